@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/BuiltinWrappers.h>
 #include <AK/ByteBuffer.h>
 #include <AK/Concepts.h>
 #include <AK/MaybeOwned.h>
@@ -63,34 +64,21 @@ public:
         size_t nread = 0;
         while (nread < count) {
             if (m_current_byte.has_value()) {
-                if constexpr (!IsSame<bool, T> && !IsSame<u8, T>) {
-                    // read as many bytes as possible directly
-                    if (((count - nread) >= 8) && is_aligned_to_byte_boundary()) {
-                        // shift existing data over
-                        result <<= 8;
-                        result |= m_current_byte.value();
-                        nread += 8;
-                        m_current_byte.clear();
-                    } else {
-                        auto const bit = (m_current_byte.value() >> (7 - m_bit_offset)) & 1;
-                        result <<= 1;
-                        result |= bit;
-                        ++nread;
-                        if (m_bit_offset++ == 7)
-                            m_current_byte.clear();
-                    }
+                // Take as many bits as possible out of the current byte at once.
+                size_t const bits_left_in_byte = 8 - m_bit_offset;
+                size_t const bits_to_take = min(bits_left_in_byte, count - nread);
+                u8 const bits = (m_current_byte.value() >> (bits_left_in_byte - bits_to_take)) & (0xff >> (8 - bits_to_take));
+                if constexpr (IsSame<bool, T>) {
+                    result = bits;
                 } else {
-                    // Always take this branch for booleans or u8: there's no purpose in reading more than a single bit
-                    auto const bit = (m_current_byte.value() >> (7 - m_bit_offset)) & 1;
-                    if constexpr (IsSame<bool, T>)
-                        result = bit;
-                    else {
-                        result <<= 1;
-                        result |= bit;
-                    }
-                    ++nread;
-                    if (m_bit_offset++ == 7)
-                        m_current_byte.clear();
+                    result <<= bits_to_take;
+                    result |= bits;
+                }
+                nread += bits_to_take;
+                m_bit_offset += bits_to_take;
+                if (m_bit_offset == 8) {
+                    m_current_byte.clear();
+                    m_bit_offset = 0;
                 }
             } else {
                 m_current_byte = TRY(m_stream->read_value<u8>());
@@ -101,6 +89,33 @@ public:
         return result;
     }
 
+    /// Reads a unary-coded number: Counts and discards zero bits up to the next set bit, which is discarded as well.
+    /// This is much faster than reading the bits one by one, since it looks at a whole byte at a time.
+    ErrorOr<size_t> read_unary()
+    {
+        size_t zero_bits = 0;
+        while (true) {
+            if (!m_current_byte.has_value()) {
+                m_current_byte = TRY(m_stream->read_value<u8>());
+                m_bit_offset = 0;
+            }
+            u8 const remaining_bits = static_cast<u8>(m_current_byte.value() << m_bit_offset);
+            if (remaining_bits != 0) {
+                size_t const leading_zeros = count_leading_zeroes(remaining_bits);
+                zero_bits += leading_zeros;
+                m_bit_offset += leading_zeros + 1;
+                if (m_bit_offset == 8) {
+                    m_current_byte.clear();
+                    m_bit_offset = 0;
+                }
+                return zero_bits;
+            }
+            zero_bits += 8 - m_bit_offset;
+            m_current_byte.clear();
+            m_bit_offset = 0;
+        }
+    }
+
     /// Discards any sub-byte stream positioning the input stream may be keeping track of.
     /// Non-bitwise reads will implicitly call this.
     void align_to_byte_boundary()
@@ -6,7 +6,7 @@
 
 #include <AK/ByteString.h>
 #include <AK/DeprecatedFlyString.h>
-#include <AK/HashTable.h>
+#include <AK/FlatHashTable.h>
 #include <AK/Optional.h>
 #include <AK/Singleton.h>
 #include <AK/StringUtils.h>
@@ -22,9 +22,9 @@ struct DeprecatedFlyStringImplTraits : public Traits<StringImpl const*> {
     }
 };
 
-static Singleton<HashTable<StringImpl const*, DeprecatedFlyStringImplTraits>> s_table;
+static Singleton<FlatHashTable<StringImpl const*, DeprecatedFlyStringImplTraits>> s_table;
 
-static HashTable<StringImpl const*, DeprecatedFlyStringImplTraits>& fly_impls()
+static FlatHashTable<StringImpl const*, DeprecatedFlyStringImplTraits>& fly_impls()
 {
     return *s_table;
 }
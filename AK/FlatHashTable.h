@@ -0,0 +1,614 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/BuiltinWrappers.h>
+#include <AK/Concepts.h>
+#include <AK/Error.h>
+#include <AK/HashTable.h>
+#include <AK/IntegralMath.h>
+#include <AK/StdLibExtras.h>
+#include <AK/Traits.h>
+#include <AK/Types.h>
+#include <AK/kmalloc.h>
+
+#ifdef __SSE2__
+#    include <emmintrin.h>
+#endif
+
+namespace AK {
+
+namespace Detail {
+
+// Every slot has a control byte next to all the others, instead of next to its value.
+// A used slot stores 7 bits of its hash there with the high bit clear, so a single comparison
+// of control bytes rules out almost every slot that can't hold the value we're looking for.
+enum class FlatHashTableControl : u8 {
+    Empty = 0x80,
+    Deleted = 0xfe,
+};
+
+// The control bytes of 16 consecutive slots, which we match against all at once.
+// Each match is a bit mask with bit N set for the Nth slot of the group.
+class FlatHashTableGroup {
+public:
+    static constexpr size_t width = 16;
+
+#ifdef __SSE2__
+    explicit FlatHashTableGroup(u8 const* control)
+        : m_control(_mm_loadu_si128(reinterpret_cast<__m128i const*>(control)))
+    {
+    }
+
+    u32 match(u8 tag) const { return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(tag)), m_control)); }
+    u32 match_empty() const { return match(to_underlying(FlatHashTableControl::Empty)); }
+    // NOTE: Both Empty and Deleted have the high bit set, and movemask extracts exactly that.
+    u32 match_empty_or_deleted() const { return _mm_movemask_epi8(m_control); }
+#else
+    explicit FlatHashTableGroup(u8 const* control)
+    {
+        __builtin_memcpy(m_control, control, width);
+    }
+
+    // NOTE: This can report false positives, but only for used slots right next to real matches. Those are
+    //       ruled out by comparing the values anyway.
+    u32 match(u8 tag) const
+    {
+        return match_each_word([&](u64 control) {
+            u64 difference = control ^ (low_bits * tag);
+            return (difference - low_bits) & ~difference & high_bits;
+        });
+    }
+    // NOTE: Empty is the only control byte with the high bit set and bit 1 clear.
+    u32 match_empty() const
+    {
+        return match_each_word([](u64 control) { return control & ~(control << 6) & high_bits; });
+    }
+    u32 match_empty_or_deleted() const
+    {
+        return match_each_word([](u64 control) { return control & high_bits; });
+    }
+#endif
+
+    u32 match_used() const { return ~match_empty_or_deleted() & 0xffff; }
+
+private:
+#ifdef __SSE2__
+    __m128i m_control;
+#else
+    static constexpr u64 low_bits = 0x0101010101010101ull;
+    static constexpr u64 high_bits = 0x8080808080808080ull;
+
+    // The matchers work on the control bytes 8 at a time, and mark matches with the high bit of the byte.
+    template<typename Matcher>
+    u32 match_each_word(Matcher matcher) const
+    {
+        auto to_bit_mask = [](u64 matches) -> u32 {
+            // Gathers the high bit of every byte into the top byte, in order.
+            return ((matches >> 7) * 0x0102040810204080ull) >> 56;
+        };
+        return to_bit_mask(matcher(m_control[0])) | (to_bit_mask(matcher(m_control[1])) << 8);
+    }
+
+    u64 m_control[2];
+#endif
+};
+
+}
+
+template<typename FlatHashTableType, typename T>
+class FlatHashTableIterator {
+    friend FlatHashTableType;
+
+public:
+    bool operator==(FlatHashTableIterator const& other) const { return m_slot == other.m_slot; }
+    bool operator!=(FlatHashTableIterator const& other) const { return m_slot != other.m_slot; }
+    T& operator*() { return *m_slot; }
+    T* operator->() { return m_slot; }
+    void operator++() { skip_to_next(); }
+
+private:
+    void skip_to_next()
+    {
+        if (!m_slot)
+            return;
+        do {
+            ++m_control;
+            ++m_slot;
+            if (m_control == m_end_control) {
+                m_slot = nullptr;
+                return;
+            }
+        } while (*m_control & 0x80);
+    }
+
+    FlatHashTableIterator(u8 const* control, T* slot, u8 const* end_control)
+        : m_control(control)
+        , m_slot(slot)
+        , m_end_control(end_control)
+    {
+    }
+
+    u8 const* m_control { nullptr };
+    T* m_slot { nullptr };
+    u8 const* m_end_control { nullptr };
+};
+
+// A set datastructure based on a hash table with open addressing, in the style of Abseil's "Swiss tables".
+// The control bytes live in their own array and are probed a group of 16 at a time, which makes lookups
+// touch far less memory than HashTable does, and lets us skip most key comparisons entirely.
+// It has the same interface as an unordered HashTable. Unlike HashTable, removing a value never moves
+// other values around, but it leaves a tombstone behind until the next rehash.
+// For a map datastructure with this layout, see FlatHashMap.
+template<typename T, typename TraitsForT>
+class FlatHashTable {
+    using Group = Detail::FlatHashTableGroup;
+    using Control = Detail::FlatHashTableControl;
+
+    static constexpr size_t minimum_capacity = Group::width;
+    // NOTE: Tombstones count towards the load factor, there always has to be an empty slot to end a probe sequence.
+    static constexpr size_t max_load_factor_eighths = 7;
+
+public:
+    FlatHashTable() = default;
+    explicit FlatHashTable(size_t capacity) { ensure_capacity(capacity); }
+
+    ~FlatHashTable()
+    {
+        if (!m_control)
+            return;
+
+        if constexpr (!IsTriviallyDestructible<T>) {
+            for (size_t i = 0; i < m_capacity; ++i) {
+                if (is_used(i))
+                    m_slots[i].~T();
+            }
+        }
+
+        kfree_sized(m_control, size_in_bytes(m_capacity));
+    }
+
+    FlatHashTable(FlatHashTable const& other)
+    {
+        if (other.is_empty())
+            return;
+        rehash(other.capacity());
+        for (auto& it : other)
+            set(it);
+    }
+
+    FlatHashTable& operator=(FlatHashTable const& other)
+    {
+        FlatHashTable temporary(other);
+        swap(*this, temporary);
+        return *this;
+    }
+
+    FlatHashTable(FlatHashTable&& other) noexcept
+        : m_control(other.m_control)
+        , m_slots(other.m_slots)
+        , m_size(other.m_size)
+        , m_deleted_count(other.m_deleted_count)
+        , m_capacity(other.m_capacity)
+    {
+        other.m_control = nullptr;
+        other.m_slots = nullptr;
+        other.m_size = 0;
+        other.m_deleted_count = 0;
+        other.m_capacity = 0;
+    }
+
+    FlatHashTable& operator=(FlatHashTable&& other) noexcept
+    {
+        FlatHashTable temporary { move(other) };
+        swap(*this, temporary);
+        return *this;
+    }
+
+    friend void swap(FlatHashTable& a, FlatHashTable& b) noexcept
+    {
+        swap(a.m_control, b.m_control);
+        swap(a.m_slots, b.m_slots);
+        swap(a.m_size, b.m_size);
+        swap(a.m_deleted_count, b.m_deleted_count);
+        swap(a.m_capacity, b.m_capacity);
+    }
+
+    [[nodiscard]] bool is_empty() const { return m_size == 0; }
+    [[nodiscard]] size_t size() const { return m_size; }
+    [[nodiscard]] size_t capacity() const { return m_capacity; }
+
+    template<typename U, size_t N>
+    ErrorOr<void> try_set_from(U (&from_array)[N])
+    {
+        for (size_t i = 0; i < N; ++i)
+            TRY(try_set(from_array[i]));
+        return {};
+    }
+    template<typename U, size_t N>
+    void set_from(U (&from_array)[N])
+    {
+        MUST(try_set_from(from_array));
+    }
+
+    ErrorOr<void> try_ensure_capacity(size_t capacity)
+    {
+        // NOTE: Like HashTable, "capacity" here is the number of values that has to fit without reallocating.
+        size_t required_capacity = capacity * 8 / max_load_factor_eighths + 1;
+        if (required_capacity <= m_capacity)
+            return {};
+        return try_rehash(required_capacity);
+    }
+    void ensure_capacity(size_t capacity)
+    {
+        MUST(try_ensure_capacity(capacity));
+    }
+
+    [[nodiscard]] bool contains(T const& value) const
+    {
+        return find(value) != end();
+    }
+
+    template<Concepts::HashCompatible<T> K>
+    requires(IsSame<TraitsForT, Traits<T>>) [[nodiscard]] bool contains(K const& value) const
+    {
+        return find(value) != end();
+    }
+
+    using Iterator = FlatHashTableIterator<FlatHashTable, T>;
+    using ConstIterator = FlatHashTableIterator<FlatHashTable const, T const>;
+
+    [[nodiscard]] Iterator begin() { return iterator_for(first_used_slot()); }
+    [[nodiscard]] Iterator end() { return Iterator(nullptr, nullptr, nullptr); }
+    [[nodiscard]] ConstIterator begin() const { return iterator_for(first_used_slot()); }
+    [[nodiscard]] ConstIterator end() const { return ConstIterator(nullptr, nullptr, nullptr); }
+
+    void clear()
+    {
+        *this = FlatHashTable();
+    }
+
+    void clear_with_capacity()
+    {
+        if (m_capacity == 0)
+            return;
+        if constexpr (!IsTriviallyDestructible<T>) {
+            for (size_t i = 0; i < m_capacity; ++i) {
+                if (is_used(i))
+                    m_slots[i].~T();
+            }
+        }
+        __builtin_memset(m_control, to_underlying(Control::Empty), m_capacity);
+        m_size = 0;
+        m_deleted_count = 0;
+    }
+
+    template<typename U = T>
+    ErrorOr<HashSetResult> try_set(U&& value, HashSetExistingEntryBehavior existing_entry_behavior = HashSetExistingEntryBehavior::Replace)
+    {
+        if (should_grow()) {
+            // If most of the load is tombstones, getting rid of them is enough.
+            bool mostly_deleted = (m_size + 1) * 16 <= m_capacity * max_load_factor_eighths;
+            TRY(try_rehash(mostly_deleted ? m_capacity : m_capacity * 2));
+        }
+
+        return write_value(forward<U>(value), existing_entry_behavior);
+    }
+    template<typename U = T>
+    HashSetResult set(U&& value, HashSetExistingEntryBehavior existing_entry_behavior = HashSetExistingEntryBehavior::Replace)
+    {
+        return MUST(try_set(forward<U>(value), existing_entry_behavior));
+    }
+
+    template<typename TUnaryPredicate>
+    [[nodiscard]] Iterator find(unsigned hash, TUnaryPredicate predicate)
+    {
+        return iterator_for(lookup_with_hash(hash, move(predicate)));
+    }
+
+    [[nodiscard]] Iterator find(T const& value)
+    {
+        if (is_empty())
+            return end();
+        return find(TraitsForT::hash(value), [&](auto& entry) { return TraitsForT::equals(entry, value); });
+    }
+
+    template<typename TUnaryPredicate>
+    [[nodiscard]] ConstIterator find(unsigned hash, TUnaryPredicate predicate) const
+    {
+        return iterator_for(lookup_with_hash(hash, move(predicate)));
+    }
+
+    [[nodiscard]] ConstIterator find(T const& value) const
+    {
+        if (is_empty())
+            return end();
+        return find(TraitsForT::hash(value), [&](auto& entry) { return TraitsForT::equals(entry, value); });
+    }
+
+    template<Concepts::HashCompatible<T> K>
+    requires(IsSame<TraitsForT, Traits<T>>) [[nodiscard]] Iterator find(K const& value)
+    {
+        if (is_empty())
+            return end();
+        return find(Traits<K>::hash(value), [&](auto& entry) { return Traits<T>::equals(entry, value); });
+    }
+
+    template<Concepts::HashCompatible<T> K, typename TUnaryPredicate>
+    requires(IsSame<TraitsForT, Traits<T>>) [[nodiscard]] Iterator find(K const& value, TUnaryPredicate predicate)
+    {
+        if (is_empty())
+            return end();
+        return find(Traits<K>::hash(value), move(predicate));
+    }
+
+    template<Concepts::HashCompatible<T> K>
+    requires(IsSame<TraitsForT, Traits<T>>) [[nodiscard]] ConstIterator find(K const& value) const
+    {
+        if (is_empty())
+            return end();
+        return find(Traits<K>::hash(value), [&](auto& entry) { return Traits<T>::equals(entry, value); });
+    }
+
+    template<Concepts::HashCompatible<T> K, typename TUnaryPredicate>
+    requires(IsSame<TraitsForT, Traits<T>>) [[nodiscard]] ConstIterator find(K const& value, TUnaryPredicate predicate) const
+    {
+        if (is_empty())
+            return end();
+        return find(Traits<K>::hash(value), move(predicate));
+    }
+
+    bool remove(T const& value)
+    {
+        auto it = find(value);
+        if (it != end()) {
+            remove(it);
+            return true;
+        }
+        return false;
+    }
+
+    template<Concepts::HashCompatible<T> K>
+    requires(IsSame<TraitsForT, Traits<T>>) bool remove(K const& value)
+    {
+        auto it = find(value);
+        if (it != end()) {
+            remove(it);
+            return true;
+        }
+        return false;
+    }
+
+    // This invalidates the iterator
+    void remove(Iterator& iterator)
+    {
+        VERIFY(iterator.m_slot);
+        delete_slot(iterator.m_slot - m_slots);
+        iterator.m_slot = nullptr;
+    }
+
+    template<typename TUnaryPredicate>
+    bool remove_all_matching(TUnaryPredicate const& predicate)
+    {
+        bool has_removed_anything = false;
+        for (size_t i = 0; i < m_capacity; ++i) {
+            if (!is_used(i) || !predicate(m_slots[i]))
+                continue;
+            delete_slot(i);
+            has_removed_anything = true;
+        }
+        return has_removed_anything;
+    }
+
+    [[nodiscard]] Vector<T> values() const
+    {
+        Vector<T> list;
+        list.ensure_capacity(size());
+        for (auto& value : *this)
+            list.unchecked_append(value);
+        return list;
+    }
+
+private:
+    struct ProbeStart {
+        size_t group_index;
+        u8 tag;
+    };
+
+    // NOTE: Many of our hash functions are weak in their low bits, so we mix the hash before splitting
+    //       it up. The high bits pick the group, and the top 7 bits become the tag in the control byte.
+    ProbeStart probe_start(unsigned hash) const
+    {
+        u64 mixed = static_cast<u64>(hash) * 0x9e3779b97f4a7c15ull;
+        return {
+            static_cast<size_t>(mixed >> 32) & group_mask(),
+            static_cast<u8>(mixed >> 57),
+        };
+    }
+
+    // Triangular probing over the groups, which visits every group once as their count is a power of two.
+    size_t next_group_index(size_t group_index, size_t step) const { return (group_index + step) & group_mask(); }
+
+    size_t group_mask() const { return m_capacity / Group::width - 1; }
+    bool is_used(size_t index) const { return !(m_control[index] & 0x80); }
+    bool should_grow() const { return (m_size + m_deleted_count + 1) * 8 > m_capacity * max_load_factor_eighths; }
+
+    static constexpr size_t slots_offset(size_t capacity) { return round_up_to_power_of_two(capacity, alignof(T)); }
+    static constexpr size_t size_in_bytes(size_t capacity) { return slots_offset(capacity) + sizeof(T) * capacity; }
+
+    u8 const* end_control() const { return m_control + m_capacity; }
+
+    T* first_used_slot() const
+    {
+        for (size_t i = 0; i < m_capacity; i += Group::width) {
+            if (auto used = Group { &m_control[i] }.match_used())
+                return &m_slots[i + count_trailing_zeroes(used)];
+        }
+        return nullptr;
+    }
+
+    Iterator iterator_for(T* slot)
+    {
+        if (!slot)
+            return end();
+        return Iterator(&m_control[slot - m_slots], slot, end_control());
+    }
+    ConstIterator iterator_for(T* slot) const
+    {
+        if (!slot)
+            return end();
+        return ConstIterator(&m_control[slot - m_slots], slot, end_control());
+    }
+
+    ErrorOr<void> try_rehash(size_t new_capacity)
+    {
+        new_capacity = max(new_capacity, minimum_capacity);
+        new_capacity = static_cast<size_t>(1) << ceil_log2(new_capacity);
+        VERIFY(new_capacity > size());
+
+        auto* new_storage = kmalloc(size_in_bytes(new_capacity));
+        if (!new_storage)
+            return Error::from_errno(ENOMEM);
+
+        auto* old_control = m_control;
+        auto* old_slots = m_slots;
+        auto old_capacity = m_capacity;
+
+        m_control = static_cast<u8*>(new_storage);
+        m_slots = reinterpret_cast<T*>(m_control + slots_offset(new_capacity));
+        m_capacity = new_capacity;
+        m_deleted_count = 0;
+        __builtin_memset(m_control, to_underlying(Control::Empty), new_capacity);
+
+        if (!old_control)
+            return {};
+
+        for (size_t i = 0; i < old_capacity; ++i) {
+            if (old_control[i] & 0x80)
+                continue;
+            insert_unique(move(old_slots[i]));
+            old_slots[i].~T();
+        }
+
+        kfree_sized(old_control, size_in_bytes(old_capacity));
+        return {};
+    }
+    void rehash(size_t new_capacity)
+    {
+        MUST(try_rehash(new_capacity));
+    }
+
+    template<typename TUnaryPredicate>
+    [[nodiscard]] T* lookup_with_hash(unsigned hash, TUnaryPredicate predicate) const
+    {
+        if (is_empty())
+            return nullptr;
+
+        auto [group_index, tag] = probe_start(hash);
+        for (size_t step = 1;; ++step) {
+            auto* group_control = &m_control[group_index * Group::width];
+            Group group { group_control };
+            for (auto matches = group.match(tag); matches; matches &= matches - 1) {
+                auto* slot = &m_slots[group_index * Group::width + count_trailing_zeroes(matches)];
+                if (predicate(*slot))
+                    return slot;
+            }
+            if (group.match_empty())
+                return nullptr;
+            group_index = next_group_index(group_index, step);
+        }
+    }
+
+    // Only used while rehashing, where we know that the value isn't in the table yet and there are no tombstones.
+    void insert_unique(T&& value)
+    {
+        auto [group_index, tag] = probe_start(TraitsForT::hash(value));
+        for (size_t step = 1;; ++step) {
+            if (auto empty = Group { &m_control[group_index * Group::width] }.match_empty()) {
+                auto index = group_index * Group::width + count_trailing_zeroes(empty);
+                new (&m_slots[index]) T(move(value));
+                m_control[index] = tag;
+                return;
+            }
+            group_index = next_group_index(group_index, step);
+        }
+    }
+
+    template<typename U = T>
+    HashSetResult write_value(U&& value, HashSetExistingEntryBehavior existing_entry_behavior)
+    {
+        auto [group_index, tag] = probe_start(TraitsForT::hash(value));
+        size_t free_index = 0;
+        bool found_free_slot = false;
+        for (size_t step = 1;; ++step) {
+            size_t group_start = group_index * Group::width;
+            Group group { &m_control[group_start] };
+
+            for (auto matches = group.match(tag); matches; matches &= matches - 1) {
+                auto& slot = m_slots[group_start + count_trailing_zeroes(matches)];
+                if (!TraitsForT::equals(slot, static_cast<T const&>(value)))
+                    continue;
+                if (existing_entry_behavior == HashSetExistingEntryBehavior::Replace) {
+                    slot = forward<U>(value);
+                    return HashSetResult::ReplacedExistingEntry;
+                }
+                return HashSetResult::KeptExistingEntry;
+            }
+
+            // We have to keep looking for an existing value until we see an empty slot,
+            // but the value goes into the first free slot along the way, which may be a tombstone.
+            if (!found_free_slot) {
+                if (auto free = group.match_empty_or_deleted()) {
+                    free_index = group_start + count_trailing_zeroes(free);
+                    found_free_slot = true;
+                }
+            }
+            if (group.match_empty())
+                break;
+            group_index = next_group_index(group_index, step);
+        }
+
+        VERIFY(found_free_slot);
+        if (m_control[free_index] == to_underlying(Control::Deleted))
+            --m_deleted_count;
+        new (&m_slots[free_index]) T(forward<U>(value));
+        m_control[free_index] = tag;
+        ++m_size;
+        return HashSetResult::InsertedNewEntry;
+    }
+
+    void delete_slot(size_t index)
+    {
+        VERIFY(index < m_capacity);
+        VERIFY(is_used(index));
+
+        m_slots[index].~T();
+        --m_size;
+
+        // A probe sequence only ever continues past a group that has no empty slots. So if this group still has one,
+        // nothing can be probing past us and the slot can simply become empty again. Otherwise it has to stay a
+        // tombstone, or we'd cut off the probe sequences of other values.
+        if (Group { &m_control[index & ~(Group::width - 1)] }.match_empty()) {
+            m_control[index] = to_underlying(Control::Empty);
+        } else {
+            m_control[index] = to_underlying(Control::Deleted);
+            ++m_deleted_count;
+        }
+    }
+
+    u8* m_control { nullptr };
+    T* m_slots { nullptr };
+    size_t m_size { 0 };
+    size_t m_deleted_count { 0 };
+    size_t m_capacity { 0 };
+};
+
+}
+
+#if USING_AK_GLOBALLY
+using AK::FlatHashTable;
+#endif
@@ -5,6 +5,7 @@
  */
 
 #include <AK/DeprecatedFlyString.h>
+#include <AK/FlatHashTable.h>
 #include <AK/FlyString.h>
 #include <AK/HashMap.h>
 #include <AK/Singleton.h>
@@ -22,19 +23,34 @@ struct FlyStringTableHashTraits : public Traits<Detail::StringData const*> {
 
 static auto& all_fly_strings()
 {
-    static Singleton<HashTable<Detail::StringData const*, FlyStringTableHashTraits>> table;
+    static Singleton<FlatHashTable<Detail::StringData const*, FlyStringTableHashTraits>> table;
     return *table;
 }
 
+// Adds a string we've just created to the table, which we already know doesn't contain an equal string.
+FlyString FlyString::intern_new_string(String const& string, unsigned hash)
+{
+    VERIFY(!string.is_short_string());
+
+    // NOTE: We already hashed the bytes to look them up, so there is no need for the table to do that again.
+    string.m_data->set_precomputed_hash(hash);
+    all_fly_strings().set(string.m_data);
+    string.m_data->set_fly_string(true);
+
+    return FlyString { Detail::StringBase(string) };
+}
+
 ErrorOr<FlyString> FlyString::from_utf8(StringView string)
 {
     if (string.is_empty())
         return FlyString {};
     if (string.length() <= Detail::MAX_SHORT_STRING_BYTE_COUNT)
         return FlyString { TRY(String::from_utf8(string)) };
-    if (auto it = all_fly_strings().find(string.hash(), [&](auto& entry) { return entry->bytes_as_string_view() == string; }); it != all_fly_strings().end())
+
+    auto hash = string.hash();
+    if (auto it = all_fly_strings().find(hash, [&](auto& entry) { return entry->bytes_as_string_view() == string; }); it != all_fly_strings().end())
         return FlyString { Detail::StringBase(**it) };
-    return FlyString { TRY(String::from_utf8(string)) };
+    return intern_new_string(TRY(String::from_utf8(string)), hash);
 }
 
 FlyString FlyString::from_utf8_without_validation(ReadonlyBytes string)
@@ -43,9 +59,11 @@ FlyString FlyString::from_utf8_without_validation(ReadonlyBytes string)
         return FlyString {};
     if (string.size() <= Detail::MAX_SHORT_STRING_BYTE_COUNT)
         return FlyString { String::from_utf8_without_validation(string) };
-    if (auto it = all_fly_strings().find(StringView(string).hash(), [&](auto& entry) { return entry->bytes_as_string_view() == string; }); it != all_fly_strings().end())
+
+    auto hash = StringView(string).hash();
+    if (auto it = all_fly_strings().find(hash, [&](auto& entry) { return entry->bytes_as_string_view() == string; }); it != all_fly_strings().end())
         return FlyString { Detail::StringBase(**it) };
-    return FlyString { String::from_utf8_without_validation(string) };
+    return intern_new_string(String::from_utf8_without_validation(string), hash);
 }
 
 FlyString::FlyString(String const& string)
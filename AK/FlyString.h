@@ -15,6 +15,8 @@
 
 namespace AK {
 
+// NOTE: Like String, FlyString is not thread-safe. Its data is reference counted non-atomically, and the table
+//       of interned strings is shared by everything in the process, so all FlyStrings must stay on one thread.
 class FlyString {
     AK_MAKE_DEFAULT_MOVABLE(FlyString);
     AK_MAKE_DEFAULT_COPYABLE(FlyString);
@@ -82,6 +84,8 @@ private:
     {
     }
 
+    static FlyString intern_new_string(String const&, unsigned hash);
+
     Detail::StringBase m_data;
 };
 
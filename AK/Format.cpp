@@ -53,12 +53,49 @@ namespace {
 
 static constexpr size_t use_next_index = NumericLimits<size_t>::max();
 
+// Every two-digit decimal number, so that we only need a division for every other digit.
+static constexpr char decimal_digit_pairs[] = "00010203040506070809101112131415161718192021222324252627282930313233343536373839404142434445464748495051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+
+static constexpr size_t count_decimal_digits(u64 value)
+{
+    size_t digits = 1;
+    for (u64 power_of_ten = 10; digits < 20 && value >= power_of_ten; power_of_ten *= 10)
+        ++digits;
+    return digits;
+}
+
+// Writes the digits from the back, two at a time. This is the path almost every formatted integer takes.
+template<size_t Size>
+static constexpr size_t convert_unsigned_to_decimal_string(u64 value, Array<u8, Size>& buffer)
+{
+    auto const length = count_decimal_digits(value);
+    VERIFY(length <= Size);
+
+    auto position = length;
+    while (value >= 100) {
+        auto const pair = (value % 100) * 2;
+        value /= 100;
+        buffer[--position] = decimal_digit_pairs[pair + 1];
+        buffer[--position] = decimal_digit_pairs[pair];
+    }
+    if (value >= 10) {
+        buffer[--position] = decimal_digit_pairs[value * 2 + 1];
+        buffer[--position] = decimal_digit_pairs[value * 2];
+    } else {
+        buffer[--position] = static_cast<u8>('0' + value);
+    }
+    return length;
+}
+
 // The worst case is that we have the largest 64-bit value formatted as binary number, this would take
 // 65 bytes (85 bytes with separators). Choosing a larger power of two won't hurt and is a bit of mitigation against out-of-bounds accesses.
 static constexpr size_t convert_unsigned_to_string(u64 value, Array<u8, 128>& buffer, u8 base, bool upper_case, bool use_separator)
 {
     VERIFY(base >= 2 && base <= 16);
 
+    if (base == 10 && !use_separator)
+        return convert_unsigned_to_decimal_string(value, buffer);
+
     constexpr char const* lowercase_lookup = "0123456789abcdef";
     constexpr char const* uppercase_lookup = "0123456789ABCDEF";
 
@@ -88,6 +125,41 @@ static constexpr size_t convert_unsigned_to_string(u64 value, Array<u8, 128>& bu
     return used;
 }
 
+#ifndef KERNEL
+// The shortest round-trip form of any float or double fits into this, including the sign, exponent and separators.
+// This saves put_f32_or_f64() from allocating a StringBuilder for every number.
+class FloatingPointStringBuffer {
+public:
+    ErrorOr<void> try_append(char character)
+    {
+        VERIFY(m_length < m_buffer.size());
+        m_buffer[m_length++] = character;
+        return {};
+    }
+    ErrorOr<void> try_append(StringView string)
+    {
+        VERIFY(m_length + string.length() <= m_buffer.size());
+        __builtin_memcpy(m_buffer.data() + m_length, string.characters_without_null_termination(), string.length());
+        m_length += string.length();
+        return {};
+    }
+    ErrorOr<void> try_append_repeated(char character, size_t count)
+    {
+        VERIFY(m_length + count <= m_buffer.size());
+        __builtin_memset(m_buffer.data() + m_length, character, count);
+        m_length += count;
+        return {};
+    }
+
+    size_t length() const { return m_length; }
+    StringView string_view() const { return { m_buffer.data(), m_length }; }
+
+private:
+    Array<char, 64> m_buffer;
+    size_t m_length { 0 };
+};
+#endif
+
 ErrorOr<void> vformat_impl(TypeErasedFormatParams& params, FormatBuilder& builder, FormatParser& parser)
 {
     auto const literal = parser.consume_literal();
@@ -204,17 +276,20 @@ bool FormatParser::consume_replacement_field(size_t& index)
 
 ErrorOr<void> FormatBuilder::put_padding(char fill, size_t amount)
 {
-    for (size_t i = 0; i < amount; ++i)
-        TRY(m_builder.try_append(fill));
-    return {};
+    return m_builder.try_append_repeated(fill, amount);
 }
 ErrorOr<void> FormatBuilder::put_literal(StringView value)
 {
+    // Literals are appended in one go up to the next escaped brace, which only ever appears once in the output.
+    size_t start = 0;
     for (size_t i = 0; i < value.length(); ++i) {
-        TRY(m_builder.try_append(value[i]));
-        if (value[i] == '{' || value[i] == '}')
-            ++i;
+        if (value[i] != '{' && value[i] != '}')
+            continue;
+        TRY(m_builder.try_append(value.substring_view(start, i + 1 - start)));
+        start = ++i + 1;
     }
+    if (start < value.length())
+        TRY(m_builder.try_append(value.substring_view(start)));
     return {};
 }
 
@@ -317,11 +392,14 @@ ErrorOr<void> FormatBuilder::put_u64(
     };
 
     auto const put_digits = [&]() -> ErrorOr<void> {
-        for (size_t i = 0; i < used_by_digits; ++i)
-            TRY(m_builder.try_append(buffer[i]));
-        return {};
+        return m_builder.try_append(StringView { buffer.span().slice(0, used_by_digits) });
     };
 
+    // Most integers are formatted without any frills, so skip all the padding logic for those.
+    // Note that used_by_prefix is zero for zero-padded fields even if there is a sign or prefix to write.
+    if (!prefix && !is_negative && sign_mode == SignMode::OnlyIfNeeded && used_by_digits >= min_width)
+        return put_digits();
+
     if (align == Align::Left) {
         auto const used_by_right_padding = used_by_padding;
 
@@ -563,7 +641,7 @@ ErrorOr<void> FormatBuilder::put_f32_or_f64(
         return put_f64_with_precision(value, base, upper_case, zero_pad, use_separator, align, min_width, precision.value_or(6), fill, sign_mode, display_mode);
 
     // No precision specified, so pick the best precision with roundtrip guarantees.
-    StringBuilder builder;
+    FloatingPointStringBuffer builder;
 
     // Special cases: NaN, inf, -inf, 0 and -0.
     auto const is_nan = isnan(value);
@@ -589,17 +667,8 @@ ErrorOr<void> FormatBuilder::put_f32_or_f64(
 
     auto const [sign, mantissa, exponent] = convert_floating_point_to_decimal_exponential_form(value);
 
-    auto convert_to_decimal_digits_array = [](auto x, auto& digits) -> size_t {
-        size_t length = 0;
-        for (; x; x /= 10)
-            digits[length++] = x % 10 | '0';
-        for (size_t i = 0; 2 * i + 1 < length; ++i)
-            swap(digits[i], digits[length - i - 1]);
-        return length;
-    };
-
     Array<u8, 20> mantissa_digits;
-    auto mantissa_length = convert_to_decimal_digits_array(mantissa, mantissa_digits);
+    auto mantissa_length = convert_unsigned_to_decimal_string(mantissa, mantissa_digits);
 
     if (sign)
         TRY(builder.try_append('-'));
@@ -631,7 +700,7 @@ ErrorOr<void> FormatBuilder::put_f32_or_f64(
     } else {
         auto const exponent_sign = n < 0 ? '-' : '+';
         Array<u8, 5> exponent_digits;
-        auto const exponent_length = convert_to_decimal_digits_array(abs(n - 1), exponent_digits);
+        auto const exponent_length = convert_unsigned_to_decimal_string(static_cast<u64>(abs(n - 1)), exponent_digits);
         auto const exponent_text = StringView { exponent_digits.span().slice(0, exponent_length) };
         integral_part_end = 1;
 
@@ -654,7 +723,7 @@ ErrorOr<void> FormatBuilder::put_f32_or_f64(
 
     if (use_separator && integral_part_end > 3) {
         // Go backwards from the end of the integral part, inserting commas every 3 consecutive digits.
-        StringBuilder separated_builder;
+        FloatingPointStringBuffer separated_builder;
         auto const string_view = builder.string_view();
         for (size_t i = 0; i < integral_part_end; ++i) {
             auto const index_from_end = integral_part_end - i - 1;
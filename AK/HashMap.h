@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <AK/FlatHashTable.h>
 #include <AK/HashTable.h>
 #include <AK/Optional.h>
 #include <AK/Vector.h>
@@ -17,8 +18,11 @@ namespace AK {
 // A map datastructure, mapping keys K to values V, based on a hash table with closed hashing.
 // HashMap can optionally provide ordered iteration based on the order of keys when IsOrdered = true.
 // HashMap is based on HashTable, which should be used instead if just a set datastructure is required.
-template<typename K, typename V, typename KeyTraits, typename ValueTraits, bool IsOrdered>
+// With IsFlat = true (see FlatHashMap), it is based on FlatHashTable instead, which is faster for lookups.
+template<typename K, typename V, typename KeyTraits, typename ValueTraits, bool IsOrdered, bool IsFlat>
 class HashMap {
+    static_assert(!(IsOrdered && IsFlat), "FlatHashTable does not support ordered iteration");
+
 private:
     struct Entry {
         K key;
@@ -93,7 +97,7 @@ public:
         });
     }
 
-    using HashTableType = HashTable<Entry, EntryTraits, IsOrdered>;
+    using HashTableType = Conditional<IsFlat, FlatHashTable<Entry, EntryTraits>, HashTable<Entry, EntryTraits, IsOrdered>>;
     using IteratorType = typename HashTableType::Iterator;
     using ConstIteratorType = typename HashTableType::ConstIterator;
 
@@ -299,10 +303,10 @@ public:
         return hash;
     }
 
-    template<typename NewKeyTraits = KeyTraits, typename NewValueTraits = ValueTraits, bool NewIsOrdered = IsOrdered>
-    ErrorOr<HashMap<K, V, NewKeyTraits, NewValueTraits, NewIsOrdered>> clone() const
+    template<typename NewKeyTraits = KeyTraits, typename NewValueTraits = ValueTraits, bool NewIsOrdered = IsOrdered, bool NewIsFlat = IsFlat && !NewIsOrdered>
+    ErrorOr<HashMap<K, V, NewKeyTraits, NewValueTraits, NewIsOrdered, NewIsFlat>> clone() const
     {
-        HashMap<K, V, NewKeyTraits, NewValueTraits, NewIsOrdered> hash_map_clone;
+        HashMap<K, V, NewKeyTraits, NewValueTraits, NewIsOrdered, NewIsFlat> hash_map_clone;
         TRY(hash_map_clone.try_ensure_capacity(size()));
         for (auto const& [key, value] : *this)
             hash_map_clone.set(key, value);
@@ -316,6 +320,7 @@ private:
 }
 
 #if USING_AK_GLOBALLY
+using AK::FlatHashMap;
 using AK::HashMap;
 using AK::OrderedHashMap;
 #endif
@@ -18,6 +18,33 @@ constexpr bool is_space(int ch)
     return ch == '\t' || ch == '\n' || ch == '\r' || ch == ' ';
 }
 
+size_t JsonParser::count_literal_string_characters(StringView input)
+{
+    auto const* characters = input.characters_without_null_termination();
+    size_t offset = 0;
+
+    // OPTIMIZATION: Look at 8 characters at a time, using the usual bit tricks to find out whether any byte within
+    //               a word is a quotation mark, a backslash, or below 0x20. Only then do we look at them one by one.
+    static constexpr u64 ones = 0x0101010101010101ull;
+    static constexpr u64 high_bits = 0x8080808080808080ull;
+    auto has_zero_byte = [](u64 word) { return ((word - ones) & ~word & high_bits) != 0; };
+
+    for (; offset + sizeof(u64) <= input.length(); offset += sizeof(u64)) {
+        u64 word;
+        __builtin_memcpy(&word, characters + offset, sizeof(u64));
+        bool has_control_character = ((word - ones * 0x20) & ~word & high_bits) != 0;
+        if (has_control_character || has_zero_byte(word ^ (ones * '"')) || has_zero_byte(word ^ (ones * '\\')))
+            break;
+    }
+
+    for (; offset < input.length(); ++offset) {
+        char ch = characters[offset];
+        if (ch == '"' || ch == '\\' || is_ascii_c0_control(ch))
+            break;
+    }
+    return offset;
+}
+
 // ECMA-404 9 String
 // Boils down to
 // STRING = "\"" *("[^\"\\]" | "\\" ("[\"\\bfnrt]" | "u[0-9A-Za-z]{4}")) "\""
@@ -45,29 +72,22 @@ ErrorOr<ByteString> JsonParser::consume_and_unescape_string()
         //       of a set of "legal" non-special bytes,
         //       hence we don't need to bother with a code-point iterator,
         //       as a simple byte iterator suffices, which GenericLexer provides by default
-        size_t literal_characters = 0;
-        for (;;) {
-            char ch = peek(literal_characters);
-            // Note: We get a 0 byte when we hit EOF
-            if (ch == 0)
-                return Error::from_string_literal("JsonParser: EOF while parsing String");
-            // Spec: All code points may be placed within the quotation marks except
-            //       for the code points that must be escaped: quotation mark (U+0022),
-            //       reverse solidus (U+005C), and the control characters U+0000 to U+001F.
-            //       There are two-character escape sequence representations of some characters.
-            if (is_ascii_c0_control(ch))
-                return Error::from_string_literal("JsonParser: ASCII control sequence encountered");
-            if (ch == '"' || ch == '\\')
-                break;
-            ++literal_characters;
-        }
+        size_t literal_characters = count_literal_string_characters(remaining());
+        char ch = peek(literal_characters);
+        // Note: We get a 0 byte when we hit EOF
+        if (ch == 0)
+            return Error::from_string_literal("JsonParser: EOF while parsing String");
+        // Spec: All code points may be placed within the quotation marks except
+        //       for the code points that must be escaped: quotation mark (U+0022),
+        //       reverse solidus (U+005C), and the control characters U+0000 to U+001F.
+        //       There are two-character escape sequence representations of some characters.
+        if (is_ascii_c0_control(ch))
+            return Error::from_string_literal("JsonParser: ASCII control sequence encountered");
         final_sb.append(consume(literal_characters));
 
-        // We have checked all cases except end-of-string and escaped characters in the loop above,
+        // We have checked all cases except end-of-string and escaped characters above,
         // so we now only have to handle those two cases
-        char ch = peek();
-
-        if (ch == '"') {
+        if (peek() == '"') {
             consume();
             break;
         }
@@ -21,6 +21,12 @@ public:
     ErrorOr<JsonValue> parse();
 
 private:
+    friend class JsonStreamReader;
+
+    // Returns how many characters at the start of the given input can be taken literally as part of a string,
+    // i.e. how many there are before the first quotation mark, backslash or control character.
+    static size_t count_literal_string_characters(StringView);
+
     ErrorOr<JsonValue> parse_helper();
 
     ErrorOr<ByteString> consume_and_unescape_string();
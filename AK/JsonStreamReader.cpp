@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/CharacterTypes.h>
+#include <AK/JsonParser.h>
+#include <AK/JsonStreamReader.h>
+
+namespace AK {
+
+static constexpr bool is_space(int ch)
+{
+    return ch == '\t' || ch == '\n' || ch == '\r' || ch == ' ';
+}
+
+static constexpr bool is_number_character(int ch)
+{
+    return is_ascii_digit(ch) || ch == '-' || ch == '+' || ch == '.' || ch == 'e' || ch == 'E';
+}
+
+ErrorOr<JsonStreamReader::ValueType> JsonStreamReader::peek_value_type()
+{
+    ignore_while(is_space);
+    switch (peek()) {
+    case '{':
+        return ValueType::Object;
+    case '[':
+        return ValueType::Array;
+    case '"':
+        return ValueType::String;
+    case 't':
+    case 'f':
+        return ValueType::Bool;
+    case 'n':
+        return ValueType::Null;
+    default:
+        if (peek() == '-' || is_ascii_digit(peek()))
+            return ValueType::Number;
+        return Error::from_string_literal("JsonStreamReader: Unexpected character");
+    }
+}
+
+ErrorOr<void> JsonStreamReader::enter_object()
+{
+    ignore_while(is_space);
+    if (!consume_specific('{'))
+        return Error::from_string_literal("JsonStreamReader: Expected '{'");
+    TRY(m_containers.try_append({ .is_object = true }));
+    return {};
+}
+
+ErrorOr<void> JsonStreamReader::enter_array()
+{
+    ignore_while(is_space);
+    if (!consume_specific('['))
+        return Error::from_string_literal("JsonStreamReader: Expected '['");
+    TRY(m_containers.try_append({ .is_object = false }));
+    return {};
+}
+
+ErrorOr<bool> JsonStreamReader::next_member_of(bool is_object)
+{
+    if (m_containers.is_empty() || m_containers.last().is_object != is_object) {
+        if (is_object)
+            return Error::from_string_literal("JsonStreamReader: Not inside an object");
+        return Error::from_string_literal("JsonStreamReader: Not inside an array");
+    }
+    auto& container = m_containers.last();
+
+    ignore_while(is_space);
+    if (consume_specific(is_object ? '}' : ']')) {
+        m_containers.take_last();
+        return false;
+    }
+
+    if (container.has_members) {
+        if (!consume_specific(','))
+            return Error::from_string_literal("JsonStreamReader: Expected ','");
+        ignore_while(is_space);
+    }
+    container.has_members = true;
+    return true;
+}
+
+ErrorOr<Optional<StringView>> JsonStreamReader::next_key()
+{
+    if (!TRY(next_member_of(true)))
+        return OptionalNone {};
+
+    auto key = TRY(consume_string(m_unescaped_key));
+    ignore_while(is_space);
+    if (!consume_specific(':'))
+        return Error::from_string_literal("JsonStreamReader: Expected ':'");
+    return Optional<StringView> { key };
+}
+
+ErrorOr<bool> JsonStreamReader::next_element()
+{
+    return next_member_of(false);
+}
+
+ErrorOr<void> JsonStreamReader::leave()
+{
+    if (m_containers.is_empty())
+        return Error::from_string_literal("JsonStreamReader: Not inside an object or array");
+
+    if (m_containers.last().is_object) {
+        while (TRY(next_key()).has_value())
+            TRY(skip_value());
+    } else {
+        while (TRY(next_element()))
+            TRY(skip_value());
+    }
+    return {};
+}
+
+ErrorOr<StringView> JsonStreamReader::consume_string(ByteString& unescaped_string)
+{
+    ignore_while(is_space);
+    if (peek() != '"')
+        return Error::from_string_literal("JsonStreamReader: Expected '\"'");
+
+    // OPTIMIZATION: Most strings don't contain any escape sequences, so we can usually just hand out a view into the input.
+    auto literal_characters = JsonParser::count_literal_string_characters(m_input.substring_view(m_index + 1));
+    if (peek(literal_characters + 1) == '"') {
+        auto string = m_input.substring_view(m_index + 1, literal_characters);
+        ignore(literal_characters + 2);
+        return string;
+    }
+
+    JsonParser parser { remaining() };
+    unescaped_string = TRY(parser.consume_and_unescape_string());
+    ignore(parser.tell());
+    return unescaped_string.view();
+}
+
+ErrorOr<ByteString> JsonStreamReader::read_string()
+{
+    ByteString unescaped_string;
+    auto string = TRY(consume_string(unescaped_string));
+    // NOTE: We only end up with an unescaped string if the string had any escape sequences in it.
+    if (!unescaped_string.is_empty())
+        return unescaped_string;
+    return ByteString { string };
+}
+
+ErrorOr<bool> JsonStreamReader::read_bool()
+{
+    ignore_while(is_space);
+    if (consume_specific("true"sv))
+        return true;
+    if (consume_specific("false"sv))
+        return false;
+    return Error::from_string_literal("JsonStreamReader: Expected 'true' or 'false'");
+}
+
+ErrorOr<void> JsonStreamReader::read_null()
+{
+    ignore_while(is_space);
+    if (!consume_specific("null"sv))
+        return Error::from_string_literal("JsonStreamReader: Expected 'null'");
+    return {};
+}
+
+ErrorOr<JsonStreamReader::Integer> JsonStreamReader::consume_integer()
+{
+    ignore_while(is_space);
+
+    Integer integer;
+    if (consume_specific('-'))
+        integer.is_negative = true;
+
+    if (!is_ascii_digit(peek()))
+        return Error::from_string_literal("JsonStreamReader: Expected a number");
+    if (peek() == '0' && is_ascii_digit(peek(1)))
+        return Error::from_string_literal("JsonStreamReader: Cannot have leading zeros");
+
+    while (is_ascii_digit(peek())) {
+        auto digit = static_cast<u64>(consume() - '0');
+        if (integer.magnitude > (NumericLimits<u64>::max() - digit) / 10)
+            return Error::from_string_literal("JsonStreamReader: Number is out of range");
+        integer.magnitude = integer.magnitude * 10 + digit;
+    }
+
+    if (peek() == '.' || peek() == 'e' || peek() == 'E')
+        return Error::from_string_literal("JsonStreamReader: Expected an integer");
+    return integer;
+}
+
+#ifndef KERNEL
+ErrorOr<double> JsonStreamReader::read_double()
+{
+    if (TRY(peek_value_type()) != ValueType::Number)
+        return Error::from_string_literal("JsonStreamReader: Expected a number");
+    auto value = TRY(read_value());
+    return value.get_double_with_precision_loss().value();
+}
+#endif
+
+ErrorOr<JsonValue> JsonStreamReader::read_value()
+{
+    ignore_while(is_space);
+
+    JsonParser parser { remaining() };
+    auto value = TRY(parser.parse_helper());
+    ignore(parser.tell());
+    return value;
+}
+
+ErrorOr<void> JsonStreamReader::skip_string()
+{
+    ignore(); // '"'
+
+    for (;;) {
+        ignore(JsonParser::count_literal_string_characters(remaining()));
+        if (consume_specific('"'))
+            return {};
+        if (!consume_specific('\\'))
+            return Error::from_string_literal("JsonStreamReader: Unterminated or invalid string");
+        if (is_eof())
+            return Error::from_string_literal("JsonStreamReader: EOF while parsing string");
+        ignore();
+    }
+}
+
+ErrorOr<void> JsonStreamReader::skip_value()
+{
+    switch (TRY(peek_value_type())) {
+    case ValueType::String:
+        return skip_string();
+    case ValueType::Number:
+        ignore_while(is_number_character);
+        return {};
+    case ValueType::Bool:
+        TRY(read_bool());
+        return {};
+    case ValueType::Null:
+        return read_null();
+    case ValueType::Array:
+    case ValueType::Object:
+        break;
+    }
+
+    // NOTE: We only keep track of which brackets have to be closed, so that a subtree can be skipped without
+    //       allocating (unless it's nested very deeply) or producing any values.
+    Vector<char, 32> closing_brackets;
+    do {
+        if (is_eof())
+            return Error::from_string_literal("JsonStreamReader: EOF while skipping value");
+
+        char ch = peek();
+        switch (ch) {
+        case '"':
+            TRY(skip_string());
+            continue;
+        case '{':
+            TRY(closing_brackets.try_append('}'));
+            break;
+        case '[':
+            TRY(closing_brackets.try_append(']'));
+            break;
+        case '}':
+        case ']':
+            if (closing_brackets.take_last() != ch)
+                return Error::from_string_literal("JsonStreamReader: Mismatched brackets");
+            break;
+        default:
+            break;
+        }
+        ignore();
+    } while (!closing_brackets.is_empty());
+
+    return {};
+}
+
+ErrorOr<void> JsonStreamReader::finish()
+{
+    if (!m_containers.is_empty())
+        return Error::from_string_literal("JsonStreamReader: Unterminated object or array");
+    ignore_while(is_space);
+    if (!is_eof())
+        return Error::from_string_literal("JsonStreamReader: Didn't consume all input");
+    return {};
+}
+
+}
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/Concepts.h>
+#include <AK/GenericLexer.h>
+#include <AK/JsonValue.h>
+#include <AK/NumericLimits.h>
+#include <AK/Optional.h>
+#include <AK/Vector.h>
+
+namespace AK {
+
+// A pull parser for JSON documents, which hands out values one at a time as the caller asks for them instead of building a
+// JsonValue tree for the whole document. Keys without escape sequences are returned as views into the input, and values that
+// the caller isn't interested in can be skipped without allocating anything at all.
+//
+//     JsonStreamReader reader { input };
+//     TRY(reader.for_each_member([&](StringView key) -> ErrorOr<void> {
+//         if (key == "pid"sv)
+//             pid = TRY(reader.read_number<pid_t>());
+//         else
+//             TRY(reader.skip_value());
+//         return {};
+//     }));
+//     TRY(reader.finish());
+class JsonStreamReader : private GenericLexer {
+public:
+    enum class ValueType {
+        Null,
+        Bool,
+        Number,
+        String,
+        Array,
+        Object,
+    };
+
+    explicit JsonStreamReader(StringView input)
+        : GenericLexer(input)
+    {
+    }
+
+    ErrorOr<ValueType> peek_value_type();
+
+    // Consumes the '{' of an object, after which its members are visited with next_key().
+    ErrorOr<void> enter_object();
+
+    // Returns the key of the next member of the current object, after which its value has to be read or skipped.
+    // Once there are no more members, this consumes the closing '}' and returns an empty Optional.
+    // NOTE: The returned view is only valid until the next call to next_key().
+    ErrorOr<Optional<StringView>> next_key();
+
+    // Consumes the '[' of an array, after which its elements are visited with next_element().
+    ErrorOr<void> enter_array();
+
+    // Returns whether the current array has another element, which then has to be read or skipped.
+    // Once there are no more elements, this consumes the closing ']' and returns false.
+    ErrorOr<bool> next_element();
+
+    // Enters the next object and calls the callback with the key of each of its members, which then has to read or skip the value.
+    template<typename Callback>
+    ErrorOr<void> for_each_member(Callback callback)
+    {
+        TRY(enter_object());
+        for (;;) {
+            auto key = TRY(next_key());
+            if (!key.has_value())
+                return {};
+            TRY(callback(*key));
+        }
+    }
+
+    // Enters the next array and calls the callback for each of its elements, which then has to read or skip the element.
+    template<typename Callback>
+    ErrorOr<void> for_each_element(Callback callback)
+    {
+        TRY(enter_array());
+        while (TRY(next_element()))
+            TRY(callback());
+        return {};
+    }
+
+    // Skips all members or elements of the current object or array that haven't been visited yet, including its closing bracket.
+    ErrorOr<void> leave();
+
+    ErrorOr<ByteString> read_string();
+    ErrorOr<bool> read_bool();
+    ErrorOr<void> read_null();
+
+    template<Integral T>
+    ErrorOr<T> read_number()
+    {
+        auto [magnitude, is_negative] = TRY(consume_integer());
+        if (is_negative) {
+            if constexpr (IsSigned<T>) {
+                if (magnitude <= static_cast<u64>(NumericLimits<T>::max()) + 1)
+                    return static_cast<T>(static_cast<i64>(0 - magnitude));
+            } else if (magnitude == 0) {
+                return 0;
+            }
+        } else if (magnitude <= static_cast<u64>(NumericLimits<T>::max())) {
+            return static_cast<T>(magnitude);
+        }
+        return Error::from_string_literal("JsonStreamReader: Number is out of range");
+    }
+
+#ifndef KERNEL
+    ErrorOr<double> read_double();
+#endif
+
+    // Parses the next value, and everything within it, into a JsonValue.
+    ErrorOr<JsonValue> read_value();
+
+    // Moves past the next value without looking at it in any more detail than is needed to find where it ends.
+    // NOTE: Strings within skipped values are not unescaped, and numbers are not checked for being well-formed.
+    ErrorOr<void> skip_value();
+
+    // Checks that all objects and arrays have been left, and that there is nothing but whitespace left in the input.
+    ErrorOr<void> finish();
+
+private:
+    struct Container {
+        bool is_object { false };
+        bool has_members { false };
+    };
+
+    struct Integer {
+        u64 magnitude { 0 };
+        bool is_negative { false };
+    };
+
+    ErrorOr<bool> next_member_of(bool is_object);
+    ErrorOr<StringView> consume_string(ByteString& unescaped_string);
+    ErrorOr<void> skip_string();
+    ErrorOr<Integer> consume_integer();
+
+    Vector<Container, 16> m_containers;
+    ByteString m_unescaped_key;
+};
+
+}
+
+#if USING_AK_GLOBALLY
+using AK::JsonStreamReader;
+#endif
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/InsertionSort.h>
+#include <AK/StdLibExtras.h>
+#include <AK/Vector.h>
+
+namespace AK {
+
+// A stable sort: Elements that compare equal keep the order they had before.
+// This needs a temporary buffer for half of the elements, if you don't care about
+// the order of equal elements, quick_sort() is faster and sorts in place.
+
+static constexpr int MERGE_SORT_INSERTION_CUTOFF = 16;
+
+namespace Detail {
+
+template<typename Collection, typename LessThan, typename T>
+void merge_sort_impl(Collection& col, int start, int end, LessThan& less_than, Vector<T>& buffer)
+{
+    // NOTE: Insertion sort only ever moves an element past others that are strictly greater, so it is stable as well.
+    if ((end + 1) - start <= MERGE_SORT_INSERTION_CUTOFF) {
+        AK::insertion_sort(col, start, end, less_than);
+        return;
+    }
+
+    int middle = start + (end - start) / 2;
+    merge_sort_impl(col, start, middle, less_than, buffer);
+    merge_sort_impl(col, middle + 1, end, less_than, buffer);
+
+    // The two halves are already in order, which is common for inputs that were sorted before.
+    if (!less_than(col[middle + 1], col[middle]))
+        return;
+
+    // Move the left half out of the way, and merge it with the right half back into place.
+    buffer.clear_with_capacity();
+    for (int i = start; i <= middle; ++i)
+        buffer.unchecked_append(move(col[i]));
+
+    size_t left = 0;
+    int right = middle + 1;
+    int out = start;
+    while (left < buffer.size() && right <= end) {
+        // Take from the left half unless the right one is strictly smaller, this is what keeps the sort stable.
+        if (less_than(col[right], buffer[left]))
+            col[out++] = move(col[right++]);
+        else
+            col[out++] = move(buffer[left++]);
+    }
+    while (left < buffer.size())
+        col[out++] = move(buffer[left++]);
+}
+
+}
+
+template<typename Collection, typename LessThan>
+void merge_sort(Collection& collection, LessThan less_than)
+{
+    using T = RemoveCVReference<decltype(collection[0])>;
+
+    int size = static_cast<int>(collection.size());
+    if (size <= 1)
+        return;
+
+    Vector<T> buffer;
+    buffer.ensure_capacity(size / 2 + 1);
+    Detail::merge_sort_impl(collection, 0, size - 1, less_than, buffer);
+}
+
+template<typename Collection>
+void merge_sort(Collection& collection)
+{
+    merge_sort(collection, [](auto& a, auto& b) { return a < b; });
+}
+
+}
+
+#if USING_AK_GLOBALLY
+using AK::merge_sort;
+#endif
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <AK/InsertionSort.h>
+#include <AK/IntegralMath.h>
 #include <AK/StdLibExtras.h>
 
 namespace AK {
@@ -17,24 +18,94 @@ namespace AK {
 // you are stuck with simple iterators to a container and you don't have access
 // to the container itself.
 //
-// We use a cutoff to insertion sort for partitions of size 7 or smaller.
+// Like introsort, both quick sorts keep track of how deep they went, and switch
+// to a heap sort for partitions that took too many steps to get to. That way,
+// inputs that keep hitting bad pivots still take no more than O(n log n) time.
+// Inputs that are already sorted (or sorted in reverse) are recognized in a
+// single pass, as that's what a lot of callers hand us when re-sorting a list.
+//
+// We use a cutoff to insertion sort for partitions of size 16 or smaller.
 // The idea is to avoid recursion for small partitions.
-// The value 7 here is a magic number. According to princeton's CS algorithm class
-// a value between 5 and 15 should work well in most situations:
-// https://algs4.cs.princeton.edu/23quicksort/
+// According to princeton's CS algorithm class a value between 5 and 15
+// should work well in most situations: https://algs4.cs.princeton.edu/23quicksort/
+// NOTE: We go a bit above that, as the partitioning steps compare each element
+//       against two pivots, which makes them more expensive than insertion sort.
+
+static constexpr int INSERTION_SORT_CUTOFF = 16;
 
-static constexpr int INSERTION_SORT_CUTOFF = 7;
+namespace Detail {
 
+// Sorts col[start..end] (with `end` inclusive!) by turning it into a max-heap and popping elements off it.
 template<typename Collection, typename LessThan>
-void dual_pivot_quick_sort(Collection& col, int start, int end, LessThan less_than)
+void heap_sort(Collection& col, int start, int end, LessThan& less_than)
 {
-    if ((end + 1) - start <= INSERTION_SORT_CUTOFF) {
-        AK::insertion_sort(col, start, end, less_than);
-        return;
+    int size = end - start + 1;
+    auto sift_down = [&](int root, int heap_size) {
+        for (;;) {
+            int child = 2 * root + 1;
+            if (child >= heap_size)
+                return;
+            if (child + 1 < heap_size && less_than(col[start + child], col[start + child + 1]))
+                ++child;
+            if (!less_than(col[start + root], col[start + child]))
+                return;
+            swap(col[start + root], col[start + child]);
+            root = child;
+        }
+    };
+
+    for (int i = size / 2 - 1; i >= 0; --i)
+        sift_down(i, size);
+    for (int i = size - 1; i > 0; --i) {
+        swap(col[start], col[start + i]);
+        sift_down(0, i);
     }
+}
 
+// Returns true if col[start..end] was already sorted, or was sorted in reverse and has been reversed.
+template<typename Collection, typename LessThan>
+bool sort_if_presorted(Collection& col, int start, int end, LessThan& less_than)
+{
+    if (less_than(col[start + 1], col[start])) {
+        // Only strictly descending runs can be reversed, reversing equal elements could break a stable sort
+        // that the caller may have done before.
+        for (int i = start + 1; i < end; ++i) {
+            if (!less_than(col[i + 1], col[i]))
+                return false;
+        }
+        for (int i = start, j = end; i < j; ++i, --j)
+            swap(col[i], col[j]);
+        return true;
+    }
+    for (int i = start + 1; i < end; ++i) {
+        if (less_than(col[i + 1], col[i]))
+            return false;
+    }
+    return true;
+}
+
+inline int quick_sort_depth_limit(size_t size)
+{
+    // NOTE: This is the same limit that introsort uses, a balanced quick sort needs about log2(n) levels.
+    return 2 * static_cast<int>(AK::log2(size));
+}
+
+template<typename Collection, typename LessThan>
+void dual_pivot_quick_sort_impl(Collection& col, int start, int end, LessThan& less_than, int depth_limit)
+{
     while (start < end) {
         int size = end - start + 1;
+        if (size <= INSERTION_SORT_CUTOFF) {
+            AK::insertion_sort(col, start, end, less_than);
+            return;
+        }
+        // We keep getting unbalanced partitions, maybe because the input was made to defeat our pivot choice.
+        // Bail out to a heap sort, which is slower on average but never worse than O(n log n).
+        if (depth_limit-- == 0) {
+            heap_sort(col, start, end, less_than);
+            return;
+        }
+
         if (size > 3) {
             int third = size / 3;
             if (less_than(col[start + third], col[end - third])) {
@@ -88,30 +159,60 @@ void dual_pivot_quick_sort(Collection& col, int start, int end, LessThan less_th
         int right_size = (end + 1) - (right_pointer + 1);
 
         if (left_size >= middle_size && left_size >= right_size) {
-            dual_pivot_quick_sort(col, left_pointer + 1, right_pointer - 1, less_than);
-            dual_pivot_quick_sort(col, right_pointer + 1, end, less_than);
+            dual_pivot_quick_sort_impl(col, left_pointer + 1, right_pointer - 1, less_than, depth_limit);
+            dual_pivot_quick_sort_impl(col, right_pointer + 1, end, less_than, depth_limit);
             end = left_pointer - 1;
         } else if (middle_size >= right_size) {
-            dual_pivot_quick_sort(col, start, left_pointer - 1, less_than);
-            dual_pivot_quick_sort(col, right_pointer + 1, end, less_than);
+            dual_pivot_quick_sort_impl(col, start, left_pointer - 1, less_than, depth_limit);
+            dual_pivot_quick_sort_impl(col, right_pointer + 1, end, less_than, depth_limit);
             start = left_pointer + 1;
             end = right_pointer - 1;
         } else {
-            dual_pivot_quick_sort(col, start, left_pointer - 1, less_than);
-            dual_pivot_quick_sort(col, left_pointer + 1, right_pointer - 1, less_than);
+            dual_pivot_quick_sort_impl(col, start, left_pointer - 1, less_than, depth_limit);
+            dual_pivot_quick_sort_impl(col, left_pointer + 1, right_pointer - 1, less_than, depth_limit);
             start = right_pointer + 1;
         }
     }
 }
 
+}
+
+template<typename Collection, typename LessThan>
+void dual_pivot_quick_sort(Collection& col, int start, int end, LessThan less_than)
+{
+    if ((end + 1) - start <= INSERTION_SORT_CUTOFF) {
+        AK::insertion_sort(col, start, end, less_than);
+        return;
+    }
+
+    if (Detail::sort_if_presorted(col, start, end, less_than))
+        return;
+
+    Detail::dual_pivot_quick_sort_impl(col, start, end, less_than, Detail::quick_sort_depth_limit((end + 1) - start));
+}
+
+namespace Detail {
+
+template<typename Iterator>
+struct IteratorRange {
+    Iterator start;
+    decltype(auto) operator[](int index) { return *(start + index); }
+};
+
 template<typename Iterator, typename LessThan>
-void single_pivot_quick_sort(Iterator start, Iterator end, LessThan less_than)
+void single_pivot_quick_sort_impl(Iterator start, Iterator end, LessThan less_than, int depth_limit)
 {
     for (;;) {
         int size = end - start;
         if (size <= 1)
             return;
 
+        if (depth_limit-- == 0) {
+            IteratorRange<Iterator> range { start };
+            heap_sort(range, 0, size - 1, less_than);
+            return;
+        }
+
         int pivot_point = size / 2;
         if (pivot_point)
             swap(*(start + pivot_point), *start);
@@ -130,15 +231,23 @@ void single_pivot_quick_sort(Iterator start, Iterator end, LessThan less_than)
         // Recur into the shorter part of the remaining data
         // to ensure a stack depth of at most log(n).
         if (i > size / 2) {
-            single_pivot_quick_sort(start + i, end, less_than);
+            single_pivot_quick_sort_impl(start + i, end, less_than, depth_limit);
             end = start + i - 1;
         } else {
-            single_pivot_quick_sort(start, start + i - 1, less_than);
+            single_pivot_quick_sort_impl(start, start + i - 1, less_than, depth_limit);
             start = start + i;
         }
     }
 }
 
+}
+
+template<typename Iterator, typename LessThan>
+void single_pivot_quick_sort(Iterator start, Iterator end, LessThan less_than)
+{
+    Detail::single_pivot_quick_sort_impl(start, end, move(less_than), Detail::quick_sort_depth_limit(end - start));
+}
+
 template<typename Iterator>
 void quick_sort(Iterator start, Iterator end)
 {
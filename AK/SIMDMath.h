@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/BitCast.h>
 #include <AK/Math.h>
 #include <AK/SIMD.h>
 #include <AK/SIMDExtras.h>
@@ -55,17 +56,173 @@ ALWAYS_INLINE static f32x4 clamp(f32x4 v, float min, float max)
     return v < min ? min : (v > max ? max : v);
 }
 
-ALWAYS_INLINE static f32x4 exp(f32x4 v)
+// Vectorized versions of expf(), logf(), sinf(), cosf() and powf(), for 4 or 8 floats at a time.
+// These are accurate to a few ULP instead of being correctly rounded, and results that would be
+// subnormal are flushed to zero. Special values (NaN, infinities, zero) are handled like libm does.
+// NOTE: The polynomials are the single precision ones from the Cephes library.
+
+namespace Detail {
+
+template<typename T>
+struct IntegerVectorFor;
+template<>
+struct IntegerVectorFor<f32x4> {
+    using Type = i32x4;
+};
+template<>
+struct IntegerVectorFor<f32x8> {
+    using Type = i32x8;
+};
+
+template<typename T>
+concept FloatVector = IsOneOf<T, f32x4, f32x8>;
+
+template<FloatVector T>
+using IntegerVector = typename IntegerVectorFor<T>::Type;
+
+template<FloatVector T>
+ALWAYS_INLINE static T splat(float value)
 {
-    // FIXME: This should be replaced with a vectorized algorithm instead of calling the scalar expf 4 times
-    return f32x4 {
-        expf(v[0]),
-        expf(v[1]),
-        expf(v[2]),
-        expf(v[3]),
-    };
+    return T {} + value;
+}
+
+// Rounds to the nearest integer, for arguments within range [INT_MIN, INT_MAX].
+template<FloatVector T>
+ALWAYS_INLINE static IntegerVector<T> round_to_integer(T v)
+{
+    return __builtin_convertvector(v + (v < 0.0f ? splat<T>(-0.5f) : splat<T>(0.5f)), IntegerVector<T>);
+}
+
+template<FloatVector T>
+ALWAYS_INLINE static T exp(T v)
+{
+    using I = IntegerVector<T>;
+
+    // exp(x) = 2^n * exp(r), with x = n * ln(2) + r and |r| <= ln(2) / 2.
+    auto x = v > 88.72283935546875f ? splat<T>(88.72283935546875f) : v;
+    x = x < -87.3365447504f ? splat<T>(-87.3365447504f) : x;
+    auto n = round_to_integer(x * 1.44269504088896341f);
+    auto fn = __builtin_convertvector(n, T);
+    // NOTE: ln(2) is split in two, so that n * 0.693359375 is exact.
+    x = x - fn * 0.693359375f;
+    x = x + fn * 2.12194440e-4f;
+
+    auto z = x * x;
+    auto y = ((((1.9875691500e-4f * x + 1.3981999507e-3f) * x + 8.3334519073e-3f) * x + 4.1665795894e-2f) * x + 1.6666665459e-1f) * x + 5.0000001201e-1f;
+    y = y * z + x + 1.0f;
+
+    // NOTE: 2^128 doesn't fit into a float, so for the largest results we multiply by 2^127 and then by 2.
+    I too_big = n > 127;
+    n = n + too_big;
+    auto scale = bit_cast<T>((n + 127) << 23);
+    auto result = y * scale * (too_big ? splat<T>(2.0f) : splat<T>(1.0f));
+
+    result = v > 88.72283935546875f ? splat<T>(__builtin_huge_valf()) : result;
+    result = v < -87.3365447504f ? splat<T>(0.0f) : result;
+    return v != v ? v : result;
+}
+
+template<FloatVector T>
+ALWAYS_INLINE static T log(T v)
+{
+    using I = IntegerVector<T>;
+
+    // log(x) = e * ln(2) + log(m), with x = 2^e * m and sqrt(2)/2 <= m < sqrt(2).
+    // Subnormal inputs are scaled up into the normal range first.
+    I is_subnormal = v < 1.17549435e-38f;
+    auto x = is_subnormal ? v * 8388608.0f : v;
+    auto bits = bit_cast<I>(x);
+    auto e = ((bits >> 23) & 0xff) - 126 - (is_subnormal & 23);
+    auto m = bit_cast<T>((bits & 0x7fffff) | 0x3f000000);
+
+    I is_small = m < 0.707106781186547524f;
+    e = e + is_small;
+    m = (is_small ? m + m : m) - 1.0f;
+    auto fe = __builtin_convertvector(e, T);
+
+    auto z = m * m;
+    auto y = ((((((((7.0376836292e-2f * m - 1.1514610310e-1f) * m + 1.1676998740e-1f) * m - 1.2420140846e-1f) * m + 1.4249322787e-1f) * m - 1.6668057665e-1f) * m + 2.0000714765e-1f) * m - 2.4999993993e-1f) * m + 3.3333331174e-1f) * m * z;
+    y = y - fe * 2.12194440e-4f;
+    y = y - 0.5f * z;
+    auto result = m + y + fe * 0.693359375f;
+
+    result = v == __builtin_huge_valf() ? v : result;
+    result = v == 0.0f ? splat<T>(-__builtin_huge_valf()) : result;
+    return (v < 0.0f || v != v) ? splat<T>(__builtin_nanf("")) : result;
+}
+
+enum class Trigonometric {
+    Sine,
+    Cosine,
+};
+
+template<Trigonometric function, FloatVector T>
+ALWAYS_INLINE static T sin_or_cos(T v)
+{
+    using I = IntegerVector<T>;
+
+    // NOTE: The range reduction below loses precision for large arguments, so those lanes go through the scalar code.
+    constexpr float reduction_limit = 8192.0f;
+
+    auto x = v < 0.0f ? -v : v;
+    // Find the octant we're in, and map it onto [-pi/4, pi/4] with j being an even number.
+    auto j = __builtin_convertvector(x * 1.27323954473516f, I);
+    j = (j + 1) & ~1;
+    auto y = __builtin_convertvector(j, T);
+    x = ((x - y * 0.78515625f) - y * 2.4187564849853515625e-4f) - y * 3.77489497744594108e-8f;
+
+    I sign_flip;
+    if constexpr (function == Trigonometric::Sine) {
+        sign_flip = ((j & 4) != 0) ^ (v < 0.0f);
+    } else {
+        j = j - 2;
+        sign_flip = (j & 4) == 0;
+    }
+
+    auto z = x * x;
+    auto cosine = ((2.443315711809948e-5f * z - 1.388731625493765e-3f) * z + 4.166664568298827e-2f) * z * z - 0.5f * z + 1.0f;
+    auto sine = ((-1.9515295891e-4f * z + 8.3321608736e-3f) * z - 1.6666654611e-1f) * z * x + x;
+    auto result = (j & 2) == 0 ? sine : cosine;
+    result = sign_flip ? -result : result;
+
+    I needs_scalar = ((v < reduction_limit) & (v > -reduction_limit)) == 0;
+    for (size_t i = 0; i < sizeof(T) / sizeof(float); ++i) {
+        if (needs_scalar[i]) [[unlikely]]
+            result[i] = function == Trigonometric::Sine ? sinf(v[i]) : cosf(v[i]);
+    }
+    return result;
 }
 
+template<FloatVector T>
+ALWAYS_INLINE static T pow(T base, T exponent)
+{
+    using I = IntegerVector<T>;
+
+    // NOTE: pow(x, y) = exp(y * log(x)) only works for positive, finite bases and finite exponents.
+    //       Everything else is rare enough to go through the scalar code.
+    auto result = exp(exponent * log(base));
+    I is_simple = (base > 0.0f) & (base < __builtin_huge_valf()) & (exponent < __builtin_huge_valf()) & (exponent > -__builtin_huge_valf());
+    I needs_scalar = is_simple == 0;
+    for (size_t i = 0; i < sizeof(T) / sizeof(float); ++i) {
+        if (needs_scalar[i]) [[unlikely]]
+            result[i] = powf(base[i], exponent[i]);
+    }
+    return result;
+}
+
+}
+
+ALWAYS_INLINE static f32x4 exp(f32x4 v) { return Detail::exp(v); }
+ALWAYS_INLINE static f32x8 exp(f32x8 v) { return Detail::exp(v); }
+ALWAYS_INLINE static f32x4 log(f32x4 v) { return Detail::log(v); }
+ALWAYS_INLINE static f32x8 log(f32x8 v) { return Detail::log(v); }
+ALWAYS_INLINE static f32x4 sin(f32x4 v) { return Detail::sin_or_cos<Detail::Trigonometric::Sine>(v); }
+ALWAYS_INLINE static f32x8 sin(f32x8 v) { return Detail::sin_or_cos<Detail::Trigonometric::Sine>(v); }
+ALWAYS_INLINE static f32x4 cos(f32x4 v) { return Detail::sin_or_cos<Detail::Trigonometric::Cosine>(v); }
+ALWAYS_INLINE static f32x8 cos(f32x8 v) { return Detail::sin_or_cos<Detail::Trigonometric::Cosine>(v); }
+ALWAYS_INLINE static f32x4 pow(f32x4 base, f32x4 exponent) { return Detail::pow(base, exponent); }
+ALWAYS_INLINE static f32x8 pow(f32x8 base, f32x8 exponent) { return Detail::pow(base, exponent); }
+
 ALWAYS_INLINE static f32x4 exp_approximate(f32x4 v)
 {
     static constexpr int number_of_iterations = 10;
@@ -84,6 +84,13 @@ public:
         return m_hash;
     }
 
+    // NOTE: This is for callers that have already hashed the same bytes, and must match what compute_hash() would produce.
+    void set_precomputed_hash(unsigned hash) const
+    {
+        m_hash = hash;
+        m_has_hash = true;
+    }
+
     bool is_fly_string() const { return m_is_fly_string; }
     void set_fly_string(bool is_fly_string) const { m_is_fly_string = is_fly_string; }
 
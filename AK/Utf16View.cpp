@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Array.h>
 #include <AK/CharacterTypes.h>
 #include <AK/Concepts.h>
 #include <AK/StringBuilder.h>
@@ -12,6 +13,10 @@
 #include <AK/Utf32View.h>
 #include <AK/Utf8View.h>
 
+#ifdef __SSE2__
+#    include <emmintrin.h>
+#endif
+
 namespace AK {
 
 static constexpr u16 high_surrogate_min = 0xd800;
@@ -21,31 +26,66 @@ static constexpr u16 low_surrogate_max = 0xdfff;
 static constexpr u32 replacement_code_point = 0xfffd;
 static constexpr u32 first_supplementary_plane_code_point = 0x10000;
 
-template<OneOf<Utf8View, Utf32View> UtfViewType>
-static ErrorOr<Utf16Data> to_utf16_impl(UtfViewType const& view)
+static void widen_ascii_to_utf16(u16* code_units, u8 const* bytes, size_t length)
 {
-    Utf16Data utf16_data;
-    TRY(utf16_data.try_ensure_capacity(view.length()));
-
-    for (auto code_point : view)
-        TRY(code_point_to_utf16(utf16_data, code_point));
+    size_t i = 0;
+
+#ifdef __SSE2__
+    auto zero = _mm_setzero_si128();
+    for (; i + 16 <= length; i += 16) {
+        auto chunk = _mm_loadu_si128(reinterpret_cast<__m128i const*>(bytes + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(code_units + i), _mm_unpacklo_epi8(chunk, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(code_units + i + 8), _mm_unpackhi_epi8(chunk, zero));
+    }
+#endif
 
-    return utf16_data;
+    for (; i < length; ++i)
+        code_units[i] = bytes[i];
 }
 
 ErrorOr<Utf16Data> utf8_to_utf16(StringView utf8_view)
 {
-    return to_utf16_impl(Utf8View { utf8_view });
+    return utf8_to_utf16(Utf8View { utf8_view });
 }
 
 ErrorOr<Utf16Data> utf8_to_utf16(Utf8View const& utf8_view)
 {
-    return to_utf16_impl(utf8_view);
+    Utf16Data utf16_data;
+    TRY(utf16_data.try_ensure_capacity(utf8_view.length()));
+
+    auto const* bytes = utf8_view.bytes();
+    auto byte_length = utf8_view.byte_length();
+
+    for (size_t offset = 0; offset < byte_length;) {
+        // OPTIMIZATION: ASCII bytes map to UTF-16 code units of the same value, so we widen runs of them in bulk.
+        auto ascii_length = Detail::count_leading_ascii_bytes(reinterpret_cast<char const*>(bytes + offset), byte_length - offset);
+        if (ascii_length > 0) {
+            auto size = utf16_data.size();
+            TRY(utf16_data.try_resize_and_keep_capacity(size + ascii_length));
+            widen_ascii_to_utf16(utf16_data.data() + size, bytes + offset, ascii_length);
+            offset += ascii_length;
+            continue;
+        }
+
+        // NOTE: We let the iterator decode anything else, so that invalid sequences are replaced exactly as they would be when iterating.
+        auto iterator = utf8_view.iterator_at_byte_offset_without_validation(offset);
+        TRY(code_point_to_utf16(utf16_data, *iterator));
+        ++iterator;
+        offset = iterator.ptr() - bytes;
+    }
+
+    return utf16_data;
 }
 
 ErrorOr<Utf16Data> utf32_to_utf16(Utf32View const& utf32_view)
 {
-    return to_utf16_impl(utf32_view);
+    Utf16Data utf16_data;
+    TRY(utf16_data.try_ensure_capacity(utf32_view.length()));
+
+    for (auto code_point : utf32_view)
+        TRY(code_point_to_utf16(utf16_data, code_point));
+
+    return utf16_data;
 }
 
 ErrorOr<void> code_point_to_utf16(Utf16Data& string, u32 code_point)
@@ -86,32 +126,76 @@ ErrorOr<ByteString> Utf16View::to_byte_string(AllowInvalidCodeUnits allow_invali
     return TRY(to_utf8(allow_invalid_code_units)).to_byte_string();
 }
 
+static size_t count_leading_ascii_code_units(u16 const* code_units, size_t length)
+{
+    size_t offset = 0;
+
+    // OPTIMIZATION: Look at 8 code units at a time by checking the high bits of each one within two machine words.
+    static constexpr u64 non_ascii_bits = 0xff80ff80ff80ff80ull;
+    for (; offset + 8 <= length; offset += 8) {
+        u64 first_word;
+        u64 second_word;
+        __builtin_memcpy(&first_word, code_units + offset, sizeof(u64));
+        __builtin_memcpy(&second_word, code_units + offset + 4, sizeof(u64));
+        if (((first_word | second_word) & non_ascii_bits) != 0)
+            break;
+    }
+
+    while (offset < length && code_units[offset] < 0x80)
+        ++offset;
+    return offset;
+}
+
+static ErrorOr<void> append_ascii_code_units(StringBuilder& builder, u16 const* code_units, size_t length)
+{
+    Array<char, 128> buffer;
+
+    while (length > 0) {
+        auto chunk_length = min(length, buffer.size());
+        for (size_t i = 0; i < chunk_length; ++i)
+            buffer[i] = static_cast<char>(code_units[i]);
+        TRY(builder.try_append(buffer.data(), chunk_length));
+
+        code_units += chunk_length;
+        length -= chunk_length;
+    }
+
+    return {};
+}
+
 ErrorOr<String> Utf16View::to_utf8(AllowInvalidCodeUnits allow_invalid_code_units) const
 {
-    StringBuilder builder;
-
-    if (allow_invalid_code_units == AllowInvalidCodeUnits::Yes) {
-        for (auto const* ptr = begin_ptr(); ptr < end_ptr(); ++ptr) {
-            if (is_high_surrogate(*ptr)) {
-                auto const* next = ptr + 1;
-
-                if ((next < end_ptr()) && is_low_surrogate(*next)) {
-                    auto code_point = decode_surrogate_pair(*ptr, *next);
-                    TRY(builder.try_append_code_point(code_point));
-                    ++ptr;
-                    continue;
-                }
+    StringBuilder builder(length_in_code_units());
+
+    for (auto const* ptr = begin_ptr(); ptr < end_ptr();) {
+        // OPTIMIZATION: ASCII code units map to UTF-8 bytes of the same value, so we narrow runs of them in bulk.
+        if (auto ascii_length = count_leading_ascii_code_units(ptr, end_ptr() - ptr); ascii_length > 0) {
+            TRY(append_ascii_code_units(builder, ptr, ascii_length));
+            ptr += ascii_length;
+            continue;
+        }
+
+        if (is_high_surrogate(*ptr)) {
+            auto const* next = ptr + 1;
+
+            if ((next < end_ptr()) && is_low_surrogate(*next)) {
+                auto code_point = decode_surrogate_pair(*ptr, *next);
+                TRY(builder.try_append_code_point(code_point));
+                ptr += 2;
+                continue;
             }
+        }
 
+        // NOTE: This matches Utf16CodePointIterator, which replaces unpaired surrogates.
+        if (allow_invalid_code_units == AllowInvalidCodeUnits::No && (is_high_surrogate(*ptr) || is_low_surrogate(*ptr)))
+            TRY(builder.try_append_code_point(replacement_code_point));
+        else
             TRY(builder.try_append_code_point(static_cast<u32>(*ptr)));
-        }
-        return builder.to_string_without_validation();
+        ++ptr;
     }
 
-    for (auto code_point : *this)
-        TRY(builder.try_append_code_point(code_point));
-
-    return builder.to_string();
+    // NOTE: Unless we were asked to keep unpaired surrogates, everything we appended is valid UTF-8 by construction.
+    return builder.to_string_without_validation();
 }
 
 size_t Utf16View::length_in_code_points() const
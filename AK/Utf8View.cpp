@@ -74,11 +74,19 @@ size_t Utf8View::calculate_length() const
 {
     size_t length = 0;
 
-    for (size_t i = 0; i < m_string.length(); ++length) {
+    for (size_t i = 0; i < m_string.length();) {
+        // OPTIMIZATION: Every ASCII byte is a code point of its own, so we can count runs of them in bulk.
+        if (auto ascii_length = Detail::count_leading_ascii_bytes(m_string.characters_without_null_termination() + i, m_string.length() - i); ascii_length > 0) {
+            i += ascii_length;
+            length += ascii_length;
+            continue;
+        }
+
         auto [byte_length, code_point, is_valid] = decode_leading_byte(static_cast<u8>(m_string[i]));
 
         // Similar to Utf8CodePointIterator::operator++, if the byte is invalid, try the next byte.
         i += is_valid ? byte_length : 1;
+        ++length;
     }
 
     return length;
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <AK/Format.h>
+#include <AK/StdLibExtras.h>
 #include <AK/StringView.h>
 #include <AK/Types.h>
 
@@ -19,6 +20,33 @@ namespace AK {
 
 class Utf8View;
 
+namespace Detail {
+
+// Returns how many of the given characters are ASCII before the first one that isn't.
+constexpr size_t count_leading_ascii_bytes(char const* characters, size_t length)
+{
+    size_t offset = 0;
+
+    // OPTIMIZATION: Look at 16 bytes at a time by checking the high bit of each byte within two machine words.
+    if (!is_constant_evaluated()) {
+        static constexpr u64 high_bits = 0x8080808080808080ull;
+        for (; offset + 16 <= length; offset += 16) {
+            u64 first_word;
+            u64 second_word;
+            __builtin_memcpy(&first_word, characters + offset, sizeof(u64));
+            __builtin_memcpy(&second_word, characters + offset + sizeof(u64), sizeof(u64));
+            if (((first_word | second_word) & high_bits) != 0)
+                break;
+        }
+    }
+
+    while (offset < length && static_cast<u8>(characters[offset]) < 0x80)
+        ++offset;
+    return offset;
+}
+
+}
+
 class Utf8CodePointIterator {
     friend class Utf8View;
 
@@ -134,26 +162,18 @@ public:
 
     constexpr bool validate(size_t& valid_bytes, AllowSurrogates surrogates = AllowSurrogates::Yes) const
     {
+        auto const* characters = m_string.characters_without_null_termination();
+        auto length = m_string.length();
         valid_bytes = 0;
 
-        for (auto it = m_string.begin(); it != m_string.end(); ++it) {
-            auto [byte_length, code_point, is_valid] = decode_leading_byte(static_cast<u8>(*it));
-            if (!is_valid)
-                return false;
-
-            for (size_t i = 1; i < byte_length; ++i) {
-                if (++it == m_string.end())
-                    return false;
+        while (valid_bytes < length) {
+            // OPTIMIZATION: Most text is mostly ASCII, which we can skip over in bulk without decoding anything.
+            valid_bytes += Detail::count_leading_ascii_bytes(characters + valid_bytes, length - valid_bytes);
+            if (valid_bytes == length)
+                break;
 
-                auto [code_point_bits, is_valid] = decode_continuation_byte(static_cast<u8>(*it));
-                if (!is_valid)
-                    return false;
-
-                code_point <<= 6;
-                code_point |= code_point_bits;
-            }
-
-            if (!is_valid_code_point(code_point, byte_length, surrogates))
+            auto byte_length = well_formed_multi_byte_sequence_length(characters + valid_bytes, length - valid_bytes, surrogates);
+            if (byte_length == 0)
                 return false;
 
             valid_bytes += byte_length;
@@ -221,6 +241,48 @@ private:
         return { .is_valid = false };
     }
 
+    // Returns the length of the well-formed multi-byte sequence at the start of the given characters, or 0 if there is none.
+    // This follows the Unicode Standard, Table 3-7 "Well-Formed UTF-8 Byte Sequences", which rejects overlong encodings
+    // and code points above U+10FFFF just by looking at the range of the first two bytes.
+    static constexpr size_t well_formed_multi_byte_sequence_length(char const* characters, size_t length, AllowSurrogates surrogates)
+    {
+        auto byte_at = [&](size_t index) { return static_cast<u8>(characters[index]); };
+
+        auto leading_byte = byte_at(0);
+        size_t byte_length = 0;
+        u8 second_byte_min = 0x80;
+        u8 second_byte_max = 0xBF;
+
+        if (leading_byte >= 0xC2 && leading_byte <= 0xDF) {
+            byte_length = 2;
+        } else if (leading_byte >= 0xE0 && leading_byte <= 0xEF) {
+            byte_length = 3;
+            if (leading_byte == 0xE0)
+                second_byte_min = 0xA0;
+            else if (leading_byte == 0xED && surrogates == AllowSurrogates::No)
+                second_byte_max = 0x9F;
+        } else if (leading_byte >= 0xF0 && leading_byte <= 0xF4) {
+            byte_length = 4;
+            if (leading_byte == 0xF0)
+                second_byte_min = 0x90;
+            else if (leading_byte == 0xF4)
+                second_byte_max = 0x8F;
+        } else {
+            return 0;
+        }
+
+        if (length < byte_length)
+            return 0;
+        if (byte_at(1) < second_byte_min || byte_at(1) > second_byte_max)
+            return 0;
+        for (size_t i = 2; i < byte_length; ++i) {
+            if ((byte_at(i) & 0xC0) != 0x80)
+                return 0;
+        }
+
+        return byte_length;
+    }
+
     static constexpr bool is_valid_code_point(u32 code_point, size_t byte_length, AllowSurrogates surrogates = AllowSurrogates::Yes)
     {
         if (surrogates == AllowSurrogates::No && byte_length == 3 && code_point >= 0xD800 && code_point <= 0xDFFF)
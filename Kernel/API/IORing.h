@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Types.h>
+
+// An IO ring is a pair of queues in memory that is shared between a process and the kernel.
+// The process puts requests into the submission queue (SQ) and tells the kernel about them with
+// io_ring_enter(), which can submit many requests and wait for completions in a single syscall.
+// Results are put into the completion queue (CQ) and can be consumed without entering the kernel.
+//
+// The shared memory is obtained by mmap()ing the IO ring file descriptor with MAP_SHARED, and
+// starts with an io_ring_header. The offsets of the SQE and CQE arrays are returned by io_ring_setup().
+// Both queues are indexed with free-running counters, the slot of a counter is `counter & (entries - 1)`.
+
+#define IO_RING_MAX_ENTRIES 4096
+
+// Use the current file offset (and advance it) instead of an explicit one.
+#define IO_RING_CURRENT_OFFSET (~(u64)0)
+
+// io_ring_enter() flags
+#define IO_RING_ENTER_GETEVENTS (1 << 0)
+
+enum IORingOpcode : u8 {
+    IO_RING_OP_NOP = 0,
+    IO_RING_OP_READ,
+    IO_RING_OP_WRITE,
+    IO_RING_OP_ACCEPT,
+    IO_RING_OP_SEND,
+    IO_RING_OP_RECV,
+};
+
+struct io_ring_sqe {
+    u8 opcode;
+    u8 reserved0;
+    u16 reserved1;
+    i32 fd;
+    // READ and WRITE: The offset in the file, or IO_RING_CURRENT_OFFSET.
+    u64 offset;
+    // READ, WRITE, SEND and RECV: The buffer in the submitting process.
+    u64 address;
+    u32 length;
+    // ACCEPT: SOCK_NONBLOCK and SOCK_CLOEXEC, SEND and RECV: MSG_* flags.
+    u32 op_flags;
+    u64 user_data;
+};
+
+struct io_ring_cqe {
+    u64 user_data;
+    // The return value that the equivalent syscall would have had, or a negated errno.
+    i32 result;
+    u32 flags;
+};
+
+struct io_ring_header {
+    // Written by the kernel as it consumes submissions.
+    u32 sq_head;
+    // Written by the process as it produces submissions.
+    u32 sq_tail;
+    // Written by the process as it consumes completions.
+    u32 cq_head;
+    // Written by the kernel as it produces completions.
+    u32 cq_tail;
+    u32 sq_entries;
+    u32 cq_entries;
+    u32 reserved[2];
+};
+
+struct io_ring_params {
+    // In: The number of SQ entries to allocate (rounded up to a power of two), out: the actual number.
+    u32 sq_entries;
+    u32 cq_entries;
+    u32 flags;
+    // The size of the shared memory that has to be mapped.
+    u32 ring_size;
+    u32 sq_offset;
+    u32 cq_offset;
+};
@@ -12,6 +12,10 @@ extern "C" {
 
 #define TCP_NODELAY 10
 #define TCP_MAXSEG 11
+#define TCP_CONGESTION 12
+
+// The maximum length of a congestion control algorithm name, including the null terminator.
+#define TCP_CA_NAME_MAX 16
 
 #ifdef __cplusplus
 }
@@ -33,6 +33,11 @@ enum {
     PERF_EVENT_SYSCALL = 16384,
     PERF_EVENT_SIGNPOST = 32768,
     PERF_EVENT_FILESYSTEM = 65536,
+    // Samples taken every so many hardware events, if the processor can count them.
+    PERF_EVENT_CYCLES = 131072,
+    PERF_EVENT_INSTRUCTIONS = 262144,
+    PERF_EVENT_CACHE_MISS = 524288,
+    PERF_EVENT_BRANCH_MISS = 1048576,
 };
 
 #define PERF_EVENT_MASK_ALL (~0ull)
@@ -70,6 +70,7 @@ typedef struct __pthread_mutex_t {
     pthread_t owner;
     int level;
     int type;
+    int spin_count;
 } pthread_mutex_t;
 
 typedef void* pthread_attr_t;
@@ -84,7 +85,9 @@ typedef struct __pthread_cond_t {
 } pthread_cond_t;
 
 typedef uint64_t pthread_rwlock_t;
-typedef void* pthread_rwlockattr_t;
+typedef struct __pthread_rwlockattr_t {
+    int kind;
+} pthread_rwlockattr_t;
 typedef struct __pthread_spinlock_t {
     int m_lock;
 } pthread_spinlock_t;
@@ -27,6 +27,9 @@ struct VirGLCommandBuffer {
     u32 num_elems;
 };
 
+// Larger command buffers are rejected by VIRGL_IOCTL_SUBMIT_CMD with E2BIG.
+#define VIRGL_MAX_COMMAND_BUFFER_ELEMS (16 * 1024)
+
 #define VIRGL_DATA_DIR_GUEST_TO_HOST 1
 #define VIRGL_DATA_DIR_HOST_TO_GUEST 2
 
@@ -11,6 +11,7 @@
 namespace Kernel {
 #if ARCH(X86_64)
 u64 msi_address_register(u8 destination_id, bool redirection_hint, bool destination_mode);
+u64 msi_address_register_for_processor(u32 processor_id);
 u32 msi_data_register(u8 vector, bool level_trigger, bool assert);
 u32 msix_vector_control_register(u32 vector_control, bool mask);
 void msi_signal_eoi();
@@ -21,6 +22,12 @@ void msi_signal_eoi();
     return 0;
 }
 
+[[maybe_unused]] static u64 msi_address_register_for_processor([[maybe_unused]] u32 processor_id)
+{
+    TODO_AARCH64();
+    return 0;
+}
+
 [[maybe_unused]] static u32 msi_data_register([[maybe_unused]] u8 vector, [[maybe_unused]] bool level_trigger, [[maybe_unused]] bool assert)
 {
     TODO_AARCH64();
@@ -75,6 +75,9 @@ public:
 
     [[noreturn]] static void halt();
     void wait_for_interrupt() const;
+    // NOTE: This must be called with interrupts disabled. It doesn't miss an interrupt that arrived
+    //       before it was called, and returns with interrupts enabled after handling the first one.
+    void enable_interrupts_and_wait_for_interrupt() const;
     ALWAYS_INLINE static void pause();
     ALWAYS_INLINE static void wait_check();
 
@@ -144,6 +147,8 @@ public:
     }
     void idle_begin() const;
     void idle_end() const;
+    ALWAYS_INLINE bool is_tick_stopped() const { return m_tick_stopped; }
+    ALWAYS_INLINE void set_tick_stopped(bool value) { m_tick_stopped = value; }
     u64 time_spent_idle() const;
     ALWAYS_INLINE static u64 read_cpu_counter();
 
@@ -197,6 +202,9 @@ private:
     FlatPtr m_in_scheduler;
     FlatPtr m_invoke_scheduler_async;
 
+    // Whether this processor stopped its timer interrupts while being idle.
+    bool m_tick_stopped { false };
+
     SetOnce m_scheduler_initialized;
 
     DeferredCallPool m_deferred_call_pool {};
@@ -444,6 +444,15 @@ void ProcessorBase<T>::wait_for_interrupt() const
     asm("wfi");
 }
 
+template<typename T>
+void ProcessorBase<T>::enable_interrupts_and_wait_for_interrupt() const
+{
+    VERIFY_INTERRUPTS_DISABLED();
+    // NOTE: A pending interrupt ends the wfi even while interrupts are masked, it's taken once we unmask them.
+    asm volatile("wfi");
+    Processor::enable_interrupts();
+}
+
 template<typename T>
 Processor& ProcessorBase<T>::by_id(u32 id)
 {
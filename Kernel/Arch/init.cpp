@@ -11,6 +11,7 @@
 #include <Kernel/Arch/InterruptManagement.h>
 #include <Kernel/Arch/Processor.h>
 #include <Kernel/Boot/BootInfo.h>
+#include <Kernel/Boot/BootTrace.h>
 #include <Kernel/Boot/CommandLine.h>
 #include <Kernel/Boot/Multiboot.h>
 #include <Kernel/Bus/PCI/Access.h>
@@ -57,9 +58,11 @@
 #include <Kernel/Sections.h>
 #include <Kernel/Security/Random.h>
 #include <Kernel/Tasks/FinalizerTask.h>
+#include <Kernel/Tasks/PageZeroingTask.h>
 #include <Kernel/Tasks/Process.h>
 #include <Kernel/Tasks/Scheduler.h>
 #include <Kernel/Tasks/SyncTask.h>
+#include <Kernel/Tasks/WaitQueue.h>
 #include <Kernel/Tasks/WorkQueue.h>
 #include <Kernel/Time/TimeManagement.h>
 #include <Kernel/kstdio.h>
@@ -116,6 +119,9 @@ READONLY_AFTER_INIT VirtualConsole* tty0;
 
 ProcessID g_init_pid { 0 };
 
+static Atomic<bool> s_parallel_init_finished { false };
+static WaitQueue s_parallel_init_wait_queue;
+
 ALWAYS_INLINE static Processor& bsp_processor()
 {
     // This solves a problem where the bsp Processor instance
@@ -385,9 +391,12 @@ void init_stage2(void*)
 #endif
 
     // Initialize the PCI Bus as early as possible, for early boot (PCI based) serial logging
-    PCI::initialize();
-    if (!PCI::Access::is_disabled()) {
-        PCISerialDevice::detect();
+    {
+        BootTrace::Step step("PCI"sv);
+        PCI::initialize();
+        if (!PCI::Access::is_disabled()) {
+            PCISerialDevice::detect();
+        }
     }
 
     VirtualFileSystem::initialize();
@@ -407,26 +416,51 @@ void init_stage2(void*)
 #if ARCH(X86_64)
     VMWareBackdoor::the(); // don't wait until first mouse packet
 #endif
-    MUST(HIDManagement::initialize());
+    {
+        BootTrace::Step step("HID"sv);
+        MUST(HIDManagement::initialize());
+    }
 
-    GraphicsManagement::the().initialize();
-    ConsoleManagement::the().initialize();
+    {
+        BootTrace::Step step("Graphics"sv);
+        GraphicsManagement::the().initialize();
+        ConsoleManagement::the().initialize();
+    }
 
     SyncTask::spawn();
     FinalizerTask::spawn();
+    PageZeroingTask::spawn();
 
     auto boot_profiling = kernel_command_line().is_boot_profiling_enabled();
 
     if (!PCI::Access::is_disabled()) {
+        BootTrace::Step step("USB"sv);
         USB::USBManagement::initialize();
     }
     SysFSFirmwareDirectory::initialize();
 
     if (!PCI::Access::is_disabled()) {
+        BootTrace::Step step("VirtIO"sv);
         VirtIO::detect_pci_instances();
     }
 
-    NetworkingManagement::the().initialize();
+    // NOTE: Network and audio devices only depend on the PCI bus, and nothing else depends on them until
+    //       userspace starts. So instead of waiting for them, we bring them up on another processor while
+    //       this one goes looking for the boot device.
+    MUST(Process::create_kernel_process("Parallel Init Task"sv, [] {
+        {
+            BootTrace::Step step("Networking"sv);
+            NetworkingManagement::the().initialize();
+        }
+        {
+            BootTrace::Step step("Audio"sv);
+            AudioManagement::the().initialize();
+        }
+        s_parallel_init_finished.store(true);
+        s_parallel_init_wait_queue.wake_all();
+        Process::current().sys$exit(0);
+        VERIFY_NOT_REACHED();
+    }));
 
 #ifdef ENABLE_KERNEL_COVERAGE_COLLECTION
     (void)KCOVDevice::must_create().leak_ref();
@@ -439,22 +473,33 @@ void init_stage2(void*)
     (void)SelfTTYDevice::must_create().leak_ref();
     PTYMultiplexer::initialize();
 
-    AudioManagement::the().initialize();
-
     // Initialize all USB Drivers
-    for (auto* init_function = driver_init_table_start; init_function != driver_init_table_end; init_function++)
-        (*init_function)();
-
-    StorageManagement::the().initialize(kernel_command_line().is_nvme_polling_enabled());
-    for (int i = 0; i < 5; ++i) {
-        if (StorageManagement::the().determine_boot_device(kernel_command_line().root_device()))
-            break;
-        dbgln_if(STORAGE_DEVICE_DEBUG, "Boot device {} not found, sleeping 2 seconds", kernel_command_line().root_device());
-        (void)Thread::current()->sleep(Duration::from_seconds(2));
+    {
+        BootTrace::Step step("USB drivers"sv);
+        for (auto* init_function = driver_init_table_start; init_function != driver_init_table_end; init_function++)
+            (*init_function)();
     }
-    if (VirtualFileSystem::the().mount_root(StorageManagement::the().root_filesystem()).is_error()) {
-        PANIC("VirtualFileSystem::mount_root failed");
+
+    {
+        BootTrace::Step step("Storage"sv);
+        StorageManagement::the().initialize(kernel_command_line().is_nvme_polling_enabled());
+        for (int i = 0; i < 5; ++i) {
+            if (StorageManagement::the().determine_boot_device(kernel_command_line().root_device()))
+                break;
+            dbgln_if(STORAGE_DEVICE_DEBUG, "Boot device {} not found, sleeping 2 seconds", kernel_command_line().root_device());
+            (void)Thread::current()->sleep(Duration::from_seconds(2));
+        }
     }
+    {
+        BootTrace::Step step("Mounting root"sv);
+        if (VirtualFileSystem::the().mount_root(StorageManagement::the().root_filesystem()).is_error()) {
+            PANIC("VirtualFileSystem::mount_root failed");
+        }
+    }
+
+    // NOTE: The initialization code is about to be unmapped, so we have to wait for the other processor to be done with it.
+    while (!s_parallel_init_finished.load())
+        s_parallel_init_wait_queue.wait_forever("ParallelInit"sv);
 
     // Switch out of early boot mode.
     g_not_in_early_boot.set();
@@ -6,12 +6,17 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/Types.h>
 
 namespace Kernel {
 
 struct ArchSpecificThreadData {
     FlatPtr fs_base { 0 };
+
+    // The hardware performance counters, while this thread isn't running. See PerformanceCounters.
+    Array<u64, 4> performance_counter_values {};
+    u8 active_performance_counters { 0 };
 };
 
 }
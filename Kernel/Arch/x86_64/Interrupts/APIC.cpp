@@ -11,6 +11,7 @@
 #include <Kernel/Arch/PageDirectory.h>
 #include <Kernel/Arch/x86_64/Interrupts/APIC.h>
 #include <Kernel/Arch/x86_64/MSR.h>
+#include <Kernel/Arch/x86_64/PerformanceCounters.h>
 #include <Kernel/Arch/x86_64/ProcessorInfo.h>
 #include <Kernel/Arch/x86_64/Time/APICTimer.h>
 #include <Kernel/Debug.h>
@@ -25,6 +26,7 @@
 #include <Kernel/Tasks/Scheduler.h>
 #include <Kernel/Tasks/Thread.h>
 
+#define IRQ_APIC_PERFORMANCE_COUNTER (0xfb - IRQ_VECTOR_BASE)
 #define IRQ_APIC_TIMER (0xfc - IRQ_VECTOR_BASE)
 #define IRQ_APIC_IPI (0xfd - IRQ_VECTOR_BASE)
 #define IRQ_APIC_ERR (0xfe - IRQ_VECTOR_BASE)
@@ -119,6 +121,34 @@ public:
 private:
 };
 
+class APICPerformanceCounterInterruptHandler final : public GenericInterruptHandler {
+public:
+    explicit APICPerformanceCounterInterruptHandler(u8 interrupt_vector)
+        : GenericInterruptHandler(interrupt_vector, true)
+    {
+    }
+    virtual ~APICPerformanceCounterInterruptHandler()
+    {
+    }
+
+    static void initialize(u8 interrupt_number)
+    {
+        auto* handler = new APICPerformanceCounterInterruptHandler(interrupt_number);
+        handler->register_interrupt_handler();
+    }
+
+    virtual bool handle_interrupt(RegisterState const&) override;
+
+    virtual bool eoi() override;
+
+    virtual HandlerType type() const override { return HandlerType::IRQHandler; }
+    virtual StringView purpose() const override { return "Performance Counter Handler"sv; }
+    virtual StringView controller() const override { return {}; }
+
+    virtual size_t sharing_devices_count() const override { return 0; }
+    virtual bool is_shared_handler() const override { return false; }
+};
+
 bool APIC::initialized()
 {
     return s_apic.is_initialized();
@@ -466,6 +496,7 @@ UNMAP_AFTER_INIT void APIC::enable(u32 cpu)
     VERIFY(m_is_x2.was_set() || cpu < 8);
 
     u32 apic_id;
+    u32 physical_apic_id;
     if (m_is_x2.was_set()) {
         dbgln_if(APIC_DEBUG, "Enable x2APIC on CPU #{}", cpu);
 
@@ -473,7 +504,10 @@ UNMAP_AFTER_INIT void APIC::enable(u32 cpu)
         set_base(get_base());
 
         apic_id = read_register(APIC_REG_ID);
+        physical_apic_id = apic_id;
     } else {
+        physical_apic_id = read_register(APIC_REG_ID) >> 24;
+
         dbgln_if(APIC_DEBUG, "Setting logical xAPIC ID for CPU #{}", cpu);
 
         // Use the CPU# as logical apic id
@@ -486,6 +520,7 @@ UNMAP_AFTER_INIT void APIC::enable(u32 cpu)
 
     dbgln_if(APIC_DEBUG, "CPU #{} apic id: {}", cpu, apic_id);
     Processor::current().info().set_apic_id(apic_id);
+    Processor::current().info().set_physical_apic_id(physical_apic_id);
 
     dbgln_if(APIC_DEBUG, "Enabling local APIC for CPU #{}, logical APIC ID: {}", cpu, apic_id);
 
@@ -496,6 +531,9 @@ UNMAP_AFTER_INIT void APIC::enable(u32 cpu)
 
         // register IPI interrupt vector
         APICIPIInterruptHandler::initialize(IRQ_APIC_IPI);
+
+        PerformanceCounters::initialize();
+        APICPerformanceCounterInterruptHandler::initialize(IRQ_APIC_PERFORMANCE_COUNTER);
     }
 
     if (!m_is_x2.was_set()) {
@@ -511,13 +549,19 @@ UNMAP_AFTER_INIT void APIC::enable(u32 cpu)
 
     write_register(APIC_REG_LVT_TIMER, APIC_LVT(0, 0) | APIC_LVT_MASKED);
     write_register(APIC_REG_LVT_THERMAL, APIC_LVT(0, 0) | APIC_LVT_MASKED);
-    write_register(APIC_REG_LVT_PERFORMANCE_COUNTER, APIC_LVT(0, 0) | APIC_LVT_MASKED);
+    unmask_performance_counter_interrupt();
     write_register(APIC_REG_LVT_LINT0, APIC_LVT(0, 7) | APIC_LVT_MASKED);
     write_register(APIC_REG_LVT_LINT1, APIC_LVT(0, 0) | APIC_LVT_TRIGGER_LEVEL);
 
     write_register(APIC_REG_TPR, 0);
 }
 
+void APIC::unmask_performance_counter_interrupt()
+{
+    // NOTE: The counters only interrupt us once they're enabled for a profiled thread.
+    write_register(APIC_REG_LVT_PERFORMANCE_COUNTER, APIC_LVT(IRQ_APIC_PERFORMANCE_COUNTER + IRQ_VECTOR_BASE, 0));
+}
+
 Thread* APIC::get_idle_thread(u32 cpu) const
 {
     VERIFY(cpu > 0);
@@ -658,6 +702,18 @@ bool APICIPIInterruptHandler::eoi()
     return true;
 }
 
+bool APICPerformanceCounterInterruptHandler::handle_interrupt(RegisterState const& regs)
+{
+    PerformanceCounters::handle_overflow_interrupt(regs);
+    return true;
+}
+
+bool APICPerformanceCounterInterruptHandler::eoi()
+{
+    APIC::the().eoi();
+    return true;
+}
+
 bool APICErrInterruptHandler::handle_interrupt(RegisterState const&)
 {
     dbgln("APIC: SMP error on CPU #{}", Processor::current_id());
@@ -25,6 +25,8 @@ public:
     static void initialize();
     static bool initialized();
 
+    bool is_x2apic() const { return m_is_x2.was_set(); }
+
     bool init_bsp();
     void eoi();
     void setup_ap_boot_environment();
@@ -33,6 +35,7 @@ public:
     void init_finished(u32 cpu);
     void broadcast_ipi();
     void send_ipi(u32 cpu);
+    void unmask_performance_counter_interrupt();
     static u8 spurious_interrupt_vector();
     Thread* get_idle_thread(u32 cpu) const;
     u32 enabled_processor_count() const { return m_processor_enabled_cnt; }
@@ -6,6 +6,8 @@
 
 #include <Kernel/Arch/Interrupts.h>
 #include <Kernel/Arch/PCIMSI.h>
+#include <Kernel/Arch/Processor.h>
+#include <Kernel/Arch/x86_64/ProcessorInfo.h>
 #include <Kernel/Arch/x86_64/Interrupts/APIC.h>
 #include <Kernel/Arch/x86_64/PCI/MSI.h>
 #include <Kernel/Interrupts/InterruptDisabler.h>
@@ -22,6 +24,21 @@ u64 msi_address_register(u8 destination_id, bool redirection_hint, bool destinat
     return (msi_address_base | (destination_id << msi_destination_shift) | flags);
 }
 
+u64 msi_address_register_for_processor(u32 processor_id)
+{
+    if (processor_id == 0 || processor_id >= Processor::count() || !APIC::initialized())
+        return msi_address_register(0, false, false);
+
+    // NOTE: The logical APIC IDs we assign in xAPIC mode are CPU indices rather than one bit per processor, so they can't
+    //       be used as a flat logical destination. Physical destination mode works the same in both APIC modes.
+    auto apic_id = Processor::by_id(processor_id).info().physical_apic_id();
+
+    // Without interrupt remapping, MSIs can only address the first 255 physical APIC IDs (0xff is a broadcast).
+    if (apic_id >= 0xff)
+        return msi_address_register(0, false, false);
+    return msi_address_register(apic_id, false, false);
+}
+
 u32 msi_data_register(u8 vector, bool level_trigger, bool assert)
 {
     u32 flags = 0;
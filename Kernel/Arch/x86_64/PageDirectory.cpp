@@ -5,6 +5,8 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Array.h>
+#include <AK/BuiltinWrappers.h>
 #include <AK/Singleton.h>
 #include <Kernel/Arch/CPU.h>
 #include <Kernel/Arch/PageDirectory.h>
@@ -24,6 +26,76 @@ struct CR3Map {
 
 static Singleton<CR3Map> s_cr3_map;
 
+static constexpr size_t max_pcid_count = 4096;
+static constexpr FlatPtr cr3_pcid_mask = max_pcid_count - 1;
+static constexpr FlatPtr cr3_no_flush_bit = 1ull << 63;
+
+struct PCIDAllocator {
+    PCIDAllocator()
+    {
+        // NOTE: PCID 0 belongs to the kernel, as well as any address space we couldn't give a PCID of its own.
+        in_use.with([](auto& in_use) { in_use[0] = 1; });
+    }
+
+    SpinlockProtected<Array<u64, max_pcid_count / 64>, LockRank::None> in_use {};
+
+    // One bit per processor that may still hold stale TLB entries for a given PCID.
+    static_assert(MAX_CPU_COUNT <= 64);
+    Array<Atomic<u64>, max_pcid_count> stale_processors {};
+};
+
+static Singleton<PCIDAllocator> s_pcid_allocator;
+
+static u16 allocate_pcid()
+{
+    if (!Processor::current().has_feature(CPUFeature::PCID))
+        return 0;
+    auto pcid = s_pcid_allocator->in_use.with([](auto& in_use) -> u16 {
+        for (size_t i = 0; i < in_use.size(); ++i) {
+            if (in_use[i] == NumericLimits<u64>::max())
+                continue;
+            auto bit = count_trailing_zeroes(~in_use[i]);
+            in_use[i] |= 1ull << bit;
+            return i * 64 + bit;
+        }
+        return 0;
+    });
+    // Whoever used this PCID before us may have left TLB entries behind on any processor.
+    if (pcid != 0)
+        s_pcid_allocator->stale_processors[pcid].store(NumericLimits<u64>::max());
+    return pcid;
+}
+
+static void deallocate_pcid(u16 pcid)
+{
+    if (pcid == 0)
+        return;
+    s_pcid_allocator->in_use.with([&](auto& in_use) {
+        in_use[pcid / 64] &= ~(1ull << (pcid % 64));
+    });
+}
+
+void PageDirectory::mark_tlb_entries_stale(bool current_processor_is_up_to_date) const
+{
+    if (m_pcid == 0)
+        return;
+    u64 processors = NumericLimits<u64>::max();
+    if (current_processor_is_up_to_date)
+        processors &= ~(1ull << Processor::current_id());
+    s_pcid_allocator->stale_processors[m_pcid].fetch_or(processors);
+}
+
+FlatPtr cr3_for_context_switch(FlatPtr cr3)
+{
+    auto pcid = cr3 & cr3_pcid_mask;
+    if (pcid == 0)
+        return cr3;
+    auto processor_bit = 1ull << Processor::current_id();
+    if (s_pcid_allocator->stale_processors[pcid].fetch_and(~processor_bit) & processor_bit)
+        return cr3;
+    return cr3 | cr3_no_flush_bit;
+}
+
 void PageDirectory::register_page_directory(PageDirectory* directory)
 {
     s_cr3_map->map.with([&](auto& map) {
@@ -53,7 +125,7 @@ void activate_kernel_page_directory(PageDirectory const& pgd)
 void activate_page_directory(PageDirectory const& pgd, Thread* current_thread)
 {
     current_thread->regs().cr3 = pgd.cr3();
-    write_cr3(pgd.cr3());
+    write_cr3(cr3_for_context_switch(pgd.cr3()));
 }
 
 UNMAP_AFTER_INIT NonnullLockRefPtr<PageDirectory> PageDirectory::must_create_kernel_page_directory()
@@ -66,6 +138,7 @@ ErrorOr<NonnullLockRefPtr<PageDirectory>> PageDirectory::try_create_for_userspac
     auto directory = TRY(adopt_nonnull_lock_ref_or_enomem(new (nothrow) PageDirectory));
 
     directory->m_process = &process;
+    directory->m_pcid = allocate_pcid();
 
     directory->m_pml4t = TRY(MM.allocate_physical_page());
 
@@ -144,6 +217,7 @@ PageDirectory::~PageDirectory()
     if (is_cr3_initialized()) {
         deregister_page_directory(this);
     }
+    deallocate_pcid(m_pcid);
 }
 
 }
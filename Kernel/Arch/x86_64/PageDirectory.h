@@ -172,9 +172,15 @@ public:
 
     FlatPtr cr3() const
     {
-        return m_pml4t->paddr().get();
+        return m_pml4t->paddr().get() | m_pcid;
     }
 
+    u16 pcid() const { return m_pcid; }
+
+    // Processors that aren't currently using this page directory keep their TLB entries for it around
+    // when PCIDs are in use. Call this when mappings change, so they get dropped on the next switch.
+    void mark_tlb_entries_stale(bool current_processor_is_up_to_date) const;
+
     bool is_cr3_initialized() const
     {
         return m_pml4t;
@@ -193,6 +199,7 @@ private:
     static void deregister_page_directory(PageDirectory* directory);
 
     Process* m_process { nullptr };
+    u16 m_pcid { 0 };
     RefPtr<PhysicalRAMPage> m_pml4t;
     RefPtr<PhysicalRAMPage> m_directory_table;
     RefPtr<PhysicalRAMPage> m_directory_pages[512];
@@ -202,4 +209,8 @@ private:
 void activate_kernel_page_directory(PageDirectory const& pgd);
 void activate_page_directory(PageDirectory const& pgd, Thread* current_thread);
 
+// Returns the value to load into CR3 when switching to the given address space, which
+// keeps its PCID-tagged TLB entries unless they have been marked stale for this processor.
+FlatPtr cr3_for_context_switch(FlatPtr cr3);
+
 }
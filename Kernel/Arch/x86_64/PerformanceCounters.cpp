@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <AK/NumericLimits.h>
+#include <Kernel/API/POSIX/serenity.h>
+#include <Kernel/Arch/x86_64/CPUID.h>
+#include <Kernel/Arch/x86_64/Interrupts/APIC.h>
+#include <Kernel/Arch/x86_64/MSR.h>
+#include <Kernel/Arch/x86_64/PerformanceCounters.h>
+#include <Kernel/Sections.h>
+#include <Kernel/Tasks/PerformanceManager.h>
+
+#define IA32_PMC0 0xc1
+#define IA32_PERFEVTSEL0 0x186
+#define IA32_PERF_GLOBAL_STATUS 0x38e
+#define IA32_PERF_GLOBAL_CTRL 0x38f
+#define IA32_PERF_GLOBAL_OVF_CTRL 0x390
+
+#define PERFEVTSEL_USR (1 << 16)
+#define PERFEVTSEL_OS (1 << 17)
+#define PERFEVTSEL_INT (1 << 20)
+#define PERFEVTSEL_EN (1 << 22)
+
+namespace Kernel {
+
+struct CounterEvent {
+    u64 type;
+    u8 event_select;
+    u8 unit_mask;
+    // The bit in CPUID.0AH:EBX that is set if the processor doesn't have this event.
+    u8 unavailable_bit;
+    // NOTE: Writing to IA32_PMCx only sets the low 32 bits and sign-extends them, so this must stay below 2^31.
+    u32 period;
+};
+
+// Intel SDM Vol. 3B, 20.2.1.2 "Pre-defined Architectural Performance Events"
+static constexpr Array<CounterEvent, PerformanceCounters::event_count> s_events { {
+    { PERF_EVENT_CYCLES, 0x3c, 0x00, 0, 2'000'000 },
+    { PERF_EVENT_INSTRUCTIONS, 0xc0, 0x00, 1, 2'000'000 },
+    { PERF_EVENT_CACHE_MISS, 0x2e, 0x41, 4, 10'000 },
+    { PERF_EVENT_BRANCH_MISS, 0xc5, 0x00, 6, 10'000 },
+} };
+
+static_assert(PerformanceCounters::event_count == sizeof(ArchSpecificThreadData::performance_counter_values) / sizeof(u64));
+
+static u8 s_version;
+static u8 s_counter_count;
+static u8 s_counter_width;
+static u64 s_supported_events;
+
+UNMAP_AFTER_INIT void PerformanceCounters::initialize()
+{
+    if (CPUID(0).eax() < 0xa)
+        return;
+    CPUID leaf(0xa);
+    s_version = leaf.eax() & 0xff;
+    if (s_version == 0)
+        return;
+
+    s_counter_count = min<u8>((leaf.eax() >> 8) & 0xff, event_count);
+    s_counter_width = (leaf.eax() >> 16) & 0xff;
+    u8 known_events_count = (leaf.eax() >> 24) & 0xff;
+    for (auto const& event : s_events) {
+        if (event.unavailable_bit < known_events_count && (leaf.ebx() & (1 << event.unavailable_bit)) == 0)
+            s_supported_events |= event.type;
+    }
+    if (s_counter_count == 0 || s_counter_width < 32)
+        s_supported_events = 0;
+
+    dmesgln("PerformanceCounters: Version {}, {} counters of {} bits", s_version, s_counter_count, s_counter_width);
+}
+
+u64 PerformanceCounters::supported_events()
+{
+    return s_supported_events;
+}
+
+static bool should_count(Thread& thread)
+{
+    if (thread.is_idle_thread() || thread.is_profiling_suppressed())
+        return false;
+    return g_profiling_all_threads || thread.process().is_profiling();
+}
+
+static u64 initial_counter_value(CounterEvent const& event)
+{
+    // The counter interrupts us when it overflows, so it starts out at -period.
+    auto counter_mask = (s_counter_width >= 64) ? NumericLimits<u64>::max() : ((1ull << s_counter_width) - 1);
+    return (0 - static_cast<u64>(event.period)) & counter_mask;
+}
+
+static bool has_overflowed(u64 value)
+{
+    // NOTE: The counter starts out with its top bit set, which is cleared once it wrapped around.
+    return (value & (1ull << (s_counter_width - 1))) == 0;
+}
+
+template<typename Callback>
+static void for_each_active_counter(u8 active_events, Callback callback)
+{
+    u8 counter = 0;
+    for (size_t index = 0; index < s_events.size() && counter < s_counter_count; ++index) {
+        if ((active_events & (1 << index)) == 0)
+            continue;
+        callback(index, counter++);
+    }
+}
+
+void PerformanceCounters::switch_context(Thread& from_thread, Thread& to_thread)
+{
+    VERIFY_INTERRUPTS_DISABLED();
+    if (s_supported_events == 0)
+        return;
+
+    auto& from_data = from_thread.arch_specific_data();
+    if (from_data.active_performance_counters != 0) {
+        if (s_version >= 2)
+            MSR(IA32_PERF_GLOBAL_CTRL).set(0);
+        for_each_active_counter(from_data.active_performance_counters, [&](size_t index, u8 counter) {
+            MSR(IA32_PERFEVTSEL0 + counter).set(0);
+            from_data.performance_counter_values[index] = MSR(IA32_PMC0 + counter).get();
+        });
+        from_data.active_performance_counters = 0;
+    }
+
+    auto events = g_profiling_event_mask & s_supported_events;
+    if (events == 0 || !should_count(to_thread))
+        return;
+
+    auto& to_data = to_thread.arch_specific_data();
+    for (size_t index = 0; index < s_events.size(); ++index) {
+        if ((events & s_events[index].type) != 0)
+            to_data.active_performance_counters |= 1 << index;
+    }
+
+    u64 enabled_counters = 0;
+    for_each_active_counter(to_data.active_performance_counters, [&](size_t index, u8 counter) {
+        auto const& event = s_events[index];
+        auto value = to_data.performance_counter_values[index];
+        if (value == 0 || has_overflowed(value))
+            value = initial_counter_value(event);
+        MSR(IA32_PMC0 + counter).set(value);
+        MSR(IA32_PERFEVTSEL0 + counter).set(event.event_select | (event.unit_mask << 8) | PERFEVTSEL_USR | PERFEVTSEL_OS | PERFEVTSEL_INT | PERFEVTSEL_EN);
+        enabled_counters |= 1ull << counter;
+    });
+    if (s_version >= 2)
+        MSR(IA32_PERF_GLOBAL_CTRL).set(enabled_counters);
+}
+
+void PerformanceCounters::handle_overflow_interrupt(RegisterState const& regs)
+{
+    auto* current_thread = Thread::current();
+    if (!current_thread)
+        return;
+
+    u64 overflowed_counters = 0;
+    for_each_active_counter(current_thread->arch_specific_data().active_performance_counters, [&](size_t index, u8 counter) {
+        MSR pmc(IA32_PMC0 + counter);
+        if (!has_overflowed(pmc.get()))
+            return;
+        auto const& event = s_events[index];
+        pmc.set(initial_counter_value(event));
+        overflowed_counters |= 1ull << counter;
+        PerformanceManager::add_hardware_event_sample(*current_thread, regs, event.type);
+    });
+
+    if (s_version >= 2 && overflowed_counters != 0)
+        MSR(IA32_PERF_GLOBAL_OVF_CTRL).set(overflowed_counters);
+    // NOTE: The local APIC masks the interrupt when it delivers it.
+    APIC::the().unmask_performance_counter_interrupt();
+}
+
+}
@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Types.h>
+#include <Kernel/Forward.h>
+
+namespace Kernel {
+
+struct RegisterState;
+
+// Samples the profiled threads every so many hardware events (cycles, retired instructions, last level cache
+// misses and branch mispredictions), using the architectural performance monitoring counters.
+// The counters are virtualized per thread: They only count while a profiled thread runs, and continue where
+// they left off the next time it is scheduled.
+// FIXME: Support the AMD performance counters as well, they're not described by CPUID leaf 0xa.
+class PerformanceCounters {
+public:
+    static constexpr size_t event_count = 4;
+
+    static void initialize();
+
+    // The PERF_EVENT_* types that can be sampled on this processor.
+    static u64 supported_events();
+
+    // NOTE: This has to be called with interrupts disabled, before switching to the thread.
+    static void switch_context(Thread& from_thread, Thread& to_thread);
+
+    static void handle_overflow_interrupt(RegisterState const&);
+};
+
+}
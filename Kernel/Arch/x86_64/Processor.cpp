@@ -28,6 +28,7 @@
 #include <Kernel/Arch/TrapFrame.h>
 #include <Kernel/Arch/x86_64/CPUID.h>
 #include <Kernel/Arch/x86_64/MSR.h>
+#include <Kernel/Arch/x86_64/PerformanceCounters.h>
 #include <Kernel/Arch/x86_64/ProcessorInfo.h>
 #include <Kernel/Library/ScopedCritical.h>
 
@@ -40,7 +41,7 @@ READONLY_AFTER_INIT static ProcessorContainer s_processors {};
 READONLY_AFTER_INIT static bool volatile s_smp_enabled;
 
 static Atomic<ProcessorMessage*> s_message_pool;
-Atomic<u32> Processor::s_idle_cpu_mask { 0 };
+Atomic<u64> Processor::s_idle_cpu_mask { 0 };
 
 extern "C" void enter_thread_context(Thread* from_thread, Thread* to_thread) __attribute__((used));
 extern "C" FlatPtr do_init_context(Thread* thread, u32 flags) __attribute__((used));
@@ -505,6 +506,13 @@ UNMAP_AFTER_INIT void Processor::cpu_setup()
         write_cr4(read_cr4() | 0x80);
     }
 
+    if (has_feature(CPUFeature::PCID)) {
+        // Turn on CR4.PCIDE so TLB entries are tagged with the PCID in CR3 and survive address space switches.
+        // NOTE: This requires CR3[11:0] to be zero, which holds as we're still running on the kernel page directory.
+        VERIFY((read_cr3() & 0xfff) == 0);
+        write_cr4(read_cr4() | 0x20000);
+    }
+
     if (has_feature(CPUFeature::NX)) {
         // Turn on IA32_EFER.NXE
         MSR ia32_efer(MSR_IA32_EFER);
@@ -950,6 +958,14 @@ void ProcessorBase<T>::exit_trap(TrapFrame& trap)
 template<typename T>
 void ProcessorBase<T>::flush_tlb_local(VirtualAddress vaddr, size_t page_count)
 {
+    // Past a certain size it's cheaper to drop all non-global entries than to invalidate page by page.
+    // NOTE: Kernel mappings are global, so we can only do this for userspace ranges.
+    static constexpr size_t flush_entire_tlb_threshold = 32;
+    if (page_count > flush_entire_tlb_threshold && Memory::is_user_range(vaddr, page_count * PAGE_SIZE)) {
+        write_cr3(read_cr3());
+        return;
+    }
+
     auto ptr = vaddr.as_ptr();
     while (page_count > 0) {
         asm volatile("invlpg %0"
@@ -964,12 +980,24 @@ void ProcessorBase<T>::flush_tlb_local(VirtualAddress vaddr, size_t page_count)
 template<typename T>
 void ProcessorBase<T>::flush_entire_tlb_local()
 {
-    write_cr3(read_cr3());
+    // NOTE: Reloading CR3 keeps global entries (and those of other PCIDs) around, toggling CR4.PGE drops everything.
+    auto cr4 = read_cr4();
+    if (cr4 & 0x80) {
+        write_cr4(cr4 & ~0x80);
+        write_cr4(cr4);
+    } else {
+        write_cr3(read_cr3());
+    }
 }
 
 template<typename T>
 void ProcessorBase<T>::flush_tlb(Memory::PageDirectory const* page_directory, VirtualAddress vaddr, size_t page_count)
 {
+    // Only processors currently using this page directory get flushed below,
+    // so the others have to drop its entries the next time they switch to it.
+    if (page_directory && Memory::is_user_address(vaddr))
+        page_directory->mark_tlb_entries_stale(read_cr3() == page_directory->cr3());
+
     if (s_smp_enabled && (!Memory::is_user_address(vaddr) || Process::current().thread_count() > 1))
         Processor::smp_broadcast_flush_tlb(page_directory, vaddr, page_count);
     else
@@ -1035,16 +1063,16 @@ u32 ProcessorBase<T>::smp_wake_n_idle_processors(u32 wake_count)
     auto& apic = APIC::the();
     while (did_wake_count < wake_count) {
         // Try to get a set of idle CPUs and flip them to busy
-        u32 idle_mask = Processor::s_idle_cpu_mask.load(AK::MemoryOrder::memory_order_relaxed) & ~(1u << current_id);
+        u64 idle_mask = Processor::s_idle_cpu_mask.load(AK::MemoryOrder::memory_order_relaxed) & ~(1ull << current_id);
         u32 idle_count = popcount(idle_mask);
         if (idle_count == 0)
             break; // No (more) idle processor available
 
-        u32 found_mask = 0;
+        u64 found_mask = 0;
         for (u32 i = 0; i < idle_count; i++) {
             u32 cpu = bit_scan_forward(idle_mask) - 1;
-            idle_mask &= ~(1u << cpu);
-            found_mask |= 1u << cpu;
+            idle_mask &= ~(1ull << cpu);
+            found_mask |= 1ull << cpu;
         }
 
         idle_mask = Processor::s_idle_cpu_mask.fetch_and(~found_mask, AK::MemoryOrder::memory_order_acq_rel) & found_mask;
@@ -1053,7 +1081,7 @@ u32 ProcessorBase<T>::smp_wake_n_idle_processors(u32 wake_count)
         idle_count = popcount(idle_mask);
         for (u32 i = 0; i < idle_count; i++) {
             u32 cpu = bit_scan_forward(idle_mask) - 1;
-            idle_mask &= ~(1u << cpu);
+            idle_mask &= ~(1ull << cpu);
 
             // Send an IPI to that CPU to wake it up. There is a possibility
             // someone else woke it up as well, or that it woke up due to
@@ -1390,9 +1418,10 @@ extern "C" void enter_thread_context(Thread* from_thread, Thread* to_thread)
 
     auto& processor = Processor::current();
     Processor::set_fs_base(to_thread->arch_specific_data().fs_base);
+    PerformanceCounters::switch_context(*from_thread, *to_thread);
 
     if (from_regs.cr3 != to_regs.cr3)
-        write_cr3(to_regs.cr3);
+        write_cr3(Memory::cr3_for_context_switch(to_regs.cr3));
 
     to_thread->set_cpu(processor.id());
 
@@ -1725,13 +1754,13 @@ void Processor::set_fs_base(FlatPtr fs_base)
 template<typename T>
 void ProcessorBase<T>::idle_begin() const
 {
-    Processor::s_idle_cpu_mask.fetch_or(1u << m_cpu, AK::MemoryOrder::memory_order_relaxed);
+    Processor::s_idle_cpu_mask.fetch_or(1ull << m_cpu, AK::MemoryOrder::memory_order_relaxed);
 }
 
 template<typename T>
 void ProcessorBase<T>::idle_end() const
 {
-    Processor::s_idle_cpu_mask.fetch_and(~(1u << m_cpu), AK::MemoryOrder::memory_order_relaxed);
+    Processor::s_idle_cpu_mask.fetch_and(~(1ull << m_cpu), AK::MemoryOrder::memory_order_relaxed);
 }
 
 template<typename T>
@@ -1740,6 +1769,15 @@ void ProcessorBase<T>::wait_for_interrupt() const
     asm("hlt");
 }
 
+template<typename T>
+void ProcessorBase<T>::enable_interrupts_and_wait_for_interrupt() const
+{
+    VERIFY_INTERRUPTS_DISABLED();
+    // NOTE: Interrupts are only taken after the instruction following sti, so nothing can sneak in before the hlt.
+    asm volatile("sti\n"
+                 "hlt");
+}
+
 }
 
 #include <Kernel/Arch/ProcessorFunctions.include>
@@ -70,7 +70,7 @@ private:
     alignas(Descriptor) Descriptor m_gdt[256];
     u32 m_gdt_length;
 
-    static Atomic<u32> s_idle_cpu_mask;
+    static Atomic<u64> s_idle_cpu_mask;
 
     TSS m_tss;
     SetOnce m_has_qemu_hvf_quirk;
@@ -35,12 +35,15 @@ public:
     u32 stepping() const { return m_stepping; }
     u32 type() const { return m_type; }
     u32 apic_id() const { return m_apic_id; }
+    // In xAPIC mode, apic_id() is the logical APIC ID, which can't be used for physical destinations.
+    u32 physical_apic_id() const { return m_physical_apic_id; }
     Optional<Cache> const& l1_data_cache() const { return m_l1_data_cache; }
     Optional<Cache> const& l1_instruction_cache() const { return m_l1_instruction_cache; }
     Optional<Cache> const& l2_cache() const { return m_l2_cache; }
     Optional<Cache> const& l3_cache() const { return m_l3_cache; }
 
     void set_apic_id(u32 apic_id) { m_apic_id = apic_id; }
+    void set_physical_apic_id(u32 physical_apic_id) { m_physical_apic_id = physical_apic_id; }
 
     static constexpr StringView s_amd_vendor_id = "AuthenticAMD"sv;
     static constexpr StringView s_intel_vendor_id = "GenuineIntel"sv;
@@ -63,6 +66,7 @@ private:
     u32 m_stepping { 0 };
     u32 m_type { 0 };
     u32 m_apic_id { 0 };
+    u32 m_physical_apic_id { 0 };
 
     Optional<Cache> m_l1_data_cache;
     Optional<Cache> m_l1_instruction_cache;
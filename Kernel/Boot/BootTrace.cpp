@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <AK/JsonArraySerializer.h>
+#include <AK/JsonObjectSerializer.h>
+#include <AK/Singleton.h>
+#include <Kernel/Arch/Processor.h>
+#include <Kernel/Boot/BootTrace.h>
+#include <Kernel/Library/KBufferBuilder.h>
+#include <Kernel/Locking/SpinlockProtected.h>
+#include <Kernel/Time/TimeManagement.h>
+
+namespace Kernel {
+
+struct BootTraceEntry {
+    StringView name;
+    MonotonicTime start;
+    Duration duration;
+    u32 cpu { 0 };
+};
+
+struct BootTraceEntries {
+    // NOTE: We don't want to allocate while the heap might still be in use by whatever we're timing,
+    //       and there's only a few dozen steps anyway.
+    Array<BootTraceEntry, 64> entries;
+    size_t count { 0 };
+};
+
+static Singleton<SpinlockProtected<BootTraceEntries, LockRank::None>> s_entries;
+
+BootTrace::Step::Step(StringView name)
+    : m_name(name)
+    , m_start(TimeManagement::the().monotonic_time(TimePrecision::Precise))
+{
+}
+
+BootTrace::Step::~Step()
+{
+    auto duration = TimeManagement::the().monotonic_time(TimePrecision::Precise) - m_start;
+    auto cpu = Processor::current_id();
+    dmesgln("BootTrace: {} took {} ms (CPU #{})", m_name, duration.to_milliseconds(), cpu);
+    s_entries->with([&](auto& entries) {
+        if (entries.count == entries.entries.size())
+            return;
+        entries.entries[entries.count++] = { m_name, m_start, duration, cpu };
+    });
+}
+
+ErrorOr<void> BootTrace::to_json(KBufferBuilder& builder)
+{
+    auto array = TRY(JsonArraySerializer<>::try_create(builder));
+    TRY(s_entries->with([&](auto& entries) -> ErrorOr<void> {
+        for (size_t i = 0; i < entries.count; ++i) {
+            auto& entry = entries.entries[i];
+            auto object = TRY(array.add_object());
+            TRY(object.add("name"sv, entry.name));
+            TRY(object.add("start_us"sv, entry.start.nanoseconds() / 1000));
+            TRY(object.add("duration_us"sv, entry.duration.to_microseconds()));
+            TRY(object.add("cpu"sv, entry.cpu));
+            TRY(object.finish());
+        }
+        return {};
+    }));
+    TRY(array.finish());
+    return {};
+}
+
+}
@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Error.h>
+#include <AK/Noncopyable.h>
+#include <AK/StringView.h>
+#include <AK/Time.h>
+
+namespace Kernel {
+
+class KBufferBuilder;
+
+// Records how long the steps of kernel initialization take, so that slow drivers stand out.
+// Every step is logged to dmesg when it finishes, and all of them can be read from /sys/kernel/boot_trace.
+class BootTrace {
+public:
+    class Step {
+        AK_MAKE_NONCOPYABLE(Step);
+        AK_MAKE_NONMOVABLE(Step);
+
+    public:
+        // NOTE: The name has to outlive the kernel, so just use a string literal.
+        explicit Step(StringView name);
+        ~Step();
+
+    private:
+        StringView m_name;
+        MonotonicTime m_start;
+    };
+
+    static ErrorOr<void> to_json(KBufferBuilder&);
+};
+
+}
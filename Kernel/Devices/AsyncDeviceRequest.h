@@ -74,6 +74,10 @@ public:
 
     void complete(RequestResult result);
 
+    // NOTE: This is only stable while holding the owning device's requests lock, as that is
+    //       what do_start() is called with.
+    bool was_started() const { return m_result != Pending; }
+
     void set_private(void* priv)
     {
         VERIFY(!m_private || !priv);
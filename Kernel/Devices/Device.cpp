@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Find.h>
 #include <AK/Singleton.h>
 #include <Kernel/Devices/Device.h>
 #include <Kernel/Devices/DeviceManagement.h>
@@ -73,11 +74,17 @@ void Device::process_next_queued_request(Badge<AsyncDeviceRequest>, AsyncDeviceR
 {
     SpinlockLocker lock(m_requests_lock);
     VERIFY(!m_requests.is_empty());
-    VERIFY(m_requests.first().ptr() == &completed_request);
-    m_requests.remove(m_requests.begin());
-    if (!m_requests.is_empty()) {
-        auto* next_request = m_requests.first().ptr();
-        next_request->do_start(move(lock));
+    VERIFY(m_requests_in_flight > 0);
+    // NOTE: With more than one request in flight, requests may complete out of order.
+    auto completed_it = AK::find_if(m_requests.begin(), m_requests.end(), [&](auto& request) { return request.ptr() == &completed_request; });
+    VERIFY(completed_it != m_requests.end());
+    m_requests.remove(completed_it);
+    --m_requests_in_flight;
+
+    auto next_it = AK::find_if(m_requests.begin(), m_requests.end(), [](auto& request) { return !request->was_started(); });
+    if (next_it != m_requests.end()) {
+        ++m_requests_in_flight;
+        (*next_it)->do_start(move(lock));
     }
 
     evaluate_block_conditions();
@@ -56,13 +56,18 @@ public:
     {
         auto request = TRY(adopt_nonnull_lock_ref_or_enomem(new (nothrow) AsyncRequestType(*this, forward<Args>(args)...)));
         SpinlockLocker lock(m_requests_lock);
-        bool was_empty = m_requests.is_empty();
         TRY(m_requests.try_append(request));
-        if (was_empty)
+        if (m_requests_in_flight < max_concurrent_requests()) {
+            ++m_requests_in_flight;
             request->do_start(move(lock));
+        }
         return request;
     }
 
+    // Devices that can keep several requests in flight (e.g. with multiple hardware queues)
+    // may override this. Requests beyond the limit wait in line until an earlier one completes.
+    virtual size_t max_concurrent_requests() const { return 1; }
+
 protected:
     Device(MajorNumber major, MinorNumber minor);
 
@@ -85,6 +90,7 @@ private:
 
     Spinlock<LockRank::None> m_requests_lock {};
     DoublyLinkedList<LockRefPtr<AsyncDeviceRequest>> m_requests;
+    size_t m_requests_in_flight { 0 };
 
 protected:
     // FIXME: This pointer will be eventually removed after all nodes in /sys/dev/block/ and
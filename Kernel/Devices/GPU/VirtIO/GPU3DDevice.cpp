@@ -109,6 +109,8 @@ ErrorOr<void> VirtIOGPU3DDevice::ioctl(OpenFileDescription& description, unsigne
     case VIRGL_IOCTL_SUBMIT_CMD: {
         auto user_command_buffer = static_ptr_cast<VirGLCommandBuffer const*>(arg);
         auto command_buffer = TRY(copy_typed_from_user(user_command_buffer));
+        if (command_buffer.num_elems > VIRGL_MAX_COMMAND_BUFFER_ELEMS)
+            return E2BIG;
         return m_context_state_list.with([get_context_for_description, &description, &command_buffer, this](auto& list) -> ErrorOr<void> {
             auto context = TRY(get_context_for_description(list, description));
             auto context_id = context->context_id();
@@ -20,16 +20,20 @@ public:
     // ^BlockDevice
     virtual void start_request(AsyncBlockDeviceRequest&) override;
 
+    // ^Device
+    virtual size_t max_concurrent_requests() const override { return m_command_queue_depth; }
+
     u16 ata_capabilites() const { return m_capabilities; }
     ATA::Address const& ata_address() const { return m_ata_address; }
 
 protected:
-    ATADevice(AHCIController const&, ATA::Address, u16, u16, u64);
+    ATADevice(AHCIController const&, ATA::Address, u16, u16, u64, size_t command_queue_depth);
 
     // FIXME: Add proper locking to ensure hotplug can work.
     LockRefPtr<AHCIController> m_controller;
     ATA::Address const m_ata_address;
     u16 const m_capabilities;
+    size_t const m_command_queue_depth { 1 };
 };
 
 }
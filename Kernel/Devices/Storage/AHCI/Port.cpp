@@ -37,14 +37,18 @@ ErrorOr<void> AHCIPort::allocate_resources_and_initialize_ports()
 
     m_fis_receive_page = TRY(MM.allocate_physical_page());
 
-    for (size_t index = 0; index < 1; index++) {
+    // Note: Every command slot gets its own command table and DMA buffer, so that with
+    // native command queuing each slot can be used for a different request at the same time.
+    auto command_slots_count = min<size_t>(m_hba_capabilities.max_command_list_entries_count, AHCI::Limits::MaxCommands);
+    for (size_t index = 0; index < command_slots_count; index++) {
         auto dma_page = TRY(MM.allocate_physical_page());
-        m_dma_buffers.append(move(dma_page));
+        TRY(m_dma_buffers.try_append(move(dma_page)));
     }
-    for (size_t index = 0; index < 1; index++) {
+    for (size_t index = 0; index < command_slots_count; index++) {
         auto command_table_page = TRY(MM.allocate_physical_page());
-        m_command_table_pages.append(move(command_table_page));
+        TRY(m_command_table_pages.try_append(move(command_table_page)));
     }
+    m_command_table_region = TRY(MM.allocate_kernel_region_with_physical_pages(m_command_table_pages.span(), "AHCI Port Command Tables"sv, Memory::Region::Access::ReadWrite, Memory::Region::Cacheable::No));
 
     m_command_list_region = TRY(MM.allocate_dma_buffer_page("AHCI Port Command List"sv, Memory::Region::Access::ReadWrite, m_command_list_page));
 
@@ -85,20 +89,14 @@ void AHCIPort::handle_interrupt()
             auto work_item_creation_result = g_io_work->try_queue([this]() {
                 m_connected_device.clear();
             });
-            if (work_item_creation_result.is_error()) {
-                auto current_request = m_current_request;
-                m_current_request.clear();
-                current_request->complete(AsyncDeviceRequest::OutOfMemory);
-            }
+            if (work_item_creation_result.is_error())
+                fail_all_outstanding_requests(AsyncDeviceRequest::OutOfMemory);
         } else {
             auto work_item_creation_result = g_io_work->try_queue([this]() {
                 reset();
             });
-            if (work_item_creation_result.is_error()) {
-                auto current_request = m_current_request;
-                m_current_request.clear();
-                current_request->complete(AsyncDeviceRequest::OutOfMemory);
-            }
+            if (work_item_creation_result.is_error())
+                fail_all_outstanding_requests(AsyncDeviceRequest::OutOfMemory);
         }
         return;
     }
@@ -111,59 +109,47 @@ void AHCIPort::handle_interrupt()
         auto work_item_creation_result = g_io_work->try_queue([this]() {
             reset();
         });
-        if (work_item_creation_result.is_error()) {
-            auto current_request = m_current_request;
-            m_current_request.clear();
-            current_request->complete(AsyncDeviceRequest::OutOfMemory);
-        }
+        if (work_item_creation_result.is_error())
+            fail_all_outstanding_requests(AsyncDeviceRequest::OutOfMemory);
         return;
     }
     if (m_interrupt_status.is_set(AHCI::PortInterruptFlag::IF) || m_interrupt_status.is_set(AHCI::PortInterruptFlag::TFE) || m_interrupt_status.is_set(AHCI::PortInterruptFlag::HBD) || m_interrupt_status.is_set(AHCI::PortInterruptFlag::HBF)) {
         auto work_item_creation_result = g_io_work->try_queue([this]() {
             recover_from_fatal_error();
         });
-        if (work_item_creation_result.is_error()) {
-            auto current_request = m_current_request;
-            m_current_request.clear();
-            current_request->complete(AsyncDeviceRequest::OutOfMemory);
-        }
+        if (work_item_creation_result.is_error())
+            fail_all_outstanding_requests(AsyncDeviceRequest::OutOfMemory);
         return;
     }
-    if (m_interrupt_status.is_set(AHCI::PortInterruptFlag::DHR) || m_interrupt_status.is_set(AHCI::PortInterruptFlag::PS)) {
-        m_wait_for_completion = false;
+    // Note: Commands without native command queuing complete with a Register D2H FIS, while
+    // queued commands are completed (possibly several at once, and in any order) with a Set Device Bits FIS.
+    if (m_interrupt_status.is_set(AHCI::PortInterruptFlag::DHR) || m_interrupt_status.is_set(AHCI::PortInterruptFlag::PS) || m_interrupt_status.is_set(AHCI::PortInterruptFlag::SDB)) {
+        u32 completed_command_slots = 0;
+        {
+            SpinlockLocker lock(m_hard_lock);
+            completed_command_slots = m_issued_command_slots & ~(m_port_registers.ci | m_port_registers.sact);
+            m_issued_command_slots &= ~completed_command_slots;
+        }
 
         // Now schedule reading/writing the buffer as soon as we leave the irq handler.
         // This is important so that we can safely access the buffers, which could
         // trigger page faults
-        if (!m_current_request) {
+        if (completed_command_slots == 0) {
             dbgln_if(AHCI_DEBUG, "AHCI Port {}: Request handled, probably identify request", representative_port_index());
         } else {
-            auto work_item_creation_result = g_io_work->try_queue([this]() {
-                dbgln_if(AHCI_DEBUG, "AHCI Port {}: Request handled", representative_port_index());
+            auto work_item_creation_result = g_io_work->try_queue([this, completed_command_slots]() {
+                dbgln_if(AHCI_DEBUG, "AHCI Port {}: Requests handled, command slots {:#08x}", representative_port_index(), completed_command_slots);
                 MutexLocker locker(m_lock);
-                VERIFY(m_current_request);
-                VERIFY(m_current_scatter_list);
-                if (!m_connected_device) {
-                    dbgln_if(AHCI_DEBUG, "AHCI Port {}: Request success", representative_port_index());
-                    complete_current_request(AsyncDeviceRequest::Failure);
-                    return;
-                }
-                if (m_current_request->request_type() == AsyncBlockDeviceRequest::Read) {
-                    if (auto result = m_current_request->write_to_buffer(m_current_request->buffer(), m_current_scatter_list->dma_region().as_ptr(), m_connected_device->block_size() * m_current_request->block_count()); result.is_error()) {
-                        dbgln_if(AHCI_DEBUG, "AHCI Port {}: Request failure, memory fault occurred when reading in data.", representative_port_index());
-                        m_current_scatter_list = nullptr;
-                        complete_current_request(AsyncDeviceRequest::MemoryFault);
-                        return;
-                    }
+                for (u8 index = 0; index < AHCI::Limits::MaxCommands; index++) {
+                    if (completed_command_slots & (1u << index))
+                        handle_completed_command_slot(index);
                 }
-                m_current_scatter_list = nullptr;
-                dbgln_if(AHCI_DEBUG, "AHCI Port {}: Request success", representative_port_index());
-                complete_current_request(AsyncDeviceRequest::Success);
             });
             if (work_item_creation_result.is_error()) {
-                auto current_request = m_current_request;
-                m_current_request.clear();
-                current_request->complete(AsyncDeviceRequest::OutOfMemory);
+                for (u8 index = 0; index < AHCI::Limits::MaxCommands; index++) {
+                    if (completed_command_slots & (1u << index))
+                        complete_command_slot(index, AsyncDeviceRequest::OutOfMemory);
+                }
             }
         }
     }
@@ -179,13 +165,18 @@ bool AHCIPort::is_interrupts_enabled() const
 void AHCIPort::recover_from_fatal_error()
 {
     MutexLocker locker(m_lock);
-    SpinlockLocker lock(m_hard_lock);
+    {
+        SpinlockLocker lock(m_hard_lock);
+
+        dmesgln("{}: AHCI Port {} fatal error, shutting down!", m_parent_controller->device_identifier().address(), representative_port_index());
+        dmesgln("{}: AHCI Port {} fatal error, SError {}", m_parent_controller->device_identifier().address(), representative_port_index(), (u32)m_port_registers.serr);
+        stop_command_list_processing();
+        stop_fis_receiving();
+        m_interrupt_enable.clear();
+    }
 
-    dmesgln("{}: AHCI Port {} fatal error, shutting down!", m_parent_controller->device_identifier().address(), representative_port_index());
-    dmesgln("{}: AHCI Port {} fatal error, SError {}", m_parent_controller->device_identifier().address(), representative_port_index(), (u32)m_port_registers.serr);
-    stop_command_list_processing();
-    stop_fis_receiving();
-    m_interrupt_enable.clear();
+    // Note: Nothing that is still outstanding will complete now, so don't leave anyone waiting for it.
+    fail_all_outstanding_requests(AsyncDeviceRequest::Failure);
 }
 
 bool AHCIPort::reset()
@@ -250,6 +241,8 @@ bool AHCIPort::initialize()
     size_t logical_sector_size = 512;
     size_t physical_sector_size = 512;
     u64 max_addressable_sector = 0;
+    m_native_command_queuing_enabled = false;
+    m_command_queue_depth = 1;
 
     if (identify_device()) {
         auto identify_block = Memory::map_typed<ATAIdentifyBlock>(m_identify_buffer_page->paddr()).release_value_but_fixme_should_propagate_errors();
@@ -273,11 +266,19 @@ bool AHCIPort::initialize()
             m_port_registers.cmd = m_port_registers.cmd | (1 << 24);
         }
 
-        dmesgln("AHCI Port {}: Device found, Capacity={}, Bytes per logical sector={}, Bytes per physical sector={}", representative_port_index(), max_addressable_sector * logical_sector_size, logical_sector_size, physical_sector_size);
+        // Word 76 bit 8 tells us if the device supports native command queuing,
+        // and the lowest 5 bits of word 75 hold its maximum queue depth minus one.
+        auto serial_ata_capabilities = identify_block->serial_ata_capabilities;
+        if (!is_atapi_attached() && m_hba_capabilities.native_command_queuing_supported && serial_ata_capabilities != 0xffff && (serial_ata_capabilities & (1 << 8))) {
+            m_native_command_queuing_enabled = true;
+            m_command_queue_depth = min<size_t>(m_command_table_pages.size(), (identify_block->queue_depth & 0x1f) + 1);
+        }
+
+        dmesgln("AHCI Port {}: Device found, Capacity={}, Bytes per logical sector={}, Bytes per physical sector={}, NCQ depth={}", representative_port_index(), max_addressable_sector * logical_sector_size, logical_sector_size, physical_sector_size, m_native_command_queuing_enabled ? m_command_queue_depth : 0);
 
         // FIXME: We don't support ATAPI devices yet, so for now we don't "create" them
         if (!is_atapi_attached()) {
-            m_connected_device = ATADiskDevice::create(*m_parent_controller, { m_port_index, 0 }, 0, logical_sector_size, max_addressable_sector);
+            m_connected_device = ATADiskDevice::create(*m_parent_controller, { m_port_index, 0 }, 0, logical_sector_size, max_addressable_sector, m_command_queue_depth);
         } else {
             dbgln("AHCI Port {}: Ignoring ATAPI devices as we don't support them.", representative_port_index());
         }
@@ -404,25 +405,29 @@ size_t AHCIPort::calculate_descriptors_count(size_t block_count) const
 {
     VERIFY(m_connected_device);
     size_t needed_dma_regions_count = Memory::page_round_up((block_count * m_connected_device->block_size())).value() / PAGE_SIZE;
-    VERIFY(needed_dma_regions_count <= m_dma_buffers.size());
+    // Note: Each command slot has exactly one DMA buffer page.
+    VERIFY(needed_dma_regions_count <= 1);
     return needed_dma_regions_count;
 }
 
-Optional<AsyncDeviceRequest::RequestResult> AHCIPort::prepare_and_set_scatter_list(AsyncBlockDeviceRequest& request)
+volatile AHCI::CommandTable& AHCIPort::command_table_for_slot(u8 command_slot_index) const
+{
+    VERIFY(command_slot_index < m_command_table_pages.size());
+    return *(volatile AHCI::CommandTable*)m_command_table_region->vaddr().offset(command_slot_index * PAGE_SIZE).as_ptr();
+}
+
+Optional<AsyncDeviceRequest::RequestResult> AHCIPort::prepare_and_set_scatter_list(u8 command_slot_index, AsyncBlockDeviceRequest& request)
 {
     VERIFY(m_lock.is_locked());
     VERIFY(request.block_count() > 0);
 
-    Vector<NonnullRefPtr<Memory::PhysicalRAMPage>> allocated_dma_regions;
-    for (size_t index = 0; index < calculate_descriptors_count(request.block_count()); index++) {
-        allocated_dma_regions.append(m_dma_buffers.at(index));
-    }
-
-    m_current_scatter_list = Memory::ScatterGatherList::try_create(request, allocated_dma_regions.span(), m_connected_device->block_size(), "AHCI Scattered DMA"sv).release_value_but_fixme_should_propagate_errors();
-    if (!m_current_scatter_list)
+    auto dma_regions = m_dma_buffers.span().slice(command_slot_index, calculate_descriptors_count(request.block_count()));
+    auto scatter_list = Memory::ScatterGatherList::try_create(request, dma_regions, m_connected_device->block_size(), "AHCI Scattered DMA"sv).release_value_but_fixme_should_propagate_errors();
+    if (!scatter_list)
         return AsyncDeviceRequest::Failure;
+    m_command_slots[command_slot_index].scatter_list = scatter_list;
     if (request.request_type() == AsyncBlockDeviceRequest::Write) {
-        if (auto result = request.read_from_buffer(request.buffer(), m_current_scatter_list->dma_region().as_ptr(), m_connected_device->block_size() * request.block_count()); result.is_error()) {
+        if (auto result = request.read_from_buffer(request.buffer(), scatter_list->dma_region().as_ptr(), m_connected_device->block_size() * request.block_count()); result.is_error()) {
             return AsyncDeviceRequest::MemoryFault;
         }
     }
@@ -433,34 +438,103 @@ void AHCIPort::start_request(AsyncBlockDeviceRequest& request)
 {
     MutexLocker locker(m_lock);
     dbgln_if(AHCI_DEBUG, "AHCI Port {}: Request start", representative_port_index());
-    VERIFY(!m_current_request);
-    VERIFY(!m_current_scatter_list);
 
-    m_current_request = request;
+    if (!m_connected_device || !is_operable()) {
+        dbgln_if(AHCI_DEBUG, "AHCI Port {}: Request failure, port is not operable.", representative_port_index());
+        locker.unlock();
+        request.complete(AsyncDeviceRequest::Failure);
+        return;
+    }
+
+    u8 command_slot_index = 0;
+    {
+        SpinlockLocker lock(m_hard_lock);
+        auto unused_command_header = try_to_find_unused_command_header();
+        // Note: The device never starts more than m_command_queue_depth requests at once,
+        // so there must be a free command slot for us.
+        VERIFY(unused_command_header.has_value());
+        command_slot_index = unused_command_header.value();
+        m_allocated_command_slots |= 1u << command_slot_index;
+        m_command_slots[command_slot_index].request = request;
+    }
 
-    auto result = prepare_and_set_scatter_list(request);
+    auto result = prepare_and_set_scatter_list(command_slot_index, request);
     if (result.has_value()) {
         dbgln_if(AHCI_DEBUG, "AHCI Port {}: Request failure.", representative_port_index());
         locker.unlock();
-        complete_current_request(result.value());
+        complete_command_slot(command_slot_index, result.value());
         return;
     }
 
-    auto success = access_device(request.request_type(), request.block_index(), request.block_count());
+    auto success = access_device(command_slot_index, request.request_type(), request.block_index(), request.block_count());
     if (!success) {
         dbgln_if(AHCI_DEBUG, "AHCI Port {}: Request failure.", representative_port_index());
         locker.unlock();
-        complete_current_request(AsyncDeviceRequest::Failure);
+        complete_command_slot(command_slot_index, AsyncDeviceRequest::Failure);
         return;
     }
 }
 
-void AHCIPort::complete_current_request(AsyncDeviceRequest::RequestResult result)
+void AHCIPort::handle_completed_command_slot(u8 command_slot_index)
 {
-    VERIFY(m_current_request);
-    auto current_request = m_current_request;
-    m_current_request.clear();
-    current_request->complete(result);
+    VERIFY(m_lock.is_locked());
+    auto& command_slot = m_command_slots[command_slot_index];
+    // Note: The request might have been failed already while this was waiting in the IO work queue.
+    if (!command_slot.request)
+        return;
+    VERIFY(command_slot.scatter_list);
+    if (!m_connected_device) {
+        dbgln_if(AHCI_DEBUG, "AHCI Port {}: Request failure, device is gone.", representative_port_index());
+        complete_command_slot(command_slot_index, AsyncDeviceRequest::Failure);
+        return;
+    }
+    auto& request = *command_slot.request;
+    if (request.request_type() == AsyncBlockDeviceRequest::Read) {
+        if (auto result = request.write_to_buffer(request.buffer(), command_slot.scatter_list->dma_region().as_ptr(), m_connected_device->block_size() * request.block_count()); result.is_error()) {
+            dbgln_if(AHCI_DEBUG, "AHCI Port {}: Request failure, memory fault occurred when reading in data.", representative_port_index());
+            complete_command_slot(command_slot_index, AsyncDeviceRequest::MemoryFault);
+            return;
+        }
+    }
+    dbgln_if(AHCI_DEBUG, "AHCI Port {}: Request success", representative_port_index());
+    complete_command_slot(command_slot_index, AsyncDeviceRequest::Success);
+}
+
+void AHCIPort::complete_command_slot(u8 command_slot_index, AsyncDeviceRequest::RequestResult result)
+{
+    LockRefPtr<AsyncBlockDeviceRequest> request;
+    {
+        SpinlockLocker lock(m_hard_lock);
+        auto& command_slot = m_command_slots[command_slot_index];
+        VERIFY(command_slot.request);
+        request = command_slot.request;
+        command_slot.request.clear();
+        command_slot.scatter_list = nullptr;
+        m_allocated_command_slots &= ~(1u << command_slot_index);
+        m_issued_command_slots &= ~(1u << command_slot_index);
+    }
+    // Note: Completing the request might start the next one right away, so the command slot
+    // has to be free before we do that.
+    request->complete(result);
+}
+
+void AHCIPort::fail_all_outstanding_requests(AsyncDeviceRequest::RequestResult result)
+{
+    Vector<LockRefPtr<AsyncBlockDeviceRequest>, AHCI::Limits::MaxCommands> requests;
+    {
+        SpinlockLocker lock(m_hard_lock);
+        for (auto& command_slot : m_command_slots) {
+            if (!command_slot.request)
+                continue;
+            requests.unchecked_append(command_slot.request);
+            command_slot.request.clear();
+            command_slot.scatter_list = nullptr;
+        }
+        m_allocated_command_slots = 0;
+        m_issued_command_slots = 0;
+    }
+    for (auto& request : requests)
+        request->complete(result);
 }
 
 bool AHCIPort::spin_until_ready() const
@@ -479,44 +553,42 @@ bool AHCIPort::spin_until_ready() const
     return true;
 }
 
-bool AHCIPort::access_device(AsyncBlockDeviceRequest::RequestType direction, u64 lba, u8 block_count)
+bool AHCIPort::access_device(u8 command_slot_index, AsyncBlockDeviceRequest::RequestType direction, u64 lba, u8 block_count)
 {
     VERIFY(m_connected_device);
     VERIFY(is_operable());
     VERIFY(m_lock.is_locked());
-    VERIFY(m_current_scatter_list);
+    auto& command_slot = m_command_slots[command_slot_index];
+    VERIFY(command_slot.scatter_list);
     SpinlockLocker lock(m_hard_lock);
 
-    dbgln_if(AHCI_DEBUG, "AHCI Port {}: Do a {}, lba {}, block count {}", representative_port_index(), direction == AsyncBlockDeviceRequest::RequestType::Write ? "write" : "read", lba, block_count);
-    if (!spin_until_ready())
+    dbgln_if(AHCI_DEBUG, "AHCI Port {}: Do a {}, lba {}, block count {}, command slot {}", representative_port_index(), direction == AsyncBlockDeviceRequest::RequestType::Write ? "write" : "read", lba, block_count, command_slot_index);
+    // Note: With native command queuing, other commands are expected to still be in flight.
+    if (!m_native_command_queuing_enabled && !spin_until_ready())
         return false;
 
-    auto unused_command_header = try_to_find_unused_command_header();
-    VERIFY(unused_command_header.has_value());
     auto* command_list_entries = (volatile AHCI::CommandHeader*)m_command_list_region->vaddr().as_ptr();
-    command_list_entries[unused_command_header.value()].ctba = m_command_table_pages[unused_command_header.value()]->paddr().get();
-    command_list_entries[unused_command_header.value()].ctbau = 0;
-    command_list_entries[unused_command_header.value()].prdbc = 0;
-    command_list_entries[unused_command_header.value()].prdtl = m_current_scatter_list->scatters_count();
+    auto& command_list_entry = command_list_entries[command_slot_index];
+    command_list_entry.ctba = m_command_table_pages[command_slot_index]->paddr().get();
+    command_list_entry.ctbau = 0;
+    command_list_entry.prdbc = 0;
+    command_list_entry.prdtl = command_slot.scatter_list->scatters_count();
 
     // Note: we must set the correct Dword count in this register. Real hardware
     // AHCI controllers do care about this field! QEMU doesn't care if we don't
     // set the correct CFL field in this register, real hardware will set an
     // handshake error bit in PxSERR register if CFL is incorrect.
-    command_list_entries[unused_command_header.value()].attributes = (size_t)FIS::DwordCount::RegisterHostToDevice | AHCI::CommandHeaderAttributes::P | (is_atapi_attached() ? AHCI::CommandHeaderAttributes::A : 0) | (direction == AsyncBlockDeviceRequest::RequestType::Write ? AHCI::CommandHeaderAttributes::W : 0);
-
-    dbgln_if(AHCI_DEBUG, "AHCI Port {}: CLE: ctba={:#08x}, ctbau={:#08x}, prdbc={:#08x}, prdtl={:#04x}, attributes={:#04x}", representative_port_index(), (u32)command_list_entries[unused_command_header.value()].ctba, (u32)command_list_entries[unused_command_header.value()].ctbau, (u32)command_list_entries[unused_command_header.value()].prdbc, (u16)command_list_entries[unused_command_header.value()].prdtl, (u16)command_list_entries[unused_command_header.value()].attributes);
+    command_list_entry.attributes = (size_t)FIS::DwordCount::RegisterHostToDevice | AHCI::CommandHeaderAttributes::P | (is_atapi_attached() ? AHCI::CommandHeaderAttributes::A : 0) | (direction == AsyncBlockDeviceRequest::RequestType::Write ? AHCI::CommandHeaderAttributes::W : 0);
 
-    auto command_table_region = MM.allocate_kernel_region_with_physical_pages({ &m_command_table_pages[unused_command_header.value()], 1 }, "AHCI Command Table"sv, Memory::Region::Access::ReadWrite, Memory::Region::Cacheable::No).release_value();
-    auto& command_table = *(volatile AHCI::CommandTable*)command_table_region->vaddr().as_ptr();
+    dbgln_if(AHCI_DEBUG, "AHCI Port {}: CLE: ctba={:#08x}, ctbau={:#08x}, prdbc={:#08x}, prdtl={:#04x}, attributes={:#04x}", representative_port_index(), (u32)command_list_entry.ctba, (u32)command_list_entry.ctbau, (u32)command_list_entry.prdbc, (u16)command_list_entry.prdtl, (u16)command_list_entry.attributes);
 
-    dbgln_if(AHCI_DEBUG, "AHCI Port {}: Allocated command table at {}", representative_port_index(), command_table_region->vaddr());
+    auto& command_table = command_table_for_slot(command_slot_index);
 
     memset(const_cast<u8*>(command_table.command_fis), 0, 64);
 
     size_t scatter_entry_index = 0;
     size_t data_transfer_count = (block_count * m_connected_device->block_size());
-    for (auto scatter_page : m_current_scatter_list->vmobject().physical_pages()) {
+    for (auto scatter_page : command_slot.scatter_list->vmobject().physical_pages()) {
         VERIFY(data_transfer_count != 0);
         VERIFY(scatter_page);
         dbgln_if(AHCI_DEBUG, "AHCI Port {}: Add a transfer scatter entry @ {}", representative_port_index(), scatter_page->paddr());
@@ -540,6 +612,11 @@ bool AHCIPort::access_device(AsyncBlockDeviceRequest::RequestType direction, u64
     if (is_atapi_attached()) {
         fis.command = ATA_CMD_PACKET;
         TODO();
+    } else if (m_native_command_queuing_enabled) {
+        if (direction == AsyncBlockDeviceRequest::RequestType::Write)
+            fis.command = ATA_CMD_WRITE_FPDMA_QUEUED;
+        else
+            fis.command = ATA_CMD_READ_FPDMA_QUEUED;
     } else {
         if (direction == AsyncBlockDeviceRequest::RequestType::Write)
             fis.command = ATA_CMD_WRITE_DMA_EXT;
@@ -558,17 +635,25 @@ bool AHCIPort::access_device(AsyncBlockDeviceRequest::RequestType direction, u64
     fis.lba_low[0] = lba & 0xff;
     fis.lba_low[1] = (lba >> 8) & 0xff;
     fis.lba_low[2] = (lba >> 16) & 0xff;
-    fis.count = (block_count);
+    if (m_native_command_queuing_enabled) {
+        // Note: Queued commands carry the sector count in the features register,
+        // and the tag (which is the command slot index) in bits 7:3 of the count register.
+        fis.features_low = block_count;
+        fis.features_high = 0;
+        fis.count = command_slot_index << 3;
+    } else {
+        fis.count = (block_count);
+    }
 
     // The below loop waits until the port is no longer busy before issuing a new command
-    if (!spin_until_ready())
+    if (!m_native_command_queuing_enabled && !spin_until_ready())
         return false;
 
     full_memory_barrier();
-    mark_command_header_ready_to_process(unused_command_header.value());
+    mark_command_header_ready_to_process(command_slot_index);
     full_memory_barrier();
 
-    dbgln_if(AHCI_DEBUG, "AHCI Port {}: Do a {}, lba {}, block count {} @ {}, ended", representative_port_index(), direction == AsyncBlockDeviceRequest::RequestType::Write ? "write" : "read", lba, block_count, m_dma_buffers[0]->paddr());
+    dbgln_if(AHCI_DEBUG, "AHCI Port {}: Do a {}, lba {}, block count {} @ {}, ended", representative_port_index(), direction == AsyncBlockDeviceRequest::RequestType::Write ? "write" : "read", lba, block_count, m_dma_buffers[command_slot_index]->paddr());
     return true;
 }
 
@@ -591,8 +676,7 @@ bool AHCIPort::identify_device()
     // QEMU doesn't care if we don't set the correct CFL field in this register, real hardware will set an handshake error bit in PxSERR register.
     command_list_entries[unused_command_header.value()].attributes = (size_t)FIS::DwordCount::RegisterHostToDevice | AHCI::CommandHeaderAttributes::P;
 
-    auto command_table_region = MM.allocate_kernel_region_with_physical_pages({ &m_command_table_pages[unused_command_header.value()], 1 }, "AHCI Command Table"sv, Memory::Region::Access::ReadWrite).release_value();
-    auto& command_table = *(volatile AHCI::CommandTable*)command_table_region->vaddr().as_ptr();
+    auto& command_table = command_table_for_slot(unused_command_header.value());
     memset(const_cast<u8*>(command_table.command_fis), 0, 64);
     command_table.descriptors[0].base_high = 0;
     command_table.descriptors[0].base_low = m_identify_buffer_page->paddr().get();
@@ -669,8 +753,8 @@ bool AHCIPort::shutdown()
 Optional<u8> AHCIPort::try_to_find_unused_command_header()
 {
     VERIFY(m_lock.is_locked());
-    u32 commands_issued = m_port_registers.ci;
-    for (size_t index = 0; index < 32; index++) {
+    u32 commands_issued = m_port_registers.ci | m_port_registers.sact | m_allocated_command_slots;
+    for (size_t index = 0; index < m_command_queue_depth; index++) {
         if (!(commands_issued & 1)) {
             dbgln_if(AHCI_DEBUG, "AHCI Port {}: unused command header at index {}", representative_port_index(), index);
             return index;
@@ -689,14 +773,17 @@ void AHCIPort::start_command_list_processing() const
     m_port_registers.cmd = m_port_registers.cmd | 1;
 }
 
-void AHCIPort::mark_command_header_ready_to_process(u8 command_header_index) const
+void AHCIPort::mark_command_header_ready_to_process(u8 command_header_index)
 {
     VERIFY(m_lock.is_locked());
     VERIFY(m_hard_lock.is_locked());
     VERIFY(is_operable());
-    VERIFY(!m_wait_for_completion);
-    m_wait_for_completion = true;
+    VERIFY(!(m_issued_command_slots & (1u << command_header_index)));
+    m_issued_command_slots |= 1u << command_header_index;
     dbgln_if(AHCI_DEBUG, "AHCI Port {}: Marking command header at index {} as ready to process.", representative_port_index(), command_header_index);
+    // Note: For queued commands, the tag has to be marked as active before the command is issued.
+    if (m_native_command_queuing_enabled)
+        m_port_registers.sact = 1u << command_header_index;
     m_port_registers.ci = 1 << command_header_index;
 }
 
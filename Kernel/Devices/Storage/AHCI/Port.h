@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/OwnPtr.h>
 #include <AK/RefPtr.h>
 #include <Kernel/Devices/Device.h>
@@ -70,10 +71,13 @@ private:
     ALWAYS_INLINE void power_on() const;
 
     void start_request(AsyncBlockDeviceRequest&);
-    void complete_current_request(AsyncDeviceRequest::RequestResult);
-    bool access_device(AsyncBlockDeviceRequest::RequestType, u64 lba, u8 block_count);
+    void complete_command_slot(u8 command_slot_index, AsyncDeviceRequest::RequestResult);
+    void handle_completed_command_slot(u8 command_slot_index);
+    void fail_all_outstanding_requests(AsyncDeviceRequest::RequestResult);
+    bool access_device(u8 command_slot_index, AsyncBlockDeviceRequest::RequestType, u64 lba, u8 block_count);
     size_t calculate_descriptors_count(size_t block_count) const;
-    [[nodiscard]] Optional<AsyncDeviceRequest::RequestResult> prepare_and_set_scatter_list(AsyncBlockDeviceRequest& request);
+    [[nodiscard]] Optional<AsyncDeviceRequest::RequestResult> prepare_and_set_scatter_list(u8 command_slot_index, AsyncBlockDeviceRequest& request);
+    volatile AHCI::CommandTable& command_table_for_slot(u8 command_slot_index) const;
 
     ALWAYS_INLINE bool is_interrupts_enabled() const;
 
@@ -82,7 +86,7 @@ private:
     bool identify_device();
 
     ALWAYS_INLINE void start_command_list_processing() const;
-    ALWAYS_INLINE void mark_command_header_ready_to_process(u8 command_header_index) const;
+    ALWAYS_INLINE void mark_command_header_ready_to_process(u8 command_header_index);
     ALWAYS_INLINE void stop_command_list_processing() const;
 
     ALWAYS_INLINE void start_fis_receiving() const;
@@ -102,14 +106,28 @@ private:
     // Data members
 
     EntropySource m_entropy_source;
-    LockRefPtr<AsyncBlockDeviceRequest> m_current_request;
     Spinlock<LockRank::None> m_hard_lock {};
     Mutex m_lock { "AHCIPort"sv };
 
-    mutable bool m_wait_for_completion { false };
+    struct CommandSlot {
+        LockRefPtr<AsyncBlockDeviceRequest> request;
+        LockRefPtr<Memory::ScatterGatherList> scatter_list;
+    };
+    Array<CommandSlot, AHCI::Limits::MaxCommands> m_command_slots;
+
+    // Note: Both of these bitmaps are protected by m_hard_lock.
+    // A command slot is allocated from the moment a request is assigned to it until that request is completed,
+    // while it is only issued for as long as the HBA still owns the command in it.
+    u32 m_allocated_command_slots { 0 };
+    u32 m_issued_command_slots { 0 };
+
+    // Note: Without native command queuing we only ever use the first command slot.
+    bool m_native_command_queuing_enabled { false };
+    size_t m_command_queue_depth { 1 };
 
     Vector<NonnullRefPtr<Memory::PhysicalRAMPage>> m_dma_buffers;
     Vector<NonnullRefPtr<Memory::PhysicalRAMPage>> m_command_table_pages;
+    OwnPtr<Memory::Region> m_command_table_region;
     RefPtr<Memory::PhysicalRAMPage> m_command_list_page;
     OwnPtr<Memory::Region> m_command_list_region;
     RefPtr<Memory::PhysicalRAMPage> m_fis_receive_page;
@@ -129,7 +147,6 @@ private:
     AHCI::PortInterruptStatusBitField m_interrupt_status;
     AHCI::PortInterruptEnableBitField m_interrupt_enable;
 
-    LockRefPtr<Memory::ScatterGatherList> m_current_scatter_list;
     bool m_disabled_by_firmware { false };
 };
 }
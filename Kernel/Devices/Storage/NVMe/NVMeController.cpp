@@ -39,6 +39,7 @@ UNMAP_AFTER_INIT ErrorOr<void> NVMeController::initialize(bool is_queue_polled)
     // Nr of queues = one queue per core
     auto nr_of_queues = Processor::count();
     auto queue_type = is_queue_polled ? QueueType::Polled : QueueType::IRQ;
+    m_queue_type = queue_type;
 
     PCI::enable_memory_space(device_identifier());
     PCI::enable_bus_mastering(device_identifier());
@@ -181,6 +182,19 @@ UNMAP_AFTER_INIT ErrorOr<void> NVMeController::identify_and_init_namespaces()
             return EFAULT;
         }
     }
+    size_t active_namespace_count = 0;
+    for (auto nsid : active_namespace_list) {
+        if (nsid == 0)
+            break;
+        ++active_namespace_count;
+    }
+
+    // All namespaces share the IO queues, and no queue may ever have more than IO_QUEUE_SIZE - 1
+    // commands in flight. Polled queues complete commands synchronously, one at a time.
+    size_t max_concurrent_requests = 1;
+    if (m_queue_type == QueueType::IRQ && active_namespace_count > 0)
+        max_concurrent_requests = max<size_t>(1, (IO_QUEUE_SIZE - 1) / active_namespace_count);
+
     // Get the NAMESPACE attributes
     {
         NVMeSubmission sub {};
@@ -209,7 +223,7 @@ UNMAP_AFTER_INIT ErrorOr<void> NVMeController::identify_and_init_namespaces()
 
             dbgln_if(NVME_DEBUG, "NVMe: Block count is {} and Block size is {}", block_counts, block_size);
 
-            m_namespaces.append(TRY(NVMeNameSpace::try_create(*this, m_queues, nsid, block_counts, block_size)));
+            m_namespaces.append(TRY(NVMeNameSpace::try_create(*this, m_queues, nsid, block_counts, block_size, max_concurrent_requests)));
             m_device_count++;
             dbgln_if(NVME_DEBUG, "NVMe: Initialized namespace with NSID: {}", nsid);
         }
@@ -430,7 +444,8 @@ UNMAP_AFTER_INIT ErrorOr<void> NVMeController::create_io_queue(u8 qid, QueueType
         .dbbuf_eventidx = move(eventidx_doorbell_regs),
     };
 
-    auto irq = TRY(allocate_irq(qid));
+    // IO queue N is used by processor N - 1, so deliver its completions there as well.
+    auto irq = TRY(allocate_irq(qid, qid - 1));
 
     m_queues.append(TRY(NVMeQueue::try_create(*this, qid, irq, IO_QUEUE_SIZE, move(cq_dma_region), move(sq_dma_region), move(doorbell), queue_type)));
     dbgln_if(NVME_DEBUG, "NVMe: Created IO Queue with QID{}", m_queues.size());
@@ -45,6 +45,7 @@ struct NVMeIO {
         request = nullptr;
         end_io_handler = nullptr;
     }
+    bool is_in_use() const { return request || end_io_handler; }
     RefPtr<AsyncBlockDeviceRequest> request;
     Function<void(u16 status)> end_io_handler;
 };
@@ -83,21 +84,30 @@ protected:
             m_db_regs.mmio_reg->sq_tail = m_sq_tail;
     }
 
-    NVMeQueue(NonnullOwnPtr<Memory::Region> rw_dma_region, Memory::PhysicalRAMPage const& rw_dma_page, u16 qid, u32 q_depth, OwnPtr<Memory::Region> cq_dma_region, OwnPtr<Memory::Region> sq_dma_region, Doorbell db_regs);
+    NVMeQueue(NonnullOwnPtr<Memory::Region> rw_dma_region, Vector<NonnullRefPtr<Memory::PhysicalRAMPage>> rw_dma_pages, u16 qid, u32 q_depth, OwnPtr<Memory::Region> cq_dma_region, OwnPtr<Memory::Region> sq_dma_region, Doorbell db_regs);
 
-    [[nodiscard]] u32 get_request_cid()
+    // NOTE: This must be called with m_requests locked. Users of the queue make sure that
+    //       there are never more than m_qdepth - 1 commands in flight, so there is always a
+    //       free command identifier (and with it, a free slot in the submission queue).
+    [[nodiscard]] u16 allocate_request_cid(HashMap<u16, NVMeIO> const& requests)
     {
-        u32 expected_tag = m_tag.load(AK::memory_order_acquire);
-
-        for (;;) {
-            u32 cid = expected_tag + 1;
+        for (u32 attempts = 0; attempts < m_qdepth; ++attempts) {
+            u16 cid = m_tag + 1;
             if (cid == m_qdepth)
                 cid = 0;
-            if (m_tag.compare_exchange_strong(expected_tag, cid, AK::memory_order_acquire))
+            m_tag = cid;
+            auto it = requests.find(cid);
+            if (it == requests.end() || !it->value.is_in_use())
                 return cid;
         }
+        VERIFY_NOT_REACHED();
     }
 
+    // Every command identifier owns one page of the read/write DMA region, so that
+    // several commands can have their data in flight at the same time.
+    u8* rw_dma_buffer(u16 cid) { return m_rw_dma_region->vaddr().offset(cid * PAGE_SIZE).as_ptr(); }
+    PhysicalAddress rw_dma_buffer_paddr(u16 cid) const { return m_rw_dma_pages[cid]->paddr(); }
+
     virtual void complete_current_request(u16 cmdid, u16 status);
 
 private:
@@ -122,7 +132,7 @@ private:
     u16 m_cq_head {};
     bool m_admin_queue { false };
     u32 m_qdepth {};
-    Atomic<u32> m_tag { 0 }; // used for the cid in a submission queue entry
+    u16 m_tag { 0 }; // used for the cid in a submission queue entry, protected by m_requests
     Spinlock<LockRank::Interrupts> m_sq_lock {};
     OwnPtr<Memory::Region> m_cq_dma_region;
     Span<NVMeSubmission> m_sqe_array;
@@ -130,6 +140,6 @@ private:
     Span<NVMeCompletion> m_cqe_array;
     WaitQueue m_sync_wait_queue;
     Doorbell m_db_regs;
-    NonnullRefPtr<Memory::PhysicalRAMPage const> const m_rw_dma_page;
+    Vector<NonnullRefPtr<Memory::PhysicalRAMPage>> const m_rw_dma_pages;
 };
 }
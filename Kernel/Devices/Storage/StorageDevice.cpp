@@ -74,6 +74,55 @@ StringView StorageDevice::command_set_to_string_view() const
     VERIFY_NOT_REACHED();
 }
 
+ErrorOr<void> StorageDevice::transfer_whole_blocks(AsyncBlockDeviceRequest::RequestType request_type, u64 index, size_t block_count, UserOrKernelBuffer const& buffer)
+{
+    // NOTE: The drivers only have a single page of DMA buffer for each request (PATAChannel will chuck a wobbly otherwise),
+    //       so large transfers are split into page-sized requests. To make up for that, we submit as many of them as the
+    //       device can have in flight before waiting on any of them, which keeps deep hardware queues busy.
+    auto requests_per_batch = clamp<size_t>(max_concurrent_requests(), 1, MaximumRequestsPerBatch);
+
+    size_t blocks_submitted = 0;
+    while (blocks_submitted < block_count) {
+        Vector<NonnullLockRefPtr<AsyncBlockDeviceRequest>, MaximumRequestsPerBatch> requests;
+        ErrorOr<void> result {};
+        while (requests.size() < requests_per_batch && blocks_submitted < block_count) {
+            auto blocks_in_request = min(m_blocks_per_page, block_count - blocks_submitted);
+            auto request_or_error = try_make_request<AsyncBlockDeviceRequest>(request_type, index + blocks_submitted, blocks_in_request, buffer.offset(blocks_submitted * block_size()), blocks_in_request * block_size());
+            if (request_or_error.is_error()) {
+                result = request_or_error.release_error();
+                break;
+            }
+            requests.unchecked_append(request_or_error.release_value());
+            blocks_submitted += blocks_in_request;
+        }
+
+        // NOTE: We have to wait for every request we submitted, even after one of them failed,
+        //       as they all still refer to the buffer.
+        for (auto& request : requests) {
+            auto request_result = request->wait();
+            if (result.is_error())
+                continue;
+            if (request_result.wait_result().was_interrupted()) {
+                result = Error::from_errno(EINTR);
+                continue;
+            }
+            switch (request_result.request_result()) {
+            case AsyncDeviceRequest::Failure:
+            case AsyncDeviceRequest::Cancelled:
+                result = Error::from_errno(EIO);
+                break;
+            case AsyncDeviceRequest::MemoryFault:
+                result = Error::from_errno(EFAULT);
+                break;
+            default:
+                break;
+            }
+        }
+        TRY(result);
+    }
+    return {};
+}
+
 ErrorOr<size_t> StorageDevice::read(OpenFileDescription&, u64 offset, UserOrKernelBuffer& outbuf, size_t len)
 {
     // NOTE: The last available offset is actually just after the last addressable block.
@@ -85,33 +134,13 @@ ErrorOr<size_t> StorageDevice::read(OpenFileDescription&, u64 offset, UserOrKern
     size_t whole_blocks = nread >> block_size_log();
     size_t remaining = nread - (whole_blocks << block_size_log());
 
-    // PATAChannel will chuck a wobbly if we try to read more than PAGE_SIZE
-    // at a time, because it uses a single page for its DMA buffer.
-    if (whole_blocks >= m_blocks_per_page) {
-        whole_blocks = m_blocks_per_page;
-        remaining = 0;
-    }
-
     if (nread < block_size())
         offset_within_block = offset - (index << block_size_log());
 
     dbgln_if(STORAGE_DEVICE_DEBUG, "StorageDevice::read() index={}, whole_blocks={}, remaining={}", index, whole_blocks, remaining);
 
-    if (whole_blocks > 0) {
-        auto read_request = TRY(try_make_request<AsyncBlockDeviceRequest>(AsyncBlockDeviceRequest::Read, index, whole_blocks, outbuf, whole_blocks * block_size()));
-        auto result = read_request->wait();
-        if (result.wait_result().was_interrupted())
-            return EINTR;
-        switch (result.request_result()) {
-        case AsyncDeviceRequest::Failure:
-        case AsyncDeviceRequest::Cancelled:
-            return EIO;
-        case AsyncDeviceRequest::MemoryFault:
-            return EFAULT;
-        default:
-            break;
-        }
-    }
+    if (whole_blocks > 0)
+        TRY(transfer_whole_blocks(AsyncBlockDeviceRequest::Read, index, whole_blocks, outbuf));
 
     off_t pos = whole_blocks * block_size();
 
@@ -150,13 +179,6 @@ ErrorOr<size_t> StorageDevice::write(OpenFileDescription&, u64 offset, UserOrKer
     size_t whole_blocks = nwrite >> block_size_log();
     size_t remaining = nwrite - (whole_blocks << block_size_log());
 
-    // PATAChannel will chuck a wobbly if we try to write more than PAGE_SIZE
-    // at a time, because it uses a single page for its DMA buffer.
-    if (whole_blocks >= m_blocks_per_page) {
-        whole_blocks = m_blocks_per_page;
-        remaining = 0;
-    }
-
     if (nwrite < block_size())
         offset_within_block = offset - (index << block_size_log());
 
@@ -168,21 +190,8 @@ ErrorOr<size_t> StorageDevice::write(OpenFileDescription&, u64 offset, UserOrKer
 
     dbgln_if(STORAGE_DEVICE_DEBUG, "StorageDevice::write() index={}, whole_blocks={}, remaining={}", index, whole_blocks, remaining);
 
-    if (whole_blocks > 0) {
-        auto write_request = TRY(try_make_request<AsyncBlockDeviceRequest>(AsyncBlockDeviceRequest::Write, index, whole_blocks, inbuf, whole_blocks * block_size()));
-        auto result = write_request->wait();
-        if (result.wait_result().was_interrupted())
-            return EINTR;
-        switch (result.request_result()) {
-        case AsyncDeviceRequest::Failure:
-        case AsyncDeviceRequest::Cancelled:
-            return EIO;
-        case AsyncDeviceRequest::MemoryFault:
-            return EFAULT;
-        default:
-            break;
-        }
-    }
+    if (whole_blocks > 0)
+        TRY(transfer_whole_blocks(AsyncBlockDeviceRequest::Write, index, whole_blocks, inbuf));
 
     off_t pos = whole_blocks * block_size();
 
@@ -89,9 +89,13 @@ protected:
     virtual StringView class_name() const override;
 
 private:
+    static constexpr size_t MaximumRequestsPerBatch = 32;
+
     virtual ErrorOr<void> after_inserting() override;
     virtual void will_be_destroyed() override;
 
+    ErrorOr<void> transfer_whole_blocks(AsyncBlockDeviceRequest::RequestType, u64 index, size_t block_count, UserOrKernelBuffer const&);
+
     mutable IntrusiveListNode<StorageDevice, LockRefPtr<StorageDevice>> m_list_node;
     Vector<NonnullLockRefPtr<StorageDevicePartition>> m_partitions;
 
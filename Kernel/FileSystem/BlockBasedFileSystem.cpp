@@ -4,53 +4,83 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AnyOf.h>
 #include <AK/IntrusiveList.h>
+#include <AK/QuickSort.h>
 #include <Kernel/Debug.h>
 #include <Kernel/FileSystem/BlockBasedFileSystem.h>
+#include <Kernel/Memory/MemoryManager.h>
 #include <Kernel/Tasks/Process.h>
+#include <Kernel/Tasks/SyncTask.h>
 
 namespace Kernel {
 
 struct CacheEntry {
+    enum class List : u8 {
+        Free,
+        Probation,
+        Protected,
+        Dirty,
+        __Count,
+    };
+
     IntrusiveListNode<CacheEntry> list_node;
     BlockBasedFileSystem::BlockIndex block_index { 0 };
     u8* data { nullptr };
+    // NOTE: Blocks that became dirty earlier have a lower dirty generation, so a flush can skip
+    //       blocks that were dirtied after it started.
+    u64 dirty_generation { 0 };
     bool has_data { false };
+    List list { List::Free };
 };
 
+// The cache is a segmented LRU, a close relative of 2Q: blocks enter the probation
+// segment and are only promoted to the protected segment once they are hit again.
+// Eviction takes from the probation segment first, so a single large sequential scan
+// can't push out the blocks that are actually being re-read.
+//
+// The cache starts out small and grows one chunk at a time while there is plenty of
+// free physical memory, and gives chunks back again once physical memory runs low.
 class DiskCache {
 public:
-    static constexpr size_t EntryCount = 10000;
-    explicit DiskCache(BlockBasedFileSystem& fs, NonnullOwnPtr<KBuffer> cached_block_data, NonnullOwnPtr<KBuffer> entries_buffer)
-        : m_fs(fs)
-        , m_cached_block_data(move(cached_block_data))
-        , m_entries(move(entries_buffer))
+    static constexpr size_t EntriesPerChunk = 1024;
+    static constexpr size_t MaximumChunkCount = 64;
+
+    static ErrorOr<NonnullOwnPtr<DiskCache>> try_create(BlockBasedFileSystem& fs)
     {
-        for (size_t i = 0; i < EntryCount; ++i) {
-            entries()[i].data = m_cached_block_data->data() + i * m_fs->logical_block_size();
-            m_clean_list.append(entries()[i]);
-        }
+        auto cache = TRY(adopt_nonnull_own_or_enomem(new (nothrow) DiskCache(fs)));
+        TRY(cache->try_grow());
+        return cache;
     }
 
     ~DiskCache() = default;
 
-    bool is_dirty() const { return !m_dirty_list.is_empty(); }
-    bool entry_is_dirty(CacheEntry const& entry) const { return m_dirty_list.contains(entry); }
+    bool is_dirty() const { return !list(CacheEntry::List::Dirty).is_empty(); }
+    size_t dirty_count() const { return list_size(CacheEntry::List::Dirty); }
+    bool entry_is_dirty(CacheEntry const& entry) const { return entry.list == CacheEntry::List::Dirty; }
 
-    void mark_all_clean()
-    {
-        while (auto* entry = m_dirty_list.first())
-            m_clean_list.prepend(*entry);
-    }
+    // Once this many blocks are dirty, the SyncTask starts writing them back in the background.
+    size_t background_writeback_threshold() const { return capacity() / 4; }
+    // Writers that push the number of dirty blocks past this have to write some of them back themselves,
+    // so dirty data can't pile up faster than the device takes it.
+    size_t writer_throttle_threshold() const { return capacity() / 2; }
+
+    u64 next_dirty_generation() const { return m_next_dirty_generation; }
+
+    // NOTE: The dirty list is kept in the order the entries became dirty, with the oldest one at the back.
+    CacheEntry* oldest_dirty_entry() const { return list(CacheEntry::List::Dirty).last(); }
 
     void mark_dirty(CacheEntry& entry)
     {
-        m_dirty_list.prepend(entry);
+        if (entry_is_dirty(entry))
+            return;
+        entry.dirty_generation = m_next_dirty_generation++;
+        move_entry(entry, CacheEntry::List::Dirty);
     }
 
     void mark_clean(CacheEntry& entry)
     {
-        m_clean_list.prepend(entry);
+        move_entry(entry, CacheEntry::List::Probation);
     }
 
     CacheEntry* get(BlockBasedFileSystem::BlockIndex block_index) const
@@ -60,19 +90,51 @@ public:
             return nullptr;
         auto& entry = const_cast<CacheEntry&>(*it->value);
         VERIFY(entry.block_index == block_index);
-        if (!entry_is_dirty(entry) && (m_clean_list.first() != &entry)) {
-            // Cache hit! Promote the entry to the front of the list.
-            m_clean_list.prepend(entry);
+        switch (entry.list) {
+        case CacheEntry::List::Probation:
+            // Second hit, this block is part of the working set.
+            move_entry(entry, CacheEntry::List::Protected);
+            if (list_size(CacheEntry::List::Protected) > protected_capacity())
+                move_entry(*list(CacheEntry::List::Protected).last(), CacheEntry::List::Probation);
+            break;
+        case CacheEntry::List::Protected:
+            if (list(CacheEntry::List::Protected).first() != &entry)
+                move_entry(entry, CacheEntry::List::Protected);
+            break;
+        case CacheEntry::List::Dirty:
+            break;
+        default:
+            VERIFY_NOT_REACHED();
         }
         return &entry;
     }
 
     ErrorOr<CacheEntry*> ensure(BlockBasedFileSystem::BlockIndex block_index) const
     {
-        if (auto* entry = get(block_index))
+        if (auto* entry = get(block_index)) {
+            ++m_statistics.hits;
             return entry;
+        }
+        ++m_statistics.misses;
+
+        if (++m_misses_since_memory_check >= MissesBetweenMemoryChecks) {
+            m_misses_since_memory_check = 0;
+            if (should_shrink())
+                shrink();
+        }
 
-        if (m_clean_list.is_empty()) {
+        if (list(CacheEntry::List::Free).is_empty() && should_grow()) {
+            // Not being able to grow isn't fatal, we just keep recycling what we have.
+            (void)try_grow();
+        }
+
+        auto* new_entry = list(CacheEntry::List::Free).last();
+        if (!new_entry)
+            new_entry = list(CacheEntry::List::Probation).last();
+        if (!new_entry)
+            new_entry = list(CacheEntry::List::Protected).last();
+
+        if (!new_entry) {
             // Not a single clean entry! Flush writes and try again.
             // NOTE: We want to make sure we only call FileBackedFileSystem flush here,
             //       not some FileBackedFileSystem subclass flush!
@@ -80,39 +142,133 @@ public:
             return ensure(block_index);
         }
 
-        VERIFY(m_clean_list.last());
-        auto& new_entry = *m_clean_list.last();
-        m_clean_list.prepend(new_entry);
-
-        m_hash.remove(new_entry.block_index);
-        TRY(m_hash.try_set(block_index, &new_entry));
+        if (new_entry->list != CacheEntry::List::Free) {
+            m_hash.remove(new_entry->block_index);
+            ++m_statistics.evictions;
+        }
+        TRY(m_hash.try_set(block_index, new_entry));
+        move_entry(*new_entry, CacheEntry::List::Probation);
 
-        new_entry.block_index = block_index;
-        new_entry.has_data = false;
+        new_entry->block_index = block_index;
+        new_entry->has_data = false;
 
-        return &new_entry;
+        return new_entry;
     }
 
-    CacheEntry const* entries() const { return (CacheEntry const*)m_entries->data(); }
-    CacheEntry* entries() { return (CacheEntry*)m_entries->data(); }
-
     template<typename Callback>
     void for_each_dirty_entry(Callback callback)
     {
-        for (auto& entry : m_dirty_list)
+        for (auto& entry : list(CacheEntry::List::Dirty))
             callback(entry);
     }
 
+    BlockBasedFileSystem::DiskCacheStatistics statistics() const
+    {
+        auto statistics = m_statistics;
+        statistics.capacity = capacity();
+        statistics.dirty = list_size(CacheEntry::List::Dirty);
+        return statistics;
+    }
+
 private:
+    static constexpr size_t MissesBetweenMemoryChecks = 64;
+
+    struct Chunk {
+        NonnullOwnPtr<KBuffer> block_data;
+        NonnullOwnPtr<KBuffer> entries_data;
+
+        Span<CacheEntry> entries() { return { reinterpret_cast<CacheEntry*>(entries_data->data()), EntriesPerChunk }; }
+    };
+
+    explicit DiskCache(BlockBasedFileSystem& fs)
+        : m_fs(fs)
+    {
+    }
+
+    size_t capacity() const { return m_chunks.size() * EntriesPerChunk; }
+    size_t protected_capacity() const { return capacity() * 3 / 4; }
+
+    IntrusiveList<&CacheEntry::list_node>& list(CacheEntry::List which) const { return m_lists[to_underlying(which)]; }
+    size_t list_size(CacheEntry::List which) const { return m_list_sizes[to_underlying(which)]; }
+
+    void move_entry(CacheEntry& entry, CacheEntry::List destination) const
+    {
+        if (entry.list_node.is_in_list())
+            --m_list_sizes[to_underlying(entry.list)];
+        entry.list = destination;
+        list(destination).prepend(entry);
+        ++m_list_sizes[to_underlying(destination)];
+    }
+
+    size_t pages_per_chunk() const { return ceil_div(EntriesPerChunk * m_fs->logical_block_size(), static_cast<u64>(PAGE_SIZE)); }
+
+    bool should_grow() const
+    {
+        if (m_chunks.size() >= MaximumChunkCount)
+            return false;
+        auto memory = MM.get_system_memory_info();
+        auto available_pages = memory.physical_pages - memory.physical_pages_used;
+        // Keep at least a quarter of physical memory free, and never let a single cache use more than an eighth of it.
+        if (available_pages < memory.physical_pages / 4 + pages_per_chunk())
+            return false;
+        return (m_chunks.size() + 1) * pages_per_chunk() <= memory.physical_pages / 8;
+    }
+
+    bool should_shrink() const
+    {
+        if (m_chunks.size() <= 1)
+            return false;
+        auto memory = MM.get_system_memory_info();
+        auto available_pages = memory.physical_pages - memory.physical_pages_used;
+        return available_pages < memory.physical_pages / 16;
+    }
+
+    ErrorOr<void> try_grow() const
+    {
+        VERIFY(m_chunks.size() < MaximumChunkCount);
+        auto block_size = m_fs->logical_block_size();
+        auto block_data = TRY(KBuffer::try_create_with_size("BlockBasedFS: Cache blocks"sv, EntriesPerChunk * block_size));
+        auto entries_data = TRY(KBuffer::try_create_with_size("BlockBasedFS: Cache entries"sv, EntriesPerChunk * sizeof(CacheEntry)));
+        TRY(m_chunks.try_append({ move(block_data), move(entries_data) }));
+
+        auto& chunk = m_chunks.last();
+        for (size_t i = 0; i < EntriesPerChunk; ++i) {
+            auto* entry = new (&chunk.entries()[i]) CacheEntry;
+            entry->data = chunk.block_data->data() + i * block_size;
+            move_entry(*entry, CacheEntry::List::Free);
+        }
+        return {};
+    }
+
+    void shrink() const
+    {
+        VERIFY(m_chunks.size() > 1);
+        auto& chunk = m_chunks.last();
+        if (any_of(chunk.entries(), [&](auto& entry) { return entry_is_dirty(entry); }))
+            m_fs->flush_writes_impl();
+
+        for (auto& entry : chunk.entries()) {
+            VERIFY(!entry_is_dirty(entry));
+            if (entry.list != CacheEntry::List::Free)
+                m_hash.remove(entry.block_index);
+            --m_list_sizes[to_underlying(entry.list)];
+            list(entry.list).remove(entry);
+            entry.~CacheEntry();
+        }
+        m_chunks.take_last();
+    }
+
     mutable NonnullRefPtr<BlockBasedFileSystem> m_fs;
-    NonnullOwnPtr<KBuffer> m_cached_block_data;
 
-    // NOTE: m_entries must be declared before m_dirty_list and m_clean_list because their entries are allocated from it.
-    // We need to ensure that the destructors of m_dirty_list and m_clean_list are called before m_entries is destroyed.
-    NonnullOwnPtr<KBuffer> m_entries;
-    mutable IntrusiveList<&CacheEntry::list_node> m_dirty_list;
-    mutable IntrusiveList<&CacheEntry::list_node> m_clean_list;
+    // NOTE: m_chunks must be declared before m_lists because the entries are allocated from it.
+    // We need to ensure that the destructors of m_lists are called before the chunks are destroyed.
+    mutable Vector<Chunk, MaximumChunkCount> m_chunks;
+    mutable Array<IntrusiveList<&CacheEntry::list_node>, to_underlying(CacheEntry::List::__Count)> m_lists;
+    mutable Array<size_t, to_underlying(CacheEntry::List::__Count)> m_list_sizes {};
     mutable HashMap<BlockBasedFileSystem::BlockIndex, CacheEntry*> m_hash;
+    mutable BlockBasedFileSystem::DiskCacheStatistics m_statistics;
+    mutable size_t m_misses_since_memory_check { 0 };
+    u64 m_next_dirty_generation { 0 };
 };
 
 BlockBasedFileSystem::BlockBasedFileSystem(OpenFileDescription& file_description)
@@ -136,9 +292,7 @@ ErrorOr<void> BlockBasedFileSystem::initialize_while_locked()
     VERIFY(m_lock.is_locked());
     VERIFY(!is_initialized_while_locked());
     VERIFY(logical_block_size() != 0);
-    auto cached_block_data = TRY(KBuffer::try_create_with_size("BlockBasedFS: Cache blocks"sv, DiskCache::EntryCount * logical_block_size()));
-    auto entries_data = TRY(KBuffer::try_create_with_size("BlockBasedFS: Cache entries"sv, DiskCache::EntryCount * sizeof(CacheEntry)));
-    auto disk_cache = TRY(adopt_nonnull_own_or_enomem(new (nothrow) DiskCache(*this, move(cached_block_data), move(entries_data))));
+    auto disk_cache = TRY(DiskCache::try_create(*this));
 
     m_cache.with_exclusive([&](auto& cache) {
         cache = move(disk_cache);
@@ -146,6 +300,15 @@ ErrorOr<void> BlockBasedFileSystem::initialize_while_locked()
     return {};
 }
 
+BlockBasedFileSystem::DiskCacheStatistics BlockBasedFileSystem::disk_cache_statistics() const
+{
+    return m_cache.with_exclusive([&](auto& cache) -> DiskCacheStatistics {
+        if (!cache)
+            return {};
+        return cache->statistics();
+    });
+}
+
 ErrorOr<void> BlockBasedFileSystem::write_block(BlockIndex index, UserOrKernelBuffer const& data, size_t count, u64 offset, bool allow_cache)
 {
     VERIFY(m_device_block_size);
@@ -159,7 +322,14 @@ ErrorOr<void> BlockBasedFileSystem::write_block(BlockIndex index, UserOrKernelBu
 
     TRY(data.read(buffered_data.bytes()));
 
-    return m_cache.with_exclusive([&](auto& cache) -> ErrorOr<void> {
+    enum class DirtyState {
+        BelowThreshold,
+        NeedsBackgroundWriteback,
+        NeedsThrottling,
+    };
+    auto dirty_state = DirtyState::BelowThreshold;
+
+    TRY(m_cache.with_exclusive([&](auto& cache) -> ErrorOr<void> {
         if (!allow_cache) {
             flush_specific_block_if_needed(index);
             u64 base_offset = index.value() * logical_block_size() + offset;
@@ -177,8 +347,27 @@ ErrorOr<void> BlockBasedFileSystem::write_block(BlockIndex index, UserOrKernelBu
 
         cache->mark_dirty(*entry);
         entry->has_data = true;
+
+        if (cache->dirty_count() >= cache->writer_throttle_threshold())
+            dirty_state = DirtyState::NeedsThrottling;
+        else if (cache->dirty_count() >= cache->background_writeback_threshold())
+            dirty_state = DirtyState::NeedsBackgroundWriteback;
         return {};
-    });
+    }));
+
+    switch (dirty_state) {
+    case DirtyState::BelowThreshold:
+        break;
+    case DirtyState::NeedsBackgroundWriteback:
+        SyncTask::request_writeback();
+        break;
+    case DirtyState::NeedsThrottling:
+        // NOTE: The background writeback didn't keep up, so make this writer wait for its share of it.
+        dbgln_if(BBFS_DEBUG, "BlockBasedFileSystem::write_block: Throttling writer, too many dirty blocks");
+        write_back_in_background();
+        break;
+    }
+    return {};
 }
 
 ErrorOr<void> BlockBasedFileSystem::raw_read(BlockIndex index, UserOrKernelBuffer& buffer)
@@ -288,21 +477,110 @@ void BlockBasedFileSystem::flush_specific_block_if_needed(BlockIndex index)
     });
 }
 
-void BlockBasedFileSystem::flush_writes_impl()
+size_t BlockBasedFileSystem::write_back_dirty_blocks(u64 dirtied_before, size_t maximum_block_count)
 {
+    // NOTE: Dirty blocks are written back in block order, and runs of adjacent blocks are gathered
+    //       into a single write, so the device sees a few large sequential writes instead of many
+    //       small scattered ones.
+    static constexpr size_t MaximumBlocksPerWrite = 64;
+
     size_t count = 0;
+    size_t write_count = 0;
     m_cache.with_exclusive([&](auto& cache) {
-        if (!cache->is_dirty())
+        if (!cache || !cache->is_dirty())
             return;
-        cache->for_each_dirty_entry([&](CacheEntry& entry) {
+
+        auto write_entry = [&](CacheEntry& entry) {
             auto base_offset = entry.block_index.value() * logical_block_size();
             auto entry_data_buffer = UserOrKernelBuffer::for_kernel_buffer(entry.data);
             [[maybe_unused]] auto rc = file_description().write(base_offset, entry_data_buffer, logical_block_size());
+            cache->mark_clean(entry);
             ++count;
+            ++write_count;
+        };
+
+        Vector<CacheEntry*> dirty_entries;
+        auto gather_buffer_or_error = ByteBuffer::create_uninitialized(MaximumBlocksPerWrite * logical_block_size());
+        if (gather_buffer_or_error.is_error() || dirty_entries.try_ensure_capacity(cache->dirty_count()).is_error()) {
+            // We are low on memory, so just write out the oldest blocks one at a time.
+            while (count < maximum_block_count) {
+                auto* entry = cache->oldest_dirty_entry();
+                if (!entry || entry->dirty_generation >= dirtied_before)
+                    break;
+                write_entry(*entry);
+            }
+            return;
+        }
+        auto gather_buffer = gather_buffer_or_error.release_value();
+
+        cache->for_each_dirty_entry([&](CacheEntry& entry) {
+            if (entry.dirty_generation < dirtied_before)
+                dirty_entries.unchecked_append(&entry);
         });
-        cache->mark_all_clean();
-        dbgln("{}: Flushed {} blocks to disk", class_name(), count);
+        quick_sort(dirty_entries, [](auto* a, auto* b) { return a->block_index.value() < b->block_index.value(); });
+        if (dirty_entries.size() > maximum_block_count)
+            dirty_entries.shrink(maximum_block_count);
+
+        for (size_t run_start = 0; run_start < dirty_entries.size();) {
+            size_t run_length = 1;
+            while (run_start + run_length < dirty_entries.size()
+                && run_length < MaximumBlocksPerWrite
+                && dirty_entries[run_start + run_length]->block_index.value() == dirty_entries[run_start]->block_index.value() + run_length)
+                ++run_length;
+
+            if (run_length == 1) {
+                write_entry(*dirty_entries[run_start]);
+            } else {
+                for (size_t i = 0; i < run_length; ++i)
+                    memcpy(gather_buffer.offset_pointer(i * logical_block_size()), dirty_entries[run_start + i]->data, logical_block_size());
+                auto base_offset = dirty_entries[run_start]->block_index.value() * logical_block_size();
+                auto gather_data_buffer = UserOrKernelBuffer::for_kernel_buffer(gather_buffer.data());
+                [[maybe_unused]] auto rc = file_description().write(base_offset, gather_data_buffer, run_length * logical_block_size());
+                for (size_t i = 0; i < run_length; ++i)
+                    cache->mark_clean(*dirty_entries[run_start + i]);
+                count += run_length;
+                ++write_count;
+            }
+            run_start += run_length;
+        }
+    });
+    dbgln_if(BBFS_DEBUG, "{}: Wrote back {} blocks in {} writes", class_name(), count, write_count);
+    return count;
+}
+
+void BlockBasedFileSystem::flush_writes_impl()
+{
+    // NOTE: The cache is only locked for one batch of blocks at a time, so everyone else using this
+    //       file system gets a chance to run in between instead of stalling until the whole flush is done.
+    //       Blocks that get dirtied while we're flushing are left for next time, so this can't go on forever.
+    static constexpr size_t BlocksPerBatch = 1024;
+
+    auto dirtied_before = m_cache.with_exclusive([](auto& cache) -> u64 {
+        if (!cache)
+            return 0;
+        return cache->next_dirty_generation();
     });
+
+    size_t count = 0;
+    while (auto written = write_back_dirty_blocks(dirtied_before, BlocksPerBatch))
+        count += written;
+    if (count != 0)
+        dbgln("{}: Flushed {} blocks to disk", class_name(), count);
+}
+
+void BlockBasedFileSystem::write_back_in_background()
+{
+    static constexpr size_t BlocksPerBatch = 256;
+
+    while (true) {
+        auto needs_writeback = m_cache.with_exclusive([](auto& cache) {
+            return cache && cache->dirty_count() >= cache->background_writeback_threshold();
+        });
+        if (!needs_writeback)
+            return;
+        if (write_back_dirty_blocks(NumericLimits<u64>::max(), BlocksPerBatch) == 0)
+            return;
+    }
 }
 
 ErrorOr<void> BlockBasedFileSystem::flush_writes()
@@ -19,9 +19,22 @@ public:
 
     u64 device_block_size() const { return m_device_block_size; }
 
+    struct DiskCacheStatistics {
+        u64 hits { 0 };
+        u64 misses { 0 };
+        u64 evictions { 0 };
+        size_t capacity { 0 };
+        size_t dirty { 0 };
+    };
+    DiskCacheStatistics disk_cache_statistics() const;
+
+    virtual bool is_block_based() const override { return true; }
+
     virtual ErrorOr<void> flush_writes() override;
     void flush_writes_impl();
 
+    virtual void write_back_in_background() override;
+
 protected:
     explicit BlockBasedFileSystem(OpenFileDescription&);
 
@@ -45,6 +58,7 @@ protected:
 
 private:
     void flush_specific_block_if_needed(BlockIndex index);
+    size_t write_back_dirty_blocks(u64 dirtied_before, size_t maximum_block_count);
 
     mutable MutexProtected<OwnPtr<DiskCache>> m_cache;
 };
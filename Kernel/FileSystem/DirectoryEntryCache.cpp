@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/Debug.h>
+#include <Kernel/FileSystem/DirectoryEntryCache.h>
+#include <Kernel/FileSystem/Inode.h>
+
+namespace Kernel {
+
+unsigned DirectoryEntryCache::hash_for(Inode const& parent, StringView name)
+{
+    return pair_int_hash(ptr_hash(&parent), name.hash());
+}
+
+void DirectoryEntryCache::remove_entry(Entries& entries, Entry& entry, EntryList& removed_entries)
+{
+    entries.table.remove(&entry);
+    entries.lru_list.remove(entry);
+    removed_entries.append(entry);
+}
+
+void DirectoryEntryCache::delete_entries(EntryList& entries)
+{
+    // NOTE: This must not be called with the cache lock held, as dropping the last reference
+    //       to an Inode might have to go to disk.
+    while (!entries.is_empty()) {
+        auto& entry = *entries.first();
+        entries.remove(entry);
+        delete &entry;
+    }
+}
+
+Optional<RefPtr<Inode>> DirectoryEntryCache::lookup(Inode& parent, StringView name)
+{
+    auto hash = hash_for(parent, name);
+    return m_entries.with([&](auto& entries) -> Optional<RefPtr<Inode>> {
+        auto it = entries.table.find(hash, [&](Entry const* entry) {
+            return entry->parent.ptr() == &parent && entry->name->view() == name;
+        });
+        if (it == entries.table.end())
+            return {};
+        auto& entry = **it;
+        entries.lru_list.remove(entry);
+        entries.lru_list.prepend(entry);
+        return entry.child;
+    });
+}
+
+void DirectoryEntryCache::add(Inode& parent, StringView name, RefPtr<Inode> child, u64 generation)
+{
+    auto name_or_error = KString::try_create(name);
+    if (name_or_error.is_error())
+        return;
+    auto* new_entry = new (nothrow) Entry { parent, name_or_error.release_value(), move(child), hash_for(parent, name), {} };
+    if (!new_entry)
+        return;
+
+    EntryList removed_entries;
+    m_entries.with([&](auto& entries) {
+        // NOTE: If the directory changed since our caller called generation(), their lookup
+        //       might have seen the old contents, so it's not safe to remember it.
+        if (m_generation.load(AK::MemoryOrder::memory_order_relaxed) != generation) {
+            removed_entries.append(*new_entry);
+            return;
+        }
+        auto it = entries.table.find(new_entry->hash, [&](Entry const* entry) {
+            return EntryTraits::equals(entry, new_entry);
+        });
+        if (it != entries.table.end())
+            remove_entry(entries, **it, removed_entries);
+        if (entries.table.try_set(new_entry).is_error()) {
+            removed_entries.append(*new_entry);
+            return;
+        }
+        entries.lru_list.prepend(*new_entry);
+        while (entries.table.size() > max_entries)
+            remove_entry(entries, *entries.lru_list.last(), removed_entries);
+    });
+    delete_entries(removed_entries);
+}
+
+void DirectoryEntryCache::invalidate(Inode& parent, StringView name)
+{
+    auto hash = hash_for(parent, name);
+    EntryList removed_entries;
+    m_entries.with([&](auto& entries) {
+        m_generation.fetch_add(1, AK::MemoryOrder::memory_order_release);
+        auto it = entries.table.find(hash, [&](Entry const* entry) {
+            return entry->parent.ptr() == &parent && entry->name->view() == name;
+        });
+        if (it != entries.table.end())
+            remove_entry(entries, **it, removed_entries);
+    });
+    delete_entries(removed_entries);
+}
+
+void DirectoryEntryCache::purge(FileSystemID fsid)
+{
+    EntryList removed_entries;
+    m_entries.with([&](auto& entries) {
+        m_generation.fetch_add(1, AK::MemoryOrder::memory_order_release);
+        for (auto it = entries.lru_list.begin(); it != entries.lru_list.end();) {
+            auto& entry = *it;
+            ++it;
+            if (entry.parent->fsid() == fsid || (entry.child && entry.child->fsid() == fsid))
+                remove_entry(entries, entry, removed_entries);
+        }
+    });
+    dbgln_if(VFS_DEBUG, "DirectoryEntryCache: Purged entries of file system {}", fsid);
+    delete_entries(removed_entries);
+}
+
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/HashTable.h>
+#include <AK/IntrusiveList.h>
+#include <AK/Optional.h>
+#include <AK/RefPtr.h>
+#include <Kernel/FileSystem/InodeIdentifier.h>
+#include <Kernel/Forward.h>
+#include <Kernel/Library/KString.h>
+#include <Kernel/Locking/SpinlockProtected.h>
+
+namespace Kernel {
+
+// Remembers the results of Inode::lookup(), both found children and names that don't exist,
+// so that resolving the same path over and over again doesn't have to ask the file system.
+// Only file systems that report every change to their directories through Inode::did_add_child()
+// and Inode::did_remove_child() may opt into this (see FileSystem::supports_directory_entry_cache()).
+class DirectoryEntryCache {
+public:
+    static constexpr size_t max_entries = 4096;
+
+    // Returns an empty Optional on a cache miss, and a null RefPtr if the name is known not to exist.
+    Optional<RefPtr<Inode>> lookup(Inode& parent, StringView name);
+
+    // Call this before doing the Inode::lookup() that will be passed to add(). If the cache was
+    // invalidated in the meantime, the lookup result might be stale and won't be cached.
+    u64 generation() const { return m_generation.load(AK::MemoryOrder::memory_order_acquire); }
+    void add(Inode& parent, StringView name, RefPtr<Inode> child, u64 generation);
+
+    void invalidate(Inode& parent, StringView name);
+    void purge(FileSystemID);
+
+private:
+    struct Entry {
+        NonnullRefPtr<Inode> parent;
+        NonnullOwnPtr<KString> name;
+        RefPtr<Inode> child;
+        unsigned hash { 0 };
+        IntrusiveListNode<Entry> lru_list_node;
+    };
+
+    struct EntryTraits : public DefaultTraits<Entry*> {
+        static unsigned hash(Entry const* entry) { return entry->hash; }
+        static bool equals(Entry const* a, Entry const* b) { return a->parent.ptr() == b->parent.ptr() && a->name->view() == b->name->view(); }
+    };
+
+    using EntryList = IntrusiveList<&Entry::lru_list_node>;
+
+    struct Entries {
+        HashTable<Entry*, EntryTraits> table;
+        // NOTE: The most recently used entry is at the front.
+        EntryList lru_list;
+    };
+
+    static unsigned hash_for(Inode const& parent, StringView name);
+    static void remove_entry(Entries&, Entry&, EntryList& removed_entries);
+    static void delete_entries(EntryList&);
+
+    SpinlockProtected<Entries, LockRank::None> m_entries {};
+    Atomic<u64> m_generation { 0 };
+};
+
+}
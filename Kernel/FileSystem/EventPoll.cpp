@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/Debug.h>
+#include <Kernel/FileSystem/EventPoll.h>
+#include <Kernel/FileSystem/OpenFileDescription.h>
+#include <Kernel/Library/KString.h>
+#include <Kernel/Locking/Spinlock.h>
+
+namespace Kernel {
+
+using BlockFlags = Thread::FileBlocker::BlockFlags;
+
+// NOTE: This protects the links between entries and their descriptions, so neither side can go away
+//       while the other one is unlinking an entry. It's always taken before a FileBlockerSet lock,
+//       and that one before the lock of an EventPoll.
+static Spinlock<LockRank::None> s_entry_links_lock {};
+
+u32 EventPollEntry::ready_events() const
+{
+    // poll() reports errors and hang-ups even if nobody asked for them, and so do we.
+    auto block_flags = BlockFlags::WriteError | BlockFlags::WriteHangUp;
+    if (m_events & EPOLLIN)
+        block_flags |= BlockFlags::Read;
+    if (m_events & EPOLLOUT)
+        block_flags |= BlockFlags::Write;
+    if (m_events & EPOLLPRI)
+        block_flags |= BlockFlags::ReadPriority;
+    if (m_events & EPOLLWRBAND)
+        block_flags |= BlockFlags::WritePriority;
+    if (m_events & EPOLLRDHUP)
+        block_flags |= BlockFlags::ReadHangUp;
+
+    auto unblocked_flags = m_description.should_unblock(block_flags);
+    u32 events = 0;
+    if (has_flag(unblocked_flags, BlockFlags::Read))
+        events |= EPOLLIN;
+    if (has_flag(unblocked_flags, BlockFlags::Write))
+        events |= EPOLLOUT;
+    if (has_flag(unblocked_flags, BlockFlags::ReadPriority))
+        events |= EPOLLPRI;
+    if (has_flag(unblocked_flags, BlockFlags::WritePriority))
+        events |= EPOLLWRBAND;
+    if (has_flag(unblocked_flags, BlockFlags::ReadHangUp))
+        events |= EPOLLRDHUP;
+    if (has_flag(unblocked_flags, BlockFlags::WriteError))
+        events |= EPOLLERR;
+    if (has_flag(unblocked_flags, BlockFlags::WriteHangUp))
+        events |= EPOLLHUP;
+    return events;
+}
+
+void EventPollEntry::file_state_changed()
+{
+    m_event_poll.entry_state_changed(*this);
+}
+
+ErrorOr<NonnullRefPtr<EventPoll>> EventPoll::try_create()
+{
+    return adopt_nonnull_ref_or_enomem(new (nothrow) EventPoll);
+}
+
+EventPoll::~EventPoll()
+{
+    SpinlockLocker links_locker(s_entry_links_lock);
+    while (true) {
+        auto* entry = m_state.with([](auto& state) -> EventPollEntry* {
+            if (state.entries.is_empty())
+                return nullptr;
+            return state.entries.begin()->value.ptr();
+        });
+        if (!entry)
+            break;
+        detach_entry(*entry);
+    }
+}
+
+bool EventPoll::can_read(OpenFileDescription const&, u64) const
+{
+    return m_state.with([](auto& state) { return !state.ready_list.is_empty(); });
+}
+
+ErrorOr<NonnullOwnPtr<KString>> EventPoll::pseudo_path(OpenFileDescription const&) const
+{
+    return m_state.with([](auto& state) -> ErrorOr<NonnullOwnPtr<KString>> {
+        return KString::formatted("EventPoll:({})", state.entries.size());
+    });
+}
+
+void EventPoll::entry_state_changed(EventPollEntry& entry)
+{
+    bool became_ready = m_state.with([&](auto& state) {
+        if (entry.m_is_ready || entry.m_is_disabled)
+            return false;
+        if (entry.ready_events() == 0)
+            return false;
+        entry.m_is_ready = true;
+        state.ready_list.append(entry);
+        return true;
+    });
+    if (became_ready)
+        evaluate_block_conditions();
+}
+
+ErrorOr<void> EventPoll::add(int fd, OpenFileDescription& description, epoll_event const& event)
+{
+    // FIXME: Allow watching other EventPolls. This needs loop detection, and entry_state_changed()
+    //        would have to stop taking the lock of one EventPoll while holding that of another.
+    if (description.is_event_poll())
+        return EINVAL;
+
+    auto new_entry = TRY(adopt_nonnull_own_or_enomem(new (nothrow) EventPollEntry(*this, description, fd, event)));
+    auto& entry = *new_entry;
+
+    SpinlockLocker links_locker(s_entry_links_lock);
+    TRY(m_state.with([&](auto& state) -> ErrorOr<void> {
+        if (state.entries.contains(fd))
+            return EEXIST;
+        TRY(state.entries.try_set(fd, move(new_entry)));
+        return {};
+    }));
+    description.event_poll_entries({}).append(entry);
+    description.blocker_set().add_observer(entry);
+    dbgln_if(EPOLL_DEBUG, "EventPoll {}: Added fd {} with events {:#x}", this, fd, event.events);
+
+    // The description might already be ready, in which case there won't be a state change to tell us.
+    entry_state_changed(entry);
+    return {};
+}
+
+ErrorOr<void> EventPoll::modify(int fd, epoll_event const& event)
+{
+    SpinlockLocker links_locker(s_entry_links_lock);
+    auto* entry = TRY(m_state.with([&](auto& state) -> ErrorOr<EventPollEntry*> {
+        auto it = state.entries.find(fd);
+        if (it == state.entries.end())
+            return ENOENT;
+        auto& entry = *it->value;
+        entry.m_events = event.events;
+        entry.m_data = event.data.u64;
+        entry.m_is_disabled = false;
+        return &entry;
+    }));
+    dbgln_if(EPOLL_DEBUG, "EventPoll {}: Modified fd {} to events {:#x}", this, fd, event.events);
+    entry_state_changed(*entry);
+    return {};
+}
+
+void EventPoll::detach_entry(EventPollEntry& entry)
+{
+    VERIFY(s_entry_links_lock.is_locked());
+    entry.m_description.blocker_set().remove_observer(entry);
+    entry.m_description_list_node.remove();
+    m_state.with([&](auto& state) {
+        if (entry.m_is_ready)
+            state.ready_list.remove(entry);
+        // NOTE: This deletes the entry.
+        state.entries.remove(entry.m_fd);
+    });
+}
+
+ErrorOr<void> EventPoll::remove(int fd)
+{
+    SpinlockLocker links_locker(s_entry_links_lock);
+    auto* entry = m_state.with([&](auto& state) -> EventPollEntry* {
+        auto it = state.entries.find(fd);
+        if (it == state.entries.end())
+            return nullptr;
+        return it->value.ptr();
+    });
+    if (!entry)
+        return ENOENT;
+    detach_entry(*entry);
+    dbgln_if(EPOLL_DEBUG, "EventPoll {}: Removed fd {}", this, fd);
+    return {};
+}
+
+void EventPoll::description_will_be_destroyed(Badge<OpenFileDescription>, OpenFileDescription&, EventPollEntry::DescriptionList& entries)
+{
+    SpinlockLocker links_locker(s_entry_links_lock);
+    while (auto* entry = entries.first())
+        entry->m_event_poll.detach_entry(*entry);
+}
+
+size_t EventPoll::collect_ready_events(Span<epoll_event> events)
+{
+    return m_state.with([&](auto& state) {
+        size_t count = 0;
+        EventPollEntry::ReadyList still_ready_list;
+        while (count < events.size()) {
+            auto* entry = state.ready_list.take_first();
+            if (!entry)
+                break;
+            entry->m_is_ready = false;
+
+            // NOTE: Entries are only put on the ready list when their file's state changes,
+            //       so it might not actually be ready (anymore).
+            auto ready_events = entry->ready_events();
+            if (ready_events == 0)
+                continue;
+
+            auto& event = events[count++];
+            event.events = ready_events;
+            event.data.u64 = entry->m_data;
+
+            if (entry->m_events & EPOLLONESHOT) {
+                entry->m_is_disabled = true;
+            } else if (!(entry->m_events & EPOLLET)) {
+                // A level-triggered entry stays ready until its file isn't ready anymore, which the next wait will find out.
+                entry->m_is_ready = true;
+                still_ready_list.append(*entry);
+            }
+        }
+
+        // NOTE: Put entries that are still ready at the back, so a busy descriptor can't starve the others.
+        while (auto* entry = still_ready_list.take_first())
+            state.ready_list.append(*entry);
+        return count;
+    });
+}
+
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Badge.h>
+#include <AK/HashMap.h>
+#include <AK/IntrusiveList.h>
+#include <AK/NonnullOwnPtr.h>
+#include <Kernel/API/POSIX/sys/epoll.h>
+#include <Kernel/FileSystem/File.h>
+#include <Kernel/Forward.h>
+#include <Kernel/Locking/SpinlockProtected.h>
+
+namespace Kernel {
+
+class EventPoll;
+
+// One file descriptor in the interest set of an EventPoll.
+// NOTE: An entry doesn't keep its description alive, closing the last file descriptor that refers to it
+//       removes the entry from every EventPoll instead.
+class EventPollEntry final : public FileBlockerSet::Observer {
+public:
+    virtual void file_state_changed() override;
+
+private:
+    friend class EventPoll;
+
+    EventPollEntry(EventPoll& event_poll, OpenFileDescription& description, int fd, epoll_event const& event)
+        : m_event_poll(event_poll)
+        , m_description(description)
+        , m_fd(fd)
+        , m_events(event.events)
+        , m_data(event.data.u64)
+    {
+    }
+
+    // Returns the subset of m_events that the description is ready for right now.
+    u32 ready_events() const;
+
+    EventPoll& m_event_poll;
+    OpenFileDescription& m_description;
+    int const m_fd { -1 };
+    u32 m_events { 0 };
+    u64 m_data { 0 };
+    bool m_is_ready { false };
+    // NOTE: EPOLLONESHOT entries are disabled after reporting an event, until they are modified again.
+    bool m_is_disabled { false };
+
+    IntrusiveListNode<EventPollEntry> m_ready_list_node;
+    IntrusiveListNode<EventPollEntry> m_description_list_node;
+
+public:
+    using ReadyList = IntrusiveList<&EventPollEntry::m_ready_list_node>;
+    using DescriptionList = IntrusiveList<&EventPollEntry::m_description_list_node>;
+};
+
+// An EventPoll keeps a persistent set of file descriptors that a process is interested in. Instead of
+// checking each of them on every wait like poll() does, the files tell the EventPoll when their state
+// changes (through their FileBlockerSet), and only the descriptors that might be ready are looked at.
+class EventPoll final : public File {
+public:
+    static ErrorOr<NonnullRefPtr<EventPoll>> try_create();
+    virtual ~EventPoll() override;
+
+    // An EventPoll is readable while it has events that can be collected.
+    virtual bool can_read(OpenFileDescription const&, u64) const override;
+    virtual ErrorOr<size_t> read(OpenFileDescription&, u64, UserOrKernelBuffer&, size_t) override { return EINVAL; }
+    virtual bool can_write(OpenFileDescription const&, u64) const override { return false; }
+    virtual ErrorOr<size_t> write(OpenFileDescription&, u64, UserOrKernelBuffer const&, size_t) override { return EINVAL; }
+
+    virtual ErrorOr<NonnullOwnPtr<KString>> pseudo_path(OpenFileDescription const&) const override;
+    virtual StringView class_name() const override { return "EventPoll"sv; }
+    virtual bool is_event_poll() const override { return true; }
+
+    ErrorOr<void> add(int fd, OpenFileDescription&, epoll_event const&);
+    ErrorOr<void> modify(int fd, epoll_event const&);
+    ErrorOr<void> remove(int fd);
+
+    // Fills the given span with events that are ready right now, and returns how many there are.
+    size_t collect_ready_events(Span<epoll_event>);
+
+    static void description_will_be_destroyed(Badge<OpenFileDescription>, OpenFileDescription&, EventPollEntry::DescriptionList&);
+
+private:
+    friend class EventPollEntry;
+
+    EventPoll() = default;
+
+    void entry_state_changed(EventPollEntry&);
+    void detach_entry(EventPollEntry&);
+
+    struct State {
+        HashMap<int, NonnullOwnPtr<EventPollEntry>> entries;
+        EventPollEntry::ReadyList ready_list;
+    };
+    mutable SpinlockProtected<State, LockRank::None> m_state {};
+};
+
+}
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Error.h>
+#include <AK/Span.h>
+#include <AK/Vector.h>
+#include <Kernel/FileSystem/BlockBasedFileSystem.h>
+
+namespace Kernel {
+
+// Maps the logical blocks of an Ext2FSInode to the blocks that store them on disk.
+// Runs of physically contiguous blocks (and runs of holes) are kept as a single extent,
+// so a large file that was written sequentially only needs a handful of entries.
+class Ext2FSBlockMap {
+public:
+    using BlockIndex = BlockBasedFileSystem::BlockIndex;
+
+    struct Extent {
+        size_t first_logical_block { 0 };
+        // NOTE: A first_block of 0 means that this extent is a hole.
+        BlockIndex first_block { 0 };
+        size_t block_count { 0 };
+
+        bool is_hole() const { return first_block == 0; }
+
+        BlockIndex block_at(size_t logical_block) const
+        {
+            if (is_hole())
+                return 0;
+            return first_block.value() + (logical_block - first_logical_block);
+        }
+
+        bool can_be_extended_with(BlockIndex block) const
+        {
+            if (is_hole())
+                return block == 0;
+            return block.value() == first_block.value() + block_count;
+        }
+    };
+
+    class Slice {
+    public:
+        Slice(Ext2FSBlockMap const& map, size_t start, size_t size)
+            : m_map(&map)
+            , m_start(start)
+            , m_size(size)
+        {
+            VERIFY(start + size <= map.size());
+        }
+
+        size_t size() const { return m_size; }
+        Slice slice(size_t start, size_t size) const
+        {
+            VERIFY(start + size <= m_size);
+            return { *m_map, m_start + start, size };
+        }
+        void copy_to(Span<u32> out) const { m_map->copy_to(m_start, out.trim(m_size)); }
+
+    private:
+        Ext2FSBlockMap const* m_map { nullptr };
+        size_t m_start { 0 };
+        size_t m_size { 0 };
+    };
+
+    bool is_empty() const { return m_block_count == 0; }
+    size_t size() const { return m_block_count; }
+    Span<Extent const> extents() const { return m_extents.span(); }
+
+    Slice slice(size_t start, size_t size) const { return { *this, start, size }; }
+
+    BlockIndex operator[](size_t logical_block) const
+    {
+        VERIFY(logical_block < m_block_count);
+        return extent_containing(logical_block).block_at(logical_block);
+    }
+
+    BlockIndex last() const
+    {
+        VERIFY(!is_empty());
+        auto const& extent = m_extents.last();
+        return extent.block_at(extent.first_logical_block + extent.block_count - 1);
+    }
+
+    // Returns the last block that is actually allocated on disk, or 0 if there's none.
+    BlockIndex last_allocated_block() const
+    {
+        for (size_t i = m_extents.size(); i > 0; --i) {
+            auto const& extent = m_extents[i - 1];
+            if (!extent.is_hole())
+                return extent.block_at(extent.first_logical_block + extent.block_count - 1);
+        }
+        return 0;
+    }
+
+    ErrorOr<void> try_append(BlockIndex block)
+    {
+        if (!m_extents.is_empty() && m_extents.last().can_be_extended_with(block))
+            ++m_extents.last().block_count;
+        else
+            TRY(m_extents.try_append({ m_block_count, block, 1 }));
+        ++m_block_count;
+        return {};
+    }
+
+    ErrorOr<void> try_extend(Span<BlockIndex const> blocks)
+    {
+        for (auto block : blocks)
+            TRY(try_append(block));
+        return {};
+    }
+
+    BlockIndex take_last()
+    {
+        auto block = last();
+        if (--m_extents.last().block_count == 0)
+            m_extents.take_last();
+        --m_block_count;
+        return block;
+    }
+
+    void remove_trailing_holes()
+    {
+        while (!m_extents.is_empty() && m_extents.last().is_hole())
+            m_block_count -= m_extents.take_last().block_count;
+    }
+
+    void clear()
+    {
+        m_extents.clear();
+        m_block_count = 0;
+    }
+
+    // Writes the on-disk indices of the blocks starting at first_logical_block into out.
+    void copy_to(size_t first_logical_block, Span<u32> out) const
+    {
+        VERIFY(first_logical_block + out.size() <= m_block_count);
+        if (out.is_empty())
+            return;
+        size_t extent_index = index_of_extent_containing(first_logical_block);
+        size_t logical_block = first_logical_block;
+        for (auto& entry : out) {
+            auto const* extent = &m_extents[extent_index];
+            if (logical_block >= extent->first_logical_block + extent->block_count)
+                extent = &m_extents[++extent_index];
+            entry = extent->block_at(logical_block).value();
+            ++logical_block;
+        }
+    }
+
+private:
+    size_t index_of_extent_containing(size_t logical_block) const
+    {
+        size_t low = 0;
+        size_t high = m_extents.size();
+        while (high - low > 1) {
+            auto middle = low + (high - low) / 2;
+            if (m_extents[middle].first_logical_block <= logical_block)
+                low = middle;
+            else
+                high = middle;
+        }
+        return low;
+    }
+
+    Extent const& extent_containing(size_t logical_block) const
+    {
+        return m_extents[index_of_extent_containing(logical_block)];
+    }
+
+    Vector<Extent> m_extents;
+    size_t m_block_count { 0 };
+};
+
+}
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/FileSystem/Ext2FS/Definitions.h>
+#include <Kernel/FileSystem/Ext2FS/DirectoryHash.h>
+
+namespace Kernel {
+
+// NOTE: These are the hash functions of the ext2/3/4 directory index as documented in the
+//       ext4 disk layout, they have to match bit for bit what other implementations compute.
+
+static constexpr u32 htree_eof_hash = 0x7fffffff;
+
+template<typename CharType>
+static u32 legacy_hash(StringView name)
+{
+    u32 hash0 = 0x12a3fe2d;
+    u32 hash1 = 0x37abe8f9;
+    for (auto ch : name) {
+        u32 hash = hash1 + (hash0 ^ (static_cast<u32>(static_cast<int>(static_cast<CharType>(ch))) * 7152373));
+        if (hash & 0x80000000)
+            hash -= 0x7fffffff;
+        hash1 = hash0;
+        hash0 = hash;
+    }
+    return hash0 << 1;
+}
+
+template<typename CharType>
+static void string_to_hash_buffer(StringView name, u32* buffer, int count)
+{
+    u32 length = name.length();
+    u32 pad = length | (length << 8);
+    pad |= pad << 16;
+
+    u32 value = pad;
+    size_t bytes_to_use = min(name.length(), static_cast<size_t>(count) * 4);
+    for (size_t i = 0; i < bytes_to_use; ++i) {
+        value = static_cast<u32>(static_cast<int>(static_cast<CharType>(name[i]))) + (value << 8);
+        if ((i % 4) == 3) {
+            *buffer++ = value;
+            value = pad;
+            --count;
+        }
+    }
+    if (--count >= 0)
+        *buffer++ = value;
+    while (--count >= 0)
+        *buffer++ = pad;
+}
+
+static u32 rotate_left(u32 value, unsigned shift)
+{
+    return (value << shift) | (value >> (32 - shift));
+}
+
+static void half_md4_transform(u32 (&buffer)[4], u32 const (&input)[8])
+{
+    auto f = [](u32 x, u32 y, u32 z) { return z ^ (x & (y ^ z)); };
+    auto g = [](u32 x, u32 y, u32 z) { return (x & y) + ((x ^ y) & z); };
+    auto h = [](u32 x, u32 y, u32 z) { return x ^ y ^ z; };
+
+    constexpr u32 k1 = 0;
+    constexpr u32 k2 = 013240474631;
+    constexpr u32 k3 = 015666365641;
+
+    u32 a = buffer[0];
+    u32 b = buffer[1];
+    u32 c = buffer[2];
+    u32 d = buffer[3];
+
+#define ROUND(function, a, b, c, d, x, s) (a += function(b, c, d) + (x), a = rotate_left(a, s))
+    ROUND(f, a, b, c, d, input[0] + k1, 3);
+    ROUND(f, d, a, b, c, input[1] + k1, 7);
+    ROUND(f, c, d, a, b, input[2] + k1, 11);
+    ROUND(f, b, c, d, a, input[3] + k1, 19);
+    ROUND(f, a, b, c, d, input[4] + k1, 3);
+    ROUND(f, d, a, b, c, input[5] + k1, 7);
+    ROUND(f, c, d, a, b, input[6] + k1, 11);
+    ROUND(f, b, c, d, a, input[7] + k1, 19);
+
+    ROUND(g, a, b, c, d, input[1] + k2, 3);
+    ROUND(g, d, a, b, c, input[3] + k2, 5);
+    ROUND(g, c, d, a, b, input[5] + k2, 9);
+    ROUND(g, b, c, d, a, input[7] + k2, 13);
+    ROUND(g, a, b, c, d, input[0] + k2, 3);
+    ROUND(g, d, a, b, c, input[2] + k2, 5);
+    ROUND(g, c, d, a, b, input[4] + k2, 9);
+    ROUND(g, b, c, d, a, input[6] + k2, 13);
+
+    ROUND(h, a, b, c, d, input[3] + k3, 3);
+    ROUND(h, d, a, b, c, input[7] + k3, 9);
+    ROUND(h, c, d, a, b, input[2] + k3, 11);
+    ROUND(h, b, c, d, a, input[6] + k3, 15);
+    ROUND(h, a, b, c, d, input[1] + k3, 3);
+    ROUND(h, d, a, b, c, input[5] + k3, 9);
+    ROUND(h, c, d, a, b, input[0] + k3, 11);
+    ROUND(h, b, c, d, a, input[4] + k3, 15);
+#undef ROUND
+
+    buffer[0] += a;
+    buffer[1] += b;
+    buffer[2] += c;
+    buffer[3] += d;
+}
+
+static void tea_transform(u32 (&buffer)[4], u32 const (&input)[4])
+{
+    constexpr u32 delta = 0x9e3779b9;
+    u32 sum = 0;
+    u32 b0 = buffer[0];
+    u32 b1 = buffer[1];
+    u32 a = input[0];
+    u32 b = input[1];
+    u32 c = input[2];
+    u32 d = input[3];
+
+    for (int n = 0; n < 16; ++n) {
+        sum += delta;
+        b0 += ((b1 << 4) + a) ^ (b1 + sum) ^ ((b1 >> 5) + b);
+        b1 += ((b0 << 4) + c) ^ (b0 + sum) ^ ((b0 >> 5) + d);
+    }
+
+    buffer[0] += b0;
+    buffer[1] += b1;
+}
+
+template<typename CharType>
+static u32 half_md4_hash(StringView name, u32 (&buffer)[4])
+{
+    u32 input[8];
+    for (size_t offset = 0; offset < name.length(); offset += 32) {
+        string_to_hash_buffer<CharType>(name.substring_view(offset), input, 8);
+        half_md4_transform(buffer, input);
+    }
+    return buffer[1];
+}
+
+template<typename CharType>
+static u32 tea_hash(StringView name, u32 (&buffer)[4])
+{
+    u32 input[4];
+    for (size_t offset = 0; offset < name.length(); offset += 16) {
+        string_to_hash_buffer<CharType>(name.substring_view(offset), input, 4);
+        tea_transform(buffer, input);
+    }
+    return buffer[0];
+}
+
+bool is_supported_ext2_directory_hash_version(u8 hash_version)
+{
+    return hash_version <= EXT2_HASH_TEA_UNSIGNED;
+}
+
+u32 compute_ext2_directory_hash(StringView name, u8 hash_version, u32 const (&seed)[4])
+{
+    u32 buffer[4] = { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476 };
+    if (seed[0] || seed[1] || seed[2] || seed[3]) {
+        for (size_t i = 0; i < 4; ++i)
+            buffer[i] = seed[i];
+    }
+
+    u32 hash = 0;
+    switch (hash_version) {
+    case EXT2_HASH_LEGACY:
+        hash = legacy_hash<i8>(name);
+        break;
+    case EXT2_HASH_LEGACY_UNSIGNED:
+        hash = legacy_hash<u8>(name);
+        break;
+    case EXT2_HASH_HALF_MD4:
+        hash = half_md4_hash<i8>(name, buffer);
+        break;
+    case EXT2_HASH_HALF_MD4_UNSIGNED:
+        hash = half_md4_hash<u8>(name, buffer);
+        break;
+    case EXT2_HASH_TEA:
+        hash = tea_hash<i8>(name, buffer);
+        break;
+    case EXT2_HASH_TEA_UNSIGNED:
+        hash = tea_hash<u8>(name, buffer);
+        break;
+    default:
+        VERIFY_NOT_REACHED();
+    }
+
+    hash &= ~1u;
+    if (hash == (htree_eof_hash << 1))
+        hash = (htree_eof_hash - 1) << 1;
+    return hash;
+}
+
+}
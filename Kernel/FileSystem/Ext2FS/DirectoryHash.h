@@ -0,0 +1,21 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/StringView.h>
+#include <AK/Types.h>
+
+namespace Kernel {
+
+// Returns whether compute_ext2_directory_hash() knows about the given hash version (EXT2_HASH_*).
+bool is_supported_ext2_directory_hash_version(u8 hash_version);
+
+// Computes the hash that is used to sort a name into a hash-indexed ("htree") directory.
+// The lowest bit is always cleared, as the index uses it to mark hash collisions that continue in the next block.
+u32 compute_ext2_directory_hash(StringView name, u8 hash_version, u32 const (&seed)[4]);
+
+}
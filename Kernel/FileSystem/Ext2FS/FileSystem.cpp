@@ -257,9 +257,9 @@ ErrorOr<void> Ext2FS::write_ext2_inode(InodeIndex inode, ext2_inode const& e2ino
     return write_block(block_index, buffer, inode_size(), offset);
 }
 
-auto Ext2FS::allocate_blocks(GroupIndex preferred_group_index, size_t count) -> ErrorOr<Vector<BlockIndex>>
+auto Ext2FS::allocate_blocks(GroupIndex preferred_group_index, size_t count, BlockIndex goal) -> ErrorOr<Vector<BlockIndex>>
 {
-    dbgln_if(EXT2_DEBUG, "Ext2FS: allocate_blocks(preferred group: {}, count {})", preferred_group_index, count);
+    dbgln_if(EXT2_DEBUG, "Ext2FS: allocate_blocks(preferred group: {}, count {}, goal {})", preferred_group_index, count, goal);
     if (count == 0)
         return Vector<BlockIndex> {};
 
@@ -267,6 +267,31 @@ auto Ext2FS::allocate_blocks(GroupIndex preferred_group_index, size_t count) ->
     TRY(blocks.try_ensure_capacity(count));
 
     MutexLocker locker(m_lock);
+
+    // If the caller is growing a file, hand out the blocks directly following its last one for as long as they're free.
+    if (goal != 0 && goal.value() + 1 < super_block().s_blocks_count) {
+        BlockIndex next_block = goal.value() + 1;
+        auto goal_group_index = group_index_from_block_index(next_block);
+        auto const& bgd = group_descriptor(goal_group_index);
+        if (bgd.bg_free_blocks_count) {
+            auto* cached_bitmap = TRY(get_bitmap_block(bgd.bg_block_bitmap));
+            int blocks_in_group = min(blocks_per_group(), super_block().s_blocks_count);
+            auto block_bitmap = cached_bitmap->bitmap(blocks_in_group);
+            BlockIndex first_block_in_group = first_block_of_group(goal_group_index);
+            for (size_t bit_index = next_block.value() - first_block_in_group.value(); bit_index < block_bitmap.size() && blocks.size() < count; ++bit_index) {
+                BlockIndex block_index = first_block_in_group.value() + bit_index;
+                if (block_bitmap.get(bit_index) || block_index.value() >= super_block().s_blocks_count)
+                    break;
+                TRY(set_block_allocation_state(block_index, true));
+                blocks.unchecked_append(block_index);
+            }
+        }
+        dbgln_if(EXT2_DEBUG, "Ext2FS: allocated {} block(s) right after goal {}", blocks.size(), goal);
+        if (blocks.size() == count)
+            return blocks;
+        preferred_group_index = goal_group_index;
+    }
+
     auto group_index = preferred_group_index;
 
     if (!group_descriptor(preferred_group_index).bg_free_blocks_count) {
@@ -619,10 +644,12 @@ ErrorOr<void> Ext2FS::free_inode(Ext2FSInode& inode)
     // Mark all blocks used by this inode as free.
     {
         auto blocks = TRY(inode.compute_block_list_with_meta_blocks());
-        for (auto block_index : blocks) {
-            VERIFY(block_index <= super_block().s_blocks_count);
-            if (block_index.value())
-                TRY(set_block_allocation_state(block_index, false));
+        for (auto const& extent : blocks.extents()) {
+            if (extent.is_hole())
+                continue;
+            VERIFY(extent.first_block.value() + extent.block_count - 1 <= super_block().s_blocks_count);
+            for (size_t i = 0; i < extent.block_count; ++i)
+                TRY(set_block_allocation_state(extent.first_block.value() + i, false));
         }
     }
 
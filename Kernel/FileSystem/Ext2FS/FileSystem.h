@@ -26,6 +26,7 @@ public:
     enum class FeaturesOptional : u32 {
         None = 0,
         ExtendedAttributes = EXT2_FEATURE_COMPAT_EXT_ATTR,
+        DirectoryIndex = EXT2_FEATURE_COMPAT_DIR_INDEX,
     };
     AK_ENUM_BITWISE_FRIEND_OPERATORS(FeaturesOptional);
 
@@ -47,6 +48,7 @@ public:
     virtual unsigned free_inode_count() const override;
 
     virtual bool supports_watchers() const override { return true; }
+    virtual bool supports_directory_entry_cache() const override { return true; }
     virtual bool supports_backing_loop_devices() const override { return true; }
 
     virtual u8 internal_file_type_to_directory_entry_type(DirectoryEntryView const& entry) const override;
@@ -91,7 +93,7 @@ private:
     BlockIndex first_block_index() const;
     BlockIndex first_block_of_block_group_descriptors() const;
     ErrorOr<InodeIndex> allocate_inode(GroupIndex preferred_group = 0);
-    ErrorOr<Vector<BlockIndex>> allocate_blocks(GroupIndex preferred_group_index, size_t count);
+    ErrorOr<Vector<BlockIndex>> allocate_blocks(GroupIndex preferred_group_index, size_t count, BlockIndex goal = 0);
     GroupIndex group_index_from_inode(InodeIndex) const;
     GroupIndex group_index_from_block_index(BlockIndex) const;
     BlockIndex first_block_of_group(GroupIndex) const;
@@ -6,8 +6,10 @@
  */
 
 #include <AK/MemoryStream.h>
+#include <AK/QuickSort.h>
 #include <Kernel/API/POSIX/errno.h>
 #include <Kernel/Debug.h>
+#include <Kernel/FileSystem/Ext2FS/DirectoryHash.h>
 #include <Kernel/FileSystem/Ext2FS/FileSystem.h>
 #include <Kernel/FileSystem/Ext2FS/Inode.h>
 #include <Kernel/FileSystem/InodeMetadata.h>
@@ -36,23 +38,20 @@ static u8 to_ext2_file_type(mode_t mode)
     return EXT2_FT_UNKNOWN;
 }
 
-ErrorOr<void> Ext2FSInode::write_indirect_block(BlockBasedFileSystem::BlockIndex block, Span<BlockBasedFileSystem::BlockIndex> blocks_indices)
+ErrorOr<void> Ext2FSInode::write_indirect_block(BlockBasedFileSystem::BlockIndex block, Ext2FSBlockMap::Slice blocks_indices)
 {
     auto const entries_per_block = EXT2_ADDR_PER_BLOCK(&fs().super_block());
     VERIFY(blocks_indices.size() <= entries_per_block);
 
     auto block_contents = TRY(ByteBuffer::create_zeroed(fs().logical_block_size()));
-    FixedMemoryStream stream { block_contents.bytes() };
     auto buffer = UserOrKernelBuffer::for_kernel_buffer(block_contents.data());
 
-    VERIFY(blocks_indices.size() <= EXT2_ADDR_PER_BLOCK(&fs().super_block()));
-    for (unsigned i = 0; i < blocks_indices.size(); ++i)
-        MUST(stream.write_value<u32>(blocks_indices[i].value()));
+    blocks_indices.copy_to({ reinterpret_cast<u32*>(block_contents.data()), entries_per_block });
 
     return fs().write_block(block, buffer, block_contents.size());
 }
 
-ErrorOr<void> Ext2FSInode::grow_doubly_indirect_block(BlockBasedFileSystem::BlockIndex block, size_t old_blocks_length, Span<BlockBasedFileSystem::BlockIndex> blocks_indices, Vector<Ext2FS::BlockIndex>& new_meta_blocks, unsigned& meta_blocks)
+ErrorOr<void> Ext2FSInode::grow_doubly_indirect_block(BlockBasedFileSystem::BlockIndex block, size_t old_blocks_length, Ext2FSBlockMap::Slice blocks_indices, Vector<Ext2FS::BlockIndex>& new_meta_blocks, unsigned& meta_blocks)
 {
     auto const entries_per_block = EXT2_ADDR_PER_BLOCK(&fs().super_block());
     auto const entries_per_doubly_indirect_block = entries_per_block * entries_per_block;
@@ -123,7 +122,7 @@ ErrorOr<void> Ext2FSInode::shrink_doubly_indirect_block(BlockBasedFileSystem::Bl
     return {};
 }
 
-ErrorOr<void> Ext2FSInode::grow_triply_indirect_block(BlockBasedFileSystem::BlockIndex block, size_t old_blocks_length, Span<BlockBasedFileSystem::BlockIndex> blocks_indices, Vector<Ext2FS::BlockIndex>& new_meta_blocks, unsigned& meta_blocks)
+ErrorOr<void> Ext2FSInode::grow_triply_indirect_block(BlockBasedFileSystem::BlockIndex block, size_t old_blocks_length, Ext2FSBlockMap::Slice blocks_indices, Vector<Ext2FS::BlockIndex>& new_meta_blocks, unsigned& meta_blocks)
 {
     auto const entries_per_block = EXT2_ADDR_PER_BLOCK(&fs().super_block());
     auto const entries_per_doubly_indirect_block = entries_per_block * entries_per_block;
@@ -268,7 +267,7 @@ ErrorOr<void> Ext2FSInode::flush_block_list()
                 old_shape.meta_blocks++;
             }
 
-            TRY(write_indirect_block(m_raw_inode.i_block[EXT2_IND_BLOCK], m_block_list.span().slice(output_block_index, new_shape.indirect_blocks)));
+            TRY(write_indirect_block(m_raw_inode.i_block[EXT2_IND_BLOCK], m_block_list.slice(output_block_index, new_shape.indirect_blocks)));
         } else if ((new_shape.indirect_blocks == 0) && (old_shape.indirect_blocks != 0)) {
             dbgln_if(EXT2_BLOCKLIST_DEBUG, "Ext2FSInode[{}]::flush_block_list(): Freeing indirect block: {}", identifier(), m_raw_inode.i_block[EXT2_IND_BLOCK]);
             TRY(fs().set_block_allocation_state(m_raw_inode.i_block[EXT2_IND_BLOCK], false));
@@ -290,7 +289,7 @@ ErrorOr<void> Ext2FSInode::flush_block_list()
                 set_metadata_dirty(true);
                 old_shape.meta_blocks++;
             }
-            TRY(grow_doubly_indirect_block(m_raw_inode.i_block[EXT2_DIND_BLOCK], old_shape.doubly_indirect_blocks, m_block_list.span().slice(output_block_index, new_shape.doubly_indirect_blocks), new_meta_blocks, old_shape.meta_blocks));
+            TRY(grow_doubly_indirect_block(m_raw_inode.i_block[EXT2_DIND_BLOCK], old_shape.doubly_indirect_blocks, m_block_list.slice(output_block_index, new_shape.doubly_indirect_blocks), new_meta_blocks, old_shape.meta_blocks));
         } else {
             TRY(shrink_doubly_indirect_block(m_raw_inode.i_block[EXT2_DIND_BLOCK], old_shape.doubly_indirect_blocks, new_shape.doubly_indirect_blocks, old_shape.meta_blocks));
             if (new_shape.doubly_indirect_blocks == 0)
@@ -311,7 +310,7 @@ ErrorOr<void> Ext2FSInode::flush_block_list()
                 set_metadata_dirty(true);
                 old_shape.meta_blocks++;
             }
-            TRY(grow_triply_indirect_block(m_raw_inode.i_block[EXT2_TIND_BLOCK], old_shape.triply_indirect_blocks, m_block_list.span().slice(output_block_index, new_shape.triply_indirect_blocks), new_meta_blocks, old_shape.meta_blocks));
+            TRY(grow_triply_indirect_block(m_raw_inode.i_block[EXT2_TIND_BLOCK], old_shape.triply_indirect_blocks, m_block_list.slice(output_block_index, new_shape.triply_indirect_blocks), new_meta_blocks, old_shape.meta_blocks));
         } else {
             TRY(shrink_triply_indirect_block(m_raw_inode.i_block[EXT2_TIND_BLOCK], old_shape.triply_indirect_blocks, new_shape.triply_indirect_blocks, old_shape.meta_blocks));
             if (new_shape.triply_indirect_blocks == 0)
@@ -332,26 +331,25 @@ ErrorOr<void> Ext2FSInode::flush_block_list()
     VERIFY_NOT_REACHED();
 }
 
-ErrorOr<Vector<Ext2FS::BlockIndex>> Ext2FSInode::compute_block_list() const
+ErrorOr<Ext2FSBlockMap> Ext2FSInode::compute_block_list() const
 {
     return compute_block_list_impl(false);
 }
 
-ErrorOr<Vector<Ext2FS::BlockIndex>> Ext2FSInode::compute_block_list_with_meta_blocks() const
+ErrorOr<Ext2FSBlockMap> Ext2FSInode::compute_block_list_with_meta_blocks() const
 {
     return compute_block_list_impl(true);
 }
 
-ErrorOr<Vector<Ext2FS::BlockIndex>> Ext2FSInode::compute_block_list_impl(bool include_block_list_blocks) const
+ErrorOr<Ext2FSBlockMap> Ext2FSInode::compute_block_list_impl(bool include_block_list_blocks) const
 {
     // FIXME: This is really awkwardly factored.. foo_impl_internal :|
     auto block_list = TRY(compute_block_list_impl_internal(m_raw_inode, include_block_list_blocks));
-    while (!block_list.is_empty() && block_list.last() == 0)
-        block_list.take_last();
+    block_list.remove_trailing_holes();
     return block_list;
 }
 
-ErrorOr<Vector<Ext2FS::BlockIndex>> Ext2FSInode::compute_block_list_impl_internal(ext2_inode const& e2inode, bool include_block_list_blocks) const
+ErrorOr<Ext2FSBlockMap> Ext2FSInode::compute_block_list_impl_internal(ext2_inode const& e2inode, bool include_block_list_blocks) const
 {
     unsigned entries_per_block = EXT2_ADDR_PER_BLOCK(&fs().super_block());
 
@@ -374,7 +372,7 @@ ErrorOr<Vector<Ext2FS::BlockIndex>> Ext2FSInode::compute_block_list_impl_interna
         blocks_remaining += shape.meta_blocks;
     }
 
-    Vector<Ext2FS::BlockIndex> list;
+    Ext2FSBlockMap list;
 
     auto add_block = [&](auto bi) -> ErrorOr<void> {
         if (blocks_remaining) {
@@ -384,13 +382,6 @@ ErrorOr<Vector<Ext2FS::BlockIndex>> Ext2FSInode::compute_block_list_impl_interna
         return {};
     };
 
-    if (include_block_list_blocks) {
-        // This seems like an excessive over-estimate but w/e.
-        TRY(list.try_ensure_capacity(blocks_remaining * 2));
-    } else {
-        TRY(list.try_ensure_capacity(blocks_remaining));
-    }
-
     unsigned direct_count = min(block_count, (unsigned)EXT2_NDIR_BLOCKS);
     for (unsigned i = 0; i < direct_count; ++i) {
         auto block_index = e2inode.i_block[i];
@@ -592,7 +583,36 @@ ErrorOr<size_t> Ext2FSInode::read_bytes_locked(off_t offset, size_t count, UserO
     return nread;
 }
 
-ErrorOr<void> Ext2FSInode::resize(u64 new_size)
+ErrorOr<void> Ext2FSInode::readahead_locked(off_t offset, size_t count) const
+{
+    VERIFY(m_inode_lock.is_locked());
+    VERIFY(offset >= 0);
+    if (static_cast<u64>(offset) >= size())
+        return {};
+    if (is_symlink() && size() < max_inline_symlink_length)
+        return {};
+
+    TRY(const_cast<Ext2FSInode&>(*this).compute_block_list_with_exclusive_locking());
+
+    u64 const block_size = fs().logical_block_size();
+    auto end = min(static_cast<u64>(offset) + count, size());
+    auto first_block_logical_index = offset / block_size;
+    auto last_block_logical_index = min(ceil_div(end, block_size), static_cast<u64>(m_block_list.size()));
+
+    dbgln_if(EXT2_VERY_DEBUG, "Ext2FSInode[{}]::readahead(): Reading blocks {} to {}", identifier(), first_block_logical_index, last_block_logical_index);
+
+    for (auto bi = first_block_logical_index; bi < last_block_logical_index; ++bi) {
+        auto block_index = m_block_list[bi];
+        // Holes read back as zeroes, there's nothing to fetch for them.
+        if (block_index.value() == 0)
+            continue;
+        // Passing no buffer only pulls the block into the disk cache.
+        TRY(fs().read_block(block_index, nullptr, block_size));
+    }
+    return {};
+}
+
+ErrorOr<void> Ext2FSInode::resize(u64 new_size, Optional<u64> clear_end)
 {
     VERIFY(m_inode_lock.is_locked());
     auto old_size = size();
@@ -621,13 +641,14 @@ ErrorOr<void> Ext2FSInode::resize(u64 new_size)
         m_block_list = TRY(compute_block_list());
 
     if (blocks_needed_after > blocks_needed_before) {
-        auto blocks = TRY(fs().allocate_blocks(fs().group_index_from_inode(index()), blocks_needed_after - blocks_needed_before));
-        TRY(m_block_list.try_extend(move(blocks)));
+        // NOTE: Try to continue right after the current last block, so the file stays contiguous on disk.
+        auto blocks = TRY(fs().allocate_blocks(fs().group_index_from_inode(index()), blocks_needed_after - blocks_needed_before, m_block_list.last_allocated_block()));
+        TRY(m_block_list.try_extend(blocks.span()));
     } else if (blocks_needed_after < blocks_needed_before) {
         if constexpr (EXT2_VERY_DEBUG) {
-            dbgln("Ext2FSInode[{}]::resize(): Shrinking inode, old block list is {} entries:", identifier(), m_block_list.size());
-            for (auto block_index : m_block_list) {
-                dbgln("    # {}", block_index);
+            dbgln("Ext2FSInode[{}]::resize(): Shrinking inode, old block list is {} entries in {} extents:", identifier(), m_block_list.size(), m_block_list.extents().size());
+            for (auto const& extent : m_block_list.extents()) {
+                dbgln("    # {} ({} blocks)", extent.first_block, extent.block_count);
             }
         }
         while (m_block_list.size() != blocks_needed_after) {
@@ -651,8 +672,9 @@ ErrorOr<void> Ext2FSInode::resize(u64 new_size)
 
     if (new_size > old_size) {
         // If we're growing the inode, make sure we zero out all the new space.
+        // NOTE: A caller that is about to overwrite the end of the new space can tell us to stop clearing early.
         // FIXME: There are definitely more efficient ways to achieve this.
-        auto bytes_to_clear = new_size - old_size;
+        auto bytes_to_clear = min(new_size, max(clear_end.value_or(new_size), old_size)) - old_size;
         auto clear_from = old_size;
         u8 zero_buffer[PAGE_SIZE] {};
         while (bytes_to_clear) {
@@ -689,9 +711,11 @@ ErrorOr<size_t> Ext2FSInode::write_bytes_locked(off_t offset, size_t count, User
     bool allow_cache = !description || !description->is_direct();
 
     auto const block_size = fs().logical_block_size();
-    auto new_size = max(static_cast<u64>(offset) + count, size());
+    auto old_size = size();
+    auto new_size = max(static_cast<u64>(offset) + count, old_size);
 
-    TRY(resize(new_size));
+    // NOTE: Everything from `offset` onwards is about to be overwritten, so only the gap before it has to be cleared.
+    TRY(resize(new_size, offset));
 
     if (m_block_list.is_empty())
         m_block_list = TRY(compute_block_list());
@@ -719,6 +743,9 @@ ErrorOr<size_t> Ext2FSInode::write_bytes_locked(off_t offset, size_t count, User
         dbgln_if(EXT2_DEBUG, "Ext2FSInode[{}]::write_bytes_locked(): Writing block {} (offset_into_block: {})", identifier(), m_block_list[bi.value()], offset_into_block);
         if (auto result = fs().write_block(m_block_list[bi.value()], data.offset(nwritten), num_bytes_to_copy, offset_into_block, allow_cache); result.is_error()) {
             dbgln("Ext2FSInode[{}]::write_bytes_locked(): Failed to write block {} (index {})", identifier(), m_block_list[bi.value()], bi);
+            // The space we grew into was never cleared, so don't leave any of it visible.
+            if (new_size > old_size)
+                (void)resize(max(old_size, static_cast<u64>(offset)));
             return result.release_error();
         }
         remaining_count -= num_bytes_to_copy;
@@ -824,6 +851,395 @@ ErrorOr<void> Ext2FSInode::write_directory(Vector<Ext2FSDirectoryEntry>& entries
     return {};
 }
 
+// NOTE: In the root block of a hash-indexed directory, the index follows the "." and ".." entries,
+//       hidden in the unused part of the ".." record. Index nodes below the root start with an
+//       empty directory entry that spans the whole block, so implementations that don't know
+//       about the index just see an empty block.
+static constexpr size_t dx_root_info_offset = 24;
+static constexpr size_t dx_node_entries_offset = 8;
+static constexpr u8 max_hash_tree_indirect_levels = 2;
+
+Optional<Ext2FSInode::DirectoryEntryPosition> Ext2FSInode::find_entry_in_block(ReadonlyBytes block, StringView name, size_t logical_block)
+{
+    Optional<size_t> previous_offset;
+    for (size_t offset = 0; offset + 8 <= block.size();) {
+        auto const& entry = *reinterpret_cast<ext2_dir_entry_2 const*>(block.data() + offset);
+        if (entry.rec_len < 8 || offset + entry.rec_len > block.size())
+            break;
+        if (entry.inode != 0 && StringView { entry.name, entry.name_len } == name)
+            return DirectoryEntryPosition { logical_block, offset, previous_offset, entry.inode };
+        previous_offset = offset;
+        offset += entry.rec_len;
+    }
+    return {};
+}
+
+bool Ext2FSInode::try_insert_entry_into_block(Bytes block, StringView name, InodeIndex inode_index, u8 file_type)
+{
+    size_t const needed_length = EXT2_DIR_REC_LEN(name.length());
+    for (size_t offset = 0; offset + 8 <= block.size();) {
+        auto& entry = *reinterpret_cast<ext2_dir_entry_2*>(block.data() + offset);
+        if (entry.rec_len < 8 || offset + entry.rec_len > block.size())
+            return false;
+        size_t const used_length = entry.inode != 0 ? EXT2_DIR_REC_LEN(entry.name_len) : 0;
+        if (entry.rec_len >= used_length + needed_length) {
+            auto* new_entry = &entry;
+            u16 record_length = entry.rec_len;
+            if (used_length != 0) {
+                entry.rec_len = used_length;
+                new_entry = reinterpret_cast<ext2_dir_entry_2*>(block.data() + offset + used_length);
+                record_length -= used_length;
+            }
+            new_entry->inode = inode_index.value();
+            new_entry->rec_len = record_length;
+            new_entry->name_len = name.length();
+            new_entry->file_type = file_type;
+            memcpy(new_entry->name, name.characters_without_null_termination(), name.length());
+            return true;
+        }
+        offset += entry.rec_len;
+    }
+    return false;
+}
+
+void Ext2FSInode::remove_entry_from_block(Bytes block, DirectoryEntryPosition const& position)
+{
+    auto& entry = *reinterpret_cast<ext2_dir_entry_2*>(block.data() + position.offset);
+    if (position.previous_offset.has_value()) {
+        auto& previous_entry = *reinterpret_cast<ext2_dir_entry_2*>(block.data() + *position.previous_offset);
+        previous_entry.rec_len += entry.rec_len;
+    } else {
+        entry.inode = 0;
+    }
+}
+
+ErrorOr<void> Ext2FSInode::read_directory_block(size_t logical_block, Bytes data) const
+{
+    auto const block_size = fs().logical_block_size();
+    VERIFY(data.size() == block_size);
+    auto buffer = UserOrKernelBuffer::for_kernel_buffer(data.data());
+    auto nread = TRY(read_bytes_locked(logical_block * block_size, block_size, buffer, nullptr));
+    if (nread != block_size)
+        return EIO;
+    return {};
+}
+
+ErrorOr<void> Ext2FSInode::write_directory_block(size_t logical_block, ReadonlyBytes data)
+{
+    auto const block_size = fs().logical_block_size();
+    VERIFY(data.size() == block_size);
+    auto buffer = UserOrKernelBuffer::for_kernel_buffer(const_cast<u8*>(data.data()));
+    auto nwritten = TRY(prepare_and_write_bytes_locked(logical_block * block_size, block_size, buffer, nullptr));
+    set_metadata_dirty(true);
+    if (nwritten != block_size)
+        return EIO;
+    return {};
+}
+
+ErrorOr<Optional<Ext2FSInode::DirectoryEntryPosition>> Ext2FSInode::find_directory_entry(StringView name) const
+{
+    VERIFY(m_inode_lock.is_locked());
+    auto const block_size = fs().logical_block_size();
+    auto block = TRY(ByteBuffer::create_uninitialized(block_size));
+
+    auto find_in_block = [&](size_t logical_block) -> ErrorOr<Optional<DirectoryEntryPosition>> {
+        TRY(read_directory_block(logical_block, block.bytes()));
+        return find_entry_in_block(block.bytes(), name, logical_block);
+    };
+
+    // NOTE: "." and ".." always live in the first block, which is not covered by the index.
+    if (is_hash_indexed() && name != "."sv && name != ".."sv) {
+        HashTreePath path;
+        if (auto hash = TRY(read_hash_tree_path(name, path)); hash.has_value()) {
+            Optional<size_t> leaf_block = path.last().child_block();
+            while (leaf_block.has_value()) {
+                if (auto position = TRY(find_in_block(*leaf_block)); position.has_value())
+                    return position;
+                leaf_block = TRY(advance_hash_tree_path(*hash, path));
+            }
+            return Optional<DirectoryEntryPosition> {};
+        }
+    }
+
+    auto const block_count = size() / block_size;
+    for (size_t logical_block = 0; logical_block < block_count; ++logical_block) {
+        if (auto position = TRY(find_in_block(logical_block)); position.has_value())
+            return position;
+    }
+    return Optional<DirectoryEntryPosition> {};
+}
+
+ErrorOr<void> Ext2FSInode::insert_directory_entry(StringView name, InodeIndex inode_index, u8 file_type)
+{
+    VERIFY(m_inode_lock.is_exclusively_locked_by_current_thread());
+    auto const block_size = fs().logical_block_size();
+
+    if (m_raw_inode.i_flags & EXT2_INDEX_FL) {
+        if (is_hash_indexed() && TRY(insert_into_hash_tree(name, inode_index, file_type)))
+            return {};
+        drop_hash_tree_index();
+    }
+
+    auto block = TRY(ByteBuffer::create_uninitialized(block_size));
+    auto block_count = size() / block_size;
+    for (size_t logical_block = 0; logical_block < block_count; ++logical_block) {
+        TRY(read_directory_block(logical_block, block.bytes()));
+        if (try_insert_entry_into_block(block.bytes(), name, inode_index, file_type))
+            return write_directory_block(logical_block, block.bytes());
+    }
+
+    // Once a directory outgrows its first block, give it a hash index like other ext2 implementations do,
+    // so that finding or adding an entry doesn't mean walking the whole directory.
+    if (block_count == 1 && has_flag(fs().get_features_optional(), Ext2FS::FeaturesOptional::DirectoryIndex)) {
+        if (TRY(convert_to_hash_tree())) {
+            if (TRY(insert_into_hash_tree(name, inode_index, file_type)))
+                return {};
+            drop_hash_tree_index();
+            block_count = size() / block_size;
+        }
+    }
+
+    // No block has room for the entry, so append a new one.
+    block.zero_fill();
+    reinterpret_cast<ext2_dir_entry_2*>(block.data())->rec_len = block_size;
+    VERIFY(try_insert_entry_into_block(block.bytes(), name, inode_index, file_type));
+    return write_directory_block(block_count, block.bytes());
+}
+
+bool Ext2FSInode::is_hash_indexed() const
+{
+    return (m_raw_inode.i_flags & EXT2_INDEX_FL) && has_flag(fs().get_features_optional(), Ext2FS::FeaturesOptional::DirectoryIndex);
+}
+
+u8 Ext2FSInode::hash_version_for(ext2_dx_root_info const& root_info) const
+{
+    // NOTE: The root only records the base algorithm, whether characters are treated as signed is a file system wide choice.
+    auto hash_version = root_info.hash_version;
+    if (hash_version <= EXT2_HASH_TEA && (fs().super_block().s_flags & EXT2_FLAGS_UNSIGNED_HASH))
+        hash_version += EXT2_HASH_LEGACY_UNSIGNED;
+    return hash_version;
+}
+
+ErrorOr<Optional<u32>> Ext2FSInode::read_hash_tree_path(StringView name, HashTreePath& path) const
+{
+    auto const block_size = fs().logical_block_size();
+    auto const block_count = size() / block_size;
+
+    auto root_block = TRY(ByteBuffer::create_uninitialized(block_size));
+    TRY(read_directory_block(0, root_block.bytes()));
+    auto const& root_info = *reinterpret_cast<ext2_dx_root_info const*>(root_block.data() + dx_root_info_offset);
+    auto hash_version = hash_version_for(root_info);
+    if (root_info.reserved_zero != 0 || root_info.info_length != sizeof(ext2_dx_root_info) || root_info.indirect_levels > max_hash_tree_indirect_levels || !is_supported_ext2_directory_hash_version(hash_version)) {
+        dbgln_if(EXT2_DEBUG, "Ext2FSInode[{}]::read_hash_tree_path(): Directory index is not usable", identifier());
+        return Optional<u32> {};
+    }
+    auto const indirect_levels = root_info.indirect_levels;
+    auto const hash = compute_ext2_directory_hash(name, hash_version, fs().super_block().s_hash_seed);
+
+    path.clear();
+    TRY(path.try_append({ 0, move(root_block), dx_root_info_offset + sizeof(ext2_dx_root_info), 0 }));
+    while (true) {
+        auto& frame = path.last();
+        auto const& count_limit = frame.count_limit();
+        auto const max_entries = (block_size - frame.entries_offset) / sizeof(ext2_dx_entry);
+        if (count_limit.count == 0 || count_limit.count > count_limit.limit || count_limit.limit > max_entries) {
+            dbgln_if(EXT2_DEBUG, "Ext2FSInode[{}]::read_hash_tree_path(): Bad index node in block {}", identifier(), frame.logical_block);
+            return Optional<u32> {};
+        }
+
+        // Find the last entry with a hash that's not above ours. The first entry has no hash, it covers everything below the second one.
+        size_t low = 1;
+        size_t high = count_limit.count;
+        while (low < high) {
+            auto middle = low + (high - low) / 2;
+            if (frame.entry(middle).hash > hash)
+                high = middle;
+            else
+                low = middle + 1;
+        }
+        frame.position = low - 1;
+
+        auto child_block = frame.child_block();
+        if (child_block == 0 || child_block >= block_count)
+            return Optional<u32> {};
+        if (path.size() > indirect_levels)
+            break;
+
+        auto node_block = TRY(ByteBuffer::create_uninitialized(block_size));
+        TRY(read_directory_block(child_block, node_block.bytes()));
+        TRY(path.try_append({ child_block, move(node_block), dx_node_entries_offset, 0 }));
+    }
+    return hash;
+}
+
+ErrorOr<Optional<size_t>> Ext2FSInode::advance_hash_tree_path(u32 hash, HashTreePath& path) const
+{
+    // Entries with the same hash can spill over into the next leaf, which is marked by setting the lowest bit of its hash.
+    size_t level = path.size() - 1;
+    while (path[level].position + 1 >= path[level].count_limit().count) {
+        if (level == 0)
+            return Optional<size_t> {};
+        --level;
+    }
+    auto& frame = path[level];
+    ++frame.position;
+    if ((frame.entry(frame.position).hash & ~1u) != hash)
+        return Optional<size_t> {};
+
+    auto const block_count = size() / fs().logical_block_size();
+    for (size_t i = level + 1; i < path.size(); ++i) {
+        auto child_block = path[i - 1].child_block();
+        if (child_block == 0 || child_block >= block_count)
+            return Optional<size_t> {};
+        TRY(read_directory_block(child_block, path[i].block.bytes()));
+        path[i].logical_block = child_block;
+        path[i].position = 0;
+    }
+    return path.last().child_block();
+}
+
+ErrorOr<bool> Ext2FSInode::insert_into_hash_tree(StringView name, InodeIndex inode_index, u8 file_type)
+{
+    auto const block_size = fs().logical_block_size();
+
+    HashTreePath path;
+    auto hash = TRY(read_hash_tree_path(name, path));
+    if (!hash.has_value())
+        return false;
+
+    auto& node = path.last();
+    auto const leaf_block_index = node.child_block();
+    auto old_leaf_block = TRY(ByteBuffer::create_uninitialized(block_size));
+    TRY(read_directory_block(leaf_block_index, old_leaf_block.bytes()));
+    if (try_insert_entry_into_block(old_leaf_block.bytes(), name, inode_index, file_type)) {
+        TRY(write_directory_block(leaf_block_index, old_leaf_block.bytes()));
+        return true;
+    }
+
+    // The leaf is full, so split it in two, ordered by hash, and point the index node at the new half.
+    auto& count_limit = node.count_limit();
+    if (count_limit.count >= count_limit.limit) {
+        // FIXME: Split the index node (or add another level of them) instead of giving up on the index.
+        dbgln_if(EXT2_DEBUG, "Ext2FSInode[{}]::insert_into_hash_tree(): Index node in block {} is full", identifier(), node.logical_block);
+        return false;
+    }
+
+    struct LeafEntry {
+        StringView name;
+        InodeIndex inode_index;
+        u8 file_type { 0 };
+        u32 hash { 0 };
+    };
+    Vector<LeafEntry> entries;
+    auto const hash_version = hash_version_for(*reinterpret_cast<ext2_dx_root_info const*>(path.first().block.data() + dx_root_info_offset));
+    size_t total_length = 0;
+    for (size_t offset = 0; offset + 8 <= block_size;) {
+        auto const& entry = *reinterpret_cast<ext2_dir_entry_2 const*>(old_leaf_block.data() + offset);
+        if (entry.rec_len < 8 || offset + entry.rec_len > block_size)
+            return false;
+        if (entry.inode != 0) {
+            StringView entry_name { entry.name, entry.name_len };
+            TRY(entries.try_append({ entry_name, entry.inode, entry.file_type, compute_ext2_directory_hash(entry_name, hash_version, fs().super_block().s_hash_seed) }));
+            total_length += EXT2_DIR_REC_LEN(entry.name_len);
+        }
+        offset += entry.rec_len;
+    }
+    TRY(entries.try_append({ name, inode_index, file_type, *hash }));
+    total_length += EXT2_DIR_REC_LEN(name.length());
+    quick_sort(entries, [](auto& a, auto& b) { return a.hash < b.hash; });
+
+    size_t split = entries.size();
+    size_t moved_length = 0;
+    while (split > 1 && moved_length < total_length / 2)
+        moved_length += EXT2_DIR_REC_LEN(entries[--split].name.length());
+    auto const split_hash = entries[split].hash;
+    bool const continued = entries[split - 1].hash == split_hash;
+
+    auto lower_leaf_block = TRY(ByteBuffer::create_zeroed(block_size));
+    auto upper_leaf_block = TRY(ByteBuffer::create_zeroed(block_size));
+    reinterpret_cast<ext2_dir_entry_2*>(lower_leaf_block.data())->rec_len = block_size;
+    reinterpret_cast<ext2_dir_entry_2*>(upper_leaf_block.data())->rec_len = block_size;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        auto& leaf_block = i < split ? lower_leaf_block : upper_leaf_block;
+        if (!try_insert_entry_into_block(leaf_block.bytes(), entries[i].name, entries[i].inode_index, entries[i].file_type))
+            return false;
+    }
+
+    auto const new_leaf_block_index = size() / block_size;
+    dbgln_if(EXT2_DEBUG, "Ext2FSInode[{}]::insert_into_hash_tree(): Splitting leaf {} at hash {:#x} into new leaf {}", identifier(), leaf_block_index, split_hash, new_leaf_block_index);
+    TRY(write_directory_block(new_leaf_block_index, upper_leaf_block.bytes()));
+    TRY(write_directory_block(leaf_block_index, lower_leaf_block.bytes()));
+
+    auto const insert_position = node.position + 1;
+    for (size_t i = count_limit.count; i > insert_position; --i)
+        node.entry(i) = node.entry(i - 1);
+    node.entry(insert_position) = { split_hash | (continued ? 1u : 0u), static_cast<u32>(new_leaf_block_index) };
+    ++count_limit.count;
+    TRY(write_directory_block(node.logical_block, node.block.bytes()));
+    return true;
+}
+
+ErrorOr<bool> Ext2FSInode::convert_to_hash_tree()
+{
+    auto const block_size = fs().logical_block_size();
+    VERIFY(size() == block_size);
+
+    auto root_block = TRY(ByteBuffer::create_uninitialized(block_size));
+    TRY(read_directory_block(0, root_block.bytes()));
+
+    auto& dot = *reinterpret_cast<ext2_dir_entry_2*>(root_block.data());
+    if (dot.inode == 0 || dot.name_len != 1 || dot.name[0] != '.' || dot.rec_len != EXT2_DIR_REC_LEN(1))
+        return false;
+    auto& dot_dot = *reinterpret_cast<ext2_dir_entry_2*>(root_block.data() + dot.rec_len);
+    if (dot_dot.inode == 0 || dot_dot.name_len != 2 || dot_dot.name[0] != '.' || dot_dot.name[1] != '.' || dot_dot.rec_len < EXT2_DIR_REC_LEN(2) || dot.rec_len + dot_dot.rec_len > block_size)
+        return false;
+
+    // Move everything except "." and ".." into the first leaf.
+    auto leaf_block = TRY(ByteBuffer::create_zeroed(block_size));
+    reinterpret_cast<ext2_dir_entry_2*>(leaf_block.data())->rec_len = block_size;
+    for (size_t offset = dot.rec_len + dot_dot.rec_len; offset + 8 <= block_size;) {
+        auto const& entry = *reinterpret_cast<ext2_dir_entry_2 const*>(root_block.data() + offset);
+        if (entry.rec_len < 8 || offset + entry.rec_len > block_size)
+            return false;
+        if (entry.inode != 0 && !try_insert_entry_into_block(leaf_block.bytes(), { entry.name, entry.name_len }, entry.inode, entry.file_type))
+            return false;
+        offset += entry.rec_len;
+    }
+
+    auto hash_version = fs().super_block().s_def_hash_version;
+    if (hash_version > EXT2_HASH_TEA)
+        hash_version = EXT2_HASH_HALF_MD4;
+
+    dot_dot.rec_len = block_size - dot.rec_len;
+    auto const entries_offset = dx_root_info_offset + sizeof(ext2_dx_root_info);
+    memset(root_block.data() + dx_root_info_offset, 0, block_size - dx_root_info_offset);
+    auto& root_info = *reinterpret_cast<ext2_dx_root_info*>(root_block.data() + dx_root_info_offset);
+    root_info.hash_version = hash_version;
+    root_info.info_length = sizeof(ext2_dx_root_info);
+    auto& count_limit = *reinterpret_cast<ext2_dx_countlimit*>(root_block.data() + entries_offset);
+    count_limit.limit = (block_size - entries_offset) / sizeof(ext2_dx_entry);
+    count_limit.count = 1;
+    reinterpret_cast<ext2_dx_entry*>(root_block.data() + entries_offset)[0].block = 1;
+
+    dbgln_if(EXT2_DEBUG, "Ext2FSInode[{}]::convert_to_hash_tree(): Creating directory index with hash version {}", identifier(), hash_version);
+    TRY(write_directory_block(1, leaf_block.bytes()));
+    TRY(write_directory_block(0, root_block.bytes()));
+    m_raw_inode.i_flags |= EXT2_INDEX_FL;
+    set_metadata_dirty(true);
+
+    // NOTE: Lookups go through the index from now on, so there's no need to keep every name in memory.
+    m_lookup_cache.clear();
+    return true;
+}
+
+void Ext2FSInode::drop_hash_tree_index()
+{
+    // NOTE: Without the flag, the index blocks just read as empty parts of a linear directory.
+    dbgln_if(EXT2_DEBUG, "Ext2FSInode[{}]::drop_hash_tree_index(): Turning into a linear directory", identifier());
+    m_raw_inode.i_flags &= ~EXT2_INDEX_FL;
+    set_metadata_dirty(true);
+}
+
 ErrorOr<NonnullRefPtr<Inode>> Ext2FSInode::create_child(StringView name, mode_t mode, dev_t dev, UserID uid, GroupID gid)
 {
     if (Kernel::is_directory(mode))
@@ -842,25 +1258,24 @@ ErrorOr<void> Ext2FSInode::add_child(Inode& child, StringView name, mode_t mode)
     dbgln_if(EXT2_DEBUG, "Ext2FSInode[{}]::add_child(): Adding inode {} with name '{}' and mode {:o} to directory {}", identifier(), child.index(), name, mode, index());
     bool has_file_type_attribute = has_flag(fs().get_features_optional(), Ext2FS::FeaturesOptional::ExtendedAttributes);
 
-    Vector<Ext2FSDirectoryEntry> entries;
-    TRY(traverse_as_directory([&](auto& entry) -> ErrorOr<void> {
-        if (name == entry.name)
+    if (is_hash_indexed()) {
+        if (TRY(find_directory_entry(name)).has_value())
             return EEXIST;
-        auto entry_name = TRY(KString::try_create(entry.name));
-        TRY(entries.try_append({ move(entry_name), entry.inode.index(), has_file_type_attribute ? entry.file_type : (u8)EXT2_FT_UNKNOWN }));
-        return {};
-    }));
+    } else {
+        TRY(populate_lookup_cache());
+        if (m_lookup_cache.contains(name))
+            return EEXIST;
+    }
 
     TRY(child.increment_link_count());
+    TRY(insert_directory_entry(name, child.index(), has_file_type_attribute ? to_ext2_file_type(mode) : (u8)EXT2_FT_UNKNOWN));
 
-    auto entry_name = TRY(KString::try_create(name));
-    TRY(entries.try_empend(move(entry_name), child.index(), has_file_type_attribute ? to_ext2_file_type(mode) : (u8)EXT2_FT_UNKNOWN));
-
-    TRY(write_directory(entries));
-    TRY(populate_lookup_cache());
-
-    auto cache_entry_name = TRY(KString::try_create(name));
-    TRY(m_lookup_cache.try_set(move(cache_entry_name), child.index()));
+    // NOTE: The lookup cache is only kept for linear directories, and might have been dropped when
+    //       the directory got indexed.
+    if (!m_lookup_cache.is_empty()) {
+        auto cache_entry_name = TRY(KString::try_create(name));
+        TRY(m_lookup_cache.try_set(move(cache_entry_name), child.index()));
+    }
     did_add_child(child.identifier(), name);
     return {};
 }
@@ -871,28 +1286,21 @@ ErrorOr<void> Ext2FSInode::remove_child(StringView name)
     dbgln_if(EXT2_DEBUG, "Ext2FSInode[{}]::remove_child(): Removing '{}'", identifier(), name);
     VERIFY(is_directory());
 
-    TRY(populate_lookup_cache());
-
-    auto it = m_lookup_cache.find(name);
-    if (it == m_lookup_cache.end())
+    if (!m_lookup_cache.is_empty() && !m_lookup_cache.contains(name))
         return ENOENT;
-    auto child_inode_index = (*it).value;
 
-    InodeIdentifier child_id { fsid(), child_inode_index };
-    bool has_file_type_attribute = has_flag(fs().get_features_optional(), Ext2FS::FeaturesOptional::ExtendedAttributes);
+    auto position = TRY(find_directory_entry(name));
+    if (!position.has_value())
+        return ENOENT;
 
-    Vector<Ext2FSDirectoryEntry> entries;
-    TRY(traverse_as_directory([&](auto& entry) -> ErrorOr<void> {
-        if (name != entry.name) {
-            auto entry_name = TRY(KString::try_create(entry.name));
-            TRY(entries.try_append({ move(entry_name), entry.inode.index(), has_file_type_attribute ? entry.file_type : (u8)EXT2_FT_UNKNOWN }));
-        }
-        return {};
-    }));
+    InodeIdentifier child_id { fsid(), position->inode_index };
 
-    TRY(write_directory(entries));
+    auto block = TRY(ByteBuffer::create_uninitialized(fs().logical_block_size()));
+    TRY(read_directory_block(position->logical_block, block.bytes()));
+    remove_entry_from_block(block.bytes(), *position);
+    TRY(write_directory_block(position->logical_block, block.bytes()));
 
-    m_lookup_cache.remove(it);
+    m_lookup_cache.remove(name);
 
     auto child_inode = TRY(fs().get_inode(child_id));
     TRY(child_inode->decrement_link_count());
@@ -907,52 +1315,43 @@ ErrorOr<void> Ext2FSInode::replace_child(StringView name, Inode& child)
     dbgln_if(EXT2_DEBUG, "Ext2FSInode[{}]::replace_child(): Replacing '{}' with inode {}", identifier(), name, child.index());
     VERIFY(is_directory());
 
-    TRY(populate_lookup_cache());
-
     if (name.length() > EXT2_NAME_LEN)
         return ENAMETOOLONG;
 
-    Vector<Ext2FSDirectoryEntry> entries;
     bool has_file_type_attribute = has_flag(fs().get_features_optional(), Ext2FS::FeaturesOptional::ExtendedAttributes);
 
-    Optional<InodeIndex> old_child_index;
-    TRY(traverse_as_directory([&](auto& entry) -> ErrorOr<void> {
-        auto is_replacing_this_inode = name == entry.name;
-        auto inode_index = is_replacing_this_inode ? child.index() : entry.inode.index();
-
-        auto entry_name = TRY(KString::try_create(entry.name));
-        TRY(entries.try_empend(move(entry_name), inode_index, has_file_type_attribute ? to_ext2_file_type(child.mode()) : (u8)EXT2_FT_UNKNOWN));
-        if (is_replacing_this_inode)
-            old_child_index = entry.inode.index();
-
-        return {};
-    }));
-
-    if (!old_child_index.has_value())
+    auto position = TRY(find_directory_entry(name));
+    if (!position.has_value())
         return ENOENT;
+    auto old_child_index = position->inode_index;
 
-    auto old_child = TRY(fs().get_inode({ fsid(), *old_child_index }));
+    auto old_child = TRY(fs().get_inode({ fsid(), old_child_index }));
 
-    auto old_index_it = m_lookup_cache.find(name);
-    VERIFY(old_index_it != m_lookup_cache.end());
-    old_index_it->value = child.index();
+    auto block = TRY(ByteBuffer::create_uninitialized(fs().logical_block_size()));
+    TRY(read_directory_block(position->logical_block, block.bytes()));
+    auto& entry = *reinterpret_cast<ext2_dir_entry_2*>(block.data() + position->offset);
+    entry.inode = child.index().value();
+    if (has_file_type_attribute)
+        entry.file_type = to_ext2_file_type(child.mode());
 
-    // NOTE: Between this line and the write_directory line, all operations must
+    // NOTE: Between this line and the write_directory_block line, all operations must
     //       be atomic. Any changes made should be reverted.
     TRY(child.increment_link_count());
 
     auto maybe_decrement_error = old_child->decrement_link_count();
     if (maybe_decrement_error.is_error()) {
-        old_index_it->value = *old_child_index;
         MUST(child.decrement_link_count());
         return maybe_decrement_error;
     }
 
     // FIXME: The filesystem is left in an inconsistent state if this fails.
-    //        Revert the changes made above if we can't write_directory.
+    //        Revert the changes made above if we can't write the directory block.
     //        Ideally, decrement should be the last operation, but we currently
-    //        can't "un-write" a directory entry list.
-    TRY(write_directory(entries));
+    //        can't "un-write" a directory entry.
+    TRY(write_directory_block(position->logical_block, block.bytes()));
+
+    if (auto it = m_lookup_cache.find(name); it != m_lookup_cache.end())
+        it->value = child.index();
 
     // TODO: Emit a did_replace_child event.
 
@@ -985,13 +1384,23 @@ ErrorOr<NonnullRefPtr<Inode>> Ext2FSInode::lookup(StringView name)
     InodeIndex inode_index;
     {
         MutexLocker locker(m_inode_lock);
-        TRY(populate_lookup_cache());
-        auto it = m_lookup_cache.find(name);
-        if (it == m_lookup_cache.end()) {
-            dbgln_if(EXT2_DEBUG, "Ext2FSInode[{}]:lookup(): '{}' not found", identifier(), name);
-            return ENOENT;
+        if (is_hash_indexed()) {
+            // NOTE: The index gets us to the right block directly, so large directories don't need to be cached in memory.
+            auto position = TRY(find_directory_entry(name));
+            if (!position.has_value()) {
+                dbgln_if(EXT2_DEBUG, "Ext2FSInode[{}]:lookup(): '{}' not found", identifier(), name);
+                return ENOENT;
+            }
+            inode_index = position->inode_index;
+        } else {
+            TRY(populate_lookup_cache());
+            auto it = m_lookup_cache.find(name);
+            if (it == m_lookup_cache.end()) {
+                dbgln_if(EXT2_DEBUG, "Ext2FSInode[{}]:lookup(): '{}' not found", identifier(), name);
+                return ENOENT;
+            }
+            inode_index = it->value;
         }
-        inode_index = it->value;
     }
 
     return fs().get_inode({ fsid(), inode_index });
@@ -6,7 +6,9 @@
 
 #pragma once
 
+#include <AK/ByteBuffer.h>
 #include <AK/HashMap.h>
+#include <Kernel/FileSystem/Ext2FS/BlockMap.h>
 #include <Kernel/FileSystem/Ext2FS/Definitions.h>
 #include <Kernel/FileSystem/Ext2FS/DirectoryEntry.h>
 #include <Kernel/FileSystem/Ext2FS/FileSystem.h>
@@ -28,6 +30,7 @@ public:
 private:
     // ^Inode
     virtual ErrorOr<size_t> read_bytes_locked(off_t, size_t, UserOrKernelBuffer& buffer, OpenFileDescription*) const override;
+    virtual ErrorOr<void> readahead_locked(off_t, size_t) const override;
     virtual InodeMetadata metadata() const override;
     virtual ErrorOr<void> traverse_as_directory(Function<ErrorOr<void>(FileSystem::DirectoryEntryView const&)>) const override;
     virtual ErrorOr<NonnullRefPtr<Inode>> lookup(StringView name) override;
@@ -47,25 +50,62 @@ private:
 
     ErrorOr<void> write_directory(Vector<Ext2FSDirectoryEntry>&);
     ErrorOr<void> populate_lookup_cache();
-    ErrorOr<void> resize(u64);
-    ErrorOr<void> write_indirect_block(BlockBasedFileSystem::BlockIndex, Span<BlockBasedFileSystem::BlockIndex>);
-    ErrorOr<void> grow_doubly_indirect_block(BlockBasedFileSystem::BlockIndex, size_t, Span<BlockBasedFileSystem::BlockIndex>, Vector<BlockBasedFileSystem::BlockIndex>&, unsigned&);
+
+    struct DirectoryEntryPosition {
+        size_t logical_block { 0 };
+        size_t offset { 0 };
+        Optional<size_t> previous_offset;
+        InodeIndex inode_index { 0 };
+    };
+
+    // One level of an htree directory index: the root block or one of the index nodes below it.
+    struct HashTreeFrame {
+        size_t logical_block { 0 };
+        ByteBuffer block;
+        size_t entries_offset { 0 };
+        size_t position { 0 };
+
+        ext2_dx_countlimit& count_limit() { return *reinterpret_cast<ext2_dx_countlimit*>(block.data() + entries_offset); }
+        ext2_dx_entry& entry(size_t index) { return reinterpret_cast<ext2_dx_entry*>(block.data() + entries_offset)[index]; }
+        size_t child_block() { return entry(position).block & 0x0fffffff; }
+    };
+    using HashTreePath = Vector<HashTreeFrame, 3>;
+
+    static Optional<DirectoryEntryPosition> find_entry_in_block(ReadonlyBytes block, StringView name, size_t logical_block);
+    static bool try_insert_entry_into_block(Bytes block, StringView name, InodeIndex, u8 file_type);
+    static void remove_entry_from_block(Bytes block, DirectoryEntryPosition const&);
+
+    ErrorOr<void> read_directory_block(size_t logical_block, Bytes) const;
+    ErrorOr<void> write_directory_block(size_t logical_block, ReadonlyBytes);
+    ErrorOr<Optional<DirectoryEntryPosition>> find_directory_entry(StringView name) const;
+    ErrorOr<void> insert_directory_entry(StringView name, InodeIndex, u8 file_type);
+
+    bool is_hash_indexed() const;
+    u8 hash_version_for(ext2_dx_root_info const&) const;
+    ErrorOr<Optional<u32>> read_hash_tree_path(StringView name, HashTreePath&) const;
+    ErrorOr<Optional<size_t>> advance_hash_tree_path(u32 hash, HashTreePath&) const;
+    ErrorOr<bool> insert_into_hash_tree(StringView name, InodeIndex, u8 file_type);
+    ErrorOr<bool> convert_to_hash_tree();
+    void drop_hash_tree_index();
+    ErrorOr<void> resize(u64, Optional<u64> clear_end = {});
+    ErrorOr<void> write_indirect_block(BlockBasedFileSystem::BlockIndex, Ext2FSBlockMap::Slice);
+    ErrorOr<void> grow_doubly_indirect_block(BlockBasedFileSystem::BlockIndex, size_t, Ext2FSBlockMap::Slice, Vector<BlockBasedFileSystem::BlockIndex>&, unsigned&);
     ErrorOr<void> shrink_doubly_indirect_block(BlockBasedFileSystem::BlockIndex, size_t, size_t, unsigned&);
-    ErrorOr<void> grow_triply_indirect_block(BlockBasedFileSystem::BlockIndex, size_t, Span<BlockBasedFileSystem::BlockIndex>, Vector<BlockBasedFileSystem::BlockIndex>&, unsigned&);
+    ErrorOr<void> grow_triply_indirect_block(BlockBasedFileSystem::BlockIndex, size_t, Ext2FSBlockMap::Slice, Vector<BlockBasedFileSystem::BlockIndex>&, unsigned&);
     ErrorOr<void> shrink_triply_indirect_block(BlockBasedFileSystem::BlockIndex, size_t, size_t, unsigned&);
     ErrorOr<void> flush_block_list();
 
     ErrorOr<void> compute_block_list_with_exclusive_locking();
-    ErrorOr<Vector<BlockBasedFileSystem::BlockIndex>> compute_block_list() const;
-    ErrorOr<Vector<BlockBasedFileSystem::BlockIndex>> compute_block_list_with_meta_blocks() const;
-    ErrorOr<Vector<BlockBasedFileSystem::BlockIndex>> compute_block_list_impl(bool include_block_list_blocks) const;
-    ErrorOr<Vector<BlockBasedFileSystem::BlockIndex>> compute_block_list_impl_internal(ext2_inode const&, bool include_block_list_blocks) const;
+    ErrorOr<Ext2FSBlockMap> compute_block_list() const;
+    ErrorOr<Ext2FSBlockMap> compute_block_list_with_meta_blocks() const;
+    ErrorOr<Ext2FSBlockMap> compute_block_list_impl(bool include_block_list_blocks) const;
+    ErrorOr<Ext2FSBlockMap> compute_block_list_impl_internal(ext2_inode const&, bool include_block_list_blocks) const;
 
     Ext2FS& fs();
     Ext2FS const& fs() const;
     Ext2FSInode(Ext2FS&, InodeIndex);
 
-    Vector<BlockBasedFileSystem::BlockIndex> m_block_list;
+    Ext2FSBlockMap m_block_list;
     HashMap<NonnullOwnPtr<KString>, InodeIndex> m_lookup_cache;
     ext2_inode m_raw_inode {};
 
@@ -16,6 +16,9 @@ namespace Kernel {
 
 class FUSEConnection : public RefCounted<FUSEConnection> {
 public:
+    // Size of the request and response buffers FUSEDevice keeps for each pending request.
+    static constexpr size_t max_request_size = 0x21000;
+
     static ErrorOr<NonnullRefPtr<FUSEConnection>> try_create(NonnullRefPtr<OpenFileDescription> description)
     {
         if (!description->is_device())
@@ -73,6 +76,10 @@ public:
         return response;
     }
 
+    // NOTE: This is only meaningful once the connection has been initialized, i.e. after the first request has been sent.
+    size_t max_write() const { return m_max_write; }
+    size_t max_read() const { return max_request_size - sizeof(fuse_out_header); }
+
     ~FUSEConnection()
     {
         auto* device = bit_cast<FUSEDevice*>(m_description->device());
@@ -124,11 +131,19 @@ private:
         if (validate_response(*response, 0).is_error())
             return Error::from_errno(EIO);
 
+        if (response->size() < sizeof(fuse_out_header) + offsetof(fuse_init_out, time_gran))
+            return Error::from_errno(EIO);
+
         fuse_init_out* init = bit_cast<fuse_init_out*>(response->data() + sizeof(fuse_out_header));
 
         m_major = init->major;
         m_minor = init->minor;
 
+        // The daemon tells us the largest write it is prepared to accept, but we can't go beyond what
+        // fits into a single request buffer of the device.
+        if (init->max_write != 0)
+            m_max_write = min<size_t>(init->max_write, max_request_size - sizeof(fuse_in_header) - sizeof(fuse_write_in));
+
         m_initialized = true;
 
         return {};
@@ -140,6 +155,9 @@ private:
 
     u32 m_major { 0 };
     u32 m_minor { 0 };
+
+    // FUSE requires daemons to accept writes of at least 4 KiB.
+    size_t m_max_write { 4 * KiB };
 };
 
 }
@@ -7,9 +7,13 @@
 #include <Kernel/FileSystem/FUSE/Definitions.h>
 #include <Kernel/FileSystem/FUSE/Inode.h>
 #include <Kernel/FileSystem/RAMBackedFileType.h>
+#include <Kernel/Time/TimeManagement.h>
 
 namespace Kernel {
 
+// Don't trust the daemon with cache timeouts so long that they would effectively never expire.
+static constexpr u64 max_attribute_cache_duration_in_seconds = 60 * 60;
+
 FUSEInode::FUSEInode(FUSE& fs, InodeIndex index)
     : Inode(fs, index)
 {
@@ -27,14 +31,14 @@ ErrorOr<size_t> FUSEInode::read_bytes_locked(off_t offset, size_t size, UserOrKe
     VERIFY(m_inode_lock.is_locked());
     VERIFY(!is_directory());
 
-    constexpr size_t max_read_size = 0x21000 - sizeof(fuse_in_header) - sizeof(fuse_read_in);
     u64 id = TRY(try_open(false, O_RDONLY));
     u32 nodeid = identifier().index().value();
+    size_t max_read_size = fs().m_connection->max_read();
 
     size_t nread = 0;
     size_t target_size = size;
     while (target_size) {
-        size_t chunk_size = min(size, max_read_size);
+        size_t chunk_size = min(target_size, max_read_size);
         fuse_read_in payload {};
         payload.fh = id;
         payload.offset = offset + nread;
@@ -68,9 +72,11 @@ ErrorOr<size_t> FUSEInode::write_bytes_locked(off_t offset, size_t size, UserOrK
     VERIFY(!is_directory());
     VERIFY(offset >= 0);
 
-    constexpr size_t max_write_size = 0x21000 - sizeof(fuse_in_header) - sizeof(fuse_write_in);
     u64 id = TRY(try_open(false, O_WRONLY));
     u32 nodeid = identifier().index().value();
+    size_t max_write_size = fs().m_connection->max_write();
+
+    invalidate_cached_metadata();
 
     size_t nwritten = 0;
     while (size) {
@@ -91,6 +97,8 @@ ErrorOr<size_t> FUSEInode::write_bytes_locked(off_t offset, size_t size, UserOrK
             return Error::from_errno(-header->error);
 
         fuse_write_out* write_response = bit_cast<fuse_write_out*>(response->data() + sizeof(fuse_out_header));
+        if (write_response->size == 0 || write_response->size > chunk_size)
+            return Error::from_errno(EIO);
 
         nwritten += write_response->size;
         size -= write_response->size;
@@ -104,6 +112,12 @@ ErrorOr<size_t> FUSEInode::write_bytes_locked(off_t offset, size_t size, UserOrK
 
 InodeMetadata FUSEInode::metadata() const
 {
+    MutexLocker locker(m_inode_lock);
+
+    auto now = TimeManagement::the().monotonic_time();
+    if (m_cached_metadata_valid_until.has_value() && now < m_cached_metadata_valid_until.value())
+        return m_cached_metadata;
+
     InodeMetadata metadata;
     metadata.inode = identifier();
     u32 id = identifier().index().value();
@@ -121,24 +135,38 @@ InodeMetadata FUSEInode::metadata() const
         return {};
 
     fuse_attr_out* getattr_response = bit_cast<fuse_attr_out*>(response->data() + sizeof(fuse_out_header));
-
-    metadata.mode = getattr_response->attr.mode;
-    metadata.size = getattr_response->attr.size;
-    metadata.block_size = getattr_response->attr.blksize;
-    metadata.block_count = getattr_response->attr.blocks;
-
-    metadata.uid = getattr_response->attr.uid;
-    metadata.gid = getattr_response->attr.gid;
-    metadata.link_count = getattr_response->attr.nlink;
-    metadata.atime = UnixDateTime::from_seconds_since_epoch(getattr_response->attr.atime);
-    metadata.ctime = UnixDateTime::from_seconds_since_epoch(getattr_response->attr.ctime);
-    metadata.mtime = UnixDateTime::from_seconds_since_epoch(getattr_response->attr.mtime);
-    metadata.major_device = major_from_encoded_device(getattr_response->attr.rdev);
-    metadata.minor_device = minor_from_encoded_device(getattr_response->attr.rdev);
+    auto const& attr = getattr_response->attr;
+
+    metadata.mode = attr.mode;
+    metadata.size = attr.size;
+    metadata.block_size = attr.blksize;
+    metadata.block_count = attr.blocks;
+
+    metadata.uid = attr.uid;
+    metadata.gid = attr.gid;
+    metadata.link_count = attr.nlink;
+    metadata.atime = UnixDateTime::from_seconds_since_epoch(attr.atime);
+    metadata.ctime = UnixDateTime::from_seconds_since_epoch(attr.ctime);
+    metadata.mtime = UnixDateTime::from_seconds_since_epoch(attr.mtime);
+    metadata.major_device = major_from_encoded_device(attr.rdev);
+    metadata.minor_device = minor_from_encoded_device(attr.rdev);
+
+    // The daemon tells us for how long these attributes stay valid, so we don't have to ask again on every stat().
+    auto valid_for = Duration::from_seconds(static_cast<i64>(min(getattr_response->attr_valid, max_attribute_cache_duration_in_seconds))) + Duration::from_nanoseconds(getattr_response->attr_valid_nsec);
+    if (valid_for > Duration::zero()) {
+        m_cached_metadata = metadata;
+        m_cached_metadata_valid_until = now + valid_for;
+    }
 
     return metadata;
 }
 
+void FUSEInode::invalidate_cached_metadata() const
+{
+    MutexLocker locker(m_inode_lock);
+    m_cached_metadata_valid_until.clear();
+}
+
 ErrorOr<u64> FUSEInode::try_open(bool directory, u32 flags) const
 {
     u32 id = identifier().index().value();
@@ -291,6 +319,8 @@ ErrorOr<void> FUSEInode::truncate_locked(u64 new_size)
     setattr.valid = FATTR_SIZE;
     setattr.size = new_size;
 
+    invalidate_cached_metadata();
+
     auto response = TRY(fs().m_connection->send_request_and_wait_for_a_reply(FUSEOpcode::FUSE_SETATTR, identifier().index().value(), { &setattr, sizeof(setattr) }));
 
     fuse_out_header* header = bit_cast<fuse_out_header*>(response->data());
@@ -321,6 +351,8 @@ ErrorOr<void> FUSEInode::update_timestamps(Optional<UnixDateTime> atime, Optiona
         setattr.mtime = mtime.value().to_timespec().tv_sec;
     }
 
+    invalidate_cached_metadata();
+
     auto response = TRY(fs().m_connection->send_request_and_wait_for_a_reply(FUSEOpcode::FUSE_SETATTR, identifier().index().value(), { &setattr, sizeof(setattr) }));
 
     fuse_out_header* header = bit_cast<fuse_out_header*>(response->data());
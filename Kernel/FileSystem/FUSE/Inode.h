@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <AK/Optional.h>
+#include <AK/Time.h>
 #include <AK/Types.h>
 #include <Kernel/FileSystem/FUSE/FileSystem.h>
 #include <Kernel/FileSystem/Inode.h>
@@ -45,7 +47,13 @@ private:
     ErrorOr<void> try_flush(u64 id) const;
     ErrorOr<void> try_release(u64 id, bool directory) const;
 
+    void invalidate_cached_metadata() const;
+
     InodeMetadata m_metadata;
+
+    // Attributes as last returned by FUSE_GETATTR, valid until the timeout the daemon gave us.
+    mutable InodeMetadata m_cached_metadata;
+    mutable Optional<MonotonicTime> m_cached_metadata_valid_until;
 };
 
 }
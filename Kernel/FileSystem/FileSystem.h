@@ -34,6 +34,11 @@ public:
     virtual Inode& root_inode() = 0;
     virtual bool supports_watchers() const { return false; }
 
+    // NOTE: File systems that return true here must report every change to their directories
+    // through Inode::did_add_child() and Inode::did_remove_child(), so the VFS can invalidate
+    // the cached results of Inode::lookup().
+    virtual bool supports_directory_entry_cache() const { return false; }
+
     // FIXME: We should aim to provide more concise mechanism to ensure
     // that backing Inodes from the FileSystem are kept intact so we can
     // attach them to a loop device.
@@ -58,10 +63,15 @@ public:
 
     virtual ErrorOr<void> flush_writes() { return {}; }
 
+    // Called by the SyncTask after a file system asked for it through SyncTask::request_writeback().
+    // Unlike flush_writes(), this only has to write back enough dirty data to get below the file system's own threshold.
+    virtual void write_back_in_background() { }
+
     u64 logical_block_size() const { return m_logical_block_size; }
     size_t fragment_size() const { return m_fragment_size; }
 
     virtual bool is_file_backed() const { return false; }
+    virtual bool is_block_based() const { return false; }
 
     // Converts file types that are used internally by the filesystem to DT_* types
     virtual u8 internal_file_type_to_directory_entry_type(DirectoryEntryView const& entry) const { return entry.file_type; }
@@ -0,0 +1,390 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/IntegralMath.h>
+#include <Kernel/API/POSIX/sys/socket.h>
+#include <Kernel/Debug.h>
+#include <Kernel/FileSystem/IORing.h>
+#include <Kernel/FileSystem/OpenFileDescription.h>
+#include <Kernel/Library/KString.h>
+#include <Kernel/Memory/MemoryManager.h>
+#include <Kernel/Net/Socket.h>
+#include <Kernel/Tasks/Process.h>
+
+namespace Kernel {
+
+using BlockFlags = Thread::FileBlocker::BlockFlags;
+
+static BlockFlags block_flags_for_opcode(u8 opcode)
+{
+    switch (opcode) {
+    case IO_RING_OP_READ:
+    case IO_RING_OP_RECV:
+        return BlockFlags::Read;
+    case IO_RING_OP_ACCEPT:
+        return BlockFlags::Accept;
+    case IO_RING_OP_WRITE:
+    case IO_RING_OP_SEND:
+        return BlockFlags::Write;
+    default:
+        return BlockFlags::None;
+    }
+}
+
+bool IORingRequest::might_be_ready() const
+{
+    auto block_flags = block_flags_for_opcode(m_sqe.opcode) | BlockFlags::WriteError | BlockFlags::WriteHangUp;
+    return m_description->should_unblock(block_flags) != BlockFlags::None;
+}
+
+void IORingRequest::file_state_changed()
+{
+    if (might_be_ready())
+        m_ring.request_might_be_ready(*this);
+}
+
+ErrorOr<NonnullRefPtr<IORing>> IORing::try_create(Process& process, io_ring_params& params)
+{
+    if (params.flags != 0)
+        return EINVAL;
+    if (params.sq_entries == 0 || params.sq_entries > IO_RING_MAX_ENTRIES)
+        return EINVAL;
+
+    u32 sq_entries = 1u << ceil_log2(params.sq_entries);
+    // NOTE: Requests complete out of order, so leave some room for completions that haven't been consumed yet.
+    u32 cq_entries = sq_entries * 2;
+
+    u32 sq_offset = sizeof(io_ring_header);
+    u32 cq_offset = sq_offset + sq_entries * sizeof(io_ring_sqe);
+    auto ring_size = TRY(Memory::page_round_up(cq_offset + cq_entries * sizeof(io_ring_cqe)));
+
+    auto vmobject = TRY(Memory::AnonymousVMObject::try_create_with_size(ring_size, AllocationStrategy::AllocateNow));
+    auto kernel_region = TRY(MM.allocate_kernel_region_with_vmobject(*vmobject, ring_size, "IORing"sv, Memory::Region::Access::ReadWrite));
+
+    params.sq_entries = sq_entries;
+    params.cq_entries = cq_entries;
+    params.ring_size = ring_size;
+    params.sq_offset = sq_offset;
+    params.cq_offset = cq_offset;
+
+    return adopt_nonnull_ref_or_enomem(new (nothrow) IORing(process.pid(), move(vmobject), move(kernel_region), sq_entries, cq_entries));
+}
+
+IORing::IORing(ProcessID owner, NonnullLockRefPtr<Memory::AnonymousVMObject> vmobject, NonnullOwnPtr<Memory::Region> kernel_region, u32 sq_entries, u32 cq_entries)
+    : m_owner(owner)
+    , m_vmobject(move(vmobject))
+    , m_kernel_region(move(kernel_region))
+    , m_sq_entries(sq_entries)
+    , m_cq_entries(cq_entries)
+{
+    auto* base = m_kernel_region->vaddr().as_ptr();
+    // NOTE: The pages were allocated right away, and are therefore zeroed.
+    m_header = reinterpret_cast<io_ring_header*>(base);
+    m_header->sq_entries = sq_entries;
+    m_header->cq_entries = cq_entries;
+    m_sqes = reinterpret_cast<io_ring_sqe*>(base + sizeof(io_ring_header));
+    m_cqes = reinterpret_cast<io_ring_cqe*>(base + sizeof(io_ring_header) + sq_entries * sizeof(io_ring_sqe));
+}
+
+IORing::~IORing()
+{
+    // NOTE: Once the requests stop observing their files, nothing can put them back on the ready list,
+    //       and they have to be off it before the pending list drops the last reference to them.
+    for (auto& request : m_pending_requests)
+        request.m_description->blocker_set().remove_observer(request);
+    m_ready_requests.with([](auto& list) { list.clear(); });
+    m_pending_requests.clear();
+}
+
+bool IORing::can_read(OpenFileDescription const&, u64) const
+{
+    return m_ready_requests.with([](auto& list) { return !list.is_empty(); });
+}
+
+ErrorOr<NonnullLockRefPtr<Memory::VMObject>> IORing::vmobject_for_mmap(Process&, Memory::VirtualRange const&, u64& offset, bool shared)
+{
+    // A private mapping would stop seeing the kernel's updates as soon as it's written to.
+    if (!shared)
+        return EINVAL;
+    if (offset != 0)
+        return EINVAL;
+    return m_vmobject;
+}
+
+ErrorOr<NonnullOwnPtr<KString>> IORing::pseudo_path(OpenFileDescription const&) const
+{
+    return KString::formatted("IORing:({})", m_sq_entries);
+}
+
+u32 IORing::completion_queue_size() const
+{
+    u32 cq_head = AK::atomic_load(&m_header->cq_head, AK::MemoryOrder::memory_order_acquire);
+    // NOTE: The process could have written anything there, but it can't make us overrun the queue.
+    return min(m_cq_tail - cq_head, m_cq_entries);
+}
+
+void IORing::post_completion(u64 user_data, ErrorOr<FlatPtr> result)
+{
+    auto& cqe = m_cqes[m_cq_tail & (m_cq_entries - 1)];
+    cqe.user_data = user_data;
+    cqe.result = result.is_error() ? -static_cast<i32>(result.error().code()) : static_cast<i32>(result.value());
+    cqe.flags = 0;
+    ++m_cq_tail;
+    AK::atomic_store(&m_header->cq_tail, m_cq_tail, AK::MemoryOrder::memory_order_release);
+}
+
+void IORing::request_might_be_ready(IORingRequest& request)
+{
+    bool became_ready = m_ready_requests.with([&](auto& list) {
+        if (request.m_is_ready)
+            return false;
+        request.m_is_ready = true;
+        list.append(request);
+        return true;
+    });
+    if (became_ready)
+        evaluate_block_conditions();
+}
+
+ErrorOr<NonnullRefPtr<IORingRequest>> IORing::create_request(Process& process, io_ring_sqe const& sqe)
+{
+    auto description = TRY(process.open_file_description(sqe.fd));
+    // NOTE: A request watching another IO ring could hold the last reference to it, and no good can come of that.
+    if (description->is_io_ring())
+        return EINVAL;
+
+    switch (sqe.opcode) {
+    case IO_RING_OP_READ:
+        if (!description->is_readable())
+            return EBADF;
+        if (description->is_directory())
+            return EISDIR;
+        if (sqe.offset != IO_RING_CURRENT_OFFSET && !description->file().is_seekable())
+            return EINVAL;
+        break;
+    case IO_RING_OP_WRITE:
+        if (!description->is_writable())
+            return EBADF;
+        if (sqe.offset != IO_RING_CURRENT_OFFSET && !description->file().is_seekable())
+            return EINVAL;
+        break;
+    case IO_RING_OP_ACCEPT:
+        TRY(process.require_promise(Pledge::accept));
+        if (!description->is_socket())
+            return ENOTSOCK;
+        if (sqe.op_flags & ~(SOCK_NONBLOCK | SOCK_CLOEXEC))
+            return EINVAL;
+        break;
+    case IO_RING_OP_SEND:
+    case IO_RING_OP_RECV:
+        if (!description->is_socket())
+            return ENOTSOCK;
+        break;
+    default:
+        return EINVAL;
+    }
+
+    return adopt_nonnull_ref_or_enomem(new (nothrow) IORingRequest(*this, move(description), sqe));
+}
+
+ErrorOr<FlatPtr> IORing::execute(Process& process, IORingRequest& request)
+{
+    auto const& sqe = request.m_sqe;
+    auto& description = *request.m_description;
+
+    switch (sqe.opcode) {
+    case IO_RING_OP_READ: {
+        if (sqe.length == 0)
+            return 0;
+        if (!description.can_read())
+            return EAGAIN;
+        auto buffer = TRY(UserOrKernelBuffer::for_user_buffer(reinterpret_cast<u8*>(sqe.address), sqe.length));
+        if (sqe.offset == IO_RING_CURRENT_OFFSET)
+            return TRY(description.read(buffer, sqe.length));
+        return TRY(description.read(buffer, sqe.offset, sqe.length));
+    }
+    case IO_RING_OP_WRITE: {
+        if (sqe.length == 0)
+            return 0;
+        if (!description.can_write())
+            return EAGAIN;
+        auto buffer = TRY(UserOrKernelBuffer::for_user_buffer(reinterpret_cast<u8*>(sqe.address), sqe.length));
+        auto nwritten_or_error = sqe.offset == IO_RING_CURRENT_OFFSET
+            ? description.write(buffer, sqe.length)
+            : description.write(sqe.offset, buffer, sqe.length);
+        if (nwritten_or_error.is_error() && nwritten_or_error.error().code() == EPIPE)
+            Thread::current()->send_signal(SIGPIPE, &process);
+        return TRY(nwritten_or_error);
+    }
+    case IO_RING_OP_ACCEPT: {
+        auto& socket = *description.socket();
+        auto accepted_socket = socket.accept();
+        if (!accepted_socket)
+            return EAGAIN;
+
+        auto accepted_socket_description = TRY(OpenFileDescription::try_create(*accepted_socket));
+        accepted_socket_description->set_readable(true);
+        accepted_socket_description->set_writable(true);
+        if (sqe.op_flags & SOCK_NONBLOCK)
+            accepted_socket_description->set_blocking(false);
+        int fd_flags = (sqe.op_flags & SOCK_CLOEXEC) ? FD_CLOEXEC : 0;
+
+        auto fd = TRY(process.fds().with_exclusive([&](auto& fds) -> ErrorOr<int> {
+            auto fd_allocation = TRY(fds.allocate());
+            fds[fd_allocation.fd].set(move(accepted_socket_description), fd_flags);
+            return fd_allocation.fd;
+        }));
+
+        // NOTE: Moving this state to Completed is what causes connect() to unblock on the client side.
+        accepted_socket->set_setup_state(Socket::SetupState::Completed);
+        return fd;
+    }
+    case IO_RING_OP_SEND: {
+        auto& socket = *description.socket();
+        if (socket.is_shut_down_for_writing()) {
+            if (!(sqe.op_flags & MSG_NOSIGNAL))
+                Thread::current()->send_signal(SIGPIPE, &process);
+            return EPIPE;
+        }
+        if (!description.can_write())
+            return EAGAIN;
+        auto buffer = TRY(UserOrKernelBuffer::for_user_buffer(reinterpret_cast<u8*>(sqe.address), sqe.length));
+        auto nsent_or_error = socket.sendto(description, buffer, sqe.length, sqe.op_flags, {}, 0);
+        if (nsent_or_error.is_error() && nsent_or_error.error().code() == EPIPE && !(sqe.op_flags & MSG_NOSIGNAL))
+            Thread::current()->send_signal(SIGPIPE, &process);
+        auto nsent = TRY(nsent_or_error);
+        if (nsent == 0 && sqe.length != 0)
+            return EAGAIN;
+        return nsent;
+    }
+    case IO_RING_OP_RECV: {
+        auto& socket = *description.socket();
+        if (socket.is_shut_down_for_reading())
+            return 0;
+        auto buffer = TRY(UserOrKernelBuffer::for_user_buffer(reinterpret_cast<u8*>(sqe.address), sqe.length));
+        UnixDateTime timestamp {};
+        return TRY(socket.recvfrom(description, buffer, sqe.length, sqe.op_flags, {}, {}, timestamp, false));
+    }
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
+
+void IORing::start_request(Process& process, io_ring_sqe const& sqe)
+{
+    if (sqe.opcode == IO_RING_OP_NOP) {
+        post_completion(sqe.user_data, 0);
+        return;
+    }
+
+    auto request_or_error = create_request(process, sqe);
+    if (request_or_error.is_error()) {
+        post_completion(sqe.user_data, request_or_error.release_error());
+        return;
+    }
+    auto request = request_or_error.release_value();
+
+    auto result = execute(process, *request);
+    if (!result.is_error() || result.error().code() != EAGAIN) {
+        post_completion(sqe.user_data, move(result));
+        return;
+    }
+
+    dbgln_if(IO_RING_DEBUG, "IORing: Request {:#x} (opcode {}) on fd {} is waiting for its file", sqe.user_data, sqe.opcode, sqe.fd);
+    m_pending_requests.append(*request);
+    ++m_pending_request_count;
+    request->m_description->blocker_set().add_observer(*request);
+    // The file might have become ready before we started watching it, in which case there won't be a state change to tell us.
+    request->file_state_changed();
+}
+
+u32 IORing::submit(Process& process, u32 to_submit)
+{
+    VERIFY(m_lock.is_locked());
+
+    u32 sq_tail = AK::atomic_load(&m_header->sq_tail, AK::MemoryOrder::memory_order_acquire);
+    u32 count = min(min(to_submit, sq_tail - m_sq_head), m_sq_entries);
+
+    u32 submitted = 0;
+    while (submitted < count) {
+        // NOTE: Every request in flight needs a place for its completion, so we don't have to drop any.
+        if (m_pending_request_count + completion_queue_size() >= m_cq_entries)
+            break;
+
+        // Copy the entry, as the process could change it while we're looking at it.
+        io_ring_sqe sqe;
+        __builtin_memcpy(&sqe, &m_sqes[m_sq_head & (m_sq_entries - 1)], sizeof(sqe));
+        ++m_sq_head;
+        ++submitted;
+        start_request(process, sqe);
+    }
+
+    AK::atomic_store(&m_header->sq_head, m_sq_head, AK::MemoryOrder::memory_order_release);
+    return submitted;
+}
+
+void IORing::retry_ready_requests(Process& process)
+{
+    VERIFY(m_lock.is_locked());
+
+    // NOTE: Every request is retried at most once, so a file that keeps changing its state without
+    //       actually becoming ready can't keep us here forever.
+    for (size_t retries = m_pending_request_count; retries > 0; --retries) {
+        auto* request = m_ready_requests.with([](auto& list) {
+            auto* request = list.take_first();
+            if (request)
+                request->m_is_ready = false;
+            return request;
+        });
+        if (!request)
+            break;
+
+        // NOTE: If the file changes its state while we're retrying, the request goes back on m_ready_requests.
+        auto result = execute(process, *request);
+        if (result.is_error() && result.error().code() == EAGAIN)
+            continue;
+
+        request->m_description->blocker_set().remove_observer(*request);
+        m_ready_requests.with([&](auto& list) {
+            if (request->m_is_ready)
+                list.remove(*request);
+        });
+        post_completion(request->m_sqe.user_data, move(result));
+        --m_pending_request_count;
+        // NOTE: This might delete the request.
+        m_pending_requests.remove(*request);
+    }
+}
+
+ErrorOr<FlatPtr> IORing::enter(Process& process, OpenFileDescription& description, u32 to_submit, u32 min_complete)
+{
+    // Buffers and file descriptors in the submission queue refer to the process that set up the ring.
+    if (process.pid() != m_owner)
+        return EPERM;
+
+    MutexLocker locker(m_lock);
+    auto submitted = submit(process, to_submit);
+    min_complete = min(min_complete, m_cq_entries);
+
+    while (true) {
+        retry_ready_requests(process);
+        if (completion_queue_size() >= min_complete)
+            break;
+        // Nothing we could wait for would give us more completions.
+        if (m_pending_request_count == 0)
+            break;
+
+        auto unblock_flags = BlockFlags::None;
+        if (Thread::current()->block<Thread::ReadBlocker>({}, description, unblock_flags).was_interrupted()) {
+            if (submitted == 0)
+                return EINTR;
+            break;
+        }
+    }
+    return submitted;
+}
+
+}
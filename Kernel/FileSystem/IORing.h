@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/IntrusiveList.h>
+#include <AK/RefCounted.h>
+#include <Kernel/API/IORing.h>
+#include <Kernel/FileSystem/File.h>
+#include <Kernel/Forward.h>
+#include <Kernel/Locking/Mutex.h>
+#include <Kernel/Locking/SpinlockProtected.h>
+#include <Kernel/Memory/AnonymousVMObject.h>
+
+namespace Kernel {
+
+class IORing;
+
+// A submitted request that couldn't be completed right away, because its file wasn't ready.
+// It watches the file until it might be, and is then retried by the next io_ring_enter().
+class IORingRequest final
+    : public RefCounted<IORingRequest>
+    , public FileBlockerSet::Observer {
+public:
+    virtual void file_state_changed() override;
+
+private:
+    friend class IORing;
+
+    IORingRequest(IORing& ring, NonnullRefPtr<OpenFileDescription> description, io_ring_sqe const& sqe)
+        : m_ring(ring)
+        , m_description(move(description))
+        , m_sqe(sqe)
+    {
+    }
+
+    bool might_be_ready() const;
+
+    IORing& m_ring;
+    NonnullRefPtr<OpenFileDescription> m_description;
+    io_ring_sqe const m_sqe;
+    bool m_is_ready { false };
+
+    IntrusiveListNode<IORingRequest, NonnullRefPtr<IORingRequest>> m_pending_list_node;
+    IntrusiveListNode<IORingRequest> m_ready_list_node;
+
+public:
+    using PendingList = IntrusiveList<&IORingRequest::m_pending_list_node>;
+    using ReadyList = IntrusiveList<&IORingRequest::m_ready_list_node>;
+};
+
+// The kernel side of an IO ring, see Kernel/API/IORing.h for how it's used.
+// NOTE: Requests run in the context of the process that created the ring, as their buffers and
+//       file descriptors belong to it. Requests that can't complete right away are retried once
+//       their file tells us (through its FileBlockerSet) that it might be ready.
+class IORing final : public File {
+public:
+    static ErrorOr<NonnullRefPtr<IORing>> try_create(Process&, io_ring_params&);
+    virtual ~IORing() override;
+
+    // An IO ring is readable while some of its pending requests might be ready to be retried.
+    virtual bool can_read(OpenFileDescription const&, u64) const override;
+    virtual ErrorOr<size_t> read(OpenFileDescription&, u64, UserOrKernelBuffer&, size_t) override { return EINVAL; }
+    virtual bool can_write(OpenFileDescription const&, u64) const override { return false; }
+    virtual ErrorOr<size_t> write(OpenFileDescription&, u64, UserOrKernelBuffer const&, size_t) override { return EINVAL; }
+    virtual ErrorOr<NonnullLockRefPtr<Memory::VMObject>> vmobject_for_mmap(Process&, Memory::VirtualRange const&, u64& offset, bool shared) override;
+
+    virtual ErrorOr<NonnullOwnPtr<KString>> pseudo_path(OpenFileDescription const&) const override;
+    virtual StringView class_name() const override { return "IORing"sv; }
+    virtual bool is_io_ring() const override { return true; }
+
+    // Submits up to `to_submit` requests, then waits until at least `min_complete` completions are available.
+    // Returns the number of submitted requests.
+    ErrorOr<FlatPtr> enter(Process&, OpenFileDescription&, u32 to_submit, u32 min_complete);
+
+private:
+    friend class IORingRequest;
+
+    IORing(ProcessID owner, NonnullLockRefPtr<Memory::AnonymousVMObject>, NonnullOwnPtr<Memory::Region>, u32 sq_entries, u32 cq_entries);
+
+    u32 completion_queue_size() const;
+    void post_completion(u64 user_data, ErrorOr<FlatPtr> result);
+
+    u32 submit(Process&, u32 to_submit);
+    void start_request(Process&, io_ring_sqe const&);
+    ErrorOr<NonnullRefPtr<IORingRequest>> create_request(Process&, io_ring_sqe const&);
+    ErrorOr<FlatPtr> execute(Process&, IORingRequest&);
+    void retry_ready_requests(Process&);
+    void request_might_be_ready(IORingRequest&);
+
+    ProcessID const m_owner;
+    NonnullLockRefPtr<Memory::AnonymousVMObject> m_vmobject;
+    NonnullOwnPtr<Memory::Region> m_kernel_region;
+
+    // NOTE: These point into memory that the process can write to at any time, so anything read from them
+    //       is copied before being looked at, and the kernel keeps its own copies of the counters it owns.
+    io_ring_header* m_header { nullptr };
+    io_ring_sqe* m_sqes { nullptr };
+    io_ring_cqe* m_cqes { nullptr };
+
+    u32 const m_sq_entries { 0 };
+    u32 const m_cq_entries { 0 };
+    u32 m_sq_head { 0 };
+    u32 m_cq_tail { 0 };
+
+    // NOTE: Only one thread at a time submits, retries or waits for completions, which means it's
+    //       the only one that can post completions while it's waiting for them.
+    Mutex m_lock { "IORing"sv };
+    IORingRequest::PendingList m_pending_requests;
+    size_t m_pending_request_count { 0 };
+
+    mutable SpinlockProtected<IORingRequest::ReadyList, LockRank::None> m_ready_requests {};
+};
+
+}
@@ -34,6 +34,8 @@ public:
     virtual ~ISO9660FS() override;
     virtual StringView class_name() const override { return "ISO9660FS"sv; }
     virtual Inode& root_inode() override;
+    // NOTE: ISO 9660 images are read-only, so cached lookups never go stale.
+    virtual bool supports_directory_entry_cache() const override { return true; }
 
     virtual unsigned total_block_count() const override;
     virtual unsigned total_inode_count() const override;
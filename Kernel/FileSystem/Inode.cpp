@@ -18,6 +18,7 @@
 #include <Kernel/Memory/SharedInodeVMObject.h>
 #include <Kernel/Net/LocalSocket.h>
 #include <Kernel/Tasks/Process.h>
+#include <Kernel/Tasks/WorkQueue.h>
 
 namespace Kernel {
 
@@ -113,6 +114,15 @@ ErrorOr<size_t> Inode::read_bytes(off_t offset, size_t length, UserOrKernelBuffe
     return read_bytes_locked(offset, length, buffer, open_description);
 }
 
+void Inode::schedule_readahead(off_t offset, size_t length)
+{
+    // Read-ahead is purely an optimization, so we don't care if it can't be queued or if it fails.
+    (void)g_io_work->try_queue([inode = NonnullRefPtr<Inode>(*this), offset, length] {
+        MutexLocker locker(inode->m_inode_lock, Mutex::Mode::Shared);
+        (void)inode->readahead_locked(offset, length);
+    });
+}
+
 ErrorOr<size_t> Inode::read_until_filled_or_end(off_t offset, size_t length, UserOrKernelBuffer buffer, OpenFileDescription* open_description) const
 {
     auto remaining_length = length;
@@ -226,6 +236,8 @@ void Inode::set_metadata_dirty(bool metadata_dirty)
 
 void Inode::did_add_child(InodeIdentifier, StringView name)
 {
+    VirtualFileSystem::the().directory_entry_cache().invalidate(*this, name);
+
     m_watchers.for_each([&](auto& watcher) {
         watcher->notify_inode_event({}, identifier(), InodeWatcherEvent::Type::ChildCreated, name);
     });
@@ -233,6 +245,8 @@ void Inode::did_add_child(InodeIdentifier, StringView name)
 
 void Inode::did_remove_child(InodeIdentifier, StringView name)
 {
+    VirtualFileSystem::the().directory_entry_cache().invalidate(*this, name);
+
     if (name == "." || name == "..") {
         // These are just aliases and are not interesting to userspace.
         return;
@@ -33,6 +33,8 @@ ErrorOr<size_t> InodeFile::read(OpenFileDescription& description, u64 offset, Us
     if (nread > 0) {
         Thread::current()->did_file_read(nread);
         evaluate_block_conditions();
+        if (auto readahead = description.did_read_for_readahead(offset, nread); readahead.has_value())
+            m_inode->schedule_readahead(readahead->offset, readahead->length);
     }
     return nread;
 }
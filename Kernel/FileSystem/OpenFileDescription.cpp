@@ -53,6 +53,10 @@ OpenFileDescription::OpenFileDescription(File& file)
 
 OpenFileDescription::~OpenFileDescription()
 {
+    // NOTE: Nobody can add this description to an EventPoll anymore, so it's fine to check this without the lock.
+    if (!m_event_poll_entries.is_empty())
+        EventPoll::description_will_be_destroyed({}, *this, m_event_poll_entries);
+
     m_file->detach(*this);
     // FIXME: Should this error path be observed somehow?
     (void)m_file->close();
@@ -314,6 +318,44 @@ InodeWatcher* OpenFileDescription::inode_watcher()
     return static_cast<InodeWatcher*>(m_file.ptr());
 }
 
+bool OpenFileDescription::is_event_poll() const
+{
+    return m_file->is_event_poll();
+}
+
+EventPoll const* OpenFileDescription::event_poll() const
+{
+    if (!is_event_poll())
+        return nullptr;
+    return static_cast<EventPoll const*>(m_file.ptr());
+}
+
+EventPoll* OpenFileDescription::event_poll()
+{
+    if (!is_event_poll())
+        return nullptr;
+    return static_cast<EventPoll*>(m_file.ptr());
+}
+
+bool OpenFileDescription::is_io_ring() const
+{
+    return m_file->is_io_ring();
+}
+
+IORing const* OpenFileDescription::io_ring() const
+{
+    if (!is_io_ring())
+        return nullptr;
+    return static_cast<IORing const*>(m_file.ptr());
+}
+
+IORing* OpenFileDescription::io_ring()
+{
+    if (!is_io_ring())
+        return nullptr;
+    return static_cast<IORing*>(m_file.ptr());
+}
+
 bool OpenFileDescription::is_mount_file() const
 {
     return m_file->is_mount_file();
@@ -499,6 +541,16 @@ bool OpenFileDescription::is_direct() const
     return m_state.with([](auto& state) { return state.direct; });
 }
 
+Optional<ReadaheadState::Range> OpenFileDescription::did_read_for_readahead(u64 offset, size_t length)
+{
+    return m_state.with([&](auto& state) -> Optional<ReadaheadState::Range> {
+        // O_DIRECT readers have explicitly opted out of any caching.
+        if (state.direct)
+            return {};
+        return state.readahead.did_read(offset, length);
+    });
+}
+
 bool OpenFileDescription::is_directory() const
 {
     return m_state.with([](auto& state) { return state.is_directory; });
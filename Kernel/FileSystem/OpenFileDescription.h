@@ -10,9 +10,11 @@
 #include <AK/Badge.h>
 #include <AK/RefPtr.h>
 #include <Kernel/FileSystem/Custody.h>
+#include <Kernel/FileSystem/EventPoll.h>
 #include <Kernel/FileSystem/FIFO.h>
 #include <Kernel/FileSystem/Inode.h>
 #include <Kernel/FileSystem/InodeMetadata.h>
+#include <Kernel/FileSystem/ReadaheadState.h>
 #include <Kernel/Forward.h>
 #include <Kernel/Library/KBuffer.h>
 #include <Kernel/Memory/VirtualAddress.h>
@@ -63,6 +65,8 @@ public:
 
     bool is_direct() const;
 
+    Optional<ReadaheadState::Range> did_read_for_readahead(u64 offset, size_t length);
+
     bool is_directory() const;
 
     File& file() { return *m_file; }
@@ -80,6 +84,15 @@ public:
     InodeWatcher const* inode_watcher() const;
     InodeWatcher* inode_watcher();
 
+    bool is_event_poll() const;
+    EventPoll const* event_poll() const;
+    EventPoll* event_poll();
+    EventPollEntry::DescriptionList& event_poll_entries(Badge<EventPoll>) { return m_event_poll_entries; }
+
+    bool is_io_ring() const;
+    IORing const* io_ring() const;
+    IORing* io_ring();
+
     bool is_mount_file() const;
     MountFile const* mount_file() const;
     MountFile* mount_file();
@@ -157,8 +170,12 @@ private:
         bool should_append : 1 { false };
         bool direct : 1 { false };
         FIFO::Direction fifo_direction : 2 { FIFO::Direction::Neither };
+        ReadaheadState readahead;
     };
 
     SpinlockProtected<State, LockRank::None> m_state {};
+
+    // NOTE: This is protected by the EventPoll entry links lock.
+    EventPollEntry::DescriptionList m_event_poll_entries;
 };
 }
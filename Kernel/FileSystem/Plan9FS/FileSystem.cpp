@@ -59,6 +59,9 @@ ErrorOr<void> Plan9FS::initialize_while_locked()
     version_message >> msize >> remote_protocol_version;
     dbgln("Remote supports msize={} and protocol version {}", msize, remote_protocol_version);
     m_remote_protocol_version = parse_protocol_version(remote_protocol_version);
+    // The server may only lower the message size we proposed, and it has to leave room for some payload.
+    if (msize <= Plan9FSMessage::max_header_size)
+        return EIO;
     m_max_message_size = min(m_max_message_size, (size_t)msize);
 
     // TODO: auth
@@ -248,6 +251,10 @@ ErrorOr<void> Plan9FS::read_and_dispatch_one_message()
     Header header;
     TRY(do_read(reinterpret_cast<u8*>(&header), sizeof(header)));
 
+    // Don't let a misbehaving server make us allocate more than the message size we agreed on.
+    if (header.size < sizeof(header) || header.size > m_max_message_size)
+        return EIO;
+
     auto buffer = TRY(KBuffer::try_create_with_size("Plan9FS: Plan9FSMessage read buffer"sv, header.size, Memory::Region::Access::ReadWrite));
     // Copy the already read header into the buffer.
     memcpy(buffer->data(), &header, sizeof(header));
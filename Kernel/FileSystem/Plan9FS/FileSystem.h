@@ -130,7 +130,9 @@ private:
     Atomic<u32> m_next_fid { 1 };
 
     ProtocolVersion m_remote_protocol_version { ProtocolVersion::v9P2000 };
-    size_t m_max_message_size { 4 * KiB };
+    // This is what we propose in Tversion; the server may negotiate it down. Reads and writes are split
+    // into messages of at most this size, so a large value is what makes bulk I/O fast.
+    size_t m_max_message_size { 512 * KiB };
 
     Mutex m_send_lock { "Plan9FS send"sv };
     Plan9FSBlockerSet m_completion_blocker;
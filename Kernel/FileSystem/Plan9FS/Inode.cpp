@@ -6,9 +6,13 @@
 
 #include <Kernel/FileSystem/Plan9FS/Inode.h>
 #include <Kernel/Tasks/Process.h>
+#include <Kernel/Time/TimeManagement.h>
 
 namespace Kernel {
 
+// 9P has no way for the server to tell us when attributes change, so we only trust them for a short while.
+static constexpr Duration attribute_cache_duration = Duration::from_seconds(1);
+
 Plan9FSInode::Plan9FSInode(Plan9FS& fs, u32 fid)
     : Inode(fs, fid)
 {
@@ -106,6 +110,7 @@ ErrorOr<size_t> Plan9FSInode::write_bytes_locked(off_t offset, size_t size, User
 {
     TRY(ensure_open_for_mode(O_WRONLY));
     size = fs().adjust_buffer_size(size);
+    invalidate_cached_metadata();
 
     auto data_copy = TRY(data.try_copy_into_kstring(size)); // FIXME: this seems ugly
 
@@ -121,6 +126,12 @@ ErrorOr<size_t> Plan9FSInode::write_bytes_locked(off_t offset, size_t size, User
 
 InodeMetadata Plan9FSInode::metadata() const
 {
+    MutexLocker locker(m_inode_lock);
+
+    auto now = TimeManagement::the().monotonic_time();
+    if (m_cached_metadata_valid_until.has_value() && now < m_cached_metadata_valid_until.value())
+        return m_cached_metadata;
+
     InodeMetadata metadata;
     metadata.inode = identifier();
 
@@ -171,9 +182,17 @@ InodeMetadata Plan9FSInode::metadata() const
         metadata.block_count = blocks;
     }
 
+    m_cached_metadata = metadata;
+    m_cached_metadata_valid_until = now + attribute_cache_duration;
     return metadata;
 }
 
+void Plan9FSInode::invalidate_cached_metadata()
+{
+    MutexLocker locker(m_inode_lock);
+    m_cached_metadata_valid_until.clear();
+}
+
 ErrorOr<void> Plan9FSInode::flush_metadata()
 {
     // Do nothing.
@@ -298,6 +317,7 @@ ErrorOr<void> Plan9FSInode::truncate_locked(u64 new_size)
         u64 mtime_sec = 0;
         u64 mtime_nsec = 0;
         message << fid() << (u64)valid << mode << uid << gid << new_size << atime_sec << atime_nsec << mtime_sec << mtime_nsec;
+        invalidate_cached_metadata();
         return fs().post_message_and_wait_for_a_reply(message);
     }
 
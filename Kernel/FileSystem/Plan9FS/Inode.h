@@ -7,6 +7,8 @@
 #pragma once
 
 #include <AK/Atomic.h>
+#include <AK/Optional.h>
+#include <AK/Time.h>
 #include <Kernel/FileSystem/Inode.h>
 #include <Kernel/FileSystem/Plan9FS/FileSystem.h>
 #include <Kernel/FileSystem/Plan9FS/Message.h>
@@ -80,6 +82,12 @@ private:
     int m_open_mode { 0 };
     ErrorOr<void> ensure_open_for_mode(int mode);
 
+    void invalidate_cached_metadata();
+
+    // Attributes as last returned by Tgetattr, reused until they expire.
+    mutable InodeMetadata m_cached_metadata;
+    mutable Optional<MonotonicTime> m_cached_metadata_valid_until;
+
     Plan9FS& fs() { return reinterpret_cast<Plan9FS&>(Inode::fs()); }
     Plan9FS& fs() const
     {
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Optional.h>
+#include <AK/StdLibExtras.h>
+#include <AK/Types.h>
+
+namespace Kernel {
+
+// Tracks a single stream of reads and decides how far ahead of it we should read.
+// Every sequential read doubles the read-ahead window up to a maximum, and any other
+// access pattern resets it.
+class ReadaheadState {
+public:
+    static constexpr size_t initial_window = 32 * KiB;
+    static constexpr size_t maximum_window = 512 * KiB;
+
+    struct Range {
+        u64 offset { 0 };
+        size_t length { 0 };
+    };
+
+    Optional<Range> did_read(u64 offset, size_t length)
+    {
+        if (offset != m_next_offset) {
+            m_window = 0;
+            m_next_offset = offset + length;
+            m_readahead_end = m_next_offset;
+            return {};
+        }
+
+        m_next_offset = offset + length;
+        m_window = m_window == 0 ? initial_window : min(m_window * 2, maximum_window);
+
+        // Only extend the read-ahead once the reader has consumed half of what we already
+        // fetched for it, so the IO is issued in large batches instead of page by page.
+        if (m_readahead_end > m_next_offset + m_window / 2)
+            return {};
+
+        auto start = max(m_readahead_end, m_next_offset);
+        auto end = m_next_offset + m_window;
+        m_readahead_end = end;
+        return Range { start, static_cast<size_t>(end - start) };
+    }
+
+private:
+    u64 m_next_offset { 0 };
+    u64 m_readahead_end { 0 };
+    size_t m_window { 0 };
+};
+
+}
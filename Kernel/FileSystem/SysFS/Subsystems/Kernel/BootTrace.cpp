@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/Boot/BootTrace.h>
+#include <Kernel/FileSystem/SysFS/Subsystems/Kernel/BootTrace.h>
+#include <Kernel/Sections.h>
+
+namespace Kernel {
+
+UNMAP_AFTER_INIT SysFSBootTrace::SysFSBootTrace(SysFSDirectory const& parent_directory)
+    : SysFSGlobalInformation(parent_directory)
+{
+}
+
+UNMAP_AFTER_INIT NonnullRefPtr<SysFSBootTrace> SysFSBootTrace::must_create(SysFSDirectory const& parent_directory)
+{
+    return adopt_ref_if_nonnull(new (nothrow) SysFSBootTrace(parent_directory)).release_nonnull();
+}
+
+ErrorOr<void> SysFSBootTrace::try_generate(KBufferBuilder& builder)
+{
+    return BootTrace::to_json(builder);
+}
+
+}
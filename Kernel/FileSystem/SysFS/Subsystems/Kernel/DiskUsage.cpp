@@ -7,6 +7,7 @@
 #include <AK/JsonObjectSerializer.h>
 #include <Kernel/API/POSIX/unistd.h>
 #include <Kernel/Devices/Loop/LoopDevice.h>
+#include <Kernel/FileSystem/BlockBasedFileSystem.h>
 #include <Kernel/FileSystem/FileBackedFileSystem.h>
 #include <Kernel/FileSystem/SysFS/Subsystems/Kernel/DiskUsage.h>
 #include <Kernel/FileSystem/VirtualFileSystem.h>
@@ -41,6 +42,15 @@ ErrorOr<void> SysFSDiskUsage::try_generate(KBufferBuilder& builder)
         TRY(fs_object.add("readonly"sv, fs.is_readonly()));
         TRY(fs_object.add("mount_flags"sv, mount.flags()));
 
+        if (fs.is_block_based()) {
+            auto cache_statistics = static_cast<BlockBasedFileSystem const&>(fs).disk_cache_statistics();
+            TRY(fs_object.add("cache_capacity"sv, cache_statistics.capacity));
+            TRY(fs_object.add("cache_dirty"sv, cache_statistics.dirty));
+            TRY(fs_object.add("cache_hits"sv, cache_statistics.hits));
+            TRY(fs_object.add("cache_misses"sv, cache_statistics.misses));
+            TRY(fs_object.add("cache_evictions"sv, cache_statistics.evictions));
+        }
+
         if (mount.flags() & MS_SRCHIDDEN) {
             TRY(fs_object.add("source"sv, "unknown"));
         } else {
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/JsonObjectSerializer.h>
+#include <Kernel/FileSystem/SysFS/Subsystems/Kernel/LockStatistics.h>
+#include <Kernel/Locking/LockStatistics.h>
+#include <Kernel/Sections.h>
+
+namespace Kernel {
+
+UNMAP_AFTER_INIT SysFSLockStatistics::SysFSLockStatistics(SysFSDirectory const& parent_directory)
+    : SysFSGlobalInformation(parent_directory)
+{
+}
+
+UNMAP_AFTER_INIT NonnullRefPtr<SysFSLockStatistics> SysFSLockStatistics::must_create(SysFSDirectory const& parent_directory)
+{
+    return adopt_ref_if_nonnull(new (nothrow) SysFSLockStatistics(parent_directory)).release_nonnull();
+}
+
+ErrorOr<void> SysFSLockStatistics::try_generate(KBufferBuilder& builder)
+{
+    auto json = TRY(JsonObjectSerializer<>::try_create(builder));
+
+    auto mutexes = TRY(json.add_array("mutexes"sv));
+    for (size_t i = 0; i < LockStatistics::max_lock_sites; ++i) {
+        auto const* site = LockStatistics::site_at(i);
+        if (!site)
+            continue;
+        auto obj = TRY(mutexes.add_object());
+        TRY(obj.add("name"sv, site->lock_name()));
+        TRY(obj.add("file"sv, site->file_name()));
+        TRY(obj.add("function"sv, site->function_name()));
+        TRY(obj.add("line"sv, site->line_number()));
+        TRY(obj.add("acquisitions"sv, site->acquisitions()));
+        TRY(obj.add("contended_acquisitions"sv, site->contended_acquisitions()));
+        TRY(obj.add("total_wait_time_ns"sv, site->total_wait_time_ns()));
+        TRY(obj.add("max_wait_time_ns"sv, site->max_wait_time_ns()));
+        TRY(obj.add("exclusive_holds"sv, site->exclusive_holds()));
+        TRY(obj.add("total_hold_time_ns"sv, site->total_hold_time_ns()));
+        TRY(obj.finish());
+    }
+    TRY(mutexes.finish());
+
+    auto spinlocks = TRY(json.add_array("spinlocks"sv));
+    for (auto rank : LockStatistics::spinlock_ranks) {
+        auto statistics = LockStatistics::spinlock_statistics_for(rank);
+        auto obj = TRY(spinlocks.add_object());
+        TRY(obj.add("rank"sv, lock_rank_to_string(rank)));
+        TRY(obj.add("acquisitions"sv, statistics.acquisitions));
+        TRY(obj.add("contended_acquisitions"sv, statistics.contended_acquisitions));
+        TRY(obj.add("spins"sv, statistics.spins));
+        TRY(obj.finish());
+    }
+    TRY(spinlocks.finish());
+
+    TRY(json.finish());
+    return {};
+}
+
+}
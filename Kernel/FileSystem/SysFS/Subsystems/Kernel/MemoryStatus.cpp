@@ -27,6 +27,8 @@ ErrorOr<void> SysFSMemoryStatus::try_generate(KBufferBuilder& builder)
     get_kmalloc_stats(stats);
 
     auto system_memory = MM.get_system_memory_info();
+    auto huge_pages = MM.huge_page_statistics();
+    auto reclaim = MM.reclaim_statistics();
 
     auto json = TRY(JsonObjectSerializer<>::try_create(builder));
     TRY(json.add("kmalloc_allocated"sv, stats.bytes_allocated));
@@ -35,8 +37,16 @@ ErrorOr<void> SysFSMemoryStatus::try_generate(KBufferBuilder& builder)
     TRY(json.add("physical_available"sv, system_memory.physical_pages - system_memory.physical_pages_used));
     TRY(json.add("physical_committed"sv, system_memory.physical_pages_committed));
     TRY(json.add("physical_uncommitted"sv, system_memory.physical_pages_uncommitted));
+    TRY(json.add("physical_zeroed"sv, system_memory.physical_pages_zeroed));
     TRY(json.add("kmalloc_call_count"sv, stats.kmalloc_call_count));
     TRY(json.add("kfree_call_count"sv, stats.kfree_call_count));
+    TRY(json.add("huge_pages_mapped"sv, huge_pages.mapped));
+    TRY(json.add("huge_pages_allocated"sv, huge_pages.allocated));
+    TRY(json.add("huge_page_allocation_failures"sv, huge_pages.allocation_failures));
+    TRY(json.add("huge_page_splits"sv, huge_pages.splits));
+    TRY(json.add("reclaim_pages_purged"sv, reclaim.pages_purged));
+    TRY(json.add("reclaim_clean_pages_released"sv, reclaim.clean_pages_reclaimed));
+    TRY(json.add("physical_allocation_failures"sv, reclaim.allocation_failures));
     TRY(json.finish());
     return {};
 }
@@ -25,15 +25,13 @@ UNMAP_AFTER_INIT NonnullRefPtr<SysFSNetworkARPStats> SysFSNetworkARPStats::must_
 ErrorOr<void> SysFSNetworkARPStats::try_generate(KBufferBuilder& builder)
 {
     auto array = TRY(JsonArraySerializer<>::try_create(builder));
-    TRY(arp_table().with([&](auto const& table) -> ErrorOr<void> {
-        for (auto& it : table) {
-            auto obj = TRY(array.add_object());
-            auto mac_address = TRY(it.value.to_string());
-            TRY(obj.add("mac_address"sv, mac_address->view()));
-            auto ip_address = TRY(it.key.to_string());
-            TRY(obj.add("ip_address"sv, ip_address->view()));
-            TRY(obj.finish());
-        }
+    TRY(arp_table().try_for_each([&](auto const& ipv4_address, auto const& mac_address) -> ErrorOr<void> {
+        auto obj = TRY(array.add_object());
+        auto mac_address_string = TRY(mac_address.to_string());
+        TRY(obj.add("mac_address"sv, mac_address_string->view()));
+        auto ip_address_string = TRY(ipv4_address.to_string());
+        TRY(obj.add("ip_address"sv, ip_address_string->view()));
+        TRY(obj.finish());
         return {};
     }));
     TRY(array.finish());
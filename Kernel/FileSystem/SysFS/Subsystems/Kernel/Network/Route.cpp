@@ -25,7 +25,7 @@ ErrorOr<void> SysFSNetworkRouteStats::try_generate(KBufferBuilder& builder)
 {
     auto array = TRY(JsonArraySerializer<>::try_create(builder));
     TRY(routing_table().with([&](auto const& table) -> ErrorOr<void> {
-        for (auto& it : table) {
+        for (auto& it : table.routes()) {
             auto obj = TRY(array.add_object());
             auto destination = TRY(it.destination.to_string());
             TRY(obj.add("destination"sv, destination->view()));
@@ -278,6 +278,18 @@ void VirtualFileSystem::sync_filesystems()
     }
 }
 
+void VirtualFileSystem::write_back_filesystems()
+{
+    Vector<NonnullRefPtr<FileSystem>, 32> file_systems;
+    m_file_systems_list.with([&](auto const& list) {
+        for (auto& fs : list)
+            file_systems.append(fs);
+    });
+
+    for (auto& fs : file_systems)
+        fs->write_back_in_background();
+}
+
 void VirtualFileSystem::lock_all_filesystems()
 {
     Vector<NonnullRefPtr<FileSystem>, 32> file_systems;
@@ -299,6 +311,9 @@ ErrorOr<void> VirtualFileSystem::unmount(Custody& mountpoint_custody)
 
 ErrorOr<void> VirtualFileSystem::unmount(Inode& guest_inode, StringView custody_path)
 {
+    // NOTE: Cached lookups hold references to the file system's inodes, which would make it look busy.
+    m_directory_entry_cache.purge(guest_inode.fsid());
+
     return m_file_backed_file_systems_list.with_exclusive([&](auto& file_backed_fs_list) -> ErrorOr<void> {
         TRY(m_mounts.with([&](auto& mounts) -> ErrorOr<void> {
             for (auto& mount : mounts) {
@@ -1172,6 +1187,26 @@ ErrorOr<NonnullRefPtr<Custody>> VirtualFileSystem::resolve_path(Process const& p
     return custody;
 }
 
+ErrorOr<NonnullRefPtr<Inode>> VirtualFileSystem::lookup_child(Inode& parent_inode, StringView name)
+{
+    if (!parent_inode.fs().supports_directory_entry_cache())
+        return parent_inode.lookup(name);
+
+    if (auto cached_child = m_directory_entry_cache.lookup(parent_inode, name); cached_child.has_value()) {
+        if (!cached_child.value())
+            return ENOENT;
+        return cached_child.release_value().release_nonnull();
+    }
+
+    auto generation = m_directory_entry_cache.generation();
+    auto child_or_error = parent_inode.lookup(name);
+    if (!child_or_error.is_error())
+        m_directory_entry_cache.add(parent_inode, name, child_or_error.value(), generation);
+    else if (child_or_error.error().code() == ENOENT)
+        m_directory_entry_cache.add(parent_inode, name, nullptr, generation);
+    return child_or_error;
+}
+
 static bool safe_to_follow_symlink(Credentials const& credentials, Inode const& inode, InodeMetadata const& parent_metadata)
 {
     auto metadata = inode.metadata();
@@ -1226,7 +1261,7 @@ ErrorOr<NonnullRefPtr<Custody>> VirtualFileSystem::resolve_path_without_veil(Cre
         }
 
         // Okay, let's look up this part.
-        auto child_or_error = parent.inode().lookup(part);
+        auto child_or_error = lookup_child(parent.inode(), part);
         if (child_or_error.is_error()) {
             if (out_parent) {
                 // ENOENT with a non-null parent custody signals to caller that
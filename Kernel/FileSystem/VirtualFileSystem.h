@@ -13,6 +13,7 @@
 #include <AK/OwnPtr.h>
 #include <AK/RefPtr.h>
 #include <Kernel/FileSystem/CustodyBase.h>
+#include <Kernel/FileSystem/DirectoryEntryCache.h>
 #include <Kernel/FileSystem/FileBackedFileSystem.h>
 #include <Kernel/FileSystem/FileSystem.h>
 #include <Kernel/FileSystem/Initializer.h>
@@ -90,6 +91,7 @@ public:
     ErrorOr<void> for_each_mount(Function<ErrorOr<void>(Mount const&)>) const;
 
     void sync_filesystems();
+    void write_back_filesystems();
     void lock_all_filesystems();
 
     static void sync();
@@ -99,6 +101,8 @@ public:
     ErrorOr<NonnullRefPtr<Custody>> resolve_path(Process const&, Credentials const&, StringView path, CustodyBase const& base, RefPtr<Custody>* out_parent = nullptr, int options = 0, int symlink_recursion_level = 0);
     ErrorOr<NonnullRefPtr<Custody>> resolve_path_without_veil(Credentials const&, StringView path, NonnullRefPtr<Custody> base, RefPtr<Custody>* out_parent = nullptr, int options = 0, int symlink_recursion_level = 0);
 
+    DirectoryEntryCache& directory_entry_cache() { return m_directory_entry_cache; }
+
 private:
     friend class OpenFileDescription;
 
@@ -112,6 +116,8 @@ private:
 
     ErrorOr<void> traverse_directory_inode(Inode&, Function<ErrorOr<void>(FileSystem::DirectoryEntryView const&)>);
 
+    ErrorOr<NonnullRefPtr<Inode>> lookup_child(Inode& parent_inode, StringView name);
+
     static bool check_matching_absolute_path_hierarchy(Custody const& first_custody, Custody const& second_custody);
     bool mount_point_exists_at_custody(Custody& mount_point);
 
@@ -131,6 +137,8 @@ private:
     MutexProtected<IntrusiveList<&FileBackedFileSystem::m_file_backed_file_system_node>> m_file_backed_file_systems_list {};
 
     SpinlockProtected<IntrusiveList<&FileSystem::m_file_system_node>, LockRank::FileSystem> m_file_systems_list {};
+
+    DirectoryEntryCache m_directory_entry_cache;
 };
 
 }
@@ -5,11 +5,13 @@
  */
 
 #include <AK/Assertions.h>
+#include <AK/Optional.h>
 #include <AK/Types.h>
 #include <Kernel/Arch/PageDirectory.h>
 #include <Kernel/Debug.h>
 #include <Kernel/Heap/Heap.h>
 #include <Kernel/Heap/kmalloc.h>
+#include <Kernel/Interrupts/InterruptDisabler.h>
 #include <Kernel/KSyms.h>
 #include <Kernel/Library/Panic.h>
 #include <Kernel/Library/StdLib.h>
@@ -28,6 +30,7 @@ static_assert(is_power_of_two(CHUNK_SIZE));
 
 static constexpr size_t INITIAL_KMALLOC_MEMORY_SIZE = 2 * MiB;
 static constexpr size_t KMALLOC_DEFAULT_ALIGNMENT = 16;
+static constexpr size_t KMALLOC_SLABHEAP_COUNT = 6;
 
 // Treat the heap as logically separate from .bss
 __attribute__((section(".heap"))) static u8 initial_kmalloc_memory[INITIAL_KMALLOC_MEMORY_SIZE];
@@ -167,7 +170,12 @@ public:
 #ifndef HAS_ADDRESS_SANITIZER
         memset(ptr, KFREE_SCRUB_BYTE, m_slab_size);
 #endif
+        return_to_block(ptr);
+    }
 
+    // Note: This is for slabs that were already scrubbed when they were freed into a magazine.
+    void return_to_block(void* ptr)
+    {
         auto* block = (KmallocSlabBlock*)((FlatPtr)ptr & KmallocSlabBlock::block_mask);
         bool block_was_full = block->is_full();
         block->deallocate(ptr);
@@ -223,6 +231,8 @@ private:
     KmallocSlabBlock::List m_full_blocks;
 };
 
+static void drain_current_processor_magazines();
+
 struct KmallocGlobalData {
     static constexpr size_t minimum_subheap_size = 1 * MiB;
 
@@ -257,6 +267,9 @@ struct KmallocGlobalData {
         if (size <= KmallocSlabBlock::block_size * 2 + sizeof(ptrdiff_t) + sizeof(size_t)) {
             // FIXME: We should propagate a freed pointer, to find the specific subheap it belonged to
             //        This would save us iterating over them in the next step and remove a recursion
+            // Note: Slabs cached in our magazines keep their blocks alive, so hand them back first.
+            //       We can't touch the magazines of the other processors from here.
+            drain_current_processor_magazines();
             bool did_purge = false;
             for (auto& slabheap : slabheaps) {
                 if (slabheap.try_purge()) {
@@ -412,7 +425,7 @@ struct KmallocGlobalData {
 
     KmallocSubheap::List subheaps;
 
-    KmallocSlabheap slabheaps[6] = { 16, 32, 64, 128, 256, 512 };
+    KmallocSlabheap slabheaps[KMALLOC_SLABHEAP_COUNT] = { 16, 32, 64, 128, 256, 512 };
 
     bool expansion_in_progress { false };
 };
@@ -420,11 +433,105 @@ struct KmallocGlobalData {
 READONLY_AFTER_INIT static KmallocGlobalData* g_kmalloc_global;
 alignas(KmallocGlobalData) static u8 g_kmalloc_global_heap[sizeof(KmallocGlobalData)];
 
-static size_t g_kmalloc_call_count;
-static size_t g_kfree_call_count;
-static size_t g_nested_kfree_calls;
 bool g_dump_kmalloc_stacks;
 
+// Every processor keeps a small magazine of free slabs for each slabheap, so that most small
+// allocations and frees never touch the global kmalloc lock. An empty magazine is refilled from
+// its slabheap (and a full one drained back into it) in batches, while holding the lock once.
+// The magazines are only ever touched by their own processor with interrupts disabled.
+struct KmallocMagazine {
+    static constexpr size_t capacity = 16;
+    static constexpr size_t batch_size = capacity / 2;
+
+    size_t count { 0 };
+    void* slabs[capacity];
+};
+
+struct KmallocProcessorCache {
+    KmallocMagazine magazines[KMALLOC_SLABHEAP_COUNT];
+    size_t kmalloc_call_count { 0 };
+    size_t kfree_call_count { 0 };
+    size_t nested_kfree_calls { 0 };
+};
+
+static KmallocProcessorCache s_processor_caches[MAX_CPU_COUNT];
+
+static KmallocProcessorCache& current_processor_cache()
+{
+    VERIFY(!Processor::are_interrupts_enabled());
+    return s_processor_caches[Processor::current_id()];
+}
+
+static Optional<size_t> magazine_index_for(size_t size, size_t alignment)
+{
+#ifdef HAS_ADDRESS_SANITIZER
+    // Slabs sitting in a magazine are neither allocated nor free as far as the shadow memory is concerned.
+    (void)size;
+    (void)alignment;
+    return {};
+#else
+    // NOTE: There's no need to take the kmalloc lock, as the kmalloc slab-heaps (and their sizes) are constant
+    for (size_t index = 0; index < KMALLOC_SLABHEAP_COUNT; ++index) {
+        auto slab_size = g_kmalloc_global->slabheaps[index].slab_size();
+        if (size <= slab_size && alignment <= slab_size)
+            return index;
+    }
+    return {};
+#endif
+}
+
+static void* allocate_from_magazine(size_t index, CallerWillInitializeMemory caller_will_initialize_memory)
+{
+    auto& slabheap = g_kmalloc_global->slabheaps[index];
+    void* ptr = nullptr;
+    {
+        InterruptDisabler disabler;
+        auto& cache = current_processor_cache();
+        ++cache.kmalloc_call_count;
+        auto& magazine = cache.magazines[index];
+        if (magazine.count == 0) {
+            SpinlockLocker lock(s_lock);
+            while (magazine.count < KmallocMagazine::batch_size) {
+                // Note: Going through the global allocator (rather than the slabheap directly) lets it purge and expand as needed.
+                auto* slab = g_kmalloc_global->allocate(slabheap.slab_size(), KMALLOC_DEFAULT_ALIGNMENT, CallerWillInitializeMemory::Yes);
+                if (!slab)
+                    break;
+                magazine.slabs[magazine.count++] = slab;
+            }
+            if (magazine.count == 0)
+                return nullptr;
+        }
+        ptr = magazine.slabs[--magazine.count];
+    }
+
+    if (caller_will_initialize_memory == CallerWillInitializeMemory::No)
+        memset(ptr, KMALLOC_SCRUB_BYTE, slabheap.slab_size());
+    return ptr;
+}
+
+static void deallocate_into_magazine(KmallocProcessorCache& cache, size_t index, void* ptr)
+{
+    auto& magazine = cache.magazines[index];
+    if (magazine.count == KmallocMagazine::capacity) {
+        SpinlockLocker lock(s_lock);
+        auto& slabheap = g_kmalloc_global->slabheaps[index];
+        while (magazine.count > KmallocMagazine::capacity - KmallocMagazine::batch_size)
+            slabheap.return_to_block(magazine.slabs[--magazine.count]);
+    }
+    magazine.slabs[magazine.count++] = ptr;
+}
+
+static void drain_current_processor_magazines()
+{
+    VERIFY(s_lock.is_locked());
+    auto& cache = current_processor_cache();
+    for (size_t index = 0; index < KMALLOC_SLABHEAP_COUNT; ++index) {
+        auto& magazine = cache.magazines[index];
+        while (magazine.count > 0)
+            g_kmalloc_global->slabheaps[index].return_to_block(magazine.slabs[--magazine.count]);
+    }
+}
+
 void kmalloc_enable_expand()
 {
     g_kmalloc_global->enable_expansion();
@@ -449,15 +556,20 @@ static void* kmalloc_impl(size_t size, size_t alignment, CallerWillInitializeMem
     // Alignment must be a power of two.
     VERIFY(is_power_of_two(alignment));
 
-    SpinlockLocker lock(s_lock);
-    ++g_kmalloc_call_count;
+    void* ptr = nullptr;
+    if (auto magazine_index = magazine_index_for(size, alignment); magazine_index.has_value() && !g_dump_kmalloc_stacks) {
+        ptr = allocate_from_magazine(magazine_index.value(), caller_will_initialize_memory);
+    } else {
+        SpinlockLocker lock(s_lock);
+        ++current_processor_cache().kmalloc_call_count;
 
-    if (g_dump_kmalloc_stacks && Kernel::g_kernel_symbols_available.was_set()) {
-        dbgln("kmalloc({})", size);
-        Kernel::dump_backtrace();
-    }
+        if (g_dump_kmalloc_stacks && Kernel::g_kernel_symbols_available.was_set()) {
+            dbgln("kmalloc({})", size);
+            Kernel::dump_backtrace();
+        }
 
-    void* ptr = g_kmalloc_global->allocate(size, alignment, caller_will_initialize_memory);
+        ptr = g_kmalloc_global->allocate(size, alignment, caller_will_initialize_memory);
+    }
 
     Thread* current_thread = Thread::current();
     if (!current_thread)
@@ -500,11 +612,19 @@ void kfree_sized(void* ptr, size_t size)
         Processor::verify_no_spinlocks_held();
     }
 
-    SpinlockLocker lock(s_lock);
-    ++g_kfree_call_count;
-    ++g_nested_kfree_calls;
+    auto magazine_index = magazine_index_for(size, 1);
+    if (magazine_index.has_value()) {
+        VERIFY(g_kmalloc_global->is_valid_kmalloc_address(VirtualAddress { ptr }));
+        // Note: Scrub the slab before disabling interrupts, it will sit in the magazine as free memory.
+        memset(ptr, KFREE_SCRUB_BYTE, g_kmalloc_global->slabheaps[magazine_index.value()].slab_size());
+    }
+
+    InterruptDisabler disabler;
+    auto& cache = current_processor_cache();
+    ++cache.kfree_call_count;
+    ++cache.nested_kfree_calls;
 
-    if (g_nested_kfree_calls == 1) {
+    if (cache.nested_kfree_calls == 1) {
         Thread* current_thread = Thread::current();
         if (!current_thread)
             current_thread = Processor::idle_thread();
@@ -514,8 +634,13 @@ void kfree_sized(void* ptr, size_t size)
         }
     }
 
-    g_kmalloc_global->deallocate(ptr, size);
-    --g_nested_kfree_calls;
+    if (magazine_index.has_value()) {
+        deallocate_into_magazine(cache, magazine_index.value(), ptr);
+    } else {
+        SpinlockLocker lock(s_lock);
+        g_kmalloc_global->deallocate(ptr, size);
+    }
+    --cache.nested_kfree_calls;
 }
 
 size_t kmalloc_good_size(size_t size)
@@ -602,6 +727,18 @@ void get_kmalloc_stats(kmalloc_stats& stats)
     SpinlockLocker lock(s_lock);
     stats.bytes_allocated = g_kmalloc_global->allocated_bytes();
     stats.bytes_free = g_kmalloc_global->free_bytes();
-    stats.kmalloc_call_count = g_kmalloc_call_count;
-    stats.kfree_call_count = g_kfree_call_count;
+    stats.kmalloc_call_count = 0;
+    stats.kfree_call_count = 0;
+
+    // Note: We can't lock the other processors' caches, so these numbers may be slightly stale.
+    for (auto const& cache : s_processor_caches) {
+        stats.kmalloc_call_count += cache.kmalloc_call_count;
+        stats.kfree_call_count += cache.kfree_call_count;
+        for (size_t index = 0; index < KMALLOC_SLABHEAP_COUNT; ++index) {
+            // Slabs cached in a magazine look allocated to their slabheap, but they are free.
+            auto cached_bytes = cache.magazines[index].count * g_kmalloc_global->slabheaps[index].slab_size();
+            stats.bytes_allocated -= cached_bytes;
+            stats.bytes_free += cached_bytes;
+        }
+    }
 }
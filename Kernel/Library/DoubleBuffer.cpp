@@ -20,12 +20,13 @@ inline void DoubleBuffer::compute_lockfree_metadata()
 ErrorOr<NonnullOwnPtr<DoubleBuffer>> DoubleBuffer::try_create(StringView name, size_t capacity)
 {
     auto storage = TRY(KBuffer::try_create_with_size(name, capacity * 2, Memory::Region::Access::ReadWrite));
-    return adopt_nonnull_own_or_enomem(new (nothrow) DoubleBuffer(capacity, move(storage)));
+    return adopt_nonnull_own_or_enomem(new (nothrow) DoubleBuffer(name, capacity, move(storage)));
 }
 
-DoubleBuffer::DoubleBuffer(size_t capacity, NonnullOwnPtr<KBuffer> storage)
+DoubleBuffer::DoubleBuffer(StringView name, size_t capacity, NonnullOwnPtr<KBuffer> storage)
     : m_write_buffer(&m_buffer1)
     , m_read_buffer(&m_buffer2)
+    , m_name(name)
     , m_storage(move(storage))
     , m_capacity(capacity)
 {
@@ -36,6 +37,31 @@ DoubleBuffer::DoubleBuffer(size_t capacity, NonnullOwnPtr<KBuffer> storage)
     m_space_for_writing = capacity;
 }
 
+ErrorOr<void> DoubleBuffer::try_set_capacity(size_t capacity)
+{
+    MutexLocker locker(m_lock);
+    size_t unread_size = m_read_buffer->size - m_read_buffer_index;
+    capacity = max(capacity, max(unread_size, m_write_buffer->size));
+    if (capacity == m_capacity)
+        return {};
+
+    auto storage = TRY(KBuffer::try_create_with_size(m_name, capacity * 2, Memory::Region::Access::ReadWrite));
+    // The unread data keeps being read first, and anything written later goes after what's already waiting.
+    memcpy(storage->data(), m_write_buffer->data, m_write_buffer->size);
+    memcpy(storage->data() + capacity, m_read_buffer->data + m_read_buffer_index, unread_size);
+    m_buffer1 = { storage->data(), m_write_buffer->size };
+    m_buffer2 = { storage->data() + capacity, unread_size };
+    m_write_buffer = &m_buffer1;
+    m_read_buffer = &m_buffer2;
+    m_read_buffer_index = 0;
+    m_storage = move(storage);
+    m_capacity = capacity;
+    compute_lockfree_metadata();
+    if (m_unblock_callback && m_space_for_writing > 0)
+        m_unblock_callback();
+    return {};
+}
+
 void DoubleBuffer::flip()
 {
     VERIFY(m_read_buffer_index == m_read_buffer->size);
@@ -37,6 +37,10 @@ public:
 
     bool is_empty() const { return m_empty; }
 
+    size_t capacity() const { return m_capacity; }
+    // NOTE: Never drops buffered data, so the new capacity may end up a bit larger than asked for.
+    ErrorOr<void> try_set_capacity(size_t);
+
     size_t space_for_writing() const { return m_space_for_writing; }
     size_t immediately_readable() const
     {
@@ -50,7 +54,7 @@ public:
     }
 
 private:
-    explicit DoubleBuffer(size_t capacity, NonnullOwnPtr<KBuffer> storage);
+    DoubleBuffer(StringView name, size_t capacity, NonnullOwnPtr<KBuffer> storage);
     void flip();
     void compute_lockfree_metadata();
 
@@ -66,6 +70,7 @@ private:
     InnerBuffer m_buffer1;
     InnerBuffer m_buffer2;
 
+    StringView m_name;
     NonnullOwnPtr<KBuffer> m_storage;
     Function<void()> m_unblock_callback;
     size_t m_capacity { 0 };
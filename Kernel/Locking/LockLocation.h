@@ -8,7 +8,7 @@
 
 #include <AK/StdLibExtras.h>
 #include <Kernel/Debug.h>
-#if LOCK_DEBUG
+#if LOCK_DEBUG || LOCK_STATISTICS
 #    include <AK/SourceLocation.h>
 #endif
 
@@ -16,13 +16,13 @@
 // significant amount of #ifdefs in Mutex / MutexLocker / etc.
 //
 // To do this we declare LockLocation to be a zero sized struct which will
-// get optimized out during normal compilation. When LOCK_DEBUG is enabled,
-// we forward the implementation to AK::SourceLocation and get rich debugging
+// get optimized out during normal compilation. When LOCK_DEBUG (or LOCK_STATISTICS)
+// is enabled, we forward the implementation to AK::SourceLocation and get rich debugging
 // information for every caller.
 
 namespace Kernel {
 
-#if LOCK_DEBUG
+#if LOCK_DEBUG || LOCK_STATISTICS
 using LockLocation = SourceLocation;
 #else
 struct LockLocation {
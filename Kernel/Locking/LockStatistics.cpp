@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <AK/BuiltinWrappers.h>
+#include <AK/HashFunctions.h>
+#include <Kernel/Arch/Processor.h>
+#include <Kernel/Debug.h>
+#include <Kernel/Locking/LockStatistics.h>
+#include <Kernel/Time/TimeManagement.h>
+
+namespace Kernel {
+
+void LockSiteStatistics::record_acquisition(bool contended, u64 wait_time_ns)
+{
+    m_acquisitions.fetch_add(1, AK::memory_order_relaxed);
+    if (!contended)
+        return;
+    m_contended_acquisitions.fetch_add(1, AK::memory_order_relaxed);
+    m_total_wait_time_ns.fetch_add(wait_time_ns, AK::memory_order_relaxed);
+    auto max_wait_time_ns = m_max_wait_time_ns.load(AK::memory_order_relaxed);
+    while (wait_time_ns > max_wait_time_ns) {
+        if (m_max_wait_time_ns.compare_exchange_strong(max_wait_time_ns, wait_time_ns, AK::memory_order_relaxed))
+            break;
+    }
+}
+
+void LockSiteStatistics::record_exclusive_hold(u64 hold_time_ns)
+{
+    m_exclusive_holds.fetch_add(1, AK::memory_order_relaxed);
+    m_total_hold_time_ns.fetch_add(hold_time_ns, AK::memory_order_relaxed);
+}
+
+#if LOCK_STATISTICS
+static Array<LockSiteStatistics, LockStatistics::max_lock_sites> s_lock_sites;
+
+// Spinlock counters are only ever written by the processor that owns them (with interrupts
+// disabled), so they don't need to bounce cache lines between processors like the lock sites do.
+struct PerProcessorSpinlockStatistics {
+    Atomic<u64> acquisitions { 0 };
+    Atomic<u64> contended_acquisitions { 0 };
+    Atomic<u64> spins { 0 };
+};
+static Array<Array<PerProcessorSpinlockStatistics, array_size(LockStatistics::spinlock_ranks)>, LockStatistics::max_tracked_processors> s_spinlock_statistics;
+
+static size_t spinlock_rank_index(LockRank rank)
+{
+    if (rank == LockRank::None)
+        return 0;
+    return count_trailing_zeroes(static_cast<unsigned>(rank)) + 1;
+}
+#endif
+
+LockSiteStatistics* LockStatistics::site_for([[maybe_unused]] SourceLocation const& location, [[maybe_unused]] StringView lock_name)
+{
+#if LOCK_STATISTICS
+    auto hash = pair_int_hash(ptr_hash(bit_cast<FlatPtr>(location.filename().characters_without_null_termination())), pair_int_hash(location.line_number(), ptr_hash(bit_cast<FlatPtr>(lock_name.characters_without_null_termination()))));
+    for (size_t probe = 0; probe < max_lock_sites; ++probe) {
+        auto& site = s_lock_sites[(hash + probe) % max_lock_sites];
+        auto state = site.m_state.load(AK::memory_order_acquire);
+        if (state == LockSiteStatistics::State::Empty) {
+            if (site.m_state.compare_exchange_strong(state, LockSiteStatistics::State::Claiming, AK::memory_order_acquire)) {
+                site.m_lock_name = lock_name;
+                site.m_file_name = location.filename();
+                site.m_function_name = location.function_name();
+                site.m_line_number = location.line_number();
+                site.m_state.store(LockSiteStatistics::State::Ready, AK::memory_order_release);
+                return &site;
+            }
+        }
+        // Someone else is claiming this slot, wait for them to tell us which site it's for.
+        while (state == LockSiteStatistics::State::Claiming) {
+            Processor::pause();
+            state = site.m_state.load(AK::memory_order_acquire);
+        }
+        if (site.m_file_name.characters_without_null_termination() == location.filename().characters_without_null_termination() && site.m_line_number == location.line_number() && site.m_lock_name.characters_without_null_termination() == lock_name.characters_without_null_termination())
+            return &site;
+    }
+#endif
+    return nullptr;
+}
+
+LockSiteStatistics const* LockStatistics::site_at([[maybe_unused]] size_t index)
+{
+#if LOCK_STATISTICS
+    VERIFY(index < max_lock_sites);
+    auto& site = s_lock_sites[index];
+    if (site.m_state.load(AK::memory_order_acquire) == LockSiteStatistics::State::Ready)
+        return &site;
+#endif
+    return nullptr;
+}
+
+void LockStatistics::record_spinlock_acquisition([[maybe_unused]] LockRank rank, [[maybe_unused]] u32 spins)
+{
+#if LOCK_STATISTICS
+    auto& statistics = s_spinlock_statistics[Processor::current_id() % max_tracked_processors][spinlock_rank_index(rank)];
+    statistics.acquisitions.store(statistics.acquisitions.load(AK::memory_order_relaxed) + 1, AK::memory_order_relaxed);
+    if (spins == 0)
+        return;
+    statistics.contended_acquisitions.store(statistics.contended_acquisitions.load(AK::memory_order_relaxed) + 1, AK::memory_order_relaxed);
+    statistics.spins.store(statistics.spins.load(AK::memory_order_relaxed) + spins, AK::memory_order_relaxed);
+#endif
+}
+
+SpinlockRankStatistics LockStatistics::spinlock_statistics_for(LockRank rank)
+{
+    SpinlockRankStatistics result { .rank = rank };
+#if LOCK_STATISTICS
+    for (auto& per_processor_statistics : s_spinlock_statistics) {
+        auto& statistics = per_processor_statistics[spinlock_rank_index(rank)];
+        result.acquisitions += statistics.acquisitions.load(AK::memory_order_relaxed);
+        result.contended_acquisitions += statistics.contended_acquisitions.load(AK::memory_order_relaxed);
+        result.spins += statistics.spins.load(AK::memory_order_relaxed);
+    }
+#endif
+    return result;
+}
+
+u64 LockStatistics::now()
+{
+    if (!TimeManagement::is_initialized())
+        return 0;
+    return static_cast<u64>(TimeManagement::the().monotonic_time(TimePrecision::Precise).nanoseconds());
+}
+
+StringView lock_rank_to_string(LockRank rank)
+{
+    switch (rank) {
+    case LockRank::None:
+        return "None"sv;
+    case LockRank::MemoryManager:
+        return "MemoryManager"sv;
+    case LockRank::Interrupts:
+        return "Interrupts"sv;
+    case LockRank::FileSystem:
+        return "FileSystem"sv;
+    case LockRank::Thread:
+        return "Thread"sv;
+    case LockRank::Process:
+        return "Process"sv;
+    }
+    return "Unknown"sv;
+}
+
+}
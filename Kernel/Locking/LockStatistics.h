@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/SourceLocation.h>
+#include <AK/StringView.h>
+#include <AK/Types.h>
+#include <Kernel/Locking/LockRank.h>
+
+// When LOCK_STATISTICS is enabled, every Mutex acquisition is accounted to its lock site
+// (the lock's name and the source location that locked it), and every Spinlock acquisition
+// is accounted to its LockRank on the current processor. The results can be read from
+// /sys/kernel/lock_statistics, e.g. with the lockstat utility.
+
+namespace Kernel {
+
+class LockSiteStatistics {
+    friend class LockStatistics;
+
+public:
+    StringView lock_name() const { return m_lock_name; }
+    StringView file_name() const { return m_file_name; }
+    StringView function_name() const { return m_function_name; }
+    u32 line_number() const { return m_line_number; }
+
+    u64 acquisitions() const { return m_acquisitions.load(AK::memory_order_relaxed); }
+    u64 contended_acquisitions() const { return m_contended_acquisitions.load(AK::memory_order_relaxed); }
+    u64 total_wait_time_ns() const { return m_total_wait_time_ns.load(AK::memory_order_relaxed); }
+    u64 max_wait_time_ns() const { return m_max_wait_time_ns.load(AK::memory_order_relaxed); }
+    u64 exclusive_holds() const { return m_exclusive_holds.load(AK::memory_order_relaxed); }
+    u64 total_hold_time_ns() const { return m_total_hold_time_ns.load(AK::memory_order_relaxed); }
+
+    void record_acquisition(bool contended, u64 wait_time_ns);
+    void record_exclusive_hold(u64 hold_time_ns);
+
+private:
+    enum class State : u8 {
+        Empty,
+        Claiming,
+        Ready,
+    };
+
+    Atomic<State> m_state { State::Empty };
+    StringView m_lock_name;
+    StringView m_file_name;
+    StringView m_function_name;
+    u32 m_line_number { 0 };
+
+    Atomic<u64> m_acquisitions { 0 };
+    Atomic<u64> m_contended_acquisitions { 0 };
+    Atomic<u64> m_total_wait_time_ns { 0 };
+    Atomic<u64> m_max_wait_time_ns { 0 };
+    Atomic<u64> m_exclusive_holds { 0 };
+    Atomic<u64> m_total_hold_time_ns { 0 };
+};
+
+struct SpinlockRankStatistics {
+    LockRank rank { LockRank::None };
+    u64 acquisitions { 0 };
+    u64 contended_acquisitions { 0 };
+    u64 spins { 0 };
+};
+
+class LockStatistics {
+public:
+    static constexpr size_t max_lock_sites = 1024;
+    static constexpr size_t max_tracked_processors = 64;
+    static constexpr LockRank spinlock_ranks[] = { LockRank::None, LockRank::MemoryManager, LockRank::Interrupts, LockRank::FileSystem, LockRank::Thread, LockRank::Process };
+
+    // Returns nullptr if the site table is full.
+    static LockSiteStatistics* site_for(SourceLocation const&, StringView lock_name);
+    // Returns nullptr if no lock site has been recorded in this slot (yet).
+    static LockSiteStatistics const* site_at(size_t index);
+
+    static void record_spinlock_acquisition(LockRank, u32 spins);
+    static SpinlockRankStatistics spinlock_statistics_for(LockRank);
+
+    // Nanoseconds since boot, or 0 before the time keeping is up.
+    static u64 now();
+};
+
+StringView lock_rank_to_string(LockRank);
+
+}
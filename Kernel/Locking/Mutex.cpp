@@ -5,6 +5,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/ScopeGuard.h>
 #include <AK/SetOnce.h>
 #include <Kernel/Debug.h>
 #include <Kernel/KSyms.h>
@@ -30,8 +31,12 @@ void Mutex::lock(Mode mode, [[maybe_unused]] LockLocation const& location)
     VERIFY(mode != Mode::Unlocked);
     auto* current_thread = Thread::current();
 
-    SpinlockLocker lock(m_lock);
     bool did_block = false;
+#if LOCK_STATISTICS
+    auto acquire_started_at = LockStatistics::now();
+    ScopeGuard record_statistics = [&] { record_acquisition(mode, location, acquire_started_at, did_block); };
+#endif
+    SpinlockLocker lock(m_lock);
     Mode current_mode = m_mode;
     switch (current_mode) {
     case Mode::Unlocked: {
@@ -174,8 +179,12 @@ void Mutex::unlock()
     case Mode::Exclusive:
         VERIFY(m_holder == bit_cast<uintptr_t>(current_thread));
         VERIFY(m_shared_holders == 0);
-        if (m_times_locked == 0)
+        if (m_times_locked == 0) {
             m_holder = 0;
+#if LOCK_STATISTICS
+            record_exclusive_release();
+#endif
+        }
         break;
     case Mode::Shared: {
         VERIFY(!m_holder);
@@ -310,6 +319,9 @@ auto Mutex::force_unlock_exclusive_if_locked(u32& lock_count_to_restore) -> Mode
         current_thread->holding_lock(*this, -(int)m_times_locked, {});
 #endif
         m_holder = 0;
+#if LOCK_STATISTICS
+        record_exclusive_release();
+#endif
         VERIFY(m_times_locked > 0);
         lock_count_to_restore = m_times_locked;
         m_times_locked = 0;
@@ -335,6 +347,10 @@ void Mutex::restore_exclusive_lock(u32 lock_count, [[maybe_unused]] LockLocation
 
     auto* current_thread = Thread::current();
     bool did_block = false;
+#if LOCK_STATISTICS
+    auto acquire_started_at = LockStatistics::now();
+    ScopeGuard record_statistics = [&] { record_acquisition(Mode::Exclusive, location, acquire_started_at, did_block); };
+#endif
     SpinlockLocker lock(m_lock);
     [[maybe_unused]] auto previous_mode = m_mode;
     if (m_mode == Mode::Exclusive && m_holder != bit_cast<uintptr_t>(current_thread)) {
@@ -371,4 +387,30 @@ void Mutex::restore_exclusive_lock(u32 lock_count, [[maybe_unused]] LockLocation
 #endif
 }
 
+#if LOCK_STATISTICS
+void Mutex::record_acquisition(Mode mode, LockLocation const& location, u64 acquire_started_at, bool did_block)
+{
+    auto* site = LockStatistics::site_for(location, m_name);
+    if (!site)
+        return;
+    auto now = LockStatistics::now();
+    // NOTE: Locks taken before the time keeping is up are still counted, but not timed.
+    site->record_acquisition(did_block, acquire_started_at ? now - acquire_started_at : 0);
+
+    // Recursive exclusive acquisitions are accounted to the outermost one.
+    if (mode == Mode::Exclusive && now && !m_exclusive_holder_site) {
+        m_exclusive_holder_site = site;
+        m_exclusive_acquired_at = now;
+    }
+}
+
+void Mutex::record_exclusive_release()
+{
+    if (!m_exclusive_holder_site)
+        return;
+    m_exclusive_holder_site->record_exclusive_hold(LockStatistics::now() - m_exclusive_acquired_at);
+    m_exclusive_holder_site = nullptr;
+}
+#endif
+
 }
@@ -14,6 +14,7 @@
 #include <Kernel/Forward.h>
 #include <Kernel/Locking/LockLocation.h>
 #include <Kernel/Locking/LockMode.h>
+#include <Kernel/Locking/LockStatistics.h>
 #include <Kernel/Tasks/WaitQueue.h>
 
 namespace Kernel {
@@ -86,6 +87,11 @@ private:
     void block(Thread&, Mode, SpinlockLocker<Spinlock<LockRank::None>>&, u32);
     void unblock_waiters(Mode);
 
+#if LOCK_STATISTICS
+    void record_acquisition(Mode, LockLocation const&, u64 acquire_started_at, bool did_block);
+    void record_exclusive_release();
+#endif
+
     StringView m_name;
     Mode m_mode { Mode::Unlocked };
 
@@ -125,6 +131,13 @@ private:
 #if LOCK_SHARED_UPGRADE_DEBUG
     HashMap<uintptr_t, u32> m_shared_holders_map;
 #endif
+
+#if LOCK_STATISTICS
+    // The lock site that took the outermost exclusive lock, and when it did so.
+    // Only ever touched by the thread holding the lock exclusively.
+    LockSiteStatistics* m_exclusive_holder_site { nullptr };
+    u64 m_exclusive_acquired_at { 0 };
+#endif
 };
 
 class MutexLocker {
@@ -9,7 +9,9 @@
 #include <AK/Atomic.h>
 #include <AK/Types.h>
 #include <Kernel/Arch/Processor.h>
+#include <Kernel/Debug.h>
 #include <Kernel/Locking/LockRank.h>
+#include <Kernel/Locking/LockStatistics.h>
 
 namespace Kernel {
 
@@ -26,8 +28,14 @@ public:
         InterruptsState previous_interrupts_state = Processor::interrupts_state();
         Processor::enter_critical();
         Processor::disable_interrupts();
-        while (m_lock.exchange(1, AK::memory_order_acquire) != 0)
+        [[maybe_unused]] u32 spins = 0;
+        while (m_lock.exchange(1, AK::memory_order_acquire) != 0) {
             Processor::wait_check();
+            if constexpr (LOCK_STATISTICS)
+                ++spins;
+        }
+        if constexpr (LOCK_STATISTICS)
+            LockStatistics::record_spinlock_acquisition(m_rank, spins);
         track_lock_acquire(m_rank);
         return previous_interrupts_state;
     }
@@ -73,14 +81,20 @@ public:
         auto& proc = Processor::current();
         FlatPtr cpu = FlatPtr(&proc);
         FlatPtr expected = 0;
+        [[maybe_unused]] u32 spins = 0;
         while (!m_lock.compare_exchange_strong(expected, cpu, AK::memory_order_acq_rel)) {
             if (expected == cpu)
                 break;
             Processor::wait_check();
+            if constexpr (LOCK_STATISTICS)
+                ++spins;
             expected = 0;
         }
-        if (m_recursions == 0)
+        if (m_recursions == 0) {
+            if constexpr (LOCK_STATISTICS)
+                LockStatistics::record_spinlock_acquisition(m_rank, spins);
             track_lock_acquire(m_rank);
+        }
         m_recursions++;
         return previous_interrupts_state;
     }
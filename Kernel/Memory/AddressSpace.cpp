@@ -5,6 +5,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/ScopeGuard.h>
 #include <Kernel/API/MemoryLayout.h>
 #include <Kernel/Arch/CPU.h>
 #include <Kernel/Locking/Spinlock.h>
@@ -76,7 +77,8 @@ ErrorOr<void> AddressSpace::unmap_mmap_range(VirtualAddress addr, size_t size)
         // Remove the old region from our regions tree, since were going to add another region
         // with the exact same start address.
         auto region = take_region(*old_region);
-        region->unmap();
+        region->unmap(ShouldFlushTLB::No);
+        ScopeGuard flush_tlb_guard = [&] { flush_tlb(region->range()); };
 
         auto new_regions = TRY(try_split_region_around_range(*region, range_to_unmap));
 
@@ -84,7 +86,7 @@ ErrorOr<void> AddressSpace::unmap_mmap_range(VirtualAddress addr, size_t size)
         for (auto* new_region : new_regions) {
             // TODO: Ideally we should do this in a way that can be rolled back on failure, as failing here
             // leaves the caller in an undefined state.
-            TRY(new_region->map(page_directory()));
+            TRY(new_region->map(page_directory(), ShouldFlushTLB::No));
         }
 
         PerformanceManager::add_unmap_perf_event(Process::current(), range_to_unmap);
@@ -106,19 +108,30 @@ ErrorOr<void> AddressSpace::unmap_mmap_range(VirtualAddress addr, size_t size)
             return EPERM;
     }
 
+    // NOTE: Regions we remove entirely are kept alive until the TLB has been flushed,
+    //       as their physical pages must not be reused while stale entries may still point at them.
+    Vector<NonnullOwnPtr<Region>> regions_to_release;
+    TRY(regions_to_release.try_ensure_capacity(regions.size()));
+
+    // NOTE: Intersecting regions are returned in address order.
+    VirtualRange range_to_flush { regions.first()->vaddr(), regions.last()->range().end().get() - regions.first()->vaddr().get() };
+    ScopeGuard flush_tlb_guard = [&] { flush_tlb(range_to_flush); };
+
     Vector<Region*, 2> new_regions;
 
     for (auto* old_region : regions) {
         // If it's a full match we can remove the entire old region.
         if (old_region->range().intersect(range_to_unmap).size() == old_region->size()) {
-            deallocate_region(*old_region);
+            auto region = take_region(*old_region);
+            region->unmap(ShouldFlushTLB::No);
+            regions_to_release.unchecked_append(move(region));
             continue;
         }
 
         // Remove the old region from our regions tree, since were going to add another region
         // with the exact same start address.
         auto region = take_region(*old_region);
-        region->unmap();
+        region->unmap(ShouldFlushTLB::No);
 
         // Otherwise, split the regions and collect them for future mapping.
         auto split_regions = TRY(try_split_region_around_range(*region, range_to_unmap));
@@ -129,7 +142,7 @@ ErrorOr<void> AddressSpace::unmap_mmap_range(VirtualAddress addr, size_t size)
     for (auto* new_region : new_regions) {
         // TODO: Ideally we should do this in a way that can be rolled back on failure, as failing here
         // leaves the caller in an undefined state.
-        TRY(new_region->map(page_directory()));
+        TRY(new_region->map(page_directory(), ShouldFlushTLB::No));
     }
 
     PerformanceManager::add_unmap_perf_event(Process::current(), range_to_unmap);
@@ -137,6 +150,11 @@ ErrorOr<void> AddressSpace::unmap_mmap_range(VirtualAddress addr, size_t size)
     return {};
 }
 
+void AddressSpace::flush_tlb(VirtualRange const& range)
+{
+    MemoryManager::flush_tlb(m_page_directory, range.base(), range.size() / PAGE_SIZE);
+}
+
 ErrorOr<Region*> AddressSpace::try_allocate_split_region(Region const& source_region, VirtualRange const& range, size_t offset_in_vmobject)
 {
     OwnPtr<KString> region_name;
@@ -336,6 +354,44 @@ void AddressSpace::remove_all_regions(Badge<Process>)
     m_region_tree.delete_all_regions_assuming_they_are_unmapped();
 }
 
+ErrorOr<AddressSpace::MemoryStatistics> AddressSpace::memory_statistics() const
+{
+    MemoryStatistics statistics;
+    HashTable<LockRefPtr<InodeVMObject>> inode_vmobjects;
+    for (auto const& region : m_region_tree.regions()) {
+        auto amount_resident = region.amount_resident();
+        statistics.amount_virtual += region.size();
+        statistics.amount_resident += amount_resident;
+
+        // NOTE: amount_shared() looks at each page through a reference of its own, which makes every resident page count as shared.
+        //       Report the same thing here, until sharing is actually tracked.
+        statistics.amount_shared += amount_resident;
+
+        auto const& vmobject = region.vmobject();
+        if (vmobject.is_inode()) {
+            auto const& inode_vmobject = static_cast<InodeVMObject const&>(vmobject);
+            TRY(inode_vmobjects.try_set(&inode_vmobject));
+            if (!region.is_shared())
+                statistics.amount_dirty_private += inode_vmobject.amount_dirty();
+        } else if (!region.is_shared()) {
+            statistics.amount_dirty_private += amount_resident;
+        }
+
+        if (vmobject.is_anonymous()) {
+            auto const& anonymous_vmobject = static_cast<AnonymousVMObject const&>(vmobject);
+            if (anonymous_vmobject.is_purgeable()) {
+                if (anonymous_vmobject.is_volatile())
+                    statistics.amount_purgeable_volatile += amount_resident;
+                else
+                    statistics.amount_purgeable_nonvolatile += amount_resident;
+            }
+        }
+    }
+    for (auto& vmobject : inode_vmobjects)
+        statistics.amount_clean_inode += vmobject->amount_clean();
+    return statistics;
+}
+
 size_t AddressSpace::amount_dirty_private() const
 {
     // FIXME: This gets a bit more complicated for Regions sharing the same underlying VMObject.
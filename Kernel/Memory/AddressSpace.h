@@ -35,6 +35,10 @@ public:
 
     ErrorOr<void> unmap_mmap_range(VirtualAddress, size_t);
 
+    // Flushes the TLB for a range after regions in it were (un)mapped with ShouldFlushTLB::No,
+    // so that changes to many regions only cost a single shootdown.
+    void flush_tlb(VirtualRange const&);
+
     ErrorOr<Region*> allocate_region_with_vmobject(VirtualRange requested_range, NonnullLockRefPtr<VMObject>, size_t offset_in_vmobject, StringView name, int prot, bool shared);
     ErrorOr<Region*> allocate_region_with_vmobject(RandomizeVirtualAddress, VirtualAddress requested_address, size_t requested_size, size_t requested_alignment, NonnullLockRefPtr<VMObject>, size_t offset_in_vmobject, StringView name, int prot, bool shared);
     ErrorOr<Region*> allocate_region(RandomizeVirtualAddress, VirtualAddress requested_address, size_t requested_size, size_t requested_alignment, StringView name, int prot = PROT_READ | PROT_WRITE, AllocationStrategy strategy = AllocationStrategy::Reserve);
@@ -54,6 +58,19 @@ public:
 
     void remove_all_regions(Badge<Process>);
 
+    struct MemoryStatistics {
+        size_t amount_virtual { 0 };
+        size_t amount_resident { 0 };
+        size_t amount_dirty_private { 0 };
+        size_t amount_clean_inode { 0 };
+        size_t amount_shared { 0 };
+        size_t amount_purgeable_volatile { 0 };
+        size_t amount_purgeable_nonvolatile { 0 };
+    };
+
+    // Computes the same values as the amount_*() functions below, but in a single pass over the regions.
+    ErrorOr<MemoryStatistics> memory_statistics() const;
+
     ErrorOr<size_t> amount_clean_inode() const;
     size_t amount_dirty_private() const;
     size_t amount_virtual() const;
@@ -146,8 +146,18 @@ AnonymousVMObject::AnonymousVMObject(FixedArray<RefPtr<PhysicalRAMPage>>&& new_p
 {
     if (strategy == AllocationStrategy::AllocateNow) {
         // Allocate all pages right now. We know we can get all because we committed the amount needed
-        for (size_t i = 0; i < page_count(); ++i)
-            physical_pages()[i] = m_unused_committed_pages->take_one();
+        size_t i = 0;
+        while (i < page_count()) {
+            // Prefer naturally aligned runs of pages, so that regions mapping us can use huge pages.
+            if (i % pages_per_huge_page == 0 && i + pages_per_huge_page <= page_count()) {
+                if (auto huge_page_or_error = m_unused_committed_pages->take_huge_page(); !huge_page_or_error.is_error()) {
+                    for (auto& page : huge_page_or_error.value())
+                        physical_pages()[i++] = move(page);
+                    continue;
+                }
+            }
+            physical_pages()[i++] = m_unused_committed_pages->take_one();
+        }
     } else {
         auto& initial_page = (strategy == AllocationStrategy::Reserve) ? MM.lazy_committed_page() : MM.shared_zero_page();
         for (size_t i = 0; i < page_count(); ++i)
@@ -212,6 +222,54 @@ size_t AnonymousVMObject::purge()
     return total_pages_purged;
 }
 
+ErrorOr<size_t> AnonymousVMObject::discard_pages(size_t first_page_index, size_t page_count)
+{
+    VERIFY(first_page_index + page_count <= this->page_count());
+
+    SpinlockLocker lock(m_lock);
+
+    // Pages that aren't ours to free (e.g. device memory) keep their contents.
+    auto is_discardable = [](PhysicalRAMPage const& page) {
+        return !page.is_shared_zero_page() && !page.is_lazy_committed_page() && page.may_return_to_freelist();
+    };
+
+    size_t discardable_page_count = 0;
+    for (size_t i = first_page_index; i < first_page_index + page_count; ++i) {
+        if (is_discardable(*m_physical_pages[i]))
+            ++discardable_page_count;
+    }
+
+    if (discardable_page_count == 0)
+        return 0;
+
+    if (is_volatile()) {
+        // Volatile memory isn't committed, so it can simply go back to the shared zero page.
+        for (size_t i = first_page_index; i < first_page_index + page_count; ++i) {
+            if (is_discardable(*m_physical_pages[i]))
+                m_physical_pages[i] = MM.shared_zero_page();
+        }
+    } else {
+        // Commit the replacement pages before letting go of the old ones, so that touching a discarded page
+        // later on is still guaranteed to succeed.
+        auto committed_pages = TRY(MM.commit_physical_pages(discardable_page_count));
+        if (m_unused_committed_pages.has_value())
+            m_unused_committed_pages->absorb(move(committed_pages));
+        else
+            m_unused_committed_pages = move(committed_pages);
+
+        for (size_t i = first_page_index; i < first_page_index + page_count; ++i) {
+            if (!is_discardable(*m_physical_pages[i]))
+                continue;
+            m_physical_pages[i] = MM.lazy_committed_page();
+            if (!m_cow_map.is_null())
+                m_cow_map.set(i, false);
+        }
+    }
+
+    remap_regions();
+    return discardable_page_count;
+}
+
 ErrorOr<void> AnonymousVMObject::set_volatile(bool is_volatile, bool& was_purged)
 {
     VERIFY(is_purgeable());
@@ -274,6 +332,13 @@ NonnullRefPtr<PhysicalRAMPage> AnonymousVMObject::allocate_committed_page(Badge<
     return m_unused_committed_pages->take_one();
 }
 
+ErrorOr<Vector<NonnullRefPtr<PhysicalRAMPage>>> AnonymousVMObject::allocate_committed_huge_page(Badge<Region>)
+{
+    if (!m_unused_committed_pages.has_value() || m_unused_committed_pages->page_count() < pages_per_huge_page)
+        return ENOMEM;
+    return m_unused_committed_pages->take_huge_page();
+}
+
 ErrorOr<void> AnonymousVMObject::ensure_cow_map()
 {
     if (m_cow_map.is_null())
@@ -26,6 +26,7 @@ public:
     virtual ErrorOr<NonnullLockRefPtr<VMObject>> try_clone() override;
 
     [[nodiscard]] NonnullRefPtr<PhysicalRAMPage> allocate_committed_page(Badge<Region>);
+    ErrorOr<Vector<NonnullRefPtr<PhysicalRAMPage>>> allocate_committed_huge_page(Badge<Region>);
     PageFaultResponse handle_cow_fault(size_t, VirtualAddress);
     size_t cow_pages() const;
     bool should_cow(size_t page_index, bool) const;
@@ -38,6 +39,9 @@ public:
 
     size_t purge();
 
+    // Drops the contents of the given pages, so they read back as zeroes and their physical pages can be freed.
+    ErrorOr<size_t> discard_pages(size_t first_page_index, size_t page_count);
+
 private:
     class SharedCommittedCowPages;
 
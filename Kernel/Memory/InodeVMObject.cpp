@@ -79,4 +79,13 @@ u32 InodeVMObject::writable_mappings() const
     return count;
 }
 
+Optional<ReadaheadState::Range> InodeVMObject::did_fault_for_readahead(size_t page_index)
+{
+    if (!m_readahead_on_fault_enabled)
+        return {};
+    return m_readahead_state.with([&](auto& state) {
+        return state.did_read(static_cast<u64>(page_index) * PAGE_SIZE, PAGE_SIZE);
+    });
+}
+
 }
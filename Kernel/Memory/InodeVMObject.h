@@ -6,7 +6,10 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
 #include <AK/Bitmap.h>
+#include <Kernel/FileSystem/ReadaheadState.h>
+#include <Kernel/Locking/SpinlockProtected.h>
 #include <Kernel/Memory/VMObject.h>
 #include <Kernel/UnixTypes.h>
 
@@ -27,6 +30,9 @@ public:
 
     u32 writable_mappings() const;
 
+    Optional<ReadaheadState::Range> did_fault_for_readahead(size_t page_index);
+    void set_readahead_on_fault_enabled(bool enabled) { m_readahead_on_fault_enabled = enabled; }
+
 protected:
     explicit InodeVMObject(Inode&, FixedArray<RefPtr<PhysicalRAMPage>>&&, Bitmap dirty_pages);
     explicit InodeVMObject(InodeVMObject const&, FixedArray<RefPtr<PhysicalRAMPage>>&&, Bitmap dirty_pages);
@@ -39,6 +45,8 @@ protected:
 
     NonnullRefPtr<Inode> const m_inode;
     Bitmap m_dirty_pages;
+    SpinlockProtected<ReadaheadState, LockRank::None> m_readahead_state {};
+    Atomic<bool> m_readahead_on_fault_enabled { true };
 };
 
 }
@@ -847,6 +847,10 @@ PageTableEntry* MemoryManager::pte(PageDirectory& page_directory, VirtualAddress
     PageDirectoryEntry const& pde = pd[page_directory_index];
     if (!pde.is_present())
         return nullptr;
+#if ARCH(X86_64)
+    // NOTE: Huge mappings are only ever installed for user regions, which don't go through this lookup.
+    VERIFY(!pde.is_huge());
+#endif
 
     return &quickmap_pt(PhysicalAddress((FlatPtr)pde.page_table_base()))[page_table_index];
 }
@@ -861,6 +865,15 @@ PageTableEntry* MemoryManager::ensure_pte(PageDirectory& page_directory, Virtual
 
     auto* pd = quickmap_pd(page_directory, page_directory_table_index);
     auto& pde = pd[page_directory_index];
+#if ARCH(X86_64)
+    if (pde.is_present() && pde.is_huge()) {
+        // Someone wants to change a single page inside a huge mapping, so we have to break it up first.
+        if (!split_huge_page(page_directory, vaddr))
+            return nullptr;
+        pd = quickmap_pd(page_directory, page_directory_table_index);
+        VERIFY(&pde == &pd[page_directory_index]); // Sanity check
+    }
+#endif
     if (pde.is_present())
         return &quickmap_pt(PhysicalAddress(pde.page_table_base()))[page_table_index];
 
@@ -902,6 +915,15 @@ void MemoryManager::release_pte(PageDirectory& page_directory, VirtualAddress va
 
     auto* pd = quickmap_pd(page_directory, page_directory_table_index);
     PageDirectoryEntry& pde = pd[page_directory_index];
+#if ARCH(X86_64)
+    if (pde.is_present() && pde.is_huge()) {
+        // NOTE: Huge mappings only cover ranges that lie entirely within one region, and regions are
+        //       always unmapped as a whole, so the entire huge mapping goes away with the first PTE.
+        pde.clear();
+        --m_huge_pages_mapped;
+        return;
+    }
+#endif
     if (pde.is_present()) {
         auto* page_table = quickmap_pt(PhysicalAddress((FlatPtr)pde.page_table_base()));
         auto& pte = page_table[page_table_index];
@@ -925,6 +947,130 @@ void MemoryManager::release_pte(PageDirectory& page_directory, VirtualAddress va
     }
 }
 
+bool MemoryManager::map_huge_page(PageDirectory& page_directory, VirtualAddress vaddr, PhysicalAddress paddr, bool writable, bool executable)
+{
+#if ARCH(X86_64)
+    VERIFY_INTERRUPTS_DISABLED();
+    VERIFY(page_directory.get_lock().is_locked_by_current_processor());
+    VERIFY(&page_directory != m_kernel_page_directory.ptr());
+    VERIFY(vaddr.get() % huge_page_size == 0);
+    VERIFY(paddr.get() % huge_page_size == 0);
+    u32 page_directory_table_index = (vaddr.get() >> 30) & 0x1ff;
+    u32 page_directory_index = (vaddr.get() >> 21) & 0x1ff;
+
+    auto* pd = quickmap_pd(page_directory, page_directory_table_index);
+    auto& pde = pd[page_directory_index];
+
+    // NOTE: The caller owns the whole 2 MiB range, so any page table we replace here only holds its own entries.
+    Optional<PhysicalAddress> replaced_page_table;
+    if (pde.is_present() && !pde.is_huge())
+        replaced_page_table = PhysicalAddress { pde.page_table_base() };
+    bool was_huge = pde.is_present() && pde.is_huge();
+
+    pde.clear();
+    pde.set_page_table_base(paddr.get());
+    pde.set_huge(true);
+    pde.set_user_allowed(true);
+    pde.set_present(true);
+    pde.set_writable(writable);
+    if (Processor::current().has_nx())
+        pde.set_execute_disabled(!executable);
+
+    if (replaced_page_table.has_value()) {
+        // Make sure no processor can still walk the old page table before we give it back.
+        flush_tlb(&page_directory, vaddr, pages_per_huge_page);
+        get_physical_page_entry(replaced_page_table.value()).allocated.physical_page.unref();
+    } else {
+        flush_tlb(&page_directory, vaddr);
+    }
+
+    if (!was_huge)
+        ++m_huge_pages_mapped;
+    return true;
+#else
+    (void)page_directory;
+    (void)vaddr;
+    (void)paddr;
+    (void)writable;
+    (void)executable;
+    return false;
+#endif
+}
+
+bool MemoryManager::split_huge_page(PageDirectory& page_directory, VirtualAddress vaddr)
+{
+#if ARCH(X86_64)
+    VERIFY_INTERRUPTS_DISABLED();
+    VERIFY(page_directory.get_lock().is_locked_by_current_processor());
+    u32 page_directory_table_index = (vaddr.get() >> 30) & 0x1ff;
+    u32 page_directory_index = (vaddr.get() >> 21) & 0x1ff;
+
+    // NOTE: Every entry gets filled in below, so there's no need to zero the page table first.
+    auto page_table_or_error = allocate_physical_page(ShouldZeroFill::No);
+    if (page_table_or_error.is_error()) {
+        dbgln("MM: Unable to allocate page table to split huge page at {}", vaddr);
+        return false;
+    }
+    auto page_table = page_table_or_error.release_value();
+
+    // NOTE: allocate_physical_page may have purged memory and remapped things, so look up the entry afresh.
+    auto* pd = quickmap_pd(page_directory, page_directory_table_index);
+    auto& pde = pd[page_directory_index];
+    VERIFY(pde.is_present() && pde.is_huge());
+
+    auto huge_page_base = pde.page_table_base();
+    auto* ptes = quickmap_pt(page_table->paddr());
+    for (size_t i = 0; i < pages_per_huge_page; ++i) {
+        auto& pte = ptes[i];
+        pte.clear();
+        pte.set_physical_page_base(huge_page_base + i * PAGE_SIZE);
+        pte.set_present(true);
+        pte.set_writable(pde.is_writable());
+        pte.set_user_allowed(pde.is_user_allowed());
+        pte.set_cache_disabled(pde.is_cache_disabled());
+        if (Processor::current().has_nx())
+            pte.set_execute_disabled(pde.is_execute_disabled());
+    }
+
+    pde.clear();
+    pde.set_page_table_base(page_table->paddr().get());
+    pde.set_user_allowed(true);
+    pde.set_present(true);
+    pde.set_writable(true);
+
+    // NOTE: This leaked ref is matched by the unref in MemoryManager::release_pte()
+    (void)page_table.leak_ref();
+
+    flush_tlb(&page_directory, VirtualAddress { vaddr.get() & ~(huge_page_size - 1) });
+    --m_huge_pages_mapped;
+    ++m_huge_page_splits;
+    return true;
+#else
+    (void)page_directory;
+    (void)vaddr;
+    return false;
+#endif
+}
+
+MemoryManager::HugePageStatistics MemoryManager::huge_page_statistics() const
+{
+    return {
+        .mapped = m_huge_pages_mapped.load(AK::MemoryOrder::memory_order_relaxed),
+        .allocated = m_huge_pages_allocated.load(AK::MemoryOrder::memory_order_relaxed),
+        .allocation_failures = m_huge_page_allocation_failures.load(AK::MemoryOrder::memory_order_relaxed),
+        .splits = m_huge_page_splits.load(AK::MemoryOrder::memory_order_relaxed),
+    };
+}
+
+MemoryManager::ReclaimStatistics MemoryManager::reclaim_statistics() const
+{
+    return {
+        .pages_purged = m_pages_purged.load(AK::MemoryOrder::memory_order_relaxed),
+        .clean_pages_reclaimed = m_clean_pages_reclaimed.load(AK::MemoryOrder::memory_order_relaxed),
+        .allocation_failures = m_physical_allocation_failures.load(AK::MemoryOrder::memory_order_relaxed),
+    };
+}
+
 UNMAP_AFTER_INIT void MemoryManager::initialize(u32 cpu)
 {
     dmesgln("Initialize MMU");
@@ -1239,6 +1385,12 @@ RefPtr<PhysicalRAMPage> MemoryManager::find_free_physical_page(bool committed)
                 break;
             }
         }
+        if (page.is_null() && !global_data.zeroed_pages.is_empty()) {
+            // The only free pages left are the pre-zeroed ones.
+            page = global_data.zeroed_pages.take_last();
+            --global_data.system_memory_info.physical_pages_zeroed;
+            ++global_data.system_memory_info.physical_pages_used;
+        }
     });
 
     if (page.is_null())
@@ -1247,8 +1399,95 @@ RefPtr<PhysicalRAMPage> MemoryManager::find_free_physical_page(bool committed)
     return page;
 }
 
+RefPtr<PhysicalRAMPage> MemoryManager::take_zeroed_physical_page(bool committed)
+{
+    return m_global_data.with([&](auto& global_data) -> RefPtr<PhysicalRAMPage> {
+        if (global_data.zeroed_pages.is_empty())
+            return nullptr;
+        if (committed) {
+            VERIFY(global_data.system_memory_info.physical_pages_committed > 0);
+            global_data.system_memory_info.physical_pages_committed--;
+        } else {
+            if (global_data.system_memory_info.physical_pages_uncommitted == 0)
+                return nullptr;
+            global_data.system_memory_info.physical_pages_uncommitted--;
+        }
+        --global_data.system_memory_info.physical_pages_zeroed;
+        ++global_data.system_memory_info.physical_pages_used;
+        return global_data.zeroed_pages.take_last();
+    });
+}
+
+static void zero_page_non_temporal(u8* ptr)
+{
+#if ARCH(X86_64)
+    // NOTE: Nobody is going to read this page until it's handed out, so don't pull it into the cache now.
+    auto* qwords = reinterpret_cast<u64*>(ptr);
+    for (size_t i = 0; i < PAGE_SIZE / sizeof(u64); ++i)
+        asm volatile("movnti %1, %0"
+                     : "=m"(qwords[i])
+                     : "r"(0ul));
+    asm volatile("sfence" ::
+                     : "memory");
+#else
+    memset(ptr, 0, PAGE_SIZE);
+#endif
+}
+
+bool MemoryManager::zeroed_page_pool_needs_refill()
+{
+    return m_global_data.with([&](auto& global_data) {
+        return global_data.zeroed_pages.size() < zeroed_page_pool_low_watermark
+            && global_data.system_memory_info.physical_pages_uncommitted > zeroed_page_pool_reserve;
+    });
+}
+
+bool MemoryManager::zero_one_free_page()
+{
+    RefPtr<PhysicalRAMPage> page;
+    m_global_data.with([&](auto& global_data) {
+        if (global_data.zeroed_pages.size() >= zeroed_page_pool_high_watermark)
+            return;
+        if (global_data.system_memory_info.physical_pages_uncommitted <= zeroed_page_pool_reserve)
+            return;
+        for (auto& region : global_data.physical_regions) {
+            page = region->take_free_page();
+            if (!page.is_null())
+                break;
+        }
+        if (page.is_null())
+            return;
+        // NOTE: While we're zeroing it, the page is accounted as used so nobody expects to find it.
+        global_data.system_memory_info.physical_pages_uncommitted--;
+        ++global_data.system_memory_info.physical_pages_used;
+    });
+
+    if (page.is_null())
+        return false;
+
+    {
+        InterruptDisabler disabler;
+        auto* ptr = quickmap_page(*page);
+        zero_page_non_temporal(ptr);
+        unquickmap_page();
+    }
+
+    m_global_data.with([&](auto& global_data) {
+        global_data.zeroed_pages.unchecked_append(page.release_nonnull());
+        ++global_data.system_memory_info.physical_pages_zeroed;
+        --global_data.system_memory_info.physical_pages_used;
+        global_data.system_memory_info.physical_pages_uncommitted++;
+    });
+    return true;
+}
+
 NonnullRefPtr<PhysicalRAMPage> MemoryManager::allocate_committed_physical_page(Badge<CommittedPhysicalPageSet>, ShouldZeroFill should_zero_fill)
 {
+    if (should_zero_fill == ShouldZeroFill::Yes) {
+        if (auto page = take_zeroed_physical_page(true))
+            return page.release_nonnull();
+    }
+
     auto page = find_free_physical_page(true);
     VERIFY(page);
     if (should_zero_fill == ShouldZeroFill::Yes) {
@@ -1260,8 +1499,48 @@ NonnullRefPtr<PhysicalRAMPage> MemoryManager::allocate_committed_physical_page(B
     return page.release_nonnull();
 }
 
+ErrorOr<Vector<NonnullRefPtr<PhysicalRAMPage>>> MemoryManager::allocate_committed_huge_page(Badge<CommittedPhysicalPageSet>)
+{
+    auto physical_pages_or_error = m_global_data.with([&](auto& global_data) -> ErrorOr<Vector<NonnullRefPtr<PhysicalRAMPage>>> {
+        // Draw from the committed pages pool. We should always have these pages available,
+        // but they may be too fragmented to find a naturally aligned run of them.
+        VERIFY(global_data.system_memory_info.physical_pages_committed >= pages_per_huge_page);
+
+        for (auto& physical_region : global_data.physical_regions) {
+            auto physical_pages = physical_region->take_contiguous_free_pages(pages_per_huge_page);
+            if (!physical_pages.is_empty()) {
+                VERIFY(physical_pages.first()->paddr().get() % huge_page_size == 0);
+                global_data.system_memory_info.physical_pages_committed -= pages_per_huge_page;
+                global_data.system_memory_info.physical_pages_used += pages_per_huge_page;
+                return physical_pages;
+            }
+        }
+        return ENOMEM;
+    });
+
+    if (physical_pages_or_error.is_error()) {
+        ++m_huge_page_allocation_failures;
+        return physical_pages_or_error.release_error();
+    }
+
+    auto physical_pages = physical_pages_or_error.release_value();
+    for (auto& page : physical_pages) {
+        InterruptDisabler disabler;
+        auto* ptr = quickmap_page(*page);
+        memset(ptr, 0, PAGE_SIZE);
+        unquickmap_page();
+    }
+    ++m_huge_pages_allocated;
+    return physical_pages;
+}
+
 ErrorOr<NonnullRefPtr<PhysicalRAMPage>> MemoryManager::allocate_physical_page(ShouldZeroFill should_zero_fill, bool* did_purge)
 {
+    if (should_zero_fill == ShouldZeroFill::Yes) {
+        if (auto page = take_zeroed_physical_page(false))
+            return page.release_nonnull();
+    }
+
     return m_global_data.with([&](auto&) -> ErrorOr<NonnullRefPtr<PhysicalRAMPage>> {
         auto page = find_free_physical_page(false);
         bool purged_pages = false;
@@ -1277,6 +1556,7 @@ ErrorOr<NonnullRefPtr<PhysicalRAMPage>> MemoryManager::allocate_physical_page(Sh
                     return IterationDecision::Continue;
                 if (auto purged_page_count = anonymous_vmobject.purge()) {
                     dbgln("MM: Purge saved the day! Purged {} pages from AnonymousVMObject", purged_page_count);
+                    m_pages_purged += purged_page_count;
                     page = find_free_physical_page(false);
                     purged_pages = true;
                     VERIFY(page);
@@ -1286,22 +1566,28 @@ ErrorOr<NonnullRefPtr<PhysicalRAMPage>> MemoryManager::allocate_physical_page(Sh
             });
         }
         if (!page) {
-            // Second, we look for a file-backed VMObject with clean pages.
+            // Second, we look for file-backed VMObjects with clean pages. Release a whole batch of them at once,
+            // so the next allocations under the same pressure don't each have to walk all VMObjects again.
+            size_t released_page_count = 0;
             for_each_vmobject([&](auto& vmobject) {
                 if (!vmobject.is_inode())
                     return IterationDecision::Continue;
                 auto& inode_vmobject = static_cast<InodeVMObject&>(vmobject);
-                if (auto released_page_count = inode_vmobject.try_release_clean_pages(1)) {
-                    dbgln("MM: Clean inode release saved the day! Released {} pages from InodeVMObject", released_page_count);
-                    page = find_free_physical_page(false);
-                    VERIFY(page);
+                released_page_count += inode_vmobject.try_release_clean_pages(static_cast<int>(reclaim_batch_page_count - released_page_count));
+                if (released_page_count >= reclaim_batch_page_count)
                     return IterationDecision::Break;
-                }
                 return IterationDecision::Continue;
             });
+            if (released_page_count) {
+                dbgln("MM: Clean inode release saved the day! Released {} pages from InodeVMObjects", released_page_count);
+                m_clean_pages_reclaimed += released_page_count;
+                page = find_free_physical_page(false);
+                VERIFY(page);
+            }
         }
         if (!page) {
             dmesgln("MM: no physical pages available");
+            ++m_physical_allocation_failures;
             return ENOMEM;
         }
 
@@ -1502,6 +1788,14 @@ NonnullRefPtr<PhysicalRAMPage> CommittedPhysicalPageSet::take_one()
     return MM.allocate_committed_physical_page({}, MemoryManager::ShouldZeroFill::Yes);
 }
 
+ErrorOr<Vector<NonnullRefPtr<PhysicalRAMPage>>> CommittedPhysicalPageSet::take_huge_page()
+{
+    VERIFY(m_page_count >= pages_per_huge_page);
+    auto physical_pages = TRY(MM.allocate_committed_huge_page({}));
+    m_page_count -= pages_per_huge_page;
+    return physical_pages;
+}
+
 void CommittedPhysicalPageSet::uncommit_one()
 {
     VERIFY(m_page_count > 0);
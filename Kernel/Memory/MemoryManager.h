@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
 #include <AK/Badge.h>
 #include <AK/Concepts.h>
 #include <AK/HashTable.h>
@@ -34,6 +35,10 @@ constexpr FlatPtr page_round_down(FlatPtr x)
     return ((FlatPtr)(x)) & ~(PAGE_SIZE - 1);
 }
 
+// A single page directory entry maps this much memory when it points directly at a physical page.
+static constexpr size_t huge_page_size = 2 * MiB;
+static constexpr size_t pages_per_huge_page = huge_page_size / PAGE_SIZE;
+
 inline FlatPtr virtual_to_low_physical(FlatPtr virtual_)
 {
     return virtual_ - physical_to_virtual_offset;
@@ -114,8 +119,11 @@ public:
     size_t page_count() const { return m_page_count; }
 
     [[nodiscard]] NonnullRefPtr<PhysicalRAMPage> take_one();
+    ErrorOr<Vector<NonnullRefPtr<PhysicalRAMPage>>> take_huge_page();
     void uncommit_one();
 
+    void absorb(CommittedPhysicalPageSet&& other) { m_page_count += exchange(other.m_page_count, 0); }
+
     void operator=(CommittedPhysicalPageSet&&) = delete;
 
 private:
@@ -123,6 +131,7 @@ private:
 };
 
 class MemoryManager {
+    friend class AddressSpace;
     friend class PageDirectory;
     friend class AnonymousVMObject;
     friend class Region;
@@ -164,10 +173,16 @@ public:
     void uncommit_physical_pages(Badge<CommittedPhysicalPageSet>, size_t page_count);
 
     NonnullRefPtr<PhysicalRAMPage> allocate_committed_physical_page(Badge<CommittedPhysicalPageSet>, ShouldZeroFill = ShouldZeroFill::Yes);
+    ErrorOr<Vector<NonnullRefPtr<PhysicalRAMPage>>> allocate_committed_huge_page(Badge<CommittedPhysicalPageSet>);
     ErrorOr<NonnullRefPtr<PhysicalRAMPage>> allocate_physical_page(ShouldZeroFill = ShouldZeroFill::Yes, bool* did_purge = nullptr);
     ErrorOr<Vector<NonnullRefPtr<PhysicalRAMPage>>> allocate_contiguous_physical_pages(size_t size);
     void deallocate_physical_page(PhysicalAddress);
 
+    // Called by the page zeroing task to top up the pool of pre-zeroed pages.
+    // Returns false once the pool is full, or there's no memory to spare for it.
+    bool zero_one_free_page();
+    bool zeroed_page_pool_needs_refill();
+
     ErrorOr<NonnullOwnPtr<Region>> allocate_contiguous_kernel_region(size_t, StringView name, Region::Access access, Region::Cacheable = Region::Cacheable::Yes);
     ErrorOr<NonnullOwnPtr<Memory::Region>> allocate_dma_buffer_page(StringView name, Memory::Region::Access access, RefPtr<Memory::PhysicalRAMPage>& dma_buffer_page);
     ErrorOr<NonnullOwnPtr<Memory::Region>> allocate_dma_buffer_page(StringView name, Memory::Region::Access access);
@@ -185,10 +200,29 @@ public:
         PhysicalSize physical_pages_used { 0 };
         PhysicalSize physical_pages_committed { 0 };
         PhysicalSize physical_pages_uncommitted { 0 };
+        PhysicalSize physical_pages_zeroed { 0 };
     };
 
     SystemMemoryInfo get_system_memory_info();
 
+    struct HugePageStatistics {
+        u64 mapped { 0 };
+        u64 allocated { 0 };
+        u64 allocation_failures { 0 };
+        u64 splits { 0 };
+    };
+
+    HugePageStatistics huge_page_statistics() const;
+
+    // How often we had to take memory away from someone because no physical page was free.
+    struct ReclaimStatistics {
+        u64 pages_purged { 0 };
+        u64 clean_pages_reclaimed { 0 };
+        u64 allocation_failures { 0 };
+    };
+
+    ReclaimStatistics reclaim_statistics() const;
+
     template<IteratorFunction<VMObject&> Callback>
     static void for_each_vmobject(Callback callback)
     {
@@ -241,12 +275,23 @@ private:
     MemoryManager();
     ~MemoryManager();
 
+    // Free pages that have already been zeroed in the background.
+    // NOTE: Pages in this pool are still accounted as free, they just don't live in a PhysicalZone.
+    static constexpr size_t zeroed_page_pool_low_watermark = 128;
+    static constexpr size_t zeroed_page_pool_high_watermark = 512;
+    // Don't take pages for the pool if that would leave fewer than this many uncommitted pages.
+    static constexpr size_t zeroed_page_pool_reserve = 1024;
+
+    // How many clean file-backed pages we try to release at once when we run out of physical pages.
+    static constexpr size_t reclaim_batch_page_count = 32;
+
     struct GlobalData {
         GlobalData();
 
         SystemMemoryInfo system_memory_info;
 
         Vector<NonnullOwnPtr<PhysicalRegion>> physical_regions;
+        Vector<NonnullRefPtr<PhysicalRAMPage>, zeroed_page_pool_high_watermark> zeroed_pages;
         OwnPtr<PhysicalRegion> physical_pages_region;
 
         RegionTree region_tree;
@@ -273,6 +318,7 @@ private:
     static void flush_tlb(PageDirectory const*, VirtualAddress, size_t page_count = 1);
 
     RefPtr<PhysicalRAMPage> find_free_physical_page(bool);
+    RefPtr<PhysicalRAMPage> take_zeroed_physical_page(bool committed);
 
     ALWAYS_INLINE u8* quickmap_page(PhysicalRAMPage& page)
     {
@@ -292,6 +338,9 @@ private:
     };
     void release_pte(PageDirectory&, VirtualAddress, IsLastPTERelease);
 
+    bool map_huge_page(PageDirectory&, VirtualAddress, PhysicalAddress, bool writable, bool executable);
+    bool split_huge_page(PageDirectory&, VirtualAddress);
+
     // NOTE: These are outside of GlobalData as they are only assigned on startup,
     //       and then never change. Atomic ref-counting covers that case without
     //       the need for additional synchronization.
@@ -304,6 +353,15 @@ private:
     PhysicalPageEntry* m_physical_page_entries { nullptr };
     size_t m_physical_page_entries_count { 0 };
 
+    Atomic<u64> m_huge_pages_mapped { 0 };
+    Atomic<u64> m_huge_pages_allocated { 0 };
+    Atomic<u64> m_huge_page_allocation_failures { 0 };
+    Atomic<u64> m_huge_page_splits { 0 };
+
+    Atomic<u64> m_pages_purged { 0 };
+    Atomic<u64> m_clean_pages_reclaimed { 0 };
+    Atomic<u64> m_physical_allocation_failures { 0 };
+
     SpinlockProtected<GlobalData, LockRank::None> m_global_data;
 };
 
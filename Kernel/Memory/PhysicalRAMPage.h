@@ -43,6 +43,8 @@ public:
     bool is_shared_zero_page() const;
     bool is_lazy_committed_page() const;
 
+    bool may_return_to_freelist() const { return m_may_return_to_freelist == MayReturnToFreeList::Yes; }
+
 private:
     explicit PhysicalRAMPage(MayReturnToFreeList may_return_to_freelist);
     ~PhysicalRAMPage() = default;
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/BinarySearch.h>
 #include <AK/BuiltinWrappers.h>
 #include <Kernel/Library/Assertions.h>
 #include <Kernel/Memory/MemoryManager.h>
@@ -55,8 +56,26 @@ void PhysicalRegion::initialize_zones()
         return zone_count;
     };
 
-    // First make 16 MiB zones (with 4096 pages each)
-    m_large_zones = make_zones(large_zone_size);
+    // Carve any space in front of the first 2 MiB boundary into naturally aligned zones,
+    // so that buddy blocks of 2 MiB taken from the large zones are physically aligned
+    // and can be mapped as huge pages.
+    size_t alignment_zone_count = 0;
+    auto first_alignment_address = base_address;
+    while (remaining_pages > 0 && (base_address.get() % huge_page_size) != 0) {
+        size_t pages_per_zone = 1ul << count_trailing_zeroes(base_address.get() / PAGE_SIZE);
+        pages_per_zone = min(pages_per_zone, remaining_pages);
+        pages_per_zone = 1ul << (sizeof(size_t) * 8 - 1 - count_leading_zeroes(pages_per_zone));
+        m_zones.append(adopt_nonnull_own_or_enomem(new (nothrow) PhysicalZone(base_address, pages_per_zone)).release_value_but_fixme_should_propagate_errors());
+        base_address = base_address.offset(pages_per_zone * PAGE_SIZE);
+        m_usable_zones.append(*m_zones.last());
+        remaining_pages -= pages_per_zone;
+        ++alignment_zone_count;
+    }
+    if (alignment_zone_count)
+        dmesgln(" * {}x PhysicalZone (alignment) @ {:016x}-{:016x}", alignment_zone_count, first_alignment_address.get(), base_address.get() - 1);
+
+    // Then make 16 MiB zones (with 4096 pages each)
+    make_zones(large_zone_size);
 
     // Then divide any remaining space into 1 MiB zones (with 256 pages each)
     make_zones(small_zone_size);
@@ -121,16 +140,17 @@ RefPtr<PhysicalRAMPage> PhysicalRegion::take_free_page()
 
 void PhysicalRegion::return_page(PhysicalAddress paddr)
 {
-    auto large_zone_base = lower().get();
-    auto small_zone_base = lower().get() + (m_large_zones * large_zone_size);
-
-    size_t zone_index;
-    if (paddr.get() < small_zone_base)
-        zone_index = (paddr.get() - large_zone_base) / large_zone_size;
-    else
-        zone_index = m_large_zones + (paddr.get() - small_zone_base) / small_zone_size;
-
-    auto& zone = m_zones[zone_index];
+    // NOTE: Zones are created in ascending address order, but they are not all the same size.
+    auto* zone_ptr = binary_search(m_zones, paddr, nullptr, [](PhysicalAddress needle, NonnullOwnPtr<PhysicalZone> const& zone) -> int {
+        if (needle < zone->base())
+            return -1;
+        if (zone->contains(needle))
+            return 0;
+        return 1;
+    });
+    VERIFY(zone_ptr);
+
+    auto& zone = *zone_ptr;
     VERIFY(zone->contains(paddr));
     zone->deallocate_block(paddr, 0);
     if (m_full_zones.contains(*zone))
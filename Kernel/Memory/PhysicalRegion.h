@@ -46,8 +46,6 @@ private:
 
     Vector<NonnullOwnPtr<PhysicalZone>> m_zones;
 
-    size_t m_large_zones { 0 };
-
     PhysicalZone::List m_usable_zones;
     PhysicalZone::List m_full_zones;
 
@@ -171,9 +171,11 @@ size_t Region::amount_dirty() const
 
 size_t Region::amount_resident() const
 {
+    // NOTE: This is called for every region of every process whenever someone looks at the process list,
+    //       so we look at the pages directly instead of locking the VMObject and taking a reference for each of them.
+    SpinlockLocker vmobject_locker(vmobject().m_lock);
     size_t bytes = 0;
-    for (size_t i = 0; i < page_count(); ++i) {
-        auto page = physical_page(i);
+    for (auto const& page : vmobject().physical_pages().slice(first_page_index(), page_count())) {
         if (page && !page->is_shared_zero_page() && !page->is_lazy_committed_page())
             bytes += PAGE_SIZE;
     }
@@ -252,10 +254,58 @@ bool Region::map_individual_page_impl(size_t page_index, PhysicalAddress paddr,
     if (Processor::current().has_pat())
         pte->set_pat(is_write_combine());
     pte->set_user_allowed(user_allowed);
+#if ARCH(X86_64)
+    // NOTE: Kernel mappings are the same in every address space, so don't tie them to a PCID.
+    pte->set_global(!is_user_address(page_vaddr));
+#endif
 
     return true;
 }
 
+bool Region::can_use_huge_pages() const
+{
+#if ARCH(X86_64)
+    if (!is_user() || is_shared() || !is_cacheable() || is_write_combine() || !is_readable())
+        return false;
+    if (!vmobject().is_anonymous())
+        return false;
+    return !static_cast<AnonymousVMObject const&>(vmobject()).is_purgeable();
+#else
+    return false;
+#endif
+}
+
+bool Region::map_huge_page_impl(size_t page_index)
+{
+    VERIFY(m_page_directory->get_lock().is_locked_by_current_processor());
+
+    auto page_vaddr = vaddr_from_page_index(page_index);
+    if (page_vaddr.get() % huge_page_size != 0 || page_index + pages_per_huge_page > page_count())
+        return false;
+    if (!can_use_huge_pages())
+        return false;
+
+    SpinlockLocker vmobject_locker(vmobject().m_lock);
+    auto first_page = physical_page(page_index);
+    if (!first_page || first_page->is_shared_zero_page() || first_page->is_lazy_committed_page())
+        return false;
+    auto first_paddr = first_page->paddr();
+    if (first_paddr.get() % huge_page_size != 0)
+        return false;
+
+    // NOTE: A huge mapping has a single set of permissions, so either all or none of its pages may be CoW.
+    bool cow = should_cow(page_index);
+    for (size_t i = 1; i < pages_per_huge_page; ++i) {
+        auto page = physical_page(page_index + i);
+        if (!page || page->paddr() != first_paddr.offset(i * PAGE_SIZE))
+            return false;
+        if (should_cow(page_index + i) != cow)
+            return false;
+    }
+
+    return MM.map_huge_page(*m_page_directory, page_vaddr, first_paddr, is_writable() && !cow, is_executable());
+}
+
 bool Region::map_individual_page_impl(size_t page_index)
 {
     RefPtr<PhysicalRAMPage> page;
@@ -302,6 +352,12 @@ void Region::unmap_with_locks_held(ShouldFlushTLB should_flush_tlb, SpinlockLock
     m_page_directory = nullptr;
 }
 
+bool Region::can_be_mapped_lazily() const
+{
+    // NOTE: Only these know how to bring in a page on a not-present fault, everything else has to be mapped up front.
+    return vmobject().is_anonymous() || vmobject().is_inode();
+}
+
 void Region::set_page_directory(PageDirectory& page_directory)
 {
     VERIFY(!m_page_directory || m_page_directory == &page_directory);
@@ -320,6 +376,10 @@ ErrorOr<void> Region::map(PageDirectory& page_directory, ShouldFlushTLB should_f
     set_page_directory(page_directory);
     size_t page_index = 0;
     while (page_index < page_count()) {
+        if (map_huge_page_impl(page_index)) {
+            page_index += pages_per_huge_page;
+            continue;
+        }
         if (!map_individual_page_impl(page_index))
             break;
         ++page_index;
@@ -353,14 +413,14 @@ ErrorOr<void> Region::map(PageDirectory& page_directory, PhysicalAddress paddr,
     return ENOMEM;
 }
 
-void Region::remap()
+void Region::remap(ShouldFlushTLB should_flush_tlb)
 {
     VERIFY(m_page_directory);
     ErrorOr<void> result;
     if (m_vmobject->is_mmio())
-        result = map(*m_page_directory, static_cast<MMIOVMObject const&>(*m_vmobject).base_address());
+        result = map(*m_page_directory, static_cast<MMIOVMObject const&>(*m_vmobject).base_address(), should_flush_tlb);
     else
-        result = map(*m_page_directory);
+        result = map(*m_page_directory, should_flush_tlb);
     if (result.is_error())
         TODO();
 }
@@ -407,10 +467,21 @@ PageFaultResponse Region::handle_fault(PageFault const& fault)
             dbgln_if(PAGE_FAULT_DEBUG, "NP(inode) fault in Region({})[{}]", this, page_index_in_region);
             return handle_inode_fault(page_index_in_region);
         }
+        if (fault.is_write() && should_cow(page_index_in_region)) {
+            // NOTE: The page tables of a forked child are filled in lazily, so the first write to a CoW page
+            //       shows up as a not-present fault instead of a protection violation.
+            dbgln_if(PAGE_FAULT_DEBUG, "NP(cow) fault in Region({})[{}] at {}", this, page_index_in_region, fault.vaddr());
+            auto phys_page = physical_page(page_index_in_region);
+            if (phys_page->is_shared_zero_page() || phys_page->is_lazy_committed_page())
+                return handle_zero_fault(page_index_in_region, *phys_page);
+            return handle_cow_fault(page_index_in_region);
+        }
 
         SpinlockLocker vmobject_locker(vmobject().m_lock);
         auto& page_slot = physical_page_slot(page_index_in_region);
         if (page_slot->is_lazy_committed_page()) {
+            if (auto response = try_handle_huge_zero_fault(page_index_in_region); response.has_value())
+                return response.release_value();
             auto page_index_in_vmobject = translate_to_vmobject_page(page_index_in_region);
             VERIFY(m_vmobject->is_anonymous());
             page_slot = static_cast<AnonymousVMObject&>(*m_vmobject).allocate_committed_page({});
@@ -418,6 +489,13 @@ PageFaultResponse Region::handle_fault(PageFault const& fault)
                 return PageFaultResponse::OutOfMemory;
             return PageFaultResponse::Continue;
         }
+        if (page_slot) {
+            // NOTE: The page is resident, it just hasn't been mapped into this page directory yet (see sys$fork).
+            dbgln_if(PAGE_FAULT_DEBUG, "NP(resident) fault in Region({})[{}] at {}", this, page_index_in_region, fault.vaddr());
+            if (!remap_vmobject_page(translate_to_vmobject_page(page_index_in_region), *page_slot))
+                return PageFaultResponse::OutOfMemory;
+            return PageFaultResponse::Continue;
+        }
         dbgln("BUG! Unexpected NP fault at {}", fault.vaddr());
         dbgln("     - Physical page slot pointer: {:p}", page_slot.ptr());
         if (page_slot) {
@@ -487,6 +565,14 @@ PageFaultResponse Region::handle_fault(PageFault const& fault)
         return PageFaultResponse::Continue;
     }
 
+    if (page_slot) {
+        // NOTE: The page is resident, it just hasn't been mapped into this page directory yet (see sys$fork).
+        dbgln_if(PAGE_FAULT_DEBUG, "Resident page fault in Region({})[{}] at {}", this, page_index_in_region, fault.vaddr());
+        if (!remap_vmobject_page(translate_to_vmobject_page(page_index_in_region), *page_slot))
+            return PageFaultResponse::OutOfMemory;
+        return PageFaultResponse::Continue;
+    }
+
     dbgln("Unexpected page fault in Region({})[{}] at {}", this, page_index_in_region, fault.vaddr());
     return PageFaultResponse::ShouldCrash;
 #endif
@@ -502,6 +588,11 @@ PageFaultResponse Region::handle_zero_fault(size_t page_index_in_region, Physica
     if (current_thread != nullptr)
         current_thread->did_zero_fault();
 
+    if (page_in_slot_at_time_of_fault.is_lazy_committed_page()) {
+        if (auto response = try_handle_huge_zero_fault(page_index_in_region); response.has_value())
+            return response.release_value();
+    }
+
     RefPtr<PhysicalRAMPage> new_physical_page;
 
     if (page_in_slot_at_time_of_fault.is_lazy_committed_page()) {
@@ -539,6 +630,57 @@ PageFaultResponse Region::handle_zero_fault(size_t page_index_in_region, Physica
     return PageFaultResponse::Continue;
 }
 
+Optional<PageFaultResponse> Region::try_handle_huge_zero_fault(size_t page_index_in_region)
+{
+    if (!can_use_huge_pages())
+        return {};
+
+    auto huge_page_vaddr = VirtualAddress { vaddr_from_page_index(page_index_in_region).get() & ~(huge_page_size - 1) };
+    if (!range().contains(huge_page_vaddr, huge_page_size))
+        return {};
+    auto first_page_index = page_index_from_address(huge_page_vaddr);
+
+    {
+        SpinlockLocker locker(vmobject().m_lock);
+
+        // Only take over the range if nobody has touched any of it yet, otherwise we'd have to copy.
+        for (size_t i = 0; i < pages_per_huge_page; ++i) {
+            auto& page_slot = physical_page_slot(first_page_index + i);
+            if (!page_slot || !page_slot->is_lazy_committed_page())
+                return {};
+        }
+
+        auto physical_pages_or_error = static_cast<AnonymousVMObject&>(*m_vmobject).allocate_committed_huge_page({});
+        if (physical_pages_or_error.is_error()) {
+            dbgln_if(PAGE_FAULT_DEBUG, "      >> Unable to allocate huge page for {}, falling back to a single page", huge_page_vaddr);
+            return {};
+        }
+
+        auto physical_pages = physical_pages_or_error.release_value();
+        for (size_t i = 0; i < pages_per_huge_page; ++i)
+            physical_page_slot(first_page_index + i) = move(physical_pages[i]);
+        dbgln_if(PAGE_FAULT_DEBUG, "      >> ALLOCATED COMMITTED HUGE {}", physical_page(first_page_index)->paddr());
+    }
+
+    auto current_thread = Thread::current();
+    if (current_thread != nullptr)
+        current_thread->did_zero_fault();
+
+    SpinlockLocker page_lock(m_page_directory->get_lock());
+    if (map_huge_page_impl(first_page_index))
+        return PageFaultResponse::Continue;
+
+    // NOTE: We've already replaced every lazy committed page in this range, so all of them need remapping.
+    for (size_t i = 0; i < pages_per_huge_page; ++i) {
+        if (!map_individual_page_impl(first_page_index + i)) {
+            dmesgln("MM: handle_zero_fault was unable to allocate a page table to map {}", huge_page_vaddr);
+            return PageFaultResponse::OutOfMemory;
+        }
+    }
+    MemoryManager::flush_tlb(m_page_directory, huge_page_vaddr, pages_per_huge_page);
+    return PageFaultResponse::Continue;
+}
+
 PageFaultResponse Region::handle_cow_fault(size_t page_index_in_region)
 {
     auto current_thread = Thread::current();
@@ -602,6 +744,8 @@ PageFaultResponse Region::handle_inode_fault(size_t page_index_in_region)
     if (nread < PAGE_SIZE) {
         // If we read less than a page, zero out the rest to avoid leaking uninitialized data.
         memset(page_buffer + nread, 0, PAGE_SIZE - nread);
+    } else if (auto readahead = inode_vmobject.did_fault_for_readahead(page_index_in_vmobject); readahead.has_value()) {
+        inode.schedule_readahead(readahead->offset, readahead->length);
     }
 
     // Allocate a new physical page, and copy the read inode contents into it.
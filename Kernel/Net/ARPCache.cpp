@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashFunctions.h>
+#include <Kernel/Arch/Processor.h>
+#include <Kernel/Net/ARPCache.h>
+
+namespace Kernel {
+
+size_t ARPCache::home_slot(u32 address)
+{
+    return int_hash(address) % capacity;
+}
+
+u64 ARPCache::pack_mac_address(MACAddress const& mac_address)
+{
+    u64 packed = 0;
+    for (size_t i = 0; i < 6; ++i)
+        packed |= static_cast<u64>(mac_address[i]) << (i * 8);
+    return packed;
+}
+
+MACAddress ARPCache::unpack_mac_address(u64 packed)
+{
+    MACAddress mac_address;
+    for (size_t i = 0; i < 6; ++i)
+        mac_address[i] = (packed >> (i * 8)) & 0xff;
+    return mac_address;
+}
+
+Optional<size_t> ARPCache::find_slot(u32 address) const
+{
+    size_t slot = home_slot(address);
+    for (size_t i = 0; i < capacity; ++i) {
+        u32 slot_address = m_entries[slot].ipv4_address.load(AK::MemoryOrder::memory_order_relaxed);
+        if (slot_address == address)
+            return slot;
+        if (slot_address == 0)
+            return {};
+        slot = (slot + 1) % capacity;
+    }
+    return {};
+}
+
+Optional<MACAddress> ARPCache::get(IPv4Address const& ipv4_address) const
+{
+    u32 address = ipv4_address.to_u32();
+    if (address == 0)
+        return {};
+
+    for (;;) {
+        u32 sequence = m_sequence.load(AK::MemoryOrder::memory_order_acquire);
+        if (sequence & 1) {
+            // Someone is changing the cache right now.
+            Processor::wait_check();
+            continue;
+        }
+
+        Optional<u64> mac_address;
+        if (auto slot = find_slot(address); slot.has_value())
+            mac_address = m_entries[*slot].mac_address.load(AK::MemoryOrder::memory_order_relaxed);
+
+        AK::atomic_thread_fence(AK::MemoryOrder::memory_order_acquire);
+        if (m_sequence.load(AK::MemoryOrder::memory_order_relaxed) != sequence)
+            continue;
+
+        if (!mac_address.has_value())
+            return {};
+        return unpack_mac_address(*mac_address);
+    }
+}
+
+void ARPCache::begin_change()
+{
+    VERIFY(m_lock.is_locked());
+    m_sequence.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+    AK::atomic_thread_fence(AK::MemoryOrder::memory_order_release);
+}
+
+void ARPCache::end_change()
+{
+    m_sequence.fetch_add(1, AK::MemoryOrder::memory_order_release);
+}
+
+bool ARPCache::set(IPv4Address const& ipv4_address, MACAddress const& mac_address)
+{
+    u32 address = ipv4_address.to_u32();
+    if (address == 0)
+        return false;
+
+    // NOTE: We're told about the sender of every packet we receive, so don't make readers retry for nothing.
+    if (get(ipv4_address) == mac_address)
+        return false;
+
+    SpinlockLocker locker(m_lock);
+    begin_change();
+    if (auto slot = find_slot(address); slot.has_value()) {
+        m_entries[*slot].mac_address.store(pack_mac_address(mac_address), AK::MemoryOrder::memory_order_relaxed);
+        end_change();
+        return true;
+    }
+
+    size_t slot = home_slot(address);
+    bool home_slot_is_used = m_entries[slot].ipv4_address.load(AK::MemoryOrder::memory_order_relaxed) != 0;
+    if (m_size < maximum_size || !home_slot_is_used) {
+        while (m_entries[slot].ipv4_address.load(AK::MemoryOrder::memory_order_relaxed) != 0)
+            slot = (slot + 1) % capacity;
+        ++m_size;
+    }
+    // NOTE: If the cache is full, this replaces whatever lives in our home slot. That keeps all probe
+    //       sequences intact, since the slot doesn't become empty.
+    m_entries[slot].ipv4_address.store(address, AK::MemoryOrder::memory_order_relaxed);
+    m_entries[slot].mac_address.store(pack_mac_address(mac_address), AK::MemoryOrder::memory_order_relaxed);
+    end_change();
+    return true;
+}
+
+void ARPCache::remove(IPv4Address const& ipv4_address)
+{
+    SpinlockLocker locker(m_lock);
+    auto found_slot = find_slot(ipv4_address.to_u32());
+    if (!found_slot.has_value())
+        return;
+
+    begin_change();
+    // Move the following entries back into the hole where their probe sequence would otherwise end early,
+    // so that we don't need tombstones.
+    size_t hole = *found_slot;
+    size_t slot = hole;
+    for (;;) {
+        slot = (slot + 1) % capacity;
+        u32 address = m_entries[slot].ipv4_address.load(AK::MemoryOrder::memory_order_relaxed);
+        if (address == 0)
+            break;
+        size_t home = home_slot(address);
+        bool home_is_after_hole = hole <= slot ? (hole < home && home <= slot) : (hole < home || home <= slot);
+        if (home_is_after_hole)
+            continue;
+        m_entries[hole].ipv4_address.store(address, AK::MemoryOrder::memory_order_relaxed);
+        m_entries[hole].mac_address.store(m_entries[slot].mac_address.load(AK::MemoryOrder::memory_order_relaxed), AK::MemoryOrder::memory_order_relaxed);
+        hole = slot;
+    }
+    m_entries[hole].ipv4_address.store(0, AK::MemoryOrder::memory_order_relaxed);
+    m_entries[hole].mac_address.store(0, AK::MemoryOrder::memory_order_relaxed);
+    --m_size;
+    end_change();
+}
+
+size_t ARPCache::size() const
+{
+    SpinlockLocker locker(m_lock);
+    return m_size;
+}
+
+}
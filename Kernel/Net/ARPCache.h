@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/Atomic.h>
+#include <AK/Error.h>
+#include <AK/IPv4Address.h>
+#include <AK/MACAddress.h>
+#include <AK/Optional.h>
+#include <Kernel/Locking/Spinlock.h>
+
+namespace Kernel {
+
+// The MAC addresses we learned for IPv4 addresses through ARP.
+// NOTE: Every packet we send looks up its next hop here, but entries rarely change. So lookups don't take a lock,
+//       like with a seqlock they just look again if the cache was changed while they were looking.
+//       Changes are serialized with a spinlock. The entries live in a fixed size open addressing table,
+//       so that a lookup racing with a change never follows a pointer to memory that has been freed.
+class ARPCache {
+public:
+    static constexpr size_t capacity = 512;
+
+    Optional<MACAddress> get(IPv4Address const&) const;
+    // Returns whether the entry was new or changed, which most of the time it isn't.
+    bool set(IPv4Address const&, MACAddress const&);
+    void remove(IPv4Address const&);
+
+    size_t size() const;
+
+    template<typename Callback>
+    ErrorOr<void> try_for_each(Callback callback) const
+    {
+        SpinlockLocker locker(m_lock);
+        for (auto const& entry : m_entries) {
+            u32 address = entry.ipv4_address.load(AK::MemoryOrder::memory_order_relaxed);
+            if (address == 0)
+                continue;
+            TRY(callback(IPv4Address(NetworkOrdered<u32>(address)), unpack_mac_address(entry.mac_address.load(AK::MemoryOrder::memory_order_relaxed))));
+        }
+        return {};
+    }
+
+private:
+    // Once the cache is this full, new entries push out old ones instead of making lookups slower.
+    static constexpr size_t maximum_size = capacity * 3 / 4;
+
+    struct Entry {
+        // NOTE: 0.0.0.0 is never resolved, so it marks unused entries.
+        Atomic<u32> ipv4_address { 0 };
+        Atomic<u64> mac_address { 0 };
+    };
+
+    static size_t home_slot(u32 address);
+    static u64 pack_mac_address(MACAddress const&);
+    static MACAddress unpack_mac_address(u64);
+
+    Optional<size_t> find_slot(u32 address) const;
+    void begin_change();
+    void end_change();
+
+    mutable Spinlock<LockRank::None> m_lock {};
+    Atomic<u32> m_sequence { 0 };
+    Array<Entry, capacity> m_entries;
+    size_t m_size { 0 };
+};
+
+}
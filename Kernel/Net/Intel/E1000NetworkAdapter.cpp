@@ -121,6 +121,8 @@ namespace Kernel {
 #define INTERRUPT_TXD_LOW (1 << 15)
 #define INTERRUPT_SRPD (1 << 16)
 
+static constexpr u32 receive_interrupts = INTERRUPT_RXT0 | INTERRUPT_RXO;
+
 // https://www.intel.com/content/dam/doc/manual/pci-pci-x-family-gbe-controllers-software-dev-manual.pdf Section 5.2
 UNMAP_AFTER_INIT static bool is_valid_device_id(u16 device_id)
 {
@@ -219,8 +221,9 @@ UNMAP_AFTER_INIT void E1000NetworkAdapter::setup_link()
 
 UNMAP_AFTER_INIT void E1000NetworkAdapter::setup_interrupts()
 {
-    out32(REG_INTERRUPT_RATE, 6000); // Interrupt rate of 1.536 milliseconds
-    out32(REG_INTERRUPT_MASK_SET, INTERRUPT_LSC | INTERRUPT_RXT0 | INTERRUPT_RXO);
+    out32(REG_INTERRUPT_RATE, interrupt_throttling_interval(m_latency_class));
+    // NOTE: We need TXDW even though we don't do anything with it in the IRQ handler, send_raw() waits for it.
+    out32(REG_INTERRUPT_MASK_SET, INTERRUPT_LSC | INTERRUPT_TXDW | receive_interrupts);
     in32(REG_INTERRUPT_CAUSE_READ);
     enable_irq();
 }
@@ -264,8 +267,9 @@ bool E1000NetworkAdapter::handle_irq(RegisterState const&)
     if (status & INTERRUPT_RXO) {
         dbgln_if(E1000_DEBUG, "E1000: RX buffer overrun");
     }
-    if (status & INTERRUPT_RXT0) {
-        receive();
+    if (status & receive_interrupts) {
+        // NOTE: The network task picks up the packets, see poll_receive().
+        schedule_receive_poll();
     }
 
     m_wait_queue.wake_all();
@@ -428,13 +432,47 @@ void E1000NetworkAdapter::send_raw(ReadonlyBytes payload)
     dbgln_if(E1000_DEBUG, "E1000: Sent packet, status is now {:#02x}!", (u8)descriptor.status);
 }
 
-void E1000NetworkAdapter::receive()
+void E1000NetworkAdapter::schedule_receive_poll()
 {
-    auto* rx_descriptors = (e1000_tx_desc*)m_rx_descriptors_region->vaddr().as_ptr();
-    u32 rx_current;
-    for (;;) {
-        rx_current = in32(REG_RXDESCTAIL) % number_of_rx_descriptors;
-        rx_current = (rx_current + 1) % number_of_rx_descriptors;
+    if (m_receive_polling.exchange(true))
+        return;
+    out32(REG_INTERRUPT_MASK_CLEAR, receive_interrupts);
+    request_receive_poll();
+}
+
+size_t E1000NetworkAdapter::poll_receive(size_t budget)
+{
+    size_t bytes_received = 0;
+    size_t packets_received = receive(budget, bytes_received);
+    m_packets_since_interrupt += packets_received;
+    m_bytes_since_interrupt += bytes_received;
+    if (packets_received == budget)
+        return packets_received;
+
+    update_interrupt_throttling(m_packets_since_interrupt, m_bytes_since_interrupt);
+    m_packets_since_interrupt = 0;
+    m_bytes_since_interrupt = 0;
+
+    m_receive_polling = false;
+    out32(REG_INTERRUPT_MASK_SET, receive_interrupts);
+    // NOTE: A packet may have come in after we last looked, but before the interrupt was unmasked again.
+    if (has_received_packet())
+        schedule_receive_poll();
+    return packets_received;
+}
+
+bool E1000NetworkAdapter::has_received_packet() const
+{
+    auto* rx_descriptors = (e1000_rx_desc const*)m_rx_descriptors_region->vaddr().as_ptr();
+    return rx_descriptors[(m_rx_tail + 1) % number_of_rx_descriptors].status & 1;
+}
+
+size_t E1000NetworkAdapter::receive(size_t budget, size_t& bytes_received)
+{
+    auto* rx_descriptors = (e1000_rx_desc*)m_rx_descriptors_region->vaddr().as_ptr();
+    size_t packets_received = 0;
+    while (packets_received < budget) {
+        u32 rx_current = (m_rx_tail + 1) % number_of_rx_descriptors;
         if (!(rx_descriptors[rx_current].status & 1))
             break;
         auto* buffer = m_rx_buffers[rx_current];
@@ -443,8 +481,50 @@ void E1000NetworkAdapter::receive()
         dbgln_if(E1000_DEBUG, "E1000: Received 1 packet @ {:p} ({} bytes)", buffer, length);
         did_receive({ buffer, length });
         rx_descriptors[rx_current].status = 0;
-        out32(REG_RXDESCTAIL, rx_current);
+        m_rx_tail = rx_current;
+        bytes_received += length;
+        ++packets_received;
     }
+    // NOTE: Handing the descriptors back to the card once per batch saves us a register write for every packet.
+    if (packets_received > 0)
+        out32(REG_RXDESCTAIL, m_rx_tail);
+    return packets_received;
+}
+
+u32 E1000NetworkAdapter::interrupt_throttling_interval(LatencyClass latency_class)
+{
+    u32 interrupts_per_second = 0;
+    switch (latency_class) {
+    case LatencyClass::Lowest:
+        interrupts_per_second = 70000;
+        break;
+    case LatencyClass::Low:
+        interrupts_per_second = 20000;
+        break;
+    case LatencyClass::Bulk:
+        interrupts_per_second = 4000;
+        break;
+    }
+    // The interrupt throttling register holds the minimum interval between interrupts in units of 256 nanoseconds.
+    return 1'000'000'000 / (interrupts_per_second * 256);
+}
+
+void E1000NetworkAdapter::update_interrupt_throttling(size_t packets, size_t bytes)
+{
+    if (packets == 0)
+        return;
+
+    auto latency_class = LatencyClass::Low;
+    if (packets <= 4 && bytes <= 4 * KiB)
+        latency_class = LatencyClass::Lowest;
+    else if (packets > receive_poll_budget / 2 || bytes / packets > 1200)
+        latency_class = LatencyClass::Bulk;
+
+    if (latency_class == m_latency_class)
+        return;
+    dbgln_if(E1000_DEBUG, "E1000: Switching to latency class {} after {} packets ({} bytes)", to_underlying(latency_class), packets, bytes);
+    m_latency_class = latency_class;
+    out32(REG_INTERRUPT_RATE, interrupt_throttling_interval(latency_class));
 }
 
 i32 E1000NetworkAdapter::link_speed()
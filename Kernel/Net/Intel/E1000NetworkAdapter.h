@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
 #include <AK/OwnPtr.h>
 #include <AK/SetOnce.h>
 #include <Kernel/Bus/PCI/Access.h>
@@ -84,7 +85,20 @@ protected:
     u16 in16(u16 address);
     u32 in32(u16 address);
 
-    void receive();
+    virtual size_t poll_receive(size_t budget) override;
+    size_t receive(size_t budget, size_t& bytes_received);
+    bool has_received_packet() const;
+    void schedule_receive_poll();
+
+    // NOTE: The interrupt rate adapts to the traffic we see. Interactive traffic gets its packets right away,
+    //       while bulk transfers and floods are fine with their packets being picked up in larger batches.
+    enum class LatencyClass {
+        Lowest,
+        Low,
+        Bulk,
+    };
+    static u32 interrupt_throttling_interval(LatencyClass);
+    void update_interrupt_throttling(size_t packets, size_t bytes);
 
     static constexpr size_t number_of_rx_descriptors = 256;
     static constexpr size_t number_of_tx_descriptors = 256;
@@ -97,6 +111,12 @@ protected:
     NonnullOwnPtr<Memory::Region> m_tx_buffer_region;
     Array<void*, number_of_rx_descriptors> m_rx_buffers;
     Array<void*, number_of_tx_descriptors> m_tx_buffers;
+    size_t m_rx_tail { number_of_rx_descriptors - 1 };
+    Atomic<bool> m_receive_polling { false };
+    LatencyClass m_latency_class { LatencyClass::Low };
+    // Received since we last switched to polling.
+    size_t m_packets_since_interrupt { 0 };
+    size_t m_bytes_since_interrupt { 0 };
     SetOnce m_has_eeprom;
     bool m_link_up { false };
     EntropySource m_entropy_source;
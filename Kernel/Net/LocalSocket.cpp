@@ -392,6 +392,27 @@ ErrorOr<NonnullOwnPtr<KString>> LocalSocket::pseudo_path(OpenFileDescription con
     return KString::try_create(builder.string_view());
 }
 
+ErrorOr<void> LocalSocket::setsockopt(OpenFileDescription& description, int level, int option, Userspace<void const*> user_value, socklen_t user_value_size)
+{
+    if (level != SOL_SOCKET || (option != SO_SNDBUF && option != SO_RCVBUF))
+        return Socket::setsockopt(description, level, option, user_value, user_value_size);
+
+    MutexLocker locker(mutex());
+
+    if (user_value_size != sizeof(int))
+        return EINVAL;
+    int value = TRY(copy_typed_from_user(static_ptr_cast<int const*>(user_value)));
+    if (value < 0)
+        return EINVAL;
+
+    // NOTE: The buffer we send into is the one our peer receives from and vice versa,
+    //       so each side gets to size its own direction.
+    auto* buffer = option == SO_SNDBUF ? send_buffer_for(description) : receive_buffer_for(description);
+    if (!buffer)
+        return ENOTCONN;
+    return buffer->try_set_capacity(clamp(static_cast<size_t>(value), minimum_buffer_size, maximum_buffer_size));
+}
+
 ErrorOr<void> LocalSocket::getsockopt(OpenFileDescription& description, int level, int option, Userspace<void*> value, Userspace<socklen_t*> value_size)
 {
     if (level != SOL_SOCKET)
@@ -404,9 +425,17 @@ ErrorOr<void> LocalSocket::getsockopt(OpenFileDescription& description, int leve
 
     switch (option) {
     case SO_SNDBUF:
-        return ENOTSUP;
-    case SO_RCVBUF:
-        return ENOTSUP;
+    case SO_RCVBUF: {
+        if (size < sizeof(int))
+            return EINVAL;
+        auto* buffer = option == SO_SNDBUF ? send_buffer_for(description) : receive_buffer_for(description);
+        if (!buffer)
+            return ENOTCONN;
+        int capacity = static_cast<int>(buffer->capacity());
+        TRY(copy_to_user(static_ptr_cast<int*>(value), &capacity));
+        size = sizeof(int);
+        return copy_to_user(value_size, &size);
+    }
     case SO_PEERCRED: {
         if (size < sizeof(ucred))
             return EINVAL;
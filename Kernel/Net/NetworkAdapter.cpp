@@ -4,12 +4,15 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/NumericLimits.h>
 #include <Kernel/Heap/kmalloc.h>
 #include <Kernel/Interrupts/InterruptDisabler.h>
 #include <Kernel/Library/StdLib.h>
 #include <Kernel/Net/EtherType.h>
+#include <Kernel/Net/IPv4SocketTuple.h>
 #include <Kernel/Net/NetworkAdapter.h>
 #include <Kernel/Net/NetworkingManagement.h>
+#include <Kernel/Net/Routing.h>
 #include <Kernel/Tasks/Process.h>
 
 namespace Kernel {
@@ -21,10 +24,16 @@ NetworkAdapter::NetworkAdapter(StringView interface_name)
 
 NetworkAdapter::~NetworkAdapter() = default;
 
-void NetworkAdapter::send_packet(ReadonlyBytes packet)
+void NetworkAdapter::send_packet(ReadonlyBytes packet, PacketOffload const& offload)
 {
     m_packets_out++;
     m_bytes_out += packet.size();
+    if (offload.needs_tcp_checksum || offload.tcp_segment_size != 0) {
+        VERIFY(has_tcp_checksum_offload());
+        VERIFY(offload.tcp_segment_size == 0 || tcp_segmentation_offload_size() > 0);
+        send_raw_with_offload(packet, offload);
+        return;
+    }
     send_raw(packet);
 }
 
@@ -47,7 +56,9 @@ void NetworkAdapter::send(MACAddress const& destination, ARPPacket const& packet
 void NetworkAdapter::fill_in_ipv4_header(PacketWithTimestamp& packet, IPv4Address const& source_ipv4, MACAddress const& destination_mac, IPv4Address const& destination_ipv4, IPv4Protocol protocol, size_t payload_size, u8 type_of_service, u8 ttl)
 {
     size_t ipv4_packet_size = sizeof(IPv4Packet) + payload_size;
-    VERIFY(ipv4_packet_size <= mtu());
+    // NOTE: Adapters with segmentation offload get segments that are larger than the MTU, and split them up.
+    VERIFY(ipv4_packet_size <= mtu() || (protocol == IPv4Protocol::TCP && tcp_segmentation_offload_size() > 0));
+    VERIFY(ipv4_packet_size <= NumericLimits<u16>::max());
 
     size_t ethernet_frame_size = ipv4_payload_offset() + payload_size;
     VERIFY(packet.buffer->size() == ethernet_frame_size);
@@ -69,13 +80,50 @@ void NetworkAdapter::fill_in_ipv4_header(PacketWithTimestamp& packet, IPv4Addres
     ipv4.set_checksum(ipv4.compute_checksum());
 }
 
+void NetworkAdapter::set_receive_queue_count(size_t count)
+{
+    VERIFY(count > 0 && count <= max_receive_queues);
+    m_receive_queue_count = count;
+}
+
+size_t NetworkAdapter::flow_hash(ReadonlyBytes frame)
+{
+    // NOTE: Everything that isn't IPv4 ends up in the first queue.
+    if (frame.size() < sizeof(EthernetFrameHeader) + sizeof(IPv4Packet))
+        return 0;
+    auto const& eth = *reinterpret_cast<EthernetFrameHeader const*>(frame.data());
+    if (eth.ether_type() != EtherType::IPv4)
+        return 0;
+    auto const& ipv4_packet = *static_cast<IPv4Packet const*>(eth.payload());
+
+    // TCP and UDP both start with the source and destination port. Fragments after the first one don't
+    // have them, so we only hash the addresses of fragmented packets to keep all of their pieces together.
+    u16 source_port = 0;
+    u16 destination_port = 0;
+    auto protocol = static_cast<IPv4Protocol>(ipv4_packet.protocol());
+    bool has_ports = (protocol == IPv4Protocol::TCP || protocol == IPv4Protocol::UDP) && !ipv4_packet.is_a_fragment();
+    if (has_ports && frame.size() >= sizeof(EthernetFrameHeader) + sizeof(IPv4Packet) + 2 * sizeof(u16)) {
+        auto const* ports = static_cast<NetworkOrdered<u16> const*>(ipv4_packet.payload());
+        source_port = ports[0];
+        destination_port = ports[1];
+    }
+
+    // This is the tuple that the TCP and UDP code will look the socket up with.
+    return Traits<IPv4SocketTuple>::hash({ ipv4_packet.destination(), destination_port, ipv4_packet.source(), source_port });
+}
+
 void NetworkAdapter::did_receive(ReadonlyBytes payload)
 {
     InterruptDisabler disabler;
     m_packets_in++;
     m_bytes_in += payload.size();
 
-    if (m_packet_queue_size == max_packet_buffers) {
+    size_t queue_count = m_receive_queue_count;
+    size_t queue_index = queue_count > 1 ? flow_hash(payload) % queue_count : 0;
+    auto& receive_queue = m_receive_queues[queue_index];
+
+    bool is_full = receive_queue.with([](auto& queue) { return queue.size == max_packet_buffers; });
+    if (is_full) {
         m_packets_dropped++;
         return;
     }
@@ -88,20 +136,50 @@ void NetworkAdapter::did_receive(ReadonlyBytes payload)
 
     memcpy(packet->buffer->data(), payload.data(), payload.size());
 
-    m_packet_queue.append(*packet);
-    m_packet_queue_size++;
+    receive_queue.with([&](auto& queue) {
+        queue.packets.append(*packet);
+        queue.size++;
+    });
 
     if (on_receive)
-        on_receive();
+        on_receive(queue_index);
 }
 
-size_t NetworkAdapter::dequeue_packet(u8* buffer, size_t buffer_size, UnixDateTime& packet_timestamp)
+void NetworkAdapter::request_receive_poll()
 {
-    InterruptDisabler disabler;
-    if (m_packet_queue.is_empty())
+    m_receive_poll_requested = true;
+    if (on_receive_poll_requested)
+        on_receive_poll_requested();
+}
+
+bool NetworkAdapter::poll_receive_if_requested()
+{
+    if (!m_receive_poll_requested.exchange(false))
+        return false;
+    if (poll_receive(receive_poll_budget) == receive_poll_budget) {
+        // There's probably more where that came from.
+        m_receive_poll_requested = true;
+        return true;
+    }
+    // NOTE: The adapter may have asked again right after switching back to interrupts.
+    return m_receive_poll_requested;
+}
+
+bool NetworkAdapter::has_queued_packets(size_t queue_index) const
+{
+    return m_receive_queues[queue_index].with([](auto const& queue) { return !queue.packets.is_empty(); });
+}
+
+size_t NetworkAdapter::dequeue_packet(size_t queue_index, u8* buffer, size_t buffer_size, UnixDateTime& packet_timestamp)
+{
+    auto packet_with_timestamp = m_receive_queues[queue_index].with([](auto& queue) -> RefPtr<PacketWithTimestamp> {
+        if (queue.packets.is_empty())
+            return nullptr;
+        queue.size--;
+        return queue.packets.take_first();
+    });
+    if (!packet_with_timestamp)
         return 0;
-    auto packet_with_timestamp = m_packet_queue.take_first();
-    m_packet_queue_size--;
     packet_timestamp = packet_with_timestamp->timestamp;
     auto& packet_buffer = packet_with_timestamp->buffer;
     size_t packet_size = packet_buffer->size();
@@ -152,11 +230,13 @@ void NetworkAdapter::release_packet_buffer(PacketWithTimestamp& packet)
 void NetworkAdapter::set_ipv4_address(IPv4Address const& address)
 {
     m_ipv4_address = address;
+    invalidate_cached_routes();
 }
 
 void NetworkAdapter::set_ipv4_netmask(IPv4Address const& netmask)
 {
     m_ipv4_netmask = netmask;
+    invalidate_cached_routes();
 }
 
 }
@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <AK/Array.h>
+#include <AK/Atomic.h>
 #include <AK/AtomicRefCounted.h>
 #include <AK/ByteBuffer.h>
 #include <AK/Function.h>
@@ -42,6 +44,14 @@ struct PacketWithTimestamp final : public AtomicRefCounted<PacketWithTimestamp>
     IntrusiveListNode<PacketWithTimestamp, RefPtr<PacketWithTimestamp>> packet_node;
 };
 
+// Work that the stack leaves to the adapter for a single outgoing packet, see NetworkAdapter::send_packet().
+struct PacketOffload {
+    // The TCP checksum field only holds the checksum of the pseudo header, the adapter has to finish it.
+    bool needs_tcp_checksum { false };
+    // If non-zero, the adapter has to split the TCP segment into segments carrying at most this many bytes.
+    u16 tcp_segment_size { 0 };
+};
+
 class NetworkingManagement;
 class NetworkAdapter
     : public AtomicRefCounted<NetworkAdapter>
@@ -73,15 +83,26 @@ public:
     }
     virtual bool link_full_duplex() { return false; }
 
+    virtual bool has_tcp_checksum_offload() const { return false; }
+    // The largest TCP segment (without headers) that the adapter can split up by itself, or 0 if it can't.
+    virtual size_t tcp_segmentation_offload_size() const { return 0; }
+
     void set_ipv4_address(IPv4Address const&);
     void set_ipv4_netmask(IPv4Address const&);
 
     void send(MACAddress const&, ARPPacket const&);
     void fill_in_ipv4_header(PacketWithTimestamp&, IPv4Address const&, MACAddress const&, IPv4Address const&, IPv4Protocol, size_t, u8 type_of_service, u8 ttl);
 
-    size_t dequeue_packet(u8* buffer, size_t buffer_size, UnixDateTime& packet_timestamp);
+    // NOTE: Received packets are spread over several queues by hashing the flow they belong to, like RSS
+    //       does in hardware. This keeps the packets of one connection in order, while the network task
+    //       can process different connections on different processors.
+    static constexpr size_t max_receive_queues = 8;
+    size_t receive_queue_count() const { return m_receive_queue_count; }
+    void set_receive_queue_count(size_t);
 
-    bool has_queued_packets() const { return !m_packet_queue.is_empty(); }
+    size_t dequeue_packet(size_t queue_index, u8* buffer, size_t buffer_size, UnixDateTime& packet_timestamp);
+
+    bool has_queued_packets(size_t queue_index) const;
 
     u32 mtu() const { return m_mtu; }
     void set_mtu(u32 mtu) { m_mtu = mtu; }
@@ -98,15 +119,32 @@ public:
     constexpr size_t layer3_payload_offset() const { return sizeof(EthernetFrameHeader); }
     constexpr size_t ipv4_payload_offset() const { return layer3_payload_offset() + sizeof(IPv4Packet); }
 
-    Function<void()> on_receive;
+    // Called whenever a packet was put into the given receive queue, possibly from an IRQ handler.
+    Function<void(size_t queue_index)> on_receive;
+
+    // NOTE: Adapters that support polling don't empty their receive ring in the IRQ handler. They mask their receive
+    //       interrupt and call request_receive_poll() instead, and the network task calls poll_receive() until the
+    //       ring runs dry, like NAPI does on Linux. That way, a flood of packets doesn't turn into a flood of interrupts.
+    static constexpr size_t receive_poll_budget = 64;
+    // Returns whether the adapter wants to be polled again.
+    bool poll_receive_if_requested();
+    // Called whenever an adapter wants to be polled, possibly from an IRQ handler.
+    Function<void()> on_receive_poll_requested;
 
-    void send_packet(ReadonlyBytes);
+    // NOTE: Offloads must only be requested if the adapter said it supports them.
+    void send_packet(ReadonlyBytes, PacketOffload const& = {});
 
 protected:
     NetworkAdapter(StringView);
     void set_mac_address(MACAddress const& mac_address) { m_mac_address = mac_address; }
     void did_receive(ReadonlyBytes);
     virtual void send_raw(ReadonlyBytes) = 0;
+    virtual void send_raw_with_offload(ReadonlyBytes, PacketOffload const&) { VERIFY_NOT_REACHED(); }
+
+    void request_receive_poll();
+    // Receives at most `budget` packets and returns how many there were. When that's less than the budget,
+    // the adapter goes back to receiving interrupts.
+    virtual size_t poll_receive([[maybe_unused]] size_t budget) { VERIFY_NOT_REACHED(); }
 
 private:
     MACAddress m_mac_address;
@@ -118,8 +156,16 @@ private:
 
     using PacketList = IntrusiveList<&PacketWithTimestamp::packet_node>;
 
-    PacketList m_packet_queue;
-    size_t m_packet_queue_size { 0 };
+    struct ReceiveQueue {
+        PacketList packets;
+        size_t size { 0 };
+    };
+
+    static size_t flow_hash(ReadonlyBytes);
+
+    Array<SpinlockProtected<ReceiveQueue, LockRank::None>, max_receive_queues> m_receive_queues;
+    Atomic<size_t> m_receive_queue_count { 1 };
+    Atomic<bool> m_receive_poll_requested { false };
     SpinlockProtected<PacketList, LockRank::None> m_unused_packets {};
     FixedStringBuffer<IFNAMSIZ> m_name;
     u32 m_packets_in { 0 };
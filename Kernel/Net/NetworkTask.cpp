@@ -4,6 +4,9 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Array.h>
+#include <AK/Atomic.h>
+#include <Kernel/Arch/Processor.h>
 #include <Kernel/Debug.h>
 #include <Kernel/Locking/Mutex.h>
 #include <Kernel/Locking/MutexProtected.h>
@@ -34,29 +37,42 @@ static void send_delayed_tcp_ack(TCPSocket& socket);
 static void send_tcp_rst(IPv4Packet const& ipv4_packet, TCPPacket const& tcp_packet, RefPtr<NetworkAdapter> adapter);
 static void flush_delayed_tcp_acks();
 static void retransmit_tcp_packets();
+static bool poll_network_adapters();
 
-static Thread* network_task = nullptr;
-static HashTable<NonnullRefPtr<TCPSocket>>* delayed_ack_sockets;
+// The network task has one worker thread per receive queue of the network adapters (see NetworkAdapter::did_receive()).
+// All packets of a flow end up in the same queue, so each connection is still handled by a single worker.
+struct NetworkTaskWorker {
+    size_t queue_index { 0 };
+    Thread* thread { nullptr };
+    WaitQueue packet_wait_queue;
+    Atomic<size_t> pending_packets { 0 };
+    // NOTE: Only ever touched by the worker itself.
+    HashTable<NonnullRefPtr<TCPSocket>> delayed_ack_sockets;
+};
 
-[[noreturn]] static void NetworkTask_main(void*);
+static Array<NetworkTaskWorker*, NetworkAdapter::max_receive_queues> s_workers {};
+static size_t s_worker_count { 0 };
 
-void NetworkTask::spawn()
+static NetworkTaskWorker* current_worker()
 {
-    auto [_, first_thread] = MUST(Process::create_kernel_process("Network Task"sv, NetworkTask_main, nullptr));
-    network_task = first_thread;
+    auto* current_thread = Thread::current();
+    for (size_t i = 0; i < s_worker_count; ++i) {
+        if (s_workers[i]->thread == current_thread)
+            return s_workers[i];
+    }
+    return nullptr;
 }
 
-bool NetworkTask::is_current()
-{
-    return Thread::current() == network_task;
-}
+[[noreturn]] static void NetworkTask_main(void*);
 
-void NetworkTask_main(void*)
+void NetworkTask::spawn()
 {
-    delayed_ack_sockets = new HashTable<NonnullRefPtr<TCPSocket>>;
+    s_worker_count = clamp<size_t>(Processor::count(), 1, NetworkAdapter::max_receive_queues);
+    for (size_t i = 0; i < s_worker_count; ++i) {
+        s_workers[i] = new NetworkTaskWorker;
+        s_workers[i]->queue_index = i;
+    }
 
-    WaitQueue packet_wait_queue;
-    int pending_packets = 0;
     NetworkingManagement::the().for_each([&](auto& adapter) {
         dmesgln("NetworkTask: {} network adapter found: hw={}", adapter.class_name(), adapter.mac_address().to_string());
 
@@ -65,22 +81,52 @@ void NetworkTask_main(void*)
             adapter.set_ipv4_netmask({ 255, 0, 0, 0 });
         }
 
-        adapter.on_receive = [&]() {
-            pending_packets++;
-            packet_wait_queue.wake_all();
+        adapter.on_receive = [](size_t queue_index) {
+            auto& worker = *s_workers[queue_index];
+            worker.pending_packets++;
+            worker.packet_wait_queue.wake_all();
+        };
+        adapter.on_receive_poll_requested = [] {
+            s_workers[0]->packet_wait_queue.wake_all();
         };
+        adapter.set_receive_queue_count(s_worker_count);
     });
 
-    auto dequeue_packet = [&pending_packets](u8* buffer, size_t buffer_size, UnixDateTime& packet_timestamp) -> size_t {
-        if (pending_packets == 0)
+    // NOTE: Each worker stays on its own processor, so that a flow's packets and sockets stay in that processor's caches.
+    auto affinity_for_worker = [](size_t index) -> u64 {
+        return s_worker_count > 1 ? (1ull << index) : THREAD_AFFINITY_DEFAULT;
+    };
+
+    auto [process, first_thread] = MUST(Process::create_kernel_process("Network Task"sv, NetworkTask_main, s_workers[0], affinity_for_worker(0)));
+    s_workers[0]->thread = first_thread;
+    for (size_t i = 1; i < s_worker_count; ++i) {
+        auto name = MUST(KString::formatted("Network Task #{}", i));
+        auto thread = MUST(process->create_kernel_thread(NetworkTask_main, s_workers[i], THREAD_PRIORITY_NORMAL, name->view(), affinity_for_worker(i), false));
+        s_workers[i]->thread = thread;
+    }
+
+    dmesgln("NetworkTask: Processing received packets on {} workers", s_worker_count);
+}
+
+bool NetworkTask::is_current()
+{
+    return current_worker() != nullptr;
+}
+
+void NetworkTask_main(void* data)
+{
+    auto& worker = *static_cast<NetworkTaskWorker*>(data);
+
+    auto dequeue_packet = [&worker](u8* buffer, size_t buffer_size, UnixDateTime& packet_timestamp) -> size_t {
+        if (worker.pending_packets == 0)
             return 0;
         size_t packet_size = 0;
         NetworkingManagement::the().for_each([&](auto& adapter) {
-            if (packet_size || !adapter.has_queued_packets())
+            if (packet_size || !adapter.has_queued_packets(worker.queue_index))
                 return;
-            packet_size = adapter.dequeue_packet(buffer, buffer_size, packet_timestamp);
-            pending_packets--;
-            dbgln_if(NETWORK_TASK_DEBUG, "NetworkTask: Dequeued packet from {} ({} bytes)", adapter.name(), packet_size);
+            packet_size = adapter.dequeue_packet(worker.queue_index, buffer, buffer_size, packet_timestamp);
+            worker.pending_packets--;
+            dbgln_if(NETWORK_TASK_DEBUG, "NetworkTask: Dequeued packet from {} queue {} ({} bytes)", adapter.name(), worker.queue_index, packet_size);
         });
         return packet_size;
     };
@@ -95,12 +141,22 @@ void NetworkTask_main(void*)
 
     while (!Process::current().is_dying()) {
         flush_delayed_tcp_acks();
-        retransmit_tcp_packets();
+        // NOTE: Retransmissions are driven by a timer rather than by received packets, so one worker is enough.
+        //       Polling the adapters only moves their packets into the receive queues, so one worker does that too.
+        bool wants_another_poll = false;
+        if (worker.queue_index == 0) {
+            retransmit_tcp_packets();
+            // NOTE: Catch up with the packets we already have before pulling in more of them.
+            if (worker.pending_packets < NetworkAdapter::receive_poll_budget)
+                wants_another_poll = poll_network_adapters();
+        }
         size_t packet_size = dequeue_packet(buffer, buffer_size, packet_timestamp);
         if (!packet_size) {
+            if (wants_another_poll)
+                continue;
             auto timeout_time = Duration::from_milliseconds(500);
             auto timeout = Thread::BlockTimeout { false, &timeout_time };
-            [[maybe_unused]] auto result = packet_wait_queue.wait_on(timeout, "NetworkTask"sv);
+            [[maybe_unused]] auto result = worker.packet_wait_queue.wait_on(timeout, "NetworkTask"sv);
             continue;
         }
         if (packet_size < sizeof(EthernetFrameHeader)) {
@@ -308,13 +364,16 @@ void send_delayed_tcp_ack(TCPSocket& socket)
         return;
     }
 
-    delayed_ack_sockets->set(move(socket));
+    auto* worker = current_worker();
+    VERIFY(worker);
+    worker->delayed_ack_sockets.set(move(socket));
 }
 
 void flush_delayed_tcp_acks()
 {
+    auto& delayed_ack_sockets = current_worker()->delayed_ack_sockets;
     Vector<NonnullRefPtr<TCPSocket>, 32> remaining_sockets;
-    for (auto& socket : *delayed_ack_sockets) {
+    for (auto& socket : delayed_ack_sockets) {
         MutexLocker locker(socket->mutex());
         if (socket->should_delay_next_ack()) {
             MUST(remaining_sockets.try_append(*socket));
@@ -323,12 +382,12 @@ void flush_delayed_tcp_acks()
         [[maybe_unused]] auto result = socket->send_ack();
     }
 
-    if (remaining_sockets.size() != delayed_ack_sockets->size()) {
-        delayed_ack_sockets->clear();
+    if (remaining_sockets.size() != delayed_ack_sockets.size()) {
+        delayed_ack_sockets.clear();
         if (remaining_sockets.size() > 0)
             dbgln("flush_delayed_tcp_acks: {} sockets remaining", remaining_sockets.size());
         for (auto&& socket : remaining_sockets)
-            delayed_ack_sockets->set(move(socket));
+            delayed_ack_sockets.set(move(socket));
     }
 }
 
@@ -360,9 +419,9 @@ void send_tcp_rst(IPv4Packet const& ipv4_packet, TCPPacket const& tcp_packet, Re
     rst_packet.set_ack_number(tcp_packet.sequence_number() + 1);
     rst_packet.set_data_offset(tcp_header_size / sizeof(u32));
     rst_packet.set_flags(TCPFlags::RST | TCPFlags::ACK);
-    rst_packet.set_checksum(TCPSocket::compute_tcp_checksum(ipv4_packet.source(), ipv4_packet.destination(), rst_packet, 0));
+    auto offload = TCPSocket::fill_in_tcp_checksum(*routing_decision.adapter, ipv4_packet.destination(), ipv4_packet.source(), rst_packet, 0);
 
-    routing_decision.adapter->send_packet(packet->bytes());
+    routing_decision.adapter->send_packet(packet->bytes(), offload);
     routing_decision.adapter->release_packet_buffer(*packet);
 }
 
@@ -431,8 +490,13 @@ void handle_tcp(IPv4Packet const& ipv4_packet, UnixDateTime const& packet_timest
 
     socket->receive_tcp_packet(tcp_packet, ipv4_packet.payload_size());
     Optional<u8> send_window_scale;
+    bool sack_permitted = false;
     if (tcp_packet.has_syn()) {
-        tcp_packet.for_each_option([&send_window_scale](auto const& option) {
+        tcp_packet.for_each_option([&send_window_scale, &sack_permitted](auto const& option) {
+            if (option.kind() == TCPOptionKind::SACKPermitted) {
+                sack_permitted = option.length() == sizeof(TCPOptionSACKPermitted);
+                return;
+            }
             if (option.kind() != TCPOptionKind::WindowScale)
                 return;
             if (option.length() != sizeof(TCPOptionWindowScale))
@@ -475,6 +539,7 @@ void handle_tcp(IPv4Packet const& ipv4_packet, UnixDateTime const& packet_timest
             dbgln_if(TCP_DEBUG, "handle_tcp: created new client socket with tuple {}", client->tuple().to_string());
             client->set_sequence_number(1000);
             client->set_ack_number(tcp_packet.sequence_number() + payload_size + 1);
+            client->set_sack_permitted(sack_permitted);
             [[maybe_unused]] auto rc2 = client->send_tcp_packet(TCPFlags::SYN | TCPFlags::ACK);
             client->set_state(TCPSocket::State::SynReceived);
             if (send_window_scale.has_value())
@@ -490,6 +555,7 @@ void handle_tcp(IPv4Packet const& ipv4_packet, UnixDateTime const& packet_timest
         switch (tcp_packet.flags()) {
         case TCPFlags::SYN:
             socket->set_ack_number(tcp_packet.sequence_number() + payload_size + 1);
+            socket->set_sack_permitted(sack_permitted);
             (void)socket->send_tcp_packet(TCPFlags::SYN | TCPFlags::ACK);
             socket->set_state(TCPSocket::State::SynReceived);
             if (send_window_scale.has_value())
@@ -497,6 +563,7 @@ void handle_tcp(IPv4Packet const& ipv4_packet, UnixDateTime const& packet_timest
             return;
         case TCPFlags::ACK | TCPFlags::SYN:
             socket->set_ack_number(tcp_packet.sequence_number() + payload_size + 1);
+            socket->set_sack_permitted(sack_permitted);
             (void)socket->send_ack(true);
             socket->set_state(TCPSocket::State::Established);
             socket->set_setup_state(Socket::SetupState::Completed);
@@ -687,6 +754,16 @@ void handle_tcp(IPv4Packet const& ipv4_packet, UnixDateTime const& packet_timest
     }
 }
 
+bool poll_network_adapters()
+{
+    bool wants_another_poll = false;
+    NetworkingManagement::the().for_each([&](auto& adapter) {
+        if (adapter.poll_receive_if_requested())
+            wants_another_poll = true;
+    });
+    return wants_another_poll;
+}
+
 void retransmit_tcp_packets()
 {
     // We must keep the sockets alive until after we've unlocked the hash table
@@ -4,7 +4,8 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
-#include <AK/HashMap.h>
+#include <AK/BuiltinWrappers.h>
+#include <AK/NumericLimits.h>
 #include <AK/Singleton.h>
 #include <Kernel/Debug.h>
 #include <Kernel/Locking/MutexProtected.h>
@@ -16,8 +17,11 @@
 
 namespace Kernel {
 
-static Singleton<SpinlockProtected<HashMap<IPv4Address, MACAddress>, LockRank::None>> s_arp_table;
-static Singleton<SpinlockProtected<Route::RouteList, LockRank::None>> s_routing_table;
+static Singleton<ARPCache> s_arp_table;
+static Singleton<SpinlockProtected<RoutingTable, LockRank::None>> s_routing_table;
+
+// Bumped whenever a routing decision that was made before might no longer be right.
+static Atomic<u32> s_routing_generation { 0 };
 
 class ARPTableBlocker final : public Thread::Blocker {
 public:
@@ -71,9 +75,7 @@ protected:
     {
         VERIFY(b.blocker_type() == Thread::Blocker::Type::Routing);
         auto& blocker = static_cast<ARPTableBlocker&>(b);
-        auto maybe_mac_address = arp_table().with([&](auto const& table) -> auto {
-            return table.get(blocker.ip_address());
-        });
+        auto maybe_mac_address = arp_table().get(blocker.ip_address());
         if (!maybe_mac_address.has_value())
             return true;
         return !blocker.unblock_if_matching_ip_address(true, blocker.ip_address(), maybe_mac_address.value());
@@ -95,9 +97,7 @@ bool ARPTableBlocker::setup_blocker()
 
 void ARPTableBlocker::will_unblock_immediately_without_blocking(UnblockImmediatelyReason)
 {
-    auto addr = arp_table().with([&](auto const& table) -> auto {
-        return table.get(ip_address());
-    });
+    auto addr = arp_table().get(ip_address());
 
     SpinlockLocker lock(m_lock);
     if (!m_did_unblock) {
@@ -106,35 +106,182 @@ void ARPTableBlocker::will_unblock_immediately_without_blocking(UnblockImmediate
     }
 }
 
-SpinlockProtected<HashMap<IPv4Address, MACAddress>, LockRank::None>& arp_table()
+ARPCache& arp_table()
 {
     return *s_arp_table;
 }
 
 void update_arp_table(IPv4Address const& ip_addr, MACAddress const& addr, UpdateTable update)
 {
-    arp_table().with([&](auto& table) {
-        if (update == UpdateTable::Set)
-            table.set(ip_addr, addr);
-        if (update == UpdateTable::Delete)
-            table.remove(ip_addr);
-    });
+    if (update == UpdateTable::Set) {
+        if (arp_table().set(ip_addr, addr))
+            invalidate_cached_routes();
+    }
+    if (update == UpdateTable::Delete) {
+        arp_table().remove(ip_addr);
+        invalidate_cached_routes();
+    }
     s_arp_table_blocker_set->unblock_blockers_waiting_for_ipv4_address(ip_addr, addr);
 
     if constexpr (ARP_DEBUG) {
-        arp_table().with([&](auto const& table) {
-            dmesgln("ARP table ({} entries):", table.size());
-            for (auto& it : table)
-                dmesgln("{} :: {}", it.value.to_string(), it.key.to_string());
-        });
+        dmesgln("ARP table ({} entries):", arp_table().size());
+        MUST(arp_table().try_for_each([](auto const& ip_address, auto const& mac_address) -> ErrorOr<void> {
+            dmesgln("{} :: {}", mac_address.to_string(), ip_address.to_string());
+            return {};
+        }));
     }
 }
 
-SpinlockProtected<Route::RouteList, LockRank::None>& routing_table()
+// Returns the length of the prefix, or nothing if the netmask has holes in it.
+static Optional<u8> prefix_length_of_netmask(u32 netmask)
+{
+    u32 host_bits = ~netmask;
+    if ((host_bits & (host_bits + 1)) != 0)
+        return {};
+    return static_cast<u8>(popcount(netmask));
+}
+
+static u32 netmask_for_prefix_length(u8 prefix_length)
+{
+    if (prefix_length == 0)
+        return 0;
+    return NumericLimits<u32>::max() << (32 - prefix_length);
+}
+
+static size_t bit_at(u32 address, u8 index)
+{
+    return (address >> (31 - index)) & 1;
+}
+
+static u8 common_prefix_length(u32 a, u32 b, u8 maximum_length)
+{
+    u32 difference = a ^ b;
+    if (difference == 0)
+        return maximum_length;
+    return min(static_cast<u8>(count_leading_zeroes(difference)), maximum_length);
+}
+
+struct Prefix {
+    u32 prefix;
+    u8 length;
+};
+
+static ErrorOr<Prefix> prefix_of_route(Route const& route)
+{
+    auto netmask = AK::convert_between_host_and_network_endian(route.netmask.to_u32());
+    auto length = prefix_length_of_netmask(netmask);
+    if (!length.has_value())
+        return EINVAL;
+    auto destination = AK::convert_between_host_and_network_endian(route.destination.to_u32());
+    return Prefix { destination & netmask, *length };
+}
+
+ErrorOr<void> RoutingTable::add(NonnullRefPtr<Route> route)
+{
+    for (auto const& existing_route : m_routes) {
+        if (existing_route == *route)
+            return EEXIST;
+    }
+
+    auto [prefix, length] = TRY(prefix_of_route(*route));
+
+    // NOTE: Every node we walk through holds a prefix of the one we're adding.
+    Node* node = &m_root;
+    for (;;) {
+        if (node->prefix_length == length) {
+            TRY(node->routes.try_append(route));
+            break;
+        }
+
+        auto& child = node->children[bit_at(prefix, node->prefix_length)];
+        if (!child) {
+            child = TRY(adopt_nonnull_own_or_enomem(new (nothrow) Node { prefix, length, {}, {} }));
+            TRY(child->routes.try_append(route));
+            break;
+        }
+
+        auto common_length = common_prefix_length(child->prefix, prefix, min(child->prefix_length, length));
+        if (common_length < child->prefix_length) {
+            // The prefixes part ways before the child does, so give them a node to branch off from.
+            auto branch = TRY(adopt_nonnull_own_or_enomem(new (nothrow) Node { prefix & netmask_for_prefix_length(common_length), common_length, {}, {} }));
+            branch->children[bit_at(child->prefix, common_length)] = move(child);
+            child = move(branch);
+        }
+        node = child.ptr();
+    }
+
+    m_routes.append(*route);
+    return {};
+}
+
+ErrorOr<void> RoutingTable::remove(Route const& route_to_remove)
+{
+    RefPtr<Route> route;
+    for (auto& candidate : m_routes) {
+        dbgln_if(ROUTING_DEBUG, "candidate: {} {} {} {} {}", candidate.destination, candidate.gateway, candidate.netmask, candidate.flags, candidate.adapter);
+        if (candidate.matches(route_to_remove)) {
+            route = candidate;
+            break;
+        }
+    }
+    if (!route)
+        return ESRCH;
+
+    // NOTE: The route made it into the table, so its prefix is valid.
+    auto [prefix, length] = MUST(prefix_of_route(*route));
+
+    Vector<Node*, 33> path;
+    Node* node = &m_root;
+    while (node->prefix_length != length) {
+        path.unchecked_append(node);
+        node = node->children[bit_at(prefix, node->prefix_length)].ptr();
+        VERIFY(node);
+    }
+    node->routes.remove_first_matching([&](auto const& candidate) { return candidate.ptr() == route.ptr(); });
+    m_routes.remove(*route);
+
+    // Nodes without routes only pull their weight if they are where two prefixes part ways.
+    while (!path.is_empty() && node->routes.is_empty()) {
+        auto* parent = path.take_last();
+        auto& slot = parent->children[bit_at(node->prefix, parent->prefix_length)];
+        if (node->children[0] && node->children[1])
+            break;
+        slot = node->children[0] ? move(node->children[0]) : move(node->children[1]);
+        node = parent;
+    }
+    return {};
+}
+
+RefPtr<Route> RoutingTable::find_longest_prefix_match(IPv4Address const& address, RefPtr<NetworkAdapter> const& through) const
+{
+    auto target = AK::convert_between_host_and_network_endian(address.to_u32());
+
+    RefPtr<Route> longest_match;
+    Node const* node = &m_root;
+    while (node && (target & netmask_for_prefix_length(node->prefix_length)) == node->prefix) {
+        for (auto const& route : node->routes) {
+            if (!through || route->adapter.ptr() == through.ptr()) {
+                longest_match = route;
+                break;
+            }
+        }
+        if (node->prefix_length == 32)
+            break;
+        node = node->children[bit_at(target, node->prefix_length)].ptr();
+    }
+    return longest_match;
+}
+
+SpinlockProtected<RoutingTable, LockRank::None>& routing_table()
 {
     return *s_routing_table;
 }
 
+void invalidate_cached_routes()
+{
+    s_routing_generation.fetch_add(1, AK::MemoryOrder::memory_order_release);
+}
+
 ErrorOr<void> update_routing_table(IPv4Address const& destination, IPv4Address const& gateway, IPv4Address const& netmask, u16 flags, RefPtr<NetworkAdapter> adapter, UpdateTable update)
 {
     dbgln_if(ROUTING_DEBUG, "update_routing_table {} {} {} {} {} {}", destination, gateway, netmask, flags, adapter, update == UpdateTable::Set ? "Set" : "Delete");
@@ -144,27 +291,13 @@ ErrorOr<void> update_routing_table(IPv4Address const& destination, IPv4Address c
         return ENOMEM;
 
     TRY(routing_table().with([&](auto& table) -> ErrorOr<void> {
-        if (update == UpdateTable::Set) {
-            for (auto const& route : table) {
-                if (route == *route_entry)
-                    return EEXIST;
-            }
-            table.append(*route_entry);
-        }
-        if (update == UpdateTable::Delete) {
-            for (auto& route : table) {
-                dbgln_if(ROUTING_DEBUG, "candidate: {} {} {} {} {}", route.destination, route.gateway, route.netmask, route.flags, route.adapter);
-                if (route.matches(*route_entry)) {
-                    // FIXME: Remove all entries, not only the first one.
-                    table.remove(route);
-                    return {};
-                }
-            }
-            return ESRCH;
-        }
-        return {};
+        if (update == UpdateTable::Set)
+            return table.add(route_entry.release_nonnull());
+        // FIXME: Remove all entries, not only the first one.
+        return table.remove(*route_entry);
     }));
 
+    invalidate_cached_routes();
     return {};
 }
 
@@ -201,7 +334,6 @@ RoutingDecision route_to(IPv4Address const& target, IPv4Address const& source, R
     auto source_addr = source.to_u32();
 
     RefPtr<NetworkAdapter> local_adapter = nullptr;
-    RefPtr<Route> chosen_route = nullptr;
 
     NetworkingManagement::the().for_each([source_addr, &target_addr, &local_adapter, &matches, &through](NetworkAdapter& adapter) {
         auto adapter_addr = adapter.ipv4_address().to_u32();
@@ -222,38 +354,11 @@ RoutingDecision route_to(IPv4Address const& target, IPv4Address const& source, R
             local_adapter = adapter;
     });
 
-    u32 longest_prefix_match = 0;
-    routing_table().for_each([&target_addr, &matches, &longest_prefix_match, &chosen_route](auto& route) {
-        auto route_addr = route.destination.to_u32();
-        auto route_mask = route.netmask.to_u32();
-
-        if (route_addr == 0 && matches(*route.adapter)) {
-            dbgln_if(ROUTING_DEBUG, "Resorting to default route found for adapter: {}", route.adapter->name());
-            chosen_route = route;
-        }
-
-        // We have a direct match and we can exit the routing table earlier.
-        if (target_addr == route_addr) {
-            dbgln_if(ROUTING_DEBUG, "Target address has a direct match in the routing table");
-            chosen_route = route;
-            return;
-        }
-
-        if ((target_addr & route_mask) == (route_addr & route_mask) && (route_addr != 0)) {
-            auto prefix = (target_addr & (route_addr & route_mask));
-
-            if (chosen_route && prefix == longest_prefix_match) {
-                chosen_route = (route.netmask.to_u32() > chosen_route->netmask.to_u32()) ? route : chosen_route;
-                dbgln_if(ROUTING_DEBUG, "Found a matching prefix match. Using longer netmask: {}", chosen_route->netmask);
-            }
-
-            if (prefix > longest_prefix_match) {
-                dbgln_if(ROUTING_DEBUG, "Found a longer prefix match - route: {}, netmask: {}", route.destination.to_string(), route.netmask);
-                longest_prefix_match = prefix;
-                chosen_route = route;
-            }
-        }
+    auto chosen_route = routing_table().with([&](auto const& table) {
+        return table.find_longest_prefix_match(target, through);
     });
+    if (chosen_route)
+        dbgln_if(ROUTING_DEBUG, "Found a longest prefix match - route: {}, netmask: {}", chosen_route->destination, chosen_route->netmask);
 
     if (local_adapter && target == local_adapter->ipv4_address())
         return { local_adapter, local_adapter->mac_address() };
@@ -304,9 +409,7 @@ RoutingDecision route_to(IPv4Address const& target, IPv4Address const& source, R
         return { adapter, multicast_ethernet_address(target) };
 
     {
-        auto addr = arp_table().with([&](auto const& table) -> auto {
-            return table.get(next_hop_ip);
-        });
+        auto addr = arp_table().get(next_hop_ip);
         if (addr.has_value()) {
             dbgln_if(ARP_DEBUG, "Routing: Using cached ARP entry for {} ({})", next_hop_ip, addr.value().to_string());
             return { adapter, addr.value() };
@@ -345,4 +448,30 @@ RoutingDecision route_to(IPv4Address const& target, IPv4Address const& source, R
     return { nullptr, {} };
 }
 
+RoutingDecision RouteCache::route_to(IPv4Address const& target, IPv4Address const& source, RefPtr<NetworkAdapter> const through, AllowBroadcast allow_broadcast, AllowUsingGateway allow_using_gateway)
+{
+    auto generation = s_routing_generation.load(AK::MemoryOrder::memory_order_acquire);
+    auto cached_decision = m_entry.with([&](auto const& entry) -> Optional<RoutingDecision> {
+        if (!entry.has_value() || entry->generation != generation)
+            return {};
+        if (entry->target != target || entry->source != source || entry->through != through)
+            return {};
+        if (entry->allow_broadcast != allow_broadcast || entry->allow_using_gateway != allow_using_gateway)
+            return {};
+        return entry->decision;
+    });
+    if (cached_decision.has_value() && cached_decision->adapter->link_up())
+        return cached_decision.release_value();
+
+    // NOTE: This may block waiting for an ARP response, so we can't hold our lock while doing it.
+    //       If the routes change in the meantime, the generation we remember won't match anymore.
+    auto decision = Kernel::route_to(target, source, through, allow_broadcast, allow_using_gateway);
+    if (!decision.is_zero()) {
+        m_entry.with([&](auto& entry) {
+            entry = Entry { target, source, through, allow_broadcast, allow_using_gateway, generation, decision };
+        });
+    }
+    return decision;
+}
+
 }
@@ -6,9 +6,13 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/IPv4Address.h>
+#include <AK/OwnPtr.h>
 #include <AK/RefPtr.h>
+#include <AK/Vector.h>
 #include <Kernel/Locking/MutexProtected.h>
+#include <Kernel/Net/ARPCache.h>
 #include <Kernel/Net/NetworkAdapter.h>
 #include <Kernel/Tasks/Thread.h>
 
@@ -44,6 +48,35 @@ struct Route final : public AtomicRefCounted<Route> {
     using RouteList = IntrusiveList<&Route::route_list_node>;
 };
 
+// The routes, indexed by their destination prefix for longest prefix matching.
+// NOTE: This is a binary trie where chains of nodes with only one child are collapsed into a single node,
+//       so a lookup only visits the nodes where routes are or where prefixes branch off.
+class RoutingTable {
+public:
+    ErrorOr<void> add(NonnullRefPtr<Route>);
+    // Removes the first route that matches the given one, see Route::matches().
+    ErrorOr<void> remove(Route const&);
+
+    // Returns the route with the longest prefix that contains the address, only considering the given adapter if there is one.
+    RefPtr<Route> find_longest_prefix_match(IPv4Address const&, RefPtr<NetworkAdapter> const& through) const;
+
+    // In the order they were added.
+    Route::RouteList const& routes() const { return m_routes; }
+
+private:
+    struct Node {
+        // NOTE: In host byte order, with all bits past the prefix length cleared.
+        u32 prefix { 0 };
+        u8 prefix_length { 0 };
+        // All routes whose destination is exactly this prefix.
+        Vector<NonnullRefPtr<Route>, 1> routes;
+        Array<OwnPtr<Node>, 2> children;
+    };
+
+    Node m_root;
+    Route::RouteList m_routes;
+};
+
 struct RoutingDecision {
     RefPtr<NetworkAdapter> adapter;
     MACAddress next_hop;
@@ -71,7 +104,29 @@ enum class AllowBroadcast {
 
 RoutingDecision route_to(IPv4Address const& target, IPv4Address const& source, RefPtr<NetworkAdapter> const through = nullptr, AllowBroadcast = AllowBroadcast::No, AllowUsingGateway = AllowUsingGateway::Yes);
 
-SpinlockProtected<HashMap<IPv4Address, MACAddress>, LockRank::None>& arp_table();
-SpinlockProtected<Route::RouteList, LockRank::None>& routing_table();
+// Remembers the last routing decision of a socket, so that most packets don't have to go through the routing
+// table and ARP cache at all. Any change to those or to the address of an adapter makes it look again.
+class RouteCache {
+public:
+    RoutingDecision route_to(IPv4Address const& target, IPv4Address const& source, RefPtr<NetworkAdapter> const through = nullptr, AllowBroadcast = AllowBroadcast::No, AllowUsingGateway = AllowUsingGateway::Yes);
+
+private:
+    struct Entry {
+        IPv4Address target;
+        IPv4Address source;
+        RefPtr<NetworkAdapter> through;
+        AllowBroadcast allow_broadcast;
+        AllowUsingGateway allow_using_gateway;
+        u32 generation { 0 };
+        RoutingDecision decision;
+    };
+
+    SpinlockProtected<Optional<Entry>, LockRank::None> m_entry {};
+};
+
+void invalidate_cached_routes();
+
+ARPCache& arp_table();
+SpinlockProtected<RoutingTable, LockRank::None>& routing_table();
 
 }
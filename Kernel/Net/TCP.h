@@ -74,7 +74,40 @@ private:
     NetworkOrdered<u8> m_value;
 };
 
+class [[gnu::packed]] TCPOptionSACKPermitted : public TCPOption {
+public:
+    TCPOptionSACKPermitted()
+        : TCPOption(TCPOptionKind::SACKPermitted, sizeof(TCPOptionSACKPermitted))
+    {
+    }
+};
+
+struct [[gnu::packed]] TCPSACKBlock {
+    NetworkOrdered<u32> left_edge;
+    NetworkOrdered<u32> right_edge;
+};
+
+// RFC 2018 (3): Each block reports a contiguous range of data that the receiver has, past a hole
+// in the sequence space. The first block covers the segment that triggered the ACK.
+class [[gnu::packed]] TCPOptionSACK : public TCPOption {
+public:
+    size_t block_count() const { return (length() - sizeof(TCPOption)) / sizeof(TCPSACKBlock); }
+    TCPSACKBlock block(size_t index) const
+    {
+        VERIFY(index < block_count());
+        return reinterpret_cast<TCPSACKBlock const*>(reinterpret_cast<u8 const*>(this) + sizeof(TCPOption))[index];
+    }
+};
+
 static_assert(AssertSize<TCPOptionMSS, 4>());
+static_assert(AssertSize<TCPOptionSACKPermitted, 2>());
+static_assert(AssertSize<TCPSACKBlock, 8>());
+
+// RFC 793 (3.3): Sequence numbers wrap around, so they have to be compared modulo 2^32.
+constexpr bool tcp_sequence_number_before(u32 a, u32 b)
+{
+    return static_cast<i32>(a - b) < 0;
+}
 
 class [[gnu::packed]] TCPPacket {
 public:
@@ -135,6 +168,8 @@ public:
             }
             if (option->length() < sizeof(TCPOption))
                 return; // minimal option length
+            if (option->length() > (size_t)options_end - (size_t)next_option)
+                return; // option doesn't fit into the header
             callback(*option);
             next_option += option->length();
         }
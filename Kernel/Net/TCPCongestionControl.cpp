@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/NumericLimits.h>
+#include <Kernel/Debug.h>
+#include <Kernel/Net/TCPCongestionControl.h>
+
+namespace Kernel {
+
+Optional<TCPCongestionControl::Algorithm> TCPCongestionControl::algorithm_from_name(StringView name)
+{
+    if (name == "reno"sv || name == "newreno"sv)
+        return Algorithm::NewReno;
+    if (name == "cubic"sv)
+        return Algorithm::Cubic;
+    return {};
+}
+
+ErrorOr<NonnullOwnPtr<TCPCongestionControl>> TCPCongestionControl::try_create(Algorithm algorithm, size_t maximum_segment_size)
+{
+    switch (algorithm) {
+    case Algorithm::NewReno:
+        return TRY(adopt_nonnull_own_or_enomem(new (nothrow) TCPNewReno(maximum_segment_size)));
+    case Algorithm::Cubic:
+        return TRY(adopt_nonnull_own_or_enomem(new (nothrow) TCPCubic(maximum_segment_size)));
+    }
+    VERIFY_NOT_REACHED();
+}
+
+TCPCongestionControl::TCPCongestionControl(size_t maximum_segment_size)
+    : m_congestion_window(initial_window(maximum_segment_size))
+    , m_slow_start_threshold(NumericLimits<size_t>::max())
+    , m_maximum_segment_size(maximum_segment_size)
+{
+}
+
+size_t TCPCongestionControl::initial_window(size_t maximum_segment_size)
+{
+    // RFC 6928 (2): "min (10*MSS, max (2*MSS, 14600))"
+    return min(10 * maximum_segment_size, max(2 * maximum_segment_size, 14600u));
+}
+
+void TCPCongestionControl::set_maximum_segment_size(size_t maximum_segment_size)
+{
+    if (m_maximum_segment_size == maximum_segment_size)
+        return;
+    m_maximum_segment_size = maximum_segment_size;
+    // NOTE: We only learn the MSS once we know the route, so the initial window was just a guess.
+    if (!m_has_seen_ack)
+        m_congestion_window = initial_window(maximum_segment_size);
+}
+
+void TCPCongestionControl::on_ack(size_t acked_bytes, Duration smoothed_round_trip_time, MonotonicTime now)
+{
+    VERIFY(!m_in_fast_recovery);
+    m_has_seen_ack = true;
+
+    if (in_slow_start()) {
+        // RFC 5681 (3.1): "cwnd += min (N, SMSS)"
+        m_congestion_window += min(acked_bytes, m_maximum_segment_size);
+        return;
+    }
+    grow_in_congestion_avoidance(acked_bytes, smoothed_round_trip_time, now);
+}
+
+void TCPCongestionControl::on_fast_retransmit(size_t bytes_in_flight, MonotonicTime now)
+{
+    VERIFY(!m_in_fast_recovery);
+    m_has_seen_ack = true;
+
+    // RFC 5681 (3.2): "The lost segment starting at SND.UNA MUST be retransmitted and cwnd set to
+    //  ssthresh plus 3*SMSS. This artificially "inflates" the congestion window by the number of
+    //  segments (three) that have left the network and which the receiver has buffered."
+    m_slow_start_threshold = slow_start_threshold_after_loss(bytes_in_flight, now);
+    m_congestion_window = m_slow_start_threshold + 3 * m_maximum_segment_size;
+    m_in_fast_recovery = true;
+    dbgln_if(TCP_SOCKET_DEBUG, "TCPCongestionControl({}): Entering fast recovery, cwnd={} ssthresh={}", name(), m_congestion_window, m_slow_start_threshold);
+}
+
+void TCPCongestionControl::on_duplicate_ack_in_fast_recovery()
+{
+    VERIFY(m_in_fast_recovery);
+    m_congestion_window += m_maximum_segment_size;
+}
+
+void TCPCongestionControl::on_partial_ack(size_t acked_bytes)
+{
+    VERIFY(m_in_fast_recovery);
+    // RFC 6582 (3.2): "deflate the congestion window by the amount of new data acknowledged by the
+    //  cumulative acknowledgment field. If the partial ACK acknowledges at least one SMSS of new data,
+    //  then add back SMSS bytes to the congestion window."
+    m_congestion_window -= min(acked_bytes, m_congestion_window - m_maximum_segment_size);
+    if (acked_bytes >= m_maximum_segment_size)
+        m_congestion_window += m_maximum_segment_size;
+}
+
+void TCPCongestionControl::on_recovery_complete()
+{
+    VERIFY(m_in_fast_recovery);
+    m_congestion_window = m_slow_start_threshold;
+    m_in_fast_recovery = false;
+    dbgln_if(TCP_SOCKET_DEBUG, "TCPCongestionControl({}): Leaving fast recovery, cwnd={}", name(), m_congestion_window);
+}
+
+void TCPCongestionControl::on_retransmit_timeout(size_t bytes_in_flight, MonotonicTime now)
+{
+    m_has_seen_ack = true;
+    // RFC 5681 (3.1): "Furthermore, upon a timeout (as specified in [RFC2988]) cwnd MUST be set to no
+    //  more than the loss window, LW, which equals 1 full-sized segment"
+    m_slow_start_threshold = slow_start_threshold_after_loss(bytes_in_flight, now);
+    m_congestion_window = m_maximum_segment_size;
+    m_in_fast_recovery = false;
+    dbgln_if(TCP_SOCKET_DEBUG, "TCPCongestionControl({}): Retransmit timeout, ssthresh={}", name(), m_slow_start_threshold);
+}
+
+size_t TCPNewReno::slow_start_threshold_after_loss(size_t bytes_in_flight, MonotonicTime)
+{
+    m_bytes_acked_in_avoidance = 0;
+    // RFC 5681 (3.1): "ssthresh = max (FlightSize / 2, 2*SMSS)"
+    return max(bytes_in_flight / 2, 2 * m_maximum_segment_size);
+}
+
+void TCPNewReno::grow_in_congestion_avoidance(size_t acked_bytes, Duration, MonotonicTime)
+{
+    // RFC 5681 (3.1): "Another common formula that a TCP MAY use to update cwnd during congestion
+    //  avoidance is given in equation (3): cwnd += SMSS*SMSS/cwnd"
+    // NOTE: We count bytes instead (RFC 3465), which is what the formula tries to approximate,
+    //       without being thrown off by delayed ACKs or rounding down small increments to zero.
+    m_bytes_acked_in_avoidance += acked_bytes;
+    if (m_bytes_acked_in_avoidance >= m_congestion_window) {
+        m_bytes_acked_in_avoidance -= m_congestion_window;
+        m_congestion_window += m_maximum_segment_size;
+    }
+}
+
+// RFC 8312 (5): "C SHOULD be set to 0.4" and (4.5) "beta_cubic SHOULD be set to 0.7"
+static constexpr u64 cubic_c_numerator = 4;
+static constexpr u64 cubic_c_denominator = 10;
+static constexpr u64 cubic_beta_numerator = 7;
+static constexpr u64 cubic_beta_denominator = 10;
+
+// The kernel can't use floating point, so we find the root with a binary search.
+static u64 integer_cube_root(u64 value)
+{
+    // NOTE: 2642245 is the largest number whose cube still fits into a u64.
+    u64 low = 0;
+    u64 high = min(value, 2642245ull);
+    while (low < high) {
+        u64 middle = (low + high + 1) / 2;
+        if (middle * middle * middle <= value)
+            low = middle;
+        else
+            high = middle - 1;
+    }
+    return low;
+}
+
+size_t TCPCubic::slow_start_threshold_after_loss(size_t, MonotonicTime)
+{
+    // RFC 8312 (4.6): "With fast convergence, when a congestion event occurs, before the window
+    //  reduction of the congestion window, a flow remembers the last value of W_max before it
+    //  updates W_max for the current congestion event."
+    if (m_congestion_window < m_window_before_loss)
+        m_window_before_loss = m_congestion_window * (cubic_beta_denominator + cubic_beta_numerator) / (2 * cubic_beta_denominator);
+    else
+        m_window_before_loss = m_congestion_window;
+    m_epoch_start.clear();
+
+    // RFC 8312 (4.5): "ssthresh = cwnd * beta_cubic"
+    return max(m_congestion_window * cubic_beta_numerator / cubic_beta_denominator, 2 * m_maximum_segment_size);
+}
+
+void TCPCubic::grow_in_congestion_avoidance(size_t acked_bytes, Duration smoothed_round_trip_time, MonotonicTime now)
+{
+    auto const mss = static_cast<u64>(m_maximum_segment_size);
+
+    if (!m_epoch_start.has_value()) {
+        m_epoch_start = now;
+        m_reno_window = m_congestion_window;
+        if (m_congestion_window < m_window_before_loss) {
+            // RFC 8312 (4.1): "K = cubic_root(W_max*(1-beta_cubic)/C)", which is the time until we're back
+            // at W_max. We start from the current window instead, which is W_max*beta_cubic after a loss.
+            u64 segments_to_origin = min<u64>((m_window_before_loss - m_congestion_window) / mss, 1'000'000);
+            // NOTE: Scaled by 1000^3 so that the root is in milliseconds.
+            m_milliseconds_to_origin = integer_cube_root(segments_to_origin * 1'000'000'000 * cubic_c_denominator / cubic_c_numerator);
+            m_origin_window = m_window_before_loss;
+        } else {
+            m_milliseconds_to_origin = 0;
+            m_origin_window = m_congestion_window;
+        }
+    }
+
+    // RFC 8312 (4.1): "W_cubic(t) = C*(t-K)^3 + W_max", evaluated one round trip ahead as in (4.3).
+    auto elapsed = (now - *m_epoch_start) + smoothed_round_trip_time;
+    i64 offset_milliseconds = clamp<i64>(elapsed.to_milliseconds() - m_milliseconds_to_origin, -1'000'000, 1'000'000);
+    // NOTE: This is C*(t-K)^3 in thousandths of a segment, it can't overflow with the clamped offset.
+    i64 offset_millisegments = offset_milliseconds * offset_milliseconds * offset_milliseconds / 1'000'000
+        * static_cast<i64>(cubic_c_numerator) / static_cast<i64>(cubic_c_denominator);
+    i64 target = static_cast<i64>(m_origin_window) + offset_millisegments * static_cast<i64>(mss) / 1000;
+    // RFC 8312 (4.3): "the target MUST be no more than 1.5 times the current cwnd"
+    target = clamp<i64>(target, static_cast<i64>(m_congestion_window), static_cast<i64>(m_congestion_window + m_congestion_window / 2));
+
+    u64 increment;
+    if (static_cast<size_t>(target) > m_congestion_window) {
+        // RFC 8312 (4.3): "cwnd MUST be incremented by (W_cubic(t+RTT) - cwnd)/cwnd for each received ACK"
+        increment = (static_cast<u64>(target) - m_congestion_window) * acked_bytes / m_congestion_window;
+    } else {
+        // RFC 8312 (4.4): Probe slowly for more bandwidth around W_max.
+        increment = mss * acked_bytes / (100 * m_congestion_window);
+    }
+
+    // RFC 8312 (4.2): "W_est(t) = W_max*beta_cubic + [3*(1-beta_cubic)/(1+beta_cubic)] * (t/RTT)",
+    // which is what standard TCP would grow to. We track it by growing it like NewReno does.
+    m_reno_window += mss * acked_bytes * 9 / (17 * m_reno_window);
+
+    m_congestion_window = max(m_congestion_window + increment, m_reno_window);
+}
+
+}
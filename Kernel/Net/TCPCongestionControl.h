@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Error.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Optional.h>
+#include <AK/StringView.h>
+#include <AK/Time.h>
+
+namespace Kernel {
+
+// Decides how much unacknowledged data a TCP connection may have in flight, its congestion window.
+// The socket reports acknowledgements, duplicate ACKs and timeouts, and the algorithms differ in how
+// the window grows while avoiding congestion and how far it is cut back after a loss.
+// Slow start and fast recovery are the same for all of them (RFC 5681, RFC 6582).
+// NOTE: All window sizes are in bytes.
+class TCPCongestionControl {
+public:
+    enum class Algorithm {
+        NewReno,
+        Cubic,
+    };
+
+    static constexpr Algorithm default_algorithm = Algorithm::Cubic;
+
+    static Optional<Algorithm> algorithm_from_name(StringView);
+    static ErrorOr<NonnullOwnPtr<TCPCongestionControl>> try_create(Algorithm, size_t maximum_segment_size);
+
+    virtual ~TCPCongestionControl() = default;
+
+    virtual Algorithm algorithm() const = 0;
+    virtual StringView name() const = 0;
+
+    size_t congestion_window() const { return m_congestion_window; }
+    size_t slow_start_threshold() const { return m_slow_start_threshold; }
+    bool in_slow_start() const { return m_congestion_window < m_slow_start_threshold; }
+    bool in_fast_recovery() const { return m_in_fast_recovery; }
+
+    size_t maximum_segment_size() const { return m_maximum_segment_size; }
+    void set_maximum_segment_size(size_t);
+
+    // Called for every ACK that acknowledges new data outside of fast recovery.
+    void on_ack(size_t acked_bytes, Duration smoothed_round_trip_time, MonotonicTime now);
+
+    // Called when enough duplicate ACKs arrived to consider the first unacknowledged segment lost.
+    void on_fast_retransmit(size_t bytes_in_flight, MonotonicTime now);
+    void on_duplicate_ack_in_fast_recovery();
+    // An ACK for some, but not all of the data that was outstanding when fast recovery started.
+    void on_partial_ack(size_t acked_bytes);
+    void on_recovery_complete();
+
+    void on_retransmit_timeout(size_t bytes_in_flight, MonotonicTime now);
+
+protected:
+    explicit TCPCongestionControl(size_t maximum_segment_size);
+
+    // Returns the slow start threshold to use after a loss was detected.
+    virtual size_t slow_start_threshold_after_loss(size_t bytes_in_flight, MonotonicTime now) = 0;
+    virtual void grow_in_congestion_avoidance(size_t acked_bytes, Duration smoothed_round_trip_time, MonotonicTime now) = 0;
+
+    size_t m_congestion_window { 0 };
+    size_t m_slow_start_threshold { 0 };
+    size_t m_maximum_segment_size { 0 };
+
+private:
+    static size_t initial_window(size_t maximum_segment_size);
+
+    bool m_in_fast_recovery { false };
+    bool m_has_seen_ack { false };
+};
+
+// RFC 5681 and RFC 6582: The window grows by one segment per round trip, and is halved on loss.
+class TCPNewReno final : public TCPCongestionControl {
+public:
+    explicit TCPNewReno(size_t maximum_segment_size)
+        : TCPCongestionControl(maximum_segment_size)
+    {
+    }
+
+    virtual Algorithm algorithm() const override { return Algorithm::NewReno; }
+    virtual StringView name() const override { return "reno"sv; }
+
+private:
+    virtual size_t slow_start_threshold_after_loss(size_t bytes_in_flight, MonotonicTime) override;
+    virtual void grow_in_congestion_avoidance(size_t acked_bytes, Duration, MonotonicTime) override;
+
+    size_t m_bytes_acked_in_avoidance { 0 };
+};
+
+// RFC 8312: The window follows a cubic function of the time since the last loss, which quickly
+// grows back to where that loss happened, carefully probes around it and then grows faster again.
+// This makes the window independent of the round trip time, which fits long, fast paths a lot better.
+class TCPCubic final : public TCPCongestionControl {
+public:
+    explicit TCPCubic(size_t maximum_segment_size)
+        : TCPCongestionControl(maximum_segment_size)
+    {
+    }
+
+    virtual Algorithm algorithm() const override { return Algorithm::Cubic; }
+    virtual StringView name() const override { return "cubic"sv; }
+
+private:
+    virtual size_t slow_start_threshold_after_loss(size_t bytes_in_flight, MonotonicTime) override;
+    virtual void grow_in_congestion_avoidance(size_t acked_bytes, Duration smoothed_round_trip_time, MonotonicTime now) override;
+
+    // The window right before the last loss (W_max).
+    size_t m_window_before_loss { 0 };
+    // The window that the cubic function is centered around, and the time it takes to get back there (K).
+    size_t m_origin_window { 0 };
+    i64 m_milliseconds_to_origin { 0 };
+    Optional<MonotonicTime> m_epoch_start;
+    // The window that standard TCP would have by now, CUBIC never grows slower than that (W_est).
+    size_t m_reno_window { 0 };
+};
+
+}
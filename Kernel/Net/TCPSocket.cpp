@@ -160,6 +160,7 @@ ErrorOr<NonnullRefPtr<TCPSocket>> TCPSocket::try_create_client(IPv4Address const
         client->set_bound();
         client->set_direction(Direction::Incoming);
         client->set_originator(*this);
+        client->m_congestion_control = TRY(TCPCongestionControl::try_create(m_congestion_control->algorithm(), m_congestion_control->maximum_segment_size()));
 
         m_pending_release_for_accept.set(tuple, client);
         client->m_registered_socket_tuple = tuple;
@@ -178,16 +179,19 @@ void TCPSocket::release_to_originator()
 
 void TCPSocket::release_for_accept(NonnullRefPtr<TCPSocket> socket)
 {
+    // NOTE: Connections to the same listening socket can be handled by different network task workers.
+    MutexLocker locker(mutex());
     VERIFY(m_pending_release_for_accept.contains(socket->tuple()));
     m_pending_release_for_accept.remove(socket->tuple());
     // FIXME: Should we observe this error somehow?
     [[maybe_unused]] auto rc = queue_connection_from(move(socket));
 }
 
-TCPSocket::TCPSocket(int protocol, NonnullOwnPtr<DoubleBuffer> receive_buffer, NonnullOwnPtr<KBuffer> scratch_buffer, NonnullRefPtr<Timer> timer)
+TCPSocket::TCPSocket(int protocol, NonnullOwnPtr<DoubleBuffer> receive_buffer, NonnullOwnPtr<KBuffer> scratch_buffer, NonnullRefPtr<Timer> timer, NonnullOwnPtr<TCPCongestionControl> congestion_control)
     : IPv4Socket(SOCK_STREAM, protocol, move(receive_buffer), move(scratch_buffer))
     , m_last_ack_sent_time(TimeManagement::the().monotonic_time())
     , m_last_retransmit_time(TimeManagement::the().monotonic_time())
+    , m_congestion_control(move(congestion_control))
     , m_timer(timer)
 {
 }
@@ -204,7 +208,9 @@ ErrorOr<NonnullRefPtr<TCPSocket>> TCPSocket::try_create(int protocol, NonnullOwn
     // Note: Scratch buffer is only used for SOCK_STREAM sockets.
     auto scratch_buffer = TRY(KBuffer::try_create_with_size("TCPSocket: Scratch buffer"sv, 65536));
     auto timer = TRY(adopt_nonnull_ref_or_enomem(new (nothrow) Timer));
-    return adopt_nonnull_ref_or_enomem(new (nothrow) TCPSocket(protocol, move(receive_buffer), move(scratch_buffer), timer));
+    // NOTE: We don't know the real MSS until we have a route, protocol_send() will tell the congestion control about it.
+    auto congestion_control = TRY(TCPCongestionControl::try_create(TCPCongestionControl::default_algorithm, 1460));
+    return adopt_nonnull_ref_or_enomem(new (nothrow) TCPSocket(protocol, move(receive_buffer), move(scratch_buffer), timer, move(congestion_control)));
 }
 
 ErrorOr<size_t> TCPSocket::protocol_size(ReadonlyBytes raw_ipv4_packet)
@@ -228,10 +234,11 @@ ErrorOr<size_t> TCPSocket::protocol_receive(ReadonlyBytes raw_ipv4_packet, UserO
 ErrorOr<size_t> TCPSocket::protocol_send(UserOrKernelBuffer const& data, size_t data_length)
 {
     auto adapter = bound_interface().with([](auto& bound_device) -> RefPtr<NetworkAdapter> { return bound_device; });
-    RoutingDecision routing_decision = route_to(peer_address(), local_address(), adapter);
+    RoutingDecision routing_decision = m_route_cache.route_to(peer_address(), local_address(), adapter);
     if (routing_decision.is_zero())
         return set_so_error(EHOSTUNREACH);
     size_t mss = routing_decision.adapter->mtu() - sizeof(IPv4Packet) - sizeof(TCPPacket);
+    m_congestion_control->set_maximum_segment_size(mss);
 
     if (!m_no_delay) {
         // RFC 896 (Nagle’s algorithm): https://www.ietf.org/rfc/rfc0896
@@ -245,7 +252,17 @@ ErrorOr<size_t> TCPSocket::protocol_send(UserOrKernelBuffer const& data, size_t
             return set_so_error(EAGAIN);
     }
 
-    data_length = min(data_length, mss);
+    // NOTE: Blocking writers wait in can_write() until there is room again.
+    auto send_window = usable_send_window();
+    if (send_window == 0)
+        return set_so_error(EAGAIN);
+
+    // NOTE: Adapters with segmentation offload get many segments worth of data at once, and split them up themselves.
+    size_t segment_size = mss;
+    if (auto offload_size = routing_decision.adapter->tcp_segmentation_offload_size(); offload_size > mss)
+        segment_size = min(offload_size, maximum_offloaded_segment_size);
+
+    data_length = min(data_length, min(segment_size, send_window));
     TRY(send_tcp_packet(TCPFlags::PSH | TCPFlags::ACK, &data, data_length, &routing_decision));
     return data_length;
 }
@@ -260,7 +277,7 @@ ErrorOr<void> TCPSocket::send_ack(bool allow_duplicate)
 ErrorOr<void> TCPSocket::send_tcp_packet(u16 flags, UserOrKernelBuffer const* payload, size_t payload_size, RoutingDecision* user_routing_decision)
 {
     auto adapter = bound_interface().with([](auto& bound_device) -> RefPtr<NetworkAdapter> { return bound_device; });
-    RoutingDecision routing_decision = user_routing_decision ? *user_routing_decision : route_to(peer_address(), local_address(), adapter);
+    RoutingDecision routing_decision = user_routing_decision ? *user_routing_decision : m_route_cache.route_to(peer_address(), local_address(), adapter);
     if (routing_decision.is_zero())
         return set_so_error(EHOSTUNREACH);
 
@@ -268,7 +285,12 @@ ErrorOr<void> TCPSocket::send_tcp_packet(u16 flags, UserOrKernelBuffer const* pa
 
     bool const has_mss_option = flags & TCPFlags::SYN;
     bool const has_window_scale_option = flags & TCPFlags::SYN;
-    size_t const options_size = (has_mss_option ? sizeof(TCPOptionMSS) : 0) + (has_window_scale_option ? sizeof(TCPOptionWindowScale) : 0);
+    // RFC 2018 (2): "The SACK-permitted option [...] MUST NOT be sent on non-SYN segments." When answering a SYN,
+    // we only send it if the peer sent it as well.
+    bool const has_sack_permitted_option = (flags & TCPFlags::SYN) && (!(flags & TCPFlags::ACK) || m_sack_permitted);
+    size_t const options_size = (has_mss_option ? sizeof(TCPOptionMSS) : 0)
+        + (has_window_scale_option ? sizeof(TCPOptionWindowScale) : 0)
+        + (has_sack_permitted_option ? sizeof(TCPOptionSACKPermitted) : 0);
     size_t const tcp_header_size = sizeof(TCPPacket) + align_up_to(options_size, 4);
     size_t const buffer_size = ipv4_payload_offset + tcp_header_size + payload_size;
     auto packet = routing_decision.adapter->acquire_packet_buffer(buffer_size);
@@ -277,7 +299,7 @@ ErrorOr<void> TCPSocket::send_tcp_packet(u16 flags, UserOrKernelBuffer const* pa
     routing_decision.adapter->fill_in_ipv4_header(*packet, local_address(),
         routing_decision.next_hop, peer_address(), IPv4Protocol::TCP,
         buffer_size - ipv4_payload_offset, type_of_service(), ttl());
-    memset(packet->buffer->data() + ipv4_payload_offset, 0, sizeof(TCPPacket));
+    memset(packet->buffer->data() + ipv4_payload_offset, 0, tcp_header_size);
     auto& tcp_packet = *(TCPPacket*)(packet->buffer->data() + ipv4_payload_offset);
     VERIFY(local_port());
     tcp_packet.set_source_port(local_port());
@@ -321,22 +343,35 @@ ErrorOr<void> TCPSocket::send_tcp_packet(u16 flags, UserOrKernelBuffer const* pa
         memcpy(next_option, &window_scale_option, sizeof(window_scale_option));
         next_option += sizeof(window_scale_option);
     }
+    if (has_sack_permitted_option) {
+        TCPOptionSACKPermitted sack_permitted_option;
+        memcpy(next_option, &sack_permitted_option, sizeof(sack_permitted_option));
+        next_option += sizeof(sack_permitted_option);
+    }
     if ((options_size % 4) != 0)
         *next_option = to_underlying(TCPOptionKind::End);
 
-    tcp_packet.set_checksum(compute_tcp_checksum(local_address(), peer_address(), tcp_packet, payload_size));
+    auto offload = fill_in_tcp_checksum(*routing_decision.adapter, local_address(), peer_address(), tcp_packet, payload_size);
+    if (size_t mss = routing_decision.adapter->mtu() - sizeof(IPv4Packet) - tcp_header_size; payload_size > mss)
+        offload.tcp_segment_size = mss;
 
     bool expect_ack { tcp_packet.has_syn() || payload_size > 0 };
     if (expect_ack) {
         bool append_failed { false };
+        auto now = TimeManagement::the().monotonic_time();
         m_unacked_packets.with_exclusive([&](auto& unacked_packets) {
-            auto result = unacked_packets.packets.try_append({ m_sequence_number, packet, ipv4_payload_offset, *routing_decision.adapter });
+            bool was_empty = unacked_packets.packets.is_empty();
+            auto result = unacked_packets.packets.try_append({ m_sequence_number, packet, ipv4_payload_offset, *routing_decision.adapter, 0, tcp_packet.sequence_number(), payload_size, now });
             if (result.is_error()) {
                 dbgln("TCPSocket: Dropped outbound packet because try_append() failed");
                 append_failed = true;
                 return;
             }
             unacked_packets.size += payload_size;
+            // RFC 6298 (5.1): "Every time a packet containing data is sent (including a retransmission), if the
+            //  timer is not running, start it running so that it will expire after RTO seconds"
+            if (was_empty)
+                m_last_retransmit_time = now;
             enqueue_for_retransmit();
         });
         if (append_failed)
@@ -345,7 +380,7 @@ ErrorOr<void> TCPSocket::send_tcp_packet(u16 flags, UserOrKernelBuffer const* pa
 
     m_packets_out++;
     m_bytes_out += buffer_size;
-    routing_decision.adapter->send_packet(packet->bytes());
+    routing_decision.adapter->send_packet(packet->bytes(), offload);
     if (!expect_ack)
         routing_decision.adapter->release_packet_buffer(*packet);
 
@@ -356,47 +391,164 @@ void TCPSocket::receive_tcp_packet(TCPPacket const& packet, u16 size)
 {
     if (packet.has_ack()) {
         u32 ack_number = packet.ack_number();
+        auto now = TimeManagement::the().monotonic_time();
 
         dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket: receive_tcp_packet: {}", ack_number);
 
+        // NOTE: The window in a SYN is never scaled.
+        // FIXME: Probe a zero window (RFC 9293, 3.8.6.1) instead of relying on the peer's window update to arrive.
+        u32 send_window_size = packet.has_syn() ? packet.window_size() : packet.window_size() << m_send_window_scale;
+        bool window_changed = send_window_size != m_send_window_size;
+        m_send_window_size = send_window_size;
+
         int removed = 0;
+        size_t acked_bytes = 0;
+        size_t bytes_in_flight = 0;
+        bool is_duplicate_ack = false;
+        Optional<Duration> round_trip_time;
         m_unacked_packets.with_exclusive([&](auto& unacked_packets) {
+            // RFC 5681 (2): A duplicate ACK acknowledges nothing new, carries no data and doesn't change the window.
+            if (!unacked_packets.packets.is_empty() && ack_number == unacked_packets.packets.first().sequence_number)
+                is_duplicate_ack = size == packet.header_size() && !packet.has_syn() && !packet.has_fin() && !window_changed;
+
             while (!unacked_packets.packets.is_empty()) {
-                auto& packet = unacked_packets.packets.first();
-
-                dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket: iterate: {}", packet.ack_number);
-
-                if (packet.ack_number <= ack_number) {
-                    auto old_adapter = packet.adapter.strong_ref();
-                    if (old_adapter)
-                        old_adapter->release_packet_buffer(*packet.buffer);
-                    TCPPacket& tcp_packet = *(TCPPacket*)(packet.buffer->buffer->data() + packet.ipv4_payload_offset);
-                    if (m_send_window_size != tcp_packet.window_size()) {
-                        m_send_window_size = tcp_packet.window_size() << m_send_window_scale;
-                    }
-                    auto payload_size = packet.buffer->buffer->data() + packet.buffer->buffer->size() - (u8*)tcp_packet.payload();
-                    unacked_packets.size -= payload_size;
-                    evaluate_block_conditions();
-                    unacked_packets.packets.take_first();
-                    removed++;
-                } else {
+                auto& unacked_packet = unacked_packets.packets.first();
+
+                dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket: iterate: {}", unacked_packet.ack_number);
+
+                if (tcp_sequence_number_before(ack_number, unacked_packet.ack_number))
                     break;
-                }
+
+                // RFC 6298 (3): Karn's algorithm, we can't tell which transmission a retransmitted segment was acknowledged for.
+                if (unacked_packet.tx_counter == 0)
+                    round_trip_time = now - unacked_packet.sent_time;
+
+                auto old_adapter = unacked_packet.adapter.strong_ref();
+                if (old_adapter)
+                    old_adapter->release_packet_buffer(*unacked_packet.buffer);
+                unacked_packets.size -= unacked_packet.payload_size;
+                if (unacked_packet.is_sacked)
+                    unacked_packets.sacked_size -= unacked_packet.payload_size;
+                acked_bytes += unacked_packet.payload_size;
+                unacked_packets.packets.take_first();
+                removed++;
             }
 
+            if (m_sack_permitted)
+                mark_sacked_packets(unacked_packets, packet);
+            bytes_in_flight = unacked_packets.bytes_in_flight();
+
             if (unacked_packets.packets.is_empty()) {
                 m_retransmit_attempts = 0;
                 dequeue_for_retransmit();
+            } else if (removed > 0) {
+                // RFC 6298 (5.3): "When an ACK is received that acknowledges new data, restart the retransmission timer"
+                m_retransmit_attempts = 0;
+                m_last_retransmit_time = now;
             }
 
             dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket: receive_tcp_packet acknowledged {} packets", removed);
         });
+
+        if (round_trip_time.has_value())
+            update_retransmit_timeout(*round_trip_time);
+
+        if (removed > 0) {
+            m_duplicate_acks_received = 0;
+            if (m_recovery_point.has_value() && tcp_sequence_number_before(ack_number, *m_recovery_point)) {
+                // RFC 6582 (3.2): "If this ACK does *not* acknowledge all of the data up to and including recover,
+                //  then this is a partial ACK. In this case, retransmit the first unacknowledged segment."
+                if (m_congestion_control->in_fast_recovery())
+                    m_congestion_control->on_partial_ack(acked_bytes);
+                else
+                    m_congestion_control->on_ack(acked_bytes, m_smoothed_round_trip_time, now);
+                retransmit_first_lost_packet();
+            } else {
+                m_recovery_point.clear();
+                if (m_congestion_control->in_fast_recovery())
+                    m_congestion_control->on_recovery_complete();
+                else if (acked_bytes > 0)
+                    m_congestion_control->on_ack(acked_bytes, m_smoothed_round_trip_time, now);
+            }
+        } else if (is_duplicate_ack) {
+            ++m_duplicate_acks_received;
+            if (m_congestion_control->in_fast_recovery()) {
+                m_congestion_control->on_duplicate_ack_in_fast_recovery();
+            } else if (m_duplicate_acks_received == fast_retransmit_threshold && !m_recovery_point.has_value()) {
+                dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket({}) got {} duplicate ACKs for {}, doing a fast retransmit", this, m_duplicate_acks_received, ack_number);
+                m_recovery_point = m_sequence_number;
+                m_congestion_control->on_fast_retransmit(bytes_in_flight, now);
+                ++m_fast_retransmits;
+                retransmit_first_lost_packet();
+            }
+        }
+
+        if (removed > 0 || window_changed)
+            evaluate_block_conditions();
     }
 
     m_packets_in++;
     m_bytes_in += packet.header_size() + size;
 }
 
+void TCPSocket::mark_sacked_packets(UnackedPackets& unacked_packets, TCPPacket const& tcp_packet)
+{
+    tcp_packet.for_each_option([&](auto const& option) {
+        if (option.kind() != TCPOptionKind::SACK)
+            return;
+        auto const& sack_option = static_cast<TCPOptionSACK const&>(option);
+        for (size_t i = 0; i < sack_option.block_count(); ++i) {
+            auto block = sack_option.block(i);
+            u32 left_edge = block.left_edge;
+            u32 right_edge = block.right_edge;
+            for (auto& packet : unacked_packets.packets) {
+                if (packet.is_sacked || packet.payload_size == 0)
+                    continue;
+                if (tcp_sequence_number_before(packet.sequence_number, left_edge) || tcp_sequence_number_before(right_edge, packet.ack_number))
+                    continue;
+                packet.is_sacked = true;
+                unacked_packets.sacked_size += packet.payload_size;
+            }
+        }
+    });
+}
+
+void TCPSocket::update_retransmit_timeout(Duration round_trip_time)
+{
+    i64 sample = round_trip_time.to_microseconds();
+    i64 smoothed = m_smoothed_round_trip_time.to_microseconds();
+    i64 variance = m_round_trip_time_variance.to_microseconds();
+
+    if (!m_has_round_trip_time_sample) {
+        // RFC 6298 (2.2): "SRTT <- R, RTTVAR <- R/2"
+        smoothed = sample;
+        variance = sample / 2;
+        m_has_round_trip_time_sample = true;
+    } else {
+        // RFC 6298 (2.3): "RTTVAR <- (1 - beta) * RTTVAR + beta * |SRTT - R'|, SRTT <- (1 - alpha) * SRTT + alpha * R'"
+        // with alpha=1/8 and beta=1/4.
+        i64 difference = smoothed > sample ? smoothed - sample : sample - smoothed;
+        variance = (3 * variance + difference) / 4;
+        smoothed = (7 * smoothed + sample) / 8;
+    }
+
+    m_smoothed_round_trip_time = Duration::from_microseconds(smoothed);
+    m_round_trip_time_variance = Duration::from_microseconds(variance);
+
+    // RFC 6298 (2.3): "RTO <- SRTT + max (G, K*RTTVAR)" with K=4, and (2.4) rounded up to 1 second.
+    auto timeout = m_smoothed_round_trip_time + max(retransmit_timer_granularity, Duration::from_microseconds(4 * variance));
+    m_retransmit_timeout = clamp(timeout, minimum_retransmit_timeout, maximum_retransmit_timeout);
+}
+
+size_t TCPSocket::usable_send_window() const
+{
+    return m_unacked_packets.with_shared([&](auto const& unacked_packets) -> size_t {
+        size_t window = min<size_t>(m_send_window_size, m_congestion_control->congestion_window());
+        auto bytes_in_flight = unacked_packets.bytes_in_flight();
+        return window > bytes_in_flight ? window - bytes_in_flight : 0;
+    });
+}
+
 bool TCPSocket::should_delay_next_ack() const
 {
     // FIXME: We don't know the MSS here so make a reasonable guess.
@@ -413,7 +565,7 @@ bool TCPSocket::should_delay_next_ack() const
     return true;
 }
 
-NetworkOrdered<u16> TCPSocket::compute_tcp_checksum(IPv4Address const& source, IPv4Address const& destination, TCPPacket const& packet, u16 payload_size)
+static u32 tcp_pseudo_header_checksum(IPv4Address const& source, IPv4Address const& destination, u16 tcp_length)
 {
     union PseudoHeader {
         struct [[gnu::packed]] {
@@ -427,11 +579,7 @@ NetworkOrdered<u16> TCPSocket::compute_tcp_checksum(IPv4Address const& source, I
     };
     static_assert(sizeof(PseudoHeader) == 12);
 
-    Checked<u16> packet_size = packet.header_size();
-    packet_size += payload_size;
-    VERIFY(!packet_size.has_overflow());
-
-    PseudoHeader pseudo_header { .header = { source, destination, 0, (u8)IPv4Protocol::TCP, packet_size.value() } };
+    PseudoHeader pseudo_header { .header = { source, destination, 0, (u8)IPv4Protocol::TCP, tcp_length } };
 
     u32 checksum = 0;
     auto* raw_pseudo_header = pseudo_header.raw;
@@ -440,6 +588,16 @@ NetworkOrdered<u16> TCPSocket::compute_tcp_checksum(IPv4Address const& source, I
         if (checksum > 0xffff)
             checksum = (checksum >> 16) + (checksum & 0xffff);
     }
+    return checksum;
+}
+
+NetworkOrdered<u16> TCPSocket::compute_tcp_checksum(IPv4Address const& source, IPv4Address const& destination, TCPPacket const& packet, u16 payload_size)
+{
+    Checked<u16> packet_size = packet.header_size();
+    packet_size += payload_size;
+    VERIFY(!packet_size.has_overflow());
+
+    u32 checksum = tcp_pseudo_header_checksum(source, destination, packet_size.value());
     auto* raw_packet = bit_cast<u16*>(&packet);
     for (size_t i = 0; i < packet.header_size() / sizeof(u16); ++i) {
         checksum += AK::convert_between_host_and_network_endian(raw_packet[i]);
@@ -462,10 +620,27 @@ NetworkOrdered<u16> TCPSocket::compute_tcp_checksum(IPv4Address const& source, I
     return ~(checksum & 0xffff);
 }
 
-ErrorOr<void> TCPSocket::setsockopt(int level, int option, Userspace<void const*> user_value, socklen_t user_value_size)
+PacketOffload TCPSocket::fill_in_tcp_checksum(NetworkAdapter const& adapter, IPv4Address const& source, IPv4Address const& destination, TCPPacket& packet, u16 payload_size)
+{
+    packet.set_checksum(0);
+    if (!adapter.has_tcp_checksum_offload()) {
+        packet.set_checksum(compute_tcp_checksum(source, destination, packet, payload_size));
+        return {};
+    }
+
+    // NOTE: The adapter sums up everything from the TCP header onwards on top of what's in the checksum field,
+    //       so that has to be the (not inverted) checksum of the pseudo header.
+    Checked<u16> packet_size = packet.header_size();
+    packet_size += payload_size;
+    VERIFY(!packet_size.has_overflow());
+    packet.set_checksum(static_cast<u16>(tcp_pseudo_header_checksum(source, destination, packet_size.value())));
+    return { .needs_tcp_checksum = true };
+}
+
+ErrorOr<void> TCPSocket::setsockopt(OpenFileDescription& description, int level, int option, Userspace<void const*> user_value, socklen_t user_value_size)
 {
     if (level != IPPROTO_TCP)
-        return IPv4Socket::setsockopt(level, option, user_value, user_value_size);
+        return IPv4Socket::setsockopt(description, level, option, user_value, user_value_size);
 
     MutexLocker locker(mutex());
 
@@ -479,6 +654,19 @@ ErrorOr<void> TCPSocket::setsockopt(int level, int option, Userspace<void const*
             return EINVAL;
         m_no_delay = value;
         return {};
+    case TCP_CONGESTION: {
+        if (user_value_size == 0)
+            return EINVAL;
+        auto name = TRY(Process::get_syscall_name_string_fixed_buffer<TCP_CA_NAME_MAX>(static_ptr_cast<char const*>(user_value), min<size_t>(user_value_size, TCP_CA_NAME_MAX)));
+        auto algorithm = TCPCongestionControl::algorithm_from_name(name.representable_view());
+        if (!algorithm.has_value())
+            return ENOENT;
+        if (*algorithm == m_congestion_control->algorithm())
+            return {};
+        // NOTE: Like other systems, we simply start over with the new algorithm.
+        m_congestion_control = TRY(TCPCongestionControl::try_create(*algorithm, m_congestion_control->maximum_segment_size()));
+        return {};
+    }
     default:
         dbgln("setsockopt({}) at IPPROTO_TCP not implemented.", option);
         return ENOPROTOOPT;
@@ -504,6 +692,17 @@ ErrorOr<void> TCPSocket::getsockopt(OpenFileDescription& description, int level,
         size = sizeof(nodelay);
         return copy_to_user(value_size, &size);
     }
+    case TCP_CONGESTION: {
+        auto name = m_congestion_control->name();
+        if (size < name.length() + 1)
+            return EINVAL;
+        char buffer[TCP_CA_NAME_MAX] {};
+        bool did_fit = name.copy_characters_to_buffer(buffer, sizeof(buffer));
+        VERIFY(did_fit);
+        TRY(copy_to_user(static_ptr_cast<char*>(value), buffer, name.length() + 1));
+        size = name.length() + 1;
+        return copy_to_user(value_size, &size);
+    }
     default:
         dbgln("getsockopt({}) at IPPROTO_TCP not implemented.", option);
         return ENOPROTOOPT;
@@ -702,13 +901,14 @@ void TCPSocket::retransmit_packets()
 {
     auto now = TimeManagement::the().monotonic_time();
 
-    // RFC6298 says we should have at least one second between retransmits. According to
+    // RFC 6298 (5.5): "The host MUST set RTO <- RTO * 2 ("back off the timer")". According to
     // RFC1122 we must do exponential backoff - even for SYN packets.
-    i64 retransmit_interval = 1;
-    for (decltype(m_retransmit_attempts) i = 0; i < m_retransmit_attempts; i++)
-        retransmit_interval *= 2;
+    auto retransmit_interval = m_retransmit_timeout;
+    for (decltype(m_retransmit_attempts) i = 0; i < m_retransmit_attempts && retransmit_interval < maximum_retransmit_timeout; i++)
+        retransmit_interval += retransmit_interval;
+    retransmit_interval = min(retransmit_interval, maximum_retransmit_timeout);
 
-    if (m_last_retransmit_time > now - Duration::from_seconds(retransmit_interval))
+    if (m_last_retransmit_time > now - retransmit_interval)
         return;
 
     dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket({}) handling retransmit", this);
@@ -723,47 +923,88 @@ void TCPSocket::retransmit_packets()
         return;
     }
 
+    // NOTE: Later timeouts for the same data must not lower the slow start threshold any further.
+    if (m_retransmit_attempts == 1) {
+        auto bytes_in_flight = m_unacked_packets.with_shared([](auto const& unacked_packets) { return unacked_packets.bytes_in_flight(); });
+        m_congestion_control->on_retransmit_timeout(bytes_in_flight, now);
+        m_recovery_point = m_sequence_number;
+        m_duplicate_acks_received = 0;
+    }
+
+    // RFC 6298 (5.4): "Retransmit the earliest segment that has not been acknowledged by the TCP receiver."
+    // The others follow as partial ACKs come in, see receive_tcp_packet().
+    retransmit_first_lost_packet();
+}
+
+void TCPSocket::retransmit_first_lost_packet()
+{
     auto adapter = bound_interface().with([](auto& bound_device) -> RefPtr<NetworkAdapter> { return bound_device; });
-    auto routing_decision = route_to(peer_address(), local_address(), adapter);
+    auto routing_decision = m_route_cache.route_to(peer_address(), local_address(), adapter);
     if (routing_decision.is_zero())
         return;
 
+    // FIXME: Use the SACK scoreboard to retransmit every hole at once, as in RFC 6675.
     m_unacked_packets.with_exclusive([&](auto& unacked_packets) {
         for (auto& packet : unacked_packets.packets) {
-            packet.tx_counter++;
-
-            if constexpr (TCP_SOCKET_DEBUG) {
-                auto& tcp_packet = *(TCPPacket const*)(packet.buffer->buffer->data() + packet.ipv4_payload_offset);
-                dbgln("Sending TCP packet from {}:{} to {}:{} with ({}{}{}{}) seq_no={}, ack_no={}, tx_counter={}",
-                    local_address(), local_port(),
-                    peer_address(), peer_port(),
-                    (tcp_packet.has_syn() ? "SYN " : ""),
-                    (tcp_packet.has_ack() ? "ACK " : ""),
-                    (tcp_packet.has_fin() ? "FIN " : ""),
-                    (tcp_packet.has_rst() ? "RST " : ""),
-                    tcp_packet.sequence_number(),
-                    tcp_packet.ack_number(),
-                    packet.tx_counter);
-            }
+            if (packet.is_sacked)
+                continue;
+            retransmit_packet(packet, routing_decision);
+            return;
+        }
+    });
+}
 
-            size_t ipv4_payload_offset = routing_decision.adapter->ipv4_payload_offset();
-            if (ipv4_payload_offset != packet.ipv4_payload_offset) {
-                // FIXME: Add support for this. This can happen if after a route change
-                // we ended up on another adapter which doesn't have the same layer 2 type
-                // like the previous adapter.
-                VERIFY_NOT_REACHED();
-            }
+void TCPSocket::retransmit_packet(OutgoingPacket& packet, RoutingDecision const& routing_decision)
+{
+    packet.tx_counter++;
+    m_retransmits++;
 
-            auto packet_buffer = packet.buffer->bytes();
+    if constexpr (TCP_SOCKET_DEBUG) {
+        auto& tcp_packet = *(TCPPacket const*)(packet.buffer->buffer->data() + packet.ipv4_payload_offset);
+        dbgln("Sending TCP packet from {}:{} to {}:{} with ({}{}{}{}) seq_no={}, ack_no={}, tx_counter={}",
+            local_address(), local_port(),
+            peer_address(), peer_port(),
+            (tcp_packet.has_syn() ? "SYN " : ""),
+            (tcp_packet.has_ack() ? "ACK " : ""),
+            (tcp_packet.has_fin() ? "FIN " : ""),
+            (tcp_packet.has_rst() ? "RST " : ""),
+            tcp_packet.sequence_number(),
+            tcp_packet.ack_number(),
+            packet.tx_counter);
+    }
 
-            routing_decision.adapter->fill_in_ipv4_header(*packet.buffer,
-                local_address(), routing_decision.next_hop, peer_address(),
-                IPv4Protocol::TCP, packet_buffer.size() - ipv4_payload_offset, type_of_service(), ttl());
-            routing_decision.adapter->send_packet(packet_buffer);
-            m_packets_out++;
-            m_bytes_out += packet_buffer.size();
-        }
-    });
+    size_t ipv4_payload_offset = routing_decision.adapter->ipv4_payload_offset();
+    if (ipv4_payload_offset != packet.ipv4_payload_offset) {
+        // FIXME: Add support for this. This can happen if after a route change
+        // we ended up on another adapter which doesn't have the same layer 2 type
+        // like the previous adapter.
+        VERIFY_NOT_REACHED();
+    }
+
+    auto packet_buffer = packet.buffer->bytes();
+    auto& tcp_packet = *(TCPPacket*)(packet.buffer->buffer->data() + ipv4_payload_offset);
+
+    // NOTE: A segment that was sent with segmentation offload is retransmitted as a whole, even if only
+    //       one of the segments the adapter split it into got lost.
+    size_t mss = routing_decision.adapter->mtu() - sizeof(IPv4Packet) - tcp_packet.header_size();
+    bool needs_segmentation = packet.payload_size > mss;
+    if (needs_segmentation && routing_decision.adapter->tcp_segmentation_offload_size() < packet.payload_size) {
+        // FIXME: Split the segment up ourselves. This can happen if after a route change
+        // we ended up on an adapter without segmentation offload.
+        dbgln("TCPSocket: Can't retransmit segment of {} bytes through {}", packet.payload_size, routing_decision.adapter->name());
+        return;
+    }
+
+    routing_decision.adapter->fill_in_ipv4_header(*packet.buffer,
+        local_address(), routing_decision.next_hop, peer_address(),
+        IPv4Protocol::TCP, packet_buffer.size() - ipv4_payload_offset, type_of_service(), ttl());
+    // NOTE: The new route may go through an adapter that computes checksums differently.
+    auto offload = fill_in_tcp_checksum(*routing_decision.adapter, local_address(), peer_address(), tcp_packet, packet.payload_size);
+    if (needs_segmentation)
+        offload.tcp_segment_size = mss;
+    routing_decision.adapter->send_packet(packet_buffer, offload);
+    m_packets_out++;
+    m_bytes_out += packet_buffer.size();
 }
 
 bool TCPSocket::can_write(OpenFileDescription const& file_description, u64 size) const
@@ -777,8 +1018,6 @@ bool TCPSocket::can_write(OpenFileDescription const& file_description, u64 size)
     if (!file_description.is_blocking())
         return true;
 
-    return m_unacked_packets.with_shared([&](auto& unacked_packets) {
-        return unacked_packets.size + size <= m_send_window_size;
-    });
+    return usable_send_window() > 0;
 }
 }
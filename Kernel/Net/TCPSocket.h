@@ -10,11 +10,13 @@
 #include <AK/Function.h>
 #include <AK/HashMap.h>
 #include <AK/IntegralMath.h>
+#include <AK/NumericLimits.h>
 #include <AK/SinglyLinkedList.h>
 #include <AK/Time.h>
 #include <Kernel/Library/LockWeakPtr.h>
 #include <Kernel/Locking/MutexProtected.h>
 #include <Kernel/Net/IPv4Socket.h>
+#include <Kernel/Net/TCPCongestionControl.h>
 #include <Kernel/Time/TimerQueue.h>
 
 namespace Kernel {
@@ -136,6 +138,15 @@ public:
     u32 bytes_in() const { return m_bytes_in; }
     u32 packets_out() const { return m_packets_out; }
     u32 bytes_out() const { return m_bytes_out; }
+    u32 retransmits() const { return m_retransmits; }
+    u32 fast_retransmits() const { return m_fast_retransmits; }
+
+    TCPCongestionControl const& congestion_control() const { return *m_congestion_control; }
+    Duration smoothed_round_trip_time() const { return m_smoothed_round_trip_time; }
+    Duration retransmit_timeout() const { return m_retransmit_timeout; }
+    u32 send_window_size() const { return m_send_window_size; }
+    bool is_sack_permitted() const { return m_sack_permitted; }
+    void set_sack_permitted(bool sack_permitted) { m_sack_permitted = sack_permitted; }
 
     void set_send_window_scale(size_t scale)
     {
@@ -148,6 +159,14 @@ public:
     void set_duplicate_acks(u32 acks) { m_duplicate_acks = acks; }
     u32 duplicate_acks() const { return m_duplicate_acks; }
 
+    // RFC 5681 (3.2): "The fast retransmit algorithm uses the arrival of 3 duplicate ACKs [...] as an
+    //  indication that a segment has been lost."
+    static constexpr u32 fast_retransmit_threshold = 3;
+
+    // NOTE: The IPv4 length field limits how much a segment handed to segmentation offload can carry,
+    //       60 bytes is the largest possible TCP header.
+    static constexpr size_t maximum_offloaded_segment_size = NumericLimits<u16>::max() - sizeof(IPv4Packet) - 60;
+
     ErrorOr<void> send_ack(bool allow_duplicate = false);
     ErrorOr<void> send_tcp_packet(u16 flags, UserOrKernelBuffer const* = nullptr, size_t = 0, RoutingDecision* = nullptr);
     void receive_tcp_packet(TCPPacket const&, u16 size);
@@ -172,15 +191,17 @@ public:
     virtual bool can_write(OpenFileDescription const&, u64) const override;
 
     static NetworkOrdered<u16> compute_tcp_checksum(IPv4Address const& source, IPv4Address const& destination, TCPPacket const&, u16 payload_size);
+    // Fills in the checksum as far as the adapter wants it for sending, and returns what is left for the adapter to do.
+    static PacketOffload fill_in_tcp_checksum(NetworkAdapter const&, IPv4Address const& source, IPv4Address const& destination, TCPPacket&, u16 payload_size);
 
-    virtual ErrorOr<void> setsockopt(int level, int option, Userspace<void const*>, socklen_t) override;
+    virtual ErrorOr<void> setsockopt(OpenFileDescription&, int level, int option, Userspace<void const*>, socklen_t) override;
     virtual ErrorOr<void> getsockopt(OpenFileDescription&, int level, int option, Userspace<void*>, Userspace<socklen_t*>) override;
 
 protected:
     void set_direction(Direction direction) { m_direction = direction; }
 
 private:
-    explicit TCPSocket(int protocol, NonnullOwnPtr<DoubleBuffer> receive_buffer, NonnullOwnPtr<KBuffer> scratch_buffer, NonnullRefPtr<Timer> timer);
+    explicit TCPSocket(int protocol, NonnullOwnPtr<DoubleBuffer> receive_buffer, NonnullOwnPtr<KBuffer> scratch_buffer, NonnullRefPtr<Timer> timer, NonnullOwnPtr<TCPCongestionControl>);
     virtual StringView class_name() const override { return "TCPSocket"sv; }
 
     virtual void shut_down_for_writing() override;
@@ -198,6 +219,12 @@ private:
     void enqueue_for_retransmit();
     void dequeue_for_retransmit();
 
+    struct UnackedPackets;
+    void mark_sacked_packets(UnackedPackets&, TCPPacket const&);
+    void retransmit_first_lost_packet();
+    void update_retransmit_timeout(Duration round_trip_time);
+    size_t usable_send_window() const;
+
     static constexpr size_t receive_window_scale()
     {
         auto buffer_size_bit_length = AK::log2(receive_buffer_size) + 1;
@@ -225,16 +252,29 @@ private:
         size_t ipv4_payload_offset;
         LockWeakPtr<NetworkAdapter> adapter;
         int tx_counter { 0 };
+        u32 sequence_number { 0 };
+        size_t payload_size { 0 };
+        MonotonicTime sent_time;
+        // The peer told us it has this packet with a SACK block, so it doesn't need to be retransmitted.
+        bool is_sacked { false };
     };
 
     struct UnackedPackets {
         SinglyLinkedList<OutgoingPacket> packets;
         size_t size { 0 };
+        size_t sacked_size { 0 };
+
+        // RFC 5681 (2): "FLIGHT SIZE: The amount of data that has been sent but not yet cumulatively
+        //  acknowledged." Data that was selectively acknowledged has left the network as well.
+        size_t bytes_in_flight() const { return size - sacked_size; }
     };
 
+    void retransmit_packet(OutgoingPacket&, RoutingDecision const&);
+
     MutexProtected<UnackedPackets> m_unacked_packets;
 
     u32 m_duplicate_acks { 0 };
+    u32 m_duplicate_acks_received { 0 };
 
     u32 m_last_ack_number_sent { 0 };
     MonotonicTime m_last_ack_sent_time;
@@ -245,6 +285,25 @@ private:
     static constexpr u32 maximum_retransmits = 5;
     MonotonicTime m_last_retransmit_time;
     u32 m_retransmit_attempts { 0 };
+    u32 m_retransmits { 0 };
+    u32 m_fast_retransmits { 0 };
+
+    // RFC 6298 (2): The retransmission timeout is derived from the smoothed round trip time and its variance.
+    static constexpr Duration initial_retransmit_timeout = Duration::from_seconds(1);
+    static constexpr Duration minimum_retransmit_timeout = Duration::from_seconds(1);
+    static constexpr Duration maximum_retransmit_timeout = Duration::from_seconds(60);
+    // NOTE: The network task looks for packets to retransmit at least this often.
+    static constexpr Duration retransmit_timer_granularity = Duration::from_milliseconds(500);
+    Duration m_smoothed_round_trip_time;
+    Duration m_round_trip_time_variance;
+    Duration m_retransmit_timeout { initial_retransmit_timeout };
+    bool m_has_round_trip_time_sample { false };
+
+    NonnullOwnPtr<TCPCongestionControl> m_congestion_control;
+    // RFC 6582 (3.2): The highest sequence number that was sent when we started recovering from a loss.
+    // Until it is acknowledged, each partial ACK means that another segment was lost.
+    Optional<u32> m_recovery_point;
+    bool m_sack_permitted { false };
 
     // Default to maximum window size. receive_tcp_packet() will update from the
     // peer's advertised window size.
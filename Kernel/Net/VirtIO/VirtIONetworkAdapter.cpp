@@ -4,9 +4,14 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/ScopeGuard.h>
+#include <Kernel/Arch/Delay.h>
+#include <Kernel/Arch/Processor.h>
 #include <Kernel/Bus/PCI/IDs.h>
 #include <Kernel/Bus/VirtIO/Transport/PCIe/TransportLink.h>
+#include <Kernel/Net/EtherType.h>
 #include <Kernel/Net/NetworkingManagement.h>
+#include <Kernel/Net/TCP.h>
 #include <Kernel/Net/VirtIO/VirtIONetworkAdapter.h>
 
 namespace Kernel {
@@ -40,16 +45,16 @@ static constexpr u64 VIRTIO_NET_F_HOST_USO = (1ull << 56);           // Device c
 static constexpr u64 VIRTIO_NET_F_HASH_REPORT = (1ull << 57);        // Device can report per-packet hash value and a type of calculated hash.
 static constexpr u64 VIRTIO_NET_F_GUEST_HDRLEN = (1ull << 59);       // Driver can provide the exact hdr_len value.
 static constexpr u64 VIRTIO_NET_F_RSS = (1ull << 60);                // Device supports RSS with Toeplitz hash calculation
-static constexpr u64 VIRTIO_NET_F_RSC_EXT = (1ull << 21);            // Device can process duplicated ACKs and report number of coalesced segments and duplicated ACKs.
-static constexpr u64 VIRTIO_NET_F_STANDBY = (1ull << 63);            // Device may act as a standby for a primary device with the same MAC address.
+static constexpr u64 VIRTIO_NET_F_RSC_EXT = (1ull << 61);            // Device can process duplicated ACKs and report number of coalesced segments and duplicated ACKs.
+static constexpr u64 VIRTIO_NET_F_STANDBY = (1ull << 62);            // Device may act as a standby for a primary device with the same MAC address.
 static constexpr u64 VIRTIO_NET_F_SPEED_DUPLEX = (1ull << 63);       // Device reports speed and duplex.
 
 static constexpr u16 VIRTIO_NET_S_LINK_UP = 1;
 static constexpr u16 VIRTIO_NET_S_ANNOUNCE = 2;
 
 static constexpr u8 VIRTIO_NET_HDR_F_NEEDS_CSUM = 1;
-static constexpr u8 VIRTIO_NET_HDR_F_DATA_VALID = 1;
-static constexpr u8 VIRTIO_NET_HDR_F_RSC_INFO = 1;
+static constexpr u8 VIRTIO_NET_HDR_F_DATA_VALID = 2;
+static constexpr u8 VIRTIO_NET_HDR_F_RSC_INFO = 4;
 static constexpr u8 VIRTIO_NET_HDR_GSO_NONE = 0;
 static constexpr u8 VIRTIO_NET_HDR_GSO_TCPV4 = 1;
 static constexpr u8 VIRTIO_NET_HDR_GSO_UDP = 3;
@@ -57,6 +62,14 @@ static constexpr u8 VIRTIO_NET_HDR_GSO_TCPV6 = 4;
 static constexpr u8 VIRTIO_NET_HDR_GSO_UDP_L4 = 5;
 static constexpr u8 VIRTIO_NET_HDR_GSO_ECN = 0x80;
 
+static constexpr u8 VIRTIO_NET_OK = 0;
+static constexpr u8 VIRTIO_NET_ERR = 1;
+
+static constexpr u8 VIRTIO_NET_CTRL_MQ = 4;
+static constexpr u8 VIRTIO_NET_CTRL_MQ_VQ_PAIRS_SET = 0;
+static constexpr u16 VIRTIO_NET_CTRL_MQ_VQ_PAIRS_MIN = 1;
+static constexpr u16 VIRTIO_NET_CTRL_MQ_VQ_PAIRS_MAX = 0x8000;
+
 struct [[gnu::packed]] VirtIONetConfig {
     u8 mac[6];
     LittleEndian<u16> status;
@@ -80,16 +93,24 @@ struct [[gnu::packed]] VirtIONetHdr {
     u8 frame[0];
 };
 
+struct [[gnu::packed]] VirtIONetCtrlHdr {
+    u8 command_class;
+    u8 command;
+};
+
+struct [[gnu::packed]] VirtIONetCtrlMQ {
+    LittleEndian<u16> virtqueue_pairs;
+};
+
 }
 
 using namespace VirtIO;
 
-static constexpr u16 RECEIVEQ = 0;
-static constexpr u16 TRANSMITQ = 1;
-
 static constexpr size_t MAX_RX_FRAME_SIZE = 1514; // Non-jumbo Ethernet frame limit.
-static constexpr size_t RX_BUFFER_SIZE = sizeof(VirtIONetHdr) * MAX_RX_FRAME_SIZE;
 static constexpr u16 MAX_INFLIGHT_PACKETS = 128;
+// NOTE: With segmentation offload, a single frame can be up to 64 KiB, so we need a lot more room to keep a few of them in flight.
+static constexpr size_t TX_BUFFER_SIZE_WITH_SEGMENTATION_OFFLOAD = 512 * KiB;
+static constexpr size_t CONTROL_COMMAND_TIMEOUT_MICROSECONDS = 10000;
 
 UNMAP_AFTER_INIT ErrorOr<bool> VirtIONetworkAdapter::probe(PCI::DeviceIdentifier const& pci_device_identifier)
 {
@@ -115,9 +136,6 @@ UNMAP_AFTER_INIT VirtIONetworkAdapter::VirtIONetworkAdapter(StringView interface
 
 UNMAP_AFTER_INIT ErrorOr<void> VirtIONetworkAdapter::initialize(Badge<NetworkingManagement>)
 {
-    m_rx_buffers = TRY(Memory::RingBuffer::try_create("VirtIONetworkAdapter Rx buffer"sv, RX_BUFFER_SIZE * MAX_INFLIGHT_PACKETS));
-    m_tx_buffers = TRY(Memory::RingBuffer::try_create("VirtIONetworkAdapter Tx buffer"sv, RX_BUFFER_SIZE * MAX_INFLIGHT_PACKETS));
-
     return initialize_virtio_resources();
 }
 
@@ -137,27 +155,119 @@ UNMAP_AFTER_INIT ErrorOr<void> VirtIONetworkAdapter::initialize_virtio_resources
             negotiated |= VIRTIO_NET_F_SPEED_DUPLEX;
         if (is_feature_set(supported_features, VIRTIO_NET_F_MTU))
             negotiated |= VIRTIO_NET_F_MTU;
+        // NOTE: Additional queue pairs have to be enabled through the control queue.
+        if (is_feature_set(supported_features, VIRTIO_NET_F_CTRL_VQ | VIRTIO_NET_F_MQ))
+            negotiated |= VIRTIO_NET_F_CTRL_VQ | VIRTIO_NET_F_MQ;
+        if (is_feature_set(supported_features, VIRTIO_NET_F_CSUM)) {
+            negotiated |= VIRTIO_NET_F_CSUM;
+            // The spec says that VIRTIO_NET_F_HOST_TSO4 requires VIRTIO_NET_F_CSUM.
+            if (is_feature_set(supported_features, VIRTIO_NET_F_HOST_TSO4))
+                negotiated |= VIRTIO_NET_F_HOST_TSO4;
+        }
+        // FIXME: Negotiate VIRTIO_NET_F_GUEST_CSUM and VIRTIO_NET_F_GUEST_TSO4 once the stack verifies checksums
+        //        of received packets and can take frames that are larger than the MTU.
         return negotiated;
     }));
+    m_has_checksum_offload = is_feature_accepted(VIRTIO_NET_F_CSUM);
+    m_has_tcp_segmentation_offload = is_feature_accepted(VIRTIO_NET_F_HOST_TSO4);
 
     TRY(handle_device_config_change());
-    TRY(setup_queues(2)); // receive & transmit
+
+    size_t max_queue_pairs = 1;
+    if (is_feature_accepted(VIRTIO_NET_F_MQ)) {
+        max_queue_pairs = transport_entity().config_read16(*m_device_config, offsetof(VirtIONetConfig, max_virtqueue_pairs));
+        if (max_queue_pairs < VIRTIO_NET_CTRL_MQ_VQ_PAIRS_MIN || max_queue_pairs > VIRTIO_NET_CTRL_MQ_VQ_PAIRS_MAX) {
+            dmesgln("VirtIONetworkAdapter: Device reported an invalid number of queue pairs: {}", max_queue_pairs);
+            return Error::from_errno(ENXIO);
+        }
+    }
+
+    // NOTE: The control queue comes after all receive and transmit queues the device has, even the ones we don't use.
+    size_t queue_count = max_queue_pairs * 2;
+    if (is_feature_accepted(VIRTIO_NET_F_CTRL_VQ))
+        m_control_queue_index = queue_count++;
+    if (queue_count > NumericLimits<u16>::max())
+        return Error::from_errno(ENXIO);
+    TRY(setup_queues(queue_count));
+
+    // There's no point in having more queues than processors to process them.
+    size_t queue_pair_count = min(max_queue_pairs, min<size_t>(Processor::count(), NetworkAdapter::max_receive_queues));
+    m_rx_buffer_size = sizeof(VirtIONetHdr) + max(MAX_RX_FRAME_SIZE, mtu() + sizeof(EthernetFrameHeader));
+    size_t tx_buffer_size = m_has_tcp_segmentation_offload ? TX_BUFFER_SIZE_WITH_SEGMENTATION_OFFLOAD : m_rx_buffer_size * MAX_INFLIGHT_PACKETS;
+    for (size_t i = 0; i < queue_pair_count; ++i) {
+        auto rx_buffers = TRY(Memory::RingBuffer::try_create("VirtIONetworkAdapter Rx buffer"sv, m_rx_buffer_size * MAX_INFLIGHT_PACKETS));
+        auto tx_buffers = TRY(Memory::RingBuffer::try_create("VirtIONetworkAdapter Tx buffer"sv, tx_buffer_size));
+        TRY(m_queue_pairs.try_append({ move(rx_buffers), move(tx_buffers) }));
+    }
+    if (m_control_queue_index.has_value())
+        m_control_buffer = TRY(MM.allocate_dma_buffer_page("VirtIONetworkAdapter Control buffer"sv, Memory::Region::Access::ReadWrite));
 
     finish_init();
 
-    {
+    for (size_t i = 0; i < m_queue_pairs.size(); ++i) {
         // Supply receive buffers.
-        auto& rx_queue = get_queue(RECEIVEQ);
+        auto& rx_buffers = *m_queue_pairs[i].rx_buffers;
+        auto& rx_queue = get_queue(receive_queue_index(i));
         SpinlockLocker queue_lock(rx_queue.lock());
         VirtIO::QueueChain chain(rx_queue);
-        while (m_rx_buffers->available_bytes() > RX_BUFFER_SIZE) {
+        while (rx_buffers.available_bytes() > m_rx_buffer_size) {
             // We know that the RingBuffer will not wraparound in this loop. But it's still awkward.
-            auto buffer_start = MUST(m_rx_buffers->reserve_space(RX_BUFFER_SIZE));
-            VERIFY(chain.add_buffer_to_chain(buffer_start, RX_BUFFER_SIZE, VirtIO::BufferType::DeviceWritable));
-            supply_chain_and_notify(RECEIVEQ, chain);
+            auto buffer_start = MUST(rx_buffers.reserve_space(m_rx_buffer_size));
+            VERIFY(chain.add_buffer_to_chain(buffer_start, m_rx_buffer_size, VirtIO::BufferType::DeviceWritable));
+            supply_chain_and_notify(receive_queue_index(i), chain);
         }
     }
 
+    if (m_queue_pairs.size() > 1) {
+        // NOTE: The device only uses the first pair until we tell it otherwise. Afterwards, it delivers the packets
+        //       of a flow to the receive queue that belongs to the transmit queue it last saw that flow on.
+        VirtIONetCtrlMQ command { static_cast<u16>(m_queue_pairs.size()) };
+        auto result = send_control_command(VIRTIO_NET_CTRL_MQ, VIRTIO_NET_CTRL_MQ_VQ_PAIRS_SET, { reinterpret_cast<u8 const*>(&command), sizeof(command) });
+        if (result.is_error())
+            dmesgln("VirtIONetworkAdapter: Failed to enable {} queue pairs: {}", m_queue_pairs.size(), result.error());
+        else
+            m_active_queue_pair_count = m_queue_pairs.size();
+    }
+    dbgln_if(VIRTIO_DEBUG, "VirtIONetworkAdapter: Using {} queue pairs, checksum offload: {}, segmentation offload: {}", m_active_queue_pair_count, m_has_checksum_offload, m_has_tcp_segmentation_offload);
+
+    return {};
+}
+
+ErrorOr<void> VirtIONetworkAdapter::send_control_command(u8 command_class, u8 command, ReadonlyBytes data)
+{
+    VERIFY(m_control_queue_index.has_value());
+    size_t request_size = sizeof(VirtIONetCtrlHdr) + data.size();
+    VERIFY(request_size + sizeof(u8) <= m_control_buffer->size());
+
+    auto* buffer = m_control_buffer->vaddr().as_ptr();
+    VirtIONetCtrlHdr header { command_class, command };
+    memcpy(buffer, &header, sizeof(header));
+    memcpy(buffer + sizeof(header), data.data(), data.size());
+    auto& ack = buffer[request_size];
+    ack = VIRTIO_NET_ERR;
+
+    // NOTE: Commands are rare and the device answers them right away, so we just poll for the answer.
+    auto& queue = get_queue(*m_control_queue_index);
+    queue.disable_interrupts();
+    SpinlockLocker lock(queue.lock());
+    VirtIO::QueueChain chain { queue };
+    auto buffer_start = m_control_buffer->physical_page(0)->paddr();
+    chain.add_buffer_to_chain(buffer_start, request_size, VirtIO::BufferType::DeviceReadable);
+    chain.add_buffer_to_chain(buffer_start.offset(request_size), sizeof(u8), VirtIO::BufferType::DeviceWritable);
+    supply_chain_and_notify(*m_control_queue_index, chain);
+    full_memory_barrier();
+    ScopeGuard clear_used_buffers([&] {
+        queue.discard_used_buffers();
+    });
+    size_t current_time = 0;
+    while (!queue.new_data_available()) {
+        if (current_time++ >= CONTROL_COMMAND_TIMEOUT_MICROSECONDS)
+            return Error::from_errno(EBUSY);
+        microseconds_delay(1);
+    }
+    full_memory_barrier();
+    if (ack != VIRTIO_NET_OK)
+        return Error::from_errno(EIO);
     return {};
 }
 
@@ -196,40 +306,60 @@ void VirtIONetworkAdapter::handle_queue_update(u16 queue_index)
 {
     dbgln_if(VIRTIO_DEBUG, "VirtIONetworkAdapter: handle_queue_update {}", queue_index);
 
-    if (queue_index == RECEIVEQ) {
-        // FIXME: Disable interrupts while receiving as recommended by the spec.
-        auto& queue = get_queue(RECEIVEQ);
-        SpinlockLocker queue_lock(queue.lock());
-        size_t used;
-        VirtIO::QueueChain popped_chain = queue.pop_used_buffer_chain(used);
-
-        while (!popped_chain.is_empty()) {
-            VERIFY(popped_chain.length() == 1);
-            popped_chain.for_each([&](PhysicalAddress addr, size_t length) {
-                size_t offset = addr.as_ptr() - m_rx_buffers->start_of_region().as_ptr();
-                auto* message = reinterpret_cast<VirtIONetHdr*>(m_rx_buffers->vaddr().offset(offset).as_ptr());
-                did_receive({ message->frame, length - sizeof(VirtIONetHdr) });
-            });
-
-            supply_chain_and_notify(RECEIVEQ, popped_chain);
-            popped_chain = queue.pop_used_buffer_chain(used);
-        }
-    } else if (queue_index == TRANSMITQ) {
-        auto& queue = get_queue(TRANSMITQ);
-        SpinlockLocker queue_lock(queue.lock());
-        SpinlockLocker ringbuffer_lock(m_tx_buffers->lock());
-
-        size_t used;
-        VirtIO::QueueChain popped_chain = queue.pop_used_buffer_chain(used);
-        do {
-            popped_chain.for_each([this](PhysicalAddress address, size_t length) {
-                m_tx_buffers->reclaim_space(address, length);
-            });
-            popped_chain.release_buffer_slots_to_queue();
-            popped_chain = queue.pop_used_buffer_chain(used);
-        } while (!popped_chain.is_empty());
-    } else {
+    // NOTE: Answers on the control queue are polled for in send_control_command().
+    if (m_control_queue_index == queue_index)
+        return;
+
+    size_t pair_index = queue_index / 2;
+    if (pair_index >= m_queue_pairs.size()) {
         dmesgln("VirtIONetworkAdapter: unexpected update for queue {}", queue_index);
+        return;
+    }
+    if (queue_index == receive_queue_index(pair_index))
+        receive_from_queue_pair(pair_index);
+    else
+        reclaim_transmitted_buffers(pair_index);
+}
+
+void VirtIONetworkAdapter::receive_from_queue_pair(size_t pair_index)
+{
+    // FIXME: Disable interrupts while receiving as recommended by the spec.
+    auto& rx_buffers = *m_queue_pairs[pair_index].rx_buffers;
+    auto& queue = get_queue(receive_queue_index(pair_index));
+    SpinlockLocker queue_lock(queue.lock());
+    size_t used;
+    VirtIO::QueueChain popped_chain = queue.pop_used_buffer_chain(used);
+
+    while (!popped_chain.is_empty()) {
+        VERIFY(popped_chain.length() == 1);
+        popped_chain.for_each([&](PhysicalAddress addr, size_t length) {
+            size_t offset = addr.as_ptr() - rx_buffers.start_of_region().as_ptr();
+            auto* message = reinterpret_cast<VirtIONetHdr*>(rx_buffers.vaddr().offset(offset).as_ptr());
+            // NOTE: The device already steered the flow to this queue, but did_receive() hashes the flow again
+            //       to pick one of the network task's queues.
+            did_receive({ message->frame, length - sizeof(VirtIONetHdr) });
+        });
+
+        supply_chain_and_notify(receive_queue_index(pair_index), popped_chain);
+        popped_chain = queue.pop_used_buffer_chain(used);
+    }
+}
+
+void VirtIONetworkAdapter::reclaim_transmitted_buffers(size_t pair_index)
+{
+    auto& tx_buffers = *m_queue_pairs[pair_index].tx_buffers;
+    auto& queue = get_queue(transmit_queue_index(pair_index));
+    SpinlockLocker queue_lock(queue.lock());
+    SpinlockLocker ringbuffer_lock(tx_buffers.lock());
+
+    size_t used;
+    VirtIO::QueueChain popped_chain = queue.pop_used_buffer_chain(used);
+    while (!popped_chain.is_empty()) {
+        popped_chain.for_each([&](PhysicalAddress address, size_t length) {
+            tx_buffers.reclaim_space(address, length);
+        });
+        popped_chain.release_buffer_slots_to_queue();
+        popped_chain = queue.pop_used_buffer_chain(used);
     }
 }
 
@@ -252,27 +382,71 @@ static bool copy_data_to_chain(VirtIO::QueueChain& chain, Memory::RingBuffer& ri
     return true;
 }
 
+// Returns where the TCP header starts if this is an IPv4 TCP frame.
+static Optional<size_t> tcp_header_offset(ReadonlyBytes frame)
+{
+    if (frame.size() < sizeof(EthernetFrameHeader) + sizeof(IPv4Packet))
+        return {};
+    auto const& eth = *reinterpret_cast<EthernetFrameHeader const*>(frame.data());
+    if (eth.ether_type() != EtherType::IPv4)
+        return {};
+    auto const& ipv4 = *static_cast<IPv4Packet const*>(eth.payload());
+    if (ipv4.protocol() != to_underlying(IPv4Protocol::TCP))
+        return {};
+    size_t offset = sizeof(EthernetFrameHeader) + ipv4.internet_header_length() * sizeof(u32);
+    if (frame.size() < offset + sizeof(TCPPacket))
+        return {};
+    return offset;
+}
+
 void VirtIONetworkAdapter::send_raw(ReadonlyBytes payload)
+{
+    send_raw_with_offload(payload, {});
+}
+
+void VirtIONetworkAdapter::send_raw_with_offload(ReadonlyBytes payload, PacketOffload const& offload)
 {
     dbgln_if(VIRTIO_DEBUG, "VirtIONetworkAdapter: send_raw length={}", payload.size());
 
-    auto& queue = get_queue(TRANSMITQ);
+    VirtIONetHdr hdr {};
+    if (offload.needs_tcp_checksum || offload.tcp_segment_size != 0) {
+        auto tcp_offset = tcp_header_offset(payload);
+        if (!tcp_offset.has_value()) {
+            dbgln("VirtIONetworkAdapter: Dropping packet with TCP offloads that isn't a TCP packet");
+            return;
+        }
+        // The device sums up everything from csum_start to the end of the frame, and stores the result
+        // at csum_start + csum_offset, which is where the TCP checksum field is.
+        hdr.flags = VIRTIO_NET_HDR_F_NEEDS_CSUM;
+        hdr.csum_start = static_cast<u16>(tcp_offset.value());
+        hdr.csum_offset = 16;
+        if (offload.tcp_segment_size != 0) {
+            auto const& tcp_packet = *reinterpret_cast<TCPPacket const*>(payload.offset(tcp_offset.value()));
+            hdr.gso_type = VIRTIO_NET_HDR_GSO_TCPV4;
+            hdr.gso_size = offload.tcp_segment_size;
+            hdr.hdr_len = static_cast<u16>(tcp_offset.value() + tcp_packet.header_size());
+        }
+    }
+
+    // NOTE: Senders on different processors use different queues, so they don't contend for the same lock.
+    size_t pair_index = Processor::current_id() % m_active_queue_pair_count;
+    auto& tx_buffers = *m_queue_pairs[pair_index].tx_buffers;
+    auto& queue = get_queue(transmit_queue_index(pair_index));
     SpinlockLocker queue_lock(queue.lock());
     VirtIO::QueueChain chain(queue);
 
-    SpinlockLocker ringbuffer_lock(m_tx_buffers->lock());
-    if (m_tx_buffers->available_bytes() < sizeof(VirtIONetHdr) + payload.size()) {
+    SpinlockLocker ringbuffer_lock(tx_buffers.lock());
+    if (tx_buffers.available_bytes() < sizeof(VirtIONetHdr) + payload.size()) {
         // We can drop packets that don't fit to apply back pressure on eager senders.
         dmesgln("VirtIONetworkAdapter: not enough space in the buffer. Dropping packet");
         return;
     }
 
     // FIXME: Handle errors from pushing to the chain and rewind the RingBuffer.
-    VirtIONetHdr hdr {};
-    VERIFY(copy_data_to_chain(chain, *m_tx_buffers, reinterpret_cast<u8*>(&hdr), sizeof(hdr)));
-    VERIFY(copy_data_to_chain(chain, *m_tx_buffers, payload.data(), payload.size()));
+    VERIFY(copy_data_to_chain(chain, tx_buffers, reinterpret_cast<u8*>(&hdr), sizeof(hdr)));
+    VERIFY(copy_data_to_chain(chain, tx_buffers, payload.data(), payload.size()));
 
-    supply_chain_and_notify(TRANSMITQ, chain);
+    supply_chain_and_notify(transmit_queue_index(pair_index), chain);
 }
 
 }
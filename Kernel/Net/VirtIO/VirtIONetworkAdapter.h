@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <AK/NumericLimits.h>
+#include <AK/Vector.h>
 #include <Kernel/Bus/VirtIO/Device.h>
 #include <Kernel/Memory/RingBuffer.h>
 #include <Kernel/Net/NetworkAdapter.h>
@@ -33,6 +35,9 @@ public:
     virtual bool link_full_duplex() override { return m_link_duplex; }
     virtual i32 link_speed() override { return m_link_speed; }
 
+    virtual bool has_tcp_checksum_offload() const override { return m_has_checksum_offload; }
+    virtual size_t tcp_segmentation_offload_size() const override { return m_has_tcp_segmentation_offload ? NumericLimits<u16>::max() : 0; }
+
 private:
     explicit VirtIONetworkAdapter(StringView interface_name, NonnullOwnPtr<VirtIO::TransportEntity>);
 
@@ -42,6 +47,16 @@ private:
 
     // NetworkAdapter
     virtual void send_raw(ReadonlyBytes) override;
+    virtual void send_raw_with_offload(ReadonlyBytes, PacketOffload const&) override;
+
+    void receive_from_queue_pair(size_t pair_index);
+    void reclaim_transmitted_buffers(size_t pair_index);
+
+    ErrorOr<void> send_control_command(u8 command_class, u8 command, ReadonlyBytes data);
+
+    // NOTE: Each pair has a receive queue at index 2N and a transmit queue at 2N+1.
+    static constexpr u16 receive_queue_index(size_t pair_index) { return pair_index * 2; }
+    static constexpr u16 transmit_queue_index(size_t pair_index) { return pair_index * 2 + 1; }
 
 private:
     VirtIO::Configuration const* m_device_config { nullptr };
@@ -52,8 +67,20 @@ private:
     i32 m_link_speed { LINKSPEED_INVALID };
     bool m_link_duplex { false };
 
-    OwnPtr<Memory::RingBuffer> m_rx_buffers;
-    OwnPtr<Memory::RingBuffer> m_tx_buffers;
+    bool m_has_checksum_offload { false };
+    bool m_has_tcp_segmentation_offload { false };
+
+    struct QueuePair {
+        NonnullOwnPtr<Memory::RingBuffer> rx_buffers;
+        NonnullOwnPtr<Memory::RingBuffer> tx_buffers;
+    };
+    Vector<QueuePair> m_queue_pairs;
+    // The number of pairs the device actually uses, which can be less than we have buffers for if switching to multiqueue failed.
+    size_t m_active_queue_pair_count { 1 };
+    size_t m_rx_buffer_size { 0 };
+
+    Optional<u16> m_control_queue_index;
+    OwnPtr<Memory::Region> m_control_buffer;
 };
 
 }
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Checked.h>
+#include <AK/NumericLimits.h>
+#include <Kernel/FileSystem/Inode.h>
+#include <Kernel/FileSystem/OpenFileDescription.h>
+#include <Kernel/Library/KBuffer.h>
+#include <Kernel/Tasks/Process.h>
+
+namespace Kernel {
+
+// NOTE: Both ends are regular files, so we can afford much larger chunks than sendfile() without
+//       holding up a reader on the other end of a pipe.
+static constexpr size_t copy_file_range_chunk_size = 1 * MiB;
+
+ErrorOr<FlatPtr> Process::sys$copy_file_range(Userspace<Syscall::SC_copy_file_range_params const*> user_params)
+{
+    VERIFY_PROCESS_BIG_LOCK_ACQUIRED(this);
+    TRY(require_promise(Pledge::stdio));
+    auto params = TRY(copy_typed_from_user(user_params));
+
+    if (params.flags != 0)
+        return EINVAL;
+
+    auto in_description = TRY(open_file_description(params.fd_in));
+    if (!in_description->is_readable())
+        return EBADF;
+    auto out_description = TRY(open_file_description(params.fd_out));
+    if (!out_description->is_writable() || out_description->should_append())
+        return EBADF;
+    if (in_description->is_directory() || out_description->is_directory())
+        return EISDIR;
+    if (!in_description->file().is_regular_file() || !out_description->file().is_regular_file())
+        return EINVAL;
+
+    if (params.count == 0)
+        return 0;
+    auto count = min(params.count, static_cast<size_t>(NumericLimits<ssize_t>::max()));
+
+    Userspace<off_t*> user_offset_in((FlatPtr)params.offset_in);
+    Userspace<off_t*> user_offset_out((FlatPtr)params.offset_out);
+    off_t offset_in = user_offset_in ? TRY(copy_typed_from_user(user_offset_in)) : in_description->offset();
+    off_t offset_out = user_offset_out ? TRY(copy_typed_from_user(user_offset_out)) : out_description->offset();
+    if (offset_in < 0 || offset_out < 0)
+        return EINVAL;
+
+    Checked<off_t> end_in = offset_in;
+    end_in += count;
+    Checked<off_t> end_out = offset_out;
+    end_out += count;
+    if (end_in.has_overflow() || end_out.has_overflow())
+        return EOVERFLOW;
+
+    // Copying a file onto an overlapping range of itself would read back data we just wrote.
+    if (in_description->inode() == out_description->inode() && offset_in < end_out.value() && offset_out < end_in.value())
+        return EINVAL;
+
+    auto buffer = TRY(KBuffer::try_create_with_size("copy_file_range"sv, min(count, copy_file_range_chunk_size)));
+    auto kernel_buffer = UserOrKernelBuffer::for_kernel_buffer(buffer->data());
+
+    size_t total_copied = 0;
+    while (total_copied < count) {
+        auto chunk_size = min(count - total_copied, buffer->size());
+        auto nread_or_error = in_description->read(kernel_buffer, offset_in + total_copied, chunk_size);
+        if (nread_or_error.is_error()) {
+            if (total_copied > 0)
+                break;
+            return nread_or_error.release_error();
+        }
+        auto nread = nread_or_error.release_value();
+        if (nread == 0)
+            break;
+
+        auto nwritten_or_error = out_description->write(offset_out + total_copied, kernel_buffer, nread);
+        if (nwritten_or_error.is_error()) {
+            if (total_copied > 0)
+                break;
+            return nwritten_or_error.release_error();
+        }
+        auto nwritten = nwritten_or_error.release_value();
+        total_copied += nwritten;
+        if (nwritten < nread)
+            break;
+    }
+
+    // Offsets given by the caller are updated in place, otherwise the file offsets move like they would for read() and write().
+    if (user_offset_in) {
+        off_t new_offset = offset_in + total_copied;
+        TRY(copy_to_user(user_offset_in, &new_offset));
+    } else {
+        TRY(in_description->seek(offset_in + total_copied, SEEK_SET));
+    }
+    if (user_offset_out) {
+        off_t new_offset = offset_out + total_copied;
+        TRY(copy_to_user(user_offset_out, &new_offset));
+    } else {
+        TRY(out_description->seek(offset_out + total_copied, SEEK_SET));
+    }
+    return total_copied;
+}
+
+}
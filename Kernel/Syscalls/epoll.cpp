@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/API/POSIX/sys/epoll.h>
+#include <Kernel/FileSystem/EventPoll.h>
+#include <Kernel/FileSystem/OpenFileDescription.h>
+#include <Kernel/Tasks/Process.h>
+
+namespace Kernel {
+
+using BlockFlags = Thread::FileBlocker::BlockFlags;
+
+// NOTE: This bounds the kernel buffer that epoll_wait() collects events into, callers that ask
+//       for more than this just get them over multiple calls.
+static constexpr int max_events_per_wait = 1024;
+
+ErrorOr<FlatPtr> Process::sys$epoll_create1(int flags)
+{
+    VERIFY_NO_PROCESS_BIG_LOCK(this);
+    TRY(require_promise(Pledge::stdio));
+
+    if (flags & ~EPOLL_CLOEXEC)
+        return EINVAL;
+
+    auto event_poll = TRY(EventPoll::try_create());
+    auto description = TRY(OpenFileDescription::try_create(move(event_poll)));
+    description->set_readable(true);
+
+    return m_fds.with_exclusive([&](auto& fds) -> ErrorOr<FlatPtr> {
+        auto fd_allocation = TRY(fds.allocate());
+        fds[fd_allocation.fd].set(move(description), (flags & EPOLL_CLOEXEC) ? FD_CLOEXEC : 0);
+        return fd_allocation.fd;
+    });
+}
+
+ErrorOr<FlatPtr> Process::sys$epoll_ctl(int epfd, int op, int fd, Userspace<epoll_event const*> user_event)
+{
+    VERIFY_NO_PROCESS_BIG_LOCK(this);
+    TRY(require_promise(Pledge::stdio));
+
+    auto event_poll_description = TRY(open_file_description(epfd));
+    if (!event_poll_description->is_event_poll())
+        return EINVAL;
+    auto& event_poll = *event_poll_description->event_poll();
+    auto description = TRY(open_file_description(fd));
+    if (description.ptr() == event_poll_description.ptr())
+        return EINVAL;
+
+    switch (op) {
+    case EPOLL_CTL_ADD: {
+        auto event = TRY(copy_typed_from_user(user_event));
+        TRY(event_poll.add(fd, *description, event));
+        return 0;
+    }
+    case EPOLL_CTL_MOD: {
+        auto event = TRY(copy_typed_from_user(user_event));
+        TRY(event_poll.modify(fd, event));
+        return 0;
+    }
+    case EPOLL_CTL_DEL:
+        TRY(event_poll.remove(fd));
+        return 0;
+    default:
+        return EINVAL;
+    }
+}
+
+ErrorOr<FlatPtr> Process::sys$epoll_wait(int epfd, Userspace<epoll_event*> user_events, int max_events, int timeout_ms)
+{
+    VERIFY_NO_PROCESS_BIG_LOCK(this);
+    TRY(require_promise(Pledge::stdio));
+
+    if (max_events <= 0)
+        return EINVAL;
+
+    auto description = TRY(open_file_description(epfd));
+    if (!description->is_event_poll())
+        return EINVAL;
+    auto& event_poll = *description->event_poll();
+
+    Vector<epoll_event> events;
+    TRY(events.try_resize(min(max_events, max_events_per_wait)));
+
+    Thread::BlockTimeout timeout;
+    if (timeout_ms >= 0) {
+        auto timeout_duration = Duration::from_milliseconds(timeout_ms);
+        timeout = Thread::BlockTimeout(false, &timeout_duration);
+    }
+
+    while (true) {
+        auto count = event_poll.collect_ready_events(events.span());
+        if (count > 0) {
+            TRY(copy_n_to_user(user_events, events.data(), count));
+            return count;
+        }
+        if (timeout_ms == 0)
+            return 0;
+
+        // NOTE: The EventPoll becomes readable once one of its entries might be ready. That can turn out
+        //       to be a false alarm, in which case we just go back to waiting until the same deadline.
+        auto unblock_flags = BlockFlags::None;
+        auto block_result = Thread::current()->block<Thread::ReadBlocker>(timeout, *description, unblock_flags);
+        if (block_result.was_interrupted())
+            return EINTR;
+        if (block_result == Thread::BlockResult::InterruptedByTimeout)
+            return 0;
+    }
+}
+
+}
@@ -169,7 +169,12 @@ ErrorOr<FlatPtr> Process::sys$fork(RegisterState& regs)
             for (auto& region : parent_space->region_tree().regions()) {
                 dbgln_if(FORK_DEBUG, "fork: cloning Region '{}' @ {}", region.name(), region.vaddr());
                 auto region_clone = TRY(region.try_clone());
-                TRY(region_clone->map(child_space->page_directory(), Memory::ShouldFlushTLB::No));
+                // NOTE: Most children exec() right away and only ever touch a handful of their pages,
+                //       so we let the page fault handler fill in their page tables on demand.
+                if (region_clone->can_be_mapped_lazily())
+                    region_clone->set_page_directory(child_space->page_directory());
+                else
+                    TRY(region_clone->map(child_space->page_directory(), Memory::ShouldFlushTLB::No));
                 TRY(child_space->region_tree().place_specifically(*region_clone, region.range()));
                 (void)region_clone.leak_ptr();
             }
@@ -5,6 +5,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Array.h>
 #include <AK/Singleton.h>
 #include <Kernel/Debug.h>
 #include <Kernel/Memory/InodeVMObject.h>
@@ -13,23 +14,34 @@
 
 namespace Kernel {
 
-static Singleton<SpinlockProtected<HashMap<GlobalFutexKey, NonnullLockRefPtr<FutexQueue>>, LockRank::None>> s_global_futex_queues;
+// NOTE: The futex queues are spread over a number of buckets by their key, so that threads using
+//       unrelated futexes don't all have to fight over a single lock.
+static constexpr size_t futex_bucket_count = 256;
+using FutexBucket = SpinlockProtected<HashMap<GlobalFutexKey, NonnullLockRefPtr<FutexQueue>>, LockRank::None>;
+static Singleton<Array<FutexBucket, futex_bucket_count>> s_futex_buckets;
+
+static FutexBucket& futex_bucket_for(GlobalFutexKey const& futex_key)
+{
+    return s_futex_buckets->at(Traits<GlobalFutexKey>::hash(futex_key) % futex_bucket_count);
+}
 
 void Process::clear_futex_queues_on_exec()
 {
-    s_global_futex_queues->with([this](auto& queues) {
-        auto const* address_space = this->address_space().with([](auto& space) { return space.ptr(); });
-        queues.remove_all_matching([address_space](auto& futex_key, auto& futex_queue) {
-            if ((futex_key.raw.offset & futex_key_private_flag) == 0)
-                return false;
-            if (futex_key.private_.address_space != address_space)
-                return false;
-            bool did_wake_all;
-            futex_queue->wake_all(did_wake_all);
-            VERIFY(did_wake_all); // No one should be left behind...
-            return true;
+    auto const* address_space = this->address_space().with([](auto& space) { return space.ptr(); });
+    for (auto& bucket : *s_futex_buckets) {
+        bucket.with([address_space](auto& queues) {
+            queues.remove_all_matching([address_space](auto& futex_key, auto& futex_queue) {
+                if ((futex_key.raw.offset & futex_key_private_flag) == 0)
+                    return false;
+                if (futex_key.private_.address_space != address_space)
+                    return false;
+                bool did_wake_all;
+                futex_queue->wake_all(did_wake_all);
+                VERIFY(did_wake_all); // No one should be left behind...
+                return true;
+            });
         });
-    });
+    }
 }
 
 ErrorOr<GlobalFutexKey> Process::get_futex_key(FlatPtr user_address, bool shared)
@@ -97,17 +109,19 @@ ErrorOr<FlatPtr> Process::sys$futex(Userspace<Syscall::SC_futex_params const*> u
     u32 cmd = params.futex_op & FUTEX_CMD_MASK;
 
     bool use_realtime_clock = (params.futex_op & FUTEX_CLOCK_REALTIME) != 0;
-    if (use_realtime_clock && cmd != FUTEX_WAIT && cmd != FUTEX_WAIT_BITSET) {
+    if (use_realtime_clock && cmd != FUTEX_WAIT && cmd != FUTEX_WAIT_BITSET && cmd != FUTEX_LOCK_PI) {
         return ENOSYS;
     }
+    // NOTE: The timeout of FUTEX_LOCK_PI is always measured against the realtime clock.
+    if (cmd == FUTEX_LOCK_PI)
+        use_realtime_clock = true;
 
     bool shared = (params.futex_op & FUTEX_PRIVATE_FLAG) == 0;
 
     switch (cmd) {
     case FUTEX_WAIT:
     case FUTEX_WAIT_BITSET:
-    case FUTEX_REQUEUE:
-    case FUTEX_CMP_REQUEUE: {
+    case FUTEX_LOCK_PI: {
         if (params.timeout) {
             auto timeout_time = TRY(copy_time_from_user(params.timeout));
             bool is_absolute = cmd != FUTEX_WAIT;
@@ -126,7 +140,7 @@ ErrorOr<FlatPtr> Process::sys$futex(Userspace<Syscall::SC_futex_params const*> u
 
     auto find_futex_queue = [&](GlobalFutexKey futex_key, bool create_if_not_found, bool* did_create = nullptr) -> ErrorOr<LockRefPtr<FutexQueue>> {
         VERIFY(!create_if_not_found || did_create != nullptr);
-        return s_global_futex_queues->with([&](auto& queues) -> ErrorOr<LockRefPtr<FutexQueue>> {
+        return futex_bucket_for(futex_key).with([&](auto& queues) -> ErrorOr<LockRefPtr<FutexQueue>> {
             auto it = queues.find(futex_key);
             if (it != queues.end())
                 return it->value;
@@ -141,7 +155,7 @@ ErrorOr<FlatPtr> Process::sys$futex(Userspace<Syscall::SC_futex_params const*> u
     };
 
     auto remove_futex_queue = [&](GlobalFutexKey futex_key) {
-        return s_global_futex_queues->with([&](auto& queues) {
+        return futex_bucket_for(futex_key).with([&](auto& queues) {
             auto it = queues.find(futex_key);
             if (it == queues.end())
                 return;
@@ -218,16 +232,26 @@ ErrorOr<FlatPtr> Process::sys$futex(Userspace<Syscall::SC_futex_params const*> u
         if (!futex_queue)
             return 0;
 
+        auto futex_key2 = TRY(get_futex_key(user_address2, shared));
+        // NOTE: Moving waiters to the futex they're already waiting on doesn't do anything.
+        if (Traits<GlobalFutexKey>::equals(futex_key, futex_key2))
+            return TRY(do_wake(user_address, params.val, {}));
+
         LockRefPtr<FutexQueue> target_futex_queue;
         bool is_empty = false;
         bool is_target_empty = false;
-        auto futex_key2 = TRY(get_futex_key(user_address2, shared));
         auto woken_or_requeued = TRY(futex_queue->wake_n_requeue(
             params.val, [&]() -> ErrorOr<FutexQueue*> {
                 // NOTE: futex_queue's lock is being held while this callback is called
                 // The reason we're doing this in a callback is that we don't want to always
                 // create a target queue, only if we actually have anything to move to it!
-                target_futex_queue = TRY(find_futex_queue(futex_key2, true));
+                // The target queue is returned with an imminent wait, which keeps it from being removed before
+                // the waiters arrive there.
+                bool did_create;
+                do {
+                    did_create = false;
+                    target_futex_queue = TRY(find_futex_queue(futex_key2, true, &did_create));
+                } while (!did_create && !target_futex_queue->queue_imminent_wait());
                 return target_futex_queue.ptr();
             },
             params.val2, is_empty, is_target_empty));
@@ -238,6 +262,107 @@ ErrorOr<FlatPtr> Process::sys$futex(Userspace<Syscall::SC_futex_params const*> u
         return woken_or_requeued;
     };
 
+    // Takes the priority inheritance futex if nobody owns it, and returns the owner otherwise (or 0 if we took it).
+    // When we're going to wait for it, we also have to tell the owner to wake us up when it lets go.
+    auto try_to_take_pi_futex = [&](bool will_wait) -> ErrorOr<u32> {
+        u32 tid = Thread::current()->tid().value();
+        for (;;) {
+            auto user_value = user_atomic_load_relaxed(params.userspace_address);
+            if (!user_value.has_value())
+                return EFAULT;
+            u32 value = user_value.value();
+            u32 owner = value & FUTEX_TID_MASK;
+            u32 new_value;
+            if (owner == 0) {
+                // NOTE: If we had to wait for it, there may still be others waiting as well.
+                new_value = tid | (will_wait ? FUTEX_WAITERS : (value & FUTEX_WAITERS));
+            } else if (owner == tid) {
+                return EDEADLK;
+            } else if (!will_wait || (value & FUTEX_WAITERS)) {
+                return owner;
+            } else {
+                new_value = value | FUTEX_WAITERS;
+            }
+            auto did_exchange = user_atomic_compare_exchange_relaxed(params.userspace_address, value, new_value);
+            if (!did_exchange.has_value())
+                return EFAULT;
+            if (!did_exchange.value())
+                continue;
+            if (owner == 0) {
+                atomic_thread_fence(AK::MemoryOrder::memory_order_acquire);
+                return 0;
+            }
+            return owner;
+        }
+    };
+
+    auto do_lock_pi = [&](bool only_try) -> ErrorOr<FlatPtr> {
+        auto futex_key = TRY(get_futex_key(user_address, shared));
+        if (TRY(try_to_take_pi_futex(false)) == 0)
+            return 0;
+        if (only_try)
+            return EAGAIN;
+
+        for (;;) {
+            bool did_create;
+            LockRefPtr<FutexQueue> futex_queue;
+            do {
+                did_create = false;
+                futex_queue = TRY(find_futex_queue(futex_key, true, &did_create));
+            } while (!did_create && !futex_queue->queue_imminent_wait());
+
+            // NOTE: We have to look at the generation before we look at the futex, see FutexQueue::pi_generation().
+            auto generation = futex_queue->pi_generation();
+            auto owner_or_error = try_to_take_pi_futex(true);
+            RefPtr<Thread> owner;
+            if (!owner_or_error.is_error() && owner_or_error.value() != 0)
+                owner = Thread::from_tid_in_same_jail(owner_or_error.value());
+            if (!owner) {
+                futex_queue->cancel_imminent_wait();
+                if (futex_queue->is_empty_and_no_imminent_waits())
+                    remove_futex_queue(futex_key);
+                if (owner_or_error.is_error())
+                    return owner_or_error.release_error();
+                if (owner_or_error.value() == 0)
+                    return 0;
+                // FIXME: Let the next thread have the futex if its owner died, like robust futexes do.
+                return ESRCH;
+            }
+
+            auto block_result = futex_queue->wait_on_pi_owner(timeout, *owner, generation);
+            if (futex_queue->is_empty_and_no_imminent_waits())
+                remove_futex_queue(futex_key);
+            if (block_result == Thread::BlockResult::InterruptedByTimeout)
+                return ETIMEDOUT;
+            if (block_result.was_interrupted())
+                return EINTR;
+        }
+    };
+
+    auto do_unlock_pi = [&]() -> ErrorOr<FlatPtr> {
+        auto futex_key = TRY(get_futex_key(user_address, shared));
+        auto user_value = user_atomic_load_relaxed(params.userspace_address);
+        if (!user_value.has_value())
+            return EFAULT;
+        if ((user_value.value() & FUTEX_TID_MASK) != Thread::current()->tid().value())
+            return EPERM;
+
+        atomic_thread_fence(AK::MemoryOrder::memory_order_release);
+        if (!user_atomic_exchange_relaxed(params.userspace_address, 0).has_value())
+            return EFAULT;
+        // FIXME: This also drops the priority we inherited through other futexes we're still holding.
+        Thread::current()->clear_inherited_priority();
+
+        auto futex_queue = TRY(find_futex_queue(futex_key, false));
+        if (!futex_queue)
+            return 0;
+        bool is_empty;
+        futex_queue->wake_pi_waiter(is_empty);
+        if (is_empty)
+            remove_futex_queue(futex_key);
+        return 0;
+    };
+
     switch (cmd) {
     case FUTEX_WAIT:
         return do_wait(0);
@@ -313,6 +438,15 @@ ErrorOr<FlatPtr> Process::sys$futex(Userspace<Syscall::SC_futex_params const*> u
     case FUTEX_CMP_REQUEUE:
         return do_requeue(params.val3);
 
+    case FUTEX_LOCK_PI:
+        return do_lock_pi(false);
+
+    case FUTEX_TRYLOCK_PI:
+        return do_lock_pi(true);
+
+    case FUTEX_UNLOCK_PI:
+        return do_unlock_pi();
+
     case FUTEX_WAIT_BITSET:
         VERIFY(params.val3 != FUTEX_BITSET_MATCH_ANY); // we should have turned it into FUTEX_WAIT
         if (params.val3 == 0)
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/API/IORing.h>
+#include <Kernel/FileSystem/IORing.h>
+#include <Kernel/FileSystem/OpenFileDescription.h>
+#include <Kernel/Tasks/Process.h>
+
+namespace Kernel {
+
+ErrorOr<FlatPtr> Process::sys$io_ring_setup(Userspace<io_ring_params*> user_params)
+{
+    VERIFY_NO_PROCESS_BIG_LOCK(this);
+    TRY(require_promise(Pledge::stdio));
+
+    auto params = TRY(copy_typed_from_user(user_params));
+    auto io_ring = TRY(IORing::try_create(*this, params));
+    auto description = TRY(OpenFileDescription::try_create(move(io_ring)));
+    // NOTE: The ring has to be mapped shared and writable, which mmap() only allows for writable descriptions.
+    description->set_readable(true);
+    description->set_writable(true);
+    TRY(copy_to_user(user_params, &params));
+
+    return m_fds.with_exclusive([&](auto& fds) -> ErrorOr<FlatPtr> {
+        auto fd_allocation = TRY(fds.allocate());
+        // NOTE: The ring refers to buffers in this program's address space, so it can't outlive an exec().
+        fds[fd_allocation.fd].set(move(description), FD_CLOEXEC);
+        return fd_allocation.fd;
+    });
+}
+
+ErrorOr<FlatPtr> Process::sys$io_ring_enter(int fd, u32 to_submit, u32 min_complete, u32 flags)
+{
+    VERIFY_PROCESS_BIG_LOCK_ACQUIRED(this);
+    TRY(require_promise(Pledge::stdio));
+
+    if (flags & ~IO_RING_ENTER_GETEVENTS)
+        return EINVAL;
+
+    auto description = TRY(open_file_description(fd));
+    if (!description->is_io_ring())
+        return EINVAL;
+
+    return description->io_ring()->enter(*this, *description, to_submit, (flags & IO_RING_ENTER_GETEVENTS) ? min_complete : 0);
+}
+
+}
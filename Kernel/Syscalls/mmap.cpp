@@ -5,12 +5,14 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/ScopeGuard.h>
 #include <Kernel/API/VirtualMemoryAnnotations.h>
 #include <Kernel/Arch/CPU.h>
 #include <Kernel/Arch/PageDirectory.h>
 #include <Kernel/Arch/SafeMem.h>
 #include <Kernel/Arch/SmapDisabler.h>
 #include <Kernel/FileSystem/Custody.h>
+#include <Kernel/FileSystem/Inode.h>
 #include <Kernel/FileSystem/OpenFileDescription.h>
 #include <Kernel/Memory/AnonymousVMObject.h>
 #include <Kernel/Memory/MemoryManager.h>
@@ -28,6 +30,15 @@
 
 namespace Kernel {
 
+// Caps how much of a file a single MAP_POPULATE or MADV_WILLNEED will pull into the disk cache.
+static constexpr size_t max_hinted_readahead_size = 16 * MiB;
+
+static void schedule_readahead_for_mmap(Memory::InodeVMObject& vmobject, size_t first_page_index, size_t page_count)
+{
+    auto length = min(page_count * PAGE_SIZE, max_hinted_readahead_size);
+    vmobject.inode().schedule_readahead(static_cast<off_t>(first_page_index * PAGE_SIZE), length);
+}
+
 ErrorOr<void> Process::validate_mmap_prot(int prot, bool map_stack, bool map_anonymous, Memory::Region const* region) const
 {
     bool make_writable = prot & PROT_WRITE;
@@ -120,6 +131,7 @@ ErrorOr<FlatPtr> Process::sys$mmap(Userspace<Syscall::SC_mmap_params const*> use
     bool map_noreserve = flags & MAP_NORESERVE;
     bool map_randomized = flags & MAP_RANDOMIZED;
     bool map_fixed_noreplace = flags & MAP_FIXED_NOREPLACE;
+    bool map_populate = flags & MAP_POPULATE;
 
     if (map_shared && map_private)
         return EINVAL;
@@ -135,6 +147,12 @@ ErrorOr<FlatPtr> Process::sys$mmap(Userspace<Syscall::SC_mmap_params const*> use
     if (map_stack && (!map_private || !map_anonymous))
         return EINVAL;
 
+#if ARCH(X86_64)
+    // Large private anonymous mappings default to huge page alignment, so they can be backed by huge pages.
+    if (!params.alignment && map_anonymous && map_private && !(flags & MAP_PURGEABLE) && !(map_fixed || map_fixed_noreplace) && rounded_size >= Memory::huge_page_size)
+        alignment = Memory::huge_page_size;
+#endif
+
     Memory::VirtualRange requested_range { VirtualAddress { addr }, rounded_size };
     if (addr && !(map_fixed || map_fixed_noreplace)) {
         // If there's an address but MAP_FIXED wasn't specified, the address is just a hint.
@@ -149,6 +167,8 @@ ErrorOr<FlatPtr> Process::sys$mmap(Userspace<Syscall::SC_mmap_params const*> use
 
     if (map_anonymous) {
         auto strategy = map_noreserve ? AllocationStrategy::None : AllocationStrategy::Reserve;
+        if (map_populate)
+            strategy = AllocationStrategy::AllocateNow;
 
         if (flags & MAP_PURGEABLE) {
             vmobject = TRY(Memory::AnonymousVMObject::try_create_purgeable_with_size(rounded_size, strategy));
@@ -210,6 +230,10 @@ ErrorOr<FlatPtr> Process::sys$mmap(Userspace<Syscall::SC_mmap_params const*> use
 
         PerformanceManager::add_mmap_perf_event(*this, *region);
 
+        // For files, we can't block here while the pages are read in, but we can get the I/O going.
+        if (map_populate && region->vmobject().is_inode())
+            schedule_readahead_for_mmap(static_cast<Memory::InodeVMObject&>(region->vmobject()), region->first_page_index(), region->page_count());
+
         return region->vaddr().get();
     });
 }
@@ -264,7 +288,8 @@ ErrorOr<FlatPtr> Process::sys$mprotect(Userspace<void*> addr, size_t size, int p
             // Remove the old region from our regions tree, since were going to add another region
             // with the exact same start address.
             auto region = space->take_region(*old_region);
-            region->unmap();
+            region->unmap(Memory::ShouldFlushTLB::No);
+            ScopeGuard flush_tlb_guard = [&] { space->flush_tlb(region->range()); };
 
             // This vector is the region(s) adjacent to our range.
             // We need to allocate a new region for the range we wanted to change permission bits on.
@@ -278,9 +303,9 @@ ErrorOr<FlatPtr> Process::sys$mprotect(Userspace<void*> addr, size_t size, int p
 
             // Map the new regions using our page directory (they were just allocated and don't have one).
             for (auto* adjacent_region : adjacent_regions) {
-                TRY(adjacent_region->map(space->page_directory()));
+                TRY(adjacent_region->map(space->page_directory(), Memory::ShouldFlushTLB::No));
             }
-            TRY(new_region->map(space->page_directory()));
+            TRY(new_region->map(space->page_directory(), Memory::ShouldFlushTLB::No));
             return 0;
         }
 
@@ -302,6 +327,11 @@ ErrorOr<FlatPtr> Process::sys$mprotect(Userspace<void*> addr, size_t size, int p
             if (full_size_found != range_to_mprotect.size())
                 return ENOMEM;
 
+            // NOTE: Instead of flushing the TLB for every region we touch, flush all of them at once when we're done.
+            //       Intersecting regions are returned in address order.
+            Memory::VirtualRange range_to_flush { regions.first()->vaddr(), regions.last()->range().end().get() - regions.first()->vaddr().get() };
+            ScopeGuard flush_tlb_guard = [&] { space->flush_tlb(range_to_flush); };
+
             // Finally, iterate over each region, either updating its access flags if the range covers it wholly,
             // or carving out a new subregion with the appropriate access flags set.
             for (auto* old_region : regions) {
@@ -315,13 +345,13 @@ ErrorOr<FlatPtr> Process::sys$mprotect(Userspace<void*> addr, size_t size, int p
                     old_region->set_writable(prot & PROT_WRITE);
                     old_region->set_executable(prot & PROT_EXEC);
 
-                    old_region->remap();
+                    old_region->remap(Memory::ShouldFlushTLB::No);
                     continue;
                 }
                 // Remove the old region from our regions tree, since were going to add another region
                 // with the exact same start address.
                 auto region = space->take_region(*old_region);
-                region->unmap();
+                region->unmap(Memory::ShouldFlushTLB::No);
 
                 // This vector is the region(s) adjacent to our range.
                 // We need to allocate a new region for the range we wanted to change permission bits on.
@@ -340,9 +370,9 @@ ErrorOr<FlatPtr> Process::sys$mprotect(Userspace<void*> addr, size_t size, int p
 
                 // Map the new region using our page directory (they were just allocated and don't have one) if any.
                 if (adjacent_regions.size())
-                    TRY(adjacent_regions[0]->map(space->page_directory()));
+                    TRY(adjacent_regions[0]->map(space->page_directory(), Memory::ShouldFlushTLB::No));
 
-                TRY(new_region->map(space->page_directory()));
+                TRY(new_region->map(space->page_directory(), Memory::ShouldFlushTLB::No));
             }
 
             return 0;
@@ -366,14 +396,14 @@ ErrorOr<FlatPtr> Process::sys$madvise(Userspace<void*> address, size_t size, int
         return EFAULT;
 
     return address_space().with([&](auto& space) -> ErrorOr<FlatPtr> {
-        auto* region = space->find_region_from_range(range_to_madvise);
-        if (!region)
-            return EINVAL;
-        if (!region->is_mmap())
-            return EPERM;
-        if (region->is_immutable())
-            return EPERM;
         if (advice == MADV_SET_VOLATILE || advice == MADV_SET_NONVOLATILE) {
+            auto* region = space->find_region_from_range(range_to_madvise);
+            if (!region)
+                return EINVAL;
+            if (!region->is_mmap())
+                return EPERM;
+            if (region->is_immutable())
+                return EPERM;
             if (!region->vmobject().is_anonymous())
                 return EINVAL;
             auto& vmobject = static_cast<Memory::AnonymousVMObject&>(region->vmobject());
@@ -383,7 +413,42 @@ ErrorOr<FlatPtr> Process::sys$madvise(Userspace<void*> address, size_t size, int
             TRY(vmobject.set_volatile(advice == MADV_SET_VOLATILE, was_purged));
             return was_purged ? 1 : 0;
         }
-        return EINVAL;
+
+        // The remaining advice may also be given for only a part of a region.
+        auto* region = space->find_region_containing(range_to_madvise);
+        if (!region)
+            return EINVAL;
+        if (!region->is_mmap())
+            return EPERM;
+
+        auto first_page_index_in_vmobject = region->translate_to_vmobject_page(region->page_index_from_address(range_to_madvise.base()));
+        auto page_count = range_to_madvise.size() / PAGE_SIZE;
+
+        switch (advice) {
+        case MADV_NORMAL:
+        case MADV_SEQUENTIAL:
+        case MADV_RANDOM:
+            // Faults already detect sequential access on their own, so we only need to know when not to bother.
+            if (region->vmobject().is_inode())
+                static_cast<Memory::InodeVMObject&>(region->vmobject()).set_readahead_on_fault_enabled(advice != MADV_RANDOM);
+            return 0;
+        case MADV_WILLNEED:
+            if (region->vmobject().is_inode())
+                schedule_readahead_for_mmap(static_cast<Memory::InodeVMObject&>(region->vmobject()), first_page_index_in_vmobject, page_count);
+            return 0;
+        case MADV_DONTNEED: {
+            if (region->is_immutable())
+                return EPERM;
+            // Shared memory belongs to everyone mapping it, so we can't just throw away its contents.
+            if (!region->vmobject().is_anonymous() || region->is_shared())
+                return EINVAL;
+            auto& vmobject = static_cast<Memory::AnonymousVMObject&>(region->vmobject());
+            TRY(vmobject.discard_pages(first_page_index_in_vmobject, page_count));
+            return 0;
+        }
+        default:
+            return EINVAL;
+        }
     });
 }
 
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/NumericLimits.h>
+#include <Kernel/FileSystem/OpenFileDescription.h>
+#include <Kernel/Library/KBuffer.h>
+#include <Kernel/Tasks/Process.h>
+
+namespace Kernel {
+
+using BlockFlags = Thread::FileBlocker::BlockFlags;
+
+// NOTE: Data is moved through a kernel buffer of this size, and never has to make a trip through userspace.
+static constexpr size_t sendfile_chunk_size = 64 * KiB;
+
+ErrorOr<FlatPtr> Process::sys$sendfile(int out_fd, int in_fd, Userspace<off_t*> user_offset, size_t count)
+{
+    VERIFY_PROCESS_BIG_LOCK_ACQUIRED(this);
+    TRY(require_promise(Pledge::stdio));
+    if (count == 0)
+        return 0;
+    if (count > NumericLimits<ssize_t>::max())
+        return EINVAL;
+
+    auto in_description = TRY(open_file_description(in_fd));
+    if (!in_description->is_readable())
+        return EBADF;
+    if (in_description->is_directory())
+        return EISDIR;
+    auto out_description = TRY(open_file_description(out_fd));
+    if (!out_description->is_writable())
+        return EBADF;
+
+    bool input_is_seekable = in_description->file().is_seekable();
+    Optional<off_t> offset;
+    if (user_offset) {
+        if (!input_is_seekable)
+            return ESPIPE;
+        offset = TRY(copy_typed_from_user(user_offset));
+        if (offset.value() < 0)
+            return EINVAL;
+    }
+
+    // NOTE: Data that was read from a pipe or socket can't be put back, so it all has to be written out.
+    //       That would make a non-blocking output block, or lose data.
+    if (!input_is_seekable && !out_description->is_blocking())
+        return EINVAL;
+
+    auto buffer = TRY(KBuffer::try_create_with_size("sendfile"sv, min(count, sendfile_chunk_size)));
+    auto kernel_buffer = UserOrKernelBuffer::for_kernel_buffer(buffer->data());
+
+    size_t total_sent = 0;
+    while (total_sent < count) {
+        if (!in_description->can_read()) {
+            // Like read(), only wait for data if we have nothing to show for it yet.
+            if (total_sent > 0 || !in_description->is_blocking())
+                break;
+            auto unblock_flags = BlockFlags::None;
+            if (Thread::current()->block<Thread::ReadBlocker>({}, *in_description, unblock_flags).was_interrupted())
+                return EINTR;
+            if (!has_flag(unblock_flags, BlockFlags::Read))
+                return EAGAIN;
+        }
+
+        auto chunk_size = min(count - total_sent, buffer->size());
+        auto nread_or_error = offset.has_value()
+            ? in_description->read(kernel_buffer, offset.value() + total_sent, chunk_size)
+            : in_description->read(kernel_buffer, chunk_size);
+        if (nread_or_error.is_error()) {
+            if (total_sent > 0)
+                break;
+            return nread_or_error.release_error();
+        }
+        auto nread = nread_or_error.release_value();
+        if (nread == 0)
+            break;
+
+        auto nwritten_or_error = do_write(*out_description, kernel_buffer, nread);
+        size_t nwritten = nwritten_or_error.is_error() ? 0 : nwritten_or_error.value();
+        total_sent += nwritten;
+
+        if (nwritten < nread) {
+            // Give the part that didn't make it back to the input, so the next call picks it up again.
+            if (!offset.has_value() && input_is_seekable)
+                TRY(in_description->seek(-static_cast<off_t>(nread - nwritten), SEEK_CUR));
+            if (nwritten_or_error.is_error() && total_sent == 0)
+                return nwritten_or_error.release_error();
+            break;
+        }
+    }
+
+    if (offset.has_value()) {
+        off_t new_offset = offset.value() + total_sent;
+        TRY(copy_to_user(user_offset, &new_offset));
+    }
+    return total_sent;
+}
+
+}
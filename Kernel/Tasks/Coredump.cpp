@@ -211,9 +211,14 @@ ErrorOr<void> Coredump::write_program_headers(size_t notes_size)
     return {};
 }
 
+// NOTE: Regions are copied and written out this many pages at a time, so that dumping a large region
+//       doesn't need a kernel buffer as large as the region itself.
+static constexpr size_t region_copy_chunk_page_count = 64;
+
 ErrorOr<void> Coredump::write_regions()
 {
     u8 zero_buffer[PAGE_SIZE] = {};
+    auto buffer = TRY(KBuffer::try_create_with_size("Coredump Region Copy Buffer"sv, region_copy_chunk_page_count * PAGE_SIZE));
 
     for (auto& region : m_regions) {
         VERIFY(!region.is_kernel());
@@ -226,43 +231,50 @@ ErrorOr<void> Coredump::write_regions()
         if (region.access() == Memory::Region::Access::None)
             continue;
 
-        auto buffer = TRY(KBuffer::try_create_with_size("Coredump Region Copy Buffer"sv, region.page_count() * PAGE_SIZE));
-
-        TRY(m_process->address_space().with([&](auto& space) -> ErrorOr<void> {
-            auto* real_region = space->region_tree().regions().find(region.vaddr().get());
-
-            if (!real_region) {
-                dmesgln("Coredump::write_regions: Failed to find matching region in the process");
-                return Error::from_errno(EFAULT);
-            }
+        for (size_t first_page = 0; first_page < region.page_count(); first_page += region_copy_chunk_page_count) {
+            auto page_count = min(region_copy_chunk_page_count, region.page_count() - first_page);
+
+            TRY(m_process->address_space().with([&](auto& space) -> ErrorOr<void> {
+                auto* real_region = space->region_tree().regions().find(region.vaddr().get());
+
+                if (!real_region) {
+                    dmesgln("Coredump::write_regions: Failed to find matching region in the process");
+                    return Error::from_errno(EFAULT);
+                }
+
+                if (!region.is_consistent_with_region(*real_region)) {
+                    dmesgln("Coredump::write_regions: Found region does not match stored metadata");
+                    return Error::from_errno(EINVAL);
+                }
+
+                // If we crashed in the middle of mapping in Regions, they do not have a page directory yet, and will crash on a remap() call
+                if (!real_region->is_mapped()) {
+                    memset(buffer->data(), 0, page_count * PAGE_SIZE);
+                    return {};
+                }
+
+                if (first_page == 0) {
+                    real_region->set_readable(true);
+                    real_region->remap();
+                }
+
+                for (size_t i = 0; i < page_count; i++) {
+                    auto page_index = first_page + i;
+                    auto page = real_region->physical_page(page_index);
+                    auto src_buffer = [&]() -> ErrorOr<UserOrKernelBuffer> {
+                        if (page)
+                            return UserOrKernelBuffer::for_user_buffer(reinterpret_cast<uint8_t*>((region.vaddr().as_ptr() + (page_index * PAGE_SIZE))), PAGE_SIZE);
+                        // If the current page is not backed by a physical page, we zero it in the coredump file.
+                        return UserOrKernelBuffer::for_kernel_buffer(zero_buffer);
+                    }();
+                    TRY(src_buffer.value().read(buffer->bytes().slice(i * PAGE_SIZE, PAGE_SIZE)));
+                }
 
-            if (!region.is_consistent_with_region(*real_region)) {
-                dmesgln("Coredump::write_regions: Found region does not match stored metadata");
-                return Error::from_errno(EINVAL);
-            }
-
-            // If we crashed in the middle of mapping in Regions, they do not have a page directory yet, and will crash on a remap() call
-            if (!real_region->is_mapped())
                 return {};
+            }));
 
-            real_region->set_readable(true);
-            real_region->remap();
-
-            for (size_t i = 0; i < region.page_count(); i++) {
-                auto page = real_region->physical_page(i);
-                auto src_buffer = [&]() -> ErrorOr<UserOrKernelBuffer> {
-                    if (page)
-                        return UserOrKernelBuffer::for_user_buffer(reinterpret_cast<uint8_t*>((region.vaddr().as_ptr() + (i * PAGE_SIZE))), PAGE_SIZE);
-                    // If the current page is not backed by a physical page, we zero it in the coredump file.
-                    return UserOrKernelBuffer::for_kernel_buffer(zero_buffer);
-                }();
-                TRY(src_buffer.value().read(buffer->bytes().slice(i * PAGE_SIZE, PAGE_SIZE)));
-            }
-
-            return {};
-        }));
-
-        TRY(m_description->write(UserOrKernelBuffer::for_kernel_buffer(buffer->data()), buffer->size()));
+            TRY(m_description->write(UserOrKernelBuffer::for_kernel_buffer(buffer->data()), page_count * PAGE_SIZE));
+        }
     }
 
     return {};
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <Kernel/API/POSIX/futex.h>
 #include <Kernel/Debug.h>
 #include <Kernel/Tasks/FutexQueue.h>
 #include <Kernel/Tasks/Thread.h>
@@ -25,6 +26,17 @@ bool FutexQueue::should_add_blocker(Thread::Blocker& b, void*)
         dbgln_if(FUTEXQUEUE_DEBUG, "FutexQueue @ {}: should not block thread {}: was removed", this, b.thread());
         return false;
     }
+
+    auto& blocker = static_cast<Thread::FutexBlocker&>(b);
+    if (auto const& generation = blocker.pi_generation(); generation.has_value()) {
+        if (generation.value() != m_pi_generation) {
+            dbgln_if(FUTEXQUEUE_DEBUG, "FutexQueue @ {}: should not block thread {}: owner let go", this, b.thread());
+            return false;
+        }
+        // NOTE: The owner only gets a higher priority the next time it is scheduled.
+        if (m_pi_owner)
+            m_pi_owner->inherit_priority(b.thread().priority());
+    }
     dbgln_if(FUTEXQUEUE_DEBUG, "FutexQueue @ {}: should block thread {}", this, b.thread());
 
     return true;
@@ -77,6 +89,9 @@ ErrorOr<u32> FutexQueue::wake_n_requeue(u32 wake_count, Function<ErrorOr<FutexQu
                     blocker.finish_requeue(*target_futex_queue);
                 }
                 target_futex_queue->do_append_blockers(move(blockers_to_requeue));
+                // NOTE: The target queue was handed to us with an imminent wait, so it couldn't go away in the meantime.
+                VERIFY(target_futex_queue->m_imminent_waits > 0);
+                target_futex_queue->m_imminent_waits--;
                 is_empty_target = target_futex_queue->is_empty_and_no_imminent_waits_locked();
             } else {
                 dbgln_if(FUTEXQUEUE_DEBUG, "FutexQueue @ {}: wake_n_requeue could not get target queue to requeue {} blockers", this, blockers_to_requeue.size());
@@ -146,6 +161,55 @@ bool FutexQueue::queue_imminent_wait()
     return true;
 }
 
+void FutexQueue::cancel_imminent_wait()
+{
+    SpinlockLocker lock(m_lock);
+    VERIFY(m_imminent_waits > 0);
+    m_imminent_waits--;
+}
+
+Thread::BlockResult FutexQueue::wait_on_pi_owner(Thread::BlockTimeout const& timeout, Thread& owner, u32 generation)
+{
+    {
+        SpinlockLocker lock(m_lock);
+        // NOTE: Whoever owns the futex now is the one that has to let go for us, everyone saw the same generation.
+        if (generation == m_pi_generation)
+            m_pi_owner = &owner;
+    }
+    return wait_on(timeout, FUTEX_BITSET_MATCH_ANY, generation);
+}
+
+u32 FutexQueue::wake_pi_waiter(bool& is_empty)
+{
+    SpinlockLocker lock(m_lock);
+    dbgln_if(FUTEXQUEUE_DEBUG, "FutexQueue @ {}: wake_pi_waiter", this);
+    m_pi_generation++;
+    m_pi_owner = nullptr;
+
+    Optional<u32> highest_priority;
+    unblock_all_blockers_whose_conditions_are_met_locked([&](Thread::Blocker& b, void*, bool&) {
+        auto priority = b.thread().priority();
+        if (!highest_priority.has_value() || priority > highest_priority.value())
+            highest_priority = priority;
+        return false;
+    });
+
+    u32 did_wake = 0;
+    if (highest_priority.has_value()) {
+        unblock_all_blockers_whose_conditions_are_met_locked([&](Thread::Blocker& b, void*, bool& stop_iterating) {
+            VERIFY(b.blocker_type() == Thread::Blocker::Type::Futex);
+            auto& blocker = static_cast<Thread::FutexBlocker&>(b);
+            if (blocker.thread().priority() != highest_priority.value() || !blocker.unblock())
+                return false;
+            did_wake++;
+            stop_iterating = true;
+            return true;
+        });
+    }
+    is_empty = is_empty_and_no_imminent_waits_locked();
+    return did_wake;
+}
+
 bool FutexQueue::try_remove()
 {
     SpinlockLocker lock(m_lock);
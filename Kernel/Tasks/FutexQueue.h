@@ -30,8 +30,22 @@ public:
     }
 
     bool queue_imminent_wait();
+    // Gives back an imminent wait for a thread that decided not to wait after all.
+    void cancel_imminent_wait();
     bool try_remove();
 
+    // Priority inheritance futexes: Waiters lend their priority to the owner while they wait for it.
+    // The generation changes whenever the owner lets go, and a waiter that saw an older one doesn't block
+    // but tries to take the futex again, so it can't miss the wakeup in between looking at it and blocking.
+    u32 pi_generation()
+    {
+        SpinlockLocker lock(m_lock);
+        return m_pi_generation;
+    }
+    Thread::BlockResult wait_on_pi_owner(Thread::BlockTimeout const&, Thread& owner, u32 generation);
+    // Wakes the waiter with the highest priority, which then races for the futex like everyone else.
+    u32 wake_pi_waiter(bool& is_empty);
+
     bool is_empty_and_no_imminent_waits()
     {
         SpinlockLocker lock(m_lock);
@@ -45,6 +59,8 @@ protected:
 private:
     size_t m_imminent_waits { 1 }; // We only create this object if we're going to be waiting, so start out with 1
     bool m_was_removed { false };
+    u32 m_pi_generation { 0 };
+    RefPtr<Thread> m_pi_owner;
 };
 
 }
@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/Memory/MemoryManager.h>
+#include <Kernel/Sections.h>
+#include <Kernel/Tasks/PageZeroingTask.h>
+#include <Kernel/Tasks/Process.h>
+#include <Kernel/Tasks/Scheduler.h>
+#include <Kernel/Time/TimeManagement.h>
+
+namespace Kernel {
+
+UNMAP_AFTER_INIT void PageZeroingTask::spawn()
+{
+    MUST(Process::create_kernel_process("Page Zeroing Task"sv, [] {
+        Thread::current()->set_priority(THREAD_PRIORITY_MIN);
+        while (!Process::current().is_dying()) {
+            // Once we drop below the low watermark, fill the pool all the way up to the high watermark.
+            if (MM.zeroed_page_pool_needs_refill()) {
+                while (MM.zero_one_free_page())
+                    Scheduler::yield();
+            }
+            (void)Thread::current()->sleep(Duration::from_milliseconds(10));
+        }
+        Process::current().sys$exit(0);
+        VERIFY_NOT_REACHED();
+    }));
+}
+
+}
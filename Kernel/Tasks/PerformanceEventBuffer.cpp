@@ -107,6 +107,10 @@ ErrorOr<void> PerformanceEventBuffer::append_with_ip_and_bp(ProcessID pid, Threa
 
     switch (type) {
     case PERF_EVENT_SAMPLE:
+    case PERF_EVENT_CYCLES:
+    case PERF_EVENT_INSTRUCTIONS:
+    case PERF_EVENT_CACHE_MISS:
+    case PERF_EVENT_BRANCH_MISS:
         break;
     case PERF_EVENT_MALLOC:
         event.data.malloc.size = arg1;
@@ -234,6 +238,18 @@ ErrorOr<void> PerformanceEventBuffer::to_json_impl(Serializer& object) const
         case PERF_EVENT_SAMPLE:
             TRY(event_object.add("type"sv, "sample"));
             break;
+        case PERF_EVENT_CYCLES:
+            TRY(event_object.add("type"sv, "cycles"));
+            break;
+        case PERF_EVENT_INSTRUCTIONS:
+            TRY(event_object.add("type"sv, "instructions"));
+            break;
+        case PERF_EVENT_CACHE_MISS:
+            TRY(event_object.add("type"sv, "cache_miss"));
+            break;
+        case PERF_EVENT_BRANCH_MISS:
+            TRY(event_object.add("type"sv, "branch_miss"));
+            break;
         case PERF_EVENT_MALLOC:
             TRY(event_object.add("type"sv, "malloc"));
             TRY(event_object.add("ptr"sv, static_cast<u64>(event.data.malloc.ptr)));
@@ -68,6 +68,16 @@ public:
         }
     }
 
+    static void add_hardware_event_sample(Thread& current_thread, RegisterState const& regs, u64 type)
+    {
+        if (current_thread.is_profiling_suppressed())
+            return;
+        if (auto* event_buffer = current_thread.process().current_perf_events_buffer()) {
+            [[maybe_unused]] auto rc = event_buffer->append_with_ip_and_bp(
+                current_thread.pid(), current_thread.tid(), regs, static_cast<int>(type), 0, 0, 0, {});
+        }
+    }
+
     static void add_mmap_perf_event(Process& current_process, Memory::Region const& region)
     {
         if (auto* event_buffer = current_process.current_perf_events_buffer()) {
@@ -44,9 +44,26 @@ struct ThreadReadyQueues {
     u32 mask {};
     static constexpr size_t count = sizeof(mask) * 8;
     Array<ThreadReadyQueue, count> queues;
+
+    // Finds the most important thread that isn't running anywhere and that may run on a processor in affinity_mask.
+    Thread* find_runnable_thread(u64 affinity_mask);
+    void enqueue(Thread&, u32 priority);
+    void dequeue(Thread&);
+};
+
+// Every processor has its own set of ready queues. Threads are queued on the processor
+// they last ran on (as long as their affinity allows it), which keeps them cache-warm,
+// and processors that run out of work steal runnable threads from their peers.
+// NOTE: The ready queues are only protected by their own locks, not by g_scheduler_lock.
+struct ProcessorReadyQueues {
+    SpinlockProtected<ThreadReadyQueues, LockRank::None> queues {};
+    // A copy of queues' priority mask, so that other processors can skip us without taking the lock.
+    // NOTE: This has to be sequentially consistent, as an idle processor checks it after marking itself as idle,
+    //       while enqueuing a thread updates it before looking for idle processors to wake up.
+    Atomic<u32> mask { 0 };
 };
 
-static Singleton<SpinlockProtected<ThreadReadyQueues, LockRank::None>> g_ready_queues;
+static Singleton<Array<ProcessorReadyQueues, MAX_CPU_COUNT>> g_ready_queues;
 
 static SpinlockProtected<TotalTimeScheduled, LockRank::None> g_total_time_scheduled {};
 
@@ -64,117 +81,202 @@ static inline u32 thread_priority_to_priority_index(u32 thread_priority)
     return priority_bucket;
 }
 
-Thread& Scheduler::pull_next_runnable_thread()
+static_assert(MAX_CPU_COUNT <= sizeof(u64) * 8);
+
+static inline u32 ready_queue_count()
+{
+    // NOTE: Processor::count() is not maintained on every architecture yet.
+    return clamp(Processor::count(), 1u, static_cast<u32>(MAX_CPU_COUNT));
+}
+
+static u32 ready_queue_processor_for(Thread const& thread)
 {
-    auto affinity_mask = 1u << Processor::current_id();
-
-    return g_ready_queues->with([&](auto& ready_queues) -> Thread& {
-        auto priority_mask = ready_queues.mask;
-        while (priority_mask != 0) {
-            auto priority = bit_scan_forward(priority_mask);
-            VERIFY(priority > 0);
-            auto& ready_queue = ready_queues.queues[--priority];
-            for (auto& thread : ready_queue.thread_list) {
-                VERIFY(thread.m_runnable_priority == (int)priority);
-                if (thread.is_active())
-                    continue;
-                if (!(thread.affinity() & affinity_mask))
-                    continue;
-                thread.m_runnable_priority = -1;
-                ready_queue.thread_list.remove(thread);
-                if (ready_queue.thread_list.is_empty())
-                    ready_queues.mask &= ~(1u << priority);
-                // Mark it as active because we are using this thread. This is similar
-                // to comparing it with Processor::current_thread, but when there are
-                // multiple processors there's no easy way to check whether the thread
-                // is actually still needed. This prevents accidental finalization when
-                // a thread is no longer in Running state, but running on another core.
-
-                // We need to mark it active here so that this thread won't be
-                // scheduled on another core if it were to be queued before actually
-                // switching to it.
-                // FIXME: Figure out a better way maybe?
-                thread.set_active(true);
-                return thread;
-            }
-            priority_mask &= ~(1u << priority);
+    auto queue_count = ready_queue_count();
+    auto online_mask = queue_count == sizeof(u64) * 8 ? NumericLimits<u64>::max() : (1ull << queue_count) - 1;
+    auto allowed_mask = thread.affinity() & online_mask;
+    if (allowed_mask == 0)
+        return Processor::current_id();
+
+    // Threads that never ran have no cache footprint anywhere yet, so keep them local.
+    auto preferred = thread.times_scheduled() == 0 ? Processor::current_id() : thread.cpu();
+    if (allowed_mask & (1ull << preferred))
+        return preferred;
+    return bit_scan_forward(allowed_mask) - 1;
+}
+
+Thread* ThreadReadyQueues::find_runnable_thread(u64 affinity_mask)
+{
+    auto priority_mask = mask;
+    while (priority_mask != 0) {
+        auto priority = bit_scan_forward(priority_mask);
+        VERIFY(priority > 0);
+        auto& ready_queue = queues[--priority];
+        for (auto& thread : ready_queue.thread_list) {
+            VERIFY(thread.m_runnable_priority == (int)priority);
+            if (thread.is_active())
+                continue;
+            if (!(thread.affinity() & affinity_mask))
+                continue;
+            return &thread;
         }
+        priority_mask &= ~(1u << priority);
+    }
+    return nullptr;
+}
+
+void ThreadReadyQueues::enqueue(Thread& thread, u32 priority)
+{
+    VERIFY(thread.m_runnable_priority < 0);
+    thread.m_runnable_priority = (int)priority;
+    VERIFY(!thread.m_ready_queue_node.is_in_list());
+    auto& ready_queue = queues[priority];
+    bool was_empty = ready_queue.thread_list.is_empty();
+    ready_queue.thread_list.append(thread);
+    if (was_empty)
+        mask |= (1u << priority);
+}
+
+void ThreadReadyQueues::dequeue(Thread& thread)
+{
+    auto priority = thread.m_runnable_priority;
+    VERIFY(priority >= 0);
+    VERIFY(mask & (1u << priority));
+    auto& ready_queue = queues[priority];
+    thread.m_runnable_priority = -1;
+    ready_queue.thread_list.remove(thread);
+    if (ready_queue.thread_list.is_empty())
+        mask &= ~(1u << priority);
+}
+
+enum class ClaimThread {
+    No,
+    Yes,
+};
+
+static Thread* find_runnable_thread_on(u32 processor, u64 affinity_mask, ClaimThread claim)
+{
+    auto& ready_queues = g_ready_queues->at(processor);
+    if (ready_queues.mask.load() == 0)
+        return nullptr;
+
+    return ready_queues.queues.with([&](auto& queues) {
+        auto* thread = queues.find_runnable_thread(affinity_mask);
+        if (thread && claim == ClaimThread::Yes) {
+            queues.dequeue(*thread);
+            ready_queues.mask.store(queues.mask);
+
+            // Mark it as active because we are using this thread. This is similar
+            // to comparing it with Processor::current_thread, but when there are
+            // multiple processors there's no easy way to check whether the thread
+            // is actually still needed. This prevents accidental finalization when
+            // a thread is no longer in Running state, but running on another core.
+
+            // We need to mark it active here so that this thread won't be
+            // picked by another core if it were to be queued again before
+            // actually switching to it.
+            thread->set_active(true);
+        }
+        return thread;
+    });
+}
+
+static Thread* find_next_runnable_thread(ClaimThread claim)
+{
+    auto current_id = Processor::current_id();
+    auto affinity_mask = 1ull << current_id;
+
+    if (auto* thread = find_runnable_thread_on(current_id, affinity_mask, claim))
+        return thread;
 
+    // We only steal from other processors once we have nothing left to run ourselves.
+    auto queue_count = ready_queue_count();
+    for (u32 i = 1; i < queue_count; ++i) {
+        if (auto* thread = find_runnable_thread_on((current_id + i) % queue_count, affinity_mask, claim))
+            return thread;
+    }
+    return nullptr;
+}
+
+Thread& Scheduler::pull_next_runnable_thread()
+{
+    // NOTE: This doesn't need g_scheduler_lock, the thread is claimed under the lock of the queue it's taken from.
+    //       The caller has to make sure that it's still runnable once it holds g_scheduler_lock.
+    auto* thread = find_next_runnable_thread(ClaimThread::Yes);
+    if (!thread) {
         auto* idle_thread = Processor::idle_thread();
         idle_thread->set_active(true);
         return *idle_thread;
-    });
+    }
+    return *thread;
 }
 
-Thread* Scheduler::peek_next_runnable_thread()
+// Returns whether a thread we took off the ready queues without holding g_scheduler_lock can still be switched to.
+static bool claimed_thread_is_still_runnable(Thread& thread)
 {
-    auto affinity_mask = 1u << Processor::current_id();
-
-    return g_ready_queues->with([&](auto& ready_queues) -> Thread* {
-        auto priority_mask = ready_queues.mask;
-        while (priority_mask != 0) {
-            auto priority = bit_scan_forward(priority_mask);
-            VERIFY(priority > 0);
-            auto& ready_queue = ready_queues.queues[--priority];
-            for (auto& thread : ready_queue.thread_list) {
-                VERIFY(thread.m_runnable_priority == (int)priority);
-                if (thread.is_active())
-                    continue;
-                if (!(thread.affinity() & affinity_mask))
-                    continue;
-                return &thread;
-            }
-            priority_mask &= ~(1u << priority);
-        }
+    VERIFY(g_scheduler_lock.is_locked_by_current_processor());
+    if (thread.is_idle_thread())
+        return true;
 
-        // Unlike in pull_next_runnable_thread() we don't want to fall back to
-        // the idle thread. We just want to see if we have any other thread ready
-        // to be scheduled.
-        return nullptr;
-    });
+    if (thread.state() != Thread::State::Runnable) {
+        // Someone stopped or killed the thread after we claimed it. Since it was active at that time,
+        // they couldn't hand it to the finalizer, so we have to do that instead.
+        thread.set_active(false);
+        if (thread.state() == Thread::State::Dying && thread.is_finalizable())
+            Scheduler::notify_finalizer();
+        return false;
+    }
+
+    // The thread might have been stopped and resumed in the meantime, which queued it again.
+    Scheduler::dequeue_runnable_thread(thread);
+    return true;
+}
+
+Thread* Scheduler::peek_next_runnable_thread()
+{
+    // Unlike in pull_next_runnable_thread() we don't want to fall back to
+    // the idle thread. We just want to see if we have any other thread ready
+    // to be scheduled.
+    return find_next_runnable_thread(ClaimThread::No);
 }
 
 bool Scheduler::dequeue_runnable_thread(Thread& thread, bool check_affinity)
 {
+    VERIFY(g_scheduler_lock.is_locked_by_current_processor());
     if (thread.is_idle_thread())
         return true;
 
-    return g_ready_queues->with([&](auto& ready_queues) {
-        auto priority = thread.m_runnable_priority;
-        if (priority < 0) {
+    if (check_affinity && !(thread.affinity() & (1ull << Processor::current_id())))
+        return false;
+
+    // NOTE: m_runnable_processor only changes under g_scheduler_lock, but the thread may be
+    //       taken off its queue by another processor at any time, so we check under the queue's lock.
+    auto& ready_queues = g_ready_queues->at(thread.m_runnable_processor);
+    return ready_queues.queues.with([&](auto& queues) {
+        if (thread.m_runnable_priority < 0) {
             VERIFY(!thread.m_ready_queue_node.is_in_list());
             return false;
         }
-
-        if (check_affinity && !(thread.affinity() & (1 << Processor::current_id())))
-            return false;
-
-        VERIFY(ready_queues.mask & (1u << priority));
-        auto& ready_queue = ready_queues.queues[priority];
-        thread.m_runnable_priority = -1;
-        ready_queue.thread_list.remove(thread);
-        if (ready_queue.thread_list.is_empty())
-            ready_queues.mask &= ~(1u << priority);
+        queues.dequeue(thread);
+        ready_queues.mask.store(queues.mask);
         return true;
     });
 }
 
 void Scheduler::enqueue_runnable_thread(Thread& thread)
 {
+    // NOTE: We're called with g_scheduler_lock held because this is a state transition,
+    //       but the ready queues themselves are only protected by their own locks.
     VERIFY(g_scheduler_lock.is_locked_by_current_processor());
     if (thread.is_idle_thread())
         return;
     auto priority = thread_priority_to_priority_index(thread.priority());
+    auto processor = ready_queue_processor_for(thread);
 
-    g_ready_queues->with([&](auto& ready_queues) {
-        VERIFY(thread.m_runnable_priority < 0);
-        thread.m_runnable_priority = (int)priority;
-        VERIFY(!thread.m_ready_queue_node.is_in_list());
-        auto& ready_queue = ready_queues.queues[priority];
-        bool was_empty = ready_queue.thread_list.is_empty();
-        ready_queue.thread_list.append(thread);
-        if (was_empty)
-            ready_queues.mask |= (1u << priority);
+    thread.m_runnable_processor = processor;
+    auto& ready_queues = g_ready_queues->at(processor);
+    ready_queues.queues.with([&](auto& queues) {
+        queues.enqueue(thread, priority);
+        ready_queues.mask.store(queues.mask);
     });
 }
 
@@ -195,7 +297,7 @@ UNMAP_AFTER_INIT void Scheduler::start()
     idle_thread.set_initialized(true);
     processor.init_context(idle_thread, false);
     idle_thread.set_state(Thread::State::Running);
-    VERIFY(idle_thread.affinity() == (1u << processor.id()));
+    VERIFY(idle_thread.affinity() == (1ull << processor.id()));
     processor.initialize_context_switching(idle_thread);
     VERIFY_NOT_REACHED();
 }
@@ -217,13 +319,20 @@ void Scheduler::pick_next()
             Processor::set_current_in_scheduler(false);
         });
 
-    SpinlockLocker lock(g_scheduler_lock);
-
     if constexpr (SCHEDULER_RUNNABLE_DEBUG) {
+        SpinlockLocker lock(g_scheduler_lock);
         dump_thread_list();
     }
 
-    auto& thread_to_schedule = pull_next_runnable_thread();
+    // Searching the ready queues and stealing from other processors only takes the locks of the queues involved.
+    // The scheduler lock is only needed for the context switch, and to make sure that the thread is still runnable.
+    auto* claimed_thread = &pull_next_runnable_thread();
+
+    SpinlockLocker lock(g_scheduler_lock);
+    while (!claimed_thread_is_still_runnable(*claimed_thread))
+        claimed_thread = &pull_next_runnable_thread();
+
+    auto& thread_to_schedule = *claimed_thread;
     if constexpr (SCHEDULER_DEBUG) {
         dbgln("Scheduler[{}]: Switch to {} @ {:p}",
             Processor::current_id(),
@@ -286,6 +395,8 @@ void Scheduler::context_switch(Thread* thread)
 #endif
 
     auto& proc = Processor::current();
+    if (from_thread->is_idle_thread())
+        TimeManagement::restart_tick_if_stopped();
     if (!thread->is_initialized()) {
         proc.init_context(*thread, false);
         thread->set_initialized(true);
@@ -399,7 +510,7 @@ UNMAP_AFTER_INIT Thread* Scheduler::create_ap_idle_thread(u32 cpu)
     VERIFY(Processor::is_bootstrap_processor());
 
     VERIFY(s_colonel_process);
-    Thread* idle_thread = MUST(s_colonel_process->create_kernel_thread(idle_loop, nullptr, THREAD_PRIORITY_MIN, MUST(KString::formatted("idle thread #{}", cpu))->view(), 1 << cpu, false));
+    Thread* idle_thread = MUST(s_colonel_process->create_kernel_thread(idle_loop, nullptr, THREAD_PRIORITY_MIN, MUST(KString::formatted("idle thread #{}", cpu))->view(), 1ull << cpu, false));
     VERIFY(idle_thread);
     return idle_thread;
 }
@@ -484,9 +595,18 @@ void Scheduler::idle_loop(void*)
     VERIFY(Processor::are_interrupts_enabled());
 
     for (;;) {
+        // NOTE: Once we're marked as idle, a thread that is made runnable elsewhere will wake us up with an IPI.
+        //       We have to check once more before waiting though, as it may have been queued before that.
+        Processor::disable_interrupts();
         proc.idle_begin();
-        proc.wait_for_interrupt();
+        if (!peek_next_runnable_thread()) {
+            TimeManagement::stop_tick_while_idle();
+            proc.enable_interrupts_and_wait_for_interrupt();
+            Processor::disable_interrupts();
+        }
         proc.idle_end();
+        TimeManagement::restart_tick_if_stopped();
+        Processor::enable_interrupts();
         VERIFY_INTERRUPTS_ENABLED();
         yield();
     }
@@ -4,21 +4,50 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Atomic.h>
+#include <AK/Singleton.h>
 #include <Kernel/FileSystem/VirtualFileSystem.h>
 #include <Kernel/Sections.h>
 #include <Kernel/Tasks/Process.h>
 #include <Kernel/Tasks/SyncTask.h>
+#include <Kernel/Tasks/WaitQueue.h>
 #include <Kernel/Time/TimeManagement.h>
 
 namespace Kernel {
 
+// NOTE: File systems that build up a lot of dirty data ask for it to be written back early,
+//       so the periodic sync doesn't have to do much besides writing out metadata.
+static constexpr Duration sync_interval = Duration::from_seconds(5);
+
+static Singleton<WaitQueue> s_writeback_wait_queue;
+static Atomic<bool> s_writeback_requested { false };
+
+void SyncTask::request_writeback()
+{
+    if (!s_writeback_requested.exchange(true, AK::MemoryOrder::memory_order_acq_rel))
+        s_writeback_wait_queue->wake_one();
+}
+
 UNMAP_AFTER_INIT void SyncTask::spawn()
 {
     MUST(Process::create_kernel_process("VFS Sync Task"sv, [] {
         dbgln("VFS SyncTask is running");
+        auto next_sync_time = TimeManagement::the().monotonic_time() + sync_interval;
         while (!Process::current().is_dying()) {
-            VirtualFileSystem::sync();
-            (void)Thread::current()->sleep(Duration::from_seconds(1));
+            auto now = TimeManagement::the().monotonic_time();
+            if (now >= next_sync_time) {
+                VirtualFileSystem::sync();
+                next_sync_time = TimeManagement::the().monotonic_time() + sync_interval;
+                continue;
+            }
+
+            if (!s_writeback_requested.load(AK::MemoryOrder::memory_order_acquire)) {
+                auto time_until_next_sync = next_sync_time - now;
+                (void)s_writeback_wait_queue->wait_on(Thread::BlockTimeout(false, &time_until_next_sync), "SyncTask"sv);
+            }
+
+            if (s_writeback_requested.exchange(false, AK::MemoryOrder::memory_order_acq_rel))
+                VirtualFileSystem::the().write_back_filesystems();
         }
         Process::current().sys$exit(0);
         VERIFY_NOT_REACHED();
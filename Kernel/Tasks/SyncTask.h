@@ -10,5 +10,9 @@ namespace Kernel {
 class SyncTask {
 public:
     static void spawn();
+
+    // Wakes up the SyncTask to write back dirty data of file systems that built up too much of it,
+    // without waiting for the next periodic sync.
+    static void request_writeback();
 };
 }
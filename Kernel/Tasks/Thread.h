@@ -52,7 +52,7 @@ struct ThreadSpecificData {
     ThreadSpecificData* self;
 };
 
-#define THREAD_AFFINITY_DEFAULT 0xffffffff
+#define THREAD_AFFINITY_DEFAULT 0xffffffffffffffff
 
 class Thread
     : public ListedRefCounted<Thread, LockType::Spinlock>
@@ -64,6 +64,7 @@ class Thread
     friend class Process;
     friend class Scheduler;
     friend struct ThreadReadyQueue;
+    friend struct ThreadReadyQueues;
 
 public:
     static Thread* current()
@@ -82,7 +83,15 @@ public:
     ProcessID pid() const;
 
     void set_priority(u32 p) { m_priority = p; }
-    u32 priority() const { return m_priority; }
+    u32 priority() const { return max(m_priority, m_inherited_priority.load(AK::MemoryOrder::memory_order_relaxed)); }
+
+    // A thread that holds a priority inheritance futex runs with (at least) the priority of the threads waiting for it.
+    void inherit_priority(u32 p)
+    {
+        if (p > m_inherited_priority.load(AK::MemoryOrder::memory_order_relaxed))
+            m_inherited_priority.store(p, AK::MemoryOrder::memory_order_relaxed);
+    }
+    void clear_inherited_priority() { m_inherited_priority.store(0, AK::MemoryOrder::memory_order_relaxed); }
 
     void detach()
     {
@@ -462,7 +471,7 @@ public:
 
     class FutexBlocker final : public Blocker {
     public:
-        explicit FutexBlocker(FutexQueue&, u32);
+        explicit FutexBlocker(FutexQueue&, u32, Optional<u32> pi_generation = {});
         virtual ~FutexBlocker();
 
         virtual Type blocker_type() const override { return Type::Futex; }
@@ -471,6 +480,7 @@ public:
         virtual bool setup_blocker() override;
 
         u32 bitset() const { return m_bitset; }
+        Optional<u32> const& pi_generation() const { return m_pi_generation; }
 
         void begin_requeue()
         {
@@ -485,6 +495,7 @@ public:
     protected:
         FutexQueue& m_futex_queue;
         u32 m_bitset { 0 };
+        Optional<u32> m_pi_generation;
         InterruptsState m_previous_interrupts_state { InterruptsState::Disabled };
         bool m_did_unblock { false };
     };
@@ -775,8 +786,8 @@ public:
 
     u32 cpu() const { return m_cpu.load(AK::MemoryOrder::memory_order_consume); }
     void set_cpu(u32 cpu) { m_cpu.store(cpu, AK::MemoryOrder::memory_order_release); }
-    u32 affinity() const { return m_cpu_affinity; }
-    void set_affinity(u32 affinity) { m_cpu_affinity = affinity; }
+    u64 affinity() const { return m_cpu_affinity; }
+    void set_affinity(u64 affinity) { m_cpu_affinity = affinity; }
 
     RegisterState& get_register_dump_from_stack();
     RegisterState const& get_register_dump_from_stack() const { return const_cast<Thread*>(this)->get_register_dump_from_stack(); }
@@ -1094,6 +1105,7 @@ private:
 
     IntrusiveListNode<Thread> m_process_thread_list_node;
     int m_runnable_priority { -1 };
+    u32 m_runnable_processor { 0 };
 
     friend class WaitQueue;
 
@@ -1167,7 +1179,7 @@ private:
     u32 m_saved_critical { 1 };
     IntrusiveListNode<Thread> m_ready_queue_node;
     Atomic<u32> m_cpu { 0 };
-    u32 m_cpu_affinity { THREAD_AFFINITY_DEFAULT };
+    u64 m_cpu_affinity { THREAD_AFFINITY_DEFAULT };
     Optional<u64> m_last_time_scheduled;
     Atomic<u64> m_total_time_scheduled_user { 0 };
     Atomic<u64> m_total_time_scheduled_kernel { 0 };
@@ -1226,6 +1238,7 @@ private:
     State m_state { Thread::State::Invalid };
     SpinlockProtected<Name, LockRank::None> m_name;
     u32 m_priority { THREAD_PRIORITY_NORMAL };
+    Atomic<u32> m_inherited_priority { 0 };
 
     State m_stop_state { Thread::State::Invalid };
 
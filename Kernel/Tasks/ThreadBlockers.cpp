@@ -146,9 +146,10 @@ bool Thread::WaitQueueBlocker::unblock()
     return true;
 }
 
-Thread::FutexBlocker::FutexBlocker(FutexQueue& futex_queue, u32 bitset)
+Thread::FutexBlocker::FutexBlocker(FutexQueue& futex_queue, u32 bitset, Optional<u32> pi_generation)
     : m_futex_queue(futex_queue)
     , m_bitset(bitset)
+    , m_pi_generation(move(pi_generation))
 {
 }
 
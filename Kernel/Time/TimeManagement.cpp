@@ -103,6 +103,40 @@ bool TimeManagement::is_system_timer(HardwareTimerBase const& timer) const
     return &timer == m_system_timer.ptr();
 }
 
+void TimeManagement::stop_tick_while_idle()
+{
+    VERIFY_INTERRUPTS_DISABLED();
+    auto& processor = Processor::current();
+    if (processor.is_tick_stopped())
+        return;
+
+#if ARCH(X86_64)
+    // NOTE: The boot processor keeps the time and fires the timers of all processors, so it always has to tick.
+    if (Processor::current_id() == 0 || !APIC::initialized())
+        return;
+    auto* apic_timer = APIC::the().get_timer();
+    if (!apic_timer || !s_the.is_initialized() || !s_the->is_system_timer(*apic_timer))
+        return;
+    apic_timer->disable_local_timer();
+    processor.set_tick_stopped(true);
+#else
+    // FIXME: Stop the tick on other architectures as well, once their secondary processors get one.
+#endif
+}
+
+void TimeManagement::restart_tick_if_stopped()
+{
+    VERIFY_INTERRUPTS_DISABLED();
+    auto& processor = Processor::current();
+    if (!processor.is_tick_stopped())
+        return;
+
+#if ARCH(X86_64)
+    APIC::the().get_timer()->enable_local_timer();
+#endif
+    processor.set_tick_stopped(false);
+}
+
 void TimeManagement::set_epoch_time(UnixDateTime ts)
 {
     // FIXME: The interrupt disabler intends to enforce atomic update of epoch time and remaining adjustment,
@@ -58,6 +58,11 @@ public:
 
     bool is_system_timer(HardwareTimerBase const&) const;
 
+    // An idle processor has nothing to do on a timer tick, so it may stop getting them until it runs a thread again.
+    // NOTE: These have to be called with interrupts disabled, on the processor whose tick should be stopped.
+    static void stop_tick_while_idle();
+    static void restart_tick_if_stopped();
+
     void increment_time_since_boot();
 
     static bool is_hpet_periodic_mode_allowed();
@@ -53,6 +53,18 @@ TimerQueue& TimerQueue::the()
 UNMAP_AFTER_INIT TimerQueue::TimerQueue()
 {
     m_ticks_per_second = TimeManagement::the().ticks_per_second();
+    m_nanoseconds_per_tick = TimeManagement::the().clock_resolution().to_nanoseconds();
+    VERIFY(m_nanoseconds_per_tick > 0);
+    m_coarse_timer_wheel.current_tick = TimeManagement::the().current_time(CLOCK_MONOTONIC_COARSE).to_nanoseconds() / m_nanoseconds_per_tick;
+}
+
+u64 TimerQueue::tick_for(Duration const& time) const
+{
+    auto nanoseconds = time.to_nanoseconds();
+    if (nanoseconds <= 0)
+        return 0;
+    // Round up, timers must never fire before their deadline.
+    return (nanoseconds + m_nanoseconds_per_tick - 1) / m_nanoseconds_per_tick;
 }
 
 bool TimerQueue::add_timer_without_id(NonnullRefPtr<Timer> timer, clockid_t clock_id, Duration const& deadline, Function<void()>&& callback)
@@ -91,6 +103,12 @@ void TimerQueue::add_timer_locked(NonnullRefPtr<Timer> timer)
     timer->clear_cancelled();
     timer->clear_callback_finished();
     timer->set_in_use();
+    timer->m_is_executing = false;
+
+    if (is_coarse(*timer)) {
+        add_timer_locked(m_coarse_timer_wheel, timer.leak_ref());
+        return;
+    }
 
     auto& queue = queue_for_timer(*timer);
     if (queue.list.is_empty()) {
@@ -115,6 +133,47 @@ void TimerQueue::add_timer_locked(NonnullRefPtr<Timer> timer)
     }
 }
 
+void TimerQueue::add_timer_locked(Wheel& wheel, Timer& timer)
+{
+    auto tick = max(tick_for(timer.m_expires), wheel.current_tick);
+    auto ticks_until_due = tick - wheel.current_tick;
+
+    size_t level = 0;
+    while (level + 1 < Wheel::level_count && ticks_until_due >= (1ull << (Wheel::slot_bits * (level + 1))))
+        ++level;
+
+    // NOTE: Timers that are further out than the wheel reaches wait in the last slot it has,
+    //       and are put back in when that one comes around.
+    constexpr u64 maximum_ticks_until_due = (1ull << (Wheel::slot_bits * Wheel::level_count)) - 1;
+    if (ticks_until_due > maximum_ticks_until_due)
+        tick = wheel.current_tick + maximum_ticks_until_due;
+
+    auto slot = (tick >> (Wheel::slot_bits * level)) & (Wheel::slot_count - 1);
+    wheel.levels[level][slot].append(timer);
+}
+
+void TimerQueue::cascade_wheel_locked(Wheel& wheel)
+{
+    VERIFY(g_timerqueue_lock.is_locked());
+
+    // A level wraps around into its next slot when all the levels below it do.
+    size_t highest_level = 0;
+    while (highest_level + 1 < Wheel::level_count && (wheel.current_tick & ((1ull << (Wheel::slot_bits * (highest_level + 1))) - 1)) == 0)
+        ++highest_level;
+
+    // NOTE: We go from the top down, so that timers moving down more than one level
+    //       end up in the first level right away.
+    for (size_t level = highest_level; level > 0; --level) {
+        auto& slot = wheel.levels[level][(wheel.current_tick >> (Wheel::slot_bits * level)) & (Wheel::slot_count - 1)];
+        // Some of the timers may end up back in the same slot, so take them all out first.
+        Timer::List timers;
+        while (auto* timer = slot.take_first())
+            timers.append(*timer);
+        while (auto* timer = timers.take_first())
+            add_timer_locked(wheel, *timer);
+    }
+}
+
 bool TimerQueue::cancel_timer(Timer& timer, bool* was_in_use)
 {
     bool in_use = timer.is_in_use();
@@ -128,15 +187,17 @@ bool TimerQueue::cancel_timer(Timer& timer, bool* was_in_use)
     }
 
     bool did_already_run = timer.set_cancelled();
-    auto& timer_queue = queue_for_timer(timer);
     if (!did_already_run) {
         timer.clear_in_use();
 
         SpinlockLocker lock(g_timerqueue_lock);
-        if (timer_queue.list.contains(timer)) {
+        if (!timer.m_is_executing) {
             // The timer has not fired, remove it
             VERIFY(timer.ref_count() > 1);
-            remove_timer_locked(timer_queue, timer);
+            if (is_coarse(timer))
+                remove_timer_locked(m_coarse_timer_wheel, timer);
+            else
+                remove_timer_locked(queue_for_timer(timer), timer);
             return true;
         }
 
@@ -147,6 +208,7 @@ bool TimerQueue::cancel_timer(Timer& timer, bool* was_in_use)
         // but since we called set_cancelled it will only drop its reference
         VERIFY(m_timers_executing.contains(timer));
         m_timers_executing.remove(timer);
+        timer.m_is_executing = false;
         return true;
     }
 
@@ -174,10 +236,46 @@ void TimerQueue::remove_timer_locked(Queue& queue, Timer& timer)
     timer.unref();
 }
 
+void TimerQueue::remove_timer_locked(Wheel&, Timer& timer)
+{
+    timer.m_list_node.remove();
+    auto now = timer.now(false);
+    if (timer.m_expires > now)
+        timer.m_remaining = timer.m_expires - now;
+    timer.unref();
+}
+
 void TimerQueue::fire()
 {
     SpinlockLocker lock(g_timerqueue_lock);
 
+    // NOTE: The timer has to be taken out of its queue already.
+    auto execute_timer = [&](Timer* timer) {
+        m_timers_executing.append(*timer);
+        timer->m_is_executing = true;
+
+        lock.unlock();
+
+        // Defer executing the timer outside of the irq handler
+        Processor::deferred_call_queue([this, timer]() {
+            // Check if we were cancelled in between being triggered
+            // by the timer irq handler and now. If so, just drop
+            // our reference and don't execute the callback.
+            if (!timer->set_cancelled()) {
+                timer->m_callback();
+                SpinlockLocker lock(g_timerqueue_lock);
+                m_timers_executing.remove(*timer);
+                timer->m_is_executing = false;
+            }
+            timer->clear_in_use();
+            timer->set_callback_finished();
+            // Drop the reference we added when queueing the timer
+            timer->unref();
+        });
+
+        lock.lock();
+    };
+
     auto fire_timers = [&](Queue& queue) {
         auto* timer = queue.list.first();
         VERIFY(timer);
@@ -185,30 +283,8 @@ void TimerQueue::fire()
 
         while (timer && timer->now(true) > timer->m_expires) {
             queue.list.remove(*timer);
-
-            m_timers_executing.append(*timer);
-
             update_next_timer_due(queue);
-
-            lock.unlock();
-
-            // Defer executing the timer outside of the irq handler
-            Processor::deferred_call_queue([this, timer]() {
-                // Check if we were cancelled in between being triggered
-                // by the timer irq handler and now. If so, just drop
-                // our reference and don't execute the callback.
-                if (!timer->set_cancelled()) {
-                    timer->m_callback();
-                    SpinlockLocker lock(g_timerqueue_lock);
-                    m_timers_executing.remove(*timer);
-                }
-                timer->clear_in_use();
-                timer->set_callback_finished();
-                // Drop the reference we added when queueing the timer
-                timer->unref();
-            });
-
-            lock.lock();
+            execute_timer(timer);
             timer = queue.list.first();
         }
     };
@@ -217,6 +293,20 @@ void TimerQueue::fire()
         fire_timers(m_timer_queue_monotonic);
     if (!m_timer_queue_realtime.list.is_empty())
         fire_timers(m_timer_queue_realtime);
+
+    // NOTE: Everything in the current slot of the first level expires on the current tick.
+    //       We look at the wheel again every time, as another processor may be firing timers as well.
+    auto& wheel = m_coarse_timer_wheel;
+    u64 now_tick = TimeManagement::the().current_time(CLOCK_MONOTONIC_COARSE).to_nanoseconds() / m_nanoseconds_per_tick;
+    while (wheel.current_tick <= now_tick) {
+        auto& slot = wheel.levels[0][wheel.current_tick & (Wheel::slot_count - 1)];
+        if (auto* timer = slot.take_first()) {
+            execute_timer(timer);
+            continue;
+        }
+        ++wheel.current_tick;
+        cascade_wheel_locked(wheel);
+    }
 }
 
 void TimerQueue::update_next_timer_due(Queue& queue)
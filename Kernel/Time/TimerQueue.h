@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/AtomicRefCounted.h>
 #include <AK/Function.h>
 #include <AK/IntrusiveList.h>
@@ -46,6 +47,8 @@ private:
     Atomic<bool> m_cancelled { false };
     Atomic<bool> m_callback_finished { false };
     Atomic<bool> m_in_use { false };
+    // Whether the timer has expired and its callback is waiting to be run, protected by the timer queue lock.
+    bool m_is_executing { false };
 
     bool operator<(Timer const& rhs) const
     {
@@ -93,21 +96,46 @@ public:
     void fire();
 
 private:
+    // Timers with a precise deadline, sorted by when they expire.
     struct Queue {
         Timer::List list;
         Duration next_timer_due {};
     };
+
+    // Coarse timers only need to fire on the first tick after their deadline, and there can be thousands of them
+    // (most of them never fire, as they are timeouts). So instead of keeping them sorted, they are hashed into
+    // slots by the tick they expire on, which makes adding and removing one O(1).
+    // NOTE: This is a hierarchical wheel: The first level has one slot per tick, and every level after that
+    //       has slots that span all of the previous level. Whenever a level wraps around, the timers from the
+    //       next slot of the level above are spread out over the levels below.
+    struct Wheel {
+        static constexpr size_t slot_bits = 6;
+        static constexpr size_t slot_count = 1 << slot_bits;
+        static constexpr size_t level_count = 4;
+
+        Array<Array<Timer::List, slot_count>, level_count> levels;
+        // The next tick whose timers haven't been fired yet.
+        u64 current_tick { 0 };
+    };
+
     void remove_timer_locked(Queue&, Timer&);
+    void remove_timer_locked(Wheel&, Timer&);
     void update_next_timer_due(Queue&);
     void add_timer_locked(NonnullRefPtr<Timer>);
+    void add_timer_locked(Wheel&, Timer&);
+    void cascade_wheel_locked(Wheel&);
+
+    u64 tick_for(Duration const&) const;
+
+    static bool is_coarse(Timer const& timer) { return timer.m_clock_id == CLOCK_MONOTONIC_COARSE; }
 
     Queue& queue_for_timer(Timer& timer)
     {
         switch (timer.m_clock_id) {
         case CLOCK_MONOTONIC:
-        case CLOCK_MONOTONIC_COARSE:
         case CLOCK_MONOTONIC_RAW:
             return m_timer_queue_monotonic;
+        // NOTE: The realtime clock can be changed at any time, so all of these timers need to be kept sorted.
         case CLOCK_REALTIME:
         case CLOCK_REALTIME_COARSE:
             return m_timer_queue_realtime;
@@ -118,8 +146,10 @@ private:
 
     u64 m_timer_id_count { 0 };
     u64 m_ticks_per_second { 0 };
+    i64 m_nanoseconds_per_tick { 0 };
     Queue m_timer_queue_monotonic;
     Queue m_timer_queue_realtime;
+    Wheel m_coarse_timer_wheel;
     Timer::List m_timers_executing;
 };
 
@@ -97,11 +97,7 @@ static ErrorOr<NonnullRefPtr<ClientType>> launch_singleton_server_process(
     });
 }
 
-ErrorOr<NonnullRefPtr<WebView::WebContentClient>> launch_web_content_process(
-    WebView::ViewImplementation& view,
-    ReadonlySpan<ByteString> candidate_web_content_paths,
-    Ladybird::WebContentOptions const& web_content_options,
-    Optional<IPC::File> request_server_socket)
+static Vector<ByteString> web_content_process_arguments(Ladybird::WebContentOptions const& web_content_options, Optional<IPC::File> const& request_server_socket)
 {
     Vector<ByteString> arguments {
         "--command-line"sv,
@@ -135,9 +131,28 @@ ErrorOr<NonnullRefPtr<WebView::WebContentClient>> launch_web_content_process(
         arguments.append(ByteString::number(request_server_socket->fd()));
     }
 
+    return arguments;
+}
+
+ErrorOr<NonnullRefPtr<WebView::WebContentClient>> launch_web_content_process(
+    WebView::ViewImplementation& view,
+    ReadonlySpan<ByteString> candidate_web_content_paths,
+    Ladybird::WebContentOptions const& web_content_options,
+    Optional<IPC::File> request_server_socket)
+{
+    auto arguments = web_content_process_arguments(web_content_options, request_server_socket);
     return launch_generic_server_process<WebView::WebContentClient>("WebContent"sv, candidate_web_content_paths, move(arguments), RegisterWithProcessManager::No, web_content_options.enable_callgrind_profiling, view);
 }
 
+ErrorOr<NonnullRefPtr<WebView::WebContentClient>> launch_spare_web_content_process(
+    ReadonlySpan<ByteString> candidate_web_content_paths,
+    Ladybird::WebContentOptions const& web_content_options,
+    Optional<IPC::File> request_server_socket)
+{
+    auto arguments = web_content_process_arguments(web_content_options, request_server_socket);
+    return launch_generic_server_process<WebView::WebContentClient>("WebContent"sv, candidate_web_content_paths, move(arguments), RegisterWithProcessManager::No, web_content_options.enable_callgrind_profiling);
+}
+
 ErrorOr<NonnullRefPtr<ImageDecoderClient::Client>> launch_image_decoder_process(ReadonlySpan<ByteString> candidate_image_decoder_paths)
 {
     return launch_generic_server_process<ImageDecoderClient::Client>("ImageDecoder"sv, candidate_image_decoder_paths, {}, RegisterWithProcessManager::Yes, Ladybird::EnableCallgrindProfiling::No);
@@ -18,8 +18,15 @@ public:
     virtual ~ImageCodecPlugin() override;
 
     virtual NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> decode_image(ReadonlyBytes, Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected) override;
+    virtual NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> decode_partial_image(ReadonlyBytes, Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected) override;
 
 private:
+    enum class IsPartialData {
+        No,
+        Yes,
+    };
+    NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> start_decoding(ReadonlyBytes, Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, IsPartialData);
+
     RefPtr<ImageDecoderClient::Client> m_client;
 };
 
@@ -7,6 +7,9 @@
 #include "Application.h"
 #include "StringUtils.h"
 #include "TaskManagerWindow.h"
+#include <Ladybird/HelperProcess.h>
+#include <Ladybird/Utilities.h>
+#include <LibCore/EventLoop.h>
 #include <LibWebView/URL.h>
 #include <QFileOpenEvent>
 
@@ -43,6 +46,64 @@ bool Application::event(QEvent* event)
     return QApplication::event(event);
 }
 
+ErrorOr<Optional<IPC::File>> Application::request_server_socket_for_web_content_process(WebContentOptions const& web_content_options)
+{
+    if (web_content_options.use_lagom_networking == UseLagomNetworking::No)
+        return OptionalNone {};
+    return Optional<IPC::File> { TRY(connect_new_request_server_client(*request_server_client)) };
+}
+
+ErrorOr<NonnullRefPtr<WebView::WebContentClient>> Application::launch_web_content_process(WebView::ViewImplementation& view, WebContentOptions const& web_content_options)
+{
+    RefPtr<WebView::WebContentClient> client;
+
+    if (m_spare_web_content_client && m_spare_web_content_options == web_content_options) {
+        client = move(m_spare_web_content_client);
+        client->adopt_view(view);
+    } else {
+        auto candidate_web_content_paths = TRY(get_paths_for_helper_process("WebContent"sv));
+        auto request_server_socket = TRY(request_server_socket_for_web_content_process(web_content_options));
+        client = TRY(::launch_web_content_process(view, candidate_web_content_paths, web_content_options, move(request_server_socket)));
+    }
+
+    // Keep a process around that has already gone through its startup, so that the next tab doesn't have to wait for it.
+    // NOTE: Processes that are waiting on a debugger or running under callgrind are better off not being launched speculatively.
+    if (web_content_options.wait_for_debugger == WaitForDebugger::No && web_content_options.enable_callgrind_profiling == EnableCallgrindProfiling::No) {
+        Core::deferred_invoke([this, web_content_options] {
+            if (!m_spare_web_content_client)
+                launch_spare_web_content_process(web_content_options);
+        });
+    }
+
+    return client.release_nonnull();
+}
+
+void Application::launch_spare_web_content_process(WebContentOptions const& web_content_options)
+{
+    auto candidate_web_content_paths = get_paths_for_helper_process("WebContent"sv);
+    if (candidate_web_content_paths.is_error())
+        return;
+    auto request_server_socket = request_server_socket_for_web_content_process(web_content_options);
+    if (request_server_socket.is_error())
+        return;
+
+    auto client = ::launch_spare_web_content_process(candidate_web_content_paths.value(), web_content_options, request_server_socket.release_value());
+    if (client.is_error()) {
+        warnln("Unable to launch spare WebContent process: {}", client.error());
+        return;
+    }
+
+    m_spare_web_content_client = client.release_value();
+    m_spare_web_content_options = web_content_options;
+
+    // The view that adopts this process replaces this handler with its own.
+    m_spare_web_content_client->on_web_content_process_crash = [this] {
+        Core::deferred_invoke([this] {
+            m_spare_web_content_client = nullptr;
+        });
+    };
+}
+
 void Application::show_task_manager_window()
 {
     if (!m_task_manager_window) {
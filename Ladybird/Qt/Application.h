@@ -11,6 +11,7 @@
 #include <Ladybird/Qt/BrowserWindow.h>
 #include <LibProtocol/RequestClient.h>
 #include <LibURL/URL.h>
+#include <LibWebView/WebContentClient.h>
 #include <QApplication>
 
 namespace Ladybird {
@@ -29,6 +30,9 @@ public:
 
     BrowserWindow& new_window(Vector<URL::URL> const& initial_urls, WebView::CookieJar&, WebContentOptions const&, StringView webdriver_content_ipc_path, Tab* parent_tab = nullptr, Optional<u64> page_index = {});
 
+    ErrorOr<NonnullRefPtr<WebView::WebContentClient>> launch_web_content_process(WebView::ViewImplementation&, WebContentOptions const&);
+    ErrorOr<Optional<IPC::File>> request_server_socket_for_web_content_process(WebContentOptions const&);
+
     void show_task_manager_window();
     void close_task_manager_window();
 
@@ -36,6 +40,11 @@ public:
     void set_active_window(BrowserWindow& w) { m_active_window = &w; }
 
 private:
+    void launch_spare_web_content_process(WebContentOptions const&);
+
+    RefPtr<WebView::WebContentClient> m_spare_web_content_client;
+    WebContentOptions m_spare_web_content_options;
+
     TaskManagerWindow* m_task_manager_window { nullptr };
     BrowserWindow* m_active_window { nullptr };
 };
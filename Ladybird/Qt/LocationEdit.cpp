@@ -5,6 +5,7 @@
  */
 
 #include "LocationEdit.h"
+#include "Application.h"
 #include "Settings.h"
 #include "StringUtils.h"
 #include <LibURL/URL.h>
@@ -36,8 +37,14 @@ LocationEdit::LocationEdit(QWidget* parent)
 
         auto query = ak_string_from_qstring(text());
 
-        if (auto url = WebView::sanitize_url(query, search_engine_url); url.has_value())
+        if (auto url = WebView::sanitize_url(query, search_engine_url); url.has_value()) {
             setText(qstring_from_ak_string(url->serialize()));
+
+            // Start connecting while the tab's WebContent process is still getting the navigation request.
+            auto& application = static_cast<Ladybird::Application&>(*QApplication::instance());
+            if (application.request_server_client && url->scheme().is_one_of("http"sv, "https"sv))
+                application.request_server_client->ensure_connection(*url, RequestServer::CacheLevel::CreateConnection);
+        }
     });
 
     connect(this, &QLineEdit::textEdited, [this] {
@@ -25,12 +25,12 @@ void RequestManagerQt::reply_finished(QNetworkReply* reply)
     request->did_finish();
 }
 
-RefPtr<Web::ResourceLoaderConnectorRequest> RequestManagerQt::start_request(ByteString const& method, URL::URL const& url, HTTP::HeaderMap const& request_headers, ReadonlyBytes request_body, Core::ProxyData const& proxy)
+RefPtr<Web::ResourceLoaderConnectorRequest> RequestManagerQt::start_request(ByteString const& method, URL::URL const& url, HTTP::HeaderMap const& request_headers, ReadonlyBytes request_body, Core::ProxyData const& proxy, HTTP::RequestPriority priority)
 {
     if (!url.scheme().bytes_as_string_view().is_one_of_ignoring_ascii_case("http"sv, "https"sv)) {
         return nullptr;
     }
-    auto request_or_error = Request::create(*m_qnam, method, url, request_headers, request_body, proxy);
+    auto request_or_error = Request::create(*m_qnam, method, url, request_headers, request_body, proxy, priority);
     if (request_or_error.is_error()) {
         return nullptr;
     }
@@ -39,7 +39,7 @@ RefPtr<Web::ResourceLoaderConnectorRequest> RequestManagerQt::start_request(Byte
     return request;
 }
 
-ErrorOr<NonnullRefPtr<RequestManagerQt::Request>> RequestManagerQt::Request::create(QNetworkAccessManager& qnam, ByteString const& method, URL::URL const& url, HTTP::HeaderMap const& request_headers, ReadonlyBytes request_body, Core::ProxyData const&)
+ErrorOr<NonnullRefPtr<RequestManagerQt::Request>> RequestManagerQt::Request::create(QNetworkAccessManager& qnam, ByteString const& method, URL::URL const& url, HTTP::HeaderMap const& request_headers, ReadonlyBytes request_body, Core::ProxyData const&, HTTP::RequestPriority priority)
 {
     QNetworkRequest request { QString(url.to_byte_string().characters()) };
     request.setAttribute(QNetworkRequest::RedirectPolicyAttribute, QNetworkRequest::ManualRedirectPolicy);
@@ -49,6 +49,18 @@ ErrorOr<NonnullRefPtr<RequestManagerQt::Request>> RequestManagerQt::Request::cre
     // NOTE: We disable HTTP2 as it's significantly slower (up to 5x, possibly more)
     request.setAttribute(QNetworkRequest::Http2AllowedAttribute, false);
 
+    switch (priority) {
+    case HTTP::RequestPriority::Low:
+        request.setPriority(QNetworkRequest::LowPriority);
+        break;
+    case HTTP::RequestPriority::Normal:
+        request.setPriority(QNetworkRequest::NormalPriority);
+        break;
+    case HTTP::RequestPriority::High:
+        request.setPriority(QNetworkRequest::HighPriority);
+        break;
+    }
+
     QNetworkReply* reply = nullptr;
 
     for (auto const& it : request_headers.headers()) {
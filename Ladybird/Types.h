@@ -67,6 +67,8 @@ struct WebContentOptions {
     LogAllJSExceptions log_all_js_exceptions { LogAllJSExceptions::No };
     EnableIDLTracing enable_idl_tracing { EnableIDLTracing::No };
     ExposeInternalsObject expose_internals_object { ExposeInternalsObject::No };
+
+    bool operator==(WebContentOptions const&) const = default;
 };
 
 }
@@ -42,6 +42,7 @@ set(ELF_IMAGE_DEBUG ON)
 set(EMOJI_DEBUG ON)
 set(ENABLE_KERNEL_COVERAGE_COLLECTION ON)
 set(ENABLE_KERNEL_COVERAGE_COLLECTION_DEBUG ON)
+set(EPOLL_DEBUG ON)
 set(ESCAPE_SEQUENCE_DEBUG ON)
 set(ETHERNET_DEBUG ON)
 set(EVENT_DEBUG ON)
@@ -86,6 +87,7 @@ set(INTEL_HDA_DEBUG ON)
 set(INTERRUPT_DEBUG ON)
 set(IOAPIC_DEBUG ON)
 set(IO_DEBUG ON)
+set(IO_RING_DEBUG ON)
 set(IPV4_DEBUG ON)
 set(IPV4_SOCKET_DEBUG ON)
 set(IRQ_DEBUG ON)
@@ -112,6 +114,7 @@ set(LOCK_IN_CRITICAL_DEBUG ON)
 set(LOCK_RANK_ENFORCEMENT ON)
 set(LOCK_RESTORE_DEBUG ON)
 set(LOCK_SHARED_UPGRADE_DEBUG ON)
+set(LOCK_STATISTICS ON)
 set(LOCK_TRACE_DEBUG ON)
 set(LOOKUPSERVER_DEBUG ON)
 set(LOOPBACK_DEBUG ON)
@@ -41,6 +41,7 @@ static ByteString pascal_case(ByteString const& identifier)
 }
 
 struct Message {
+    Vector<ByteString> attributes;
     ByteString name;
     bool is_synchronous { false };
     Vector<Parameter> inputs;
@@ -109,6 +110,23 @@ Vector<Endpoint> parse(ByteBuffer const& file_contents)
             lexer.ignore_until('\n');
     };
 
+    auto parse_attributes = [&](Vector<ByteString>& storage) {
+        if (!lexer.consume_specific('['))
+            return;
+        for (;;) {
+            if (lexer.consume_specific(']')) {
+                consume_whitespace();
+                break;
+            }
+            if (lexer.consume_specific(',')) {
+                consume_whitespace();
+            }
+            auto attribute = lexer.consume_until([](char ch) { return ch == ']' || ch == ','; });
+            storage.append(attribute);
+            consume_whitespace();
+        }
+    };
+
     auto parse_parameter_type = [&]() {
         ByteString parameter_type = lexer.consume_until([](char ch) { return ch == '<' || isspace(ch); });
         if (lexer.peek() == '<') {
@@ -150,20 +168,7 @@ Vector<Endpoint> parse(ByteBuffer const& file_contents)
             consume_whitespace();
             if (lexer.peek() == ')')
                 break;
-            if (lexer.consume_specific('[')) {
-                for (;;) {
-                    if (lexer.consume_specific(']')) {
-                        consume_whitespace();
-                        break;
-                    }
-                    if (lexer.consume_specific(',')) {
-                        consume_whitespace();
-                    }
-                    auto attribute = lexer.consume_until([](char ch) { return ch == ']' || ch == ','; });
-                    parameter.attributes.append(attribute);
-                    consume_whitespace();
-                }
-            }
+            parse_attributes(parameter.attributes);
             parameter.type = parse_parameter_type();
             if (parameter.type.ends_with(',') || parameter.type.ends_with(')')) {
                 warnln("Parameter {} of method: {} must be named", parameter_index, message_name);
@@ -196,6 +201,7 @@ Vector<Endpoint> parse(ByteBuffer const& file_contents)
     auto parse_message = [&] {
         Message message;
         consume_whitespace();
+        parse_attributes(message.attributes);
         message.name = lexer.consume_until([](char ch) { return isspace(ch) || ch == '('; });
         consume_whitespace();
         assert_specific('(');
@@ -222,6 +228,11 @@ Vector<Endpoint> parse(ByteBuffer const& file_contents)
 
         consume_whitespace();
 
+        if (message.is_synchronous && message.attributes.contains_slow("Coalesce")) {
+            warnln("Synchronous message {} can't be coalesced", message.name);
+            VERIFY_NOT_REACHED();
+        }
+
         endpoints.last().messages.append(move(message));
     };
 
@@ -327,7 +338,7 @@ ByteString constructor_for_message(ByteString const& name, Vector<Parameter> con
     return builder.to_byte_string();
 }
 
-void do_message(SourceGenerator message_generator, ByteString const& name, Vector<Parameter> const& parameters, ByteString const& response_type = {})
+void do_message(SourceGenerator message_generator, ByteString const& name, Vector<Parameter> const& parameters, ByteString const& response_type = {}, bool is_coalescable = false)
 {
     auto pascal_name = pascal_case(name);
     message_generator.set("message.name", name);
@@ -370,8 +381,24 @@ public:)~~~");
     virtual u32 endpoint_magic() const override { return @endpoint.magic@; }
     virtual i32 message_id() const override { return (int)MessageID::@message.pascal_name@; }
     static i32 static_message_id() { return (int)MessageID::@message.pascal_name@; }
-    virtual const char* message_name() const override { return "@endpoint.name@::@message.pascal_name@"; }
+    virtual const char* message_name() const override { return "@endpoint.name@::@message.pascal_name@"; })~~~");
 
+    if (is_coalescable) {
+        StringBuilder builder;
+        builder.append("other.endpoint_magic() == endpoint_magic() && other.message_id() == message_id()"sv);
+        for (auto const& parameter : parameters) {
+            if (parameter.attributes.contains_slow("CoalesceKey"))
+                builder.appendff(" && static_cast<{} const&>(other).m_{} == m_{}", pascal_name, parameter.name, parameter.name);
+        }
+        message_generator.set("message.supersedes_condition", builder.to_byte_string());
+        message_generator.appendln(R"~~~(
+    virtual bool supersedes(IPC::Message const& other) const override
+    {
+        return @message.supersedes_condition@;
+    })~~~");
+    }
+
+    message_generator.appendln(R"~~~(
     static ErrorOr<NonnullOwnPtr<@message.pascal_name@>> decode(Stream& stream, Queue<IPC::File>& files)
     {
         IPC::Decoder decoder { stream, files };)~~~");
@@ -583,7 +610,7 @@ void build_endpoint(SourceGenerator generator, Endpoint const& endpoint)
             response_name = message.response_name();
             do_message(generator.fork(), response_name, message.outputs);
         }
-        do_message(generator.fork(), message.name, message.inputs, response_name);
+        do_message(generator.fork(), message.name, message.inputs, response_name, message.attributes.contains_slow("Coalesce"));
     }
 
     generator.appendln(R"~~~(
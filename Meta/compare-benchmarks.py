@@ -0,0 +1,87 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2026, the SerenityOS developers.
+#
+# SPDX-License-Identifier: BSD-2-Clause
+
+"""
+Compares LibTest benchmark results against a saved baseline and flags regressions.
+
+    Build/lagom/bin/TestVector --bench --benchmark_json baseline/TestVector.json
+    # ... make changes, rebuild ...
+    Build/lagom/bin/TestVector --bench --benchmark_json current/TestVector.json
+    Meta/compare-benchmarks.py baseline current
+
+Both arguments can either be result files, or directories of result files that are matched up by
+file name. A benchmark regressed if its median got slower by more than the threshold, and by more
+than the noise of the two runs. The script exits with 1 if any benchmark regressed.
+"""
+
+import argparse
+import json
+import pathlib
+import sys
+
+
+def load_results(path):
+    files = sorted(path.glob("*.json")) if path.is_dir() else [path]
+    results = {}
+    for file in files:
+        with open(file) as f:
+            suite = json.load(f)
+        for name, benchmark in suite["benchmarks"].items():
+            results[f"{file.stem}.{name}" if path.is_dir() else name] = benchmark
+    return results
+
+
+def format_nanoseconds(nanoseconds):
+    for unit, scale in (("s", 1e9), ("ms", 1e6), ("us", 1e3)):
+        if nanoseconds >= scale:
+            return f"{nanoseconds / scale:.3f}{unit}"
+    return f"{nanoseconds:.1f}ns"
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare LibTest benchmark results against a baseline")
+    parser.add_argument("baseline", type=pathlib.Path, help="baseline result file or directory")
+    parser.add_argument("current", type=pathlib.Path, help="current result file or directory")
+    parser.add_argument("--threshold", type=float, default=5.0,
+                        help="percentage by which a median has to get slower to count as a regression (default: 5)")
+    args = parser.parse_args()
+
+    baseline = load_results(args.baseline)
+    current = load_results(args.current)
+
+    regressions = []
+    for name in sorted(baseline.keys() & current.keys()):
+        old = baseline[name]
+        new = current[name]
+        old_median = old["median_ns"]
+        new_median = new["median_ns"]
+        if old_median == 0:
+            continue
+
+        change = (new_median - old_median) / old_median * 100
+        # A difference that's within the spread of the samples is most likely noise.
+        noise = 2 * max(old["standard_deviation_ns"], new["standard_deviation_ns"])
+        status = ""
+        if change > args.threshold and new_median - old_median > noise:
+            status = "REGRESSED"
+            regressions.append(name)
+        elif change < -args.threshold and old_median - new_median > noise:
+            status = "improved"
+
+        times = f"{format_nanoseconds(old_median):>12} {format_nanoseconds(new_median):>12}"
+        print(f"{name:50} {times} {change:+7.1f}%  {status}".rstrip())
+
+    for name in sorted(baseline.keys() - current.keys()):
+        print(f"{name:50} missing from current results", file=sys.stderr)
+
+    if regressions:
+        print(f"\n{len(regressions)} benchmark(s) regressed by more than {args.threshold}%", file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,101 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2026, the SerenityOS developers.
+#
+# SPDX-License-Identifier: BSD-2-Clause
+
+"""
+Runs the LibJS benchmark corpus through the js binary and reports the results as JSON.
+
+    Meta/run-js-benchmarks.py --js Build/lagom/bin/js --iterations 5 > results.json
+
+Each benchmark is run as its own process, so the reported times include startup. Compare
+two result files with --compare to see which benchmarks got faster or slower.
+"""
+
+import argparse
+import json
+import os
+import pathlib
+import resource
+import statistics
+import subprocess
+import sys
+import time
+
+DEFAULT_CORPUS = pathlib.Path(__file__).resolve().parent.parent / "Tests" / "LibJS" / "Benchmarks"
+
+
+def run_once(js, benchmark):
+    before = resource.getrusage(resource.RUSAGE_CHILDREN)
+    start = time.perf_counter()
+    process = subprocess.run([js, "--disable-debug-output", str(benchmark)],
+                             stdout=subprocess.DEVNULL, stderr=subprocess.PIPE)
+    wall_time = time.perf_counter() - start
+    after = resource.getrusage(resource.RUSAGE_CHILDREN)
+
+    if process.returncode != 0:
+        raise RuntimeError(f"{benchmark.name} exited with {process.returncode}:\n{process.stderr.decode()}")
+
+    return {
+        "wall_time": wall_time,
+        "user_time": after.ru_utime - before.ru_utime,
+        "system_time": after.ru_stime - before.ru_stime,
+        # NOTE: ru_maxrss is the peak of all children so far, so this is only meaningful for the largest benchmark.
+        "max_rss_kib": after.ru_maxrss,
+    }
+
+
+def run_benchmarks(args):
+    benchmarks = sorted(args.corpus.glob("*.js"))
+    if args.filter:
+        benchmarks = [benchmark for benchmark in benchmarks if args.filter in benchmark.name]
+
+    results = {}
+    for benchmark in benchmarks:
+        runs = [run_once(args.js, benchmark) for _ in range(args.iterations)]
+        wall_times = [run["wall_time"] for run in runs]
+        results[benchmark.stem] = {
+            "iterations": args.iterations,
+            "wall_time_min": min(wall_times),
+            "wall_time_median": statistics.median(wall_times),
+            "user_time_median": statistics.median(run["user_time"] for run in runs),
+            "system_time_median": statistics.median(run["system_time"] for run in runs),
+            "max_rss_kib": max(run["max_rss_kib"] for run in runs),
+        }
+        print(f"{benchmark.stem}: {results[benchmark.stem]['wall_time_median']:.3f}s", file=sys.stderr)
+
+    json.dump(results, sys.stdout, indent=4)
+    print()
+
+
+def compare_results(args):
+    with open(args.compare[0]) as file:
+        old = json.load(file)
+    with open(args.compare[1]) as file:
+        new = json.load(file)
+
+    for name in sorted(old.keys() & new.keys()):
+        old_time = old[name]["wall_time_median"]
+        new_time = new[name]["wall_time_median"]
+        change = (new_time - old_time) / old_time * 100
+        print(f"{name:30} {old_time:8.3f}s {new_time:8.3f}s {change:+7.1f}%")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Run the LibJS benchmark corpus")
+    parser.add_argument("--js", default=os.environ.get("JS_BINARY", "js"), help="path to the js binary")
+    parser.add_argument("--corpus", type=pathlib.Path, default=DEFAULT_CORPUS, help="directory of benchmark scripts")
+    parser.add_argument("--iterations", type=int, default=3, help="number of runs per benchmark")
+    parser.add_argument("--filter", help="only run benchmarks whose file name contains this string")
+    parser.add_argument("--compare", nargs=2, metavar=("OLD", "NEW"), help="compare two result files instead")
+    args = parser.parse_args()
+
+    if args.compare:
+        compare_results(args)
+    else:
+        run_benchmarks(args)
+
+
+if __name__ == "__main__":
+    main()
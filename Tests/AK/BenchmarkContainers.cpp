@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/CircularDeque.h>
+#include <AK/HashMap.h>
+#include <AK/HashTable.h>
+#include <AK/QuickSort.h>
+#include <AK/String.h>
+#include <AK/Vector.h>
+
+static constexpr size_t element_count = 1000;
+
+static Vector<u32> make_shuffled_keys(size_t count)
+{
+    Vector<u32> keys;
+    keys.ensure_capacity(count);
+    // A full-period LCG, so every key is distinct without needing a random source.
+    u32 state = 12345;
+    for (size_t i = 0; i < count; ++i) {
+        state = state * 1664525u + 1013904223u;
+        keys.unchecked_append(state);
+    }
+    return keys;
+}
+
+BENCHMARK_CASE(vector_append)
+{
+    Vector<u32> vector;
+    for (u32 i = 0; i < element_count; ++i)
+        vector.append(i);
+    Test::do_not_optimize(vector.data());
+}
+
+BENCHMARK_CASE(vector_append_with_inline_capacity)
+{
+    Vector<u32, 16> vector;
+    for (u32 i = 0; i < 16; ++i)
+        vector.append(i);
+    Test::do_not_optimize(vector.data());
+}
+
+BENCHMARK_CASE(vector_iterate)
+{
+    static auto const vector = make_shuffled_keys(element_count);
+    u64 sum = 0;
+    for (auto value : vector)
+        sum += value;
+    Test::do_not_optimize(sum);
+}
+
+BENCHMARK_CASE(vector_quick_sort)
+{
+    static auto const keys = make_shuffled_keys(element_count);
+    auto vector = keys;
+    quick_sort(vector);
+    Test::do_not_optimize(vector.data());
+}
+
+BENCHMARK_CASE(hash_table_set)
+{
+    static auto const keys = make_shuffled_keys(element_count);
+    HashTable<u32> table;
+    for (auto key : keys)
+        table.set(key);
+    Test::do_not_optimize(table.size());
+}
+
+BENCHMARK_CASE(hash_map_set)
+{
+    static auto const keys = make_shuffled_keys(element_count);
+    HashMap<u32, u32> map;
+    for (auto key : keys)
+        map.set(key, key);
+    Test::do_not_optimize(map.size());
+}
+
+BENCHMARK_CASE(hash_map_get)
+{
+    static auto const keys = make_shuffled_keys(element_count);
+    static auto const map = [] {
+        HashMap<u32, u32> map;
+        for (auto key : keys)
+            map.set(key, key);
+        return map;
+    }();
+
+    u64 sum = 0;
+    for (auto key : keys)
+        sum += map.get(key).value();
+    Test::do_not_optimize(sum);
+}
+
+BENCHMARK_CASE(hash_map_string_keys)
+{
+    static auto const keys = [] {
+        Vector<String> keys;
+        for (auto key : make_shuffled_keys(element_count))
+            keys.append(MUST(String::number(key)));
+        return keys;
+    }();
+
+    HashMap<String, size_t> map;
+    for (size_t i = 0; i < keys.size(); ++i)
+        map.set(keys[i], i);
+    u64 sum = 0;
+    for (auto const& key : keys)
+        sum += map.get(key).value();
+    Test::do_not_optimize(sum);
+}
+
+BENCHMARK_CASE(circular_deque_push_and_pop)
+{
+    CircularDeque<u32, 64> deque;
+    for (u32 i = 0; i < element_count; ++i) {
+        if (deque.size() == deque.capacity())
+            deque.dequeue();
+        deque.enqueue(i);
+    }
+    Test::do_not_optimize(deque.first());
+}
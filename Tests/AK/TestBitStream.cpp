@@ -132,6 +132,23 @@ TEST_CASE(big_endian_bit_stream_input_output_match)
     }
 }
 
+TEST_CASE(big_endian_bit_stream_read_unary)
+{
+    // 1 | 001 | 0000 0000 0001 | 01 | 000 (three bits) | 001
+    Array<u8, 3> const test_data { 0b1001'0000, 0b0000'0001, 0b0100'0001 };
+    auto memory_stream = make<FixedMemoryStream>(test_data);
+    BigEndianInputBitStream bit_stream { MaybeOwned<Stream>(*memory_stream) };
+
+    EXPECT_EQ(MUST(bit_stream.read_unary()), 0u);
+    EXPECT_EQ(MUST(bit_stream.read_unary()), 2u);
+    EXPECT_EQ(MUST(bit_stream.read_unary()), 11u);
+    EXPECT_EQ(MUST(bit_stream.read_unary()), 1u);
+    EXPECT_EQ(MUST(bit_stream.read_bits<u8>(3)), 0b000u);
+    EXPECT_EQ(MUST(bit_stream.read_unary()), 2u);
+    EXPECT(bit_stream.is_aligned_to_byte_boundary());
+    EXPECT(bit_stream.read_unary().is_error());
+}
+
 TEST_CASE(bit_reads_beyond_stream_limits)
 {
     Array<u8, 1> const test_data { 0xFF };
@@ -0,0 +1,313 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/ByteString.h>
+#include <AK/FlatHashTable.h>
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Vector.h>
+
+TEST_CASE(construct)
+{
+    using IntTable = FlatHashTable<int>;
+    EXPECT(IntTable().is_empty());
+    EXPECT_EQ(IntTable().size(), 0u);
+    EXPECT(IntTable().begin() == IntTable().end());
+}
+
+TEST_CASE(basic_move)
+{
+    FlatHashTable<int> foo;
+    foo.set(1);
+    EXPECT_EQ(foo.size(), 1u);
+    auto bar = move(foo);
+    EXPECT_EQ(bar.size(), 1u);
+    EXPECT_EQ(foo.size(), 0u);
+    foo = move(bar);
+    EXPECT_EQ(bar.size(), 0u);
+    EXPECT_EQ(foo.size(), 1u);
+    EXPECT(foo.contains(1));
+}
+
+TEST_CASE(copy)
+{
+    FlatHashTable<ByteString> strings;
+    strings.set("One");
+    strings.set("Two");
+
+    auto copy = strings;
+    strings.remove("One");
+    EXPECT_EQ(copy.size(), 2u);
+    EXPECT(copy.contains("One"sv));
+    EXPECT(copy.contains("Two"sv));
+}
+
+TEST_CASE(range_loop)
+{
+    FlatHashTable<ByteString> strings;
+    EXPECT_EQ(strings.set("One"), AK::HashSetResult::InsertedNewEntry);
+    EXPECT_EQ(strings.set("Two"), AK::HashSetResult::InsertedNewEntry);
+    EXPECT_EQ(strings.set("Three"), AK::HashSetResult::InsertedNewEntry);
+
+    int loop_counter = 0;
+    for (auto& it : strings) {
+        EXPECT_EQ(it.is_empty(), false);
+        ++loop_counter;
+    }
+    EXPECT_EQ(loop_counter, 3);
+}
+
+TEST_CASE(set_existing_entry)
+{
+    FlatHashTable<ByteString, CaseInsensitiveStringTraits> strings;
+    EXPECT_EQ(strings.set("nickserv"), AK::HashSetResult::InsertedNewEntry);
+    EXPECT_EQ(strings.set("NickServ"), AK::HashSetResult::ReplacedExistingEntry);
+    EXPECT_EQ(strings.set("NICKSERV", AK::HashSetExistingEntryBehavior::Keep), AK::HashSetResult::KeptExistingEntry);
+    EXPECT_EQ(strings.size(), 1u);
+    EXPECT_EQ(*strings.begin(), "NickServ");
+}
+
+TEST_CASE(remove_all_matching)
+{
+    FlatHashTable<int> ints;
+    for (int i = 0; i < 100; ++i)
+        ints.set(i);
+
+    EXPECT_EQ(ints.remove_all_matching([&](int value) { return value >= 50; }), true);
+    EXPECT_EQ(ints.remove_all_matching([&](int) { return false; }), false);
+    EXPECT_EQ(ints.size(), 50u);
+    for (int i = 0; i < 100; ++i)
+        EXPECT_EQ(ints.contains(i), i < 50);
+
+    EXPECT_EQ(ints.remove_all_matching([&](int) { return true; }), true);
+    EXPECT(ints.is_empty());
+}
+
+TEST_CASE(many_strings)
+{
+    FlatHashTable<ByteString> strings;
+    for (int i = 0; i < 999; ++i)
+        EXPECT_EQ(strings.set(ByteString::number(i)), AK::HashSetResult::InsertedNewEntry);
+    EXPECT_EQ(strings.size(), 999u);
+    for (int i = 0; i < 999; ++i)
+        EXPECT(strings.contains(ByteString::number(i)));
+    for (int i = 0; i < 999; ++i)
+        EXPECT_EQ(strings.remove(ByteString::number(i)), true);
+    EXPECT_EQ(strings.is_empty(), true);
+}
+
+TEST_CASE(many_collisions)
+{
+    struct StringCollisionTraits : public DefaultTraits<ByteString> {
+        static unsigned hash(ByteString const&) { return 0; }
+    };
+
+    FlatHashTable<ByteString, StringCollisionTraits> strings;
+    for (int i = 0; i < 999; ++i)
+        EXPECT_EQ(strings.set(ByteString::number(i)), AK::HashSetResult::InsertedNewEntry);
+
+    EXPECT_EQ(strings.set("foo"), AK::HashSetResult::InsertedNewEntry);
+    EXPECT_EQ(strings.size(), 1000u);
+
+    for (int i = 0; i < 999; ++i)
+        EXPECT_EQ(strings.remove(ByteString::number(i)), true);
+
+    EXPECT(strings.find("foo") != strings.end());
+}
+
+TEST_CASE(tombstone_reuse)
+{
+    struct StringCollisionTraits : public DefaultTraits<ByteString> {
+        static unsigned hash(ByteString const&) { return 0; }
+    };
+
+    // Every value lands in the same group, so removing them has to leave tombstones behind.
+    FlatHashTable<ByteString, StringCollisionTraits> strings;
+    for (int i = 0; i < 32; ++i)
+        EXPECT_EQ(strings.set(ByteString::number(i)), AK::HashSetResult::InsertedNewEntry);
+    auto capacity = strings.capacity();
+
+    for (int i = 32; i < 9999; ++i) {
+        EXPECT_EQ(strings.set(ByteString::number(i)), AK::HashSetResult::InsertedNewEntry);
+        EXPECT_EQ(strings.remove(ByteString::number(i - 32)), true);
+    }
+
+    EXPECT_EQ(strings.size(), 32u);
+    EXPECT_EQ(strings.capacity(), capacity);
+    for (int i = 9999 - 32; i < 9999; ++i)
+        EXPECT(strings.contains(ByteString::number(i)));
+}
+
+TEST_CASE(capacity_leak)
+{
+    FlatHashTable<int> table;
+    for (size_t i = 0; i < 10000; ++i) {
+        table.set(i);
+        table.remove(i);
+    }
+    EXPECT(table.capacity() < 100u);
+}
+
+TEST_CASE(ensure_capacity)
+{
+    FlatHashTable<int> table;
+    table.ensure_capacity(1000);
+    auto capacity = table.capacity();
+    for (int i = 0; i < 1000; ++i)
+        table.set(i);
+    EXPECT_EQ(table.capacity(), capacity);
+}
+
+TEST_CASE(non_trivial_type_table)
+{
+    FlatHashTable<NonnullOwnPtr<int>> table;
+
+    table.set(make<int>(3));
+    table.set(make<int>(11));
+
+    for (int i = 0; i < 1'000; ++i) {
+        table.set(make<int>(-i));
+    }
+    for (int i = 0; i < 10'000; ++i) {
+        table.set(make<int>(i));
+        table.remove(make<int>(i));
+    }
+
+    EXPECT_EQ(table.remove_all_matching([&](auto&) { return true; }), true);
+    EXPECT(table.is_empty());
+    EXPECT_EQ(table.remove_all_matching([&](auto&) { return true; }), false);
+}
+
+TEST_CASE(clear_with_capacity)
+{
+    FlatHashTable<ByteString> strings;
+    for (int i = 0; i < 100; ++i)
+        strings.set(ByteString::number(i));
+    auto capacity = strings.capacity();
+
+    strings.clear_with_capacity();
+    EXPECT(strings.is_empty());
+    EXPECT_EQ(strings.capacity(), capacity);
+    EXPECT(!strings.contains("1"sv));
+    EXPECT(strings.begin() == strings.end());
+
+    strings.set("1");
+    EXPECT(strings.contains("1"sv));
+}
+
+TEST_CASE(iterator_removal)
+{
+    FlatHashTable<int> map;
+    map.set(0);
+    map.set(1);
+
+    auto it = map.begin();
+    map.remove(it);
+    EXPECT_EQ(it, map.end());
+    EXPECT_EQ(map.size(), 1u);
+}
+
+TEST_CASE(flat_hash_map)
+{
+    FlatHashMap<ByteString, int> map;
+    for (int i = 0; i < 1000; ++i)
+        map.set(ByteString::number(i), i);
+    EXPECT_EQ(map.size(), 1000u);
+    EXPECT_EQ(map.get("500"sv), 500);
+    EXPECT_EQ(map.take("500"sv), 500);
+    EXPECT(!map.contains("500"sv));
+    EXPECT_EQ(map.ensure("500", [] { return 500; }), 500);
+
+    auto clone = MUST(map.clone());
+    EXPECT_EQ(clone.size(), 1000u);
+    auto ordered_clone = MUST((map.clone<Traits<ByteString>, Traits<int>, true>()));
+    EXPECT_EQ(ordered_clone.size(), 1000u);
+
+    map.remove_all_matching([](auto&, int value) { return value % 2 == 0; });
+    EXPECT_EQ(map.size(), 500u);
+    for (auto& [key, value] : map)
+        EXPECT_EQ(value % 2, 1);
+}
+
+static constexpr int benchmark_value_count = 100'000;
+
+template<typename Map>
+static void benchmark_integer_lookups()
+{
+    Map map;
+    for (int i = 0; i < benchmark_value_count; ++i)
+        map.set(i * 7, i);
+
+    size_t hits = 0;
+    for (int round = 0; round < 10; ++round) {
+        for (int i = 0; i < benchmark_value_count * 2; ++i) {
+            if (map.contains(i))
+                ++hits;
+        }
+    }
+    EXPECT_EQ(hits, 10u * ((benchmark_value_count * 2 + 6) / 7));
+}
+
+template<typename Map>
+static void benchmark_string_lookups()
+{
+    Vector<ByteString> keys;
+    for (int i = 0; i < benchmark_value_count; ++i)
+        keys.append(ByteString::formatted("property_{}", i));
+
+    Map map;
+    for (int i = 0; i < benchmark_value_count; ++i)
+        map.set(keys[i], i);
+
+    for (int round = 0; round < 10; ++round) {
+        for (int i = 0; i < benchmark_value_count; ++i)
+            EXPECT_EQ(map.get(keys[i]), i);
+    }
+}
+
+template<typename Map>
+static void benchmark_churn()
+{
+    Map map;
+    for (int i = 0; i < benchmark_value_count * 10; ++i) {
+        map.set(i, i);
+        if (i >= 1000)
+            map.remove(i - 1000);
+    }
+    EXPECT_EQ(map.size(), 1000u);
+}
+
+BENCHMARK_CASE(hash_map_integer_lookups)
+{
+    benchmark_integer_lookups<HashMap<int, int>>();
+}
+
+BENCHMARK_CASE(flat_hash_map_integer_lookups)
+{
+    benchmark_integer_lookups<FlatHashMap<int, int>>();
+}
+
+BENCHMARK_CASE(hash_map_string_lookups)
+{
+    benchmark_string_lookups<HashMap<ByteString, int>>();
+}
+
+BENCHMARK_CASE(flat_hash_map_string_lookups)
+{
+    benchmark_string_lookups<FlatHashMap<ByteString, int>>();
+}
+
+BENCHMARK_CASE(hash_map_churn)
+{
+    benchmark_churn<HashMap<int, int>>();
+}
+
+BENCHMARK_CASE(flat_hash_map_churn)
+{
+    benchmark_churn<FlatHashMap<int, int>>();
+}
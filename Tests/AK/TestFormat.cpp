@@ -410,3 +410,58 @@ TEST_CASE(format_wchar)
     EXPECT_EQ(ByteString::formatted("{:6d}", L'a'), "    97");
     EXPECT_EQ(ByteString::formatted("{:#x}", L'\U0001F41E'), "0x1f41e");
 }
+
+TEST_CASE(format_integer_digit_pairs)
+{
+    EXPECT_EQ(ByteString::formatted("{}", 0), "0");
+    EXPECT_EQ(ByteString::formatted("{}", 7), "7");
+    EXPECT_EQ(ByteString::formatted("{}", 10), "10");
+    EXPECT_EQ(ByteString::formatted("{}", 99), "99");
+    EXPECT_EQ(ByteString::formatted("{}", 100), "100");
+    EXPECT_EQ(ByteString::formatted("{}", 1234567), "1234567");
+    EXPECT_EQ(ByteString::formatted("{}", NumericLimits<u64>::max()), "18446744073709551615");
+    EXPECT_EQ(ByteString::formatted("{}", NumericLimits<i64>::min()), "-9223372036854775808");
+    EXPECT_EQ(ByteString::formatted("{}", 10'000'000'000'000'000'000ull), "10000000000000000000");
+    EXPECT_EQ(ByteString::formatted("{{{}}}", 42), "{42}");
+    EXPECT_EQ(ByteString::formatted("}}{}{{", 42), "}42{");
+}
+
+TEST_CASE(format_integer_sign_and_prefix)
+{
+    EXPECT_EQ(ByteString::formatted("{:+}", 42), "+42");
+    EXPECT_EQ(ByteString::formatted("{: }", 42), " 42");
+    EXPECT_EQ(ByteString::formatted("{:+}", -42), "-42");
+    EXPECT_EQ(ByteString::formatted("{:#x}", 255), "0xff");
+    EXPECT_EQ(ByteString::formatted("{:#X}", 255), "0XFF");
+    EXPECT_EQ(ByteString::formatted("{:#b}", 5), "0b101");
+    EXPECT_EQ(ByteString::formatted("{:#o}", 8), "010");
+
+    // Zero-padded fields where the digits alone already fill the width must still get their sign and prefix.
+    EXPECT_EQ(ByteString::formatted("{:04}", -12345), "-12345");
+    EXPECT_EQ(ByteString::formatted("{:+04}", 12345), "+12345");
+    EXPECT_EQ(ByteString::formatted("{: 04}", 12345), " 12345");
+    EXPECT_EQ(ByteString::formatted("{:#04x}", 0x25a54), "0x25a54");
+    EXPECT_EQ(ByteString::formatted("{:#04X}", 0xfffd), "0XFFFD");
+    EXPECT_EQ(ByteString::formatted("{:#02b}", 5), "0b101");
+    EXPECT_EQ(ByteString::formatted("{:#04x}", -0x25a54), "-0x25a54");
+    EXPECT_EQ(ByteString::formatted("{:06}", -42), "-000042");
+    EXPECT_EQ(ByteString::formatted("{:#06x}", 0xff), "0x0000ff");
+}
+
+static constexpr size_t format_benchmark_iterations = 100'000;
+
+BENCHMARK_CASE(appendff_integers)
+{
+    StringBuilder builder;
+    for (size_t i = 0; i < format_benchmark_iterations; ++i)
+        builder.appendff("{} {} ", i, i * 2654435761u);
+    EXPECT(builder.length() > format_benchmark_iterations * 4);
+}
+
+BENCHMARK_CASE(appendff_doubles)
+{
+    StringBuilder builder;
+    for (size_t i = 0; i < format_benchmark_iterations; ++i)
+        builder.appendff("{} ", static_cast<double>(i) / 7.0);
+    EXPECT(builder.length() > format_benchmark_iterations * 4);
+}
@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/JsonObject.h>
+#include <AK/JsonStreamReader.h>
+#include <AK/NoAllocationGuard.h>
+#include <AK/StringBuilder.h>
+
+TEST_CASE(read_object)
+{
+    JsonStreamReader reader { R"( { "name": "Form1", "x": 155, "y": -10, "visible": true, "tooltip": null, "ratio": 0.5 } )"sv };
+    TRY_OR_FAIL(reader.enter_object());
+
+    EXPECT_EQ(TRY_OR_FAIL(reader.next_key()), "name"sv);
+    EXPECT_EQ(TRY_OR_FAIL(reader.read_string()), "Form1"sv);
+    EXPECT_EQ(TRY_OR_FAIL(reader.next_key()), "x"sv);
+    EXPECT_EQ(TRY_OR_FAIL(reader.read_number<u32>()), 155u);
+    EXPECT_EQ(TRY_OR_FAIL(reader.next_key()), "y"sv);
+    EXPECT_EQ(TRY_OR_FAIL(reader.read_number<i32>()), -10);
+    EXPECT_EQ(TRY_OR_FAIL(reader.next_key()), "visible"sv);
+    EXPECT_EQ(TRY_OR_FAIL(reader.read_bool()), true);
+    EXPECT_EQ(TRY_OR_FAIL(reader.next_key()), "tooltip"sv);
+    EXPECT_EQ(TRY_OR_FAIL(reader.peek_value_type()), JsonStreamReader::ValueType::Null);
+    TRY_OR_FAIL(reader.read_null());
+    EXPECT_EQ(TRY_OR_FAIL(reader.next_key()), "ratio"sv);
+    EXPECT_EQ(TRY_OR_FAIL(reader.read_double()), 0.5);
+
+    EXPECT(!TRY_OR_FAIL(reader.next_key()).has_value());
+    TRY_OR_FAIL(reader.finish());
+}
+
+TEST_CASE(read_array)
+{
+    JsonStreamReader reader { "[1, 2, [], [3], 4]"sv };
+    TRY_OR_FAIL(reader.enter_array());
+
+    Vector<u64> numbers;
+    while (TRY_OR_FAIL(reader.next_element())) {
+        if (TRY_OR_FAIL(reader.peek_value_type()) == JsonStreamReader::ValueType::Array) {
+            TRY_OR_FAIL(reader.enter_array());
+            while (TRY_OR_FAIL(reader.next_element()))
+                numbers.append(TRY_OR_FAIL(reader.read_number<u64>()));
+            continue;
+        }
+        numbers.append(TRY_OR_FAIL(reader.read_number<u64>()));
+    }
+    TRY_OR_FAIL(reader.finish());
+
+    EXPECT_EQ(numbers, (Vector<u64> { 1, 2, 3, 4 }));
+}
+
+TEST_CASE(escaped_strings)
+{
+    JsonStreamReader reader { R"({"a\"b": "c\ndé", "plain": ""})"sv };
+    TRY_OR_FAIL(reader.enter_object());
+    EXPECT_EQ(TRY_OR_FAIL(reader.next_key()), "a\"b"sv);
+    EXPECT_EQ(TRY_OR_FAIL(reader.read_string()), "c\ndé"sv);
+    EXPECT_EQ(TRY_OR_FAIL(reader.next_key()), "plain"sv);
+    EXPECT_EQ(TRY_OR_FAIL(reader.read_string()), ""sv);
+    EXPECT(!TRY_OR_FAIL(reader.next_key()).has_value());
+    TRY_OR_FAIL(reader.finish());
+}
+
+TEST_CASE(number_ranges)
+{
+    auto read = [](StringView input) {
+        JsonStreamReader reader { input };
+        return reader.read_number<i8>();
+    };
+    EXPECT_EQ(TRY_OR_FAIL(read("127"sv)), 127);
+    EXPECT_EQ(TRY_OR_FAIL(read("-128"sv)), -128);
+    EXPECT(read("128"sv).is_error());
+    EXPECT(read("-129"sv).is_error());
+    EXPECT(read("1.5"sv).is_error());
+    EXPECT(read("01"sv).is_error());
+    EXPECT(read("-"sv).is_error());
+
+    JsonStreamReader reader { "[18446744073709551615, -9223372036854775808, 18446744073709551616, -1]"sv };
+    TRY_OR_FAIL(reader.enter_array());
+    EXPECT(TRY_OR_FAIL(reader.next_element()));
+    EXPECT_EQ(TRY_OR_FAIL(reader.read_number<u64>()), NumericLimits<u64>::max());
+    EXPECT(TRY_OR_FAIL(reader.next_element()));
+    EXPECT_EQ(TRY_OR_FAIL(reader.read_number<i64>()), NumericLimits<i64>::min());
+    EXPECT(TRY_OR_FAIL(reader.next_element()));
+    EXPECT(reader.read_number<u64>().is_error());
+}
+
+TEST_CASE(skip_values)
+{
+    JsonStreamReader reader { R"({"skipped": {"a": [1, {"b": "]}\"["}, -2.5e3], "c": null}, "wanted": 42, "also_skipped": "x", "rest": [true, false]})"sv };
+    Optional<u32> wanted;
+    TRY_OR_FAIL(reader.for_each_member([&](StringView key) -> ErrorOr<void> {
+        if (key == "wanted"sv)
+            wanted = TRY(reader.read_number<u32>());
+        else
+            TRY(reader.skip_value());
+        return {};
+    }));
+    TRY_OR_FAIL(reader.finish());
+    EXPECT_EQ(wanted, 42u);
+}
+
+TEST_CASE(leave_container)
+{
+    JsonStreamReader reader { R"([{"first": 1, "second": [2, 3]}, 4, 5])"sv };
+    TRY_OR_FAIL(reader.enter_array());
+    EXPECT(TRY_OR_FAIL(reader.next_element()));
+    TRY_OR_FAIL(reader.enter_object());
+    EXPECT_EQ(TRY_OR_FAIL(reader.next_key()), "first"sv);
+    EXPECT_EQ(TRY_OR_FAIL(reader.read_number<u32>()), 1u);
+    TRY_OR_FAIL(reader.leave());
+    EXPECT(TRY_OR_FAIL(reader.next_element()));
+    EXPECT_EQ(TRY_OR_FAIL(reader.read_number<u32>()), 4u);
+    TRY_OR_FAIL(reader.leave());
+    TRY_OR_FAIL(reader.finish());
+}
+
+TEST_CASE(read_value)
+{
+    JsonStreamReader reader { R"({"object": {"a": [1, 2]}, "b": 3})"sv };
+    TRY_OR_FAIL(reader.enter_object());
+    EXPECT_EQ(TRY_OR_FAIL(reader.next_key()), "object"sv);
+    auto value = TRY_OR_FAIL(reader.read_value());
+    EXPECT(value.is_object());
+    EXPECT_EQ(value.as_object().get_array("a"sv)->size(), 2u);
+    EXPECT_EQ(TRY_OR_FAIL(reader.next_key()), "b"sv);
+    EXPECT_EQ(TRY_OR_FAIL(reader.read_number<u32>()), 3u);
+    EXPECT(!TRY_OR_FAIL(reader.next_key()).has_value());
+    TRY_OR_FAIL(reader.finish());
+}
+
+TEST_CASE(malformed_input)
+{
+    auto skip = [](StringView input) -> ErrorOr<void> {
+        JsonStreamReader reader { input };
+        TRY(reader.skip_value());
+        return reader.finish();
+    };
+    EXPECT(!skip(R"({"a": [1, 2]})"sv).is_error());
+    EXPECT(skip(R"({"a": [1, 2})"sv).is_error());
+    EXPECT(skip(R"({"a": [1, 2]}})"sv).is_error());
+    EXPECT(skip(R"({"a": "unterminated})"sv).is_error());
+    EXPECT(skip("nul"sv).is_error());
+
+    auto visit = [](StringView input) -> ErrorOr<void> {
+        JsonStreamReader reader { input };
+        TRY(reader.enter_object());
+        while (TRY(reader.next_key()).has_value())
+            TRY(reader.skip_value());
+        return reader.finish();
+    };
+    EXPECT(!visit(R"({"a": 1, "b": 2})"sv).is_error());
+    EXPECT(visit(R"({"a": 1 "b": 2})"sv).is_error());
+    EXPECT(visit(R"({"a": 1,})"sv).is_error());
+    EXPECT(visit(R"({"a" 1})"sv).is_error());
+    EXPECT(visit(R"({"a": 1)"sv).is_error());
+    EXPECT(visit(R"({"a": 1} x)"sv).is_error());
+
+    JsonStreamReader reader { "[1]"sv };
+    TRY_OR_FAIL(reader.enter_array());
+    EXPECT(reader.next_key().is_error());
+}
+
+TEST_CASE(skipping_does_not_allocate)
+{
+    JsonStreamReader reader { R"({"processes": [{"pid": 1, "name": "Kernel", "threads": [{"tid": 1}]}], "total_time": 1234})"sv };
+    EXPECT_NO_CRASH("Read", [&] {
+        NoAllocationGuard guard;
+        MUST(reader.for_each_member([&](StringView key) -> ErrorOr<void> {
+            if (key == "total_time"sv)
+                EXPECT_EQ(TRY(reader.read_number<u64>()), 1234u);
+            else
+                TRY(reader.skip_value());
+            return {};
+        }));
+        MUST(reader.finish());
+        return Test::Crash::Failure::DidNotCrash;
+    });
+}
+
+static ByteString make_process_list(size_t process_count)
+{
+    StringBuilder builder;
+    builder.append("{\"processes\":["sv);
+    for (size_t i = 0; i < process_count; ++i) {
+        if (i != 0)
+            builder.append(',');
+        builder.appendff(R"({{"pid":{},"pgid":{},"uid":100,"name":"Process {}","executable":"/bin/Process","tty":"","pledge":"stdio rpath","veil":"None","amount_virtual":123456789,"kernel":false,"threads":[)", i, i, i);
+        for (size_t j = 0; j < 4; ++j) {
+            if (j != 0)
+                builder.append(',');
+            builder.appendff(R"({{"tid":{},"name":"Thread {}","times_scheduled":{},"time_user":{},"time_kernel":{},"state":"Blocking","cpu":0,"priority":30}})", i * 4 + j, j, i * j, i * 100, j * 100);
+        }
+        builder.append("]}"sv);
+    }
+    builder.append("],\"total_time\":123456,\"total_time_kernel\":789}"sv);
+    return builder.to_byte_string();
+}
+
+BENCHMARK_CASE(process_list_as_json_value)
+{
+    auto json = make_process_list(500);
+    for (size_t round = 0; round < 20; ++round) {
+        auto value = MUST(JsonValue::from_string(json));
+        size_t thread_count = 0;
+        value.as_object().get_array("processes"sv)->for_each([&](auto& process) {
+            thread_count += process.as_object().get_array("threads"sv)->size();
+        });
+        EXPECT_EQ(thread_count, 2000u);
+    }
+}
+
+BENCHMARK_CASE(process_list_with_stream_reader)
+{
+    auto json = make_process_list(500);
+    for (size_t round = 0; round < 20; ++round) {
+        JsonStreamReader reader { json };
+        size_t thread_count = 0;
+        MUST(reader.for_each_member([&](StringView key) -> ErrorOr<void> {
+            if (key != "processes"sv)
+                return reader.skip_value();
+            return reader.for_each_element([&] {
+                return reader.for_each_member([&](StringView process_key) -> ErrorOr<void> {
+                    if (process_key != "threads"sv)
+                        return reader.skip_value();
+                    return reader.for_each_element([&]() -> ErrorOr<void> {
+                        ++thread_count;
+                        return reader.skip_value();
+                    });
+                });
+            });
+        }));
+        MUST(reader.finish());
+        EXPECT_EQ(thread_count, 2000u);
+    }
+}
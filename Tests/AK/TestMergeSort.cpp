@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/MergeSort.h>
+#include <AK/Noncopyable.h>
+#include <AK/Vector.h>
+
+TEST_CASE(sorts_without_copy)
+{
+    struct NoCopy {
+        AK_MAKE_NONCOPYABLE(NoCopy);
+        AK_MAKE_DEFAULT_MOVABLE(NoCopy);
+
+    public:
+        NoCopy() = default;
+
+        int value { 0 };
+    };
+
+    Vector<NoCopy> vector;
+    for (int i = 0; i < 100; ++i) {
+        NoCopy element;
+        element.value = (100 - i) % 37;
+        vector.append(move(element));
+    }
+
+    merge_sort(vector, [](auto& a, auto& b) { return a.value < b.value; });
+
+    for (size_t i = 0; i < vector.size() - 1; ++i)
+        EXPECT(vector[i].value <= vector[i + 1].value);
+}
+
+TEST_CASE(sort_is_stable)
+{
+    struct Element {
+        int key;
+        int original_index;
+    };
+
+    Vector<Element> vector;
+    for (int i = 0; i < 1000; ++i)
+        vector.append({ (i * 7919) % 10, i });
+
+    merge_sort(vector, [](auto& a, auto& b) { return a.key < b.key; });
+
+    for (size_t i = 0; i < vector.size() - 1; ++i) {
+        EXPECT(vector[i].key <= vector[i + 1].key);
+        if (vector[i].key == vector[i + 1].key)
+            EXPECT(vector[i].original_index < vector[i + 1].original_index);
+    }
+}
+
+TEST_CASE(sorts_small_and_empty_collections)
+{
+    Vector<int> empty;
+    merge_sort(empty);
+    EXPECT(empty.is_empty());
+
+    Vector<int> one { 1 };
+    merge_sort(one);
+    EXPECT_EQ(one[0], 1);
+
+    Vector<int> few { 3, 1, 2 };
+    merge_sort(few);
+    EXPECT_EQ(few, (Vector<int> { 1, 2, 3 }));
+}
@@ -9,6 +9,7 @@
 #include <AK/Noncopyable.h>
 #include <AK/QuickSort.h>
 #include <AK/StdLibExtras.h>
+#include <AK/Vector.h>
 
 TEST_CASE(sorts_without_copy)
 {
@@ -95,3 +96,41 @@ TEST_CASE(maximum_stack_depth)
 
     delete[] data;
 }
+
+TEST_CASE(sorts_presorted_and_reversed_input)
+{
+    Vector<int> ascending;
+    Vector<int> descending;
+    for (int i = 0; i < 1000; ++i) {
+        ascending.append(i);
+        descending.append(1000 - i);
+    }
+
+    quick_sort(ascending);
+    quick_sort(descending);
+
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(ascending[i], i);
+        EXPECT_EQ(descending[i], i + 1);
+    }
+}
+
+TEST_CASE(bounded_comparisons_on_adversarial_input)
+{
+    // Everything equal except for a few elements makes a lot of partitions degenerate.
+    int const size = 4096;
+    Vector<int> data;
+    for (int i = 0; i < size; ++i)
+        data.append(i % 512 == 0 ? size - i : 0);
+
+    size_t comparisons = 0;
+    quick_sort(data, [&](int a, int b) {
+        ++comparisons;
+        return a < b;
+    });
+
+    for (int i = 0; i < size - 1; ++i)
+        EXPECT(data[i] <= data[i + 1]);
+    // NOTE: A quadratic sort would need millions of comparisons for this.
+    EXPECT(comparisons < 16 * size * 12);
+}
@@ -7,6 +7,7 @@
 #include <LibTest/TestCase.h>
 
 #include <AK/Array.h>
+#include <AK/ByteString.h>
 #include <AK/String.h>
 #include <AK/StringView.h>
 #include <AK/Types.h>
@@ -67,6 +68,52 @@ TEST_CASE(encode_utf8)
     }
 }
 
+TEST_CASE(transcode_long_strings)
+{
+    // These are long enough for runs of ASCII to be converted in bulk, with other code points in between.
+    auto utf8_string = MUST(String::formatted("{}Привет{}😀{}", MUST(String::repeated('a', 37)), MUST(String::repeated('b', 16)), MUST(String::repeated('c', 21))));
+    auto utf16_string = MUST(AK::utf8_to_utf16(utf8_string));
+    Utf16View view { utf16_string };
+
+    EXPECT_EQ(view.length_in_code_units(), 37u + 6u + 16u + 2u + 21u);
+    EXPECT_EQ(view.length_in_code_points(), 37u + 6u + 16u + 1u + 21u);
+    EXPECT_EQ(view.code_point_at(36), (u32)'a');
+    EXPECT_EQ(view.code_point_at(37), 0x41fu);
+    EXPECT_EQ(view.code_point_at(59), 0x1f600u);
+    EXPECT_EQ(view.code_point_at(61), (u32)'c');
+
+    EXPECT_EQ(MUST(view.to_utf8(Utf16View::AllowInvalidCodeUnits::Yes)), utf8_string);
+    EXPECT_EQ(MUST(view.to_utf8(Utf16View::AllowInvalidCodeUnits::No)), utf8_string);
+
+    // Invalid UTF-8 in between runs of ASCII becomes replacement characters, just like when iterating the view.
+    auto invalid_utf8 = "abcdefghijklmnopqrstuvwxyz\xf0\x9f"
+                        "abcdefghijklmnopqrstuvwxyz\xc0"sv;
+    auto invalid_utf16 = MUST(AK::utf8_to_utf16(invalid_utf8));
+    Vector<u32> expected;
+    for (auto code_point : Utf8View { invalid_utf8 })
+        expected.append(code_point);
+
+    Utf16View invalid_view { invalid_utf16 };
+    EXPECT_EQ(invalid_view.length_in_code_points(), expected.size());
+    size_t i = 0;
+    for (auto code_point : invalid_view)
+        EXPECT_EQ(code_point, expected[i++]);
+
+    // Unpaired surrogates in between runs of ASCII.
+    Vector<u16> code_units;
+    for (size_t j = 0; j < 20; ++j)
+        code_units.append('x');
+    code_units.append(0xdc00);
+    for (size_t j = 0; j < 20; ++j)
+        code_units.append('y');
+
+    Utf16View surrogate_view { code_units };
+    auto with_surrogate = ByteString::formatted("{}\xed\xb0\x80{}", ByteString::repeated('x', 20), ByteString::repeated('y', 20));
+    auto with_replacement = ByteString::formatted("{}\ufffd{}", ByteString::repeated('x', 20), ByteString::repeated('y', 20));
+    EXPECT_EQ(MUST(surrogate_view.to_utf8(Utf16View::AllowInvalidCodeUnits::Yes)), with_surrogate.view());
+    EXPECT_EQ(MUST(surrogate_view.to_utf8(Utf16View::AllowInvalidCodeUnits::No)), with_replacement.view());
+}
+
 TEST_CASE(decode_utf16)
 {
     // Same string as the decode_utf8 test.
@@ -7,6 +7,7 @@
 #include <LibTest/TestCase.h>
 
 #include <AK/ByteBuffer.h>
+#include <AK/ByteString.h>
 #include <AK/Utf8View.h>
 
 TEST_CASE(decode_ascii)
@@ -128,6 +129,30 @@ TEST_CASE(validate_overlong_utf8)
     EXPECT(valid_bytes == 2);
 }
 
+TEST_CASE(validate_long_utf8)
+{
+    static_assert(Utf8View { "Hello, world! Привет, мир!"sv }.validate());
+    static_assert(!Utf8View { "Hello, world!\xff"sv }.validate());
+
+    // Put a single multi-byte sequence at every offset of a long ASCII string, so that it ends up anywhere within a block.
+    for (size_t offset = 0; offset < 40; ++offset) {
+        auto valid = ByteString::formatted("{}😀{}", ByteString::repeated('a', offset), ByteString::repeated('b', 40 - offset));
+        size_t valid_bytes = 0;
+        EXPECT(Utf8View { valid }.validate(valid_bytes));
+        EXPECT_EQ(valid_bytes, valid.length());
+        EXPECT_EQ(Utf8View { valid }.length(), 41u);
+
+        auto truncated = ByteString::formatted("{}\xf0\x9f\x98{}", ByteString::repeated('a', offset), ByteString::repeated('b', 40 - offset));
+        EXPECT(!Utf8View { truncated }.validate(valid_bytes));
+        EXPECT_EQ(valid_bytes, offset);
+
+        auto surrogate = ByteString::formatted("{}\xed\xa0\x80{}", ByteString::repeated('a', offset), ByteString::repeated('b', 40 - offset));
+        EXPECT(Utf8View { surrogate }.validate(valid_bytes, Utf8View::AllowSurrogates::Yes));
+        EXPECT(!Utf8View { surrogate }.validate(valid_bytes, Utf8View::AllowSurrogates::No));
+        EXPECT_EQ(valid_bytes, offset);
+    }
+}
+
 TEST_CASE(iterate_utf8)
 {
     Utf8View view("Some weird characters \u00A9\u266A\uA755"sv);
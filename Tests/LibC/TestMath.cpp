@@ -98,6 +98,35 @@ TEST_CASE(logarithms)
     EXPECT_APPROXIMATE(log10(5), 0.698970);
 }
 
+TEST_CASE(single_precision)
+{
+    EXPECT_APPROXIMATE(sinf(1234.0f), 0.601928);
+    EXPECT_APPROXIMATE(cosf(1234.0f), -0.798551);
+    EXPECT_APPROXIMATE(sinf(1.0e30f), -0.791163);
+    EXPECT_APPROXIMATE(cosf(-1.0f), 0.540302);
+    EXPECT(signbit(sinf(-0.0f)));
+    EXPECT(isnan(sinf(__builtin_huge_valf())));
+
+    EXPECT_APPROXIMATE(expf(1.5f), 4.481689);
+    EXPECT_APPROXIMATE(expf(-17.0f), 0.000000);
+    EXPECT_EQ(expf(0.0f), 1.0f);
+    EXPECT_EQ(expf(100.0f), __builtin_huge_valf());
+    EXPECT_EQ(expf(-__builtin_huge_valf()), 0.0f);
+
+    EXPECT(isnan(logf(-1.0f)));
+    EXPECT_EQ(logf(0.0f), -__builtin_huge_valf());
+    EXPECT_EQ(logf(1.0f), 0.0f);
+    EXPECT_APPROXIMATE(logf(0.5f), -0.693147);
+    EXPECT_APPROXIMATE(logf(500.0f), 6.214608);
+
+    EXPECT_APPROXIMATE(powf(2.0f, 0.5f), 1.414214);
+    EXPECT_APPROXIMATE(powf(-2.0f, 3.0f), -8.0);
+    EXPECT_EQ(powf(-1.0f, __builtin_huge_valf()), 1.0f);
+    EXPECT_EQ(powf(__builtin_nanf(""), 0.0f), 1.0f);
+    EXPECT_EQ(powf(0.0f, -1.0f), __builtin_huge_valf());
+    EXPECT(isnan(powf(-2.0f, 0.5f)));
+}
+
 union Extractor {
     explicit Extractor(double d)
         : d(d)
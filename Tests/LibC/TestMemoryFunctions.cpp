@@ -0,0 +1,338 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/Array.h>
+#include <AK/ByteString.h>
+#include <AK/Platform.h>
+#include <AK/Types.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// NOTE: Everything here is checked against straightforward byte-by-byte loops, so that the optimized implementations
+//       aren't used to test themselves.
+
+static constexpr size_t max_size = 2048;
+static constexpr size_t max_misalignment = 16;
+// Room on either side of the tested range to catch accesses outside of it.
+static constexpr size_t guard_size = 64;
+// memcpy_sse2_erms switches to rep movsb at this size.
+static constexpr size_t erms_threshold = 1024;
+
+#if ARCH(X86_64) && defined(AK_OS_SERENITY)
+extern "C" void* memcpy_sse2(void*, void const*, size_t);
+extern "C" void* memcpy_sse2_erms(void*, void const*, size_t);
+#endif
+
+struct MemcpyImplementation {
+    StringView name;
+    void* (*function)(void*, void const*, size_t);
+};
+
+static Array const s_memcpy_implementations {
+    MemcpyImplementation { "memcpy"sv, memcpy },
+#if ARCH(X86_64) && defined(AK_OS_SERENITY)
+    // The resolver only picks one of these for the CPU we're running on, but both have to work.
+    MemcpyImplementation { "memcpy_sse2"sv, memcpy_sse2 },
+    MemcpyImplementation { "memcpy_sse2_erms"sv, memcpy_sse2_erms },
+#endif
+};
+
+// Checking every pair of misalignments for every size takes too long, so that's only done for small sizes and around the
+// ERMS threshold. For other sizes, each source misalignment is paired with a destination misalignment that changes with
+// the size, so every pair still comes up many times.
+static bool checks_all_misalignment_pairs(size_t size)
+{
+    return size <= 256 || (size >= erms_threshold - 32 && size <= erms_threshold + 32) || size > max_size - 16;
+}
+
+// Never zero or 0xff, so that the string functions don't stop early and 0xff can be used as a unique marker.
+static u8 pattern_byte(size_t index, u8 seed)
+{
+    return static_cast<u8>((index * 7 + seed) % 254) + 1;
+}
+
+static void fill_with_pattern(u8* buffer, size_t size, u8 seed)
+{
+    for (size_t i = 0; i < size; ++i)
+        buffer[i] = pattern_byte(i, seed);
+}
+
+TEST_CASE(memcpy_all_sizes_and_misalignments)
+{
+    static constexpr size_t buffer_size = guard_size + max_misalignment + max_size + guard_size;
+    static Array<u8, buffer_size> source;
+    static Array<u8, buffer_size> destination;
+    fill_with_pattern(source.data(), buffer_size, 1);
+
+    for (auto const& implementation : s_memcpy_implementations) {
+        fill_with_pattern(destination.data(), buffer_size, 2);
+
+        for (size_t size = 0; size <= max_size; ++size) {
+            for (size_t source_misalignment = 0; source_misalignment < max_misalignment; ++source_misalignment) {
+                for (size_t destination_misalignment = 0; destination_misalignment < max_misalignment; ++destination_misalignment) {
+                    if (!checks_all_misalignment_pairs(size) && destination_misalignment != (source_misalignment + size) % max_misalignment)
+                        continue;
+
+                    auto destination_offset = guard_size + destination_misalignment;
+                    auto* from = source.data() + guard_size + source_misalignment;
+                    auto* to = destination.data() + destination_offset;
+
+                    auto* result = implementation.function(to, from, size);
+                    if (result != to) {
+                        FAIL(ByteString::formatted("{}: size {}, misalignment {}/{}: returned {:p} instead of {:p}", implementation.name, size, source_misalignment, destination_misalignment, result, to));
+                        return;
+                    }
+
+                    for (size_t i = destination_offset - guard_size; i < destination_offset + size + guard_size; ++i) {
+                        bool copied = i >= destination_offset && i < destination_offset + size;
+                        auto expected = copied ? from[i - destination_offset] : pattern_byte(i, 2);
+                        if (destination[i] != expected) {
+                            FAIL(ByteString::formatted("{}: size {}, misalignment {}/{}: wrong byte at offset {}", implementation.name, size, source_misalignment, destination_misalignment, static_cast<ssize_t>(i) - static_cast<ssize_t>(destination_offset)));
+                            return;
+                        }
+                    }
+
+                    // Put the destination back for the next round.
+                    for (size_t i = destination_offset; i < destination_offset + size; ++i)
+                        destination[i] = pattern_byte(i, 2);
+                }
+            }
+        }
+    }
+}
+
+static void test_memmove_overlap(bool destination_after_source)
+{
+    // Distances between source and destination: less than, exactly and more than a vector apart, and across the ERMS threshold.
+    static constexpr Array<size_t, 9> distances { 1, 3, 8, 15, 16, 17, 64, 1000, 1030 };
+    static constexpr size_t buffer_size = guard_size + max_misalignment + distances.last() + max_size + guard_size;
+    static Array<u8, buffer_size> buffer;
+    static Array<u8, buffer_size> expected;
+    fill_with_pattern(buffer.data(), buffer_size, 3);
+    fill_with_pattern(expected.data(), buffer_size, 3);
+
+    for (auto distance : distances) {
+        for (size_t size = 0; size <= max_size; ++size) {
+            for (size_t misalignment = 0; misalignment < max_misalignment; ++misalignment) {
+                if (size > 128 && misalignment != size % max_misalignment)
+                    continue;
+
+                auto low = guard_size + misalignment;
+                auto high = low + distance;
+                auto source_offset = destination_after_source ? low : high;
+                auto destination_offset = destination_after_source ? high : low;
+
+                // Copy through the right end first, so the reference can't clobber its own source either.
+                if (destination_after_source) {
+                    for (size_t i = size; i > 0; --i)
+                        expected[destination_offset + i - 1] = expected[source_offset + i - 1];
+                } else {
+                    for (size_t i = 0; i < size; ++i)
+                        expected[destination_offset + i] = expected[source_offset + i];
+                }
+
+                auto* result = memmove(buffer.data() + destination_offset, buffer.data() + source_offset, size);
+                if (result != buffer.data() + destination_offset) {
+                    FAIL(ByteString::formatted("memmove: size {}, distance {}, misalignment {}: wrong return value", size, distance, misalignment));
+                    return;
+                }
+
+                auto touched_end = high + size;
+                for (size_t i = low - guard_size; i < touched_end + guard_size; ++i) {
+                    if (buffer[i] != expected[i]) {
+                        FAIL(ByteString::formatted("memmove ({}): size {}, distance {}, misalignment {}: wrong byte at offset {}", destination_after_source ? "backward"sv : "forward"sv, size, distance, misalignment, static_cast<ssize_t>(i) - static_cast<ssize_t>(destination_offset)));
+                        return;
+                    }
+                }
+
+                // Put the touched range back for the next round.
+                for (size_t i = low; i < touched_end; ++i) {
+                    buffer[i] = pattern_byte(i, 3);
+                    expected[i] = buffer[i];
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE(memmove_overlapping_with_destination_after_source)
+{
+    // This has to copy backwards.
+    test_memmove_overlap(true);
+}
+
+TEST_CASE(memmove_overlapping_with_destination_before_source)
+{
+    test_memmove_overlap(false);
+}
+
+static int reference_memcmp(u8 const* a, u8 const* b, size_t size)
+{
+    for (size_t i = 0; i < size; ++i) {
+        if (a[i] != b[i])
+            return a[i] < b[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+static int sign(int value)
+{
+    return (value > 0) - (value < 0);
+}
+
+TEST_CASE(memcmp_difference_at_every_position)
+{
+    static constexpr size_t buffer_size = max_misalignment + max_size;
+    static Array<u8, buffer_size> a_buffer;
+    static Array<u8, buffer_size> b_buffer;
+
+    for (size_t a_misalignment = 0; a_misalignment < max_misalignment; ++a_misalignment) {
+        for (size_t b_misalignment = 0; b_misalignment < max_misalignment; ++b_misalignment) {
+            auto* a = a_buffer.data() + a_misalignment;
+            auto* b = b_buffer.data() + b_misalignment;
+            fill_with_pattern(a, max_size, 4);
+            fill_with_pattern(b, max_size, 4);
+
+            for (size_t size = 0; size <= max_size; ++size) {
+                if (auto result = memcmp(a, b, size); result != 0) {
+                    FAIL(ByteString::formatted("memcmp: size {}, misalignment {}/{}: equal ranges returned {}", size, a_misalignment, b_misalignment, result));
+                    return;
+                }
+
+                // memcmp has no ERMS path, so only small sizes need every pair here.
+                if (size > 128 && b_misalignment != (a_misalignment + size) % max_misalignment)
+                    continue;
+
+                // The first difference at every position of the first and the last 16-byte block, and of one in the middle.
+                // Adding 0x80 flips the top bit, so the bytes have to be compared as unsigned.
+                auto check_difference_at = [&](size_t position) {
+                    if (position >= size)
+                        return true;
+                    auto original = b[position];
+                    for (u8 delta : { 0x01, 0x80, 0xff }) {
+                        b[position] = static_cast<u8>(original + delta);
+                        auto expected = reference_memcmp(a, b, size);
+                        auto result = memcmp(a, b, size);
+                        b[position] = original;
+                        if (sign(result) != expected) {
+                            FAIL(ByteString::formatted("memcmp: size {}, misalignment {}/{}, difference at {}: returned {}, expected sign {}", size, a_misalignment, b_misalignment, position, result, expected));
+                            return false;
+                        }
+                    }
+                    return true;
+                };
+
+                auto middle_block = (size / 2) & ~static_cast<size_t>(15);
+                for (size_t i = 0; i < 16; ++i) {
+                    if (!check_difference_at(i) || !check_difference_at(middle_block + i) || (size >= 16 && !check_difference_at(size - 16 + i)))
+                        return;
+                }
+            }
+        }
+    }
+}
+
+// Maps a page followed by an inaccessible one, so that reading past the end of a string at the end of the first page
+// crashes instead of silently passing.
+class GuardedPage {
+public:
+    GuardedPage()
+    {
+        m_page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        auto* mapping = mmap(nullptr, 2 * m_page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        VERIFY(mapping != MAP_FAILED);
+        m_base = static_cast<u8*>(mapping);
+        VERIFY(mprotect(m_base + m_page_size, m_page_size, PROT_NONE) == 0);
+    }
+
+    ~GuardedPage()
+    {
+        munmap(m_base, 2 * m_page_size);
+    }
+
+    // Returns the start of a range of the given size that ends right before the guard page.
+    u8* range_ending_at_guard(size_t size) { return m_base + m_page_size - size; }
+
+private:
+    u8* m_base { nullptr };
+    size_t m_page_size { 0 };
+};
+
+// Looking for every position in every length would take a while, so longer strings have their first and last bytes checked.
+static bool should_check_position(size_t position, size_t length)
+{
+    return length <= 128 || position < 32 || position >= length - 32;
+}
+
+TEST_CASE(string_functions_before_a_guard_page)
+{
+    GuardedPage page;
+
+    // As the strings end at the guard page, their start moves through every misalignment as well.
+    for (size_t length = 0; length <= max_size; ++length) {
+        auto* string = reinterpret_cast<char*>(page.range_ending_at_guard(length + 1));
+        fill_with_pattern(reinterpret_cast<u8*>(string), length, 5);
+        string[length] = '\0';
+
+        if (auto result = strlen(string); result != length) {
+            FAIL(ByteString::formatted("strlen: length {}: returned {}", length, result));
+            return;
+        }
+        if (strchr(string, '\0') != string + length || strchrnul(string, '\0') != string + length) {
+            FAIL(ByteString::formatted("strchr: length {}: didn't stop at the terminator", length));
+            return;
+        }
+        if (strchr(string, 0xff) != nullptr || strchrnul(string, 0xff) != string + length) {
+            FAIL(ByteString::formatted("strchr: length {}: found a byte that isn't there", length));
+            return;
+        }
+
+        for (size_t position = 0; position < length; ++position) {
+            if (!should_check_position(position, length))
+                continue;
+            auto original = string[position];
+            string[position] = static_cast<char>(0xff);
+            bool found = strchr(string, 0xff) == string + position && strchrnul(string, 0xff) == string + position;
+            string[position] = original;
+            if (!found) {
+                FAIL(ByteString::formatted("strchr: length {}: didn't find the byte at {}", length, position));
+                return;
+            }
+        }
+    }
+}
+
+TEST_CASE(memchr_before_a_guard_page)
+{
+    GuardedPage page;
+
+    for (size_t size = 0; size <= max_size; ++size) {
+        auto* bytes = page.range_ending_at_guard(size);
+        fill_with_pattern(bytes, size, 6);
+
+        if (memchr(bytes, 0, size) != nullptr || memchr(bytes, 0xff, size) != nullptr) {
+            FAIL(ByteString::formatted("memchr: size {}: found a byte that isn't there", size));
+            return;
+        }
+
+        for (size_t position = 0; position < size; ++position) {
+            if (!should_check_position(position, size))
+                continue;
+            bytes[position] = 0xff;
+            auto* result = memchr(bytes, 0xff, size);
+            // Nor must it be found when it's just past the end of the searched range.
+            auto* result_before = memchr(bytes, 0xff, position);
+            bytes[position] = pattern_byte(position, 6);
+            if (result != bytes + position || result_before != nullptr) {
+                FAIL(ByteString::formatted("memchr: size {}: didn't find just the byte at {}", size, position));
+                return;
+            }
+        }
+    }
+}
@@ -4,8 +4,14 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Array.h>
+#include <AK/Atomic.h>
 #include <LibTest/TestCase.h>
+#include <errno.h>
 #include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
 
 TEST_CASE(rwlock_init)
 {
@@ -88,3 +94,192 @@ TEST_CASE(rwlock_wrlock_init_in_once)
     result = pthread_rwlock_unlock(&lock);
     EXPECT_EQ(0, result);
 }
+
+static pthread_t start_thread(void* (*function)(void*), void* argument)
+{
+    pthread_t thread;
+    auto result = pthread_create(&thread, nullptr, function, argument);
+    VERIFY(result == 0);
+    return thread;
+}
+
+static timespec realtime_from_now(long milliseconds)
+{
+    timespec time;
+    clock_gettime(CLOCK_REALTIME, &time);
+    time.tv_sec += milliseconds / 1000;
+    time.tv_nsec += (milliseconds % 1000) * 1'000'000;
+    if (time.tv_nsec >= 1'000'000'000) {
+        ++time.tv_sec;
+        time.tv_nsec -= 1'000'000'000;
+    }
+    return time;
+}
+
+// Gives another thread time to get to sleep on a lock. Tests must not fail if it hasn't yet.
+static void let_other_threads_block()
+{
+    usleep(100'000);
+}
+
+TEST_CASE(rwlock_writer_woken_by_last_reader)
+{
+    static pthread_rwlock_t lock;
+    static Atomic<bool> writer_acquired;
+    EXPECT_EQ(0, pthread_rwlock_init(&lock, nullptr));
+
+    EXPECT_EQ(0, pthread_rwlock_rdlock(&lock));
+    EXPECT_EQ(0, pthread_rwlock_rdlock(&lock));
+
+    auto writer = start_thread([](void*) -> void* {
+        EXPECT_EQ(0, pthread_rwlock_wrlock(&lock));
+        writer_acquired = true;
+        EXPECT_EQ(0, pthread_rwlock_unlock(&lock));
+        return nullptr;
+    },
+        nullptr);
+
+    let_other_threads_block();
+    EXPECT(!writer_acquired);
+    EXPECT_EQ(0, pthread_rwlock_unlock(&lock));
+    let_other_threads_block();
+    EXPECT(!writer_acquired);
+
+    // Only the last reader leaving lets the writer in, and it has to wake it up.
+    EXPECT_EQ(0, pthread_rwlock_unlock(&lock));
+    EXPECT_EQ(0, pthread_join(writer, nullptr));
+    EXPECT(writer_acquired);
+}
+
+TEST_CASE(rwlock_timed_locks)
+{
+    static pthread_rwlock_t lock;
+    EXPECT_EQ(0, pthread_rwlock_init(&lock, nullptr));
+
+    auto try_timed_locks = [](void* expected_result) -> void* {
+        auto expected = static_cast<int>(reinterpret_cast<uintptr_t>(expected_result));
+
+        auto timeout = realtime_from_now(50);
+        EXPECT_EQ(expected, pthread_rwlock_timedwrlock(&lock, &timeout));
+        if (expected == 0)
+            EXPECT_EQ(0, pthread_rwlock_unlock(&lock));
+
+        timeout = realtime_from_now(50);
+        EXPECT_EQ(expected, pthread_rwlock_timedrdlock(&lock, &timeout));
+        if (expected == 0)
+            EXPECT_EQ(0, pthread_rwlock_unlock(&lock));
+        return nullptr;
+    };
+
+    // While another thread holds the write lock, both time out.
+    EXPECT_EQ(0, pthread_rwlock_wrlock(&lock));
+    EXPECT_EQ(0, pthread_join(start_thread(try_timed_locks, reinterpret_cast<void*>(ETIMEDOUT)), nullptr));
+    EXPECT_EQ(0, pthread_rwlock_unlock(&lock));
+
+    // Once it's free, both succeed right away.
+    EXPECT_EQ(0, pthread_join(start_thread(try_timed_locks, reinterpret_cast<void*>(0)), nullptr));
+
+    // A timeout in the past still takes a free lock.
+    timespec past {};
+    EXPECT_EQ(0, pthread_rwlock_timedwrlock(&lock, &past));
+    EXPECT_EQ(0, pthread_rwlock_unlock(&lock));
+}
+
+TEST_CASE(rwlock_rdlock_while_holding_wrlock)
+{
+    pthread_rwlock_t lock;
+    EXPECT_EQ(0, pthread_rwlock_init(&lock, nullptr));
+
+    EXPECT_EQ(0, pthread_rwlock_wrlock(&lock));
+    EXPECT_EQ(EDEADLK, pthread_rwlock_rdlock(&lock));
+    EXPECT_EQ(EDEADLK, pthread_rwlock_wrlock(&lock));
+    EXPECT_EQ(0, pthread_rwlock_unlock(&lock));
+
+    // The failed attempts must not have left anything locked.
+    EXPECT_EQ(0, pthread_rwlock_trywrlock(&lock));
+    EXPECT_EQ(0, pthread_rwlock_unlock(&lock));
+}
+
+TEST_CASE(rwlock_prefer_writer_blocks_new_readers)
+{
+    static pthread_rwlock_t lock;
+    static Atomic<bool> writer_acquired;
+
+    pthread_rwlockattr_t attributes;
+    EXPECT_EQ(0, pthread_rwlockattr_init(&attributes));
+    EXPECT_EQ(0, pthread_rwlockattr_setkind_np(&attributes, PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP));
+    int kind = 0;
+    EXPECT_EQ(0, pthread_rwlockattr_getkind_np(&attributes, &kind));
+    EXPECT_EQ(PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP, kind);
+    EXPECT_EQ(0, pthread_rwlock_init(&lock, &attributes));
+    EXPECT_EQ(0, pthread_rwlockattr_destroy(&attributes));
+
+    EXPECT_EQ(0, pthread_rwlock_rdlock(&lock));
+
+    auto writer = start_thread([](void*) -> void* {
+        EXPECT_EQ(0, pthread_rwlock_wrlock(&lock));
+        writer_acquired = true;
+        EXPECT_EQ(0, pthread_rwlock_unlock(&lock));
+        return nullptr;
+    },
+        nullptr);
+
+    // As soon as the writer waits, other readers are turned away even though only readers hold the lock.
+    int result = 0;
+    for (int attempt = 0; attempt < 50; ++attempt) {
+        auto reader = start_thread([](void*) -> void* {
+            auto result = pthread_rwlock_tryrdlock(&lock);
+            if (result == 0)
+                pthread_rwlock_unlock(&lock);
+            return reinterpret_cast<void*>(static_cast<uintptr_t>(result));
+        },
+            nullptr);
+        void* reader_result = nullptr;
+        EXPECT_EQ(0, pthread_join(reader, &reader_result));
+        result = static_cast<int>(reinterpret_cast<uintptr_t>(reader_result));
+        if (result != 0)
+            break;
+        let_other_threads_block();
+    }
+    EXPECT_EQ(EBUSY, result);
+    EXPECT(!writer_acquired);
+
+    EXPECT_EQ(0, pthread_rwlock_unlock(&lock));
+    EXPECT_EQ(0, pthread_join(writer, nullptr));
+    EXPECT(writer_acquired);
+}
+
+TEST_CASE(mutex_contended_lock_keeps_mutual_exclusion)
+{
+    static constexpr size_t thread_count = 4;
+    static constexpr size_t iterations = 100'000;
+    static pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+    static size_t counter = 0;
+    static Atomic<size_t> threads_inside;
+    static Atomic<bool> overlapped;
+
+    Array<pthread_t, thread_count> threads;
+    for (auto& thread : threads) {
+        thread = start_thread([](void*) -> void* {
+            for (size_t i = 0; i < iterations; ++i) {
+                EXPECT_EQ(0, pthread_mutex_lock(&mutex));
+                if (threads_inside.fetch_add(1) != 0)
+                    overlapped = true;
+                // A read-modify-write that isn't atomic, so lost updates show up in the total.
+                auto value = counter;
+                if (i % 64 == 0)
+                    sched_yield();
+                counter = value + 1;
+                threads_inside.fetch_sub(1);
+                EXPECT_EQ(0, pthread_mutex_unlock(&mutex));
+            }
+            return nullptr;
+        },
+            nullptr);
+    }
+    for (auto thread : threads)
+        EXPECT_EQ(0, pthread_join(thread, nullptr));
+
+    EXPECT(!overlapped);
+    EXPECT_EQ(thread_count * iterations, counter);
+}
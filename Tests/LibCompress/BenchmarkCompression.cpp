@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/Array.h>
+#include <AK/StringBuilder.h>
+#include <LibCompress/Deflate.h>
+#include <LibCompress/Gzip.h>
+#include <LibCompress/Zlib.h>
+#include <LibCompress/Zstd.h>
+
+// Words from a small vocabulary, with enough variation that the match finders have real choices to make.
+static ByteBuffer const& text_corpus()
+{
+    static auto const corpus = [] {
+        constexpr Array words { "the "sv, "of "sv, "and "sv, "compression "sv, "window "sv, "match "sv, "length "sv, "distance "sv, "huffman "sv, "block "sv, "literal "sv, "symbol "sv, "table "sv, "stream "sv, ".\n"sv, ", "sv };
+        StringBuilder builder;
+        u32 state = 1;
+        while (builder.length() < 256 * KiB) {
+            state = state * 1103515245 + 12345;
+            builder.append(words[(state >> 16) % words.size()]);
+        }
+        return builder.to_byte_buffer().release_value();
+    }();
+    return corpus;
+}
+
+BENCHMARK_CASE(deflate_compress_fast)
+{
+    auto compressed = TRY_OR_FAIL(Compress::DeflateCompressor::compress_all(text_corpus(), Compress::DeflateCompressor::CompressionLevel::FAST));
+    Test::do_not_optimize(compressed.data());
+}
+
+BENCHMARK_CASE(deflate_compress_good)
+{
+    auto compressed = TRY_OR_FAIL(Compress::DeflateCompressor::compress_all(text_corpus(), Compress::DeflateCompressor::CompressionLevel::GOOD));
+    Test::do_not_optimize(compressed.data());
+}
+
+BENCHMARK_CASE(deflate_decompress)
+{
+    static auto const compressed = MUST(Compress::DeflateCompressor::compress_all(text_corpus()));
+    auto decompressed = TRY_OR_FAIL(Compress::DeflateDecompressor::decompress_all(compressed));
+    EXPECT_EQ(decompressed.size(), text_corpus().size());
+}
+
+BENCHMARK_CASE(gzip_compress)
+{
+    auto compressed = TRY_OR_FAIL(Compress::GzipCompressor::compress_all(text_corpus()));
+    Test::do_not_optimize(compressed.data());
+}
+
+BENCHMARK_CASE(gzip_decompress)
+{
+    static auto const compressed = MUST(Compress::GzipCompressor::compress_all(text_corpus()));
+    auto decompressed = TRY_OR_FAIL(Compress::GzipDecompressor::decompress_all(compressed));
+    EXPECT_EQ(decompressed.size(), text_corpus().size());
+}
+
+BENCHMARK_CASE(zlib_compress)
+{
+    auto compressed = TRY_OR_FAIL(Compress::ZlibCompressor::compress_all(text_corpus()));
+    Test::do_not_optimize(compressed.data());
+}
+
+BENCHMARK_CASE(zstd_compress)
+{
+    auto compressed = TRY_OR_FAIL(Compress::ZstdCompressor::compress_all(text_corpus()));
+    Test::do_not_optimize(compressed.data());
+}
+
+BENCHMARK_CASE(zstd_decompress)
+{
+    static auto const compressed = MUST(Compress::ZstdCompressor::compress_all(text_corpus()));
+    auto decompressed = TRY_OR_FAIL(Compress::ZstdDecompressor::decompress_all(compressed));
+    EXPECT_EQ(decompressed.size(), text_corpus().size());
+}
@@ -10,6 +10,7 @@
 #include <AK/BitStream.h>
 #include <AK/MemoryStream.h>
 #include <AK/Random.h>
+#include <AK/StringBuilder.h>
 #include <LibCompress/Deflate.h>
 #include <LibCore/File.h>
 #include <cstring>
@@ -62,6 +63,34 @@ TEST_CASE(canonical_code_complex)
         EXPECT_EQ(MUST(huffman.read_symbol(bit_stream)), output[idx]);
 }
 
+TEST_CASE(canonical_code_long_codes)
+{
+    // Code lengths 1 to 15, plus a second code of length 15, so that the code is complete.
+    Array<u8, 16> code;
+    for (size_t i = 0; i < 15; ++i)
+        code[i] = i + 1;
+    code[15] = 15;
+
+    auto const huffman = TRY_OR_FAIL(Compress::CanonicalCode::from_bytes(code));
+
+    AllocatingMemoryStream output_stream;
+    {
+        LittleEndianOutputBitStream bit_stream { MaybeOwned<Stream>(output_stream) };
+        for (u32 symbol = 0; symbol < 16; ++symbol)
+            TRY_OR_FAIL(huffman.write_symbol(bit_stream, 15 - symbol));
+        for (u32 symbol = 0; symbol < 16; ++symbol)
+            TRY_OR_FAIL(huffman.write_symbol(bit_stream, symbol));
+        TRY_OR_FAIL(bit_stream.align_to_byte_boundary());
+        TRY_OR_FAIL(bit_stream.flush_buffer_to_stream());
+    }
+
+    LittleEndianInputBitStream bit_stream { MaybeOwned<Stream>(output_stream) };
+    for (u32 symbol = 0; symbol < 16; ++symbol)
+        EXPECT_EQ(TRY_OR_FAIL(huffman.read_symbol(bit_stream)), 15 - symbol);
+    for (u32 symbol = 0; symbol < 16; ++symbol)
+        EXPECT_EQ(TRY_OR_FAIL(huffman.read_symbol(bit_stream)), symbol);
+}
+
 TEST_CASE(invalid_canonical_code)
 {
     Array<u8, 257> code;
@@ -83,6 +112,21 @@ TEST_CASE(deflate_decompress_compressed_block)
     EXPECT(decompressed.value().bytes() == ReadonlyBytes({ uncompressed, sizeof(uncompressed) - 1 }));
 }
 
+TEST_CASE(deflate_decompress_block_ending_close_to_the_end_of_the_stream)
+{
+    // The end-of-block code is the last 7 bits of this stream, which is shorter than the longest fixed literal code.
+    Array<u8, 8> const compressed {
+        0x9b, 0x30, 0x71, 0xd2, 0xe4, 0x29, 0x53, 0x01
+    };
+
+    Array<u8, 6> const uncompressed {
+        0x90, 0x91, 0x92, 0x93, 0x94, 0x95
+    };
+
+    auto const decompressed = TRY_OR_FAIL(Compress::DeflateDecompressor::decompress_all(compressed));
+    EXPECT(decompressed.bytes() == uncompressed.span());
+}
+
 TEST_CASE(deflate_decompress_uncompressed_block)
 {
     Array<u8, 18> const compressed {
@@ -156,6 +200,51 @@ TEST_CASE(deflate_round_trip_compress_large)
     EXPECT(uncompressed == original);
 }
 
+TEST_CASE(deflate_decompress_truncated_stream)
+{
+    StringBuilder builder;
+    for (size_t i = 0; i < 1000; ++i)
+        builder.appendff("Line number {} of a text that gets cut short.\n", i);
+    auto original = builder.string_view().bytes();
+    auto compressed = TRY_OR_FAIL(Compress::DeflateCompressor::compress_all(original, Compress::DeflateCompressor::CompressionLevel::GOOD));
+
+    // Everything that was decoded before the input ran out is returned first, and the error only comes after that.
+    auto stream = make<FixedMemoryStream>(compressed.bytes().trim(compressed.size() / 2));
+    auto decompressor = TRY_OR_FAIL(Compress::DeflateDecompressor::construct(make<LittleEndianInputBitStream>(move(stream))));
+
+    ByteBuffer decompressed;
+    Array<u8, 1024> buffer;
+    for (;;) {
+        auto read_bytes = decompressor->read_some(buffer);
+        if (read_bytes.is_error())
+            break;
+        EXPECT(!read_bytes.value().is_empty());
+        decompressed.append(read_bytes.value());
+    }
+
+    EXPECT(decompressed.size() > original.size() / 4);
+    EXPECT(decompressed.size() < original.size());
+    EXPECT_EQ(decompressed.bytes(), original.trim(decompressed.size()));
+    EXPECT(decompressor->read_some(buffer).is_error());
+}
+
+TEST_CASE(deflate_compress_matches_across_blocks)
+{
+    // Every block repeats the previous one, so each block after the first should be almost entirely made of back references into the previous block
+    auto chunk = ByteBuffer::create_uninitialized(24 * KiB).release_value();
+    fill_with_random(chunk);
+    ByteBuffer original;
+    for (size_t i = 0; i < 4; ++i)
+        original.append(chunk);
+
+    for (auto level : { Compress::DeflateCompressor::CompressionLevel::FAST, Compress::DeflateCompressor::CompressionLevel::GOOD }) {
+        auto compressed = TRY_OR_FAIL(Compress::DeflateCompressor::compress_all(original, level));
+        EXPECT(compressed.size() < chunk.size() + 4 * KiB);
+        auto uncompressed = TRY_OR_FAIL(Compress::DeflateDecompressor::decompress_all(compressed));
+        EXPECT(uncompressed == original);
+    }
+}
+
 TEST_CASE(deflate_compress_literals)
 {
     // This byte array is known to not produce any back references with our lz77 implementation even at the highest compression settings
@@ -180,3 +269,22 @@ TEST_CASE(ossfuzz_58046)
     auto test_data = TRY_OR_FAIL(test_file->read_until_eof());
     EXPECT(Compress::DeflateDecompressor::decompress_all(test_data).is_error());
 }
+
+BENCHMARK_CASE(deflate_compress_text)
+{
+    // A text-like corpus: words from a small vocabulary, with enough variation that the match finder has real choices to make
+    constexpr Array words { "the "sv, "of "sv, "and "sv, "compression "sv, "window "sv, "match "sv, "length "sv, "distance "sv, "huffman "sv, "block "sv, "literal "sv, "symbol "sv, "table "sv, "stream "sv, ".\n"sv, ", "sv };
+    StringBuilder builder;
+    u32 state = 1;
+    while (builder.length() < 4 * MiB) {
+        state = state * 1103515245 + 12345;
+        builder.append(words[(state >> 16) % words.size()]);
+    }
+    auto original = builder.to_byte_buffer().release_value();
+
+    for (auto level : { Compress::DeflateCompressor::CompressionLevel::FAST, Compress::DeflateCompressor::CompressionLevel::GOOD, Compress::DeflateCompressor::CompressionLevel::GREAT }) {
+        auto compressed = TRY_OR_FAIL(Compress::DeflateCompressor::compress_all(original, level));
+        auto uncompressed = TRY_OR_FAIL(Compress::DeflateDecompressor::decompress_all(compressed));
+        EXPECT(uncompressed == original);
+    }
+}
@@ -94,6 +94,19 @@ TEST_CASE(gzip_round_trip)
     EXPECT(uncompressed == original);
 }
 
+TEST_CASE(gzip_round_trip_multiple_threads)
+{
+    // Large enough to be split across all of the threads, with some repetition so back-references are involved as well.
+    auto original = ByteBuffer::create_uninitialized(4 * MiB + 123).release_value();
+    fill_with_random(original.bytes().trim(64 * KiB));
+    for (size_t offset = 64 * KiB; offset < original.size(); offset += 64 * KiB)
+        original.bytes().slice(offset).overwrite(0, original.data(), min(64 * KiB, original.size() - offset));
+
+    auto compressed = TRY_OR_FAIL(Compress::GzipCompressor::compress_all(original, 4));
+    auto uncompressed = TRY_OR_FAIL(Compress::GzipDecompressor::decompress_all(compressed));
+    EXPECT(uncompressed == original);
+}
+
 TEST_CASE(gzip_truncated_uncompressed_block)
 {
     Array<u8, 38> const compressed {
@@ -7,6 +7,7 @@
 #include <LibTest/TestCase.h>
 
 #include <AK/MemoryStream.h>
+#include <AK/StringBuilder.h>
 #include <LibCompress/Xz.h>
 
 TEST_CASE(lzma2_compressed_without_settings_after_uncompressed)
@@ -2057,3 +2058,70 @@ TEST_CASE(xz_utils_unsupported_filter_flags_3)
     auto buffer_or_error = decompressor->read_until_eof(PAGE_SIZE);
     EXPECT(buffer_or_error.is_error());
 }
+
+TEST_CASE(xz_multiple_blocks_with_sizes_in_headers)
+{
+    // Created with `xz -T2 --block-size=110 --check=crc32 --lzma2=preset=6,dict=4KiB`, which stores the sizes of all three blocks in their headers.
+    Array<u8, 288> const compressed {
+        0xFD, 0x37, 0x7A, 0x58, 0x5A, 0x00, 0x00, 0x01, 0x69, 0x22, 0xDE, 0x36, 0x02, 0xC0, 0x41, 0x6E,
+        0x21, 0x01, 0x00, 0x00, 0x16, 0xF5, 0x50, 0x10, 0xE0, 0x00, 0x6D, 0x00, 0x39, 0x5D, 0x00, 0x21,
+        0x1B, 0x09, 0xE6, 0x47, 0x01, 0xC1, 0x5A, 0x72, 0xF3, 0x53, 0xDF, 0xBB, 0x01, 0xEB, 0xE7, 0xF3,
+        0xA3, 0xD9, 0x2F, 0x5E, 0xB2, 0x86, 0x0B, 0x87, 0xA2, 0xB5, 0x56, 0x7E, 0x33, 0x5A, 0x99, 0xB7,
+        0xE1, 0xA0, 0x30, 0x73, 0x09, 0xD4, 0x50, 0x81, 0x4F, 0x6D, 0x50, 0xBA, 0x5E, 0xF6, 0xC9, 0xAA,
+        0xB6, 0xB9, 0x74, 0x80, 0x01, 0xDA, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x2C, 0x14, 0xD1, 0xE4,
+        0x02, 0xC0, 0x41, 0x6E, 0x21, 0x01, 0x00, 0x00, 0x16, 0xF5, 0x50, 0x10, 0xE0, 0x00, 0x6D, 0x00,
+        0x39, 0x5D, 0x00, 0x37, 0x98, 0xC9, 0xB2, 0xE9, 0xC6, 0x4F, 0x16, 0xFE, 0x09, 0xF2, 0x2B, 0xB1,
+        0x5A, 0x51, 0xE4, 0x67, 0x47, 0x4E, 0xFB, 0x59, 0xAB, 0x89, 0x33, 0x04, 0x30, 0xE0, 0x18, 0x8B,
+        0xA0, 0x3B, 0x97, 0x5F, 0x96, 0x97, 0xB3, 0x80, 0x34, 0x51, 0xF5, 0xC2, 0x1E, 0xBD, 0xD3, 0xFF,
+        0x87, 0x84, 0x0C, 0x06, 0xFD, 0xED, 0x86, 0xDC, 0xF5, 0xF1, 0xAC, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x67, 0x7C, 0x64, 0xB9, 0x02, 0xC0, 0x42, 0x68, 0x21, 0x01, 0x00, 0x00, 0x18, 0x72, 0x84, 0x19,
+        0xE0, 0x00, 0x67, 0x00, 0x3A, 0x5D, 0x00, 0x35, 0x88, 0x02, 0x43, 0xD9, 0x04, 0x97, 0xDE, 0xBD,
+        0xC0, 0x1C, 0x7D, 0x2A, 0x39, 0xAE, 0x31, 0x7B, 0xB0, 0x87, 0x28, 0x20, 0x97, 0x01, 0xEF, 0x79,
+        0xEE, 0xD2, 0x33, 0xC3, 0xF2, 0xA9, 0x35, 0x32, 0xC7, 0x42, 0xA5, 0x4A, 0xF5, 0x4C, 0xD7, 0xF0,
+        0x43, 0x88, 0xF9, 0xC0, 0x85, 0x49, 0x59, 0x7B, 0xE5, 0x16, 0x6E, 0x90, 0x94, 0x45, 0xF3, 0xE8,
+        0x00, 0x00, 0x00, 0x00, 0xD2, 0xD9, 0x1D, 0xFA, 0x00, 0x03, 0x51, 0x6E, 0x51, 0x6E, 0x52, 0x68,
+        0xDB, 0x8F, 0x06, 0x4F, 0x3E, 0x30, 0x0D, 0x8B, 0x02, 0x00, 0x00, 0x00, 0x00, 0x01, 0x59, 0x5A
+    };
+
+    StringBuilder expected_builder;
+    for (size_t i = 0; i < 6; ++i)
+        expected_builder.appendff("Block {}: the quick brown fox jumps over the lazy dog.\n", i / 2);
+    auto expected = expected_builder.to_byte_string();
+
+    for (size_t thread_count : { 1, 2, 4 }) {
+        auto stream = MUST(try_make<FixedMemoryStream>(compressed));
+        auto decompressor = MUST(Compress::XzDecompressor::create(move(stream), thread_count));
+        auto buffer = TRY_OR_FAIL(decompressor->read_until_eof(PAGE_SIZE));
+        EXPECT_EQ(buffer.span(), expected.bytes());
+    }
+
+    // Concatenated streams decompress to the concatenation of their contents.
+    ByteBuffer concatenated;
+    concatenated.append(compressed);
+    concatenated.append(compressed);
+    auto expected_concatenated = ByteString::formatted("{}{}", expected, expected);
+    for (size_t thread_count : { 1, 2 }) {
+        auto stream = MUST(try_make<FixedMemoryStream>(concatenated.bytes()));
+        auto decompressor = MUST(Compress::XzDecompressor::create(move(stream), thread_count));
+        auto buffer = TRY_OR_FAIL(decompressor->read_until_eof(PAGE_SIZE));
+        EXPECT_EQ(buffer.span(), expected_concatenated.bytes());
+    }
+
+    // A block that decompresses to more or less than the uncompressed size in its header is an error, prefetched or not.
+    // The first block header is at offset 12, and is followed by its CRC32.
+    Array<Array<u8, 12>, 2> const first_block_headers_with_wrong_sizes {
+        Array<u8, 12> { 0x02, 0xC0, 0x41, 0x6D, 0x21, 0x01, 0x00, 0x00, 0xC6, 0x8F, 0xF0, 0x57 },
+        Array<u8, 12> { 0x02, 0xC0, 0x41, 0x6F, 0x21, 0x01, 0x00, 0x00, 0xA6, 0xDC, 0x30, 0x2D },
+    };
+    for (auto const& block_header : first_block_headers_with_wrong_sizes) {
+        auto corrupted = MUST(ByteBuffer::copy(compressed));
+        corrupted.overwrite(12, block_header.data(), block_header.size());
+
+        for (size_t thread_count : { 1, 2, 4 }) {
+            auto stream = MUST(try_make<FixedMemoryStream>(corrupted.bytes()));
+            auto decompressor = MUST(Compress::XzDecompressor::create(move(stream), thread_count));
+            auto buffer_or_error = decompressor->read_until_eof(PAGE_SIZE);
+            EXPECT(buffer_or_error.is_error());
+        }
+    }
+}
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/Array.h>
+#include <AK/MemoryStream.h>
+#include <AK/Random.h>
+#include <LibCompress/Zstd.h>
+#include <LibCore/File.h>
+
+static void run_test(StringView file_name)
+{
+    // This makes sure that the tests will run both on target and in Lagom.
+#ifdef AK_OS_SERENITY
+    ByteString path = ByteString::formatted("/usr/Tests/LibCompress/zstd-test-files/{}", file_name);
+#else
+    ByteString path = ByteString::formatted("zstd-test-files/{}", file_name);
+#endif
+
+    auto cmp_file = MUST(Core::File::open(path, Core::File::OpenMode::Read));
+    auto cmp_data = MUST(cmp_file->read_until_eof());
+
+    auto file = MUST(Core::File::open(ByteString::formatted("{}.zst", path), Core::File::OpenMode::Read));
+    auto zstd_stream = MUST(Compress::ZstdDecompressor::create(MaybeOwned<Stream> { *file }));
+    auto data = MUST(zstd_stream->read_until_eof());
+
+    EXPECT_EQ(data, cmp_data);
+}
+
+TEST_CASE(zstd_decompress_empty)
+{
+    Array<u8, 13> const compressed {
+        0x28, 0xB5, 0x2F, 0xFD,      // Magic
+        0x24,                        // Frame Header Descriptor (single segment, checksum, 1 byte content size)
+        0x00,                        // Frame Content Size
+        0x01, 0x00, 0x00,            // Block Header (last block, raw, 0 bytes)
+        0x99, 0xE9, 0xD8, 0x51       // Content Checksum
+    };
+
+    auto decompressed = MUST(Compress::ZstdDecompressor::decompress_all(compressed));
+    EXPECT(decompressed.is_empty());
+}
+
+TEST_CASE(zstd_decompress_raw_block)
+{
+    Array<u8, 18> const compressed {
+        0x28, 0xB5, 0x2F, 0xFD, 0x24, 0x05,
+        0x29, 0x00, 0x00,            // Block Header (last block, raw, 5 bytes)
+        'H', 'e', 'l', 'l', 'o',
+        0x44, 0x7D, 0xB2, 0x75
+    };
+
+    auto decompressed = MUST(Compress::ZstdDecompressor::decompress_all(compressed));
+    EXPECT_EQ(decompressed.bytes(), "Hello"sv.bytes());
+}
+
+TEST_CASE(zstd_decompress_repeated_match)
+{
+    Array<u8, 22> const compressed {
+        0x28, 0xB5, 0x2F, 0xFD, 0x24, 0x39,
+        0x4D, 0x00, 0x00,            // Block Header (last block, compressed, 9 bytes)
+        0x18, 'a', 'b', 'c',         // Raw Literals Section
+        0x01, 0x00, 0xF3, 0x74, 0x43, // Sequences Section (one sequence with the predefined tables)
+        0xAE, 0x7F, 0x88, 0xF8
+    };
+
+    auto decompressed = MUST(Compress::ZstdDecompressor::decompress_all(compressed));
+    EXPECT_EQ(decompressed.bytes(), "abcabcabcabcabcabcabcabcabcabcabcabcabcabcabcabcabcabcabc"sv.bytes());
+}
+
+TEST_CASE(zstd_decompress_checksum_mismatch)
+{
+    Array<u8, 18> const compressed {
+        0x28, 0xB5, 0x2F, 0xFD, 0x24, 0x05,
+        0x29, 0x00, 0x00,
+        'H', 'e', 'l', 'l', 'o',
+        0x44, 0x7D, 0xB2, 0x76
+    };
+
+    EXPECT(Compress::ZstdDecompressor::decompress_all(compressed).is_error());
+}
+
+TEST_CASE(zstd_decompress_skippable_and_concatenated_frames)
+{
+    Array<u8, 40> const compressed {
+        // Skippable Frame
+        0x52, 0x2A, 0x4D, 0x18,      // Magic
+        0x04, 0x00, 0x00, 0x00,      // Frame Size
+        0xDE, 0xAD, 0xBE, 0xEF,
+
+        0x28, 0xB5, 0x2F, 0xFD, 0x24, 0x05,
+        0x29, 0x00, 0x00,
+        'H', 'e', 'l', 'l', 'o',
+        0x44, 0x7D, 0xB2, 0x75,
+
+        // Frame without a checksum or content size, holding a single RLE block
+        0x28, 0xB5, 0x2F, 0xFD,
+        0x00,                        // Frame Header Descriptor
+        0x50,                        // Window Descriptor (4 MiB)
+        0x1B, 0x00, 0x00,            // Block Header (last block, RLE, 3 bytes)
+        '!'
+    };
+
+    auto decompressed = MUST(Compress::ZstdDecompressor::decompress_all(compressed));
+    EXPECT_EQ(decompressed.bytes(), "Hello!!!"sv.bytes());
+}
+
+TEST_CASE(zstd_decompress_truncated)
+{
+    Array<u8, 15> const compressed {
+        0x28, 0xB5, 0x2F, 0xFD, 0x24, 0x05,
+        0x29, 0x00, 0x00,
+        'H', 'e', 'l', 'l', 'o',
+        0x44
+    };
+
+    EXPECT(Compress::ZstdDecompressor::decompress_all(compressed).is_error());
+}
+
+TEST_CASE(zstd_decompress_files)
+{
+    run_test("lorem.txt"sv);
+    run_test("serenityos.html"sv);
+    run_test("happy3rd.html"sv);
+}
+
+TEST_CASE(zstd_round_trip)
+{
+    auto original = ByteBuffer::create_uninitialized(1 * MiB).release_value();
+    fill_with_random(original);
+    // Make a part of the input compressible, so that the compressor emits compressed blocks as well as raw ones.
+    for (size_t i = 300 * KiB; i < original.size(); ++i)
+        original[i] = original[i % 1024] % 16;
+
+    auto compressed = MUST(Compress::ZstdCompressor::compress_all(original));
+    EXPECT(compressed.size() < original.size());
+    auto decompressed = MUST(Compress::ZstdDecompressor::decompress_all(compressed));
+    EXPECT_EQ(decompressed, original);
+}
+
+TEST_CASE(zstd_round_trip_streaming)
+{
+    StringBuilder builder;
+    for (size_t i = 0; builder.length() < 3 * MiB; ++i)
+        builder.appendff("Line {} of a Zstandard test, with some text that repeats now and then ({}).\n", i, i % 37);
+    auto original = MUST(builder.to_byte_buffer());
+
+    AllocatingMemoryStream compressed_stream;
+    {
+        auto compressor = MUST(Compress::ZstdCompressor::create(MaybeOwned<Stream> { compressed_stream }));
+        // Write in uneven pieces, so that blocks and window slides don't line up with the writes.
+        for (size_t offset = 0; offset < original.size(); offset += 12345)
+            MUST(compressor->write_until_depleted(original.bytes().slice(offset, min<size_t>(12345, original.size() - offset))));
+        MUST(compressor->finish());
+    }
+
+    auto decompressor = MUST(Compress::ZstdDecompressor::create(MaybeOwned<Stream> { compressed_stream }));
+    ByteBuffer decompressed;
+    Array<u8, 1000> chunk;
+    while (!decompressor->is_eof())
+        decompressed.append(MUST(decompressor->read_some(chunk)));
+    EXPECT_EQ(decompressed, original);
+}
+
+TEST_CASE(zstd_round_trip_empty)
+{
+    auto compressed = MUST(Compress::ZstdCompressor::compress_all({}));
+    auto decompressed = MUST(Compress::ZstdDecompressor::decompress_all(compressed));
+    EXPECT(decompressed.is_empty());
+}
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/EventLoop.h>
+#include <LibCore/EventLoopImplementationUnix.h>
+#include <LibCore/Timer.h>
+#include <LibTest/TestCase.h>
+
+TEST_CASE(timers_within_slack_fire_in_one_wakeup)
+{
+    Core::EventLoop event_loop;
+    Core::EventLoopManagerUnix::set_timer_slack(Duration::from_milliseconds(200));
+
+    int fired_count = 0;
+    auto first = Core::Timer::create_single_shot(10, [&] { ++fired_count; });
+    auto second = Core::Timer::create_single_shot(60, [&] { ++fired_count; });
+    first->start();
+    second->start();
+
+    while (fired_count == 0)
+        event_loop.pump(Core::EventLoop::WaitMode::WaitForEvents);
+    EXPECT_EQ(fired_count, 2);
+
+    Core::EventLoopManagerUnix::set_timer_slack({});
+}
+
+TEST_CASE(timers_do_not_fire_early)
+{
+    Core::EventLoop event_loop;
+
+    int fired_count = 0;
+    auto first = Core::Timer::create_single_shot(10, [&] { ++fired_count; });
+    auto second = Core::Timer::create_single_shot(200, [&] { ++fired_count; });
+    first->start();
+    second->start();
+
+    while (fired_count == 0)
+        event_loop.pump(Core::EventLoop::WaitMode::WaitForEvents);
+    EXPECT_EQ(fired_count, 1);
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <AK/JsonValue.h>
+#include <LibCore/TraceEvent.h>
+#include <LibTest/TestCase.h>
+
+static JsonArray take_events()
+{
+    auto json = MUST(JsonValue::from_string(Core::TraceEvent::take_events_as_json()));
+    return json.as_array();
+}
+
+TEST_CASE(nothing_is_recorded_while_disabled)
+{
+    Core::TraceEvent::set_enabled(false);
+    {
+        Core::TraceEventScope scope("test"sv, "disabled"sv);
+    }
+    EXPECT(take_events().is_empty());
+}
+
+TEST_CASE(scope_records_complete_event)
+{
+    Core::TraceEvent::set_enabled(true);
+    {
+        Core::TraceEventScope outer("test"sv, "outer"sv);
+        Core::TraceEventScope inner("test"sv, "inner"sv);
+    }
+    Core::TraceEvent::set_enabled(false);
+
+    auto events = take_events();
+    EXPECT_EQ(events.size(), 2u);
+
+    // Scopes are recorded when they end, so the innermost one comes first.
+    auto const& inner = events[0].as_object();
+    auto const& outer = events[1].as_object();
+    EXPECT_EQ(inner.get_byte_string("name"sv), "inner"sv);
+    EXPECT_EQ(outer.get_byte_string("name"sv), "outer"sv);
+    EXPECT_EQ(outer.get_byte_string("cat"sv), "test"sv);
+    EXPECT_EQ(outer.get_byte_string("ph"sv), "X"sv);
+    EXPECT(outer.get_i64("ts"sv).value() <= inner.get_i64("ts"sv).value());
+    EXPECT(outer.get_i64("dur"sv).value() >= inner.get_i64("dur"sv).value());
+    EXPECT_EQ(outer.get_u64("tid"sv), inner.get_u64("tid"sv));
+
+    EXPECT(take_events().is_empty());
+}
+
+TEST_CASE(async_event_is_recorded_as_begin_and_end)
+{
+    auto start = MonotonicTime::now();
+    auto end = start + AK::Duration::from_milliseconds(5);
+    Core::TraceEvent::record_async("network"sv, "load"sv, 42, start, end, "https://example.com/"sv);
+
+    auto events = take_events();
+    EXPECT_EQ(events.size(), 2u);
+
+    auto const& begin_event = events[0].as_object();
+    auto const& end_event = events[1].as_object();
+    EXPECT_EQ(begin_event.get_byte_string("ph"sv), "b"sv);
+    EXPECT_EQ(end_event.get_byte_string("ph"sv), "e"sv);
+    EXPECT_EQ(begin_event.get_u64("id"sv), 42u);
+    EXPECT_EQ(end_event.get_u64("id"sv), 42u);
+    EXPECT_EQ(end_event.get_i64("ts"sv).value() - begin_event.get_i64("ts"sv).value(), 5000);
+    EXPECT_EQ(begin_event.get_object("args"sv)->get_byte_string("detail"sv), "https://example.com/"sv);
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/ByteBuffer.h>
+#include <AK/Random.h>
+#include <LibCrypto/Checksum/Adler32.h>
+#include <LibCrypto/Checksum/CRC32.h>
+#include <LibCrypto/Cipher/AES.h>
+#include <LibCrypto/Cipher/ChaCha20.h>
+#include <LibCrypto/Hash/MD5.h>
+#include <LibCrypto/Hash/SHA1.h>
+#include <LibCrypto/Hash/SHA2.h>
+
+static ReadonlyBytes operator""_b(char const* string, size_t length)
+{
+    return ReadonlyBytes(string, length);
+}
+
+static ByteBuffer const& input()
+{
+    static auto const input = [] {
+        auto buffer = MUST(ByteBuffer::create_uninitialized(64 * KiB));
+        fill_with_random(buffer);
+        return buffer;
+    }();
+    return input;
+}
+
+BENCHMARK_CASE(md5)
+{
+    auto digest = Crypto::Hash::MD5::hash(input());
+    Test::do_not_optimize(digest);
+}
+
+BENCHMARK_CASE(sha1)
+{
+    auto digest = Crypto::Hash::SHA1::hash(input());
+    Test::do_not_optimize(digest);
+}
+
+BENCHMARK_CASE(sha256)
+{
+    auto digest = Crypto::Hash::SHA256::hash(input());
+    Test::do_not_optimize(digest);
+}
+
+BENCHMARK_CASE(sha512)
+{
+    auto digest = Crypto::Hash::SHA512::hash(input());
+    Test::do_not_optimize(digest);
+}
+
+BENCHMARK_CASE(crc32)
+{
+    auto digest = Crypto::Checksum::CRC32(input()).digest();
+    Test::do_not_optimize(digest);
+}
+
+BENCHMARK_CASE(adler32)
+{
+    auto digest = Crypto::Checksum::Adler32(input()).digest();
+    Test::do_not_optimize(digest);
+}
+
+BENCHMARK_CASE(aes_cbc_encrypt)
+{
+    static Crypto::Cipher::AESCipher::CBCMode cipher("WellHelloFriendsWellHelloFriends"_b, 256, Crypto::Cipher::Intent::Encryption);
+    static auto output = MUST(cipher.create_aligned_buffer(input().size()));
+    static auto const iv = MUST(ByteBuffer::create_zeroed(Crypto::Cipher::AESCipher::block_size()));
+
+    auto output_span = output.bytes();
+    cipher.encrypt(input(), output_span, iv);
+    Test::clobber_memory();
+}
+
+BENCHMARK_CASE(chacha20_encrypt)
+{
+    static Crypto::Cipher::ChaCha20 cipher("WellHelloFriendsWellHelloFriends"_b, "HelloFriends"_b);
+    static auto output = MUST(ByteBuffer::create_uninitialized(input().size()));
+
+    auto output_span = output.bytes();
+    cipher.encrypt(input(), output_span);
+    Test::clobber_memory();
+}
@@ -201,6 +201,16 @@ TEST_CASE(test_unsigned_bigint_multiplication_with_big_numbers2)
     EXPECT_EQ(result.words(), expected_result);
 }
 
+TEST_CASE(test_unsigned_bigint_karatsuba_multiplication)
+{
+    // (2^3200 - 1)^2 = 2^6400 - 2^3201 + 1, with operands large enough to go through Karatsuba.
+    Crypto::UnsignedBigInteger one { 1 };
+    auto num = one.shift_left(3200).minus(one);
+    auto result = num.multiplied_by(num);
+    auto expected_result = one.shift_left(6400).minus(one.shift_left(3201)).plus(one);
+    EXPECT_EQ(result, expected_result);
+}
+
 TEST_CASE(test_unsigned_bigint_simple_division)
 {
     Crypto::UnsignedBigInteger num1(27194);
@@ -258,6 +268,12 @@ TEST_CASE(test_bigint_modular_inverse)
     EXPECT_EQ(result, 25);
 }
 
+TEST_CASE(test_bigint_modular_inverse_with_larger_numbers)
+{
+    EXPECT_EQ(Crypto::NumberTheory::ModularInverse(99999, 65521), 34296);
+    EXPECT_EQ(Crypto::NumberTheory::ModularInverse(4000000000u, 2147483647u), 1315749281u);
+}
+
 TEST_CASE(test_bigint_even_simple_modular_power)
 {
     Crypto::UnsignedBigInteger base { 7 };
@@ -6,6 +6,7 @@
 
 #include <LibCrypto/Checksum/Adler32.h>
 #include <LibCrypto/Checksum/CRC32.h>
+#include <LibCrypto/Checksum/XXH64.h>
 #include <LibCrypto/Checksum/cksum.h>
 #include <LibTest/TestCase.h>
 
@@ -23,6 +24,24 @@ TEST_CASE(test_adler32)
     do_test("abcdefghijklmnopqrstuvwxyz"sv.bytes(), 0x90860b20);
 }
 
+TEST_CASE(test_adler32_long_input)
+{
+    Array<u8, 1000> data;
+    for (size_t i = 0; i < data.size(); ++i)
+        data[i] = i * 7 + 3;
+    EXPECT_EQ(Crypto::Checksum::Adler32(data).digest(), 0x38adedfcu);
+
+    // Updating in several parts has to give the same result, including when the parts don't line up with the block size.
+    Crypto::Checksum::Adler32 adler32;
+    adler32.update(data.span().trim(37));
+    adler32.update(data.span().slice(37));
+    EXPECT_EQ(adler32.digest(), 0x38adedfcu);
+
+    Array<u8, 10000> all_ones;
+    all_ones.fill(0xff);
+    EXPECT_EQ(Crypto::Checksum::Adler32(all_ones).digest(), 0xb623eb2bu);
+}
+
 TEST_CASE(test_cksum)
 {
     auto do_test = [](ReadonlyBytes input, u32 expected_result) {
@@ -63,3 +82,47 @@ TEST_CASE(test_crc32)
     do_test("The quick brown fox jumps over the lazy dog"sv.bytes(), 0x414FA339);
     do_test("various CRC algorithms input data"sv.bytes(), 0x9BD366AE);
 }
+
+TEST_CASE(test_crc32_long_input)
+{
+    Array<u8, 1000> data;
+    for (size_t i = 0; i < data.size(); ++i)
+        data[i] = i * 7 + 3;
+    EXPECT_EQ(Crypto::Checksum::CRC32(data).digest(), 0x17bc2a46u);
+
+    // Updating in several parts has to give the same result, including when the parts don't line up with the block size.
+    Crypto::Checksum::CRC32 crc32;
+    crc32.update(data.span().trim(37));
+    crc32.update(data.span().slice(37));
+    EXPECT_EQ(crc32.digest(), 0x17bc2a46u);
+
+    Array<u8, 10000> all_ones;
+    all_ones.fill(0xff);
+    EXPECT_EQ(Crypto::Checksum::CRC32(all_ones).digest(), 0x133c790du);
+}
+
+TEST_CASE(test_xxh64)
+{
+    auto do_test = [](ReadonlyBytes input, u64 expected_result) {
+        auto digest = Crypto::Checksum::XXH64(input).digest();
+        EXPECT_EQ(digest, expected_result);
+    };
+
+    do_test(""sv.bytes(), 0xef46db3751d8e999);
+    do_test("a"sv.bytes(), 0xd24ec4f1a98c6e5b);
+    do_test("abc"sv.bytes(), 0x44bc2cf5ad770999);
+}
+
+TEST_CASE(test_xxh64_long_input)
+{
+    Array<u8, 1000> data;
+    for (size_t i = 0; i < data.size(); ++i)
+        data[i] = i * 7 + 3;
+    EXPECT_EQ(Crypto::Checksum::XXH64(data).digest(), 0x5f235fa033f1a3fbu);
+
+    // Updating in several parts has to give the same result, including when the parts don't line up with the stripe size.
+    Crypto::Checksum::XXH64 xxh64;
+    xxh64.update(data.span().trim(37));
+    xxh64.update(data.span().slice(37));
+    EXPECT_EQ(xxh64.digest(), 0x5f235fa033f1a3fbu);
+}
@@ -40,6 +40,86 @@ BENCHMARK_CASE(fill)
     }
 }
 
+BENCHMARK_CASE(fill_with_alpha)
+{
+    int const run_count = 100;
+    int const bitmap_size = 2000;
+
+    auto bitmap = TRY_OR_FAIL(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, { bitmap_size, bitmap_size }));
+    bitmap->fill(Color::White);
+    Gfx::Painter painter(bitmap);
+
+    for (int run = 0; run < run_count; run++) {
+        painter.fill_rect(bitmap->rect(), Color(Color::Blue).with_alpha(run + 50));
+    }
+}
+
+static NonnullRefPtr<Gfx::Bitmap> make_translucent_bitmap(int size)
+{
+    auto bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, { size, size }));
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x)
+            bitmap->set_pixel(x, y, Color(x, y, x + y, x ^ y));
+    }
+    return bitmap;
+}
+
+BENCHMARK_CASE(blit_with_alpha)
+{
+    int const run_count = 100;
+    int const bitmap_size = 2000;
+
+    auto bitmap = TRY_OR_FAIL(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRx8888, { bitmap_size, bitmap_size }));
+    auto source = make_translucent_bitmap(bitmap_size);
+    Gfx::Painter painter(bitmap);
+
+    for (int run = 0; run < run_count; run++) {
+        painter.blit({ 0, 0 }, source, source->rect());
+    }
+}
+
+BENCHMARK_CASE(blit_with_opacity)
+{
+    int const run_count = 100;
+    int const bitmap_size = 2000;
+
+    auto bitmap = TRY_OR_FAIL(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, { bitmap_size, bitmap_size }));
+    auto source = make_translucent_bitmap(bitmap_size);
+    Gfx::Painter painter(bitmap);
+
+    for (int run = 0; run < run_count; run++) {
+        painter.blit({ 0, 0 }, source, source->rect(), 0.5f);
+    }
+}
+
+BENCHMARK_CASE(draw_scaled_bitmap_with_alpha)
+{
+    int const run_count = 50;
+    int const bitmap_size = 2000;
+
+    auto bitmap = TRY_OR_FAIL(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRx8888, { bitmap_size, bitmap_size }));
+    auto source = make_translucent_bitmap(bitmap_size / 2);
+    Gfx::Painter painter(bitmap);
+
+    for (int run = 0; run < run_count; run++) {
+        painter.draw_scaled_bitmap(bitmap->rect(), source, source->rect(), 1.0f, Gfx::Painter::ScalingMode::BilinearBlend);
+    }
+}
+
+BENCHMARK_CASE(draw_box_sampled_scaled_bitmap)
+{
+    int const run_count = 20;
+    int const bitmap_size = 2000;
+
+    auto bitmap = TRY_OR_FAIL(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRx8888, { bitmap_size / 3, bitmap_size / 3 }));
+    auto source = make_translucent_bitmap(bitmap_size);
+    Gfx::Painter painter(bitmap);
+
+    for (int run = 0; run < run_count; run++) {
+        painter.draw_scaled_bitmap(bitmap->rect(), source, source->rect(), 1.0f, Gfx::Painter::ScalingMode::BoxSampling);
+    }
+}
+
 BENCHMARK_CASE(fill_with_gradient)
 {
     int const run_count = 50;
@@ -52,3 +132,34 @@ BENCHMARK_CASE(fill_with_gradient)
         painter.fill_rect_with_gradient(bitmap->rect(), Color::Blue, Color::Red);
     }
 }
+
+// The cases below paint small areas, like a widget or a glyph would, so per-call overhead matters more than fill rate.
+// They rely on the benchmark runner to repeat them; see --benchmark_min_time.
+
+static Gfx::Painter& small_painter()
+{
+    static auto bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRx8888, { 256, 256 }));
+    static Gfx::Painter painter(bitmap);
+    return painter;
+}
+
+BENCHMARK_CASE(fill_small_rect_with_alpha)
+{
+    small_painter().fill_rect({ 10, 10, 32, 32 }, Color(Color::Blue).with_alpha(128));
+}
+
+BENCHMARK_CASE(fill_small_rect_with_rounded_corners)
+{
+    small_painter().fill_rect_with_rounded_corners({ 10, 10, 64, 24 }, Color::Blue, 6);
+}
+
+BENCHMARK_CASE(fill_small_ellipse)
+{
+    small_painter().fill_ellipse({ 10, 10, 32, 32 }, Color::Blue);
+}
+
+BENCHMARK_CASE(blit_small_bitmap_with_alpha)
+{
+    static auto const source = make_translucent_bitmap(64);
+    small_painter().blit({ 10, 10 }, source, source->rect());
+}
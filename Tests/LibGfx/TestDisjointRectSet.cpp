@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGfx/DisjointRectSet.h>
+#include <LibTest/TestCase.h>
+
+TEST_CASE(coalesce_merges_rects_sharing_an_edge)
+{
+    Gfx::DisjointIntRectSet rects;
+    rects.add({ 0, 0, 10, 10 });
+    rects.add({ 10, 0, 10, 10 });
+    rects.add({ 0, 10, 20, 5 });
+    rects.add({ 100, 100, 10, 10 });
+
+    rects.coalesce(0);
+    EXPECT_EQ(rects.size(), 2u);
+    EXPECT_EQ(rects.rects()[0], Gfx::IntRect(0, 0, 20, 15));
+    EXPECT_EQ(rects.rects()[1], Gfx::IntRect(100, 100, 10, 10));
+}
+
+TEST_CASE(coalesce_keeps_rects_only_partially_sharing_an_edge)
+{
+    Gfx::DisjointIntRectSet rects;
+    rects.add({ 0, 0, 10, 10 });
+    rects.add({ 10, 5, 10, 10 });
+
+    rects.coalesce(0);
+    EXPECT_EQ(rects.size(), 2u);
+}
+
+TEST_CASE(coalesce_into_bounding_rect_when_cheaper)
+{
+    Gfx::DisjointIntRectSet rects;
+    rects.add({ 0, 0, 10, 10 });
+    rects.add({ 20, 0, 10, 10 });
+
+    // Replacing both rects by their bounding rect covers 100 more pixels.
+    rects.coalesce(99);
+    EXPECT_EQ(rects.size(), 2u);
+
+    rects.coalesce(100);
+    EXPECT_EQ(rects.size(), 1u);
+    EXPECT_EQ(rects.rects()[0], Gfx::IntRect(0, 0, 30, 10));
+}
+
+TEST_CASE(coalesce_empty_set)
+{
+    Gfx::DisjointIntRectSet rects;
+    rects.coalesce(1000);
+    EXPECT(rects.is_empty());
+}
@@ -6,10 +6,13 @@
  */
 
 #include <AK/Utf8View.h>
+#include <LibCore/MappedFile.h>
 #include <LibCore/ResourceImplementationFile.h>
 #include <LibGfx/Font/BitmapFont.h>
 #include <LibGfx/Font/FontDatabase.h>
+#include <LibGfx/Font/GlyphBitmapCache.h>
 #include <LibGfx/Font/OpenType/Glyf.h>
+#include <LibGfx/Font/WOFF2/Font.h>
 #include <LibTest/TestCase.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -194,3 +197,43 @@ TEST_CASE(resolve_glyph_path_containing_single_off_curve_point)
         return Test::Crash::Failure::DidNotCrash;
     });
 }
+
+TEST_CASE(glyph_bitmap_cache_evicts_least_recently_used_glyphs)
+{
+#ifdef AK_OS_SERENITY
+    auto file = MUST(Core::MappedFile::map("/usr/Tests/LibGfx/test-inputs/woff2/incorrect_sfnt_size.woff2"sv));
+#else
+    auto file = MUST(Core::MappedFile::map("test-inputs/woff2/incorrect_sfnt_size.woff2"sv));
+#endif
+    auto font = TRY_OR_FAIL(WOFF2::Font::try_load_from_externally_owned_memory(file->bytes()));
+    auto scaled_font = font->scaled_font(12);
+    auto glyph_bitmap = TRY_OR_FAIL(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, { 10, 10 }));
+    auto glyph = [](u32 glyph_id) { return Gfx::GlyphIndexWithSubpixelOffset { glyph_id, { 0, 0 } }; };
+
+    size_t glyph_size_in_bytes = 0;
+    {
+        Gfx::GlyphBitmapCache cache;
+        cache.set(*scaled_font, glyph(0), glyph_bitmap);
+        glyph_size_in_bytes = cache.size_in_bytes();
+    }
+
+    // There is only enough room for three glyphs.
+    Gfx::GlyphBitmapCache cache(3 * glyph_size_in_bytes);
+    cache.set(*scaled_font, glyph(1), glyph_bitmap);
+    cache.set(*scaled_font, glyph(2), glyph_bitmap);
+    cache.set(*scaled_font, glyph(3), glyph_bitmap);
+    EXPECT_EQ(cache.glyph_count(), 3u);
+
+    EXPECT_EQ(cache.get(*scaled_font, glyph(1)).value(), glyph_bitmap);
+    cache.set(*scaled_font, glyph(4), glyph_bitmap);
+    EXPECT_EQ(cache.glyph_count(), 3u);
+    EXPECT_EQ(cache.size_in_bytes(), 3 * glyph_size_in_bytes);
+    EXPECT(!cache.get(*scaled_font, glyph(2)).has_value());
+    EXPECT(cache.get(*scaled_font, glyph(1)).has_value());
+    EXPECT(cache.get(*scaled_font, glyph(3)).has_value());
+    EXPECT(cache.get(*scaled_font, glyph(4)).has_value());
+
+    cache.remove_all_glyphs_of(*scaled_font);
+    EXPECT_EQ(cache.glyph_count(), 0u);
+    EXPECT_EQ(cache.size_in_bytes(), 0u);
+}
@@ -224,6 +224,25 @@ TEST_CASE(from_pcs)
     EXPECT_EQ(sRGB_from_xyz(r_xyz * f64 + g_xyz * f128 + b_xyz * f192), Color(64, 128, 192));
 }
 
+TEST_CASE(matrix_matrix_conversion)
+{
+    auto sRGB = MUST(Gfx::ICC::sRGB());
+    auto map = sRGB->matrix_matrix_conversion(sRGB);
+    EXPECT(map.has_value());
+
+    // Converting sRGB to sRGB must round-trip every channel value exactly.
+    for (int i = 0; i < 256; ++i) {
+        u8 value = i;
+        EXPECT_EQ(map->map(value, value, value), Color(value, value, value));
+        EXPECT_EQ(map->map(FloatVector3 { value / 255.f, value / 255.f, value / 255.f }), Color(value, value, value));
+    }
+
+    EXPECT_EQ(map->map(255, 0, 0), Color(255, 0, 0));
+    EXPECT_EQ(map->map(0, 255, 0), Color(0, 255, 0));
+    EXPECT_EQ(map->map(0, 0, 255), Color(0, 0, 255));
+    EXPECT_EQ(map->map(64, 128, 192), Color(64, 128, 192));
+}
+
 TEST_CASE(to_lab)
 {
     auto sRGB = MUST(Gfx::ICC::sRGB());
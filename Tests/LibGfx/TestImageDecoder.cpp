@@ -115,6 +115,27 @@ TEST_CASE(test_gif)
     EXPECT(frame.duration == 400);
 }
 
+TEST_CASE(test_gif_partial_first_frame)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("download-animation.gif"sv)));
+    auto plugin_decoder = TRY_OR_FAIL(Gfx::GIFImageDecoderPlugin::create(file->bytes()));
+    auto expected_frame = TRY_OR_FAIL(plugin_decoder->frame(0));
+
+    auto partial_decoder = TRY_OR_FAIL(Gfx::GIFImageDecoderPlugin::create(file->bytes().trim(file->bytes().size() * 3 / 10)));
+    auto partial_frame = TRY_OR_FAIL(partial_decoder->partial_first_frame());
+    EXPECT(!partial_frame.is_complete);
+    EXPECT(partial_frame.decoded_rows_of_current_pass > 0);
+    EXPECT(partial_frame.decoded_rows_of_current_pass < expected_frame.image->height());
+    EXPECT_EQ(partial_frame.image->size(), expected_frame.image->size());
+    EXPECT_EQ(partial_frame.image->get_pixel(0, 0), expected_frame.image->get_pixel(0, 0));
+    EXPECT_EQ(partial_frame.image->get_pixel(0, expected_frame.image->height() - 1).alpha(), 0);
+
+    auto complete_decoder = TRY_OR_FAIL(Gfx::GIFImageDecoderPlugin::create(file->bytes()));
+    auto complete_frame = TRY_OR_FAIL(complete_decoder->partial_first_frame());
+    EXPECT(complete_frame.is_complete);
+    EXPECT(complete_frame.image->visually_equals(*expected_frame.image));
+}
+
 TEST_CASE(test_gif_without_global_color_table)
 {
     Array<u8, 35> gif_data {
@@ -490,6 +511,26 @@ TEST_CASE(test_jpeg_sof2_spectral_selection)
     TRY_OR_FAIL(expect_single_frame_of_size(*plugin_decoder, { 592, 800 }));
 }
 
+TEST_CASE(test_jpeg_sof2_partial_first_frame)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("jpg/spectral_selection.jpg"sv)));
+    auto plugin_decoder = TRY_OR_FAIL(Gfx::JPEGImageDecoderPlugin::create(file->bytes()));
+    auto expected_frame = TRY_OR_FAIL(plugin_decoder->frame(0));
+
+    // The first scans only contain the DC coefficients, which are enough to show a blurry version of the whole image.
+    auto partial_decoder = TRY_OR_FAIL(Gfx::JPEGImageDecoderPlugin::create(file->bytes().trim(file->bytes().size() / 2)));
+    auto partial_frame = TRY_OR_FAIL(partial_decoder->partial_first_frame());
+    EXPECT(!partial_frame.is_complete);
+    EXPECT(partial_frame.decoded_passes > 0);
+    EXPECT_EQ(partial_frame.image->size(), expected_frame.image->size());
+    EXPECT(!partial_frame.image->visually_equals(*expected_frame.image));
+
+    auto complete_decoder = TRY_OR_FAIL(Gfx::JPEGImageDecoderPlugin::create(file->bytes()));
+    auto complete_frame = TRY_OR_FAIL(complete_decoder->partial_first_frame());
+    EXPECT(complete_frame.is_complete);
+    EXPECT(complete_frame.image->visually_equals(*expected_frame.image));
+}
+
 TEST_CASE(test_jpeg_sof0_several_scans_odd_number_mcu)
 {
     auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("jpg/several_scans_odd_number_mcu.jpg"sv)));
@@ -553,6 +594,24 @@ TEST_CASE(test_jpeg_grayscale_with_weird_mcu_and_reset_marker)
     TRY_OR_FAIL(expect_single_frame_of_size(*plugin_decoder, { 320, 240 }));
 }
 
+TEST_CASE(test_jpeg_restart_intervals_on_several_threads)
+{
+    Array test_inputs = {
+        TEST_INPUT("jpg/odd-restart.jpg"sv),
+        TEST_INPUT("jpg/grayscale_mcu.jpg"sv),
+    };
+
+    for (auto test_input : test_inputs) {
+        auto file = TRY_OR_FAIL(Core::MappedFile::map(test_input));
+        auto single_threaded_decoder = TRY_OR_FAIL(Gfx::JPEGImageDecoderPlugin::create(file->bytes()));
+        auto expected_frame = TRY_OR_FAIL(single_threaded_decoder->frame(0));
+
+        auto plugin_decoder = TRY_OR_FAIL(Gfx::JPEGImageDecoderPlugin::create_with_options(file->bytes(), {}, { .thread_count = 4 }));
+        auto frame = TRY_OR_FAIL(plugin_decoder->frame(0));
+        EXPECT(frame.image->visually_equals(*expected_frame.image));
+    }
+}
+
 TEST_CASE(test_jpeg_malformed_header)
 {
     Array test_inputs = {
@@ -769,6 +828,72 @@ TEST_CASE(test_png)
     TRY_OR_FAIL(expect_single_frame(*plugin_decoder));
 }
 
+TEST_CASE(test_png_partial_first_frame)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("png/buggie.png"sv)));
+    auto plugin_decoder = TRY_OR_FAIL(Gfx::PNGImageDecoderPlugin::create(file->bytes()));
+    auto expected_frame = TRY_OR_FAIL(plugin_decoder->frame(0));
+
+    int previous_decoded_rows = 0;
+    for (size_t quarters = 1; quarters < 4; ++quarters) {
+        auto partial_decoder = TRY_OR_FAIL(Gfx::PNGImageDecoderPlugin::create(file->bytes().trim(file->bytes().size() * quarters / 4)));
+        auto partial_frame = TRY_OR_FAIL(partial_decoder->partial_first_frame());
+        EXPECT(!partial_frame.is_complete);
+        EXPECT_EQ(partial_frame.decoded_passes, 0u);
+        EXPECT(partial_frame.decoded_rows_of_current_pass > previous_decoded_rows);
+        previous_decoded_rows = partial_frame.decoded_rows_of_current_pass;
+
+        for (int x = 0; x < expected_frame.image->width(); ++x) {
+            EXPECT_EQ(partial_frame.image->get_pixel(x, previous_decoded_rows - 1), expected_frame.image->get_pixel(x, previous_decoded_rows - 1));
+            EXPECT_EQ(partial_frame.image->get_pixel(x, previous_decoded_rows).alpha(), 0);
+        }
+    }
+
+    auto complete_decoder = TRY_OR_FAIL(Gfx::PNGImageDecoderPlugin::create(file->bytes()));
+    auto complete_frame = TRY_OR_FAIL(complete_decoder->partial_first_frame());
+    EXPECT(complete_frame.is_complete);
+    EXPECT(complete_frame.image->visually_equals(*expected_frame.image));
+}
+
+TEST_CASE(test_png_adam7)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("png/adam7.png"sv)));
+    auto plugin_decoder = TRY_OR_FAIL(Gfx::PNGImageDecoderPlugin::create(file->bytes()));
+
+    auto frame = TRY_OR_FAIL(expect_single_frame_of_size(*plugin_decoder, { 32, 32 }));
+    for (int y = 0; y < 32; ++y) {
+        for (int x = 0; x < 32; ++x)
+            EXPECT_EQ(frame.image->get_pixel(x, y), Gfx::Color(x * 8, y * 8, 255 - (x + y) * 4));
+    }
+}
+
+TEST_CASE(test_png_adam7_partial_first_frame)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("png/adam7.png"sv)));
+
+    // Half of the image data covers the first five passes, and part of the sixth one.
+    auto partial_decoder = TRY_OR_FAIL(Gfx::PNGImageDecoderPlugin::create(file->bytes().trim(file->bytes().size() / 2)));
+    auto partial_frame = TRY_OR_FAIL(partial_decoder->partial_first_frame());
+    EXPECT(!partial_frame.is_complete);
+    EXPECT_EQ(partial_frame.decoded_passes, 5u);
+    EXPECT(partial_frame.decoded_rows_of_current_pass > 0);
+
+    // Each decoded pixel stands in for the pixels of the later passes around it.
+    for (int y = 0; y < 32; ++y) {
+        for (int x = 0; x < 32; ++x) {
+            int block_x = y < partial_frame.decoded_rows_of_current_pass ? x : x / 2 * 2;
+            int block_y = y / 2 * 2;
+            EXPECT_EQ(partial_frame.image->get_pixel(x, y), Gfx::Color(block_x * 8, block_y * 8, 255 - (block_x + block_y) * 4));
+        }
+    }
+
+    auto complete_decoder = TRY_OR_FAIL(Gfx::PNGImageDecoderPlugin::create(file->bytes()));
+    auto complete_frame = TRY_OR_FAIL(complete_decoder->partial_first_frame());
+    EXPECT(complete_frame.is_complete);
+    EXPECT_EQ(complete_frame.decoded_passes, 7u);
+    EXPECT(complete_frame.image->visually_equals(*TRY_OR_FAIL(complete_decoder->frame(0)).image));
+}
+
 TEST_CASE(test_exif)
 {
     auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("png/exif.png"sv)));
@@ -781,6 +906,24 @@ TEST_CASE(test_exif)
     EXPECT_EQ(*exif_metadata.orientation(), Gfx::TIFF::Orientation::Rotate90Clockwise);
 }
 
+TEST_CASE(test_apng_frames_on_several_threads)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("png/animated.png"sv)));
+    auto single_threaded_decoder = TRY_OR_FAIL(Gfx::PNGImageDecoderPlugin::create(file->bytes()));
+    EXPECT(single_threaded_decoder->is_animated());
+    EXPECT_EQ(single_threaded_decoder->frame_count(), 7u);
+
+    auto plugin_decoder = TRY_OR_FAIL(Gfx::PNGImageDecoderPlugin::create_with_options(file->bytes(), { .thread_count = 4 }));
+    EXPECT_EQ(plugin_decoder->frame_count(), 7u);
+
+    for (size_t i = 0; i < plugin_decoder->frame_count(); ++i) {
+        auto expected_frame = TRY_OR_FAIL(single_threaded_decoder->frame(i));
+        auto frame = TRY_OR_FAIL(plugin_decoder->frame(i));
+        EXPECT_EQ(frame.duration, expected_frame.duration);
+        EXPECT(frame.image->visually_equals(*expected_frame.image));
+    }
+}
+
 TEST_CASE(test_png_malformed_frame)
 {
     Array test_inputs = {
@@ -1288,6 +1431,25 @@ TEST_CASE(test_webp_lossy_4_with_partitions)
     EXPECT_EQ(frame.image->get_pixel(780, 570), Gfx::Color(0x73, 0xc9, 0xf9, 255));
 }
 
+TEST_CASE(test_webp_lossy_on_several_threads)
+{
+    Array test_inputs = {
+        TEST_INPUT("webp/4.webp"sv),
+        TEST_INPUT("webp/4-with-8-partitions.webp"sv),
+        TEST_INPUT("webp/extended-lossy.webp"sv),
+    };
+
+    for (auto test_input : test_inputs) {
+        auto file = TRY_OR_FAIL(Core::MappedFile::map(test_input));
+        auto single_threaded_decoder = TRY_OR_FAIL(Gfx::WebPImageDecoderPlugin::create(file->bytes()));
+        auto expected_frame = TRY_OR_FAIL(single_threaded_decoder->frame(0));
+
+        auto plugin_decoder = TRY_OR_FAIL(Gfx::WebPImageDecoderPlugin::create_with_options(file->bytes(), { .thread_count = 4 }));
+        auto frame = TRY_OR_FAIL(plugin_decoder->frame(0));
+        EXPECT(frame.image->visually_equals(*expected_frame.image));
+    }
+}
+
 TEST_CASE(test_webp_extended_lossless)
 {
     auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("webp/extended-lossless.webp"sv)));
@@ -1461,6 +1623,17 @@ TEST_CASE(test_jxl_modular_simple_tree_upsample2_10bits)
     EXPECT_EQ(frame.image->get_pixel(42, 57), Gfx::Color::from_string("#4c0072"sv));
 }
 
+TEST_CASE(test_jxl_modular_simple_tree_upsample2_10bits_on_several_threads)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("jxl/modular_simple_tree_upsample2_10bits_rct.jxl"sv)));
+    auto single_threaded_decoder = TRY_OR_FAIL(Gfx::JPEGXLImageDecoderPlugin::create(file->bytes()));
+    auto expected_frame = TRY_OR_FAIL(single_threaded_decoder->frame(0));
+
+    auto plugin_decoder = TRY_OR_FAIL(Gfx::JPEGXLImageDecoderPlugin::create_with_options(file->bytes(), { .thread_count = 4 }));
+    auto frame = TRY_OR_FAIL(expect_single_frame_of_size(*plugin_decoder, { 128, 128 }));
+    EXPECT(frame.image->visually_equals(*expected_frame.image));
+}
+
 TEST_CASE(test_jxl_modular_property_8)
 {
     auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("jxl/modular_property_8.jxl"sv)));
@@ -6,6 +6,8 @@
 
 #include <LibTest/TestCase.h>
 
+#include <LibGfx/AntiAliasingPainter.h>
+#include <LibGfx/ImmutableBitmap.h>
 #include <LibGfx/Painter.h>
 
 TEST_CASE(draw_scaled_bitmap_with_transform)
@@ -53,3 +55,121 @@ TEST_CASE(draw_rect_rough_bounds)
     painter.draw_rect(Gfx::IntRect(0, 0, 1, 1), Color::Black, true);
     painter.draw_rect(Gfx::IntRect(9, 9, 1, 1), Color::Black, true);
 }
+
+TEST_CASE(blend_matches_color_blend)
+{
+    // Odd widths make sure that the pixels that don't fill up a whole vector are blended as well.
+    auto make_bitmap = [](Gfx::BitmapFormat format, u32 seed) {
+        auto bitmap = MUST(Gfx::Bitmap::create(format, { 37, 7 }));
+        for (int y = 0; y < bitmap->height(); ++y) {
+            for (int x = 0; x < bitmap->width(); ++x) {
+                seed = seed * 1103515245 + 12345;
+                u32 alpha = x % 3 == 0 ? 0xff : (seed >> 8) & 0xff;
+                bitmap->scanline(y)[x] = (alpha << 24) | (seed >> 8 & 0xffffff);
+            }
+        }
+        return bitmap;
+    };
+
+    for (auto format : { Gfx::BitmapFormat::BGRx8888, Gfx::BitmapFormat::BGRA8888 }) {
+        auto bitmap = make_bitmap(format, 1);
+        auto expected = MUST(bitmap->clone());
+        auto source = make_bitmap(Gfx::BitmapFormat::BGRA8888, 2);
+
+        Gfx::Painter painter(*bitmap);
+        painter.blit({ 0, 0 }, source, source->rect());
+
+        for (int y = 0; y < bitmap->height(); ++y) {
+            for (int x = 0; x < bitmap->width(); ++x) {
+                auto destination = expected->get_pixel(x, y);
+                EXPECT_EQ(bitmap->get_pixel(x, y), destination.blend(source->get_pixel(x, y)));
+            }
+        }
+
+        auto color = Color(10, 200, 30, 77);
+        expected = MUST(bitmap->clone());
+        painter.fill_rect(bitmap->rect(), color);
+
+        for (int y = 0; y < bitmap->height(); ++y) {
+            for (int x = 0; x < bitmap->width(); ++x)
+                EXPECT_EQ(bitmap->get_pixel(x, y), expected->get_pixel(x, y).blend(color));
+        }
+    }
+}
+
+TEST_CASE(fill_path_winding_rules)
+{
+    // A pentagram, where the pentagon in the middle winds twice.
+    Gfx::Path path;
+    path.move_to({ 50, 5 });
+    path.line_to({ 77, 90 });
+    path.line_to({ 5, 37 });
+    path.line_to({ 95, 37 });
+    path.line_to({ 23, 90 });
+    path.close();
+
+    for (auto winding_rule : { Gfx::Painter::WindingRule::Nonzero, Gfx::Painter::WindingRule::EvenOdd }) {
+        auto bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRx8888, { 100, 100 }));
+        bitmap->fill(Color::White);
+        Gfx::Painter painter(*bitmap);
+        Gfx::AntiAliasingPainter aa_painter(painter);
+        aa_painter.fill_path(path, Color::Black, winding_rule);
+
+        EXPECT_EQ(bitmap->get_pixel(50, 50), winding_rule == Gfx::Painter::WindingRule::Nonzero ? Color::Black : Color::White);
+        EXPECT_EQ(bitmap->get_pixel(50, 20), Color::Black);
+        EXPECT_EQ(bitmap->get_pixel(5, 90), Color::White);
+
+        // Pixels on the edges are only partially covered.
+        auto edge = bitmap->get_pixel(54, 20);
+        EXPECT(edge != Color::White && edge != Color::Black);
+    }
+}
+
+TEST_CASE(draw_box_sampled_scaled_bitmap)
+{
+    // The left half is opaque red and the right half is a transparent green, which must not bleed into the result.
+    auto source = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, { 4, 4 }));
+    for (int y = 0; y < 4; ++y) {
+        for (int x = 0; x < 4; ++x)
+            source->set_pixel(x, y, x < 2 ? Color::Red : Color(Color::Green).with_alpha(0));
+    }
+
+    auto bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, { 3, 2 }));
+    Gfx::Painter painter(*bitmap);
+    painter.draw_scaled_bitmap({ 0, 0, 3, 2 }, *source, source->rect(), 1.0f, Gfx::Painter::ScalingMode::BoxSampling);
+
+    // Each destination pixel covers 4/3 source pixels horizontally, so the one in the middle is half covered by red.
+    for (int y = 0; y < 2; ++y) {
+        EXPECT_EQ(bitmap->get_pixel(0, y), Color::Red);
+        auto middle = bitmap->get_pixel(1, y);
+        EXPECT_EQ(middle.with_alpha(255), Color::Red);
+        EXPECT(middle.alpha() == 127 || middle.alpha() == 128);
+        EXPECT_EQ(bitmap->get_pixel(2, y).alpha(), 0);
+    }
+}
+
+TEST_CASE(immutable_bitmap_scaled_bitmap)
+{
+    auto source = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, { 50, 40 }));
+    for (int y = 0; y < source->height(); ++y) {
+        for (int x = 0; x < source->width(); ++x)
+            source->set_pixel(x, y, Color(x * 5, y * 6, x ^ y, (x + y) * 3));
+    }
+    auto immutable_bitmap = Gfx::ImmutableBitmap::create(source);
+
+    for (auto scaling_mode : { Gfx::Painter::ScalingMode::BilinearBlend, Gfx::Painter::ScalingMode::BoxSampling }) {
+        auto expected = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, { 17, 13 }));
+        Gfx::Painter painter(*expected);
+        painter.draw_scaled_bitmap(expected->rect(), *source, source->rect(), 1.0f, scaling_mode);
+
+        auto scaled = MUST(immutable_bitmap->scaled_bitmap(expected->size(), scaling_mode));
+        EXPECT_EQ(scaled->size(), expected->size());
+        for (int y = 0; y < expected->height(); ++y) {
+            for (int x = 0; x < expected->width(); ++x)
+                EXPECT_EQ(scaled->get_pixel(x, y), expected->get_pixel(x, y));
+        }
+
+        // Asking for the same size again returns the bitmap that was scaled before.
+        EXPECT_EQ(MUST(immutable_bitmap->scaled_bitmap(expected->size(), scaling_mode)).ptr(), scaled.ptr());
+    }
+}
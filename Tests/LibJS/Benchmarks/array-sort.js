@@ -0,0 +1,11 @@
+let seed = 42;
+function random() {
+    seed = (seed * 1103515245 + 12345) % 2147483648;
+    return seed;
+}
+
+for (let iteration = 0; iteration < 10; ++iteration) {
+    const numbers = [];
+    for (let i = 0; i < 20000; ++i) numbers.push(random());
+    numbers.sort((a, b) => a - b);
+}
@@ -0,0 +1,5 @@
+const records = [];
+for (let i = 0; i < 2000; ++i)
+    records.push({ id: i, name: `record ${i}`, tags: ["a", "b", "c"], nested: { ok: i % 2 === 0 } });
+
+for (let iteration = 0; iteration < 10; ++iteration) JSON.parse(JSON.stringify(records));
@@ -0,0 +1,6 @@
+let promise = Promise.resolve(0);
+for (let i = 0; i < 50000; ++i) promise = promise.then(value => value + 1);
+
+(async () => {
+    for (let i = 0; i < 50000; ++i) await i;
+})();
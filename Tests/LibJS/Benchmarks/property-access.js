@@ -0,0 +1,14 @@
+class Point {
+    constructor(x, y) {
+        this.x = x;
+        this.y = y;
+    }
+
+    add(other) {
+        return new Point(this.x + other.x, this.y + other.y);
+    }
+}
+
+let sum = new Point(0, 0);
+const step = new Point(1, 2);
+for (let i = 0; i < 300000; ++i) sum = sum.add(step);
@@ -0,0 +1,5 @@
+for (let iteration = 0; iteration < 20; ++iteration) {
+    let string = "";
+    for (let i = 0; i < 10000; ++i) string += i.toString(16) + ",";
+    string.split(",").join(";");
+}
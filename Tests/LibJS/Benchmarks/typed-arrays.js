@@ -0,0 +1,11 @@
+const pixels = new Uint8ClampedArray(256 * 256 * 4);
+for (let iteration = 0; iteration < 20; ++iteration) {
+    for (let i = 0; i < pixels.length; i += 4) {
+        pixels[i] = i & 0xff;
+        pixels[i + 1] = (i >> 8) & 0xff;
+        pixels[i + 2] = iteration;
+        pixels[i + 3] = 255;
+    }
+    pixels.indexOf(7);
+    new Uint8ClampedArray(pixels.length).set(pixels);
+}
@@ -1078,6 +1078,48 @@ TEST_CASE(optimizer_alternation)
     }
 }
 
+TEST_CASE(optimizer_starting_ranges)
+{
+    {
+        Regex<ECMA262> re("[ace]\\d+"sv);
+        EXPECT_EQ(re.parser_result.optimization_data.starting_ranges.size(), 3u);
+    }
+    {
+        // Anything that may match something other than the first compare has to be left alone.
+        Regex<ECMA262> re("a?b"sv);
+        EXPECT(re.parser_result.optimization_data.starting_ranges.is_empty());
+    }
+    {
+        Regex<ECMA262> re("[^a]b"sv);
+        EXPECT(re.parser_result.optimization_data.starting_ranges.is_empty());
+    }
+
+    Array tests {
+        // Pattern, Subject, Expected matches
+        Tuple { "[xyz]\\d+"sv, "a1 x12 bb y3 z"sv, Array { "x12"sv, "y3"sv } },
+        Tuple { "(q)u+"sv, "quu qi qu"sv, Array { "quu"sv, "qu"sv } },
+        Tuple { "[0-9]+"sv, "abc 123 def 45"sv, Array { "123"sv, "45"sv } },
+    };
+
+    for (auto& test : tests) {
+        Regex<ECMA262> re(test.get<0>(), ECMAScriptFlags::Global);
+        EXPECT(!re.parser_result.optimization_data.starting_ranges.is_empty());
+
+        auto result = re.match(test.get<1>());
+        EXPECT(result.success);
+        EXPECT_EQ(result.matches.size(), test.get<2>().size());
+        for (size_t i = 0; i < min(result.matches.size(), test.get<2>().size()); ++i)
+            EXPECT_EQ(result.matches[i].view.to_byte_string(), test.get<2>()[i]);
+    }
+
+    {
+        // Case insensitivity can also be asked for when matching, where the starting ranges don't apply anymore.
+        Regex<ECMA262> re("x\\d"sv, ECMAScriptFlags::Global);
+        auto result = re.match("X1 x2"sv, ECMAScriptFlags::Global | ECMAScriptFlags::Insensitive);
+        EXPECT_EQ(result.matches.size(), 2u);
+    }
+}
+
 TEST_CASE(posix_basic_dollar_is_end_anchor)
 {
     // Ensure that a dollar sign at the end only matches the end of the line.
@@ -192,3 +192,92 @@ TEST_CASE(heap_free_storage)
     auto new_heap_size = MUST(heap->file_size_in_bytes());
     EXPECT(new_heap_size <= heap_size);
 }
+
+TEST_CASE(heap_read_back_more_blocks_than_fit_in_cache)
+{
+    ScopeGuard guard([]() { MUST(Core::System::unlink(db_path)); });
+
+    // Every storage below fits in a single block, so we touch far more blocks than the Heap keeps cached
+    static constexpr size_t storage_count = 3000;
+    Vector<SQL::Block::Index> indices;
+    {
+        auto heap = create_heap();
+        for (size_t i = 0; i < storage_count; ++i) {
+            auto index = heap->request_new_block_index();
+            auto value = ByteString::formatted("storage {}", i);
+            TRY_OR_FAIL(heap->write_storage(index, value.bytes()));
+            indices.append(index);
+        }
+        MUST(heap->flush());
+
+        // Overwrite every other storage after the first flush, so cached blocks need to be replaced
+        for (size_t i = 0; i < storage_count; i += 2) {
+            auto value = ByteString::formatted("overwritten {}", i);
+            TRY_OR_FAIL(heap->write_storage(indices[i], value.bytes()));
+        }
+        for (size_t i = 0; i < storage_count; ++i) {
+            auto expected = i % 2 == 0 ? ByteString::formatted("overwritten {}", i) : ByteString::formatted("storage {}", i);
+            EXPECT_EQ(TRY_OR_FAIL(heap->read_storage(indices[i])).bytes(), expected.bytes());
+        }
+        MUST(heap->flush());
+    }
+
+    auto heap = create_heap();
+    for (size_t pass = 0; pass < 2; ++pass) {
+        for (size_t i = 0; i < storage_count; ++i) {
+            auto expected = i % 2 == 0 ? ByteString::formatted("overwritten {}", i) : ByteString::formatted("storage {}", i);
+            EXPECT_EQ(TRY_OR_FAIL(heap->read_storage(indices[i])).bytes(), expected.bytes());
+        }
+    }
+}
+
+static ByteBuffer read_file(StringView path)
+{
+    auto file = MUST(Core::File::open(path, Core::File::OpenMode::Read));
+    return MUST(file->read_until_eof());
+}
+
+static void write_file(StringView path, ReadonlyBytes data)
+{
+    auto file = MUST(Core::File::open(path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+    MUST(file->write_until_depleted(data));
+}
+
+TEST_CASE(heap_recover_flushed_storage_from_wal)
+{
+    ScopeGuard guard([]() { MUST(Core::System::unlink(db_path)); });
+    auto wal_path = ByteString::formatted("{}-wal", db_path);
+
+    StringBuilder builder;
+    MUST(builder.try_append_repeated('x', SQL::Block::DATA_SIZE * 4));
+    auto long_string = builder.string_view();
+
+    // Capture the heap and log files after a flush, before the log is checkpointed into the heap file
+    SQL::Block::Index storage_block_id = 0;
+    ByteBuffer heap_file;
+    ByteBuffer wal_file;
+    {
+        auto heap = create_heap();
+        storage_block_id = heap->request_new_block_index();
+        TRY_OR_FAIL(heap->write_storage(storage_block_id, long_string.bytes()));
+        MUST(heap->flush());
+
+        // A flush that is torn halfway through must be ignored upon recovery
+        TRY_OR_FAIL(heap->write_storage(storage_block_id, "torn"sv.bytes()));
+        heap_file = read_file(db_path);
+        wal_file = read_file(wal_path);
+        EXPECT(wal_file.size() > long_string.length());
+        MUST(heap->flush());
+        auto full_wal_file = read_file(wal_path);
+        TRY_OR_FAIL(wal_file.try_append(full_wal_file.bytes().slice(wal_file.size(), (full_wal_file.size() - wal_file.size()) / 2)));
+    }
+
+    // Simulate a crash by restoring both files
+    write_file(db_path, heap_file);
+    write_file(wal_path, wal_file);
+
+    auto heap = create_heap();
+    auto stored_long_string = TRY_OR_FAIL(heap->read_storage(storage_block_id));
+    EXPECT_EQ(long_string.bytes(), stored_long_string.bytes());
+    EXPECT_EQ(read_file(wal_path).size(), 0u);
+}
@@ -128,6 +128,10 @@ TEST_CASE(insert_into_table_multiple_tuples_wrong_data_types)
     auto result = try_execute(database, "INSERT INTO TestSchema.TestTable ( TextColumn, IntColumn ) VALUES ('Test_1', 42), (43, 'Test_2');");
     EXPECT(result.is_error());
     EXPECT(result.release_error().error() == SQL::SQLErrorCode::InvalidValueType);
+
+    // None of the tuples should have been inserted
+    auto table = MUST(database->get_table("TESTSCHEMA", "TESTTABLE"));
+    EXPECT(TRY_OR_FAIL(database->select_all(*table)).is_empty());
 }
 
 TEST_CASE(insert_wrong_number_of_values)
@@ -384,6 +388,48 @@ TEST_CASE(select_inner_join)
     EXPECT_EQ(result[0].row[2].to_byte_string(), "Test_12");
 }
 
+TEST_CASE(select_inner_join_with_single_table_terms)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = MUST(SQL::Database::create(db_name));
+    MUST(database->open());
+    create_two_tables(database);
+    auto result = execute(database,
+        "INSERT INTO TestSchema.TestTable1 ( TextColumn1, IntColumn ) VALUES "
+        "( 'Test_1', 42 ), "
+        "( 'Test_2', 43 ), "
+        "( 'Test_3', 44 ), "
+        "( 'Test_4', 45 ), "
+        "( 'Test_5', 46 );");
+    EXPECT(result.size() == 5);
+    result = execute(database,
+        "INSERT INTO TestSchema.TestTable2 ( TextColumn2, IntColumn ) VALUES "
+        "( 'Test_10', 43 ), "
+        "( 'Test_11', 44 ), "
+        "( 'Test_12', 45 ), "
+        "( 'Test_13', 46 ), "
+        "( 'Test_14', 47 );");
+    EXPECT(result.size() == 5);
+    result = execute(database,
+        "SELECT TestTable1.IntColumn, TextColumn1, TextColumn2 "
+        "FROM TestSchema.TestTable1, TestSchema.TestTable2 "
+        "WHERE (TestTable1.IntColumn > 43) AND (TextColumn2 != 'Test_12') AND (TestTable1.IntColumn = TestTable2.IntColumn) "
+        "ORDER BY TextColumn1;");
+    EXPECT_EQ(result.size(), 2u);
+    EXPECT_EQ(result[0].row[0].to_int<i32>(), 44);
+    EXPECT_EQ(result[0].row[1].to_byte_string(), "Test_3");
+    EXPECT_EQ(result[0].row[2].to_byte_string(), "Test_11");
+    EXPECT_EQ(result[1].row[0].to_int<i32>(), 46);
+    EXPECT_EQ(result[1].row[1].to_byte_string(), "Test_5");
+    EXPECT_EQ(result[1].row[2].to_byte_string(), "Test_13");
+
+    // An unqualified column name that exists in both tables is still ambiguous.
+    auto ambiguous_result = try_execute(database,
+        "SELECT TextColumn1 FROM TestSchema.TestTable1, TestSchema.TestTable2 WHERE (TextColumn1 = 'Test_1') AND (IntColumn = 42);");
+    EXPECT(ambiguous_result.is_error());
+    EXPECT_EQ(ambiguous_result.error().error(), SQL::SQLErrorCode::AmbiguousColumnName);
+}
+
 TEST_CASE(select_with_like)
 {
     ScopeGuard guard([]() { unlink(db_name); });
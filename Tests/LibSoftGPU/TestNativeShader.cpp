@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <LibSoftGPU/PixelQuad.h>
+#include <LibSoftGPU/Sampler.h>
+#include <LibSoftGPU/Shader.h>
+#include <LibSoftGPU/ShaderProcessor.h>
+#include <LibTest/TestCase.h>
+
+using namespace SoftGPU;
+
+static Instruction input(u16 target_register, u8 input_index)
+{
+    Instruction instruction {};
+    instruction.operation = Opcode::Input;
+    instruction.arguments.input = { target_register, input_index };
+    return instruction;
+}
+
+static Instruction output(u16 source_register, u8 output_index)
+{
+    Instruction instruction {};
+    instruction.operation = Opcode::Output;
+    instruction.arguments.output = { source_register, output_index };
+    return instruction;
+}
+
+static Instruction binop(Opcode operation, u16 target_register, u16 source_register1, u16 source_register2)
+{
+    Instruction instruction {};
+    instruction.operation = operation;
+    instruction.arguments.binop = { target_register, source_register1, source_register2 };
+    return instruction;
+}
+
+static Instruction swizzle(u16 target_register, u16 source_register, u8 pattern)
+{
+    Instruction instruction {};
+    instruction.operation = Opcode::Swizzle;
+    instruction.arguments.swizzle = { target_register, source_register, pattern };
+    return instruction;
+}
+
+static Instruction sample_2d(u16 target_register, u16 coordinates_register, u8 sampler_index)
+{
+    Instruction instruction {};
+    instruction.operation = Opcode::Sample2D;
+    instruction.arguments.sample = { target_register, coordinates_register, sampler_index };
+    return instruction;
+}
+
+static PixelQuad make_quad()
+{
+    PixelQuad quad {};
+    for (size_t i = 0; i < quad.inputs.size(); ++i)
+        quad.inputs[i] = AK::SIMD::f32x4 { i + 1.f, i * 0.5f, -2.f * i, 3.f };
+    for (auto& value : quad.outputs)
+        value = AK::SIMD::expand4(0.f);
+    return quad;
+}
+
+TEST_CASE(native_shader_matches_interpreter)
+{
+    Vector<Instruction> instructions {
+        input(0, SHADER_INPUT_VERTEX_COLOR),
+        input(4, SHADER_INPUT_FIRST_TEXCOORD),
+        binop(Opcode::Add, 8, 0, 4),
+        binop(Opcode::Sub, 12, 8, 0),
+        binop(Opcode::Mul, 16, 12, 4),
+        binop(Opcode::Div, 20, 16, 8),
+        swizzle(24, 20, swizzle_pattern(3, 2, 1, 0)),
+        // Swizzling in place has to read all components before writing any.
+        swizzle(24, 24, swizzle_pattern(1, 1, 0, 3)),
+        sample_2d(28, 4, 0),
+        binop(Opcode::Mul, 32, 24, 28),
+        output(32, SHADER_OUTPUT_FIRST_COLOR),
+    };
+
+    auto shader = adopt_ref(*new Shader(nullptr, instructions));
+    if (!shader->native_shader()) {
+        warnln("Native shaders are not supported here, skipping");
+        return;
+    }
+
+    Array<Sampler, GPU::NUM_TEXTURE_UNITS> samplers;
+    ShaderProcessor processor { samplers };
+
+    auto native_quad = make_quad();
+    processor.execute(native_quad, *shader);
+
+    auto interpreted_quad = make_quad();
+    processor.interpret(interpreted_quad, *shader);
+
+    for (size_t i = 0; i < NUM_SHADER_OUTPUTS; ++i) {
+        for (size_t lane = 0; lane < 4; ++lane)
+            EXPECT_EQ(native_quad.outputs[i][lane], interpreted_quad.outputs[i][lane]);
+    }
+    // Unbound samplers return opaque red, so the alpha channel ends up non-zero.
+    EXPECT_NE(native_quad.outputs[3][0], 0.f);
+}
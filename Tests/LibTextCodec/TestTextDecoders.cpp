@@ -58,3 +58,36 @@ TEST_CASE(test_utf16le_decode)
     EXPECT(processed_code_points[2] == 0x6B);
     EXPECT(processed_code_points[3] == 0x1F600);
 }
+
+TEST_CASE(test_utf16_to_utf8)
+{
+    auto& be_decoder = *TextCodec::decoder_for_exact_name("UTF-16BE"sv);
+    auto& le_decoder = *TextCodec::decoder_for_exact_name("UTF-16LE"sv);
+
+    // Long enough for the ASCII runs to be looked at a word at a time, with a surrogate pair in between.
+    EXPECT_EQ(MUST(be_decoder.to_utf8("\x00H\x00\x65\x00l\x00l\x00o\x00,\x00 \x00w\xd8=\xde\x00\x00o\x00r\x00l\x00\x64\x00!"sv)), "Hello, w😀orld!"sv);
+    EXPECT_EQ(MUST(le_decoder.to_utf8("H\x00\x65\x00l\x00l\x00o\x00,\x00 \x00w\x00=\xd8\x00\xdeo\x00r\x00l\x00\x64\x00!\x00"sv)), "Hello, w😀orld!"sv);
+
+    // A high surrogate followed by ASCII, and a trailing odd byte.
+    EXPECT_EQ(MUST(be_decoder.to_utf8("\x00\x61\x00\x62\x00\x63\x00\x64\xd8=\x00\x65\x00\x66\x00\x67\x00\x68\x00"sv)), "abcd�efgh"sv);
+    EXPECT_EQ(MUST(le_decoder.to_utf8("\xff\xfe\x61\x00\xe4\x00"sv)), "aä"sv);
+}
+
+TEST_CASE(test_single_byte_to_utf8)
+{
+    auto& latin1_decoder = *TextCodec::decoder_for_exact_name("ISO-8859-1"sv);
+    EXPECT_EQ(MUST(latin1_decoder.to_utf8("Gr\xfc\xdf dich, sch\xf6ne Welt!"sv)), "Grüß dich, schöne Welt!"sv);
+
+    auto& windows1252_decoder = *TextCodec::decoder_for_exact_name("windows-1252"sv);
+    EXPECT_EQ(MUST(windows1252_decoder.to_utf8("\x93quoted\x94 costs \x80\x35, and it's a long line of ASCII"sv)), "“quoted” costs €5, and it's a long line of ASCII"sv);
+
+    auto& x_user_defined_decoder = *TextCodec::decoder_for_exact_name("x-user-defined"sv);
+    EXPECT_EQ(MUST(x_user_defined_decoder.to_utf8("ab\x80\xff"sv)), "ab\uF780\uF7FF"sv);
+}
+
+TEST_CASE(test_utf8_to_utf8)
+{
+    auto decoder = TextCodec::UTF8Decoder();
+    EXPECT_EQ(MUST(decoder.to_utf8("\xef\xbb\xbfsäk😀"sv)), "säk😀"sv);
+    EXPECT_EQ(MUST(decoder.to_utf8("a\xffz"sv)), "a�z"sv);
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <AK/Atomic.h>
+#include <LibTest/TestCase.h>
+#include <LibThreading/ParallelFor.h>
+#include <LibThreading/ThreadPool.h>
+
+using Pool = Threading::ThreadPool<Function<void()>>;
+
+TEST_CASE(parallel_for_visits_every_index_once)
+{
+    Pool pool { [](Function<void()> work) { work(); }, 4 };
+    Array<Atomic<int>, 1000> visits {};
+
+    Threading::parallel_for(pool, visits.size(), [&](size_t index) { visits[index].fetch_add(1); });
+
+    for (auto& count : visits)
+        EXPECT_EQ(count.load(), 1);
+}
+
+TEST_CASE(parallel_for_from_worker_does_not_deadlock)
+{
+    Pool pool { [](Function<void()> work) { work(); }, 2 };
+    Atomic<size_t> sum { 0 };
+
+    // Every worker is busy with an outer index while the inner loops run, so they have to make progress on their own.
+    Threading::parallel_for(pool, 8, [&](size_t outer) {
+        Threading::parallel_for(pool, 8, [&](size_t inner) { sum.fetch_add(outer * 8 + inner); });
+    });
+
+    EXPECT_EQ(sum.load(), 64u * 63u / 2u);
+}
+
+TEST_CASE(parallel_for_on_default_pool)
+{
+    Atomic<size_t> calls { 0 };
+    Threading::parallel_for(100, [&](size_t) { calls.fetch_add(1); });
+    EXPECT_EQ(calls.load(), 100u);
+    EXPECT(Threading::default_thread_pool().concurrency() > 0);
+}
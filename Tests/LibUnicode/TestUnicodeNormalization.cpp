@@ -93,3 +93,28 @@ TEST_CASE(normalize_nfkc)
     EXPECT_EQ(normalize("\u0958"sv, NormalizationForm::NFKC), "\u0915\u093C"sv);
     EXPECT_EQ(normalize("\u2126"sv, NormalizationForm::NFKC), "\u03A9"sv);
 }
+
+TEST_CASE(is_normalized)
+{
+    EXPECT(is_normalized(""sv, NormalizationForm::NFC));
+    EXPECT(is_normalized("Hello, friends!"sv, NormalizationForm::NFD));
+    EXPECT(is_normalized("Hello, friends!"sv, NormalizationForm::NFKC));
+
+    EXPECT(is_normalized("Am\u00E9lie"sv, NormalizationForm::NFC));
+    EXPECT(!is_normalized("Am\u00E9lie"sv, NormalizationForm::NFD));
+    EXPECT(is_normalized("Ame\u0301lie"sv, NormalizationForm::NFD));
+    EXPECT(!is_normalized("Ame\u0301lie"sv, NormalizationForm::NFC));
+
+    EXPECT(is_normalized("\uB2ED"sv, NormalizationForm::NFC));
+    EXPECT(!is_normalized("\u1103\u1161\u11B0"sv, NormalizationForm::NFC));
+
+    // Combining marks out of canonical order.
+    EXPECT(!is_normalized("\u0044\u0307\u0323"sv, NormalizationForm::NFD));
+    EXPECT(is_normalized("\u0044\u0323\u0307"sv, NormalizationForm::NFD));
+
+    EXPECT(is_normalized("O\uFB00ice"sv, NormalizationForm::NFC));
+    EXPECT(!is_normalized("O\uFB00ice"sv, NormalizationForm::NFKC));
+
+    auto string = "Already normalized"_string;
+    EXPECT_EQ(normalize(string, NormalizationForm::NFC), string);
+}
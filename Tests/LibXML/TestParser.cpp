@@ -41,3 +41,28 @@ TEST_CASE(predefined_character_reference)
     auto const& content = node.children[0]->content.get<XML::Node::Text>();
     EXPECT_EQ(content.builder.string_view(), "Well hello &, <, >, ', and \"!");
 }
+
+TEST_CASE(listener_events)
+{
+    struct EventRecorder : public XML::Listener {
+        virtual void element_start(XML::Name const& name, HashMap<XML::Name, ByteString> const& attributes) override
+        {
+            events.append(ByteString::formatted("<{} {}>", name, attributes.get("id"sv).value_or({})));
+        }
+        virtual void element_end(XML::Name const& name) override { events.append(ByteString::formatted("</{}>", name)); }
+        virtual void text(StringView text) override
+        {
+            if (!text.is_empty())
+                events.append(text);
+        }
+
+        Vector<ByteString> events;
+    };
+
+    XML::Parser parser("<list><item id=\"1\">one</item><item id=\"2\"/><item id=\"3\">three</item></list>"sv);
+    EventRecorder recorder;
+    MUST(parser.parse_with_listener(recorder));
+
+    Vector<ByteString> expected_events { "<list >", "<item 1>", "one", "</item>", "<item 2>", "</item>", "<item 3>", "three", "</item>", "</list>" };
+    EXPECT_EQ(recorder.events, expected_events);
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/StringBuilder.h>
+#include <AK/StringView.h>
+#include <LibCore/Command.h>
+#include <LibCore/File.h>
+#include <LibCore/System.h>
+#include <LibFileSystem/FileSystem.h>
+#include <LibTest/Macros.h>
+#include <LibTest/TestCase.h>
+
+static constexpr StringView s_test_dir = "/tmp/grep-test"sv;
+
+class GrepSetup {
+public:
+    GrepSetup()
+    {
+        clean_up(); // Just in case something was left behind from beforehand.
+        MUST(Core::System::mkdir(s_test_dir, 0755));
+    }
+
+    ~GrepSetup()
+    {
+        clean_up();
+    }
+
+private:
+    static void clean_up()
+    {
+        auto result = FileSystem::remove(s_test_dir, FileSystem::RecursionMode::Allowed);
+        if (result.is_error())
+            VERIFY(result.error().is_errno() && result.error().code() == ENOENT);
+    }
+};
+
+enum class ExpectMatch {
+    Yes,
+    No,
+};
+
+static ByteString write_test_file(StringView name, StringView contents)
+{
+    auto path = ByteString::formatted("{}/{}", s_test_dir, name);
+    auto file = MUST(Core::File::open(path, Core::File::OpenMode::Write));
+    MUST(file->write_until_depleted(contents.bytes()));
+    return path;
+}
+
+static void run_grep(ExpectMatch match, Vector<char const*>&& arguments, StringView expected_stdout)
+{
+    MUST(arguments.try_insert(0, "grep"));
+    MUST(arguments.try_append(nullptr));
+    auto grep = MUST(Core::Command::create("grep"sv, arguments.data()));
+    auto [stdout, stderr] = MUST(grep->read_all());
+    auto status = MUST(grep->status());
+
+    StringView stdout_view { stdout.bytes() };
+    StringView stderr_view { stderr.bytes() };
+
+    if (match == ExpectMatch::Yes && status != Core::Command::ProcessResult::DoneWithZeroExitCode) {
+        FAIL(ByteString::formatted("grep didn't report a match: status: {}, stdout: {}, stderr: {}", static_cast<int>(status), stdout_view, stderr_view));
+    } else if (match == ExpectMatch::No && status != Core::Command::ProcessResult::Failed) {
+        FAIL(ByteString::formatted("grep didn't report no match: status: {}, stdout: {}, stderr: {}", static_cast<int>(status), stdout_view, stderr_view));
+    }
+    EXPECT_EQ(stdout_view, expected_stdout);
+}
+
+TEST_CASE(null_byte_near_the_start_makes_the_whole_file_binary)
+{
+    GrepSetup setup;
+    auto path = write_test_file("binary"sv, "\0\nhello\n"sv);
+
+    // The matching line has no null byte itself, but the file is still binary.
+    run_grep(ExpectMatch::Yes, { "hello", path.characters() }, ByteString::formatted("binary file {} matches\n", path));
+    run_grep(ExpectMatch::Yes, { "-a", "hello", path.characters() }, "hello\n"sv);
+    run_grep(ExpectMatch::No, { "-I", "hello", path.characters() }, ""sv);
+}
+
+TEST_CASE(null_byte_after_the_first_32_kib_only_makes_its_line_binary)
+{
+    GrepSetup setup;
+    StringBuilder builder;
+    builder.append("hello\n"sv);
+    for (size_t i = 0; i < 40 * KiB / 8; ++i)
+        builder.append("padding\n"sv);
+    builder.append("hello\0\n"sv);
+    auto path = write_test_file("late-binary"sv, builder.string_view());
+
+    run_grep(ExpectMatch::Yes, { "hello", path.characters() }, ByteString::formatted("hello\nbinary file {} matches\n", path));
+    run_grep(ExpectMatch::Yes, { "-I", "hello", path.characters() }, "hello\n"sv);
+}
+
+TEST_CASE(empty_file)
+{
+    GrepSetup setup;
+    auto path = write_test_file("empty"sv, ""sv);
+
+    run_grep(ExpectMatch::No, { "hello", path.characters() }, ""sv);
+}
+
+TEST_CASE(generated_file_that_claims_to_be_empty)
+{
+    // SysFS files are regular files with a size of zero, and are only generated when read.
+    run_grep(ExpectMatch::Yes, { "-q", "[0-9]", "/sys/kernel/uptime" }, ""sv);
+}
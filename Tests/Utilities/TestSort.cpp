@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/StringBuilder.h>
+#include <AK/StringView.h>
+#include <LibCore/Command.h>
+#include <LibTest/Macros.h>
+#include <LibTest/TestCase.h>
+
+static void run_sort(Vector<char const*>&& arguments, StringView standard_input, StringView expected_stdout)
+{
+    MUST(arguments.try_insert(0, "sort"));
+    MUST(arguments.try_append(nullptr));
+    auto sort = MUST(Core::Command::create("sort"sv, arguments.data()));
+    MUST(sort->write(standard_input));
+    auto [stdout, stderr] = MUST(sort->read_all());
+    auto status = MUST(sort->status());
+    if (status != Core::Command::ProcessResult::DoneWithZeroExitCode) {
+        FAIL(ByteString::formatted("sort didn't exit cleanly: status: {}, stdout: {}, stderr: {}", static_cast<int>(status), StringView { stdout.bytes() }, StringView { stderr.bytes() }));
+    }
+    EXPECT_EQ(StringView { expected_stdout.bytes() }, StringView { stdout.bytes() });
+}
+
+TEST_CASE(sort_lines)
+{
+    run_sort({}, "b 3\na 10\nc 2\na 1\n"sv, "a 1\na 10\nb 3\nc 2\n"sv);
+    run_sort({ "-r" }, "b 3\na 10\nc 2\na 1\n"sv, "c 2\nb 3\na 10\na 1\n"sv);
+}
+
+TEST_CASE(sort_by_key)
+{
+    run_sort({ "-n", "-k", "2" }, "b 3\na 10\nc 2\na 1\n"sv, "a 1\nc 2\nb 3\na 10\n"sv);
+    run_sort({ "-k", "2n" }, "b 3\na 10\nc 2\na 1\n"sv, "a 1\nc 2\nb 3\na 10\n"sv);
+    run_sort({ "-t", ":", "-k", "2,2" }, "x:1:b\ny::a\nz:3:c\n"sv, "y::a\nx:1:b\nz:3:c\n"sv);
+    run_sort({ "-k", "1.2,1.2" }, "bz\nay\ncx\n"sv, "cx\nay\nbz\n"sv);
+}
+
+TEST_CASE(unique_keeps_first_of_equal_keys)
+{
+    run_sort({ "-u", "-k", "1,1" }, "b 1\na 2\nb 3\na 4\n"sv, "a 2\nb 1\n"sv);
+}
+
+TEST_CASE(sort_with_temporary_files)
+{
+    // A permutation of the numbers, large enough to not fit into the buffer at once.
+    StringBuilder input;
+    StringBuilder expected_output;
+    for (size_t i = 0; i < 10000; ++i)
+        input.appendff("{:05}\n", (i * 7919) % 10000);
+    for (size_t i = 0; i < 10000; ++i)
+        expected_output.appendff("{:05}\n", i);
+
+    run_sort({ "-S", "16K", "--parallel", "2" }, input.string_view(), expected_output.string_view());
+    run_sort({ "-u", "-S", "4K" }, "b\na\nb\na\nc\n"sv, "a\nb\nc\n"sv);
+}
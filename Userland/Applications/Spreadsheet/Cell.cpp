@@ -31,6 +31,7 @@ void Cell::set_data(ByteString new_data)
     }
 
     m_data = move(new_data);
+    m_parsed_formula = {};
     m_dirty = true;
     m_evaluated_externally = false;
 }
@@ -44,6 +45,7 @@ void Cell::set_data(JS::Value new_data)
 
     builder.append(new_data.to_string_without_side_effects());
     m_data = builder.to_byte_string();
+    m_parsed_formula = {};
 
     m_evaluated_data = move(new_data);
 }
@@ -106,7 +108,9 @@ void Cell::update_data(Badge<Sheet>)
         m_dirty = false;
         if (m_kind == Formula) {
             if (!m_evaluated_externally) {
-                auto value_or_error = m_sheet->evaluate(m_data, this);
+                // Whatever the formula reads this time around gets recorded again while it's being evaluated.
+                clear_referenced_cells();
+                auto value_or_error = evaluate_formula();
                 if (value_or_error.is_error()) {
                     m_evaluated_data = JS::js_undefined();
                     m_thrown_value = *value_or_error.release_error().release_value();
@@ -117,11 +121,22 @@ void Cell::update_data(Badge<Sheet>)
             }
         }
 
-        for (auto& ref : m_referencing_cells) {
-            if (ref) {
-                ref->m_dirty = true;
+        // Mark everything that depends on this cell as dirty before updating any of it; cells that are read while dirty
+        // get evaluated on demand, so a cell that depends on this one through several paths only sees up-to-date
+        // values, and only gets evaluated once.
+        // NOTE: Sheet::update() has usually done this already, but evaluating a formula can also change other cells.
+        HashTable<Cell*> seen;
+        mark_referencing_cells_dirty(seen);
+
+        // Grab a copy, as evaluating a formula may change which cells reference this one.
+        Vector<WeakPtr<Cell>> referencing_cells;
+        referencing_cells.ensure_capacity(m_referencing_cells.size());
+        for (auto& it : m_referencing_cells)
+            referencing_cells.unchecked_append(it.value);
+
+        for (auto& ref : referencing_cells) {
+            if (ref)
                 ref->update();
-            }
         }
     }
 
@@ -172,16 +187,48 @@ ByteString Cell::source() const
     return builder.to_byte_string();
 }
 
+JS::ThrowCompletionOr<JS::Value> Cell::evaluate_formula()
+{
+    // Formulas get re-evaluated every time a cell they read changes, so only parse them once.
+    if (m_parsed_formula.is_null())
+        m_parsed_formula = JS::make_handle(TRY(m_sheet->parse(m_data, this)));
+    return m_sheet->evaluate(*m_parsed_formula, this);
+}
+
 // FIXME: Find a better way to figure out dependencies
 void Cell::reference_from(Cell* other)
 {
     if (!other || other == this)
         return;
 
-    if (!m_referencing_cells.find_if([other](auto const& ptr) { return ptr.ptr() == other; }).is_end())
-        return;
+    m_referencing_cells.set(other, other->make_weak_ptr());
+    other->m_referenced_cells.set(this, make_weak_ptr());
+}
 
-    m_referencing_cells.append(other->make_weak_ptr());
+void Cell::clear_referenced_cells()
+{
+    for (auto& it : m_referenced_cells) {
+        if (it.value)
+            it.value->m_referencing_cells.remove(this);
+    }
+    m_referenced_cells.clear();
+}
+
+void Cell::mark_referencing_cells_dirty(HashTable<Cell*>& seen)
+{
+    // NOTE: Long chains of references are common, so don't recurse here.
+    Vector<Cell*> cells_to_visit { this };
+    while (!cells_to_visit.is_empty()) {
+        auto* current = cells_to_visit.take_last();
+        for (auto& it : current->m_referencing_cells) {
+            auto& cell = it.value;
+            // Cells that were already updated are either part of a reference cycle, or got marked dirty up front.
+            if (!cell || m_sheet->has_been_visited(cell.ptr()) || seen.set(cell.ptr()) != HashSetResult::InsertedNewEntry)
+                continue;
+            cell->m_dirty = true;
+            cells_to_visit.append(cell.ptr());
+        }
+    }
 }
 
 void Cell::copy_from(Cell const& other)
@@ -189,6 +236,7 @@ void Cell::copy_from(Cell const& other)
     m_dirty = true;
     m_evaluated_externally = other.m_evaluated_externally;
     m_data = other.m_data;
+    m_parsed_formula = {};
     m_evaluated_data = other.m_evaluated_data;
     m_kind = other.m_kind;
     m_type = other.m_type;
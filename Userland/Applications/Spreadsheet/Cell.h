@@ -12,9 +12,11 @@
 #include "JSIntegration.h"
 #include "Position.h"
 #include <AK/ByteString.h>
+#include <AK/HashMap.h>
 #include <AK/Types.h>
 #include <AK/WeakPtr.h>
 #include <LibGUI/Command.h>
+#include <LibJS/Heap/Handle.h>
 
 namespace Spreadsheet {
 
@@ -70,7 +72,7 @@ struct Cell : public Weakable<Cell> {
     ByteString const& data() const { return m_data; }
     const JS::Value& evaluated_data() const { return m_evaluated_data; }
     Kind kind() const { return m_kind; }
-    Vector<WeakPtr<Cell>> const& referencing_cells() const { return m_referencing_cells; }
+    HashMap<Cell*, WeakPtr<Cell>> const& referencing_cells() const { return m_referencing_cells; }
 
     void set_type(StringView name);
     void set_type(CellType const*);
@@ -109,12 +111,18 @@ struct Cell : public Weakable<Cell> {
     void update();
     void update_data(Badge<Sheet>);
 
+    // Marks every cell that (transitively) depends on this one as dirty, except for those already updated.
+    void mark_referencing_cells_dirty(HashTable<Cell*>& seen);
+
     Sheet const& sheet() const { return *m_sheet; }
     Sheet& sheet() { return *m_sheet; }
 
     void copy_from(Cell const&);
 
 private:
+    JS::ThrowCompletionOr<JS::Value> evaluate_formula();
+    void clear_referenced_cells();
+
     bool m_dirty { false };
     bool m_evaluated_externally { false };
     ByteString m_data;
@@ -122,7 +130,11 @@ private:
     JS::Value m_thrown_value;
     Kind m_kind { LiteralString };
     WeakPtr<Sheet> m_sheet;
-    Vector<WeakPtr<Cell>> m_referencing_cells;
+    // Cells whose formulas read this cell, and the cells this cell's formula read the last time it was evaluated.
+    // These are keyed by address so the edges can be dropped quickly when a formula is re-evaluated.
+    HashMap<Cell*, WeakPtr<Cell>> m_referencing_cells;
+    HashMap<Cell*, WeakPtr<Cell>> m_referenced_cells;
+    JS::Handle<JS::Script> m_parsed_formula;
     CellType const* m_type { nullptr };
     CellTypeMetadata m_type_metadata;
     Position m_position;
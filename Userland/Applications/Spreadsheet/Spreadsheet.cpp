@@ -133,6 +133,12 @@ void Sheet::update()
         }
     }
 
+    // Find everything that's affected by the changes before evaluating anything, so that no formula gets to read
+    // a cell that's only going to be updated later on.
+    HashTable<Cell*> seen;
+    for (auto& cell : cells_copy)
+        cell.mark_referencing_cells_dirty(seen);
+
     for (auto& cell : cells_copy)
         update(cell);
 
@@ -158,8 +164,19 @@ void Sheet::update(Cell& cell)
 }
 
 JS::ThrowCompletionOr<JS::Value> Sheet::evaluate(StringView source, Cell* on_behalf_of)
+{
+    auto script = TRY(parse(source, on_behalf_of));
+    return evaluate(*script, on_behalf_of);
+}
+
+JS::ThrowCompletionOr<JS::Value> Sheet::evaluate(JS::Script& script, Cell* on_behalf_of)
 {
     TemporaryChange cell_change { m_current_cell_being_evaluated, on_behalf_of };
+    return vm().bytecode_interpreter().run(script);
+}
+
+JS::ThrowCompletionOr<JS::NonnullGCPtr<JS::Script>> Sheet::parse(StringView source, Cell* on_behalf_of)
+{
     auto name = on_behalf_of ? on_behalf_of->name_for_javascript(*this) : "cell <unknown>"sv;
     auto script_or_error = JS::Script::parse(
         source,
@@ -169,7 +186,7 @@ JS::ThrowCompletionOr<JS::Value> Sheet::evaluate(StringView source, Cell* on_beh
     if (script_or_error.is_error())
         return vm().throw_completion<JS::SyntaxError>(script_or_error.error().first().to_string());
 
-    return vm().bytecode_interpreter().run(script_or_error.value());
+    return script_or_error.release_value();
 }
 
 Cell* Sheet::at(StringView name)
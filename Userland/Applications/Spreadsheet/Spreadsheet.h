@@ -126,6 +126,8 @@ public:
     }
 
     JS::ThrowCompletionOr<JS::Value> evaluate(StringView, Cell* = nullptr);
+    JS::ThrowCompletionOr<JS::Value> evaluate(JS::Script&, Cell* = nullptr);
+    JS::ThrowCompletionOr<JS::NonnullGCPtr<JS::Script>> parse(StringView, Cell* = nullptr);
     SheetGlobalObject& global_object() const { return *m_global_object; }
 
     Cell*& current_evaluated_cell() { return m_current_cell_being_evaluated; }
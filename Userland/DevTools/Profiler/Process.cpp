@@ -77,6 +77,8 @@ void LibraryMetadata::handle_mmap(FlatPtr base, size_t size, ByteString const& n
     else
         path = name.substring_view(0, name.view().find(':').value());
 
+    m_symbol_cache.clear();
+
     // Each loaded object has at least 4 segments associated with it: .rodata, .text, .relro, .data.
     // We only want to create a single LibraryMetadata object for each library, so we need to update the
     // associated base address and size as new regions are discovered.
@@ -134,4 +136,18 @@ LibraryMetadata::Library const* LibraryMetadata::library_containing(FlatPtr ptr)
     return nullptr;
 }
 
+LibraryMetadata::Symbol const& LibraryMetadata::symbolicate(FlatPtr ptr) const
+{
+    return m_symbol_cache.ensure(ptr, [&] {
+        Symbol symbol;
+        if (auto const* library = library_containing(ptr)) {
+            symbol.library = library;
+            symbol.name = library->symbolicate(ptr, &symbol.offset);
+        } else {
+            symbol.name = ByteString::formatted("?? <{:p}>", ptr);
+        }
+        return symbol;
+    });
+}
+
 }
@@ -37,11 +37,22 @@ public:
         Debug::DebugInfo const& load_debug_info(FlatPtr base_address) const;
     };
 
+    struct Symbol {
+        Library const* library { nullptr };
+        ByteString name;
+        u32 offset { 0 };
+    };
+
     void handle_mmap(FlatPtr base, size_t size, ByteString const& name);
     Library const* library_containing(FlatPtr) const;
 
+    // Looks up the library containing the address and symbolicates it there. The result is remembered until the next mmap.
+    // NOTE: The returned reference is only valid until the next call.
+    Symbol const& symbolicate(FlatPtr) const;
+
 private:
     mutable HashMap<ByteString, NonnullOwnPtr<Library>> m_libraries;
+    mutable HashMap<FlatPtr, Symbol> m_symbol_cache;
 };
 
 struct Thread {
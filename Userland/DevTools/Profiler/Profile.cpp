@@ -11,6 +11,7 @@
 #include "SamplesModel.h"
 #include "SourceModel.h"
 #include <AK/HashTable.h>
+#include <AK/JsonStreamReader.h>
 #include <AK/LexicalPath.h>
 #include <AK/QuickSort.h>
 #include <AK/RefPtr.h>
@@ -265,15 +266,36 @@ void Profile::rebuild_tree()
 Optional<MappedObject> g_kernel_debuginfo_object;
 OwnPtr<Debug::DebugInfo> g_kernel_debug_info;
 
-ErrorOr<NonnullOwnPtr<Profile>> Profile::load_from_perfcore_file(StringView path)
+static ErrorOr<HashMap<FlatPtr, ByteString>> read_profile_strings(StringView contents)
 {
-    auto file = TRY(Core::File::open(path, Core::File::OpenMode::Read));
+    // NOTE: The kernel writes the strings before the events, so this usually doesn't have to look any further than that.
+    JsonStreamReader reader { contents };
+    TRY(reader.enter_object());
+    for (;;) {
+        auto key = TRY(reader.next_key());
+        if (!key.has_value())
+            return Error::from_string_literal("Malformed profile (strings is not an array)");
+        if (*key != "strings"sv) {
+            TRY(reader.skip_value());
+            continue;
+        }
 
-    auto json = JsonValue::from_string(TRY(file->read_until_eof()));
-    if (json.is_error() || !json.value().is_object())
-        return Error::from_string_literal("Invalid perfcore format (not a JSON object)");
+        HashMap<FlatPtr, ByteString> profile_strings;
+        FlatPtr string_id = 0;
+        TRY(reader.for_each_element([&]() -> ErrorOr<void> {
+            profile_strings.set(string_id++, TRY(reader.read_string()));
+            return {};
+        }));
+        return profile_strings;
+    }
+}
 
-    auto const& object = json.value().as_object();
+ErrorOr<NonnullOwnPtr<Profile>> Profile::load_from_perfcore_file(StringView path)
+{
+    // NOTE: Profiles of busy systems get very large, so we map the file and parse one event at a time
+    //       instead of building a JsonValue for the whole thing first.
+    auto file = TRY(Core::MappedFile::map(path));
+    StringView contents { file->bytes() };
 
     if (!g_kernel_debuginfo_object.has_value()) {
         auto debuginfo_file_or_error = Core::MappedFile::map("/boot/Kernel.debug"sv);
@@ -284,30 +306,18 @@ ErrorOr<NonnullOwnPtr<Profile>> Profile::load_from_perfcore_file(StringView path
         }
     }
 
-    auto strings_value = object.get_array("strings"sv);
-    if (!strings_value.has_value())
-        return Error::from_string_literal("Malformed profile (strings is not an array)");
-    auto const& strings = strings_value.value();
-
-    HashMap<FlatPtr, ByteString> profile_strings;
-    for (FlatPtr string_id = 0; string_id < strings.size(); ++string_id) {
-        auto const& value = strings.at(string_id);
-        profile_strings.set(string_id, value.as_string());
-    }
-
-    auto events_value = object.get_array("events"sv);
-    if (!events_value.has_value())
-        return Error::from_string_literal("Malformed profile (events is not an array)");
-    auto const& perf_events = events_value.value();
+    auto profile_strings = TRY(read_profile_strings(contents));
 
     Vector<NonnullOwnPtr<Process>> all_processes;
     HashMap<pid_t, Process*> current_processes;
     Vector<Event> events;
     EventSerialNumber next_serial;
 
-    for (auto const& perf_event_value : perf_events.values()) {
-        auto const& perf_event = perf_event_value.as_object();
+    auto maybe_kernel_base = Symbolication::kernel_base();
+    // The same addresses show up in stack after stack, so only look each of them up once.
+    HashMap<FlatPtr, LibraryMetadata::Symbol> kernel_symbol_cache;
 
+    auto handle_event = [&](JsonObject const& perf_event) -> ErrorOr<void> {
         Event event;
 
         event.serial = next_serial;
@@ -321,6 +331,14 @@ ErrorOr<NonnullOwnPtr<Profile>> Profile::load_from_perfcore_file(StringView path
 
         if (type_string == "sample"sv) {
             event.data = Event::SampleData {};
+        } else if (type_string == "cycles"sv) {
+            event.data = Event::SampleData { .source = Event::SampleData::Source::Cycles };
+        } else if (type_string == "instructions"sv) {
+            event.data = Event::SampleData { .source = Event::SampleData::Source::Instructions };
+        } else if (type_string == "cache_miss"sv) {
+            event.data = Event::SampleData { .source = Event::SampleData::Source::CacheMisses };
+        } else if (type_string == "branch_miss"sv) {
+            event.data = Event::SampleData { .source = Event::SampleData::Source::BranchMisses };
         } else if (type_string == "kmalloc"sv) {
             event.data = Event::MallocData {
                 .ptr = perf_event.get_addr("ptr"sv).value_or(0),
@@ -350,13 +368,13 @@ ErrorOr<NonnullOwnPtr<Profile>> Profile::load_from_perfcore_file(StringView path
             auto it = current_processes.find(event.pid);
             if (it != current_processes.end())
                 it->value->library_metadata.handle_mmap(ptr, size, name);
-            continue;
+            return {};
         } else if (type_string == "munmap"sv) {
             event.data = Event::MunmapData {
                 .ptr = perf_event.get_addr("ptr"sv).value_or(0),
                 .size = perf_event.get_integer<size_t>("size"sv).value_or(0),
             };
-            continue;
+            return {};
         } else if (type_string == "process_create"sv) {
             auto parent_pid = perf_event.get_integer<pid_t>("parent_pid"sv).value_or(0);
             auto executable = perf_event.get_byte_string("executable"sv).value_or({});
@@ -375,7 +393,7 @@ ErrorOr<NonnullOwnPtr<Profile>> Profile::load_from_perfcore_file(StringView path
 
             current_processes.set(sampled_process->pid, sampled_process);
             all_processes.append(move(sampled_process));
-            continue;
+            return {};
         } else if (type_string == "process_exec"sv) {
             auto executable = perf_event.get_byte_string("executable"sv).value_or({});
             event.data = Event::ProcessExecData {
@@ -397,13 +415,13 @@ ErrorOr<NonnullOwnPtr<Profile>> Profile::load_from_perfcore_file(StringView path
 
             current_processes.set(sampled_process->pid, sampled_process);
             all_processes.append(move(sampled_process));
-            continue;
+            return {};
         } else if (type_string == "process_exit"sv) {
             auto* old_process = current_processes.get(event.pid).value();
             old_process->end_valid = event.serial;
 
             current_processes.remove(event.pid);
-            continue;
+            return {};
         } else if (type_string == "thread_create"sv) {
             auto parent_tid = perf_event.get_integer<pid_t>("parent_tid"sv).value_or(0);
             event.data = Event::ThreadCreateData {
@@ -412,12 +430,12 @@ ErrorOr<NonnullOwnPtr<Profile>> Profile::load_from_perfcore_file(StringView path
             auto it = current_processes.find(event.pid);
             if (it != current_processes.end())
                 it->value->handle_thread_create(event.tid, event.serial);
-            continue;
+            return {};
         } else if (type_string == "thread_exit"sv) {
             auto it = current_processes.find(event.pid);
             if (it != current_processes.end())
                 it->value->handle_thread_exit(event.tid, event.serial);
-            continue;
+            return {};
         } else if (type_string == "filesystem"sv) {
             Event::FilesystemEventData fsdata {
                 .duration = Duration::from_nanoseconds(perf_event.get_integer<u64>("durationNs"sv).value_or(0)),
@@ -472,11 +490,15 @@ ErrorOr<NonnullOwnPtr<Profile>> Profile::load_from_perfcore_file(StringView path
             VERIFY_NOT_REACHED();
         }
 
-        auto maybe_kernel_base = Symbolication::kernel_base();
-
         auto stack = perf_event.get_array("stack"sv);
         VERIFY(stack.has_value());
         auto const& stack_array = stack.value();
+
+        LibraryMetadata const* library_metadata = nullptr;
+        if (auto it = current_processes.find(event.pid); it != current_processes.end())
+            library_metadata = &it->value->library_metadata;
+
+        event.frames.ensure_capacity(stack_array.size());
         for (ssize_t i = stack_array.values().size() - 1; i >= 0; --i) {
             auto const& frame = stack_array.at(i);
             auto ptr = frame.as_integer<u64>();
@@ -486,35 +508,55 @@ ErrorOr<NonnullOwnPtr<Profile>> Profile::load_from_perfcore_file(StringView path
 
             if (maybe_kernel_base.has_value() && ptr >= maybe_kernel_base.value()) {
                 if (g_kernel_debuginfo_object.has_value()) {
-                    symbol = g_kernel_debuginfo_object->elf.symbolicate(ptr - maybe_kernel_base.value(), &offset);
+                    auto& kernel_symbol = kernel_symbol_cache.ensure(ptr, [&] {
+                        u32 kernel_offset = 0;
+                        auto name = g_kernel_debuginfo_object->elf.symbolicate(ptr - maybe_kernel_base.value(), &kernel_offset);
+                        return LibraryMetadata::Symbol { nullptr, move(name), kernel_offset };
+                    });
+                    symbol = kernel_symbol.name;
+                    offset = kernel_symbol.offset;
                 } else {
                     symbol = ByteString::formatted("?? <{:p}>", ptr);
                 }
+            } else if (library_metadata) {
+                auto const& library_symbol = library_metadata->symbolicate(ptr);
+                if (library_symbol.library)
+                    object_name = library_symbol.library->name;
+                symbol = library_symbol.name;
+                offset = library_symbol.offset;
             } else {
-                auto it = current_processes.find(event.pid);
-                // FIXME: This logic is kinda gnarly, find a way to clean it up.
-                LibraryMetadata* library_metadata {};
-                if (it != current_processes.end())
-                    library_metadata = &it->value->library_metadata;
-                if (auto const* library = library_metadata ? library_metadata->library_containing(ptr) : nullptr) {
-                    object_name = library->name;
-                    symbol = library->symbolicate(ptr, &offset);
-                } else {
-                    symbol = ByteString::formatted("?? <{:p}>", ptr);
-                }
+                symbol = ByteString::formatted("?? <{:p}>", ptr);
             }
 
             event.frames.append({ object_name, symbol, (FlatPtr)ptr, offset });
         }
 
         if (event.frames.size() < 2)
-            continue;
+            return {};
 
         FlatPtr innermost_frame_address = event.frames.at(1).address;
         event.in_kernel = maybe_kernel_base.has_value() && innermost_frame_address >= maybe_kernel_base.value();
 
         events.append(move(event));
-    }
+        return {};
+    };
+
+    bool has_events = false;
+    JsonStreamReader reader { contents };
+    TRY(reader.for_each_member([&](StringView key) -> ErrorOr<void> {
+        if (key != "events"sv)
+            return reader.skip_value();
+        has_events = true;
+        return reader.for_each_element([&]() -> ErrorOr<void> {
+            auto perf_event = TRY(reader.read_value());
+            if (!perf_event.is_object())
+                return Error::from_string_literal("Malformed profile (event is not an object)");
+            return handle_event(perf_event.as_object());
+        });
+    }));
+    TRY(reader.finish());
+    if (!has_events)
+        return Error::from_string_literal("Malformed profile (events is not an array)");
 
     if (events.is_empty())
         return Error::from_string_literal("No events captured (targeted process was never on CPU)");
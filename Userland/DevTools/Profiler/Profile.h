@@ -184,6 +184,15 @@ public:
         Vector<Frame> frames;
 
         struct SampleData {
+            // What made us take the sample, either the profiling timer or a hardware performance counter.
+            enum class Source {
+                Timer,
+                Cycles,
+                Instructions,
+                CacheMisses,
+                BranchMisses,
+            };
+            Source source { Source::Timer };
         };
 
         struct MallocData {
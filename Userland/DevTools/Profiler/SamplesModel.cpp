@@ -44,6 +44,8 @@ ErrorOr<String> SamplesModel::column_name(int column) const
         return "Executable"_string;
     case Column::LostSamples:
         return "Lost Samples"_string;
+    case Column::Source:
+        return "Source"_string;
     case Column::InnermostStackFrame:
         return "Innermost Frame"_string;
     case Column::Path:
@@ -86,6 +88,25 @@ GUI::Variant SamplesModel::data(GUI::ModelIndex const& index, GUI::ModelRole rol
             return event.lost_samples;
         }
 
+        if (index.column() == Column::Source) {
+            auto const* sample = event.data.get_pointer<Profile::Event::SampleData>();
+            if (!sample)
+                return "";
+            switch (sample->source) {
+            case Profile::Event::SampleData::Source::Timer:
+                return "Timer";
+            case Profile::Event::SampleData::Source::Cycles:
+                return "Cycles";
+            case Profile::Event::SampleData::Source::Instructions:
+                return "Instructions";
+            case Profile::Event::SampleData::Source::CacheMisses:
+                return "Cache misses";
+            case Profile::Event::SampleData::Source::BranchMisses:
+                return "Branch misses";
+            }
+            VERIFY_NOT_REACHED();
+        }
+
         if (index.column() == Column::InnermostStackFrame) {
             return event.frames.last().symbol;
         }
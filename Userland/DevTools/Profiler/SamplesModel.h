@@ -27,6 +27,7 @@ public:
         ThreadID,
         ExecutableName,
         LostSamples,
+        Source,
         InnermostStackFrame,
         Path,
         __Count
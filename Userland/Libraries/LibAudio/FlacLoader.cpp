@@ -762,6 +762,31 @@ ErrorOr<Vector<i64>, LoaderError> FlacLoaderPlugin::decode_verbatim(FlacSubframe
     return decoded;
 }
 
+// Restores LPC-predicted samples with plain 64-bit arithmetic, as long as that is guaranteed not to overflow.
+// Coefficients have at most 15 bits and there are at most 32 of them, so the prediction sum of samples below 2^40 stays below 2^60.
+// Warm-up samples and residuals are at most 33 bits wide, so only a malformed stream can produce a sample outside these bounds;
+// restoration stops right after such a sample and returns the index of the first sample that still needs to be predicted.
+// An Order of 0 means that the predictor order is only known at runtime.
+template<size_t Order>
+static size_t restore_lpc_without_overflow(Span<i64> decoded, ReadonlySpan<i64> coefficients, u8 shift)
+{
+    constexpr i64 max_safe_sample_magnitude = 1ll << 40;
+    size_t const order = Order == 0 ? coefficients.size() : Order;
+    VERIFY(coefficients.size() == order && order <= 32);
+
+    i64 const* coefficient_data = coefficients.data();
+    i64* samples = decoded.data();
+    for (size_t i = order; i < decoded.size(); ++i) {
+        i64 prediction = 0;
+        for (size_t t = 0; t < order; ++t)
+            prediction += coefficient_data[t] * samples[i - t - 1];
+        samples[i] += prediction >> shift;
+        if (samples[i] >= max_safe_sample_magnitude || samples[i] <= -max_safe_sample_magnitude)
+            return i + 1;
+    }
+    return decoded.size();
+}
+
 // 11.28. SUBFRAME_LPC
 // Decode a subframe encoded with a custom linear predictor coding, i.e. the subframe provides the polynomial order and coefficients
 ErrorOr<void, LoaderError> FlacLoaderPlugin::decode_custom_lpc(Vector<i64>& decoded, FlacSubframeHeader& subframe, BigEndianInputBitStream& bit_input)
@@ -809,7 +834,47 @@ ErrorOr<void, LoaderError> FlacLoaderPlugin::decode_custom_lpc(Vector<i64>& deco
     TRY(decode_residual(decoded, subframe, bit_input));
 
     // approximate the waveform with the predictor
-    for (size_t i = subframe.order; i < m_current_frame->sample_count; ++i) {
+    size_t first_unrestored_sample = subframe.order;
+    if (lpc_shift >= 0) {
+        // Order-specialized predictors for the orders commonly chosen by encoders, so that the inner loop is fully unrolled.
+        auto decoded_span = decoded.span();
+        auto coefficients_span = coefficients.span();
+        switch (subframe.order) {
+        case 1:
+            first_unrestored_sample = restore_lpc_without_overflow<1>(decoded_span, coefficients_span, lpc_shift);
+            break;
+        case 2:
+            first_unrestored_sample = restore_lpc_without_overflow<2>(decoded_span, coefficients_span, lpc_shift);
+            break;
+        case 3:
+            first_unrestored_sample = restore_lpc_without_overflow<3>(decoded_span, coefficients_span, lpc_shift);
+            break;
+        case 4:
+            first_unrestored_sample = restore_lpc_without_overflow<4>(decoded_span, coefficients_span, lpc_shift);
+            break;
+        case 5:
+            first_unrestored_sample = restore_lpc_without_overflow<5>(decoded_span, coefficients_span, lpc_shift);
+            break;
+        case 6:
+            first_unrestored_sample = restore_lpc_without_overflow<6>(decoded_span, coefficients_span, lpc_shift);
+            break;
+        case 7:
+            first_unrestored_sample = restore_lpc_without_overflow<7>(decoded_span, coefficients_span, lpc_shift);
+            break;
+        case 8:
+            first_unrestored_sample = restore_lpc_without_overflow<8>(decoded_span, coefficients_span, lpc_shift);
+            break;
+        case 12:
+            first_unrestored_sample = restore_lpc_without_overflow<12>(decoded_span, coefficients_span, lpc_shift);
+            break;
+        default:
+            first_unrestored_sample = restore_lpc_without_overflow<0>(decoded_span, coefficients_span, lpc_shift);
+            break;
+        }
+    }
+
+    // Anything the fast predictor could not restore needs to be computed with overflow handling.
+    for (size_t i = first_unrestored_sample; i < m_current_frame->sample_count; ++i) {
         // (see below)
         Checked<i64> sample = 0;
         for (size_t t = 0; t < subframe.order; ++t) {
@@ -927,17 +992,13 @@ MaybeLoaderError FlacLoaderPlugin::decode_residual(Vector<i64>& decoded, FlacSub
         // 11.30.2. RESIDUAL_CODING_METHOD_PARTITIONED_EXP_GOLOMB
         // decode a single Rice partition with four bits for the order k
         for (size_t i = 0; i < partitions; ++i) {
-            // FIXME: Write into the decode buffer directly.
-            auto rice_partition = TRY(decode_rice_partition(4, partitions, i, subframe, bit_input));
-            decoded.extend(move(rice_partition));
+            TRY(decode_rice_partition(decoded, 4, partitions, i, subframe, bit_input));
         }
     } else if (residual_mode == FlacResidualMode::Rice5Bit) {
         // 11.30.3. RESIDUAL_CODING_METHOD_PARTITIONED_EXP_GOLOMB2
         // five bits equivalent
         for (size_t i = 0; i < partitions; ++i) {
-            // FIXME: Write into the decode buffer directly.
-            auto rice_partition = TRY(decode_rice_partition(5, partitions, i, subframe, bit_input));
-            decoded.extend(move(rice_partition));
+            TRY(decode_rice_partition(decoded, 5, partitions, i, subframe, bit_input));
         }
     } else
         return LoaderError { LoaderError::Category::Format, static_cast<size_t>(m_current_sample_or_frame), "Reserved residual coding method"_fly_string };
@@ -947,7 +1008,7 @@ MaybeLoaderError FlacLoaderPlugin::decode_residual(Vector<i64>& decoded, FlacSub
 
 // 11.30.2.1. EXP_GOLOMB_PARTITION and 11.30.3.1. EXP_GOLOMB2_PARTITION
 // Decode a single Rice partition as part of the residual, every partition can have its own Rice parameter k
-ALWAYS_INLINE ErrorOr<Vector<i64>, LoaderError> FlacLoaderPlugin::decode_rice_partition(u8 partition_type, u32 partitions, u32 partition_index, FlacSubframeHeader& subframe, BigEndianInputBitStream& bit_input)
+ALWAYS_INLINE MaybeLoaderError FlacLoaderPlugin::decode_rice_partition(Vector<i64>& decoded, u8 partition_type, u32 partitions, u32 partition_index, FlacSubframeHeader& subframe, BigEndianInputBitStream& bit_input)
 {
     // 11.30.2.2. EXP GOLOMB PARTITION ENCODING PARAMETER and 11.30.3.2. EXP-GOLOMB2 PARTITION ENCODING PARAMETER
     u8 k = TRY(bit_input.read_bits<u8>(partition_type));
@@ -963,32 +1024,31 @@ ALWAYS_INLINE ErrorOr<Vector<i64>, LoaderError> FlacLoaderPlugin::decode_rice_pa
         residual_sample_count -= subframe.order;
     }
 
-    Vector<i64> rice_partition;
-    rice_partition.resize(residual_sample_count);
+    TRY(decoded.try_ensure_capacity(decoded.size() + residual_sample_count));
 
     // escape code for unencoded binary partition
     if (k == (1 << partition_type) - 1) {
         u8 unencoded_bps = TRY(bit_input.read_bits<u8>(5));
         if (unencoded_bps != 0) {
-            for (size_t r = 0; r < residual_sample_count; ++r) {
-                rice_partition[r] = sign_extend(TRY(bit_input.read_bits<u32>(unencoded_bps)), unencoded_bps);
-            }
+            for (size_t r = 0; r < residual_sample_count; ++r)
+                decoded.unchecked_append(sign_extend(TRY(bit_input.read_bits<u32>(unencoded_bps)), unencoded_bps));
+        } else {
+            for (size_t r = 0; r < residual_sample_count; ++r)
+                decoded.unchecked_append(0);
         }
     } else {
-        for (size_t r = 0; r < residual_sample_count; ++r) {
-            rice_partition[r] = TRY(decode_unsigned_exp_golomb(k, bit_input));
-        }
+        for (size_t r = 0; r < residual_sample_count; ++r)
+            decoded.unchecked_append(TRY(decode_unsigned_exp_golomb(k, bit_input)));
     }
 
-    return rice_partition;
+    return {};
 }
 
 // Decode a single number encoded with Rice/Exponential-Golomb encoding (the unsigned variant)
 ALWAYS_INLINE ErrorOr<i32> decode_unsigned_exp_golomb(u8 k, BigEndianInputBitStream& bit_input)
 {
-    u8 q = 0;
-    while (TRY(bit_input.read_bit()) == 0)
-        ++q;
+    // most significant bits (quotient), unary-coded
+    u32 q = TRY(bit_input.read_unary());
 
     // least significant bits (remainder)
     u32 rem = TRY(bit_input.read_bits<u32>(k));
@@ -11,6 +11,7 @@
 #include <LibAudio/QOALoader.h>
 #include <LibAudio/WavLoader.h>
 #include <LibCore/MappedFile.h>
+#include <sys/mman.h>
 
 namespace Audio {
 
@@ -45,6 +46,8 @@ static constexpr LoaderPluginInitializer s_initializers[] = {
 ErrorOr<NonnullRefPtr<Loader>, LoaderError> Loader::create(StringView path)
 {
     auto stream = TRY(Core::MappedFile::map(path, Core::MappedFile::Mode::ReadOnly));
+    // Audio is decoded from front to back, so let the kernel read ahead aggressively.
+    (void)stream->advise(MADV_SEQUENTIAL);
     auto plugin = TRY(Loader::create_plugin(move(stream)));
     return adopt_ref(*new (nothrow) Loader(move(plugin)));
 }
@@ -315,7 +315,7 @@ ErrorOr<MP3::MP3Frame, LoaderError> MP3LoaderPlugin::read_frame_data(MP3::Header
                 for (size_t band_index = 0; band_index < 32; band_index++) {
                     in_samples[band_index] = granule.filter_bank_input[band_index][sample_index];
                 }
-                synthesis(m_synthesis_buffer[channel_index], in_samples, granule.pcm[sample_index]);
+                synthesis(m_synthesis_buffer[channel_index], m_synthesis_buffer_offsets[channel_index], in_samples, granule.pcm[sample_index]);
             }
         }
     }
@@ -827,38 +827,40 @@ void MP3LoaderPlugin::transform_samples_to_time(Array<float, MP3::granule_size>
 }
 
 // ISO/IEC 11172-3 (Figure A.2)
-void MP3LoaderPlugin::synthesis(Array<float, 1024>& V, Array<float, 32>& samples, Array<float, 32>& result)
+// V is used as a ring buffer starting at V_offset, so that shifting it by 64 values doesn't require moving the other 960.
+void MP3LoaderPlugin::synthesis(Array<float, 1024>& V, size_t& V_offset, Array<float, 32>& samples, Array<float, 32>& result)
 {
-    for (size_t i = 1023; i >= 64; i--) {
-        V[i] = V[i - 64];
-    }
-
-    for (size_t i = 0; i < 64; i++) {
-        V[i] = 0;
-        for (size_t k = 0; k < 32; k++) {
-            float const N = MP3::Tables::SynthesisSubbandFilterCoefficients[i][k];
-            V[i] += N * samples[k];
-        }
-    }
-
-    Array<float, 512> U;
+    V_offset = (V_offset - 64) % 1024;
+    float* new_V = V.data() + V_offset;
+
+    // The matrixing coefficients are cos((16 + i) * (2k + 1) * pi / 64), which means that the rows are symmetric:
+    // Row 16 is zero, rows 17-32 are the negated rows 15-0 and rows 49-63 equal rows 47-33.
+    // Therefore, only half of the rows have to be computed.
+    auto matrix_row = [&](size_t i) {
+        float value = 0;
+        for (size_t k = 0; k < 32; k++)
+            value += MP3::Tables::SynthesisSubbandFilterCoefficients[i][k] * samples[k];
+        return value;
+    };
+    for (size_t i = 0; i < 16; i++)
+        new_V[i] = matrix_row(i);
+    for (size_t i = 33; i <= 48; i++)
+        new_V[i] = matrix_row(i);
+    new_V[16] = 0;
+    for (size_t i = 1; i <= 16; i++)
+        new_V[16 + i] = -new_V[16 - i];
+    for (size_t i = 1; i < 16; i++)
+        new_V[48 + i] = new_V[48 - i];
+
+    // Build the vector U from V and window it, summing up the 16 windowed values for each output sample.
+    result = {};
     for (size_t i = 0; i < 8; i++) {
-        for (size_t j = 0; j < 32; j++) {
-            U[i * 64 + j] = V[i * 128 + j];
-            U[i * 64 + 32 + j] = V[i * 128 + 96 + j];
-        }
-    }
-
-    Array<float, 512> W;
-    for (size_t i = 0; i < 512; i++) {
-        W[i] = U[i] * MP3::Tables::WindowSynthesis[i];
-    }
-
-    for (size_t j = 0; j < 32; j++) {
-        result[j] = 0;
-        for (size_t k = 0; k < 16; k++) {
-            result[j] += W[j + 32 * k];
-        }
+        float const* first_V_part = V.data() + ((V_offset + i * 128) % 1024);
+        float const* second_V_part = V.data() + ((V_offset + i * 128 + 96) % 1024);
+        float const* first_window_part = MP3::Tables::WindowSynthesis.data() + i * 64;
+        float const* second_window_part = first_window_part + 32;
+        for (size_t j = 0; j < 32; j++)
+            result[j] += first_V_part[j] * first_window_part[j] + second_V_part[j] * second_window_part[j];
     }
 }
 
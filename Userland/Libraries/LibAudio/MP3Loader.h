@@ -56,12 +56,14 @@ private:
     static void reduce_alias(MP3::Granule&, size_t max_subband_index = 576);
     static void process_stereo(MP3::MP3Frame&, size_t granule_index);
     static void transform_samples_to_time(Array<float, 576> const& input, size_t input_offset, Array<float, 36>& output, MP3::BlockType block_type);
-    static void synthesis(Array<float, 1024>& V, Array<float, 32>& samples, Array<float, 32>& result);
+    static void synthesis(Array<float, 1024>& V, size_t& V_offset, Array<float, 32>& samples, Array<float, 32>& result);
     static ReadonlySpan<MP3::Tables::ScaleFactorBand> get_scalefactor_bands(MP3::Granule const&, int samplerate);
 
     SeekTable m_seek_table;
     AK::Array<AK::Array<AK::Array<float, 18>, 32>, 2> m_last_values {};
     AK::Array<AK::Array<float, 1024>, 2> m_synthesis_buffer {};
+    // Resetting m_synthesis_buffer to zero is enough to reset the synthesis, its ring buffer offsets don't matter then.
+    AK::Array<size_t, 2> m_synthesis_buffer_offsets {};
     static DSP::MDCT<36> s_mdct_36;
     static DSP::MDCT<12> s_mdct_12;
 
@@ -62,6 +62,16 @@ public:
     template<ArrayLike<SampleType> Samples, size_t vector_inline_capacity = 0>
     ErrorOr<void> try_resample_into_end(Vector<SampleType, vector_inline_capacity>& destination, Samples&& to_resample)
     {
+        // Matching rates are common, and then every sample is stored and read exactly once.
+        if (m_source == m_target) {
+            TRY(destination.try_ensure_capacity(destination.size() + to_resample.size()));
+            for (auto sample : to_resample)
+                destination.unchecked_append(sample);
+            if (!to_resample.is_empty())
+                m_last_sample_l = m_last_sample_r = to_resample[to_resample.size() - 1];
+            return {};
+        }
+
         float ratio = (m_source > m_target) ? static_cast<float>(m_source) / m_target : static_cast<float>(m_target) / m_source;
         TRY(destination.try_ensure_capacity(destination.size() + to_resample.size() * ratio));
         for (auto sample : to_resample) {
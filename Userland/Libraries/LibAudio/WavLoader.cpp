@@ -11,7 +11,6 @@
 #include <AK/Debug.h>
 #include <AK/Endian.h>
 #include <AK/FixedArray.h>
-#include <AK/MemoryStream.h>
 #include <AK/NonnullOwnPtr.h>
 #include <AK/NumericLimits.h>
 #include <AK/Try.h>
@@ -46,19 +45,66 @@ ErrorOr<NonnullOwnPtr<LoaderPlugin>, LoaderError> WavLoaderPlugin::create(Nonnul
     return loader;
 }
 
-template<typename SampleReader>
-MaybeLoaderError WavLoaderPlugin::read_samples_from_stream(Stream& stream, SampleReader read_sample, FixedArray<Sample>& samples) const
+// There's no i24 type + we need to do the endianness conversion manually anyways.
+struct Int24 {
+    u8 bytes[3];
+};
+static_assert(sizeof(Int24) == 3);
+
+template<typename T>
+static ALWAYS_INLINE double read_sample(u8 const* data)
+{
+    if constexpr (IsSame<T, Int24>) {
+        i32 sample1 = data[0];
+        i32 sample2 = data[1];
+        i32 sample3 = data[2];
+
+        i32 value = 0;
+        value = sample1;
+        value |= sample2 << 8;
+        value |= sample3 << 16;
+        // Sign extend the value, as it can currently not have the correct sign.
+        value = (value << 8) >> 8;
+        // Range of value is now -2^23 to 2^23-1 and we can rescale normally.
+        return static_cast<double>(value) / static_cast<double>((1 << 23) - 1);
+    } else {
+        T sample { 0 };
+        __builtin_memcpy(&sample, data, sizeof(T));
+        // Remap integer samples to normalized floating-point range of -1 to 1.
+        if constexpr (IsIntegral<T>) {
+            if constexpr (NumericLimits<T>::is_signed()) {
+                // Signed integer samples are centered around zero, so this division is enough.
+                return static_cast<double>(AK::convert_between_host_and_little_endian(sample)) / static_cast<double>(NumericLimits<T>::max());
+            } else {
+                // Unsigned integer samples, on the other hand, need to be shifted to center them around zero.
+                // The first division therefore remaps to the range 0 to 2.
+                return static_cast<double>(AK::convert_between_host_and_little_endian(sample)) / (static_cast<double>(NumericLimits<T>::max()) / 2.0) - 1.0;
+            }
+        } else {
+            return static_cast<double>(AK::convert_between_host_and_little_endian(sample));
+        }
+    }
+}
+
+template<typename T>
+MaybeLoaderError WavLoaderPlugin::read_samples_from_data(ReadonlyBytes data, FixedArray<Sample>& samples) const
 {
+    // The samples are converted straight from the data instead of through a stream, so that these loops stay simple
+    // enough for the compiler to vectorize.
+    if (data.size() < samples.size() * m_num_channels * sizeof(T))
+        return LoaderError { LoaderError::Category::IO, "Not enough sample data"_fly_string };
+    auto const* sample_data = data.data();
+
     switch (m_num_channels) {
     case 1:
-        for (auto& sample : samples)
-            sample = Sample(TRY(read_sample(stream)));
+        for (size_t i = 0; i < samples.size(); ++i)
+            samples[i] = Sample(read_sample<T>(sample_data + i * sizeof(T)));
         break;
     case 2:
-        for (auto& sample : samples) {
-            auto left_channel_sample = TRY(read_sample(stream));
-            auto right_channel_sample = TRY(read_sample(stream));
-            sample = Sample(left_channel_sample, right_channel_sample);
+        for (size_t i = 0; i < samples.size(); ++i) {
+            auto left_channel_sample = read_sample<T>(sample_data + i * 2 * sizeof(T));
+            auto right_channel_sample = read_sample<T>(sample_data + (i * 2 + 1) * sizeof(T));
+            samples[i] = Sample(left_channel_sample, right_channel_sample);
         }
         break;
     default:
@@ -67,63 +113,25 @@ MaybeLoaderError WavLoaderPlugin::read_samples_from_stream(Stream& stream, Sampl
     return {};
 }
 
-// There's no i24 type + we need to do the endianness conversion manually anyways.
-static ErrorOr<double> read_sample_int24(Stream& stream)
-{
-    i32 sample1 = TRY(stream.read_value<u8>());
-    i32 sample2 = TRY(stream.read_value<u8>());
-    i32 sample3 = TRY(stream.read_value<u8>());
-
-    i32 value = 0;
-    value = sample1;
-    value |= sample2 << 8;
-    value |= sample3 << 16;
-    // Sign extend the value, as it can currently not have the correct sign.
-    value = (value << 8) >> 8;
-    // Range of value is now -2^23 to 2^23-1 and we can rescale normally.
-    return static_cast<double>(value) / static_cast<double>((1 << 23) - 1);
-}
-
-template<typename T>
-static ErrorOr<double> read_sample(Stream& stream)
-{
-    T sample { 0 };
-    TRY(stream.read_until_filled(Bytes { &sample, sizeof(T) }));
-    // Remap integer samples to normalized floating-point range of -1 to 1.
-    if constexpr (IsIntegral<T>) {
-        if constexpr (NumericLimits<T>::is_signed()) {
-            // Signed integer samples are centered around zero, so this division is enough.
-            return static_cast<double>(AK::convert_between_host_and_little_endian(sample)) / static_cast<double>(NumericLimits<T>::max());
-        } else {
-            // Unsigned integer samples, on the other hand, need to be shifted to center them around zero.
-            // The first division therefore remaps to the range 0 to 2.
-            return static_cast<double>(AK::convert_between_host_and_little_endian(sample)) / (static_cast<double>(NumericLimits<T>::max()) / 2.0) - 1.0;
-        }
-    } else {
-        return static_cast<double>(AK::convert_between_host_and_little_endian(sample));
-    }
-}
-
 LoaderSamples WavLoaderPlugin::samples_from_pcm_data(ReadonlyBytes data, size_t samples_to_read) const
 {
     FixedArray<Sample> samples = TRY(FixedArray<Sample>::create(samples_to_read));
-    FixedMemoryStream stream { data };
 
     switch (m_sample_format) {
     case PcmSampleFormat::Uint8:
-        TRY(read_samples_from_stream(stream, read_sample<u8>, samples));
+        TRY(read_samples_from_data<u8>(data, samples));
         break;
     case PcmSampleFormat::Int16:
-        TRY(read_samples_from_stream(stream, read_sample<i16>, samples));
+        TRY(read_samples_from_data<i16>(data, samples));
         break;
     case PcmSampleFormat::Int24:
-        TRY(read_samples_from_stream(stream, read_sample_int24, samples));
+        TRY(read_samples_from_data<Int24>(data, samples));
         break;
     case PcmSampleFormat::Float32:
-        TRY(read_samples_from_stream(stream, read_sample<float>, samples));
+        TRY(read_samples_from_data<float>(data, samples));
         break;
     case PcmSampleFormat::Float64:
-        TRY(read_samples_from_stream(stream, read_sample<double>, samples));
+        TRY(read_samples_from_data<double>(data, samples));
         break;
     default:
         VERIFY_NOT_REACHED();
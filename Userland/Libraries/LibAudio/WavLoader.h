@@ -49,8 +49,8 @@ private:
     MaybeLoaderError load_wav_info_block(Vector<RIFF::OwnedChunk> info_chunks);
 
     LoaderSamples samples_from_pcm_data(ReadonlyBytes data, size_t samples_to_read) const;
-    template<typename SampleReader>
-    MaybeLoaderError read_samples_from_stream(Stream& stream, SampleReader read_sample, FixedArray<Sample>& samples) const;
+    template<typename T>
+    MaybeLoaderError read_samples_from_data(ReadonlyBytes data, FixedArray<Sample>& samples) const;
 
     u32 m_sample_rate { 0 };
     u16 m_num_channels { 0 };
@@ -7,6 +7,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/BitCast.h>
 #include <AK/BuiltinWrappers.h>
 #include <AK/FloatingPoint.h>
 #if ARCH(X86_64)
@@ -323,7 +324,7 @@ long double nanl(char const* s) NOEXCEPT
     return __builtin_nanl(s);
 }
 
-#define MAKE_AK_BACKED1(name)                     \
+#define MAKE_AK_BACKED1_DOUBLE(name)              \
     long double name##l(long double arg) NOEXCEPT \
     {                                             \
         return AK::name<long double>(arg);        \
@@ -331,12 +332,14 @@ long double nanl(char const* s) NOEXCEPT
     double name(double arg) NOEXCEPT              \
     {                                             \
         return AK::name<double>(arg);             \
-    }                                             \
-    float name##f(float arg) NOEXCEPT             \
-    {                                             \
-        return AK::name<float>(arg);              \
     }
-#define MAKE_AK_BACKED2(name)                                        \
+#define MAKE_AK_BACKED1(name)         \
+    MAKE_AK_BACKED1_DOUBLE(name)      \
+    float name##f(float arg) NOEXCEPT \
+    {                                 \
+        return AK::name<float>(arg);  \
+    }
+#define MAKE_AK_BACKED2_DOUBLE(name)                                 \
     long double name##l(long double arg1, long double arg2) NOEXCEPT \
     {                                                                \
         return AK::name<long double>(arg1, arg2);                    \
@@ -344,14 +347,253 @@ long double nanl(char const* s) NOEXCEPT
     double name(double arg1, double arg2) NOEXCEPT                   \
     {                                                                \
         return AK::name<double>(arg1, arg2);                         \
-    }                                                                \
-    float name##f(float arg1, float arg2) NOEXCEPT                   \
-    {                                                                \
-        return AK::name<float>(arg1, arg2);                          \
     }
+#define MAKE_AK_BACKED2(name)                       \
+    MAKE_AK_BACKED2_DOUBLE(name)                    \
+    float name##f(float arg1, float arg2) NOEXCEPT  \
+    {                                               \
+        return AK::name<float>(arg1, arg2);         \
+    }
+
+// NOTE: The single precision versions of exp, log, sin, cos and pow are evaluated in double precision
+//       with polynomials, which leaves enough headroom for the results to round correctly to float in
+//       all but very rare cases. This is a lot faster than the x87 instructions backing the other ones.
+namespace FloatMath {
+
+// ln(2) and pi/2 split into a part with the low bits cleared, so that multiplying it by small integers is exact.
+static constexpr double ln2_hi = 6.93147180369123816490e-01;
+static constexpr double ln2_lo = 1.90821492927058770002e-10;
+static constexpr double pio2_hi = 1.57079632673412561417e+00;
+static constexpr double pio2_lo = 6.07710050650619224932e-11;
+
+// Only valid for results that are normal doubles, which all finite float results are.
+static double exp(double x)
+{
+    // exp(x) = 2^k * exp(r), with x = k * ln(2) + r and |r| <= ln(2) / 2.
+    auto k = static_cast<i64>(x * M_LOG2E + (x < 0 ? -0.5 : 0.5));
+    double r = x - k * ln2_hi - k * ln2_lo;
+    double p = 1.0 / 39916800;
+    p = p * r + 1.0 / 3628800;
+    p = p * r + 1.0 / 362880;
+    p = p * r + 1.0 / 40320;
+    p = p * r + 1.0 / 5040;
+    p = p * r + 1.0 / 720;
+    p = p * r + 1.0 / 120;
+    p = p * r + 1.0 / 24;
+    p = p * r + 1.0 / 6;
+    p = p * r + 0.5;
+    p = p * r + 1.0;
+    p = p * r + 1.0;
+    return p * bit_cast<double>(static_cast<u64>(k + 1023) << 52);
+}
+
+// Only valid for normal, positive and finite arguments.
+static double log(double x)
+{
+    // log(x) = e * ln(2) + log(m), with x = 2^e * m and sqrt(2)/2 <= m < sqrt(2).
+    auto bits = bit_cast<u64>(x);
+    int e = static_cast<int>(bits >> 52) - 1023;
+    double m = bit_cast<double>((bits & 0x000fffffffffffffull) | 0x3ff0000000000000ull);
+    if (m > M_SQRT2) {
+        m *= 0.5;
+        ++e;
+    }
+
+    // log(m) = 2 * atanh(s) = 2 * (s + s^3/3 + s^5/5 + ...), with s = (m - 1) / (m + 1) and |s| < 0.172.
+    double s = (m - 1) / (m + 1);
+    double z = s * s;
+    double p = 1.0 / 17;
+    p = p * z + 1.0 / 15;
+    p = p * z + 1.0 / 13;
+    p = p * z + 1.0 / 11;
+    p = p * z + 1.0 / 9;
+    p = p * z + 1.0 / 7;
+    p = p * z + 1.0 / 5;
+    p = p * z + 1.0 / 3;
+    return e * ln2_hi + (2 * s + 2 * s * z * p + e * ln2_lo);
+}
+
+// The first 320 bits of 2/pi, which is enough to reduce any float.
+static constexpr u32 two_over_pi_bits[] = {
+    0xa2f9836e, 0x4e441529, 0xfc2757d1, 0xf534ddc0, 0xdb629599,
+    0x3c439041, 0xfe5163ab, 0xdebbc561, 0xb7246e3a, 0x424dd2e0
+};
+
+// Returns r and k with x = k * pi/2 + r and |r| <= pi/4, for any finite positive x.
+// This multiplies x with as many bits of 2/pi as it takes to keep all of them that fall below the binary point
+// (Payne and Hanek's method), bits above it only contribute multiples of 4 quadrants.
+static double reduce_large_argument(float x, i64& k)
+{
+    auto bits = bit_cast<u32>(x);
+    u64 mantissa = (bits & 0x7fffff) | 0x800000;
+    int exponent = static_cast<int>((bits >> 23) & 0xff) - 127 - 23;
+
+    // Pick the 96 bits of 2/pi that start with the one worth 2 quadrants (or the first one, if that comes before them).
+    int first_bit = max(exponent - 2, 0);
+    int word = first_bit / 32;
+    int shift = first_bit % 32;
+    unsigned __int128 window = (static_cast<unsigned __int128>(two_over_pi_bits[word]) << 96)
+        | (static_cast<unsigned __int128>(two_over_pi_bits[word + 1]) << 64)
+        | (static_cast<unsigned __int128>(two_over_pi_bits[word + 2]) << 32)
+        | two_over_pi_bits[word + 3];
+    window = (window << shift) >> 32;
+
+    // The product is a fixed point number with this many bits after the binary point.
+    int fraction_bits = first_bit + 96 - exponent;
+    auto product = window * mantissa;
+    k = static_cast<i64>(product >> fraction_bits) & 3;
+    auto fraction = static_cast<u64>(product >> (fraction_bits - 64));
+    // Fractions of at least one half round up to the next quadrant and leave a negative r.
+    if (fraction >> 63)
+        ++k;
+    return static_cast<double>(static_cast<i64>(fraction)) * 0x1p-64 * (pio2_hi + pio2_lo);
+}
+
+enum class Trigonometric {
+    Sine,
+    Cosine,
+};
+
+static float sin_or_cos(float x, Trigonometric function)
+{
+    if (!isfinite(x))
+        return NAN;
+    if (x == 0.0f)
+        return function == Trigonometric::Sine ? x : 1.0f;
+
+    // Map x onto r in [-pi/4, pi/4], with x = k * pi/2 + r. The quadrant decides which function and sign we need.
+    // NOTE: The simple range reduction is only exact as long as k fits into 20 bits.
+    auto value = static_cast<double>(x);
+    i64 k;
+    double r;
+    if (fabsf(x) < 0x1p20f) {
+        k = static_cast<i64>(value * M_2_PI + (value < 0 ? -0.5 : 0.5));
+        r = value - k * pio2_hi - k * pio2_lo;
+    } else {
+        r = reduce_large_argument(fabsf(x), k);
+        if (x < 0) {
+            k = -k;
+            r = -r;
+        }
+    }
+    auto quadrant = (k + (function == Trigonometric::Cosine ? 1 : 0)) & 3;
+
+    double z = r * r;
+    double result;
+    if (quadrant & 1) {
+        double p = -1.0 / 87178291200;
+        p = p * z + 1.0 / 479001600;
+        p = p * z - 1.0 / 3628800;
+        p = p * z + 1.0 / 40320;
+        p = p * z - 1.0 / 720;
+        p = p * z + 1.0 / 24;
+        p = p * z - 0.5;
+        result = p * z + 1.0;
+    } else {
+        double p = 1.0 / 6227020800;
+        p = p * z - 1.0 / 39916800;
+        p = p * z + 1.0 / 362880;
+        p = p * z - 1.0 / 5040;
+        p = p * z + 1.0 / 120;
+        p = p * z - 1.0 / 6;
+        result = r + r * z * p;
+    }
+    return static_cast<float>(quadrant & 2 ? -result : result);
+}
+
+static bool is_integer(float x)
+{
+    // All floats at least this large are integers.
+    if (!(fabsf(x) < 0x1p24f))
+        return isfinite(x);
+    return static_cast<float>(static_cast<i32>(x)) == x;
+}
+
+static bool is_odd_integer(float x)
+{
+    if (!(fabsf(x) < 0x1p24f))
+        return false;
+    auto integer = static_cast<i32>(x);
+    return static_cast<float>(integer) == x && (integer & 1);
+}
+
+}
+
+float expf(float x) NOEXCEPT
+{
+    if (isnan(x))
+        return x;
+    if (x > 88.72283935546875f)
+        return HUGE_VALF;
+    if (x < -103.97208404541015625f)
+        return 0.0f;
+    return static_cast<float>(FloatMath::exp(static_cast<double>(x)));
+}
+
+float logf(float x) NOEXCEPT
+{
+    if (isnan(x) || x < 0.0f)
+        return NAN;
+    if (x == 0.0f)
+        return -HUGE_VALF;
+    if (isinf(x))
+        return x;
+    return static_cast<float>(FloatMath::log(static_cast<double>(x)));
+}
+
+float sinf(float x) NOEXCEPT
+{
+    return FloatMath::sin_or_cos(x, FloatMath::Trigonometric::Sine);
+}
+
+float cosf(float x) NOEXCEPT
+{
+    return FloatMath::sin_or_cos(x, FloatMath::Trigonometric::Cosine);
+}
+
+float powf(float x, float y) NOEXCEPT
+{
+    // These follow the special cases in C99 Annex F.9.4.4.
+    if (x == 1.0f || y == 0.0f)
+        return 1.0f;
+    if (isnan(x) || isnan(y))
+        return NAN;
+
+    bool y_is_odd_integer = FloatMath::is_odd_integer(y);
+    if (x == 0.0f) {
+        if (y < 0.0f)
+            return y_is_odd_integer ? copysignf(HUGE_VALF, x) : HUGE_VALF;
+        return y_is_odd_integer ? x : 0.0f;
+    }
+    if (isinf(y)) {
+        if (x == -1.0f)
+            return 1.0f;
+        return (fabsf(x) < 1.0f) == (y < 0.0f) ? HUGE_VALF : 0.0f;
+    }
+    if (isinf(x)) {
+        float magnitude = y < 0.0f ? 0.0f : HUGE_VALF;
+        return x < 0.0f && y_is_odd_integer ? -magnitude : magnitude;
+    }
+
+    float sign = 1.0f;
+    if (x < 0.0f) {
+        if (!FloatMath::is_integer(y))
+            return NAN;
+        if (y_is_odd_integer)
+            sign = -1.0f;
+        x = -x;
+    }
+
+    double exponent = static_cast<double>(y) * FloatMath::log(static_cast<double>(x));
+    if (exponent > 88.72283935546875)
+        return sign * HUGE_VALF;
+    if (exponent < -103.97208404541015625)
+        return sign * 0.0f;
+    return sign * static_cast<float>(FloatMath::exp(exponent));
+}
 
-MAKE_AK_BACKED1(sin);
-MAKE_AK_BACKED1(cos);
+MAKE_AK_BACKED1_DOUBLE(sin);
+MAKE_AK_BACKED1_DOUBLE(cos);
 MAKE_AK_BACKED1(tan);
 MAKE_AK_BACKED1(asin);
 MAKE_AK_BACKED1(acos);
@@ -364,17 +606,17 @@ MAKE_AK_BACKED1(acosh);
 MAKE_AK_BACKED1(atanh);
 MAKE_AK_BACKED1(sqrt);
 MAKE_AK_BACKED1(cbrt);
-MAKE_AK_BACKED1(log);
+MAKE_AK_BACKED1_DOUBLE(log);
 MAKE_AK_BACKED1(log2);
 MAKE_AK_BACKED1(log10);
-MAKE_AK_BACKED1(exp);
+MAKE_AK_BACKED1_DOUBLE(exp);
 MAKE_AK_BACKED1(exp2);
 MAKE_AK_BACKED1(fabs);
 
 MAKE_AK_BACKED2(atan2);
 MAKE_AK_BACKED2(hypot);
 MAKE_AK_BACKED2(fmod);
-MAKE_AK_BACKED2(pow);
+MAKE_AK_BACKED2_DOUBLE(pow);
 MAKE_AK_BACKED2(remainder);
 
 long double truncl(long double x) NOEXCEPT
@@ -21,6 +21,7 @@
 #include <signal.h>
 #include <stdio.h>
 #include <string.h>
+#include <sys/internals.h>
 #include <sys/mman.h>
 #include <sys/prctl.h>
 #include <syscall.h>
@@ -61,6 +62,8 @@ extern "C" {
 [[noreturn]] static void exit_thread(void* code, void* stack_location, size_t stack_size)
 {
     __pthread_key_destroy_for_current_thread();
+    // NOTE: Give the chunks that this thread kept for itself back, or they'd be lost along with its TLS region.
+    __malloc_flush_thread_cache();
     MUST(__free_tls_region(bit_cast<FlatPtr>(__builtin_thread_pointer())));
     syscall(SC_exit_thread, code, stack_location, stack_size);
     VERIFY_NOT_REACHED();
@@ -664,8 +667,6 @@ int pthread_equal(pthread_t t1, pthread_t t2)
     return t1 == t2;
 }
 
-// FIXME: Use the fancy futex mechanism above to write an rw lock.
-//        For the time being, let's just use a less-than-good lock to get things working.
 // https://pubs.opengroup.org/onlinepubs/009695399/functions/pthread_rwlock_destroy.html
 int pthread_rwlock_destroy(pthread_rwlock_t* rl)
 {
@@ -674,123 +675,156 @@ int pthread_rwlock_destroy(pthread_rwlock_t* rl)
     return 0;
 }
 
-// In a very non-straightforward way, this value is composed of two 32-bit integers
+// This value is composed of two 32-bit integers:
 // the top 32 bits are reserved for the ID of write-locking thread (if any)
-// and the bottom 32 bits are:
-//     top 2 bits (30,31): reader wake mask, writer wake mask
-//     middle 16 bits: information
-//        bit 16: someone is waiting to write
-//        bit 17: locked for write
+// and the bottom 32 bits are the lock state, which is also what we wait on:
+//     bit 30: some readers are waiting for the lock
+//     bit 18: the lock prefers writers
+//     bit 17: locked for write
+//     bit 16: some writers are waiting for the lock
 //     bottom 16 bits (0..15): reader count
-constexpr static u32 reader_wake_mask = 1 << 30;
-constexpr static u32 writer_wake_mask = 1 << 31;
+// The waiting bits are a hint that somebody might have to be woken up when the lock is released,
+// every waiter sets them again right before going to sleep.
+// NOTE: A lock that prefers writers doesn't let new readers in while a writer is waiting for it.
+//       This keeps writers from starving, but a thread that takes the read lock again while
+//       holding it will deadlock against a waiting writer. So this isn't the default.
+constexpr static u32 reader_count_mask = 0xffff;
+constexpr static u32 writer_waiting_mask = 1 << 16;
 constexpr static u32 writer_locked_mask = 1 << 17;
-constexpr static u32 writer_intent_mask = 1 << 16;
+constexpr static u32 prefer_writers_mask = 1 << 18;
+constexpr static u32 reader_waiting_mask = 1 << 30;
+
+static u32* rwlock_state(pthread_rwlock_t* lockp)
+{
+    return reinterpret_cast<u32*>(lockp);
+}
+
+static pthread_t* rwlock_writer(pthread_rwlock_t* lockp)
+{
+    return reinterpret_cast<pthread_t*>(lockp) + 1;
+}
+
 // https://pubs.opengroup.org/onlinepubs/009695399/functions/pthread_rwlock_init.html
 int pthread_rwlock_init(pthread_rwlock_t* __restrict lockp, pthread_rwlockattr_t const* __restrict attr)
 {
-    // Just ignore the attributes. use defaults for now.
-    (void)attr;
-
     // No readers, no writer, not locked at all.
     *lockp = 0;
+    if (attr && attr->kind == PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP)
+        *rwlock_state(lockp) = prefer_writers_mask;
     return 0;
 }
 
-// Note that this function does not care about the top 32 bits at all.
-static int rwlock_rdlock_maybe_timed(u32* lockp, const struct timespec* timeout = nullptr, bool only_once = false, int value_if_timeout = -1, int value_if_okay = -2)
-{
-    auto current = AK::atomic_load(lockp);
-    for (; !only_once;) {
-        // First, see if this is locked for writing
-        // if it's not, try to add to the counter.
-        // If someone is waiting to write, and there is one or no other readers, let them have the lock.
-        if (!(current & writer_locked_mask)) {
-            auto count = (u16)current;
-            if (!(current & writer_intent_mask) || count > 1) {
-                ++count;
-                auto desired = (current & 0xffff0000u) | count;
-                auto did_exchange = AK::atomic_compare_exchange_strong(lockp, current, desired, AK::MemoryOrder::memory_order_acquire);
-                if (!did_exchange)
-                    continue; // tough luck, try again.
-                return value_if_okay;
-            }
-        }
+static int rwlock_wait(pthread_rwlock_t* lockp, u32 expected, u32 waiting_mask, const struct timespec* abstime)
+{
+    // NOTE: The timeouts of the rwlock functions are measured against CLOCK_REALTIME.
+    int op = FUTEX_WAIT_BITSET | FUTEX_PRIVATE_FLAG;
+    if (abstime)
+        op |= FUTEX_CLOCK_REALTIME;
+
+    int saved_errno = errno;
+    auto rc = futex(rwlock_state(lockp), op, expected, abstime, nullptr, waiting_mask);
+    int result = 0;
+    if (rc < 0 && errno != EAGAIN && errno != EINTR)
+        result = errno;
+    errno = saved_errno;
+    return result;
+}
 
-        // If no one else is waiting for the read wake bit, set it.
-        if (!(current & reader_wake_mask)) {
-            auto desired = current | reader_wake_mask;
-            auto did_exchange = AK::atomic_compare_exchange_strong(lockp, current, desired, AK::MemoryOrder::memory_order_acquire);
-            if (!did_exchange)
-                continue; // Something interesting happened!
+static int rwlock_wake(pthread_rwlock_t* lockp, u32 waiting_mask, u32 count)
+{
+    int saved_errno = errno;
+    auto rc = futex(rwlock_state(lockp), FUTEX_WAKE_BITSET | FUTEX_PRIVATE_FLAG, count, nullptr, nullptr, waiting_mask);
+    errno = saved_errno;
+    return max(rc, 0);
+}
 
-            current = desired;
+static void rwlock_wake_readers(pthread_rwlock_t* lockp)
+{
+    rwlock_wake(lockp, reader_waiting_mask, UINT32_MAX);
+}
+
+// Called after a write unlock, or after the last reader left, with the state from right before that.
+// The waiting bits that are in `woken_waiters` were cleared by the unlock.
+static void rwlock_wake_waiters(pthread_rwlock_t* lockp, u32 previous, u32 woken_waiters)
+{
+    if (woken_waiters & writer_waiting_mask) {
+        // NOTE: A writer that was woken up takes the lock as if others were still waiting for it,
+        //       so that it passes the wakeup on when it's done.
+        bool woke_writer = rwlock_wake(lockp, writer_waiting_mask, 1) > 0;
+        if (!woke_writer && (previous & reader_waiting_mask) && !(woken_waiters & reader_waiting_mask)) {
+            // The readers were left waiting for a writer that doesn't exist anymore.
+            AK::atomic_fetch_and(rwlock_state(lockp), ~reader_waiting_mask, AK::memory_order_relaxed);
+            rwlock_wake_readers(lockp);
+            return;
         }
+    }
+    if (woken_waiters & reader_waiting_mask)
+        rwlock_wake_readers(lockp);
+}
 
-        // Seems like someone is writing (or is interested in writing and we let them have the lock)
-        // wait until they're done.
-        auto rc = futex(lockp, FUTEX_WAIT_BITSET | FUTEX_PRIVATE_FLAG, current, timeout, nullptr, reader_wake_mask);
-        if (rc < 0 && errno == ETIMEDOUT && timeout) {
-            return value_if_timeout;
+static int rwlock_rdlock(pthread_rwlock_t* lockp, const struct timespec* abstime = nullptr, bool only_once = false)
+{
+    auto* state = rwlock_state(lockp);
+    auto current = AK::atomic_load(state, AK::memory_order_relaxed);
+    for (;;) {
+        // A writer blocks us if it holds the lock, or if it waits for it and the lock prefers writers.
+        bool blocked_by_writer = (current & writer_locked_mask)
+            || ((current & prefer_writers_mask) && (current & writer_waiting_mask));
+        if (!blocked_by_writer) {
+            if ((current & reader_count_mask) == reader_count_mask)
+                return EAGAIN;
+            if (AK::atomic_compare_exchange_strong(state, current, current + 1, AK::memory_order_acquire))
+                return 0;
+            continue;
         }
-        if (rc < 0 && errno != EAGAIN) {
-            // Something broke. let's just bail out.
-            return errno;
+
+        if ((current & writer_locked_mask) && AK::atomic_load(rwlock_writer(lockp), AK::memory_order_relaxed) == pthread_self())
+            return EDEADLK;
+        if (only_once)
+            return EBUSY;
+
+        // Tell whoever releases the lock that we're waiting, then wait until they're done.
+        if (!(current & reader_waiting_mask)) {
+            if (!AK::atomic_compare_exchange_strong(state, current, current | reader_waiting_mask, AK::memory_order_relaxed))
+                continue;
+            current |= reader_waiting_mask;
         }
-        errno = 0;
-        // Reload the 'current' value
-        current = AK::atomic_load(lockp);
+        if (auto rc = rwlock_wait(lockp, current, reader_waiting_mask, abstime); rc != 0)
+            return rc;
+        current = AK::atomic_load(state, AK::memory_order_relaxed);
     }
-    return value_if_timeout;
-}
-
-static int rwlock_wrlock_maybe_timed(pthread_rwlock_t* lockval_p, const struct timespec* timeout = nullptr, bool only_once = false, int value_if_timeout = -1, int value_if_okay = -2)
-{
-    u32* lockp = reinterpret_cast<u32*>(lockval_p);
-    auto current = AK::atomic_load(lockp);
-    for (; !only_once;) {
-        // First, see if this is locked for writing, and if there are any readers.
-        // if not, lock it.
-        // If someone is waiting to write, let them have the lock.
-        if (!(current & writer_locked_mask) && ((u16)current) == 0) {
-            if (!(current & writer_intent_mask)) {
-                auto desired = current | writer_locked_mask | writer_intent_mask;
-                auto did_exchange = AK::atomic_compare_exchange_strong(lockp, current, desired, AK::MemoryOrder::memory_order_acquire);
-                if (!did_exchange)
-                    continue;
-
-                // Now that we've locked the value, it's safe to set our thread ID.
-                AK::atomic_store(reinterpret_cast<i32*>(lockval_p) + 1, pthread_self());
-                return value_if_okay;
-            }
-        }
+}
 
-        // That didn't work, if no one else is waiting for the write bit, set it.
-        if (!(current & writer_wake_mask)) {
-            auto desired = current | writer_wake_mask | writer_intent_mask;
-            auto did_exchange = AK::atomic_compare_exchange_strong(lockp, current, desired, AK::MemoryOrder::memory_order_acquire);
-            if (!did_exchange)
-                continue; // Something interesting happened!
+static int rwlock_wrlock(pthread_rwlock_t* lockp, const struct timespec* abstime = nullptr, bool only_once = false)
+{
+    auto* state = rwlock_state(lockp);
+    auto current = AK::atomic_load(state, AK::memory_order_relaxed);
+    u32 waited = 0;
+    for (;;) {
+        if (!(current & (writer_locked_mask | reader_count_mask))) {
+            if (!AK::atomic_compare_exchange_strong(state, current, current | writer_locked_mask | waited, AK::memory_order_acquire))
+                continue;
 
-            current = desired;
+            // Now that we've locked the value, it's safe to set our thread ID.
+            AK::atomic_store(rwlock_writer(lockp), pthread_self(), AK::memory_order_relaxed);
+            return 0;
         }
 
-        // Seems like someone is writing (or is interested in writing and we let them have the lock)
-        // wait until they're done.
-        auto rc = futex(lockp, FUTEX_WAIT_BITSET | FUTEX_PRIVATE_FLAG, current, timeout, nullptr, writer_wake_mask);
-        if (rc < 0 && errno == ETIMEDOUT && timeout) {
-            return value_if_timeout;
-        }
-        if (rc < 0 && errno != EAGAIN) {
-            // Something broke. let's just bail out.
-            return errno;
+        if ((current & writer_locked_mask) && AK::atomic_load(rwlock_writer(lockp), AK::memory_order_relaxed) == pthread_self())
+            return EDEADLK;
+        if (only_once)
+            return EBUSY;
+
+        if (!(current & writer_waiting_mask)) {
+            if (!AK::atomic_compare_exchange_strong(state, current, current | writer_waiting_mask, AK::memory_order_relaxed))
+                continue;
+            current |= writer_waiting_mask;
         }
-        errno = 0;
-        // Reload the 'current' value
-        current = AK::atomic_load(lockp);
+        waited = writer_waiting_mask;
+        if (auto rc = rwlock_wait(lockp, current, writer_waiting_mask, abstime); rc != 0)
+            return rc;
+        current = AK::atomic_load(state, AK::memory_order_relaxed);
     }
-
-    return value_if_timeout;
 }
 
 // https://pubs.opengroup.org/onlinepubs/009695399/functions/pthread_rwlock_rdlock.html
@@ -799,35 +833,25 @@ int pthread_rwlock_rdlock(pthread_rwlock_t* lockp)
     if (!lockp)
         return EINVAL;
 
-    return rwlock_rdlock_maybe_timed(reinterpret_cast<u32*>(lockp), nullptr, false, 0, 0);
+    return rwlock_rdlock(lockp);
 }
 
 // https://pubs.opengroup.org/onlinepubs/009695399/functions/pthread_rwlock_timedrdlock.html
 int pthread_rwlock_timedrdlock(pthread_rwlock_t* __restrict lockp, const struct timespec* __restrict timespec)
 {
-    if (!lockp)
+    if (!lockp || !timespec)
         return EINVAL;
 
-    auto rc = rwlock_rdlock_maybe_timed(reinterpret_cast<u32*>(lockp), timespec);
-    if (rc == -1) // "ok"
-        return 0;
-    if (rc == -2) // "timed out"
-        return 1;
-    return rc;
+    return rwlock_rdlock(lockp, timespec);
 }
 
 // https://pubs.opengroup.org/onlinepubs/009695399/functions/pthread_rwlock_timedwrlock.html
 int pthread_rwlock_timedwrlock(pthread_rwlock_t* __restrict lockp, const struct timespec* __restrict timespec)
 {
-    if (!lockp)
+    if (!lockp || !timespec)
         return EINVAL;
 
-    auto rc = rwlock_wrlock_maybe_timed(lockp, timespec);
-    if (rc == -1) // "ok"
-        return 0;
-    if (rc == -2) // "timed out"
-        return 1;
-    return rc;
+    return rwlock_wrlock(lockp, timespec);
 }
 
 // https://pubs.opengroup.org/onlinepubs/009695399/functions/pthread_rwlock_tryrdlock.html
@@ -836,7 +860,7 @@ int pthread_rwlock_tryrdlock(pthread_rwlock_t* lockp)
     if (!lockp)
         return EINVAL;
 
-    return rwlock_rdlock_maybe_timed(reinterpret_cast<u32*>(lockp), nullptr, true, EBUSY, 0);
+    return rwlock_rdlock(lockp, nullptr, true);
 }
 
 // https://pubs.opengroup.org/onlinepubs/009695399/functions/pthread_rwlock_trywrlock.html
@@ -845,51 +869,55 @@ int pthread_rwlock_trywrlock(pthread_rwlock_t* lockp)
     if (!lockp)
         return EINVAL;
 
-    return rwlock_wrlock_maybe_timed(lockp, nullptr, true, EBUSY, 0);
+    return rwlock_wrlock(lockp, nullptr, true);
 }
 
 // https://pubs.opengroup.org/onlinepubs/009695399/functions/pthread_rwlock_unlock.html
-int pthread_rwlock_unlock(pthread_rwlock_t* lockval_p)
+int pthread_rwlock_unlock(pthread_rwlock_t* lockp)
 {
-    if (!lockval_p)
+    if (!lockp)
         return EINVAL;
 
     // This is a weird API, we don't really know whether we're unlocking write or read...
-    auto lockp = reinterpret_cast<u32*>(lockval_p);
-    auto current = AK::atomic_load(lockp, AK::MemoryOrder::memory_order_relaxed);
+    auto* state = rwlock_state(lockp);
+    auto current = AK::atomic_load(state, AK::memory_order_relaxed);
     if (current & writer_locked_mask) {
         // If this lock is locked for writing, its owner better be us!
-        auto owner_id = AK::atomic_load(reinterpret_cast<i32*>(lockval_p) + 1);
-        auto my_id = pthread_self();
-        if (owner_id != my_id)
+        if (AK::atomic_load(rwlock_writer(lockp), AK::memory_order_relaxed) != pthread_self())
             return EINVAL; // you don't own this lock, silly.
-
-        // Now just unlock it.
-        auto desired = current & ~(writer_locked_mask | writer_intent_mask);
-        AK::atomic_store(lockp, desired, AK::MemoryOrder::memory_order_release);
-        // Then wake both readers and writers, if any.
-        auto rc = futex(lockp, FUTEX_WAKE_BITSET | FUTEX_PRIVATE_FLAG, UINT32_MAX, nullptr, nullptr, (current & writer_wake_mask) | reader_wake_mask);
-        if (rc < 0)
-            return errno;
-        return 0;
+        AK::atomic_store(rwlock_writer(lockp), 0, AK::memory_order_relaxed);
+
+        for (;;) {
+            // Readers that are waiting on a lock that prefers writers have to wait for the next writer, if there is one.
+            u32 woken_waiters = current & (writer_waiting_mask | reader_waiting_mask);
+            if ((current & prefer_writers_mask) && (current & writer_waiting_mask))
+                woken_waiters = writer_waiting_mask;
+            auto desired = current & ~(writer_locked_mask | woken_waiters);
+            if (AK::atomic_compare_exchange_strong(state, current, desired, AK::memory_order_release)) {
+                rwlock_wake_waiters(lockp, current, woken_waiters);
+                return 0;
+            }
+        }
     }
 
     for (;;) {
-        auto count = (u16)current;
-        if (!count) {
+        if (!(current & reader_count_mask)) {
             // Are you crazy? this isn't even locked!
             return EINVAL;
         }
-        --count;
-        auto desired = (current & 0xffff0000u) | count;
-        auto did_exchange = AK::atomic_compare_exchange_strong(lockp, current, desired, AK::MemoryOrder::memory_order_release);
-        if (did_exchange)
-            break;
+        auto desired = current - 1;
+        // The last reader to leave lets a waiting writer in.
+        u32 woken_waiters = 0;
+        if (!(desired & reader_count_mask))
+            woken_waiters = desired & writer_waiting_mask;
+        desired &= ~woken_waiters;
+        if (AK::atomic_compare_exchange_strong(state, current, desired, AK::memory_order_release)) {
+            if (woken_waiters)
+                rwlock_wake_waiters(lockp, current, woken_waiters);
+            return 0;
+        }
         // tough luck, try again.
     }
-
-    // Finally, unlocked at last!
-    return 0;
 }
 
 // https://pubs.opengroup.org/onlinepubs/009695399/functions/pthread_rwlock_wrlock.html
@@ -898,7 +926,7 @@ int pthread_rwlock_wrlock(pthread_rwlock_t* lockp)
     if (!lockp)
         return EINVAL;
 
-    return rwlock_wrlock_maybe_timed(lockp, nullptr, false, 0, 0);
+    return rwlock_wrlock(lockp);
 }
 
 // https://pubs.opengroup.org/onlinepubs/009695399/functions/pthread_rwlockattr_destroy.html
@@ -908,21 +936,54 @@ int pthread_rwlockattr_destroy(pthread_rwlockattr_t*)
 }
 
 // https://pubs.opengroup.org/onlinepubs/009695399/functions/pthread_rwlockattr_getpshared.html
-int pthread_rwlockattr_getpshared(pthread_rwlockattr_t const* __restrict, int* __restrict)
+int pthread_rwlockattr_getpshared(pthread_rwlockattr_t const* __restrict, int* __restrict pshared)
 {
-    VERIFY_NOT_REACHED();
+    *pshared = PTHREAD_PROCESS_PRIVATE;
+    return 0;
 }
 
 // https://pubs.opengroup.org/onlinepubs/009695399/functions/pthread_rwlockattr_init.html
-int pthread_rwlockattr_init(pthread_rwlockattr_t*)
+int pthread_rwlockattr_init(pthread_rwlockattr_t* attr)
 {
-    VERIFY_NOT_REACHED();
+    attr->kind = PTHREAD_RWLOCK_DEFAULT_NP;
+    return 0;
 }
 
 // https://pubs.opengroup.org/onlinepubs/009695399/functions/pthread_rwlockattr_setpshared.html
-int pthread_rwlockattr_setpshared(pthread_rwlockattr_t*, int)
+int pthread_rwlockattr_setpshared(pthread_rwlockattr_t*, int pshared)
 {
-    VERIFY_NOT_REACHED();
+    switch (pshared) {
+    case PTHREAD_PROCESS_PRIVATE:
+        return 0;
+    case PTHREAD_PROCESS_SHARED:
+        // FIXME: Implement process-shared rwlocks, they can't use private futexes.
+        return ENOTSUP;
+    default:
+        return EINVAL;
+    }
+}
+
+// https://man7.org/linux/man-pages/man3/pthread_rwlockattr_setkind_np.3.html
+int pthread_rwlockattr_getkind_np(pthread_rwlockattr_t const* __restrict attr, int* __restrict kind)
+{
+    *kind = attr->kind;
+    return 0;
+}
+
+// https://man7.org/linux/man-pages/man3/pthread_rwlockattr_setkind_np.3.html
+int pthread_rwlockattr_setkind_np(pthread_rwlockattr_t* attr, int kind)
+{
+    // NOTE: Like glibc, PTHREAD_RWLOCK_PREFER_WRITER_NP is accepted but behaves like PTHREAD_RWLOCK_PREFER_READER_NP,
+    //       as a lock that prefers writers can't be read locked recursively.
+    switch (kind) {
+    case PTHREAD_RWLOCK_PREFER_READER_NP:
+    case PTHREAD_RWLOCK_PREFER_WRITER_NP:
+    case PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP:
+        attr->kind = kind;
+        return 0;
+    default:
+        return EINVAL;
+    }
 }
 
 // https://pubs.opengroup.org/onlinepubs/009695399/functions/pthread_atfork.html
@@ -81,9 +81,12 @@ int pthread_setschedparam(pthread_t thread, int policy, const struct sched_param
         0, 0, CLOCK_MONOTONIC_COARSE \
     }
 
-// FIXME: Actually implement this!
-#define PTHREAD_RWLOCK_INITIALIZER \
-    NULL
+#define PTHREAD_RWLOCK_INITIALIZER 0
+
+#define PTHREAD_RWLOCK_PREFER_READER_NP 0
+#define PTHREAD_RWLOCK_PREFER_WRITER_NP 1
+#define PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP 2
+#define PTHREAD_RWLOCK_DEFAULT_NP PTHREAD_RWLOCK_PREFER_READER_NP
 
 #define PTHREAD_KEYS_MAX 64
 #define PTHREAD_DESTRUCTOR_ITERATIONS 4
@@ -143,6 +146,8 @@ int pthread_rwlockattr_destroy(pthread_rwlockattr_t*);
 int pthread_rwlockattr_getpshared(pthread_rwlockattr_t const* __restrict, int* __restrict);
 int pthread_rwlockattr_init(pthread_rwlockattr_t*);
 int pthread_rwlockattr_setpshared(pthread_rwlockattr_t*, int);
+int pthread_rwlockattr_getkind_np(pthread_rwlockattr_t const* __restrict, int* __restrict);
+int pthread_rwlockattr_setkind_np(pthread_rwlockattr_t*, int);
 
 int pthread_atfork(void (*prepare)(void), void (*parent)(void), void (*child)(void));
 
@@ -150,12 +150,21 @@ int pthread_cond_broadcast(pthread_cond_t* cond)
     if (!(value & NEED_TO_WAKE_ALL)) [[likely]]
         return 0;
 
-    AK::atomic_fetch_and(&cond->value, ~(NEED_TO_WAKE_ONE | NEED_TO_WAKE_ALL), AK::memory_order_acquire);
+    value = AK::atomic_fetch_and(&cond->value, ~(NEED_TO_WAKE_ONE | NEED_TO_WAKE_ALL), AK::memory_order_acquire) & ~(NEED_TO_WAKE_ONE | NEED_TO_WAKE_ALL);
 
     pthread_mutex_t* mutex = AK::atomic_load(&cond->mutex, AK::memory_order_relaxed);
     VERIFY(mutex);
 
-    int rc = futex(&cond->value, FUTEX_REQUEUE | FUTEX_PRIVATE_FLAG, -1, nullptr, &mutex->lock, INT_MAX);
-    VERIFY(rc >= 0);
+    // Only one of the waiters could get the mutex anyway, so wake just that one and move everyone else
+    // over to wait for the mutex. The one we woke takes the pessimistic locking path, which makes sure
+    // that whoever unlocks the mutex next wakes the next one of them.
+    for (;;) {
+        int rc = futex(&cond->value, FUTEX_CMP_REQUEUE | FUTEX_PRIVATE_FLAG, 1, reinterpret_cast<timespec const*>(INT_MAX), &mutex->lock, value);
+        if (rc >= 0)
+            break;
+        // Someone started waiting or signaled in the meantime, which they're allowed to do without holding the mutex.
+        VERIFY(errno == EAGAIN);
+        value = AK::atomic_load(&cond->value, AK::memory_order_relaxed);
+    }
     return 0;
 }
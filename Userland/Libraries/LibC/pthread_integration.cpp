@@ -6,6 +6,7 @@
 
 #include <AK/Atomic.h>
 #include <AK/NeverDestroyed.h>
+#include <AK/Platform.h>
 #include <AK/Types.h>
 #include <AK/Vector.h>
 #include <bits/pthread_integration.h>
@@ -104,6 +105,7 @@ int pthread_mutex_init(pthread_mutex_t* mutex, pthread_mutexattr_t const* attrib
     mutex->owner = 0;
     mutex->level = 0;
     mutex->type = attributes ? attributes->type : __PTHREAD_MUTEX_NORMAL;
+    mutex->spin_count = 0;
     return 0;
 }
 
@@ -129,6 +131,74 @@ int pthread_mutex_trylock(pthread_mutex_t* mutex)
     return EBUSY;
 }
 
+// NOTE: Going to sleep in the kernel and getting woken up again costs a lot more than most critical sections take,
+//       so a contended mutex is spun on for a bit first. How long is learned per mutex, from how long it took to
+//       get the mutex the last few times, capped so that we don't burn a lot of CPU time on long critical sections.
+static constexpr int mutex_max_spin_count = 100;
+
+static bool spinning_can_help()
+{
+    // Spinning only makes sense if the owner can make progress on another processor in the meantime.
+    static Atomic<int, AK::memory_order_relaxed> s_processor_count { 0 };
+    int processor_count = s_processor_count;
+    if (processor_count == 0) [[unlikely]] {
+        processor_count = static_cast<int>(max(1l, sysconf(_SC_NPROCESSORS_ONLN)));
+        s_processor_count = processor_count;
+    }
+    return processor_count > 1;
+}
+
+static ALWAYS_INLINE void spin_loop_hint()
+{
+#if ARCH(X86_64)
+    __builtin_ia32_pause();
+#elif ARCH(AARCH64)
+    asm volatile("yield");
+#endif
+}
+
+// Returns true if we got the mutex while spinning.
+static bool mutex_spin(pthread_mutex_t* mutex)
+{
+    int spin_count = AK::atomic_load(&mutex->spin_count, AK::memory_order_relaxed);
+    int max_spins = min(mutex_max_spin_count, spin_count * 2 + 10);
+
+    bool acquired = false;
+    int spins = 0;
+    for (; spins < max_spins; ++spins) {
+        spin_loop_hint();
+        u32 value = AK::atomic_load(&mutex->lock, AK::memory_order_relaxed);
+        if (value == MUTEX_UNLOCKED) {
+            acquired = AK::atomic_compare_exchange_strong(&mutex->lock, value, MUTEX_LOCKED_NO_NEED_TO_WAKE, AK::memory_order_acquire);
+            if (acquired)
+                break;
+        }
+        // Somebody already went to sleep waiting for this mutex, spinning won't get us in front of them.
+        if (value == MUTEX_LOCKED_NEED_TO_WAKE)
+            break;
+    }
+
+    // NOTE: This is only a heuristic, so it doesn't matter if other threads update it at the same time.
+    AK::atomic_store(&mutex->spin_count, spin_count + (spins - spin_count) / 8, AK::memory_order_relaxed);
+    return acquired;
+}
+
+[[gnu::noinline]] static void mutex_lock_slow(pthread_mutex_t* mutex, u32 value)
+{
+    if (value == MUTEX_LOCKED_NO_NEED_TO_WAKE && spinning_can_help() && mutex_spin(mutex))
+        return;
+
+    // Wait, record the fact that we're going to wait, and always
+    // remember to wake the next thread up once we release the mutex.
+    if (value != MUTEX_LOCKED_NEED_TO_WAKE)
+        value = AK::atomic_exchange(&mutex->lock, MUTEX_LOCKED_NEED_TO_WAKE, AK::memory_order_acquire);
+
+    while (value != MUTEX_UNLOCKED) {
+        futex_wait(&mutex->lock, MUTEX_LOCKED_NEED_TO_WAKE, nullptr, 0, false);
+        value = AK::atomic_exchange(&mutex->lock, MUTEX_LOCKED_NEED_TO_WAKE, AK::memory_order_acquire);
+    }
+}
+
 // https://pubs.opengroup.org/onlinepubs/009695399/functions/pthread_mutex_lock.html
 int pthread_mutex_lock(pthread_mutex_t* mutex)
 {
@@ -149,15 +219,8 @@ int pthread_mutex_lock(pthread_mutex_t* mutex)
         }
     }
 
-    // Slow path: wait, record the fact that we're going to wait, and always
-    // remember to wake the next thread up once we release the mutex.
-    if (value != MUTEX_LOCKED_NEED_TO_WAKE)
-        value = AK::atomic_exchange(&mutex->lock, MUTEX_LOCKED_NEED_TO_WAKE, AK::memory_order_acquire);
-
-    while (value != MUTEX_UNLOCKED) {
-        futex_wait(&mutex->lock, MUTEX_LOCKED_NEED_TO_WAKE, nullptr, 0, false);
-        value = AK::atomic_exchange(&mutex->lock, MUTEX_LOCKED_NEED_TO_WAKE, AK::memory_order_acquire);
-    }
+    // Slow path: spin for a bit, then wait.
+    mutex_lock_slow(mutex, value);
 
     if (mutex->type == __PTHREAD_MUTEX_RECURSIVE)
         AK::atomic_store(&mutex->owner, pthread_self(), AK::memory_order_relaxed);
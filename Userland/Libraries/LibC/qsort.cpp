@@ -6,6 +6,7 @@
 
 #include <AK/Assertions.h>
 #include <AK/QuickSort.h>
+#include <AK/Span.h>
 #include <stdlib.h>
 #include <sys/types.h>
 
@@ -34,7 +35,16 @@ inline void swap(SizedObject const& a, SizedObject const& b)
     size_t const size = a.size();
     auto const a_data = reinterpret_cast<char*>(a.data());
     auto const b_data = reinterpret_cast<char*>(b.data());
-    for (auto i = 0u; i < size; ++i) {
+    size_t i = 0;
+    for (; i + sizeof(u64) <= size; i += sizeof(u64)) {
+        u64 a_word;
+        u64 b_word;
+        __builtin_memcpy(&a_word, a_data + i, sizeof(u64));
+        __builtin_memcpy(&b_word, b_data + i, sizeof(u64));
+        __builtin_memcpy(a_data + i, &b_word, sizeof(u64));
+        __builtin_memcpy(b_data + i, &a_word, sizeof(u64));
+    }
+    for (; i < size; ++i) {
         swap(a_data[i], b_data[i]);
     }
 }
@@ -59,6 +69,26 @@ private:
     size_t m_element_size;
 };
 
+// NOTE: Most arrays that get sorted hold ints, pointers or other small, aligned elements.
+//       Sorting those as what they are lets the elements be swapped directly, and not byte by byte.
+template<typename Compare>
+static void sort_sized_objects(void* bot, size_t nmemb, size_t size, Compare compare)
+{
+    auto sort_as = [&]<typename T>() {
+        Span<T> elements { static_cast<T*>(bot), nmemb };
+        AK::dual_pivot_quick_sort(elements, 0, nmemb - 1, [&](T const& a, T const& b) { return compare(&a, &b) < 0; });
+    };
+
+    auto address = reinterpret_cast<FlatPtr>(bot);
+    if (size == sizeof(u32) && address % alignof(u32) == 0)
+        return sort_as.template operator()<u32>();
+    if (size == sizeof(u64) && address % alignof(u64) == 0)
+        return sort_as.template operator()<u64>();
+
+    SizedObjectSlice slice { bot, size };
+    AK::dual_pivot_quick_sort(slice, 0, nmemb - 1, [&](SizedObject const& a, SizedObject const& b) { return compare(a.data(), b.data()) < 0; });
+}
+
 // https://pubs.opengroup.org/onlinepubs/9699919799/functions/qsort.html
 void qsort(void* bot, size_t nmemb, size_t size, int (*compar)(void const*, void const*))
 {
@@ -66,9 +96,7 @@ void qsort(void* bot, size_t nmemb, size_t size, int (*compar)(void const*, void
         return;
     }
 
-    SizedObjectSlice slice { bot, size };
-
-    AK::dual_pivot_quick_sort(slice, 0, nmemb - 1, [=](SizedObject const& a, SizedObject const& b) { return compar(a.data(), b.data()) < 0; });
+    sort_sized_objects(bot, nmemb, size, compar);
 }
 
 void qsort_r(void* bot, size_t nmemb, size_t size, int (*compar)(void const*, void const*, void*), void* arg)
@@ -77,7 +105,5 @@ void qsort_r(void* bot, size_t nmemb, size_t size, int (*compar)(void const*, vo
         return;
     }
 
-    SizedObjectSlice slice { bot, size };
-
-    AK::dual_pivot_quick_sort(slice, 0, nmemb - 1, [=](SizedObject const& a, SizedObject const& b) { return compar(a.data(), b.data(), arg) < 0; });
+    sort_sized_objects(bot, nmemb, size, [=](void const* a, void const* b) { return compar(a, b, arg); });
 }
@@ -42,7 +42,9 @@ int futex(uint32_t* userspace_address, int futex_op, uint32_t value, const struc
 {
     int rc;
     switch (futex_op & FUTEX_CMD_MASK) {
-    case FUTEX_WAKE_OP: {
+    case FUTEX_WAKE_OP:
+    case FUTEX_REQUEUE:
+    case FUTEX_CMP_REQUEUE: {
         // These interpret timeout as a u32 value for val2
         Syscall::SC_futex_params params {
             .userspace_address = userspace_address,
@@ -152,6 +154,18 @@ int emuctl(uintptr_t command, uintptr_t arg0, uintptr_t arg1)
     return syscall(SC_emuctl, command, arg0, arg1);
 }
 
+int io_ring_setup(struct io_ring_params* params)
+{
+    int rc = syscall(SC_io_ring_setup, params);
+    __RETURN_WITH_ERRNO(rc, rc, -1);
+}
+
+int io_ring_enter(int fd, uint32_t to_submit, uint32_t min_complete, uint32_t flags)
+{
+    int rc = syscall(SC_io_ring_enter, fd, to_submit, min_complete, flags);
+    __RETURN_WITH_ERRNO(rc, rc, -1);
+}
+
 int serenity_open(char const* path, size_t path_length, int options, ...)
 {
     if (!path) {
@@ -70,6 +70,11 @@ uint16_t internet_checksum(void const* ptr, size_t count);
 
 int emuctl(uintptr_t command, uintptr_t arg0, uintptr_t arg1);
 
+// See <Kernel/API/IORing.h> for the structures and constants used by these.
+struct io_ring_params;
+int io_ring_setup(struct io_ring_params* params);
+int io_ring_enter(int fd, uint32_t to_submit, uint32_t min_complete, uint32_t flags);
+
 int serenity_open(char const* path, size_t path_length, int options, ...);
 
 __END_DECLS
@@ -5,10 +5,12 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/BuiltinWrappers.h>
 #include <AK/Format.h>
 #include <AK/MemMem.h>
 #include <AK/Memory.h>
 #include <AK/Platform.h>
+#include <AK/SIMD.h>
 #include <AK/StdLibExtras.h>
 #include <AK/Types.h>
 #include <assert.h>
@@ -19,6 +21,49 @@
 #include <stdlib.h>
 #include <string.h>
 
+#if ARCH(X86_64)
+// NOTE: SSE2 is part of the x86-64 baseline, so we don't need to check for it at runtime.
+//       The string functions read whole 16-byte aligned blocks, which never cross a page boundary.
+//       So even though they may read past the end of the string, they can never fault because of that.
+using AK::SIMD::c8x16;
+
+ALWAYS_INLINE static c8x16 load_block(void const* ptr)
+{
+    c8x16 block;
+    __builtin_memcpy(&block, ptr, sizeof(block));
+    return block;
+}
+
+// Returns a bit mask with bit N set if the Nth byte of the block matches.
+ALWAYS_INLINE static u32 matching_bytes(c8x16 block, c8x16 needle)
+{
+    return __builtin_ia32_pmovmskb128(static_cast<c8x16>(block == needle));
+}
+
+static char const* find_byte_or_terminator(char const* str, char ch)
+{
+    c8x16 const zero {};
+    c8x16 const needle = zero + ch;
+
+    auto offset = reinterpret_cast<FlatPtr>(str) & 15;
+    auto const* block = str - offset;
+    auto matches = [&](char const* block) {
+        auto data = load_block(block);
+        return matching_bytes(data, zero) | matching_bytes(data, needle);
+    };
+
+    u32 mask = matches(block) >> offset;
+    if (mask)
+        return str + count_trailing_zeroes(mask);
+    for (;;) {
+        block += 16;
+        mask = matches(block);
+        if (mask)
+            return block + count_trailing_zeroes(mask);
+    }
+}
+#endif
+
 extern "C" {
 
 // https://pubs.opengroup.org/onlinepubs/9699919799/functions/strspn.html
@@ -52,10 +97,14 @@ size_t strcspn(char const* s, char const* reject)
 // https://pubs.opengroup.org/onlinepubs/9699919799/functions/strlen.html
 size_t strlen(char const* str)
 {
+#if ARCH(X86_64)
+    return find_byte_or_terminator(str, '\0') - str;
+#else
     size_t len = 0;
     while (*(str++))
         ++len;
     return len;
+#endif
 }
 
 // https://pubs.opengroup.org/onlinepubs/9699919799/functions/strnlen.html
@@ -119,6 +168,15 @@ int memcmp(void const* v1, void const* v2, size_t n)
 {
     auto* s1 = (uint8_t const*)v1;
     auto* s2 = (uint8_t const*)v2;
+#if ARCH(X86_64)
+    for (; n >= 16; s1 += 16, s2 += 16, n -= 16) {
+        u32 mask = matching_bytes(load_block(s1), load_block(s2));
+        if (mask != 0xffff) {
+            auto index = count_trailing_zeroes(~mask);
+            return s1[index] < s2[index] ? -1 : 1;
+        }
+    }
+#endif
     while (n-- > 0) {
         if (*s1++ != *s2++)
             return s1[-1] < s2[-1] ? -1 : 1;
@@ -134,22 +192,17 @@ int timingsafe_memcmp(void const* b1, void const* b2, size_t len)
 }
 
 // https://pubs.opengroup.org/onlinepubs/9699919799/functions/memcpy.html
+// For x86-64, an optimized ASM implementation is found in ./arch/x86_64/memcpy.S
+#if !ARCH(X86_64)
 void* memcpy(void* dest_ptr, void const* src_ptr, size_t n)
 {
-#if ARCH(X86_64)
-    void* original_dest = dest_ptr;
-    asm volatile(
-        "rep movsb"
-        : "+D"(dest_ptr), "+S"(src_ptr), "+c"(n)::"memory");
-    return original_dest;
-#else
     u8* pd = (u8*)dest_ptr;
     u8 const* ps = (u8 const*)src_ptr;
     for (; n--;)
         *pd++ = *ps++;
     return dest_ptr;
-#endif
 }
+#endif
 
 // https://pubs.opengroup.org/onlinepubs/9699919799/functions/memccpy.html
 void* memccpy(void* dest_ptr, void const* src_ptr, int c, size_t n)
@@ -180,13 +233,17 @@ void* memset(void* dest_ptr, int c, size_t n)
 // https://pubs.opengroup.org/onlinepubs/9699919799/functions/memmove.html
 void* memmove(void* dest, void const* src, size_t n)
 {
-    if (dest < src)
-        return memcpy(dest, src, n);
-    if (((FlatPtr)dest - (FlatPtr)src) >= n)
+    // NOTE: memcpy() doesn't promise to copy in any particular order, so we can only use it if the buffers don't overlap.
+    if (((FlatPtr)dest - (FlatPtr)src) >= n && ((FlatPtr)src - (FlatPtr)dest) >= n)
         return memcpy(dest, src, n);
 
     u8* pd = (u8*)dest;
     u8 const* ps = (u8 const*)src;
+    if (dest < src) {
+        for (; n--;)
+            *pd++ = *ps++;
+        return dest;
+    }
     for (pd += n, ps += n; n--;)
         *--pd = *--ps;
     return dest;
@@ -249,12 +306,17 @@ size_t strlcpy(char* dest, char const* src, size_t n)
 char* strchr(char const* str, int c)
 {
     char ch = c;
+#if ARCH(X86_64)
+    auto const* found = find_byte_or_terminator(str, ch);
+    return *found == ch ? const_cast<char*>(found) : nullptr;
+#else
     for (;; ++str) {
         if (*str == ch)
             return const_cast<char*>(str);
         if (!*str)
             return nullptr;
     }
+#endif
 }
 
 // https://pubs.opengroup.org/onlinepubs/9699959399/functions/index.html
@@ -267,10 +329,14 @@ char* index(char const* str, int c)
 char* strchrnul(char const* str, int c)
 {
     char ch = c;
+#if ARCH(X86_64)
+    return const_cast<char*>(find_byte_or_terminator(str, ch));
+#else
     for (;; ++str) {
         if (*str == ch || !*str)
             return const_cast<char*>(str);
     }
+#endif
 }
 
 // https://pubs.opengroup.org/onlinepubs/9699919799/functions/memchr.html
@@ -278,7 +344,15 @@ void* memchr(void const* ptr, int c, size_t size)
 {
     char ch = c;
     auto* cptr = (char const*)ptr;
-    for (size_t i = 0; i < size; ++i) {
+    size_t i = 0;
+#if ARCH(X86_64)
+    c8x16 const needle = c8x16 {} + ch;
+    for (; i + 16 <= size; i += 16) {
+        if (u32 mask = matching_bytes(load_block(cptr + i), needle))
+            return const_cast<char*>(cptr + i + count_trailing_zeroes(mask));
+    }
+#endif
+    for (; i < size; ++i) {
         if (cptr[i] == ch)
             return const_cast<char*>(cptr + i);
     }
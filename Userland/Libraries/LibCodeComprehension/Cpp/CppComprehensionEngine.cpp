@@ -27,6 +27,7 @@ CppComprehensionEngine::CppComprehensionEngine(FileDB const& filedb)
 
 CppComprehensionEngine::DocumentData const* CppComprehensionEngine::get_or_create_document_data(ByteString const& file)
 {
+    reparse_edited_documents();
     auto absolute_path = filedb().to_absolute_path(file);
     if (!m_documents.contains(absolute_path)) {
         set_document_data(absolute_path, create_document_data_for(absolute_path));
@@ -56,6 +57,22 @@ OwnPtr<CppComprehensionEngine::DocumentData> CppComprehensionEngine::create_docu
     return create_document_data(move(document.value()), file);
 }
 
+void CppComprehensionEngine::reparse_edited_documents()
+{
+    if (m_edited_documents.is_empty())
+        return;
+
+    // Parsing a document parses its headers through get_or_create_document_data(), so take the whole set first.
+    auto edited_documents = move(m_edited_documents);
+    for (auto& file : edited_documents) {
+        auto text = filedb().get_or_read_from_filesystem(file);
+        auto const* document = get_document_data(file);
+        if (document && text.has_value() && document->text() == text.value())
+            continue;
+        set_document_data(file, create_document_data_for(file));
+    }
+}
+
 void CppComprehensionEngine::set_document_data(ByteString const& file, OwnPtr<DocumentData>&& data)
 {
     m_documents.set(filedb().to_absolute_path(file), move(data));
@@ -393,7 +410,8 @@ ByteString CppComprehensionEngine::document_path_from_include_path(StringView in
 
 void CppComprehensionEngine::on_edit(ByteString const& file)
 {
-    set_document_data(file, create_document_data_for(file));
+    // Every keystroke ends up here, so we only reparse once the document is actually queried.
+    m_edited_documents.set(filedb().to_absolute_path(file));
 }
 
 void CppComprehensionEngine::file_opened([[maybe_unused]] ByteString const& file)
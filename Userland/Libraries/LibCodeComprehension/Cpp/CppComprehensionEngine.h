@@ -117,6 +117,7 @@ private:
     DocumentData const* get_document_data(ByteString const& file) const;
     DocumentData const* get_or_create_document_data(ByteString const& file);
     void set_document_data(ByteString const& file, OwnPtr<DocumentData>&& data);
+    void reparse_edited_documents();
 
     OwnPtr<DocumentData> create_document_data_for(ByteString const& file);
     ByteString document_path_from_include_path(StringView include_path) const;
@@ -151,6 +152,9 @@ private:
     // A document is added to this set when we start processing it (e.g because it was #included) and removed when we're done.
     // We use this to prevent circular #includes from looping indefinitely.
     HashTable<ByteString> m_unfinished_documents;
+
+    // Documents that were edited since they were last parsed. They are reparsed the next time any document is requested.
+    HashTable<ByteString> m_edited_documents;
 };
 
 template<typename Func>
@@ -71,6 +71,7 @@ static void test_find_array_variable_declaration_single_empty();
 static void test_find_array_variable_declaration_double();
 static void test_complete_includes();
 static void test_parameters_hint();
+static void test_complete_after_edit();
 
 int run_tests()
 {
@@ -83,6 +84,7 @@ int run_tests()
     RUN(test_find_array_variable_declaration_double());
     RUN(test_complete_includes());
     RUN(test_parameters_hint());
+    RUN(test_complete_after_edit());
     return 0;
 }
 
@@ -264,6 +266,25 @@ void test_parameters_hint()
     PASS;
 }
 
+void test_complete_after_edit()
+{
+    I_TEST(Complete After Edit)
+    FileDB filedb;
+    filedb.add("complete_after_edit.cpp", "int main()\n{\n    int myvar1;\n    myv\n}\n");
+    CodeComprehension::Cpp::CppComprehensionEngine engine(filedb);
+    auto suggestions = engine.get_suggestions("complete_after_edit.cpp", { 3, 7 });
+    if (suggestions.size() != 1 || suggestions[0].completion != "myvar1")
+        FAIL("wrong results before edit");
+
+    filedb.add("complete_after_edit.cpp", "int main()\n{\n    int myvar2;\n    myv\n}\n");
+    engine.on_edit("complete_after_edit.cpp");
+    suggestions = engine.get_suggestions("complete_after_edit.cpp", { 3, 7 });
+    if (suggestions.size() != 1 || suggestions[0].completion != "myvar2")
+        FAIL("wrong results after edit");
+
+    PASS;
+}
+
 ErrorOr<int> serenity_main(Main::Arguments)
 {
     return run_tests();
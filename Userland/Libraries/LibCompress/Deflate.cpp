@@ -7,8 +7,8 @@
 
 #include <AK/Array.h>
 #include <AK/Assertions.h>
-#include <AK/BinarySearch.h>
 #include <AK/MemoryStream.h>
+#include <AK/ScopeGuard.h>
 #include <string.h>
 
 #include <LibCompress/Deflate.h>
@@ -24,29 +24,15 @@ static constexpr int EndOfBlock = 256;
 
 CanonicalCode const& CanonicalCode::fixed_literal_codes()
 {
-    static CanonicalCode code;
-    static bool initialized = false;
-
-    if (initialized)
-        return code;
-
-    code = MUST(CanonicalCode::from_bytes(fixed_literal_bit_lengths));
-    initialized = true;
-
+    // NOTE: This is a function-local static so that initializing it is thread-safe, as GzipCompressor can compress on several threads.
+    static CanonicalCode const code = MUST(CanonicalCode::from_bytes(fixed_literal_bit_lengths));
     return code;
 }
 
 CanonicalCode const& CanonicalCode::fixed_distance_codes()
 {
-    static CanonicalCode code;
-    static bool initialized = false;
-
-    if (initialized)
-        return code;
-
-    code = MUST(CanonicalCode::from_bytes(fixed_distance_bit_lengths));
-    initialized = true;
-
+    // NOTE: This is a function-local static so that initializing it is thread-safe, as GzipCompressor can compress on several threads.
+    static CanonicalCode const code = MUST(CanonicalCode::from_bytes(fixed_distance_bit_lengths));
     return code;
 }
 
@@ -83,11 +69,13 @@ ErrorOr<CanonicalCode> CanonicalCode::from_bytes(ReadonlyBytes bytes)
         u16 symbol_value { 0 };
         u16 code_length { 0 };
     };
-    Array<PrefixCode, 1 << CanonicalCode::max_allowed_prefixed_code_length> prefix_codes;
-    size_t number_of_prefix_codes = 0;
+    // NOTE: The codes are generated in canonical order, which is also the lexicographic order of the codes themselves.
+    //       This means that all codes that share a prefix are next to each other, with the longest one last.
+    Vector<PrefixCode, 288> prefix_codes;
+    size_t max_code_length = 0;
 
     auto next_code = 0;
-    for (size_t code_length = 1; code_length <= 15; ++code_length) {
+    for (size_t code_length = 1; code_length <= CanonicalCode::max_code_length; ++code_length) {
         next_code <<= 1;
         auto start_bit = 1 << code_length;
 
@@ -98,20 +86,8 @@ ErrorOr<CanonicalCode> CanonicalCode::from_bytes(ReadonlyBytes bytes)
             if (next_code > start_bit)
                 return Error::from_string_literal("Failed to decode code lengths");
 
-            if (code_length <= CanonicalCode::max_allowed_prefixed_code_length) {
-                if (number_of_prefix_codes >= prefix_codes.size())
-                    return Error::from_string_literal("Invalid canonical Huffman code");
-
-                auto& prefix_code = prefix_codes[number_of_prefix_codes++];
-                prefix_code.symbol_code = next_code;
-                prefix_code.symbol_value = symbol;
-                prefix_code.code_length = code_length;
-
-                code.m_max_prefixed_code_length = code_length;
-            } else {
-                code.m_symbol_codes.append(start_bit | next_code);
-                code.m_symbol_values.append(symbol);
-            }
+            TRY(prefix_codes.try_append({ static_cast<u16>(next_code), static_cast<u16>(symbol), static_cast<u16>(code_length) }));
+            max_code_length = code_length;
 
             if (code.m_bit_codes.size() < symbol + 1) {
                 TRY(code.m_bit_codes.try_resize(symbol + 1));
@@ -127,41 +103,84 @@ ErrorOr<CanonicalCode> CanonicalCode::from_bytes(ReadonlyBytes bytes)
     if (next_code != (1 << 15))
         return Error::from_string_literal("Failed to decode code lengths");
 
-    for (auto [symbol_code, symbol_value, code_length] : prefix_codes) {
-        if (code_length == 0 || code_length > CanonicalCode::max_allowed_prefixed_code_length)
-            break;
+    code.m_max_prefixed_code_length = min(max_code_length, CanonicalCode::max_allowed_prefixed_code_length);
+    auto const prefix_length = code.m_max_prefixed_code_length;
+
+    for (size_t i = 0; i < prefix_codes.size();) {
+        auto [symbol_code, symbol_value, code_length] = prefix_codes[i];
 
-        auto shift = code.m_max_prefixed_code_length - code_length;
-        symbol_code <<= shift;
+        if (code_length <= prefix_length) {
+            // Every index that starts with this code decodes to its symbol.
+            auto index = fast_reverse16(symbol_code, code_length);
+            for (size_t j = 0; j < (1u << (prefix_length - code_length)); ++j)
+                code.m_prefix_table[index | (j << code_length)] = PrefixTableEntry { symbol_value, static_cast<u8>(code_length) };
+            ++i;
+            continue;
+        }
 
-        for (size_t j = 0; j < (1u << shift); ++j) {
-            auto index = fast_reverse16(symbol_code + j, code.m_max_prefixed_code_length);
-            code.m_prefix_table[index] = PrefixTableEntry { symbol_value, code_length };
+        // Longer codes are grouped by their first prefix_length bits, and every group gets a sub-table that is large enough for its longest code.
+        auto prefix = symbol_code >> (code_length - prefix_length);
+        auto group_end = i;
+        while (group_end < prefix_codes.size() && (prefix_codes[group_end].symbol_code >> (prefix_codes[group_end].code_length - prefix_length)) == prefix)
+            ++group_end;
+
+        auto secondary_table_bits = prefix_codes[group_end - 1].code_length - prefix_length;
+        auto secondary_table_offset = code.m_secondary_table.size();
+        TRY(code.m_secondary_table.try_resize(secondary_table_offset + (1u << secondary_table_bits)));
+        code.m_prefix_table[fast_reverse16(prefix, prefix_length)] = PrefixTableEntry { static_cast<u16>(secondary_table_offset), 0, static_cast<u8>(secondary_table_bits) };
+
+        for (; i < group_end; ++i) {
+            auto const& long_code = prefix_codes[i];
+            auto suffix_length = long_code.code_length - prefix_length;
+            auto suffix = fast_reverse16(long_code.symbol_code & ((1u << suffix_length) - 1), suffix_length);
+            for (size_t j = 0; j < (1u << (secondary_table_bits - suffix_length)); ++j)
+                code.m_secondary_table[secondary_table_offset + (suffix | (j << suffix_length))] = PrefixTableEntry { long_code.symbol_value, static_cast<u8>(long_code.code_length) };
         }
     }
 
     return code;
 }
 
+ALWAYS_INLINE CanonicalCode::PrefixTableEntry const& CanonicalCode::lookup(size_t bits) const
+{
+    auto const& entry = m_prefix_table[bits & ((1u << m_max_prefixed_code_length) - 1)];
+    if (entry.code_length != 0)
+        return entry;
+
+    auto secondary_index = (bits >> m_max_prefixed_code_length) & ((1u << entry.secondary_table_bits) - 1);
+    return m_secondary_table[entry.symbol_value + secondary_index];
+}
+
 ErrorOr<u32> CanonicalCode::read_symbol(LittleEndianInputBitStream& stream) const
 {
-    auto prefix = TRY(stream.peek_bits<size_t>(m_max_prefixed_code_length));
+    // Near the end of the stream, there may not be enough bits left to fill the table index, even though the symbol itself is shorter.
+    auto prefix_or_error = stream.peek_bits<size_t>(m_max_prefixed_code_length);
+    if (prefix_or_error.is_error())
+        return read_symbol_bit_by_bit(stream);
 
-    if (auto [symbol_value, code_length] = m_prefix_table[prefix]; code_length != 0) {
+    if (auto [symbol_value, code_length, secondary_table_bits] = m_prefix_table[prefix_or_error.value()]; code_length != 0) {
         stream.discard_previously_peeked_bits(code_length);
         return symbol_value;
-    }
-
-    auto code_bits = TRY(stream.read_bits<u16>(m_max_prefixed_code_length));
-    code_bits = fast_reverse16(code_bits, m_max_prefixed_code_length);
-    code_bits |= 1 << m_max_prefixed_code_length;
+    } else {
+        auto code_bits_or_error = stream.peek_bits<size_t>(m_max_prefixed_code_length + secondary_table_bits);
+        if (code_bits_or_error.is_error())
+            return read_symbol_bit_by_bit(stream);
 
-    for (size_t i = m_max_prefixed_code_length; i < 16; ++i) {
-        size_t index;
-        if (binary_search(m_symbol_codes.span(), code_bits, &index))
-            return m_symbol_values[index];
+        auto const& entry = lookup(code_bits_or_error.value());
+        stream.discard_previously_peeked_bits(entry.code_length);
+        return entry.symbol_value;
+    }
+}
 
-        code_bits = code_bits << 1 | TRY(stream.read_bit());
+ErrorOr<u32> CanonicalCode::read_symbol_bit_by_bit(LittleEndianInputBitStream& stream) const
+{
+    // The bits we don't have yet are zero in the table index, so an entry that is no longer than the bits we do have is the right one.
+    for (size_t length = 1; length <= max_code_length; ++length) {
+        auto bits = TRY(stream.peek_bits<size_t>(length));
+        if (auto const& entry = lookup(bits); entry.code_length != 0 && entry.code_length <= length) {
+            stream.discard_previously_peeked_bits(entry.code_length);
+            return entry.symbol_value;
+        }
     }
 
     return Error::from_string_literal("Symbol exceeds maximum symbol number");
@@ -179,38 +198,55 @@ ErrorOr<bool> DeflateDecompressor::CompressedBlock::try_read_more()
     if (m_eof == true)
         return false;
 
-    auto const symbol = TRY(m_literal_codes.read_symbol(*m_decompressor.m_input_stream));
+    // Runs of literals are collected here, so they can be written to the output buffer in one go.
+    Array<u8, max_back_reference_length> literals;
+    size_t literal_count = 0;
+    auto flush_literals = [&] {
+        auto written_length = m_decompressor.m_output_buffer.write(literals.span().trim(literal_count));
+        VERIFY(written_length == literal_count);
+        literal_count = 0;
+    };
+    // The literals that were decoded before running out of input are kept as well.
+    ScopeGuard flush_literals_on_exit = [&] { flush_literals(); };
 
-    if (symbol >= 286)
-        return Error::from_string_literal("Invalid deflate literal/length symbol");
+    // Decode symbols for as long as the output buffer is guaranteed to have space for them, instead of returning to the caller after each one.
+    while (m_decompressor.m_output_buffer.empty_space() >= max_back_reference_length + literal_count) {
+        auto const symbol = TRY(m_literal_codes.read_symbol(*m_decompressor.m_input_stream));
 
-    if (symbol < EndOfBlock) {
-        u8 byte_symbol = symbol;
-        m_decompressor.m_output_buffer.write({ &byte_symbol, sizeof(byte_symbol) });
-        return true;
-    }
+        if (symbol >= 286)
+            return Error::from_string_literal("Invalid deflate literal/length symbol");
 
-    if (symbol == EndOfBlock) {
-        m_eof = true;
-        return false;
-    }
+        if (symbol < EndOfBlock) {
+            literals[literal_count++] = symbol;
+            if (literal_count == literals.size())
+                flush_literals();
+            continue;
+        }
 
-    if (!m_distance_codes.has_value())
-        return Error::from_string_literal("Distance codes have not been initialized");
+        flush_literals();
 
-    auto const length = TRY(m_decompressor.decode_length(symbol));
-    auto const distance_symbol = TRY(m_distance_codes.value().read_symbol(*m_decompressor.m_input_stream));
-    if (distance_symbol >= 30)
-        return Error::from_string_literal("Invalid deflate distance symbol");
+        if (symbol == EndOfBlock) {
+            m_eof = true;
+            break;
+        }
 
-    auto const distance = TRY(m_decompressor.decode_distance(distance_symbol));
+        if (!m_distance_codes.has_value())
+            return Error::from_string_literal("Distance codes have not been initialized");
 
-    auto copied_length = TRY(m_decompressor.m_output_buffer.copy_from_seekback(distance, length));
+        auto const length = TRY(m_decompressor.decode_length(symbol));
+        auto const distance_symbol = TRY(m_distance_codes.value().read_symbol(*m_decompressor.m_input_stream));
+        if (distance_symbol >= 30)
+            return Error::from_string_literal("Invalid deflate distance symbol");
 
-    // TODO: What should we do if the output buffer is full?
-    VERIFY(copied_length == length);
+        auto const distance = TRY(m_decompressor.decode_distance(distance_symbol));
 
-    return true;
+        auto copied_length = TRY(m_decompressor.m_output_buffer.copy_from_seekback(distance, length));
+        VERIFY(copied_length == length);
+    }
+    flush_literals();
+
+    // If we reached the end of the block, the caller still has to read what we decoded up to that point.
+    return !m_eof || m_decompressor.m_output_buffer.used_space() > 0;
 }
 
 DeflateDecompressor::UncompressedBlock::UncompressedBlock(DeflateDecompressor& decompressor, size_t length)
@@ -257,6 +293,23 @@ DeflateDecompressor::~DeflateDecompressor()
         m_uncompressed_block.~UncompressedBlock();
 }
 
+template<typename Block>
+ErrorOr<bool> DeflateDecompressor::try_read_more(Block& block)
+{
+    if (m_deferred_error.has_value())
+        return Error::copy(*m_deferred_error);
+    return block.try_read_more();
+}
+
+ErrorOr<Bytes> DeflateDecompressor::defer_error(Error error, Bytes read_bytes)
+{
+    // Truncated input still yields everything that could be decoded before it ran out.
+    m_deferred_error = Error::copy(error);
+    if (read_bytes.is_empty())
+        return error;
+    return read_bytes;
+}
+
 ErrorOr<Bytes> DeflateDecompressor::read_some(Bytes bytes)
 {
     size_t total_read = 0;
@@ -309,7 +362,14 @@ ErrorOr<Bytes> DeflateDecompressor::read_some(Bytes bytes)
         if (m_state == State::ReadingCompressedBlock) {
             auto nread = m_output_buffer.read(slice).size();
 
-            while (nread < slice.size() && TRY(m_compressed_block.try_read_more())) {
+            while (nread < slice.size()) {
+                auto read_more = try_read_more(m_compressed_block);
+                if (read_more.is_error()) {
+                    nread += m_output_buffer.read(slice.slice(nread)).size();
+                    return defer_error(read_more.release_error(), bytes.slice(0, total_read + nread));
+                }
+                if (!read_more.value())
+                    break;
                 nread += m_output_buffer.read(slice.slice(nread)).size();
             }
 
@@ -326,7 +386,14 @@ ErrorOr<Bytes> DeflateDecompressor::read_some(Bytes bytes)
         if (m_state == State::ReadingUncompressedBlock) {
             auto nread = m_output_buffer.read(slice).size();
 
-            while (nread < slice.size() && TRY(m_uncompressed_block.try_read_more())) {
+            while (nread < slice.size()) {
+                auto read_more = try_read_more(m_uncompressed_block);
+                if (read_more.is_error()) {
+                    nread += m_output_buffer.read(slice.slice(nread)).size();
+                    return defer_error(read_more.release_error(), bytes.slice(0, total_read + nread));
+                }
+                if (!read_more.value())
+                    break;
                 nread += m_output_buffer.read(slice.slice(nread)).size();
             }
 
@@ -478,6 +545,8 @@ DeflateCompressor::DeflateCompressor(NonnullOwnPtr<LittleEndianOutputBitStream>
 {
     m_symbol_frequencies.fill(0);
     m_distance_frequencies.fill(0);
+    for (auto& slot : m_hash_head)
+        slot = empty_slot;
 }
 
 DeflateCompressor::~DeflateCompressor()
@@ -557,7 +626,7 @@ size_t DeflateCompressor::find_back_match(size_t start, u16 hash, size_t previou
         previous_match_length = min_match_length - 1; // we only care about matches that are at least min_match_length long
     if (previous_match_length >= maximum_match_length)
         return 0; // we can't improve a maximum length match
-    if (previous_match_length >= m_compression_constants.max_lazy_length)
+    if (m_compression_constants.lazy_matching && previous_match_length >= m_compression_constants.max_lazy_length)
         return 0; // the previous match is already pretty, we shouldn't waste another full search
     if (previous_match_length >= m_compression_constants.good_match_length)
         max_chain_length /= 4; // we already have a pretty good much, so do a shorter search
@@ -569,8 +638,8 @@ size_t DeflateCompressor::find_back_match(size_t start, u16 hash, size_t previou
             break; // no remaining candidates
 
         VERIFY(candidate < start);
-        if (start - candidate > window_size)
-            break; // outside the window
+        if (start - candidate > max_back_reference_distance)
+            break; // further away than a back reference can reach
 
         auto match_length = compare_match_candidate(start, candidate, previous_match_length, maximum_match_length);
 
@@ -579,11 +648,11 @@ size_t DeflateCompressor::find_back_match(size_t start, u16 hash, size_t previou
             match_position = candidate;
             previous_match_length = match_length;
 
-            if (match_length == maximum_match_length)
-                return match_length; // bail if we got the maximum possible length
+            if (match_length >= min(maximum_match_length, m_compression_constants.great_match_length))
+                return match_length; // bail if we got the maximum possible length, or one that is good enough
         }
 
-        candidate = m_hash_prev[candidate % window_size];
+        candidate = m_hash_prev[candidate];
     }
     if (!match_found)
         return 0;                 // we didn't find any matches
@@ -595,34 +664,49 @@ ALWAYS_INLINE u8 DeflateCompressor::distance_to_base(u16 distance)
     return (distance <= 256) ? distance_to_base_lo[distance - 1] : distance_to_base_hi[(distance - 1) >> 7];
 }
 
-void DeflateCompressor::lz77_compress_block()
+void DeflateCompressor::insert_hash(size_t position, u16 hash)
 {
-    for (auto& slot : m_hash_head) { // initialize chained hash table
-        slot = empty_slot;
-    }
+    m_hash_prev[position] = m_hash_head[hash];
+    m_hash_head[hash] = position;
+}
 
-    auto insert_hash = [&](auto pos, auto hash) {
-        auto window_pos = pos % window_size;
-        m_hash_prev[window_pos] = m_hash_head[hash];
-        m_hash_head[hash] = window_pos;
+// Moves the hash chains along with the rolling window, dropping the positions that fall out of it.
+void DeflateCompressor::slide_hash_table()
+{
+    auto slide = [](u16 position) -> u16 {
+        return (position == empty_slot || position < block_size) ? empty_slot : position - block_size;
     };
+    for (auto& slot : m_hash_head)
+        slot = slide(slot);
+    for (size_t i = 0; i < block_size; i++)
+        m_hash_prev[i] = slide(m_hash_prev[i + block_size]);
+}
 
-    auto emit_literal = [&](auto literal) {
-        VERIFY(m_pending_symbol_size <= block_size + 1);
-        auto index = m_pending_symbol_size++;
-        m_symbol_buffer[index].distance = 0;
-        m_symbol_buffer[index].literal = literal;
-        m_symbol_frequencies[literal]++;
-    };
+ALWAYS_INLINE void DeflateCompressor::emit_literal(u16 literal)
+{
+    VERIFY(m_pending_symbol_size <= block_size + 1);
+    auto index = m_pending_symbol_size++;
+    m_symbol_buffer[index].distance = 0;
+    m_symbol_buffer[index].literal = literal;
+    m_symbol_frequencies[literal]++;
+}
 
-    auto emit_back_reference = [&](auto distance, auto length) {
-        VERIFY(m_pending_symbol_size <= block_size + 1);
-        auto index = m_pending_symbol_size++;
-        m_symbol_buffer[index].distance = distance;
-        m_symbol_buffer[index].length = length;
-        m_symbol_frequencies[length_to_symbol[length]]++;
-        m_distance_frequencies[distance_to_base(distance)]++;
-    };
+ALWAYS_INLINE void DeflateCompressor::emit_back_reference(u16 distance, u16 length)
+{
+    VERIFY(m_pending_symbol_size <= block_size + 1);
+    auto index = m_pending_symbol_size++;
+    m_symbol_buffer[index].distance = distance;
+    m_symbol_buffer[index].length = length;
+    m_symbol_frequencies[length_to_symbol[length]]++;
+    m_distance_frequencies[distance_to_base(distance)]++;
+}
+
+void DeflateCompressor::lz77_compress_block()
+{
+    if (!m_compression_constants.lazy_matching) {
+        lz77_compress_block_greedy();
+        return;
+    }
 
     size_t previous_match_length = 0;
     size_t previous_match_position = 0;
@@ -636,7 +720,7 @@ void DeflateCompressor::lz77_compress_block()
         auto hash = hash_sequence(&m_rolling_window[current_position]);
         size_t match_position;
         auto match_length = find_back_match(current_position, hash, previous_match_length,
-            min(m_compression_constants.great_match_length, block_end - current_position), match_position);
+            min(max_match_length, block_end - current_position), match_position);
 
         insert_hash(current_position, hash);
 
@@ -680,6 +764,40 @@ void DeflateCompressor::lz77_compress_block()
     }
 }
 
+// Like zlib's deflate_fast(): every match is taken as soon as it is found, and the bytes covered by long matches are not hashed at all.
+void DeflateCompressor::lz77_compress_block_greedy()
+{
+    VERIFY(m_compression_constants.great_match_length <= max_match_length);
+
+    auto block_end = block_size + m_pending_block_size;
+    auto last_hashable_position = block_end - min_match_length + 1;
+    size_t current_position = block_size;
+    while (current_position < last_hashable_position) {
+        auto hash = hash_sequence(&m_rolling_window[current_position]);
+        size_t match_position;
+        auto match_length = find_back_match(current_position, hash, 0,
+            min(max_match_length, block_end - current_position), match_position);
+
+        insert_hash(current_position, hash);
+
+        if (match_length == 0) {
+            emit_literal(m_rolling_window[current_position++]);
+            continue;
+        }
+
+        emit_back_reference(current_position - match_position, match_length);
+        if (match_length <= m_compression_constants.max_lazy_length) {
+            for (size_t j = current_position + 1; j < min(current_position + match_length, last_hashable_position); j++)
+                insert_hash(j, hash_sequence(&m_rolling_window[j]));
+        }
+        current_position += match_length;
+    }
+
+    while (current_position < block_end) {
+        emit_literal(m_rolling_window[current_position++]);
+    }
+}
+
 size_t DeflateCompressor::huffman_block_length(Array<u8, max_huffman_literals> const& literal_bit_lengths, Array<u8, max_huffman_distances> const& distance_bit_lengths)
 {
     size_t length = 0;
@@ -946,6 +1064,7 @@ ErrorOr<void> DeflateCompressor::flush()
     m_distance_frequencies.fill(0);
     // On the final block this copy will potentially produce an invalid search window, but since its the final block we dont care
     pending_block().copy_trimmed_to({ m_rolling_window, block_size });
+    slide_hash_table();
 
     return {};
 }
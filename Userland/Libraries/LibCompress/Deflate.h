@@ -31,19 +31,24 @@ public:
     static ErrorOr<CanonicalCode> from_bytes(ReadonlyBytes);
 
 private:
-    static constexpr size_t max_allowed_prefixed_code_length = 8;
+    static constexpr size_t max_allowed_prefixed_code_length = 10;
+    static constexpr size_t max_code_length = 15;
 
+    // For codes that are longer than the prefix table index, the prefix table entry has a code length of zero,
+    // and refers to a sub-table of the secondary table, which is indexed by the next secondary_table_bits bits.
     struct PrefixTableEntry {
         u16 symbol_value { 0 };
-        u16 code_length { 0 };
+        u8 code_length { 0 };
+        u8 secondary_table_bits { 0 };
     };
 
-    // Decompression - indexed by code
-    Vector<u16, 286> m_symbol_codes;
-    Vector<u16, 286> m_symbol_values;
+    PrefixTableEntry const& lookup(size_t bits) const;
+    ErrorOr<u32> read_symbol_bit_by_bit(LittleEndianInputBitStream&) const;
 
+    // Decompression - indexed by the next bits of the stream
     Array<PrefixTableEntry, 1 << max_allowed_prefixed_code_length> m_prefix_table {};
     size_t m_max_prefixed_code_length { 0 };
+    Vector<PrefixTableEntry> m_secondary_table;
 
     // Compression - indexed by symbol
     // Deflate uses a maximum of 288 symbols (maximum of 32 for distances),
@@ -115,10 +120,17 @@ private:
     ErrorOr<u32> decode_distance(u32);
     ErrorOr<void> decode_codes(CanonicalCode& literal_code, Optional<CanonicalCode>& distance_code);
 
+    template<typename Block>
+    ErrorOr<bool> try_read_more(Block&);
+    ErrorOr<Bytes> defer_error(Error, Bytes read_bytes);
+
     static constexpr u16 max_back_reference_length = 258;
 
     bool m_read_final_block { false };
 
+    // An error that happened after some data was decoded, it is returned once that data has been read.
+    Optional<Error> m_deferred_error;
+
     State m_state { State::Idle };
     union {
         CompressedBlock m_compressed_block;
@@ -138,6 +150,7 @@ public:
     static constexpr size_t max_huffman_distances = 32;
     static constexpr size_t min_match_length = 4;   // matches smaller than these are not worth the size of the back reference
     static constexpr size_t max_match_length = 258; // matches longer than these cannot be encoded using huffman codes
+    static constexpr size_t max_back_reference_distance = 32 * KiB;
     static constexpr u16 empty_slot = UINT16_MAX;
 
     struct CompressionConstants {
@@ -145,15 +158,16 @@ public:
         size_t max_lazy_length;    // If the match is at least this long we dont defer matching to the next byte (which takes time) as its good enough
         size_t great_match_length; // Once we find a match of at least this length (a great match) we can just stop searching for longer ones
         size_t max_chain;          // We only check the actual length of the max_chain closest matches
+        bool lazy_matching;        // Without lazy matching we take the first match we find, and max_lazy_length is instead the longest match whose bytes we still insert into the hash table
     };
 
     // These constants were shamelessly "borrowed" from zlib
     static constexpr CompressionConstants compression_constants[] = {
-        { 0, 0, 0, 0 },
-        { 4, 4, 8, 4 },
-        { 8, 16, 128, 128 },
-        { 32, 258, 258, 4096 },
-        { max_match_length, max_match_length, max_match_length, 1 << hash_bits } // disable all limits
+        { 0, 0, 0, 0, false },
+        { 4, 4, 8, 4, false },
+        { 8, 16, 128, 128, true },
+        { 32, 258, 258, 4096, true },
+        { max_match_length, max_match_length, max_match_length, 1 << hash_bits, true } // disable all limits
     };
 
     enum class CompressionLevel : int {
@@ -185,7 +199,12 @@ private:
     static u16 hash_sequence(u8 const* bytes);
     size_t compare_match_candidate(size_t start, size_t candidate, size_t prev_match_length, size_t max_match_length);
     size_t find_back_match(size_t start, u16 hash, size_t previous_match_length, size_t max_match_length, size_t& match_position);
+    void insert_hash(size_t position, u16 hash);
+    void slide_hash_table();
+    void emit_literal(u16 literal);
+    void emit_back_reference(u16 distance, u16 length);
     void lz77_compress_block();
+    void lz77_compress_block_greedy();
 
     // Huffman Coding
     struct code_length_symbol {
@@ -223,7 +242,7 @@ private:
     Array<u16, max_huffman_literals> m_symbol_frequencies;    // there are 286 valid symbol values (symbols 286-287 never occur)
     Array<u16, max_huffman_distances> m_distance_frequencies; // there are 30 valid distance values (distances 30-31 never occur)
 
-    // LZ77 Chained hash table
+    // LZ77 Chained hash table, indexed by position in the rolling window. It is kept across blocks, so matches can reach back into the previous block.
     u16 m_hash_head[1 << hash_bits];
     u16 m_hash_prev[window_size];
 };
@@ -14,6 +14,7 @@
 #include <LibCore/File.h>
 #include <LibCore/MappedFile.h>
 #include <LibCore/System.h>
+#include <LibThreading/ParallelFor.h>
 
 namespace Compress {
 
@@ -189,8 +190,9 @@ ErrorOr<size_t> GzipDecompressor::write_some(ReadonlyBytes)
     return Error::from_errno(EBADF);
 }
 
-GzipCompressor::GzipCompressor(MaybeOwned<Stream> stream)
+GzipCompressor::GzipCompressor(MaybeOwned<Stream> stream, size_t thread_count)
     : m_output_stream(move(stream))
+    , m_thread_count(max(thread_count, 1u))
 {
 }
 
@@ -200,6 +202,16 @@ ErrorOr<Bytes> GzipCompressor::read_some(Bytes)
 }
 
 ErrorOr<size_t> GzipCompressor::write_some(ReadonlyBytes bytes)
+{
+    auto thread_count = min(m_thread_count, bytes.size() / minimum_bytes_per_thread);
+    if (thread_count > 1)
+        TRY(write_members_in_parallel(bytes, thread_count));
+    else
+        TRY(write_member(*m_output_stream, bytes));
+    return bytes.size();
+}
+
+ErrorOr<void> GzipCompressor::write_member(Stream& output_stream, ReadonlyBytes bytes)
 {
     BlockHeader header;
     header.identification_1 = 0x1f;
@@ -209,15 +221,49 @@ ErrorOr<size_t> GzipCompressor::write_some(ReadonlyBytes bytes)
     header.modification_time = 0;
     header.extra_flags = 3;      // DEFLATE sets 2 for maximum compression and 4 for minimum compression
     header.operating_system = 3; // unix
-    TRY(m_output_stream->write_until_depleted({ &header, sizeof(header) }));
-    auto compressed_stream = TRY(DeflateCompressor::construct(MaybeOwned(*m_output_stream)));
+    TRY(output_stream.write_until_depleted({ &header, sizeof(header) }));
+    auto compressed_stream = TRY(DeflateCompressor::construct(MaybeOwned(output_stream)));
     TRY(compressed_stream->write_until_depleted(bytes));
     TRY(compressed_stream->final_flush());
     Crypto::Checksum::CRC32 crc32;
     crc32.update(bytes);
-    TRY(m_output_stream->write_value<LittleEndian<u32>>(crc32.digest()));
-    TRY(m_output_stream->write_value<LittleEndian<u32>>(bytes.size()));
-    return bytes.size();
+    TRY(output_stream.write_value<LittleEndian<u32>>(crc32.digest()));
+    TRY(output_stream.write_value<LittleEndian<u32>>(bytes.size()));
+    return {};
+}
+
+ErrorOr<void> GzipCompressor::write_members_in_parallel(ReadonlyBytes bytes, size_t thread_count)
+{
+    // A gzip file may consist of several members, which decompress to the concatenation of their contents (RFC 1952, section 2.2).
+    // So every chunk is compressed into a member of its own, without having to wait for the chunks before it.
+    struct Chunk {
+        ReadonlyBytes input;
+        AllocatingMemoryStream output;
+        Optional<Error> error;
+    };
+
+    auto chunk_size = ceil_div(bytes.size(), thread_count);
+    Vector<Chunk> chunks;
+    TRY(chunks.try_ensure_capacity(thread_count));
+    for (size_t offset = 0; offset < bytes.size(); offset += chunk_size)
+        chunks.unchecked_append({ bytes.slice(offset, min(chunk_size, bytes.size() - offset)), {}, {} });
+
+    auto compress_chunk = [](Chunk& chunk) {
+        if (auto result = write_member(chunk.output, chunk.input); result.is_error())
+            chunk.error = result.release_error();
+    };
+
+    Threading::parallel_for(chunks.size(), [&](size_t i) { compress_chunk(chunks[i]); });
+
+    for (auto& chunk : chunks) {
+        if (chunk.error.has_value())
+            return chunk.error.release_value();
+
+        auto compressed = TRY(chunk.output.read_until_eof());
+        TRY(m_output_stream->write_until_depleted(compressed));
+    }
+
+    return {};
 }
 
 bool GzipCompressor::is_eof() const
@@ -234,10 +280,10 @@ void GzipCompressor::close()
 {
 }
 
-ErrorOr<ByteBuffer> GzipCompressor::compress_all(ReadonlyBytes bytes)
+ErrorOr<ByteBuffer> GzipCompressor::compress_all(ReadonlyBytes bytes, size_t thread_count)
 {
     auto output_stream = TRY(try_make<AllocatingMemoryStream>());
-    GzipCompressor gzip_stream { MaybeOwned<Stream>(*output_stream) };
+    GzipCompressor gzip_stream { MaybeOwned<Stream>(*output_stream), thread_count };
 
     TRY(gzip_stream.write_until_depleted(bytes));
 
@@ -83,7 +83,8 @@ private:
 
 class GzipCompressor final : public Stream {
 public:
-    GzipCompressor(MaybeOwned<Stream>);
+    // With more than one thread, large writes are split into that many chunks that are compressed concurrently on the default thread pool, each into its own gzip member.
+    GzipCompressor(MaybeOwned<Stream>, size_t thread_count = 1);
 
     virtual ErrorOr<Bytes> read_some(Bytes) override;
     virtual ErrorOr<size_t> write_some(ReadonlyBytes) override;
@@ -91,10 +92,17 @@ public:
     virtual bool is_open() const override;
     virtual void close() override;
 
-    static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes bytes);
+    static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes bytes, size_t thread_count = 1);
 
 private:
+    // Below this, the cost of starting a thread and of the extra member header outweighs the gain from compressing in parallel.
+    static constexpr size_t minimum_bytes_per_thread = 256 * KiB;
+
+    static ErrorOr<void> write_member(Stream&, ReadonlyBytes);
+    ErrorOr<void> write_members_in_parallel(ReadonlyBytes, size_t thread_count);
+
     MaybeOwned<Stream> m_output_stream;
+    size_t m_thread_count { 1 };
 };
 
 }
@@ -190,6 +190,44 @@ bool LzmaDecompressor::has_reached_expected_data_size() const
     return m_total_processed_bytes >= m_options.uncompressed_size.value();
 }
 
+void LzmaDecompressor::refill_input_buffer()
+{
+    VERIFY(m_buffered_input.is_empty());
+
+    auto read_bytes_or_error = m_stream->read_some(m_input_buffer);
+    if (read_bytes_or_error.is_error()) {
+        if (!m_range_decoder_error.has_value())
+            m_range_decoder_error = read_bytes_or_error.release_error();
+        return;
+    }
+
+    m_buffered_input = read_bytes_or_error.value();
+    if (m_buffered_input.is_empty() && !m_range_decoder_error.has_value())
+        m_range_decoder_error = Error::from_string_literal("Reached end-of-file before filling the entire buffer");
+}
+
+ALWAYS_INLINE u8 LzmaDecompressor::read_input_byte()
+{
+    if (m_buffered_input.is_empty()) [[unlikely]] {
+        refill_input_buffer();
+
+        // Once we are out of data, we keep feeding zeroes to the range decoder until the error is noticed.
+        if (m_buffered_input.is_empty())
+            return 0;
+    }
+
+    auto byte = m_buffered_input[0];
+    m_buffered_input = m_buffered_input.slice(1);
+    return byte;
+}
+
+ErrorOr<void> LzmaDecompressor::take_range_decoder_error()
+{
+    if (m_range_decoder_error.has_value()) [[unlikely]]
+        return m_range_decoder_error.release_value();
+    return {};
+}
+
 ErrorOr<void> LzmaDecompressor::initialize_range_decoder()
 {
     // "The LZMA Encoder always writes ZERO in initial byte of compressed stream.
@@ -197,7 +235,8 @@ ErrorOr<void> LzmaDecompressor::initialize_range_decoder()
     //  LZMA Encoder. If initial byte is not equal to ZERO, the LZMA Decoder must
     //  stop decoding and report error."
     {
-        auto byte = TRY(m_stream->read_value<u8>());
+        auto byte = read_input_byte();
+        TRY(take_range_decoder_error());
         if (byte != 0)
             return Error::from_string_literal("Initial byte of data stream is not zero");
     }
@@ -205,9 +244,10 @@ ErrorOr<void> LzmaDecompressor::initialize_range_decoder()
     // Read the initial bytes into the range decoder.
     m_range_decoder_code = 0;
     for (size_t i = 0; i < 4; i++) {
-        auto byte = TRY(m_stream->read_value<u8>());
+        auto byte = read_input_byte();
         m_range_decoder_code = m_range_decoder_code << 8 | byte;
     }
+    TRY(take_range_decoder_error());
 
     m_range_decoder_range = 0xFFFFFFFF;
 
@@ -218,6 +258,9 @@ ErrorOr<void> LzmaDecompressor::append_input_stream(MaybeOwned<Stream> stream, O
 {
     m_stream = move(stream);
 
+    // Anything that is left over from the previous stream doesn't belong to the one we are appending.
+    m_buffered_input = {};
+
     TRY(initialize_range_decoder());
 
     if (m_options.uncompressed_size.has_value() != uncompressed_size.has_value())
@@ -229,21 +272,19 @@ ErrorOr<void> LzmaDecompressor::append_input_stream(MaybeOwned<Stream> stream, O
     return {};
 }
 
-ErrorOr<void> LzmaDecompressor::normalize_range_decoder()
+ALWAYS_INLINE void LzmaDecompressor::normalize_range_decoder()
 {
     // "The Normalize() function keeps the "Range" value in described range."
 
     if (m_range_decoder_range >= minimum_range_value)
-        return {};
+        return;
 
     m_range_decoder_range <<= 8;
     m_range_decoder_code <<= 8;
 
-    m_range_decoder_code |= TRY(m_stream->read_value<u8>());
+    m_range_decoder_code |= read_input_byte();
 
     VERIFY(m_range_decoder_range >= minimum_range_value);
-
-    return {};
 }
 
 ErrorOr<void> LzmaCompressor::shift_range_encoder()
@@ -297,7 +338,7 @@ ErrorOr<void> LzmaCompressor::normalize_range_encoder()
     return {};
 }
 
-ErrorOr<u8> LzmaDecompressor::decode_direct_bit()
+u8 LzmaDecompressor::decode_direct_bit()
 {
     dbgln_if(LZMA_DEBUG, "Decoding direct bit {} with code = {:#x}, range = {:#x}", 1 - ((m_range_decoder_code - (m_range_decoder_range >> 1)) >> 31), m_range_decoder_code, m_range_decoder_range);
 
@@ -308,10 +349,10 @@ ErrorOr<u8> LzmaDecompressor::decode_direct_bit()
 
     m_range_decoder_code += m_range_decoder_range & temp;
 
-    if (m_range_decoder_code == m_range_decoder_range)
-        return Error::from_string_literal("Reached an invalid state while decoding LZMA stream");
+    if (m_range_decoder_code == m_range_decoder_range && !m_range_decoder_error.has_value())
+        m_range_decoder_error = Error::from_string_literal("Reached an invalid state while decoding LZMA stream");
 
-    TRY(normalize_range_decoder());
+    normalize_range_decoder();
 
     return temp + 1;
 }
@@ -330,7 +371,7 @@ ErrorOr<void> LzmaCompressor::encode_direct_bit(u8 value)
     return {};
 }
 
-ErrorOr<u8> LzmaDecompressor::decode_bit_with_probability(Probability& probability)
+ALWAYS_INLINE u8 LzmaDecompressor::decode_bit_with_probability(Probability& probability)
 {
     // "The LZMA decoder provides the pointer to CProb variable that contains
     //  information about estimated probability for symbol 0 and the Range Decoder
@@ -343,13 +384,13 @@ ErrorOr<u8> LzmaDecompressor::decode_bit_with_probability(Probability& probabili
     if (m_range_decoder_code < bound) {
         probability += ((1 << probability_bit_count) - probability) >> probability_shift_width;
         m_range_decoder_range = bound;
-        TRY(normalize_range_decoder());
+        normalize_range_decoder();
         return 0;
     } else {
         probability -= probability >> probability_shift_width;
         m_range_decoder_code -= bound;
         m_range_decoder_range -= bound;
-        TRY(normalize_range_decoder());
+        normalize_range_decoder();
         return 1;
     }
 }
@@ -373,7 +414,7 @@ ErrorOr<void> LzmaCompressor::encode_bit_with_probability(Probability& probabili
     return {};
 }
 
-ErrorOr<u16> LzmaDecompressor::decode_symbol_using_bit_tree(size_t bit_count, Span<Probability> probability_tree)
+u16 LzmaDecompressor::decode_symbol_using_bit_tree(size_t bit_count, Span<Probability> probability_tree)
 {
     VERIFY(bit_count <= sizeof(u16) * 8);
     VERIFY(probability_tree.size() >= 1ul << bit_count);
@@ -385,7 +426,7 @@ ErrorOr<u16> LzmaDecompressor::decode_symbol_using_bit_tree(size_t bit_count, Sp
     size_t tree_index = 1;
 
     for (size_t i = 0; i < bit_count; i++) {
-        u16 next_bit = TRY(decode_bit_with_probability(probability_tree[tree_index]));
+        u16 next_bit = decode_bit_with_probability(probability_tree[tree_index]);
         result = (result << 1) | next_bit;
         tree_index = (tree_index << 1) | next_bit;
     }
@@ -420,7 +461,7 @@ ErrorOr<void> LzmaCompressor::encode_symbol_using_bit_tree(size_t bit_count, Spa
     return {};
 }
 
-ErrorOr<u16> LzmaDecompressor::decode_symbol_using_reverse_bit_tree(size_t bit_count, Span<Probability> probability_tree)
+u16 LzmaDecompressor::decode_symbol_using_reverse_bit_tree(size_t bit_count, Span<Probability> probability_tree)
 {
     VERIFY(bit_count <= sizeof(u16) * 8);
     VERIFY(probability_tree.size() >= 1ul << bit_count);
@@ -429,7 +470,7 @@ ErrorOr<u16> LzmaDecompressor::decode_symbol_using_reverse_bit_tree(size_t bit_c
     size_t tree_index = 1;
 
     for (size_t i = 0; i < bit_count; i++) {
-        u16 next_bit = TRY(decode_bit_with_probability(probability_tree[tree_index]));
+        u16 next_bit = decode_bit_with_probability(probability_tree[tree_index]);
         result |= next_bit << i;
         tree_index = (tree_index << 1) | next_bit;
     }
@@ -499,7 +540,7 @@ ErrorOr<void> LzmaDecompressor::decode_literal_to_output_buffer()
             u8 match_bit = (matched_byte >> 7) & 1;
             matched_byte <<= 1;
 
-            u8 decoded_bit = TRY(decode_bit_with_probability(selected_probability_table[((1 + match_bit) << 8) + result]));
+            u8 decoded_bit = decode_bit_with_probability(selected_probability_table[((1 + match_bit) << 8) + result]);
             result = result << 1 | decoded_bit;
 
             if (match_bit != decoded_bit)
@@ -508,7 +549,9 @@ ErrorOr<void> LzmaDecompressor::decode_literal_to_output_buffer()
     }
 
     while (result < 0x100)
-        result = (result << 1) | TRY(decode_bit_with_probability(selected_probability_table[result]));
+        result = (result << 1) | decode_bit_with_probability(selected_probability_table[result]);
+
+    TRY(take_range_decoder_error());
 
     u8 actual_result = result - 0x100;
 
@@ -670,7 +713,7 @@ LzmaState::LzmaLengthCoderState::LzmaLengthCoderState()
     initialize_to_default_probability(m_high_length_probabilities);
 }
 
-ErrorOr<u16> LzmaDecompressor::decode_normalized_match_length(LzmaLengthCoderState& length_decoder_state)
+u16 LzmaDecompressor::decode_normalized_match_length(LzmaLengthCoderState& length_decoder_state)
 {
     // "LZMA uses "posState" value as context to select the binary tree
     //  from LowCoder and MidCoder binary tree arrays:"
@@ -682,15 +725,15 @@ ErrorOr<u16> LzmaDecompressor::decode_normalized_match_length(LzmaLengthCoderSta
     //   sequence                                    (binary + decimal):
     //
     //   0 xxx              LowCoder[posState]       xxx
-    if (TRY(decode_bit_with_probability(length_decoder_state.m_first_choice_probability)) == 0)
-        return TRY(decode_symbol_using_bit_tree(3, length_decoder_state.m_low_length_probabilities[position_state].span()));
+    if (decode_bit_with_probability(length_decoder_state.m_first_choice_probability) == 0)
+        return decode_symbol_using_bit_tree(3, length_decoder_state.m_low_length_probabilities[position_state].span());
 
     //   1 0 yyy            MidCoder[posState]       yyy + 8
-    if (TRY(decode_bit_with_probability(length_decoder_state.m_second_choice_probability)) == 0)
-        return TRY(decode_symbol_using_bit_tree(3, length_decoder_state.m_medium_length_probabilities[position_state].span())) + 8;
+    if (decode_bit_with_probability(length_decoder_state.m_second_choice_probability) == 0)
+        return decode_symbol_using_bit_tree(3, length_decoder_state.m_medium_length_probabilities[position_state].span()) + 8;
 
     //   1 1 zzzzzzzz       HighCoder                zzzzzzzz + 16"
-    return TRY(decode_symbol_using_bit_tree(8, length_decoder_state.m_high_length_probabilities.span())) + 16;
+    return decode_symbol_using_bit_tree(8, length_decoder_state.m_high_length_probabilities.span()) + 16;
 }
 
 ErrorOr<void> LzmaCompressor::encode_normalized_match_length(LzmaLengthCoderState& length_coder_state, u16 normalized_length)
@@ -716,7 +759,7 @@ ErrorOr<void> LzmaCompressor::encode_normalized_match_length(LzmaLengthCoderStat
     return {};
 }
 
-ErrorOr<u32> LzmaDecompressor::decode_normalized_match_distance(u16 normalized_match_length)
+u32 LzmaDecompressor::decode_normalized_match_distance(u16 normalized_match_length)
 {
     // "LZMA uses normalized match length (zero-based length)
     //  to calculate the context state "lenState" do decode the distance value."
@@ -724,7 +767,7 @@ ErrorOr<u32> LzmaDecompressor::decode_normalized_match_distance(u16 normalized_m
 
     // "At first stage the distance decoder decodes 6-bit "posSlot" value with bit
     //  tree decoder from PosSlotDecoder array."
-    u16 position_slot = TRY(decode_symbol_using_bit_tree(6, m_length_to_position_states[length_state].span()));
+    u16 position_slot = decode_symbol_using_bit_tree(6, m_length_to_position_states[length_state].span());
 
     // "The encoding scheme for distance value is shown in the following table:
     //
@@ -776,7 +819,7 @@ ErrorOr<u32> LzmaDecompressor::decode_normalized_match_distance(u16 normalized_m
     if (position_slot < first_position_slot_with_direct_encoded_bits) {
         size_t number_of_bits_to_decode = (position_slot / 2) - 1;
         auto& selected_probability_tree = m_binary_tree_distance_probabilities[position_slot - first_position_slot_with_binary_tree_bits];
-        return (distance_prefix << number_of_bits_to_decode) | TRY(decode_symbol_using_reverse_bit_tree(number_of_bits_to_decode, selected_probability_tree));
+        return (distance_prefix << number_of_bits_to_decode) | decode_symbol_using_reverse_bit_tree(number_of_bits_to_decode, selected_probability_tree);
     }
 
     // "  if (posSlot >= kEndPosModelIndex), the middle bits are decoded as direct
@@ -784,9 +827,9 @@ ErrorOr<u32> LzmaDecompressor::decode_normalized_match_distance(u16 normalized_m
     //     decoder "AlignDecoder" with "Reverse" scheme."
     size_t number_of_direct_bits_to_decode = ((position_slot - first_position_slot_with_direct_encoded_bits) / 2) + 2;
     for (size_t i = 0; i < number_of_direct_bits_to_decode; i++) {
-        distance_prefix = (distance_prefix << 1) | TRY(decode_direct_bit());
+        distance_prefix = (distance_prefix << 1) | decode_direct_bit();
     }
-    return (distance_prefix << number_of_alignment_bits) | TRY(decode_symbol_using_reverse_bit_tree(number_of_alignment_bits, m_alignment_bit_probabilities));
+    return (distance_prefix << number_of_alignment_bits) | decode_symbol_using_reverse_bit_tree(number_of_alignment_bits, m_alignment_bit_probabilities);
 }
 
 ErrorOr<void> LzmaCompressor::encode_normalized_match_distance(u16 normalized_match_length, u32 normalized_match_distance)
@@ -878,7 +921,7 @@ void LzmaState::update_state_after_short_rep()
         m_state = 11;
 }
 
-ErrorOr<LzmaDecompressor::MatchType> LzmaDecompressor::decode_match_type()
+LzmaDecompressor::MatchType LzmaDecompressor::decode_match_type()
 {
     // "The decoder calculates "state2" variable value to select exact variable from
     //  "IsMatch" and "IsRep0Long" arrays."
@@ -890,7 +933,7 @@ ErrorOr<LzmaDecompressor::MatchType> LzmaDecompressor::decode_match_type()
     //
     //  IsMatch[state2] decode
     //   0 - the Literal"
-    if (TRY(decode_bit_with_probability(m_is_match_probabilities[state2])) == 0) {
+    if (decode_bit_with_probability(m_is_match_probabilities[state2]) == 0) {
         dbgln_if(LZMA_DEBUG, "Decoded match type 'Literal'");
         return MatchType::Literal;
     }
@@ -898,7 +941,7 @@ ErrorOr<LzmaDecompressor::MatchType> LzmaDecompressor::decode_match_type()
     // " 1 - the Match
     //     IsRep[state] decode
     //       0 - Simple Match"
-    if (TRY(decode_bit_with_probability(m_is_rep_probabilities[m_state])) == 0) {
+    if (decode_bit_with_probability(m_is_rep_probabilities[m_state]) == 0) {
         dbgln_if(LZMA_DEBUG, "Decoded match type 'SimpleMatch'");
         return MatchType::SimpleMatch;
     }
@@ -906,10 +949,10 @@ ErrorOr<LzmaDecompressor::MatchType> LzmaDecompressor::decode_match_type()
     // "     1 - Rep Match
     //         IsRepG0[state] decode
     //           0 - the distance is rep0"
-    if (TRY(decode_bit_with_probability(m_is_rep_g0_probabilities[m_state])) == 0) {
+    if (decode_bit_with_probability(m_is_rep_g0_probabilities[m_state]) == 0) {
         // "       IsRep0Long[state2] decode
         //           0 - Short Rep Match"
-        if (TRY(decode_bit_with_probability(m_is_rep0_long_probabilities[state2])) == 0) {
+        if (decode_bit_with_probability(m_is_rep0_long_probabilities[state2]) == 0) {
             dbgln_if(LZMA_DEBUG, "Decoded match type 'ShortRepMatch'");
             return MatchType::ShortRepMatch;
         }
@@ -922,7 +965,7 @@ ErrorOr<LzmaDecompressor::MatchType> LzmaDecompressor::decode_match_type()
     // "         1 -
     //             IsRepG1[state] decode
     //               0 - Rep Match 1"
-    if (TRY(decode_bit_with_probability(m_is_rep_g1_probabilities[m_state])) == 0) {
+    if (decode_bit_with_probability(m_is_rep_g1_probabilities[m_state]) == 0) {
         dbgln_if(LZMA_DEBUG, "Decoded match type 'RepMatch1'");
         return MatchType::RepMatch1;
     }
@@ -930,7 +973,7 @@ ErrorOr<LzmaDecompressor::MatchType> LzmaDecompressor::decode_match_type()
     // "             1 -
     //                 IsRepG2[state] decode
     //                   0 - Rep Match 2"
-    if (TRY(decode_bit_with_probability(m_is_rep_g2_probabilities[m_state])) == 0) {
+    if (decode_bit_with_probability(m_is_rep_g2_probabilities[m_state]) == 0) {
         dbgln_if(LZMA_DEBUG, "Decoded match type 'RepMatch2'");
         return MatchType::RepMatch2;
     }
@@ -1059,7 +1102,8 @@ ErrorOr<Bytes> LzmaDecompressor::read_some(Bytes bytes)
             continue;
         }
 
-        auto const match_type = TRY(decode_match_type());
+        auto const match_type = decode_match_type();
+        TRY(take_range_decoder_error());
 
         // If we are looking for EOS, but find another match type, the stream is also corrupted.
         if (has_reached_expected_data_size() && match_type != MatchType::SimpleMatch)
@@ -1085,13 +1129,14 @@ ErrorOr<Bytes> LzmaDecompressor::read_some(Bytes bytes)
             m_rep1 = m_rep0;
 
             // "The zero-based length is decoded with "LenDecoder"."
-            u16 normalized_length = TRY(decode_normalized_match_length(m_length_coder));
+            u16 normalized_length = decode_normalized_match_length(m_length_coder);
 
             // "The state is update with UpdateState_Match function."
             update_state_after_match();
 
             // "and the new "rep0" value is decoded with DecodeDistance."
-            m_rep0 = TRY(decode_normalized_match_distance(normalized_length));
+            m_rep0 = decode_normalized_match_distance(normalized_length);
+            TRY(take_range_decoder_error());
 
             // "If the value of "rep0" is equal to 0xFFFFFFFF, it means that we have
             //  "End of stream" marker, so we can stop decoding and check finishing
@@ -1166,7 +1211,8 @@ ErrorOr<Bytes> LzmaDecompressor::read_some(Bytes bytes)
 
         // "In other cases (Rep Match 0/1/2/3), it decodes the zero-based
         //  length of match with "RepLenDecoder" decoder."
-        u16 normalized_length = TRY(decode_normalized_match_length(m_rep_length_coder));
+        u16 normalized_length = decode_normalized_match_length(m_rep_length_coder);
+        TRY(take_range_decoder_error());
 
         // "Then it updates the state."
         update_state_after_rep();
@@ -190,25 +190,37 @@ private:
     u32 m_range_decoder_range { 0xFFFFFFFF };
     u32 m_range_decoder_code { 0 };
 
+    // The range decoder consumes its input one byte at a time, so we read ahead from the input stream in larger chunks.
+    // Note: This may read beyond the end of the LZMA data, which is fine for LZMA containers and for LZMA2 chunks (which have a known compressed size).
+    Array<u8, 4 * KiB> m_input_buffer;
+    ReadonlyBytes m_buffered_input;
+    u8 read_input_byte();
+    void refill_input_buffer();
+
+    // Decoding a single bit can't fail, so that the hot path doesn't have to deal with errors. Instead, the first error
+    // (running out of input or reaching an invalid state) is stored here, and checked once per decoded symbol.
+    Optional<Error> m_range_decoder_error;
+    ErrorOr<void> take_range_decoder_error();
+
     ErrorOr<void> initialize_range_decoder();
-    ErrorOr<void> normalize_range_decoder();
-    ErrorOr<u8> decode_direct_bit();
-    ErrorOr<u8> decode_bit_with_probability(Probability& probability);
+    void normalize_range_decoder();
+    u8 decode_direct_bit();
+    u8 decode_bit_with_probability(Probability& probability);
 
-    ErrorOr<MatchType> decode_match_type();
+    MatchType decode_match_type();
 
     // Decodes a multi-bit symbol using a given probability tree (either in normal or in reverse order).
     // The specification states that "unsigned" is at least 16 bits in size, our implementation assumes this as the maximum symbol size.
-    ErrorOr<u16> decode_symbol_using_bit_tree(size_t bit_count, Span<Probability> probability_tree);
-    ErrorOr<u16> decode_symbol_using_reverse_bit_tree(size_t bit_count, Span<Probability> probability_tree);
+    u16 decode_symbol_using_bit_tree(size_t bit_count, Span<Probability> probability_tree);
+    u16 decode_symbol_using_reverse_bit_tree(size_t bit_count, Span<Probability> probability_tree);
 
     ErrorOr<void> decode_literal_to_output_buffer();
 
-    ErrorOr<u16> decode_normalized_match_length(LzmaLengthCoderState&);
+    u16 decode_normalized_match_length(LzmaLengthCoderState&);
 
     // This deviates from the specification, which states that "unsigned" is at least 16-bit.
     // However, the match distance needs to be at least 32-bit, at the very least to hold the 0xFFFFFFFF end marker value.
-    ErrorOr<u32> decode_normalized_match_distance(u16 normalized_match_length);
+    u32 decode_normalized_match_distance(u16 normalized_match_length);
 };
 
 class LzmaCompressor : public Stream
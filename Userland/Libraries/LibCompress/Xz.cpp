@@ -9,6 +9,7 @@
 #include <LibCompress/Lzma2.h>
 #include <LibCompress/Xz.h>
 #include <LibCrypto/Checksum/CRC32.h>
+#include <LibThreading/Thread.h>
 
 namespace Compress {
 
@@ -339,17 +340,20 @@ void XzFilterBCJArm64::close()
 {
 }
 
-ErrorOr<NonnullOwnPtr<XzDecompressor>> XzDecompressor::create(MaybeOwned<Stream> stream)
+ErrorOr<NonnullOwnPtr<XzDecompressor>> XzDecompressor::create(MaybeOwned<Stream> stream, size_t thread_count)
 {
+    VERIFY(thread_count >= 1);
+
     auto counting_stream = TRY(try_make<CountingStream>(move(stream)));
 
-    auto decompressor = TRY(adopt_nonnull_own_or_enomem(new (nothrow) XzDecompressor(move(counting_stream))));
+    auto decompressor = TRY(adopt_nonnull_own_or_enomem(new (nothrow) XzDecompressor(move(counting_stream), thread_count)));
 
     return decompressor;
 }
 
-XzDecompressor::XzDecompressor(NonnullOwnPtr<CountingStream> stream)
+XzDecompressor::XzDecompressor(NonnullOwnPtr<CountingStream> stream, size_t thread_count)
     : m_stream(move(stream))
+    , m_thread_count(thread_count)
 {
 }
 
@@ -430,13 +434,15 @@ ErrorOr<bool> XzDecompressor::load_next_stream()
     return true;
 }
 
-ErrorOr<void> XzDecompressor::load_next_block(u8 encoded_block_header_size)
+ErrorOr<XzDecompressor::BlockHeader> XzDecompressor::read_block_header(u8 encoded_block_header_size)
 {
+    BlockHeader block_header;
+
     // We already read the encoded Block Header size (one byte) to determine that this is not an Index.
-    m_current_block_start_offset = m_stream->read_bytes() - 1;
+    block_header.start_offset = m_stream->read_bytes() - 1;
 
     // Ensure that the start of the block is aligned to a multiple of four (in theory, everything in XZ is).
-    VERIFY(m_current_block_start_offset % 4 == 0);
+    VERIFY(block_header.start_offset % 4 == 0);
 
     // 3.1.1. Block Header Size:
     // "This field contains the size of the Block Header field,
@@ -465,8 +471,6 @@ ErrorOr<void> XzDecompressor::load_next_block(u8 encoded_block_header_size)
     if (flags.reserved != 0)
         return Error::from_string_literal("XZ block header has reserved non-null block flag bits");
 
-    MaybeOwned<Stream> new_block_stream { *m_stream };
-
     // 3.1.3. Compressed Size:
     // "This field is present only if the appropriate bit is set in
     //  the Block Flags field (see Section 3.1.2)."
@@ -479,7 +483,7 @@ ErrorOr<void> XzDecompressor::load_next_block(u8 encoded_block_header_size)
         if (compressed_size == 0)
             return Error::from_string_literal("XZ block header contains a compressed size of zero");
 
-        new_block_stream = TRY(try_make<ConstrainedStream>(move(new_block_stream), compressed_size));
+        block_header.compressed_size = compressed_size;
     }
 
     // 3.1.4. Uncompressed Size:
@@ -487,21 +491,9 @@ ErrorOr<void> XzDecompressor::load_next_block(u8 encoded_block_header_size)
     //  the Block Flags field (see Section 3.1.2)."
     if (flags.uncompressed_size_present) {
         // "Uncompressed Size is stored using the encoding described in Section 1.2."
-        u64 const uncompressed_size = TRY(header_stream.read_value<XzMultibyteInteger>());
-
-        m_current_block_expected_uncompressed_size = uncompressed_size;
-    } else {
-        m_current_block_expected_uncompressed_size.clear();
+        block_header.uncompressed_size = TRY(header_stream.read_value<XzMultibyteInteger>());
     }
 
-    // We need to process the filters in reverse order, since they are listed in the order that they have been applied in.
-    struct FilterEntry {
-        u64 id;
-        ByteBuffer properties;
-        bool last;
-    };
-    Vector<FilterEntry, 4> filters;
-
     // 3.1.5. List of Filter Flags:
     // "The number of Filter Flags fields is stored in the Block Flags
     //  field (see Section 3.1.2)."
@@ -518,10 +510,47 @@ ErrorOr<void> XzDecompressor::load_next_block(u8 encoded_block_header_size)
         auto filter_properties = TRY(ByteBuffer::create_uninitialized(size_of_properties));
         TRY(header_stream.read_until_filled(filter_properties));
 
-        filters.empend(filter_id, move(filter_properties), last);
+        block_header.filters.empend(filter_id, move(filter_properties), last);
+    }
+
+    // Check that we know how to undo the filters before verifying the rest of the header, as the block couldn't be decoded anyways.
+    for (auto& filter : block_header.filters) {
+        if (filter.id != 0x21 && filter.id != 0x0a && filter.id != 0x03)
+            return Error::from_string_literal("XZ block header contains unknown filter ID");
+    }
+
+    // 3.1.6. Header Padding:
+    // "This field contains as many null byte as it is needed to make
+    //  the Block Header have the size specified in Block Header Size."
+    constexpr size_t size_of_block_header_size = 1;
+    constexpr size_t size_of_crc32 = 4;
+    while (MUST(header_stream.tell()) < block_header_size - size_of_block_header_size - size_of_crc32) {
+        auto const padding_byte = TRY(header_stream.read_value<u8>());
+
+        // "If any of the bytes are not null bytes, the decoder MUST
+        //  indicate an error."
+        if (padding_byte != 0)
+            return Error::from_string_literal("XZ block header padding contains non-null bytes");
     }
 
-    for (auto& filter : filters.in_reverse()) {
+    // 3.1.7. CRC32:
+    // "The CRC32 is calculated over everything in the Block Header
+    //  field except the CRC32 field itself.
+    Crypto::Checksum::CRC32 calculated_header_crc32 { header.span().trim(block_header_size - size_of_crc32) };
+    //  It is stored as an unsigned 32-bit little endian integer.
+    u32 const stored_header_crc32 = TRY(header_stream.read_value<LittleEndian<u32>>());
+    //  If the calculated value does not match the stored one, the decoder MUST indicate
+    //  an error."
+    if (calculated_header_crc32.digest() != stored_header_crc32)
+        return Error::from_string_literal("Stored XZ block header CRC32 does not match the stored CRC32");
+
+    return block_header;
+}
+
+ErrorOr<MaybeOwned<Stream>> XzDecompressor::create_block_stream(MaybeOwned<Stream> new_block_stream, BlockHeader& block_header)
+{
+    // We need to process the filters in reverse order, since they are listed in the order that they have been applied in.
+    for (auto& filter : block_header.filters.in_reverse()) {
         // 5.3.1. LZMA2
         if (filter.id == 0x21) {
             if (!filter.last)
@@ -570,44 +599,133 @@ ErrorOr<void> XzDecompressor::load_next_block(u8 encoded_block_header_size)
             continue;
         }
 
-        return Error::from_string_literal("XZ block header contains unknown filter ID");
+        VERIFY_NOT_REACHED();
     }
 
-    // 3.1.6. Header Padding:
-    // "This field contains as many null byte as it is needed to make
-    //  the Block Header have the size specified in Block Header Size."
-    constexpr size_t size_of_block_header_size = 1;
-    constexpr size_t size_of_crc32 = 4;
-    while (MUST(header_stream.tell()) < block_header_size - size_of_block_header_size - size_of_crc32) {
-        auto const padding_byte = TRY(header_stream.read_value<u8>());
+    return new_block_stream;
+}
 
-        // "If any of the bytes are not null bytes, the decoder MUST
-        //  indicate an error."
-        if (padding_byte != 0)
-            return Error::from_string_literal("XZ block header padding contains non-null bytes");
-    }
+ErrorOr<void> XzDecompressor::start_block(BlockHeader block_header)
+{
+    MaybeOwned<Stream> new_block_stream { *m_stream };
 
-    // 3.1.7. CRC32:
-    // "The CRC32 is calculated over everything in the Block Header
-    //  field except the CRC32 field itself.
-    Crypto::Checksum::CRC32 calculated_header_crc32 { header.span().trim(block_header_size - size_of_crc32) };
-    //  It is stored as an unsigned 32-bit little endian integer.
-    u32 const stored_header_crc32 = TRY(header_stream.read_value<LittleEndian<u32>>());
-    //  If the calculated value does not match the stored one, the decoder MUST indicate
-    //  an error."
-    if (calculated_header_crc32.digest() != stored_header_crc32)
-        return Error::from_string_literal("Stored XZ block header CRC32 does not match the stored CRC32");
+    if (block_header.compressed_size.has_value())
+        new_block_stream = TRY(try_make<ConstrainedStream>(move(new_block_stream), *block_header.compressed_size));
 
-    m_current_block_stream = move(new_block_stream);
+    m_current_block_stream = TRY(create_block_stream(move(new_block_stream), block_header));
+    m_current_block_expected_uncompressed_size = block_header.uncompressed_size;
     m_current_block_uncompressed_size = 0;
+    m_current_block_start_offset = block_header.start_offset;
+    m_current_block_unpadded_size.clear();
 
     return {};
 }
 
-ErrorOr<void> XzDecompressor::finish_current_block()
+ErrorOr<void> XzDecompressor::prefetch_blocks(BlockHeader block_header)
 {
-    auto unpadded_size = m_stream->read_bytes() - m_current_block_start_offset;
+    VERIFY(m_prefetched_blocks.is_empty());
+
+    auto can_be_prefetched = [](BlockHeader const& header) {
+        return header.compressed_size.has_value() && header.uncompressed_size.has_value();
+    };
+
+    if (!can_be_prefetched(block_header) || *block_header.uncompressed_size > maximum_prefetched_size)
+        return start_block(move(block_header));
+
+    u64 prefetched_size = 0;
+    while (true) {
+        prefetched_size += *block_header.uncompressed_size;
 
+        auto compressed_data = TRY(ByteBuffer::create_uninitialized(*block_header.compressed_size));
+        TRY(m_stream->read_until_filled(compressed_data));
+        auto unpadded_size = TRY(read_block_padding_and_check(m_stream->read_bytes() - block_header.start_offset));
+
+        TRY(m_prefetched_blocks.try_append({ move(block_header), move(compressed_data), unpadded_size }));
+
+        if (m_prefetched_blocks.size() == m_thread_count)
+            break;
+
+        auto const encoded_block_header_size_or_index_indicator = TRY(m_stream->read_value<u8>());
+        if (encoded_block_header_size_or_index_indicator == 0x00) {
+            m_next_block_header_size_or_index_indicator = encoded_block_header_size_or_index_indicator;
+            break;
+        }
+
+        block_header = TRY(read_block_header(encoded_block_header_size_or_index_indicator));
+        if (!can_be_prefetched(block_header) || prefetched_size + *block_header.uncompressed_size > maximum_prefetched_size) {
+            m_next_block_header = move(block_header);
+            break;
+        }
+    }
+
+    auto decode_block = [](PrefetchedBlock& block) {
+        auto result = [&]() -> ErrorOr<void> {
+            auto compressed_stream = TRY(try_make<FixedMemoryStream>(block.compressed_data.bytes()));
+            auto block_stream = TRY(create_block_stream(move(compressed_stream), block.header));
+
+            // NOTE: Only blocks that declare their uncompressed size are prefetched, so we never have to buffer more
+            //       than that. Reading one byte past it tells us whether the block is lying about its size.
+            auto uncompressed_size = *block.header.uncompressed_size;
+            auto uncompressed_data = TRY(ByteBuffer::create_uninitialized(uncompressed_size + 1));
+            auto uncompressed_bytes = uncompressed_data.bytes();
+            size_t total_read = 0;
+            while (total_read < uncompressed_data.size()) {
+                auto read_bytes = TRY(block_stream->read_some(uncompressed_bytes.slice(total_read)));
+                if (read_bytes.is_empty())
+                    break;
+                total_read += read_bytes.size();
+            }
+            if (total_read != uncompressed_size)
+                return Error::from_string_literal("XZ block uncompressed size mismatch");
+
+            uncompressed_data.resize(uncompressed_size);
+            block.uncompressed_data = move(uncompressed_data);
+            return {};
+        }();
+        if (result.is_error())
+            block.error = result.release_error();
+        block.compressed_data.clear();
+    };
+
+    // The first block is decoded on this thread, while the others are decoded on threads of their own.
+    Vector<NonnullRefPtr<Threading::Thread>> threads;
+    TRY(threads.try_ensure_capacity(m_prefetched_blocks.size() - 1));
+    for (size_t i = 1; i < m_prefetched_blocks.size(); ++i) {
+        auto thread = Threading::Thread::construct([&block = m_prefetched_blocks[i], &decode_block]() -> intptr_t {
+            decode_block(block);
+            return 0;
+        },
+            "XzDecompressor"sv);
+        thread->start();
+        threads.unchecked_append(move(thread));
+    }
+
+    decode_block(m_prefetched_blocks[0]);
+
+    for (auto& thread : threads)
+        (void)thread->join();
+
+    return start_next_prefetched_block();
+}
+
+ErrorOr<void> XzDecompressor::start_next_prefetched_block()
+{
+    auto block = m_prefetched_blocks.take_first();
+    if (block.error.has_value())
+        return block.error.release_value();
+
+    m_current_block_prefetched_data = move(block.uncompressed_data);
+    m_current_block_stream = TRY(try_make<FixedMemoryStream>(m_current_block_prefetched_data.bytes()));
+    m_current_block_expected_uncompressed_size = block.header.uncompressed_size;
+    m_current_block_uncompressed_size = 0;
+    m_current_block_start_offset = block.header.start_offset;
+    m_current_block_unpadded_size = block.unpadded_size;
+
+    return {};
+}
+
+ErrorOr<u64> XzDecompressor::read_block_padding_and_check(u64 unpadded_size)
+{
     // 3.3. Block Padding:
     // "Block Padding MUST contain 0-3 null bytes to make the size of
     //  the Block a multiple of four bytes. This can be needed when
@@ -640,6 +758,17 @@ ErrorOr<void> XzDecompressor::finish_current_block()
     TRY(m_stream->discard(*maybe_check_size));
     unpadded_size += *maybe_check_size;
 
+    return unpadded_size;
+}
+
+ErrorOr<void> XzDecompressor::finish_current_block()
+{
+    u64 unpadded_size;
+    if (m_current_block_unpadded_size.has_value())
+        unpadded_size = *m_current_block_unpadded_size;
+    else
+        unpadded_size = TRY(read_block_padding_and_check(m_stream->read_bytes() - m_current_block_start_offset));
+
     if (m_current_block_expected_uncompressed_size.has_value()) {
         if (*m_current_block_expected_uncompressed_size != m_current_block_uncompressed_size)
             return Error::from_string_literal("Uncompressed size of XZ block does not match the expected value");
@@ -767,23 +896,39 @@ ErrorOr<Bytes> XzDecompressor::read_some(Bytes bytes)
         if (m_current_block_stream.has_value()) {
             // We have already processed a block, so we weed to clean up trailing data before the next block starts.
             TRY(finish_current_block());
+            m_current_block_stream.clear();
+            m_current_block_prefetched_data.clear();
         }
 
-        // The first byte between Block Header (3.1.1. Block Header Size) and Index (4.1. Index Indicator) overlap.
-        // Block header sizes have valid values in the range of [0x01, 0xFF], the only valid value for an Index Indicator is therefore 0x00.
-        auto const encoded_block_header_size_or_index_indicator = TRY(m_stream->read_value<u8>());
-
-        if (encoded_block_header_size_or_index_indicator == 0x00) {
-            // This is an Index, which is the last element before the stream footer.
-            TRY(finish_current_stream());
+        if (!m_prefetched_blocks.is_empty()) {
+            TRY(start_next_prefetched_block());
+        } else if (m_next_block_header.has_value()) {
+            TRY(start_block(m_next_block_header.release_value()));
+        } else {
+            // The first byte between Block Header (3.1.1. Block Header Size) and Index (4.1. Index Indicator) overlap.
+            // Block header sizes have valid values in the range of [0x01, 0xFF], the only valid value for an Index Indicator is therefore 0x00.
+            u8 encoded_block_header_size_or_index_indicator;
+            if (m_next_block_header_size_or_index_indicator.has_value())
+                encoded_block_header_size_or_index_indicator = m_next_block_header_size_or_index_indicator.release_value();
+            else
+                encoded_block_header_size_or_index_indicator = TRY(m_stream->read_value<u8>());
+
+            if (encoded_block_header_size_or_index_indicator == 0x00) {
+                // This is an Index, which is the last element before the stream footer.
+                TRY(finish_current_stream());
+
+                // Another XZ Stream might follow, so we just unset the current information and continue on the next read.
+                m_stream_flags.clear();
+                m_processed_blocks.clear();
+                return bytes.trim(0);
+            }
 
-            // Another XZ Stream might follow, so we just unset the current information and continue on the next read.
-            m_stream_flags.clear();
-            m_processed_blocks.clear();
-            return bytes.trim(0);
+            auto block_header = TRY(read_block_header(encoded_block_header_size_or_index_indicator));
+            if (m_thread_count > 1)
+                TRY(prefetch_blocks(move(block_header)));
+            else
+                TRY(start_block(move(block_header)));
         }
-
-        TRY(load_next_block(encoded_block_header_size_or_index_indicator));
     }
 
     auto result = TRY((*m_current_block_stream)->read_some(bytes));
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/ByteBuffer.h>
 #include <AK/CircularBuffer.h>
 #include <AK/ConstrainedStream.h>
 #include <AK/CountingStream.h>
@@ -154,7 +155,9 @@ private:
 
 class XzDecompressor : public Stream {
 public:
-    static ErrorOr<NonnullOwnPtr<XzDecompressor>> create(MaybeOwned<Stream>);
+    // Blocks that store their sizes in the Block Header can be decoded independently of each other.
+    // With a thread count larger than one, up to that many of those blocks are read ahead and decoded in parallel.
+    static ErrorOr<NonnullOwnPtr<XzDecompressor>> create(MaybeOwned<Stream>, size_t thread_count = 1);
 
     virtual ErrorOr<Bytes> read_some(Bytes) override;
     virtual ErrorOr<size_t> write_some(ReadonlyBytes) override;
@@ -163,14 +166,46 @@ public:
     virtual void close() override;
 
 private:
-    XzDecompressor(NonnullOwnPtr<CountingStream>);
+    XzDecompressor(NonnullOwnPtr<CountingStream>, size_t thread_count);
+
+    struct FilterEntry {
+        u64 id;
+        ByteBuffer properties;
+        bool last;
+    };
+
+    struct BlockHeader {
+        u64 start_offset {};
+        Optional<u64> compressed_size {};
+        Optional<u64> uncompressed_size {};
+
+        // These are in the order that they have been applied in, so they need to be undone in reverse.
+        Vector<FilterEntry, 4> filters {};
+    };
+
+    struct PrefetchedBlock {
+        BlockHeader header;
+        ByteBuffer compressed_data;
+        u64 unpadded_size {};
+        ByteBuffer uncompressed_data {};
+        Optional<Error> error {};
+    };
+
+    // Prefetching stops once the decoded blocks would take up more memory than this.
+    static constexpr u64 maximum_prefetched_size = 256 * MiB;
 
     ErrorOr<bool> load_next_stream();
-    ErrorOr<void> load_next_block(u8 encoded_block_header_size);
+    ErrorOr<BlockHeader> read_block_header(u8 encoded_block_header_size);
+    static ErrorOr<MaybeOwned<Stream>> create_block_stream(MaybeOwned<Stream>, BlockHeader&);
+    ErrorOr<void> start_block(BlockHeader);
+    ErrorOr<void> prefetch_blocks(BlockHeader);
+    ErrorOr<void> start_next_prefetched_block();
+    ErrorOr<u64> read_block_padding_and_check(u64 unpadded_size);
     ErrorOr<void> finish_current_block();
     ErrorOr<void> finish_current_stream();
 
     NonnullOwnPtr<CountingStream> m_stream;
+    size_t m_thread_count { 1 };
     Optional<XzStreamFlags> m_stream_flags;
     bool m_found_first_stream_header { false };
     bool m_found_last_stream_footer { false };
@@ -180,6 +215,15 @@ private:
     u64 m_current_block_uncompressed_size {};
     u64 m_current_block_start_offset {};
 
+    // Prefetched blocks have their padding and check read along with their data, so their unpadded size is known up front.
+    Optional<u64> m_current_block_unpadded_size {};
+    ByteBuffer m_current_block_prefetched_data {};
+    Vector<PrefetchedBlock> m_prefetched_blocks;
+
+    // Prefetching may have to look at the start of the following element to know when to stop.
+    Optional<u8> m_next_block_header_size_or_index_indicator {};
+    Optional<BlockHeader> m_next_block_header {};
+
     struct BlockMetadata {
         u64 uncompressed_size {};
         u64 unpadded_size {};
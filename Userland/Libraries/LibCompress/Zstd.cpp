@@ -0,0 +1,1776 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/BuiltinWrappers.h>
+#include <AK/ByteReader.h>
+#include <AK/Endian.h>
+#include <AK/MemoryStream.h>
+#include <LibCompress/Huffman.h>
+#include <LibCompress/Zstd.h>
+
+namespace Compress {
+
+static constexpr u32 frame_magic = 0xFD2FB528;
+static constexpr u32 skippable_frame_magic = 0x184D2A50;
+static constexpr u32 skippable_frame_magic_mask = 0xFFFFFFF0;
+
+// https://datatracker.ietf.org/doc/html/rfc8878#section-3.1.1.2.3
+static constexpr size_t block_maximum_size = 128 * KiB;
+
+static constexpr u8 minimum_window_log = 10;
+static constexpr u8 max_huffman_bits = 11;
+static constexpr u8 max_huffman_weights_accuracy_log = 6;
+static constexpr u8 max_literal_lengths_accuracy_log = 9;
+static constexpr u8 max_offsets_accuracy_log = 8;
+static constexpr u8 max_match_lengths_accuracy_log = 9;
+static constexpr u8 max_literal_length_code = 35;
+static constexpr u8 max_offset_code = 31;
+static constexpr u8 max_match_length_code = 52;
+static constexpr size_t minimum_match_length = 3;
+
+enum class BlockType : u8 {
+    Raw = 0,
+    RLE = 1,
+    Compressed = 2,
+    Reserved = 3,
+};
+
+enum class LiteralsBlockType : u8 {
+    Raw = 0,
+    RLE = 1,
+    Compressed = 2,
+    Treeless = 3,
+};
+
+enum class SymbolCompressionMode : u8 {
+    Predefined = 0,
+    RLE = 1,
+    FSECompressed = 2,
+    Repeat = 3,
+};
+
+// https://datatracker.ietf.org/doc/html/rfc8878#section-3.1.1.3.2.1.1
+static constexpr Array<u32, 36> literal_length_baselines {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+    16, 18, 20, 22, 24, 28, 32, 40, 48, 64, 128, 256, 512, 1024, 2048, 4096,
+    8192, 16384, 32768, 65536
+};
+static constexpr Array<u8, 36> literal_length_extra_bits {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    1, 1, 1, 1, 2, 2, 3, 3, 4, 6, 7, 8, 9, 10, 11, 12,
+    13, 14, 15, 16
+};
+
+static constexpr Array<u32, 53> match_length_baselines {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18,
+    19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34,
+    35, 37, 39, 41, 43, 47, 51, 59, 67, 83, 99, 131, 259, 515, 1027, 2051,
+    4099, 8195, 16387, 32771, 65539
+};
+static constexpr Array<u8, 53> match_length_extra_bits {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    1, 1, 1, 1, 2, 2, 3, 3, 4, 4, 5, 7, 8, 9, 10, 11,
+    12, 13, 14, 15, 16
+};
+
+// https://datatracker.ietf.org/doc/html/rfc8878#section-3.1.1.3.2.2
+static constexpr u8 default_literal_lengths_accuracy_log = 6;
+static constexpr Array<i16, 36> default_literal_lengths_distribution {
+    4, 3, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 1, 1, 1,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 3, 2, 1, 1, 1, 1, 1,
+    -1, -1, -1, -1
+};
+
+static constexpr u8 default_match_lengths_accuracy_log = 6;
+static constexpr Array<i16, 53> default_match_lengths_distribution {
+    1, 4, 3, 2, 2, 2, 2, 2, 2, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, -1, -1,
+    -1, -1, -1, -1, -1
+};
+
+static constexpr u8 default_offsets_accuracy_log = 5;
+static constexpr Array<i16, 29> default_offsets_distribution {
+    1, 1, 1, 1, 1, 1, 2, 2, 2, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, -1, -1, -1, -1, -1
+};
+
+static ALWAYS_INLINE u8 highest_bit(u32 value)
+{
+    return count_required_bits(value) - 1;
+}
+
+// https://datatracker.ietf.org/doc/html/rfc8878#section-3.1.2.5
+static u32 resolve_offset(u32 offset_value, u32 literal_length, Array<u32, 3>& repeated_offsets)
+{
+    if (offset_value > 3) {
+        u32 offset = offset_value - 3;
+        repeated_offsets[2] = repeated_offsets[1];
+        repeated_offsets[1] = repeated_offsets[0];
+        repeated_offsets[0] = offset;
+        return offset;
+    }
+
+    // When there are no literals in front of the match, repeating the last offset would have made the previous sequence longer instead,
+    // so the repeated offsets are shifted by one, and the last one is replaced by the most recent offset minus one.
+    auto index = literal_length == 0 ? offset_value : offset_value - 1;
+    if (index == 0)
+        return repeated_offsets[0];
+
+    u32 offset = index == 3 ? repeated_offsets[0] - 1 : repeated_offsets[index];
+    if (index > 1)
+        repeated_offsets[2] = repeated_offsets[1];
+    repeated_offsets[1] = repeated_offsets[0];
+    repeated_offsets[0] = offset;
+    return offset;
+}
+
+// Reads a bitstream from the lowest bit of its first byte onwards, which is how FSE table descriptions are stored.
+class ForwardBitReader {
+public:
+    explicit ForwardBitReader(ReadonlyBytes data)
+        : m_data(data)
+    {
+    }
+
+    // Bits past the end of the data read as zero, so that the caller can look ahead further than it ends up needing to.
+    u32 peek_bits(u8 count) const
+    {
+        u32 value = 0;
+        for (u8 i = 0; i < count; ++i) {
+            auto position = m_position + i;
+            if (position / 8 < m_data.size() && ((m_data[position / 8] >> (position % 8)) & 1))
+                value |= 1u << i;
+        }
+        return value;
+    }
+
+    ErrorOr<void> discard_bits(u8 count)
+    {
+        m_position += count;
+        if (m_position > m_data.size() * 8)
+            return Error::from_string_literal("Zstandard FSE table description is truncated");
+        return {};
+    }
+
+    ErrorOr<u32> read_bits(u8 count)
+    {
+        auto value = peek_bits(count);
+        TRY(discard_bits(count));
+        return value;
+    }
+
+    size_t bytes_consumed() const { return ceil_div(m_position, 8ul); }
+
+private:
+    ReadonlyBytes m_data;
+    size_t m_position { 0 };
+};
+
+// Reads a bitstream backwards, starting below the highest set bit of its last byte. This is how all Huffman and FSE coded data is stored.
+class BackwardBitReader {
+public:
+    static ErrorOr<BackwardBitReader> create(ReadonlyBytes data)
+    {
+        if (data.is_empty() || data.last() == 0)
+            return Error::from_string_literal("Zstandard bitstream is missing its end marker");
+        return BackwardBitReader { data, static_cast<i64>((data.size() - 1) * 8 + highest_bit(data.last())) };
+    }
+
+    // Bits before the start of the data read as zero. Whether that is an error is up to the caller, see position().
+    ALWAYS_INLINE u32 read_bits(u8 count)
+    {
+        if (count == 0)
+            return 0;
+
+        m_position -= count;
+        if (m_position >= 0) [[likely]]
+            return (load_bits_at(m_position) & ((1ull << count) - 1));
+
+        if (m_position <= -static_cast<i64>(count))
+            return 0;
+        auto available_bits = count + m_position;
+        return (load_bits_at(0) & ((1ull << available_bits) - 1)) << -m_position;
+    }
+
+    i64 position() const { return m_position; }
+    bool is_overflowed() const { return m_position < 0; }
+
+private:
+    BackwardBitReader(ReadonlyBytes data, i64 position)
+        : m_data(data)
+        , m_position(position)
+    {
+    }
+
+    ALWAYS_INLINE u64 load_bits_at(i64 bit_position) const
+    {
+        size_t byte_position = bit_position / 8;
+        u64 value = 0;
+        if (byte_position + 8 <= m_data.size()) {
+            value = AK::convert_between_host_and_little_endian(ByteReader::load64(m_data.offset_pointer(byte_position)));
+        } else {
+            for (size_t i = byte_position; i < m_data.size(); ++i)
+                value |= static_cast<u64>(m_data[i]) << ((i - byte_position) * 8);
+        }
+        return value >> (bit_position % 8);
+    }
+
+    ReadonlyBytes m_data;
+    i64 m_position { 0 };
+};
+
+// https://datatracker.ietf.org/doc/html/rfc8878#section-4.1.1
+static ErrorOr<void> build_fse_table(ZstdDecompressor::FSETable& table, ReadonlySpan<i16> probabilities, u8 accuracy_log)
+{
+    size_t size = 1u << accuracy_log;
+    Array<u16, 256> next_state_descriptors {};
+
+    // Symbols with a "less than 1" probability each get a single cell at the end of the table, which resets the state completely.
+    size_t high_threshold = size;
+    for (size_t symbol = 0; symbol < probabilities.size(); ++symbol) {
+        if (probabilities[symbol] != -1)
+            continue;
+        table.entries[--high_threshold].symbol = symbol;
+        next_state_descriptors[symbol] = 1;
+    }
+
+    size_t step = (size >> 1) + (size >> 3) + 3;
+    size_t mask = size - 1;
+    size_t position = 0;
+    for (size_t symbol = 0; symbol < probabilities.size(); ++symbol) {
+        if (probabilities[symbol] <= 0)
+            continue;
+        next_state_descriptors[symbol] = probabilities[symbol];
+        for (i16 i = 0; i < probabilities[symbol]; ++i) {
+            table.entries[position].symbol = symbol;
+            do {
+                position = (position + step) & mask;
+            } while (position >= high_threshold);
+        }
+    }
+    if (position != 0)
+        return Error::from_string_literal("Zstandard FSE distribution is invalid");
+
+    for (size_t state = 0; state < size; ++state) {
+        auto& entry = table.entries[state];
+        u16 next_state_descriptor = next_state_descriptors[entry.symbol]++;
+        entry.number_of_bits = accuracy_log - highest_bit(next_state_descriptor);
+        entry.base = (next_state_descriptor << entry.number_of_bits) - size;
+    }
+
+    table.accuracy_log = accuracy_log;
+    table.is_valid = true;
+    return {};
+}
+
+// https://datatracker.ietf.org/doc/html/rfc8878#section-4.1.1
+static ErrorOr<size_t> read_fse_table(ZstdDecompressor::FSETable& table, ReadonlyBytes data, u8 maximum_accuracy_log, u8 maximum_symbol)
+{
+    ForwardBitReader reader { data };
+
+    u8 accuracy_log = TRY(reader.read_bits(4)) + 5;
+    if (accuracy_log > maximum_accuracy_log)
+        return Error::from_string_literal("Zstandard FSE table has an accuracy log that is too large");
+
+    Array<i16, 256> probabilities {};
+    i32 remaining = 1 << accuracy_log;
+    size_t symbol_count = 0;
+    while (remaining > 0) {
+        if (symbol_count > maximum_symbol)
+            return Error::from_string_literal("Zstandard FSE table has too many symbols");
+
+        // The value can range from 0 to remaining + 1, and the smaller values are encoded with one bit less than the larger ones.
+        u8 bit_count = highest_bit(remaining + 1) + 1;
+        u32 value = reader.peek_bits(bit_count);
+        u32 lower_mask = (1u << (bit_count - 1)) - 1;
+        u32 threshold = (1u << bit_count) - 1 - (remaining + 1);
+        if ((value & lower_mask) < threshold) {
+            TRY(reader.discard_bits(bit_count - 1));
+            value &= lower_mask;
+        } else {
+            TRY(reader.discard_bits(bit_count));
+            if (value > lower_mask)
+                value -= threshold;
+        }
+
+        // A probability of -1 means "less than 1", which takes up a single cell.
+        i16 probability = static_cast<i16>(value) - 1;
+        remaining -= probability < 0 ? -probability : probability;
+        probabilities[symbol_count++] = probability;
+
+        if (probability == 0) {
+            while (true) {
+                auto repeat = TRY(reader.read_bits(2));
+                if (symbol_count + repeat > static_cast<size_t>(maximum_symbol) + 1)
+                    return Error::from_string_literal("Zstandard FSE table has too many symbols");
+                symbol_count += repeat;
+                if (repeat != 3)
+                    break;
+            }
+        }
+    }
+    if (remaining != 0)
+        return Error::from_string_literal("Zstandard FSE table probabilities do not add up");
+
+    TRY(build_fse_table(table, probabilities.span().trim(symbol_count), accuracy_log));
+    return reader.bytes_consumed();
+}
+
+static ErrorOr<size_t> update_fse_table(ZstdDecompressor::FSETable& table, SymbolCompressionMode mode, ReadonlyBytes data, ReadonlySpan<i16> default_distribution, u8 default_accuracy_log, u8 maximum_accuracy_log, u8 maximum_symbol)
+{
+    switch (mode) {
+    case SymbolCompressionMode::Predefined:
+        TRY(build_fse_table(table, default_distribution, default_accuracy_log));
+        return 0;
+    case SymbolCompressionMode::RLE:
+        if (data.is_empty())
+            return Error::from_string_literal("Zstandard sequences section is truncated");
+        if (data[0] > maximum_symbol)
+            return Error::from_string_literal("Zstandard RLE symbol is out of range");
+        table.entries[0] = { data[0], 0, 0 };
+        table.accuracy_log = 0;
+        table.is_valid = true;
+        return 1;
+    case SymbolCompressionMode::FSECompressed:
+        return read_fse_table(table, data, maximum_accuracy_log, maximum_symbol);
+    case SymbolCompressionMode::Repeat:
+        if (!table.is_valid)
+            return Error::from_string_literal("Zstandard block repeats an FSE table that was never defined");
+        return 0;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+static ErrorOr<void> decode_huffman_stream(ZstdDecompressor::HuffmanTable const& table, ReadonlyBytes stream, Bytes output)
+{
+    auto reader = TRY(BackwardBitReader::create(stream));
+    auto max_number_of_bits = table.max_number_of_bits;
+    u32 mask = (1u << max_number_of_bits) - 1;
+
+    // The state always holds the next max_number_of_bits bits of the stream, which is enough to look up any symbol.
+    u32 state = reader.read_bits(max_number_of_bits);
+    for (auto& byte : output) {
+        auto entry = table.entries[state];
+        byte = entry.symbol;
+        state = ((state << entry.number_of_bits) | reader.read_bits(entry.number_of_bits)) & mask;
+    }
+
+    // The state has looked ahead by max_number_of_bits after the last symbol, so that is exactly how far before the start we should be.
+    if (reader.position() != -static_cast<i64>(max_number_of_bits))
+        return Error::from_string_literal("Zstandard Huffman stream was not fully consumed");
+    return {};
+}
+
+ErrorOr<NonnullOwnPtr<ZstdDecompressor>> ZstdDecompressor::create(MaybeOwned<Stream> stream)
+{
+    auto block_buffer = TRY(ByteBuffer::create_uninitialized(block_maximum_size));
+    auto literals = TRY(ByteBuffer::create_uninitialized(block_maximum_size));
+    return adopt_nonnull_own_or_enomem(new (nothrow) ZstdDecompressor(move(stream), move(block_buffer), move(literals)));
+}
+
+ZstdDecompressor::ZstdDecompressor(MaybeOwned<Stream> stream, ByteBuffer block_buffer, ByteBuffer literals)
+    : m_stream(move(stream))
+    , m_block_buffer(move(block_buffer))
+    , m_literals(move(literals))
+{
+}
+
+// https://datatracker.ietf.org/doc/html/rfc8878#section-3.1.1.1
+ErrorOr<bool> ZstdDecompressor::read_frame_header()
+{
+    while (true) {
+        // Reaching the end of the input in between frames is how a stream ends.
+        Array<u8, 4> magic_bytes;
+        size_t magic_size = 0;
+        while (magic_size < magic_bytes.size()) {
+            auto read = TRY(m_stream->read_some(magic_bytes.span().slice(magic_size)));
+            if (read.is_empty() && m_stream->is_eof())
+                break;
+            magic_size += read.size();
+        }
+        if (magic_size == 0)
+            return false;
+        if (magic_size < magic_bytes.size())
+            return Error::from_string_literal("Zstandard frame header is truncated");
+
+        u32 magic = magic_bytes[0] | (magic_bytes[1] << 8) | (magic_bytes[2] << 16) | (static_cast<u32>(magic_bytes[3]) << 24);
+
+        // https://datatracker.ietf.org/doc/html/rfc8878#section-3.1.2
+        if ((magic & skippable_frame_magic_mask) == skippable_frame_magic) {
+            auto frame_size = TRY(m_stream->read_value<LittleEndian<u32>>());
+            TRY(m_stream->discard(frame_size));
+            continue;
+        }
+
+        if (magic != frame_magic)
+            return Error::from_string_literal("Invalid Zstandard frame magic");
+        break;
+    }
+
+    auto descriptor = TRY(m_stream->read_value<u8>());
+    u8 frame_content_size_flag = descriptor >> 6;
+    bool single_segment = (descriptor >> 5) & 1;
+    bool has_checksum = (descriptor >> 2) & 1;
+    u8 dictionary_id_flag = descriptor & 3;
+    if ((descriptor >> 3) & 1)
+        return Error::from_string_literal("Zstandard frame header has the reserved bit set");
+
+    FrameHeader header;
+    header.has_checksum = has_checksum;
+
+    if (!single_segment) {
+        auto window_descriptor = TRY(m_stream->read_value<u8>());
+        u8 exponent = window_descriptor >> 3;
+        u8 mantissa = window_descriptor & 7;
+        u64 window_base = 1ull << (minimum_window_log + exponent);
+        header.window_size = window_base + (window_base / 8) * mantissa;
+    }
+
+    static constexpr Array<u8, 4> dictionary_id_sizes { 0, 1, 2, 4 };
+    u32 dictionary_id = 0;
+    for (u8 i = 0; i < dictionary_id_sizes[dictionary_id_flag]; ++i)
+        dictionary_id |= static_cast<u32>(TRY(m_stream->read_value<u8>())) << (i * 8);
+    // FIXME: Support dictionaries.
+    if (dictionary_id != 0)
+        return Error::from_string_literal("Zstandard dictionaries are not supported");
+
+    static constexpr Array<u8, 4> frame_content_size_sizes { 0, 2, 4, 8 };
+    u8 frame_content_size_size = frame_content_size_flag == 0 && single_segment ? 1 : frame_content_size_sizes[frame_content_size_flag];
+    if (frame_content_size_size > 0) {
+        u64 content_size = 0;
+        for (u8 i = 0; i < frame_content_size_size; ++i)
+            content_size |= static_cast<u64>(TRY(m_stream->read_value<u8>())) << (i * 8);
+        if (frame_content_size_size == 2)
+            content_size += 256;
+        header.content_size = content_size;
+    }
+
+    if (single_segment)
+        header.window_size = header.content_size.value();
+
+    if (header.window_size > maximum_window_size)
+        return Error::from_string_literal("Zstandard frame needs a window that is too large");
+
+    // Output is handed out after every block, so we only need to keep the window around, plus the block that is being decoded.
+    m_block_maximum_size = min(header.window_size, block_maximum_size);
+    auto history_size = min(header.window_size, header.content_size.value_or(header.window_size));
+    auto window_capacity = max(history_size + m_block_maximum_size, 1);
+    if (!m_window.has_value() || m_window->capacity() != window_capacity)
+        m_window = TRY(CircularBuffer::create_empty(window_capacity));
+    else
+        m_window->clear();
+
+    m_frame = header;
+    m_last_block_seen = false;
+    m_frame_decoded_size = 0;
+    m_checksum = Crypto::Checksum::XXH64 {};
+    m_repeated_offsets = { 1, 4, 8 };
+    m_huffman_table.is_valid = false;
+    m_literal_lengths_table.is_valid = false;
+    m_offsets_table.is_valid = false;
+    m_match_lengths_table.is_valid = false;
+    return true;
+}
+
+// https://datatracker.ietf.org/doc/html/rfc8878#section-3.1.1.2
+ErrorOr<void> ZstdDecompressor::decode_block()
+{
+    Array<u8, 3> header_bytes;
+    TRY(m_stream->read_until_filled(header_bytes));
+    u32 header = header_bytes[0] | (header_bytes[1] << 8) | (header_bytes[2] << 16);
+
+    m_last_block_seen = header & 1;
+    auto type = static_cast<BlockType>((header >> 1) & 3);
+    size_t size = header >> 3;
+
+    if (size > m_block_maximum_size)
+        return Error::from_string_literal("Zstandard block is larger than the maximum block size");
+
+    switch (type) {
+    case BlockType::Raw: {
+        auto data = m_block_buffer.span().trim(size);
+        TRY(m_stream->read_until_filled(data));
+        m_window->write(data);
+        m_frame_decoded_size += size;
+        return {};
+    }
+    case BlockType::RLE: {
+        auto data = m_block_buffer.span().trim(size);
+        data.fill(TRY(m_stream->read_value<u8>()));
+        m_window->write(data);
+        m_frame_decoded_size += size;
+        return {};
+    }
+    case BlockType::Compressed: {
+        auto data = m_block_buffer.span().trim(size);
+        TRY(m_stream->read_until_filled(data));
+        return decode_compressed_block(data);
+    }
+    case BlockType::Reserved:
+        return Error::from_string_literal("Zstandard block has the reserved block type");
+    }
+    VERIFY_NOT_REACHED();
+}
+
+ErrorOr<void> ZstdDecompressor::decode_compressed_block(ReadonlyBytes block)
+{
+    auto literals_section_size = TRY(decode_literals_section(block));
+    return decode_sequences_section(block.slice(literals_section_size));
+}
+
+// https://datatracker.ietf.org/doc/html/rfc8878#section-3.1.1.3.1
+ErrorOr<size_t> ZstdDecompressor::decode_literals_section(ReadonlyBytes block)
+{
+    if (block.is_empty())
+        return Error::from_string_literal("Zstandard literals section is missing");
+
+    auto type = static_cast<LiteralsBlockType>(block[0] & 3);
+    u8 size_format = (block[0] >> 2) & 3;
+
+    if (type == LiteralsBlockType::Raw || type == LiteralsBlockType::RLE) {
+        size_t header_size = 1;
+        size_t regenerated_size = block[0] >> 3;
+        if (size_format == 1) {
+            header_size = 2;
+        } else if (size_format == 3) {
+            header_size = 3;
+        }
+        if (block.size() < header_size)
+            return Error::from_string_literal("Zstandard literals section header is truncated");
+        if (header_size == 2)
+            regenerated_size = (block[0] >> 4) + (block[1] << 4);
+        else if (header_size == 3)
+            regenerated_size = (block[0] >> 4) + (block[1] << 4) + (block[2] << 12);
+
+        if (regenerated_size > m_block_maximum_size)
+            return Error::from_string_literal("Zstandard literals section is larger than the maximum block size");
+        m_literals_size = regenerated_size;
+
+        if (type == LiteralsBlockType::Raw) {
+            if (block.size() < header_size + regenerated_size)
+                return Error::from_string_literal("Zstandard literals section is truncated");
+            block.slice(header_size, regenerated_size).copy_to(m_literals);
+            return header_size + regenerated_size;
+        }
+
+        if (block.size() < header_size + 1)
+            return Error::from_string_literal("Zstandard literals section is truncated");
+        m_literals.span().trim(regenerated_size).fill(block[header_size]);
+        return header_size + 1;
+    }
+
+    static constexpr Array<u8, 4> header_sizes { 3, 3, 4, 5 };
+    size_t header_size = header_sizes[size_format];
+    if (block.size() < header_size)
+        return Error::from_string_literal("Zstandard literals section header is truncated");
+
+    u64 header = 0;
+    for (size_t i = 0; i < header_size; ++i)
+        header |= static_cast<u64>(block[i]) << (i * 8);
+    u8 size_bits = size_format < 2 ? 10 : (size_format == 2 ? 14 : 18);
+    size_t regenerated_size = (header >> 4) & ((1u << size_bits) - 1);
+    size_t compressed_size = (header >> (4 + size_bits)) & ((1u << size_bits) - 1);
+    bool has_four_streams = size_format != 0;
+
+    if (regenerated_size > m_block_maximum_size)
+        return Error::from_string_literal("Zstandard literals section is larger than the maximum block size");
+    if (block.size() < header_size + compressed_size)
+        return Error::from_string_literal("Zstandard literals section is truncated");
+
+    auto data = block.slice(header_size, compressed_size);
+    if (type == LiteralsBlockType::Compressed) {
+        auto tree_description_size = TRY(read_huffman_table(data));
+        data = data.slice(tree_description_size);
+    } else if (!m_huffman_table.is_valid) {
+        return Error::from_string_literal("Zstandard block reuses a Huffman table that was never defined");
+    }
+
+    m_literals_size = regenerated_size;
+    auto literals = m_literals.span().trim(regenerated_size);
+
+    if (!has_four_streams) {
+        TRY(decode_huffman_stream(m_huffman_table, data, literals));
+        return header_size + compressed_size;
+    }
+
+    // https://datatracker.ietf.org/doc/html/rfc8878#section-3.1.1.3.1.6
+    if (data.size() < 6)
+        return Error::from_string_literal("Zstandard literals jump table is truncated");
+    Array<size_t, 4> stream_sizes;
+    size_t total_stream_size = 0;
+    for (size_t i = 0; i < 3; ++i) {
+        stream_sizes[i] = data[i * 2] | (data[i * 2 + 1] << 8);
+        total_stream_size += stream_sizes[i];
+    }
+    data = data.slice(6);
+    if (total_stream_size > data.size())
+        return Error::from_string_literal("Zstandard literals streams are larger than the literals section");
+    stream_sizes[3] = data.size() - total_stream_size;
+
+    size_t segment_size = ceil_div(regenerated_size, 4ul);
+    if (segment_size * 3 > regenerated_size)
+        return Error::from_string_literal("Zstandard literals section is too small for four streams");
+
+    for (size_t i = 0; i < 4; ++i) {
+        auto output = i < 3 ? literals.slice(i * segment_size, segment_size) : literals.slice(3 * segment_size);
+        TRY(decode_huffman_stream(m_huffman_table, data.trim(stream_sizes[i]), output));
+        data = data.slice(stream_sizes[i]);
+    }
+
+    return header_size + compressed_size;
+}
+
+// https://datatracker.ietf.org/doc/html/rfc8878#section-4.2.1
+ErrorOr<size_t> ZstdDecompressor::read_huffman_table(ReadonlyBytes data)
+{
+    if (data.is_empty())
+        return Error::from_string_literal("Zstandard Huffman tree description is missing");
+
+    // The weight of the last symbol is implied, and a few more can be decoded from the FSE stream before we notice that it has ended.
+    Array<u8, 260> weights {};
+    size_t weight_count = 0;
+    size_t description_size = 0;
+    u8 header = data[0];
+
+    if (header >= 128) {
+        weight_count = header - 127;
+        description_size = 1 + ceil_div(weight_count, 2ul);
+        if (data.size() < description_size)
+            return Error::from_string_literal("Zstandard Huffman tree description is truncated");
+        for (size_t i = 0; i < weight_count; ++i) {
+            auto byte = data[1 + i / 2];
+            weights[i] = i % 2 == 0 ? byte >> 4 : byte & 0xf;
+        }
+    } else {
+        description_size = 1 + header;
+        if (data.size() < description_size)
+            return Error::from_string_literal("Zstandard Huffman tree description is truncated");
+        auto compressed_weights = data.slice(1, header);
+
+        FSETable table;
+        auto table_description_size = TRY(read_fse_table(table, compressed_weights, max_huffman_weights_accuracy_log, 255));
+        auto reader = TRY(BackwardBitReader::create(compressed_weights.slice(table_description_size)));
+
+        // The weights are encoded with two interleaved FSE states, and are decoded until the bitstream runs out.
+        u32 state_1 = reader.read_bits(table.accuracy_log);
+        u32 state_2 = reader.read_bits(table.accuracy_log);
+        while (true) {
+            if (weight_count > 255)
+                return Error::from_string_literal("Zstandard Huffman tree description has too many weights");
+
+            weights[weight_count++] = table.entries[state_1].symbol;
+            state_1 = table.entries[state_1].base + reader.read_bits(table.entries[state_1].number_of_bits);
+            if (reader.is_overflowed()) {
+                weights[weight_count++] = table.entries[state_2].symbol;
+                break;
+            }
+
+            weights[weight_count++] = table.entries[state_2].symbol;
+            state_2 = table.entries[state_2].base + reader.read_bits(table.entries[state_2].number_of_bits);
+            if (reader.is_overflowed()) {
+                weights[weight_count++] = table.entries[state_1].symbol;
+                break;
+            }
+        }
+        if (weight_count > 255)
+            return Error::from_string_literal("Zstandard Huffman tree description has too many weights");
+    }
+
+    // The weight of the last symbol is whatever makes the sum of all 2^(weight - 1) a power of two.
+    u32 weight_sum = 0;
+    for (size_t i = 0; i < weight_count; ++i) {
+        if (weights[i] > max_huffman_bits)
+            return Error::from_string_literal("Zstandard Huffman weight is too large");
+        if (weights[i] > 0)
+            weight_sum += 1u << (weights[i] - 1);
+    }
+    if (weight_sum == 0)
+        return Error::from_string_literal("Zstandard Huffman tree has no symbols");
+
+    u8 max_number_of_bits = highest_bit(weight_sum) + 1;
+    if (max_number_of_bits > max_huffman_bits)
+        return Error::from_string_literal("Zstandard Huffman tree is too deep");
+    u32 left_over = (1u << max_number_of_bits) - weight_sum;
+    if (!is_power_of_two(left_over))
+        return Error::from_string_literal("Zstandard Huffman tree is incomplete");
+    weights[weight_count++] = highest_bit(left_over) + 1;
+
+    // Symbols with more bits come first, and within the same number of bits, symbols are in their natural order.
+    Array<u8, 256> number_of_bits {};
+    Array<u32, max_huffman_bits + 1> rank_counts {};
+    for (size_t symbol = 0; symbol < weight_count; ++symbol) {
+        if (weights[symbol] > 0)
+            number_of_bits[symbol] = max_number_of_bits + 1 - weights[symbol];
+        ++rank_counts[number_of_bits[symbol]];
+    }
+
+    Array<u32, max_huffman_bits + 1> rank_starts {};
+    rank_starts[max_number_of_bits] = 0;
+    for (u8 bits = max_number_of_bits; bits > 1; --bits)
+        rank_starts[bits - 1] = rank_starts[bits] + (rank_counts[bits] << (max_number_of_bits - bits));
+
+    for (size_t symbol = 0; symbol < weight_count; ++symbol) {
+        auto bits = number_of_bits[symbol];
+        if (bits == 0)
+            continue;
+        auto length = 1u << (max_number_of_bits - bits);
+        for (u32 i = 0; i < length; ++i)
+            m_huffman_table.entries[rank_starts[bits] + i] = { static_cast<u8>(symbol), bits };
+        rank_starts[bits] += length;
+    }
+
+    m_huffman_table.max_number_of_bits = max_number_of_bits;
+    m_huffman_table.is_valid = true;
+    return description_size;
+}
+
+// https://datatracker.ietf.org/doc/html/rfc8878#section-3.1.1.3.2
+ErrorOr<void> ZstdDecompressor::decode_sequences_section(ReadonlyBytes data)
+{
+    if (data.is_empty())
+        return Error::from_string_literal("Zstandard sequences section is missing");
+
+    size_t offset = 1;
+    u32 sequence_count = data[0];
+    if (sequence_count >= 128) {
+        offset = sequence_count < 255 ? 2 : 3;
+        if (data.size() < offset)
+            return Error::from_string_literal("Zstandard sequences section header is truncated");
+        if (sequence_count < 255)
+            sequence_count = ((sequence_count - 128) << 8) + data[1];
+        else
+            sequence_count = data[1] + (data[2] << 8) + 0x7F00;
+    }
+
+    auto literals = m_literals.span().trim(m_literals_size);
+
+    if (sequence_count == 0) {
+        if (data.size() != offset)
+            return Error::from_string_literal("Zstandard block has data after an empty sequences section");
+        m_window->write(literals);
+        m_frame_decoded_size += literals.size();
+        return {};
+    }
+
+    if (data.size() < offset + 1)
+        return Error::from_string_literal("Zstandard sequences section header is truncated");
+    u8 modes = data[offset++];
+    if ((modes & 3) != 0)
+        return Error::from_string_literal("Zstandard sequences section has reserved bits set");
+
+    offset += TRY(update_fse_table(m_literal_lengths_table, static_cast<SymbolCompressionMode>(modes >> 6), data.slice(offset),
+        default_literal_lengths_distribution, default_literal_lengths_accuracy_log, max_literal_lengths_accuracy_log, max_literal_length_code));
+    offset += TRY(update_fse_table(m_offsets_table, static_cast<SymbolCompressionMode>((modes >> 4) & 3), data.slice(offset),
+        default_offsets_distribution, default_offsets_accuracy_log, max_offsets_accuracy_log, max_offset_code));
+    offset += TRY(update_fse_table(m_match_lengths_table, static_cast<SymbolCompressionMode>((modes >> 2) & 3), data.slice(offset),
+        default_match_lengths_distribution, default_match_lengths_accuracy_log, max_match_lengths_accuracy_log, max_match_length_code));
+
+    auto reader = TRY(BackwardBitReader::create(data.slice(offset)));
+    u32 literal_lengths_state = reader.read_bits(m_literal_lengths_table.accuracy_log);
+    u32 offsets_state = reader.read_bits(m_offsets_table.accuracy_log);
+    u32 match_lengths_state = reader.read_bits(m_match_lengths_table.accuracy_log);
+
+    size_t literals_position = 0;
+    size_t block_size = 0;
+    for (u32 i = 0; i < sequence_count; ++i) {
+        auto const& literal_lengths_entry = m_literal_lengths_table.entries[literal_lengths_state];
+        auto const& offsets_entry = m_offsets_table.entries[offsets_state];
+        auto const& match_lengths_entry = m_match_lengths_table.entries[match_lengths_state];
+
+        u8 offset_code = offsets_entry.symbol;
+        u32 offset_value = (1u << offset_code) + reader.read_bits(offset_code);
+        u32 match_length = match_length_baselines[match_lengths_entry.symbol] + reader.read_bits(match_length_extra_bits[match_lengths_entry.symbol]);
+        u32 literal_length = literal_length_baselines[literal_lengths_entry.symbol] + reader.read_bits(literal_length_extra_bits[literal_lengths_entry.symbol]);
+
+        if (i + 1 < sequence_count) {
+            literal_lengths_state = literal_lengths_entry.base + reader.read_bits(literal_lengths_entry.number_of_bits);
+            match_lengths_state = match_lengths_entry.base + reader.read_bits(match_lengths_entry.number_of_bits);
+            offsets_state = offsets_entry.base + reader.read_bits(offsets_entry.number_of_bits);
+        }
+
+        auto match_offset = resolve_offset(offset_value, literal_length, m_repeated_offsets);
+
+        if (literal_length > literals.size() - literals_position)
+            return Error::from_string_literal("Zstandard sequence uses more literals than there are");
+        block_size += literal_length + match_length;
+        if (block_size > m_block_maximum_size)
+            return Error::from_string_literal("Zstandard block decodes to more than the maximum block size");
+
+        m_window->write(literals.slice(literals_position, literal_length));
+        literals_position += literal_length;
+
+        if (match_offset == 0 || match_offset > m_frame->window_size || match_offset > m_window->seekback_limit())
+            return Error::from_string_literal("Zstandard sequence refers to data outside of the window");
+        auto copied = TRY(m_window->copy_from_seekback(match_offset, match_length));
+        VERIFY(copied == match_length);
+    }
+
+    if (reader.position() != 0)
+        return Error::from_string_literal("Zstandard sequences bitstream was not fully consumed");
+
+    auto remaining_literals = literals.slice(literals_position);
+    if (block_size + remaining_literals.size() > m_block_maximum_size)
+        return Error::from_string_literal("Zstandard block decodes to more than the maximum block size");
+    m_window->write(remaining_literals);
+    m_frame_decoded_size += block_size + remaining_literals.size();
+    return {};
+}
+
+ErrorOr<void> ZstdDecompressor::finish_frame()
+{
+    if (m_frame->content_size.has_value() && *m_frame->content_size != m_frame_decoded_size)
+        return Error::from_string_literal("Zstandard frame content size does not match the decoded size");
+
+    // https://datatracker.ietf.org/doc/html/rfc8878#section-3.1.1
+    if (m_frame->has_checksum) {
+        u32 expected_checksum = TRY(m_stream->read_value<LittleEndian<u32>>());
+        if (static_cast<u32>(m_checksum.digest()) != expected_checksum)
+            return Error::from_string_literal("Zstandard frame checksum does not match");
+    }
+
+    m_frame.clear();
+    return {};
+}
+
+ErrorOr<Bytes> ZstdDecompressor::read_some(Bytes bytes)
+{
+    while (true) {
+        if (m_window.has_value() && m_window->used_space() > 0) {
+            auto read = m_window->read(bytes);
+            if (m_frame->has_checksum)
+                m_checksum.update(read);
+            return read;
+        }
+
+        if (m_frame.has_value()) {
+            if (!m_last_block_seen)
+                TRY(decode_block());
+            else
+                TRY(finish_frame());
+            continue;
+        }
+
+        if (m_eof || !TRY(read_frame_header())) {
+            m_eof = true;
+            return bytes.trim(0);
+        }
+    }
+}
+
+ErrorOr<size_t> ZstdDecompressor::write_some(ReadonlyBytes)
+{
+    return Error::from_errno(EBADF);
+}
+
+bool ZstdDecompressor::is_eof() const
+{
+    return m_eof;
+}
+
+ErrorOr<ByteBuffer> ZstdDecompressor::decompress_all(ReadonlyBytes bytes)
+{
+    auto memory_stream = TRY(try_make<FixedMemoryStream>(bytes));
+    auto decompressor = TRY(ZstdDecompressor::create(move(memory_stream)));
+    return decompressor->read_until_eof();
+}
+
+bool ZstdDecompressor::is_likely_compressed(ReadonlyBytes bytes)
+{
+    return bytes.size() >= 4 && ByteReader::load32(bytes.data()) == AK::convert_between_host_and_little_endian(frame_magic);
+}
+
+// Writes a bitstream from the lowest bit of its first byte onwards. Streams that are read with a BackwardBitReader are written in
+// reverse order of how they are read, and end with a marker bit.
+class BitstreamWriter {
+public:
+    explicit BitstreamWriter(ByteBuffer& output)
+        : m_output(output)
+    {
+    }
+
+    ALWAYS_INLINE void write_bits(u64 value, u8 count)
+    {
+        m_bit_buffer |= (value & ((1ull << count) - 1)) << m_bit_count;
+        m_bit_count += count;
+        if (m_bit_count >= 32) {
+            auto bytes = AK::convert_between_host_and_little_endian(static_cast<u32>(m_bit_buffer));
+            m_output.append(&bytes, sizeof(bytes));
+            m_bit_buffer >>= 32;
+            m_bit_count -= 32;
+        }
+    }
+
+    void align_to_byte_boundary()
+    {
+        while (m_bit_count > 0) {
+            m_output.append(static_cast<u8>(m_bit_buffer));
+            m_bit_buffer >>= 8;
+            m_bit_count = m_bit_count > 8 ? m_bit_count - 8 : 0;
+        }
+        m_bit_buffer = 0;
+    }
+
+    void finish_with_end_marker()
+    {
+        write_bits(1, 1);
+        align_to_byte_boundary();
+    }
+
+private:
+    ByteBuffer& m_output;
+    u64 m_bit_buffer { 0 };
+    u8 m_bit_count { 0 };
+};
+
+// This is the counterpart of build_fse_table(), where each state records which state to continue from for each symbol.
+struct FSEEncodingTable {
+    struct SymbolTransform {
+        i32 delta_find_state { 0 };
+        u32 delta_number_of_bits { 0 };
+    };
+
+    u8 accuracy_log { 0 };
+    Vector<u16, 512> state_table;
+    Vector<SymbolTransform, 64> symbol_transforms;
+};
+
+static FSEEncodingTable build_fse_encoding_table(ReadonlySpan<i16> probabilities, u8 accuracy_log)
+{
+    FSEEncodingTable table;
+    table.accuracy_log = accuracy_log;
+    u32 size = 1u << accuracy_log;
+
+    // This spreads the symbols over the states in the same way as build_fse_table() does.
+    Vector<u8, 512> state_symbols;
+    state_symbols.resize(size);
+    Vector<u32, 64> cumulative_probabilities;
+    cumulative_probabilities.resize(probabilities.size() + 1);
+    u32 high_threshold = size - 1;
+    for (size_t symbol = 0; symbol < probabilities.size(); ++symbol) {
+        if (probabilities[symbol] == -1) {
+            cumulative_probabilities[symbol + 1] = cumulative_probabilities[symbol] + 1;
+            state_symbols[high_threshold--] = symbol;
+        } else {
+            cumulative_probabilities[symbol + 1] = cumulative_probabilities[symbol] + max(probabilities[symbol], 0);
+        }
+    }
+
+    u32 step = (size >> 1) + (size >> 3) + 3;
+    u32 mask = size - 1;
+    u32 position = 0;
+    for (size_t symbol = 0; symbol < probabilities.size(); ++symbol) {
+        for (i16 i = 0; i < probabilities[symbol]; ++i) {
+            state_symbols[position] = symbol;
+            do {
+                position = (position + step) & mask;
+            } while (position > high_threshold);
+        }
+    }
+    VERIFY(position == 0);
+
+    table.state_table.resize(size);
+    for (u32 state = 0; state < size; ++state)
+        table.state_table[cumulative_probabilities[state_symbols[state]]++] = size + state;
+
+    table.symbol_transforms.resize(probabilities.size());
+    i32 total = 0;
+    for (size_t symbol = 0; symbol < probabilities.size(); ++symbol) {
+        auto& transform = table.symbol_transforms[symbol];
+        auto probability = probabilities[symbol];
+        if (probability == 0) {
+            transform.delta_number_of_bits = ((accuracy_log + 1) << 16) - size;
+        } else if (probability == -1 || probability == 1) {
+            transform.delta_number_of_bits = (accuracy_log << 16) - size;
+            transform.delta_find_state = total - 1;
+            ++total;
+        } else {
+            u32 max_bits_out = accuracy_log - highest_bit(probability - 1);
+            u32 min_state_plus = static_cast<u32>(probability) << max_bits_out;
+            transform.delta_number_of_bits = (max_bits_out << 16) - min_state_plus;
+            transform.delta_find_state = total - probability;
+            total += probability;
+        }
+    }
+
+    return table;
+}
+
+class FSEEncoder {
+public:
+    // FSE encodes backwards, so this starts with the last symbol of the stream.
+    FSEEncoder(FSEEncodingTable const& table, u8 last_symbol)
+        : m_table(table)
+    {
+        auto const& transform = m_table.symbol_transforms[last_symbol];
+        u32 number_of_bits = (transform.delta_number_of_bits + (1 << 15)) >> 16;
+        u32 state = (number_of_bits << 16) - transform.delta_number_of_bits;
+        m_state = m_table.state_table[(state >> number_of_bits) + transform.delta_find_state];
+    }
+
+    ALWAYS_INLINE void encode(BitstreamWriter& writer, u8 symbol)
+    {
+        auto const& transform = m_table.symbol_transforms[symbol];
+        u32 number_of_bits = (m_state + transform.delta_number_of_bits) >> 16;
+        writer.write_bits(m_state, number_of_bits);
+        m_state = m_table.state_table[(m_state >> number_of_bits) + transform.delta_find_state];
+    }
+
+    void flush(BitstreamWriter& writer)
+    {
+        writer.write_bits(m_state, m_table.accuracy_log);
+    }
+
+private:
+    FSEEncodingTable const& m_table;
+    u32 m_state { 0 };
+};
+
+// Scales the symbol counts to probabilities that add up to 1 << accuracy_log, so that every symbol that occurs gets a probability of at least 1.
+static void normalize_counts(ReadonlySpan<u32> counts, u32 total, u8 accuracy_log, Span<i16> probabilities)
+{
+    i32 size = 1 << accuracy_log;
+    i32 sum = 0;
+    for (size_t symbol = 0; symbol < counts.size(); ++symbol) {
+        if (counts[symbol] == 0) {
+            probabilities[symbol] = 0;
+            continue;
+        }
+        probabilities[symbol] = max(1, static_cast<i32>(static_cast<u64>(counts[symbol]) * size / total));
+        sum += probabilities[symbol];
+    }
+
+    // Hand the rounding error to the most probable symbols, which changes their cost the least.
+    while (sum != size) {
+        size_t most_probable = 0;
+        for (size_t symbol = 1; symbol < counts.size(); ++symbol) {
+            if (probabilities[symbol] > probabilities[most_probable])
+                most_probable = symbol;
+        }
+        auto adjustment = sum < size ? size - sum : max(-(probabilities[most_probable] - 1), size - sum);
+        VERIFY(adjustment != 0);
+        probabilities[most_probable] += adjustment;
+        sum += adjustment;
+    }
+}
+
+// This is the counterpart of read_fse_table(). The probabilities must not have any trailing zeroes.
+static void write_fse_table_description(BitstreamWriter& writer, ReadonlySpan<i16> probabilities, u8 accuracy_log)
+{
+    writer.write_bits(accuracy_log - 5, 4);
+
+    i32 remaining = 1 << accuracy_log;
+    size_t symbol = 0;
+    while (remaining > 0) {
+        auto probability = probabilities[symbol++];
+
+        u8 bit_count = highest_bit(remaining + 1) + 1;
+        u32 value = probability + 1;
+        u32 lower_mask = (1u << (bit_count - 1)) - 1;
+        u32 threshold = (1u << bit_count) - 1 - (remaining + 1);
+        if (value < threshold)
+            writer.write_bits(value, bit_count - 1);
+        else if (value <= lower_mask)
+            writer.write_bits(value, bit_count);
+        else
+            writer.write_bits(value + threshold, bit_count);
+
+        remaining -= probability < 0 ? -probability : probability;
+
+        if (probability == 0) {
+            size_t repeat = 0;
+            while (symbol + repeat < probabilities.size() && probabilities[symbol + repeat] == 0)
+                ++repeat;
+            symbol += repeat;
+            for (; repeat >= 3; repeat -= 3)
+                writer.write_bits(3, 2);
+            writer.write_bits(repeat, 2);
+        }
+    }
+
+    writer.align_to_byte_boundary();
+}
+
+static ALWAYS_INLINE u8 literal_length_code(u32 literal_length)
+{
+    if (literal_length < 16)
+        return literal_length;
+    if (literal_length >= 64)
+        return highest_bit(literal_length) + 19;
+    u8 code = 16;
+    while (literal_length_baselines[code + 1] <= literal_length)
+        ++code;
+    return code;
+}
+
+static ALWAYS_INLINE u8 match_length_code(u32 match_length)
+{
+    u32 value = match_length - minimum_match_length;
+    if (value < 32)
+        return value;
+    if (value >= 128)
+        return highest_bit(value) + 36;
+    u8 code = 32;
+    while (match_length_baselines[code + 1] <= match_length)
+        ++code;
+    return code;
+}
+
+static constexpr size_t hash_bits = 16;
+
+static ALWAYS_INLINE u32 hash_at(u8 const* data)
+{
+    return (ByteReader::load32(data) * 2654435761u) >> (32 - hash_bits);
+}
+
+ErrorOr<NonnullOwnPtr<ZstdCompressor>> ZstdCompressor::create(MaybeOwned<Stream> stream, Optional<u64> content_size)
+{
+    auto buffer = TRY(ByteBuffer::create_uninitialized(window_size + block_size));
+    Vector<u32> hash_head;
+    TRY(hash_head.try_resize(1 << hash_bits));
+    hash_head.span().fill(empty_slot);
+    Vector<u32> hash_chain;
+    TRY(hash_chain.try_resize(window_size));
+
+    auto compressor = TRY(adopt_nonnull_own_or_enomem(new (nothrow) ZstdCompressor(move(stream), content_size, move(buffer), move(hash_head), move(hash_chain))));
+    TRY(compressor->m_literals.try_ensure_capacity(block_size));
+    TRY(compressor->m_compressed_block.try_ensure_capacity(2 * block_size));
+    TRY(compressor->m_sequences.try_ensure_capacity(block_size / minimum_match_length));
+    return compressor;
+}
+
+ZstdCompressor::ZstdCompressor(MaybeOwned<Stream> stream, Optional<u64> content_size, ByteBuffer buffer, Vector<u32> hash_head, Vector<u32> hash_chain)
+    : m_stream(move(stream))
+    , m_content_size(content_size)
+    , m_buffer(move(buffer))
+    , m_hash_head(move(hash_head))
+    , m_hash_chain(move(hash_chain))
+    , m_repeated_offsets { 1, 4, 8 }
+{
+}
+
+ZstdCompressor::~ZstdCompressor()
+{
+    if (!m_finished) {
+        // Note: We need a better API for specifying things like this.
+        finish().release_value_but_fixme_should_propagate_errors();
+    }
+}
+
+ErrorOr<Bytes> ZstdCompressor::read_some(Bytes)
+{
+    return Error::from_errno(EBADF);
+}
+
+ErrorOr<size_t> ZstdCompressor::write_some(ReadonlyBytes bytes)
+{
+    if (m_finished)
+        return Error::from_string_literal("Tried to write to a finished Zstandard compressor");
+    if (m_content_size.has_value() && m_total_input_size + bytes.size() > *m_content_size)
+        return Error::from_string_literal("Tried to write more data than the pledged content size to a Zstandard compressor");
+
+    if (!m_wrote_frame_header)
+        TRY(write_frame_header());
+
+    // A full block is only compressed once more data arrives, so that the last block can always be marked as such.
+    if (m_buffer_size - m_block_start == block_size)
+        TRY(compress_block(false));
+    if (m_buffer_size == m_buffer.size())
+        slide_window();
+
+    auto pending_size = m_buffer_size - m_block_start;
+    auto written = min(bytes.size(), min(m_buffer.size() - m_buffer_size, block_size - pending_size));
+    bytes.trim(written).copy_to(m_buffer.span().slice(m_buffer_size));
+    m_buffer_size += written;
+
+    m_checksum.update(bytes.trim(written));
+    m_total_input_size += written;
+    return written;
+}
+
+bool ZstdCompressor::is_eof() const
+{
+    return true;
+}
+
+bool ZstdCompressor::is_open() const
+{
+    return m_stream->is_open();
+}
+
+void ZstdCompressor::close()
+{
+    if (!m_finished) {
+        // Note: We need a better API for specifying things like this.
+        finish().release_value_but_fixme_should_propagate_errors();
+    }
+}
+
+ErrorOr<void> ZstdCompressor::finish()
+{
+    if (m_finished)
+        return {};
+    m_finished = true;
+
+    if (m_content_size.has_value() && m_total_input_size != *m_content_size)
+        return Error::from_string_literal("Zstandard compressor was finished before the pledged content size was written");
+
+    if (!m_wrote_frame_header)
+        TRY(write_frame_header());
+    TRY(compress_block(true));
+
+    u32 checksum = static_cast<u32>(m_checksum.digest());
+    TRY(m_stream->write_value<LittleEndian<u32>>(checksum));
+    return {};
+}
+
+ErrorOr<ByteBuffer> ZstdCompressor::compress_all(ReadonlyBytes bytes)
+{
+    AllocatingMemoryStream output_stream;
+    auto compressor = TRY(ZstdCompressor::create(MaybeOwned<Stream> { output_stream }, bytes.size()));
+    TRY(compressor->write_until_depleted(bytes));
+    TRY(compressor->finish());
+    return output_stream.read_until_eof();
+}
+
+// https://datatracker.ietf.org/doc/html/rfc8878#section-3.1.1.1
+ErrorOr<void> ZstdCompressor::write_frame_header()
+{
+    m_wrote_frame_header = true;
+    TRY(m_stream->write_value<LittleEndian<u32>>(frame_magic));
+
+    // A frame that fits into a single window doesn't need a window descriptor, the decoder can just use the content size.
+    bool single_segment = m_content_size.has_value() && *m_content_size <= window_size;
+
+    u8 frame_content_size_flag = 0;
+    u8 frame_content_size_size = 0;
+    u64 frame_content_size = 0;
+    if (m_content_size.has_value()) {
+        frame_content_size = *m_content_size;
+        if (single_segment && frame_content_size < 256) {
+            frame_content_size_size = 1;
+        } else if (frame_content_size >= 256 && frame_content_size < 65536 + 256) {
+            frame_content_size_flag = 1;
+            frame_content_size_size = 2;
+            frame_content_size -= 256;
+        } else if (frame_content_size <= NumericLimits<u32>::max()) {
+            frame_content_size_flag = 2;
+            frame_content_size_size = 4;
+        } else {
+            frame_content_size_flag = 3;
+            frame_content_size_size = 8;
+        }
+    }
+
+    u8 descriptor = (frame_content_size_flag << 6) | (single_segment ? 1 << 5 : 0) | (1 << 2);
+    TRY(m_stream->write_value<u8>(descriptor));
+
+    if (!single_segment) {
+        u8 window_descriptor = (highest_bit(window_size) - minimum_window_log) << 3;
+        TRY(m_stream->write_value<u8>(window_descriptor));
+    }
+
+    for (u8 i = 0; i < frame_content_size_size; ++i)
+        TRY(m_stream->write_value<u8>(static_cast<u8>(frame_content_size >> (i * 8))));
+
+    return {};
+}
+
+static ErrorOr<void> write_block_header(Stream& stream, BlockType type, size_t size, bool is_last_block)
+{
+    u32 header = (is_last_block ? 1 : 0) | (to_underlying(type) << 1) | (size << 3);
+    Array<u8, 3> header_bytes { static_cast<u8>(header), static_cast<u8>(header >> 8), static_cast<u8>(header >> 16) };
+    return stream.write_until_depleted(header_bytes);
+}
+
+static constexpr size_t minimum_huffman_literals_size = 64;
+
+// Literal sections with at least this many literals are split into four Huffman streams, which lets the decoder work on them in parallel.
+static constexpr size_t minimum_four_stream_literals_size = 256;
+
+// https://datatracker.ietf.org/doc/html/rfc8878#section-3.1.1.3.1.1
+static void write_raw_literals_section(ByteBuffer& output, ReadonlyBytes literals, LiteralsBlockType type)
+{
+    u32 size = literals.size();
+    u8 type_bits = to_underlying(type);
+    if (size < 32) {
+        output.append(type_bits | (size << 3));
+    } else if (size < 4096) {
+        output.append(type_bits | (1 << 2) | (size << 4));
+        output.append(size >> 4);
+    } else {
+        output.append(type_bits | (3 << 2) | (size << 4));
+        output.append(size >> 4);
+        output.append(size >> 12);
+    }
+
+    if (type == LiteralsBlockType::RLE)
+        output.append(literals[0]);
+    else
+        output.append(literals);
+}
+
+// https://datatracker.ietf.org/doc/html/rfc8878#section-4.2.1.2
+static bool write_compressed_huffman_weights(ByteBuffer& output, ReadonlyBytes weights)
+{
+    Array<u32, max_huffman_bits + 1> counts {};
+    size_t largest_weight = 0;
+    size_t distinct_weights = 0;
+    for (auto weight : weights) {
+        if (counts[weight]++ == 0)
+            ++distinct_weights;
+        largest_weight = max(largest_weight, weight);
+    }
+
+    // A single weight would need an RLE mode, which this description doesn't have.
+    if (distinct_weights < 2)
+        return false;
+
+    Array<i16, max_huffman_bits + 1> probabilities_storage {};
+    auto probabilities = probabilities_storage.span().trim(largest_weight + 1);
+    normalize_counts(counts.span().trim(largest_weight + 1), weights.size(), max_huffman_weights_accuracy_log, probabilities);
+
+    ByteBuffer compressed;
+    BitstreamWriter writer { compressed };
+    write_fse_table_description(writer, probabilities, max_huffman_weights_accuracy_log);
+
+    // The weights are encoded with two interleaved states, where the first state encodes the first weight.
+    auto table = build_fse_encoding_table(probabilities, max_huffman_weights_accuracy_log);
+    size_t remaining = weights.size();
+    Optional<FSEEncoder> first_encoder;
+    Optional<FSEEncoder> second_encoder;
+    if (remaining % 2 == 1) {
+        first_encoder.emplace(table, weights[--remaining]);
+        second_encoder.emplace(table, weights[--remaining]);
+        first_encoder->encode(writer, weights[--remaining]);
+    } else {
+        second_encoder.emplace(table, weights[--remaining]);
+        first_encoder.emplace(table, weights[--remaining]);
+    }
+    while (remaining > 0) {
+        second_encoder->encode(writer, weights[--remaining]);
+        first_encoder->encode(writer, weights[--remaining]);
+    }
+    second_encoder->flush(writer);
+    first_encoder->flush(writer);
+    writer.finish_with_end_marker();
+
+    if (compressed.size() >= 128)
+        return false;
+    output.append(compressed.size());
+    output.append(compressed);
+    return true;
+}
+
+// https://datatracker.ietf.org/doc/html/rfc8878#section-3.1.1.3.1
+static bool write_compressed_literals_section(ByteBuffer& output, ReadonlyBytes literals)
+{
+    Array<u32, 256> counts {};
+    for (auto byte : literals)
+        ++counts[byte];
+
+    u32 max_count = 0;
+    for (auto count : counts)
+        max_count = max(max_count, count);
+    Array<u16, 256> frequencies;
+    for (size_t symbol = 0; symbol < counts.size(); ++symbol)
+        frequencies[symbol] = counts[symbol] == 0 ? 0 : max(1, static_cast<u64>(counts[symbol]) * NumericLimits<u16>::max() / max_count);
+
+    Array<u8, 256> lengths;
+    generate_huffman_lengths(lengths, frequencies, max_huffman_bits);
+
+    u8 max_number_of_bits = 0;
+    size_t last_symbol = 0;
+    size_t symbol_count = 0;
+    for (size_t symbol = 0; symbol < lengths.size(); ++symbol) {
+        if (lengths[symbol] == 0)
+            continue;
+        max_number_of_bits = max(max_number_of_bits, lengths[symbol]);
+        last_symbol = symbol;
+        ++symbol_count;
+    }
+    if (symbol_count < 2)
+        return false;
+
+    // The weight of the last symbol is implied by the others.
+    Array<u8, 256> weights {};
+    for (size_t symbol = 0; symbol < last_symbol; ++symbol)
+        weights[symbol] = lengths[symbol] == 0 ? 0 : max_number_of_bits + 1 - lengths[symbol];
+
+    ByteBuffer compressed;
+    if (last_symbol <= 128) {
+        compressed.append(127 + last_symbol);
+        for (size_t symbol = 0; symbol < last_symbol; symbol += 2)
+            compressed.append((weights[symbol] << 4) | weights[symbol + 1]);
+    } else if (!write_compressed_huffman_weights(compressed, weights.span().trim(last_symbol))) {
+        return false;
+    }
+
+    // This assigns the codes in the same order as ZstdDecompressor::read_huffman_table() does.
+    Array<u32, max_huffman_bits + 1> rank_counts {};
+    for (auto length : lengths)
+        ++rank_counts[length];
+    Array<u32, max_huffman_bits + 1> rank_starts {};
+    for (u8 bits = max_number_of_bits; bits > 1; --bits)
+        rank_starts[bits - 1] = rank_starts[bits] + (rank_counts[bits] << (max_number_of_bits - bits));
+    Array<u16, 256> codes {};
+    for (size_t symbol = 0; symbol < lengths.size(); ++symbol) {
+        auto bits = lengths[symbol];
+        if (bits == 0)
+            continue;
+        codes[symbol] = rank_starts[bits] >> (max_number_of_bits - bits);
+        rank_starts[bits] += 1u << (max_number_of_bits - bits);
+    }
+
+    auto write_stream = [&](ReadonlyBytes stream_literals) {
+        BitstreamWriter writer { compressed };
+        for (size_t i = stream_literals.size(); i-- > 0;) {
+            auto symbol = stream_literals[i];
+            writer.write_bits(codes[symbol], lengths[symbol]);
+        }
+        writer.finish_with_end_marker();
+    };
+
+    bool has_four_streams = literals.size() >= minimum_four_stream_literals_size;
+    if (has_four_streams) {
+        auto jump_table_offset = compressed.size();
+        compressed.append(Array<u8, 6> {});
+        auto segment_size = ceil_div(literals.size(), 4ul);
+        for (size_t i = 0; i < 4; ++i) {
+            auto stream_start = compressed.size();
+            write_stream(i < 3 ? literals.slice(i * segment_size, segment_size) : literals.slice(3 * segment_size));
+            if (i == 3)
+                break;
+            auto stream_size = compressed.size() - stream_start;
+            if (stream_size > NumericLimits<u16>::max())
+                return false;
+            compressed[jump_table_offset + i * 2] = stream_size;
+            compressed[jump_table_offset + i * 2 + 1] = stream_size >> 8;
+        }
+    } else {
+        write_stream(literals);
+    }
+
+    if (compressed.size() >= literals.size())
+        return false;
+
+    u64 regenerated_size = literals.size();
+    u64 compressed_size = compressed.size();
+    u8 size_format = 0;
+    if (has_four_streams)
+        size_format = max(regenerated_size, compressed_size) < 1024 ? 1 : (max(regenerated_size, compressed_size) < 16384 ? 2 : 3);
+    u8 size_bits = size_format < 2 ? 10 : (size_format == 2 ? 14 : 18);
+    size_t header_size = size_format < 2 ? 3 : (size_format == 2 ? 4 : 5);
+
+    u64 header = to_underlying(LiteralsBlockType::Compressed) | (size_format << 2) | (regenerated_size << 4) | (compressed_size << (4 + size_bits));
+    for (size_t i = 0; i < header_size; ++i)
+        output.append(static_cast<u8>(header >> (i * 8)));
+    output.append(compressed);
+    return true;
+}
+
+static void write_literals_section(ByteBuffer& output, ReadonlyBytes literals)
+{
+    if (literals.size() > 1 && all_of(literals, [&](u8 byte) { return byte == literals[0]; })) {
+        write_raw_literals_section(output, literals, LiteralsBlockType::RLE);
+        return;
+    }
+    if (literals.size() >= minimum_huffman_literals_size && write_compressed_literals_section(output, literals))
+        return;
+    write_raw_literals_section(output, literals, LiteralsBlockType::Raw);
+}
+
+// Below this many sequences, describing our own FSE table costs more than we would save by using it.
+static constexpr size_t minimum_sequences_for_fse_table = 64;
+
+struct SymbolEncoding {
+    SymbolCompressionMode mode { SymbolCompressionMode::Predefined };
+    FSEEncodingTable table;
+};
+
+static SymbolEncoding choose_symbol_encoding(ByteBuffer& output, ReadonlySpan<u32> counts, u32 total, ReadonlySpan<i16> default_distribution, u8 default_accuracy_log, u8 maximum_accuracy_log)
+{
+    size_t largest_symbol = 0;
+    size_t distinct_symbols = 0;
+    for (size_t symbol = 0; symbol < counts.size(); ++symbol) {
+        if (counts[symbol] == 0)
+            continue;
+        largest_symbol = symbol;
+        ++distinct_symbols;
+    }
+
+    Array<i16, max_match_length_code + 1> probabilities_storage {};
+    auto probabilities = probabilities_storage.span().trim(largest_symbol + 1);
+
+    if (distinct_symbols == 1) {
+        output.append(largest_symbol);
+        probabilities[largest_symbol] = 1;
+        return { SymbolCompressionMode::RLE, build_fse_encoding_table(probabilities, 0) };
+    }
+
+    if (total < minimum_sequences_for_fse_table && largest_symbol < default_distribution.size())
+        return { SymbolCompressionMode::Predefined, build_fse_encoding_table(default_distribution, default_accuracy_log) };
+
+    u8 accuracy_log = clamp(highest_bit(total) - 1, 5, maximum_accuracy_log);
+    while ((1u << accuracy_log) < distinct_symbols)
+        ++accuracy_log;
+    normalize_counts(counts.trim(largest_symbol + 1), total, accuracy_log, probabilities);
+
+    BitstreamWriter writer { output };
+    write_fse_table_description(writer, probabilities, accuracy_log);
+    return { SymbolCompressionMode::FSECompressed, build_fse_encoding_table(probabilities, accuracy_log) };
+}
+
+// https://datatracker.ietf.org/doc/html/rfc8878#section-3.1.1.3.2
+void ZstdCompressor::write_sequences_section()
+{
+    auto& output = m_compressed_block;
+
+    u32 sequence_count = m_sequences.size();
+    if (sequence_count < 128) {
+        output.append(sequence_count);
+    } else if (sequence_count < 0x7F00) {
+        output.append((sequence_count >> 8) + 128);
+        output.append(sequence_count);
+    } else {
+        output.append(255);
+        output.append(sequence_count - 0x7F00);
+        output.append((sequence_count - 0x7F00) >> 8);
+    }
+
+    if (sequence_count == 0)
+        return;
+
+    Array<u32, max_literal_length_code + 1> literal_length_counts {};
+    Array<u32, max_offset_code + 1> offset_counts {};
+    Array<u32, max_match_length_code + 1> match_length_counts {};
+    for (auto const& sequence : m_sequences) {
+        ++literal_length_counts[literal_length_code(sequence.literal_length)];
+        ++offset_counts[highest_bit(sequence.offset_value)];
+        ++match_length_counts[match_length_code(sequence.match_length)];
+    }
+
+    auto modes_offset = output.size();
+    output.append(0);
+    auto literal_lengths = choose_symbol_encoding(output, literal_length_counts, sequence_count, default_literal_lengths_distribution, default_literal_lengths_accuracy_log, max_literal_lengths_accuracy_log);
+    auto offsets = choose_symbol_encoding(output, offset_counts, sequence_count, default_offsets_distribution, default_offsets_accuracy_log, max_offsets_accuracy_log);
+    auto match_lengths = choose_symbol_encoding(output, match_length_counts, sequence_count, default_match_lengths_distribution, default_match_lengths_accuracy_log, max_match_lengths_accuracy_log);
+    output[modes_offset] = (to_underlying(literal_lengths.mode) << 6) | (to_underlying(offsets.mode) << 4) | (to_underlying(match_lengths.mode) << 2);
+
+    // The decoder reads the sequences front to back, so we write them back to front.
+    BitstreamWriter writer { output };
+    auto write_extra_bits = [&](Sequence const& sequence, u8 literal_length_code, u8 offset_code, u8 match_length_code) {
+        writer.write_bits(sequence.literal_length - literal_length_baselines[literal_length_code], literal_length_extra_bits[literal_length_code]);
+        writer.write_bits(sequence.match_length - match_length_baselines[match_length_code], match_length_extra_bits[match_length_code]);
+        writer.write_bits(sequence.offset_value - (1u << offset_code), offset_code);
+    };
+
+    auto const& last_sequence = m_sequences.last();
+    u8 last_literal_length_code = literal_length_code(last_sequence.literal_length);
+    u8 last_offset_code = highest_bit(last_sequence.offset_value);
+    u8 last_match_length_code = match_length_code(last_sequence.match_length);
+    FSEEncoder literal_lengths_encoder { literal_lengths.table, last_literal_length_code };
+    FSEEncoder offsets_encoder { offsets.table, last_offset_code };
+    FSEEncoder match_lengths_encoder { match_lengths.table, last_match_length_code };
+    write_extra_bits(last_sequence, last_literal_length_code, last_offset_code, last_match_length_code);
+
+    for (size_t i = sequence_count - 1; i-- > 0;) {
+        auto const& sequence = m_sequences[i];
+        u8 literal_length_code_value = literal_length_code(sequence.literal_length);
+        u8 offset_code = highest_bit(sequence.offset_value);
+        u8 match_length_code_value = match_length_code(sequence.match_length);
+        offsets_encoder.encode(writer, offset_code);
+        match_lengths_encoder.encode(writer, match_length_code_value);
+        literal_lengths_encoder.encode(writer, literal_length_code_value);
+        write_extra_bits(sequence, literal_length_code_value, offset_code, match_length_code_value);
+    }
+
+    match_lengths_encoder.flush(writer);
+    offsets_encoder.flush(writer);
+    literal_lengths_encoder.flush(writer);
+    writer.finish_with_end_marker();
+}
+
+ErrorOr<void> ZstdCompressor::compress_block(bool is_last_block)
+{
+    auto block = m_buffer.span().slice(m_block_start, m_buffer_size - m_block_start);
+    m_block_start = m_buffer_size;
+
+    if (!block.is_empty() && all_of(block, [&](u8 byte) { return byte == block[0]; })) {
+        TRY(write_block_header(*m_stream, BlockType::RLE, block.size(), is_last_block));
+        return m_stream->write_value<u8>(block[0]);
+    }
+
+    if (!block.is_empty()) {
+        // The decoder only learns about the new offsets if we end up writing a compressed block.
+        auto repeated_offsets = m_repeated_offsets;
+
+        find_sequences(m_block_start - block.size(), m_buffer_size);
+        m_compressed_block.clear();
+        write_literals_section(m_compressed_block, m_literals);
+        write_sequences_section();
+
+        if (m_compressed_block.size() < block.size()) {
+            TRY(write_block_header(*m_stream, BlockType::Compressed, m_compressed_block.size(), is_last_block));
+            return m_stream->write_until_depleted(m_compressed_block);
+        }
+
+        m_repeated_offsets = repeated_offsets;
+    }
+
+    TRY(write_block_header(*m_stream, BlockType::Raw, block.size(), is_last_block));
+    return m_stream->write_until_depleted(block);
+}
+
+void ZstdCompressor::insert_hash(size_t position)
+{
+    if (position + 4 > m_buffer_size)
+        return;
+    auto hash = hash_at(m_buffer.data() + position);
+    u32 hash_position = m_buffer_position + position;
+    m_hash_chain[hash_position & (window_size - 1)] = m_hash_head[hash];
+    m_hash_head[hash] = hash_position;
+}
+
+static ALWAYS_INLINE size_t common_prefix_length(u8 const* a, u8 const* b, size_t limit)
+{
+    size_t length = 0;
+    while (length + 8 <= limit) {
+        auto difference = ByteReader::load64(a + length) ^ ByteReader::load64(b + length);
+        if (difference != 0)
+            return length + count_trailing_zeroes(AK::convert_between_host_and_little_endian(difference)) / 8;
+        length += 8;
+    }
+    while (length < limit && a[length] == b[length])
+        ++length;
+    return length;
+}
+
+size_t ZstdCompressor::longest_match(size_t position, size_t block_end, size_t& distance) const
+{
+    auto limit = block_end - position;
+    auto const* current = m_buffer.data() + position;
+    u32 current_position = m_buffer_position + position;
+    auto maximum_distance = min(position, window_size);
+
+    size_t best_length = 0;
+    u32 candidate = m_hash_head[hash_at(current)];
+    for (size_t chain_length = 0; chain_length < maximum_chain_length && candidate < current_position; ++chain_length) {
+        size_t candidate_distance = current_position - candidate;
+        if (candidate_distance > maximum_distance)
+            break;
+
+        auto const* candidate_data = current - candidate_distance;
+        if (best_length == 0 || candidate_data[best_length] == current[best_length]) {
+            auto length = common_prefix_length(candidate_data, current, limit);
+            if (length > best_length) {
+                best_length = length;
+                distance = candidate_distance;
+                if (length == limit)
+                    break;
+            }
+        }
+
+        auto next = m_hash_chain[candidate & (window_size - 1)];
+        if (next >= candidate)
+            break;
+        candidate = next;
+    }
+
+    return best_length;
+}
+
+void ZstdCompressor::find_sequences(size_t block_start, size_t block_end)
+{
+    m_sequences.clear_with_capacity();
+    m_literals.clear();
+
+    // Every match needs at least four bytes, since that's what the hashes cover.
+    static constexpr size_t minimum_found_match_length = 4;
+
+    size_t literals_start = block_start;
+    size_t position = block_start;
+    while (position + minimum_found_match_length <= block_end) {
+        u32 literal_length = position - literals_start;
+        size_t match_length = 0;
+        size_t distance = 0;
+
+        // Repeating the most recent offset is cheap to encode and common in structured data, so it's worth checking first.
+        auto repeated_offset = m_repeated_offsets[0];
+        if (literal_length > 0 && repeated_offset <= position) {
+            match_length = common_prefix_length(m_buffer.data() + position - repeated_offset, m_buffer.data() + position, block_end - position);
+            distance = repeated_offset;
+        }
+
+        if (match_length < minimum_found_match_length)
+            match_length = longest_match(position, block_end, distance);
+
+        if (match_length < minimum_found_match_length) {
+            insert_hash(position);
+            ++position;
+            continue;
+        }
+
+        u32 offset_value = distance + 3;
+        if (literal_length > 0) {
+            if (distance == m_repeated_offsets[0])
+                offset_value = 1;
+            else if (distance == m_repeated_offsets[1])
+                offset_value = 2;
+            else if (distance == m_repeated_offsets[2])
+                offset_value = 3;
+        } else {
+            if (distance == m_repeated_offsets[1])
+                offset_value = 1;
+            else if (distance == m_repeated_offsets[2])
+                offset_value = 2;
+            else if (distance == m_repeated_offsets[0] - 1)
+                offset_value = 3;
+        }
+        auto resolved_offset = resolve_offset(offset_value, literal_length, m_repeated_offsets);
+        VERIFY(resolved_offset == distance);
+
+        m_literals.append(m_buffer.span().slice(literals_start, literal_length));
+        m_sequences.append({ literal_length, static_cast<u32>(match_length), offset_value });
+
+        for (size_t i = 0; i < match_length; ++i)
+            insert_hash(position + i);
+        position += match_length;
+        literals_start = position;
+    }
+
+    m_literals.append(m_buffer.span().slice(literals_start, block_end - literals_start));
+}
+
+void ZstdCompressor::slide_window()
+{
+    VERIFY(m_block_start > window_size);
+    auto shift = m_block_start - window_size;
+    memmove(m_buffer.data(), m_buffer.data() + shift, m_buffer_size - shift);
+    m_buffer_size -= shift;
+    m_block_start -= shift;
+    m_buffer_position += shift;
+
+    if (m_buffer_position + m_buffer.size() > NumericLimits<u32>::max() / 2)
+        rebase_hash_positions();
+}
+
+void ZstdCompressor::rebase_hash_positions()
+{
+    // Chain entries are indexed by their position modulo the window size, so the positions have to move by a multiple of it.
+    u32 rebase = m_buffer_position & ~static_cast<u64>(window_size - 1);
+    auto rebase_position = [rebase](u32& position) {
+        position = position == empty_slot || position < rebase ? empty_slot : position - rebase;
+    };
+    for (auto& position : m_hash_head)
+        rebase_position(position);
+    for (auto& position : m_hash_chain)
+        rebase_position(position);
+    m_buffer_position -= rebase;
+}
+
+}
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/ByteBuffer.h>
+#include <AK/CircularBuffer.h>
+#include <AK/MaybeOwned.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Optional.h>
+#include <AK/Stream.h>
+#include <AK/Vector.h>
+#include <LibCrypto/Checksum/XXH64.h>
+
+namespace Compress {
+
+// This implements the Zstandard compression format, as described in RFC 8878.
+// https://datatracker.ietf.org/doc/html/rfc8878
+
+class ZstdDecompressor final : public Stream {
+public:
+    // Frames that need a larger window than this are rejected, which matches the default limit of the reference decoder.
+    static constexpr u64 maximum_window_size = 128 * MiB;
+
+    static ErrorOr<NonnullOwnPtr<ZstdDecompressor>> create(MaybeOwned<Stream>);
+
+    virtual ErrorOr<Bytes> read_some(Bytes) override;
+    virtual ErrorOr<size_t> write_some(ReadonlyBytes) override;
+    virtual bool is_eof() const override;
+    virtual bool is_open() const override { return true; }
+    virtual void close() override { }
+
+    static ErrorOr<ByteBuffer> decompress_all(ReadonlyBytes);
+    static bool is_likely_compressed(ReadonlyBytes);
+
+    // https://datatracker.ietf.org/doc/html/rfc8878#section-4.1.1
+    struct FSETable {
+        struct Entry {
+            u8 symbol { 0 };
+            u8 number_of_bits { 0 };
+            u16 base { 0 };
+        };
+
+        u8 accuracy_log { 0 };
+        bool is_valid { false };
+        Array<Entry, 1 << 9> entries;
+    };
+
+    // https://datatracker.ietf.org/doc/html/rfc8878#section-4.2.1
+    struct HuffmanTable {
+        struct Entry {
+            u8 symbol { 0 };
+            u8 number_of_bits { 0 };
+        };
+
+        u8 max_number_of_bits { 0 };
+        bool is_valid { false };
+        Array<Entry, 1 << 11> entries;
+    };
+
+private:
+    struct FrameHeader {
+        u64 window_size { 0 };
+        Optional<u64> content_size;
+        bool has_checksum { false };
+    };
+
+    ZstdDecompressor(MaybeOwned<Stream>, ByteBuffer block_buffer, ByteBuffer literals);
+
+    ErrorOr<bool> read_frame_header();
+    ErrorOr<void> decode_block();
+    ErrorOr<void> decode_compressed_block(ReadonlyBytes);
+    ErrorOr<size_t> decode_literals_section(ReadonlyBytes);
+    ErrorOr<size_t> read_huffman_table(ReadonlyBytes);
+    ErrorOr<void> decode_sequences_section(ReadonlyBytes);
+    ErrorOr<void> finish_frame();
+
+    MaybeOwned<Stream> m_stream;
+    Optional<CircularBuffer> m_window;
+
+    Optional<FrameHeader> m_frame;
+    size_t m_block_maximum_size { 0 };
+    bool m_last_block_seen { false };
+    u64 m_frame_decoded_size { 0 };
+    Crypto::Checksum::XXH64 m_checksum;
+
+    // These carry over from one compressed block to the next one in the same frame.
+    Array<u32, 3> m_repeated_offsets;
+    HuffmanTable m_huffman_table;
+    FSETable m_literal_lengths_table;
+    FSETable m_offsets_table;
+    FSETable m_match_lengths_table;
+
+    ByteBuffer m_block_buffer;
+    ByteBuffer m_literals;
+    size_t m_literals_size { 0 };
+
+    bool m_eof { false };
+};
+
+// FIXME: Add compression levels, and search for matches harder on the higher ones.
+class ZstdCompressor final : public Stream {
+public:
+    // When the content size is known up front, it is stored in the frame header, which lets small inputs be decoded with a smaller window.
+    static ErrorOr<NonnullOwnPtr<ZstdCompressor>> create(MaybeOwned<Stream>, Optional<u64> content_size = {});
+    ~ZstdCompressor();
+
+    virtual ErrorOr<Bytes> read_some(Bytes) override;
+    virtual ErrorOr<size_t> write_some(ReadonlyBytes) override;
+    virtual bool is_eof() const override;
+    virtual bool is_open() const override;
+    virtual void close() override;
+
+    ErrorOr<void> finish();
+
+    static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes);
+
+private:
+    static constexpr size_t window_size = 1 * MiB;
+    static constexpr size_t block_size = 128 * KiB;
+    static constexpr size_t maximum_chain_length = 32;
+    static constexpr u32 empty_slot = NumericLimits<u32>::max();
+
+    struct Sequence {
+        u32 literal_length { 0 };
+        u32 match_length { 0 };
+        u32 offset_value { 0 };
+    };
+
+    ZstdCompressor(MaybeOwned<Stream>, Optional<u64> content_size, ByteBuffer buffer, Vector<u32> hash_head, Vector<u32> hash_chain);
+
+    ErrorOr<void> write_frame_header();
+    ErrorOr<void> compress_block(bool is_last_block);
+    void find_sequences(size_t block_start, size_t block_end);
+    void write_sequences_section();
+    void insert_hash(size_t position);
+    size_t longest_match(size_t position, size_t block_end, size_t& distance) const;
+    void slide_window();
+    void rebase_hash_positions();
+
+    MaybeOwned<Stream> m_stream;
+    Optional<u64> m_content_size;
+
+    // The last window_size bytes before m_block_start are history that matches may refer to, everything after it is input that still needs to be compressed.
+    ByteBuffer m_buffer;
+    size_t m_buffer_size { 0 };
+    size_t m_block_start { 0 };
+
+    // The hash tables store positions where m_buffer[i] is at m_buffer_position + i. All of them are moved down now and then,
+    // so that they keep fitting into 32 bits no matter how long the stream gets.
+    u64 m_buffer_position { 0 };
+    Vector<u32> m_hash_head;
+    Vector<u32> m_hash_chain;
+
+    Array<u32, 3> m_repeated_offsets;
+    Vector<Sequence> m_sequences;
+    ByteBuffer m_literals;
+    ByteBuffer m_compressed_block;
+
+    Crypto::Checksum::XXH64 m_checksum;
+    u64 m_total_input_size { 0 };
+    bool m_wrote_frame_header { false };
+    bool m_finished { false };
+};
+
+}
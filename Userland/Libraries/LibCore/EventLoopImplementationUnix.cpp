@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AnyOf.h>
 #include <AK/BinaryHeap.h>
 #include <AK/Singleton.h>
 #include <AK/TemporaryChange.h>
@@ -48,6 +49,20 @@ bool has_flag(int value, int flag)
     return (value & flag) == flag;
 }
 
+NotificationType poll_events_to_notification_type(int revents)
+{
+    NotificationType type = NotificationType::None;
+    if (has_flag(revents, POLLIN))
+        type |= NotificationType::Read;
+    if (has_flag(revents, POLLOUT))
+        type |= NotificationType::Write;
+    if (has_flag(revents, POLLHUP))
+        type |= NotificationType::HangUp;
+    if (has_flag(revents, POLLERR))
+        type |= NotificationType::Error;
+    return type;
+}
+
 class EventLoopTimeout {
 public:
     static constexpr ssize_t INVALID_INDEX = NumericLimits<ssize_t>::max();
@@ -274,18 +289,69 @@ struct ThreadData {
 
         wake_pipe_fds = MUST(Core::System::pipe2(O_CLOEXEC));
 
+#ifdef AK_OS_SERENITY
+        // NOTE: After a fork, the epoll instance is still shared with the parent, so we need our own one.
+        if (epoll_fd != -1)
+            close(epoll_fd);
+        epoll_fd = MUST(Core::System::epoll_create1(EPOLL_CLOEXEC));
+
+        // The wake pipe informs us of POSIX signals as well as manual calls to wake()
+        VERIFY(notifiers_by_fd.is_empty());
+        epoll_event event { .events = EPOLLIN, .data = { .fd = wake_pipe_fds[0] } };
+        MUST(Core::System::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wake_pipe_fds[0], &event));
+#else
         // The wake pipe informs us of POSIX signals as well as manual calls to wake()
         VERIFY(poll_fds.size() == 0);
         poll_fds.append({ .fd = wake_pipe_fds[0], .events = POLLIN, .revents = 0 });
         notifier_by_index.append(nullptr);
+#endif
     }
 
+#ifdef AK_OS_SERENITY
+    // Tells the epoll instance about the union of the events that the notifiers for this fd are interested in.
+    void update_epoll_interest(int fd, bool is_new_fd)
+    {
+        auto it = notifiers_by_fd.find(fd);
+        if (it == notifiers_by_fd.end()) {
+            // NOTE: The fd might have been closed before its notifiers went away, in which case the kernel has already forgotten about it.
+            (void)Core::System::epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+            return;
+        }
+
+        short events = 0;
+        for (auto* notifier : it->value)
+            events |= notification_type_to_poll_events(notifier->type());
+        epoll_event event { .events = static_cast<u32>(events), .data = { .fd = fd } };
+
+        auto result = Core::System::epoll_ctl(epoll_fd, is_new_fd ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, fd, &event);
+        if (result.is_error() && result.error().code() == EEXIST) {
+            // The fd number was closed and reused while another fd still kept the old file open, so we are still watching that one.
+            (void)Core::System::epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+            result = Core::System::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event);
+        } else if (result.is_error() && result.error().code() == ENOENT) {
+            // The fd was closed and reopened while some of its notifiers stayed around.
+            result = Core::System::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event);
+        }
+        if (result.is_error())
+            dbgln("EventLoopImplementationUnix: Failed to watch fd {}: {}", fd, result.error());
+    }
+#endif
+
     // Each thread has its own timers, notifiers and a wake pipe.
     TimeoutSet timeouts;
-
+    Duration timer_slack;
+
+#ifdef AK_OS_SERENITY
+    // NOTE: Unlike with poll(), the kernel keeps track of what we're interested in, so we don't
+    //       have to hand it every single fd (and it doesn't have to check them) on each iteration.
+    int epoll_fd { -1 };
+    HashMap<int, Vector<Notifier*, 1>> notifiers_by_fd;
+    Array<epoll_event, 64> epoll_events;
+#else
     Vector<pollfd> poll_fds;
     HashMap<Notifier*, size_t> notifier_by_ptr;
     Vector<Notifier*> notifier_by_index;
+#endif
 
     // The wake pipe is used to notify another event loop that someone has called wake(), or a signal has been received.
     // wake() writes 0i32 into the pipe, signals write the signal number (guaranteed non-zero).
@@ -365,7 +431,8 @@ retry:
     if (mode == EventLoopImplementation::PumpMode::WaitForEvents && !has_pending_events) {
         auto next_timer_expiration = thread_data.timeouts.next_timer_expiration();
         if (next_timer_expiration.has_value()) {
-            auto computed_timeout = next_timer_expiration.value() - time_at_iteration_start;
+            // Sleeping through the slack lets the timers that expire in the meantime fire together with the first one.
+            auto computed_timeout = next_timer_expiration.value() + thread_data.timer_slack - time_at_iteration_start;
             if (computed_timeout.is_negative())
                 computed_timeout = Duration::zero();
             i64 true_timeout = computed_timeout.to_milliseconds();
@@ -377,7 +444,11 @@ retry:
 
 try_select_again:
     // select() and wait for file system events, calls to wake(), POSIX signals, or timer expirations.
+#ifdef AK_OS_SERENITY
+    ErrorOr<int> error_or_marked_fd_count = System::epoll_wait(thread_data.epoll_fd, thread_data.epoll_events, should_wait_forever ? -1 : timeout);
+#else
     ErrorOr<int> error_or_marked_fd_count = System::poll(thread_data.poll_fds, should_wait_forever ? -1 : timeout);
+#endif
     auto time_after_poll = MonotonicTime::now_coarse();
     // Because POSIX, we might spuriously return from select() with EINTR; just select again.
     if (error_or_marked_fd_count.is_error()) {
@@ -387,9 +458,18 @@ try_select_again:
         VERIFY_NOT_REACHED();
     }
 
+#ifdef AK_OS_SERENITY
+    auto marked_events = thread_data.epoll_events.span().trim(error_or_marked_fd_count.value());
+    bool wake_pipe_is_readable = any_of(marked_events, [&](auto& event) {
+        return event.data.fd == thread_data.wake_pipe_fds[0] && has_flag(event.events, EPOLLIN);
+    });
+#else
+    bool wake_pipe_is_readable = has_flag(thread_data.poll_fds[0].revents, POLLIN);
+#endif
+
     // We woke up due to a call to wake() or a POSIX signal.
     // Handle signals and see whether we need to handle events as well.
-    if (has_flag(thread_data.poll_fds[0].revents, POLLIN)) {
+    if (wake_pipe_is_readable) {
         int wake_events[8];
         ssize_t nread;
         // We might receive another signal while read()ing here. The signal will go to the handle_signal properly,
@@ -418,26 +498,34 @@ try_select_again:
             goto retry;
     }
 
+#ifdef AK_OS_SERENITY
+    // Handle file system notifiers by making them normal events.
+    // NOTE: The EPOLL* flags have the same values as their POLL* counterparts.
+    for (auto& event : marked_events) {
+        if (event.data.fd == thread_data.wake_pipe_fds[0])
+            continue;
+        auto it = thread_data.notifiers_by_fd.find(event.data.fd);
+        if (it == thread_data.notifiers_by_fd.end())
+            continue;
+        for (auto* notifier : it->value) {
+            auto type = poll_events_to_notification_type(event.events) & notifier->type();
+            if (type != NotificationType::None)
+                ThreadEventQueue::current().post_event(*notifier, make<NotifierActivationEvent>(notifier->fd(), type));
+        }
+    }
+#else
     if (error_or_marked_fd_count.value() != 0) {
         // Handle file system notifiers by making them normal events.
         for (size_t i = 1; i < thread_data.poll_fds.size(); ++i) {
             auto& revents = thread_data.poll_fds[i].revents;
             auto& notifier = *thread_data.notifier_by_index[i];
 
-            NotificationType type = NotificationType::None;
-            if (has_flag(revents, POLLIN))
-                type |= NotificationType::Read;
-            if (has_flag(revents, POLLOUT))
-                type |= NotificationType::Write;
-            if (has_flag(revents, POLLHUP))
-                type |= NotificationType::HangUp;
-            if (has_flag(revents, POLLERR))
-                type |= NotificationType::Error;
-            type &= notifier.type();
+            auto type = poll_events_to_notification_type(revents) & notifier.type();
             if (type != NotificationType::None)
                 ThreadEventQueue::current().post_event(notifier, make<NotifierActivationEvent>(notifier.fd(), type));
         }
     }
+#endif
 
     // Handle expired timers.
     thread_data.timeouts.fire_expired(time_after_poll);
@@ -514,9 +602,13 @@ void EventLoopImplementationUnix::notify_forked_and_in_child()
 {
     auto& thread_data = ThreadData::the();
     thread_data.timeouts.clear();
+#ifdef AK_OS_SERENITY
+    thread_data.notifiers_by_fd.clear();
+#else
     thread_data.poll_fds.clear();
     thread_data.notifier_by_ptr.clear();
     thread_data.notifier_by_index.clear();
+#endif
     thread_data.initialize_wake_pipe();
     if (auto* info = signals_info<false>()) {
         info->signal_handlers.clear();
@@ -638,6 +730,12 @@ void EventLoopManagerUnix::unregister_signal(int handler_id)
         info.signal_handlers.remove(remove_signal_number);
 }
 
+void EventLoopManagerUnix::set_timer_slack(Duration slack)
+{
+    VERIFY(!slack.is_negative());
+    ThreadData::the().timer_slack = slack;
+}
+
 intptr_t EventLoopManagerUnix::register_timer(EventReceiver& object, int milliseconds, bool should_reload, TimerShouldFireWhenNotVisible fire_when_not_visible)
 {
     VERIFY(milliseconds >= 0);
@@ -672,6 +770,11 @@ void EventLoopManagerUnix::register_notifier(Notifier& notifier)
 {
     auto& thread_data = ThreadData::the();
 
+#ifdef AK_OS_SERENITY
+    auto& notifiers = thread_data.notifiers_by_fd.ensure(notifier.fd());
+    notifiers.append(&notifier);
+    thread_data.update_epoll_interest(notifier.fd(), notifiers.size() == 1);
+#else
     thread_data.notifier_by_ptr.set(&notifier, thread_data.poll_fds.size());
     thread_data.notifier_by_index.append(&notifier);
     thread_data.poll_fds.append({
@@ -679,6 +782,7 @@ void EventLoopManagerUnix::register_notifier(Notifier& notifier)
         .events = notification_type_to_poll_events(notifier.type()),
         .revents = 0,
     });
+#endif
 
     notifier.set_owner_thread(s_thread_id);
 }
@@ -690,6 +794,14 @@ void EventLoopManagerUnix::unregister_notifier(Notifier& notifier)
         return;
 
     auto& thread_data = *thread_data_ptr;
+#ifdef AK_OS_SERENITY
+    auto it = thread_data.notifiers_by_fd.find(notifier.fd());
+    VERIFY(it != thread_data.notifiers_by_fd.end());
+    it->value.remove_first_matching([&](auto* other) { return other == &notifier; });
+    if (it->value.is_empty())
+        thread_data.notifiers_by_fd.remove(it);
+    thread_data.update_epoll_interest(notifier.fd(), false);
+#else
     auto it = thread_data.notifier_by_ptr.find(&notifier);
     VERIFY(it != thread_data.notifier_by_ptr.end());
 
@@ -703,6 +815,7 @@ void EventLoopManagerUnix::unregister_notifier(Notifier& notifier)
     }
     thread_data.poll_fds.take_last();
     thread_data.notifier_by_index.take_last();
+#endif
 }
 
 void EventLoopManagerUnix::did_post_event()
@@ -31,6 +31,10 @@ public:
     void wait_for_events(EventLoopImplementation::PumpMode);
     static Optional<MonotonicTime> get_next_timer_expiration();
 
+    // Allows timers of the calling thread to fire up to `slack` late, so that timers expiring close to each other
+    // are handled in the same wakeup instead of one wakeup each.
+    static void set_timer_slack(Duration slack);
+
 private:
     void dispatch_signal(int signal_number);
     static void handle_signal(int signal_number);
@@ -64,6 +64,15 @@ MappedFile::MappedFile(void* ptr, size_t size, Mode mode)
 {
 }
 
+ErrorOr<void> MappedFile::advise(int advice)
+{
+    if (m_size == 0)
+        return {};
+    if (::madvise(m_data, m_size, advice) < 0)
+        return Error::from_syscall("madvise"sv, -errno);
+    return {};
+}
+
 MappedFile::~MappedFile()
 {
     auto res = Core::System::munmap(m_data, m_size);
@@ -32,6 +32,9 @@ public:
     void const* data() const { return m_data; }
     ReadonlyBytes bytes() const { return { m_data, m_size }; }
 
+    // Tells the kernel how the mapping is going to be accessed, see madvise(2).
+    ErrorOr<void> advise(int advice);
+
 private:
     explicit MappedFile(void*, size_t, Mode);
 
@@ -5,9 +5,7 @@
  */
 
 #include <AK/ByteBuffer.h>
-#include <AK/JsonArray.h>
-#include <AK/JsonObject.h>
-#include <AK/JsonValue.h>
+#include <AK/JsonStreamReader.h>
 #include <LibCore/File.h>
 #include <LibCore/ProcessStatisticsReader.h>
 #include <pwd.h>
@@ -16,76 +14,143 @@ namespace Core {
 
 HashMap<uid_t, ByteString> ProcessStatisticsReader::s_usernames;
 
+static ErrorOr<ThreadStatistics> read_thread(JsonStreamReader& reader)
+{
+    ThreadStatistics thread {};
+    TRY(reader.for_each_member([&](StringView key) -> ErrorOr<void> {
+        if (key == "tid"sv)
+            thread.tid = TRY(reader.read_number<pid_t>());
+        else if (key == "times_scheduled"sv)
+            thread.times_scheduled = TRY(reader.read_number<unsigned>());
+        else if (key == "name"sv)
+            thread.name = TRY(reader.read_string());
+        else if (key == "state"sv)
+            thread.state = TRY(reader.read_string());
+        else if (key == "time_user"sv)
+            thread.time_user = TRY(reader.read_number<u64>());
+        else if (key == "time_kernel"sv)
+            thread.time_kernel = TRY(reader.read_number<u64>());
+        else if (key == "cpu"sv)
+            thread.cpu = TRY(reader.read_number<u32>());
+        else if (key == "priority"sv)
+            thread.priority = TRY(reader.read_number<u32>());
+        else if (key == "syscall_count"sv)
+            thread.syscall_count = TRY(reader.read_number<unsigned>());
+        else if (key == "inode_faults"sv)
+            thread.inode_faults = TRY(reader.read_number<unsigned>());
+        else if (key == "zero_faults"sv)
+            thread.zero_faults = TRY(reader.read_number<unsigned>());
+        else if (key == "cow_faults"sv)
+            thread.cow_faults = TRY(reader.read_number<unsigned>());
+        else if (key == "unix_socket_read_bytes"sv)
+            thread.unix_socket_read_bytes = TRY(reader.read_number<u64>());
+        else if (key == "unix_socket_write_bytes"sv)
+            thread.unix_socket_write_bytes = TRY(reader.read_number<u64>());
+        else if (key == "ipv4_socket_read_bytes"sv)
+            thread.ipv4_socket_read_bytes = TRY(reader.read_number<u64>());
+        else if (key == "ipv4_socket_write_bytes"sv)
+            thread.ipv4_socket_write_bytes = TRY(reader.read_number<u64>());
+        else if (key == "file_read_bytes"sv)
+            thread.file_read_bytes = TRY(reader.read_number<u64>());
+        else if (key == "file_write_bytes"sv)
+            thread.file_write_bytes = TRY(reader.read_number<u64>());
+        else
+            TRY(reader.skip_value());
+        return {};
+    }));
+    return thread;
+}
+
+static ErrorOr<ProcessStatistics> read_process(JsonStreamReader& reader)
+{
+    ProcessStatistics process {};
+    TRY(reader.for_each_member([&](StringView key) -> ErrorOr<void> {
+        if (key == "pid"sv)
+            process.pid = TRY(reader.read_number<pid_t>());
+        else if (key == "pgid"sv)
+            process.pgid = TRY(reader.read_number<pid_t>());
+        else if (key == "pgp"sv)
+            process.pgp = TRY(reader.read_number<pid_t>());
+        else if (key == "sid"sv)
+            process.sid = TRY(reader.read_number<pid_t>());
+        else if (key == "uid"sv)
+            process.uid = TRY(reader.read_number<uid_t>());
+        else if (key == "gid"sv)
+            process.gid = TRY(reader.read_number<gid_t>());
+        else if (key == "ppid"sv)
+            process.ppid = TRY(reader.read_number<pid_t>());
+        else if (key == "kernel"sv)
+            process.kernel = TRY(reader.read_bool());
+        else if (key == "name"sv)
+            process.name = TRY(reader.read_string());
+        else if (key == "executable"sv)
+            process.executable = TRY(reader.read_string());
+        else if (key == "tty"sv)
+            process.tty = TRY(reader.read_string());
+        else if (key == "pledge"sv)
+            process.pledge = TRY(reader.read_string());
+        else if (key == "veil"sv)
+            process.veil = TRY(reader.read_string());
+        else if (key == "creation_time"sv)
+            process.creation_time = UnixDateTime::from_nanoseconds_since_epoch(TRY(reader.read_number<i64>()));
+        else if (key == "amount_virtual"sv)
+            process.amount_virtual = TRY(reader.read_number<size_t>());
+        else if (key == "amount_resident"sv)
+            process.amount_resident = TRY(reader.read_number<size_t>());
+        else if (key == "amount_shared"sv)
+            process.amount_shared = TRY(reader.read_number<size_t>());
+        else if (key == "amount_dirty_private"sv)
+            process.amount_dirty_private = TRY(reader.read_number<size_t>());
+        else if (key == "amount_clean_inode"sv)
+            process.amount_clean_inode = TRY(reader.read_number<size_t>());
+        else if (key == "amount_purgeable_volatile"sv)
+            process.amount_purgeable_volatile = TRY(reader.read_number<size_t>());
+        else if (key == "amount_purgeable_nonvolatile"sv)
+            process.amount_purgeable_nonvolatile = TRY(reader.read_number<size_t>());
+        else if (key == "threads"sv)
+            TRY(reader.for_each_element([&]() -> ErrorOr<void> {
+                TRY(process.threads.try_append(TRY(read_thread(reader))));
+                return {};
+            }));
+        else
+            TRY(reader.skip_value());
+        return {};
+    }));
+    return process;
+}
+
 ErrorOr<AllProcessesStatistics> ProcessStatisticsReader::get_all(SeekableStream& proc_all_file, bool include_usernames)
 {
     TRY(proc_all_file.seek(0, SeekMode::SetPosition));
 
-    AllProcessesStatistics all_processes_statistics;
+    AllProcessesStatistics all_processes_statistics {};
 
     auto file_contents = TRY(proc_all_file.read_until_eof());
-    auto json_obj = TRY(JsonValue::from_string(file_contents)).as_object();
-    json_obj.get_array("processes"sv)->for_each([&](auto& value) {
-        JsonObject const& process_object = value.as_object();
-        Core::ProcessStatistics process;
-
-        // kernel data first
-        process.pid = process_object.get_u32("pid"sv).value_or(0);
-        process.pgid = process_object.get_u32("pgid"sv).value_or(0);
-        process.pgp = process_object.get_u32("pgp"sv).value_or(0);
-        process.sid = process_object.get_u32("sid"sv).value_or(0);
-        process.uid = process_object.get_u32("uid"sv).value_or(0);
-        process.gid = process_object.get_u32("gid"sv).value_or(0);
-        process.ppid = process_object.get_u32("ppid"sv).value_or(0);
-        process.kernel = process_object.get_bool("kernel"sv).value_or(false);
-        process.name = process_object.get_byte_string("name"sv).value_or("");
-        process.executable = process_object.get_byte_string("executable"sv).value_or("");
-        process.tty = process_object.get_byte_string("tty"sv).value_or("");
-        process.pledge = process_object.get_byte_string("pledge"sv).value_or("");
-        process.veil = process_object.get_byte_string("veil"sv).value_or("");
-        process.creation_time = UnixDateTime::from_nanoseconds_since_epoch(process_object.get_i64("creation_time"sv).value_or(0));
-        process.amount_virtual = process_object.get_u32("amount_virtual"sv).value_or(0);
-        process.amount_resident = process_object.get_u32("amount_resident"sv).value_or(0);
-        process.amount_shared = process_object.get_u32("amount_shared"sv).value_or(0);
-        process.amount_dirty_private = process_object.get_u32("amount_dirty_private"sv).value_or(0);
-        process.amount_clean_inode = process_object.get_u32("amount_clean_inode"sv).value_or(0);
-        process.amount_purgeable_volatile = process_object.get_u32("amount_purgeable_volatile"sv).value_or(0);
-        process.amount_purgeable_nonvolatile = process_object.get_u32("amount_purgeable_nonvolatile"sv).value_or(0);
-
-        auto& thread_array = process_object.get_array("threads"sv).value();
-        process.threads.ensure_capacity(thread_array.size());
-        thread_array.for_each([&](auto& value) {
-            auto& thread_object = value.as_object();
-            Core::ThreadStatistics thread;
-            thread.tid = thread_object.get_u32("tid"sv).value_or(0);
-            thread.times_scheduled = thread_object.get_u32("times_scheduled"sv).value_or(0);
-            thread.name = thread_object.get_byte_string("name"sv).value_or("");
-            thread.state = thread_object.get_byte_string("state"sv).value_or("");
-            thread.time_user = thread_object.get_u64("time_user"sv).value_or(0);
-            thread.time_kernel = thread_object.get_u64("time_kernel"sv).value_or(0);
-            thread.cpu = thread_object.get_u32("cpu"sv).value_or(0);
-            thread.priority = thread_object.get_u32("priority"sv).value_or(0);
-            thread.syscall_count = thread_object.get_u32("syscall_count"sv).value_or(0);
-            thread.inode_faults = thread_object.get_u32("inode_faults"sv).value_or(0);
-            thread.zero_faults = thread_object.get_u32("zero_faults"sv).value_or(0);
-            thread.cow_faults = thread_object.get_u32("cow_faults"sv).value_or(0);
-            thread.unix_socket_read_bytes = thread_object.get_u64("unix_socket_read_bytes"sv).value_or(0);
-            thread.unix_socket_write_bytes = thread_object.get_u64("unix_socket_write_bytes"sv).value_or(0);
-            thread.ipv4_socket_read_bytes = thread_object.get_u64("ipv4_socket_read_bytes"sv).value_or(0);
-            thread.ipv4_socket_write_bytes = thread_object.get_u64("ipv4_socket_write_bytes"sv).value_or(0);
-            thread.file_read_bytes = thread_object.get_u64("file_read_bytes"sv).value_or(0);
-            thread.file_write_bytes = thread_object.get_u64("file_write_bytes"sv).value_or(0);
-            process.threads.append(move(thread));
-        });
 
-        // and synthetic data last
-        if (include_usernames) {
-            process.username = username_from_uid(process.uid);
+    // NOTE: We read the JSON as it comes instead of building a JsonValue for it first, since this is done over and over
+    //       again by the likes of top and SystemMonitor, and there can be a lot of processes and threads to go through.
+    JsonStreamReader reader { file_contents };
+    TRY(reader.for_each_member([&](StringView key) -> ErrorOr<void> {
+        if (key == "processes"sv) {
+            return reader.for_each_element([&]() -> ErrorOr<void> {
+                auto process = TRY(read_process(reader));
+                // and synthetic data last
+                if (include_usernames)
+                    process.username = username_from_uid(process.uid);
+                TRY(all_processes_statistics.processes.try_append(move(process)));
+                return {};
+            });
         }
-        all_processes_statistics.processes.append(move(process));
-    });
+        if (key == "total_time"sv)
+            all_processes_statistics.total_time_scheduled = TRY(reader.read_number<u64>());
+        else if (key == "total_time_kernel"sv)
+            all_processes_statistics.total_time_scheduled_kernel = TRY(reader.read_number<u64>());
+        else
+            TRY(reader.skip_value());
+        return {};
+    }));
+    TRY(reader.finish());
 
-    all_processes_statistics.total_time_scheduled = json_obj.get_u64("total_time"sv).value_or(0);
-    all_processes_statistics.total_time_scheduled_kernel = json_obj.get_u64("total_time_kernel"sv).value_or(0);
     return all_processes_statistics;
 }
 
@@ -1731,6 +1731,47 @@ ErrorOr<int> poll(Span<struct pollfd> poll_fds, int timeout)
     return { rc };
 }
 
+#if defined(AK_OS_SERENITY) || defined(AK_OS_LINUX)
+ErrorOr<int> epoll_create1(int flags)
+{
+    int fd = ::epoll_create1(flags);
+    if (fd < 0)
+        return Error::from_syscall("epoll_create1"sv, -errno);
+    return fd;
+}
+
+ErrorOr<void> epoll_ctl(int epfd, int op, int fd, struct epoll_event* event)
+{
+    if (::epoll_ctl(epfd, op, fd, event) < 0)
+        return Error::from_syscall("epoll_ctl"sv, -errno);
+    return {};
+}
+
+ErrorOr<int> epoll_wait(int epfd, Span<struct epoll_event> events, int timeout)
+{
+    auto const rc = ::epoll_wait(epfd, events.data(), events.size(), timeout);
+    if (rc < 0)
+        return Error::from_syscall("epoll_wait"sv, -errno);
+    return { rc };
+}
+
+ErrorOr<size_t> sendfile(int out_fd, int in_fd, off_t* offset, size_t count)
+{
+    auto const rc = ::sendfile(out_fd, in_fd, offset, count);
+    if (rc < 0)
+        return Error::from_syscall("sendfile"sv, -errno);
+    return static_cast<size_t>(rc);
+}
+
+ErrorOr<size_t> copy_file_range(int fd_in, off_t* offset_in, int fd_out, off_t* offset_out, size_t count)
+{
+    auto const rc = ::copy_file_range(fd_in, offset_in, fd_out, offset_out, count, 0);
+    if (rc < 0)
+        return Error::from_syscall("copy_file_range"sv, -errno);
+    return static_cast<size_t>(rc);
+}
+#endif
+
 #ifdef AK_OS_SERENITY
 ErrorOr<void> posix_fallocate(int fd, off_t offset, off_t length)
 {
@@ -35,6 +35,11 @@
 #    include <Kernel/API/Jail.h>
 #endif
 
+#if defined(AK_OS_SERENITY) || defined(AK_OS_LINUX)
+#    include <sys/epoll.h>
+#    include <sys/sendfile.h>
+#endif
+
 #if !defined(AK_OS_BSD_GENERIC)
 #    include <shadow.h>
 #endif
@@ -240,6 +245,18 @@ ErrorOr<void> access(StringView pathname, int mode, int flags = 0);
 ErrorOr<ByteString> readlink(StringView pathname);
 ErrorOr<int> poll(Span<struct pollfd>, int timeout);
 
+#if defined(AK_OS_SERENITY) || defined(AK_OS_LINUX)
+ErrorOr<int> epoll_create1(int flags);
+ErrorOr<void> epoll_ctl(int epfd, int op, int fd, struct epoll_event*);
+ErrorOr<int> epoll_wait(int epfd, Span<struct epoll_event>, int timeout);
+
+// Copies up to `count` bytes from in_fd to out_fd without going through userspace.
+ErrorOr<size_t> sendfile(int out_fd, int in_fd, off_t* offset, size_t count);
+
+// Copies up to `count` bytes between two regular files without going through userspace.
+ErrorOr<size_t> copy_file_range(int fd_in, off_t* offset_in, int fd_out, off_t* offset_out, size_t count);
+#endif
+
 #ifdef AK_OS_SERENITY
 ErrorOr<void> create_block_device(StringView name, mode_t mode, unsigned major, unsigned minor);
 ErrorOr<void> create_char_device(StringView name, mode_t mode, unsigned major, unsigned minor);
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/JsonArraySerializer.h>
+#include <AK/JsonObjectSerializer.h>
+#include <AK/StringBuilder.h>
+#include <AK/Vector.h>
+#include <LibCore/TraceEvent.h>
+#include <LibThreading/Mutex.h>
+#include <unistd.h>
+
+namespace Core {
+
+Atomic<bool> TraceEvent::s_enabled { false };
+
+namespace {
+
+struct RecordedEvent {
+    StringView category;
+    StringView name;
+    ByteString detail;
+    i64 start_us { 0 };
+    i64 duration_us { 0 };
+    u64 thread_id { 0 };
+    Optional<u64> async_id;
+};
+
+// Keeps a forgotten tracing session from growing without bounds.
+static constexpr size_t max_recorded_events = 1'000'000;
+
+Threading::Mutex s_mutex;
+Vector<RecordedEvent> s_events;
+size_t s_dropped_event_count { 0 };
+
+u64 current_thread_id()
+{
+    static Atomic<u64> s_next_thread_id { 1 };
+    thread_local u64 const thread_id = s_next_thread_id.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+    return thread_id;
+}
+
+void append_event(StringView category, StringView name, MonotonicTime start, MonotonicTime end, StringView detail, Optional<u64> async_id)
+{
+    RecordedEvent event {
+        .category = category,
+        .name = name,
+        .detail = detail,
+        .start_us = start.nanoseconds() / 1000,
+        .duration_us = (end - start).to_microseconds(),
+        .thread_id = current_thread_id(),
+        .async_id = async_id,
+    };
+
+    Threading::MutexLocker locker(s_mutex);
+    if (s_events.size() >= max_recorded_events) {
+        ++s_dropped_event_count;
+        return;
+    }
+    s_events.append(move(event));
+}
+
+}
+
+void TraceEvent::set_enabled(bool enabled)
+{
+    s_enabled.store(enabled, AK::MemoryOrder::memory_order_relaxed);
+}
+
+void TraceEvent::record(StringView category, StringView name, MonotonicTime start, MonotonicTime end, StringView detail)
+{
+    append_event(category, name, start, end, detail, {});
+}
+
+void TraceEvent::record_async(StringView category, StringView name, u64 id, MonotonicTime start, MonotonicTime end, StringView detail)
+{
+    append_event(category, name, start, end, detail, id);
+}
+
+ByteString TraceEvent::take_events_as_json()
+{
+    Vector<RecordedEvent> events;
+    size_t dropped_event_count = 0;
+    {
+        Threading::MutexLocker locker(s_mutex);
+        events = move(s_events);
+        dropped_event_count = exchange(s_dropped_event_count, 0);
+    }
+
+    if (dropped_event_count != 0)
+        dbgln("TraceEvent: Dropped {} events after reaching the limit of {}", dropped_event_count, max_recorded_events);
+
+    auto pid = getpid();
+
+    StringBuilder builder;
+    auto array = MUST(JsonArraySerializer<>::try_create(builder));
+
+    auto add_event = [&](RecordedEvent const& event, StringView phase, i64 timestamp_us) {
+        auto object = MUST(array.add_object());
+        MUST(object.add("name"sv, event.name));
+        MUST(object.add("cat"sv, event.category));
+        MUST(object.add("ph"sv, phase));
+        MUST(object.add("ts"sv, timestamp_us));
+        if (phase == "X"sv)
+            MUST(object.add("dur"sv, event.duration_us));
+        if (event.async_id.has_value())
+            MUST(object.add("id"sv, *event.async_id));
+        MUST(object.add("pid"sv, pid));
+        MUST(object.add("tid"sv, event.thread_id));
+        if (!event.detail.is_empty() && phase != "e"sv) {
+            auto args = MUST(object.add_object("args"sv));
+            MUST(args.add("detail"sv, event.detail));
+            MUST(args.finish());
+        }
+        MUST(object.finish());
+    };
+
+    for (auto const& event : events) {
+        if (event.async_id.has_value()) {
+            add_event(event, "b"sv, event.start_us);
+            add_event(event, "e"sv, event.start_us + event.duration_us);
+        } else {
+            add_event(event, "X"sv, event.start_us);
+        }
+    }
+
+    MUST(array.finish());
+    return builder.to_byte_string();
+}
+
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/ByteString.h>
+#include <AK/Noncopyable.h>
+#include <AK/Optional.h>
+#include <AK/StringView.h>
+#include <AK/Time.h>
+
+namespace Core {
+
+// Records spans of work in the Chrome trace event format, so they can be looked at on a timeline in
+// chrome://tracing or https://ui.perfetto.dev. Recording is off by default, in which case a span costs
+// a single relaxed load.
+//
+// NOTE: Categories and names are not copied, and must be string literals.
+class TraceEvent {
+public:
+    static bool is_enabled() { return s_enabled.load(AK::MemoryOrder::memory_order_relaxed); }
+    static void set_enabled(bool);
+
+    // NOTE: These record unconditionally, callers that have to do any work to gather the arguments should check is_enabled() first.
+    static void record(StringView category, StringView name, MonotonicTime start, MonotonicTime end, StringView detail = {});
+
+    // Async events may overlap other events on the same thread, e.g. for network requests that are in flight at the same time.
+    static void record_async(StringView category, StringView name, u64 id, MonotonicTime start, MonotonicTime end, StringView detail = {});
+
+    // Returns all events recorded so far as a JSON array of trace events, and forgets about them.
+    static ByteString take_events_as_json();
+
+private:
+    static Atomic<bool> s_enabled;
+};
+
+class TraceEventScope {
+    AK_MAKE_NONCOPYABLE(TraceEventScope);
+    AK_MAKE_NONMOVABLE(TraceEventScope);
+
+public:
+    TraceEventScope(StringView category, StringView name)
+        : m_category(category)
+        , m_name(name)
+    {
+        if (TraceEvent::is_enabled()) [[unlikely]]
+            m_start = MonotonicTime::now();
+    }
+
+    ~TraceEventScope()
+    {
+        if (m_start.has_value()) [[unlikely]]
+            TraceEvent::record(m_category, m_name, *m_start, MonotonicTime::now());
+    }
+
+private:
+    StringView m_category;
+    StringView m_name;
+    Optional<MonotonicTime> m_start;
+};
+
+}
@@ -9,38 +9,153 @@
 
 namespace Crypto {
 
+using Word = UnsignedBigInteger::Word;
+
+// Below this many words in the shorter operand, schoolbook multiplication beats Karatsuba's extra additions.
+static constexpr size_t karatsuba_threshold = 32;
+
+/**
+ * Computes output = left * right, where output has exactly left.size() + right.size() words.
+ */
+static void schoolbook_multiply(Span<Word> output, ReadonlySpan<Word> left, ReadonlySpan<Word> right)
+{
+    output.fill(0);
+    for (size_t i = 0; i < left.size(); ++i) {
+        u64 carry = 0;
+        for (size_t j = 0; j < right.size(); ++j) {
+            u64 product = static_cast<u64>(left[i]) * right[j] + output[i + j] + carry;
+            output[i + j] = static_cast<Word>(product);
+            carry = product >> UnsignedBigInteger::BITS_IN_WORD;
+        }
+        output[i + right.size()] = static_cast<Word>(carry);
+    }
+}
+
+/**
+ * Computes accumulator += value, where the accumulator has at least as many words as the value, and returns the carry out of the accumulator.
+ */
+static Word add_into(Span<Word> accumulator, ReadonlySpan<Word> value)
+{
+    u64 carry = 0;
+    for (size_t i = 0; i < accumulator.size() && (i < value.size() || carry); ++i) {
+        u64 sum = static_cast<u64>(accumulator[i]) + (i < value.size() ? value[i] : 0) + carry;
+        accumulator[i] = static_cast<Word>(sum);
+        carry = sum >> UnsignedBigInteger::BITS_IN_WORD;
+    }
+    return static_cast<Word>(carry);
+}
+
 /**
- * Complexity: O(N^2) where N is the number of words in the larger number
+ * Computes accumulator -= value, where the accumulator is known to be at least as large as the value.
+ */
+static void subtract_from(Span<Word> accumulator, ReadonlySpan<Word> value)
+{
+    Word borrow = 0;
+    for (size_t i = 0; i < accumulator.size() && (i < value.size() || borrow); ++i) {
+        Word subtrahend = i < value.size() ? value[i] : 0;
+        Word difference = accumulator[i] - subtrahend - borrow;
+        borrow = (accumulator[i] < subtrahend || (accumulator[i] == subtrahend && borrow)) ? 1 : 0;
+        accumulator[i] = difference;
+    }
+    VERIFY(borrow == 0);
+}
+
+/**
+ * Returns an upper bound for the scratch space karatsuba_multiply() needs. Every level of the recursion needs at most
+ * 2 * (left_length + right_length + 2) words for its sums and middle product, and the nested levels can reuse the space after that.
+ */
+static size_t karatsuba_scratch_size(size_t left_length, size_t right_length)
+{
+    size_t levels = 0;
+    for (size_t shorter_length = min(left_length, right_length); shorter_length >= karatsuba_threshold; shorter_length = shorter_length - shorter_length / 2 + 1)
+        ++levels;
+    return levels * 2 * (left_length + right_length + 2);
+}
+
+/**
+ * Computes output = left * right, where output has exactly left.size() + right.size() words.
+ * With left = a1 * B^h + a0 and right = b1 * B^h + b0, this computes the product from the three half-sized products
+ * a0 * b0, a1 * b1 and (a0 + a1) * (b0 + b1), instead of the four that schoolbook multiplication would need.
+ */
+static void karatsuba_multiply(Span<Word> output, ReadonlySpan<Word> left, ReadonlySpan<Word> right, Span<Word> scratch)
+{
+    size_t shorter_length = min(left.size(), right.size());
+    if (shorter_length < karatsuba_threshold) {
+        schoolbook_multiply(output, left, right);
+        return;
+    }
+
+    size_t half = shorter_length / 2;
+    auto left_low = left.slice(0, half);
+    auto left_high = left.slice(half);
+    auto right_low = right.slice(0, half);
+    auto right_high = right.slice(half);
+
+    // The low and high products land in disjoint parts of the output: z0 in the low 2h words, z2 in the rest.
+    auto low_product = output.slice(0, 2 * half);
+    auto high_product = output.slice(2 * half);
+
+    auto left_sum = scratch.slice(0, left_high.size() + 1);
+    auto right_sum = scratch.slice(left_sum.size(), right_high.size() + 1);
+    auto middle_product = scratch.slice(left_sum.size() + right_sum.size(), left_sum.size() + right_sum.size());
+    auto remaining_scratch = scratch.slice(left_sum.size() + right_sum.size() + middle_product.size());
+
+    left_high.copy_to(left_sum);
+    left_sum.last() = add_into(left_sum.slice(0, left_high.size()), left_low);
+    right_high.copy_to(right_sum);
+    right_sum.last() = add_into(right_sum.slice(0, right_high.size()), right_low);
+
+    karatsuba_multiply(low_product, left_low, right_low, remaining_scratch);
+    karatsuba_multiply(high_product, left_high, right_high, remaining_scratch);
+    karatsuba_multiply(middle_product, left_sum, right_sum, remaining_scratch);
+
+    // z1 = (a0 + a1) * (b0 + b1) - z0 - z2 = a0 * b1 + a1 * b0
+    subtract_from(middle_product, low_product);
+    subtract_from(middle_product, high_product);
+
+    // z1 always fits in the output above B^h, so any words of it beyond that are zero.
+    auto middle_destination = output.slice(half);
+    auto significant_middle_length = min(middle_product.size(), middle_destination.size());
+    for (size_t i = significant_middle_length; i < middle_product.size(); ++i)
+        VERIFY(middle_product[i] == 0);
+    auto carry = add_into(middle_destination, middle_product.slice(0, significant_middle_length));
+    VERIFY(carry == 0);
+}
+
+/**
+ * Complexity: O(N^2) where N is the number of words in the larger number, or O(N^1.58) once Karatsuba kicks in
  * Multiplication method:
- * An integer is equal to the sum of the powers of two
- * according to the indices of its 'on' bits.
- * So to multiple x*y, we go over each '1' bit in x (say the i'th bit),
- * and add y<<i to the result.
+ * Word-by-word schoolbook multiplication for small numbers, and Karatsuba multiplication for large ones.
+ * temp_scratch is used as scratch space for the intermediate Karatsuba products.
  */
 FLATTEN void UnsignedBigIntegerAlgorithms::multiply_without_allocation(
     UnsignedBigInteger const& left,
     UnsignedBigInteger const& right,
-    UnsignedBigInteger& temp_shift_result,
-    UnsignedBigInteger& temp_shift_plus,
-    UnsignedBigInteger& temp_shift,
+    UnsignedBigInteger& temp_scratch,
     UnsignedBigInteger& output)
 {
-    output.set_to_0();
+    auto left_length = left.trimmed_length();
+    auto right_length = right.trimmed_length();
 
-    // iterate all bits
-    for (size_t word_index = 0; word_index < left.length(); ++word_index) {
-        for (size_t bit_index = 0; bit_index < UnsignedBigInteger::BITS_IN_WORD; ++bit_index) {
-            // If the bit is off - skip over it
-            if (!(left.m_words[word_index] & (1 << bit_index)))
-                continue;
+    output.set_to_0();
+    if (left_length == 0 || right_length == 0)
+        return;
 
-            size_t shift_amount = word_index * UnsignedBigInteger::BITS_IN_WORD + bit_index;
+    output.resize_with_leading_zeros(left_length + right_length);
+    auto output_words = Span<Word> { output.m_words.data(), left_length + right_length };
+    auto left_words = ReadonlySpan<Word> { left.m_words.data(), left_length };
+    auto right_words = ReadonlySpan<Word> { right.m_words.data(), right_length };
 
-            // output += (right << shift_amount);
-            shift_left_without_allocation(right, shift_amount, temp_shift_result, temp_shift_plus, temp_shift);
-            add_into_accumulator_without_allocation(output, temp_shift);
-        }
+    auto scratch_size = karatsuba_scratch_size(left_length, right_length);
+    if (scratch_size == 0) {
+        schoolbook_multiply(output_words, left_words, right_words);
+    } else {
+        temp_scratch.set_to_0();
+        temp_scratch.resize_with_leading_zeros(scratch_size);
+        karatsuba_multiply(output_words, left_words, right_words, { temp_scratch.m_words.data(), scratch_size });
     }
+
+    output.clamp_to_trimmed_length();
 }
 
 }
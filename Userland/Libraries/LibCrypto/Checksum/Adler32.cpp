@@ -4,14 +4,80 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Platform.h>
 #include <AK/Span.h>
 #include <AK/Types.h>
 #include <LibCrypto/Checksum/Adler32.h>
 
+#if ARCH(X86_64)
+#    include <immintrin.h>
+#endif
+
 namespace Crypto::Checksum {
 
+#if ARCH(X86_64)
+static bool const s_has_ssse3 = __builtin_cpu_supports("ssse3");
+
+// This processes 32-byte blocks, and returns the number of bytes that were processed.
+// For a block of bytes b_1..b_32, a grows by the sum of the bytes, and b grows by 32 * a plus the sum of (33 - i) * b_i.
+// Both sums are computed with SSSE3 multiply-add and sum-of-absolute-differences instructions.
+[[gnu::target("ssse3")]] static size_t update_with_ssse3(u32& state_a, u32& state_b, ReadonlyBytes data)
+{
+    static constexpr size_t block_size = 32;
+    // The largest number of bytes that can be processed before the 32-bit sums have to be reduced modulo 65521.
+    static constexpr size_t blocks_without_overflow = 5552 / block_size;
+
+    __m128i const weights_1 = _mm_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17);
+    __m128i const weights_2 = _mm_setr_epi8(16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1);
+    __m128i const zero = _mm_setzero_si128();
+    __m128i const ones = _mm_set1_epi16(1);
+
+    auto const* bytes = data.data();
+    size_t blocks = data.size() / block_size;
+    while (blocks > 0) {
+        size_t chunk_blocks = min(blocks, blocks_without_overflow);
+        blocks -= chunk_blocks;
+
+        // The initial a contributes to b once for every byte in the chunk.
+        __m128i previous_a_sum = _mm_set_epi32(0, 0, 0, static_cast<int>(state_a * chunk_blocks));
+        __m128i b_sum = _mm_set_epi32(0, 0, 0, static_cast<int>(state_b));
+        __m128i a_sum = zero;
+
+        for (size_t i = 0; i < chunk_blocks; ++i) {
+            __m128i bytes_1 = _mm_loadu_si128(reinterpret_cast<__m128i const*>(bytes));
+            __m128i bytes_2 = _mm_loadu_si128(reinterpret_cast<__m128i const*>(bytes + 16));
+            bytes += block_size;
+
+            previous_a_sum = _mm_add_epi32(previous_a_sum, a_sum);
+
+            a_sum = _mm_add_epi32(a_sum, _mm_sad_epu8(bytes_1, zero));
+            b_sum = _mm_add_epi32(b_sum, _mm_madd_epi16(_mm_maddubs_epi16(bytes_1, weights_1), ones));
+            a_sum = _mm_add_epi32(a_sum, _mm_sad_epu8(bytes_2, zero));
+            b_sum = _mm_add_epi32(b_sum, _mm_madd_epi16(_mm_maddubs_epi16(bytes_2, weights_2), ones));
+        }
+
+        b_sum = _mm_add_epi32(b_sum, _mm_slli_epi32(previous_a_sum, 5));
+
+        // Add up the 32-bit lanes.
+        a_sum = _mm_add_epi32(a_sum, _mm_shuffle_epi32(a_sum, _MM_SHUFFLE(1, 0, 3, 2)));
+        b_sum = _mm_add_epi32(b_sum, _mm_shuffle_epi32(b_sum, _MM_SHUFFLE(2, 3, 0, 1)));
+        b_sum = _mm_add_epi32(b_sum, _mm_shuffle_epi32(b_sum, _MM_SHUFFLE(1, 0, 3, 2)));
+
+        state_a = (state_a + static_cast<u32>(_mm_cvtsi128_si32(a_sum))) % 65521;
+        state_b = static_cast<u32>(_mm_cvtsi128_si32(b_sum)) % 65521;
+    }
+
+    return bytes - data.data();
+}
+#endif
+
 void Adler32::update(ReadonlyBytes data)
 {
+#if ARCH(X86_64)
+    if (s_has_ssse3)
+        data = data.slice(update_with_ssse3(m_state_a, m_state_b, data));
+#endif
+
     // See https://github.com/SerenityOS/serenity/pull/24408#discussion_r1609051678
     constexpr size_t iterations_without_overflow = 380368439;
 
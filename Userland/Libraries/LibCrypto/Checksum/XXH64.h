@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/Span.h>
+#include <AK/Types.h>
+#include <LibCrypto/Checksum/ChecksumFunction.h>
+
+namespace Crypto::Checksum {
+
+// https://github.com/Cyan4973/xxHash/blob/dev/doc/xxhash_spec.md#xxh64-algorithm-description
+class XXH64 : public ChecksumFunction<u64> {
+public:
+    explicit XXH64(u64 seed = 0);
+    explicit XXH64(ReadonlyBytes data)
+        : XXH64()
+    {
+        update(data);
+    }
+
+    virtual void update(ReadonlyBytes data) override;
+    virtual u64 digest() override;
+
+private:
+    static constexpr size_t stripe_size = 32;
+
+    void consume_stripe(u8 const*);
+
+    u64 m_seed { 0 };
+    Array<u64, 4> m_accumulators;
+    Array<u8, stripe_size> m_buffer;
+    size_t m_buffered_size { 0 };
+    u64 m_total_size { 0 };
+};
+
+}
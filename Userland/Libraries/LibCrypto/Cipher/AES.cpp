@@ -8,6 +8,10 @@
 #include <LibCrypto/Cipher/AES.h>
 #include <LibCrypto/Cipher/AESTables.h>
 
+#if ARCH(X86_64) && !defined(KERNEL)
+#    include <immintrin.h>
+#endif
+
 namespace Crypto::Cipher {
 
 template<typename T>
@@ -196,8 +200,48 @@ void AESCipherKey::expand_decrypt_key(ReadonlyBytes user_key, size_t bits)
     }
 }
 
+#if ARCH(X86_64) && !defined(KERNEL)
+static bool const s_has_aes_ni = __builtin_cpu_supports("aes") && __builtin_cpu_supports("ssse3");
+
+// NOTE: The round keys are stored as big-endian words, while AES-NI wants them in the byte order of the key schedule.
+[[gnu::target("aes,ssse3")]] static __m128i load_round_key(u32 const* round_key)
+{
+    auto const byte_swap_words = _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    return _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const*>(round_key)), byte_swap_words);
+}
+
+[[gnu::target("aes,ssse3")]] static void encrypt_block_with_aes_ni(AESCipherKey const& key, u8 const* in, u8* out)
+{
+    auto const* round_keys = key.round_keys();
+    auto state = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<__m128i const*>(in)), load_round_key(round_keys));
+    for (size_t round = 1; round < key.rounds(); ++round)
+        state = _mm_aesenc_si128(state, load_round_key(round_keys + round * 4));
+    state = _mm_aesenclast_si128(state, load_round_key(round_keys + key.rounds() * 4));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), state);
+}
+
+// NOTE: The decryption key schedule already has the inverse mix-column applied to its middle rounds, which is the
+//       "equivalent inverse cipher" form that AESDEC expects.
+[[gnu::target("aes,ssse3")]] static void decrypt_block_with_aes_ni(AESCipherKey const& key, u8 const* in, u8* out)
+{
+    auto const* round_keys = key.round_keys();
+    auto state = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<__m128i const*>(in)), load_round_key(round_keys));
+    for (size_t round = 1; round < key.rounds(); ++round)
+        state = _mm_aesdec_si128(state, load_round_key(round_keys + round * 4));
+    state = _mm_aesdeclast_si128(state, load_round_key(round_keys + key.rounds() * 4));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), state);
+}
+#endif
+
 void AESCipher::encrypt_block(AESCipherBlock const& in, AESCipherBlock& out)
 {
+#if ARCH(X86_64) && !defined(KERNEL)
+    if (s_has_aes_ni) {
+        encrypt_block_with_aes_ni(key(), in.bytes().data(), out.bytes().data());
+        return;
+    }
+#endif
+
     u32 s0, s1, s2, s3, t0, t1, t2, t3;
     size_t r { 0 };
 
@@ -287,6 +331,13 @@ void AESCipher::encrypt_block(AESCipherBlock const& in, AESCipherBlock& out)
 
 void AESCipher::decrypt_block(AESCipherBlock const& in, AESCipherBlock& out)
 {
+#if ARCH(X86_64) && !defined(KERNEL)
+    if (s_has_aes_ni) {
+        decrypt_block_with_aes_ni(key(), in.bytes().data(), out.bytes().data());
+        return;
+    }
+#endif
+
     u32 s0, s1, s2, s3, t0, t1, t2, t3;
     size_t r { 0 };
 
@@ -45,7 +45,7 @@ ErrorOr<ByteBuffer> Ed25519::generate_public_key(ReadonlyBytes private_key)
     s[31] |= 0x40;
 
     // Perform a fixed-base scalar multiplication [s]B.
-    point_multiply_scalar(&sb, s, &BASE_POINT);
+    point_multiply_base(&sb, s);
 
     // 4.  The public key A is the encoding of the point [s]B.
     // First, encode the y-coordinate (in the range 0 <= y < p) as a little-endian string of 32 octets.
@@ -91,7 +91,7 @@ ErrorOr<ByteBuffer> Ed25519::sign(ReadonlyBytes public_key, ReadonlyBytes privat
     barrett_reduce(r, digest.data);
 
     // 3.  Compute the point [r]B.
-    point_multiply_scalar(&rb, r, &BASE_POINT);
+    point_multiply_base(&rb, r);
 
     auto R = TRY(ByteBuffer::create_uninitialized(32));
     // Let the string R be the encoding of this point
@@ -179,7 +179,7 @@ bool Ed25519::verify(ReadonlyBytes public_key, ReadonlyBytes signature, Readonly
     // NOTE: We check [S]B - [k]A' == R
     Curve25519::modular_subtract(ka.x, Curve25519::ZERO, ka.x);
     Curve25519::modular_subtract(ka.t, Curve25519::ZERO, ka.t);
-    point_multiply_scalar(&sb, s, &BASE_POINT);
+    point_multiply_base(&sb, s);
     point_multiply_scalar(&ka, k, &ka);
     point_add(&ka, &sb, &ka);
     encode_point(&ka, p);
@@ -209,25 +209,57 @@ void Ed25519::point_double(Ed25519Point* result, Ed25519Point const* point)
 
 void Ed25519::point_multiply_scalar(Ed25519Point* result, u8 const* scalar, Ed25519Point const* point)
 {
+    WindowTable table;
+    make_window_table(table, point);
+
     // Set U to the neutral element (0, 1, 1, 0)
     Curve25519::set(u.x, 0);
     Curve25519::set(u.y, 1);
     Curve25519::set(u.z, 1);
     Curve25519::set(u.t, 0);
 
-    for (i32 i = Curve25519::BITS - 1; i >= 0; i--) {
-        u8 b = (scalar[i / 8] >> (i % 8)) & 1;
+    for (size_t window = WINDOW_COUNT; window-- > 0;) {
+        // Compute U = 16 * U
+        for (size_t i = 0; i < WINDOW_BITS; i++)
+            point_double(&u, &u);
+
+        // Compute U = U + digit * P
+        // NOTE: The addition formulas are complete, so adding the neutral element for a zero digit is fine.
+        select_from_window_table(&v, table, window_digit(scalar, window));
+        point_add(&u, &u, &v);
+    }
 
-        // Compute U = 2 * U
-        point_double(&u, &u);
-        // Compute V = U + P
-        point_add(&v, &u, point);
+    Curve25519::copy(result->x, u.x);
+    Curve25519::copy(result->y, u.y);
+    Curve25519::copy(result->z, u.z);
+    Curve25519::copy(result->t, u.t);
+}
+
+void Ed25519::point_multiply_base(Ed25519Point* result, u8 const* scalar)
+{
+    // For every window w, the multiples j * 16^w * B of the base point B.
+    // NOTE: The table only depends on the curve, so it is built once and shared by all instances.
+    static Array<WindowTable, WINDOW_COUNT> const base_point_table = [this] {
+        Array<WindowTable, WINDOW_COUNT> table;
+        Ed25519Point base = BASE_POINT;
+        for (size_t window = 0; window < WINDOW_COUNT; window++) {
+            make_window_table(table[window], &base);
+            for (size_t i = 0; i < WINDOW_BITS; i++)
+                point_double(&base, &base);
+        }
+        return table;
+    }();
+
+    // With the multiples of every window precomputed, the fixed-base multiplication needs no point doublings:
+    // [s]B = sum(digit_w * 16^w * B)
+    Curve25519::set(u.x, 0);
+    Curve25519::set(u.y, 1);
+    Curve25519::set(u.z, 1);
+    Curve25519::set(u.t, 0);
 
-        // If b is set, then U = V
-        Curve25519::select(u.x, u.x, v.x, b);
-        Curve25519::select(u.y, u.y, v.y, b);
-        Curve25519::select(u.z, u.z, v.z, b);
-        Curve25519::select(u.t, u.t, v.t, b);
+    for (size_t window = 0; window < WINDOW_COUNT; window++) {
+        select_from_window_table(&v, base_point_table[window], window_digit(scalar, window));
+        point_add(&u, &u, &v);
     }
 
     Curve25519::copy(result->x, u.x);
@@ -236,6 +268,37 @@ void Ed25519::point_multiply_scalar(Ed25519Point* result, u8 const* scalar, Ed25
     Curve25519::copy(result->t, u.t);
 }
 
+void Ed25519::make_window_table(WindowTable& table, Ed25519Point const* point)
+{
+    // The first entry is the neutral element (0, 1, 1, 0)
+    Curve25519::set(table[0].x, 0);
+    Curve25519::set(table[0].y, 1);
+    Curve25519::set(table[0].z, 1);
+    Curve25519::set(table[0].t, 0);
+
+    table[1] = *point;
+    for (size_t i = 2; i < WINDOW_SIZE; i++)
+        point_add(&table[i], &table[i - 1], point);
+}
+
+void Ed25519::select_from_window_table(Ed25519Point* result, WindowTable const& table, u8 digit)
+{
+    // Read every entry of the table, so the memory access pattern doesn't depend on the secret digit
+    *result = table[0];
+    for (size_t i = 1; i < WINDOW_SIZE; i++) {
+        u32 condition = digit == i;
+        Curve25519::select(result->x, result->x, table[i].x, condition);
+        Curve25519::select(result->y, result->y, table[i].y, condition);
+        Curve25519::select(result->z, result->z, table[i].z, condition);
+        Curve25519::select(result->t, result->t, table[i].t, condition);
+    }
+}
+
+u8 Ed25519::window_digit(u8 const* scalar, size_t window)
+{
+    return (scalar[window / 2] >> ((window % 2) * WINDOW_BITS)) & (WINDOW_SIZE - 1);
+}
+
 // https://datatracker.ietf.org/doc/html/rfc8032#section-5.1.2
 void Ed25519::encode_point(Ed25519Point* point, u8* data)
 {
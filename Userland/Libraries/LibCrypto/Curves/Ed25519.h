@@ -6,7 +6,9 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/ByteBuffer.h>
+#include <LibCrypto/Curves/Curve25519.h>
 #include <LibCrypto/Curves/EllipticCurve.h>
 
 namespace Crypto::Curves {
@@ -42,6 +44,17 @@ private:
     void point_add(Ed25519Point* result, Ed25519Point const* p, Ed25519Point const* q);
     void point_double(Ed25519Point* result, Ed25519Point const* point);
     void point_multiply_scalar(Ed25519Point* result, u8 const* scalar, Ed25519Point const* point);
+    void point_multiply_base(Ed25519Point* result, u8 const* scalar);
+
+    // Scalars are processed in 4-bit windows, and the multiples of the point for every window digit are precomputed.
+    static constexpr size_t WINDOW_BITS = 4;
+    static constexpr size_t WINDOW_SIZE = 1 << WINDOW_BITS;
+    static constexpr size_t WINDOW_COUNT = Curve25519::BYTES * 8 / WINDOW_BITS;
+    using WindowTable = Array<Ed25519Point, WINDOW_SIZE>;
+
+    void make_window_table(WindowTable& table, Ed25519Point const* point);
+    void select_from_window_table(Ed25519Point* result, WindowTable const& table, u8 digit);
+    static u8 window_digit(u8 const* scalar, size_t window);
 
     void barrett_reduce(u8* result, u8 const* input);
 
@@ -147,7 +147,11 @@ public:
 
     ErrorOr<ByteBuffer> generate_public_key(ReadonlyBytes a) override
     {
-        return compute_coordinate(a, GENERATOR_POINT);
+        AK::FixedMemoryStream scalar_stream { a };
+
+        StorageType scalar = TRY(scalar_stream.read_value<BigEndian<StorageType>>());
+        JacobianPoint result = TRY(generate_public_key_internal(scalar));
+        return export_uncompressed_point(result);
     }
 
     ErrorOr<ByteBuffer> compute_coordinate(ReadonlyBytes scalar_bytes, ReadonlyBytes point_bytes) override
@@ -158,14 +162,7 @@ public:
         StorageType scalar = TRY(scalar_stream.read_value<BigEndian<StorageType>>());
         JacobianPoint point = TRY(read_uncompressed_point(point_stream));
         JacobianPoint result = TRY(compute_coordinate_internal(scalar, point));
-
-        // Export the values into an output buffer
-        auto buf = TRY(ByteBuffer::create_uninitialized(POINT_BYTE_SIZE));
-        AK::FixedMemoryStream buf_stream { buf.bytes() };
-        TRY(buf_stream.write_value<u8>(0x04));
-        TRY(buf_stream.write_value<BigEndian<StorageType>>(result.x));
-        TRY(buf_stream.write_value<BigEndian<StorageType>>(result.y));
-        return buf;
+        return export_uncompressed_point(result);
     }
 
     ErrorOr<ByteBuffer> derive_premaster_key(ReadonlyBytes shared_point) override
@@ -258,11 +255,83 @@ public:
     }
 
 private:
-    ErrorOr<JacobianPoint> generate_public_key_internal(StorageType a)
+    // Scalars are processed in 4-bit windows, and the multiples of the point for every window digit are precomputed.
+    static constexpr size_t WINDOW_BITS = 4;
+    static constexpr size_t WINDOW_SIZE = 1 << WINDOW_BITS;
+    static constexpr size_t WINDOW_COUNT = KEY_BIT_SIZE / WINDOW_BITS;
+    static_assert(KEY_BIT_SIZE % WINDOW_BITS == 0);
+
+    using WindowTable = Array<JacobianPoint, WINDOW_SIZE>;
+
+    // For every window w, the multiples j * 16^w * G of the generator point G, in Montgomery form.
+    using GeneratorTable = Array<WindowTable, WINDOW_COUNT>;
+
+    GeneratorTable const& generator_table()
+    {
+        // NOTE: The table only depends on the curve, so it is built once and shared by all instances.
+        static GeneratorTable const table = [this] {
+            AK::FixedMemoryStream generator_point_stream { GENERATOR_POINT };
+            JacobianPoint base = MUST(read_uncompressed_point(generator_point_stream));
+            base.x = to_montgomery(base.x);
+            base.y = to_montgomery(base.y);
+            base.z = to_montgomery(base.z);
+
+            GeneratorTable table;
+            for (size_t window = 0; window < WINDOW_COUNT; window++) {
+                table[window] = make_window_table(base);
+                for (size_t i = 0; i < WINDOW_BITS; i++)
+                    base = point_double(base);
+            }
+            return table;
+        }();
+        return table;
+    }
+
+    WindowTable make_window_table(JacobianPoint const& point)
+    {
+        // The entry for a zero digit is never used, but looking it up has to be harmless.
+        WindowTable table;
+        table[0] = point;
+        table[1] = point;
+        table[2] = point_double(point);
+        for (size_t i = 3; i < WINDOW_SIZE; i++)
+            table[i] = point_add(table[i - 1], point);
+        return table;
+    }
+
+    JacobianPoint select_from_window_table(WindowTable const& table, u8 digit)
+    {
+        // Read every entry of the table, so the memory access pattern doesn't depend on the secret digit
+        JacobianPoint result = table[0];
+        for (size_t i = 1; i < WINDOW_SIZE; i++)
+            result = select_point(result, table[i], digit == i);
+        return result;
+    }
+
+    static constexpr u8 window_digit(StorageType const& scalar, size_t window)
+    {
+        return static_cast<u8>(scalar >> (window * WINDOW_BITS)) & (WINDOW_SIZE - 1);
+    }
+
+    ErrorOr<JacobianPoint> generate_public_key_internal(StorageType scalar)
     {
-        AK::FixedMemoryStream generator_point_stream { GENERATOR_POINT };
-        JacobianPoint point = TRY(read_uncompressed_point(generator_point_stream));
-        return compute_coordinate_internal(a, point);
+        // FIXME: This will slightly bias the distribution of client secrets
+        scalar = modular_reduce_order(scalar);
+        if (scalar.is_zero_constant_time())
+            return Error::from_string_literal("SECPxxxr1: scalar is zero");
+
+        auto const& table = generator_table();
+
+        // With the multiples of every window precomputed, the fixed-base multiplication needs no point doublings:
+        // scalar * G = sum(digit_w * 16^w * G)
+        JacobianPoint result { 0, 0, 0 };
+        for (size_t window = 0; window < WINDOW_COUNT; window++) {
+            u8 digit = window_digit(scalar, window);
+            JacobianPoint temp_result = point_add(result, select_from_window_table(table[window], digit));
+            result = select_point(result, temp_result, digit != 0);
+        }
+
+        return convert_result_from_montgomery(result);
     }
 
     ErrorOr<JacobianPoint> compute_coordinate_internal(StorageType scalar, JacobianPoint point)
@@ -281,22 +350,24 @@ private:
         if (!is_point_on_curve(point))
             return Error::from_string_literal("SECPxxxr1: point is not on the curve");
 
-        JacobianPoint result { 0, 0, 0 };
-        JacobianPoint temp_result { 0, 0, 0 };
-
-        // Calculate the scalar times point multiplication in constant time
-        for (size_t i = 0; i < KEY_BIT_SIZE; i++) {
-            temp_result = point_add(result, point);
+        auto table = make_window_table(point);
 
-            auto condition = (scalar & 1u) == 1u;
-            result.x = select(result.x, temp_result.x, condition);
-            result.y = select(result.y, temp_result.y, condition);
-            result.z = select(result.z, temp_result.z, condition);
+        // Calculate the scalar times point multiplication in constant time, one window at a time from the most significant one
+        JacobianPoint result { 0, 0, 0 };
+        for (size_t window = WINDOW_COUNT; window-- > 0;) {
+            for (size_t i = 0; i < WINDOW_BITS; i++)
+                result = point_double(result);
 
-            point = point_double(point);
-            scalar >>= 1u;
+            u8 digit = window_digit(scalar, window);
+            JacobianPoint temp_result = point_add(result, select_from_window_table(table, digit));
+            result = select_point(result, temp_result, digit != 0);
         }
 
+        return convert_result_from_montgomery(result);
+    }
+
+    JacobianPoint convert_result_from_montgomery(JacobianPoint result)
+    {
         // Convert from Jacobian coordinates back to Affine coordinates
         convert_jacobian_to_affine(result);
 
@@ -315,6 +386,16 @@ private:
         return result;
     }
 
+    static ErrorOr<ByteBuffer> export_uncompressed_point(JacobianPoint const& point)
+    {
+        auto buf = TRY(ByteBuffer::create_uninitialized(POINT_BYTE_SIZE));
+        AK::FixedMemoryStream buf_stream { buf.bytes() };
+        TRY(buf_stream.write_value<u8>(0x04));
+        TRY(buf_stream.write_value<BigEndian<StorageType>>(point.x));
+        TRY(buf_stream.write_value<BigEndian<StorageType>>(point.y));
+        return buf;
+    }
+
     static ErrorOr<JacobianPoint> read_uncompressed_point(Stream& stream)
     {
         // Make sure the point is uncompressed
@@ -339,6 +420,15 @@ private:
         return (left & mask) | (right & ~mask);
     }
 
+    constexpr JacobianPoint select_point(JacobianPoint const& left, JacobianPoint const& right, bool condition)
+    {
+        return JacobianPoint {
+            select(left.x, right.x, condition),
+            select(left.y, right.y, condition),
+            select(left.z, right.z, condition),
+        };
+    }
+
     constexpr StorageType modular_reduce(StorageType const& value)
     {
         // Add -prime % 2^KEY_BIT_SIZE
@@ -528,9 +618,8 @@ private:
 
         // if (Y == 0)
         //   return POINT_AT_INFINITY
-        if (point.y.is_zero_constant_time()) {
-            VERIFY_NOT_REACHED();
-        }
+        // NOTE: There are no points of order 2 on these curves, so only the point at infinity itself has Y == 0.
+        //       It is represented as (0, 0, 0), which the formulas below map to itself.
 
         StorageType temp;
 
@@ -606,7 +695,7 @@ private:
             if (s1.is_equal_to_constant_time(s2)) {
                 return point_double(point_a);
             } else {
-                VERIFY_NOT_REACHED();
+                return JacobianPoint { 0, 0, 0 };
             }
         }
 
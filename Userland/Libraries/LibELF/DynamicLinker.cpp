@@ -65,16 +65,29 @@ static ByteString s_cwd;
 
 static bool s_allowed_to_check_environment_variables { false };
 static bool s_do_breakpoint_trap_before_entry { false };
+static bool s_bind_now { false };
 static StringView s_ld_library_path;
 static StringView s_main_program_pledge_promises;
 static ByteString s_loader_pledge_promises;
 
 static HashMap<StringView, DynamicObject::SymbolLookupResult> s_magic_functions;
 
+struct GlobalSymbolCacheTraits : public DefaultTraits<StringView> {
+    // NOTE: This is the hash that we need for looking the symbol up in the objects anyway.
+    static unsigned hash(StringView name) { return compute_gnu_hash(name); }
+};
+
+// NOTE: Objects are never unloaded and new ones are only ever appended to s_global_objects,
+//       so once a symbol has been found, it keeps resolving to the same definition.
+static HashMap<StringView, DynamicObject::SymbolLookupResult, GlobalSymbolCacheTraits> s_global_symbol_cache;
+
 Optional<DynamicObject::SymbolLookupResult> DynamicLinker::lookup_global_symbol(StringView name)
 {
-    auto symbol = DynamicObject::HashSymbol { name };
+    return lookup_global_symbol(DynamicObject::HashSymbol { name });
+}
 
+Optional<DynamicObject::SymbolLookupResult> DynamicLinker::lookup_global_symbol(DynamicObject::HashSymbol const& symbol)
+{
     for (auto& lib : s_global_objects) {
         auto res = lib.value->lookup_symbol(symbol);
         if (!res.has_value())
@@ -84,11 +97,27 @@ Optional<DynamicObject::SymbolLookupResult> DynamicLinker::lookup_global_symbol(
         // We don't want to allow local symbols to be pulled in to other modules
     }
 
-    if (auto magic_lookup = s_magic_functions.get(name); magic_lookup.has_value())
+    if (auto magic_lookup = s_magic_functions.get(symbol.name()); magic_lookup.has_value())
         return *magic_lookup;
     return {};
 }
 
+Optional<DynamicObject::SymbolLookupResult> DynamicLinker::lookup_global_symbol_with_cache(StringView name)
+{
+    // Every library refers to the same handful of symbols from LibC, LibCore and friends (malloc, operator new,
+    // vtables, ...), and each of those lookups would otherwise walk the hash tables of all loaded objects again.
+    auto symbol = DynamicObject::HashSymbol { name };
+    auto it = s_global_symbol_cache.find(symbol.gnu_hash(), [&](auto& entry) { return entry.key == name; });
+    if (it != s_global_symbol_cache.end())
+        return it->value;
+
+    auto result = lookup_global_symbol(symbol);
+    // NOTE: Symbols that weren't found might still show up in an object that is loaded later on.
+    if (result.has_value())
+        s_global_symbol_cache.set(name, result.value());
+    return result;
+}
+
 static Result<NonnullRefPtr<DynamicLoader>, DlErrorMessage> map_library(ByteString const& filepath, int fd)
 {
     VERIFY(filepath.starts_with('/'));
@@ -465,9 +494,14 @@ static Optional<DlErrorMessage> verify_tls_for_dlopen(DynamicLoader const& loade
 
 static Result<void*, DlErrorMessage> __dlopen(char const* filename, int flags)
 {
-    // FIXME: RTLD_NOW and RTLD_LOCAL are not supported
-    flags &= ~RTLD_NOW;
-    flags |= RTLD_LAZY;
+    // NOTE: POSIX requires exactly one of RTLD_LAZY and RTLD_NOW, we're lenient and default to lazy binding.
+    if (s_bind_now) {
+        flags &= ~RTLD_LAZY;
+        flags |= RTLD_NOW;
+    } else if (!(flags & RTLD_NOW)) {
+        flags |= RTLD_LAZY;
+    }
+    // FIXME: RTLD_LOCAL is not supported
     flags &= ~RTLD_LOCAL;
     flags |= RTLD_GLOBAL;
 
@@ -627,6 +661,11 @@ static void read_environment_variables()
             s_do_breakpoint_trap_before_entry = true;
         }
 
+        constexpr auto bind_now_string = "LD_BIND_NOW="sv;
+        if (env_string.starts_with(bind_now_string) && env_string.length() > bind_now_string.length()) {
+            s_bind_now = true;
+        }
+
         constexpr auto library_path_string = "LD_LIBRARY_PATH="sv;
         if (env_string.starts_with(library_path_string)) {
             s_ld_library_path = env_string.substring_view(library_path_string.length());
@@ -677,6 +716,11 @@ EntryPointFunction ELF::DynamicLinker::linker_main(ByteString&& main_program_pat
     if (s_allowed_to_check_environment_variables)
         read_environment_variables();
 
+    // NOTE: Programs running with elevated privileges don't leave any symbol resolution for later,
+    //       a missing symbol should make them fail right away instead of halfway through their work.
+    if (is_secure)
+        s_bind_now = true;
+
     s_main_program_path = main_program_path;
 
     // NOTE: We always map the main library first, since it may require
@@ -730,7 +774,7 @@ Examples of static-pie ELF objects are ELF packers, and the system dynamic loade
 
     allocate_tls(objects.load_order);
 
-    auto result = link_main_library(RTLD_GLOBAL | RTLD_LAZY, objects);
+    auto result = link_main_library(RTLD_GLOBAL | (s_bind_now ? RTLD_NOW : RTLD_LAZY), objects);
     if (result.is_error()) {
         warnln("{}", result.error().text);
         _exit(1);
@@ -17,6 +17,11 @@ using EntryPointFunction = int (*)(int, char**, char**);
 class DynamicLinker {
 public:
     static Optional<DynamicObject::SymbolLookupResult> lookup_global_symbol(StringView symbol);
+    static Optional<DynamicObject::SymbolLookupResult> lookup_global_symbol(DynamicObject::HashSymbol const& symbol);
+    // Like lookup_global_symbol(), but remembers where the symbol was found for later lookups.
+    // NOTE: This must only be used while loading objects, and the name must point into the string table of a loaded
+    //       object. Lazy PLT binding can happen on any thread at any time, so it has to use lookup_global_symbol().
+    static Optional<DynamicObject::SymbolLookupResult> lookup_global_symbol_with_cache(StringView symbol);
     static EntryPointFunction linker_main(ByteString&& main_program_path, int fd, bool is_secure, char** envp);
     static int iterate_over_loaded_shared_objects(int (*callback)(struct dl_phdr_info* info, size_t size, void* data), void* data);
 
@@ -186,11 +186,11 @@ bool DynamicLoader::load_stage_2(unsigned flags)
             }
         }
     }
-    do_main_relocations();
+    do_main_relocations(flags);
     return true;
 }
 
-void DynamicLoader::do_main_relocations()
+void DynamicLoader::do_main_relocations(unsigned flags)
 {
     do_relr_relocations();
 
@@ -228,8 +228,8 @@ void DynamicLoader::do_main_relocations()
             return;
         }
 
-        // FIXME: Or LD_BIND_NOW is set?
-        if (m_dynamic_object->must_bind_now()) {
+        // NOTE: Objects linked with `-z now` opt out of lazy binding, as does loading with RTLD_NOW (or LD_BIND_NOW).
+        if (m_dynamic_object->must_bind_now() || !(flags & RTLD_LAZY)) {
             switch (do_plt_relocation(relocation, ShouldCallIfuncResolver::No)) {
             case RelocationResult::Failed:
                 dbgln("Loader.so: {} unresolved symbol '{}'", m_filepath, relocation.symbol().name());
@@ -250,7 +250,8 @@ void DynamicLoader::do_main_relocations()
 
 Result<NonnullRefPtr<DynamicObject>, DlErrorMessage> DynamicLoader::load_stage_3(unsigned flags)
 {
-    if (flags & RTLD_LAZY) {
+    // NOTE: Even without lazy binding, IFUNC resolvers may call other IFUNCs that haven't been bound yet.
+    if ((flags & RTLD_LAZY) || !m_plt_ifunc_relocations.is_empty()) {
         if (m_dynamic_object->has_plt())
             setup_plt_trampoline();
     }
@@ -520,7 +521,7 @@ DynamicLoader::RelocationResult DynamicLoader::do_direct_relocation(DynamicObjec
         // in large inheritance hierarchies are involved, there might be tens of references to
         // the same symbol. We can avoid redundant lookups by keeping track of the previous result.
         if (!cached_result.has_value() || !cached_result.value().symbol.definitely_equals(symbol))
-            cached_result = DynamicLoader::CachedLookupResult { symbol, DynamicLoader::lookup_symbol(symbol) };
+            cached_result = DynamicLoader::CachedLookupResult { symbol, DynamicLoader::lookup_symbol(symbol, UseGlobalSymbolCache::Yes) };
         return cached_result.value().result;
     };
 
@@ -815,10 +816,13 @@ void DynamicLoader::call_object_init_functions()
     }
 }
 
-Optional<DynamicObject::SymbolLookupResult> DynamicLoader::lookup_symbol(const ELF::DynamicObject::Symbol& symbol)
+Optional<DynamicObject::SymbolLookupResult> DynamicLoader::lookup_symbol(const ELF::DynamicObject::Symbol& symbol, UseGlobalSymbolCache use_global_symbol_cache)
 {
-    if (symbol.is_undefined() || symbol.bind() == STB_WEAK)
+    if (symbol.is_undefined() || symbol.bind() == STB_WEAK) {
+        if (use_global_symbol_cache == UseGlobalSymbolCache::Yes)
+            return DynamicLinker::lookup_global_symbol_with_cache(symbol.name());
         return DynamicLinker::lookup_global_symbol(symbol.name());
+    }
 
     return DynamicObject::SymbolLookupResult { symbol.value(), symbol.size(), symbol.address(), symbol.bind(), symbol.type(), &symbol.object() };
 }
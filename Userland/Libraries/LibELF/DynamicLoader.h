@@ -40,6 +40,11 @@ enum class ShouldCallIfuncResolver {
     No
 };
 
+enum class UseGlobalSymbolCache {
+    Yes,
+    No
+};
+
 extern "C" FlatPtr _fixup_plt_entry(DynamicObject* object, u32 relocation_offset);
 
 class DynamicLoader : public RefCounted<DynamicLoader> {
@@ -80,7 +85,7 @@ public:
     Vector<LoadedSegment> const text_segments() const { return m_text_segments; }
     bool is_dynamic() const { return image().is_dynamic(); }
 
-    static Optional<DynamicObject::SymbolLookupResult> lookup_symbol(const ELF::DynamicObject::Symbol&);
+    static Optional<DynamicObject::SymbolLookupResult> lookup_symbol(const ELF::DynamicObject::Symbol&, UseGlobalSymbolCache = UseGlobalSymbolCache::No);
     void copy_initial_tls_data_into(Bytes buffer) const;
 
     DynamicObject& dynamic_object() { return *m_dynamic_object; }
@@ -128,7 +133,7 @@ private:
     void load_program_headers();
 
     // Stage 2
-    void do_main_relocations();
+    void do_main_relocations(unsigned flags);
 
     // Stage 3
     void setup_plt_trampoline();
@@ -193,6 +193,47 @@ static ErrorOr<ByteString> get_duplicate_file_name(StringView path)
     return current_name;
 }
 
+// Returns false if the kernel can't copy between these files, in which case nothing was copied.
+static ErrorOr<bool> copy_file_contents_in_kernel([[maybe_unused]] Core::File& destination, [[maybe_unused]] Core::File& source)
+{
+#if defined(AK_OS_SERENITY) || defined(AK_OS_LINUX)
+    bool copied_anything = false;
+
+    // NOTE: copy_file_range() only works between regular files (and on Linux, only within some file systems),
+    //       but it moves much larger chunks at a time than sendfile() does.
+    while (true) {
+        auto ncopied_or_error = Core::System::copy_file_range(source.fd(), nullptr, destination.fd(), nullptr, NumericLimits<ssize_t>::max());
+        if (ncopied_or_error.is_error()) {
+            auto code = ncopied_or_error.error().code();
+            if (!copied_anything && (code == EINVAL || code == EXDEV || code == ENOSYS || code == EOPNOTSUPP))
+                break;
+            return ncopied_or_error.release_error();
+        }
+        // NOTE: Some file systems claim to be empty here rather than refusing, so let sendfile() have the final say.
+        if (ncopied_or_error.value() == 0) {
+            if (copied_anything)
+                return true;
+            break;
+        }
+        copied_anything = true;
+    }
+
+    while (true) {
+        auto nsent_or_error = Core::System::sendfile(destination.fd(), source.fd(), nullptr, NumericLimits<ssize_t>::max());
+        if (nsent_or_error.is_error()) {
+            if (!copied_anything && nsent_or_error.error().code() == EINVAL)
+                return false;
+            return nsent_or_error.release_error();
+        }
+        if (nsent_or_error.value() == 0)
+            return true;
+        copied_anything = true;
+    }
+#else
+    return false;
+#endif
+}
+
 ErrorOr<void> copy_file(StringView destination_path, StringView source_path, struct stat const& source_stat, Core::File& source, PreserveMode preserve_mode)
 {
     auto destination_or_error = Core::File::open(destination_path, Core::File::OpenMode::Write, 0666);
@@ -205,16 +246,15 @@ ErrorOr<void> copy_file(StringView destination_path, StringView source_path, str
     }
     auto destination = destination_or_error.release_value();
 
-    if (source_stat.st_size > 0)
-        TRY(destination->truncate(source_stat.st_size));
+    if (!TRY(copy_file_contents_in_kernel(*destination, source))) {
+        while (true) {
+            auto bytes_read = TRY(source.read_until_eof());
 
-    while (true) {
-        auto bytes_read = TRY(source.read_until_eof());
-
-        if (bytes_read.is_empty())
-            break;
+            if (bytes_read.is_empty())
+                break;
 
-        TRY(destination->write_until_depleted(bytes_read));
+            TRY(destination->write_until_depleted(bytes_read));
+        }
     }
 
     auto my_umask = umask(0);
@@ -19,6 +19,8 @@
 
 namespace GUI {
 
+static constexpr int max_rows_measured_for_column_sizes = 1000;
+
 AbstractTableView::AbstractTableView()
 {
     REGISTER_BOOL_PROPERTY("column_headers_visible", column_headers_visible, set_column_headers_visible);
@@ -95,6 +97,10 @@ void AbstractTableView::update_column_sizes()
     int column_count = model.column_count();
     int row_count = model.row_count();
 
+    // Every model update ends up here, so for large models we only measure an evenly spaced sample of the rows.
+    // Columns never shrink here, and auto_resize_column() still measures every row when asked to.
+    int row_step = max(1, ceil_div(row_count, max_rows_measured_for_column_sizes));
+
     for (int column = 0; column < column_count; ++column) {
         if (!column_header().is_section_visible(column))
             continue;
@@ -102,7 +108,7 @@ void AbstractTableView::update_column_sizes()
         if (column == m_key_column && model.is_column_sortable(column))
             header_width += HeaderView::sorting_arrow_width + HeaderView::sorting_arrow_offset;
         int column_width = header_width;
-        for (int row = 0; row < row_count; ++row) {
+        for (int row = 0; row < row_count; row += row_step) {
             auto cell_data = model.index(row, column).data();
             int cell_width = 0;
             if (cell_data.is_icon()) {
@@ -12,7 +12,10 @@
 #include <AK/StringBuilder.h>
 #include <AK/Types.h>
 #include <LibCore/DirIterator.h>
+#include <LibCore/Directory.h>
+#include <LibCore/File.h>
 #include <LibCore/StandardPaths.h>
+#include <LibCore/System.h>
 #include <LibFileSystem/FileSystem.h>
 #include <LibGUI/AbstractView.h>
 #include <LibGUI/FileIconProvider.h>
@@ -700,11 +703,93 @@ struct ThumbnailCache {
 static Threading::MutexProtected<ThumbnailCache> s_thumbnail_cache {};
 static Threading::MutexProtected<RefPtr<ImageDecoderClient::Client>> s_image_decoder_client {};
 
+// Thumbnails are also kept on disk, so that opening a directory again (possibly in another application) doesn't have to decode every image again.
+// Entries are named after a hash of the image's path, and record the path, size and modification time of the image they were made from.
+struct [[gnu::packed]] ThumbnailCacheEntryHeader {
+    static constexpr u32 expected_magic = 0x424d4854; // "THMB"
+
+    u32 magic { expected_magic };
+    u32 path_length { 0 };
+    i64 mtime { 0 };
+    u64 size { 0 };
+    i32 width { 0 };
+    i32 height { 0 };
+};
+
+static ByteString thumbnail_cache_entry_path(StringView path)
+{
+    // FNV-1a. Collisions are harmless, since the entry's path has to match as well.
+    u64 hash = 0xcbf29ce484222325;
+    for (auto byte : path.bytes()) {
+        hash ^= byte;
+        hash *= 0x100000001b3;
+    }
+    return ByteString::formatted("{}/thumbnails/{:016x}", Core::StandardPaths::cache_directory(), hash);
+}
+
+static ErrorOr<NonnullRefPtr<Gfx::Bitmap>> load_thumbnail_from_disk(StringView path, struct stat const& st, Gfx::IntSize thumbnail_size)
+{
+    auto file = TRY(Core::File::open(thumbnail_cache_entry_path(path), Core::File::OpenMode::Read));
+    auto contents = TRY(file->read_until_eof());
+
+    ThumbnailCacheEntryHeader header;
+    if (contents.size() < sizeof(header))
+        return Error::from_string_literal("Thumbnail cache entry is truncated");
+    memcpy(&header, contents.data(), sizeof(header));
+    if (header.magic != ThumbnailCacheEntryHeader::expected_magic || header.width != thumbnail_size.width() || header.height != thumbnail_size.height())
+        return Error::from_string_literal("Thumbnail cache entry has an unexpected format");
+
+    size_t row_size = thumbnail_size.width() * sizeof(Gfx::ARGB32);
+    size_t pixels_offset = sizeof(header) + header.path_length;
+    if (contents.size() != pixels_offset + row_size * thumbnail_size.height())
+        return Error::from_string_literal("Thumbnail cache entry is truncated");
+    if (header.mtime != st.st_mtime || header.size != static_cast<u64>(st.st_size) || contents.bytes().slice(sizeof(header), header.path_length) != path.bytes())
+        return Error::from_string_literal("Thumbnail cache entry is stale");
+
+    auto thumbnail = TRY(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, thumbnail_size));
+    for (int y = 0; y < thumbnail_size.height(); ++y)
+        memcpy(thumbnail->scanline_u8(y), contents.data() + pixels_offset + y * row_size, row_size);
+    return thumbnail;
+}
+
+static ErrorOr<void> save_thumbnail_to_disk(StringView path, struct stat const& st, Gfx::Bitmap const& thumbnail)
+{
+    auto entry_path = thumbnail_cache_entry_path(path);
+    TRY(Core::Directory::create(LexicalPath(entry_path).parent(), Core::Directory::CreateDirectories::Yes, 0700));
+
+    ThumbnailCacheEntryHeader header;
+    header.path_length = path.length();
+    header.mtime = st.st_mtime;
+    header.size = st.st_size;
+    header.width = thumbnail.width();
+    header.height = thumbnail.height();
+
+    // Other processes may be reading the same entry, so write it elsewhere and move it into place once it's complete.
+    auto temporary_path = ByteString::formatted("{}.{}", entry_path, getpid());
+    auto write_entry = [&]() -> ErrorOr<void> {
+        auto file = TRY(Core::File::open(temporary_path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate, 0600));
+        TRY(file->write_until_depleted({ &header, sizeof(header) }));
+        TRY(file->write_until_depleted(path.bytes()));
+        for (int y = 0; y < thumbnail.height(); ++y)
+            TRY(file->write_until_depleted({ thumbnail.scanline_u8(y), thumbnail.width() * sizeof(Gfx::ARGB32) }));
+        return {};
+    };
+    if (auto result = write_entry(); result.is_error()) {
+        (void)Core::System::unlink(temporary_path);
+        return result.release_error();
+    }
+    return Core::System::rename(temporary_path, entry_path);
+}
+
 static ErrorOr<NonnullRefPtr<Gfx::Bitmap>> render_thumbnail(StringView path)
 {
     Core::EventLoop event_loop;
     Gfx::IntSize const thumbnail_size { 32, 32 };
 
+    auto st = TRY(Core::System::stat(path));
+    if (auto cached_thumbnail = load_thumbnail_from_disk(path, st, thumbnail_size); !cached_thumbnail.is_error())
+        return cached_thumbnail.release_value();
+
     auto file = TRY(Core::MappedFile::map(path));
     auto decoded_image = TRY(s_image_decoder_client.with_locked([=, &file](auto& maybe_client) -> ErrorOr<Optional<ImageDecoderClient::DecodedImage>> {
         if (!maybe_client) {
@@ -733,6 +818,9 @@ static ErrorOr<NonnullRefPtr<Gfx::Bitmap>> render_thumbnail(StringView path)
 
     Painter painter(thumbnail);
     painter.draw_scaled_bitmap(destination, *bitmap, bitmap->rect(), 1.f, Painter::ScalingMode::BoxSampling);
+
+    if (auto result = save_thumbnail_to_disk(path, st, thumbnail); result.is_error())
+        dbgln("Failed to cache thumbnail for {}: {}", path, result.error());
     return thumbnail;
 }
 
@@ -38,7 +38,8 @@ public:
 
     virtual bool is_column_sortable(int column_index) const override;
 
-    virtual bool less_than(ModelIndex const&, ModelIndex const&) const;
+    // The value rows are sorted by, compared with operator<. It is computed once per row for each sort.
+    virtual Variant sort_key(ModelIndex const&) const;
 
     ModelIndex map_to_source(ModelIndex const&) const;
     ModelIndex map_to_proxy(ModelIndex const&) const;
@@ -2084,6 +2084,12 @@ void TextEditor::recompute_all_visual_lines()
     update_content_size();
 }
 
+void TextEditor::invalidate_all_visual_lines()
+{
+    for (auto& line_data : m_line_data)
+        line_data->line_version = 0;
+}
+
 void TextEditor::ensure_cursor_is_valid()
 {
     auto new_cursor = m_cursor;
@@ -2113,7 +2119,6 @@ void TextEditor::recompute_visual_lines(size_t line_index, Vector<TextDocumentFo
     size_t line_width_so_far = 0;
 
     auto& visual_data = m_line_data[line_index];
-    visual_data->visual_lines.clear_with_capacity();
 
     auto available_width = visible_text_rect_in_inner_coordinates().width();
     auto glyph_spacing = font().glyph_spacing();
@@ -2131,6 +2136,18 @@ void TextEditor::recompute_visual_lines(size_t line_index, Vector<TextDocumentFo
         }
     }
 
+    // Wrapping and measuring a line is what makes this expensive, and most lines don't change between reflows.
+    if (visual_data->line_version == line.version()
+        && visual_data->line_code_points == line.code_points()
+        && visual_data->available_width == available_width
+        && visual_data->wrapping_mode == wrapping_mode()
+        && visual_data->is_visible == line_is_visible) {
+        visual_data->visual_rect = { m_horizontal_content_padding, 0, visual_data->content_width, static_cast<int>(visual_data->visual_lines.size()) * line_height() };
+        return;
+    }
+
+    visual_data->visual_lines.clear_with_capacity();
+
     auto wrap_visual_lines_anywhere = [&]() {
         size_t start_of_visual_line = 0;
         for (auto it = line.view().begin(); it != line.view().end(); ++it) {
@@ -2190,8 +2207,13 @@ void TextEditor::recompute_visual_lines(size_t line_index, Vector<TextDocumentFo
         }
     }
 
-    auto line_width = is_wrapping_enabled() ? available_width : text_width_for_font(line.view(), font());
-    visual_data->visual_rect = { m_horizontal_content_padding, 0, line_width, static_cast<int>(visual_data->visual_lines.size()) * line_height() };
+    visual_data->line_version = line.version();
+    visual_data->line_code_points = line.code_points();
+    visual_data->available_width = available_width;
+    visual_data->wrapping_mode = wrapping_mode();
+    visual_data->is_visible = line_is_visible;
+    visual_data->content_width = is_wrapping_enabled() ? available_width : text_width_for_font(line.view(), font());
+    visual_data->visual_rect = { m_horizontal_content_padding, 0, visual_data->content_width, static_cast<int>(visual_data->visual_lines.size()) * line_height() };
 }
 
 template<typename Callback>
@@ -2244,6 +2266,7 @@ void TextEditor::add_custom_context_menu_action(Action& action)
 void TextEditor::did_change_font()
 {
     vertical_scrollbar().set_step(line_height());
+    invalidate_all_visual_lines();
     recompute_all_visual_lines();
     update();
     AbstractScrollableWidget::did_change_font();
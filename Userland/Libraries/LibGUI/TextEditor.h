@@ -369,6 +369,7 @@ private:
     Gfx::IntRect folding_indicator_rect_in_inner_coordinates() const;
     Gfx::IntRect visible_text_rect_in_inner_coordinates() const;
     void recompute_all_visual_lines();
+    void invalidate_all_visual_lines();
     void ensure_cursor_is_valid();
     void rehighlight_if_needed();
 
@@ -450,6 +451,14 @@ private:
         Vector<Utf32View> visual_lines;
         Gfx::IntRect visual_rect;
         u32 gutter_indicators { 0 }; // A bitfield of which gutter indicators are present. (1 << GutterIndicatorID)
+
+        // What visual_lines and content_width were computed for, so lines that didn't change don't have to be measured again.
+        u64 line_version { 0 };
+        u32 const* line_code_points { nullptr };
+        int available_width { 0 };
+        WrappingMode wrapping_mode { WrappingMode::NoWrap };
+        bool is_visible { false };
+        int content_width { 0 };
     };
 
     Vector<NonnullOwnPtr<LineData>> m_line_data;
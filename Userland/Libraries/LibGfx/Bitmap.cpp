@@ -24,6 +24,7 @@
 #include <LibGfx/ShareableBitmap.h>
 #include <errno.h>
 #include <stdio.h>
+#include <sys/mman.h>
 
 namespace Gfx {
 
@@ -139,6 +140,8 @@ ErrorOr<NonnullRefPtr<Bitmap>> Bitmap::load_from_file(StringView path, int scale
 ErrorOr<NonnullRefPtr<Bitmap>> Bitmap::load_from_file(NonnullOwnPtr<Core::File> file, StringView path, Optional<IntSize> ideal_size)
 {
     auto mapped_file = TRY(Core::MappedFile::map_from_file(move(file), path));
+    // We're about to decode the whole file, so start reading it in right away.
+    (void)mapped_file->advise(MADV_WILLNEED);
     auto mime_type = Core::guess_mime_type_based_on_filename(path);
     return load_from_bytes(mapped_file->bytes(), ideal_size, mime_type);
 }
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Platform.h>
+#include <AK/SIMD.h>
+#include <LibGfx/Color.h>
+
+// Vectors wider than what the baseline target supports are only ever used inside of functions that enable AVX2.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+namespace Gfx::Detail {
+
+// These blend rows of BGRA8888 pixels over a BGRx8888 or BGRA8888 destination, with the exact same results as Color::blend().
+// Without an alpha channel in the destination, every destination pixel counts as opaque, and the division by the
+// resulting alpha becomes a division by 255. Otherwise, the division is done in floating point and then corrected,
+// which makes it exact as all of the intermediate values fit into 25 bits.
+template<typename U32, typename I32, typename F32, bool destination_has_alpha>
+ALWAYS_INLINE U32 blend_pixels(U32 destination, U32 source)
+{
+    auto divide_by_255 = [](U32 value) { return (value + 1 + (value >> 8)) >> 8; };
+
+    U32 source_alpha = source >> 24;
+    U32 inverse_source_alpha = 255 - source_alpha;
+
+    U32 blended;
+    if constexpr (destination_has_alpha) {
+        U32 destination_alpha = destination >> 24;
+        U32 divisor = 255 * (destination_alpha + source_alpha) - destination_alpha * source_alpha;
+        // Pixels where both alphas are zero are never taken from the blended result.
+        F32 reciprocal = 1.0f / __builtin_convertvector(divisor | (U32)(divisor == 0), F32);
+        U32 destination_weight = destination_alpha * inverse_source_alpha;
+        U32 source_weight = 255 * source_alpha;
+
+        auto blend_channel = [&](int shift) {
+            U32 numerator = ((destination >> shift) & 0xff) * destination_weight + ((source >> shift) & 0xff) * source_weight;
+            U32 quotient = (U32)__builtin_convertvector(__builtin_convertvector(numerator, F32) * reciprocal, I32);
+            quotient += (U32)(quotient * divisor > numerator);
+            quotient -= (U32)((quotient + 1) * divisor <= numerator);
+            return quotient << shift;
+        };
+
+        blended = blend_channel(0) | blend_channel(8) | blend_channel(16) | (divide_by_255(divisor) << 24);
+    } else {
+        destination |= 0xff000000;
+
+        auto blend_channel = [&](int shift) {
+            return divide_by_255(((destination >> shift) & 0xff) * inverse_source_alpha + ((source >> shift) & 0xff) * source_alpha) << shift;
+        };
+
+        blended = blend_channel(0) | blend_channel(8) | blend_channel(16) | 0xff000000;
+    }
+
+    U32 result = source_alpha == 0 ? destination : blended;
+    result = source_alpha == 255 ? source : result;
+    if constexpr (destination_has_alpha)
+        result = (destination >> 24) == 0 ? source : result;
+    return result;
+}
+
+template<typename U32, typename I32, typename F32, bool destination_has_alpha, bool source_is_constant>
+ALWAYS_INLINE void blend_row_with_vectors(ARGB32* destination, ARGB32 const* source, size_t count)
+{
+    constexpr size_t lanes = sizeof(U32) / sizeof(u32);
+
+    auto load = [](ARGB32 const* pixels) {
+        U32 vector;
+        __builtin_memcpy(&vector, pixels, sizeof(vector));
+        return vector;
+    };
+
+    U32 constant_source = U32 {} + (source_is_constant ? source[0] : 0);
+    size_t i = 0;
+    for (; i + lanes <= count; i += lanes) {
+        U32 source_pixels = source_is_constant ? constant_source : load(source + i);
+        U32 source_alpha = source_pixels >> 24;
+
+        // Fully transparent and fully opaque runs of pixels are common enough in bitmaps to skip the arithmetic.
+        bool all_transparent = true;
+        bool all_opaque = true;
+        for (size_t lane = 0; lane < lanes; ++lane) {
+            all_transparent &= source_alpha[lane] == 0;
+            all_opaque &= source_alpha[lane] == 255;
+        }
+
+        U32 result;
+        if (all_opaque) {
+            result = source_pixels;
+        } else if (all_transparent) {
+            U32 destination_pixels = load(destination + i);
+            if constexpr (destination_has_alpha)
+                result = (destination_pixels >> 24) == 0 ? source_pixels : destination_pixels;
+            else
+                result = destination_pixels | 0xff000000;
+        } else {
+            result = blend_pixels<U32, I32, F32, destination_has_alpha>(load(destination + i), source_pixels);
+        }
+        __builtin_memcpy(destination + i, &result, sizeof(result));
+    }
+
+    for (; i < count; ++i) {
+        auto destination_color = destination_has_alpha ? Color::from_argb(destination[i]) : Color::from_rgb(destination[i]);
+        destination[i] = destination_color.blend(Color::from_argb(source[source_is_constant ? 0 : i])).value();
+    }
+}
+
+#if ARCH(X86_64)
+inline bool const s_has_avx2 = __builtin_cpu_supports("avx2");
+
+template<bool destination_has_alpha, bool source_is_constant>
+[[gnu::target("avx2")]] inline void blend_row_with_avx2(ARGB32* destination, ARGB32 const* source, size_t count)
+{
+    blend_row_with_vectors<AK::SIMD::u32x8, AK::SIMD::i32x8, AK::SIMD::f32x8, destination_has_alpha, source_is_constant>(destination, source, count);
+}
+#endif
+
+// If source_is_constant is set, source points to a single pixel that is blended over the whole row.
+template<bool destination_has_alpha, bool source_is_constant = false>
+inline void blend_row(ARGB32* destination, ARGB32 const* source, size_t count)
+{
+#if ARCH(X86_64)
+    if (s_has_avx2)
+        return blend_row_with_avx2<destination_has_alpha, source_is_constant>(destination, source, count);
+#endif
+    blend_row_with_vectors<AK::SIMD::u32x4, AK::SIMD::i32x4, AK::SIMD::f32x4, destination_has_alpha, source_is_constant>(destination, source, count);
+}
+
+}
+
+#pragma GCC diagnostic pop
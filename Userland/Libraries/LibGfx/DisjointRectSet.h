@@ -240,6 +240,45 @@ public:
             rect.translate_by(delta);
     }
 
+    // Reduces the number of rects, for consumers where every rect has a fixed cost on top of its area.
+    // Rects sharing a whole edge are always merged. If the remaining rects waste at most
+    // `cost_per_rect` of area each when replaced by their bounding rect, they are replaced by it.
+    // The set stays disjoint and keeps covering everything it did, but may cover more afterwards.
+    void coalesce(T cost_per_rect)
+    {
+        bool pass_had_merges = false;
+        do {
+            pass_had_merges = false;
+            for (size_t i = 0; i < m_rects.size(); ++i) {
+                for (size_t j = i + 1; j < m_rects.size(); ++j) {
+                    auto& r1 = m_rects[i];
+                    auto& r2 = m_rects[j];
+                    bool share_vertical_edge = r1.top() == r2.top() && r1.bottom() == r2.bottom() && (r1.right() == r2.left() || r2.right() == r1.left());
+                    bool share_horizontal_edge = r1.left() == r2.left() && r1.right() == r2.right() && (r1.bottom() == r2.top() || r2.bottom() == r1.top());
+                    if (!share_vertical_edge && !share_horizontal_edge)
+                        continue;
+                    r1 = r1.united(r2);
+                    m_rects.remove(j--);
+                    pass_had_merges = true;
+                }
+            }
+        } while (pass_had_merges);
+
+        if (m_rects.size() < 2)
+            return;
+
+        Rect<T> bounding_rect;
+        T covered_area = 0;
+        for (auto& rect : m_rects) {
+            bounding_rect = bounding_rect.united(rect);
+            covered_area += rect.size().area();
+        }
+        if (bounding_rect.size().area() - covered_area > cost_per_rect * static_cast<T>(m_rects.size() - 1))
+            return;
+        m_rects.clear_with_capacity();
+        m_rects.append(bounding_rect);
+    }
+
 private:
     bool add_no_shatter(Rect<T> const& new_rect)
     {
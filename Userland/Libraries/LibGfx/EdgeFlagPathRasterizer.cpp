@@ -9,6 +9,7 @@
 #include <AK/IntegralMath.h>
 #include <AK/Types.h>
 #include <LibGfx/AntiAliasingPainter.h>
+#include <LibGfx/BlendRow.h>
 #include <LibGfx/EdgeFlagPathRasterizer.h>
 
 #if defined(AK_COMPILER_GCC)
@@ -140,6 +141,7 @@ void EdgeFlagPathRasterizer<SamplesPerPixel>::fill_internal(Painter& painter, Pa
         return;
 
     m_scanline.resize(scanline_length);
+    m_run_colors.resize(scanline_length);
 
     if (m_clip.is_empty())
         return;
@@ -326,19 +328,11 @@ auto EdgeFlagPathRasterizer<SamplesPerPixel>::accumulate_non_zero_scanline(EdgeE
     VERIFY(edge_extent.min_x >= 0);
     VERIFY(edge_extent.max_x < static_cast<int>(m_scanline.size()));
     for (int x = edge_extent.min_x; x <= edge_extent.max_x; x += 1) {
-        if (auto edges = m_scanline.data()[x]) {
-            // We only need to process the windings when we hit some edges.
-            for (auto y_sub = 0u; y_sub < SamplesPerPixel; y_sub++) {
-                auto subpixel_bit = 1 << y_sub;
-                if (edges & subpixel_bit) {
-                    auto winding = m_windings.data()[x].counts[y_sub];
-                    auto previous_winding_count = acc.winding.counts[y_sub];
-                    acc.winding.counts[y_sub] += winding;
-                    // Toggle fill on change to/from zero.
-                    if (bool(previous_winding_count) ^ bool(acc.winding.counts[y_sub]))
-                        acc.sample ^= subpixel_bit;
-                }
-            }
+        if (m_scanline.data()[x]) {
+            // We only need to process the windings when we hit some edges. The windings of subpixels without
+            // edges are zero, so all of the counts can be updated at once, and a subpixel is filled when its count isn't zero.
+            acc.winding.add(m_windings.data()[x]);
+            acc.sample = acc.winding.non_zero_samples();
         }
         sample_callback(x, acc.sample);
         m_scanline.data()[x] = 0;
@@ -357,25 +351,6 @@ auto EdgeFlagPathRasterizer<SamplesPerPixel>::accumulate_scanline(EdgeExtent edg
         return accumulate_non_zero_scanline(edge_extent, init, callback);
 }
 
-template<unsigned SamplesPerPixel>
-void EdgeFlagPathRasterizer<SamplesPerPixel>::write_pixel(BitmapFormat format, ARGB32* scanline_ptr, int scanline, int offset, SampleType sample, auto& color_or_function)
-{
-    if (!sample)
-        return;
-    auto dest_x = offset + m_blit_origin.x();
-    auto coverage = SubpixelSample::compute_coverage(sample);
-    auto paint_color = scanline_color(scanline, offset, coverage_to_alpha(coverage), color_or_function);
-    scanline_ptr[dest_x] = color_for_format(format, scanline_ptr[dest_x]).blend(paint_color).value();
-}
-
-template<unsigned SamplesPerPixel>
-void EdgeFlagPathRasterizer<SamplesPerPixel>::fast_fill_solid_color_span(ARGB32* scanline_ptr, int start, int end, Color color)
-{
-    auto start_x = start + m_blit_origin.x();
-    auto end_x = end + m_blit_origin.x();
-    fast_u32_fill(scanline_ptr + start_x, color.value(), end_x - start_x + 1);
-}
-
 template<unsigned SamplesPerPixel>
 template<Painter::WindingRule WindingRule>
 FLATTEN __attribute__((hot)) void EdgeFlagPathRasterizer<SamplesPerPixel>::write_scanline(Painter& painter, int scanline, EdgeExtent edge_extent, auto& color_or_function)
@@ -398,39 +373,60 @@ FLATTEN __attribute__((hot)) void EdgeFlagPathRasterizer<SamplesPerPixel>::write
 
     // Get pointer to current scanline pixels.
     auto dest_format = painter.target()->format();
-    auto dest_ptr = painter.target()->scanline(scanline + m_blit_origin.y());
+    auto dest_ptr = painter.target()->scanline(scanline + m_blit_origin.y()) + m_blit_origin.x();
+
+    // Pixels are written in runs: Either spans of solid color that are set via a fast_u32_fill(), or spans of
+    // covered pixels that are blended into the scanline all at once.
+    int run_start = 0;
+    int run_length = 0;
+    auto flush_run = [&](Optional<Color> solid_color) {
+        if (run_length == 0)
+            return;
+        if (solid_color.has_value())
+            fast_u32_fill(dest_ptr + run_start, solid_color->value(), run_length);
+        else if (dest_format == BitmapFormat::BGRA8888)
+            Detail::blend_row<true>(dest_ptr + run_start, m_run_colors.data(), run_length);
+        else
+            Detail::blend_row<false>(dest_ptr + run_start, m_run_colors.data(), run_length);
+        run_length = 0;
+    };
 
-    // Simple case: Handle each pixel individually.
+    // Simple case: Collect each covered pixel into a run.
     // Used for PaintStyle fills and semi-transparent colors.
-    auto write_scanline_pixelwise = [&](auto& color_or_function) {
+    auto write_scanline_blended = [&](auto& color_or_function) {
         accumulate_scanline<WindingRule>(clipped_extent, acc, [&](int x, SampleType sample) {
-            write_pixel(dest_format, dest_ptr, scanline, x, sample, color_or_function);
+            if (!sample)
+                return flush_run({});
+            if (run_length == 0)
+                run_start = x;
+            auto alpha = coverage_to_alpha(SubpixelSample::compute_coverage(sample));
+            m_run_colors.data()[run_length++] = scanline_color(scanline, x, alpha, color_or_function).value();
         });
+        flush_run({});
     };
-    // Fast fill case: Track spans of solid color and set the entire span via a fast_u32_fill().
+    // Fast fill case: Track spans of solid color, and blend the partially covered pixels in between individually.
     // Used for opaque colors (i.e. alpha == 255).
     auto write_scanline_with_fast_fills = [&](Color color) {
         if (color.alpha() != 255)
-            return write_scanline_pixelwise(color);
+            return write_scanline_blended(color);
         constexpr SampleType full_converage = NumericLimits<SampleType>::max();
-        int full_converage_count = 0;
         accumulate_scanline<WindingRule>(clipped_extent, acc, [&](int x, SampleType sample) {
             if (sample == full_converage) {
-                full_converage_count++;
+                if (run_length == 0)
+                    run_start = x;
+                run_length++;
                 return;
-            } else {
-                write_pixel(dest_format, dest_ptr, scanline, x, sample, color);
             }
-            if (full_converage_count > 0) {
-                fast_fill_solid_color_span(dest_ptr, x - full_converage_count, x - 1, color);
-                full_converage_count = 0;
+            flush_run(color);
+            if (sample) {
+                auto paint_color = color.with_alpha(coverage_to_alpha(SubpixelSample::compute_coverage(sample)));
+                dest_ptr[x] = color_for_format(dest_format, dest_ptr[x]).blend(paint_color).value();
             }
         });
-        if (full_converage_count > 0)
-            fast_fill_solid_color_span(dest_ptr, clipped_extent.max_x - full_converage_count + 1, clipped_extent.max_x, color);
+        flush_run(color);
     };
     switch_on_color_or_function(
-        color_or_function, write_scanline_with_fast_fills, write_scanline_pixelwise);
+        color_or_function, write_scanline_with_fast_fills, write_scanline_blended);
 }
 
 static IntSize path_bounds(Gfx::Path const& path)
@@ -178,8 +178,6 @@ private:
     template<Painter::WindingRule>
     FLATTEN void write_scanline(Painter&, int scanline, EdgeExtent, auto& color_or_function);
     Color scanline_color(int scanline, int offset, u8 alpha, auto& color_or_function);
-    void write_pixel(BitmapFormat format, ARGB32* scanline_ptr, int scanline, int offset, SampleType sample, auto& color_or_function);
-    void fast_fill_solid_color_span(ARGB32* scanline_ptr, int start, int end, Color color);
 
     template<Painter::WindingRule, typename Callback>
     auto accumulate_scanline(EdgeExtent, auto, Callback);
@@ -189,6 +187,33 @@ private:
     struct WindingCounts {
         // NOTE: This only allows up to 256 winding levels. Increase this if required (i.e. to an i16).
         i8 counts[SamplesPerPixel];
+
+        // These work on eight counts at a time, packed into a u64, and never carry from one count into the next.
+        ALWAYS_INLINE void add(WindingCounts const& other)
+        {
+            constexpr u64 low_bits = 0x7f7f7f7f7f7f7f7f;
+            for (size_t i = 0; i < SamplesPerPixel; i += sizeof(u64)) {
+                u64 a, b;
+                __builtin_memcpy(&a, counts + i, sizeof(u64));
+                __builtin_memcpy(&b, other.counts + i, sizeof(u64));
+                u64 sum = ((a & low_bits) + (b & low_bits)) ^ ((a ^ b) & ~low_bits);
+                __builtin_memcpy(counts + i, &sum, sizeof(u64));
+            }
+        }
+
+        ALWAYS_INLINE SampleType non_zero_samples() const
+        {
+            constexpr u64 low_bits = 0x7f7f7f7f7f7f7f7f;
+            SampleType samples = 0;
+            for (size_t i = 0; i < SamplesPerPixel; i += sizeof(u64)) {
+                u64 word;
+                __builtin_memcpy(&word, counts + i, sizeof(u64));
+                // The top bit of every byte is set if the count isn't zero, then those bits get gathered into the top byte.
+                u64 non_zero = ((((word & low_bits) + low_bits) | word) & ~low_bits) >> 7;
+                samples |= static_cast<SampleType>((non_zero * 0x0102040810204080) >> 56) << i;
+            }
+            return samples;
+        }
     };
 
     struct NonZeroAcc {
@@ -211,6 +236,7 @@ private:
 
     Vector<SampleType> m_scanline;
     Vector<WindingCounts> m_windings;
+    Vector<ARGB32> m_run_colors;
 
     class EdgeTable {
     public:
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGfx/Font/GlyphBitmapCache.h>
+
+namespace Gfx {
+
+GlyphBitmapCache& GlyphBitmapCache::the()
+{
+    // Scaled fonts remove their glyphs from the cache when they are destroyed, which can happen during static destruction.
+    static GlyphBitmapCache* s_the = new GlyphBitmapCache;
+    return *s_the;
+}
+
+GlyphBitmapCache::~GlyphBitmapCache()
+{
+    while (!m_entries_by_use.is_empty())
+        remove(*m_entries_by_use.first());
+}
+
+Optional<RefPtr<Bitmap>> GlyphBitmapCache::get(ScaledFont const& font, GlyphIndexWithSubpixelOffset index)
+{
+    auto it = m_entries.find({ &font, index });
+    if (it == m_entries.end())
+        return {};
+
+    auto& entry = *it->value;
+    if (m_entries_by_use.first() != &entry)
+        m_entries_by_use.prepend(entry);
+    return entry.bitmap;
+}
+
+void GlyphBitmapCache::set(ScaledFont const& font, GlyphIndexWithSubpixelOffset index, RefPtr<Bitmap> bitmap)
+{
+    Key key { &font, index };
+    if (auto it = m_entries.find(key); it != m_entries.end())
+        remove(*it->value);
+
+    // Glyphs without a bitmap, like spaces, are counted as well, so that the number of entries stays bounded too.
+    auto size_in_bytes = sizeof(Entry) + (bitmap ? bitmap->size_in_bytes() : 0);
+    while (m_size_in_bytes + size_in_bytes > m_budget_in_bytes && !m_entries_by_use.is_empty())
+        remove(*m_entries_by_use.last());
+
+    auto entry = make<Entry>(key, move(bitmap), size_in_bytes);
+    m_entries_by_use.prepend(*entry);
+    m_size_in_bytes += size_in_bytes;
+    m_entries.set(key, move(entry));
+}
+
+void GlyphBitmapCache::remove_all_glyphs_of(ScaledFont const& font)
+{
+    for (auto it = m_entries_by_use.begin(); it != m_entries_by_use.end();) {
+        auto& entry = *it;
+        ++it;
+        if (entry.key.font == &font)
+            remove(entry);
+    }
+}
+
+void GlyphBitmapCache::remove(Entry& entry)
+{
+    auto key = entry.key;
+    m_entries_by_use.remove(entry);
+    m_size_in_bytes -= entry.size_in_bytes;
+    m_entries.remove(key);
+}
+
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/IntrusiveList.h>
+#include <AK/NonnullOwnPtr.h>
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/Font/ScaledFont.h>
+
+namespace Gfx {
+
+// Rasterized glyphs of all scaled fonts share one budget, so that text in many different sizes doesn't end up holding
+// on to every glyph that was ever painted. Once the budget is used up, the least recently used glyphs are evicted first.
+class GlyphBitmapCache {
+public:
+    static constexpr size_t default_budget_in_bytes = 32 * MiB;
+
+    static GlyphBitmapCache& the();
+
+    explicit GlyphBitmapCache(size_t budget_in_bytes = default_budget_in_bytes)
+        : m_budget_in_bytes(budget_in_bytes)
+    {
+    }
+    ~GlyphBitmapCache();
+
+    Optional<RefPtr<Bitmap>> get(ScaledFont const&, GlyphIndexWithSubpixelOffset);
+    void set(ScaledFont const&, GlyphIndexWithSubpixelOffset, RefPtr<Bitmap>);
+    void remove_all_glyphs_of(ScaledFont const&);
+
+    size_t size_in_bytes() const { return m_size_in_bytes; }
+    size_t glyph_count() const { return m_entries.size(); }
+
+private:
+    struct Key {
+        ScaledFont const* font { nullptr };
+        GlyphIndexWithSubpixelOffset index;
+
+        bool operator==(Key const&) const = default;
+    };
+
+    struct KeyTraits : public DefaultTraits<Key> {
+        static unsigned hash(Key const& key) { return pair_int_hash(ptr_hash(key.font), Traits<GlyphIndexWithSubpixelOffset>::hash(key.index)); }
+    };
+
+    struct Entry {
+        Entry(Key key, RefPtr<Bitmap> bitmap, size_t size_in_bytes)
+            : key(key)
+            , bitmap(move(bitmap))
+            , size_in_bytes(size_in_bytes)
+        {
+        }
+
+        Key key;
+        RefPtr<Bitmap> bitmap;
+        size_t size_in_bytes { 0 };
+        IntrusiveListNode<Entry> list_node;
+
+        using List = IntrusiveList<&Entry::list_node>;
+    };
+
+    void remove(Entry&);
+
+    size_t m_budget_in_bytes { 0 };
+    size_t m_size_in_bytes { 0 };
+    HashMap<Key, NonnullOwnPtr<Entry>, KeyTraits> m_entries;
+
+    // Ordered from the most to the least recently used entry.
+    Entry::List m_entries_by_use;
+};
+
+}
@@ -7,6 +7,7 @@
 #include <AK/Utf32View.h>
 #include <AK/Utf8View.h>
 #include <LibGfx/Font/Emoji.h>
+#include <LibGfx/Font/GlyphBitmapCache.h>
 #include <LibGfx/Font/ScaledFont.h>
 
 namespace Gfx {
@@ -36,6 +37,11 @@ ScaledFont::ScaledFont(NonnullRefPtr<VectorFont> font, float point_width, float
     };
 }
 
+ScaledFont::~ScaledFont()
+{
+    GlyphBitmapCache::the().remove_all_glyphs_of(*this);
+}
+
 int ScaledFont::width_rounded_up(StringView view) const
 {
     return static_cast<int>(ceilf(width(view)));
@@ -74,15 +80,26 @@ ALWAYS_INLINE float ScaledFont::unicode_view_width(T const& view) const
 RefPtr<Gfx::Bitmap> ScaledFont::rasterize_glyph(u32 glyph_id, GlyphSubpixelOffset subpixel_offset) const
 {
     GlyphIndexWithSubpixelOffset index { glyph_id, subpixel_offset };
-    auto glyph_iterator = m_cached_glyph_bitmaps.find(index);
-    if (glyph_iterator != m_cached_glyph_bitmaps.end())
-        return glyph_iterator->value;
+    auto& cache = GlyphBitmapCache::the();
+    if (auto glyph_bitmap = cache.get(*this, index); glyph_bitmap.has_value())
+        return glyph_bitmap.release_value();
 
     auto glyph_bitmap = m_font->rasterize_glyph(glyph_id, m_x_scale, m_y_scale, subpixel_offset);
-    m_cached_glyph_bitmaps.set(index, glyph_bitmap);
+    cache.set(*this, index, glyph_bitmap);
     return glyph_bitmap;
 }
 
+ScaledGlyphMetrics ScaledFont::glyph_metrics(u32 glyph_id) const
+{
+    // Looking these up involves parsing the glyph's outline header, and painting a glyph needs them more than once.
+    if (auto it = m_cached_glyph_metrics.find(glyph_id); it != m_cached_glyph_metrics.end())
+        return it->value;
+
+    auto metrics = m_font->glyph_metrics(glyph_id, m_x_scale, m_y_scale, m_point_width, m_point_height);
+    m_cached_glyph_metrics.set(glyph_id, metrics);
+    return metrics;
+}
+
 bool ScaledFont::append_glyph_path_to(Gfx::Path& path, u32 glyph_id) const
 {
     auto glyph_iterator = m_glyph_cache.find(glyph_id);
@@ -1655,6 +1655,17 @@ MatrixMatrixConversion::MatrixMatrixConversion(LutCurveType source_red_TRC,
     check(m_destination_red_TRC);
     check(m_destination_green_TRC);
     check(m_destination_blue_TRC);
+
+    LutCurveType const* source_curves[] = { &m_source_red_TRC, &m_source_green_TRC, &m_source_blue_TRC };
+    LutCurveType const* destination_curves[] = { &m_destination_red_TRC, &m_destination_green_TRC, &m_destination_blue_TRC };
+    for (size_t channel = 0; channel < 3; ++channel) {
+        for (size_t i = 0; i < 256; ++i)
+            m_source_curve_lookup_tables[channel][i] = evaluate_curve(*source_curves[channel], i / 255.0f);
+
+        // round(255 * inverse(linear)) exceeds i exactly when linear reaches curve((i + 0.5) / 255), as the curves are non-decreasing.
+        for (size_t i = 0; i < 255; ++i)
+            m_destination_rounding_thresholds[channel][i] = evaluate_curve(*destination_curves[channel], (i + 0.5f) / 255.0f);
+    }
 }
 
 Optional<MatrixMatrixConversion> Profile::matrix_matrix_conversion(Profile const& source_profile) const
@@ -1697,9 +1708,9 @@ Optional<MatrixMatrixConversion> Profile::matrix_matrix_conversion(Profile const
 ErrorOr<void> Profile::convert_image_matrix_matrix(Gfx::Bitmap& bitmap, MatrixMatrixConversion const& map) const
 {
     for (auto& pixel : bitmap) {
-        FloatVector3 rgb { (float)Color::from_argb(pixel).red(), (float)Color::from_argb(pixel).green(), (float)Color::from_argb(pixel).blue() };
-        auto out = map.map(rgb / 255.0f);
-        out.set_alpha(Color::from_argb(pixel).alpha());
+        auto color = Color::from_argb(pixel);
+        auto out = map.map(color.red(), color.green(), color.blue());
+        out.set_alpha(color.alpha());
         pixel = out.value();
     }
     return {};
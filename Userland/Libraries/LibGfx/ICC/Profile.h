@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/Error.h>
 #include <AK/Format.h>
 #include <AK/HashMap.h>
@@ -178,7 +179,19 @@ public:
 
     Color map(FloatVector3) const;
 
+    // Faster version of map() for 8-bit input, using lookup tables for the source curves.
+    Color map(u8 red, u8 green, u8 blue) const;
+
 private:
+    static float evaluate_curve(TagData const& trc, float f)
+    {
+        if (trc.type() == CurveTagData::Type)
+            return static_cast<CurveTagData const&>(trc).evaluate(f);
+        return static_cast<ParametricCurveTagData const&>(trc).evaluate(f);
+    }
+
+    Color map_linear(FloatVector3 linear_rgb) const;
+
     LutCurveType m_source_red_TRC;
     LutCurveType m_source_green_TRC;
     LutCurveType m_source_blue_TRC;
@@ -186,37 +199,56 @@ private:
     LutCurveType m_destination_red_TRC;
     LutCurveType m_destination_green_TRC;
     LutCurveType m_destination_blue_TRC;
+
+    // The source curves, evaluated at every 8-bit input value.
+    Array<Array<float, 256>, 3> m_source_curve_lookup_tables;
+
+    // Instead of evaluating the inverse of the destination curves for every pixel, we precompute the linear value at
+    // which the rounded 8-bit output steps from i to i + 1, and binary search for the output value in those.
+    Array<Array<float, 255>, 3> m_destination_rounding_thresholds;
 };
 
 inline Color MatrixMatrixConversion::map(FloatVector3 in_rgb) const
 {
-    auto evaluate_curve = [](TagData const& trc, float f) {
-        if (trc.type() == CurveTagData::Type)
-            return static_cast<CurveTagData const&>(trc).evaluate(f);
-        return static_cast<ParametricCurveTagData const&>(trc).evaluate(f);
-    };
-
-    auto evaluate_curve_inverse = [](TagData const& trc, float f) {
-        if (trc.type() == CurveTagData::Type)
-            return static_cast<CurveTagData const&>(trc).evaluate_inverse(f);
-        return static_cast<ParametricCurveTagData const&>(trc).evaluate_inverse(f);
-    };
-
     FloatVector3 linear_rgb = {
         evaluate_curve(m_source_red_TRC, in_rgb[0]),
         evaluate_curve(m_source_green_TRC, in_rgb[1]),
         evaluate_curve(m_source_blue_TRC, in_rgb[2]),
     };
-    linear_rgb = m_matrix * linear_rgb;
+    return map_linear(linear_rgb);
+}
+
+inline Color MatrixMatrixConversion::map(u8 red, u8 green, u8 blue) const
+{
+    FloatVector3 linear_rgb = {
+        m_source_curve_lookup_tables[0][red],
+        m_source_curve_lookup_tables[1][green],
+        m_source_curve_lookup_tables[2][blue],
+    };
+    return map_linear(linear_rgb);
+}
 
+inline Color MatrixMatrixConversion::map_linear(FloatVector3 linear_rgb) const
+{
+    linear_rgb = m_matrix * linear_rgb;
     linear_rgb.clamp(0.f, 1.f);
-    float device_r = evaluate_curve_inverse(m_destination_red_TRC, linear_rgb[0]);
-    float device_g = evaluate_curve_inverse(m_destination_green_TRC, linear_rgb[1]);
-    float device_b = evaluate_curve_inverse(m_destination_blue_TRC, linear_rgb[2]);
 
-    u8 out_r = round(255 * device_r);
-    u8 out_g = round(255 * device_g);
-    u8 out_b = round(255 * device_b);
+    auto device_value = [](Array<float, 255> const& thresholds, float linear) -> u8 {
+        size_t low = 0;
+        size_t high = thresholds.size();
+        while (low < high) {
+            size_t middle = (low + high) / 2;
+            if (thresholds[middle] <= linear)
+                low = middle + 1;
+            else
+                high = middle;
+        }
+        return low;
+    };
+
+    u8 out_r = device_value(m_destination_rounding_thresholds[0], linear_rgb[0]);
+    u8 out_g = device_value(m_destination_rounding_thresholds[1], linear_rgb[1]);
+    u8 out_b = device_value(m_destination_rounding_thresholds[2], linear_rgb[2]);
 
     return Color(out_r, out_g, out_b);
 }
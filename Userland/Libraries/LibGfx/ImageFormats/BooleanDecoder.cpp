@@ -5,7 +5,6 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
-#include <AK/BuiltinWrappers.h>
 #include <AK/Debug.h>
 #include <AK/Endian.h>
 
@@ -32,11 +31,8 @@ ErrorOr<BooleanDecoder> BooleanDecoder::initialize(ReadonlyBytes data)
 // Instead of filling the value field one bit at a time as the spec suggests, we store the
 // data to be read in a reservoir of greater than one byte. This allows us to read out data
 // for the entire reservoir at once, avoiding a lot of branch misses in read_bool().
-void BooleanDecoder::fill_reservoir()
+void BooleanDecoder::refill_reservoir()
 {
-    if (m_value_bits_left > 8)
-        return;
-
     // Defer errors until the decode is finalized, so the work to check for errors and return them only has
     // to be done once. Not refilling the reservoir here will only result in reading out all zeroes until
     // the range decode is finished.
@@ -62,34 +58,6 @@ void BooleanDecoder::fill_reservoir()
     m_value_bits_left += read_size * 8;
 }
 
-// 9.2.2 Boolean decoding process
-bool BooleanDecoder::read_bool(u8 probability)
-{
-    auto split = 1u + (((m_range - 1u) * probability) >> 8u);
-    // The actual value being read resides in the most significant 8 bits
-    // of the value field, so we shift the split into that range for comparison.
-    auto split_shifted = static_cast<ValueType>(split) << reserve_bits;
-    bool return_bool;
-
-    if (m_value < split_shifted) {
-        m_range = split;
-        return_bool = false;
-    } else {
-        m_range -= split;
-        m_value -= split_shifted;
-        return_bool = true;
-    }
-
-    u8 bits_to_shift_into_range = count_leading_zeroes(m_range) - ((sizeof(m_range) - 1) * 8);
-    m_range <<= bits_to_shift_into_range;
-    m_value <<= bits_to_shift_into_range;
-    m_value_bits_left -= bits_to_shift_into_range;
-
-    fill_reservoir();
-
-    return return_bool;
-}
-
 // 9.2.4 Parsing process for read_literal
 u8 BooleanDecoder::read_literal(u8 bits)
 {
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <AK/BitStream.h>
+#include <AK/BuiltinWrappers.h>
 #include <AK/Error.h>
 #include <AK/Optional.h>
 #include <AK/Types.h>
@@ -20,7 +21,8 @@ public:
     static ErrorOr<BooleanDecoder> initialize(ReadonlyBytes data);
 
     /* (9.2) */
-    bool read_bool(u8 probability);
+    // This is called for every single bit of the coefficient data, so it lives here to be inlined into the token decoding loops.
+    ALWAYS_INLINE bool read_bool(u8 probability);
     u8 read_literal(u8 bits);
 
     ErrorOr<void> finish_decode();
@@ -40,7 +42,13 @@ private:
         fill_reservoir();
     }
 
-    void fill_reservoir();
+    ALWAYS_INLINE void fill_reservoir()
+    {
+        if (m_value_bits_left > 8)
+            return;
+        refill_reservoir();
+    }
+    void refill_reservoir();
 
     u8 const* m_data;
     size_t m_bytes_left { 0 };
@@ -52,4 +60,32 @@ private:
     u32 m_value_bits_left { 0 };
 };
 
+// 9.2.2 Boolean decoding process
+bool BooleanDecoder::read_bool(u8 probability)
+{
+    auto split = 1u + (((m_range - 1u) * probability) >> 8u);
+    // The actual value being read resides in the most significant 8 bits
+    // of the value field, so we shift the split into that range for comparison.
+    auto split_shifted = static_cast<ValueType>(split) << reserve_bits;
+    bool return_bool;
+
+    if (m_value < split_shifted) {
+        m_range = split;
+        return_bool = false;
+    } else {
+        m_range -= split;
+        m_value -= split_shifted;
+        return_bool = true;
+    }
+
+    u8 bits_to_shift_into_range = count_leading_zeroes(m_range) - ((sizeof(m_range) - 1) * 8);
+    m_range <<= bits_to_shift_into_range;
+    m_value <<= bits_to_shift_into_range;
+    m_value_bits_left -= bits_to_shift_into_range;
+
+    fill_reservoir();
+
+    return return_bool;
+}
+
 }
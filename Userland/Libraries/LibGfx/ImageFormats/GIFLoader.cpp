@@ -24,6 +24,9 @@ namespace Gfx {
 static constexpr Array<int, 4> INTERLACE_ROW_STRIDES = { 8, 8, 4, 2 };
 static constexpr Array<int, 4> INTERLACE_ROW_OFFSETS = { 0, 4, 2, 1 };
 
+// Rows of each interlace pass that are covered by a row of it until the following passes are drawn.
+static constexpr Array<int, 4> INTERLACE_ROW_HEIGHTS = { 8, 4, 2, 1 };
+
 struct GIFImageDescriptor {
     u16 x { 0 };
     u16 y { 0 };
@@ -133,6 +136,70 @@ static void clear_rect(Bitmap& bitmap, IntRect const& rect, Color color)
     }
 }
 
+enum class FillInterlacedRows {
+    No,
+    Yes,
+};
+
+struct DrawnRows {
+    u32 completed_passes { 0 };
+    int rows_of_current_pass { 0 };
+};
+
+// Draws the color indices of an image into the frame buffer, and returns how far they got when there aren't enough of them.
+// While the image is incomplete, the rows of each interlace pass can also fill the rows below them that the following passes haven't drawn yet.
+static DrawnRows draw_image(GIFLoadingContext& context, GIFImageDescriptor const& image, ReadonlyBytes color_indices, FillInterlacedRows fill_interlaced_rows)
+{
+    auto const& color_map = image.use_global_color_map ? context.logical_screen.color_map : image.color_map;
+
+    int pixel_index = 0;
+    int row = 0;
+    int interlace_pass = 0;
+    DrawnRows drawn_rows;
+
+    if (!image.width)
+        return drawn_rows;
+
+    for (auto const& color : color_indices) {
+        auto c = color_map[color];
+
+        int x = pixel_index % image.width + image.x;
+        int y = row + image.y;
+
+        if (!image.transparent || color != image.transparency_index) {
+            int rows_to_fill = 1;
+            if (image.interlaced && fill_interlaced_rows == FillInterlacedRows::Yes && interlace_pass < 4)
+                rows_to_fill = INTERLACE_ROW_HEIGHTS[interlace_pass];
+            for (int filled_y = y; filled_y < y + rows_to_fill && filled_y < image.y + image.height; ++filled_y) {
+                if (context.frame_buffer->rect().contains(x, filled_y))
+                    context.frame_buffer->set_pixel(x, filled_y, c);
+            }
+        }
+
+        ++pixel_index;
+        if (pixel_index % image.width == 0) {
+            drawn_rows.rows_of_current_pass = min(row + (image.interlaced ? INTERLACE_ROW_STRIDES[min(interlace_pass, 3)] : 1), static_cast<int>(image.height));
+            if (image.interlaced) {
+                if (interlace_pass < 4) {
+                    if (row + INTERLACE_ROW_STRIDES[interlace_pass] >= image.height) {
+                        ++interlace_pass;
+                        ++drawn_rows.completed_passes;
+                        drawn_rows.rows_of_current_pass = 0;
+                        if (interlace_pass < 4)
+                            row = INTERLACE_ROW_OFFSETS[interlace_pass];
+                    } else {
+                        row += INTERLACE_ROW_STRIDES[interlace_pass];
+                    }
+                }
+            } else {
+                ++row;
+            }
+        }
+    }
+
+    return drawn_rows;
+}
+
 static ErrorOr<void> decode_frame(GIFLoadingContext& context, size_t frame_index)
 {
     if (frame_index >= context.images.size()) {
@@ -185,43 +252,7 @@ static ErrorOr<void> decode_frame(GIFLoadingContext& context, size_t frame_index
             return Error::from_string_literal("LZW minimum code size is greater than 8");
 
         auto decoded_stream = TRY(Compress::LzwDecompressor<LittleEndianInputBitStream>::decompress_all(image->lzw_encoded_bytes, image->lzw_min_code_size));
-
-        auto const& color_map = image->use_global_color_map ? context.logical_screen.color_map : image->color_map;
-
-        int pixel_index = 0;
-        int row = 0;
-        int interlace_pass = 0;
-
-        if (!image->width)
-            continue;
-
-        for (auto const& color : decoded_stream.bytes()) {
-            auto c = color_map[color];
-
-            int x = pixel_index % image->width + image->x;
-            int y = row + image->y;
-
-            if (context.frame_buffer->rect().contains(x, y) && (!image->transparent || color != image->transparency_index)) {
-                context.frame_buffer->set_pixel(x, y, c);
-            }
-
-            ++pixel_index;
-            if (pixel_index % image->width == 0) {
-                if (image->interlaced) {
-                    if (interlace_pass < 4) {
-                        if (row + INTERLACE_ROW_STRIDES[interlace_pass] >= image->height) {
-                            ++interlace_pass;
-                            if (interlace_pass < 4)
-                                row = INTERLACE_ROW_OFFSETS[interlace_pass];
-                        } else {
-                            row += INTERLACE_ROW_STRIDES[interlace_pass];
-                        }
-                    }
-                } else {
-                    ++row;
-                }
-            }
-        }
+        draw_image(context, *image, decoded_stream, FillInterlacedRows::No);
 
         context.current_frame = i;
         context.state = GIFLoadingContext::State::FrameComplete;
@@ -364,7 +395,11 @@ static ErrorOr<void> load_gif_frame_descriptors(GIFLoadingContext& context)
                     break;
 
                 auto const lzw_subblock = TRY(image->lzw_encoded_bytes.get_bytes_for_writing(lzw_encoded_bytes_expected));
-                TRY(context.stream.read_until_filled(lzw_subblock));
+                if (auto result = context.stream.read_until_filled(lzw_subblock); result.is_error()) {
+                    // Only keep what was actually read, so that the start of the image can still be shown.
+                    image->lzw_encoded_bytes.resize(image->lzw_encoded_bytes.size() - lzw_subblock.size());
+                    return result.release_error();
+                }
             }
 
             current_image = make<GIFImageDescriptor>();
@@ -499,4 +534,36 @@ ErrorOr<ImageFrameDescriptor> GIFImageDecoderPlugin::frame(size_t index, Optiona
     return frame;
 }
 
+ErrorOr<PartialImageFrameDescriptor> GIFImageDecoderPlugin::partial_first_frame()
+{
+    if (m_context->state < GIFLoadingContext::State::FrameDescriptorsLoaded && m_context->error_state == GIFLoadingContext::ErrorState::NoError) {
+        // The descriptors end where the data does, but the images that were read up to that point are kept.
+        if (load_gif_frame_descriptors(*m_context).is_error())
+            m_context->error_state = GIFLoadingContext::ErrorState::FailedToLoadFrameDescriptors;
+    }
+
+    if (m_context->images.is_empty() || m_context->images[0]->lzw_encoded_bytes.is_empty())
+        return Error::from_string_literal("GIFImageDecoderPlugin: No image data yet");
+
+    auto const& image = *m_context->images[0];
+    if (image.lzw_min_code_size > 8)
+        return Error::from_string_literal("LZW minimum code size is greater than 8");
+
+    auto decoded_stream = TRY(Compress::LzwDecompressor<LittleEndianInputBitStream>::decompress_available(image.lzw_encoded_bytes, image.lzw_min_code_size));
+
+    m_context->frame_buffer = TRY(Bitmap::create(BitmapFormat::BGRA8888, { m_context->logical_screen.width, m_context->logical_screen.height }));
+    m_context->frame_buffer->fill(Color::Transparent);
+    auto drawn_rows = draw_image(*m_context, image, decoded_stream, FillInterlacedRows::Yes);
+
+    // The partially drawn frame buffer can't be used as a starting point for the following frames.
+    m_context->state = GIFLoadingContext::State::FrameDescriptorsLoaded;
+
+    PartialImageFrameDescriptor frame;
+    frame.image = m_context->frame_buffer;
+    frame.decoded_passes = drawn_rows.completed_passes;
+    frame.decoded_rows_of_current_pass = drawn_rows.rows_of_current_pass;
+    frame.is_complete = m_context->images.size() > 1 || m_context->error_state == GIFLoadingContext::ErrorState::NoError;
+    return frame;
+}
+
 }
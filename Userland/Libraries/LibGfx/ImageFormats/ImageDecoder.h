@@ -26,6 +26,20 @@ struct ImageFrameDescriptor {
     int duration { 0 };
 };
 
+// What could be decoded of the first frame of an image whose data was cut short, for example because it's still being downloaded.
+struct PartialImageFrameDescriptor {
+    RefPtr<Bitmap> image;
+
+    // Interlaced and progressive images cover the whole frame early on, and are then refined by each of their passes.
+    // Other images only have a single pass, which fills the frame from the top.
+    u32 decoded_passes { 0 };
+
+    // How far down the frame the pass after the decoded ones got.
+    int decoded_rows_of_current_pass { 0 };
+
+    bool is_complete { false };
+};
+
 struct VectorImageFrameDescriptor {
     RefPtr<VectorGraphic> image;
     int duration { 0 };
@@ -53,6 +67,12 @@ protected:
     mutable HashMap<StringView, String> m_main_tags;
 };
 
+// Options for the decoders that can spread their work over several threads.
+struct ImageDecoderOptions {
+    // This is opt-in, as the calling process needs to be allowed to create threads.
+    size_t thread_count { 1 };
+};
+
 enum class NaturalFrameFormat {
     RGB,
     Grayscale,
@@ -84,6 +104,10 @@ public:
 
     virtual ErrorOr<ImageFrameDescriptor> frame(size_t index, Optional<IntSize> ideal_size = {}) = 0;
 
+    // Override this if the format can show something before all of its data is available.
+    // This is called on plugins that were created with a prefix of the data, and must not fail just because the rest is missing.
+    virtual ErrorOr<PartialImageFrameDescriptor> partial_first_frame() { return Error::from_string_literal("ImageDecoderPlugin: Partial decoding is not supported"); }
+
     virtual Optional<Metadata const&> metadata() { return OptionalNone {}; }
 
     virtual ErrorOr<Optional<ReadonlyBytes>> icc_data() { return OptionalNone {}; }
@@ -111,6 +135,9 @@ public:
 
     ErrorOr<ImageFrameDescriptor> frame(size_t index, Optional<IntSize> ideal_size = {}) const { return m_plugin->frame(index, ideal_size); }
 
+    // Call only on decoders that were created with data that may be incomplete.
+    ErrorOr<PartialImageFrameDescriptor> partial_first_frame() const { return m_plugin->partial_first_frame(); }
+
     Optional<Metadata const&> metadata() const { return m_plugin->metadata(); }
     ErrorOr<Optional<ReadonlyBytes>> icc_data() const { return m_plugin->icc_data(); }
 
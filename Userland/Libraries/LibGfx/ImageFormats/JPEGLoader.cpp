@@ -13,6 +13,7 @@
 #include <AK/Math.h>
 #include <AK/MemoryStream.h>
 #include <AK/NumericLimits.h>
+#include <AK/SIMD.h>
 #include <AK/String.h>
 #include <AK/Try.h>
 #include <AK/Vector.h>
@@ -20,6 +21,9 @@
 #include <LibGfx/ImageFormats/JPEGShared.h>
 #include <LibGfx/ImageFormats/TIFFLoader.h>
 #include <LibGfx/ImageFormats/TIFFMetadata.h>
+#include <LibThreading/ParallelFor.h>
+
+#pragma GCC diagnostic ignored "-Wpsabi"
 
 namespace Gfx {
 
@@ -227,6 +231,54 @@ public:
         return {};
     }
 
+    struct EntropyCodedSegment {
+        ByteBuffer data;
+
+        // The offsets in data right after each RSTn marker.
+        Vector<size_t> restart_marker_ends;
+    };
+
+    // Reads the entropy-coded data up to the next marker that's not a RSTn marker, and saves that marker for the following read_u16().
+    // The data keeps its byte stuffing and markers, and ends with that marker, so that a HuffmanStream reading it knows where it ends.
+    ErrorOr<EntropyCodedSegment> read_entropy_coded_segment()
+    {
+        VERIFY(!m_saved_marker.has_value());
+
+        EntropyCodedSegment segment;
+        while (true) {
+            if (m_byte_offset == m_current_size)
+                TRY(refill_buffer());
+
+            auto const available = m_buffer.span().slice(m_byte_offset, m_current_size - m_byte_offset);
+            auto const* marker_start = static_cast<u8 const*>(memchr(available.data(), 0xFF, available.size()));
+            auto const data_size = marker_start ? static_cast<size_t>(marker_start - available.data()) : available.size();
+            TRY(segment.data.try_append(available.data(), data_size));
+            m_byte_offset += data_size;
+            if (!marker_start)
+                continue;
+
+            // Skip the 0xFF, and any fill bytes after it.
+            m_byte_offset++;
+            u8 next_byte = TRY(read_u8());
+            while (next_byte == 0xFF)
+                next_byte = TRY(read_u8());
+
+            TRY(segment.data.try_append(0xFF));
+            TRY(segment.data.try_append(next_byte));
+            if (next_byte == 0x00)
+                continue;
+
+            Marker const marker = 0xFF00 | next_byte;
+            if (marker >= JPEG_RST0 && marker <= JPEG_RST7) {
+                TRY(segment.restart_marker_ends.try_append(segment.data.size()));
+                continue;
+            }
+
+            m_saved_marker = marker;
+            return segment;
+        }
+    }
+
     Optional<u16>& saved_marker(Badge<HuffmanStream>)
     {
         return m_saved_marker;
@@ -331,6 +383,11 @@ public:
     {
     }
 
+    u64 byte_offset() const
+    {
+        return jpeg_stream.byte_offset();
+    }
+
 private:
     ALWAYS_INLINE ErrorOr<void> refill_reservoir()
     {
@@ -404,6 +461,17 @@ struct Scan {
     {
     }
 
+    // Creates a scan with the same parameters, whose entropy-coded data is read from another stream.
+    Scan(Scan const& other, HuffmanStream stream)
+        : components(other.components)
+        , spectral_selection_start(other.spectral_selection_start)
+        , spectral_selection_end(other.spectral_selection_end)
+        , successive_approximation_high(other.successive_approximation_high)
+        , successive_approximation_low(other.successive_approximation_low)
+        , huffman_stream(stream)
+    {
+    }
+
     // B.2.3 - Scan header syntax
     Vector<ScanComponent, 4> components;
 
@@ -415,6 +483,9 @@ struct Scan {
     HuffmanStream huffman_stream;
 
     u64 end_of_bands_run_count { 0 };
+    Array<i16, 4> previous_dc_values {};
+
+    u32 decoded_mcu_count { 0 };
 
     // See the note on Figure B.4 - Scan header syntax
     bool are_components_interleaved() const
@@ -432,16 +503,17 @@ enum class ColorTransform {
 };
 
 struct JPEGLoadingContext {
-    JPEGLoadingContext(JPEGStream jpeg_stream, JPEGDecoderOptions options)
+    JPEGLoadingContext(JPEGStream jpeg_stream, JPEGDecoderOptions options, ImageDecoderOptions decoder_options)
         : stream(move(jpeg_stream))
         , options(options)
+        , decoder_options(decoder_options)
     {
     }
 
-    static ErrorOr<NonnullOwnPtr<JPEGLoadingContext>> create(NonnullOwnPtr<Stream> stream, JPEGDecoderOptions options)
+    static ErrorOr<NonnullOwnPtr<JPEGLoadingContext>> create(NonnullOwnPtr<Stream> stream, JPEGDecoderOptions options, ImageDecoderOptions decoder_options)
     {
         auto jpeg_stream = TRY(JPEGStream::create(move(stream)));
-        return make<JPEGLoadingContext>(move(jpeg_stream), options);
+        return make<JPEGLoadingContext>(move(jpeg_stream), options, decoder_options);
     }
 
     enum State {
@@ -470,10 +542,10 @@ struct JPEGLoadingContext {
     u16 dc_restart_interval { 0 };
     HashMap<u8, HuffmanTable> dc_tables;
     HashMap<u8, HuffmanTable> ac_tables;
-    Array<i16, 4> previous_dc_values {};
     MacroblockMeta mblock_meta;
     JPEGStream stream;
     JPEGDecoderOptions options;
+    ImageDecoderOptions decoder_options;
 
     Optional<ColorTransform> color_transform {};
 
@@ -481,6 +553,8 @@ struct JPEGLoadingContext {
 
     Optional<ICCMultiChunkState> icc_multi_chunk_state;
     Optional<ByteBuffer> icc_data;
+
+    u32 decoded_scan_count { 0 };
 };
 
 static inline auto* get_component(Macroblock& block, unsigned component)
@@ -516,7 +590,7 @@ enum class JPEGDecodingMode {
 };
 
 template<JPEGDecodingMode DecodingMode>
-static ErrorOr<void> add_dc(JPEGLoadingContext& context, Macroblock& macroblock, ScanComponent const& scan_component)
+static ErrorOr<void> add_dc(JPEGLoadingContext const& context, Scan& scan, Macroblock& macroblock, ScanComponent const& scan_component)
 {
     auto maybe_table = context.dc_tables.get(scan_component.dc_destination_id);
     if (!maybe_table.has_value()) {
@@ -525,7 +599,6 @@ static ErrorOr<void> add_dc(JPEGLoadingContext& context, Macroblock& macroblock,
     }
 
     auto& dc_table = maybe_table.value();
-    auto& scan = *context.current_scan;
 
     auto* select_component = get_component(macroblock, scan_component.component.index);
     auto& coefficient = select_component[0];
@@ -553,7 +626,7 @@ static ErrorOr<void> add_dc(JPEGLoadingContext& context, Macroblock& macroblock,
     if (dc_length != 0 && dc_diff < (1 << (dc_length - 1)))
         dc_diff -= (1 << dc_length) - 1;
 
-    auto& previous_dc = context.previous_dc_values[scan_component.component.index];
+    auto& previous_dc = scan.previous_dc_values[scan_component.component.index];
     previous_dc += dc_diff;
     coefficient = previous_dc << scan.successive_approximation_low;
 
@@ -597,7 +670,7 @@ static bool is_progressive(StartOfFrame::FrameType frame_type)
 }
 
 template<JPEGDecodingMode DecodingMode>
-static ErrorOr<void> add_ac(JPEGLoadingContext& context, Macroblock& macroblock, ScanComponent const& scan_component)
+static ErrorOr<void> add_ac(JPEGLoadingContext const& context, Scan& scan, Macroblock& macroblock, ScanComponent const& scan_component)
 {
     auto maybe_table = context.ac_tables.get(scan_component.ac_destination_id);
     if (!maybe_table.has_value()) {
@@ -608,8 +681,6 @@ static ErrorOr<void> add_ac(JPEGLoadingContext& context, Macroblock& macroblock,
     auto& ac_table = maybe_table.value();
     auto* select_component = get_component(macroblock, scan_component.component.index);
 
-    auto& scan = *context.current_scan;
-
     // Compute the AC coefficients.
 
     // 0th coefficient is the dc, which is already handled
@@ -731,14 +802,14 @@ static ErrorOr<void> add_ac(JPEGLoadingContext& context, Macroblock& macroblock,
  * we are dealing with three components) will fill up the blocks with chroma data.
  */
 template<JPEGDecodingMode DecodingMode>
-static ErrorOr<void> build_macroblocks(JPEGLoadingContext& context, Vector<Macroblock>& macroblocks, u32 hcursor, u32 vcursor)
+static ErrorOr<void> build_macroblocks(JPEGLoadingContext const& context, Scan& scan, Vector<Macroblock>& macroblocks, u32 hcursor, u32 vcursor)
 {
-    for (auto const& scan_component : context.current_scan->components) {
+    for (auto const& scan_component : scan.components) {
         for (u8 vfactor_i = 0; vfactor_i < scan_component.component.sampling_factors.vertical; vfactor_i++) {
             for (u8 hfactor_i = 0; hfactor_i < scan_component.component.sampling_factors.horizontal; hfactor_i++) {
                 // A.2.3 - Interleaved order
                 u32 macroblock_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hfactor_i + hcursor);
-                if (!context.current_scan->are_components_interleaved()) {
+                if (!scan.are_components_interleaved()) {
                     macroblock_index = vcursor * context.mblock_meta.hpadded_count + (hfactor_i + (hcursor * scan_component.component.sampling_factors.vertical) + (vfactor_i * scan_component.component.sampling_factors.horizontal));
 
                     // A.2.4 Completion of partial MCU
@@ -756,17 +827,17 @@ static ErrorOr<void> build_macroblocks(JPEGLoadingContext& context, Vector<Macro
                 Macroblock& block = macroblocks[macroblock_index];
 
                 if constexpr (DecodingMode == JPEGDecodingMode::Sequential) {
-                    TRY(add_dc<DecodingMode>(context, block, scan_component));
-                    TRY(add_ac<DecodingMode>(context, block, scan_component));
+                    TRY(add_dc<DecodingMode>(context, scan, block, scan_component));
+                    TRY(add_ac<DecodingMode>(context, scan, block, scan_component));
                 } else {
-                    if (context.current_scan->spectral_selection_start == 0)
-                        TRY(add_dc<DecodingMode>(context, block, scan_component));
-                    if (context.current_scan->spectral_selection_end != 0)
-                        TRY(add_ac<DecodingMode>(context, block, scan_component));
+                    if (scan.spectral_selection_start == 0)
+                        TRY(add_dc<DecodingMode>(context, scan, block, scan_component));
+                    if (scan.spectral_selection_end != 0)
+                        TRY(add_ac<DecodingMode>(context, scan, block, scan_component));
 
                     // G.1.2.2 - Progressive encoding of AC coefficients with Huffman coding
-                    if (context.current_scan->end_of_bands_run_count > 0) {
-                        --context.current_scan->end_of_bands_run_count;
+                    if (scan.end_of_bands_run_count > 0) {
+                        --scan.end_of_bands_run_count;
                         continue;
                     }
                 }
@@ -789,61 +860,150 @@ static bool is_dct_based(StartOfFrame::FrameType frame_type)
         || frame_type == StartOfFrame::FrameType::Differential_Progressive_DCT_Arithmetic;
 }
 
-static void reset_decoder(JPEGLoadingContext& context)
+static void reset_decoder(JPEGLoadingContext const& context, Scan& scan)
 {
     // G.1.2.2 - Progressive encoding of AC coefficients with Huffman coding
-    context.current_scan->end_of_bands_run_count = 0;
+    scan.end_of_bands_run_count = 0;
 
     // E.2.4 Control procedure for decoding a restart interval
     if (is_dct_based(context.frame.type)) {
-        context.previous_dc_values = {};
+        scan.previous_dc_values = {};
         return;
     }
 
     VERIFY_NOT_REACHED();
 }
 
-static ErrorOr<void> decode_huffman_stream(JPEGLoadingContext& context, Vector<Macroblock>& macroblocks)
+static u32 number_of_mcus_per_row(JPEGLoadingContext const& context)
 {
-    for (u32 vcursor = 0; vcursor < context.mblock_meta.vcount; vcursor += context.sampling_factors.vertical) {
-        for (u32 hcursor = 0; hcursor < context.mblock_meta.hcount; hcursor += context.sampling_factors.horizontal) {
-            // FIXME: This is likely wrong for non-interleaved scans.
-            VERIFY(context.mblock_meta.hpadded_count % context.sampling_factors.horizontal == 0);
-            u32 number_of_mcus_decoded_so_far = ((vcursor / context.sampling_factors.vertical) * context.mblock_meta.hpadded_count + hcursor) / context.sampling_factors.horizontal;
+    // FIXME: This is likely wrong for non-interleaved scans.
+    VERIFY(context.mblock_meta.hpadded_count % context.sampling_factors.horizontal == 0);
+    return context.mblock_meta.hpadded_count / context.sampling_factors.horizontal;
+}
 
-            auto& huffman_stream = context.current_scan->huffman_stream;
+static u32 number_of_mcus(JPEGLoadingContext const& context)
+{
+    return number_of_mcus_per_row(context) * ceil_div(context.mblock_meta.vcount, static_cast<u32>(context.sampling_factors.vertical));
+}
 
-            if (context.dc_restart_interval > 0) {
-                if (number_of_mcus_decoded_so_far != 0 && number_of_mcus_decoded_so_far % context.dc_restart_interval == 0) {
-                    reset_decoder(context);
+static bool starts_restart_interval(JPEGLoadingContext const& context, u32 mcu_index)
+{
+    return context.dc_restart_interval > 0 && mcu_index != 0 && mcu_index % context.dc_restart_interval == 0;
+}
 
-                    // Restart markers are stored in byte boundaries. Advance the huffman stream cursor to
-                    //  the 0th bit of the next byte.
-                    TRY(huffman_stream.advance_to_byte_boundary());
+// Decodes the MCUs in [first_mcu, end_mcu), where first_mcu is either the first MCU of the scan or of a restart interval.
+static ErrorOr<void> decode_mcus(JPEGLoadingContext const& context, Scan& scan, Vector<Macroblock>& macroblocks, u32 first_mcu, u32 end_mcu)
+{
+    auto const mcus_per_row = number_of_mcus_per_row(context);
 
-                    // Skip the restart marker (RSTn).
-                    TRY(huffman_stream.discard_bits(8));
-                }
-            }
+    for (u32 mcu_index = first_mcu; mcu_index < end_mcu; ++mcu_index) {
+        u32 const hcursor = (mcu_index % mcus_per_row) * context.sampling_factors.horizontal;
+        u32 const vcursor = (mcu_index / mcus_per_row) * context.sampling_factors.vertical;
 
-            auto result = [&]() {
-                if (is_progressive(context.frame.type))
-                    return build_macroblocks<JPEGDecodingMode::Progressive>(context, macroblocks, hcursor, vcursor);
-                return build_macroblocks<JPEGDecodingMode::Sequential>(context, macroblocks, hcursor, vcursor);
-            }();
+        if (mcu_index != first_mcu && starts_restart_interval(context, mcu_index)) {
+            reset_decoder(context, scan);
 
-            if (result.is_error()) {
-                if constexpr (JPEG_DEBUG) {
-                    dbgln("Failed to build Macroblock {}: {}", number_of_mcus_decoded_so_far, result.error());
-                    dbgln("Huffman stream byte offset {:#x}", context.stream.byte_offset());
-                }
-                return result.release_error();
+            // Restart markers are stored in byte boundaries. Advance the huffman stream cursor to
+            //  the 0th bit of the next byte.
+            TRY(scan.huffman_stream.advance_to_byte_boundary());
+
+            // Skip the restart marker (RSTn).
+            TRY(scan.huffman_stream.discard_bits(8));
+        }
+
+        auto result = [&]() {
+            if (is_progressive(context.frame.type))
+                return build_macroblocks<JPEGDecodingMode::Progressive>(context, scan, macroblocks, hcursor, vcursor);
+            return build_macroblocks<JPEGDecodingMode::Sequential>(context, scan, macroblocks, hcursor, vcursor);
+        }();
+
+        if (result.is_error()) {
+            if constexpr (JPEG_DEBUG) {
+                dbgln("Failed to build Macroblock {}: {}", mcu_index, result.error());
+                dbgln("Huffman stream byte offset {:#x}", scan.huffman_stream.byte_offset());
             }
+            return result.release_error();
         }
+
+        scan.decoded_mcu_count++;
     }
     return {};
 }
 
+static bool can_decode_restart_intervals_in_parallel(JPEGLoadingContext const& context)
+{
+    if (context.decoder_options.thread_count <= 1 || context.dc_restart_interval == 0)
+        return false;
+
+    // Every MCU must cover macroblocks of its own, which build_macroblocks() doesn't guarantee for the non-interleaved scans of subsampled components.
+    auto const& scan = *context.current_scan;
+    return scan.are_components_interleaved() || scan.components[0].component.sampling_factors == SamplingFactors { 1, 1 };
+}
+
+static ErrorOr<void> decode_huffman_stream_in_parallel(JPEGLoadingContext& context, Vector<Macroblock>& macroblocks)
+{
+    // E.2.4 - Control procedure for decoding a restart interval
+    // Every restart interval starts on a byte boundary right after its RSTn marker, with freshly reset predictions.
+    // So once the whole entropy-coded segment is in memory, ranges of restart intervals can be decoded on separate threads.
+    auto const segment = TRY(context.stream.read_entropy_coded_segment());
+
+    auto const mcu_count = number_of_mcus(context);
+    auto const interval_count = ceil_div(mcu_count, static_cast<u32>(context.dc_restart_interval));
+
+    // Damaged files may not have a marker for every interval, so those are decoded in one go, exactly like decode_huffman_stream() would.
+    auto thread_count = min<size_t>(context.decoder_options.thread_count, interval_count);
+    if (segment.restart_marker_ends.size() + 1 != interval_count)
+        thread_count = 1;
+
+    struct Range {
+        u32 first_mcu { 0 };
+        u32 end_mcu { 0 };
+        size_t byte_offset { 0 };
+        Optional<Error> error;
+    };
+
+    Vector<Range> ranges;
+    TRY(ranges.try_ensure_capacity(thread_count));
+    for (size_t i = 0; i < thread_count; ++i) {
+        auto const first_interval = static_cast<u32>(interval_count * i / thread_count);
+        auto const end_interval = static_cast<u32>(interval_count * (i + 1) / thread_count);
+        ranges.unchecked_append({
+            .first_mcu = first_interval * context.dc_restart_interval,
+            .end_mcu = min(end_interval * context.dc_restart_interval, mcu_count),
+            .byte_offset = first_interval == 0 ? 0 : segment.restart_marker_ends[first_interval - 1],
+            .error = {},
+        });
+    }
+
+    auto decode_range = [&context, &segment, &macroblocks](Range& range) {
+        auto result = [&]() -> ErrorOr<void> {
+            // The stream may read ahead into the following ranges, but it stops at the marker at the end of the segment.
+            auto stream = TRY(JPEGStream::create(TRY(try_make<FixedMemoryStream>(segment.data.bytes().slice(range.byte_offset)))));
+            Scan scan { *context.current_scan, HuffmanStream { stream } };
+            return decode_mcus(context, scan, macroblocks, range.first_mcu, range.end_mcu);
+        }();
+        if (result.is_error())
+            range.error = result.release_error();
+    };
+
+    Threading::parallel_for(ranges.size(), [&](size_t i) { decode_range(ranges[i]); });
+
+    for (auto& range : ranges) {
+        if (range.error.has_value())
+            return range.error.release_value();
+    }
+
+    return {};
+}
+
+static ErrorOr<void> decode_huffman_stream(JPEGLoadingContext& context, Vector<Macroblock>& macroblocks)
+{
+    if (can_decode_restart_intervals_in_parallel(context))
+        return decode_huffman_stream_in_parallel(context, macroblocks);
+
+    return decode_mcus(context, *context.current_scan, macroblocks, 0, number_of_mcus(context));
+}
+
 static bool is_frame_marker(Marker const marker)
 {
     // B.1.1.3 - Marker assignments
@@ -1430,9 +1590,39 @@ static void dequantize(JPEGLoadingContext& context, Vector<Macroblock>& macroblo
     }
 }
 
-static void inverse_dct_8x8(i16* block_component)
+static ALWAYS_INLINE AK::SIMD::i16x8 load_row(i16 const* row)
 {
-    // Does a 2-D IDCT by doing two 1-D IDCTs as described in https://unix4lyfe.org/dct/
+    AK::SIMD::i16x8 values;
+    __builtin_memcpy(&values, row, sizeof(values));
+    return values;
+}
+
+static ALWAYS_INLINE void store_row(i16* row, AK::SIMD::i16x8 values)
+{
+    __builtin_memcpy(row, &values, sizeof(values));
+}
+
+static ALWAYS_INLINE AK::SIMD::i32x8 clamp_row(AK::SIMD::i32x8 values, i32 min_value, i32 max_value)
+{
+    values = values < min_value ? min_value : values;
+    return values > max_value ? max_value : values;
+}
+
+static ALWAYS_INLINE void transpose_8x8(i16* block_component)
+{
+    for (u32 i = 0; i < 8; ++i) {
+        for (u32 j = i + 1; j < 8; ++j)
+            swap(block_component[i * 8 + j], block_component[j * 8 + i]);
+    }
+}
+
+// Does a 1-D IDCT on the 8 columns of the block, with one SIMD lane per column.
+static ALWAYS_INLINE void inverse_dct_8_columns(i16* block_component)
+{
+    using AK::SIMD::f32x8;
+    using AK::SIMD::i16x8;
+    using AK::SIMD::i32x8;
+
     // The 1-D DCT idea is described at https://unix4lyfe.org/dct-1d/, read aan.cc from bottom to top.
     static float const m0 = 2.0f * AK::cos(1.0f / 16.0f * 2.0f * AK::Pi<float>);
     static float const m1 = 2.0f * AK::cos(2.0f / 16.0f * 2.0f * AK::Pi<float>);
@@ -1449,140 +1639,89 @@ static void inverse_dct_8x8(i16* block_component)
     static float const s6 = AK::cos(6.0f / 16.0f * AK::Pi<float>) / 2.0f;
     static float const s7 = AK::cos(7.0f / 16.0f * AK::Pi<float>) / 2.0f;
 
-    for (u32 k = 0; k < 8; ++k) {
-        float const g0 = block_component[0 * 8 + k] * s0;
-        float const g1 = block_component[4 * 8 + k] * s4;
-        float const g2 = block_component[2 * 8 + k] * s2;
-        float const g3 = block_component[6 * 8 + k] * s6;
-        float const g4 = block_component[5 * 8 + k] * s5;
-        float const g5 = block_component[1 * 8 + k] * s1;
-        float const g6 = block_component[7 * 8 + k] * s7;
-        float const g7 = block_component[3 * 8 + k] * s3;
-
-        float const f0 = g0;
-        float const f1 = g1;
-        float const f2 = g2;
-        float const f3 = g3;
-        float const f4 = g4 - g7;
-        float const f5 = g5 + g6;
-        float const f6 = g5 - g6;
-        float const f7 = g4 + g7;
-
-        float const e0 = f0;
-        float const e1 = f1;
-        float const e2 = f2 - f3;
-        float const e3 = f2 + f3;
-        float const e4 = f4;
-        float const e5 = f5 - f7;
-        float const e6 = f6;
-        float const e7 = f5 + f7;
-        float const e8 = f4 + f6;
-
-        float const d0 = e0;
-        float const d1 = e1;
-        float const d2 = e2 * m1;
-        float const d3 = e3;
-        float const d4 = e4 * m2;
-        float const d5 = e5 * m3;
-        float const d6 = e6 * m4;
-        float const d7 = e7;
-        float const d8 = e8 * m5;
-
-        float const c0 = d0 + d1;
-        float const c1 = d0 - d1;
-        float const c2 = d2 - d3;
-        float const c3 = d3;
-        float const c4 = d4 + d8;
-        float const c5 = d5 + d7;
-        float const c6 = d6 - d8;
-        float const c7 = d7;
-        float const c8 = c5 - c6;
-
-        float const b0 = c0 + c3;
-        float const b1 = c1 + c2;
-        float const b2 = c1 - c2;
-        float const b3 = c0 - c3;
-        float const b4 = c4 - c8;
-        float const b5 = c8;
-        float const b6 = c6 - c7;
-        float const b7 = c7;
-
-        block_component[0 * 8 + k] = b0 + b7;
-        block_component[1 * 8 + k] = b1 + b6;
-        block_component[2 * 8 + k] = b2 + b5;
-        block_component[3 * 8 + k] = b3 + b4;
-        block_component[4 * 8 + k] = b3 - b4;
-        block_component[5 * 8 + k] = b2 - b5;
-        block_component[6 * 8 + k] = b1 - b6;
-        block_component[7 * 8 + k] = b0 - b7;
-    }
-    for (u32 l = 0; l < 8; ++l) {
-        float const g0 = block_component[l * 8 + 0] * s0;
-        float const g1 = block_component[l * 8 + 4] * s4;
-        float const g2 = block_component[l * 8 + 2] * s2;
-        float const g3 = block_component[l * 8 + 6] * s6;
-        float const g4 = block_component[l * 8 + 5] * s5;
-        float const g5 = block_component[l * 8 + 1] * s1;
-        float const g6 = block_component[l * 8 + 7] * s7;
-        float const g7 = block_component[l * 8 + 3] * s3;
-
-        float const f0 = g0;
-        float const f1 = g1;
-        float const f2 = g2;
-        float const f3 = g3;
-        float const f4 = g4 - g7;
-        float const f5 = g5 + g6;
-        float const f6 = g5 - g6;
-        float const f7 = g4 + g7;
-
-        float const e0 = f0;
-        float const e1 = f1;
-        float const e2 = f2 - f3;
-        float const e3 = f2 + f3;
-        float const e4 = f4;
-        float const e5 = f5 - f7;
-        float const e6 = f6;
-        float const e7 = f5 + f7;
-        float const e8 = f4 + f6;
-
-        float const d0 = e0;
-        float const d1 = e1;
-        float const d2 = e2 * m1;
-        float const d3 = e3;
-        float const d4 = e4 * m2;
-        float const d5 = e5 * m3;
-        float const d6 = e6 * m4;
-        float const d7 = e7;
-        float const d8 = e8 * m5;
-
-        float const c0 = d0 + d1;
-        float const c1 = d0 - d1;
-        float const c2 = d2 - d3;
-        float const c3 = d3;
-        float const c4 = d4 + d8;
-        float const c5 = d5 + d7;
-        float const c6 = d6 - d8;
-        float const c7 = d7;
-        float const c8 = c5 - c6;
-
-        float const b0 = c0 + c3;
-        float const b1 = c1 + c2;
-        float const b2 = c1 - c2;
-        float const b3 = c0 - c3;
-        float const b4 = c4 - c8;
-        float const b5 = c8;
-        float const b6 = c6 - c7;
-        float const b7 = c7;
-
-        block_component[l * 8 + 0] = b0 + b7;
-        block_component[l * 8 + 1] = b1 + b6;
-        block_component[l * 8 + 2] = b2 + b5;
-        block_component[l * 8 + 3] = b3 + b4;
-        block_component[l * 8 + 4] = b3 - b4;
-        block_component[l * 8 + 5] = b2 - b5;
-        block_component[l * 8 + 6] = b1 - b6;
-        block_component[l * 8 + 7] = b0 - b7;
-    }
+    auto const load = [&](u32 row) {
+        return __builtin_convertvector(load_row(block_component + row * 8), f32x8);
+    };
+    auto const store = [&](u32 row, f32x8 values) {
+        // Like the scalar conversion to i16, this truncates towards zero.
+        store_row(block_component + row * 8, __builtin_convertvector(__builtin_convertvector(values, i32x8), i16x8));
+    };
+
+    f32x8 const g0 = load(0) * s0;
+    f32x8 const g1 = load(4) * s4;
+    f32x8 const g2 = load(2) * s2;
+    f32x8 const g3 = load(6) * s6;
+    f32x8 const g4 = load(5) * s5;
+    f32x8 const g5 = load(1) * s1;
+    f32x8 const g6 = load(7) * s7;
+    f32x8 const g7 = load(3) * s3;
+
+    f32x8 const f0 = g0;
+    f32x8 const f1 = g1;
+    f32x8 const f2 = g2;
+    f32x8 const f3 = g3;
+    f32x8 const f4 = g4 - g7;
+    f32x8 const f5 = g5 + g6;
+    f32x8 const f6 = g5 - g6;
+    f32x8 const f7 = g4 + g7;
+
+    f32x8 const e0 = f0;
+    f32x8 const e1 = f1;
+    f32x8 const e2 = f2 - f3;
+    f32x8 const e3 = f2 + f3;
+    f32x8 const e4 = f4;
+    f32x8 const e5 = f5 - f7;
+    f32x8 const e6 = f6;
+    f32x8 const e7 = f5 + f7;
+    f32x8 const e8 = f4 + f6;
+
+    f32x8 const d0 = e0;
+    f32x8 const d1 = e1;
+    f32x8 const d2 = e2 * m1;
+    f32x8 const d3 = e3;
+    f32x8 const d4 = e4 * m2;
+    f32x8 const d5 = e5 * m3;
+    f32x8 const d6 = e6 * m4;
+    f32x8 const d7 = e7;
+    f32x8 const d8 = e8 * m5;
+
+    f32x8 const c0 = d0 + d1;
+    f32x8 const c1 = d0 - d1;
+    f32x8 const c2 = d2 - d3;
+    f32x8 const c3 = d3;
+    f32x8 const c4 = d4 + d8;
+    f32x8 const c5 = d5 + d7;
+    f32x8 const c6 = d6 - d8;
+    f32x8 const c7 = d7;
+    f32x8 const c8 = c5 - c6;
+
+    f32x8 const b0 = c0 + c3;
+    f32x8 const b1 = c1 + c2;
+    f32x8 const b2 = c1 - c2;
+    f32x8 const b3 = c0 - c3;
+    f32x8 const b4 = c4 - c8;
+    f32x8 const b5 = c8;
+    f32x8 const b6 = c6 - c7;
+    f32x8 const b7 = c7;
+
+    store(0, b0 + b7);
+    store(1, b1 + b6);
+    store(2, b2 + b5);
+    store(3, b3 + b4);
+    store(4, b3 - b4);
+    store(5, b2 - b5);
+    store(6, b1 - b6);
+    store(7, b0 - b7);
+}
+
+static void inverse_dct_8x8(i16* block_component)
+{
+    // Does a 2-D IDCT by doing two 1-D IDCTs as described in https://unix4lyfe.org/dct/
+    // Both passes work on columns, so the block is transposed around the second one.
+    inverse_dct_8_columns(block_component);
+    transpose_8x8(block_component);
+    inverse_dct_8_columns(block_component);
+    transpose_8x8(block_component);
 }
 
 static void inverse_dct(JPEGLoadingContext const& context, Vector<Macroblock>& macroblocks)
@@ -1606,76 +1745,130 @@ static void inverse_dct(JPEGLoadingContext const& context, Vector<Macroblock>& m
     // F.2.1.5 - Inverse DCT (IDCT)
     auto const level_shift = 1 << (context.frame.precision - 1);
     auto const max_value = (1 << context.frame.precision) - 1;
+
+    // FIXME: This just truncate all coefficients, it's an easy way to support (read hack)
+    //        12 bits JPEGs without rewriting all color transformations.
+    auto const shift_to_8_bits = context.frame.precision - 8;
+
+    auto const level_shift_and_clamp = [&](i16* block_component) {
+        for (u8 i = 0; i < 8; ++i) {
+            auto row = __builtin_convertvector(load_row(block_component + i * 8), AK::SIMD::i32x8);
+            row = clamp_row(row + level_shift, 0, max_value) >> shift_to_8_bits;
+            store_row(block_component + i * 8, __builtin_convertvector(row, AK::SIMD::i16x8));
+        }
+    };
+
     for (u32 vcursor = 0; vcursor < context.mblock_meta.vcount; vcursor += context.sampling_factors.vertical) {
         for (u32 hcursor = 0; hcursor < context.mblock_meta.hcount; hcursor += context.sampling_factors.horizontal) {
             for (u8 vfactor_i = 0; vfactor_i < context.sampling_factors.vertical; ++vfactor_i) {
                 for (u8 hfactor_i = 0; hfactor_i < context.sampling_factors.horizontal; ++hfactor_i) {
                     u32 mb_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hcursor + hfactor_i);
-                    for (u8 i = 0; i < 8; ++i) {
-                        for (u8 j = 0; j < 8; ++j) {
-
-                            // FIXME: This just truncate all coefficients, it's an easy way to support (read hack)
-                            //        12 bits JPEGs without rewriting all color transformations.
-                            auto const clamp_to_8_bits = [&](u16 color) -> u8 {
-                                if (context.frame.precision == 8)
-                                    return static_cast<u8>(color);
-                                return static_cast<u8>(color >> 4);
-                            };
-
-                            macroblocks[mb_index].r[i * 8 + j] = clamp_to_8_bits(clamp(macroblocks[mb_index].r[i * 8 + j] + level_shift, 0, max_value));
-                            macroblocks[mb_index].g[i * 8 + j] = clamp_to_8_bits(clamp(macroblocks[mb_index].g[i * 8 + j] + level_shift, 0, max_value));
-                            macroblocks[mb_index].b[i * 8 + j] = clamp_to_8_bits(clamp(macroblocks[mb_index].b[i * 8 + j] + level_shift, 0, max_value));
-                            macroblocks[mb_index].k[i * 8 + j] = clamp_to_8_bits(clamp(macroblocks[mb_index].k[i * 8 + j] + level_shift, 0, max_value));
-                        }
-                    }
+                    level_shift_and_clamp(macroblocks[mb_index].r);
+                    level_shift_and_clamp(macroblocks[mb_index].g);
+                    level_shift_and_clamp(macroblocks[mb_index].b);
+                    level_shift_and_clamp(macroblocks[mb_index].k);
                 }
             }
         }
     }
 }
 
-static void undo_subsampling(JPEGLoadingContext const& context, Vector<Macroblock>& macroblocks)
+static ErrorOr<void> undo_subsampling(JPEGLoadingContext const& context, Vector<Macroblock>& macroblocks)
 {
     // The first component has sampling factors of context.sampling_factors, while the others
     // divide the first component's sampling factors. This is enforced by read_start_of_frame().
-    // This function undoes the subsampling by duplicating the values of the smaller components.
+    // As the first component's factors are 1 or 2, the others are upsampled by a factor of 1 or 2 in each direction.
     // See https://www.w3.org/Graphics/JPEG/itu-t81.pdf, A.2 Order of source image data encoding.
     //
-    // FIXME: Allow more combinations of sampling factors.
+    // Like libjpeg's "fancy upsampling", every output sample is interpolated with a triangle filter between the
+    // nearest input samples, which places the chroma samples between the luma samples (like the JFIF positioning).
     // See https://calendar.perfplanet.com/2015/why-arent-your-images-using-chroma-subsampling/ for
     // subsampling factors visble on the web. In PDF files, YCCK 2111 and 2112 and CMYK 2111 and 2112 are also present.
+    auto const mcus_per_row = context.mblock_meta.hpadded_count / context.sampling_factors.horizontal;
+    auto const mcus_per_column = context.mblock_meta.vpadded_count / context.sampling_factors.vertical;
+    auto const output_width = context.mblock_meta.hpadded_count * 8;
+
+    Vector<i16> plane;
+    Vector<i16> output_row;
+    TRY(output_row.try_resize(output_width));
+
     for (u32 component_i = 0; component_i < context.components.size(); component_i++) {
         auto& component = context.components[component_i];
         if (component.sampling_factors == context.sampling_factors)
             continue;
 
+        auto const horizontal_ratio = context.sampling_factors.horizontal / component.sampling_factors.horizontal;
+        auto const vertical_ratio = context.sampling_factors.vertical / component.sampling_factors.vertical;
+
+        // Gather the component's blocks into a plane, so that the filter can reach across block boundaries.
+        auto const plane_width = mcus_per_row * component.sampling_factors.horizontal * 8;
+        auto const plane_height = mcus_per_column * component.sampling_factors.vertical * 8;
+        TRY(plane.try_resize(plane_width * plane_height));
+
         for (u32 vcursor = 0; vcursor < context.mblock_meta.vcount; vcursor += context.sampling_factors.vertical) {
             for (u32 hcursor = 0; hcursor < context.mblock_meta.hcount; hcursor += context.sampling_factors.horizontal) {
-                u32 const component_block_index = vcursor * context.mblock_meta.hpadded_count + hcursor;
-                Macroblock& component_block = macroblocks[component_block_index];
-                auto* block_component_source = get_component(component_block, component_i);
-
-                // Overflows are intentional.
-                for (u8 vfactor_i = context.sampling_factors.vertical - 1; vfactor_i < context.sampling_factors.vertical; --vfactor_i) {
-                    for (u8 hfactor_i = context.sampling_factors.horizontal - 1; hfactor_i < context.sampling_factors.horizontal; --hfactor_i) {
+                for (u8 vfactor_i = 0; vfactor_i < component.sampling_factors.vertical; vfactor_i++) {
+                    for (u8 hfactor_i = 0; hfactor_i < component.sampling_factors.horizontal; hfactor_i++) {
                         u32 macroblock_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hfactor_i + hcursor);
-                        Macroblock& block = macroblocks[macroblock_index];
-                        auto* block_component_destination = get_component(block, component_i);
-                        for (u8 i = 7; i < 8; --i) {
-                            for (u8 j = 7; j < 8; --j) {
-                                u8 const pixel = i * 8 + j;
-                                // The component is 8x8 subsampled 2x2. Upsample its 2x2 4x4 tiles.
-                                u32 const component_pxrow = (i / context.sampling_factors.vertical) + 4 * vfactor_i;
-                                u32 const component_pxcol = (j / context.sampling_factors.horizontal) + 4 * hfactor_i;
-                                u32 const component_pixel = component_pxrow * 8 + component_pxcol;
-                                block_component_destination[pixel] = block_component_source[component_pixel];
-                            }
-                        }
+                        auto const* block_component = get_component(macroblocks[macroblock_index], component_i);
+                        u32 const plane_x = (hcursor / context.sampling_factors.horizontal * component.sampling_factors.horizontal + hfactor_i) * 8;
+                        u32 const plane_y = (vcursor / context.sampling_factors.vertical * component.sampling_factors.vertical + vfactor_i) * 8;
+                        for (u8 i = 0; i < 8; ++i)
+                            __builtin_memcpy(&plane[(plane_y + i) * plane_width + plane_x], block_component + i * 8, 8 * sizeof(i16));
                     }
                 }
             }
         }
+
+        // Samples outside of the image are garbage, so the filter only reads the ones that cover it.
+        auto const last_x = ceil_div<u32, u32>(context.frame.width * component.sampling_factors.horizontal, context.sampling_factors.horizontal) - 1;
+        auto const last_y = ceil_div<u32, u32>(context.frame.height * component.sampling_factors.vertical, context.sampling_factors.vertical) - 1;
+        auto const sample = [&](i16 const* row, i32 x) -> i32 {
+            return row[clamp<i32>(x, 0, last_x)];
+        };
+
+        for (u32 y = 0; y < context.mblock_meta.vcount * 8; ++y) {
+            // Each output row is interpolated between its input row and the closest other one, which is
+            // the one above for even rows and the one below for odd rows.
+            u32 const input_y = min(y / vertical_ratio, last_y);
+            i16 const* row = &plane[input_y * plane_width];
+            i16 const* other_row = row;
+            if (vertical_ratio == 2)
+                other_row = &plane[clamp<i32>(y % 2 == 0 ? input_y - 1 : input_y + 1, 0, last_y) * plane_width];
+
+            if (horizontal_ratio == 1 && vertical_ratio == 1) {
+                for (u32 x = 0; x < output_width; ++x)
+                    output_row[x] = sample(row, x);
+            } else if (horizontal_ratio == 1) {
+                // The bias alternates between rows so that rounding does not shift the image in one direction.
+                i32 const bias = y % 2 == 0 ? 1 : 2;
+                for (u32 x = 0; x < output_width; ++x)
+                    output_row[x] = (3 * sample(row, x) + sample(other_row, x) + bias) >> 2;
+            } else if (vertical_ratio == 1) {
+                for (u32 x = 0; x < output_width / 2; ++x) {
+                    auto const nearest = 3 * sample(row, x);
+                    output_row[2 * x] = (nearest + sample(row, x - 1) + 1) >> 2;
+                    output_row[2 * x + 1] = (nearest + sample(row, x + 1) + 2) >> 2;
+                }
+            } else {
+                auto const column_sum = [&](i32 x) {
+                    return 3 * sample(row, x) + sample(other_row, x);
+                };
+                for (u32 x = 0; x < output_width / 2; ++x) {
+                    auto const nearest = 3 * column_sum(x);
+                    output_row[2 * x] = (nearest + column_sum(x - 1) + 8) >> 4;
+                    output_row[2 * x + 1] = (nearest + column_sum(x + 1) + 7) >> 4;
+                }
+            }
+
+            for (u32 hcursor = 0; hcursor < context.mblock_meta.hpadded_count; ++hcursor) {
+                auto* block_component = get_component(macroblocks[y / 8 * context.mblock_meta.hpadded_count + hcursor], component_i);
+                __builtin_memcpy(block_component + y % 8 * 8, &output_row[hcursor * 8], 8 * sizeof(i16));
+            }
+        }
     }
+
+    return {};
 }
 
 static void ycbcr_to_rgb(Vector<Macroblock>& macroblocks)
@@ -1683,17 +1876,24 @@ static void ycbcr_to_rgb(Vector<Macroblock>& macroblocks)
     // Conversion from YCbCr to RGB isn't specified in the first JPEG specification but in the JFIF extension:
     // See: https://www.itu.int/rec/dologin_pub.asp?lang=f&id=T-REC-T.871-201105-I!!PDF-E&type=items
     // 7 - Conversion to and from RGB
+    using AK::SIMD::f32x8;
+    using AK::SIMD::i16x8;
+    using AK::SIMD::i32x8;
+
     for (auto& macroblock : macroblocks) {
-        auto* y = macroblock.y;
-        auto* cb = macroblock.cb;
-        auto* cr = macroblock.cr;
-        for (u8 i = 0; i < 64; ++i) {
-            int r = y[i] + 1.402f * (cr[i] - 128);
-            int g = y[i] - 0.3441f * (cb[i] - 128) - 0.7141f * (cr[i] - 128);
-            int b = y[i] + 1.772f * (cb[i] - 128);
-            y[i] = clamp(r, 0, 255);
-            cb[i] = clamp(g, 0, 255);
-            cr[i] = clamp(b, 0, 255);
+        for (u8 i = 0; i < 64; i += 8) {
+            auto* y = macroblock.y + i;
+            auto* cb = macroblock.cb + i;
+            auto* cr = macroblock.cr + i;
+            auto const y_row = __builtin_convertvector(load_row(y), f32x8);
+            auto const cb_row = __builtin_convertvector(load_row(cb) - 128, f32x8);
+            auto const cr_row = __builtin_convertvector(load_row(cr) - 128, f32x8);
+            auto const r = __builtin_convertvector(y_row + 1.402f * cr_row, i32x8);
+            auto const g = __builtin_convertvector(y_row - 0.3441f * cb_row - 0.7141f * cr_row, i32x8);
+            auto const b = __builtin_convertvector(y_row + 1.772f * cb_row, i32x8);
+            store_row(y, __builtin_convertvector(clamp_row(r, 0, 255), i16x8));
+            store_row(cb, __builtin_convertvector(clamp_row(g, 0, 255), i16x8));
+            store_row(cr, __builtin_convertvector(clamp_row(b, 0, 255), i16x8));
         }
     }
 }
@@ -1941,15 +2141,12 @@ static ErrorOr<void> decode_header(JPEGLoadingContext& context)
     return {};
 }
 
-static ErrorOr<Vector<Macroblock>> construct_macroblocks(JPEGLoadingContext& context)
+static ErrorOr<void> decode_scans(JPEGLoadingContext& context, Vector<Macroblock>& macroblocks)
 {
     // B.6 - Summary
     // See: Figure B.16 – Flow of compressed data syntax
     // This function handles the "Multi-scan" loop.
 
-    Vector<Macroblock> macroblocks;
-    TRY(macroblocks.try_resize(context.mblock_meta.padded_total));
-
     Marker marker = TRY(read_marker_at_cursor(context.stream));
     while (true) {
         if (is_miscellaneous_or_table_marker(marker)) {
@@ -1957,8 +2154,9 @@ static ErrorOr<Vector<Macroblock>> construct_macroblocks(JPEGLoadingContext& con
         } else if (marker == JPEG_SOS) {
             TRY(read_start_of_scan(context.stream, context));
             TRY(decode_huffman_stream(context, macroblocks));
+            context.decoded_scan_count++;
         } else if (marker == JPEG_EOI) {
-            return macroblocks;
+            return {};
         } else {
             dbgln_if(JPEG_DEBUG, "Unexpected marker {:x}!", marker);
             return Error::from_string_literal("Unexpected marker");
@@ -1968,12 +2166,19 @@ static ErrorOr<Vector<Macroblock>> construct_macroblocks(JPEGLoadingContext& con
     }
 }
 
-static ErrorOr<void> decode_jpeg(JPEGLoadingContext& context)
+static ErrorOr<Vector<Macroblock>> construct_macroblocks(JPEGLoadingContext& context)
+{
+    Vector<Macroblock> macroblocks;
+    TRY(macroblocks.try_resize(context.mblock_meta.padded_total));
+    TRY(decode_scans(context, macroblocks));
+    return macroblocks;
+}
+
+static ErrorOr<void> compose_macroblocks(JPEGLoadingContext& context, Vector<Macroblock>& macroblocks)
 {
-    auto macroblocks = TRY(construct_macroblocks(context));
     dequantize(context, macroblocks);
     inverse_dct(context, macroblocks);
-    undo_subsampling(context, macroblocks);
+    TRY(undo_subsampling(context, macroblocks));
     TRY(handle_color_transform(context, macroblocks));
     if (context.components.size() == 4)
         TRY(compose_cmyk_bitmap(context, macroblocks));
@@ -1982,6 +2187,48 @@ static ErrorOr<void> decode_jpeg(JPEGLoadingContext& context)
     return {};
 }
 
+static ErrorOr<void> decode_jpeg(JPEGLoadingContext& context)
+{
+    auto macroblocks = TRY(construct_macroblocks(context));
+    return compose_macroblocks(context, macroblocks);
+}
+
+static ErrorOr<PartialImageFrameDescriptor> decode_partial_jpeg(JPEGLoadingContext& context)
+{
+    Vector<Macroblock> macroblocks;
+    TRY(macroblocks.try_resize(context.mblock_meta.padded_total));
+
+    // Decoding stops with an error once the data runs out, and everything that was decoded up to that point is kept.
+    // Progressive images show all of their completed scans, and the part of the following one that was decoded, at once.
+    PartialImageFrameDescriptor frame;
+    frame.is_complete = !decode_scans(context, macroblocks).is_error();
+    frame.decoded_passes = context.decoded_scan_count;
+    if (!frame.is_complete && context.current_scan.has_value()) {
+        auto const mcu_rows = context.current_scan->decoded_mcu_count / number_of_mcus_per_row(context);
+        frame.decoded_rows_of_current_pass = min(mcu_rows * context.sampling_factors.vertical * 8, context.frame.height);
+    }
+
+    if (frame.decoded_passes == 0 && frame.decoded_rows_of_current_pass == 0)
+        return Error::from_string_literal("JPEGImageDecoderPlugin: No image data yet");
+
+    TRY(compose_macroblocks(context, macroblocks));
+
+    RefPtr<Bitmap> bitmap = context.bitmap;
+    if (context.cmyk_bitmap)
+        bitmap = TRY(context.cmyk_bitmap->to_low_quality_rgb());
+
+    if (frame.is_complete || frame.decoded_passes > 0) {
+        frame.image = bitmap;
+        return frame;
+    }
+
+    // Until the first scan is complete, the rows it didn't reach yet are transparent.
+    frame.image = TRY(Bitmap::create(BitmapFormat::BGRA8888, bitmap->size()));
+    for (int y = 0; y < frame.decoded_rows_of_current_pass; ++y)
+        memcpy(frame.image->scanline(y), bitmap->scanline(y), bitmap->width() * sizeof(ARGB32));
+    return frame;
+}
+
 JPEGImageDecoderPlugin::JPEGImageDecoderPlugin(NonnullOwnPtr<JPEGLoadingContext> context)
     : m_context(move(context))
 {
@@ -2004,13 +2251,13 @@ bool JPEGImageDecoderPlugin::sniff(ReadonlyBytes data)
 
 ErrorOr<NonnullOwnPtr<ImageDecoderPlugin>> JPEGImageDecoderPlugin::create(ReadonlyBytes data)
 {
-    return create_with_options(data, {});
+    return create_with_options(data);
 }
 
-ErrorOr<NonnullOwnPtr<ImageDecoderPlugin>> JPEGImageDecoderPlugin::create_with_options(ReadonlyBytes data, JPEGDecoderOptions options)
+ErrorOr<NonnullOwnPtr<ImageDecoderPlugin>> JPEGImageDecoderPlugin::create_with_options(ReadonlyBytes data, JPEGDecoderOptions options, ImageDecoderOptions decoder_options)
 {
     auto stream = TRY(try_make<FixedMemoryStream>(data));
-    auto context = TRY(JPEGLoadingContext::create(move(stream), options));
+    auto context = TRY(JPEGLoadingContext::create(move(stream), options, decoder_options));
     auto plugin = TRY(adopt_nonnull_own_or_enomem(new (nothrow) JPEGImageDecoderPlugin(move(context))));
     TRY(decode_header(*plugin->m_context));
     return plugin;
@@ -2038,6 +2285,16 @@ ErrorOr<ImageFrameDescriptor> JPEGImageDecoderPlugin::frame(size_t index, Option
     return ImageFrameDescriptor { m_context->bitmap, 0 };
 }
 
+ErrorOr<PartialImageFrameDescriptor> JPEGImageDecoderPlugin::partial_first_frame()
+{
+    if (m_context->state != JPEGLoadingContext::State::HeaderDecoded)
+        return Error::from_string_literal("JPEGImageDecoderPlugin: Partial decoding must happen before any other decoding");
+
+    auto frame = decode_partial_jpeg(*m_context);
+    m_context->state = frame.is_error() || !frame.value().is_complete ? JPEGLoadingContext::State::Error : JPEGLoadingContext::State::BitmapDecoded;
+    return frame;
+}
+
 Optional<Metadata const&> JPEGImageDecoderPlugin::metadata()
 {
     if (m_context->exif_metadata)
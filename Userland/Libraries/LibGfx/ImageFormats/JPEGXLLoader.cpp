@@ -11,9 +11,40 @@
 #include <LibCompress/Brotli.h>
 #include <LibGfx/ImageFormats/ExifOrientedBitmap.h>
 #include <LibGfx/ImageFormats/JPEGXLLoader.h>
+#include <LibThreading/Thread.h>
 
 namespace Gfx {
 
+// Once the image is fully decoded, every row of its channels can be processed independently from the others.
+template<typename Callback>
+static ErrorOr<void> for_each_band_of_rows(u32 height, size_t thread_count, Callback callback)
+{
+    static constexpr u32 minimum_rows_per_band = 16;
+    auto const band_count = max<size_t>(min<size_t>(thread_count, height / minimum_rows_per_band), 1);
+
+    // The first band is processed on this thread, while the others are processed on threads of their own.
+    Vector<NonnullRefPtr<Threading::Thread>> threads;
+    TRY(threads.try_ensure_capacity(band_count - 1));
+    for (size_t i = 1; i < band_count; ++i) {
+        auto const first_row = static_cast<u32>(height * i / band_count);
+        auto const end_row = static_cast<u32>(height * (i + 1) / band_count);
+        auto thread = Threading::Thread::construct([first_row, end_row, &callback]() -> intptr_t {
+            callback(first_row, end_row);
+            return 0;
+        },
+            "JPEGXLDecoder"sv);
+        thread->start();
+        threads.unchecked_append(move(thread));
+    }
+
+    callback(0, static_cast<u32>(height / band_count));
+
+    for (auto& thread : threads)
+        (void)thread->join();
+
+    return {};
+}
+
 /// 4.2 - Functions
 static ALWAYS_INLINE i32 unpack_signed(u32 u)
 {
@@ -1621,6 +1652,16 @@ public:
         m_pixels[y * m_width + x] = value;
     }
 
+    Span<i32> row(u32 y)
+    {
+        return m_pixels.span().slice(y * m_width, m_width);
+    }
+
+    ReadonlySpan<i32> row(u32 y) const
+    {
+        return m_pixels.span().slice(y * m_width, m_width);
+    }
+
     u32 width() const
     {
         return m_width;
@@ -1712,7 +1753,7 @@ public:
         };
     }
 
-    ErrorOr<NonnullRefPtr<Bitmap>> to_bitmap(ImageMetadata& metadata) const
+    ErrorOr<NonnullRefPtr<Bitmap>> to_bitmap(ImageMetadata& metadata, size_t thread_count) const
     {
         // FIXME: which channel size should we use?
         auto const width = m_channels[0].width();
@@ -1725,34 +1766,33 @@ public:
 
         auto const bits_per_sample = metadata.bit_depth.bits_per_sample;
         VERIFY(bits_per_sample >= 8);
-        for (u32 y {}; y < height; ++y) {
-            for (u32 x {}; x < width; ++x) {
-                auto const to_u8 = [&, bits_per_sample](i32 sample) -> u8 {
-                    // FIXME: Don't truncate the result to 8 bits
-                    static constexpr auto maximum_supported_bit_depth = 8;
-                    if (bits_per_sample > maximum_supported_bit_depth)
-                        sample >>= (bits_per_sample - maximum_supported_bit_depth);
-
-                    return clamp(sample + .5, 0, (1 << maximum_supported_bit_depth) - 1);
-                };
-
-                auto const color = [&]() -> Color {
-                    if (!alpha_channel.has_value()) {
-                        return { to_u8(m_channels[0].get(x, y)),
-                            to_u8(m_channels[1].get(x, y)),
-                            to_u8(m_channels[2].get(x, y)) };
-                    }
+        auto const to_u8 = [bits_per_sample](i32 sample) -> u8 {
+            // FIXME: Don't truncate the result to 8 bits
+            static constexpr auto maximum_supported_bit_depth = 8;
+            if (bits_per_sample > maximum_supported_bit_depth)
+                sample >>= (bits_per_sample - maximum_supported_bit_depth);
+
+            return clamp(sample + .5, 0, (1 << maximum_supported_bit_depth) - 1);
+        };
+
+        // Every band sets a distinct set of pixels, even once they are moved around by the orientation.
+        TRY(for_each_band_of_rows(height, thread_count, [&](u32 first_row, u32 end_row) {
+            for (u32 y = first_row; y < end_row; ++y) {
+                auto const red = m_channels[0].row(y);
+                auto const green = m_channels[1].row(y);
+                auto const blue = m_channels[2].row(y);
 
-                    return {
-                        to_u8(m_channels[0].get(x, y)),
-                        to_u8(m_channels[1].get(x, y)),
-                        to_u8(m_channels[2].get(x, y)),
-                        to_u8(m_channels[*alpha_channel].get(x, y)),
-                    };
-                }();
-                oriented_bitmap.set_pixel(x, y, color.value());
+                if (!alpha_channel.has_value()) {
+                    for (u32 x {}; x < width; ++x)
+                        oriented_bitmap.set_pixel(x, y, Color(to_u8(red[x]), to_u8(green[x]), to_u8(blue[x])).value());
+                    continue;
+                }
+
+                auto const alpha = m_channels[*alpha_channel].row(y);
+                for (u32 x {}; x < width; ++x)
+                    oriented_bitmap.set_pixel(x, y, Color(to_u8(red[x]), to_u8(green[x]), to_u8(blue[x]), to_u8(alpha[x])).value());
             }
-        }
+        }));
 
         return oriented_bitmap.bitmap();
     }
@@ -2241,57 +2281,104 @@ static ErrorOr<void> read_lf_group(LittleEndianInputBitStream&,
 ///
 
 /// H.6 - Transformations
-static void apply_rct(Image& image, TransformInfo const& transformation)
+template<u32 type>
+static void apply_rct_to_row(ReadonlySpan<i32> a_row, ReadonlySpan<i32> b_row, ReadonlySpan<i32> c_row, Span<i32> d_row, Span<i32> e_row, Span<i32> f_row)
 {
-    auto& channels = image.channels();
-    for (u32 y {}; y < channels[transformation.begin_c].height(); y++) {
-        for (u32 x {}; x < channels[transformation.begin_c].width(); x++) {
-
-            auto a = channels[transformation.begin_c + 0].get(x, y);
-            auto b = channels[transformation.begin_c + 1].get(x, y);
-            auto c = channels[transformation.begin_c + 2].get(x, y);
-
-            i32 d {};
-            i32 e {};
-            i32 f {};
-
-            auto const permutation = transformation.rct_type / 7;
-            auto const type = transformation.rct_type % 7;
-            if (type == 6) { // YCgCo
-                auto const tmp = a - (c >> 1);
-                e = c + tmp;
-                f = tmp - (b >> 1);
-                d = f + b;
-            } else {
-                if (type & 1)
-                    c = c + a;
-                if ((type >> 1) == 1)
-                    b = b + a;
-                if ((type >> 1) == 2)
-                    b = b + ((a + c) >> 1);
-                d = a;
-                e = b;
-                f = c;
-            }
+    // The type is a template parameter so that this loop is free of branches, and can be vectorized.
+    for (size_t x = 0; x < a_row.size(); ++x) {
+        auto const a = a_row[x];
+        auto b = b_row[x];
+        auto c = c_row[x];
+
+        i32 d {};
+        i32 e {};
+        i32 f {};
+
+        if constexpr (type == 6) { // YCgCo
+            auto const tmp = a - (c >> 1);
+            e = c + tmp;
+            f = tmp - (b >> 1);
+            d = f + b;
+        } else {
+            if constexpr (type & 1)
+                c = c + a;
+            if constexpr ((type >> 1) == 1)
+                b = b + a;
+            if constexpr ((type >> 1) == 2)
+                b = b + ((a + c) >> 1);
+            d = a;
+            e = b;
+            f = c;
+        }
 
-            Array<i32, 3> v {};
-            v[permutation % 3] = d;
-            v[(permutation + 1 + (permutation / 3)) % 3] = e;
-            v[(permutation + 2 - (permutation / 3)) % 3] = f;
+        d_row[x] = d;
+        e_row[x] = e;
+        f_row[x] = f;
+    }
+}
 
-            channels[transformation.begin_c + 0].set(x, y, v[0]);
-            channels[transformation.begin_c + 1].set(x, y, v[1]);
-            channels[transformation.begin_c + 2].set(x, y, v[2]);
+static ErrorOr<void> apply_rct(Image& image, TransformInfo const& transformation, size_t thread_count)
+{
+    auto& channels = image.channels();
+    auto const permutation = transformation.rct_type / 7;
+    auto const type = transformation.rct_type % 7;
+
+    auto& d_channel = channels[transformation.begin_c + (permutation % 3)];
+    auto& e_channel = channels[transformation.begin_c + ((permutation + 1 + (permutation / 3)) % 3)];
+    auto& f_channel = channels[transformation.begin_c + ((permutation + 2 - (permutation / 3)) % 3)];
+
+    // The outputs are written back in the same channels, so every row is copied before being transformed.
+    auto const width = channels[transformation.begin_c].width();
+    return for_each_band_of_rows(channels[transformation.begin_c].height(), thread_count, [&](u32 first_row, u32 end_row) {
+        Vector<i32, 3 * 1024> inputs;
+        inputs.resize(3 * width);
+        auto const a_row = inputs.span().slice(0, width);
+        auto const b_row = inputs.span().slice(width, width);
+        auto const c_row = inputs.span().slice(2 * width, width);
+
+        for (u32 y = first_row; y < end_row; ++y) {
+            channels[transformation.begin_c + 0].row(y).copy_to(a_row);
+            channels[transformation.begin_c + 1].row(y).copy_to(b_row);
+            channels[transformation.begin_c + 2].row(y).copy_to(c_row);
+
+            auto const d_row = d_channel.row(y);
+            auto const e_row = e_channel.row(y);
+            auto const f_row = f_channel.row(y);
+
+            switch (type) {
+            case 0:
+                apply_rct_to_row<0>(a_row, b_row, c_row, d_row, e_row, f_row);
+                break;
+            case 1:
+                apply_rct_to_row<1>(a_row, b_row, c_row, d_row, e_row, f_row);
+                break;
+            case 2:
+                apply_rct_to_row<2>(a_row, b_row, c_row, d_row, e_row, f_row);
+                break;
+            case 3:
+                apply_rct_to_row<3>(a_row, b_row, c_row, d_row, e_row, f_row);
+                break;
+            case 4:
+                apply_rct_to_row<4>(a_row, b_row, c_row, d_row, e_row, f_row);
+                break;
+            case 5:
+                apply_rct_to_row<5>(a_row, b_row, c_row, d_row, e_row, f_row);
+                break;
+            case 6:
+                apply_rct_to_row<6>(a_row, b_row, c_row, d_row, e_row, f_row);
+                break;
+            default:
+                VERIFY_NOT_REACHED();
+            }
         }
-    }
+    });
 }
 
-static void apply_transformation(Image& image, TransformInfo const& transformation)
+static ErrorOr<void> apply_transformation(Image& image, TransformInfo const& transformation, size_t thread_count)
 {
     switch (transformation.tr) {
     case TransformInfo::TransformId::kRCT:
-        apply_rct(image, transformation);
-        break;
+        return apply_rct(image, transformation, thread_count);
     case TransformInfo::TransformId::kPalette:
     case TransformInfo::TransformId::kSqueeze:
         TODO();
@@ -2348,7 +2435,8 @@ struct Frame {
 static ErrorOr<Frame> read_frame(LittleEndianInputBitStream& stream,
     SizeHeader const& size_header,
     ImageMetadata const& metadata,
-    Optional<EntropyDecoder>& entropy_decoder)
+    Optional<EntropyDecoder>& entropy_decoder,
+    size_t thread_count)
 {
     // F.1 - General
     // Each Frame is byte-aligned by invoking ZeroPadToByte() (B.2.7)
@@ -2404,7 +2492,7 @@ static ErrorOr<Frame> read_frame(LittleEndianInputBitStream& stream,
     // When all modular groups are decoded, the inverse transforms are applied to
     // the at that point fully decoded GlobalModular image, as specified in H.6.
     for (auto const& transformation : transform_infos.in_reverse())
-        apply_transformation(frame.image, transformation);
+        TRY(apply_transformation(frame.image, transformation, thread_count));
 
     return frame;
 }
@@ -2423,7 +2511,7 @@ static u32 mirror_1d(i32 coord, u32 size)
 ///
 
 /// K - Image features
-static ErrorOr<void> apply_upsampling(Frame& frame, ImageMetadata const& metadata)
+static ErrorOr<void> apply_upsampling(Frame& frame, ImageMetadata const& metadata, size_t thread_count)
 {
     Optional<u32> ec_max;
     for (auto upsampling : frame.frame_header.ec_upsampling) {
@@ -2445,50 +2533,82 @@ static ErrorOr<void> apply_upsampling(Frame& frame, ImageMetadata const& metadat
             return metadata.up8_weight[index];
         };
 
+        // The weights only depend on the position in the upsampled block and in the W window, so they are looked up once
+        // and stored in the order of the loops below.
+        Vector<double> weights;
+        TRY(weights.try_ensure_capacity(k * k * 25));
+        for (u8 ky {}; ky < k; ++ky) {
+            for (u8 kx {}; kx < k; ++kx) {
+                for (u8 ix {}; ix < 5; ++ix) {
+                    for (u8 iy {}; iy < 5; ++iy) {
+                        auto const j = (ky < k / 2) ? (iy + 5 * ky) : ((4 - iy) + 5 * (k - 1 - ky));
+                        auto const i = (kx < k / 2) ? (ix + 5 * kx) : ((4 - ix) + 5 * (k - 1 - kx));
+                        auto const minimum = min(i, j);
+                        auto const maximum = max(i, j);
+                        auto const index = 5 * k * minimum / 2 - minimum * (minimum - 1) / 2 + maximum - minimum;
+                        weights.unchecked_append(weight(index));
+                    }
+                }
+            }
+        }
+
         // FIXME: Use ec_upsampling for extra-channels
         for (auto& channel : frame.image.channels()) {
             auto upsampled = TRY(Channel::create(k * channel.width(), k * channel.height()));
 
-            // Loop over the original image
-            for (u32 y {}; y < channel.height(); y++) {
-                for (u32 x {}; x < channel.width(); x++) {
+            // Mirrored coordinates of the W window, for every coordinate offset by 2.
+            Vector<u32> mirrored_x;
+            TRY(mirrored_x.try_ensure_capacity(channel.width() + 4));
+            for (u32 x {}; x < channel.width() + 4; ++x)
+                mirrored_x.unchecked_append(mirror_1d(static_cast<i32>(x) - 2, channel.width()));
+
+            Vector<u32> mirrored_y;
+            TRY(mirrored_y.try_ensure_capacity(channel.height() + 4));
+            for (u32 y {}; y < channel.height() + 4; ++y)
+                mirrored_y.unchecked_append(mirror_1d(static_cast<i32>(y) - 2, channel.height()));
+
+            // Every band of rows of the original image gives its own rows of the upsampled one.
+            TRY(for_each_band_of_rows(channel.height(), thread_count, [&](u32 first_row, u32 end_row) {
+                for (u32 y = first_row; y < end_row; y++) {
+                    Array<ReadonlySpan<i32>, 5> rows;
+                    for (u8 iy {}; iy < 5; ++iy)
+                        rows[iy] = channel.row(mirrored_y[y + iy]);
+
+                    for (u32 x {}; x < channel.width(); x++) {
+                        // Loop over the W window, which is the same for the whole upsampled block
+                        Array<double, 25> window;
+                        double W_min = NumericLimits<double>::max();
+                        double W_max = -NumericLimits<double>::max();
+                        for (u8 ix {}; ix < 5; ++ix) {
+                            auto const origin_sample_x = mirrored_x[x + ix];
+                            for (u8 iy {}; iy < 5; ++iy) {
+                                double const origin_sample = rows[iy][origin_sample_x];
+                                W_min = min(W_min, origin_sample);
+                                W_max = max(W_max, origin_sample);
+                                window[ix * 5 + iy] = origin_sample;
+                            }
+                        }
 
-                    // Loop over the upsampling factor
-                    for (u8 kx {}; kx < k; ++kx) {
+                        // Loop over the upsampling factor
+                        auto const* block_weights = weights.data();
                         for (u8 ky {}; ky < k; ++ky) {
-                            double sum {};
-                            // Loop over the W window
-                            double W_min = NumericLimits<double>::max();
-                            double W_max = -NumericLimits<double>::max();
-                            for (u8 ix {}; ix < 5; ++ix) {
-                                for (u8 iy {}; iy < 5; ++iy) {
-                                    auto const j = (ky < k / 2) ? (iy + 5 * ky) : ((4 - iy) + 5 * (k - 1 - ky));
-                                    auto const i = (kx < k / 2) ? (ix + 5 * kx) : ((4 - ix) + 5 * (k - 1 - kx));
-                                    auto const minimum = min(i, j);
-                                    auto const maximum = max(i, j);
-                                    auto const index = 5 * k * minimum / 2 - minimum * (minimum - 1) / 2 + maximum - minimum;
-
-                                    auto const origin_sample_x = mirror_1d(x + ix - 2, channel.width());
-                                    auto const origin_sample_y = mirror_1d(y + iy - 2, channel.height());
-
-                                    auto const origin_sample = channel.get(origin_sample_x, origin_sample_y);
-
-                                    W_min = min(W_min, origin_sample);
-                                    W_max = max(W_max, origin_sample);
-
-                                    sum += origin_sample * weight(index);
-                                }
+                            auto upsampled_row = upsampled.row(y * k + ky);
+                            for (u8 kx {}; kx < k; ++kx) {
+                                double sum {};
+                                for (u8 i {}; i < 25; ++i)
+                                    sum += window[i] * block_weights[i];
+                                block_weights += 25;
+
+                                // The resulting sample is clamped to the range [a, b] where a and b are
+                                // the minimum and maximum of the samples in W.
+                                sum = clamp(sum, W_min, W_max);
+
+                                upsampled_row[x * k + kx] = sum;
                             }
-
-                            // The resulting sample is clamped to the range [a, b] where a and b are
-                            // the minimum and maximum of the samples in W.
-                            sum = clamp(sum, W_min, W_max);
-
-                            upsampled.set(x * k + kx, y * k + ky, sum);
                         }
                     }
                 }
-            }
+            }));
             channel = move(upsampled);
         }
     }
@@ -2496,9 +2616,9 @@ static ErrorOr<void> apply_upsampling(Frame& frame, ImageMetadata const& metadat
     return {};
 }
 
-static ErrorOr<void> apply_image_features(Frame& frame, ImageMetadata const& metadata)
+static ErrorOr<void> apply_image_features(Frame& frame, ImageMetadata const& metadata, size_t thread_count)
 {
-    TRY(apply_upsampling(frame, metadata));
+    TRY(apply_upsampling(frame, metadata, thread_count));
 
     if (frame.frame_header.flags != FrameHeader::Flags::None)
         TODO();
@@ -2507,7 +2627,7 @@ static ErrorOr<void> apply_image_features(Frame& frame, ImageMetadata const& met
 ///
 
 /// L.2 - XYB + L.3 - YCbCr
-static void ycbcr_to_rgb(Image& image, u8 bits_per_sample)
+static ErrorOr<void> ycbcr_to_rgb(Image& image, u8 bits_per_sample, size_t thread_count)
 {
     auto& channels = image.channels();
     VERIFY(channels.size() >= 3);
@@ -2516,29 +2636,37 @@ static void ycbcr_to_rgb(Image& image, u8 bits_per_sample)
     VERIFY(channels[0].height() == channels[1].height() && channels[1].height() == channels[2].height());
 
     auto const half_range_offset = (1 << bits_per_sample) / 2;
-    for (u32 y = 0; y < channels[0].height(); ++y) {
-        for (u32 x = 0; x < channels[0].width(); ++x) {
-            auto const cb = channels[0].get(x, y);
-            auto const luma = channels[1].get(x, y);
-            auto const cr = channels[2].get(x, y);
-
-            channels[0].set(x, y, luma + half_range_offset + 1.402 * cr);
-            channels[1].set(x, y, luma + half_range_offset - 0.344136 * cb - 0.714136 * cr);
-            channels[2].set(x, y, luma + half_range_offset + 1.772 * cb);
+    return for_each_band_of_rows(channels[0].height(), thread_count, [&](u32 first_row, u32 end_row) {
+        for (u32 y = first_row; y < end_row; ++y) {
+            auto first_row_of_channel = channels[0].row(y);
+            auto second_row_of_channel = channels[1].row(y);
+            auto third_row_of_channel = channels[2].row(y);
+
+            for (u32 x = 0; x < first_row_of_channel.size(); ++x) {
+                auto const cb = first_row_of_channel[x];
+                auto const luma = second_row_of_channel[x];
+                auto const cr = third_row_of_channel[x];
+
+                first_row_of_channel[x] = luma + half_range_offset + 1.402 * cr;
+                second_row_of_channel[x] = luma + half_range_offset - 0.344136 * cb - 0.714136 * cr;
+                third_row_of_channel[x] = luma + half_range_offset + 1.772 * cb;
+            }
         }
-    }
+    });
 }
 
-static void apply_colour_transformation(Frame& frame, ImageMetadata const& metadata)
+static ErrorOr<void> apply_colour_transformation(Frame& frame, ImageMetadata const& metadata, size_t thread_count)
 {
     if (frame.frame_header.do_YCbCr)
-        ycbcr_to_rgb(frame.image, metadata.bit_depth.bits_per_sample);
+        TRY(ycbcr_to_rgb(frame.image, metadata.bit_depth.bits_per_sample, thread_count));
 
     if (metadata.xyb_encoded) {
         TODO();
     } else {
         // FIXME: Do a proper color transformation with metadata.colour_encoding
     }
+
+    return {};
 }
 ///
 
@@ -2557,8 +2685,9 @@ static ErrorOr<void> render_extra_channels(Image&, ImageMetadata const& metadata
 
 class JPEGXLLoadingContext {
 public:
-    JPEGXLLoadingContext(NonnullOwnPtr<Stream> stream)
+    JPEGXLLoadingContext(NonnullOwnPtr<Stream> stream, ImageDecoderOptions options)
         : m_stream(move(stream))
+        , m_options(options)
     {
     }
 
@@ -2580,14 +2709,14 @@ public:
 
     ErrorOr<void> decode_frame()
     {
-        auto frame = TRY(read_frame(m_stream, m_header, m_metadata, m_entropy_decoder));
+        auto frame = TRY(read_frame(m_stream, m_header, m_metadata, m_entropy_decoder, m_options.thread_count));
 
         if (frame.frame_header.restoration_filter.gab || frame.frame_header.restoration_filter.epf_iters != 0)
             TODO();
 
-        TRY(apply_image_features(frame, m_metadata));
+        TRY(apply_image_features(frame, m_metadata, m_options.thread_count));
 
-        apply_colour_transformation(frame, m_metadata);
+        TRY(apply_colour_transformation(frame, m_metadata, m_options.thread_count));
 
         TRY(render_extra_channels(frame.image, m_metadata));
 
@@ -2614,7 +2743,7 @@ public:
 
             TRY(decode_frame());
 
-            m_bitmap = TRY(m_image->to_bitmap(m_metadata));
+            m_bitmap = TRY(m_image->to_bitmap(m_metadata, m_options.thread_count));
             m_image.clear();
 
             return {};
@@ -2651,6 +2780,7 @@ private:
     State m_state { State::NotDecoded };
 
     LittleEndianInputBitStream m_stream;
+    ImageDecoderOptions m_options;
     RefPtr<Gfx::Bitmap> m_bitmap;
 
     // JPEG XL images can be composed of multiples sub-images, this variable is an internal
@@ -2663,9 +2793,9 @@ private:
     ImageMetadata m_metadata;
 };
 
-JPEGXLImageDecoderPlugin::JPEGXLImageDecoderPlugin(NonnullOwnPtr<FixedMemoryStream> stream)
+JPEGXLImageDecoderPlugin::JPEGXLImageDecoderPlugin(NonnullOwnPtr<FixedMemoryStream> stream, ImageDecoderOptions options)
 {
-    m_context = make<JPEGXLLoadingContext>(move(stream));
+    m_context = make<JPEGXLLoadingContext>(move(stream), options);
 }
 
 JPEGXLImageDecoderPlugin::~JPEGXLImageDecoderPlugin() = default;
@@ -2683,9 +2813,14 @@ bool JPEGXLImageDecoderPlugin::sniff(ReadonlyBytes data)
 }
 
 ErrorOr<NonnullOwnPtr<ImageDecoderPlugin>> JPEGXLImageDecoderPlugin::create(ReadonlyBytes data)
+{
+    return create_with_options(data);
+}
+
+ErrorOr<NonnullOwnPtr<ImageDecoderPlugin>> JPEGXLImageDecoderPlugin::create_with_options(ReadonlyBytes data, ImageDecoderOptions options)
 {
     auto stream = TRY(try_make<FixedMemoryStream>(data));
-    auto plugin = TRY(adopt_nonnull_own_or_enomem(new (nothrow) JPEGXLImageDecoderPlugin(move(stream))));
+    auto plugin = TRY(adopt_nonnull_own_or_enomem(new (nothrow) JPEGXLImageDecoderPlugin(move(stream), options)));
     TRY(plugin->m_context->decode_image_header());
     return plugin;
 }
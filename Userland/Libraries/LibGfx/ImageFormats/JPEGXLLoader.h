@@ -17,6 +17,8 @@ class JPEGXLImageDecoderPlugin : public ImageDecoderPlugin {
 public:
     static bool sniff(ReadonlyBytes);
     static ErrorOr<NonnullOwnPtr<ImageDecoderPlugin>> create(ReadonlyBytes);
+    // The inverse transforms, upsampling and colour conversion can be run on bands of rows on several threads.
+    static ErrorOr<NonnullOwnPtr<ImageDecoderPlugin>> create_with_options(ReadonlyBytes, ImageDecoderOptions = {});
 
     virtual ~JPEGXLImageDecoderPlugin() override;
 
@@ -30,7 +32,7 @@ public:
     virtual ErrorOr<ImageFrameDescriptor> frame(size_t index, Optional<IntSize> ideal_size = {}) override;
 
 private:
-    JPEGXLImageDecoderPlugin(NonnullOwnPtr<FixedMemoryStream>);
+    JPEGXLImageDecoderPlugin(NonnullOwnPtr<FixedMemoryStream>, ImageDecoderOptions);
 
     OwnPtr<JPEGXLLoadingContext> m_context;
 };
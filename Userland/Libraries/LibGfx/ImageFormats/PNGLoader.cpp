@@ -7,13 +7,16 @@
 
 #include <AK/Debug.h>
 #include <AK/Endian.h>
+#include <AK/FixedArray.h>
 #include <AK/MemoryStream.h>
+#include <AK/SIMDExtras.h>
 #include <AK/Vector.h>
 #include <LibCompress/Zlib.h>
 #include <LibGfx/ImageFormats/PNGLoader.h>
 #include <LibGfx/ImageFormats/TIFFLoader.h>
 #include <LibGfx/ImageFormats/TIFFMetadata.h>
 #include <LibGfx/Painter.h>
+#include <LibThreading/Thread.h>
 
 namespace Gfx {
 
@@ -82,11 +85,6 @@ struct EmbeddedICCProfile {
     ReadonlyBytes compressed_data;
 };
 
-struct Scanline {
-    PNG::FilterType filter;
-    ReadonlyBytes data {};
-};
-
 struct [[gnu::packed]] PaletteEntry {
     u8 r;
     u8 g;
@@ -134,6 +132,9 @@ struct AnimationFrame {
     RefPtr<Bitmap> bitmap;
     ByteBuffer compressed_data;
 
+    // The frame's own pixels, when they have been decoded before the frame is composited onto the previous one.
+    RefPtr<Bitmap> decoded_bitmap;
+
     AnimationFrame(fcTL_Chunk const& fcTL)
         : fcTL(fcTL)
     {
@@ -164,6 +165,7 @@ struct PNGLoadingContext {
         BitmapDecoded,
     };
     State state { State::NotDecoded };
+    ImageDecoderOptions options;
     u8 const* data { nullptr };
     u8 const* data_current_ptr { nullptr };
     size_t data_size { 0 };
@@ -185,8 +187,6 @@ struct PNGLoadingContext {
     bool has_seen_idat_chunk { false };
     bool has_seen_actl_chunk_before_idat { false };
     bool has_alpha() const { return to_underlying(color_type) & 4 || palette_transparency_data.size() > 0; }
-    Vector<Scanline> scanlines;
-    ByteBuffer unfiltered_data;
     RefPtr<Gfx::Bitmap> bitmap;
     ByteBuffer compressed_data;
     Vector<PaletteEntry> palette_data;
@@ -202,21 +202,19 @@ struct PNGLoadingContext {
 
     OwnPtr<ExifMetadata> exif_metadata;
 
-    Checked<int> compute_row_size_for_width(int width)
+    Checked<int> compute_row_size_for_width(int width) const
     {
         Checked<int> row_size = width;
         row_size *= channels;
         row_size *= bit_depth;
         row_size += 7;
         row_size /= 8;
-        if (row_size.has_overflow()) {
+        if (row_size.has_overflow())
             dbgln("PNG too large, integer overflow while computing row size");
-            state = State::Error;
-        }
         return row_size;
     }
 
-    PNGLoadingContext create_subimage_context(int width, int height)
+    PNGLoadingContext create_subimage_context(int width, int height) const
     {
         PNGLoadingContext subimage_context;
         subimage_context.state = State::ChunksDecoded;
@@ -293,10 +291,62 @@ union [[gnu::packed]] Pixel {
 };
 static_assert(AssertSize<Pixel, 4>());
 
+// Unfilters a scanline one pixel at a time, with one SIMD lane per byte of the pixel.
+template<size_t bytes_per_pixel, PNG::FilterType filter>
+ALWAYS_INLINE static void unfilter_scanline_by_pixel(Bytes scanline_data, ReadonlyBytes previous_scanlines_data)
+{
+    static_assert(bytes_per_pixel <= sizeof(AK::SIMD::u8x4));
+
+    auto const load = [](u8 const* pixel) {
+        AK::SIMD::u8x4 value {};
+        __builtin_memcpy(&value, pixel, bytes_per_pixel);
+        return value;
+    };
+
+    AK::SIMD::u8x4 left {};
+    AK::SIMD::u8x4 upper_left {};
+    for (size_t i = 0; i + bytes_per_pixel <= scanline_data.size(); i += bytes_per_pixel) {
+        auto pixel = load(&scanline_data[i]);
+        auto const above = load(&previous_scanlines_data[i]);
+        if constexpr (filter == PNG::FilterType::Sub)
+            pixel += left;
+        else if constexpr (filter == PNG::FilterType::Average)
+            pixel += AK::SIMD::to_u8x4((AK::SIMD::to_u16x4(left) + AK::SIMD::to_u16x4(above)) / 2);
+        else if constexpr (filter == PNG::FilterType::Paeth)
+            pixel += PNG::paeth_predictor(left, above, upper_left);
+        __builtin_memcpy(&scanline_data[i], &pixel, bytes_per_pixel);
+        left = pixel;
+        upper_left = above;
+    }
+}
+
+template<size_t bytes_per_pixel>
+static void unfilter_scanline_by_pixel(PNG::FilterType filter, Bytes scanline_data, ReadonlyBytes previous_scanlines_data)
+{
+    switch (filter) {
+    case PNG::FilterType::Sub:
+        return unfilter_scanline_by_pixel<bytes_per_pixel, PNG::FilterType::Sub>(scanline_data, previous_scanlines_data);
+    case PNG::FilterType::Average:
+        return unfilter_scanline_by_pixel<bytes_per_pixel, PNG::FilterType::Average>(scanline_data, previous_scanlines_data);
+    case PNG::FilterType::Paeth:
+        return unfilter_scanline_by_pixel<bytes_per_pixel, PNG::FilterType::Paeth>(scanline_data, previous_scanlines_data);
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
+
 void PNGImageDecoderPlugin::unfilter_scanline(PNG::FilterType filter, Bytes scanline_data, ReadonlyBytes previous_scanlines_data, u8 bytes_per_complete_pixel)
 {
     // https://www.w3.org/TR/png-3/#9Filter-types
     // "Filters are applied to bytes, not to pixels, regardless of the bit depth or colour type of the image."
+    if (filter == PNG::FilterType::Sub || filter == PNG::FilterType::Average || filter == PNG::FilterType::Paeth) {
+        // These filters depend on the previous pixel, so the bytes of the common 8-bit RGB and RGBA pixels are done side by side.
+        if (bytes_per_complete_pixel == 3 && scanline_data.size() % 3 == 0)
+            return unfilter_scanline_by_pixel<3>(filter, scanline_data, previous_scanlines_data);
+        if (bytes_per_complete_pixel == 4 && scanline_data.size() % 4 == 0)
+            return unfilter_scanline_by_pixel<4>(filter, scanline_data, previous_scanlines_data);
+    }
+
     switch (filter) {
     case PNG::FilterType::None:
         break;
@@ -337,132 +387,82 @@ void PNGImageDecoderPlugin::unfilter_scanline(PNG::FilterType filter, Bytes scan
 }
 
 template<typename T>
-ALWAYS_INLINE static void unpack_grayscale_without_alpha(PNGLoadingContext& context)
+ALWAYS_INLINE static void unpack_grayscale_without_alpha(ReadonlyBytes scanline, Pixel* pixels, int width)
 {
-    for (int y = 0; y < context.height; ++y) {
-        auto* gray_values = reinterpret_cast<T const*>(context.scanlines[y].data.data());
-        for (int i = 0; i < context.width; ++i) {
-            auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-            pixel.r = gray_values[i];
-            pixel.g = gray_values[i];
-            pixel.b = gray_values[i];
-            pixel.a = 0xff;
-        }
+    auto* gray_values = reinterpret_cast<T const*>(scanline.data());
+    for (int i = 0; i < width; ++i) {
+        auto& pixel = pixels[i];
+        pixel.r = gray_values[i];
+        pixel.g = gray_values[i];
+        pixel.b = gray_values[i];
+        pixel.a = 0xff;
     }
 }
 
 template<typename T>
-ALWAYS_INLINE static void unpack_grayscale_with_alpha(PNGLoadingContext& context)
+ALWAYS_INLINE static void unpack_grayscale_with_alpha(ReadonlyBytes scanline, Pixel* pixels, int width)
 {
-    for (int y = 0; y < context.height; ++y) {
-        auto* tuples = reinterpret_cast<Tuple<T> const*>(context.scanlines[y].data.data());
-        for (int i = 0; i < context.width; ++i) {
-            auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-            pixel.r = tuples[i].gray;
-            pixel.g = tuples[i].gray;
-            pixel.b = tuples[i].gray;
-            pixel.a = tuples[i].a;
-        }
+    auto* tuples = reinterpret_cast<Tuple<T> const*>(scanline.data());
+    for (int i = 0; i < width; ++i) {
+        auto& pixel = pixels[i];
+        pixel.r = tuples[i].gray;
+        pixel.g = tuples[i].gray;
+        pixel.b = tuples[i].gray;
+        pixel.a = tuples[i].a;
     }
 }
 
 template<typename T>
-ALWAYS_INLINE static void unpack_triplets_without_alpha(PNGLoadingContext& context)
+ALWAYS_INLINE static void unpack_triplets_without_alpha(ReadonlyBytes scanline, Pixel* pixels, int width)
 {
-    for (int y = 0; y < context.height; ++y) {
-        auto* triplets = reinterpret_cast<Triplet<T> const*>(context.scanlines[y].data.data());
-        for (int i = 0; i < context.width; ++i) {
-            auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-            pixel.r = triplets[i].r;
-            pixel.g = triplets[i].g;
-            pixel.b = triplets[i].b;
-            pixel.a = 0xff;
-        }
+    auto* triplets = reinterpret_cast<Triplet<T> const*>(scanline.data());
+    for (int i = 0; i < width; ++i) {
+        auto& pixel = pixels[i];
+        pixel.r = triplets[i].r;
+        pixel.g = triplets[i].g;
+        pixel.b = triplets[i].b;
+        pixel.a = 0xff;
     }
 }
 
 template<typename T>
-ALWAYS_INLINE static void unpack_triplets_with_transparency_value(PNGLoadingContext& context, Triplet<T> transparency_value)
+ALWAYS_INLINE static void unpack_triplets_with_transparency_value(ReadonlyBytes scanline, Pixel* pixels, int width, Triplet<T> transparency_value)
 {
-    for (int y = 0; y < context.height; ++y) {
-        auto* triplets = reinterpret_cast<Triplet<T> const*>(context.scanlines[y].data.data());
-        for (int i = 0; i < context.width; ++i) {
-            auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-            pixel.r = triplets[i].r;
-            pixel.g = triplets[i].g;
-            pixel.b = triplets[i].b;
-            if (triplets[i] == transparency_value)
-                pixel.a = 0x00;
-            else
-                pixel.a = 0xff;
-        }
+    auto* triplets = reinterpret_cast<Triplet<T> const*>(scanline.data());
+    for (int i = 0; i < width; ++i) {
+        auto& pixel = pixels[i];
+        pixel.r = triplets[i].r;
+        pixel.g = triplets[i].g;
+        pixel.b = triplets[i].b;
+        if (triplets[i] == transparency_value)
+            pixel.a = 0x00;
+        else
+            pixel.a = 0xff;
     }
 }
 
-NEVER_INLINE FLATTEN static ErrorOr<void> unfilter(PNGLoadingContext& context)
+// Unpacks an unfiltered scanline to BGRA.
+NEVER_INLINE FLATTEN static ErrorOr<void> unpack_scanline(PNGLoadingContext const& context, ReadonlyBytes scanline, Pixel* pixels, int width)
 {
-    // First unfilter the scanlines:
-
-    // FIXME: Instead of creating a separate buffer for the scanlines that need to be
-    //        mutated, the mutation could be done in place (if the data was non-const).
-    size_t bytes_per_scanline = context.scanlines[0].data.size();
-    size_t bytes_needed_for_all_unfiltered_scanlines = 0;
-    for (int y = 0; y < context.height; ++y) {
-        if (context.scanlines[y].filter != PNG::FilterType::None) {
-            bytes_needed_for_all_unfiltered_scanlines += bytes_per_scanline;
-        }
-    }
-    context.unfiltered_data = TRY(ByteBuffer::create_uninitialized(bytes_needed_for_all_unfiltered_scanlines));
-
-    // From section 6.3 of http://www.libpng.org/pub/png/spec/1.2/PNG-Filters.html
-    // "bpp is defined as the number of bytes per complete pixel, rounding up to one.
-    // For example, for color type 2 with a bit depth of 16, bpp is equal to 6
-    // (three samples, two bytes per sample); for color type 0 with a bit depth of 2,
-    // bpp is equal to 1 (rounding up); for color type 4 with a bit depth of 16, bpp
-    // is equal to 4 (two-byte grayscale sample, plus two-byte alpha sample)."
-    u8 bytes_per_complete_pixel = ceil_div(context.bit_depth, (u8)8) * context.channels;
-
-    u8 dummy_scanline_bytes[bytes_per_scanline];
-    memset(dummy_scanline_bytes, 0, sizeof(dummy_scanline_bytes));
-    auto previous_scanlines_data = ReadonlyBytes { dummy_scanline_bytes, sizeof(dummy_scanline_bytes) };
-
-    for (int y = 0, data_start = 0; y < context.height; ++y) {
-        if (context.scanlines[y].filter != PNG::FilterType::None) {
-            auto scanline_data_slice = context.unfiltered_data.bytes().slice(data_start, bytes_per_scanline);
-
-            // Copy the current values over and set the scanline's data to the to-be-mutated slice
-            context.scanlines[y].data.copy_to(scanline_data_slice);
-            context.scanlines[y].data = scanline_data_slice;
-
-            PNGImageDecoderPlugin::unfilter_scanline(context.scanlines[y].filter, scanline_data_slice, previous_scanlines_data, bytes_per_complete_pixel);
-
-            data_start += bytes_per_scanline;
-        }
-        previous_scanlines_data = context.scanlines[y].data;
-    }
-
-    // Now unpack the scanlines to RGBA:
     switch (context.color_type) {
     case PNG::ColorType::Greyscale:
         if (context.bit_depth == 8) {
-            unpack_grayscale_without_alpha<u8>(context);
+            unpack_grayscale_without_alpha<u8>(scanline, pixels, width);
         } else if (context.bit_depth == 16) {
-            unpack_grayscale_without_alpha<u16>(context);
+            unpack_grayscale_without_alpha<u16>(scanline, pixels, width);
         } else if (context.bit_depth == 1 || context.bit_depth == 2 || context.bit_depth == 4) {
             auto bit_depth_squared = context.bit_depth * context.bit_depth;
             auto pixels_per_byte = 8 / context.bit_depth;
             auto mask = (1 << context.bit_depth) - 1;
-            for (int y = 0; y < context.height; ++y) {
-                auto* gray_values = context.scanlines[y].data.data();
-                for (int x = 0; x < context.width; ++x) {
-                    auto bit_offset = (8 - context.bit_depth) - (context.bit_depth * (x % pixels_per_byte));
-                    auto value = (gray_values[x / pixels_per_byte] >> bit_offset) & mask;
-                    auto& pixel = (Pixel&)context.bitmap->scanline(y)[x];
-                    pixel.r = value * (0xff / bit_depth_squared);
-                    pixel.g = value * (0xff / bit_depth_squared);
-                    pixel.b = value * (0xff / bit_depth_squared);
-                    pixel.a = 0xff;
-                }
+            auto* gray_values = scanline.data();
+            for (int x = 0; x < width; ++x) {
+                auto bit_offset = (8 - context.bit_depth) - (context.bit_depth * (x % pixels_per_byte));
+                auto value = (gray_values[x / pixels_per_byte] >> bit_offset) & mask;
+                auto& pixel = pixels[x];
+                pixel.r = value * (0xff / bit_depth_squared);
+                pixel.g = value * (0xff / bit_depth_squared);
+                pixel.b = value * (0xff / bit_depth_squared);
+                pixel.a = 0xff;
             }
         } else {
             VERIFY_NOT_REACHED();
@@ -470,9 +470,9 @@ NEVER_INLINE FLATTEN static ErrorOr<void> unfilter(PNGLoadingContext& context)
         break;
     case PNG::ColorType::GreyscaleWithAlpha:
         if (context.bit_depth == 8) {
-            unpack_grayscale_with_alpha<u8>(context);
+            unpack_grayscale_with_alpha<u8>(scanline, pixels, width);
         } else if (context.bit_depth == 16) {
-            unpack_grayscale_with_alpha<u16>(context);
+            unpack_grayscale_with_alpha<u16>(scanline, pixels, width);
         } else {
             VERIFY_NOT_REACHED();
         }
@@ -480,39 +480,35 @@ NEVER_INLINE FLATTEN static ErrorOr<void> unfilter(PNGLoadingContext& context)
     case PNG::ColorType::Truecolor:
         if (context.palette_transparency_data.size() == 6) {
             if (context.bit_depth == 8) {
-                unpack_triplets_with_transparency_value<u8>(context, Triplet<u8> { context.palette_transparency_data[0], context.palette_transparency_data[2], context.palette_transparency_data[4] });
+                unpack_triplets_with_transparency_value<u8>(scanline, pixels, width, Triplet<u8> { context.palette_transparency_data[0], context.palette_transparency_data[2], context.palette_transparency_data[4] });
             } else if (context.bit_depth == 16) {
                 u16 tr = context.palette_transparency_data[0] | context.palette_transparency_data[1] << 8;
                 u16 tg = context.palette_transparency_data[2] | context.palette_transparency_data[3] << 8;
                 u16 tb = context.palette_transparency_data[4] | context.palette_transparency_data[5] << 8;
-                unpack_triplets_with_transparency_value<u16>(context, Triplet<u16> { tr, tg, tb });
+                unpack_triplets_with_transparency_value<u16>(scanline, pixels, width, Triplet<u16> { tr, tg, tb });
             } else {
                 VERIFY_NOT_REACHED();
             }
         } else {
             if (context.bit_depth == 8)
-                unpack_triplets_without_alpha<u8>(context);
+                unpack_triplets_without_alpha<u8>(scanline, pixels, width);
             else if (context.bit_depth == 16)
-                unpack_triplets_without_alpha<u16>(context);
+                unpack_triplets_without_alpha<u16>(scanline, pixels, width);
             else
                 VERIFY_NOT_REACHED();
         }
         break;
     case PNG::ColorType::TruecolorWithAlpha:
         if (context.bit_depth == 8) {
-            for (int y = 0; y < context.height; ++y) {
-                memcpy(context.bitmap->scanline(y), context.scanlines[y].data.data(), context.scanlines[y].data.size());
-            }
+            memcpy(pixels, scanline.data(), scanline.size());
         } else if (context.bit_depth == 16) {
-            for (int y = 0; y < context.height; ++y) {
-                auto* quartets = reinterpret_cast<Quartet<u16> const*>(context.scanlines[y].data.data());
-                for (int i = 0; i < context.width; ++i) {
-                    auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-                    pixel.r = quartets[i].r & 0xFF;
-                    pixel.g = quartets[i].g & 0xFF;
-                    pixel.b = quartets[i].b & 0xFF;
-                    pixel.a = quartets[i].a & 0xFF;
-                }
+            auto* quartets = reinterpret_cast<Quartet<u16> const*>(scanline.data());
+            for (int i = 0; i < width; ++i) {
+                auto& pixel = pixels[i];
+                pixel.r = quartets[i].r & 0xFF;
+                pixel.g = quartets[i].g & 0xFF;
+                pixel.b = quartets[i].b & 0xFF;
+                pixel.a = quartets[i].a & 0xFF;
             }
         } else {
             VERIFY_NOT_REACHED();
@@ -520,42 +516,38 @@ NEVER_INLINE FLATTEN static ErrorOr<void> unfilter(PNGLoadingContext& context)
         break;
     case PNG::ColorType::IndexedColor:
         if (context.bit_depth == 8) {
-            for (int y = 0; y < context.height; ++y) {
-                auto* palette_index = context.scanlines[y].data.data();
-                for (int i = 0; i < context.width; ++i) {
-                    auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-                    if (palette_index[i] >= context.palette_data.size())
-                        return Error::from_string_literal("PNGImageDecoderPlugin: Palette index out of range");
-                    auto& color = context.palette_data.at((int)palette_index[i]);
-                    auto transparency = context.palette_transparency_data.size() >= palette_index[i] + 1u
-                        ? context.palette_transparency_data[palette_index[i]]
-                        : 0xff;
-                    pixel.r = color.r;
-                    pixel.g = color.g;
-                    pixel.b = color.b;
-                    pixel.a = transparency;
-                }
+            auto* palette_index = scanline.data();
+            for (int i = 0; i < width; ++i) {
+                auto& pixel = pixels[i];
+                if (palette_index[i] >= context.palette_data.size())
+                    return Error::from_string_literal("PNGImageDecoderPlugin: Palette index out of range");
+                auto& color = context.palette_data.at((int)palette_index[i]);
+                auto transparency = context.palette_transparency_data.size() >= palette_index[i] + 1u
+                    ? context.palette_transparency_data[palette_index[i]]
+                    : 0xff;
+                pixel.r = color.r;
+                pixel.g = color.g;
+                pixel.b = color.b;
+                pixel.a = transparency;
             }
         } else if (context.bit_depth == 1 || context.bit_depth == 2 || context.bit_depth == 4) {
             auto pixels_per_byte = 8 / context.bit_depth;
             auto mask = (1 << context.bit_depth) - 1;
-            for (int y = 0; y < context.height; ++y) {
-                auto* palette_indices = context.scanlines[y].data.data();
-                for (int i = 0; i < context.width; ++i) {
-                    auto bit_offset = (8 - context.bit_depth) - (context.bit_depth * (i % pixels_per_byte));
-                    auto palette_index = (palette_indices[i / pixels_per_byte] >> bit_offset) & mask;
-                    auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-                    if ((size_t)palette_index >= context.palette_data.size())
-                        return Error::from_string_literal("PNGImageDecoderPlugin: Palette index out of range");
-                    auto& color = context.palette_data.at(palette_index);
-                    auto transparency = context.palette_transparency_data.size() >= palette_index + 1u
-                        ? context.palette_transparency_data[palette_index]
-                        : 0xff;
-                    pixel.r = color.r;
-                    pixel.g = color.g;
-                    pixel.b = color.b;
-                    pixel.a = transparency;
-                }
+            auto* palette_indices = scanline.data();
+            for (int i = 0; i < width; ++i) {
+                auto bit_offset = (8 - context.bit_depth) - (context.bit_depth * (i % pixels_per_byte));
+                auto palette_index = (palette_indices[i / pixels_per_byte] >> bit_offset) & mask;
+                auto& pixel = pixels[i];
+                if ((size_t)palette_index >= context.palette_data.size())
+                    return Error::from_string_literal("PNGImageDecoderPlugin: Palette index out of range");
+                auto& color = context.palette_data.at(palette_index);
+                auto transparency = context.palette_transparency_data.size() >= palette_index + 1u
+                    ? context.palette_transparency_data[palette_index]
+                    : 0xff;
+                pixel.r = color.r;
+                pixel.g = color.g;
+                pixel.b = color.b;
+                pixel.a = transparency;
             }
         } else {
             VERIFY_NOT_REACHED();
@@ -567,12 +559,46 @@ NEVER_INLINE FLATTEN static ErrorOr<void> unfilter(PNGLoadingContext& context)
     }
 
     // Swap r and b values:
-    for (int y = 0; y < context.height; ++y) {
-        auto* pixels = (Pixel*)context.bitmap->scanline(y);
-        for (int i = 0; i < context.bitmap->width(); ++i) {
-            auto& x = pixels[i];
-            swap(x.r, x.b);
-        }
+    for (int i = 0; i < width; ++i) {
+        auto& x = pixels[i];
+        swap(x.r, x.b);
+    }
+
+    return {};
+}
+
+// Inflates and unfilters the scanlines of a (sub)image one at a time, so that only two of them are in memory at once.
+// unpack_row() is called with the number and the unfiltered data of every scanline.
+template<typename Callback>
+static ErrorOr<void> decode_scanlines(PNGLoadingContext const& context, Stream& decompressor, int width, int height, Callback unpack_row)
+{
+    auto row_size = context.compute_row_size_for_width(width);
+    if (row_size.has_overflow())
+        return Error::from_string_literal("PNGImageDecoderPlugin: Row size overflow");
+
+    // From section 6.3 of http://www.libpng.org/pub/png/spec/1.2/PNG-Filters.html
+    // "bpp is defined as the number of bytes per complete pixel, rounding up to one.
+    // For example, for color type 2 with a bit depth of 16, bpp is equal to 6
+    // (three samples, two bytes per sample); for color type 0 with a bit depth of 2,
+    // bpp is equal to 1 (rounding up); for color type 4 with a bit depth of 16, bpp
+    // is equal to 4 (two-byte grayscale sample, plus two-byte alpha sample)."
+    u8 bytes_per_complete_pixel = ceil_div(context.bit_depth, (u8)8) * context.channels;
+
+    // The filters treat the scanline before the first one as all zeroes.
+    auto previous_scanline = TRY(ByteBuffer::create_zeroed(row_size.value()));
+    auto scanline = TRY(ByteBuffer::create_uninitialized(row_size.value()));
+
+    for (int y = 0; y < height; ++y) {
+        u8 filter_byte;
+        if (decompressor.read_until_filled({ &filter_byte, 1 }).is_error() || decompressor.read_until_filled(scanline).is_error())
+            return Error::from_string_literal("PNGImageDecoderPlugin: Decoding failed");
+
+        auto filter = TRY(PNG::filter_type(filter_byte));
+        PNGImageDecoderPlugin::unfilter_scanline(filter, scanline, previous_scanline, bytes_per_complete_pixel);
+
+        TRY(unpack_row(y, scanline.bytes()));
+
+        swap(scanline, previous_scanline);
     }
 
     return {};
@@ -696,36 +722,12 @@ static bool decode_png_chunks(PNGLoadingContext& context)
     return true;
 }
 
-static ErrorOr<void> decode_png_bitmap_simple(PNGLoadingContext& context, ByteBuffer& decompression_buffer)
+static ErrorOr<void> decode_png_bitmap_simple(PNGLoadingContext& context, Stream& decompressor)
 {
-    Streamer streamer(decompression_buffer.data(), decompression_buffer.size());
-
-    for (int y = 0; y < context.height; ++y) {
-        u8 filter_byte;
-        if (!streamer.read(filter_byte)) {
-            context.state = PNGLoadingContext::State::Error;
-            return Error::from_string_literal("PNGImageDecoderPlugin: Decoding failed");
-        }
-
-        if (filter_byte > 4) {
-            context.state = PNGLoadingContext::State::Error;
-            return Error::from_string_literal("PNGImageDecoderPlugin: Invalid PNG filter");
-        }
-
-        context.scanlines.append({ MUST(PNG::filter_type(filter_byte)) });
-        auto& scanline_buffer = context.scanlines.last().data;
-        auto row_size = context.compute_row_size_for_width(context.width);
-        if (row_size.has_overflow())
-            return Error::from_string_literal("PNGImageDecoderPlugin: Row size overflow");
-
-        if (!streamer.wrap_bytes(scanline_buffer, row_size.value())) {
-            context.state = PNGLoadingContext::State::Error;
-            return Error::from_string_literal("PNGImageDecoderPlugin: Decoding failed");
-        }
-    }
-
     context.bitmap = TRY(Bitmap::create(context.has_alpha() ? BitmapFormat::BGRA8888 : BitmapFormat::BGRx8888, { context.width, context.height }));
-    return unfilter(context);
+    return decode_scanlines(context, decompressor, context.width, context.height, [&](int y, ReadonlyBytes scanline) {
+        return unpack_scanline(context, scanline, reinterpret_cast<Pixel*>(context.bitmap->scanline(y)), context.width);
+    });
 }
 
 static int adam7_height(PNGLoadingContext& context, int pass)
@@ -778,56 +780,65 @@ static int adam7_startx[8] = { 0, 0, 4, 0, 2, 0, 1, 0 };
 static int adam7_stepy[8] = { 1, 8, 8, 8, 4, 4, 2, 2 };
 static int adam7_stepx[8] = { 1, 8, 8, 4, 4, 2, 2, 1 };
 
-static ErrorOr<void> decode_adam7_pass(PNGLoadingContext& context, Streamer& streamer, int pass)
+static ErrorOr<void> decode_adam7_pass(PNGLoadingContext& context, Stream& decompressor, int pass)
 {
-    auto subimage_context = context.create_subimage_context(adam7_width(context, pass), adam7_height(context, pass));
+    auto width = adam7_width(context, pass);
+    auto height = adam7_height(context, pass);
 
     // For small images, some passes might be empty
-    if (!subimage_context.width || !subimage_context.height)
+    if (!width || !height)
         return {};
 
-    for (int y = 0; y < subimage_context.height; ++y) {
-        u8 filter_byte;
-        if (!streamer.read(filter_byte)) {
-            context.state = PNGLoadingContext::State::Error;
-            return Error::from_string_literal("PNGImageDecoderPlugin: Decoding failed");
-        }
+    auto pixels = TRY(FixedArray<Pixel>::create(width));
+    return decode_scanlines(context, decompressor, width, height, [&](int y, ReadonlyBytes scanline) -> ErrorOr<void> {
+        TRY(unpack_scanline(context, scanline, pixels.data(), width));
+
+        // Copy the subimage data into the main image according to the pass pattern
+        auto dy = adam7_starty[pass] + y * adam7_stepy[pass];
+        if (dy >= context.height)
+            return {};
+        auto* destination = reinterpret_cast<Pixel*>(context.bitmap->scanline(dy));
+        for (int x = 0, dx = adam7_startx[pass]; x < width && dx < context.width; ++x, dx += adam7_stepx[pass])
+            destination[dx] = pixels[x];
+        return {};
+    });
+}
 
-        if (filter_byte > 4) {
-            context.state = PNGLoadingContext::State::Error;
-            return Error::from_string_literal("PNGImageDecoderPlugin: Invalid PNG filter");
-        }
+// While an interlaced image is incomplete, every pixel of a pass also covers the pixels to its right and below that the following passes haven't decoded yet.
+static int adam7_block_width[8] = { 1, 8, 4, 4, 2, 2, 1, 1 };
+static int adam7_block_height[8] = { 1, 8, 8, 4, 4, 2, 2, 1 };
 
-        subimage_context.scanlines.append({ MUST(PNG::filter_type(filter_byte)) });
-        auto& scanline_buffer = subimage_context.scanlines.last().data;
+static ErrorOr<void> decode_partial_adam7_pass(PNGLoadingContext& context, Stream& decompressor, int pass, PartialImageFrameDescriptor& frame)
+{
+    auto width = adam7_width(context, pass);
+    auto height = adam7_height(context, pass);
 
-        auto row_size = context.compute_row_size_for_width(subimage_context.width);
-        if (row_size.has_overflow())
-            return Error::from_string_literal("PNGImageDecoderPlugin: Row size overflow");
-        if (!streamer.wrap_bytes(scanline_buffer, row_size.value())) {
-            context.state = PNGLoadingContext::State::Error;
-            return Error::from_string_literal("PNGImageDecoderPlugin: Decoding failed");
-        }
-    }
+    if (!width || !height)
+        return {};
 
-    subimage_context.bitmap = TRY(Bitmap::create(context.bitmap->format(), { subimage_context.width, subimage_context.height }));
-    TRY(unfilter(subimage_context));
+    auto pixels = TRY(FixedArray<Pixel>::create(width));
+    return decode_scanlines(context, decompressor, width, height, [&](int y, ReadonlyBytes scanline) -> ErrorOr<void> {
+        TRY(unpack_scanline(context, scanline, pixels.data(), width));
 
-    // Copy the subimage data into the main image according to the pass pattern
-    for (int y = 0, dy = adam7_starty[pass]; y < subimage_context.height && dy < context.height; ++y, dy += adam7_stepy[pass]) {
-        for (int x = 0, dx = adam7_startx[pass]; x < subimage_context.width && dx < context.width; ++x, dx += adam7_stepx[pass]) {
-            context.bitmap->set_pixel(dx, dy, subimage_context.bitmap->get_pixel(x, y));
+        auto dy = adam7_starty[pass] + y * adam7_stepy[pass];
+        for (int block_y = dy; block_y < min(dy + adam7_block_height[pass], context.height); ++block_y) {
+            auto* destination = reinterpret_cast<Pixel*>(context.bitmap->scanline(block_y));
+            for (int x = 0, dx = adam7_startx[pass]; x < width && dx < context.width; ++x, dx += adam7_stepx[pass]) {
+                for (int block_x = dx; block_x < min(dx + adam7_block_width[pass], context.width); ++block_x)
+                    destination[block_x] = pixels[x];
+            }
         }
-    }
-    return {};
+
+        frame.decoded_rows_of_current_pass = min(dy + adam7_stepy[pass], context.height);
+        return {};
+    });
 }
 
-static ErrorOr<void> decode_png_adam7(PNGLoadingContext& context, ByteBuffer& decompression_buffer)
+static ErrorOr<void> decode_png_adam7(PNGLoadingContext& context, Stream& decompressor)
 {
-    Streamer streamer(decompression_buffer.data(), decompression_buffer.size());
     context.bitmap = TRY(Bitmap::create(context.has_alpha() ? BitmapFormat::BGRA8888 : BitmapFormat::BGRx8888, { context.width, context.height }));
     for (int pass = 1; pass <= 7; ++pass)
-        TRY(decode_adam7_pass(context, streamer, pass));
+        TRY(decode_adam7_pass(context, decompressor, pass));
     return {};
 }
 
@@ -844,39 +855,70 @@ static ErrorOr<void> decode_png_bitmap(PNGLoadingContext& context)
     if (context.color_type == PNG::ColorType::IndexedColor && context.palette_data.is_empty())
         return Error::from_string_literal("PNGImageDecoderPlugin: Didn't see a PLTE chunk for a palletized image, or it was empty.");
 
-    auto compressed_data_stream = make<FixedMemoryStream>(context.compressed_data.span());
-    auto decompressor_or_error = Compress::ZlibDecompressor::create(move(compressed_data_stream));
-    if (decompressor_or_error.is_error()) {
-        context.state = PNGLoadingContext::State::Error;
-        return decompressor_or_error.release_error();
-    }
-    auto decompressor = decompressor_or_error.release_value();
-    auto result_or_error = decompressor->read_until_eof();
-    if (result_or_error.is_error()) {
+    auto result = [&]() -> ErrorOr<void> {
+        // The image data is inflated while it's being unfiltered, so the whole decompressed image never needs to be in memory.
+        auto compressed_data_stream = make<FixedMemoryStream>(context.compressed_data.span());
+        auto decompressor = TRY(Compress::ZlibDecompressor::create(move(compressed_data_stream)));
+
+        switch (context.interlace_method) {
+        case PngInterlaceMethod::Null:
+            return decode_png_bitmap_simple(context, *decompressor);
+        case PngInterlaceMethod::Adam7:
+            return decode_png_adam7(context, *decompressor);
+        default:
+            return Error::from_string_literal("PNGImageDecoderPlugin: Invalid interlace method");
+        }
+    }();
+    if (result.is_error()) {
         context.state = PNGLoadingContext::State::Error;
-        return result_or_error.release_error();
+        return result.release_error();
     }
-    auto decompression_buffer = result_or_error.release_value();
     context.compressed_data.clear();
 
-    context.scanlines.ensure_capacity(context.height);
+    context.state = PNGLoadingContext::State::BitmapDecoded;
+    return {};
+}
+
+// Decodes as many rows as possible from the image data chunks that have been fully received.
+static ErrorOr<PartialImageFrameDescriptor> decode_partial_png_bitmap(PNGLoadingContext& context)
+{
+    if (context.color_type == PNG::ColorType::IndexedColor && context.palette_data.is_empty())
+        return Error::from_string_literal("PNGImageDecoderPlugin: No PLTE chunk yet");
+
+    PartialImageFrameDescriptor frame;
+
+    // The rows that haven't been decoded yet are transparent.
+    context.bitmap = TRY(Bitmap::create(BitmapFormat::BGRA8888, { context.width, context.height }));
+    frame.image = context.bitmap;
+
+    auto compressed_data_stream = make<FixedMemoryStream>(context.compressed_data.span());
+    auto decompressor = TRY(Compress::ZlibDecompressor::create(move(compressed_data_stream)));
+
+    // Decoding stops with an error once the image data runs out, which is expected here.
     switch (context.interlace_method) {
     case PngInterlaceMethod::Null:
-        TRY(decode_png_bitmap_simple(context, decompression_buffer));
+        (void)decode_scanlines(context, *decompressor, context.width, context.height, [&](int y, ReadonlyBytes scanline) -> ErrorOr<void> {
+            TRY(unpack_scanline(context, scanline, reinterpret_cast<Pixel*>(context.bitmap->scanline(y)), context.width));
+            frame.decoded_rows_of_current_pass = y + 1;
+            return {};
+        });
         break;
     case PngInterlaceMethod::Adam7:
-        TRY(decode_png_adam7(context, decompression_buffer));
+        for (int pass = 1; pass <= 7; ++pass) {
+            frame.decoded_rows_of_current_pass = 0;
+            if (decode_partial_adam7_pass(context, *decompressor, pass, frame).is_error())
+                break;
+            frame.decoded_passes = pass;
+        }
         break;
     default:
-        context.state = PNGLoadingContext::State::Error;
         return Error::from_string_literal("PNGImageDecoderPlugin: Invalid interlace method");
     }
 
-    context.state = PNGLoadingContext::State::BitmapDecoded;
-    return {};
+    return frame;
 }
 
-static ErrorOr<RefPtr<Bitmap>> decode_png_animation_frame_bitmap(PNGLoadingContext& context, AnimationFrame& animation_frame)
+static ErrorOr<NonnullRefPtr<Bitmap>> decode_png_animation_frame_bitmap(PNGLoadingContext const& context, AnimationFrame const& animation_frame)
 {
     if (context.color_type == PNG::ColorType::IndexedColor && context.palette_data.is_empty())
         return Error::from_string_literal("PNGImageDecoderPlugin: Didn't see a PLTE chunk for a palletized image, or it was empty.");
@@ -888,23 +930,74 @@ static ErrorOr<RefPtr<Bitmap>> decode_png_animation_frame_bitmap(PNGLoadingConte
 
     auto compressed_data_stream = make<FixedMemoryStream>(animation_frame.compressed_data.span());
     auto decompressor = TRY(Compress::ZlibDecompressor::create(move(compressed_data_stream)));
-    auto decompression_buffer = TRY(decompressor->read_until_eof());
-    frame_context.compressed_data.clear();
 
-    frame_context.scanlines.ensure_capacity(frame_context.height);
     switch (context.interlace_method) {
     case PngInterlaceMethod::Null:
-        TRY(decode_png_bitmap_simple(frame_context, decompression_buffer));
+        TRY(decode_png_bitmap_simple(frame_context, *decompressor));
         break;
     case PngInterlaceMethod::Adam7:
-        TRY(decode_png_adam7(frame_context, decompression_buffer));
+        TRY(decode_png_adam7(frame_context, *decompressor));
         break;
     default:
         return Error::from_string_literal("PNGImageDecoderPlugin: Invalid interlace method");
     }
 
-    context.state = PNGLoadingContext::State::BitmapDecoded;
-    return move(frame_context.bitmap);
+    return frame_context.bitmap.release_nonnull();
+}
+
+// Decodes the pixels of the given animation frame. With several threads, the frames after it that are already
+// in memory are decoded as well, as they don't depend on each other until they are composited.
+static ErrorOr<void> decode_animation_frame_bitmaps(PNGLoadingContext& context, size_t first_frame_index)
+{
+    size_t end_frame_index = first_frame_index + 1;
+    if (context.options.thread_count > 1 && context.last_completed_animation_frame_index.has_value()) {
+        // Once all chunks have been read, the last completed index is one past the last frame.
+        auto frames_in_memory = min<size_t>(context.last_completed_animation_frame_index.value() + 1, context.animation_frames.size());
+        end_frame_index = max(end_frame_index, min(first_frame_index + context.options.thread_count, frames_in_memory));
+    }
+
+    Vector<Optional<ErrorOr<NonnullRefPtr<Bitmap>>>> results;
+    TRY(results.try_resize(end_frame_index - first_frame_index));
+
+    auto decode_frame = [&context, &results, first_frame_index](size_t frame_index) {
+        auto const& animation_frame = context.animation_frames[frame_index];
+        results[frame_index - first_frame_index] = decode_png_animation_frame_bitmap(context, animation_frame);
+    };
+
+    // The requested frame is decoded on this thread, while the others are decoded on threads of their own.
+    Vector<NonnullRefPtr<Threading::Thread>> threads;
+    TRY(threads.try_ensure_capacity(results.size() - 1));
+    for (size_t frame_index = first_frame_index + 1; frame_index < end_frame_index; ++frame_index) {
+        if (context.animation_frames[frame_index].decoded_bitmap)
+            continue;
+        auto thread = Threading::Thread::construct([frame_index, &decode_frame]() -> intptr_t {
+            decode_frame(frame_index);
+            return 0;
+        },
+            "PNGDecoder"sv);
+        thread->start();
+        threads.unchecked_append(move(thread));
+    }
+
+    decode_frame(first_frame_index);
+
+    for (auto& thread : threads)
+        (void)thread->join();
+
+    // Only the requested frame has to decode successfully, the others will be decoded again when they are needed.
+    for (size_t frame_index = first_frame_index; frame_index < end_frame_index; ++frame_index) {
+        auto& result = results[frame_index - first_frame_index];
+        if (!result.has_value())
+            continue;
+        if (result->is_error()) {
+            if (frame_index == first_frame_index)
+                return result->release_error();
+            continue;
+        }
+        context.animation_frames[frame_index].decoded_bitmap = result->release_value();
+    }
+
+    return {};
 }
 
 static bool is_valid_compression_method(u8 compression_method)
@@ -1252,9 +1345,10 @@ static ErrorOr<void> process_chunk(Streamer& streamer, PNGLoadingContext& contex
     return {};
 }
 
-PNGImageDecoderPlugin::PNGImageDecoderPlugin(u8 const* data, size_t size)
+PNGImageDecoderPlugin::PNGImageDecoderPlugin(u8 const* data, size_t size, ImageDecoderOptions options)
 {
     m_context = make<PNGLoadingContext>();
+    m_context->options = options;
     m_context->data = m_context->data_current_ptr = data;
     m_context->data_size = size;
 }
@@ -1306,7 +1400,12 @@ bool PNGImageDecoderPlugin::sniff(ReadonlyBytes data)
 
 ErrorOr<NonnullOwnPtr<ImageDecoderPlugin>> PNGImageDecoderPlugin::create(ReadonlyBytes data)
 {
-    auto plugin = TRY(adopt_nonnull_own_or_enomem(new (nothrow) PNGImageDecoderPlugin(data.data(), data.size())));
+    return create_with_options(data);
+}
+
+ErrorOr<NonnullOwnPtr<ImageDecoderPlugin>> PNGImageDecoderPlugin::create_with_options(ReadonlyBytes data, ImageDecoderOptions options)
+{
+    auto plugin = TRY(adopt_nonnull_own_or_enomem(new (nothrow) PNGImageDecoderPlugin(data.data(), data.size(), options)));
     if (!decode_png_header(*plugin->m_context))
         return Error::from_string_literal("Invalid header for a PNG file");
     TRY(decode_png_ihdr(*plugin->m_context));
@@ -1431,12 +1530,14 @@ ErrorOr<ImageFrameDescriptor> PNGImageDecoderPlugin::frame(size_t index, Optiona
             auto& animation_frame = m_context->animation_frames[i];
             animation_frame.bitmap = m_context->bitmap;
         } else {
+            if (!m_context->animation_frames[i].decoded_bitmap)
+                TRY(decode_animation_frame_bitmaps(*m_context, i));
+
             auto& animation_frame = m_context->animation_frames[i];
             VERIFY(!animation_frame.bitmap);
+            auto decoded_bitmap = animation_frame.decoded_bitmap.release_nonnull();
 
-            auto decoded_bitmap = TRY(decode_png_animation_frame_bitmap(*m_context, animation_frame));
-
-            auto prev_animation_frame = m_context->animation_frames[i - 1];
+            auto const& prev_animation_frame = m_context->animation_frames[i - 1];
             animation_frame.bitmap = TRY(render_animation_frame(prev_animation_frame, animation_frame, *decoded_bitmap));
         }
         m_context->animation_next_frame_to_render = i + 1;
@@ -1450,6 +1551,38 @@ ErrorOr<ImageFrameDescriptor> PNGImageDecoderPlugin::frame(size_t index, Optiona
     return descriptor;
 }
 
+ErrorOr<PartialImageFrameDescriptor> PNGImageDecoderPlugin::partial_first_frame()
+{
+    if (m_context->state == PNGLoadingContext::State::Error)
+        return Error::from_string_literal("PNGImageDecoderPlugin: Decoding failed");
+
+    // This stops at the first chunk that was cut short.
+    if (!decode_png_chunks(*m_context))
+        return Error::from_string_literal("PNGImageDecoderPlugin: Decoding failed");
+
+    if (m_context->has_seen_iend) {
+        PartialImageFrameDescriptor frame;
+        frame.image = TRY(this->frame(0)).image;
+        frame.decoded_passes = m_context->interlace_method == PngInterlaceMethod::Adam7 ? 7 : 1;
+        frame.is_complete = true;
+        return frame;
+    }
+
+    // The image data chunk that was cut short still has rows that can be shown.
+    size_t data_remaining = m_context->data_size - (m_context->data_current_ptr - m_context->data);
+    Streamer streamer(m_context->data_current_ptr, data_remaining);
+    u32 chunk_size;
+    Array<u8, 4> chunk_type_buffer;
+    if (streamer.read(chunk_size) && streamer.read_bytes(chunk_type_buffer.data(), chunk_type_buffer.size()) && StringView { chunk_type_buffer.span() } == "IDAT"sv)
+        m_context->compressed_data.append(streamer.current_data_ptr(), min<size_t>(chunk_size, data_remaining - 8));
+
+    auto frame = decode_partial_png_bitmap(*m_context);
+
+    // The bitmap is incomplete, so it can't be used as the first frame of the image.
+    m_context->state = PNGLoadingContext::State::Error;
+    return frame;
+}
+
 Optional<Metadata const&> PNGImageDecoderPlugin::metadata()
 {
     if (m_context->exif_metadata)
@@ -17,6 +17,8 @@ class PNGImageDecoderPlugin final : public ImageDecoderPlugin {
 public:
     static bool sniff(ReadonlyBytes);
     static ErrorOr<NonnullOwnPtr<ImageDecoderPlugin>> create(ReadonlyBytes);
+    // The frames of an animated PNG can be decoded on several threads before they are composited one after the other.
+    static ErrorOr<NonnullOwnPtr<ImageDecoderPlugin>> create_with_options(ReadonlyBytes, ImageDecoderOptions = {});
 
     virtual ~PNGImageDecoderPlugin() override;
 
@@ -27,13 +29,14 @@ public:
     virtual size_t frame_count() override;
     virtual size_t first_animated_frame_index() override;
     virtual ErrorOr<ImageFrameDescriptor> frame(size_t index, Optional<IntSize> ideal_size = {}) override;
+    virtual ErrorOr<PartialImageFrameDescriptor> partial_first_frame() override;
     virtual Optional<Metadata const&> metadata() override;
     virtual ErrorOr<Optional<ReadonlyBytes>> icc_data() override;
 
     static void unfilter_scanline(PNG::FilterType filter, Bytes scanline_data, ReadonlyBytes previous_scanlines_data, u8 bytes_per_complete_pixel);
 
 private:
-    PNGImageDecoderPlugin(u8 const*, size_t);
+    PNGImageDecoderPlugin(u8 const*, size_t, ImageDecoderOptions);
     bool ensure_image_data_chunk_was_decoded();
     bool ensure_animation_frame_was_decoded(u32);
 
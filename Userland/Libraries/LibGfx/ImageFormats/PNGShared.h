@@ -56,12 +56,16 @@ ALWAYS_INLINE u8 paeth_predictor(u8 a, u8 b, u8 c)
 
 ALWAYS_INLINE AK::SIMD::u8x4 paeth_predictor(AK::SIMD::u8x4 a, AK::SIMD::u8x4 b, AK::SIMD::u8x4 c)
 {
-    return AK::SIMD::u8x4 {
-        paeth_predictor(a[0], b[0], c[0]),
-        paeth_predictor(a[1], b[1], c[1]),
-        paeth_predictor(a[2], b[2], c[2]),
-        paeth_predictor(a[3], b[3], c[3]),
-    };
+    // This is the same computation as above, with p - a = b - c, p - b = a - c and p - c = a + b - 2c.
+    auto const wide_a = __builtin_convertvector(a, AK::SIMD::i16x4);
+    auto const wide_b = __builtin_convertvector(b, AK::SIMD::i16x4);
+    auto const wide_c = __builtin_convertvector(c, AK::SIMD::i16x4);
+    auto const absolute = [](AK::SIMD::i16x4 value) { return value < 0 ? -value : value; };
+    auto const pa = absolute(wide_b - wide_c);
+    auto const pb = absolute(wide_a - wide_c);
+    auto const pc = absolute(wide_a + wide_b - 2 * wide_c);
+    auto const predictor = (pa <= pb && pa <= pc) ? wide_a : (pb <= pc ? wide_b : wide_c);
+    return __builtin_convertvector(predictor, AK::SIMD::u8x4);
 }
 
 };
@@ -49,6 +49,7 @@ struct WebPLoadingContext {
     };
     State state { State::NotDecoded };
     ReadonlyBytes data;
+    ImageDecoderOptions options;
 
     ReadonlyBytes chunks_cursor;
 
@@ -530,7 +531,7 @@ static ErrorOr<NonnullRefPtr<Bitmap>> decode_webp_image_data(WebPLoadingContext&
 
     VERIFY(image_data.image_data_chunk.id() == "VP8 "sv);
     auto vp8_header = TRY(decode_webp_chunk_VP8_header(image_data.image_data_chunk.data()));
-    auto bitmap = TRY(decode_webp_chunk_VP8_contents(vp8_header, image_data.alpha_chunk.has_value()));
+    auto bitmap = TRY(decode_webp_chunk_VP8_contents(vp8_header, image_data.alpha_chunk.has_value(), context.options.thread_count));
 
     if (image_data.alpha_chunk.has_value())
         TRY(decode_webp_chunk_ALPH(image_data.alpha_chunk.value(), *bitmap));
@@ -623,8 +624,14 @@ bool WebPImageDecoderPlugin::sniff(ReadonlyBytes data)
 }
 
 ErrorOr<NonnullOwnPtr<ImageDecoderPlugin>> WebPImageDecoderPlugin::create(ReadonlyBytes data)
+{
+    return create_with_options(data, {});
+}
+
+ErrorOr<NonnullOwnPtr<ImageDecoderPlugin>> WebPImageDecoderPlugin::create_with_options(ReadonlyBytes data, ImageDecoderOptions options)
 {
     auto context = TRY(try_make<WebPLoadingContext>());
+    context->options = options;
     auto plugin = TRY(adopt_nonnull_own_or_enomem(new (nothrow) WebPImageDecoderPlugin(data, move(context))));
     TRY(decode_webp_header(*plugin->m_context));
     TRY(decode_webp_first_chunk(*plugin->m_context));
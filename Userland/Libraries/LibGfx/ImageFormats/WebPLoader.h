@@ -16,6 +16,9 @@ class WebPImageDecoderPlugin final : public ImageDecoderPlugin {
 public:
     static bool sniff(ReadonlyBytes);
     static ErrorOr<NonnullOwnPtr<ImageDecoderPlugin>> create(ReadonlyBytes);
+    // Lossy images can have their coefficients decoded on worker threads while the macroblocks are reconstructed on the calling thread.
+    // Images with several data partitions can use more than one worker thread.
+    static ErrorOr<NonnullOwnPtr<ImageDecoderPlugin>> create_with_options(ReadonlyBytes, ImageDecoderOptions = {});
 
     virtual ~WebPImageDecoderPlugin() override;
 
@@ -8,10 +8,15 @@
 #include <AK/Endian.h>
 #include <AK/Format.h>
 #include <AK/MemoryStream.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
 #include <AK/Vector.h>
 #include <LibGfx/ImageFormats/BooleanDecoder.h>
 #include <LibGfx/ImageFormats/WebPLoaderLossy.h>
 #include <LibGfx/ImageFormats/WebPLoaderLossyTables.h>
+#include <LibThreading/ConditionVariable.h>
+#include <LibThreading/Mutex.h>
+#include <LibThreading/Thread.h>
 
 // Lossy format: https://datatracker.ietf.org/doc/html/rfc6386
 
@@ -590,7 +595,17 @@ i16 coefficient_value_for_token(BooleanDecoder& decoder, u8 token)
     return v;
 }
 
-i16 dequantize_value(i16 value, bool is_dc, QuantizationIndices const& quantization_indices, Segmentation const& segmentation, int segment_id, CoefficientBlockIndex index)
+// The dequantization factors for one segment, see compute_dequantization_factors().
+struct DequantizationFactors {
+    i16 y_dc { 0 };
+    i16 y_ac { 0 };
+    i16 y2_dc { 0 };
+    i16 y2_ac { 0 };
+    i16 uv_dc { 0 };
+    i16 uv_ac { 0 };
+};
+
+DequantizationFactors compute_dequantization_factors(QuantizationIndices const& quantization_indices, Segmentation const& segmentation, int segment_id)
 {
     // https://datatracker.ietf.org/doc/html/rfc6386#section-9.6 "Dequantization Indices"
     // "before inverting the transform, each decoded coefficient
@@ -611,6 +626,7 @@ i16 dequantize_value(i16 value, bool is_dc, QuantizationIndices const& quantizat
     // * Also for y2, ac_qlookup is at least 8 for lower table entries
     // * For uv, the dc_qlookup index is clamped to 117 (instead of 127 for everything else)
     //   (or, alternatively, the value is clamped to 132 at most)
+    // These only depend on the segment, so they are computed once per segment instead of once per coefficient.
 
     int y_ac_base = quantization_indices.y_ac;
     if (segmentation.update_macroblock_segmentation_map) {
@@ -620,51 +636,28 @@ i16 dequantize_value(i16 value, bool is_dc, QuantizationIndices const& quantizat
             y_ac_base = segmentation.quantizer_update_value[segment_id];
     }
 
-    int dequantization_index;
-    if (index.is_y2())
-        dequantization_index = y_ac_base + (is_dc ? quantization_indices.y2_dc_delta : quantization_indices.y2_ac_delta);
-    else if (index.is_u() || index.is_v())
-        dequantization_index = y_ac_base + (is_dc ? quantization_indices.uv_dc_delta : quantization_indices.uv_ac_delta);
-    else
-        dequantization_index = is_dc ? (y_ac_base + quantization_indices.y_dc_delta) : y_ac_base;
-
-    // clamp index
-    if ((index.is_u() || index.is_v()) && is_dc)
-        dequantization_index = clamp(dequantization_index, 0, 117);
-    else
-        dequantization_index = clamp(dequantization_index, 0, 127);
-
     // "the multiplies are computed and stored using 16-bit signed integers."
-    i16 dequantization_factor;
-    if (is_dc)
-        dequantization_factor = (i16)dc_qlookup[dequantization_index];
-    else
-        dequantization_factor = (i16)ac_qlookup[dequantization_index];
-
-    if (index.is_y2()) {
-        if (is_dc)
-            dequantization_factor *= 2;
-        else
-            dequantization_factor = max((dequantization_factor * 155) / 100, 8);
-    }
-
-    return dequantization_factor * value;
+    auto dc_factor = [](int dequantization_index, int max_index = 127) { return static_cast<i16>(dc_qlookup[clamp(dequantization_index, 0, max_index)]); };
+    auto ac_factor = [](int dequantization_index) { return static_cast<i16>(ac_qlookup[clamp(dequantization_index, 0, 127)]); };
+
+    DequantizationFactors factors;
+    factors.y_dc = dc_factor(y_ac_base + quantization_indices.y_dc_delta);
+    factors.y_ac = ac_factor(y_ac_base);
+    factors.y2_dc = dc_factor(y_ac_base + quantization_indices.y2_dc_delta) * 2;
+    factors.y2_ac = max((ac_factor(y_ac_base + quantization_indices.y2_ac_delta) * 155) / 100, 8);
+    factors.uv_dc = dc_factor(y_ac_base + quantization_indices.uv_dc_delta, 117);
+    factors.uv_ac = ac_factor(y_ac_base + quantization_indices.uv_ac_delta);
+    return factors;
 }
 
-// Reading macroblock coefficients requires needing to know if the block to the left and above the current macroblock
-// has non-zero coefficients. This stores that state.
-struct CoefficientReadingContext {
-    // Store if each plane has nonzero coefficients in the block above and to the left of the current block.
+// Stores if each plane has nonzero coefficients in the block above the current block, for each macroblock column.
+// With several data partitions, this is shared by all threads that decode coefficients, see decode_VP8_image_data().
+struct CoefficientAboveContext {
     Vector<bool> y2_above;
     Vector<bool> y_above;
     Vector<bool> u_above;
     Vector<bool> v_above;
 
-    bool y2_left {};
-    bool y_left[4] {};
-    bool u_left[2] {};
-    bool v_left[2] {};
-
     ErrorOr<void> initialize(int macroblock_width)
     {
         TRY(y2_above.try_resize(macroblock_width));
@@ -673,6 +666,23 @@ struct CoefficientReadingContext {
         TRY(v_above.try_resize(macroblock_width * 2));
         return {};
     }
+};
+
+// Reading macroblock coefficients requires needing to know if the block to the left and above the current macroblock
+// has non-zero coefficients. This stores that state.
+struct CoefficientReadingContext {
+    explicit CoefficientReadingContext(CoefficientAboveContext& above)
+        : above(above)
+    {
+    }
+
+    CoefficientAboveContext& above;
+
+    // Store if each plane has nonzero coefficients in the block to the left of the current block.
+    bool y2_left {};
+    bool y_left[4] {};
+    bool u_left[2] {};
+    bool v_left[2] {};
 
     void start_new_row()
     {
@@ -688,12 +698,12 @@ struct CoefficientReadingContext {
     bool& was_above_nonzero(CoefficientBlockIndex index, int mb_x)
     {
         if (index.is_y2())
-            return y2_above[mb_x];
+            return above.y2_above[mb_x];
         if (index.is_u())
-            return u_above[mb_x * 2 + index.sub_x()];
+            return above.u_above[mb_x * 2 + index.sub_x()];
         if (index.is_v())
-            return v_above[mb_x * 2 + index.sub_x()];
-        return y_above[mb_x * 4 + index.sub_x()];
+            return above.v_above[mb_x * 2 + index.sub_x()];
+        return above.y_above[mb_x * 4 + index.sub_x()];
     }
     bool was_above_nonzero(CoefficientBlockIndex index, int mb_x) const { return const_cast<CoefficientReadingContext&>(*this).was_above_nonzero(index, mb_x); }
 
@@ -719,7 +729,7 @@ struct CoefficientReadingContext {
 using Coefficients = i16[16];
 
 // Returns if any non-zero coefficients were read.
-bool read_coefficent_block(BooleanDecoder& decoder, Coefficients out_coefficients, CoefficientBlockIndex block_index, CoefficientReadingContext& coefficient_reading_context, int mb_x, bool have_y2, int segment_id, FrameHeader const& header)
+bool read_coefficent_block(BooleanDecoder& decoder, Coefficients out_coefficients, CoefficientBlockIndex block_index, CoefficientReadingContext& coefficient_reading_context, int mb_x, bool have_y2, DequantizationFactors const& dequantization_factors, FrameHeader const& header)
 {
     // Corresponds to `residual_block()` in https://datatracker.ietf.org/doc/html/rfc6386#section-19.3,
     // but also does dequantization of the stored values.
@@ -729,6 +739,16 @@ bool read_coefficent_block(BooleanDecoder& decoder, Coefficients out_coefficient
 
     bool subblock_has_nonzero_coefficients = false;
 
+    i16 dc_dequantization_factor = dequantization_factors.y_dc;
+    i16 ac_dequantization_factor = dequantization_factors.y_ac;
+    if (block_index.is_y2()) {
+        dc_dequantization_factor = dequantization_factors.y2_dc;
+        ac_dequantization_factor = dequantization_factors.y2_ac;
+    } else if (block_index.is_u() || block_index.is_v()) {
+        dc_dequantization_factor = dequantization_factors.uv_dc;
+        ac_dequantization_factor = dequantization_factors.uv_ac;
+    }
+
     for (int j = firstCoeff; j < 16; ++j) {
         // https://datatracker.ietf.org/doc/html/rfc6386#section-13.2 "Coding of Individual Coefficient Values"
         // https://datatracker.ietf.org/doc/html/rfc6386#section-13.3 "Token Probabilities"
@@ -801,7 +821,7 @@ bool read_coefficent_block(BooleanDecoder& decoder, Coefficients out_coefficient
         // last_decoded_value is used for setting `tricky`. It needs to be set to the last decoded token, not to the last dequantized value.
         last_decoded_value = v;
 
-        i16 dequantized_value = dequantize_value(v, j == 0, header.quantization_indices, header.segmentation, segment_id, block_index);
+        i16 dequantized_value = (j == 0 ? dc_dequantization_factor : ac_dequantization_factor) * v;
 
         static int constexpr Zigzag[] = { 0, 1, 4, 8, 5, 2, 3, 6, 9, 12, 13, 10, 7, 11, 14, 15 };
         out_coefficients[Zigzag[j]] = dequantized_value;
@@ -816,12 +836,107 @@ struct MacroblockCoefficients {
     Coefficients v_coeffs[4] {};
 };
 
-MacroblockCoefficients read_macroblock_coefficients(BooleanDecoder& decoder, FrameHeader const& header, CoefficientReadingContext& coefficient_reading_context, MacroblockMetadata const& metadata, int mb_x)
+// The inverse transforms below work on four columns at once in their first pass, and on four rows at once in their second pass.
+// Like the reference implementations in the spec, they store their intermediate results as 16-bit integers.
+ALWAYS_INLINE AK::SIMD::i32x4 load_coefficient_row(i16 const* row)
+{
+    AK::SIMD::i16x4 values;
+    __builtin_memcpy(&values, row, sizeof(values));
+    return __builtin_convertvector(values, AK::SIMD::i32x4);
+}
+
+ALWAYS_INLINE AK::SIMD::i32x4 truncate_to_i16(AK::SIMD::i32x4 values)
+{
+    return __builtin_convertvector(__builtin_convertvector(values, AK::SIMD::i16x4), AK::SIMD::i32x4);
+}
+
+ALWAYS_INLINE AK::SIMD::i32x4 coefficient_column(AK::SIMD::i32x4 const rows[4], int x)
+{
+    return AK::SIMD::i32x4 { rows[0][x], rows[1][x], rows[2][x], rows[3][x] };
+}
+
+// https://datatracker.ietf.org/doc/html/rfc6386#section-14.3 "Implementation of the WHT Inversion"
+void inverse_walsh_hadamard_transform(i16 const* input, i16* output)
+{
+    using AK::SIMD::i32x4;
+
+    auto one_dimensional_wht = [](i32x4 i0, i32x4 i1, i32x4 i2, i32x4 i3, i32x4 results[4]) {
+        i32x4 a1 = i0 + i3;
+        i32x4 b1 = i1 + i2;
+        i32x4 c1 = i1 - i2;
+        i32x4 d1 = i0 - i3;
+
+        results[0] = a1 + b1;
+        results[1] = c1 + d1;
+        results[2] = a1 - b1;
+        results[3] = d1 - c1;
+    };
+
+    // Vertical pass, with one lane per column.
+    i32x4 rows[4];
+    one_dimensional_wht(load_coefficient_row(input + 0), load_coefficient_row(input + 4), load_coefficient_row(input + 8), load_coefficient_row(input + 12), rows);
+    for (auto& row : rows)
+        row = truncate_to_i16(row);
+
+    // Horizontal pass, with one lane per row.
+    i32x4 columns[4];
+    one_dimensional_wht(coefficient_column(rows, 0), coefficient_column(rows, 1), coefficient_column(rows, 2), coefficient_column(rows, 3), columns);
+
+    for (int y = 0; y < 4; ++y) {
+        for (int x = 0; x < 4; ++x)
+            output[y * 4 + x] = static_cast<i16>((columns[x][y] + 3) >> 3);
+    }
+}
+
+// https://datatracker.ietf.org/doc/html/rfc6386#section-14.4 "Implementation of the DCT Inversion"
+// Returns the rows of the output.
+void inverse_dct(i16 const* input, AK::SIMD::i32x4 output[4])
+{
+    using AK::SIMD::i32x4;
+
+    static constexpr int cospi8sqrt2minus1 = 20091;
+    static constexpr int sinpi8sqrt2 = 35468;
+
+    auto one_dimensional_idct = [](i32x4 i0, i32x4 i1, i32x4 i2, i32x4 i3, i32x4 results[4]) {
+        i32x4 a1 = i0 + i2;
+        i32x4 b1 = i0 - i2;
+
+        i32x4 temp1 = (i1 * sinpi8sqrt2) >> 16;
+        i32x4 temp2 = i3 + ((i3 * cospi8sqrt2minus1) >> 16);
+        i32x4 c1 = temp1 - temp2;
+
+        temp1 = i1 + ((i1 * cospi8sqrt2minus1) >> 16);
+        temp2 = (i3 * sinpi8sqrt2) >> 16;
+        i32x4 d1 = temp1 + temp2;
+
+        results[0] = a1 + d1;
+        results[1] = b1 + c1;
+        results[2] = b1 - c1;
+        results[3] = a1 - d1;
+    };
+
+    // Vertical pass, with one lane per column.
+    i32x4 rows[4];
+    one_dimensional_idct(load_coefficient_row(input + 0), load_coefficient_row(input + 4), load_coefficient_row(input + 8), load_coefficient_row(input + 12), rows);
+    for (auto& row : rows)
+        row = truncate_to_i16(row);
+
+    // Horizontal pass, with one lane per row.
+    i32x4 columns[4];
+    one_dimensional_idct(coefficient_column(rows, 0), coefficient_column(rows, 1), coefficient_column(rows, 2), coefficient_column(rows, 3), columns);
+    for (auto& column : columns)
+        column = truncate_to_i16((column + 4) >> 3);
+
+    for (int y = 0; y < 4; ++y)
+        output[y] = coefficient_column(columns, y);
+}
+
+void read_macroblock_coefficients(BooleanDecoder& decoder, FrameHeader const& header, DequantizationFactors const& dequantization_factors, CoefficientReadingContext& coefficient_reading_context, MacroblockMetadata const& metadata, int mb_x, MacroblockCoefficients& coefficients)
 {
     // Corresponds to `residual_data()` in https://datatracker.ietf.org/doc/html/rfc6386#section-19.3,
     // but also does the inverse walsh-hadamard transform if a Y2 block is present.
 
-    MacroblockCoefficients coefficients;
+    coefficients = {};
     Coefficients y2_coeffs {};
 
     // "firstCoeff is 1 for luma blocks of macroblocks containing Y2 subblock; otherwise 0"
@@ -864,7 +979,7 @@ MacroblockCoefficients read_macroblock_coefficients(BooleanDecoder& decoder, Fra
                 to_read = coefficients.v_coeffs[i - 21];
             else // Y
                 to_read = coefficients.y_coeffs[i - 1];
-            subblock_has_nonzero_coefficients = read_coefficent_block(decoder, to_read, block_index, coefficient_reading_context, mb_x, have_y2, metadata.segment_id, header);
+            subblock_has_nonzero_coefficients = read_coefficent_block(decoder, to_read, block_index, coefficient_reading_context, mb_x, have_y2, dequantization_factors, header);
         }
 
         coefficient_reading_context.update(block_index, mb_x, subblock_has_nonzero_coefficients);
@@ -878,12 +993,10 @@ MacroblockCoefficients read_macroblock_coefficients(BooleanDecoder& decoder, Fra
     //  subblock whose index is (i * 4) + j."
     if (have_y2) {
         Coefficients wht_output;
-        vp8_short_inv_walsh4x4_c(y2_coeffs, wht_output);
+        inverse_walsh_hadamard_transform(y2_coeffs, wht_output);
         for (size_t i = 0; i < 16; ++i)
             coefficients.y_coeffs[i][0] = wht_output[i];
     }
-
-    return coefficients;
 }
 
 template<int N>
@@ -1041,23 +1154,42 @@ void predict_y_subblock(Bytes y_prediction, IntraBlockMode mode, int x, int y, R
 }
 
 template<int N>
-void add_idct_to_prediction(Bytes prediction, Coefficients coefficients, int x, int y)
+void add_idct_to_prediction(Bytes prediction, Coefficients const coefficients, int x, int y)
 {
-    Coefficients idct_output;
-    short_idct4x4llm_c(coefficients, idct_output, 4 * sizeof(i16));
+    using AK::SIMD::i32x4;
+    using AK::SIMD::u8x4;
+
+    // Most subblocks have only a DC coefficient (or no coefficients at all), and then the IDCT output is the same everywhere.
+    i16 ac_coefficients = 0;
+    for (int i = 1; i < 16; ++i)
+        ac_coefficients |= coefficients[i];
+
+    i32x4 idct_output[4];
+    if (ac_coefficients == 0) {
+        if (coefficients[0] == 0)
+            return;
+        for (auto& row : idct_output)
+            row = AK::SIMD::expand4(static_cast<i32>(static_cast<i16>((coefficients[0] + 4) >> 3)));
+    } else {
+        inverse_dct(coefficients, idct_output);
+    }
 
     // https://datatracker.ietf.org/doc/html/rfc6386#section-14.5 "Summation of Predictor and Residue"
     // FIXME: Could omit the clamp() call if FrameHeader.clamping_type == ClampingSpecification::NoClampingNecessary.
     for (int py = 0; py < 4; ++py) {
-        for (int px = 0; px < 4; ++px) {
-            u8& p = prediction[(4 * y + py) * N + (4 * x + px)];
-            p = clamp(p + idct_output[py * 4 + px], 0, 255);
-        }
+        u8* row = prediction.offset_pointer((4 * y + py) * N + 4 * x);
+        u8x4 pixels;
+        __builtin_memcpy(&pixels, row, sizeof(pixels));
+        auto sum = __builtin_convertvector(pixels, i32x4) + idct_output[py];
+        sum = sum < 0 ? 0 : sum;
+        sum = sum > 255 ? 255 : sum;
+        pixels = __builtin_convertvector(sum, u8x4);
+        __builtin_memcpy(row, &pixels, sizeof(pixels));
     }
 }
 
 template<int N>
-void process_macroblock(Bytes output, IntraMacroblockMode mode, int mb_x, int mb_y, ReadonlyBytes left, ReadonlyBytes above, u8 truemotion_corner, Coefficients coefficients_array[])
+void process_macroblock(Bytes output, IntraMacroblockMode mode, int mb_x, int mb_y, ReadonlyBytes left, ReadonlyBytes above, u8 truemotion_corner, Coefficients const coefficients_array[])
 {
     predict_macroblock<4 * N>(output, mode, mb_x, mb_y, left, above, truemotion_corner);
 
@@ -1068,7 +1200,7 @@ void process_macroblock(Bytes output, IntraMacroblockMode mode, int mb_x, int mb
             add_idct_to_prediction<4 * N>(output, coefficients_array[i], x, y);
 }
 
-void process_subblocks(Bytes y_output, MacroblockMetadata const& metadata, int mb_x, ReadonlyBytes predicted_y_left, ReadonlyBytes predicted_y_above, u8 y_truemotion_corner, Coefficients coefficients_array[], int macroblock_width)
+void process_subblocks(Bytes y_output, MacroblockMetadata const& metadata, int mb_x, ReadonlyBytes predicted_y_left, ReadonlyBytes predicted_y_above, u8 y_truemotion_corner, Coefficients const coefficients_array[], int macroblock_width)
 {
     // Loop over the 4x4 subblocks
     for (int y = 0, i = 0; y < 4; ++y) {
@@ -1117,104 +1249,264 @@ void process_subblocks(Bytes y_output, MacroblockMetadata const& metadata, int m
 
 void convert_yuv_to_rgb(Bitmap& bitmap, int mb_x, int mb_y, ReadonlyBytes y_data, ReadonlyBytes u_data, ReadonlyBytes v_data)
 {
-    for (int y = 0; y < 16; ++y) {
-        for (int x = 0; x < 16; ++x) {
-            u8 Y = y_data[y * 16 + x];
+    using AK::SIMD::f64x4;
+    using AK::SIMD::i32x4;
+    using AK::SIMD::u32x4;
+    using AK::SIMD::u8x4;
+
+    auto clamp_to_u8 = [](f64x4 values) {
+        auto integers = __builtin_convertvector(values, i32x4);
+        integers = integers < 0 ? 0 : integers;
+        integers = integers > 255 ? 255 : integers;
+        return __builtin_convertvector(integers, u32x4);
+    };
+
+    // The bitmap has the size of the image, so the macroblocks at the right and bottom edges can stick out of it.
+    int height = min(16, bitmap.height() - mb_y * 16);
+    int width = min(16, bitmap.width() - mb_x * 16);
+
+    // Converts four pixels at once.
+    for (int y = 0; y < height; ++y) {
+        auto* scanline = bitmap.scanline(mb_y * 16 + y) + mb_x * 16;
+        for (int x = 0; x < width; x += 4) {
+            u8x4 y_values;
+            __builtin_memcpy(&y_values, y_data.offset_pointer(y * 16 + x), sizeof(y_values));
+            auto Y = __builtin_convertvector(y_values, f64x4);
 
             // FIXME: Could do nicer upsampling than just nearest neighbor
-            u8 U = u_data[(y / 2) * 8 + x / 2];
-            u8 V = v_data[(y / 2) * 8 + x / 2];
+            u8 const* u_values = u_data.offset_pointer((y / 2) * 8 + x / 2);
+            u8 const* v_values = v_data.offset_pointer((y / 2) * 8 + x / 2);
+            f64x4 U { static_cast<double>(u_values[0]), static_cast<double>(u_values[0]), static_cast<double>(u_values[1]), static_cast<double>(u_values[1]) };
+            f64x4 V { static_cast<double>(v_values[0]), static_cast<double>(v_values[0]), static_cast<double>(v_values[1]), static_cast<double>(v_values[1]) };
 
             // XXX: These numbers are from the fixed-point values in libwebp's yuv.h. There's probably a better reference somewhere.
-            int r = 1.1655 * Y + 1.596 * V - 222.4;
-            int g = 1.1655 * Y - 0.3917 * U - 0.8129 * V + 136.0625;
-            int b = 1.1655 * Y + 2.0172 * U - 276.33;
+            auto r = clamp_to_u8(1.1655 * Y + 1.596 * V - 222.4);
+            auto g = clamp_to_u8(1.1655 * Y - 0.3917 * U - 0.8129 * V + 136.0625);
+            auto b = clamp_to_u8(1.1655 * Y + 2.0172 * U - 276.33);
 
-            bitmap.scanline(mb_y * 16 + y)[mb_x * 16 + x] = Color(clamp(r, 0, 255), clamp(g, 0, 255), clamp(b, 0, 255)).value();
+            u32x4 pixels = 0xff000000 | (r << 16) | (g << 8) | b;
+            __builtin_memcpy(scanline + x, &pixels, min(width - x, 4) * sizeof(u32));
         }
     }
 }
 
-ErrorOr<void> decode_VP8_image_data(Gfx::Bitmap& bitmap, FrameHeader const& header, Vector<ReadonlyBytes> data_partitions, int macroblock_width, int macroblock_height, Vector<MacroblockMetadata> const& macroblock_metadata)
+// The bottom row of pixels of the previous macroblock row, which is what the next macroblock row is predicted from.
+struct PredictedAbove {
+    Vector<u8> y;
+    Vector<u8> u;
+    Vector<u8> v;
+
+    ErrorOr<void> initialize(int macroblock_width)
+    {
+        TRY(y.try_resize(macroblock_width * 16));
+        TRY(u.try_resize(macroblock_width * 8));
+        TRY(v.try_resize(macroblock_width * 8));
+        y.span().fill(127);
+        u.span().fill(127);
+        v.span().fill(127);
+        return {};
+    }
+};
+
+void reconstruct_macroblock_row(Bitmap& bitmap, int mb_y, int macroblock_width, ReadonlySpan<MacroblockMetadata> row_metadata, ReadonlySpan<MacroblockCoefficients> row_coefficients, PredictedAbove& predicted_above)
 {
+    auto& predicted_y_above = predicted_above.y;
+    auto& predicted_u_above = predicted_above.u;
+    auto& predicted_v_above = predicted_above.v;
+
+    u8 predicted_y_left[16] { 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129 };
+    u8 predicted_u_left[8] { 129, 129, 129, 129, 129, 129, 129, 129 };
+    u8 predicted_v_left[8] { 129, 129, 129, 129, 129, 129, 129, 129 };
+
+    // The spec doesn't say if this should be 127, 129, or something else.
+    // But ReconstructRow in frame_dec.c in libwebp suggests 129.
+    u8 y_truemotion_corner = 129;
+    u8 u_truemotion_corner = 129;
+    u8 v_truemotion_corner = 129;
+
+    for (int mb_x = 0; mb_x < macroblock_width; ++mb_x) {
+        auto const& metadata = row_metadata[mb_x];
+        auto const& coefficients = row_coefficients[mb_x];
+
+        u8 y_data[16 * 16] {};
+        if (metadata.intra_y_mode == B_PRED)
+            process_subblocks(y_data, metadata, mb_x, predicted_y_left, predicted_y_above, y_truemotion_corner, coefficients.y_coeffs, macroblock_width);
+        else
+            process_macroblock<4>(y_data, metadata.intra_y_mode, mb_x, mb_y, predicted_y_left, predicted_y_above, y_truemotion_corner, coefficients.y_coeffs);
 
-    Vector<BooleanDecoder> streams;
-    for (auto data : data_partitions) {
-        auto decoder = TRY(BooleanDecoder::initialize(data));
-        TRY(streams.try_append(move(decoder)));
+        u8 u_data[8 * 8] {};
+        process_macroblock<2>(u_data, metadata.uv_mode, mb_x, mb_y, predicted_u_left, predicted_u_above, u_truemotion_corner, coefficients.u_coeffs);
+
+        u8 v_data[8 * 8] {};
+        process_macroblock<2>(v_data, metadata.uv_mode, mb_x, mb_y, predicted_v_left, predicted_v_above, v_truemotion_corner, coefficients.v_coeffs);
+
+        // FIXME: insert loop filtering here
+
+        convert_yuv_to_rgb(bitmap, mb_x, mb_y, y_data, u_data, v_data);
+
+        y_truemotion_corner = predicted_y_above[mb_x * 16 + 15];
+        for (int i = 0; i < 16; ++i)
+            predicted_y_left[i] = y_data[15 + i * 16];
+        for (int i = 0; i < 16; ++i)
+            predicted_y_above[mb_x * 16 + i] = y_data[15 * 16 + i];
+
+        u_truemotion_corner = predicted_u_above[mb_x * 8 + 7];
+        for (int i = 0; i < 8; ++i)
+            predicted_u_left[i] = u_data[7 + i * 8];
+        for (int i = 0; i < 8; ++i)
+            predicted_u_above[mb_x * 8 + i] = u_data[7 * 8 + i];
+
+        v_truemotion_corner = predicted_v_above[mb_x * 8 + 7];
+        for (int i = 0; i < 8; ++i)
+            predicted_v_left[i] = v_data[7 + i * 8];
+        for (int i = 0; i < 8; ++i)
+            predicted_v_above[mb_x * 8 + i] = v_data[7 * 8 + i];
     }
+}
 
-    CoefficientReadingContext coefficient_reading_context;
-    TRY(coefficient_reading_context.initialize(macroblock_width));
+// Everything that is needed to decode the coefficients of a macroblock row, apart from the data partition the row is stored in.
+struct CoefficientDecodingState {
+    FrameHeader const& header;
+    Array<DequantizationFactors, 4> dequantization_factors;
+    CoefficientAboveContext above;
+};
 
-    Vector<u8> predicted_y_above;
-    TRY(predicted_y_above.try_resize(macroblock_width * 16));
-    for (size_t i = 0; i < predicted_y_above.size(); ++i)
-        predicted_y_above[i] = 127;
+// Calls before_macroblock(mb_x) before reading the coefficients of each macroblock in the row.
+template<typename Callback>
+void read_macroblock_row_coefficients(BooleanDecoder& decoder, CoefficientDecodingState& state, ReadonlySpan<MacroblockMetadata> row_metadata, Span<MacroblockCoefficients> row_coefficients, Callback before_macroblock)
+{
+    CoefficientReadingContext coefficient_reading_context { state.above };
+    coefficient_reading_context.start_new_row();
 
-    Vector<u8> predicted_u_above;
-    TRY(predicted_u_above.try_resize(macroblock_width * 8));
-    for (size_t i = 0; i < predicted_u_above.size(); ++i)
-        predicted_u_above[i] = 127;
+    for (size_t mb_x = 0; mb_x < row_metadata.size(); ++mb_x) {
+        before_macroblock(static_cast<int>(mb_x));
+        auto const& metadata = row_metadata[mb_x];
+        read_macroblock_coefficients(decoder, state.header, state.dequantization_factors[metadata.segment_id], coefficient_reading_context, metadata, static_cast<int>(mb_x), row_coefficients[mb_x]);
+    }
+}
 
-    Vector<u8> predicted_v_above;
-    TRY(predicted_v_above.try_resize(macroblock_width * 8));
-    for (size_t i = 0; i < predicted_v_above.size(); ++i)
-        predicted_v_above[i] = 127;
+// Decoding the coefficients takes about as long as reconstructing the macroblocks from them, so they are decoded on worker threads,
+// while this thread reconstructs the rows the workers are done with. Macroblock row mb_y is stored in data partition mb_y % number_of_partitions,
+// so with several partitions, several rows can be decoded at once. Each macroblock still needs to know which of the blocks above it had
+// nonzero coefficients though, so every row follows the row above it at a distance.
+struct CoefficientDecodingProgress {
+    // Progress is only published every few macroblocks, so that threads don't fight over the mutex all the time.
+    static constexpr int macroblocks_per_update = 8;
 
-    for (int mb_y = 0, macroblock_index = 0; mb_y < macroblock_height; ++mb_y) {
-        BooleanDecoder& decoder = streams[mb_y % streams.size()];
+    Threading::Mutex mutex;
+    Threading::ConditionVariable condition { mutex };
 
-        coefficient_reading_context.start_new_row();
+    // For each macroblock row, how many of its macroblocks have their coefficients decoded.
+    Vector<int> decoded_macroblocks;
 
-        u8 predicted_y_left[16] { 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129 };
-        u8 predicted_u_left[8] { 129, 129, 129, 129, 129, 129, 129, 129 };
-        u8 predicted_v_left[8] { 129, 129, 129, 129, 129, 129, 129, 129 };
+    // The coefficients of row mb_y are stored in slot mb_y % coefficient_row_count, which is free again once the row before has been reconstructed.
+    int reconstructed_rows { 0 };
+};
 
-        // The spec doesn't say if this should be 127, 129, or something else.
-        // But ReconstructRow in frame_dec.c in libwebp suggests 129.
-        u8 y_truemotion_corner = 129;
-        u8 u_truemotion_corner = 129;
-        u8 v_truemotion_corner = 129;
+ErrorOr<void> decode_VP8_image_data_on_threads(Gfx::Bitmap& bitmap, CoefficientDecodingState& state, Vector<BooleanDecoder>& streams, int macroblock_width, int macroblock_height, Vector<MacroblockMetadata> const& macroblock_metadata, size_t thread_count)
+{
+    auto const worker_count = clamp<size_t>(thread_count - 1, 1, streams.size());
+    auto const coefficient_row_count = min<size_t>(macroblock_height, 2 * worker_count);
 
-        for (int mb_x = 0; mb_x < macroblock_width; ++mb_x, ++macroblock_index) {
-            auto const& metadata = macroblock_metadata[macroblock_index];
+    Vector<MacroblockCoefficients> coefficients;
+    TRY(coefficients.try_resize(coefficient_row_count * macroblock_width));
+    auto row_coefficients = [&](int mb_y) { return coefficients.span().slice((mb_y % coefficient_row_count) * macroblock_width, macroblock_width); };
+    auto row_metadata = [&](int mb_y) { return macroblock_metadata.span().slice(mb_y * macroblock_width, macroblock_width); };
 
-            auto coefficients = read_macroblock_coefficients(decoder, header, coefficient_reading_context, metadata, mb_x);
+    PredictedAbove predicted_above;
+    TRY(predicted_above.initialize(macroblock_width));
 
-            u8 y_data[16 * 16] {};
-            if (metadata.intra_y_mode == B_PRED)
-                process_subblocks(y_data, metadata, mb_x, predicted_y_left, predicted_y_above, y_truemotion_corner, coefficients.y_coeffs, macroblock_width);
-            else
-                process_macroblock<4>(y_data, metadata.intra_y_mode, mb_x, mb_y, predicted_y_left, predicted_y_above, y_truemotion_corner, coefficients.y_coeffs);
+    CoefficientDecodingProgress progress;
+    TRY(progress.decoded_macroblocks.try_resize(macroblock_height));
 
-            u8 u_data[8 * 8] {};
-            process_macroblock<2>(u_data, metadata.uv_mode, mb_x, mb_y, predicted_u_left, predicted_u_above, u_truemotion_corner, coefficients.u_coeffs);
+    auto decode_rows = [&](size_t worker_index) {
+        for (int mb_y = 0; mb_y < macroblock_height; ++mb_y) {
+            auto partition_index = mb_y % streams.size();
+            if (partition_index % worker_count != worker_index)
+                continue;
 
-            u8 v_data[8 * 8] {};
-            process_macroblock<2>(v_data, metadata.uv_mode, mb_x, mb_y, predicted_v_left, predicted_v_above, v_truemotion_corner, coefficients.v_coeffs);
+            {
+                Threading::MutexLocker locker { progress.mutex };
+                progress.condition.wait_while([&] { return progress.reconstructed_rows + static_cast<int>(coefficient_row_count) <= mb_y; });
+            }
 
-            // FIXME: insert loop filtering here
+            int known_decoded_macroblocks_above = mb_y == 0 ? macroblock_width : 0;
+            read_macroblock_row_coefficients(streams[partition_index], state, row_metadata(mb_y), row_coefficients(mb_y), [&](int mb_x) {
+                if (mb_x > 0 && mb_x % CoefficientDecodingProgress::macroblocks_per_update == 0) {
+                    Threading::MutexLocker locker { progress.mutex };
+                    progress.decoded_macroblocks[mb_y] = mb_x;
+                    progress.condition.broadcast();
+                }
+                if (known_decoded_macroblocks_above <= mb_x) {
+                    Threading::MutexLocker locker { progress.mutex };
+                    progress.condition.wait_while([&] { return progress.decoded_macroblocks[mb_y - 1] <= mb_x; });
+                    known_decoded_macroblocks_above = progress.decoded_macroblocks[mb_y - 1];
+                }
+            });
 
-            convert_yuv_to_rgb(bitmap, mb_x, mb_y, y_data, u_data, v_data);
+            Threading::MutexLocker locker { progress.mutex };
+            progress.decoded_macroblocks[mb_y] = macroblock_width;
+            progress.condition.broadcast();
+        }
+    };
 
-            y_truemotion_corner = predicted_y_above[mb_x * 16 + 15];
-            for (int i = 0; i < 16; ++i)
-                predicted_y_left[i] = y_data[15 + i * 16];
-            for (int i = 0; i < 16; ++i)
-                predicted_y_above[mb_x * 16 + i] = y_data[15 * 16 + i];
+    Vector<NonnullRefPtr<Threading::Thread>> threads;
+    TRY(threads.try_ensure_capacity(worker_count));
+    for (size_t i = 0; i < worker_count; ++i) {
+        auto thread = Threading::Thread::construct([i, &decode_rows]() -> intptr_t {
+            decode_rows(i);
+            return 0;
+        },
+            "WebPDecoder"sv);
+        thread->start();
+        threads.unchecked_append(move(thread));
+    }
 
-            u_truemotion_corner = predicted_u_above[mb_x * 8 + 7];
-            for (int i = 0; i < 8; ++i)
-                predicted_u_left[i] = u_data[7 + i * 8];
-            for (int i = 0; i < 8; ++i)
-                predicted_u_above[mb_x * 8 + i] = u_data[7 * 8 + i];
+    for (int mb_y = 0; mb_y < macroblock_height; ++mb_y) {
+        {
+            Threading::MutexLocker locker { progress.mutex };
+            progress.condition.wait_while([&] { return progress.decoded_macroblocks[mb_y] < macroblock_width; });
+        }
 
-            v_truemotion_corner = predicted_v_above[mb_x * 8 + 7];
-            for (int i = 0; i < 8; ++i)
-                predicted_v_left[i] = v_data[7 + i * 8];
-            for (int i = 0; i < 8; ++i)
-                predicted_v_above[mb_x * 8 + i] = v_data[7 * 8 + i];
+        reconstruct_macroblock_row(bitmap, mb_y, macroblock_width, row_metadata(mb_y), row_coefficients(mb_y), predicted_above);
+
+        Threading::MutexLocker locker { progress.mutex };
+        progress.reconstructed_rows = mb_y + 1;
+        progress.condition.broadcast();
+    }
+
+    for (auto& thread : threads)
+        (void)thread->join();
+
+    return {};
+}
+
+ErrorOr<void> decode_VP8_image_data(Gfx::Bitmap& bitmap, FrameHeader const& header, Vector<ReadonlyBytes> data_partitions, int macroblock_width, int macroblock_height, Vector<MacroblockMetadata> const& macroblock_metadata, size_t thread_count)
+{
+    Vector<BooleanDecoder> streams;
+    for (auto data : data_partitions) {
+        auto decoder = TRY(BooleanDecoder::initialize(data));
+        TRY(streams.try_append(move(decoder)));
+    }
+
+    CoefficientDecodingState state { header, {}, {} };
+    for (int segment_id = 0; segment_id < 4; ++segment_id)
+        state.dequantization_factors[segment_id] = compute_dequantization_factors(header.quantization_indices, header.segmentation, segment_id);
+    TRY(state.above.initialize(macroblock_width));
+
+    if (thread_count > 1 && macroblock_height > 1) {
+        TRY(decode_VP8_image_data_on_threads(bitmap, state, streams, macroblock_width, macroblock_height, macroblock_metadata, thread_count));
+    } else {
+        PredictedAbove predicted_above;
+        TRY(predicted_above.initialize(macroblock_width));
+
+        Vector<MacroblockCoefficients> row_coefficients;
+        TRY(row_coefficients.try_resize(macroblock_width));
+
+        for (int mb_y = 0; mb_y < macroblock_height; ++mb_y) {
+            auto row_metadata = macroblock_metadata.span().slice(mb_y * macroblock_width, macroblock_width);
+            read_macroblock_row_coefficients(streams[mb_y % streams.size()], state, row_metadata, row_coefficients, [](int) {});
+            reconstruct_macroblock_row(bitmap, mb_y, macroblock_width, row_metadata, row_coefficients, predicted_above);
         }
     }
 
@@ -1260,7 +1552,7 @@ static ErrorOr<Vector<ReadonlyBytes>> split_data_partitions(ReadonlyBytes second
 
 }
 
-ErrorOr<NonnullRefPtr<Bitmap>> decode_webp_chunk_VP8_contents(VP8Header const& vp8_header, bool include_alpha_channel)
+ErrorOr<NonnullRefPtr<Bitmap>> decode_webp_chunk_VP8_contents(VP8Header const& vp8_header, bool include_alpha_channel, size_t thread_count)
 {
     // The first partition stores header, per-segment state, and macroblock metadata.
     auto decoder = TRY(BooleanDecoder::initialize(vp8_header.first_partition));
@@ -1280,16 +1572,11 @@ ErrorOr<NonnullRefPtr<Bitmap>> decode_webp_chunk_VP8_contents(VP8Header const& v
     // Done with the first partition!
 
     auto bitmap_format = include_alpha_channel ? BitmapFormat::BGRA8888 : BitmapFormat::BGRx8888;
-    auto bitmap = TRY(Bitmap::create(bitmap_format, { macroblock_width * 16, macroblock_height * 16 }));
+    auto bitmap = TRY(Bitmap::create(bitmap_format, { vp8_header.width, vp8_header.height }));
 
     auto data_partitions = TRY(split_data_partitions(vp8_header.second_partition, header.number_of_dct_partitions));
-    TRY(decode_VP8_image_data(*bitmap, header, move(data_partitions), macroblock_width, macroblock_height, macroblock_metadata));
-
-    auto width = static_cast<int>(vp8_header.width);
-    auto height = static_cast<int>(vp8_header.height);
-    if (bitmap->physical_size() == IntSize { width, height })
-        return bitmap;
-    return bitmap->cropped({ 0, 0, width, height });
+    TRY(decode_VP8_image_data(*bitmap, header, move(data_partitions), macroblock_width, macroblock_height, macroblock_metadata, thread_count));
+    return bitmap;
 }
 
 }
@@ -21,4 +21,27 @@ ImmutableBitmap::ImmutableBitmap(NonnullRefPtr<Bitmap> bitmap)
 {
 }
 
+ErrorOr<NonnullRefPtr<Bitmap>> ImmutableBitmap::scaled_bitmap(IntSize size, Painter::ScalingMode scaling_mode) const
+{
+    for (size_t i = 0; i < m_scaled_bitmaps.size(); ++i) {
+        if (m_scaled_bitmaps[i].size != size || m_scaled_bitmaps[i].scaling_mode != scaling_mode)
+            continue;
+        if (i != 0)
+            swap(m_scaled_bitmaps[0], m_scaled_bitmaps[i]);
+        return m_scaled_bitmaps[0].bitmap;
+    }
+
+    // New bitmaps start out fully transparent, and painting onto them stores the scaled pixels as they are.
+    // Blitting the result later on therefore looks exactly the same as scaling the bitmap while painting it.
+    auto format = m_bitmap->has_alpha_channel() ? BitmapFormat::BGRA8888 : BitmapFormat::BGRx8888;
+    auto scaled = TRY(Bitmap::create(format, size));
+    Painter painter(*scaled);
+    painter.draw_scaled_bitmap(scaled->rect(), *m_bitmap, m_bitmap->rect(), 1.0f, scaling_mode);
+
+    if (m_scaled_bitmaps.size() == max_scaled_bitmap_count)
+        m_scaled_bitmaps.take_last();
+    m_scaled_bitmaps.prepend(ScaledBitmap { size, scaling_mode, scaled });
+    return scaled;
+}
+
 }
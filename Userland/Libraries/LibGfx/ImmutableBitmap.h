@@ -8,8 +8,10 @@
 
 #include <AK/Forward.h>
 #include <AK/RefCounted.h>
+#include <AK/Vector.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/Forward.h>
+#include <LibGfx/Painter.h>
 #include <LibGfx/Rect.h>
 
 namespace Gfx {
@@ -30,9 +32,21 @@ public:
 
     size_t id() const { return m_id; }
 
+    // Images tend to be painted at the same size over and over, so the most recently requested scaled versions are kept around.
+    ErrorOr<NonnullRefPtr<Bitmap>> scaled_bitmap(IntSize, Painter::ScalingMode) const;
+
 private:
+    static constexpr size_t max_scaled_bitmap_count = 2;
+
+    struct ScaledBitmap {
+        IntSize size;
+        Painter::ScalingMode scaling_mode;
+        NonnullRefPtr<Bitmap> bitmap;
+    };
+
     NonnullRefPtr<Bitmap> m_bitmap;
     size_t m_id;
+    mutable Vector<ScaledBitmap, max_scaled_bitmap_count> m_scaled_bitmaps;
 
     explicit ImmutableBitmap(NonnullRefPtr<Bitmap> bitmap);
 };
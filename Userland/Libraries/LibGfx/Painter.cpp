@@ -12,6 +12,7 @@
 
 #include "Painter.h"
 #include "Bitmap.h"
+#include "BlendRow.h"
 #include "Font/Emoji.h"
 #include "Font/Font.h"
 #include <AK/Assertions.h>
@@ -21,6 +22,7 @@
 #include <AK/Memory.h>
 #include <AK/Queue.h>
 #include <AK/QuickSort.h>
+#include <AK/SIMDExtras.h>
 #include <AK/Stack.h>
 #include <AK/StdLibExtras.h>
 #include <AK/StringBuilder.h>
@@ -108,10 +110,13 @@ void Painter::fill_physical_rect(IntRect const& physical_rect, Color color)
     ARGB32* dst = m_target->scanline(physical_rect.top()) + physical_rect.left();
     size_t const dst_skip = m_target->pitch() / sizeof(ARGB32);
 
-    auto dst_format = target()->format();
+    ARGB32 const source = color.value();
+    bool const destination_has_alpha = target()->has_alpha_channel();
     for (int i = physical_rect.height() - 1; i >= 0; --i) {
-        for (int j = 0; j < physical_rect.width(); ++j)
-            dst[j] = color_for_format(dst_format, dst[j]).blend(color).value();
+        if (destination_has_alpha)
+            Detail::blend_row<true, true>(dst, &source, physical_rect.width());
+        else
+            Detail::blend_row<false, true>(dst, &source, physical_rect.width());
         dst += dst_skip;
     }
 }
@@ -835,28 +840,42 @@ static void swap_red_and_blue_channels(Color& color)
     color = Color::from_argb(bgra);
 }
 
-// FIXME: This function is very unoptimized.
 template<BlitState::AlphaState has_alpha>
 static void do_blit_with_opacity(BlitState& state)
 {
-    for (int row = 0; row < state.row_count; ++row) {
-        for (int x = 0; x < state.column_count; ++x) {
-            Color dest_color = (has_alpha & BlitState::DstAlpha) ? Color::from_argb(state.dst[x]) : Color::from_rgb(state.dst[x]);
-            if constexpr (has_alpha & BlitState::SrcAlpha) {
-                Color src_color_with_alpha = Color::from_argb(state.src[x]);
-                if (state.src_format == BitmapFormat::RGBA8888)
-                    swap_red_and_blue_channels(src_color_with_alpha);
-                float pixel_opacity = src_color_with_alpha.alpha() / 255.0;
-                src_color_with_alpha.set_alpha(255 * (state.opacity * pixel_opacity));
-                state.dst[x] = dest_color.blend(src_color_with_alpha).value();
-            } else {
-                Color src_color_with_alpha = Color::from_rgb(state.src[x]);
+    // Work out the alpha of every source pixel once up front, the same way Color::set_alpha() would truncate it.
+    Array<u8, 256> source_alpha;
+    for (size_t alpha = 0; alpha < source_alpha.size(); ++alpha) {
+        if constexpr (has_alpha & BlitState::SrcAlpha) {
+            float pixel_opacity = alpha / 255.0;
+            source_alpha[alpha] = 255 * (state.opacity * pixel_opacity);
+        } else {
+            source_alpha[alpha] = state.opacity * 255;
+        }
+    }
+
+    bool can_blend_source_directly = (has_alpha & BlitState::SrcAlpha) && state.src_format != BitmapFormat::RGBA8888;
+    for (size_t alpha = 0; alpha < source_alpha.size(); ++alpha)
+        can_blend_source_directly &= source_alpha[alpha] == alpha;
+
+    Vector<ARGB32, 1024> row;
+    if (!can_blend_source_directly)
+        row.resize(state.column_count);
+
+    for (int row_index = 0; row_index < state.row_count; ++row_index) {
+        ARGB32 const* source = state.src;
+        if (!can_blend_source_directly) {
+            for (int x = 0; x < state.column_count; ++x) {
+                Color src_color = Color::from_argb(state.src[x]);
                 if (state.src_format == BitmapFormat::RGBA8888)
-                    swap_red_and_blue_channels(src_color_with_alpha);
-                src_color_with_alpha.set_alpha(state.opacity * 255);
-                state.dst[x] = dest_color.blend(src_color_with_alpha).value();
+                    swap_red_and_blue_channels(src_color);
+                row[x] = (src_color.value() & 0xffffff) | (source_alpha[src_color.alpha()] << 24);
             }
+            source = row.data();
         }
+
+        Detail::blend_row<(has_alpha & BlitState::DstAlpha) != 0>(state.dst, source, state.column_count);
+
         state.dst += state.dst_pitch;
         state.src += state.src_pitch;
     }
@@ -1131,57 +1150,131 @@ ALWAYS_INLINE static void do_draw_integer_scaled_bitmap(Gfx::Bitmap& target, Int
     }
 }
 
+struct BoxSamplingSpan {
+    int first_source_index { 0 };
+    int source_count { 0 };
+    size_t first_weight { 0 };
+};
+
+// Every destination pixel covers a box of source pixels, and each source pixel contributes the area of its overlap with that box.
+// That area is the product of the overlaps along both axes, so the overlaps only need to be computed once per column and row.
+static void compute_box_sampling_spans(Vector<BoxSamplingSpan>& spans, Vector<float>& weights, float source_start, float source_pixel_size, int destination_offset, int first, int count, int source_size)
+{
+    spans.resize(count);
+    weights.clear_with_capacity();
+    for (int i = 0; i < count; ++i) {
+        float box_start = source_start + (first + i - destination_offset) * source_pixel_size;
+        float box_end = box_start + source_pixel_size;
+        int first_source_index = max(static_cast<int>(floorf(box_start)), 0);
+        int end_source_index = min(static_cast<int>(ceilf(box_end)), source_size);
+
+        auto& span = spans[i];
+        span.first_source_index = first_source_index;
+        span.source_count = max(end_source_index - first_source_index, 0);
+        span.first_weight = weights.size();
+        for (int s = first_source_index; s < end_source_index; ++s) {
+            float overlap_start = max(box_start, static_cast<float>(s));
+            float overlap_end = min(box_end, static_cast<float>(s) + 1.f);
+            weights.append(overlap_start > overlap_end ? 0.f : overlap_end - overlap_start);
+        }
+    }
+}
+
 template<bool has_alpha_channel, typename GetPixel>
 ALWAYS_INLINE static void do_draw_box_sampled_scaled_bitmap(Gfx::Bitmap& target, IntRect const& dst_rect, IntRect const& clipped_rect, Gfx::Bitmap const& source, FloatRect const& src_rect, GetPixel get_pixel, float opacity)
 {
     float source_pixel_width = src_rect.width() / dst_rect.width();
     float source_pixel_height = src_rect.height() / dst_rect.height();
     float source_pixel_area = source_pixel_width * source_pixel_height;
-    FloatRect const pixel_box = { 0.f, 0.f, 1.f, 1.f };
+
+    Vector<BoxSamplingSpan> column_spans;
+    Vector<BoxSamplingSpan> row_spans;
+    Vector<float> column_weights;
+    Vector<float> row_weights;
+    compute_box_sampling_spans(column_spans, column_weights, src_rect.left(), source_pixel_width, dst_rect.x(), clipped_rect.left(), clipped_rect.width(), source.width());
+    compute_box_sampling_spans(row_spans, row_weights, src_rect.top(), source_pixel_height, dst_rect.y(), clipped_rect.top(), clipped_rect.height(), source.height());
+
+    int first_source_x = source.width();
+    int end_source_x = 0;
+    for (auto const& span : column_spans) {
+        if (span.source_count == 0)
+            continue;
+        first_source_x = min(first_source_x, span.first_source_index);
+        end_source_x = max(end_source_x, span.first_source_index + span.source_count);
+    }
+    if (first_source_x >= end_source_x)
+        first_source_x = end_source_x = 0;
+
+    // The source pixels of a row are premultiplied by their alpha once, with the alpha itself ending up in the last lane.
+    // The accumulators sum these up in the same layout, so their last lane is the total area covered by opaque pixels.
+    Vector<AK::SIMD::f32x4, 256> source_row;
+    Vector<AK::SIMD::f32x4, 256> column_sums;
+    Vector<AK::SIMD::f32x4, 256> accumulators;
+    auto resize_with_zeroes = [](auto& vector, size_t size) {
+        vector.ensure_capacity(size);
+        for (size_t i = 0; i < size; ++i)
+            vector.unchecked_append(AK::SIMD::f32x4 { 0.f, 0.f, 0.f, 0.f });
+    };
+    resize_with_zeroes(source_row, end_source_x - first_source_x);
+    resize_with_zeroes(column_sums, clipped_rect.width());
+    resize_with_zeroes(accumulators, clipped_rect.width());
+    int summed_source_y = -1;
+
+    Vector<ARGB32, 1024> row;
+    if constexpr (has_alpha_channel)
+        row.resize(clipped_rect.width());
 
     for (int y = clipped_rect.top(); y < clipped_rect.bottom(); ++y) {
-        auto* scanline = reinterpret_cast<Color*>(target.scanline(y));
-        for (int x = clipped_rect.left(); x < clipped_rect.right(); ++x) {
-            // Project the destination pixel in the source image
-            FloatRect const source_box = {
-                src_rect.left() + (x - dst_rect.x()) * source_pixel_width,
-                src_rect.top() + (y - dst_rect.y()) * source_pixel_height,
-                source_pixel_width,
-                source_pixel_height,
-            };
-            IntRect enclosing_source_box = enclosing_int_rect(source_box).intersected(source.rect());
+        auto& row_span = row_spans[y - clipped_rect.top()];
+        accumulators.span().fill(AK::SIMD::f32x4 { 0.f, 0.f, 0.f, 0.f });
 
-            // Sum the contribution of all source pixels inside the projected pixel
-            float red_accumulator = 0.f;
-            float green_accumulator = 0.f;
-            float blue_accumulator = 0.f;
-            float total_area = 0.f;
-            for (int sy = enclosing_source_box.y(); sy < enclosing_source_box.bottom(); ++sy) {
-                for (int sx = enclosing_source_box.x(); sx < enclosing_source_box.right(); ++sx) {
-                    float area = source_box.intersected(pixel_box.translated(sx, sy)).size().area();
+        for (int i = 0; i < row_span.source_count; ++i) {
+            int sy = row_span.first_source_index + i;
 
+            // Neighboring destination rows usually share a source row at their edges, so the last one that was summed up is kept.
+            if (sy != summed_source_y) {
+                summed_source_y = sy;
+                for (int sx = first_source_x; sx < end_source_x; ++sx) {
                     auto pixel = get_pixel(source, sx, sy);
-                    area *= pixel.alpha() / 255.f;
+                    float alpha = pixel.alpha() / 255.f;
+                    source_row[sx - first_source_x] = AK::SIMD::f32x4 { static_cast<float>(pixel.blue()), static_cast<float>(pixel.green()), static_cast<float>(pixel.red()), 1.f } * alpha;
+                }
 
-                    red_accumulator += pixel.red() * area;
-                    green_accumulator += pixel.green() * area;
-                    blue_accumulator += pixel.blue() * area;
-                    total_area += area;
+                for (size_t x = 0; x < column_spans.size(); ++x) {
+                    auto& column_span = column_spans[x];
+                    auto const* values = source_row.data() + (column_span.first_source_index - first_source_x);
+                    auto const* weights = column_weights.data() + column_span.first_weight;
+                    AK::SIMD::f32x4 sum { 0.f, 0.f, 0.f, 0.f };
+                    for (int j = 0; j < column_span.source_count; ++j)
+                        sum += values[j] * weights[j];
+                    column_sums[x] = sum;
                 }
             }
 
+            float row_weight = row_weights[row_span.first_weight + i];
+            for (size_t x = 0; x < accumulators.size(); ++x)
+                accumulators[x] += column_sums[x] * row_weight;
+        }
+
+        auto* scanline = reinterpret_cast<Color*>(target.scanline(y));
+        for (int x = clipped_rect.left(); x < clipped_rect.right(); ++x) {
+            auto accumulator = accumulators[x - clipped_rect.left()];
+            float total_area = accumulator[3];
             Color src_pixel = {
-                round_to<u8>(min(red_accumulator / total_area, 255.f)),
-                round_to<u8>(min(green_accumulator / total_area, 255.f)),
-                round_to<u8>(min(blue_accumulator / total_area, 255.f)),
+                round_to<u8>(min(accumulator[2] / total_area, 255.f)),
+                round_to<u8>(min(accumulator[1] / total_area, 255.f)),
+                round_to<u8>(min(accumulator[0] / total_area, 255.f)),
                 round_to<u8>(min(total_area * 255.f / source_pixel_area * opacity, 255.f)),
             };
 
             if constexpr (has_alpha_channel)
-                scanline[x] = scanline[x].blend(src_pixel);
+                row[x - clipped_rect.left()] = src_pixel.value();
             else
                 scanline[x] = src_pixel;
         }
+
+        if constexpr (has_alpha_channel)
+            Detail::blend_row<true>(reinterpret_cast<ARGB32*>(scanline + clipped_rect.left()), row.data(), row.size());
     }
 }
 
@@ -1220,6 +1313,10 @@ ALWAYS_INLINE static void do_draw_scaled_bitmap(Gfx::Bitmap& target, IntRect con
     i64 src_left = src_rect.left() * shift;
     i64 src_top = src_rect.top() * shift;
 
+    Vector<ARGB32, 1024> row;
+    if constexpr (has_alpha_channel)
+        row.resize(clipped_rect.width());
+
     for (int y = clipped_rect.top(); y < clipped_rect.bottom(); ++y) {
         auto* scanline = reinterpret_cast<Color*>(target.scanline(y));
         auto desired_y = (y - dst_rect.y()) * vscale + src_top;
@@ -1280,10 +1377,15 @@ ALWAYS_INLINE static void do_draw_scaled_bitmap(Gfx::Bitmap& target, IntRect con
                 src_pixel.set_alpha(src_pixel.alpha() * opacity);
 
             if constexpr (has_alpha_channel)
-                scanline[x] = scanline[x].blend(src_pixel);
+                row[x - clipped_rect.left()] = src_pixel.value();
             else
                 scanline[x] = src_pixel;
         }
+
+        if constexpr (has_alpha_channel) {
+            // The target's alpha channel is always taken into account here, just like Color::blend() on the scanline would.
+            Detail::blend_row<true>(reinterpret_cast<ARGB32*>(scanline + clipped_rect.left()), row.data(), row.size());
+        }
     }
 }
 
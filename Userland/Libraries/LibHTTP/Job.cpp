@@ -17,6 +17,7 @@
 #include <LibCompress/Brotli.h>
 #include <LibCompress/Gzip.h>
 #include <LibCompress/Zlib.h>
+#include <LibCompress/Zstd.h>
 #include <LibCore/Event.h>
 #include <LibCore/EventLoop.h>
 #include <LibHTTP/HttpResponse.h>
@@ -145,6 +146,22 @@ static ErrorOr<ByteBuffer> handle_content_encoding(ByteBuffer const& buf, ByteSt
             dbgln("  Output size: {}", uncompressed.size());
         }
 
+        return uncompressed;
+    } else if (content_encoding == "zstd") {
+        // https://datatracker.ietf.org/doc/html/rfc8878#section-7.2
+        if (!Compress::ZstdDecompressor::is_likely_compressed(buf)) {
+            dbgln("Job::handle_content_encoding: buf is not zstd compressed!");
+        }
+
+        dbgln_if(JOB_DEBUG, "Job::handle_content_encoding: buf is zstd compressed!");
+
+        auto uncompressed = TRY(Compress::ZstdDecompressor::decompress_all(buf));
+        if constexpr (JOB_DEBUG) {
+            dbgln("Job::handle_content_encoding: Zstd::decompress() successful.");
+            dbgln("  Input size: {}", buf.size());
+            dbgln("  Output size: {}", uncompressed.size());
+        }
+
         return uncompressed;
     }
 
@@ -196,6 +213,8 @@ Coroutine<void> Job::flush_received_buffers()
             if (result.is_error())
                 break;
             auto written = result.release_value();
+            if (on_response_body_written)
+                on_response_body_written(payload.trim(written));
             m_buffered_size -= written;
             if (written == payload.size()) {
                 // FIXME: Make this a take-first-friendly object?
@@ -27,6 +27,10 @@ public:
 
     Core::Socket const* socket() const { return m_socket; }
     URL::URL url() const { return m_request.url(); }
+    HttpRequest const& request() const { return m_request; }
+
+    // Called with each piece of the (decoded) response body once it has been written to the output stream.
+    Function<void(ReadonlyBytes)> on_response_body_written;
 
     HttpResponse* response() { return static_cast<HttpResponse*>(Core::NetworkJob::response()); }
     HttpResponse const* response() const { return static_cast<HttpResponse const*>(Core::NetworkJob::response()); }
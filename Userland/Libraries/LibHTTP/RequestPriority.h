@@ -0,0 +1,21 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Types.h>
+
+namespace HTTP {
+
+// How urgently the requester needs a response. RequestServer uses this to order requests waiting for a connection
+// to the same server, so that e.g. stylesheets aren't stuck behind a long list of images.
+enum class RequestPriority : u8 {
+    Low,
+    Normal,
+    High,
+};
+
+}
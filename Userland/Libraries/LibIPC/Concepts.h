@@ -29,8 +29,8 @@ namespace Detail {
 
 template<typename T>
 constexpr inline bool IsHashMap = false;
-template<typename K, typename V, typename KeyTraits, typename ValueTraits, bool IsOrdered>
-constexpr inline bool IsHashMap<HashMap<K, V, KeyTraits, ValueTraits, IsOrdered>> = true;
+template<typename K, typename V, typename KeyTraits, typename ValueTraits, bool IsOrdered, bool IsFlat>
+constexpr inline bool IsHashMap<HashMap<K, V, KeyTraits, ValueTraits, IsOrdered, IsFlat>> = true;
 
 template<typename T>
 constexpr inline bool IsOptional = false;
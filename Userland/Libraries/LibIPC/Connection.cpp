@@ -29,6 +29,13 @@ ConnectionBase::ConnectionBase(IPC::Stub& local_stub, NonnullOwnPtr<Core::LocalS
     , m_deferred_invoker(make<CoreEventLoopDeferredInvoker>())
 {
     m_responsiveness_timer = Core::Timer::create_single_shot(3000, [this] { may_have_become_unresponsive(); });
+
+    // NOTE: Anything up to large_message_threshold is sent through the socket, so have room for a bunch of those.
+    if (auto fd = m_socket->fd(); fd.has_value()) {
+        int buffer_size = 4 * large_message_threshold;
+        if (auto result = Core::System::setsockopt(*fd, SOL_SOCKET, SO_SNDBUF, &buffer_size, sizeof(buffer_size)); result.is_error())
+            dbgln("IPC::ConnectionBase: Couldn't grow the socket send buffer: {}", result.error());
+    }
 }
 
 void ConnectionBase::set_deferred_invoker(NonnullOwnPtr<DeferredInvoker> deferred_invoker)
@@ -69,6 +76,16 @@ void ConnectionBase::shutdown_with_error(Error const& error)
     shutdown();
 }
 
+void ConnectionBase::enqueue_local_message(NonnullOwnPtr<Message> message)
+{
+    // If we're falling behind, only the most recent of a run of superseding messages (e.g. mouse moves) is worth handling.
+    if (!m_unprocessed_messages.is_empty() && message->supersedes(*m_unprocessed_messages.last())) {
+        m_unprocessed_messages.last() = move(message);
+        return;
+    }
+    m_unprocessed_messages.append(move(message));
+}
+
 void ConnectionBase::handle_messages()
 {
     auto messages = move(m_unprocessed_messages);
@@ -110,7 +127,7 @@ ErrorOr<Vector<u8>> ConnectionBase::read_as_much_as_possible_from_socket_without
         m_unprocessed_bytes.clear();
     }
 
-    u8 buffer[4096];
+    u8 buffer[16 * KiB];
     Vector<int> received_fds;
 
     bool should_shut_down = false;
@@ -122,7 +139,7 @@ ErrorOr<Vector<u8>> ConnectionBase::read_as_much_as_possible_from_socket_without
     };
 
     while (m_socket->is_open()) {
-        auto maybe_bytes_read = m_socket->receive_message({ buffer, 4096 }, MSG_DONTWAIT, received_fds);
+        auto maybe_bytes_read = m_socket->receive_message({ buffer, sizeof(buffer) }, MSG_DONTWAIT, received_fds);
         if (maybe_bytes_read.is_error()) {
             auto error = maybe_bytes_read.release_error();
             if (error.is_syscall() && error.code() == EAGAIN) {
@@ -148,6 +165,12 @@ ErrorOr<Vector<u8>> ConnectionBase::read_as_much_as_possible_from_socket_without
         bytes.append(bytes_read.data(), bytes_read.size());
         for (auto const& fd : received_fds)
             m_unprocessed_fds.enqueue(IPC::File::adopt_fd(fd));
+
+        // NOTE: A short read means we've drained the socket for now, so don't spend another syscall just to be told so.
+        //       If more arrives in the meantime (or the read was cut short by attached descriptors), the socket is
+        //       still readable and we'll get back here.
+        if (bytes_read.size() < sizeof(buffer))
+            break;
     }
 
     if (!bytes.is_empty()) {
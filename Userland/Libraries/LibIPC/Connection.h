@@ -10,6 +10,7 @@
 #include <AK/ByteBuffer.h>
 #include <AK/Queue.h>
 #include <AK/Try.h>
+#include <LibCore/AnonymousBuffer.h>
 #include <LibCore/Event.h>
 #include <LibCore/EventLoop.h>
 #include <LibCore/Notifier.h>
@@ -69,6 +70,7 @@ protected:
     ErrorOr<void> drain_messages_from_peer();
 
     ErrorOr<void> post_message(MessageBuffer, MessageKind);
+    void enqueue_local_message(NonnullOwnPtr<Message>);
     void handle_messages();
 
     IPC::Stub& m_local_stub;
@@ -137,14 +139,27 @@ protected:
         u32 message_size = 0;
         for (; index + sizeof(message_size) < bytes.size(); index += message_size) {
             memcpy(&message_size, bytes.data() + index, sizeof(message_size));
+            bool is_large_message = message_size & large_message_flag;
+            message_size &= ~large_message_flag;
             if (message_size == 0 || bytes.size() - index - sizeof(uint32_t) < message_size)
                 break;
             index += sizeof(message_size);
             auto remaining_bytes = ReadonlyBytes { bytes.data() + index, message_size };
 
+            Core::AnonymousBuffer large_message_data;
+            if (is_large_message) {
+                auto data_or_error = receive_large_message_data(remaining_bytes, m_unprocessed_fds);
+                if (data_or_error.is_error()) {
+                    dbgln("Failed to receive a large message: {}", data_or_error.error());
+                    break;
+                }
+                large_message_data = data_or_error.release_value();
+                remaining_bytes = ReadonlyBytes { large_message_data.data<u8>(), large_message_data.size() };
+            }
+
             auto local_message = LocalEndpoint::decode_message(remaining_bytes, m_unprocessed_fds);
             if (!local_message.is_error()) {
-                m_unprocessed_messages.append(local_message.release_value());
+                enqueue_local_message(local_message.release_value());
                 continue;
             }
 
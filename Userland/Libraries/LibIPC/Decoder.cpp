@@ -23,10 +23,21 @@ ErrorOr<size_t> Decoder::decode_size()
     return static_cast<size_t>(TRY(decode<u32>()));
 }
 
+// See shared_data_threshold.
+static ErrorOr<Core::AnonymousBuffer> decode_shared_data(Decoder& decoder, size_t length)
+{
+    auto file = TRY(decoder.decode<IPC::File>());
+    return Core::AnonymousBuffer::create_from_anon_fd(file.take_fd(), length);
+}
+
 template<>
 ErrorOr<String> decode(Decoder& decoder)
 {
     auto length = TRY(decoder.decode_size());
+    if (length > shared_data_threshold) {
+        auto data = TRY(decode_shared_data(decoder, length));
+        return String::from_utf8(StringView { data.data<char>(), data.size() });
+    }
     return String::from_stream(decoder.stream(), length);
 }
 
@@ -49,6 +60,10 @@ ErrorOr<ByteBuffer> decode(Decoder& decoder)
     auto length = TRY(decoder.decode_size());
     if (length == 0)
         return ByteBuffer {};
+    if (length > shared_data_threshold) {
+        auto data = TRY(decode_shared_data(decoder, length));
+        return ByteBuffer::copy(ReadonlyBytes { data.data<u8>(), data.size() });
+    }
 
     auto buffer = TRY(ByteBuffer::create_uninitialized(length));
     auto bytes = buffer.bytes();
@@ -31,6 +31,17 @@ ErrorOr<void> Encoder::encode_size(size_t size)
     return encode(static_cast<u32>(size));
 }
 
+static ErrorOr<void> encode_data(Encoder& encoder, ReadonlyBytes data)
+{
+    TRY(encoder.encode_size(data.size()));
+    if (data.size() <= shared_data_threshold)
+        return encoder.append(data.data(), data.size());
+
+    auto buffer = TRY(Core::AnonymousBuffer::create_with_size(data.size()));
+    data.copy_to({ buffer.data<u8>(), buffer.size() });
+    return encoder.encode(TRY(IPC::File::clone_fd(buffer.fd())));
+}
+
 template<>
 ErrorOr<void> encode(Encoder& encoder, float const& value)
 {
@@ -46,10 +57,7 @@ ErrorOr<void> encode(Encoder& encoder, double const& value)
 template<>
 ErrorOr<void> encode(Encoder& encoder, String const& value)
 {
-    auto bytes = value.bytes();
-    TRY(encoder.encode_size(bytes.size()));
-    TRY(encoder.append(bytes.data(), bytes.size()));
-    return {};
+    return encode_data(encoder, value.bytes());
 }
 
 template<>
@@ -73,9 +81,7 @@ ErrorOr<void> encode(Encoder& encoder, ByteString const& value)
 template<>
 ErrorOr<void> encode(Encoder& encoder, ByteBuffer const& value)
 {
-    TRY(encoder.encode_size(value.size()));
-    TRY(encoder.append(value.data(), value.size()));
-    return {};
+    return encode_data(encoder, value.bytes());
 }
 
 template<>
@@ -5,8 +5,12 @@
  */
 
 #include <AK/Checked.h>
+#include <AK/NumericLimits.h>
+#include <LibCore/AnonymousBuffer.h>
 #include <LibCore/EventLoop.h>
 #include <LibCore/Socket.h>
+#include <LibCore/System.h>
+#include <LibIPC/File.h>
 #include <LibIPC/Message.h>
 #include <sched.h>
 
@@ -14,6 +18,20 @@ namespace IPC {
 
 using MessageSizeType = u32;
 
+ErrorOr<Core::AnonymousBuffer> receive_large_message_data(ReadonlyBytes header, Queue<File>& files)
+{
+    MessageSizeType data_size = 0;
+    if (header.size() != sizeof(data_size))
+        return Error::from_string_literal("Malformed large message header");
+    memcpy(&data_size, header.data(), sizeof(data_size));
+
+    // NOTE: The sender puts the descriptor of the buffer in front of the ones that belong to the message itself.
+    if (files.is_empty())
+        return Error::from_string_literal("Large message without a buffer");
+    auto file = files.dequeue();
+    return Core::AnonymousBuffer::create_from_anon_fd(file.take_fd(), data_size);
+}
+
 MessageBuffer::MessageBuffer()
 {
     m_data.resize(sizeof(MessageSizeType));
@@ -38,15 +56,42 @@ ErrorOr<void> MessageBuffer::append_file_descriptor(int fd)
     return {};
 }
 
+ErrorOr<u32> MessageBuffer::move_data_into_anonymous_buffer()
+{
+    auto data = m_data.span().slice(sizeof(MessageSizeType));
+    if (data.size() > NumericLimits<MessageSizeType>::max())
+        return Error::from_string_literal("Message is too large for IPC encoding");
+
+    auto buffer = TRY(Core::AnonymousBuffer::create_with_size(data.size()));
+    data.copy_to({ buffer.data<u8>(), buffer.size() });
+
+    // NOTE: The buffer gets unmapped and closes its descriptor when we're done here, so the peer gets a duplicate.
+    //       It goes in front of the message's own descriptors, since the peer needs it before decoding the message.
+    auto fd = TRY(Core::System::dup(buffer.fd()));
+    auto auto_fd = TRY(adopt_nonnull_ref_or_enomem(new (nothrow) AutoCloseFileDescriptor(fd)));
+    TRY(m_fds.try_prepend(move(auto_fd)));
+
+    // The header is just the size of the data that's in the buffer.
+    MessageSizeType const data_size = data.size();
+    m_data.resize(sizeof(MessageSizeType));
+    TRY(append_data(reinterpret_cast<u8 const*>(&data_size), sizeof(data_size)));
+    return sizeof(data_size) | large_message_flag;
+}
+
 ErrorOr<void> MessageBuffer::transfer_message(Core::LocalSocket& socket, bool block_event_loop)
 {
-    Checked<MessageSizeType> checked_message_size { m_data.size() };
-    checked_message_size -= sizeof(MessageSizeType);
+    MessageSizeType message_size = 0;
+    if (m_data.size() - sizeof(MessageSizeType) > large_message_threshold) {
+        message_size = TRY(move_data_into_anonymous_buffer());
+    } else {
+        Checked<MessageSizeType> checked_message_size { m_data.size() };
+        checked_message_size -= sizeof(MessageSizeType);
 
-    if (checked_message_size.has_overflow())
-        return Error::from_string_literal("Message is too large for IPC encoding");
+        if (checked_message_size.has_overflow())
+            return Error::from_string_literal("Message is too large for IPC encoding");
 
-    MessageSizeType const message_size = checked_message_size.value();
+        message_size = checked_message_size.value();
+    }
     m_data.span().overwrite(0, reinterpret_cast<u8 const*>(&message_size), sizeof(message_size));
 
     auto raw_fds = Vector<int, 1> {};
@@ -8,14 +8,28 @@
 #pragma once
 
 #include <AK/Error.h>
+#include <AK/Queue.h>
 #include <AK/RefCounted.h>
 #include <AK/RefPtr.h>
 #include <AK/Vector.h>
 #include <LibCore/Forward.h>
+#include <LibIPC/Forward.h>
 #include <unistd.h>
 
 namespace IPC {
 
+// Messages larger than this don't go through the socket. Their data is put into an anonymous buffer instead,
+// whose pages are handed over to the peer alongside a small header.
+static constexpr size_t large_message_threshold = 64 * KiB;
+// Set in the size of a message that is just the header of a large message.
+static constexpr u32 large_message_flag = 1u << 31;
+// Byte buffers and strings larger than this are encoded as the descriptor of an anonymous buffer holding their data,
+// so they neither get copied into the message nor make it a large message.
+static constexpr size_t shared_data_threshold = 64 * KiB;
+
+// Maps the data of a large message, given its header and the descriptors that came with it.
+ErrorOr<Core::AnonymousBuffer> receive_large_message_data(ReadonlyBytes header, Queue<File>& files);
+
 class AutoCloseFileDescriptor : public RefCounted<AutoCloseFileDescriptor> {
 public:
     AutoCloseFileDescriptor(int fd)
@@ -47,6 +61,8 @@ public:
     ErrorOr<void> transfer_message(Core::LocalSocket& socket, bool block_event_loop = false);
 
 private:
+    ErrorOr<u32> move_data_into_anonymous_buffer();
+
     Vector<u8, 1024> m_data;
     Vector<NonnullRefPtr<AutoCloseFileDescriptor>, 1> m_fds;
 };
@@ -68,6 +84,10 @@ public:
     virtual bool valid() const = 0;
     virtual ErrorOr<MessageBuffer> encode() const = 0;
 
+    // Whether this message makes an earlier one that hasn't been handled yet redundant. Messages opt into this
+    // with the [Coalesce] attribute in their endpoint definition.
+    virtual bool supersedes(Message const&) const { return false; }
+
 protected:
     Message() = default;
 };
@@ -26,6 +26,16 @@ void Client::die()
 }
 
 NonnullRefPtr<Core::Promise<DecodedImage>> Client::decode_image(ReadonlyBytes encoded_data, Function<ErrorOr<void>(DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type)
+{
+    return start_decoding(encoded_data, move(on_resolved), move(on_rejected), ideal_size, move(mime_type), IsPartialData::No);
+}
+
+NonnullRefPtr<Core::Promise<DecodedImage>> Client::decode_partial_image(ReadonlyBytes encoded_data, Function<ErrorOr<void>(DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type)
+{
+    return start_decoding(encoded_data, move(on_resolved), move(on_rejected), ideal_size, move(mime_type), IsPartialData::Yes);
+}
+
+NonnullRefPtr<Core::Promise<DecodedImage>> Client::start_decoding(ReadonlyBytes encoded_data, Function<ErrorOr<void>(DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type, IsPartialData is_partial_data)
 {
     auto promise = Core::Promise<DecodedImage>::construct();
     if (on_resolved)
@@ -48,18 +58,51 @@ NonnullRefPtr<Core::Promise<DecodedImage>> Client::decode_image(ReadonlyBytes en
 
     memcpy(encoded_buffer.data<void>(), encoded_data.data(), encoded_data.size());
 
-    auto response = send_sync_but_allow_failure<Messages::ImageDecoderServer::DecodeImage>(move(encoded_buffer), ideal_size, mime_type);
-    if (!response) {
+    Optional<i64> image_id;
+    if (is_partial_data == IsPartialData::Yes) {
+        if (auto response = send_sync_but_allow_failure<Messages::ImageDecoderServer::DecodePartialImage>(move(encoded_buffer), ideal_size, mime_type))
+            image_id = response->image_id();
+    } else {
+        if (auto response = send_sync_but_allow_failure<Messages::ImageDecoderServer::DecodeImage>(move(encoded_buffer), ideal_size, mime_type))
+            image_id = response->image_id();
+    }
+
+    if (!image_id.has_value()) {
         dbgln("ImageDecoder disconnected trying to decode image");
         promise->reject(Error::from_string_literal("ImageDecoder disconnected"));
         return promise;
     }
 
-    m_pending_decoded_images.set(response->image_id(), promise);
+    m_pending_decoded_images.set(*image_id, promise);
 
     return promise;
 }
 
+Optional<i64> Client::image_id_for_pending_promise(Core::Promise<DecodedImage> const& promise) const
+{
+    for (auto& [image_id, pending_promise] : m_pending_decoded_images) {
+        if (pending_promise.ptr() == &promise)
+            return image_id;
+    }
+    return {};
+}
+
+void Client::cancel_decoding(Core::Promise<DecodedImage> const& promise)
+{
+    auto image_id = image_id_for_pending_promise(promise);
+    if (!image_id.has_value())
+        return;
+
+    async_cancel_decoding(*image_id);
+    m_pending_decoded_images.take(*image_id).release_value()->reject(Error::from_errno(ECANCELED));
+}
+
+void Client::set_image_visibility(Core::Promise<DecodedImage> const& promise, bool is_visible)
+{
+    if (auto image_id = image_id_for_pending_promise(promise); image_id.has_value())
+        async_set_image_visibility(*image_id, is_visible);
+}
+
 void Client::did_decode_image(i64 image_id, bool is_animated, u32 loop_count, Vector<Gfx::ShareableBitmap> const& bitmaps, Vector<u32> const& durations, Gfx::FloatPoint scale)
 {
     VERIFY(!bitmaps.is_empty());
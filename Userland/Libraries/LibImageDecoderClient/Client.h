@@ -36,9 +36,24 @@ public:
 
     NonnullRefPtr<Core::Promise<DecodedImage>> decode_image(ReadonlyBytes, Function<ErrorOr<void>(DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size = {}, Optional<ByteString> mime_type = {});
 
+    // Decodes as much of the first frame as the beginning of an image that is still being downloaded covers.
+    NonnullRefPtr<Core::Promise<DecodedImage>> decode_partial_image(ReadonlyBytes, Function<ErrorOr<void>(DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size = {}, Optional<ByteString> mime_type = {});
+
+    // These only have an effect while the image is still waiting to be decoded, or is being decoded.
+    void cancel_decoding(Core::Promise<DecodedImage> const&);
+    void set_image_visibility(Core::Promise<DecodedImage> const&, bool is_visible);
+
     Function<void()> on_death;
 
 private:
+    enum class IsPartialData {
+        No,
+        Yes,
+    };
+    NonnullRefPtr<Core::Promise<DecodedImage>> start_decoding(ReadonlyBytes, Function<ErrorOr<void>(DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type, IsPartialData);
+
+    Optional<i64> image_id_for_pending_promise(Core::Promise<DecodedImage> const&) const;
+
     virtual void die() override;
 
     virtual void did_decode_image(i64 image_id, bool is_animated, u32 loop_count, Vector<Gfx::ShareableBitmap> const& bitmaps, Vector<u32> const& durations, Gfx::FloatPoint scale) override;
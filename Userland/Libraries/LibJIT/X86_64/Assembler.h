@@ -1017,6 +1017,40 @@ struct X86_64Assembler {
         emit_modrm_rm(dst, src);
     }
 
+    // movups, which moves four packed floats between XMM registers and memory that doesn't have to be aligned.
+    void mov_f32x4(Operand dst, Operand src)
+    {
+        if (dst.type == Operand::Type::FReg && (src.type == Operand::Type::FReg || src.type == Operand::Type::Mem64BaseAndOffset)) {
+            emit_rex_for_rm(dst, src, REX_W::No);
+            emit8(0x0f);
+            emit8(0x10);
+            emit_modrm_rm(dst, src);
+        } else if (dst.type == Operand::Type::Mem64BaseAndOffset && src.type == Operand::Type::FReg) {
+            emit_rex_for_mr(dst, src, REX_W::No);
+            emit8(0x0f);
+            emit8(0x11);
+            emit_modrm_mr(dst, src);
+        } else {
+            VERIFY_NOT_REACHED();
+        }
+    }
+
+    // addps, subps, mulps and divps, which operate on four packed floats.
+    void add_f32x4(Operand dst, Operand src) { emit_packed_f32_operation(0x58, dst, src); }
+    void sub_f32x4(Operand dst, Operand src) { emit_packed_f32_operation(0x5c, dst, src); }
+    void mul_f32x4(Operand dst, Operand src) { emit_packed_f32_operation(0x59, dst, src); }
+    void div_f32x4(Operand dst, Operand src) { emit_packed_f32_operation(0x5e, dst, src); }
+
+    void emit_packed_f32_operation(u8 opcode, Operand dst, Operand src)
+    {
+        // NOTE: Memory operands would have to be 16-byte aligned, so we only allow registers.
+        VERIFY(dst.type == Operand::Type::FReg && src.type == Operand::Type::FReg);
+        emit_rex_for_rm(dst, src, REX_W::No);
+        emit8(0x0f);
+        emit8(opcode);
+        emit_modrm_rm(dst, src);
+    }
+
     void native_call(
         u64 callee,
         Vector<Operand> const& preserved_registers = {},
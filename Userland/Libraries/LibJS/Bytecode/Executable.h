@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/DeprecatedFlyString.h>
 #include <AK/HashMap.h>
 #include <AK/NonnullOwnPtr.h>
@@ -23,13 +24,41 @@
 namespace JS::Bytecode {
 
 struct PropertyLookupCache {
-    WeakPtr<Shape> shape;
-    Optional<u32> property_offset;
-    WeakPtr<Object> prototype;
-    WeakPtr<PrototypeChainValidity> prototype_chain_validity;
+    // NOTE: Most access sites only ever see one or two shapes, but code that works on a few different kinds of
+    //       objects (e.g. nodes of a tree) would keep evicting a single entry, so we remember a handful of them.
+    static constexpr size_t max_number_of_shapes_to_remember = 4;
+
+    struct Entry {
+        WeakPtr<Shape> shape;
+        Optional<u32> property_offset;
+        WeakPtr<Object> prototype;
+        WeakPtr<PrototypeChainValidity> prototype_chain_validity;
+    };
+
+    // Returns a cleared entry for the given shape. This is either the stale entry we already had for it,
+    // or a new one at the front, for which the least recently added entry is dropped.
+    Entry& entry_for_shape(Shape const& shape)
+    {
+        size_t index = entries.size() - 1;
+        for (size_t i = 0; i < entries.size(); ++i) {
+            if (entries[i].shape == &shape) {
+                index = i;
+                break;
+            }
+        }
+        for (; index > 0; --index)
+            entries[index] = move(entries[index - 1]);
+        entries[0] = {};
+        entries[0].shape = shape;
+        return entries[0];
+    }
+
+    AK::Array<Entry, max_number_of_shapes_to_remember> entries;
 };
 
-struct GlobalVariableCache : public PropertyLookupCache {
+struct GlobalVariableCache {
+    WeakPtr<Shape> shape;
+    Optional<u32> property_offset;
     u64 environment_serial_number { 0 };
 };
 
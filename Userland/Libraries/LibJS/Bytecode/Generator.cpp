@@ -319,6 +319,31 @@ CodeGenerationErrorOr<NonnullGCPtr<Executable>> Generator::compile(VM& vm, ASTNo
     if (undefined_constant.has_value())
         undefined_constant.value().operand().offset_index_by(number_of_registers);
 
+    // Pass: Thread jumps through blocks that do nothing but jump somewhere else.
+    // OPTIMIZATION: Such blocks are very common, e.g. at the end of the branches of nested if statements or in front of
+    //               loop continuations. A jump can't throw, so jumping over them has no effect on exception handling,
+    //               and lets the passes below drop the jump or replace it with whatever the final target starts with.
+    auto final_jump_target = [&](size_t block_index) {
+        // NOTE: Bounding the number of hops keeps us from going around in circles in something like `for (;;) {}`.
+        for (size_t hops = 0; hops < generator.m_root_basic_blocks.size(); ++hops) {
+            InstructionStreamIterator it(generator.m_root_basic_blocks[block_index]->instruction_stream());
+            if (it.at_end() || (*it).type() != Instruction::Type::Jump)
+                break;
+            block_index = static_cast<Op::Jump const&>(*it).target().basic_block_index();
+        }
+        return block_index;
+    };
+    for (auto& block : generator.m_root_basic_blocks) {
+        Bytecode::InstructionStreamIterator it(block->instruction_stream());
+        while (!it.at_end()) {
+            auto& instruction = const_cast<Instruction&>(*it);
+            instruction.visit_labels([&](Label& label) {
+                label = Label { static_cast<u32>(final_jump_target(label.basic_block_index())) };
+            });
+            ++it;
+        }
+    }
+
     for (auto& block : generator.m_root_basic_blocks) {
         basic_block_start_offsets.append(bytecode.size());
         if (block->handler() || block->finalizer()) {
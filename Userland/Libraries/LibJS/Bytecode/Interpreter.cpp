@@ -973,6 +973,42 @@ ThrowCompletionOr<void> Sub::execute_impl(Bytecode::Interpreter& interpreter) co
     return {};
 }
 
+ThrowCompletionOr<void> Div::execute_impl(Bytecode::Interpreter& interpreter) const
+{
+    auto& vm = interpreter.vm();
+    auto const lhs = interpreter.get(m_lhs);
+    auto const rhs = interpreter.get(m_rhs);
+
+    // NOTE: Number division is plain IEEE 754 division, and the Value constructor turns an integral result back into an Int32.
+    if (lhs.is_number() && rhs.is_number()) {
+        interpreter.set(m_dst, Value(lhs.as_double() / rhs.as_double()));
+        return {};
+    }
+
+    interpreter.set(m_dst, TRY(div(vm, lhs, rhs)));
+    return {};
+}
+
+ThrowCompletionOr<void> Mod::execute_impl(Bytecode::Interpreter& interpreter) const
+{
+    auto& vm = interpreter.vm();
+    auto const lhs = interpreter.get(m_lhs);
+    auto const rhs = interpreter.get(m_rhs);
+
+    if (lhs.is_number() && rhs.is_number()) {
+        // NOTE: A negative dividend could produce -0, which isn't an Int32, so we leave that case to fmod().
+        if (lhs.is_int32() && rhs.is_int32() && lhs.as_i32() >= 0 && rhs.as_i32() > 0) {
+            interpreter.set(m_dst, Value(lhs.as_i32() % rhs.as_i32()));
+            return {};
+        }
+        interpreter.set(m_dst, Value(fmod(lhs.as_double(), rhs.as_double())));
+        return {};
+    }
+
+    interpreter.set(m_dst, TRY(mod(vm, lhs, rhs)));
+    return {};
+}
+
 ThrowCompletionOr<void> BitwiseXor::execute_impl(Bytecode::Interpreter& interpreter) const
 {
     auto& vm = interpreter.vm();
@@ -1744,6 +1780,15 @@ ThrowCompletionOr<void> Decrement::execute_impl(Bytecode::Interpreter& interpret
     auto& vm = interpreter.vm();
     auto old_value = interpreter.get(dst());
 
+    // OPTIMIZATION: Fast path for Int32 values.
+    if (old_value.is_int32()) {
+        auto integer_value = old_value.as_i32();
+        if (integer_value != NumericLimits<i32>::min()) [[likely]] {
+            interpreter.set(dst(), Value { integer_value - 1 });
+            return {};
+        }
+    }
+
     old_value = TRY(old_value.to_numeric(vm));
 
     if (old_value.is_number())
@@ -1758,6 +1803,16 @@ ThrowCompletionOr<void> PostfixDecrement::execute_impl(Bytecode::Interpreter& in
     auto& vm = interpreter.vm();
     auto old_value = interpreter.get(m_src);
 
+    // OPTIMIZATION: Fast path for Int32 values.
+    if (old_value.is_int32()) {
+        auto integer_value = old_value.as_i32();
+        if (integer_value != NumericLimits<i32>::min()) [[likely]] {
+            interpreter.set(m_dst, old_value);
+            interpreter.set(m_src, Value { integer_value - 1 });
+            return {};
+        }
+    }
+
     old_value = TRY(old_value.to_numeric(vm));
     interpreter.set(m_dst, old_value);
 
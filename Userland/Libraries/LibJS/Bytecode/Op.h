@@ -111,20 +111,20 @@ private:
     O(BitwiseAnd, bitwise_and)                           \
     O(BitwiseOr, bitwise_or)                             \
     O(BitwiseXor, bitwise_xor)                           \
+    O(Div, div)                                          \
     O(GreaterThan, greater_than)                         \
     O(GreaterThanEquals, greater_than_equals)            \
     O(LeftShift, left_shift)                             \
     O(LessThan, less_than)                               \
     O(LessThanEquals, less_than_equals)                  \
+    O(Mod, mod)                                          \
     O(Mul, mul)                                          \
     O(RightShift, right_shift)                           \
     O(Sub, sub)                                          \
     O(UnsignedRightShift, unsigned_right_shift)
 
 #define JS_ENUMERATE_COMMON_BINARY_OPS_WITHOUT_FAST_PATH(O) \
-    O(Div, div)                                             \
     O(Exp, exp)                                             \
-    O(Mod, mod)                                             \
     O(In, in)                                               \
     O(InstanceOf, instance_of)                              \
     O(LooselyInequals, loosely_inequals)                    \
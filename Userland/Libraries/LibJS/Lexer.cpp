@@ -688,9 +688,17 @@ Token Lexer::next()
     } else if (auto code_point = is_identifier_start(identifier_length); code_point.has_value()) {
         bool has_escaped_character = false;
         // identifier or keyword
-        StringBuilder builder;
+        // OPTIMIZATION: Almost all identifiers are plain ASCII, and those we can take straight out of the source.
+        //               We only start building the identifier code point by code point once we see anything else.
+        auto identifier_start = m_position - 1;
+        Optional<StringBuilder> builder;
         do {
-            builder.append_code_point(*code_point);
+            if (!builder.has_value() && (identifier_length > 1 || !is_ascii(*code_point))) {
+                builder.emplace();
+                builder->append(m_source.substring_view(identifier_start, m_position - 1 - identifier_start));
+            }
+            if (builder.has_value())
+                builder->append_code_point(*code_point);
             for (size_t i = 0; i < identifier_length; ++i)
                 consume();
 
@@ -699,7 +707,10 @@ Token Lexer::next()
             code_point = is_identifier_middle(identifier_length);
         } while (code_point.has_value());
 
-        identifier = builder.string_view();
+        if (builder.has_value())
+            identifier = builder->string_view();
+        else
+            identifier = m_source.substring_view(identifier_start, m_position - 1 - identifier_start);
         m_parsed_identifiers->identifiers.set(*identifier);
 
         auto it = s_keywords.find(identifier->hash(), [&](auto& entry) { return entry.key == identifier; });
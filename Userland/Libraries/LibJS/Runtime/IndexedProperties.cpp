@@ -18,6 +18,10 @@ SimpleIndexedPropertyStorage::SimpleIndexedPropertyStorage(Vector<Value>&& initi
     , m_array_size(initial_values.size())
     , m_packed_elements(move(initial_values))
 {
+    for (auto const& value : m_packed_elements) {
+        if (!value.is_empty())
+            ++m_occupied_count;
+    }
 }
 
 bool SimpleIndexedPropertyStorage::has_index(u32 index) const
@@ -51,31 +55,47 @@ void SimpleIndexedPropertyStorage::put(u32 index, Value value, PropertyAttribute
         m_array_size = index + 1;
         grow_storage_if_needed();
     }
-    m_packed_elements[index] = value;
+    auto& element = m_packed_elements[index];
+    if (element.is_empty() && !value.is_empty())
+        ++m_occupied_count;
+    else if (!element.is_empty() && value.is_empty())
+        --m_occupied_count;
+    element = value;
 }
 
 void SimpleIndexedPropertyStorage::remove(u32 index)
 {
     VERIFY(index < m_array_size);
+    if (!m_packed_elements[index].is_empty())
+        --m_occupied_count;
     m_packed_elements[index] = {};
 }
 
 ValueAndAttributes SimpleIndexedPropertyStorage::take_first()
 {
     m_array_size--;
-    return { m_packed_elements.take_first(), default_attributes };
+    auto first_element = m_packed_elements.take_first();
+    if (!first_element.is_empty())
+        --m_occupied_count;
+    return { first_element, default_attributes };
 }
 
 ValueAndAttributes SimpleIndexedPropertyStorage::take_last()
 {
     m_array_size--;
     auto last_element = m_packed_elements[m_array_size];
+    if (!last_element.is_empty())
+        --m_occupied_count;
     m_packed_elements[m_array_size] = {};
     return { last_element, default_attributes };
 }
 
 bool SimpleIndexedPropertyStorage::set_array_like_size(size_t new_size)
 {
+    for (size_t i = new_size; i < m_packed_elements.size(); ++i) {
+        if (!m_packed_elements[i].is_empty())
+            --m_occupied_count;
+    }
     m_array_size = new_size;
     m_packed_elements.resize_and_keep_capacity(new_size);
     return true;
@@ -226,10 +246,25 @@ Optional<ValueAndAttributes> IndexedProperties::get(u32 index) const
     return m_storage->get(index);
 }
 
+// Writing far past the end of an array would leave a lot of holes in the packed storage, so past a point we'd rather
+// switch to the generic storage. Arrays that grow by more than a few elements at a time are common though (e.g. filling
+// one from both ends, or after setting the length), so we tolerate holes as long as the array stays about half full.
+static bool would_become_too_sparse(SimpleIndexedPropertyStorage const& storage, u32 index)
+{
+    if (index <= storage.array_like_size() + SPARSE_ARRAY_HOLE_THRESHOLD)
+        return false;
+    if (index >= LENGTH_SETTER_GENERIC_STORAGE_THRESHOLD)
+        return true;
+    // NOTE: This is measured against the elements that are actually there, not the length, so that an array can't
+    //       keep most of its packed storage empty by growing a little further each time.
+    return index + 1 > (storage.occupied_count() + 1) * 2;
+}
+
 void IndexedProperties::put(u32 index, Value value, PropertyAttributes attributes)
 {
     ensure_storage();
-    if (m_storage->is_simple_storage() && (attributes != default_attributes || index > (array_like_size() + SPARSE_ARRAY_HOLE_THRESHOLD))) {
+    if (m_storage->is_simple_storage()
+        && (attributes != default_attributes || would_become_too_sparse(static_cast<SimpleIndexedPropertyStorage const&>(*m_storage), index))) {
         switch_to_generic_storage();
     }
 
@@ -264,15 +299,8 @@ size_t IndexedProperties::real_size() const
 {
     if (!m_storage)
         return 0;
-    if (m_storage->is_simple_storage()) {
-        auto& packed_elements = static_cast<SimpleIndexedPropertyStorage const&>(*m_storage).elements();
-        size_t size = 0;
-        for (auto& element : packed_elements) {
-            if (!element.is_empty())
-                ++size;
-        }
-        return size;
-    }
+    if (m_storage->is_simple_storage())
+        return static_cast<SimpleIndexedPropertyStorage const&>(*m_storage).occupied_count();
     return static_cast<GenericIndexedPropertyStorage const&>(*m_storage).size();
 }
 
@@ -73,6 +73,8 @@ public:
     virtual bool set_array_like_size(size_t new_size) override;
 
     Vector<Value> const& elements() const { return m_packed_elements; }
+    // The number of elements that aren't holes.
+    size_t occupied_count() const { return m_occupied_count; }
 
     [[nodiscard]] bool inline_has_index(u32 index) const
     {
@@ -92,6 +94,7 @@ private:
     void grow_storage_if_needed();
 
     size_t m_array_size { 0 };
+    size_t m_occupied_count { 0 };
     Vector<Value> m_packed_elements;
 };
 
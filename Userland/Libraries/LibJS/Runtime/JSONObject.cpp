@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AnyOf.h>
 #include <AK/Function.h>
 #include <AK/JsonArray.h>
 #include <AK/JsonObject.h>
@@ -353,6 +354,15 @@ ThrowCompletionOr<ByteString> JSONObject::serialize_json_array(VM& vm, Stringify
 // 25.5.2.2 QuoteJSONString ( value ), https://tc39.es/ecma262/#sec-quotejsonstring
 ByteString JSONObject::quote_json_string(ByteString string)
 {
+    // OPTIMIZATION: Most strings (and nearly all property keys) contain nothing that has to be escaped, so we
+    //               can skip decoding them code point by code point. Surrogates are encoded with a 0xED lead byte,
+    //               so any string containing one takes the slow path below.
+    auto needs_escaping = any_of(string.bytes(), [](u8 byte) {
+        return byte < 0x20 || byte == '"' || byte == '\\' || byte == 0xED;
+    });
+    if (!needs_escaping)
+        return ByteString::formatted("\"{}\"", string);
+
     // 1. Let product be the String value consisting solely of the code unit 0x0022 (QUOTATION MARK).
     StringBuilder builder;
     builder.append('"');
@@ -497,6 +497,102 @@ inline void fast_typed_array_fill(TypedArrayBase& typed_array, u32 begin, u32 en
         *(slot++) = value;
 }
 
+enum class SearchDirection {
+    Forward,
+    Backward,
+};
+
+template<typename T, typename Callback>
+static Optional<u32> find_typed_array_element(TypedArrayBase const& typed_array, u32 begin, u32 end, SearchDirection direction, Callback matches)
+{
+    auto const* elements = reinterpret_cast<T const*>(typed_array.viewed_array_buffer()->buffer().offset_pointer(typed_array.byte_offset()));
+    if (direction == SearchDirection::Forward) {
+        for (auto i = begin; i < end; ++i) {
+            if (matches(elements[i]))
+                return i;
+        }
+    } else {
+        for (auto i = end; i > begin; --i) {
+            if (matches(elements[i - 1]))
+                return i - 1;
+        }
+    }
+    return {};
+}
+
+template<typename T>
+static Optional<u32> find_typed_array_integer(TypedArrayBase const& typed_array, double value, u32 begin, u32 end, SearchDirection direction)
+{
+    // NOTE: A Number that the element type can't represent exactly can't be equal to any of the elements.
+    if (trunc(value) != value || value < static_cast<double>(NumericLimits<T>::min()) || value > static_cast<double>(NumericLimits<T>::max()))
+        return {};
+    auto needle = static_cast<T>(value);
+    return find_typed_array_element<T>(typed_array, begin, end, direction, [needle](T element) { return element == needle; });
+}
+
+enum class NaNIsEqual {
+    No,
+    Yes,
+};
+
+// OPTIMIZATION: Comparing the raw elements to the search element is a lot cheaper than going through [[Get]] for each of them.
+//               This only handles Numbers in arrays of Numbers, for which elements that aren't present can never be equal.
+//               Returns an empty Optional if the search has to be done the slow way, and the index of the match, if any, otherwise.
+static Optional<Optional<u32>> fast_typed_array_search(TypedArrayBase const& typed_array, Value search_element, u32 begin, u32 end, SearchDirection direction, NaNIsEqual nan_is_equal)
+{
+    if (!search_element.is_number() || typed_array.content_type() != TypedArrayBase::ContentType::Number)
+        return {};
+
+    // NOTE: Evaluating fromIndex may have shrunk or detached the buffer since the caller got the length.
+    auto typed_array_record = make_typed_array_with_buffer_witness_record(typed_array, ArrayBuffer::Order::Unordered);
+    if (is_typed_array_out_of_bounds(typed_array_record))
+        return Optional<u32> {};
+    end = min(end, typed_array_length(typed_array_record));
+    if (begin >= end)
+        return Optional<u32> {};
+
+    auto value = search_element.as_double();
+    if (isnan(value)) {
+        if (nan_is_equal == NaNIsEqual::No)
+            return Optional<u32> {};
+        switch (typed_array.kind()) {
+        case TypedArrayBase::Kind::Float32Array:
+            return find_typed_array_element<float>(typed_array, begin, end, direction, [](float element) { return isnan(element); });
+        case TypedArrayBase::Kind::Float64Array:
+            return find_typed_array_element<double>(typed_array, begin, end, direction, [](double element) { return isnan(element); });
+        default:
+            return Optional<u32> {};
+        }
+    }
+
+    switch (typed_array.kind()) {
+    case TypedArrayBase::Kind::Uint8Array:
+    case TypedArrayBase::Kind::Uint8ClampedArray:
+        return find_typed_array_integer<u8>(typed_array, value, begin, end, direction);
+    case TypedArrayBase::Kind::Uint16Array:
+        return find_typed_array_integer<u16>(typed_array, value, begin, end, direction);
+    case TypedArrayBase::Kind::Uint32Array:
+        return find_typed_array_integer<u32>(typed_array, value, begin, end, direction);
+    case TypedArrayBase::Kind::Int8Array:
+        return find_typed_array_integer<i8>(typed_array, value, begin, end, direction);
+    case TypedArrayBase::Kind::Int16Array:
+        return find_typed_array_integer<i16>(typed_array, value, begin, end, direction);
+    case TypedArrayBase::Kind::Int32Array:
+        return find_typed_array_integer<i32>(typed_array, value, begin, end, direction);
+    case TypedArrayBase::Kind::Float32Array: {
+        // NOTE: Elements are widened to doubles before they are compared, so only values that survive the round trip can match.
+        auto needle = static_cast<float>(value);
+        if (static_cast<double>(needle) != value)
+            return Optional<u32> {};
+        return find_typed_array_element<float>(typed_array, begin, end, direction, [needle](float element) { return element == needle; });
+    }
+    case TypedArrayBase::Kind::Float64Array:
+        return find_typed_array_element<double>(typed_array, begin, end, direction, [value](double element) { return element == value; });
+    default:
+        return {};
+    }
+}
+
 // 23.2.3.9 %TypedArray%.prototype.fill ( value [ , start [ , end ] ] ), https://tc39.es/ecma262/#sec-%typedarray%.prototype.fill
 JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::fill)
 {
@@ -917,6 +1013,9 @@ JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::includes)
         k = relative_k;
     }
 
+    if (auto result = fast_typed_array_search(*typed_array, search_element, k, length, SearchDirection::Forward, NaNIsEqual::Yes); result.has_value())
+        return Value { result->has_value() };
+
     // 11. Repeat, while k < len,
     while (k < length) {
         // a. Let elementK be ! Get(O, ! ToString(𝔽(k))).
@@ -986,6 +1085,9 @@ JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::index_of)
         k = relative_k;
     }
 
+    if (auto result = fast_typed_array_search(*typed_array, search_element, k, length, SearchDirection::Forward, NaNIsEqual::No); result.has_value())
+        return result->has_value() ? Value { result->value() } : Value { -1 };
+
     // 11. Repeat, while k < len,
     while (k < length) {
         // a. Let kPresent be ! HasProperty(O, ! ToString(𝔽(k))).
@@ -1123,6 +1225,11 @@ JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::last_index_of)
         k = relative_k;
     }
 
+    if (k >= 0) {
+        if (auto result = fast_typed_array_search(*typed_array, search_element, 0, k + 1, SearchDirection::Backward, NaNIsEqual::No); result.has_value())
+            return result->has_value() ? Value { result->value() } : Value { -1 };
+    }
+
     // 9. Repeat, while k ≥ 0,
     while (k >= 0) {
         // a. Let kPresent be ! HasProperty(O, ! ToString(𝔽(k))).
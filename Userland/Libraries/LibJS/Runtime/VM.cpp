@@ -215,8 +215,8 @@ void VM::gather_roots(HashMap<Cell*, HeapRoot>& roots)
     for (auto& saved_stack : m_saved_execution_context_stacks)
         gather_roots_from_execution_context_stack(saved_stack);
 
-    for (auto& job : m_promise_jobs)
-        roots.set(job, HeapRoot { .type = HeapRoot::Type::VM });
+    for (size_t i = m_next_promise_job_index; i < m_promise_jobs.size(); ++i)
+        roots.set(m_promise_jobs[i], HeapRoot { .type = HeapRoot::Type::VM });
 }
 
 // 9.1.2.1 GetIdentifierReference ( env, name, strict ), https://tc39.es/ecma262/#sec-getidentifierreference
@@ -366,12 +366,17 @@ void VM::run_queued_promise_jobs()
 {
     dbgln_if(PROMISE_DEBUG, "Running queued promise jobs");
 
-    while (!m_promise_jobs.is_empty()) {
-        auto job = m_promise_jobs.take_first();
+    // NOTE: Jobs are consumed by advancing an index instead of taking them off the front of the vector,
+    //       which would shift every job that is still queued (and every job the running ones enqueue).
+    while (m_next_promise_job_index < m_promise_jobs.size()) {
+        auto job = m_promise_jobs[m_next_promise_job_index++];
         dbgln_if(PROMISE_DEBUG, "Calling promise job function");
 
         [[maybe_unused]] auto result = job->function()();
     }
+
+    m_promise_jobs.clear_with_capacity();
+    m_next_promise_job_index = 0;
 }
 
 // 9.5.4 HostEnqueuePromiseJob ( job, realm ), https://tc39.es/ecma262/#sec-hostenqueuepromisejob
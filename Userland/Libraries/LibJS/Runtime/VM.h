@@ -293,6 +293,7 @@ private:
     HashMap<String, NonnullGCPtr<Symbol>> m_global_symbol_registry;
 
     Vector<NonnullGCPtr<HeapFunction<ThrowCompletionOr<Value>()>>> m_promise_jobs;
+    size_t m_next_promise_job_index { 0 };
 
     Vector<GCPtr<FinalizationRegistry>> m_finalization_registry_cleanup_jobs;
 
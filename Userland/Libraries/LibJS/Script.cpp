@@ -26,7 +26,12 @@ Result<NonnullGCPtr<Script>, Vector<ParserError>> Script::parse(StringView sourc
         return parser.errors();
 
     // 3. Return Script Record { [[Realm]]: realm, [[ECMAScriptCode]]: script, [[HostDefined]]: hostDefined }.
-    return realm.heap().allocate_without_realm<Script>(realm, filename, move(script), host_defined);
+    return create(realm, filename, move(script), host_defined);
+}
+
+NonnullGCPtr<Script> Script::create(Realm& realm, StringView filename, NonnullRefPtr<Program> parse_node, HostDefined* host_defined)
+{
+    return realm.heap().allocate_without_realm<Script>(realm, filename, move(parse_node), host_defined);
 }
 
 Script::Script(Realm& realm, StringView filename, NonnullRefPtr<Program> parse_node, HostDefined* host_defined)
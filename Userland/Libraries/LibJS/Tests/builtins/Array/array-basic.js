@@ -63,3 +63,53 @@ test("assigning array expression with destination referenced in array expression
     }
     expect(go("foo")).toEqual(["foo"]);
 });
+
+test("writing past the end of an array", () => {
+    let a = [];
+    for (let i = 0; i < 1000; ++i) a.push(i);
+
+    // Far enough past the end that the array ends up with a lot of holes, but still more than half full.
+    a[1500] = "x";
+    expect(a).toHaveLength(1501);
+    expect(a[999]).toBe(999);
+    expect(a[1000]).toBeUndefined();
+    expect(1000 in a).toBeFalse();
+    expect(a[1500]).toBe("x");
+    expect(Object.keys(a)).toHaveLength(1001);
+
+    // Far enough past the end that most of the array would be holes.
+    a[100000] = "y";
+    expect(a).toHaveLength(100001);
+    expect(a[1500]).toBe("x");
+    expect(a[100000]).toBe("y");
+    expect(50000 in a).toBeFalse();
+    expect(Object.keys(a)).toHaveLength(1002);
+
+    let b = [];
+    b.length = 300;
+    b[500] = 1;
+    expect(b).toHaveLength(501);
+    expect(b.indexOf(1)).toBe(500);
+    expect(b.reduce((sum, value) => sum + value, 0)).toBe(1);
+});
+
+test("growing a mostly empty array past its end", () => {
+    let a = [];
+    a.length = 1000;
+    a[0] = 0;
+
+    // Within twice the length, but only two of the elements would actually be there.
+    a[1300] = 1300;
+    expect(a).toHaveLength(1301);
+    expect(a[0]).toBe(0);
+    expect(a[1300]).toBe(1300);
+    expect(Object.keys(a)).toEqual(["0", "1300"]);
+
+    for (let i = 1; i < 10; ++i) a[1300 + i * 300] = i;
+    expect(a).toHaveLength(4001);
+    expect(Object.keys(a)).toHaveLength(11);
+    expect(a[3700]).toBe(8);
+    expect(a.pop()).toBe(9);
+    expect(a).toHaveLength(4000);
+    expect(Object.keys(a)).toHaveLength(10);
+});
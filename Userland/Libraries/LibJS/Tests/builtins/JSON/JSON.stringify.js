@@ -71,6 +71,14 @@ describe("correct behavior", () => {
         expect(JSON.stringify("\ud83d\ud83d\ude04\ud83d\ude04\ude04")).toBe('"\\ud83d😄😄\\ude04"');
         expect(JSON.stringify("\ude04\ud83d\ude04\ud83d\ude04\ud83d")).toBe('"\\ude04😄😄\\ud83d"');
     });
+
+    test("strings with and without characters that need escaping", () => {
+        expect(JSON.stringify("foo bar")).toBe('"foo bar"');
+        expect(JSON.stringify("ünïcödé 😄")).toBe('"ünïcödé 😄"');
+        expect(JSON.stringify("\ud7a3")).toBe('"\ud7a3"');
+        expect(JSON.stringify('a"b\\c\n')).toBe('"a\\"b\\\\c\\n"');
+        expect(JSON.stringify({ 'q"uote': 1, plain: 2 })).toBe('{"q\\"uote":1,"plain":2}');
+    });
 });
 
 describe("errors", () => {
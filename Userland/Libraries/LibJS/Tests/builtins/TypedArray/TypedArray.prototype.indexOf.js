@@ -62,3 +62,16 @@ test("basic functionality", () => {
         expect(typedArray.indexOf(2n, -2)).toBe(1);
     });
 });
+
+test("values the element type can't represent", () => {
+    expect(new Uint8Array([255, 1]).indexOf(-1)).toBe(-1);
+    expect(new Uint8Array([0, 1]).indexOf(256)).toBe(-1);
+    expect(new Int32Array([1, 2]).indexOf(1.5)).toBe(-1);
+    expect(new Int32Array([0, 1]).indexOf(-0)).toBe(0);
+    expect(new Float32Array([0.1, 0.5]).indexOf(0.1)).toBe(-1);
+    expect(new Float32Array([0.1, 0.5]).indexOf(0.5)).toBe(1);
+    expect(new Float64Array([NaN, 1]).indexOf(NaN)).toBe(-1);
+    expect(new Float64Array([NaN, 1]).includes(NaN)).toBeTrue();
+    expect(new Float32Array([1, NaN, 1]).lastIndexOf(1)).toBe(2);
+    expect(new Uint8Array([1, 2]).indexOf("1")).toBe(-1);
+});
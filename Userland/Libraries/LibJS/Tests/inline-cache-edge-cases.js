@@ -16,3 +16,59 @@ test("Inline cache invalidated by deleting property from unique shape", () => {
     expect(first).toBe(2);
     expect(second).toBeUndefined();
 });
+
+test("Polymorphic access site sees the right value for each shape", () => {
+    // Every object has the property at a different offset, and there are more shapes than the cache has entries.
+    let objects = [];
+    for (let i = 0; i < 8; ++i) {
+        let o = {};
+        for (let j = 0; j < i; ++j) o["padding" + j] = j;
+        o.value = i;
+        objects.push(o);
+    }
+
+    function get(o) {
+        return o.value;
+    }
+
+    function put(o, value) {
+        o.value = value;
+    }
+
+    for (let round = 0; round < 3; ++round) {
+        for (let i = 0; i < objects.length; ++i) {
+            expect(get(objects[i])).toBe(i + round * 10);
+            put(objects[i], i + (round + 1) * 10);
+        }
+    }
+});
+
+test("Polymorphic access site with prototype chain entries", () => {
+    class A {
+        get name() {
+            return "A";
+        }
+    }
+    class B {
+        get name() {
+            return "B";
+        }
+    }
+
+    function name(o) {
+        return o.name;
+    }
+
+    let a = new A();
+    let b = new B();
+    let own = { name: "own" };
+    for (let i = 0; i < 3; ++i) {
+        expect(name(a)).toBe("A");
+        expect(name(b)).toBe("B");
+        expect(name(own)).toBe("own");
+    }
+
+    Object.defineProperty(B.prototype, "name", { value: "changed" });
+    expect(name(a)).toBe("A");
+    expect(name(b)).toBe("changed");
+});
@@ -8,3 +8,33 @@ test("basic functionality", () => {
     }
     expect(j).toBe(8);
 });
+
+test("continue out of nested blocks", () => {
+    let visited = [];
+    outer: for (let i = 0; i < 4; ++i) {
+        for (let j = 0; j < 4; ++j) {
+            if (j === 1) {
+                if (i % 2 === 0) {
+                    continue outer;
+                } else {
+                    continue;
+                }
+            }
+            visited.push(`${i}${j}`);
+        }
+    }
+    expect(visited).toEqual(["00", "10", "12", "13", "20", "30", "32", "33"]);
+});
+
+test("continue through finally", () => {
+    let log = [];
+    for (let i = 0; i < 3; ++i) {
+        try {
+            if (i === 1) continue;
+            log.push(`try${i}`);
+        } finally {
+            log.push(`finally${i}`);
+        }
+    }
+    expect(log).toEqual(["try0", "finally0", "finally1", "try2", "finally2"]);
+});
@@ -37,3 +37,42 @@ test("basic functionality", () => {
     expect(undefined % undefined).toBeNaN();
     expect(null % null).toBeNaN();
 });
+
+test("Int32 operands", () => {
+    const remainder = (a, b) => a % b;
+    expect(remainder(10, 3)).toBe(1);
+    expect(remainder(0, 3)).toBe(0);
+    expect(remainder(2147483647, 2)).toBe(1);
+    expect(remainder(-4, 2)).toBe(-0);
+    expect(remainder(-2147483648, -1)).toBe(-0);
+    expect(remainder(4, -3)).toBe(1);
+    expect(remainder(4, 0)).toBeNaN();
+    expect(remainder(-7n, 2n)).toBe(-1n);
+});
+
+test("division", () => {
+    const quotient = (a, b) => a / b;
+    expect(quotient(10, 2)).toBe(5);
+    expect(quotient(10, 4)).toBe(2.5);
+    expect(quotient(0, -5)).toBe(-0);
+    expect(quotient(-2147483648, -1)).toBe(2147483648);
+    expect(quotient(1, 0)).toBe(Infinity);
+    expect(quotient(0, 0)).toBeNaN();
+    expect(quotient("9", 3)).toBe(3);
+});
+
+test("decrement", () => {
+    let i = 5;
+    expect(i--).toBe(5);
+    expect(i).toBe(4);
+    expect(--i).toBe(3);
+
+    let minimum = -2147483648;
+    expect(minimum--).toBe(-2147483648);
+    expect(minimum).toBe(-2147483649);
+    expect(--minimum).toBe(-2147483650);
+
+    let string = "3";
+    expect(string--).toBe(3);
+    expect(string).toBe(2);
+});
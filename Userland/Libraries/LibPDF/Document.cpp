@@ -6,6 +6,7 @@
 
 #include <LibPDF/CommonNames.h>
 #include <LibPDF/Document.h>
+#include <LibPDF/Fonts/PDFFont.h>
 #include <LibPDF/Parser.h>
 #include <LibTextCodec/Decoder.h>
 
@@ -129,6 +130,8 @@ Document::Document(NonnullRefPtr<DocumentParser> const& parser)
     m_parser->set_document(this);
 }
 
+Document::~Document() = default;
+
 PDFErrorOr<void> Document::initialize()
 {
     if (m_security_handler)
@@ -151,6 +154,23 @@ PDFErrorOr<Value> Document::get_or_load_value(u32 index)
     return object;
 }
 
+PDFErrorOr<NonnullRefPtr<PDFFont>> Document::get_or_load_font(FontCacheKey const& key)
+{
+    auto it = m_font_cache.find(key);
+    if (it != m_font_cache.end()) {
+        // Update the potentially-stale size set in text_set_matrix_and_line_matrix().
+        it->value->set_font_size(key.font_size);
+        return it->value;
+    }
+
+    if (m_font_cache.size() >= max_cached_fonts)
+        m_font_cache.clear();
+
+    auto font = TRY(PDFFont::create(this, key.font_dictionary, key.font_size));
+    m_font_cache.set(key, font);
+    return font;
+}
+
 u32 Document::get_first_page_index() const
 {
     // FIXME: A PDF can have a different default first page, which
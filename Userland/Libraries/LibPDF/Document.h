@@ -106,6 +106,7 @@ public:
     static ByteString text_string_to_utf8(ByteString const&);
 
     static PDFErrorOr<NonnullRefPtr<Document>> create(ReadonlyBytes bytes);
+    ~Document();
 
     // If a security handler is present, it is the caller's responsibility to ensure
     // this document is unencrypted before calling this function. The user does not
@@ -158,6 +159,17 @@ public:
 
     PDFErrorOr<void> unfilter_stream(NonnullRefPtr<StreamObject> stream) { return m_parser->unfilter_stream(move(stream)); }
 
+    struct FontCacheKey {
+        NonnullRefPtr<DictObject> font_dictionary;
+        float font_size;
+
+        bool operator==(FontCacheKey const&) const = default;
+    };
+
+    // Loading a font is expensive, and most fonts are used on many pages, so loaded fonts are
+    // shared between the renderers of all pages.
+    PDFErrorOr<NonnullRefPtr<PDFFont>> get_or_load_font(FontCacheKey const&);
+
 private:
     explicit Document(NonnullRefPtr<DocumentParser> const& parser);
 
@@ -194,12 +206,24 @@ private:
     HashMap<u32, Value> m_values;
     RefPtr<OutlineDict> m_outline;
     RefPtr<SecurityHandler> m_security_handler;
+
+    // Every zoom level adds entries for all fonts that are rendered at it, so the cache is emptied at this size.
+    static constexpr size_t max_cached_fonts = 256;
+    HashMap<FontCacheKey, NonnullRefPtr<PDFFont>> m_font_cache;
 };
 
 }
 
 namespace AK {
 
+template<>
+struct Traits<PDF::Document::FontCacheKey> : public DefaultTraits<PDF::Document::FontCacheKey> {
+    static unsigned hash(PDF::Document::FontCacheKey const& key)
+    {
+        return pair_int_hash(ptr_hash(key.font_dictionary.ptr()), int_hash(bit_cast<u32>(key.font_size)));
+    }
+};
+
 template<>
 struct Formatter<PDF::Destination> : Formatter<FormatString> {
     ErrorOr<void> format(FormatBuilder& builder, PDF::Destination const& destination)
@@ -590,17 +590,25 @@ PDFErrorOr<NonnullRefPtr<DictObject>> DocumentParser::parse_file_trailer()
     return parse_dict();
 }
 
-PDFErrorOr<Value> DocumentParser::parse_compressed_object_with_index(u32 index)
+PDFErrorOr<DocumentParser::ObjectStream const*> DocumentParser::object_stream(u32 index)
 {
-    auto object_stream_index = m_xref_table->object_stream_for_object(index);
-    auto stream_offset = m_xref_table->byte_offset_for_object(object_stream_index);
+    for (size_t i = 0; i < m_object_stream_cache.size(); ++i) {
+        if (m_object_stream_cache[i].index != index)
+            continue;
+        // Keep the cache ordered from least to most recently used.
+        if (i != m_object_stream_cache.size() - 1)
+            m_object_stream_cache.append(m_object_stream_cache.take(i));
+        return &m_object_stream_cache.last();
+    }
+
+    auto stream_offset = m_xref_table->byte_offset_for_object(index);
 
     m_reader.move_to(stream_offset);
 
     auto obj_stream = TRY(parse_indirect_value());
     auto stream = TRY(indirect_value_as_stream(obj_stream));
 
-    if (obj_stream->index() != object_stream_index)
+    if (obj_stream->index() != index)
         return error("Mismatching object stream index");
 
     auto dict = stream->dict();
@@ -617,14 +625,36 @@ PDFErrorOr<Value> DocumentParser::parse_compressed_object_with_index(u32 index)
     // The data was already decrypted when reading the outer compressed ObjStm.
     stream_parser.set_encryption_enabled(false);
 
+    HashMap<u32, u32> object_offsets;
     for (u32 i = 0; i < object_count; ++i) {
         auto object_number = TRY(stream_parser.parse_number());
         auto object_offset = TRY(stream_parser.parse_number());
+        // If an object number appears more than once, the first occurrence is the one that gets used.
+        object_offsets.ensure(object_number.get_u32(), [&] { return object_offset.get_u32(); });
+    }
 
-        if (object_number.get_u32() == index) {
-            stream_parser.move_to(first_object_offset + object_offset.get_u32());
-            break;
-        }
+    if (m_object_stream_cache.size() == object_stream_cache_size)
+        m_object_stream_cache.remove(0);
+    m_object_stream_cache.append({ index, move(stream), object_count, first_object_offset, move(object_offsets) });
+    return &m_object_stream_cache.last();
+}
+
+PDFErrorOr<Value> DocumentParser::parse_compressed_object_with_index(u32 index)
+{
+    auto const& object_stream = *TRY(this->object_stream(m_xref_table->object_stream_for_object(index)));
+    auto stream = object_stream.stream;
+
+    Parser stream_parser(m_document, stream->bytes());
+
+    // The data was already decrypted when reading the outer compressed ObjStm.
+    stream_parser.set_encryption_enabled(false);
+
+    if (auto object_offset = object_stream.object_offsets.get(index); object_offset.has_value()) {
+        stream_parser.move_to(object_stream.first_object_offset + object_offset.value());
+    } else {
+        // The object is not in the stream after all, so continue parsing after the object number and offset pairs.
+        for (u32 i = 0; i < 2 * object_stream.object_count; ++i)
+            TRY(stream_parser.parse_number());
     }
 
     stream_parser.push_reference({ index, 0 });
@@ -97,11 +97,25 @@ private:
     PDFErrorOr<NonnullRefPtr<DictObject>> parse_file_trailer();
     PDFErrorOr<Value> parse_compressed_object_with_index(u32 index);
 
+    struct ObjectStream {
+        u32 index { 0 };
+        NonnullRefPtr<StreamObject> stream;
+        u32 object_count { 0 };
+        u32 first_object_offset { 0 };
+        HashMap<u32, u32> object_offsets;
+    };
+    PDFErrorOr<ObjectStream const*> object_stream(u32 index);
+
     bool navigate_to_before_eof_marker();
     bool navigate_to_after_startxref();
 
     RefPtr<XRefTable> m_xref_table;
     Optional<LinearizationDictionary> m_linearization_dictionary;
+
+    // Object streams usually contain many objects, which tend to be loaded together. To not inflate and
+    // parse the same stream again for each of them, the most recently used object streams are kept around.
+    static constexpr size_t object_stream_cache_size = 8;
+    Vector<ObjectStream, object_stream_cache_size> m_object_stream_cache;
 };
 
 }
@@ -96,18 +96,35 @@ enum class OperatorType {
 
 class Operator {
 public:
+    // Most operators take at most six operands, so they are stored inline to not allocate for each operator.
+    using Arguments = Vector<Value, 6>;
+
+    // Operator symbols are at most three characters long, so their characters form a unique key to switch on.
+    static constexpr u32 symbol_key(StringView symbol_string)
+    {
+        u32 key = 0;
+        for (auto ch : symbol_string)
+            key = (key << 8) | static_cast<u8>(ch);
+        return key;
+    }
+
     static OperatorType operator_type_from_symbol(StringView symbol_string)
     {
+        if (symbol_string.length() <= 3) {
+            switch (symbol_key(symbol_string)) {
 #define V(name, snake_name, symbol) \
-    if (symbol_string == #symbol)   \
+    case symbol_key(#symbol##sv):   \
         return OperatorType::name;
-        ENUMERATE_OPERATORS(V)
+                ENUMERATE_OPERATORS(V)
 #undef V
-
-        if (symbol_string == "'")
-            return OperatorType::TextNextLineShowString;
-        if (symbol_string == "\"")
-            return OperatorType::TextNextLineShowStringSetSpacing;
+            case symbol_key("'"sv):
+                return OperatorType::TextNextLineShowString;
+            case symbol_key("\""sv):
+                return OperatorType::TextNextLineShowStringSetSpacing;
+            default:
+                break;
+            }
+        }
 
         dbgln("unsupported graphics symbol {}", symbol_string);
         VERIFY_NOT_REACHED();
@@ -145,18 +162,18 @@ public:
         VERIFY_NOT_REACHED();
     }
 
-    Operator(OperatorType operator_type, Vector<Value> arguments)
+    Operator(OperatorType operator_type, Arguments arguments)
         : m_operator_type(operator_type)
         , m_arguments(move(arguments))
     {
     }
 
     [[nodiscard]] ALWAYS_INLINE OperatorType type() const { return m_operator_type; }
-    [[nodiscard]] ALWAYS_INLINE Vector<Value> const& arguments() const { return m_arguments; }
+    [[nodiscard]] ALWAYS_INLINE Arguments const& arguments() const { return m_arguments; }
 
 private:
     OperatorType m_operator_type;
-    Vector<Value> m_arguments;
+    Arguments m_arguments;
 };
 
 }
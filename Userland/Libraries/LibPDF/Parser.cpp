@@ -201,13 +201,23 @@ PDFErrorOr<Value> Parser::parse_number()
     if (!consumed_digit)
         return error("Invalid number");
 
+    auto number_bytes = m_reader.bytes().slice(start_offset, m_reader.offset() - start_offset);
     m_reader.consume_whitespace();
 
-    auto string = ByteString(m_reader.bytes().slice(start_offset, m_reader.offset() - start_offset));
-    if (is_float)
-        return Value(strtof(string.characters(), nullptr));
+    // Numbers are by far the most common values in content streams, so avoid allocating a string for each of them.
+    auto parse = [&](char const* characters) {
+        if (is_float)
+            return Value(strtof(characters, nullptr));
+        return Value(atoi(characters));
+    };
+
+    Array<u8, 32> buffer;
+    if (number_bytes.size() >= buffer.size())
+        return parse(ByteString(number_bytes).characters());
 
-    return Value(atoi(string.characters()));
+    number_bytes.copy_to(buffer.span());
+    buffer[number_bytes.size()] = '\0';
+    return parse(reinterpret_cast<char const*>(buffer.data()));
 }
 
 PDFErrorOr<NonnullRefPtr<NameObject>> Parser::parse_name()
@@ -565,7 +575,7 @@ PDFErrorOr<NonnullRefPtr<StreamObject>> Parser::parse_inline_image()
 PDFErrorOr<Vector<Operator>> Parser::parse_operators()
 {
     Vector<Operator> operators;
-    Vector<Value> operator_args;
+    Operator::Arguments operator_args;
 
     constexpr static auto is_operator_char_start = [](char ch) {
         return isalpha(ch) || ch == '*' || ch == '\'' || ch == '"';
@@ -603,8 +613,13 @@ PDFErrorOr<Vector<Operator>> Parser::parse_operators()
             }
 
             operators.append(Operator(operator_type, move(operator_args)));
-            operator_args = Vector<Value>();
+            operator_args.clear();
+
+            continue;
+        }
 
+        if (m_reader.matches_number()) {
+            operator_args.append(TRY(parse_number()));
             continue;
         }
 
@@ -495,20 +495,6 @@ RENDERER_HANDLER(text_set_leading)
     return {};
 }
 
-PDFErrorOr<NonnullRefPtr<PDFFont>> Renderer::get_font(FontCacheKey const& key)
-{
-    auto it = m_font_cache.find(key);
-    if (it != m_font_cache.end()) {
-        // Update the potentially-stale size set in text_set_matrix_and_line_matrix().
-        it->value->set_font_size(key.font_size);
-        return it->value;
-    }
-
-    auto font = TRY(PDFFont::create(m_document, key.font_dictionary, key.font_size));
-    m_font_cache.set(key, font);
-    return font;
-}
-
 RENDERER_HANDLER(text_set_font)
 {
     auto target_font_name = MUST(m_document->resolve_to<NameObject>(args[0]))->name();
@@ -522,8 +508,7 @@ RENDERER_HANDLER(text_set_font)
     auto fonts_dictionary = MUST(resources->get_dict(m_document, CommonNames::Font));
     auto font_dictionary = MUST(fonts_dictionary->get_dict(m_document, target_font_name));
 
-    FontCacheKey cache_key { move(font_dictionary), font_size };
-    text_state().font = TRY(get_font(cache_key));
+    text_state().font = TRY(m_document->get_or_load_font({ move(font_dictionary), font_size }));
 
     m_text_rendering_matrix_is_dirty = true;
     return {};
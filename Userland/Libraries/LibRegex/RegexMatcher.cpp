@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AnyOf.h>
 #include <AK/BumpAllocator.h>
 #include <AK/ByteString.h>
 #include <AK/Debug.h>
@@ -185,6 +186,22 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
 
     auto single_match_only = input.regex_options.has_flag_set(AllFlags::SingleMatch);
 
+    auto const& starting_ranges = m_pattern->parser_result.optimization_data.starting_ranges;
+    auto use_starting_ranges = !starting_ranges.is_empty() && !input.regex_options.has_flag_set(AllFlags::Insensitive);
+    auto can_start_match_at = [&](RegexStringView view, size_t index) {
+        // NOTE: Unicode views are indexed differently by the different kinds of compares, so we don't try to second-guess them.
+        if (view.unicode())
+            return true;
+        if (index >= view.length())
+            return false;
+        // NOTE: Plain characters are compared against code units and ranges against code points, so we accept both.
+        auto code_unit = view.code_unit_at(index);
+        auto code_point = view[index];
+        return any_of(starting_ranges, [&](CharRange range) {
+            return (code_unit >= range.from && code_unit <= range.to) || (code_point >= range.from && code_point <= range.to);
+        });
+    };
+
     for (auto const& view : views) {
         if (lines_to_skip != 0) {
             ++input.line;
@@ -245,6 +262,13 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
             if (match_length_minimum && match_length_minimum > view_length - view_index)
                 break;
 
+            // OPTIMIZATION: Don't bother setting up a match at positions where the pattern's first compare can't succeed.
+            if (use_starting_ranges && !can_start_match_at(view, view_index)) {
+                if (!continue_search)
+                    break;
+                continue;
+            }
+
             input.column = match_count;
             input.match_index = match_count;
 
@@ -37,6 +37,64 @@ void Regex<Parser>::run_optimization_passes()
     attempt_rewrite_loops_as_atomic_groups(blocks);
 
     parser_result.bytecode.flatten();
+
+    fill_optimization_data();
+}
+
+template<typename Parser>
+void Regex<Parser>::fill_optimization_data()
+{
+    // NOTE: A case insensitive compare accepts more than its ranges say, so there's nothing to be learned from it.
+    if (parser_result.options.has_flag_set(AllFlags::Insensitive))
+        return;
+
+    auto& bytecode = parser_result.bytecode;
+
+    // Find the first compare, which every match has to go through at its starting position.
+    // We can only look past instructions that neither consume input nor branch.
+    MatchState state;
+    for (;;) {
+        if (state.instruction_position >= bytecode.size())
+            return;
+        auto& opcode = bytecode.get_opcode(state);
+        if (opcode.opcode_id() == OpCodeId::Compare)
+            break;
+        if (opcode.opcode_id() != OpCodeId::SaveLeftCaptureGroup && opcode.opcode_id() != OpCodeId::Checkpoint)
+            return;
+        state.instruction_position += opcode.size();
+    }
+
+    // Only a compare that accepts one character out of a set of plain characters and ranges is of any use to us.
+    auto& compare = static_cast<OpCode_Compare const&>(bytecode.get_opcode(state));
+    Vector<CharRange> starting_ranges;
+    size_t offset = state.instruction_position + 3;
+    for (size_t i = 0; i < compare.arguments_count(); ++i) {
+        switch (static_cast<CharacterCompareType>(bytecode.at(offset++))) {
+        case CharacterCompareType::Char: {
+            auto ch = static_cast<u32>(bytecode.at(offset++));
+            starting_ranges.append({ ch, ch });
+            break;
+        }
+        case CharacterCompareType::CharRange:
+            starting_ranges.append(CharRange { bytecode.at(offset++) });
+            break;
+        case CharacterCompareType::LookupTable: {
+            auto count = bytecode.at(offset++);
+            for (size_t j = 0; j < count; ++j)
+                starting_ranges.append(CharRange { bytecode.at(offset++) });
+            break;
+        }
+        default:
+            return;
+        }
+    }
+
+    // NOTE: Checking a long list of ranges at every position would end up costing more than simply trying to match there.
+    static constexpr size_t max_number_of_starting_ranges = 32;
+    if (starting_ranges.is_empty() || starting_ranges.size() > max_number_of_starting_ranges)
+        return;
+
+    parser_result.optimization_data.starting_ranges = move(starting_ranges);
 }
 
 template<typename Parser>
@@ -58,6 +58,8 @@ public:
 
         struct {
             Optional<ByteString> pure_substring_search;
+            // If not empty, a match can only start at a character that's within one of these ranges.
+            Vector<CharRange> starting_ranges;
         } optimization_data {};
     };
 
@@ -757,9 +757,14 @@ private:
 // Statements
 //==================================================================================================
 
+enum class ShouldCommit {
+    No,
+    Yes,
+};
+
 class Statement : public ASTNode {
 public:
-    ResultOr<ResultSet> execute(AK::NonnullRefPtr<Database> database, ReadonlySpan<Value> placeholder_values = {}) const;
+    ResultOr<ResultSet> execute(AK::NonnullRefPtr<Database> database, ReadonlySpan<Value> placeholder_values = {}, ShouldCommit = ShouldCommit::Yes) const;
 
     virtual ResultOr<ResultSet> execute(ExecutionContext&) const
     {
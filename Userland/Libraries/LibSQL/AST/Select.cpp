@@ -37,6 +37,108 @@ static ByteString result_column_name(ResultColumn const& column, size_t column_i
     return fallback_column_name();
 }
 
+// A WHERE clause is split into its top-level AND terms, so that every term can be applied as soon as all
+// tables it refers to have been joined, instead of filtering the full cartesian product at the end.
+static void split_conjunction(NonnullRefPtr<Expression const> const& expression, Vector<NonnullRefPtr<Expression const>>& terms)
+{
+    if (is<BinaryOperatorExpression>(*expression)) {
+        auto const& binary_expression = verify_cast<BinaryOperatorExpression>(*expression);
+        if (binary_expression.type() == BinaryOperator::And) {
+            split_conjunction(binary_expression.lhs(), terms);
+            split_conjunction(binary_expression.rhs(), terms);
+            return;
+        }
+    }
+    terms.append(expression);
+}
+
+// Finds the index of the last table a WHERE term refers to, so the term can be evaluated right after joining it.
+// Returns an empty Optional if the term cannot be evaluated early, e.g. because it contains expressions that are
+// not understood here, column names that don't resolve to exactly one table, or no column names at all.
+static Optional<size_t> last_table_referenced_by(Expression const& expression, Vector<NonnullRefPtr<TableDef>> const& tables)
+{
+    Optional<size_t> last_table;
+    bool can_be_evaluated_early = true;
+
+    auto visit = [&](auto& self, Expression const& node) -> void {
+        if (!can_be_evaluated_early)
+            return;
+
+        if (is<NumericLiteral>(node) || is<StringLiteral>(node) || is<BlobLiteral>(node) || is<BooleanLiteral>(node) || is<NullLiteral>(node) || is<Placeholder>(node))
+            return;
+
+        if (is<ColumnNameExpression>(node)) {
+            auto const& column_name_expression = verify_cast<ColumnNameExpression>(node);
+            Optional<size_t> table_index;
+            size_t matches = 0;
+            for (size_t i = 0; i < tables.size(); ++i) {
+                if (!column_name_expression.table_name().is_empty() && tables[i]->name() != column_name_expression.table_name())
+                    continue;
+                for (auto const& column : tables[i]->columns()) {
+                    if (column->name() == column_name_expression.column_name()) {
+                        table_index = i;
+                        ++matches;
+                    }
+                }
+            }
+            if (matches != 1) {
+                can_be_evaluated_early = false;
+                return;
+            }
+            last_table = max(last_table.value_or(0), *table_index);
+            return;
+        }
+
+        if (is<UnaryOperatorExpression>(node)) {
+            self(self, *verify_cast<UnaryOperatorExpression>(node).expression());
+            return;
+        }
+
+        if (is<BinaryOperatorExpression>(node) || is<MatchExpression>(node)) {
+            auto const& nested_expression = verify_cast<NestedDoubleExpression>(node);
+            self(self, *nested_expression.lhs());
+            self(self, *nested_expression.rhs());
+            if (is<MatchExpression>(node)) {
+                if (auto const& escape = verify_cast<MatchExpression>(node).escape())
+                    self(self, *escape);
+            }
+            return;
+        }
+
+        if (is<ChainedExpression>(node)) {
+            for (auto const& chained_expression : verify_cast<ChainedExpression>(node).expressions())
+                self(self, *chained_expression);
+            return;
+        }
+
+        can_be_evaluated_early = false;
+    };
+    visit(visit, expression);
+
+    if (!can_be_evaluated_early)
+        return {};
+    return last_table;
+}
+
+static ResultOr<bool> row_matches_terms(ExecutionContext& context, Tuple& row, Vector<NonnullRefPtr<Expression const>> const& terms, bool where_clause_was_split)
+{
+    context.current_row = &row;
+
+    for (auto const& term : terms) {
+        auto term_result = TRY(term->evaluate(context)).to_bool();
+        if (!term_result.has_value()) {
+            // Evaluating the whole clause would have failed on the AND operator.
+            if (where_clause_was_split)
+                return Result { SQLCommand::Unknown, SQLErrorCode::BooleanOperatorTypeMismatch, BinaryOperator_name(BinaryOperator::And) };
+            return false;
+        }
+        if (!term_result.value())
+            return false;
+    }
+
+    return true;
+}
+
 ResultOr<ResultSet> Select::execute(ExecutionContext& context) const
 {
     Vector<NonnullRefPtr<ResultColumn const>> columns;
@@ -85,6 +187,32 @@ ResultOr<ResultSet> Select::execute(ExecutionContext& context) const
 
     ResultSet result { SQLCommand::Select, move(column_names) };
 
+    Vector<NonnullRefPtr<TableDef>> tables;
+    for (auto& table_descriptor : table_or_subquery_list()) {
+        auto table_def = TRY(context.database->get_table(table_descriptor->schema_name(), table_descriptor->table_name()));
+        if (table_def->num_columns() == 0)
+            continue;
+        tables.append(move(table_def));
+    }
+
+    // Assign every WHERE term to the table after which it can be evaluated; all others are evaluated on the complete rows.
+    Vector<Vector<NonnullRefPtr<Expression const>>> terms_per_table;
+    terms_per_table.resize(tables.size());
+    Vector<NonnullRefPtr<Expression const>> remaining_terms;
+    bool where_clause_was_split = false;
+    if (auto const& where = where_clause()) {
+        Vector<NonnullRefPtr<Expression const>> terms;
+        split_conjunction(*where, terms);
+        where_clause_was_split = terms.size() > 1;
+
+        for (auto& term : terms) {
+            if (auto table_index = last_table_referenced_by(*term, tables); table_index.has_value())
+                terms_per_table[*table_index].append(move(term));
+            else
+                remaining_terms.append(move(term));
+        }
+    }
+
     auto descriptor = adopt_ref(*new TupleDescriptor);
     Tuple tuple(descriptor);
     Vector<Tuple> rows;
@@ -92,27 +220,25 @@ ResultOr<ResultSet> Select::execute(ExecutionContext& context) const
     tuple.append(Value { true });
     rows.append(tuple);
 
-    for (auto& table_descriptor : table_or_subquery_list()) {
-        if (!table_descriptor->is_table())
-            return Result { SQLCommand::Select, SQLErrorCode::NotYetImplemented, "Sub-selects are not yet implemented"sv };
-
-        auto table_def = TRY(context.database->get_table(table_descriptor->schema_name(), table_descriptor->table_name()));
-        if (table_def->num_columns() == 0)
-            continue;
-
-        auto old_descriptor_size = descriptor->size();
+    for (size_t table_index = 0; table_index < tables.size(); ++table_index) {
+        auto& table_def = tables[table_index];
         descriptor->extend(table_def->to_tuple_descriptor());
 
-        while (!rows.is_empty() && (rows.first().size() == old_descriptor_size)) {
-            auto cartesian_row = rows.take_first();
-            auto table_rows = TRY(context.database->select_all(*table_def));
+        // Every table is only read once, no matter how many rows it is joined with.
+        auto table_rows = TRY(context.database->select_all(*table_def));
+        auto const& terms = terms_per_table[table_index];
 
-            for (auto& table_row : table_rows) {
+        Vector<Tuple> joined_rows;
+        for (auto const& cartesian_row : rows) {
+            for (auto const& table_row : table_rows) {
                 auto new_row = cartesian_row;
                 new_row.extend(table_row);
-                rows.append(new_row);
+                if (!terms.is_empty() && !TRY(row_matches_terms(context, new_row, terms, where_clause_was_split)))
+                    continue;
+                joined_rows.append(move(new_row));
             }
         }
+        rows = move(joined_rows);
     }
 
     bool has_ordering { false };
@@ -124,13 +250,8 @@ ResultOr<ResultSet> Select::execute(ExecutionContext& context) const
     Tuple sort_key(sort_descriptor);
 
     for (auto& row : rows) {
-        context.current_row = &row;
-
-        if (where_clause()) {
-            auto where_result = TRY(where_clause()->evaluate(context)).to_bool();
-            if (!where_result.has_value() || !where_result.value())
-                continue;
-        }
+        if (!TRY(row_matches_terms(context, row, remaining_terms, where_clause_was_split)))
+            continue;
 
         tuple.clear();
 
@@ -11,13 +11,14 @@
 
 namespace SQL::AST {
 
-ResultOr<ResultSet> Statement::execute(AK::NonnullRefPtr<Database> database, ReadonlySpan<Value> placeholder_values) const
+ResultOr<ResultSet> Statement::execute(AK::NonnullRefPtr<Database> database, ReadonlySpan<Value> placeholder_values, ShouldCommit should_commit) const
 {
     ExecutionContext context { move(database), this, placeholder_values, nullptr };
     auto result = TRY(execute(context));
 
     // FIXME: When transactional sessions are supported, don't auto-commit modifications.
-    TRY(context.database->commit());
+    if (should_commit == ShouldCommit::Yes)
+        TRY(context.database->commit());
 
     return result;
 }
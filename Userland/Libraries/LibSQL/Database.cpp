@@ -202,19 +202,34 @@ ErrorOr<Vector<Row>> Database::match(TableDef& table, Key const& key)
 
 ErrorOr<void> Database::insert(Row& row)
 {
-    VERIFY(m_table_cache.get(row.table().key().hash()).has_value());
+    return insert(Span<Row> { &row, 1 });
+}
+
+ErrorOr<void> Database::insert(Span<Row> rows)
+{
+    if (rows.is_empty())
+        return {};
+
+    auto& table = rows.first().table();
+    VERIFY(m_table_cache.get(table.key().hash()).has_value());
     // TODO: implement table constraints such as unique, foreign key, etc.
 
-    row.set_block_index(m_heap->request_new_block_index());
-    row.set_next_block_index(row.table().block_index());
-    TRY(update(row));
+    // Every row is prepended to the table's chain of rows, so the table's key only needs to be updated once.
+    auto first_block_index = table.block_index();
+    for (auto& row : rows) {
+        VERIFY(&row.table() == &table);
+        row.set_block_index(m_heap->request_new_block_index());
+        row.set_next_block_index(first_block_index);
+        TRY(update(row));
+        first_block_index = row.block_index();
+    }
 
     // TODO update indexes defined on table.
 
-    auto table_key = row.table().key();
-    table_key.set_block_index(row.block_index());
+    auto table_key = table.key();
+    table_key.set_block_index(first_block_index);
     VERIFY(m_tables->update_key_pointer(table_key));
-    row.table().set_block_index(row.block_index());
+    table.set_block_index(first_block_index);
     return {};
 }
 
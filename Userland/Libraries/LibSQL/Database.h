@@ -44,6 +44,7 @@ public:
     ErrorOr<Vector<Row>> select_all(TableDef&);
     ErrorOr<Vector<Row>> match(TableDef&, Key const&);
     ErrorOr<void> insert(Row&);
+    ErrorOr<void> insert(Span<Row>);
     ErrorOr<void> remove(Row&);
     ErrorOr<void> update(Row&);
 
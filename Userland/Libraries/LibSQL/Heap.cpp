@@ -9,6 +9,7 @@
 #include <AK/Format.h>
 #include <AK/QuickSort.h>
 #include <LibCore/System.h>
+#include <LibCrypto/Checksum/CRC32.h>
 #include <LibSQL/Heap.h>
 #include <sys/stat.h>
 
@@ -26,17 +27,27 @@ Heap::Heap(ByteString file_name)
 
 Heap::~Heap()
 {
-    if (m_file && !m_write_ahead_log.is_empty()) {
-        if (auto maybe_error = flush(); maybe_error.is_error())
-            warnln("~Heap({}): {}", name(), maybe_error.error());
+    if (!m_file)
+        return;
+
+    if (auto maybe_error = flush(); maybe_error.is_error()) {
+        warnln("~Heap({}): {}", name(), maybe_error.error());
+        return;
+    }
+    if (auto maybe_error = checkpoint(); maybe_error.is_error()) {
+        warnln("~Heap({}): {}", name(), maybe_error.error());
+        return;
     }
+
+    m_wal_file = nullptr;
+    if (auto maybe_error = Core::System::unlink(wal_name()); maybe_error.is_error())
+        warnln("~Heap({}): {}", name(), maybe_error.error());
 }
 
 ErrorOr<void> Heap::open()
 {
     VERIFY(!m_file);
 
-    size_t file_size = 0;
     struct stat stat_buffer;
     if (stat(name().characters(), &stat_buffer) != 0) {
         if (errno != ENOENT) {
@@ -46,21 +57,30 @@ ErrorOr<void> Heap::open()
     } else if (!S_ISREG(stat_buffer.st_mode)) {
         warnln("Heap::open({}): can only use regular files"sv, name());
         return Error::from_string_literal("Heap::open(): can only use regular files");
-    } else {
-        file_size = stat_buffer.st_size;
     }
 
+    auto file = TRY(Core::File::open(name(), Core::File::OpenMode::ReadWrite));
+    auto wal_file = TRY(Core::File::open(wal_name(), Core::File::OpenMode::ReadWrite));
+    m_file_descriptor = file->fd();
+    m_file = TRY(Core::InputBufferedFile::create(move(file)));
+    m_wal_file = move(wal_file);
+
+    if (auto error_maybe = recover_from_wal(); error_maybe.is_error()) {
+        m_file = nullptr;
+        m_wal_file = nullptr;
+        return error_maybe.release_error();
+    }
+
+    auto file_size = TRY(m_file->seek(0, SeekMode::FromEndPosition));
     if (file_size > 0) {
         m_next_block = file_size / Block::SIZE;
         m_highest_block_written = m_next_block - 1;
     }
 
-    auto file = TRY(Core::File::open(name(), Core::File::OpenMode::ReadWrite));
-    m_file = TRY(Core::InputBufferedFile::create(move(file)));
-
     if (file_size > 0) {
         if (auto error_maybe = read_zero_block(); error_maybe.is_error()) {
             m_file = nullptr;
+            m_wal_file = nullptr;
             return error_maybe.release_error();
         }
     } else {
@@ -71,15 +91,21 @@ ErrorOr<void> Heap::open()
     if (m_version != VERSION) {
         dbgln_if(SQL_DEBUG, "Heap file {} opened has incompatible version {}. Deleting for version {}.", name(), m_version, VERSION);
         m_file = nullptr;
+        m_wal_file = nullptr;
+        m_write_ahead_log.clear();
 
         TRY(Core::System::unlink(name()));
+        TRY(Core::System::unlink(wal_name()));
         return open();
     }
 
     // Perform a heap scan to find all free blocks
     // FIXME: this is very inefficient; store free blocks in a persistent heap structure
+    // Blocks are read sequentially without seeking, since seeking discards the file's read buffer.
+    auto block_data = TRY(ByteBuffer::create_uninitialized(Block::SIZE));
+    TRY(m_file->seek(Block::SIZE, SeekMode::SetPosition));
     for (Block::Index index = 1; index <= m_highest_block_written; ++index) {
-        auto block_data = TRY(read_raw_block(index));
+        TRY(m_file->read_until_filled(block_data));
         auto size_in_bytes = *reinterpret_cast<u32*>(block_data.data());
         if (size_in_bytes == 0)
             TRY(m_free_block_indices.try_append(index));
@@ -91,8 +117,12 @@ ErrorOr<void> Heap::open()
 
 ErrorOr<size_t> Heap::file_size_in_bytes() const
 {
+    // Committed blocks that were not checkpointed yet count towards the size of the heap file.
     TRY(m_file->seek(0, SeekMode::FromEndPosition));
-    return TRY(m_file->tell());
+    auto file_size = TRY(m_file->tell());
+    if (m_blocks_to_checkpoint.is_empty())
+        return file_size;
+    return max(file_size, (static_cast<size_t>(m_highest_block_written) + 1) * Block::SIZE);
 }
 
 bool Heap::has_block(Block::Index index) const
@@ -101,6 +131,56 @@ bool Heap::has_block(Block::Index index) const
         && !m_free_block_indices.contains_slow(index);
 }
 
+// Every flush appends a frame to the write-ahead log: a header holding the magic, the number of blocks and the
+// CRC32 of the payload, followed by the index and data of every block. Frames that are incomplete or have a
+// checksum mismatch were torn by a crash during the flush, and are discarded along with everything after them.
+static constexpr u32 WAL_FRAME_MAGIC = 0x57514c53; // "SQLW"
+static constexpr size_t WAL_FRAME_HEADER_SIZE = 3 * sizeof(u32);
+static constexpr size_t WAL_BLOCK_RECORD_SIZE = sizeof(Block::Index) + Block::SIZE;
+
+ErrorOr<void> Heap::recover_from_wal()
+{
+    VERIFY(m_file);
+    VERIFY(m_wal_file);
+
+    auto wal = TRY(m_wal_file->read_until_eof());
+    size_t offset = 0;
+    size_t frame_count = 0;
+    while (wal.size() - offset >= WAL_FRAME_HEADER_SIZE) {
+        auto const* header = reinterpret_cast<u32 const*>(wal.offset_pointer(offset));
+        auto block_count = header[1];
+        if (header[0] != WAL_FRAME_MAGIC || block_count == 0)
+            break;
+        auto payload_size = static_cast<size_t>(block_count) * WAL_BLOCK_RECORD_SIZE;
+        if (wal.size() - offset - WAL_FRAME_HEADER_SIZE < payload_size)
+            break;
+        auto payload = wal.bytes().slice(offset + WAL_FRAME_HEADER_SIZE, payload_size);
+        if (Crypto::Checksum::CRC32 { payload }.digest() != header[2])
+            break;
+
+        for (size_t record = 0; record < payload_size; record += WAL_BLOCK_RECORD_SIZE) {
+            Block::Index index;
+            memcpy(&index, payload.offset_pointer(record), sizeof(index));
+            TRY(write_raw_block(index, payload.slice(record + sizeof(index), Block::SIZE)));
+        }
+
+        offset += WAL_FRAME_HEADER_SIZE + payload_size;
+        ++frame_count;
+    }
+
+    if (offset < wal.size())
+        warnln("Heap::open({}): discarding {} bytes of incomplete write-ahead log", name(), wal.size() - offset);
+    dbgln_if(SQL_DEBUG, "Heap file {}: recovered {} frames from the write-ahead log", name(), frame_count);
+
+    if (frame_count > 0)
+        TRY(Core::System::fsync(m_file_descriptor));
+    if (!wal.is_empty()) {
+        TRY(m_wal_file->truncate(0));
+        TRY(m_wal_file->seek(0, SeekMode::SetPosition));
+    }
+    return {};
+}
+
 Block::Index Heap::request_new_block_index()
 {
     if (!m_free_block_indices.is_empty())
@@ -179,13 +259,78 @@ ErrorOr<ByteBuffer> Heap::read_raw_block(Block::Index index)
 
     if (auto wal_entry = m_write_ahead_log.get(index); wal_entry.has_value())
         return wal_entry.value();
+    if (auto committed_block = m_blocks_to_checkpoint.get(index); committed_block.has_value())
+        return committed_block.value();
+    if (auto cached_block = cached_raw_block(index); cached_block.has_value())
+        return cached_block.value();
 
     TRY(m_file->seek(index * Block::SIZE, SeekMode::SetPosition));
     auto buffer = TRY(ByteBuffer::create_uninitialized(Block::SIZE));
     TRY(m_file->read_until_filled(buffer));
+    if (index > 0)
+        TRY(cache_raw_block(index, buffer));
     return buffer;
 }
 
+Optional<ByteBuffer const&> Heap::cached_raw_block(Block::Index index)
+{
+    auto slot = m_block_cache_slots.get(index);
+    if (!slot.has_value())
+        return {};
+
+    auto& entry = m_block_cache[slot.value()];
+    entry.referenced = true;
+    return entry.data;
+}
+
+ErrorOr<void> Heap::cache_raw_block(Block::Index index, ByteBuffer const& data)
+{
+    VERIFY(index > 0);
+    VERIFY(data.size() == Block::SIZE);
+
+    if (auto slot = m_block_cache_slots.get(index); slot.has_value()) {
+        auto& entry = m_block_cache[slot.value()];
+        entry.data.overwrite(0, data.data(), data.size());
+        entry.referenced = true;
+        return {};
+    }
+
+    size_t slot = m_block_cache.size();
+    if (slot < BLOCK_CACHE_CAPACITY) {
+        TRY(m_block_cache.try_append({}));
+    } else {
+        while (m_block_cache[m_block_cache_hand].referenced) {
+            m_block_cache[m_block_cache_hand].referenced = false;
+            m_block_cache_hand = (m_block_cache_hand + 1) % m_block_cache.size();
+        }
+        slot = m_block_cache_hand;
+        m_block_cache_hand = (m_block_cache_hand + 1) % m_block_cache.size();
+        m_block_cache_slots.remove(m_block_cache[slot].index);
+    }
+
+    auto& entry = m_block_cache[slot];
+    if (entry.data.is_empty())
+        entry.data = TRY(ByteBuffer::copy(data));
+    else
+        entry.data.overwrite(0, data.data(), data.size());
+    entry.index = index;
+    entry.referenced = false;
+    TRY(m_block_cache_slots.try_set(index, slot));
+    return {};
+}
+
+void Heap::uncache_raw_block(Block::Index index)
+{
+    auto slot = m_block_cache_slots.take(index);
+    if (!slot.has_value())
+        return;
+
+    // The slot keeps its buffer for reuse and is the first candidate for replacement.
+    auto& entry = m_block_cache[slot.value()];
+    entry.index = 0;
+    entry.referenced = false;
+}
+
 ErrorOr<Block> Heap::read_block(Block::Index index)
 {
     dbgln_if(SQL_DEBUG, "{}({})", __FUNCTION__, index);
@@ -221,6 +366,7 @@ ErrorOr<void> Heap::write_raw_block_to_wal(Block::Index index, ByteBuffer&& data
     VERIFY(data.size() == Block::SIZE);
 
     TRY(m_write_ahead_log.try_set(index, move(data)));
+    uncache_raw_block(index);
 
     return {};
 }
@@ -276,15 +422,64 @@ ErrorOr<void> Heap::free_block(Block const& block)
 ErrorOr<void> Heap::flush()
 {
     VERIFY(m_file);
+    if (m_write_ahead_log.is_empty())
+        return {};
+
     auto indices = m_write_ahead_log.keys();
     quick_sort(indices);
+
+    auto frame = TRY(ByteBuffer::create_uninitialized(WAL_FRAME_HEADER_SIZE + indices.size() * WAL_BLOCK_RECORD_SIZE));
+    auto payload = frame.bytes().slice(WAL_FRAME_HEADER_SIZE);
+    size_t offset = 0;
     for (auto index : indices) {
         dbgln_if(SQL_DEBUG, "Flushing block {}", index);
-        auto& data = m_write_ahead_log.get(index).value();
-        TRY(write_raw_block(index, data));
+        payload.overwrite(offset, &index, sizeof(index));
+        payload.overwrite(offset + sizeof(index), m_write_ahead_log.get(index)->data(), Block::SIZE);
+        offset += WAL_BLOCK_RECORD_SIZE;
+    }
+    u32 header[] = { WAL_FRAME_MAGIC, static_cast<u32>(indices.size()), Crypto::Checksum::CRC32 { payload }.digest() };
+    frame.overwrite(0, header, sizeof(header));
+
+    TRY(m_wal_file->write_until_depleted(frame));
+    TRY(Core::System::fsync(m_wal_file->fd()));
+    m_wal_size += frame.size();
+
+    // The blocks are durable now, but are only written to the heap file itself once the log is checkpointed.
+    for (auto index : indices) {
+        TRY(m_blocks_to_checkpoint.try_set(index, m_write_ahead_log.take(index).release_value()));
+        if (index > m_highest_block_written)
+            m_highest_block_written = index;
     }
-    m_write_ahead_log.clear();
     dbgln_if(SQL_DEBUG, "WAL flushed; new number of blocks = {}", m_highest_block_written);
+
+    if (m_wal_size >= WAL_CHECKPOINT_SIZE)
+        TRY(checkpoint());
+    return {};
+}
+
+ErrorOr<void> Heap::checkpoint()
+{
+    VERIFY(m_file);
+    if (m_blocks_to_checkpoint.is_empty())
+        return {};
+
+    auto indices = m_blocks_to_checkpoint.keys();
+    quick_sort(indices);
+    for (auto index : indices)
+        TRY(write_raw_block(index, m_blocks_to_checkpoint.get(index).value()));
+    TRY(Core::System::fsync(m_file_descriptor));
+
+    // Only once the heap file is synced, the log may be emptied.
+    TRY(m_wal_file->truncate(0));
+    TRY(m_wal_file->seek(0, SeekMode::SetPosition));
+    m_wal_size = 0;
+
+    for (auto index : indices) {
+        auto data = m_blocks_to_checkpoint.take(index).release_value();
+        if (index > 0)
+            TRY(cache_raw_block(index, data));
+    }
+    dbgln_if(SQL_DEBUG, "WAL checkpointed {} blocks", indices.size());
     return {};
 }
 
@@ -63,6 +63,12 @@ private:
  *
  * A Heap can be thought of the backing storage of a single database. It's
  * assumed that a single SQL database is backed by a single Heap.
+ *
+ * Modified blocks are kept in memory until the Heap is flushed. A flush appends
+ * all of them as a single checksummed frame to the write-ahead log file next to
+ * the heap file, and syncs it to disk. Once the log grows large enough, its
+ * blocks are checkpointed into the heap file itself and the log is emptied.
+ * Frames that were not checkpointed yet are replayed when the Heap is opened.
  */
 class Heap : public RefCounted<Heap> {
 public:
@@ -75,6 +81,7 @@ public:
 
     ErrorOr<void> open();
     ErrorOr<size_t> file_size_in_bytes() const;
+    ByteString wal_name() const { return ByteString::formatted("{}-wal", m_name); }
 
     [[nodiscard]] bool has_block(Block::Index) const;
     [[nodiscard]] Block::Index request_new_block_index();
@@ -120,14 +127,21 @@ public:
     ErrorOr<void> free_storage(Block::Index);
 
     ErrorOr<void> flush();
+    ErrorOr<void> checkpoint();
 
 private:
     explicit Heap(ByteString);
 
+    ErrorOr<void> recover_from_wal();
+
     ErrorOr<ByteBuffer> read_raw_block(Block::Index);
     ErrorOr<void> write_raw_block(Block::Index, ReadonlyBytes);
     ErrorOr<void> write_raw_block_to_wal(Block::Index, ByteBuffer&&);
 
+    Optional<ByteBuffer const&> cached_raw_block(Block::Index);
+    ErrorOr<void> cache_raw_block(Block::Index, ByteBuffer const&);
+    void uncache_raw_block(Block::Index);
+
     ErrorOr<Block> read_block(Block::Index);
     ErrorOr<void> write_block(Block const&);
     ErrorOr<void> free_block(Block const&);
@@ -136,9 +150,25 @@ private:
     ErrorOr<void> initialize_zero_block();
     ErrorOr<void> update_zero_block();
 
+    // Clean blocks read from or flushed to the file are kept in a bounded cache. Replacement uses the
+    // clock algorithm: a hit sets a block's reference bit, and the hand skips (and clears) referenced
+    // blocks before evicting the first unreferenced one.
+    static constexpr size_t BLOCK_CACHE_CAPACITY = 1024;
+
+    static constexpr size_t WAL_CHECKPOINT_SIZE = 4 * MiB;
+
+    struct CachedBlock {
+        Block::Index index { 0 };
+        ByteBuffer data;
+        bool referenced { false };
+    };
+
     ByteString m_name;
 
     OwnPtr<Core::InputBufferedFile> m_file;
+    int m_file_descriptor { -1 };
+    OwnPtr<Core::File> m_wal_file;
+    size_t m_wal_size { 0 };
     Block::Index m_highest_block_written { 0 };
     Block::Index m_next_block { 1 };
     Block::Index m_schemas_root { 0 };
@@ -147,7 +177,11 @@ private:
     u32 m_version { VERSION };
     Array<u32, 16> m_user_values { 0 };
     HashMap<Block::Index, ByteBuffer> m_write_ahead_log;
+    HashMap<Block::Index, ByteBuffer> m_blocks_to_checkpoint;
     Vector<Block::Index> m_free_block_indices;
+    Vector<CachedBlock> m_block_cache;
+    HashMap<Block::Index, size_t> m_block_cache_slots;
+    size_t m_block_cache_hand { 0 };
 };
 
 }
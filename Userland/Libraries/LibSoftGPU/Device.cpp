@@ -25,6 +25,7 @@
 #include <LibSoftGPU/SIMD.h>
 #include <LibSoftGPU/Shader.h>
 #include <LibSoftGPU/ShaderCompiler.h>
+#include <LibThreading/ParallelFor.h>
 #include <math.h>
 
 namespace SoftGPU {
@@ -39,7 +40,7 @@ static i64 g_num_quads;
 
 using AK::abs;
 using AK::SIMD::any;
-using AK::SIMD::exp_approximate;
+using AK::SIMD::exp;
 using AK::SIMD::expand4;
 using AK::SIMD::f32x4;
 using AK::SIMD::i32x4;
@@ -53,6 +54,10 @@ using AK::SIMD::u32x4;
 
 static constexpr int subpixel_factor = 1 << SUBPIXEL_BITS;
 
+// Primitives covering fewer quads than this are not worth handing to other threads.
+static constexpr int minimum_quads_for_parallel_rasterization = 4096;
+static constexpr int quad_rows_per_band = 16;
+
 // Returns positive values for counter-clockwise rotation of vertices. Note that it returns the
 // area of a parallelogram with sides {a, b} and {b, c}, so _double_ the area of the triangle {a, b, c}.
 constexpr static i32 edge_function(IntVector2 const& a, IntVector2 const& b, IntVector2 const& c)
@@ -289,224 +294,245 @@ ALWAYS_INLINE void Device::rasterize(Gfx::IntRect& render_bounds, CB1 set_covera
     auto const qy1 = render_bounds_bottom & ~1;
 
     // Blend weights
-    Vector4<f32x4> source_weights;
-    Vector4<f32x4> destination_weights;
+    Vector4<f32x4> constant_source_weights;
+    Vector4<f32x4> constant_destination_weights;
     auto const source_weights_are_constant = is_blend_factor_constant(m_options.blend_source_factor);
     auto const destination_weights_are_constant = is_blend_factor_constant(m_options.blend_destination_factor);
     if (m_options.enable_blending) {
         if (source_weights_are_constant)
-            source_weights = get_blend_factor(m_options.blend_source_factor, m_options.blend_color, {}, {});
+            constant_source_weights = get_blend_factor(m_options.blend_source_factor, m_options.blend_color, {}, {});
         if (destination_weights_are_constant)
-            destination_weights = get_blend_factor(m_options.blend_destination_factor, m_options.blend_color, {}, {});
+            constant_destination_weights = get_blend_factor(m_options.blend_destination_factor, m_options.blend_color, {}, {});
     }
 
-    // Rasterize all quads
-    // FIXME: this could be embarrassingly parallel
-    for (int qy = qy0; qy <= qy1; qy += 2) {
-        for (int qx = qx0; qx <= qx1; qx += 2) {
-            PixelQuad quad;
-            quad.screen_coordinates = {
-                i32x4 { qx, qx + 1, qx, qx + 1 },
-                i32x4 { qy, qy, qy + 1, qy + 1 },
-            };
+    // Rasterizes the quads of the rows [first_qy, last_qy]. These write to pixels of their own only, so distinct
+    // rows can be rasterized concurrently as long as each of them has its own shader processor.
+    auto rasterize_quad_rows = [&](int first_qy, int last_qy, ShaderProcessor& shader_processor) {
+        auto source_weights = constant_source_weights;
+        auto destination_weights = constant_destination_weights;
+
+        for (int qy = first_qy; qy <= last_qy; qy += 2) {
+            for (int qx = qx0; qx <= qx1; qx += 2) {
+                PixelQuad quad;
+                quad.screen_coordinates = {
+                    i32x4 { qx, qx + 1, qx, qx + 1 },
+                    i32x4 { qy, qy, qy + 1, qy + 1 },
+                };
+
+                // Set coverage mask and test against render bounds
+                set_coverage_mask(quad);
+                quad.mask &= quad.screen_coordinates.x() >= render_bounds_left
+                    && quad.screen_coordinates.x() <= render_bounds_right
+                    && quad.screen_coordinates.y() >= render_bounds_top
+                    && quad.screen_coordinates.y() <= render_bounds_bottom;
+                auto coverage_bits = maskbits(quad.mask);
+                if (coverage_bits == 0)
+                    continue;
 
-            // Set coverage mask and test against render bounds
-            set_coverage_mask(quad);
-            quad.mask &= quad.screen_coordinates.x() >= render_bounds_left
-                && quad.screen_coordinates.x() <= render_bounds_right
-                && quad.screen_coordinates.y() >= render_bounds_top
-                && quad.screen_coordinates.y() <= render_bounds_bottom;
-            auto coverage_bits = maskbits(quad.mask);
-            if (coverage_bits == 0)
-                continue;
+                INCREASE_STATISTICS_COUNTER(g_num_quads, 1);
+                INCREASE_STATISTICS_COUNTER(g_num_pixels, maskcount(quad.mask));
 
-            INCREASE_STATISTICS_COUNTER(g_num_quads, 1);
-            INCREASE_STATISTICS_COUNTER(g_num_pixels, maskcount(quad.mask));
-
-            // Stencil testing
-            GPU::StencilType* stencil_ptrs[4];
-            i32x4 stencil_value;
-            if (m_options.enable_stencil_test) {
-                stencil_ptrs[0] = coverage_bits & 1 ? &stencil_buffer->scanline(qy)[qx] : nullptr;
-                stencil_ptrs[1] = coverage_bits & 2 ? &stencil_buffer->scanline(qy)[qx + 1] : nullptr;
-                stencil_ptrs[2] = coverage_bits & 4 ? &stencil_buffer->scanline(qy + 1)[qx] : nullptr;
-                stencil_ptrs[3] = coverage_bits & 8 ? &stencil_buffer->scanline(qy + 1)[qx + 1] : nullptr;
-
-                stencil_value = load4_masked(stencil_ptrs[0], stencil_ptrs[1], stencil_ptrs[2], stencil_ptrs[3], quad.mask);
-                stencil_value &= stencil_configuration.test_mask;
-
-                i32x4 stencil_test_passed;
-                switch (stencil_configuration.test_function) {
-                case GPU::StencilTestFunction::Always:
-                    stencil_test_passed = expand4(~0);
-                    break;
-                case GPU::StencilTestFunction::Equal:
-                    stencil_test_passed = stencil_value == stencil_reference_value;
-                    break;
-                case GPU::StencilTestFunction::Greater:
-                    stencil_test_passed = stencil_value > stencil_reference_value;
-                    break;
-                case GPU::StencilTestFunction::GreaterOrEqual:
-                    stencil_test_passed = stencil_value >= stencil_reference_value;
-                    break;
-                case GPU::StencilTestFunction::Less:
-                    stencil_test_passed = stencil_value < stencil_reference_value;
-                    break;
-                case GPU::StencilTestFunction::LessOrEqual:
-                    stencil_test_passed = stencil_value <= stencil_reference_value;
-                    break;
-                case GPU::StencilTestFunction::Never:
-                    stencil_test_passed = expand4(0);
-                    break;
-                case GPU::StencilTestFunction::NotEqual:
-                    stencil_test_passed = stencil_value != stencil_reference_value;
-                    break;
-                default:
-                    VERIFY_NOT_REACHED();
-                }
+                // Stencil testing
+                GPU::StencilType* stencil_ptrs[4];
+                i32x4 stencil_value;
+                if (m_options.enable_stencil_test) {
+                    stencil_ptrs[0] = coverage_bits & 1 ? &stencil_buffer->scanline(qy)[qx] : nullptr;
+                    stencil_ptrs[1] = coverage_bits & 2 ? &stencil_buffer->scanline(qy)[qx + 1] : nullptr;
+                    stencil_ptrs[2] = coverage_bits & 4 ? &stencil_buffer->scanline(qy + 1)[qx] : nullptr;
+                    stencil_ptrs[3] = coverage_bits & 8 ? &stencil_buffer->scanline(qy + 1)[qx + 1] : nullptr;
+
+                    stencil_value = load4_masked(stencil_ptrs[0], stencil_ptrs[1], stencil_ptrs[2], stencil_ptrs[3], quad.mask);
+                    stencil_value &= stencil_configuration.test_mask;
+
+                    i32x4 stencil_test_passed;
+                    switch (stencil_configuration.test_function) {
+                    case GPU::StencilTestFunction::Always:
+                        stencil_test_passed = expand4(~0);
+                        break;
+                    case GPU::StencilTestFunction::Equal:
+                        stencil_test_passed = stencil_value == stencil_reference_value;
+                        break;
+                    case GPU::StencilTestFunction::Greater:
+                        stencil_test_passed = stencil_value > stencil_reference_value;
+                        break;
+                    case GPU::StencilTestFunction::GreaterOrEqual:
+                        stencil_test_passed = stencil_value >= stencil_reference_value;
+                        break;
+                    case GPU::StencilTestFunction::Less:
+                        stencil_test_passed = stencil_value < stencil_reference_value;
+                        break;
+                    case GPU::StencilTestFunction::LessOrEqual:
+                        stencil_test_passed = stencil_value <= stencil_reference_value;
+                        break;
+                    case GPU::StencilTestFunction::Never:
+                        stencil_test_passed = expand4(0);
+                        break;
+                    case GPU::StencilTestFunction::NotEqual:
+                        stencil_test_passed = stencil_value != stencil_reference_value;
+                        break;
+                    default:
+                        VERIFY_NOT_REACHED();
+                    }
+
+                    // Update stencil buffer for pixels that failed the stencil test
+                    write_to_stencil(
+                        stencil_ptrs,
+                        stencil_value,
+                        stencil_configuration.on_stencil_test_fail,
+                        stencil_reference_value,
+                        stencil_configuration.write_mask,
+                        quad.mask & ~stencil_test_passed);
 
-                // Update stencil buffer for pixels that failed the stencil test
-                write_to_stencil(
-                    stencil_ptrs,
-                    stencil_value,
-                    stencil_configuration.on_stencil_test_fail,
-                    stencil_reference_value,
-                    stencil_configuration.write_mask,
-                    quad.mask & ~stencil_test_passed);
-
-                // Update coverage mask + early quad rejection
-                quad.mask &= stencil_test_passed;
-                coverage_bits = maskbits(quad.mask);
-                if (coverage_bits == 0)
-                    continue;
-            }
+                    // Update coverage mask + early quad rejection
+                    quad.mask &= stencil_test_passed;
+                    coverage_bits = maskbits(quad.mask);
+                    if (coverage_bits == 0)
+                        continue;
+                }
 
-            // Depth testing
-            GPU::DepthType* depth_ptrs[4] = {
-                coverage_bits & 1 ? &depth_buffer->scanline(qy)[qx] : nullptr,
-                coverage_bits & 2 ? &depth_buffer->scanline(qy)[qx + 1] : nullptr,
-                coverage_bits & 4 ? &depth_buffer->scanline(qy + 1)[qx] : nullptr,
-                coverage_bits & 8 ? &depth_buffer->scanline(qy + 1)[qx + 1] : nullptr,
-            };
-            if (m_options.enable_depth_test) {
-                set_quad_depth(quad);
-
-                auto depth = load4_masked(depth_ptrs[0], depth_ptrs[1], depth_ptrs[2], depth_ptrs[3], quad.mask);
-                i32x4 depth_test_passed;
-                switch (m_options.depth_func) {
-                case GPU::DepthTestFunction::Always:
-                    depth_test_passed = expand4(~0);
-                    break;
-                case GPU::DepthTestFunction::Never:
-                    depth_test_passed = expand4(0);
-                    break;
-                case GPU::DepthTestFunction::Greater:
-                    depth_test_passed = quad.depth > depth;
-                    break;
-                case GPU::DepthTestFunction::GreaterOrEqual:
-                    depth_test_passed = quad.depth >= depth;
-                    break;
-                case GPU::DepthTestFunction::NotEqual:
-                    depth_test_passed = quad.depth != depth;
-                    break;
-                case GPU::DepthTestFunction::Equal:
-                    depth_test_passed = quad.depth == depth;
-                    break;
-                case GPU::DepthTestFunction::LessOrEqual:
-                    depth_test_passed = quad.depth <= depth;
-                    break;
-                case GPU::DepthTestFunction::Less:
-                    depth_test_passed = quad.depth < depth;
-                    break;
-                default:
-                    VERIFY_NOT_REACHED();
+                // Depth testing
+                GPU::DepthType* depth_ptrs[4] = {
+                    coverage_bits & 1 ? &depth_buffer->scanline(qy)[qx] : nullptr,
+                    coverage_bits & 2 ? &depth_buffer->scanline(qy)[qx + 1] : nullptr,
+                    coverage_bits & 4 ? &depth_buffer->scanline(qy + 1)[qx] : nullptr,
+                    coverage_bits & 8 ? &depth_buffer->scanline(qy + 1)[qx + 1] : nullptr,
+                };
+                if (m_options.enable_depth_test) {
+                    set_quad_depth(quad);
+
+                    auto depth = load4_masked(depth_ptrs[0], depth_ptrs[1], depth_ptrs[2], depth_ptrs[3], quad.mask);
+                    i32x4 depth_test_passed;
+                    switch (m_options.depth_func) {
+                    case GPU::DepthTestFunction::Always:
+                        depth_test_passed = expand4(~0);
+                        break;
+                    case GPU::DepthTestFunction::Never:
+                        depth_test_passed = expand4(0);
+                        break;
+                    case GPU::DepthTestFunction::Greater:
+                        depth_test_passed = quad.depth > depth;
+                        break;
+                    case GPU::DepthTestFunction::GreaterOrEqual:
+                        depth_test_passed = quad.depth >= depth;
+                        break;
+                    case GPU::DepthTestFunction::NotEqual:
+                        depth_test_passed = quad.depth != depth;
+                        break;
+                    case GPU::DepthTestFunction::Equal:
+                        depth_test_passed = quad.depth == depth;
+                        break;
+                    case GPU::DepthTestFunction::LessOrEqual:
+                        depth_test_passed = quad.depth <= depth;
+                        break;
+                    case GPU::DepthTestFunction::Less:
+                        depth_test_passed = quad.depth < depth;
+                        break;
+                    default:
+                        VERIFY_NOT_REACHED();
+                    }
+
+                    // Update stencil buffer for pixels that failed the depth test
+                    if (m_options.enable_stencil_test) {
+                        write_to_stencil(
+                            stencil_ptrs,
+                            stencil_value,
+                            stencil_configuration.on_depth_test_fail,
+                            stencil_reference_value,
+                            stencil_configuration.write_mask,
+                            quad.mask & ~depth_test_passed);
+                    }
+
+                    // Update coverage mask + early quad rejection
+                    quad.mask &= depth_test_passed;
+                    coverage_bits = maskbits(quad.mask);
+                    if (coverage_bits == 0)
+                        continue;
                 }
 
-                // Update stencil buffer for pixels that failed the depth test
+                // Update stencil buffer for passed pixels
                 if (m_options.enable_stencil_test) {
                     write_to_stencil(
                         stencil_ptrs,
                         stencil_value,
-                        stencil_configuration.on_depth_test_fail,
+                        stencil_configuration.on_pass,
                         stencil_reference_value,
                         stencil_configuration.write_mask,
-                        quad.mask & ~depth_test_passed);
+                        quad.mask);
                 }
 
-                // Update coverage mask + early quad rejection
-                quad.mask &= depth_test_passed;
-                coverage_bits = maskbits(quad.mask);
-                if (coverage_bits == 0)
-                    continue;
-            }
+                INCREASE_STATISTICS_COUNTER(g_num_pixels_shaded, maskcount(quad.mask));
 
-            // Update stencil buffer for passed pixels
-            if (m_options.enable_stencil_test) {
-                write_to_stencil(
-                    stencil_ptrs,
-                    stencil_value,
-                    stencil_configuration.on_pass,
-                    stencil_reference_value,
-                    stencil_configuration.write_mask,
-                    quad.mask);
-            }
+                set_quad_attributes(quad);
+                shade_fragments(quad, shader_processor);
 
-            INCREASE_STATISTICS_COUNTER(g_num_pixels_shaded, maskcount(quad.mask));
+                // Alpha testing
+                if (m_options.enable_alpha_test) {
+                    test_alpha(quad, m_options.alpha_test_func, alpha_test_ref_value);
+                    coverage_bits = maskbits(quad.mask);
+                    if (coverage_bits == 0)
+                        continue;
+                }
 
-            set_quad_attributes(quad);
-            shade_fragments(quad);
+                // Write to depth buffer
+                if (m_options.enable_depth_test && m_options.enable_depth_write)
+                    store4_masked(quad.depth, depth_ptrs[0], depth_ptrs[1], depth_ptrs[2], depth_ptrs[3], quad.mask);
 
-            // Alpha testing
-            if (m_options.enable_alpha_test) {
-                test_alpha(quad, m_options.alpha_test_func, alpha_test_ref_value);
-                coverage_bits = maskbits(quad.mask);
-                if (coverage_bits == 0)
+                // We will not update the color buffer at all
+                if ((m_options.color_mask == 0) || !m_options.enable_color_write)
                     continue;
-            }
-
-            // Write to depth buffer
-            if (m_options.enable_depth_test && m_options.enable_depth_write)
-                store4_masked(quad.depth, depth_ptrs[0], depth_ptrs[1], depth_ptrs[2], depth_ptrs[3], quad.mask);
 
-            // We will not update the color buffer at all
-            if ((m_options.color_mask == 0) || !m_options.enable_color_write)
-                continue;
+                GPU::ColorType* color_ptrs[4] = {
+                    coverage_bits & 1 ? &color_buffer->scanline(qy)[qx] : nullptr,
+                    coverage_bits & 2 ? &color_buffer->scanline(qy)[qx + 1] : nullptr,
+                    coverage_bits & 4 ? &color_buffer->scanline(qy + 1)[qx] : nullptr,
+                    coverage_bits & 8 ? &color_buffer->scanline(qy + 1)[qx + 1] : nullptr,
+                };
 
-            GPU::ColorType* color_ptrs[4] = {
-                coverage_bits & 1 ? &color_buffer->scanline(qy)[qx] : nullptr,
-                coverage_bits & 2 ? &color_buffer->scanline(qy)[qx + 1] : nullptr,
-                coverage_bits & 4 ? &color_buffer->scanline(qy + 1)[qx] : nullptr,
-                coverage_bits & 8 ? &color_buffer->scanline(qy + 1)[qx + 1] : nullptr,
-            };
+                u32x4 dst_u32;
+                if (m_options.enable_blending || m_options.color_mask != 0xffffffff)
+                    dst_u32 = load4_masked(color_ptrs[0], color_ptrs[1], color_ptrs[2], color_ptrs[3], quad.mask);
 
-            u32x4 dst_u32;
-            if (m_options.enable_blending || m_options.color_mask != 0xffffffff)
-                dst_u32 = load4_masked(color_ptrs[0], color_ptrs[1], color_ptrs[2], color_ptrs[3], quad.mask);
+                auto out_color = quad.get_output_vector4(SHADER_OUTPUT_FIRST_COLOR);
 
-            auto out_color = quad.get_output_vector4(SHADER_OUTPUT_FIRST_COLOR);
+                // Blend color values from pixel_staging into color_buffer
+                if (m_options.enable_blending) {
+                    INCREASE_STATISTICS_COUNTER(g_num_pixels_blended, maskcount(quad.mask));
 
-            // Blend color values from pixel_staging into color_buffer
-            if (m_options.enable_blending) {
-                INCREASE_STATISTICS_COUNTER(g_num_pixels_blended, maskcount(quad.mask));
+                    auto const& source_color = out_color;
+                    auto const destination_color = to_vec4(dst_u32);
 
-                auto const& source_color = out_color;
-                auto const destination_color = to_vec4(dst_u32);
+                    if (!source_weights_are_constant)
+                        source_weights = get_blend_factor(m_options.blend_source_factor, m_options.blend_color, source_color, destination_color);
+                    if (!destination_weights_are_constant)
+                        destination_weights = get_blend_factor(m_options.blend_destination_factor, m_options.blend_color, source_color, destination_color);
 
-                if (!source_weights_are_constant)
-                    source_weights = get_blend_factor(m_options.blend_source_factor, m_options.blend_color, source_color, destination_color);
-                if (!destination_weights_are_constant)
-                    destination_weights = get_blend_factor(m_options.blend_destination_factor, m_options.blend_color, source_color, destination_color);
+                    out_color = blend_colors(m_options.blend_equation_rgb, m_options.blend_equation_alpha, source_color, source_weights, destination_color, destination_weights);
+                }
 
-                out_color = blend_colors(m_options.blend_equation_rgb, m_options.blend_equation_alpha, source_color, source_weights, destination_color, destination_weights);
+                auto const argb32_color = to_argb32(out_color);
+                if (m_options.color_mask == 0xffffffff)
+                    store4_masked(argb32_color, color_ptrs[0], color_ptrs[1], color_ptrs[2], color_ptrs[3], quad.mask);
+                else
+                    store4_masked((argb32_color & m_options.color_mask) | (dst_u32 & ~m_options.color_mask), color_ptrs[0], color_ptrs[1], color_ptrs[2], color_ptrs[3], quad.mask);
             }
-
-            auto const argb32_color = to_argb32(out_color);
-            if (m_options.color_mask == 0xffffffff)
-                store4_masked(argb32_color, color_ptrs[0], color_ptrs[1], color_ptrs[2], color_ptrs[3], quad.mask);
-            else
-                store4_masked((argb32_color & m_options.color_mask) | (dst_u32 & ~m_options.color_mask), color_ptrs[0], color_ptrs[1], color_ptrs[2], color_ptrs[3], quad.mask);
         }
+    };
+
+    // Large primitives are split into bands of rows that are rasterized in parallel. Primitives are still drawn one
+    // after the other, so every pixel sees them in submission order.
+    auto const quad_row_count = (qy1 - qy0) / 2 + 1;
+    auto const quad_count = quad_row_count * ((qx1 - qx0) / 2 + 1);
+    auto const band_count = ceil_div(quad_row_count, quad_rows_per_band);
+    if (ENABLE_STATISTICS_OVERLAY || quad_count < minimum_quads_for_parallel_rasterization || band_count < 2) {
+        rasterize_quad_rows(qy0, qy1, m_shader_processor);
+        return;
     }
+
+    Threading::parallel_for(static_cast<size_t>(band_count), [&](size_t band) {
+        ShaderProcessor shader_processor { m_samplers };
+        auto const first_qy = qy0 + static_cast<int>(band) * quad_rows_per_band * 2;
+        rasterize_quad_rows(first_qy, min(first_qy + (quad_rows_per_band - 1) * 2, qy1), shader_processor);
+    });
 }
 
 void Device::rasterize_line_aliased(GPU::Vertex& from, GPU::Vertex& to)
@@ -543,21 +569,22 @@ void Device::rasterize_line_antialiased(GPU::Vertex& from, GPU::Vertex& to)
 
     // Rasterize using a 2D signed distance field for a line segment
     // FIXME: performance-wise, this might be the absolute worst way to draw an anti-aliased line
-    f32x4 distance_along_line;
+    auto calculate_distance_along_line = [&from_coords4, &line_vector4, &line_dot4](auto& quad) {
+        auto const pixel_vector = to_vec2_f32x4(quad.screen_coordinates) - from_coords4;
+        return AK::SIMD::clamp(pixel_vector.dot(line_vector4) / line_dot4, 0.f, 1.f);
+    };
     rasterize(
         render_bounds,
-        [&from_coords4, &distance_along_line, &line_vector4, &line_dot4, &line_radius](auto& quad) {
-            auto const screen_coordinates4 = to_vec2_f32x4(quad.screen_coordinates);
-            auto const pixel_vector = screen_coordinates4 - from_coords4;
-            distance_along_line = AK::SIMD::clamp(pixel_vector.dot(line_vector4) / line_dot4, 0.f, 1.f);
-            auto distance_to_line = length(pixel_vector - line_vector4 * distance_along_line) - line_radius;
+        [&from_coords4, &line_vector4, &line_radius, &calculate_distance_along_line](auto& quad) {
+            auto const pixel_vector = to_vec2_f32x4(quad.screen_coordinates) - from_coords4;
+            auto distance_to_line = length(pixel_vector - line_vector4 * calculate_distance_along_line(quad)) - line_radius;
 
             // Add .5f to the distance so coverage transitions half a pixel before the actual border
             quad.coverage = 1.f - AK::SIMD::clamp(distance_to_line + 0.5f, 0.f, 1.f);
             quad.mask = quad.coverage > 0.f;
         },
-        [&from_depth4, &to_depth4, &distance_along_line](auto& quad) {
-            quad.depth = mix(from_depth4, to_depth4, distance_along_line);
+        [&from_depth4, &to_depth4, &calculate_distance_along_line](auto& quad) {
+            quad.depth = mix(from_depth4, to_depth4, calculate_distance_along_line(quad));
         },
         [&from_color4, &from, &from_fog_depth4](auto& quad) {
             // FIXME: interpolate color, tex coords and fog depth along the distance of the line
@@ -1191,10 +1218,10 @@ void Device::draw_primitives(GPU::PrimitiveType primitive_type, Vector<GPU::Vert
         rasterize_triangle(triangle);
 }
 
-ALWAYS_INLINE void Device::shade_fragments(PixelQuad& quad)
+ALWAYS_INLINE void Device::shade_fragments(PixelQuad& quad, ShaderProcessor& shader_processor)
 {
     if (m_current_fragment_shader) {
-        m_shader_processor.execute(quad, *m_current_fragment_shader);
+        shader_processor.execute(quad, *m_current_fragment_shader);
         return;
     }
 
@@ -1333,12 +1360,12 @@ ALWAYS_INLINE void Device::shade_fragments(PixelQuad& quad)
             break;
         case GPU::FogMode::Exp: {
             auto argument = -m_options.fog_density * quad.fog_depth;
-            factor = exp_approximate(argument);
+            factor = exp(argument);
         } break;
         case GPU::FogMode::Exp2: {
             auto argument = m_options.fog_density * quad.fog_depth;
             argument *= -argument;
-            factor = exp_approximate(argument);
+            factor = exp(argument);
         } break;
         default:
             VERIFY_NOT_REACHED();
@@ -104,7 +104,7 @@ private:
     void rasterize_point(GPU::Vertex&);
 
     void rasterize_triangle(Triangle&);
-    void shade_fragments(PixelQuad&);
+    void shade_fragments(PixelQuad&, ShaderProcessor&);
 
     RefPtr<FrameBuffer<GPU::ColorType, GPU::DepthType, GPU::StencilType>> m_frame_buffer {};
     GPU::RasterizerOptions m_options;
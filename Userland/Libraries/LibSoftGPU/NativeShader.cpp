@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Format.h>
+#include <LibCore/System.h>
+#include <LibJIT/Assembler.h>
+#include <LibSoftGPU/NativeShader.h>
+#include <LibSoftGPU/PixelQuad.h>
+#include <LibSoftGPU/ShaderProcessor.h>
+#include <errno.h>
+#include <string.h>
+#include <sys/mman.h>
+
+// NOTE: Serenity only allows executable anonymous memory on filesystems mounted with MS_AXALLOWED, and processes
+//       without the prot_exec promise would be killed for trying, so we always interpret shaders there.
+#if defined(JIT_ARCH_SUPPORTED) && !defined(AK_OS_SERENITY)
+#    define NATIVE_SHADERS_SUPPORTED 1
+#endif
+
+namespace SoftGPU {
+
+using AK::SIMD::f32x4;
+
+NativeShader::NativeShader(void* code, size_t code_size)
+    : m_code(code)
+    , m_code_size(code_size)
+{
+}
+
+NativeShader::~NativeShader()
+{
+    MUST(Core::System::munmap(m_code, m_code_size));
+}
+
+void NativeShader::execute(f32x4* registers, PixelQuad& quad, ShaderProcessor& processor) const
+{
+    bit_cast<Entry>(m_code)(registers, &quad, &processor);
+}
+
+void NativeShader::sample_2d(ShaderProcessor* processor, Instruction::Arguments arguments)
+{
+    processor->op_sample2d(arguments);
+}
+
+#ifdef NATIVE_SHADERS_SUPPORTED
+
+using Assembler = JIT::Assembler;
+using Operand = Assembler::Operand;
+using Reg = Assembler::Reg;
+
+// These are callee-saved, so they survive the calls into the sampler. Unlike R12 and R13, they can be used as
+// a base register without a SIB byte or a displacement.
+static constexpr auto registers_base = Reg::RBX;
+static constexpr auto quad_base = Reg::R14;
+static constexpr auto processor_base = Reg::R15;
+
+static Operand shader_register(u16 index)
+{
+    return Operand::Mem64BaseAndOffset(registers_base, index * sizeof(f32x4));
+}
+
+static Operand quad_input(u8 index)
+{
+    return Operand::Mem64BaseAndOffset(quad_base, __builtin_offsetof(PixelQuad, inputs) + index * sizeof(f32x4));
+}
+
+static Operand quad_output(u8 index)
+{
+    return Operand::Mem64BaseAndOffset(quad_base, __builtin_offsetof(PixelQuad, outputs) + index * sizeof(f32x4));
+}
+
+static Operand xmm(u8 index)
+{
+    return Operand::FloatRegister(static_cast<Reg>(index));
+}
+
+OwnPtr<NativeShader> NativeShader::try_compile(Vector<Instruction> const& instructions)
+{
+    Vector<u8> code;
+    Assembler assembler { code };
+
+    assembler.enter();
+    assembler.mov(Operand::Register(registers_base), Operand::Register(Reg::RDI));
+    assembler.mov(Operand::Register(quad_base), Operand::Register(Reg::RSI));
+    assembler.mov(Operand::Register(processor_base), Operand::Register(Reg::RDX));
+
+    for (auto const& instruction : instructions) {
+        auto const& arguments = instruction.arguments;
+        switch (instruction.operation) {
+        case Opcode::Input:
+            for (u8 i = 0; i < 4; ++i) {
+                assembler.mov_f32x4(xmm(0), quad_input(arguments.input.input_index + i));
+                assembler.mov_f32x4(shader_register(arguments.input.target_register + i), xmm(0));
+            }
+            break;
+        case Opcode::Output:
+            for (u8 i = 0; i < 4; ++i) {
+                assembler.mov_f32x4(xmm(0), shader_register(arguments.output.source_register + i));
+                assembler.mov_f32x4(quad_output(arguments.output.output_index + i), xmm(0));
+            }
+            break;
+        case Opcode::Sample2D: {
+            // The arguments are small enough to be passed in a single register.
+            u64 raw_arguments = 0;
+            static_assert(sizeof(arguments) <= sizeof(raw_arguments));
+            memcpy(&raw_arguments, &arguments, sizeof(arguments));
+            assembler.mov(Operand::Register(Reg::RDI), Operand::Register(processor_base));
+            assembler.mov(Operand::Register(Reg::RSI), Operand::Imm(raw_arguments));
+            assembler.native_call(bit_cast<u64>(&NativeShader::sample_2d));
+            break;
+        }
+        case Opcode::Swizzle:
+            // All four source components are loaded first, as the target may overlap with the source.
+            for (u8 i = 0; i < 4; ++i)
+                assembler.mov_f32x4(xmm(i), shader_register(arguments.swizzle.source_register + i));
+            for (u8 i = 0; i < 4; ++i)
+                assembler.mov_f32x4(shader_register(arguments.swizzle.target_register + i), xmm(swizzle_index(arguments.swizzle.pattern, i)));
+            break;
+        case Opcode::Add:
+        case Opcode::Sub:
+        case Opcode::Mul:
+        case Opcode::Div:
+            for (u8 i = 0; i < 4; ++i) {
+                assembler.mov_f32x4(xmm(0), shader_register(arguments.binop.source_register1 + i));
+                assembler.mov_f32x4(xmm(1), shader_register(arguments.binop.source_register2 + i));
+                if (instruction.operation == Opcode::Add)
+                    assembler.add_f32x4(xmm(0), xmm(1));
+                else if (instruction.operation == Opcode::Sub)
+                    assembler.sub_f32x4(xmm(0), xmm(1));
+                else if (instruction.operation == Opcode::Mul)
+                    assembler.mul_f32x4(xmm(0), xmm(1));
+                else
+                    assembler.div_f32x4(xmm(0), xmm(1));
+                assembler.mov_f32x4(shader_register(arguments.binop.target_register + i), xmm(0));
+            }
+            break;
+        default:
+            VERIFY_NOT_REACHED();
+        }
+    }
+
+    assembler.exit();
+
+    auto code_size = round_up_to_power_of_two(code.size(), PAGE_SIZE);
+    auto memory_or_error = Core::System::mmap(nullptr, code_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0, 0, "NativeShader"sv);
+    if (memory_or_error.is_error()) {
+        dbgln("NativeShader: Failed to allocate {} bytes of code: {}", code_size, memory_or_error.error());
+        return nullptr;
+    }
+    auto* memory = memory_or_error.release_value();
+    memcpy(memory, code.data(), code.size());
+    if (mprotect(memory, code_size, PROT_READ | PROT_EXEC) < 0) {
+        dbgln("NativeShader: Failed to make code executable: {}", strerror(errno));
+        MUST(Core::System::munmap(memory, code_size));
+        return nullptr;
+    }
+
+    return adopt_own(*new NativeShader(memory, code_size));
+}
+
+#else
+
+OwnPtr<NativeShader> NativeShader::try_compile(Vector<Instruction> const&)
+{
+    return nullptr;
+}
+
+#endif
+
+}
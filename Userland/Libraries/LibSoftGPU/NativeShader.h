@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Noncopyable.h>
+#include <AK/OwnPtr.h>
+#include <AK/SIMD.h>
+#include <AK/Vector.h>
+#include <LibSoftGPU/ISA.h>
+
+namespace SoftGPU {
+
+struct PixelQuad;
+class ShaderProcessor;
+
+// A shader program compiled to native code, which does the same to the register file and quad as interpreting it would.
+class NativeShader final {
+    AK_MAKE_NONCOPYABLE(NativeShader);
+    AK_MAKE_NONMOVABLE(NativeShader);
+
+public:
+    // Returns null if native code is not supported on this platform or could not be mapped executable,
+    // in which case the program has to be interpreted.
+    static OwnPtr<NativeShader> try_compile(Vector<Instruction> const&);
+
+    ~NativeShader();
+
+    void execute(AK::SIMD::f32x4* registers, PixelQuad&, ShaderProcessor&) const;
+
+private:
+    using Entry = void (*)(AK::SIMD::f32x4* registers, PixelQuad*, ShaderProcessor*);
+
+    NativeShader(void* code, size_t code_size);
+
+    static void sample_2d(ShaderProcessor*, Instruction::Arguments);
+
+    void* m_code { nullptr };
+    size_t m_code_size { 0 };
+};
+
+}
@@ -71,12 +71,14 @@ static f32x4 wrap(f32x4 value, GPU::TextureWrapMode mode, f32x4 num_texels)
     }
 }
 
-ALWAYS_INLINE static Vector4<f32x4> texel4(Image const& image, u32x4 level, u32x4 x, u32x4 y)
+// The texel fetchers are called as fetch_texel(lane, x, y), and return a reference to that texel.
+template<typename FetchTexel>
+ALWAYS_INLINE static Vector4<f32x4> texel4(FetchTexel const& fetch_texel, u32x4 x, u32x4 y)
 {
-    auto const& t0 = image.texel(level[0], x[0], y[0], 0);
-    auto const& t1 = image.texel(level[1], x[1], y[1], 0);
-    auto const& t2 = image.texel(level[2], x[2], y[2], 0);
-    auto const& t3 = image.texel(level[3], x[3], y[3], 0);
+    auto const& t0 = fetch_texel(0, x[0], y[0]);
+    auto const& t1 = fetch_texel(1, x[1], y[1]);
+    auto const& t2 = fetch_texel(2, x[2], y[2]);
+    auto const& t3 = fetch_texel(3, x[3], y[3]);
 
     return Vector4<f32x4> {
         f32x4 { t0.x(), t1.x(), t2.x(), t3.x() },
@@ -86,14 +88,15 @@ ALWAYS_INLINE static Vector4<f32x4> texel4(Image const& image, u32x4 level, u32x
     };
 }
 
-ALWAYS_INLINE static Vector4<f32x4> texel4border(Image const& image, u32x4 level, u32x4 x, u32x4 y, FloatVector4 const& border, u32x4 w, u32x4 h)
+template<typename FetchTexel>
+ALWAYS_INLINE static Vector4<f32x4> texel4border(FetchTexel const& fetch_texel, u32x4 x, u32x4 y, FloatVector4 const& border, u32x4 w, u32x4 h)
 {
     auto border_mask = maskbits(x < 0 || x >= w || y < 0 || y >= h);
 
-    auto const& t0 = (border_mask & 1) > 0 ? border : image.texel(level[0], x[0], y[0], 0);
-    auto const& t1 = (border_mask & 2) > 0 ? border : image.texel(level[1], x[1], y[1], 0);
-    auto const& t2 = (border_mask & 4) > 0 ? border : image.texel(level[2], x[2], y[2], 0);
-    auto const& t3 = (border_mask & 8) > 0 ? border : image.texel(level[3], x[3], y[3], 0);
+    auto const& t0 = (border_mask & 1) > 0 ? border : fetch_texel(0, x[0], y[0]);
+    auto const& t1 = (border_mask & 2) > 0 ? border : fetch_texel(1, x[1], y[1]);
+    auto const& t2 = (border_mask & 4) > 0 ? border : fetch_texel(2, x[2], y[2]);
+    auto const& t3 = (border_mask & 8) > 0 ? border : fetch_texel(3, x[3], y[3]);
 
     return Vector4<f32x4> {
         f32x4 { t0.x(), t1.x(), t2.x(), t3.x() },
@@ -103,6 +106,102 @@ ALWAYS_INLINE static Vector4<f32x4> texel4border(Image const& image, u32x4 level
     };
 }
 
+// Returns whether texture coordinates wrapped with this mode always end up inside the texture.
+static constexpr bool wraps_to_inside(GPU::TextureWrapMode mode)
+{
+    switch (mode) {
+    case GPU::TextureWrapMode::Repeat:
+    case GPU::TextureWrapMode::MirroredRepeat:
+    case GPU::TextureWrapMode::ClampToEdge:
+        return true;
+    case GPU::TextureWrapMode::Clamp:
+        return !CLAMP_DEPRECATED_BEHAVIOR;
+    case GPU::TextureWrapMode::ClampToBorder:
+        return false;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+template<typename FetchTexel>
+ALWAYS_INLINE static Vector4<f32x4> filter_texels(GPU::SamplerConfig const& config, Image const& image, Vector2<f32x4> const& uv, u32x4 width, u32x4 height, GPU::TextureFilter filter, FetchTexel const& fetch_texel)
+{
+    auto f_width = to_f32x4(width);
+    auto f_height = to_f32x4(height);
+
+    u32x4 width_mask = width - 1;
+    u32x4 height_mask = height - 1;
+
+    f32x4 u = wrap(uv.x(), config.texture_wrap_u, f_width) * f_width;
+    f32x4 v = wrap(uv.y(), config.texture_wrap_v, f_height) * f_height;
+
+    if (filter == GPU::TextureFilter::Nearest) {
+        u32x4 i = to_u32x4(u);
+        u32x4 j = to_u32x4(v);
+
+        i = image.width_is_power_of_two() ? i & width_mask : i % width;
+        j = image.height_is_power_of_two() ? j & height_mask : j % height;
+
+        return texel4(fetch_texel, i, j);
+    }
+
+    u -= 0.5f;
+    v -= 0.5f;
+
+    f32x4 const floored_u = floor_int_range(u);
+    f32x4 const floored_v = floor_int_range(v);
+
+    u32x4 i0 = to_u32x4(floored_u);
+    u32x4 i1 = i0 + 1;
+    u32x4 j0 = to_u32x4(floored_v);
+    u32x4 j1 = j0 + 1;
+
+    if (config.texture_wrap_u == GPU::TextureWrapMode::Repeat) {
+        if (image.width_is_power_of_two()) {
+            i0 = i0 & width_mask;
+            i1 = i1 & width_mask;
+        } else {
+            i0 = i0 % width;
+            i1 = i1 % width;
+        }
+    }
+
+    if (config.texture_wrap_v == GPU::TextureWrapMode::Repeat) {
+        if (image.height_is_power_of_two()) {
+            j0 = j0 & height_mask;
+            j1 = j1 & height_mask;
+        } else {
+            j0 = j0 % height;
+            j1 = j1 % height;
+        }
+    }
+
+    Vector4<f32x4> t0, t1, t2, t3;
+
+    if (wraps_to_inside(config.texture_wrap_u) && wraps_to_inside(config.texture_wrap_v)) {
+        // Only i1 and j1 can end up just past the far edge, in which case their weight is zero. Fetching the edge texel
+        // instead of the border color there gives the same result without checking every texel against the bounds.
+        i1 = i1 < width ? i1 : width_mask;
+        j1 = j1 < height ? j1 : height_mask;
+
+        t0 = texel4(fetch_texel, i0, j0);
+        t1 = texel4(fetch_texel, i1, j0);
+        t2 = texel4(fetch_texel, i0, j1);
+        t3 = texel4(fetch_texel, i1, j1);
+    } else {
+        t0 = texel4border(fetch_texel, i0, j0, config.border_color, width, height);
+        t1 = texel4border(fetch_texel, i1, j0, config.border_color, width, height);
+        t2 = texel4border(fetch_texel, i0, j1, config.border_color, width, height);
+        t3 = texel4border(fetch_texel, i1, j1, config.border_color, width, height);
+    }
+
+    f32x4 const alpha = u - floored_u;
+    f32x4 const beta = v - floored_v;
+
+    auto const lerp_0 = mix(t0, t1, alpha);
+    auto const lerp_1 = mix(t2, t3, alpha);
+    return mix(lerp_0, lerp_1, beta);
+}
+
 Vector4<AK::SIMD::f32x4> Sampler::sample_2d(Vector2<AK::SIMD::f32x4> const& uv) const
 {
     if (m_config.bound_image.is_null())
@@ -155,6 +254,16 @@ Vector4<AK::SIMD::f32x4> Sampler::sample_2d_lod(Vector2<AK::SIMD::f32x4> const&
 {
     auto const& image = *static_ptr_cast<Image>(m_config.bound_image);
 
+    // All pixels of a quad usually sample the same level, so its size and texels only have to be looked up once.
+    if (level[0] == level[1] && level[0] == level[2] && level[0] == level[3]) {
+        auto const width = image.width_at_level(level[0]);
+        auto const height = image.height_at_level(level[0]);
+        auto const* texels = image.texel_pointer(level[0], 0, 0, 0);
+        return filter_texels(m_config, image, uv, expand4(width), expand4(height), filter, [texels, width](size_t, u32 x, u32 y) -> FloatVector4 const& {
+            return texels[y * width + x];
+        });
+    }
+
     u32x4 const width = {
         image.width_at_level(level[0]),
         image.width_at_level(level[1]),
@@ -168,76 +277,9 @@ Vector4<AK::SIMD::f32x4> Sampler::sample_2d_lod(Vector2<AK::SIMD::f32x4> const&
         image.height_at_level(level[3]),
     };
 
-    auto f_width = to_f32x4(width);
-    auto f_height = to_f32x4(height);
-
-    u32x4 width_mask = width - 1;
-    u32x4 height_mask = height - 1;
-
-    f32x4 u = wrap(uv.x(), m_config.texture_wrap_u, f_width) * f_width;
-    f32x4 v = wrap(uv.y(), m_config.texture_wrap_v, f_height) * f_height;
-
-    if (filter == GPU::TextureFilter::Nearest) {
-        u32x4 i = to_u32x4(u);
-        u32x4 j = to_u32x4(v);
-
-        i = image.width_is_power_of_two() ? i & width_mask : i % width;
-        j = image.height_is_power_of_two() ? j & height_mask : j % height;
-
-        return texel4(image, level, i, j);
-    }
-
-    u -= 0.5f;
-    v -= 0.5f;
-
-    f32x4 const floored_u = floor_int_range(u);
-    f32x4 const floored_v = floor_int_range(v);
-
-    u32x4 i0 = to_u32x4(floored_u);
-    u32x4 i1 = i0 + 1;
-    u32x4 j0 = to_u32x4(floored_v);
-    u32x4 j1 = j0 + 1;
-
-    if (m_config.texture_wrap_u == GPU::TextureWrapMode::Repeat) {
-        if (image.width_is_power_of_two()) {
-            i0 = i0 & width_mask;
-            i1 = i1 & width_mask;
-        } else {
-            i0 = i0 % width;
-            i1 = i1 % width;
-        }
-    }
-
-    if (m_config.texture_wrap_v == GPU::TextureWrapMode::Repeat) {
-        if (image.height_is_power_of_two()) {
-            j0 = j0 & height_mask;
-            j1 = j1 & height_mask;
-        } else {
-            j0 = j0 % height;
-            j1 = j1 % height;
-        }
-    }
-
-    Vector4<f32x4> t0, t1, t2, t3;
-
-    if (m_config.texture_wrap_u == GPU::TextureWrapMode::Repeat && m_config.texture_wrap_v == GPU::TextureWrapMode::Repeat) {
-        t0 = texel4(image, level, i0, j0);
-        t1 = texel4(image, level, i1, j0);
-        t2 = texel4(image, level, i0, j1);
-        t3 = texel4(image, level, i1, j1);
-    } else {
-        t0 = texel4border(image, level, i0, j0, m_config.border_color, width, height);
-        t1 = texel4border(image, level, i1, j0, m_config.border_color, width, height);
-        t2 = texel4border(image, level, i0, j1, m_config.border_color, width, height);
-        t3 = texel4border(image, level, i1, j1, m_config.border_color, width, height);
-    }
-
-    f32x4 const alpha = u - floored_u;
-    f32x4 const beta = v - floored_v;
-
-    auto const lerp_0 = mix(t0, t1, alpha);
-    auto const lerp_1 = mix(t2, t3, alpha);
-    return mix(lerp_0, lerp_1, beta);
+    return filter_texels(m_config, image, uv, width, height, filter, [&image, level](size_t lane, u32 x, u32 y) -> FloatVector4 const& {
+        return image.texel(level[lane], x, y, 0);
+    });
 }
 
 }
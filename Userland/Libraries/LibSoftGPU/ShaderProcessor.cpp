@@ -14,6 +14,15 @@ namespace SoftGPU {
 using AK::SIMD::f32x4;
 
 void ShaderProcessor::execute(PixelQuad& quad, Shader const& shader)
+{
+    if (auto const* native_shader = shader.native_shader()) {
+        native_shader->execute(m_registers, quad, *this);
+        return;
+    }
+    interpret(quad, shader);
+}
+
+void ShaderProcessor::interpret(PixelQuad& quad, Shader const& shader)
 {
     auto& instructions = shader.instructions();
     for (size_t program_counter = 0; program_counter < instructions.size(); ++program_counter) {
@@ -18,6 +18,8 @@ namespace SoftGPU {
 class Shader;
 
 class ShaderProcessor final {
+    friend class NativeShader;
+
 public:
     ShaderProcessor(Array<Sampler, GPU::NUM_TEXTURE_UNITS>& samplers)
         : m_samplers { samplers }
@@ -25,6 +27,8 @@ public:
     }
 
     void execute(PixelQuad&, Shader const&);
+    // Runs the program instruction by instruction, even if it was compiled to native code.
+    void interpret(PixelQuad&, Shader const&);
 
     ALWAYS_INLINE AK::SIMD::f32x4 get_register(u16 index) const { return m_registers[index]; }
     ALWAYS_INLINE void set_register(u16 index, AK::SIMD::f32x4 value) { m_registers[index] = value; }
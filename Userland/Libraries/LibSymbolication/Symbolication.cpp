@@ -10,6 +10,7 @@
 #include <AK/JsonObject.h>
 #include <AK/JsonValue.h>
 #include <AK/LexicalPath.h>
+#include <AK/QuickSort.h>
 #include <LibCore/File.h>
 #include <LibCore/MappedFile.h>
 #include <LibDebug/DebugInfo.h>
@@ -22,10 +23,17 @@ struct CachedELF {
     NonnullOwnPtr<Core::MappedFile> mapped_file;
     NonnullOwnPtr<Debug::DebugInfo> debug_info;
     NonnullOwnPtr<ELF::Image> image;
+
+    // Callers like SystemMonitor keep asking about the same addresses, and looking up source positions is expensive.
+    HashMap<FlatPtr, Symbol> symbols {};
+    HashMap<FlatPtr, Symbol> symbols_with_source_positions {};
 };
 
 static HashMap<ByteString, OwnPtr<CachedELF>> s_cache;
 
+// Maps the library names we were asked about to the path we found them at, or to themselves if we didn't find them.
+static HashMap<ByteString, ByteString> s_full_paths;
+
 enum class KernelBaseState {
     Uninitialized,
     Valid,
@@ -69,19 +77,24 @@ Optional<Symbol> symbolicate(ByteString const& path, FlatPtr address, IncludeSou
 {
     ByteString full_path = path;
     if (!path.starts_with('/')) {
-        Array<StringView, 2> search_paths { "/usr/lib"sv, "/usr/local/lib"sv };
-        bool found = false;
-        for (auto& search_path : search_paths) {
-            full_path = LexicalPath::join(search_path, path).string();
-            if (FileSystem::exists(full_path)) {
-                found = true;
-                break;
+        if (auto it = s_full_paths.find(path); it != s_full_paths.end()) {
+            full_path = it->value;
+        } else {
+            Array<StringView, 2> search_paths { "/usr/lib"sv, "/usr/local/lib"sv };
+            bool found = false;
+            for (auto& search_path : search_paths) {
+                full_path = LexicalPath::join(search_path, path).string();
+                if (FileSystem::exists(full_path)) {
+                    found = true;
+                    break;
+                }
             }
-        }
-        if (!found) {
-            dbgln("Failed to find candidate for {}", path);
-            s_cache.set(path, {});
-            return {};
+            if (!found) {
+                dbgln("Failed to find candidate for {}", path);
+                full_path = path;
+                s_cache.set(path, {});
+            }
+            s_full_paths.set(path, full_path);
         }
     }
     if (!s_cache.contains(full_path)) {
@@ -108,6 +121,10 @@ Optional<Symbol> symbolicate(ByteString const& path, FlatPtr address, IncludeSou
     if (!cached_elf)
         return {};
 
+    auto& cached_symbols = include_source_positions == IncludeSourcePosition::Yes ? cached_elf->symbols_with_source_positions : cached_elf->symbols;
+    if (auto cached_symbol = cached_symbols.get(address); cached_symbol.has_value())
+        return cached_symbol.release_value();
+
     u32 offset = 0;
     auto symbol = cached_elf->debug_info->elf().symbolicate(address, &offset);
 
@@ -125,13 +142,15 @@ Optional<Symbol> symbolicate(ByteString const& path, FlatPtr address, IncludeSou
         }
     }
 
-    return Symbol {
+    Symbol result {
         .address = address,
         .name = move(symbol),
         .object = LexicalPath::basename(path),
         .offset = offset,
         .source_positions = move(positions),
     };
+    cached_symbols.set(address, result);
+    return result;
 }
 
 Vector<Symbol> symbolicate_thread(pid_t pid, pid_t tid, IncludeSourcePosition include_source_positions)
@@ -223,21 +242,37 @@ Vector<Symbol> symbolicate_thread(pid_t pid, pid_t tid, IncludeSourcePosition in
         }
     }
 
+    // Look up regions by address with a binary search, and find the base of each image (the lowest address mapped from it) only once.
+    // The base of the region an address is in may not be the base of its ELF image. For example, there could be an
+    // .rodata mapping at a lower address than the first .text mapping from the same image.
+    quick_sort(regions, [](auto& a, auto& b) { return a.base < b.base; });
+    HashMap<ByteString, FlatPtr> image_bases;
+    for (auto& region : regions)
+        image_bases.ensure(region.path, [&] { return region.base; });
+
     Vector<Symbol> symbols;
     bool first_frame = true;
 
     for (auto address : stack) {
         RegionWithSymbols const* found_region = nullptr;
-        for (auto& region : regions) {
+        size_t start = 0;
+        size_t end = regions.size();
+        while (start < end) {
+            auto middle = start + (end - start) / 2;
+            if (regions[middle].base <= address)
+                start = middle + 1;
+            else
+                end = middle;
+        }
+        if (start > 0) {
+            auto& region = regions[start - 1];
             FlatPtr region_end;
             if (Checked<FlatPtr>::addition_would_overflow(region.base, region.size))
                 region_end = NumericLimits<FlatPtr>::max();
             else
                 region_end = region.base + region.size;
-            if (address >= region.base && address < region_end) {
+            if (address < region_end)
                 found_region = &region;
-                break;
-            }
         }
 
         if (!found_region) {
@@ -245,19 +280,7 @@ Vector<Symbol> symbolicate_thread(pid_t pid, pid_t tid, IncludeSourcePosition in
             continue;
         }
 
-        // We found an address inside of a region, but the base of that region
-        // may not be the base of the ELF image. For example, there could be an
-        // .rodata mapping at a lower address than the first .text mapping from
-        // the same image. look for the lowest address region with the same path.
-        RegionWithSymbols const* base_region = nullptr;
-        for (auto& region : regions) {
-            if (region.path != found_region->path)
-                continue;
-            if (!base_region || region.base <= base_region->base)
-                base_region = &region;
-        }
-
-        FlatPtr adjusted_address = address - base_region->base;
+        FlatPtr adjusted_address = address - image_bases.get(found_region->path).value();
 
         // We're subtracting 1 from the address because this is the return address,
         // i.e. it is one instruction past the call instruction.
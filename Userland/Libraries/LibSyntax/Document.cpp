@@ -72,6 +72,14 @@ ByteString TextDocumentLine::to_utf8() const
     return builder.to_byte_string();
 }
 
+static u64 s_next_line_version = 1;
+
+void TextDocumentLine::did_change(Document& document)
+{
+    m_version = s_next_line_version++;
+    document.update_views({});
+}
+
 TextDocumentLine::TextDocumentLine(Document& document)
 {
     clear(document);
@@ -85,13 +93,13 @@ TextDocumentLine::TextDocumentLine(Document& document, StringView text)
 void TextDocumentLine::clear(Document& document)
 {
     m_text.clear();
-    document.update_views({});
+    did_change(document);
 }
 
 void TextDocumentLine::set_text(Document& document, Vector<u32> const text)
 {
     m_text = move(text);
-    document.update_views({});
+    did_change(document);
 }
 
 bool TextDocumentLine::set_text(Document& document, StringView text)
@@ -101,13 +109,15 @@ bool TextDocumentLine::set_text(Document& document, StringView text)
         return true;
     }
     m_text.clear();
+    // NOTE: The old text is gone even if the new one turns out to be invalid.
+    m_version = s_next_line_version++;
     Utf8View utf8_view(text);
     if (!utf8_view.validate()) {
         return false;
     }
     for (auto code_point : utf8_view)
         m_text.append(code_point);
-    document.update_views({});
+    did_change(document);
     return true;
 }
 
@@ -116,7 +126,7 @@ void TextDocumentLine::append(Document& document, u32 const* code_points, size_t
     if (length == 0)
         return;
     m_text.append(code_points, length);
-    document.update_views({});
+    did_change(document);
 }
 
 void TextDocumentLine::append(Document& document, u32 code_point)
@@ -136,7 +146,7 @@ void TextDocumentLine::insert(Document& document, size_t index, u32 code_point)
     } else {
         m_text.insert(index, code_point);
     }
-    document.update_views({});
+    did_change(document);
 }
 
 void TextDocumentLine::remove(Document& document, size_t index)
@@ -146,7 +156,7 @@ void TextDocumentLine::remove(Document& document, size_t index)
     } else {
         m_text.remove(index);
     }
-    document.update_views({});
+    did_change(document);
 }
 
 void TextDocumentLine::remove_range(Document& document, size_t start, size_t length)
@@ -160,7 +170,7 @@ void TextDocumentLine::remove_range(Document& document, size_t start, size_t len
     for (size_t i = (start + length); i < m_text.size(); ++i)
         new_data.append(m_text[i]);
     m_text = move(new_data);
-    document.update_views({});
+    did_change(document);
 }
 
 void TextDocumentLine::keep_range(Document& document, size_t start_index, size_t length)
@@ -173,13 +183,13 @@ void TextDocumentLine::keep_range(Document& document, size_t start_index, size_t
         new_data.append(m_text[i]);
 
     m_text = move(new_data);
-    document.update_views({});
+    did_change(document);
 }
 
 void TextDocumentLine::truncate(Document& document, size_t length)
 {
     m_text.resize(length);
-    document.update_views({});
+    did_change(document);
 }
 
 TextDocumentSpan const* Document::span_at(TextPosition const& position) const
@@ -57,9 +57,16 @@ public:
     bool is_empty() const { return length() == 0; }
     size_t leading_spaces() const;
 
+    // Changes whenever the text changes, and is never the same for two different lines.
+    // This lets views tell whether what they computed from the line's text is still valid.
+    u64 version() const { return m_version; }
+
 private:
+    void did_change(Document&);
+
     // NOTE: This vector is null terminated.
     Vector<u32> m_text;
+    u64 m_version { 0 };
 };
 
 class Document : public RefCounted<Document> {
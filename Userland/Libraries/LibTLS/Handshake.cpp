@@ -7,18 +7,92 @@
 
 #include <AK/Debug.h>
 #include <AK/Endian.h>
+#include <AK/HashMap.h>
 #include <AK/Random.h>
 
 #include <LibCore/Timer.h>
 #include <LibCrypto/ASN1/DER.h>
 #include <LibTLS/TLSv12.h>
+#include <LibThreading/Mutex.h>
 
 namespace TLS {
 
+// Sessions are shared between all TLS connections in the process, keyed by the SNI host name.
+static constexpr size_t max_cached_sessions = 64;
+static constexpr auto max_cached_session_age = AK::Duration::from_seconds(10 * 60);
+static Threading::Mutex s_session_cache_mutex;
+static HashMap<ByteString, CachedSession> s_session_cache;
+
+bool TLSv12::may_resume_sessions() const
+{
+    // NOTE: Resuming a session skips certificate verification, so only do it for connections that verify certificates the
+    //       same way as the one that established the session did.
+    if (m_context.is_server || m_context.extensions.SNI.is_empty())
+        return false;
+    return m_context.options.validate_certificates
+        && !m_context.options.allow_self_signed_certificates
+        && !m_context.options.root_certificates.has_value();
+}
+
+void TLSv12::cache_session()
+{
+    if (!may_resume_sessions() || m_context.session_id_size == 0)
+        return;
+
+    CachedSession session;
+    memcpy(session.session_id, m_context.session_id, m_context.session_id_size);
+    session.session_id_size = m_context.session_id_size;
+    session.cipher = m_context.cipher;
+    session.master_key = m_context.master_key;
+    session.extended_master_secret = m_context.extensions.extended_master_secret;
+
+    Threading::MutexLocker locker(s_session_cache_mutex);
+    if (s_session_cache.size() >= max_cached_sessions && !s_session_cache.contains(m_context.extensions.SNI)) {
+        auto oldest = s_session_cache.begin();
+        for (auto it = s_session_cache.begin(); it != s_session_cache.end(); ++it) {
+            if (it->value.established_at < oldest->value.established_at)
+                oldest = it;
+        }
+        s_session_cache.remove(oldest);
+    }
+    s_session_cache.set(m_context.extensions.SNI, move(session));
+}
+
+void TLSv12::forget_cached_session()
+{
+    Threading::MutexLocker locker(s_session_cache_mutex);
+    s_session_cache.remove(m_context.extensions.SNI);
+}
+
+static Optional<CachedSession> find_cached_session(ByteString const& host, Vector<CipherSuite> const& usable_cipher_suites)
+{
+    Threading::MutexLocker locker(s_session_cache_mutex);
+    auto it = s_session_cache.find(host);
+    if (it == s_session_cache.end())
+        return {};
+
+    if (MonotonicTime::now() - it->value.established_at >= max_cached_session_age) {
+        s_session_cache.remove(it);
+        return {};
+    }
+    if (!usable_cipher_suites.contains_slow(it->value.cipher))
+        return {};
+    return it->value;
+}
+
 ByteBuffer TLSv12::build_hello()
 {
     fill_with_random(m_context.local_random);
 
+    if (m_context.session_id_size == 0 && may_resume_sessions()) {
+        if (auto session = find_cached_session(m_context.extensions.SNI, m_context.options.usable_cipher_suites); session.has_value()) {
+            dbgln_if(TLS_DEBUG, "Offering to resume a cached session with {}", m_context.extensions.SNI);
+            memcpy(m_context.session_id, session->session_id, session->session_id_size);
+            m_context.session_id_size = session->session_id_size;
+            m_context.offered_session = session.release_value();
+        }
+    }
+
     auto packet_version = (u16)m_context.options.version;
     auto version = (u16)m_context.options.version;
     PacketBuilder builder { ContentType::HANDSHAKE, packet_version };
@@ -227,7 +301,24 @@ ssize_t TLSv12::handle_handshake_finished(ReadonlyBytes buffer, WritePacketStage
 
     // TODO: Compare Hashes
     dbgln_if(TLS_DEBUG, "FIXME: handle_handshake_finished :: Check message validity");
+
+    if (m_context.is_resuming_session) {
+        // RFC 5246 section 7.3: In an abbreviated handshake the server finishes first, and the connection
+        // is only established once we've answered with our own ChangeCipherSpec and Finished.
+        write_packets = WritePacketStage::Finished;
+        return index + size;
+    }
+
+    cache_session();
+    finish_handshake();
+
+    return index + size;
+}
+
+void TLSv12::finish_handshake()
+{
     m_context.connection_status = ConnectionStatus::Established;
+    m_context.offered_session.clear();
 
     if (m_handshake_timeout_timer) {
         // Disable the handshake timeout timer as handshake has been established.
@@ -238,8 +329,6 @@ ssize_t TLSv12::handle_handshake_finished(ReadonlyBytes buffer, WritePacketStage
 
     if (on_connected)
         on_connected();
-
-    return index + size;
 }
 
 ssize_t TLSv12::handle_handshake_payload(ReadonlyBytes vbuffer)
@@ -547,7 +636,7 @@ ssize_t TLSv12::handle_handshake_payload(ReadonlyBytes vbuffer)
                 auto packet = build_handshake_finished();
                 write_packet(packet);
             }
-            m_context.connection_status = ConnectionStatus::Established;
+            finish_handshake();
             break;
         }
         payload_size++;
@@ -61,6 +61,17 @@ ssize_t TLSv12::handle_server_hello(ReadonlyBytes buffer, WritePacketStage& writ
         return (i8)Error::NeedMoreData;
     }
 
+    // RFC 5246 section 7.4.1.3: The server echoes the session ID we offered if it agrees to resume that session.
+    if (m_context.offered_session.has_value()) {
+        auto const& offered_session = *m_context.offered_session;
+        m_context.is_resuming_session = session_length == offered_session.session_id_size
+            && memcmp(buffer.offset_pointer(res), offered_session.session_id, session_length) == 0;
+        if (!m_context.is_resuming_session) {
+            dbgln_if(TLS_DEBUG, "Server declined to resume the session we offered");
+            m_context.offered_session.clear();
+        }
+    }
+
     if (session_length && session_length <= 32) {
         memcpy(m_context.session_id, buffer.offset_pointer(res), session_length);
         m_context.session_id_size = session_length;
@@ -84,6 +95,10 @@ ssize_t TLSv12::handle_server_hello(ReadonlyBytes buffer, WritePacketStage& writ
         dbgln("No supported cipher could be agreed upon");
         return (i8)Error::NoCommonCipher;
     }
+    if (m_context.is_resuming_session && cipher != m_context.offered_session->cipher) {
+        dbgln("Server resumed a session with a different cipher suite");
+        return (i8)Error::NotSafe;
+    }
     m_context.cipher = cipher;
     dbgln_if(TLS_DEBUG, "Cipher: {}", enum_to_string(cipher));
 
@@ -196,6 +211,22 @@ ssize_t TLSv12::handle_server_hello(ReadonlyBytes buffer, WritePacketStage& writ
         }
     }
 
+    if (m_context.is_resuming_session) {
+        // RFC 7627 section 5.3: A resumed session has to use the extended master secret if and only if the original one did.
+        if (m_context.extensions.extended_master_secret != m_context.offered_session->extended_master_secret) {
+            dbgln("Server resumed a session with a different extended master secret setting");
+            return (i8)Error::NotSafe;
+        }
+
+        dbgln_if(TLS_DEBUG, "Resuming the cached session");
+        m_context.master_key = move(m_context.offered_session->master_key);
+        if (!expand_key())
+            return (i8)Error::OutOfMemory;
+
+        // The server skips straight to its ChangeCipherSpec and Finished.
+        m_context.connection_status = ConnectionStatus::KeyExchange;
+    }
+
     return res;
 }
 
@@ -534,6 +534,8 @@ ssize_t TLSv12::handle_message(ReadonlyBytes buffer)
 
             if (level == (u8)AlertLevel::FATAL) {
                 dbgln("We were alerted of a critical error: {} ({})", code, enum_to_string((AlertDescription)code));
+                if (m_context.is_resuming_session && m_context.connection_status != ConnectionStatus::Established)
+                    forget_cached_session();
                 m_context.critical_error = code;
                 try_disambiguate_error();
                 res = (i8)Error::UnknownError;
@@ -9,6 +9,7 @@
 #include "Certificate.h"
 #include <AK/IPv4Address.h>
 #include <AK/Queue.h>
+#include <AK/Time.h>
 #include <AK/WeakPtr.h>
 #include <LibCore/Notifier.h>
 #include <LibCore/Socket.h>
@@ -236,6 +237,17 @@ private:
     size_t m_offset_into_current_buffer { 0 };
 };
 
+// RFC 5246 section 7.4.1.2: A session the server gave us an ID for, which later connections to the same host can resume
+// with an abbreviated handshake that skips the key exchange and certificate verification.
+struct CachedSession {
+    u8 session_id[32];
+    u8 session_id_size { 0 };
+    CipherSuite cipher;
+    ByteBuffer master_key;
+    bool extended_master_secret { false };
+    MonotonicTime established_at { MonotonicTime::now() };
+};
+
 struct Context {
     bool verify_chain(StringView host) const;
     bool verify_certificate_pair(Certificate const& subject, Certificate const& issuer) const;
@@ -246,6 +258,8 @@ struct Context {
     u8 local_random[32];
     u8 session_id[32];
     u8 session_id_size { 0 };
+    Optional<CachedSession> offered_session;
+    bool is_resuming_session { false };
     CipherSuite cipher;
     bool is_server { false };
     Vector<Certificate> certificates;
@@ -526,6 +540,11 @@ private:
 
     bool expand_key();
 
+    bool may_resume_sessions() const;
+    void cache_session();
+    void forget_cached_session();
+    void finish_handshake();
+
     bool compute_master_secret_from_pre_master_secret(size_t length);
 
     void try_disambiguate_error() const;
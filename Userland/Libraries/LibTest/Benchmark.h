@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Platform.h>
+
+namespace Test {
+
+// Keeps the compiler from optimizing away the computation of `value`, e.g. when a benchmark
+// computes something only to throw it away.
+template<typename T>
+ALWAYS_INLINE void do_not_optimize(T const& value)
+{
+    asm volatile(""
+                 :
+                 : "r,m"(value)
+                 : "memory");
+}
+
+template<typename T>
+ALWAYS_INLINE void do_not_optimize(T& value)
+{
+#if defined(AK_COMPILER_CLANG)
+    asm volatile(""
+                 : "+r,m"(value)
+                 :
+                 : "memory");
+#else
+    asm volatile(""
+                 : "+m,r"(value)
+                 :
+                 : "memory");
+#endif
+}
+
+// Forces all pending memory writes to happen, and keeps the compiler from assuming anything
+// about memory across this point.
+ALWAYS_INLINE void clobber_memory()
+{
+    asm volatile(""
+                 :
+                 :
+                 : "memory");
+}
+
+}
@@ -6,7 +6,11 @@
  */
 
 #include <AK/Function.h>
+#include <AK/JsonObject.h>
+#include <AK/QuickSort.h>
+#include <AK/Time.h>
 #include <LibCore/ArgsParser.h>
+#include <LibCore/File.h>
 #include <LibTest/Macros.h>
 #include <LibTest/TestResult.h>
 #include <LibTest/TestSuite.h>
@@ -126,16 +130,24 @@ int TestSuite::main(ByteString const& suite_name, Span<StringView> arguments)
     bool do_tests_only = getenv("TESTS_ONLY") != nullptr;
     bool do_benchmarks_only = false;
     bool do_list_cases = false;
+    Optional<u64> benchmark_warmup_runs;
+    Optional<u64> benchmark_min_time_ms;
     StringView search_string = "*"sv;
 
     args_parser.add_option(do_tests_only, "Only run tests.", "tests");
-    args_parser.add_option(do_benchmarks_only, "Only run benchmarks.", "bench");
-    args_parser.add_option(m_benchmark_repetitions, "Number of times to repeat each benchmark (default 1)", "benchmark_repetitions", 0, "N");
+    args_parser.add_option(do_benchmarks_only, "Only run benchmarks, with a warmup run and for at least 500ms each unless specified otherwise.", "bench");
+    args_parser.add_option(m_benchmark_repetitions, "Minimum number of samples to take of each benchmark (default 1)", "benchmark_repetitions", 0, "N");
+    args_parser.add_option(benchmark_warmup_runs, "Number of unmeasured runs before measuring each benchmark (default 0)", "benchmark_warmup", 0, "N");
+    args_parser.add_option(benchmark_min_time_ms, "Keep sampling each benchmark for at least this long, running it several times per sample if it is fast (default 0)", "benchmark_min_time", 0, "MS");
+    args_parser.add_option(m_benchmark_json_path, "Write the benchmark results as JSON to this file", "benchmark_json", 0, "FILE");
     args_parser.add_option(m_randomized_runs, "Number of times to run each RANDOMIZED_TEST_CASE (default 100)", "randomized_runs", 0, "RUNS");
     args_parser.add_option(do_list_cases, "List available test cases.", "list");
     args_parser.add_positional_argument(search_string, "Only run matching cases.", "pattern", Core::ArgsParser::Required::No);
     args_parser.parse(arguments);
 
+    m_benchmark_warmup_runs = benchmark_warmup_runs.value_or(do_benchmarks_only ? 1 : 0);
+    m_benchmark_min_time_ms = benchmark_min_time_ms.value_or(do_benchmarks_only ? 500 : 0);
+
     if (m_setup)
         m_setup();
 
@@ -174,6 +186,108 @@ Vector<NonnullRefPtr<TestCase>> TestSuite::find_cases(ByteString const& search,
     return matches;
 }
 
+static ByteString format_nanoseconds(double nanoseconds)
+{
+    if (nanoseconds >= 1'000'000'000)
+        return ByteString::formatted("{:.3f}s", nanoseconds / 1'000'000'000);
+    if (nanoseconds >= 1'000'000)
+        return ByteString::formatted("{:.3f}ms", nanoseconds / 1'000'000);
+    if (nanoseconds >= 1'000)
+        return ByteString::formatted("{:.3f}us", nanoseconds / 1'000);
+    return ByteString::formatted("{:.1f}ns", nanoseconds);
+}
+
+// Fast benchmarks are run several times per sample, so that every sample takes at least this long.
+static constexpr i64 benchmark_sample_target_ns = 10'000'000;
+
+TestSuite::BenchmarkStatistics TestSuite::run_benchmark(TestCase const& test_case)
+{
+    BenchmarkStatistics statistics { .name = test_case.name() };
+
+    auto has_failed = [&] { return m_current_test_result != TestResult::NotRun && m_current_test_result != TestResult::Passed; };
+    auto run_iterations = [&](u64 iterations) {
+        auto started = MonotonicTime::now();
+        for (u64 i = 0; i < iterations && !has_failed(); ++i)
+            test_case.func()();
+        // Non-randomized tests don't touch the test result when passing.
+        if (m_current_test_result == TestResult::NotRun)
+            m_current_test_result = TestResult::Passed;
+        return (MonotonicTime::now() - started).to_nanoseconds();
+    };
+
+    for (u64 i = 0; i < m_benchmark_warmup_runs && !has_failed(); ++i)
+        run_iterations(1);
+
+    i64 const min_time_ns = m_benchmark_min_time_ms * 1'000'000;
+    if (min_time_ns > 0) {
+        while (!has_failed()) {
+            auto elapsed_ns = run_iterations(statistics.iterations_per_sample);
+            if (elapsed_ns >= min(benchmark_sample_target_ns, min_time_ns))
+                break;
+            // Aim a bit past the target, but don't scale up by more than 10x at a time in case the first runs were unusually fast.
+            auto const estimate = elapsed_ns > 0 ? static_cast<u64>(statistics.iterations_per_sample * 1.2 * benchmark_sample_target_ns / elapsed_ns) : NumericLimits<u64>::max();
+            statistics.iterations_per_sample = clamp(estimate, statistics.iterations_per_sample + 1, statistics.iterations_per_sample * 10);
+        }
+    }
+
+    Vector<double> samples;
+    auto sampling_started = MonotonicTime::now();
+    while (!has_failed()) {
+        auto elapsed_ns = run_iterations(statistics.iterations_per_sample);
+        samples.append(static_cast<double>(elapsed_ns) / statistics.iterations_per_sample);
+        if (samples.size() >= m_benchmark_repetitions && (MonotonicTime::now() - sampling_started).to_nanoseconds() >= min_time_ns)
+            break;
+    }
+
+    statistics.samples = samples.size();
+    if (samples.is_empty())
+        return statistics;
+
+    quick_sort(samples);
+    auto const count = samples.size();
+    statistics.min_ns = samples.first();
+    statistics.max_ns = samples.last();
+    statistics.median_ns = count % 2 ? samples[count / 2] : (samples[count / 2 - 1] + samples[count / 2]) / 2;
+
+    double sum = 0;
+    for (auto sample : samples)
+        sum += sample;
+    statistics.mean_ns = sum / count;
+
+    if (count > 1) {
+        double sum_of_squared_deviations = 0;
+        for (auto sample : samples)
+            sum_of_squared_deviations += (sample - statistics.mean_ns) * (sample - statistics.mean_ns);
+        statistics.standard_deviation_ns = sqrt(sum_of_squared_deviations / (count - 1));
+    }
+    return statistics;
+}
+
+ErrorOr<void> TestSuite::write_benchmark_results_as_json() const
+{
+    JsonObject benchmarks;
+    for (auto const& result : m_benchmark_results) {
+        JsonObject benchmark;
+        benchmark.set("iterations_per_sample", result.iterations_per_sample);
+        benchmark.set("samples", result.samples);
+        benchmark.set("median_ns", result.median_ns);
+        benchmark.set("min_ns", result.min_ns);
+        benchmark.set("max_ns", result.max_ns);
+        benchmark.set("mean_ns", result.mean_ns);
+        benchmark.set("standard_deviation_ns", result.standard_deviation_ns);
+        benchmarks.set(result.name, move(benchmark));
+    }
+
+    JsonObject json;
+    json.set("suite", m_suite_name);
+    json.set("benchmarks", move(benchmarks));
+
+    auto file = TRY(Core::File::open(m_benchmark_json_path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+    auto serialized_json = json.serialized<StringBuilder>();
+    TRY(file->write_until_depleted(serialized_json.bytes()));
+    return {};
+}
+
 int TestSuite::run(Vector<NonnullRefPtr<TestCase>> const& tests)
 {
     size_t test_count = 0;
@@ -186,42 +300,33 @@ int TestSuite::run(Vector<NonnullRefPtr<TestCase>> const& tests)
 
     for (auto const& t : tests) {
         auto const test_type = t->is_benchmark() ? "benchmark" : "test";
-        auto const repetitions = t->is_benchmark() ? m_benchmark_repetitions : 1;
 
         warnln("Running {} '{}'.", test_type, t->name());
         m_current_test_result = TestResult::NotRun;
         enable_reporting();
 
-        u64 total_time = 0;
-        u64 sum_of_squared_times = 0;
-        u64 min_time = NumericLimits<u64>::max();
-        u64 max_time = 0;
-
-        for (u64 i = 0; i < repetitions; ++i) {
-            TestElapsedTimer timer;
+        TestElapsedTimer timer;
+        if (t->is_benchmark()) {
+            auto statistics = run_benchmark(*t);
+            if (statistics.samples > 1 || statistics.iterations_per_sample > 1) {
+                dbgln("{} benchmark '{}' with a median of {} (min={}, max={}, mean={}±{}) over {} samples of {} iterations",
+                    test_result_to_string(m_current_test_result), t->name(),
+                    format_nanoseconds(statistics.median_ns), format_nanoseconds(statistics.min_ns), format_nanoseconds(statistics.max_ns),
+                    format_nanoseconds(statistics.mean_ns), format_nanoseconds(statistics.standard_deviation_ns),
+                    statistics.samples, statistics.iterations_per_sample);
+            } else {
+                dbgln("{} benchmark '{}' in {}", test_result_to_string(m_current_test_result), t->name(), format_nanoseconds(statistics.median_ns));
+            }
+            if (m_current_test_result == TestResult::Passed)
+                m_benchmark_results.append(move(statistics));
+        } else {
             t->func()();
-            auto const iteration_time = timer.elapsed_milliseconds();
-            total_time += iteration_time;
-            sum_of_squared_times += iteration_time * iteration_time;
-            min_time = min(min_time, iteration_time);
-            max_time = max(max_time, iteration_time);
-
             // Non-randomized tests don't touch the test result when passing.
             if (m_current_test_result == TestResult::NotRun)
                 m_current_test_result = TestResult::Passed;
+            dbgln("{} test '{}' in {}ms", test_result_to_string(m_current_test_result), t->name(), timer.elapsed_milliseconds());
         }
-
-        if (repetitions != 1) {
-            double average = total_time / double(repetitions);
-            double average_squared = average * average;
-            double standard_deviation = sqrt((sum_of_squared_times + repetitions * average_squared - 2 * total_time * average) / (repetitions - 1));
-
-            dbgln("{} {} '{}' on average in {:.1f}±{:.1f}ms (min={}ms, max={}ms, total={}ms)",
-                test_result_to_string(m_current_test_result), test_type, t->name(),
-                average, standard_deviation, min_time, max_time, total_time);
-        } else {
-            dbgln("{} {} '{}' in {}ms", test_result_to_string(m_current_test_result), test_type, t->name(), total_time);
-        }
+        auto const total_time = timer.elapsed_milliseconds();
 
         if (t->is_benchmark()) {
             m_benchtime += total_time;
@@ -282,6 +387,11 @@ int TestSuite::run(Vector<NonnullRefPtr<TestCase>> const& tests)
         }
     }
 
+    if (!m_benchmark_json_path.is_empty()) {
+        if (auto result = write_benchmark_results_as_json(); result.is_error())
+            warnln("Failed to write benchmark results to {}: {}", m_benchmark_json_path, result.error());
+    }
+
     // We have multiple TestResults, all except for Passed being "bad".
     // Let's get a count of them:
     return (int)(test_count - test_passed_count + benchmark_count - benchmark_passed_count);
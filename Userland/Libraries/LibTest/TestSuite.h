@@ -9,6 +9,7 @@
 
 #include <AK/ByteString.h>
 #include <AK/Function.h>
+#include <AK/Optional.h>
 #include <AK/Vector.h>
 #include <LibTest/Macros.h>
 #include <LibTest/Randomized/RandomnessSource.h>
@@ -63,12 +64,30 @@ public:
     u64 randomized_runs() { return m_randomized_runs; }
 
 private:
+    struct BenchmarkStatistics {
+        ByteString name;
+        u64 iterations_per_sample { 1 };
+        u64 samples { 0 };
+        double median_ns { 0 };
+        double min_ns { 0 };
+        double max_ns { 0 };
+        double mean_ns { 0 };
+        double standard_deviation_ns { 0 };
+    };
+
+    BenchmarkStatistics run_benchmark(TestCase const&);
+    ErrorOr<void> write_benchmark_results_as_json() const;
+
     static TestSuite* s_global;
     Vector<NonnullRefPtr<TestCase>> m_cases;
     u64 m_testtime = 0;
     u64 m_benchtime = 0;
     ByteString m_suite_name;
     u64 m_benchmark_repetitions = 1;
+    u64 m_benchmark_warmup_runs = 0;
+    u64 m_benchmark_min_time_ms = 0;
+    ByteString m_benchmark_json_path;
+    Vector<BenchmarkStatistics> m_benchmark_results;
     u64 m_randomized_runs = 100;
     Function<void()> m_setup;
     TestResult m_current_test_result = TestResult::NotRun;
@@ -8,6 +8,7 @@
  */
 
 #include <AK/BinarySearch.h>
+#include <AK/Endian.h>
 #include <AK/StringBuilder.h>
 #include <AK/Utf16View.h>
 #include <AK/Utf8View.h>
@@ -372,17 +373,30 @@ ErrorOr<String> UTF8Decoder::to_utf8(StringView input)
         bomless_input = input.substring_view(3);
     }
 
+    // OPTIMIZATION: Well-formed input decodes to itself, so there is no need to decode and re-encode every code point.
+    if (Utf8View(bomless_input).validate(Utf8View::AllowSurrogates::No))
+        return String::from_utf8_without_validation(bomless_input.bytes());
+
     return Decoder::to_utf8(bomless_input);
 }
 
-ErrorOr<void> UTF16BEDecoder::process(StringView input, Function<ErrorOr<void>(u32)> on_code_point)
+template<typename CodeUnit>
+static u16 read_utf16_code_unit(StringView input, size_t offset)
+{
+    CodeUnit code_unit;
+    __builtin_memcpy(&code_unit, input.characters_without_null_termination() + offset, sizeof(code_unit));
+    return code_unit;
+}
+
+template<typename CodeUnit, typename Callback>
+static ErrorOr<void> process_utf16(StringView input, Callback&& on_code_point)
 {
     // rfc2781, 2.2 Decoding UTF-16
     size_t utf16_length = input.length() - (input.length() % 2);
     for (size_t i = 0; i < utf16_length; i += 2) {
         // 1) If W1 < 0xD800 or W1 > 0xDFFF, the character value U is the value
         //    of W1. Terminate.
-        u16 w1 = (static_cast<u8>(input[i]) << 8) | static_cast<u8>(input[i + 1]);
+        u16 w1 = read_utf16_code_unit<CodeUnit>(input, i);
         if (!is_unicode_surrogate(w1)) {
             TRY(on_code_point(w1));
             continue;
@@ -399,7 +413,7 @@ ErrorOr<void> UTF16BEDecoder::process(StringView input, Function<ErrorOr<void>(u
             continue;
         }
 
-        u16 w2 = (static_cast<u8>(input[i + 2]) << 8) | static_cast<u8>(input[i + 3]);
+        u16 w2 = read_utf16_code_unit<CodeUnit>(input, i + 2);
         if (!Utf16View::is_low_surrogate(w2)) {
             TRY(on_code_point(replacement_code_point));
             continue;
@@ -416,18 +430,19 @@ ErrorOr<void> UTF16BEDecoder::process(StringView input, Function<ErrorOr<void>(u
     return {};
 }
 
-bool UTF16BEDecoder::validate(StringView input)
+template<typename CodeUnit>
+static bool validate_utf16(StringView input)
 {
     size_t utf16_length = input.length() - (input.length() % 2);
     for (size_t i = 0; i < utf16_length; i += 2) {
-        u16 w1 = (static_cast<u8>(input[i]) << 8) | static_cast<u8>(input[i + 1]);
+        u16 w1 = read_utf16_code_unit<CodeUnit>(input, i);
         if (!is_unicode_surrogate(w1))
             continue;
 
         if (!Utf16View::is_high_surrogate(w1) || i + 2 == utf16_length)
             return false;
 
-        u16 w2 = (static_cast<u8>(input[i + 2]) << 8) | static_cast<u8>(input[i + 3]);
+        u16 w2 = read_utf16_code_unit<CodeUnit>(input, i + 2);
         if (!Utf16View::is_low_surrogate(w2))
             return false;
 
@@ -436,6 +451,66 @@ bool UTF16BEDecoder::validate(StringView input)
     return true;
 }
 
+// Returns how many bytes at the start of the input make up ASCII code units.
+template<typename CodeUnit>
+static size_t count_leading_utf16_ascii_bytes(StringView input)
+{
+    size_t offset = 0;
+
+    // OPTIMIZATION: Look at 4 code units at a time. A code unit is ASCII if none of its bits above the lowest 7 are set.
+    static constexpr bool input_matches_host_byte_order = IsSame<CodeUnit, LittleEndian<u16>> == AK::HostIsLittleEndian;
+    static constexpr u64 non_ascii_bits = input_matches_host_byte_order ? 0xff80ff80ff80ff80ull : 0x80ff80ff80ff80ffull;
+
+    for (; offset + sizeof(u64) <= input.length(); offset += sizeof(u64)) {
+        u64 word;
+        __builtin_memcpy(&word, input.characters_without_null_termination() + offset, sizeof(word));
+        if ((word & non_ascii_bits) != 0)
+            break;
+    }
+
+    while (offset + 2 <= input.length() && read_utf16_code_unit<CodeUnit>(input, offset) < 0x80)
+        offset += 2;
+    return offset;
+}
+
+template<typename CodeUnit>
+static ErrorOr<String> utf16_to_utf8(StringView input)
+{
+    StringBuilder builder(input.length() / 2);
+    auto append_code_point = [&builder](u32 code_point) { return builder.try_append_code_point(code_point); };
+
+    size_t offset = 0;
+    while (offset < input.length()) {
+        // OPTIMIZATION: Runs of ASCII are copied over directly, without going through the full decoder.
+        auto ascii_end = offset + count_leading_utf16_ascii_bytes<CodeUnit>(input.substring_view(offset));
+        for (; offset < ascii_end; offset += 2)
+            TRY(builder.try_append(static_cast<char>(read_utf16_code_unit<CodeUnit>(input, offset))));
+
+        // Everything up to the next ASCII code unit is decoded as usual. ASCII code units are never part of a surrogate
+        // pair, so splitting the input there does not change how it decodes.
+        auto non_ascii_end = offset;
+        while (non_ascii_end + 2 <= input.length() && read_utf16_code_unit<CodeUnit>(input, non_ascii_end) >= 0x80)
+            non_ascii_end += 2;
+        if (non_ascii_end + 2 > input.length())
+            non_ascii_end = input.length();
+
+        TRY(process_utf16<CodeUnit>(input.substring_view(offset, non_ascii_end - offset), append_code_point));
+        offset = non_ascii_end;
+    }
+
+    return builder.to_string_without_validation();
+}
+
+ErrorOr<void> UTF16BEDecoder::process(StringView input, Function<ErrorOr<void>(u32)> on_code_point)
+{
+    return process_utf16<BigEndian<u16>>(input, on_code_point);
+}
+
+bool UTF16BEDecoder::validate(StringView input)
+{
+    return validate_utf16<BigEndian<u16>>(input);
+}
+
 ErrorOr<String> UTF16BEDecoder::to_utf8(StringView input)
 {
     // Discard the BOM
@@ -443,70 +518,17 @@ ErrorOr<String> UTF16BEDecoder::to_utf8(StringView input)
     if (auto bytes = input.bytes(); bytes.size() >= 2 && bytes[0] == 0xFE && bytes[1] == 0xFF)
         bomless_input = input.substring_view(2);
 
-    StringBuilder builder(bomless_input.length() / 2);
-    TRY(process(bomless_input, [&builder](u32 c) { return builder.try_append_code_point(c); }));
-    return builder.to_string();
+    return utf16_to_utf8<BigEndian<u16>>(bomless_input);
 }
 
 ErrorOr<void> UTF16LEDecoder::process(StringView input, Function<ErrorOr<void>(u32)> on_code_point)
 {
-    // rfc2781, 2.2 Decoding UTF-16
-    size_t utf16_length = input.length() - (input.length() % 2);
-    for (size_t i = 0; i < utf16_length; i += 2) {
-        // 1) If W1 < 0xD800 or W1 > 0xDFFF, the character value U is the value
-        //    of W1. Terminate.
-        u16 w1 = static_cast<u8>(input[i]) | (static_cast<u8>(input[i + 1]) << 8);
-        if (!is_unicode_surrogate(w1)) {
-            TRY(on_code_point(w1));
-            continue;
-        }
-
-        // 2) Determine if W1 is between 0xD800 and 0xDBFF. If not, the sequence
-        //    is in error and no valid character can be obtained using W1.
-        //    Terminate.
-        // 3) If there is no W2 (that is, the sequence ends with W1), or if W2
-        //    is not between 0xDC00 and 0xDFFF, the sequence is in error.
-        //    Terminate.
-        if (!Utf16View::is_high_surrogate(w1) || i + 2 == utf16_length) {
-            TRY(on_code_point(replacement_code_point));
-            continue;
-        }
-
-        u16 w2 = static_cast<u8>(input[i + 2]) | (static_cast<u8>(input[i + 3]) << 8);
-        if (!Utf16View::is_low_surrogate(w2)) {
-            TRY(on_code_point(replacement_code_point));
-            continue;
-        }
-
-        // 4) Construct a 20-bit unsigned integer U', taking the 10 low-order
-        //    bits of W1 as its 10 high-order bits and the 10 low-order bits of
-        //    W2 as its 10 low-order bits.
-        // 5) Add 0x10000 to U' to obtain the character value U. Terminate.
-        TRY(on_code_point(Utf16View::decode_surrogate_pair(w1, w2)));
-        i += 2;
-    }
-
-    return {};
+    return process_utf16<LittleEndian<u16>>(input, on_code_point);
 }
 
 bool UTF16LEDecoder::validate(StringView input)
 {
-    size_t utf16_length = input.length() - (input.length() % 2);
-    for (size_t i = 0; i < utf16_length; i += 2) {
-        u16 w1 = static_cast<u8>(input[i]) | (static_cast<u8>(input[i + 1]) << 8);
-        if (!is_unicode_surrogate(w1))
-            continue;
-
-        if (!Utf16View::is_high_surrogate(w1) || i + 2 == utf16_length)
-            return false;
-
-        u16 w2 = static_cast<u8>(input[i + 2]) | (static_cast<u8>(input[i + 3]) << 8);
-        if (!Utf16View::is_low_surrogate(w2))
-            return false;
-
-        i += 2;
-    }
-    return true;
+    return validate_utf16<LittleEndian<u16>>(input);
 }
 
 ErrorOr<String> UTF16LEDecoder::to_utf8(StringView input)
@@ -516,9 +538,30 @@ ErrorOr<String> UTF16LEDecoder::to_utf8(StringView input)
     if (auto bytes = input.bytes(); bytes.size() >= 2 && bytes[0] == 0xFF && bytes[1] == 0xFE)
         bomless_input = input.substring_view(2);
 
-    StringBuilder builder(bomless_input.length() / 2);
-    TRY(process(bomless_input, [&builder](u32 c) { return builder.try_append_code_point(c); }));
-    return builder.to_string();
+    return utf16_to_utf8<LittleEndian<u16>>(bomless_input);
+}
+
+// Decodes an encoding in which every byte is one code point, and ASCII bytes decode to themselves.
+template<typename Callback>
+static ErrorOr<String> single_byte_encoding_to_utf8(StringView input, Callback decode_byte)
+{
+    StringBuilder builder(input.length());
+    auto const* characters = input.characters_without_null_termination();
+
+    size_t offset = 0;
+    while (offset < input.length()) {
+        // OPTIMIZATION: Most text is mostly ASCII, which we can copy over in bulk without decoding anything.
+        auto ascii_length = AK::Detail::count_leading_ascii_bytes(characters + offset, input.length() - offset);
+        TRY(builder.try_append(input.substring_view(offset, ascii_length)));
+        offset += ascii_length;
+
+        if (offset < input.length()) {
+            TRY(builder.try_append_code_point(decode_byte(static_cast<u8>(characters[offset]))));
+            ++offset;
+        }
+    }
+
+    return builder.to_string_without_validation();
 }
 
 ErrorOr<void> Latin1Decoder::process(StringView input, Function<ErrorOr<void>(u32)> on_code_point)
@@ -531,6 +574,11 @@ ErrorOr<void> Latin1Decoder::process(StringView input, Function<ErrorOr<void>(u3
     return {};
 }
 
+ErrorOr<String> Latin1Decoder::to_utf8(StringView input)
+{
+    return single_byte_encoding_to_utf8(input, [](u8 byte) -> u32 { return byte; });
+}
+
 ErrorOr<void> PDFDocEncodingDecoder::process(StringView input, Function<ErrorOr<void>(u32)> on_code_point)
 {
     // PDF 1.7 spec, Appendix D.2 "PDFDocEncoding Character Set"
@@ -602,6 +650,11 @@ ErrorOr<void> XUserDefinedDecoder::process(StringView input, Function<ErrorOr<vo
     return {};
 }
 
+ErrorOr<String> XUserDefinedDecoder::to_utf8(StringView input)
+{
+    return single_byte_encoding_to_utf8(input, [](u8 byte) -> u32 { return 0xF780 + byte - 0x80; });
+}
+
 // https://encoding.spec.whatwg.org/#single-byte-decoder
 template<Integral ArrayType>
 ErrorOr<void> SingleByteDecoder<ArrayType>::process(StringView input, Function<ErrorOr<void>(u32)> on_code_point)
@@ -625,6 +678,12 @@ ErrorOr<void> SingleByteDecoder<ArrayType>::process(StringView input, Function<E
     return {};
 }
 
+template<Integral ArrayType>
+ErrorOr<String> SingleByteDecoder<ArrayType>::to_utf8(StringView input)
+{
+    return single_byte_encoding_to_utf8(input, [this](u8 byte) -> u32 { return m_translation_table[byte - 0x80]; });
+}
+
 // https://encoding.spec.whatwg.org/#index-gb18030-ranges-code-point
 static Optional<u32> index_gb18030_ranges_code_point(u32 pointer)
 {
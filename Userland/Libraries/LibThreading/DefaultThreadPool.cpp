@@ -0,0 +1,18 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibThreading/DefaultThreadPool.h>
+
+namespace Threading {
+
+DefaultThreadPool& default_thread_pool()
+{
+    // Leaked on purpose, joining the workers from a static destructor at exit is not worth the trouble.
+    static auto* s_pool = new DefaultThreadPool { [](Function<void()> work) { work(); } };
+    return *s_pool;
+}
+
+}
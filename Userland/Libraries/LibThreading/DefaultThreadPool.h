@@ -0,0 +1,21 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Function.h>
+#include <LibThreading/ThreadPool.h>
+
+namespace Threading {
+
+using DefaultThreadPool = ThreadPool<Function<void()>>;
+
+// A process-wide pool with one worker per CPU, for short CPU-bound jobs such as decoding or compressing in parallel.
+// Work that blocks on I/O or waits on other jobs does not belong here, since it keeps a CPU's worth of workers idle.
+// The workers are started on first use and are never stopped.
+DefaultThreadPool& default_thread_pool();
+
+}
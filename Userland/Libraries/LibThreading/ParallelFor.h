@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/AtomicRefCounted.h>
+#include <AK/NonnullRefPtr.h>
+#include <LibThreading/ConditionVariable.h>
+#include <LibThreading/DefaultThreadPool.h>
+#include <LibThreading/Mutex.h>
+
+namespace Threading {
+
+// Calls callback(index) for every index in [0, count), spread over the pool's workers and the calling thread,
+// and returns once all of them have returned.
+// The calling thread keeps claiming indices itself until none are left, so this makes progress even when all
+// workers are busy, including when it is called from one of the pool's own workers.
+template<typename Pool, typename Callback>
+void parallel_for(Pool& pool, size_t count, Callback&& callback)
+{
+    if (count == 0)
+        return;
+    if (count == 1) {
+        callback(0);
+        return;
+    }
+
+    struct State : public AtomicRefCounted<State> {
+        State(size_t count, Callback& callback)
+            : count(count)
+            , callback(callback)
+        {
+        }
+
+        void run()
+        {
+            while (true) {
+                auto index = next_index.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+                if (index >= count)
+                    return;
+                callback(index);
+                if (completed.fetch_add(1, AK::MemoryOrder::memory_order_acq_rel) + 1 == count) {
+                    MutexLocker locker(mutex);
+                    all_done.broadcast();
+                }
+            }
+        }
+
+        size_t const count;
+        // Only dereferenced for a claimed index, and the caller stays around until all of those are completed.
+        Callback& callback;
+        Atomic<size_t> next_index { 0 };
+        Atomic<size_t> completed { 0 };
+        Mutex mutex;
+        ConditionVariable all_done { mutex };
+    };
+
+    // Helpers that only get to run after everything is done find no index left, but still hold on to the state.
+    auto state = adopt_ref(*new State(count, callback));
+    // The calling thread takes the place of one worker, so a single-threaded pool runs everything on the caller
+    // instead of time-slicing two threads over the same work.
+    auto helper_count = min(count - 1, max<size_t>(pool.concurrency(), 1) - 1);
+    for (size_t i = 0; i < helper_count; ++i)
+        pool.submit([state] { state->run(); });
+
+    state->run();
+
+    MutexLocker locker(state->mutex);
+    while (state->completed.load(AK::MemoryOrder::memory_order_acquire) < count)
+        state->all_done.wait();
+}
+
+template<typename Callback>
+void parallel_for(size_t count, Callback&& callback)
+{
+    parallel_for(default_thread_pool(), count, forward<Callback>(callback));
+}
+
+}
@@ -94,6 +94,8 @@ public:
         return m_should_exit.load(AK::MemoryOrder::memory_order_acquire);
     }
 
+    size_t concurrency() const { return m_workers.size(); }
+
     void submit(Work work)
     {
         m_work_queue.with_locked([&](auto& queue) {
@@ -41,8 +41,7 @@ static MappingStatus translate_status(MappingStatus status, UseStd3AsciiRules us
 static bool is_valid_label(String const& label, CheckHyphens check_hyphens, CheckBidi check_bidi, CheckJoiners check_joiners, UseStd3AsciiRules use_std3_ascii_rules, TransitionalProcessing transitional_processing)
 {
     // 1. The label must be in Unicode Normalization Form NFC.
-    auto normalized = normalize(label, NormalizationForm::NFC);
-    if (normalized != label)
+    if (!is_normalized(label, NormalizationForm::NFC))
         return false;
 
     size_t position = 0;
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/CharacterTypes.h>
 #include <AK/Find.h>
 #include <AK/QuickSort.h>
 #include <AK/Utf8View.h>
@@ -297,8 +298,84 @@ static Vector<u32> normalize_implementation(Utf8View string, NormalizationForm f
     VERIFY_NOT_REACHED();
 }
 
+#if ENABLE_UNICODE_DATA
+static Property quick_check_property(NormalizationForm form)
+{
+    switch (form) {
+    case NormalizationForm::NFD:
+        return Property::NFD_QC;
+    case NormalizationForm::NFC:
+        return Property::NFC_QC;
+    case NormalizationForm::NFKD:
+        return Property::NFKD_QC;
+    case NormalizationForm::NFKC:
+        return Property::NFKC_QC;
+    }
+    VERIFY_NOT_REACHED();
+}
+#endif
+
+// Returns true only if the string is known to already be in the given normalization form. A false result means the
+// string may or may not be normalized, and the full algorithm has to be run to find out.
+// https://www.unicode.org/reports/tr15/#Detecting_Normalization_Forms
+static bool quick_check_is_normalized(StringView string, [[maybe_unused]] NormalizationForm form)
+{
+    // OPTIMIZATION: ASCII is invariant under every normalization form, and most strings are entirely ASCII.
+    auto ascii_length = AK::Detail::count_leading_ascii_bytes(string.characters_without_null_termination(), string.length());
+    if (ascii_length == string.length())
+        return true;
+
+#if ENABLE_UNICODE_DATA
+    Utf8View remaining { string.substring_view(ascii_length) };
+    if (!remaining.validate())
+        return false;
+
+    auto property = quick_check_property(form);
+    u32 last_combining_class = 0;
+
+    for (auto code_point : remaining) {
+        if (is_ascii(code_point)) {
+            last_combining_class = 0;
+            continue;
+        }
+
+        auto combining_class = canonical_combining_class(code_point);
+        if (combining_class != 0 && last_combining_class > combining_class)
+            return false;
+
+        // The generated property is set for code points whose quick check value is either No or Maybe.
+        if (code_point_has_property(code_point, property))
+            return false;
+
+        last_combining_class = combining_class;
+    }
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool is_normalized(StringView string, NormalizationForm form)
+{
+    if (quick_check_is_normalized(string, form))
+        return true;
+    return normalize(string, form) == string;
+}
+
+String normalize(String const& string, NormalizationForm form)
+{
+    // OPTIMIZATION: Hand back the string we were given if it is already normalized, rather than building a copy.
+    if (quick_check_is_normalized(string, form))
+        return string;
+    return normalize(string.bytes_as_string_view(), form);
+}
+
 String normalize(StringView string, NormalizationForm form)
 {
+    if (quick_check_is_normalized(string, form))
+        return String::from_utf8_without_validation(string.bytes());
+
     auto const code_points = normalize_implementation(Utf8View { string }, form);
 
     StringBuilder builder;
@@ -30,5 +30,8 @@ NormalizationForm normalization_form_from_string(StringView form);
 StringView normalization_form_to_string(NormalizationForm form);
 
 String normalize(StringView string, NormalizationForm form);
+String normalize(String const& string, NormalizationForm form);
+
+bool is_normalized(StringView string, NormalizationForm form);
 
 }
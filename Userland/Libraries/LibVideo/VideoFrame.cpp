@@ -6,10 +6,15 @@
 
 #include <AK/NonnullOwnPtr.h>
 #include <AK/OwnPtr.h>
+#include <LibThreading/ParallelFor.h>
 #include <LibVideo/Color/ColorConverter.h>
 
 #include "VideoFrame.h"
 
+#if defined(AK_COMPILER_GCC)
+#    pragma GCC optimize("O3")
+#endif
+
 namespace Video {
 
 ErrorOr<NonnullOwnPtr<SubsampledYUVFrame>> SubsampledYUVFrame::try_create(
@@ -58,31 +63,27 @@ ALWAYS_INLINE void interpolate_row(u32 const row, u32 const width, u16 const* pl
 }
 
 template<u32 subsampling_horizontal, u32 subsampling_vertical, typename Convert>
-ALWAYS_INLINE DecoderErrorOr<void> convert_to_bitmap_subsampled(Convert convert, u32 const width, u32 const height, FixedArray<u16> const& plane_y, FixedArray<u16> const& plane_u, FixedArray<u16> const& plane_v, Gfx::Bitmap& bitmap)
+ALWAYS_INLINE void convert_rows_subsampled(Convert convert, u32 const width, u32 const rows_start, u32 const rows_end, u16 const* plane_y, u16 const* plane_u, u16 const* plane_v, Span<u16> temporary_buffer, Gfx::Bitmap& bitmap)
 {
-    VERIFY(bitmap.width() >= 0 && static_cast<u32>(bitmap.width()) == width);
-    VERIFY(bitmap.height() >= 0 && static_cast<u32>(bitmap.height()) == height);
-
-    auto temporary_buffer = DECODER_TRY_ALLOC(FixedArray<u16>::create(static_cast<size_t>(width) * 4));
-
     // Above rows
-    auto* u_row_a = temporary_buffer.span().slice(static_cast<size_t>(width) * 0, width).data();
-    auto* v_row_a = temporary_buffer.span().slice(static_cast<size_t>(width) * 1, width).data();
+    auto* u_row_a = temporary_buffer.slice(static_cast<size_t>(width) * 0, width).data();
+    auto* v_row_a = temporary_buffer.slice(static_cast<size_t>(width) * 1, width).data();
 
     // Below rows
-    auto* u_row_b = temporary_buffer.span().slice(static_cast<size_t>(width) * 2, width).data();
-    auto* v_row_b = temporary_buffer.span().slice(static_cast<size_t>(width) * 3, width).data();
+    auto* u_row_b = temporary_buffer.slice(static_cast<size_t>(width) * 2, width).data();
+    auto* v_row_b = temporary_buffer.slice(static_cast<size_t>(width) * 3, width).data();
 
     u32 const vertical_step = 1 << subsampling_vertical;
 
-    interpolate_row<subsampling_horizontal>(0, width, plane_u.data(), plane_v.data(), u_row_a, v_row_a);
+    // Recreate the above rows that the rows before this range would have left behind.
+    auto const first_uv_row = rows_start >> subsampling_vertical;
+    interpolate_row<subsampling_horizontal>(first_uv_row > 0 ? first_uv_row - 1 : 0, width, plane_u, plane_v, u_row_a, v_row_a);
 
     // Do interpolation for all inner rows.
-    u32 const rows_end = height - subsampling_vertical;
-    for (u32 row = 0; row < rows_end; row += vertical_step) {
+    for (u32 row = rows_start; row < rows_end; row += vertical_step) {
         // Horizontally scale the row if subsampled.
         auto uv_row = row >> subsampling_vertical;
-        interpolate_row<subsampling_horizontal>(uv_row, width, plane_u.data(), plane_v.data(), u_row_b, v_row_b);
+        interpolate_row<subsampling_horizontal>(uv_row, width, plane_u, plane_v, u_row_b, v_row_b);
 
         // If subsampled vertically, vertically interpolate the middle row between the above and below rows.
         if constexpr (subsampling_vertical != 0) {
@@ -112,14 +113,43 @@ ALWAYS_INLINE DecoderErrorOr<void> convert_to_bitmap_subsampled(Convert convert,
         AK::TypedTransfer<RemoveReference<decltype(*u_row_a)>>::move(u_row_a, u_row_b, width);
         AK::TypedTransfer<RemoveReference<decltype(*u_row_a)>>::move(v_row_a, v_row_b, width);
     }
+}
+
+static constexpr u32 rows_per_conversion_band = 64;
+
+template<u32 subsampling_horizontal, u32 subsampling_vertical, typename Convert>
+ALWAYS_INLINE DecoderErrorOr<void> convert_to_bitmap_subsampled(Convert convert, u32 const width, u32 const height, FixedArray<u16> const& plane_y, FixedArray<u16> const& plane_u, FixedArray<u16> const& plane_v, Gfx::Bitmap& bitmap)
+{
+    VERIFY(bitmap.width() >= 0 && static_cast<u32>(bitmap.width()) == width);
+    VERIFY(bitmap.height() >= 0 && static_cast<u32>(bitmap.height()) == height);
+
+    // The inner rows are converted in bands on the default thread pool, each with its own temporary chroma rows.
+    static_assert(rows_per_conversion_band % 2 == 0);
+    u32 const rows_end = height - subsampling_vertical;
+    size_t const band_count = ceil_div(rows_end, rows_per_conversion_band);
+    size_t const band_buffer_size = static_cast<size_t>(width) * 4;
+    auto temporary_buffer = DECODER_TRY_ALLOC(FixedArray<u16>::create(max<size_t>(band_count, 1) * band_buffer_size));
+
+    Threading::parallel_for(band_count, [&](size_t band) {
+        u32 const band_rows_start = band * rows_per_conversion_band;
+        u32 const band_rows_end = min(band_rows_start + rows_per_conversion_band, rows_end);
+        convert_rows_subsampled<subsampling_horizontal, subsampling_vertical>(
+            convert, width, band_rows_start, band_rows_end,
+            plane_y.data(), plane_u.data(), plane_v.data(),
+            temporary_buffer.span().slice(band * band_buffer_size, band_buffer_size), bitmap);
+    });
 
     if constexpr (subsampling_vertical != 0) {
         // If there is a final row that hasn't been set above, convert it now.
         if ((height & 1) == 0) {
+            auto* u_row = temporary_buffer.span().slice(0, width).data();
+            auto* v_row = temporary_buffer.span().slice(width, width).data();
+            interpolate_row<subsampling_horizontal>((height - 2) >> 1, width, plane_u.data(), plane_v.data(), u_row, v_row);
+
             auto const* y_row = &plane_y[static_cast<size_t>(height - 1) * width];
             auto* scan_line = bitmap.scanline(static_cast<int>(height - 1));
             for (size_t column = 0; column < width; column++) {
-                scan_line[column] = convert(y_row[column], u_row_a[column], v_row_a[column]).value();
+                scan_line[column] = convert(y_row[column], u_row[column], v_row[column]).value();
             }
         }
     }
@@ -127,27 +157,42 @@ ALWAYS_INLINE DecoderErrorOr<void> convert_to_bitmap_subsampled(Convert convert,
     return {};
 }
 
+template<u32 subsampling_horizontal, u32 subsampling_vertical, VideoFullRangeFlag range>
+static ALWAYS_INLINE DecoderErrorOr<void> convert_to_bitmap_simple(MatrixCoefficients matrix_coefficients, u32 const width, u32 const height, FixedArray<u16> const& plane_y, FixedArray<u16> const& plane_u, FixedArray<u16> const& plane_v, Gfx::Bitmap& bitmap)
+{
+    switch (matrix_coefficients) {
+    case MatrixCoefficients::BT709:
+        return convert_to_bitmap_subsampled<subsampling_horizontal, subsampling_vertical>([](u16 y, u16 u, u16 v) { return ColorConverter::convert_simple_yuv_to_rgb<MatrixCoefficients::BT709, range>(y, u, v); }, width, height, plane_y, plane_u, plane_v, bitmap);
+    case MatrixCoefficients::BT601:
+        return convert_to_bitmap_subsampled<subsampling_horizontal, subsampling_vertical>([](u16 y, u16 u, u16 v) { return ColorConverter::convert_simple_yuv_to_rgb<MatrixCoefficients::BT601, range>(y, u, v); }, width, height, plane_y, plane_u, plane_v, bitmap);
+    case MatrixCoefficients::BT2020ConstantLuminance:
+    case MatrixCoefficients::BT2020NonConstantLuminance:
+        return convert_to_bitmap_subsampled<subsampling_horizontal, subsampling_vertical>([](u16 y, u16 u, u16 v) { return ColorConverter::convert_simple_yuv_to_rgb<MatrixCoefficients::BT2020ConstantLuminance, range>(y, u, v); }, width, height, plane_y, plane_u, plane_v, bitmap);
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
+
 template<u32 subsampling_horizontal, u32 subsampling_vertical>
 static ALWAYS_INLINE DecoderErrorOr<void> convert_to_bitmap_selecting_converter(CodingIndependentCodePoints cicp, u8 bit_depth, u32 const width, u32 const height, FixedArray<u16> const& plane_y, FixedArray<u16> const& plane_u, FixedArray<u16> const& plane_v, Gfx::Bitmap& bitmap)
 {
     constexpr auto output_cicp = CodingIndependentCodePoints(ColorPrimaries::BT709, TransferCharacteristics::SRGB, MatrixCoefficients::BT709, VideoFullRangeFlag::Full);
 
-    if (bit_depth == 8 && cicp.transfer_characteristics() == output_cicp.transfer_characteristics() && cicp.color_primaries() == output_cicp.color_primaries() && cicp.video_full_range_flag() == VideoFullRangeFlag::Studio) {
-        switch (cicp.matrix_coefficients()) {
-        case MatrixCoefficients::BT709:
-            return convert_to_bitmap_subsampled<subsampling_horizontal, subsampling_vertical>([](u16 y, u16 u, u16 v) { return ColorConverter::convert_simple_yuv_to_rgb<MatrixCoefficients::BT709, VideoFullRangeFlag::Studio>(y, u, v); }, width, height, plane_y, plane_u, plane_v, bitmap);
-        case MatrixCoefficients::BT601:
-            return convert_to_bitmap_subsampled<subsampling_horizontal, subsampling_vertical>([](u16 y, u16 u, u16 v) { return ColorConverter::convert_simple_yuv_to_rgb<MatrixCoefficients::BT601, VideoFullRangeFlag::Studio>(y, u, v); }, width, height, plane_y, plane_u, plane_v, bitmap);
-        case MatrixCoefficients::BT2020ConstantLuminance:
-        case MatrixCoefficients::BT2020NonConstantLuminance:
-            return convert_to_bitmap_subsampled<subsampling_horizontal, subsampling_vertical>([](u16 y, u16 u, u16 v) { return ColorConverter::convert_simple_yuv_to_rgb<MatrixCoefficients::BT2020ConstantLuminance, VideoFullRangeFlag::Studio>(y, u, v); }, width, height, plane_y, plane_u, plane_v, bitmap);
+    if (bit_depth == 8 && cicp.transfer_characteristics() == output_cicp.transfer_characteristics() && cicp.color_primaries() == output_cicp.color_primaries()) {
+        switch (cicp.video_full_range_flag()) {
+        case VideoFullRangeFlag::Studio:
+            return convert_to_bitmap_simple<subsampling_horizontal, subsampling_vertical, VideoFullRangeFlag::Studio>(cicp.matrix_coefficients(), width, height, plane_y, plane_u, plane_v, bitmap);
+        case VideoFullRangeFlag::Full:
+            return convert_to_bitmap_simple<subsampling_horizontal, subsampling_vertical, VideoFullRangeFlag::Full>(cicp.matrix_coefficients(), width, height, plane_y, plane_u, plane_v, bitmap);
         default:
-            VERIFY_NOT_REACHED();
+            break;
         }
     }
 
     auto converter = TRY(ColorConverter::create(bit_depth, cicp, output_cicp));
-    return convert_to_bitmap_subsampled<subsampling_horizontal, subsampling_vertical>([&](u16 y, u16 u, u16 v) { return converter.convert_yuv(y, u, v); }, width, height, plane_y, plane_u, plane_v, bitmap);
+    // OPTIMIZATION: Capturing the converter by value gives every band its own copy, which the compiler can then
+    //               keep apart from the bitmap it writes to instead of reloading it for every pixel.
+    return convert_to_bitmap_subsampled<subsampling_horizontal, subsampling_vertical>([converter](u16 y, u16 u, u16 v) { return converter.convert_yuv(y, u, v); }, width, height, plane_y, plane_u, plane_v, bitmap);
 }
 
 static DecoderErrorOr<void> convert_to_bitmap_selecting_subsampling(bool subsampling_horizontal, bool subsampling_vertical, CodingIndependentCodePoints cicp, u8 bit_depth, u32 const width, u32 const height, FixedArray<u16> const& plane_y, FixedArray<u16> const& plane_u, FixedArray<u16> const& plane_v, Gfx::Bitmap& bitmap)
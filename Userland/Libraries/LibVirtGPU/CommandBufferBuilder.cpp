@@ -100,6 +100,17 @@ void CommandBufferBuilder::append_set_tweaks(u32 id, u32 value)
 }
 
 void CommandBufferBuilder::append_transfer3d(Protocol::ResourceID resource, size_t width, size_t height, size_t depth, size_t direction)
+{
+    append_transfer3d_impl(resource, 0, width, height, depth, direction);
+}
+
+void CommandBufferBuilder::append_transfer3d_buffer_range(Protocol::ResourceID resource, size_t offset, size_t size, size_t direction)
+{
+    // For buffers, the data is taken from the same offset in the transfer region as it is placed at in the resource.
+    append_transfer3d_impl(resource, offset, size, 1, 1, direction);
+}
+
+void CommandBufferBuilder::append_transfer3d_impl(Protocol::ResourceID resource, size_t x, size_t width, size_t height, size_t depth, size_t direction)
 {
     CommandBuilder builder(m_buffer, Protocol::VirGLCommand::TRANSFER3D, Protocol::ObjectType::NONE);
     builder.appendu32(resource.value()); // res_handle
@@ -110,13 +121,13 @@ void CommandBufferBuilder::append_transfer3d(Protocol::ResourceID resource, size
     builder.appendu32(242);       // usage
     builder.appendu32(0);         // stride
     builder.appendu32(0);         // layer_stride
-    builder.appendu32(0);         // x
+    builder.appendu32(x);         // x
     builder.appendu32(0);         // y
     builder.appendu32(0);         // z
     builder.appendu32(width);     // width
     builder.appendu32(height);    // height
     builder.appendu32(depth);     // depth
-    builder.appendu32(0);         // data_offset
+    builder.appendu32(x);         // data_offset
     builder.appendu32(direction); // direction
 }
 
@@ -125,10 +136,10 @@ void CommandBufferBuilder::append_end_transfers_3d()
     CommandBuilder builder(m_buffer, Protocol::VirGLCommand::END_TRANSFERS, Protocol::ObjectType::NONE);
 }
 
-void CommandBufferBuilder::append_draw_vbo(Protocol::PipePrimitiveTypes primitive_type, u32 count)
+void CommandBufferBuilder::append_draw_vbo(Protocol::PipePrimitiveTypes primitive_type, u32 count, u32 start)
 {
     CommandBuilder builder(m_buffer, Protocol::VirGLCommand::DRAW_VBO, Protocol::ObjectType::NONE);
-    builder.appendu32(0);                             // start
+    builder.appendu32(start);                         // start
     builder.appendu32(count);                         // count
     builder.appendu32(to_underlying(primitive_type)); // mode
     builder.appendu32(0);                             // indexed
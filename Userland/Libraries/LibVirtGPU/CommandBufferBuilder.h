@@ -21,8 +21,9 @@ class CommandBufferBuilder {
 public:
     void append_set_tweaks(u32 id, u32 value);
     void append_transfer3d(Protocol::ResourceID resource, size_t width, size_t height = 1, size_t depth = 1, size_t direction = VIRGL_DATA_DIR_GUEST_TO_HOST);
+    void append_transfer3d_buffer_range(Protocol::ResourceID resource, size_t offset, size_t size, size_t direction = VIRGL_DATA_DIR_GUEST_TO_HOST);
     void append_end_transfers_3d();
-    void append_draw_vbo(Protocol::PipePrimitiveTypes, u32 count);
+    void append_draw_vbo(Protocol::PipePrimitiveTypes, u32 count, u32 start = 0);
     void append_clear(float r, float g, float b, float a);
     void append_clear(double depth);
     void append_set_vertex_buffers(u32 stride, u32 offset, Protocol::ResourceID resource);
@@ -43,7 +44,13 @@ public:
     void append_bind_dsa(Protocol::ObjectHandle handle);
     Vector<u32> const& build() { return m_buffer; }
 
+    bool is_empty() const { return m_buffer.is_empty(); }
+    size_t size() const { return m_buffer.size(); }
+    void clear() { m_buffer.clear_with_capacity(); }
+
 private:
+    void append_transfer3d_impl(Protocol::ResourceID resource, size_t x, size_t width, size_t height, size_t depth, size_t direction);
+
     Vector<u32> m_buffer;
 };
 
@@ -18,6 +18,12 @@
 
 namespace VirtGPU {
 
+// NOTE: The kernel backs all our resources with a transfer region of this size.
+static constexpr size_t vertex_buffer_size = PAGE_SIZE * 256;
+
+// Enough for any single command we append to a batch, e.g. a constant buffer update or a transfer.
+static constexpr size_t max_command_size_in_elements = 256;
+
 static constexpr auto frag_shader = "FRAG\n"
                                     "PROPERTY FS_COLOR0_WRITES_ALL_CBUFS 1\n"
                                     "DCL IN[0], COLOR, COLOR\n"
@@ -62,7 +68,7 @@ ErrorOr<void> Device::initialize_context(Gfx::IntSize min_size)
         .target = to_underlying(Gallium::PipeTextureTarget::BUFFER), // pipe_texture_target
         .format = 0,                                                 // untyped buffer
         .bind = to_underlying(Protocol::BindTarget::VIRGL_BIND_VERTEX_BUFFER),
-        .width = PAGE_SIZE * 256,
+        .width = static_cast<u32>(vertex_buffer_size),
         .height = 1,
         .depth = 1,
         .array_size = 1,
@@ -214,8 +220,12 @@ void Device::draw_primitives(GPU::PrimitiveType primitive_type, Vector<GPU::Vert
     auto combined_matrix = (Gfx::scale_matrix(FloatVector3 { 1, -1, 1 }) * m_projection_transform * m_model_view_transform).transpose();
     encode_constant_buffer(combined_matrix, m_constant_buffer_data);
 
-    // Create command buffer
-    CommandBufferBuilder builder;
+    // Each draw call of a batch gets its own part of the vertex buffer, so we only need to flush once that is used up.
+    auto num_bytes = sizeof(VertexData) * m_vertices.size();
+    if (m_vertex_buffer_offset + num_bytes > vertex_buffer_size)
+        MUST(flush_pending_commands());
+
+    auto& builder = m_pending_commands;
 
     // Set the constant buffer to the combined transformation matrix
     builder.append_set_constant_buffer(m_constant_buffer_data);
@@ -223,14 +233,14 @@ void Device::draw_primitives(GPU::PrimitiveType primitive_type, Vector<GPU::Vert
     // Transfer data from vertices array to kernel virgl transfer region
     VirGLTransferDescriptor descriptor {
         .data = m_vertices.data(),
-        .offset_in_region = 0,
-        .num_bytes = sizeof(VertexData) * m_vertices.size(),
+        .offset_in_region = m_vertex_buffer_offset,
+        .num_bytes = num_bytes,
         .direction = VIRGL_DATA_DIR_GUEST_TO_HOST,
     };
     MUST(Core::System::ioctl(m_gpu_file->fd(), VIRGL_IOCTL_TRANSFER_DATA, &descriptor));
 
     // Transfer data from kernel virgl transfer region to host resource
-    builder.append_transfer3d(m_vbo_resource_id, sizeof(VertexData) * m_vertices.size(), 1, 1, VIRGL_DATA_DIR_GUEST_TO_HOST);
+    builder.append_transfer3d_buffer_range(m_vbo_resource_id, m_vertex_buffer_offset, num_bytes, VIRGL_DATA_DIR_GUEST_TO_HOST);
     builder.append_end_transfers_3d();
 
     // Set the constant buffer to the identity matrix
@@ -260,10 +270,10 @@ void Device::draw_primitives(GPU::PrimitiveType primitive_type, Vector<GPU::Vert
     };
 
     // Draw the vbo
-    builder.append_draw_vbo(map_primitive_type(primitive_type), m_vertices.size());
+    builder.append_draw_vbo(map_primitive_type(primitive_type), m_vertices.size(), m_vertex_buffer_offset / sizeof(VertexData));
+    m_vertex_buffer_offset += num_bytes;
 
-    // Upload the buffer
-    MUST(upload_command_buffer(builder.build()));
+    MUST(flush_pending_commands_if_needed());
 }
 
 void Device::resize(Gfx::IntSize)
@@ -273,16 +283,14 @@ void Device::resize(Gfx::IntSize)
 
 void Device::clear_color(FloatVector4 const& color)
 {
-    CommandBufferBuilder builder;
-    builder.append_clear(color.x(), color.y(), color.z(), color.w());
-    MUST(upload_command_buffer(builder.build()));
+    m_pending_commands.append_clear(color.x(), color.y(), color.z(), color.w());
+    MUST(flush_pending_commands_if_needed());
 }
 
 void Device::clear_depth(GPU::DepthType depth)
 {
-    CommandBufferBuilder builder;
-    builder.append_clear(depth);
-    MUST(upload_command_buffer(builder.build()));
+    m_pending_commands.append_clear(depth);
+    MUST(flush_pending_commands_if_needed());
 }
 
 void Device::clear_stencil(GPU::StencilType)
@@ -292,11 +300,11 @@ void Device::clear_stencil(GPU::StencilType)
 
 void Device::blit_from_color_buffer(Gfx::Bitmap& front_buffer)
 {
-    // Transfer data back from hypervisor to kernel transfer region
-    CommandBufferBuilder builder;
-    builder.append_transfer3d(m_drawtarget, front_buffer.size().width(), front_buffer.size().height(), 1, VIRGL_DATA_DIR_HOST_TO_GUEST);
-    builder.append_end_transfers_3d();
-    MUST(upload_command_buffer(builder.build()));
+    // Transfer data back from hypervisor to kernel transfer region. This is the first time we actually
+    // need the results of everything queued up so far, so submit it all together now.
+    m_pending_commands.append_transfer3d(m_drawtarget, front_buffer.size().width(), front_buffer.size().height(), 1, VIRGL_DATA_DIR_HOST_TO_GUEST);
+    m_pending_commands.append_end_transfers_3d();
+    MUST(flush_pending_commands());
 
     // Copy from kernel transfer region to userspace
     VirGLTransferDescriptor descriptor {
@@ -438,6 +446,25 @@ Protocol::ObjectHandle Device::allocate_handle()
     return { ++m_last_allocated_handle };
 }
 
+ErrorOr<void> Device::flush_pending_commands()
+{
+    // Once submitted, the host is done with the vertex data of this batch, so the next one can start over.
+    m_vertex_buffer_offset = 0;
+    if (m_pending_commands.is_empty())
+        return {};
+    auto result = upload_command_buffer(m_pending_commands.build());
+    m_pending_commands.clear();
+    return result;
+}
+
+ErrorOr<void> Device::flush_pending_commands_if_needed()
+{
+    // Leave room for the largest command we might append next (a constant buffer update, a transfer and a draw).
+    if (m_pending_commands.size() + max_command_size_in_elements > VIRGL_MAX_COMMAND_BUFFER_ELEMS)
+        return flush_pending_commands();
+    return {};
+}
+
 ErrorOr<void> Device::upload_command_buffer(Vector<u32> const& command_buffer)
 {
     VERIFY(command_buffer.size() <= NumericLimits<u32>::max());
@@ -11,6 +11,7 @@
 #include <AK/Vector.h>
 #include <Kernel/API/VirGL.h>
 #include <LibGPU/Device.h>
+#include <LibVirtGPU/CommandBufferBuilder.h>
 #include <LibVirtGPU/VirGLProtocol.h>
 
 namespace VirtGPU {
@@ -66,9 +67,15 @@ private:
     Protocol::ObjectHandle allocate_handle();
     ErrorOr<Protocol::ResourceID> create_virgl_resource(VirGL3DResourceSpec&);
     ErrorOr<void> upload_command_buffer(Vector<u32> const&);
+    ErrorOr<void> flush_pending_commands();
+    ErrorOr<void> flush_pending_commands_if_needed();
 
     NonnullOwnPtr<Core::File> m_gpu_file;
 
+    // Commands are collected here and only submitted once we need their results, or run out of space.
+    CommandBufferBuilder m_pending_commands;
+    size_t m_vertex_buffer_offset { 0 };
+
     FloatMatrix4x4 m_model_view_transform;
     FloatMatrix4x4 m_projection_transform;
 
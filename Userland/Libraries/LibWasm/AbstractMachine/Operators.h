@@ -153,7 +153,7 @@ struct VectorShiftRight {
     auto operator()(u128 lhs, i32 rhs) const
     {
         auto shift_value = rhs % (sizeof(lhs) * 8 / VectorSize);
-        return bit_cast<u128>(bit_cast<Native128ByteVectorOf<NativeIntegralType<128 / VectorSize>, SetSign>>(lhs) >> shift_value);
+        return bit_cast<u128>(bit_cast<NativeVectorType<128 / VectorSize, VectorSize, SetSign>>(lhs) >> shift_value);
     }
     static StringView name()
     {
@@ -271,13 +271,9 @@ template<size_t VectorSize, typename Op, template<typename> typename SetSign = M
 struct VectorCmpOp {
     auto operator()(u128 c1, u128 c2) const
     {
-        using ElementType = NativeIntegralType<128 / VectorSize>;
-        auto result = bit_cast<Native128ByteVectorOf<ElementType, SetSign>>(c1);
-        auto other = bit_cast<Native128ByteVectorOf<ElementType, SetSign>>(c2);
-        Op op;
-        for (size_t i = 0; i < VectorSize; ++i)
-            result[i] = op(result[i], other[i]) ? static_cast<MakeUnsigned<ElementType>>(-1) : 0;
-        return bit_cast<u128>(result);
+        // NOTE: Comparing two vectors yields a vector with all bits of a lane set where the comparison holds, which is exactly what Wasm wants.
+        using VectorType = NativeVectorType<128 / VectorSize, VectorSize, SetSign>;
+        return bit_cast<u128>(Op {}(bit_cast<VectorType>(c1), bit_cast<VectorType>(c2)));
     }
 
     static StringView name()
@@ -324,6 +320,151 @@ struct VectorFloatCmpOp {
     }
 };
 
+template<size_t VectorSize, typename Op, template<typename> typename SetSign = MakeSigned>
+struct VectorIntegerBinaryOp {
+    auto operator()(u128 lhs, u128 rhs) const
+    {
+        using VectorType = NativeVectorType<128 / VectorSize, VectorSize, SetSign>;
+        return bit_cast<u128>(Op {}(bit_cast<VectorType>(lhs), bit_cast<VectorType>(rhs)));
+    }
+
+    static StringView name()
+    {
+        switch (VectorSize) {
+        case 16:
+            return "vec(8x16).binary_op"sv;
+        case 8:
+            return "vec(16x8).binary_op"sv;
+        case 4:
+            return "vec(32x4).binary_op"sv;
+        case 2:
+            return "vec(64x2).binary_op"sv;
+        default:
+            VERIFY_NOT_REACHED();
+        }
+    }
+};
+
+template<size_t VectorSize, typename Op, template<typename> typename SetSign = MakeSigned>
+struct VectorIntegerUnaryOp {
+    auto operator()(u128 lhs) const
+    {
+        using VectorType = NativeVectorType<128 / VectorSize, VectorSize, SetSign>;
+        return bit_cast<u128>(Op {}(bit_cast<VectorType>(lhs)));
+    }
+
+    static StringView name()
+    {
+        switch (VectorSize) {
+        case 16:
+            return "vec(8x16).unary_op"sv;
+        case 8:
+            return "vec(16x8).unary_op"sv;
+        case 4:
+            return "vec(32x4).unary_op"sv;
+        case 2:
+            return "vec(64x2).unary_op"sv;
+        default:
+            VERIFY_NOT_REACHED();
+        }
+    }
+};
+
+struct VectorMinimum {
+    template<typename Vector>
+    auto operator()(Vector lhs, Vector rhs) const
+    {
+        auto mask = bit_cast<Vector>(lhs < rhs);
+        return (lhs & mask) | (rhs & ~mask);
+    }
+
+    static StringView name() { return "min"sv; }
+};
+
+struct VectorMaximum {
+    template<typename Vector>
+    auto operator()(Vector lhs, Vector rhs) const
+    {
+        auto mask = bit_cast<Vector>(lhs > rhs);
+        return (lhs & mask) | (rhs & ~mask);
+    }
+
+    static StringView name() { return "max"sv; }
+};
+
+struct VectorRoundingAverage {
+    // NOTE: This is (lhs + rhs + 1) / 2 without the intermediate sum overflowing the lane.
+    template<typename Vector>
+    auto operator()(Vector lhs, Vector rhs) const { return (lhs | rhs) - ((lhs ^ rhs) >> 1); }
+
+    static StringView name() { return "avgr"sv; }
+};
+
+struct BitAndNot {
+    template<typename Lhs, typename Rhs>
+    auto operator()(Lhs lhs, Rhs rhs) const { return lhs & ~rhs; }
+
+    static StringView name() { return "&~"sv; }
+};
+
+struct BitNot {
+    template<typename Lhs>
+    auto operator()(Lhs lhs) const { return ~lhs; }
+
+    static StringView name() { return "~"sv; }
+};
+
+template<size_t VectorSize>
+struct VectorIntegerAbsolute {
+    auto operator()(u128 value) const
+    {
+        using SignedVector = NativeVectorType<128 / VectorSize, VectorSize, MakeSigned>;
+        using UnsignedVector = NativeVectorType<128 / VectorSize, VectorSize, MakeUnsigned>;
+        auto mask = bit_cast<UnsignedVector>(bit_cast<SignedVector>(value) < 0);
+        auto lanes = bit_cast<UnsignedVector>(value);
+        return bit_cast<u128>((lanes ^ mask) - mask);
+    }
+
+    static StringView name() { return "vec.abs"sv; }
+};
+
+template<size_t VectorSize>
+struct VectorAllTrue {
+    auto operator()(u128 value) const
+    {
+        auto lanes = bit_cast<NativeVectorType<128 / VectorSize, VectorSize, MakeUnsigned>>(value);
+        for (size_t i = 0; i < VectorSize; ++i) {
+            if (lanes[i] == 0)
+                return 0;
+        }
+        return 1;
+    }
+
+    static StringView name() { return "vec.all_true"sv; }
+};
+
+template<size_t VectorSize>
+struct VectorBitmask {
+    auto operator()(u128 value) const
+    {
+        auto lanes = bit_cast<NativeVectorType<128 / VectorSize, VectorSize, MakeSigned>>(value);
+        i32 result = 0;
+        for (size_t i = 0; i < VectorSize; ++i) {
+            if (lanes[i] < 0)
+                result |= 1 << i;
+        }
+        return result;
+    }
+
+    static StringView name() { return "vec.bitmask"sv; }
+};
+
+struct VectorAnyTrue {
+    auto operator()(u128 value) const { return value != u128(0) ? 1 : 0; }
+
+    static StringView name() { return "vec.any_true"sv; }
+};
+
 struct Minimum {
     template<typename Lhs, typename Rhs>
     auto operator()(Lhs lhs, Rhs rhs) const
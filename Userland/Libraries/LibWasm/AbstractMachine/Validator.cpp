@@ -281,6 +281,10 @@ ErrorOr<void, ValidationError> Validator::validate(TableSection const& section)
 
 ErrorOr<void, ValidationError> Validator::validate(CodeSection const& section)
 {
+    // NOTE: Forking copies the whole context (including the set of declared function references),
+    //       so do it once and reset the per-function state for every function instead.
+    auto function_validator = fork();
+
     size_t index = m_context.imported_function_count;
     for (auto& entry : section.functions()) {
         auto function_index = index++;
@@ -288,7 +292,7 @@ ErrorOr<void, ValidationError> Validator::validate(CodeSection const& section)
         auto& function_type = m_context.functions[function_index];
         auto& function = entry.func();
 
-        auto function_validator = fork();
+        function_validator.m_frames.clear_with_capacity();
         function_validator.m_context.locals = {};
         function_validator.m_context.locals.extend(function_type.parameters());
         for (auto& local : function.locals()) {
@@ -646,6 +646,8 @@ NonnullOwnPtr<JS::ExecutionContext> create_a_new_javascript_realm(JS::VM& vm, Fu
     return realm_execution_context;
 }
 
+WebEngineCustomData::~WebEngineCustomData() = default;
+
 void WebEngineCustomData::spin_event_loop_until(JS::SafeFunction<bool()> goal_condition)
 {
     Platform::EventLoopPlugin::the().spin_until(move(goal_condition));
@@ -36,7 +36,7 @@ struct CustomElementReactionsStack {
 };
 
 struct WebEngineCustomData final : public JS::VM::CustomData {
-    virtual ~WebEngineCustomData() override = default;
+    virtual ~WebEngineCustomData() override;
 
     virtual void spin_event_loop_until(JS::SafeFunction<bool()> goal_condition) override;
 
@@ -59,6 +59,14 @@ struct WebEngineCustomData final : public JS::VM::CustomData {
     // Each similar-origin window agent has a custom element reactions stack, which is initially empty.
     CustomElementReactionsStack custom_element_reactions_stack {};
 
+    // The parsed programs of the most recently created classic scripts, most recent first. See ClassicScript::create().
+    struct RecentlyParsedClassicScript {
+        NonnullRefPtr<JS::Program> program;
+        // The line the script started on in its file, which all positions in the program are offset by.
+        size_t source_line_number { 1 };
+    };
+    Vector<RecentlyParsedClassicScript> recently_parsed_classic_scripts;
+
     // https://html.spec.whatwg.org/multipage/custom-elements.html#current-element-queue
     // A similar-origin window agent's current element queue is the element queue at the top of its custom element reactions stack.
     Vector<JS::Handle<DOM::Element>>& current_element_queue() { return custom_element_reactions_stack.element_queue_stack.last(); }
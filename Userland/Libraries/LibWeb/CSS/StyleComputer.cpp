@@ -65,6 +65,7 @@
 #include <LibWeb/DOM/Attr.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Element.h>
+#include <LibWeb/DOM/NamedNodeMap.h>
 #include <LibWeb/DOM/ShadowRoot.h>
 #include <LibWeb/HTML/HTMLBRElement.h>
 #include <LibWeb/HTML/HTMLHtmlElement.h>
@@ -325,18 +326,20 @@ Vector<MatchingRule> StyleComputer::collect_matching_rules(DOM::Element const& e
 
     auto const& rule_cache = rule_cache_for_cascade_origin(cascade_origin);
 
-    Vector<MatchingRule, 512> rules_to_run;
+    // NOTE: We only collect pointers to the candidate rules here, and run the cheap rejection checks before the selector
+    //       engine. Most candidate rules don't match, so this avoids copying a MatchingRule for each of them.
+    Vector<MatchingRule const*, 512> rules_to_run;
     auto add_rules_to_run = [&](Vector<MatchingRule> const& rules) {
         rules_to_run.grow_capacity(rules_to_run.size() + rules.size());
         if (pseudo_element.has_value()) {
             for (auto const& rule : rules) {
                 if (rule.contains_pseudo_element && filter_namespace_rule(element, rule))
-                    rules_to_run.unchecked_append(rule);
+                    rules_to_run.unchecked_append(&rule);
             }
         } else {
             for (auto const& rule : rules) {
                 if (!rule.contains_pseudo_element && filter_namespace_rule(element, rule))
-                    rules_to_run.unchecked_append(rule);
+                    rules_to_run.unchecked_append(&rule);
             }
         }
     };
@@ -365,27 +368,26 @@ Vector<MatchingRule> StyleComputer::collect_matching_rules(DOM::Element const& e
     add_rules_to_run(rule_cache.other_rules);
 
     Vector<MatchingRule> matching_rules;
-    matching_rules.ensure_capacity(rules_to_run.size());
-    for (auto const& rule_to_run : rules_to_run) {
+    for (auto const* rule_to_run : rules_to_run) {
         // FIXME: This needs to be revised when adding support for the :host and ::shadow selectors, which transition shadow tree boundaries
-        auto rule_root = rule_to_run.shadow_root;
-        auto from_user_agent_or_user_stylesheet = rule_to_run.cascade_origin == CascadeOrigin::UserAgent || rule_to_run.cascade_origin == CascadeOrigin::User;
+        auto rule_root = rule_to_run->shadow_root;
+        auto from_user_agent_or_user_stylesheet = rule_to_run->cascade_origin == CascadeOrigin::UserAgent || rule_to_run->cascade_origin == CascadeOrigin::User;
         if (rule_root != shadow_root && !from_user_agent_or_user_stylesheet)
             continue;
 
-        auto const& selector = rule_to_run.rule->selectors()[rule_to_run.selector_index];
+        auto const& selector = rule_to_run->rule->selectors()[rule_to_run->selector_index];
 
         if (should_reject_with_ancestor_filter(*selector))
             continue;
 
-        if (rule_to_run.can_use_fast_matches) {
-            if (!SelectorEngine::fast_matches(selector, *rule_to_run.sheet, element))
+        if (rule_to_run->can_use_fast_matches) {
+            if (!SelectorEngine::fast_matches(selector, *rule_to_run->sheet, element))
                 continue;
         } else {
-            if (!SelectorEngine::matches(selector, *rule_to_run.sheet, element, pseudo_element))
+            if (!SelectorEngine::matches(selector, *rule_to_run->sheet, element, pseudo_element))
                 continue;
         }
-        matching_rules.append(rule_to_run);
+        matching_rules.append(*rule_to_run);
     }
     return matching_rules;
 }
@@ -1705,12 +1707,14 @@ void StyleComputer::compute_cascaded_values(StyleProperties& style, DOM::Element
         }
     }
 
-    auto animations = element.get_animations({ .subtree = false });
-    for (auto& animation : animations) {
-        if (auto effect = animation->effect(); effect && effect->is_keyframe_effect()) {
-            auto& keyframe_effect = *static_cast<Animations::KeyframeEffect*>(effect.ptr());
-            if (keyframe_effect.pseudo_element_type() == pseudo_element)
-                collect_animation_into(element, pseudo_element, keyframe_effect, style);
+    if (element.has_associated_animations()) {
+        auto animations = element.get_animations({ .subtree = false });
+        for (auto& animation : animations) {
+            if (auto effect = animation->effect(); effect && effect->is_keyframe_effect()) {
+                auto& keyframe_effect = *static_cast<Animations::KeyframeEffect*>(effect.ptr());
+                if (keyframe_effect.pseudo_element_type() == pseudo_element)
+                    collect_animation_into(element, pseudo_element, keyframe_effect, style);
+            }
         }
     }
 
@@ -2413,6 +2417,11 @@ RefPtr<StyleProperties> StyleComputer::compute_style_impl(DOM::Element& element,
         return style;
     }
 
+    if (mode == ComputeStyleMode::Normal && !pseudo_element.has_value()) {
+        if (auto shared_style = style_shared_with_previous_sibling(element))
+            return shared_style;
+    }
+
     auto style = StyleProperties::create();
     // 1. Perform the cascade. This produces the "specified style"
     bool did_match_any_pseudo_element_rules = false;
@@ -2442,6 +2451,121 @@ RefPtr<StyleProperties> StyleComputer::compute_style_impl(DOM::Element& element,
     // 8. Let the element adjust computed style
     element.adjust_computed_style(style);
 
+    if (mode == ComputeStyleMode::Normal && !pseudo_element.has_value() && can_take_part_in_style_sharing(element))
+        m_style_sharing_candidate = StyleSharingCandidate { element, style };
+
+    return style;
+}
+
+void StyleComputer::set_style_sharing_enabled(Badge<DOM::Document>, bool enabled)
+{
+    m_style_sharing_enabled = enabled;
+    m_style_sharing_candidate.clear();
+}
+
+bool StyleComputer::can_take_part_in_style_sharing(DOM::Element const& element) const
+{
+    if (!m_style_sharing_enabled)
+        return false;
+
+    // NOTE: These all feed into the style through something other than the element's attributes and its parent.
+    if (element.inline_style() || element.shadow_root() || element.use_pseudo_element().has_value())
+        return false;
+    if (element.cached_animation_name_animation() || element.has_associated_animations())
+        return false;
+    return true;
+}
+
+// NOTE: This returns true if the selector tests something that two siblings with the same tag and attributes can differ in.
+//       Anything else is either decided by the element's attributes, or by its ancestors, which siblings share.
+static bool selector_can_tell_siblings_apart(Selector const& selector)
+{
+    for (auto const& compound_selector : selector.compound_selectors()) {
+        if (compound_selector.combinator == Selector::Combinator::NextSibling
+            || compound_selector.combinator == Selector::Combinator::SubsequentSibling
+            || compound_selector.combinator == Selector::Combinator::Column)
+            return true;
+
+        for (auto const& simple_selector : compound_selector.simple_selectors) {
+            if (simple_selector.type != Selector::SimpleSelector::Type::PseudoClass)
+                continue;
+            auto const& pseudo_class = simple_selector.pseudo_class();
+            switch (pseudo_class.type) {
+            case PseudoClass::Link:
+            case PseudoClass::AnyLink:
+            case PseudoClass::LocalLink:
+            case PseudoClass::Visited:
+            case PseudoClass::Root:
+            case PseudoClass::Lang:
+                break;
+            case PseudoClass::Is:
+            case PseudoClass::Where:
+            case PseudoClass::Not:
+                for (auto const& argument_selector : pseudo_class.argument_selector_list) {
+                    if (selector_can_tell_siblings_apart(*argument_selector))
+                        return true;
+                }
+                break;
+            default:
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Checking each sibling-sensitive rule against both elements stops paying off somewhere around here.
+static constexpr size_t max_sibling_sensitive_rules_for_style_sharing = 128;
+
+RefPtr<StyleProperties> StyleComputer::style_shared_with_previous_sibling(DOM::Element& element) const
+{
+    if (!m_style_sharing_candidate.has_value())
+        return nullptr;
+
+    auto candidate = m_style_sharing_candidate->element;
+    if (candidate != element.previous_element_sibling())
+        return nullptr;
+    if (!can_take_part_in_style_sharing(element))
+        return nullptr;
+
+    if (candidate->local_name() != element.local_name() || candidate->namespace_uri() != element.namespace_uri())
+        return nullptr;
+
+    // NOTE: Comparing all attributes covers the id, classes, presentational hints and anything an attribute selector can look at.
+    auto const* attributes = element.attributes();
+    auto const* candidate_attributes = candidate->attributes();
+    if (attributes->length() != candidate_attributes->length())
+        return nullptr;
+    for (u32 i = 0; i < attributes->length(); ++i) {
+        auto const* attribute = attributes->item(i);
+        auto const* candidate_attribute = candidate_attributes->item(i);
+        if (attribute->local_name() != candidate_attribute->local_name()
+            || attribute->namespace_uri() != candidate_attribute->namespace_uri()
+            || attribute->value() != candidate_attribute->value())
+            return nullptr;
+    }
+
+    auto const& author_rule_cache = rule_cache_for_cascade_origin(CascadeOrigin::Author);
+    auto const& user_rule_cache = rule_cache_for_cascade_origin(CascadeOrigin::User);
+    auto const& user_agent_rule_cache = rule_cache_for_cascade_origin(CascadeOrigin::UserAgent);
+    auto sibling_sensitive_rule_count = author_rule_cache.sibling_sensitive_rules.size() + user_rule_cache.sibling_sensitive_rules.size() + user_agent_rule_cache.sibling_sensitive_rules.size();
+    if (sibling_sensitive_rule_count > max_sibling_sensitive_rules_for_style_sharing)
+        return nullptr;
+
+    for (auto const* rule_cache : { &author_rule_cache, &user_rule_cache, &user_agent_rule_cache }) {
+        for (auto const& rule : rule_cache->sibling_sensitive_rules) {
+            auto const& selector = rule.rule->selectors()[rule.selector_index];
+            if (SelectorEngine::matches(selector, *rule.sheet, element) != SelectorEngine::matches(selector, *rule.sheet, *candidate))
+                return nullptr;
+        }
+    }
+
+    // NOTE: The cascade would have resolved the same custom properties for this element, so hand them over as well.
+    element.set_custom_properties({}, candidate->custom_properties({}));
+
+    // NOTE: The style is copied, since it is modified in place later on (e.g. by animations).
+    auto style = m_style_sharing_candidate->style->clone();
+    m_style_sharing_candidate = StyleSharingCandidate { element, style };
     return style;
 }
 
@@ -2500,6 +2624,11 @@ NonnullOwnPtr<StyleComputer::RuleCache> StyleComputer::make_rule_cache_for_casca
                     }
                 }
 
+                m_style_invalidation_data->add_selector(selector);
+
+                if (!matching_rule.contains_pseudo_element && selector_can_tell_siblings_apart(selector))
+                    rule_cache->sibling_sensitive_rules.append(matching_rule);
+
                 bool added_to_bucket = false;
                 for (auto const& simple_selector : selector.compound_selectors().last().simple_selectors) {
                     if (simple_selector.type == CSS::Selector::SimpleSelector::Type::Id) {
@@ -2603,6 +2732,7 @@ void StyleComputer::build_rule_cache()
         m_user_style_sheet = JS::make_handle(parse_css_stylesheet(CSS::Parser::ParsingContext(document()), user_style_source.value()));
     }
 
+    m_style_invalidation_data = make<StyleInvalidationData>();
     m_author_rule_cache = make_rule_cache_for_cascade_origin(CascadeOrigin::Author);
     m_user_rule_cache = make_rule_cache_for_cascade_origin(CascadeOrigin::User);
     m_user_agent_rule_cache = make_rule_cache_for_cascade_origin(CascadeOrigin::UserAgent);
@@ -2621,6 +2751,7 @@ void StyleComputer::invalidate_rule_cache()
     // NOTE: It might not be necessary to throw away the UA rule cache.
     //       If we are sure that it's safe, we could keep it as an optimization.
     m_user_agent_rule_cache = nullptr;
+    m_style_invalidation_data = nullptr;
 }
 
 void StyleComputer::did_load_font(FlyString const&)
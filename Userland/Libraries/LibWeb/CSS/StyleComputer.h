@@ -15,6 +15,7 @@
 #include <LibWeb/CSS/CSSKeyframesRule.h>
 #include <LibWeb/CSS/CSSStyleDeclaration.h>
 #include <LibWeb/CSS/Selector.h>
+#include <LibWeb/CSS/StyleInvalidation.h>
 #include <LibWeb/CSS/StyleProperties.h>
 #include <LibWeb/Forward.h>
 #include <LibWeb/Loader/ResourceLoader.h>
@@ -134,6 +135,9 @@ public:
 
     void invalidate_rule_cache();
 
+    // NOTE: This is null while the rule cache is invalidated, as we don't want to rebuild it on every DOM change.
+    CSS::StyleInvalidationData const* style_invalidation_data() const { return m_style_invalidation_data.ptr(); }
+
     Gfx::Font const& initial_font() const;
 
     void did_load_font(FlyString const& family_name);
@@ -146,6 +150,9 @@ public:
 
     void set_viewport_rect(Badge<DOM::Document>, CSSPixelRect const& viewport_rect) { m_viewport_rect = viewport_rect; }
 
+    // While enabled, an element may reuse the style just computed for its previous sibling if nothing could tell them apart.
+    void set_style_sharing_enabled(Badge<DOM::Document>, bool);
+
     enum class AnimationRefresh {
         No,
         Yes,
@@ -162,6 +169,9 @@ private:
 
     [[nodiscard]] bool should_reject_with_ancestor_filter(Selector const&) const;
 
+    [[nodiscard]] bool can_take_part_in_style_sharing(DOM::Element const&) const;
+    RefPtr<StyleProperties> style_shared_with_previous_sibling(DOM::Element&) const;
+
     RefPtr<StyleProperties> compute_style_impl(DOM::Element&, Optional<CSS::Selector::PseudoElement::Type>, ComputeStyleMode) const;
     void compute_cascaded_values(StyleProperties&, DOM::Element&, Optional<CSS::Selector::PseudoElement::Type>, bool& did_match_any_pseudo_element_rules, ComputeStyleMode) const;
     static RefPtr<Gfx::FontCascadeList const> find_matching_font_weight_ascending(Vector<MatchingFontCandidate> const& candidates, int target_weight, float font_size_in_pt, bool inclusive);
@@ -207,6 +217,9 @@ private:
         Vector<MatchingRule> root_rules;
         Vector<MatchingRule> other_rules;
 
+        // Rules whose selectors could match only one of two siblings with identical attributes.
+        Vector<MatchingRule> sibling_sensitive_rules;
+
         HashMap<FlyString, NonnullRefPtr<Animations::KeyframeEffect::KeyFrameSet>> rules_by_animation_keyframes;
     };
 
@@ -217,6 +230,7 @@ private:
     OwnPtr<RuleCache> m_author_rule_cache;
     OwnPtr<RuleCache> m_user_rule_cache;
     OwnPtr<RuleCache> m_user_agent_rule_cache;
+    OwnPtr<StyleInvalidationData> m_style_invalidation_data;
     JS::Handle<CSSStyleSheet> m_user_style_sheet;
 
     using FontLoaderList = Vector<NonnullOwnPtr<FontLoader>>;
@@ -228,6 +242,13 @@ private:
     CSSPixelRect m_viewport_rect;
 
     CountingBloomFilter<u8, 14> m_ancestor_filter;
+
+    struct StyleSharingCandidate {
+        JS::GCPtr<DOM::Element const> element;
+        NonnullRefPtr<StyleProperties const> style;
+    };
+    bool m_style_sharing_enabled { false };
+    mutable Optional<StyleSharingCandidate> m_style_sharing_candidate;
 };
 
 class FontLoader : public ResourceClient {
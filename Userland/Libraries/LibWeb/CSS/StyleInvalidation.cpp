@@ -50,6 +50,15 @@ RequiredInvalidationAfterStyleChange compute_property_invalidation(CSS::Property
         if (old_value_opacity != new_value_opacity && (old_value_opacity == 1 || new_value_opacity == 1)) {
             invalidation.rebuild_stacking_context_tree = true;
         }
+    } else if (property_id == CSS::PropertyID::Transform && old_value && new_value) {
+        // OPTIMIZATION: Any transform other than none makes an element create a stacking context, and the paintable
+        //               picks up the new matrix when paint-only properties are resolved. So the stacking context tree
+        //               only needs a rebuild when the element gains or loses its transform, not on every frame of a
+        //               transform animation.
+        auto old_value_has_transform = !CSS::StyleProperties::transformations_for_style_value(*old_value).is_empty();
+        auto new_value_has_transform = !CSS::StyleProperties::transformations_for_style_value(*new_value).is_empty();
+        if (old_value_has_transform != new_value_has_transform)
+            invalidation.rebuild_stacking_context_tree = true;
     } else if (CSS::property_affects_stacking_context(property_id)) {
         invalidation.rebuild_stacking_context_tree = true;
     }
@@ -58,4 +67,123 @@ RequiredInvalidationAfterStyleChange compute_property_invalidation(CSS::Property
     return invalidation;
 }
 
+void StyleInvalidationData::add_selector(Selector const& selector)
+{
+    add_selector(selector, {});
+}
+
+void StyleInvalidationData::add_selector(Selector const& selector, InvalidationSet subject_invalidation_set)
+{
+    // NOTE: We walk the compound selectors from right to left. Each combinator we pass means that the compounds
+    //       further left are matched against an ancestor or a preceding sibling of the subject, so a change that
+    //       affects them has to invalidate that element's descendants or following siblings.
+    auto invalidation_set = subject_invalidation_set;
+    auto const& compound_selectors = selector.compound_selectors();
+    for (size_t i = compound_selectors.size(); i > 0; --i) {
+        auto const& compound_selector = compound_selectors[i - 1];
+        for (auto const& simple_selector : compound_selector.simple_selectors)
+            add_simple_selector(simple_selector, invalidation_set);
+
+        switch (compound_selector.combinator) {
+        case Selector::Combinator::None:
+            break;
+        case Selector::Combinator::ImmediateChild:
+        case Selector::Combinator::Descendant:
+            invalidation_set.invalidate_descendants = true;
+            break;
+        case Selector::Combinator::NextSibling:
+        case Selector::Combinator::SubsequentSibling:
+            invalidation_set.invalidate_siblings = true;
+            break;
+        case Selector::Combinator::Column:
+            invalidation_set.invalidate_descendants = true;
+            invalidation_set.invalidate_siblings = true;
+            break;
+        }
+    }
+}
+
+void StyleInvalidationData::add_simple_selector(Selector::SimpleSelector const& simple_selector, InvalidationSet invalidation_set)
+{
+    switch (simple_selector.type) {
+    case Selector::SimpleSelector::Type::Class:
+        class_names.ensure(simple_selector.lowercase_name()) |= invalidation_set;
+        return;
+    case Selector::SimpleSelector::Type::Id:
+        ids.ensure(simple_selector.lowercase_name()) |= invalidation_set;
+        return;
+    case Selector::SimpleSelector::Type::Attribute:
+        attribute_names.ensure(simple_selector.attribute().qualified_name.name.lowercase_name) |= invalidation_set;
+        return;
+    case Selector::SimpleSelector::Type::PseudoClass:
+        break;
+    default:
+        return;
+    }
+
+    auto const& pseudo_class = simple_selector.pseudo_class();
+    switch (pseudo_class.type) {
+    // These only look at the element's position in the tree, or at state that isn't stored in attributes.
+    case PseudoClass::Active:
+    case PseudoClass::Empty:
+    case PseudoClass::FirstChild:
+    case PseudoClass::FirstOfType:
+    case PseudoClass::Focus:
+    case PseudoClass::FocusVisible:
+    case PseudoClass::FocusWithin:
+    case PseudoClass::Hover:
+    case PseudoClass::LastChild:
+    case PseudoClass::LastOfType:
+    case PseudoClass::NthChild:
+    case PseudoClass::NthLastChild:
+    case PseudoClass::NthLastOfType:
+    case PseudoClass::NthOfType:
+    case PseudoClass::OnlyChild:
+    case PseudoClass::OnlyOfType:
+    case PseudoClass::Root:
+    case PseudoClass::Scope:
+    case PseudoClass::Is:
+    case PseudoClass::Not:
+    case PseudoClass::Where:
+        break;
+    case PseudoClass::Host:
+        // NOTE: Anything inside :host() is matched against the shadow host, while the rule applies inside its shadow tree.
+        invalidation_set.invalidate_descendants = true;
+        break;
+    default: {
+        // NOTE: Many of these (e.g. :disabled or :lang()) also look at the element's ancestors, so we always include descendants.
+        auto pseudo_class_invalidation_set = invalidation_set;
+        pseudo_class_invalidation_set.invalidate_descendants = true;
+        attribute_dependent_pseudo_classes |= pseudo_class_invalidation_set;
+        break;
+    }
+    }
+
+    for (auto const& argument_selector : pseudo_class.argument_selector_list)
+        add_selector(*argument_selector, invalidation_set);
+}
+
+static InvalidationSet find_invalidation_set(HashMap<FlyString, InvalidationSet> const& map, StringView name)
+{
+    if (map.is_empty())
+        return {};
+    auto lowercase_name = MUST(FlyString::from_utf8(name.to_lowercase_string()));
+    return map.get(lowercase_name).value_or({});
+}
+
+InvalidationSet StyleInvalidationData::invalidation_set_for_class(StringView class_name) const
+{
+    return find_invalidation_set(class_names, class_name);
+}
+
+InvalidationSet StyleInvalidationData::invalidation_set_for_id(StringView id) const
+{
+    return find_invalidation_set(ids, id);
+}
+
+InvalidationSet StyleInvalidationData::invalidation_set_for_attribute(StringView attribute_name) const
+{
+    return find_invalidation_set(attribute_names, attribute_name);
+}
+
 }
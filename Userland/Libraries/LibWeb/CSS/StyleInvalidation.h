@@ -6,7 +6,10 @@
 
 #pragma once
 
+#include <AK/FlyString.h>
+#include <AK/HashMap.h>
 #include <LibWeb/CSS/PropertyID.h>
+#include <LibWeb/CSS/Selector.h>
 
 namespace Web::CSS {
 
@@ -28,6 +31,40 @@ struct RequiredInvalidationAfterStyleChange {
     static RequiredInvalidationAfterStyleChange full() { return { true, true, true, true }; }
 };
 
+// Which elements, besides the one that changed, may start or stop matching some selector after a DOM change.
+struct InvalidationSet {
+    bool invalidate_descendants : 1 { false };
+    bool invalidate_siblings : 1 { false };
+
+    void operator|=(InvalidationSet const& other)
+    {
+        invalidate_descendants |= other.invalidate_descendants;
+        invalidate_siblings |= other.invalidate_siblings;
+    }
+};
+
+// A summary of where classes, ids and attributes appear in the selectors in use. This lets a class, id or attribute
+// change restyle only the elements that could be affected, instead of the whole subtree of the changed element.
+// NOTE: All names are stored lowercased, so that lookups work in quirks mode as well.
+struct StyleInvalidationData {
+    HashMap<FlyString, InvalidationSet> class_names;
+    HashMap<FlyString, InvalidationSet> ids;
+    HashMap<FlyString, InvalidationSet> attribute_names;
+
+    // Pseudo-classes that may depend on an attribute of the element or one of its ancestors, e.g. :checked or :lang().
+    InvalidationSet attribute_dependent_pseudo_classes;
+
+    void add_selector(Selector const&);
+
+    InvalidationSet invalidation_set_for_class(StringView) const;
+    InvalidationSet invalidation_set_for_id(StringView) const;
+    InvalidationSet invalidation_set_for_attribute(StringView) const;
+
+private:
+    void add_selector(Selector const&, InvalidationSet subject_invalidation_set);
+    void add_simple_selector(Selector::SimpleSelector const&, InvalidationSet);
+};
+
 RequiredInvalidationAfterStyleChange compute_property_invalidation(CSS::PropertyID property_id, RefPtr<CSS::StyleValue const> const& old_value, RefPtr<CSS::StyleValue const> const& new_value);
 
 }
@@ -15,6 +15,7 @@
 #include <AK/StringBuilder.h>
 #include <AK/Utf8View.h>
 #include <LibCore/Timer.h>
+#include <LibCore/TraceEvent.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/FunctionObject.h>
 #include <LibJS/Runtime/NativeFunction.h>
@@ -1014,6 +1015,18 @@ URL::URL Document::parse_url(StringView url) const
 }
 
 void Document::set_needs_layout()
+{
+    // NOTE: We don't know what changed, so none of the intrinsic sizes cached by previous layouts can be trusted.
+    if (m_layout_root)
+        m_layout_root->cached_intrinsic_sizes().clear();
+
+    if (m_needs_layout)
+        return;
+    m_needs_layout = true;
+    schedule_layout_update();
+}
+
+void Document::set_needs_layout(Badge<Layout::Node>)
 {
     if (m_needs_layout)
         return;
@@ -1082,6 +1095,8 @@ void Document::update_layout()
     if (!navigable)
         return;
 
+    Core::TraceEventScope trace_event("layout"sv, "Document::update_layout"sv);
+
     auto* document_element = this->document_element();
     auto viewport_rect = this->viewport_rect();
 
@@ -1095,6 +1110,7 @@ void Document::update_layout()
     }
 
     Layout::LayoutState layout_state;
+    layout_state.intrinsic_sizes = move(m_layout_root->cached_intrinsic_sizes());
 
     {
         Layout::BlockFormattingContext root_formatting_context(layout_state, *m_layout_root, nullptr);
@@ -1118,6 +1134,7 @@ void Document::update_layout()
     }
 
     layout_state.commit(*m_layout_root);
+    m_layout_root->cached_intrinsic_sizes() = move(layout_state.intrinsic_sizes);
 
     // Broadcast the current viewport rect to any new paintables, so they know whether they're visible or not.
     inform_all_viewport_clients_about_the_current_viewport_rect();
@@ -1205,19 +1222,23 @@ void Document::update_style()
     if (m_created_for_appropriate_template_contents)
         return;
 
+    Core::TraceEventScope trace_event("style"sv, "Document::update_style"sv);
+
     // Fetch the viewport rect once, instead of repeatedly, during style computation.
     style_computer().set_viewport_rect({}, viewport_rect());
 
     evaluate_media_rules();
 
     style_computer().reset_ancestor_filter();
+    style_computer().set_style_sharing_enabled({}, true);
 
     auto invalidation = update_style_recursively(*this, style_computer());
+    style_computer().set_style_sharing_enabled({}, false);
+    // NOTE: Elements that need a relayout have already requested one through their layout node,
+    //       which lets us keep the cached layout results of everything they don't affect.
     if (invalidation.rebuild_layout_tree) {
         invalidate_layout();
     } else {
-        if (invalidation.relayout)
-            set_needs_layout();
         if (invalidation.rebuild_stacking_context_tree)
             invalidate_stacking_context_tree();
     }
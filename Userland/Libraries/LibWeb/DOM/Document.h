@@ -232,6 +232,7 @@ public:
     void update_animated_style_if_needed();
 
     void set_needs_layout();
+    void set_needs_layout(Badge<Layout::Node>);
 
     void invalidate_layout();
     void invalidate_stacking_context_tree();
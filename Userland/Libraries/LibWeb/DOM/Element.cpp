@@ -446,7 +446,7 @@ void Element::run_attribute_change_steps(FlyString const& local_name, Optional<S
 
     // AD-HOC: Run our own internal attribute change handler.
     attribute_changed(local_name, value);
-    invalidate_style_after_attribute_change(local_name);
+    invalidate_style_after_attribute_change(local_name, old_value, value);
 
     document().bump_dom_tree_version();
 }
@@ -523,13 +523,38 @@ static CSS::RequiredInvalidationAfterStyleChange compute_required_invalidation(C
     return invalidation;
 }
 
+static bool custom_properties_are_equal(HashMap<FlyString, CSS::StyleProperty> const& a, HashMap<FlyString, CSS::StyleProperty> const& b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (auto const& it : a) {
+        auto other = b.find(it.key);
+        if (other == b.end())
+            return false;
+        if (it.value.important != other->value.important || *it.value.value != *other->value.value)
+            return false;
+    }
+    return true;
+}
+
 CSS::RequiredInvalidationAfterStyleChange Element::recompute_style()
 {
     set_needs_style_update(false);
     VERIFY(parent());
 
+    auto old_custom_properties = move(m_custom_properties);
     auto new_computed_css_values = document().style_computer().compute_style(*this);
 
+    // NOTE: Custom properties are looked up through the ancestor chain, so a change here may affect any element in our subtree.
+    if (!custom_properties_are_equal(old_custom_properties, m_custom_properties)) {
+        for_each_child([](Node& child) {
+            child.invalidate_style();
+            return IterationDecision::Continue;
+        });
+        if (auto shadow_root = this->shadow_root())
+            shadow_root->invalidate_style();
+    }
+
     // Tables must not inherit -libweb-* values for text-align.
     // FIXME: Find the spec for this.
     if (is<HTML::HTMLTableElement>(*this)) {
@@ -547,6 +572,9 @@ CSS::RequiredInvalidationAfterStyleChange Element::recompute_style()
     if (invalidation.is_none())
         return invalidation;
 
+    // NOTE: Our children inherit from us, so they have to be restyled as well.
+    invalidate_style_of_children();
+
     m_computed_css_values = move(new_computed_css_values);
     computed_css_values_changed();
 
@@ -556,6 +584,8 @@ CSS::RequiredInvalidationAfterStyleChange Element::recompute_style()
     if (!invalidation.rebuild_layout_tree && layout_node()) {
         // If we're keeping the layout tree, we can just apply the new style to the existing layout tree.
         layout_node()->apply_style(*m_computed_css_values);
+        if (invalidation.relayout)
+            layout_node()->set_needs_layout();
         if (invalidation.repaint && paintable())
             paintable()->set_needs_display();
     }
@@ -1881,13 +1911,61 @@ ErrorOr<void> Element::scroll_into_view(Optional<Variant<bool, ScrollIntoViewOpt
     // FIXME: 8. Optionally perform some other action that brings the element to the user’s attention.
 }
 
-void Element::invalidate_style_after_attribute_change(FlyString const& attribute_name)
+void Element::invalidate_style_after_attribute_change(FlyString const& attribute_name, Optional<String> const& old_value, Optional<String> const& new_value)
 {
-    // FIXME: Only invalidate if the attribute can actually affect style.
-    (void)attribute_name;
+    // If the document is already marked for a full style update, there's no need to do anything here.
+    if (document().needs_full_style_update())
+        return;
 
+    // NOTE: Presentational hints can depend on any attribute, so this element is always restyled.
+    //       Its descendants and following siblings are only restyled if some selector could make them care about the change.
+    //       If this element's style changes, its children get restyled anyway, since they inherit from it.
     // FIXME: This will need to become smarter when we implement the :has() selector.
-    invalidate_style();
+    auto const* invalidation_data_ptr = document().style_computer().style_invalidation_data();
+    if (!invalidation_data_ptr) {
+        invalidate_style();
+        return;
+    }
+    auto const& invalidation_data = *invalidation_data_ptr;
+    auto invalidation_set = invalidation_data.invalidation_set_for_attribute(attribute_name);
+
+    if (attribute_name == HTML::AttributeNames::class_) {
+        auto old_class_attribute = old_value.value_or(String {});
+        auto new_class_attribute = new_value.value_or(String {});
+        auto old_classes = old_class_attribute.bytes_as_string_view().split_view_if(Infra::is_ascii_whitespace);
+        auto new_classes = new_class_attribute.bytes_as_string_view().split_view_if(Infra::is_ascii_whitespace);
+        for (auto old_class : old_classes) {
+            if (!new_classes.contains_slow(old_class))
+                invalidation_set |= invalidation_data.invalidation_set_for_class(old_class);
+        }
+        for (auto new_class : new_classes) {
+            if (!old_classes.contains_slow(new_class))
+                invalidation_set |= invalidation_data.invalidation_set_for_class(new_class);
+        }
+    } else {
+        if (attribute_name == HTML::AttributeNames::id) {
+            if (old_value.has_value())
+                invalidation_set |= invalidation_data.invalidation_set_for_id(*old_value);
+            if (new_value.has_value())
+                invalidation_set |= invalidation_data.invalidation_set_for_id(*new_value);
+        }
+        invalidation_set |= invalidation_data.attribute_dependent_pseudo_classes;
+    }
+
+    // NOTE: Some attributes, like <table cellpadding>, are read by the presentational hints of descendants,
+    //       which no selector tells us about.
+    if (affects_presentational_hints_of_descendants(attribute_name))
+        invalidation_set.invalidate_descendants = true;
+
+    if (invalidation_set.invalidate_descendants)
+        invalidate_style();
+    else
+        set_needs_style_update(true);
+
+    if (invalidation_set.invalidate_siblings) {
+        for (auto* sibling = next_element_sibling(); sibling; sibling = sibling->next_element_sibling())
+            sibling->invalidate_style();
+    }
 }
 
 // https://www.w3.org/TR/wai-aria-1.2/#tree_exclusion
@@ -157,6 +157,9 @@ public:
 
     virtual void apply_presentational_hints(CSS::StyleProperties&) const { }
 
+    // Whether the given attribute of this element is read by the presentational hints of its descendants.
+    virtual bool affects_presentational_hints_of_descendants(FlyString const&) const { return false; }
+
     // https://dom.spec.whatwg.org/#concept-element-attributes-change-ext
     virtual void attribute_change_steps(FlyString const& local_name, Optional<String> const& old_value, Optional<String> const& value, Optional<FlyString> const& namespace_);
 
@@ -410,7 +413,7 @@ protected:
 private:
     void make_html_uppercased_qualified_name();
 
-    void invalidate_style_after_attribute_change(FlyString const& attribute_name);
+    void invalidate_style_after_attribute_change(FlyString const& attribute_name, Optional<String> const& old_value, Optional<String> const& new_value);
 
     WebIDL::ExceptionOr<JS::GCPtr<Node>> insert_adjacent(StringView where, JS::NonnullGCPtr<Node> node);
 
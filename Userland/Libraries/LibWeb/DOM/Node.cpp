@@ -288,6 +288,23 @@ void Node::invalidate_style()
     document().schedule_style_update();
 }
 
+// Used when this node's style has changed, since its children inherit from it.
+void Node::invalidate_style_of_children()
+{
+    for_each_child([&](Node& child) {
+        child.m_needs_style_update = true;
+        m_child_needs_style_update = true;
+        return IterationDecision::Continue;
+    });
+    if (auto shadow_root = is_element() ? static_cast<DOM::Element&>(*this).shadow_root() : nullptr) {
+        shadow_root->m_needs_style_update = true;
+        m_child_needs_style_update = true;
+    }
+    for (auto* ancestor = parent_or_shadow_host(); ancestor; ancestor = ancestor->parent_or_shadow_host())
+        ancestor->m_child_needs_style_update = true;
+    document().schedule_style_update();
+}
+
 String Node::child_text_content() const
 {
     if (!is<ParentNode>(*this))
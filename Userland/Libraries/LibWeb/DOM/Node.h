@@ -222,6 +222,7 @@ public:
     void set_child_needs_style_update(bool b) { m_child_needs_style_update = b; }
 
     void invalidate_style();
+    void invalidate_style_of_children();
 
     void set_document(Badge<Document>, Document&);
 
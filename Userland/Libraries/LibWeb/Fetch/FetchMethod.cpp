@@ -46,6 +46,11 @@ JS::NonnullGCPtr<JS::Promise> fetch(JS::VM& vm, RequestInfo const& input, Reques
     // 3. Let request be requestObject’s request.
     auto request = request_object->request();
 
+    // AD-HOC: Network responses are handed to script as they arrive, so that readers of Response.body don't have to wait
+    //         for the whole body to be downloaded first.
+    if (request->url().scheme().is_one_of("http"sv, "https"sv))
+        request->set_buffer_policy(Infrastructure::Request::BufferPolicy::DoNotBufferResponse);
+
     // 4. If requestObject’s signal is aborted, then:
     if (request_object->signal()->aborted()) {
         // 1. Abort the fetch() call with p, request, null, and requestObject’s signal’s abort reason.
@@ -68,6 +68,46 @@ namespace Web::Fetch::Fetching {
         _temporary_result.release_value();                                                           \
     })
 
+static HTTP::RequestPriority load_priority_for_request(Infrastructure::Request const& request)
+{
+    switch (request.priority()) {
+    case Infrastructure::Request::Priority::High:
+        return HTTP::RequestPriority::High;
+    case Infrastructure::Request::Priority::Low:
+        return HTTP::RequestPriority::Low;
+    case Infrastructure::Request::Priority::Auto:
+        break;
+    }
+
+    if (request.render_blocking())
+        return HTTP::RequestPriority::High;
+
+    if (request.initiator() == Infrastructure::Request::Initiator::Prefetch)
+        return HTTP::RequestPriority::Low;
+
+    if (!request.destination().has_value())
+        return HTTP::RequestPriority::Normal;
+
+    switch (*request.destination()) {
+    // Anything that holds up parsing or rendering of the document goes first.
+    case Infrastructure::Request::Destination::Document:
+    case Infrastructure::Request::Destination::Frame:
+    case Infrastructure::Request::Destination::IFrame:
+    case Infrastructure::Request::Destination::Style:
+    case Infrastructure::Request::Destination::Script:
+    case Infrastructure::Request::Destination::Font:
+        return HTTP::RequestPriority::High;
+    // Media can be displayed progressively and shouldn't compete with the above.
+    case Infrastructure::Request::Destination::Image:
+    case Infrastructure::Request::Destination::Audio:
+    case Infrastructure::Request::Destination::Video:
+    case Infrastructure::Request::Destination::Track:
+        return HTTP::RequestPriority::Low;
+    default:
+        return HTTP::RequestPriority::Normal;
+    }
+}
+
 // https://fetch.spec.whatwg.org/#concept-fetch
 WebIDL::ExceptionOr<JS::NonnullGCPtr<Infrastructure::FetchController>> fetch(JS::Realm& realm, Infrastructure::Request& request, Infrastructure::FetchAlgorithms const& algorithms, UseParallelQueue use_parallel_queue)
 {
@@ -203,6 +243,8 @@ WebIDL::ExceptionOr<JS::NonnullGCPtr<Infrastructure::FetchController>> fetch(JS:
     //     in setting request’s priority to a user-agent-defined object.
     // NOTE: The user-agent-defined object could encompass stream weight and dependency for HTTP/2, and equivalent
     //       information used to prioritize dispatch and processing of HTTP/1 fetches.
+    if (!request.internal_priority().has_value())
+        request.set_internal_priority(Infrastructure::Request::InternalPriority { .load_priority = load_priority_for_request(request) });
 
     // 16. If request is a subresource request, then:
     if (request.is_subresource_request()) {
@@ -1907,6 +1949,13 @@ WebIDL::ExceptionOr<JS::NonnullGCPtr<PendingResponse>> nonstandard_resource_load
     load_request.set_url(request->current_url());
     load_request.set_page(page);
     load_request.set_method(ByteString::copy(request->method()));
+    if (request->internal_priority().has_value())
+        load_request.set_priority(request->internal_priority()->load_priority);
+    load_request.set_fetch_parameters({
+        .mode = Infrastructure::request_mode_to_string(request->mode()),
+        .credentials_mode = Infrastructure::request_credentials_mode_to_string(request->credentials_mode()),
+        .integrity_metadata = request->integrity_metadata(),
+    });
 
     for (auto const& header : *request->header_list())
         load_request.set_header(ByteString::copy(header.name), ByteString::copy(header.value));
@@ -1936,7 +1985,7 @@ WebIDL::ExceptionOr<JS::NonnullGCPtr<PendingResponse>> nonstandard_resource_load
     // FIXME: This check should be removed and all HTTP requests should go through the `ResourceLoader::load_unbuffered`
     //        path. The buffer option should then be supplied to the steps below that allow us to buffer data up to a
     //        user-agent-defined limit (or not). However, we will need to fully use stream operations throughout the
-    //        fetch process to enable this (e.g. Body::fully_read must use streams for this to work).
+    //        fetch process to enable this (e.g. Body::incrementally_read needs to be used by the HTML parser).
     if (request->buffer_policy() == Infrastructure::Request::BufferPolicy::DoNotBufferResponse) {
         HTML::TemporaryExecutionContext execution_context { Bindings::host_defined_environment_settings_object(realm), HTML::TemporaryExecutionContext::CallbacksEnabled::Yes };
 
@@ -5,6 +5,8 @@
  */
 
 #include <LibJS/Runtime/PromiseCapability.h>
+#include <LibWeb/Bindings/ExceptionOrUtils.h>
+#include <LibWeb/Bindings/HostDefined.h>
 #include <LibWeb/Bindings/MainThreadVM.h>
 #include <LibWeb/Fetch/BodyInit.h>
 #include <LibWeb/Fetch/Infrastructure/HTTP/Bodies.h>
@@ -12,6 +14,7 @@
 #include <LibWeb/Fetch/Infrastructure/Task.h>
 #include <LibWeb/HTML/Scripting/TemporaryExecutionContext.h>
 #include <LibWeb/Streams/AbstractOperations.h>
+#include <LibWeb/Streams/ReadableStreamDefaultReader.h>
 #include <LibWeb/WebIDL/Promise.h>
 
 namespace Web::Fetch::Infrastructure {
@@ -87,9 +90,8 @@ void Body::fully_read(JS::Realm& realm, Web::Fetch::Infrastructure::Body::Proces
         }));
     };
 
-    // 4. Let reader be the result of getting a reader for body’s stream. If that threw an exception, then run errorSteps with that exception and return.
-    // 5. Read all bytes from reader, given successSteps and errorSteps.
-    // FIXME: Use streams for these steps.
+    // OPTIMIZATION: Bodies that were created from a byte sequence or Blob are handed over directly, rather than being read
+    //               back out of their stream chunk by chunk.
     m_source.visit(
         [&](ByteBuffer const& byte_buffer) {
             if (auto result = success_steps(byte_buffer); result.is_error())
@@ -100,7 +102,29 @@ void Body::fully_read(JS::Realm& realm, Web::Fetch::Infrastructure::Body::Proces
                 error_steps(WebIDL::UnknownError::create(realm, "Out-of-memory"_fly_string));
         },
         [&](Empty) {
-            error_steps(WebIDL::DOMException::create(realm, "DOMException"_fly_string, "Reading from Blob, FormData or null source is not yet implemented"_fly_string));
+            HTML::TemporaryExecutionContext execution_context { Bindings::host_defined_environment_settings_object(realm), HTML::TemporaryExecutionContext::CallbacksEnabled::Yes };
+
+            // 4. Let reader be the result of getting a reader for body’s stream. If that threw an exception, then run errorSteps with that exception and return.
+            auto reader = Streams::acquire_readable_stream_default_reader(*m_stream);
+            if (reader.is_exception()) {
+                auto throw_completion = Bindings::dom_exception_to_throw_completion(realm.vm(), reader.release_error());
+                queue_fetch_task(*task_destination_object, JS::create_heap_function(realm.heap(), [process_body_error, error = JS::make_handle(*throw_completion.value())]() {
+                    process_body_error->function()(error.value());
+                }));
+                return;
+            }
+
+            // 5. Read all bytes from reader, given successSteps and errorSteps.
+            reader.value()->read_all_bytes(
+                [success_steps = move(success_steps), error_steps = move(error_steps), &realm](ByteBuffer bytes) {
+                    if (auto result = success_steps(bytes); result.is_error())
+                        error_steps(WebIDL::UnknownError::create(realm, "Out-of-memory"_fly_string));
+                },
+                [&realm, process_body_error, task_destination_object](JS::Value error) {
+                    queue_fetch_task(*task_destination_object, JS::create_heap_function(realm.heap(), [process_body_error, error = JS::make_handle(error)]() {
+                        process_body_error->function()(error.value());
+                    }));
+                });
         });
 }
 
@@ -227,6 +227,7 @@ JS::NonnullGCPtr<Request> Request::clone(JS::Realm& realm) const
     new_request->set_initiator(m_initiator);
     new_request->set_destination(m_destination);
     new_request->set_priority(m_priority);
+    new_request->set_internal_priority(m_internal_priority);
     new_request->set_origin(m_origin);
     new_request->set_policy_container(m_policy_container);
     new_request->set_referrer(m_referrer);
@@ -437,6 +438,19 @@ StringView request_mode_to_string(Request::Mode mode)
     VERIFY_NOT_REACHED();
 }
 
+StringView request_credentials_mode_to_string(Request::CredentialsMode credentials_mode)
+{
+    switch (credentials_mode) {
+    case Request::CredentialsMode::Omit:
+        return "omit"sv;
+    case Request::CredentialsMode::SameOrigin:
+        return "same-origin"sv;
+    case Request::CredentialsMode::Include:
+        return "include"sv;
+    }
+    VERIFY_NOT_REACHED();
+}
+
 Optional<Request::Priority> request_priority_from_string(StringView string)
 {
     if (string.equals_ignoring_ascii_case("high"sv))
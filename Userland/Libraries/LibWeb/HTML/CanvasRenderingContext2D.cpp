@@ -380,6 +380,11 @@ WebIDL::ExceptionOr<JS::NonnullGCPtr<ImageData>> CanvasRenderingContext2D::creat
     return ImageData::create(realm(), width, height, settings);
 }
 
+static ALWAYS_INLINE u32 swap_red_and_blue_channels(u32 pixel)
+{
+    return (pixel & 0xff00ff00) | ((pixel & 0x000000ff) << 16) | ((pixel & 0x00ff0000) >> 16);
+}
+
 // https://html.spec.whatwg.org/multipage/canvas.html#dom-context-2d-getimagedata
 WebIDL::ExceptionOr<JS::GCPtr<ImageData>> CanvasRenderingContext2D::get_image_data(int x, int y, int width, int height, Optional<ImageDataSettings> const& settings) const
 {
@@ -405,12 +410,13 @@ WebIDL::ExceptionOr<JS::GCPtr<ImageData>> CanvasRenderingContext2D::get_image_da
     auto source_rect_intersected = source_rect.intersected(bitmap.rect());
 
     // 6. Set the pixel values of imageData to be the pixels of this's output bitmap in the area specified by the source rectangle in the bitmap's coordinate space units, converted from this's color space to imageData's colorSpace using 'relative-colorimetric' rendering intent.
-    // FIXME: Can't use a Gfx::Painter + blit() here as it doesn't support ImageData bitmap's RGBA8888 format.
-    for (int target_y = 0; target_y < source_rect_intersected.height(); ++target_y) {
-        for (int target_x = 0; target_x < source_rect_intersected.width(); ++target_x) {
-            auto pixel = bitmap.get_pixel(target_x + x, target_y + y);
-            image_data->bitmap().set_pixel(target_x, target_y, pixel);
-        }
+    // NOTE: The canvas bitmap is BGRA8888 and the ImageData bitmap is RGBA8888, neither premultiplied, so this is a plain swap of the red and blue channels.
+    auto destination_offset = source_rect_intersected.location() - source_rect.location();
+    for (int row = 0; row < source_rect_intersected.height(); ++row) {
+        auto const* source = bitmap.scanline(source_rect_intersected.top() + row) + source_rect_intersected.left();
+        auto* destination = image_data->bitmap().scanline(destination_offset.y() + row) + destination_offset.x();
+        for (int column = 0; column < source_rect_intersected.width(); ++column)
+            destination[column] = swap_red_and_blue_channels(source[column]);
     }
 
     // 7. Set the pixels values of imageData for areas of the source rectangle that are outside of the output bitmap to transparent black.
@@ -420,12 +426,17 @@ WebIDL::ExceptionOr<JS::GCPtr<ImageData>> CanvasRenderingContext2D::get_image_da
     return image_data;
 }
 
+// https://html.spec.whatwg.org/multipage/canvas.html#dom-context-2d-putimagedata
 void CanvasRenderingContext2D::put_image_data(ImageData const& image_data, float x, float y)
 {
-    draw_clipped([&](auto& painter) {
-        painter.underlying_painter().blit(Gfx::IntPoint(x, y), image_data.bitmap(), image_data.bitmap().rect());
-        return Gfx::FloatRect(x, y, image_data.width(), image_data.height());
-    });
+    auto* painter = this->painter();
+    if (!painter)
+        return;
+
+    // NOTE: putImageData() replaces the pixels outright; it's unaffected by the clipping region, global alpha and compositing,
+    //       so copy the rows over without blending.
+    painter->blit(Gfx::IntPoint(x, y), image_data.bitmap(), image_data.bitmap().rect(), 1.0f, false);
+    did_draw(Gfx::FloatRect(x, y, image_data.width(), image_data.height()));
 }
 
 // https://html.spec.whatwg.org/multipage/canvas.html#reset-the-rendering-context-to-its-default-state
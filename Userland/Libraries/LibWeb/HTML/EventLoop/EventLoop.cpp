@@ -351,6 +351,10 @@ void EventLoop::process()
         //    perform the start an idle period algorithm for win with computeDeadline. [REQUESTIDLECALLBACK]
         for (auto& win : same_loop_windows())
             win->start_an_idle_period();
+
+        // OPTIMIZATION: There's nothing else to do right now, so this is a good time for a garbage collection that
+        //               would otherwise soon interrupt a task or a rendering update.
+        heap().collect_garbage_if_close_to_threshold();
     }
 
     // FIXME: 14. If this is a worker event loop, then:
@@ -59,6 +59,12 @@ void HTMLBodyElement::apply_presentational_hints(CSS::StyleProperties& style) co
     });
 }
 
+bool HTMLBodyElement::affects_presentational_hints_of_descendants(FlyString const& name) const
+{
+    // NOTE: The link colors end up in the computed style of the links in our subtree.
+    return name.equals_ignoring_ascii_case("link"sv) || name.equals_ignoring_ascii_case("alink"sv) || name.equals_ignoring_ascii_case("vlink"sv);
+}
+
 void HTMLBodyElement::attribute_changed(FlyString const& name, Optional<String> const& value)
 {
     HTMLElement::attribute_changed(name, value);
@@ -23,6 +23,7 @@ public:
 
     virtual void attribute_changed(FlyString const&, Optional<String> const&) override;
     virtual void apply_presentational_hints(CSS::StyleProperties&) const override;
+    virtual bool affects_presentational_hints_of_descendants(FlyString const&) const override;
 
     // https://www.w3.org/TR/html-aria/#el-body
     virtual Optional<ARIA::Role> default_role() const override { return ARIA::Role::generic; }
@@ -701,7 +701,10 @@ void HTMLImageElement::add_callbacks_to_image_request(JS::NonnullGCPtr<ImageRequ
                     dispatch_event(DOM::Event::create(realm(), HTML::EventNames::load));
 
                 set_needs_style_update(true);
-                document().set_needs_layout();
+                if (auto* layout_node = this->layout_node())
+                    layout_node->set_needs_layout();
+                else
+                    document().set_needs_layout();
 
                 if (image_data->is_animated() && image_data->frame_count() > 1) {
                     m_current_frame_index = 0;
@@ -733,6 +736,25 @@ void HTMLImageElement::add_callbacks_to_image_request(JS::NonnullGCPtr<ImageRequ
                 dispatch_event(DOM::Event::create(realm(), HTML::EventNames::error));
 
             m_load_event_delayer.clear();
+        },
+        [this, image_request]() {
+            batching_dispatcher().enqueue([this, image_request] {
+                // While the image is still being fetched, the part of it that has been decoded so far is shown in place of the current request's image.
+                if (image_request != m_current_request || image_request->state() == ImageRequest::State::CompletelyAvailable || image_request->state() == ImageRequest::State::Broken)
+                    return;
+
+                auto partial_image_data = image_request->shared_image_request()->partial_image_data();
+                if (!partial_image_data)
+                    return;
+
+                image_request->set_image_data(partial_image_data);
+                image_request->set_state(ImageRequest::State::PartiallyAvailable);
+
+                if (auto* layout_node = this->layout_node())
+                    layout_node->set_needs_layout();
+                else
+                    document().set_needs_layout();
+            });
         });
 }
 
@@ -836,7 +858,10 @@ void HTMLImageElement::react_to_changes_in_the_environment()
             image_request->prepare_for_presentation(*this);
             // FIXME: This is ad-hoc, updating the layout here should probably be handled by prepare_for_presentation().
             set_needs_style_update(true);
-            document().set_needs_layout();
+            if (auto* layout_node = this->layout_node())
+                layout_node->set_needs_layout();
+            else
+                document().set_needs_layout();
 
             // 7. Fire an event named load at the img element.
             dispatch_event(DOM::Event::create(realm(), HTML::EventNames::load));
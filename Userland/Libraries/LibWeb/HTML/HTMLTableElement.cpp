@@ -115,6 +115,12 @@ void HTMLTableElement::attribute_changed(FlyString const& name, Optional<String>
     }
 }
 
+bool HTMLTableElement::affects_presentational_hints_of_descendants(FlyString const& name) const
+{
+    // NOTE: These are read by HTMLTableCellElement::apply_presentational_hints().
+    return name == HTML::AttributeNames::cellpadding || name == HTML::AttributeNames::border;
+}
+
 // https://html.spec.whatwg.org/multipage/tables.html#dom-table-caption
 JS::GCPtr<HTMLTableCaptionElement> HTMLTableElement::caption()
 {
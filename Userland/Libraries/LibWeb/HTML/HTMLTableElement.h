@@ -60,6 +60,7 @@ private:
 
     virtual void apply_presentational_hints(CSS::StyleProperties&) const override;
     virtual void attribute_changed(FlyString const& name, Optional<String> const& value) override;
+    virtual bool affects_presentational_hints_of_descendants(FlyString const&) const override;
 
     JS::GCPtr<DOM::HTMLCollection> mutable m_rows;
     JS::GCPtr<DOM::HTMLCollection> mutable m_t_bodies;
@@ -7,6 +7,7 @@
 
 #include <AK/ByteReader.h>
 #include <AK/MemoryStream.h>
+#include <LibCore/AnonymousBuffer.h>
 #include <LibCore/Socket.h>
 #include <LibCore/System.h>
 #include <LibIPC/Decoder.h>
@@ -273,6 +274,8 @@ ErrorOr<MessagePort::ParseDecision> MessagePort::parse_message()
             return ParseDecision::NotEnoughData;
 
         m_socket_incoming_message_size = ByteReader::load32(m_buffered_data.data());
+        m_socket_incoming_message_is_large = m_socket_incoming_message_size & IPC::large_message_flag;
+        m_socket_incoming_message_size &= ~IPC::large_message_flag;
         // NOTE: We don't decrement the number of ready bytes because we want to remove the entire
         //       message + header from the buffer in one go on success
         m_socket_state = SocketState::Data;
@@ -282,7 +285,14 @@ ErrorOr<MessagePort::ParseDecision> MessagePort::parse_message()
         if (num_bytes_ready < m_socket_incoming_message_size)
             return ParseDecision::NotEnoughData;
 
-        auto payload = m_buffered_data.span().slice(HEADER_SIZE, m_socket_incoming_message_size);
+        ReadonlyBytes payload = m_buffered_data.span().slice(HEADER_SIZE, m_socket_incoming_message_size);
+
+        // NOTE: Large messages only carry a header, their data comes in an anonymous buffer.
+        Core::AnonymousBuffer large_message_data;
+        if (m_socket_incoming_message_is_large) {
+            large_message_data = TRY(IPC::receive_large_message_data(payload, m_unprocessed_fds));
+            payload = { large_message_data.data<u8>(), large_message_data.size() };
+        }
 
         FixedMemoryStream stream { payload, FixedMemoryStream::Mode::ReadOnly };
         IPC::Decoder decoder { stream, m_unprocessed_fds };
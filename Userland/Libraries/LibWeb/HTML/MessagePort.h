@@ -98,6 +98,7 @@ private:
         Error,
     } m_socket_state { SocketState::Header };
     size_t m_socket_incoming_message_size { 0 };
+    bool m_socket_incoming_message_is_large { false };
     Queue<IPC::File> m_unprocessed_fds;
     Vector<u8> m_buffered_data;
 
@@ -5,6 +5,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibCore/TraceEvent.h>
 #include <LibWeb/Crypto/Crypto.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/DocumentLoading.h>
@@ -2133,6 +2134,8 @@ void Navigable::paint(Painting::RecordingPainter& recording_painter, PaintConfig
         VERIFY_NOT_REACHED();
     }
 
+    Core::TraceEventScope trace_event("paint"sv, "Navigable::paint"sv);
+
     Web::PaintContext context(recording_painter, page.palette(), page.client().device_pixels_per_css_pixel());
     context.set_device_viewport_rect(viewport_rect);
     context.set_should_show_line_box_borders(config.should_show_line_box_borders);
@@ -9,6 +9,7 @@
 #include <AK/Debug.h>
 #include <AK/SourceLocation.h>
 #include <AK/Utf32View.h>
+#include <LibCore/TraceEvent.h>
 #include <LibTextCodec/Decoder.h>
 #include <LibWeb/Bindings/ExceptionOrUtils.h>
 #include <LibWeb/Bindings/MainThreadVM.h>
@@ -24,6 +25,7 @@
 #include <LibWeb/DOM/QualifiedName.h>
 #include <LibWeb/DOM/ShadowRoot.h>
 #include <LibWeb/DOM/Text.h>
+#include <LibWeb/Fetch/Infrastructure/HTTP/Requests.h>
 #include <LibWeb/HTML/CustomElements/CustomElementDefinition.h>
 #include <LibWeb/HTML/EventLoop/EventLoop.h>
 #include <LibWeb/HTML/EventNames.h>
@@ -40,6 +42,7 @@
 #include <LibWeb/HighResolutionTime/TimeOrigin.h>
 #include <LibWeb/Infra/CharacterTypes.h>
 #include <LibWeb/Infra/Strings.h>
+#include <LibWeb/Loader/ResourceLoader.h>
 #include <LibWeb/MathML/TagNames.h>
 #include <LibWeb/Namespace.h>
 #include <LibWeb/SVG/SVGScriptElement.h>
@@ -174,6 +177,8 @@ void HTMLParser::visit_edges(Cell::Visitor& visitor)
 
 void HTMLParser::run(HTMLTokenizer::StopAtInsertionPoint stop_at_insertion_point)
 {
+    Core::TraceEventScope trace_event("html"sv, "HTMLParser::run"sv);
+
     for (;;) {
         // FIXME: Find a better way to say that we come from Document::close() and want to process EOF.
         if (!m_tokenizer.is_eof_inserted() && m_tokenizer.is_insertion_point_reached())
@@ -214,6 +219,14 @@ void HTMLParser::run(HTMLTokenizer::StopAtInsertionPoint stop_at_insertion_point
             dbgln_if(HTML_PARSER_DEBUG, "Stop parsing{}! :^)", m_parsing_fragment ? " fragment" : "");
             break;
         }
+
+        // NOTE: Only the outermost invocation may yield. A nested one (from document.write()) must consume all of its input
+        //       before the script that wrote it continues.
+        if (m_slice_deadline.has_value() && script_nesting_level() == 0 && stop_at_insertion_point == HTMLTokenizer::StopAtInsertionPoint::No
+            && MonotonicTime::now() >= *m_slice_deadline) {
+            m_yielded_at_slice_deadline = true;
+            break;
+        }
     }
 
     flush_character_insertions();
@@ -228,6 +241,41 @@ void HTMLParser::run(const URL::URL& url, HTMLTokenizer::StopAtInsertionPoint st
     m_document->detach_parser({});
 }
 
+static constexpr auto parser_slice_duration = AK::Duration::from_milliseconds(10);
+
+void HTMLParser::run_incrementally(const URL::URL& url)
+{
+    m_document->set_url(url);
+    m_document->set_source(MUST(String::from_byte_string(m_tokenizer.source())));
+    run_next_slice();
+}
+
+void HTMLParser::run_next_slice()
+{
+    // NOTE: Whoever aborted us (e.g. document.open()) has already taken care of the document, and may even have given it
+    //       a new parser, so there is nothing left for us to do.
+    if (m_aborted)
+        return;
+
+    m_slice_deadline = MonotonicTime::now() + parser_slice_duration;
+    m_yielded_at_slice_deadline = false;
+    run();
+    m_slice_deadline.clear();
+
+    if (m_aborted)
+        return;
+
+    if (m_yielded_at_slice_deadline) {
+        queue_global_task(HTML::Task::Source::Networking, *m_document, JS::create_heap_function(m_document->heap(), [parser = JS::NonnullGCPtr { *this }] {
+            parser->run_next_slice();
+        }));
+        return;
+    }
+
+    the_end(*m_document, this);
+    m_document->detach_parser({});
+}
+
 // https://html.spec.whatwg.org/multipage/parsing.html#the-end
 void HTMLParser::the_end(JS::NonnullGCPtr<DOM::Document> document, JS::GCPtr<HTMLParser> parser)
 {
@@ -264,6 +312,11 @@ void HTMLParser::the_end(JS::NonnullGCPtr<DOM::Document> document, JS::GCPtr<HTM
 
     // FIXME: 1. If the active speculative HTML parser is not null, then stop the speculative HTML parser and return.
 
+    // NOTE: All elements have been created at this point, and have started whatever fetches they were going to make.
+    //       So any speculative preload that hasn't been picked up yet is never going to be.
+    if (parser)
+        parser->discard_speculative_preloads();
+
     // 2. Set the insertion point to undefined.
     if (parser)
         parser->m_tokenizer.undefine_insertion_point();
@@ -2929,7 +2982,10 @@ void HTMLParser::handle_text(HTMLToken& token)
                     // 2. Set the pending parsing-blocking script to null.
                     auto the_script = document().take_pending_parsing_blocking_script({});
 
-                    // FIXME: 3. Start the speculative HTML parser for this instance of the HTML parser.
+                    // 3. Start the speculative HTML parser for this instance of the HTML parser.
+                    // NOTE: We don't build speculative mock elements, but scan ahead for resources that are likely going to be
+                    //       needed and start loading them, so they don't have to wait until the script has executed.
+                    run_speculative_preload_scan();
 
                     // 4. Block the tokenizer for this instance of the HTML parser, such that the event loop will not run tasks that invoke the tokenizer.
                     m_tokenizer.set_blocked(true);
@@ -2948,7 +3004,8 @@ void HTMLParser::handle_text(HTMLToken& token)
                     if (m_aborted)
                         return;
 
-                    // FIXME: 7. Stop the speculative HTML parser for this instance of the HTML parser.
+                    // 7. Stop the speculative HTML parser for this instance of the HTML parser.
+                    // NOTE: The preload scan runs to completion when it is started, so there is nothing to stop here.
 
                     // 8. Unblock the tokenizer for this instance of the HTML parser, such that tasks that invoke the tokenizer can again be run.
                     m_tokenizer.set_blocked(false);
@@ -4912,7 +4969,8 @@ void HTMLParser::abort()
     // 1. Throw away any pending content in the input stream, and discard any future content that would have been added to it.
     m_tokenizer.abort();
 
-    // FIXME: 2. Stop the speculative HTML parser for this HTML parser.
+    // 2. Stop the speculative HTML parser for this HTML parser.
+    discard_speculative_preloads();
 
     // 3. Update the current document readiness to "interactive".
     m_document->update_readiness(DocumentReadyState::Interactive);
@@ -4927,6 +4985,104 @@ void HTMLParser::abort()
     m_aborted = true;
 }
 
+// https://html.spec.whatwg.org/multipage/parsing.html#speculative-html-parsing
+void HTMLParser::run_speculative_preload_scan()
+{
+    if (m_parsing_fragment || !m_document->browsing_context())
+        return;
+
+    // NOTE: Without document.write() the input after the insertion point doesn't change, so everything we could find
+    //       has already been found by a previous scan.
+    if (m_input_length_at_last_speculative_scan == m_tokenizer.input_length())
+        return;
+    m_input_length_at_last_speculative_scan = m_tokenizer.input_length();
+
+    auto preload = [&](HTMLToken const& token, FlyString const& url_attribute) {
+        // NOTE: The element is going to be fetched in "no-cors" mode with credentials and no integrity metadata unless
+        //       one of these attributes says otherwise. Rather than working out what it would be fetched with instead,
+        //       we leave such elements alone, as a preload made differently would never be taken over anyway.
+        if (token.has_attribute(HTML::AttributeNames::crossorigin)
+            || token.has_attribute(HTML::AttributeNames::integrity)
+            || token.has_attribute(HTML::AttributeNames::referrerpolicy))
+            return;
+
+        auto value = token.attribute(url_attribute);
+        if (!value.has_value() || value->is_empty())
+            return;
+        auto url = m_document->parse_url(*value);
+        if (!url.is_valid() || m_speculative_preload_urls.contains_slow(url))
+            return;
+        auto request = LoadRequest::create_for_url_on_page(url, &m_document->page());
+        request.set_fetch_parameters({
+            .mode = Fetch::Infrastructure::request_mode_to_string(Fetch::Infrastructure::Request::Mode::NoCORS),
+            .credentials_mode = Fetch::Infrastructure::request_credentials_mode_to_string(Fetch::Infrastructure::Request::CredentialsMode::Include),
+            .integrity_metadata = {},
+        });
+        ResourceLoader::the().preload_speculatively(request);
+        m_speculative_preload_urls.append(move(url));
+    };
+
+    HTMLTokenizer tokenizer { m_tokenizer.unconsumed_input(), "utf-8"sv };
+    size_t template_depth = 0;
+
+    for (;;) {
+        auto token = tokenizer.next_token();
+        if (!token.has_value() || token->is_end_of_file())
+            break;
+
+        if (token->is_end_tag() && token->tag_name() == HTML::TagNames::template_ && template_depth > 0)
+            --template_depth;
+        if (!token->is_start_tag())
+            continue;
+
+        auto const& tag_name = token->tag_name();
+
+        // NOTE: Without a tree builder, the tokenizer has to be told about elements whose contents aren't markup, or we
+        //       would go looking for resources inside scripts and style sheets.
+        if (tag_name == HTML::TagNames::script) {
+            tokenizer.switch_to(HTMLTokenizer::State::ScriptData);
+        } else if (tag_name.is_one_of(HTML::TagNames::style, HTML::TagNames::xmp, HTML::TagNames::iframe, HTML::TagNames::noembed, HTML::TagNames::noframes)
+            || (tag_name == HTML::TagNames::noscript && m_scripting_enabled)) {
+            tokenizer.switch_to(HTMLTokenizer::State::RAWTEXT);
+        } else if (tag_name.is_one_of(HTML::TagNames::title, HTML::TagNames::textarea)) {
+            tokenizer.switch_to(HTMLTokenizer::State::RCDATA);
+        } else if (tag_name == HTML::TagNames::plaintext) {
+            break;
+        } else if (tag_name == HTML::TagNames::template_) {
+            ++template_depth;
+        }
+
+        // NOTE: Template contents are inert, nothing in there is going to be fetched.
+        if (template_depth > 0)
+            continue;
+
+        if (tag_name == HTML::TagNames::script) {
+            // NOTE: Module scripts are always fetched in "cors" mode.
+            auto type = token->attribute(HTML::AttributeNames::type);
+            bool is_module = type.has_value() && type->bytes_as_string_view().trim(Infra::ASCII_WHITESPACE).equals_ignoring_ascii_case("module"sv);
+            if (!is_module && !token->attribute(HTML::AttributeNames::nomodule).has_value())
+                preload(*token, HTML::AttributeNames::src);
+        } else if (tag_name == HTML::TagNames::link) {
+            auto rel = MUST(Infra::to_ascii_lowercase(token->attribute(HTML::AttributeNames::rel).value_or(String {})));
+            auto keywords = rel.bytes_as_string_view().split_view_if(Infra::is_ascii_whitespace);
+            if (keywords.contains_slow("stylesheet"sv) && !keywords.contains_slow("alternate"sv))
+                preload(*token, HTML::AttributeNames::href);
+        } else if (tag_name == HTML::TagNames::img) {
+            // FIXME: Pick a candidate from srcset.
+            auto loading = token->attribute(HTML::AttributeNames::loading);
+            if (!loading.has_value() || !loading->equals_ignoring_ascii_case("lazy"sv))
+                preload(*token, HTML::AttributeNames::src);
+        }
+    }
+}
+
+void HTMLParser::discard_speculative_preloads()
+{
+    for (auto const& url : m_speculative_preload_urls)
+        ResourceLoader::the().discard_speculative_preload(url);
+    m_speculative_preload_urls.clear();
+}
+
 // https://html.spec.whatwg.org/multipage/parsing.html#insert-an-element-at-the-adjusted-insertion-location
 void HTMLParser::insert_an_element_at_the_adjusted_insertion_location(JS::NonnullGCPtr<DOM::Element> element)
 {
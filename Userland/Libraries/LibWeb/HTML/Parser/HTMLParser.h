@@ -56,6 +56,10 @@ public:
     void run(HTMLTokenizer::StopAtInsertionPoint = HTMLTokenizer::StopAtInsertionPoint::No);
     void run(const URL::URL&, HTMLTokenizer::StopAtInsertionPoint = HTMLTokenizer::StopAtInsertionPoint::No);
 
+    // Like run(), but returns to the event loop every few milliseconds and continues in a new task, so that the page
+    // stays responsive while a large document is parsed.
+    void run_incrementally(const URL::URL&);
+
     static void the_end(JS::NonnullGCPtr<DOM::Document>, JS::GCPtr<HTMLParser> = nullptr);
 
     DOM::Document& document();
@@ -161,6 +165,11 @@ private:
     void decrement_script_nesting_level();
     void reset_the_insertion_mode_appropriately();
 
+    void run_next_slice();
+
+    void run_speculative_preload_scan();
+    void discard_speculative_preloads();
+
     void adjust_mathml_attributes(HTMLToken&);
     void adjust_svg_tag_names(HTMLToken&);
     void adjust_svg_attributes(HTMLToken&);
@@ -200,6 +209,9 @@ private:
     bool m_stop_parsing { false };
     size_t m_script_nesting_level { 0 };
 
+    Optional<MonotonicTime> m_slice_deadline;
+    bool m_yielded_at_slice_deadline { false };
+
     JS::Realm& realm();
 
     JS::GCPtr<DOM::Document> m_document;
@@ -209,6 +221,10 @@ private:
 
     Vector<HTMLToken> m_pending_table_character_tokens;
 
+    // URLs preloaded by the speculative scan that nothing has asked for yet.
+    Vector<URL::URL> m_speculative_preload_urls;
+    Optional<size_t> m_input_length_at_last_speculative_scan;
+
     JS::GCPtr<DOM::Text> m_character_insertion_node;
     StringBuilder m_character_insertion_builder;
 };
@@ -248,6 +248,51 @@ Optional<u32> HTMLTokenizer::peek_code_point(size_t offset) const
     return *it;
 }
 
+// Appends the code points up to the next one of stop_characters (or U+000D CR, which needs newline normalization) to the
+// current builder in one go, instead of running each of them through the state machine.
+// NOTE: All stop characters are ASCII, which never appears inside a multi-byte UTF-8 sequence, so we can scan bytes.
+template<char... stop_characters>
+void HTMLTokenizer::append_code_points_up_to_one_of()
+{
+    auto const* bytes = m_utf8_view.bytes();
+    auto start = m_utf8_view.byte_offset_of(m_utf8_iterator);
+    auto end = m_utf8_view.byte_length();
+    if (m_insertion_point.defined) {
+        if (m_insertion_point.position <= start)
+            return;
+        end = min(end, m_insertion_point.position);
+    }
+
+    auto position = m_source_positions.is_empty() ? HTMLToken::Position {} : m_source_positions.last();
+    auto offset = start;
+    auto last_code_point_offset = start;
+    for (; offset < end; ++offset) {
+        auto byte = bytes[offset];
+        if (byte == '\r' || ((byte == stop_characters) || ...))
+            break;
+        if ((byte & 0xC0) == 0x80)
+            continue;
+        last_code_point_offset = offset;
+        if (byte == '\n') {
+            position.column = 0;
+            position.line++;
+        } else {
+            position.column++;
+        }
+    }
+
+    if (offset == start)
+        return;
+
+    m_current_builder.append(m_utf8_view.as_string().substring_view(start, offset - start));
+    if (!m_source_positions.is_empty()) {
+        position.byte_offset += offset - start;
+        m_source_positions.append(position);
+    }
+    m_prev_utf8_iterator = m_utf8_view.iterator_at_byte_offset_without_validation(last_code_point_offset);
+    m_utf8_iterator = m_utf8_view.iterator_at_byte_offset_without_validation(offset);
+}
+
 HTMLToken::Position HTMLTokenizer::nth_last_position(size_t n)
 {
     if (n + 1 > m_source_positions.size()) {
@@ -1272,6 +1317,7 @@ _StartOfFunction:
                 ANYTHING_ELSE
                 {
                     m_current_builder.append_code_point(current_input_character.value());
+                    append_code_points_up_to_one_of<'"', '&', '\0'>();
                     continue;
                 }
             }
@@ -1304,6 +1350,7 @@ _StartOfFunction:
                 ANYTHING_ELSE
                 {
                     m_current_builder.append_code_point(current_input_character.value());
+                    append_code_points_up_to_one_of<'\'', '&', '\0'>();
                     continue;
                 }
             }
@@ -1474,6 +1521,7 @@ _StartOfFunction:
                 ANYTHING_ELSE
                 {
                     m_current_builder.append_code_point(current_input_character.value());
+                    append_code_points_up_to_one_of<'<', '-', '\0'>();
                     continue;
                 }
             }
@@ -129,6 +129,8 @@ public:
     bool is_blocked() const { return m_blocked; }
 
     ByteString source() const { return m_decoded_input; }
+    size_t input_length() const { return m_decoded_input.length(); }
+    StringView unconsumed_input() const { return m_decoded_input.substring_view(m_utf8_view.byte_offset_of(m_utf8_iterator)); }
 
     void insert_input_at_insertion_point(StringView input);
     void insert_eof();
@@ -155,6 +157,8 @@ private:
     void skip(size_t count);
     Optional<u32> next_code_point();
     Optional<u32> peek_code_point(size_t offset) const;
+    template<char... stop_characters>
+    void append_code_points_up_to_one_of();
     bool consume_next_if_match(StringView, CaseSensitivity = CaseSensitivity::CaseSensitive);
     void create_new_token(HTMLToken::Type);
     bool current_end_tag_token_is_appropriate() const;
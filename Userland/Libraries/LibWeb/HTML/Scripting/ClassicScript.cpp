@@ -6,8 +6,11 @@
 
 #include <AK/Debug.h>
 #include <LibCore/ElapsedTimer.h>
+#include <LibCore/TraceEvent.h>
+#include <LibJS/AST.h>
 #include <LibJS/Bytecode/Interpreter.h>
 #include <LibWeb/Bindings/ExceptionOrUtils.h>
+#include <LibWeb/Bindings/MainThreadVM.h>
 #include <LibWeb/HTML/Scripting/ClassicScript.h>
 #include <LibWeb/HTML/Scripting/Environments.h>
 #include <LibWeb/HTML/Scripting/ExceptionReporter.h>
@@ -17,6 +20,38 @@ namespace Web::HTML {
 
 JS_DEFINE_ALLOCATOR(ClassicScript);
 
+static constexpr size_t max_number_of_recently_parsed_scripts = 16;
+
+// OPTIMIZATION: Sites load the same scripts again on every navigation, and often in several of their iframes as well.
+//               As all of these share one VM, a script with the same source text, filename and starting line as a recently
+//               parsed one can simply share its program. That also shares the bytecode of all of its functions, which is
+//               kept on their AST nodes once they have been called for the first time.
+static RefPtr<JS::Program> take_recently_parsed_program(JS::VM& vm, ByteString const& filename, StringView source, size_t source_line_number)
+{
+    auto& recently_parsed_scripts = verify_cast<Bindings::WebEngineCustomData>(*vm.custom_data()).recently_parsed_classic_scripts;
+    for (size_t i = 0; i < recently_parsed_scripts.size(); ++i) {
+        auto const& recently_parsed_script = recently_parsed_scripts[i];
+        auto const& source_code = recently_parsed_script.program->source_code();
+        if (recently_parsed_script.source_line_number == source_line_number && source_code.code() == source && source_code.filename() == filename.view())
+            return recently_parsed_scripts.take(i).program;
+    }
+    return nullptr;
+}
+
+static void remember_recently_parsed_program(JS::VM& vm, NonnullRefPtr<JS::Program> program, size_t source_line_number)
+{
+    // NOTE: Global declaration instantiation decides whether functions hoisted under Annex B also get a var binding,
+    //       depending on what is already declared in the global environment, and remembers that on the AST itself.
+    //       Since that may come out differently in another realm, we don't share programs that contain any of them.
+    if (!program->is_strict_mode() && program->has_functions_hoistable_with_annexB_extension())
+        return;
+
+    auto& recently_parsed_scripts = verify_cast<Bindings::WebEngineCustomData>(*vm.custom_data()).recently_parsed_classic_scripts;
+    if (recently_parsed_scripts.size() == max_number_of_recently_parsed_scripts)
+        recently_parsed_scripts.take_last();
+    recently_parsed_scripts.prepend({ move(program), source_line_number });
+}
+
 // https://html.spec.whatwg.org/multipage/webappapis.html#creating-a-classic-script
 JS::NonnullGCPtr<ClassicScript> ClassicScript::create(ByteString filename, StringView source, EnvironmentSettingsObject& environment_settings_object, URL::URL base_url, size_t source_line_number, MutedErrors muted_errors)
 {
@@ -49,6 +84,13 @@ JS::NonnullGCPtr<ClassicScript> ClassicScript::create(ByteString filename, Strin
     script->set_error_to_rethrow(JS::js_null());
 
     // 10. Let result be ParseScript(source, settings's Realm, script).
+    if (auto program = take_recently_parsed_program(vm, script->filename(), source, source_line_number)) {
+        dbgln_if(HTML_SCRIPT_DEBUG, "ClassicScript: Reusing the program of a recently parsed {}", script->filename());
+        script->m_script_record = JS::Script::create(environment_settings_object.realm(), script->filename(), *program, script);
+        remember_recently_parsed_program(vm, program.release_nonnull(), source_line_number);
+        return script;
+    }
+
     auto parse_timer = Core::ElapsedTimer::start_new();
     auto result = JS::Script::parse(source, environment_settings_object.realm(), script->filename(), script, source_line_number);
     dbgln_if(HTML_SCRIPT_DEBUG, "ClassicScript: Parsed {} in {}ms", script->filename(), parse_timer.elapsed());
@@ -68,6 +110,7 @@ JS::NonnullGCPtr<ClassicScript> ClassicScript::create(ByteString filename, Strin
 
     // 12. Set script's record to result.
     script->m_script_record = *result.release_value();
+    remember_recently_parsed_program(vm, script->m_script_record->parse_node(), source_line_number);
 
     // 13. Return script.
     return script;
@@ -94,6 +137,7 @@ JS::Completion ClassicScript::run(RethrowErrors rethrow_errors, JS::GCPtr<JS::En
         evaluation_status = JS::Completion { JS::Completion::Type::Throw, error_to_rethrow() };
     } else {
         auto timer = Core::ElapsedTimer::start_new();
+        Core::TraceEventScope trace_event("js"sv, "ClassicScript::run"sv);
 
         // 6. Otherwise, set evaluationStatus to ScriptEvaluation(script's record).
         evaluation_status = vm().bytecode_interpreter().run(*m_script_record, lexical_environment_override);
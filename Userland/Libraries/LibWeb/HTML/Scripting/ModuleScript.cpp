@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibCore/TraceEvent.h>
 #include <LibJS/Runtime/ModuleRequest.h>
 #include <LibWeb/HTML/Scripting/Environments.h>
 #include <LibWeb/HTML/Scripting/Fetching.h>
@@ -154,6 +155,7 @@ JS::Promise* JavaScriptModuleScript::run(PreventErrorReporting)
         vm().push_execution_context(*module_execution_context);
 
         // 2. Set evaluationPromise to record.Evaluate().
+        Core::TraceEventScope trace_event("js"sv, "JavaScriptModuleScript::run"sv);
         auto elevation_promise_or_error = record->evaluate(vm());
 
         // NOTE: This step will recursively evaluate all of the module's dependencies.
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AnyOf.h>
 #include <AK/HashTable.h>
 #include <LibGfx/Bitmap.h>
 #include <LibWeb/Fetch/Fetching/Fetching.h>
@@ -58,8 +59,10 @@ void SharedImageRequest::visit_edges(JS::Cell::Visitor& visitor)
     for (auto& callback : m_callbacks) {
         visitor.visit(callback.on_finish);
         visitor.visit(callback.on_fail);
+        visitor.visit(callback.on_progress);
     }
     visitor.visit(m_image_data);
+    visitor.visit(m_partial_image_data);
 }
 
 JS::GCPtr<DecodedImageData> SharedImageRequest::image_data() const
@@ -79,25 +82,35 @@ void SharedImageRequest::set_fetch_controller(JS::GCPtr<Fetch::Infrastructure::F
 
 void SharedImageRequest::fetch_image(JS::Realm& realm, JS::NonnullGCPtr<Fetch::Infrastructure::Request> request)
 {
+    // Network responses are read as they arrive, so that the image can be shown while it is still loading.
+    if (request->url().scheme().is_one_of("http"sv, "https"sv))
+        request->set_buffer_policy(Fetch::Infrastructure::Request::BufferPolicy::DoNotBufferResponse);
+
     Fetch::Infrastructure::FetchAlgorithms::Input fetch_algorithms_input {};
     fetch_algorithms_input.process_response = [this, &realm, request](JS::NonnullGCPtr<Fetch::Infrastructure::Response> response) {
         // FIXME: If the response is CORS cross-origin, we must use its internal response to query any of its data. See:
         //        https://github.com/whatwg/html/issues/9355
         response = response->unsafe_response();
 
-        auto process_body = JS::create_heap_function(heap(), [this, request, response](ByteBuffer data) {
-            auto extracted_mime_type = response->header_list()->extract_mime_type();
-            auto mime_type = extracted_mime_type.has_value() ? extracted_mime_type.value().essence().bytes_as_string_view() : StringView {};
-            handle_successful_fetch(request->url(), mime_type, move(data));
+        if (!response->body()) {
+            handle_failed_fetch();
+            return;
+        }
+
+        auto extracted_mime_type = response->header_list()->extract_mime_type();
+        auto mime_type = extracted_mime_type.has_value() ? extracted_mime_type.value().essence() : String {};
+
+        auto process_body_chunk = JS::create_heap_function(heap(), [this, request, mime_type](ByteBuffer chunk) {
+            handle_received_data(request->url(), mime_type, move(chunk));
+        });
+        auto process_end_of_body = JS::create_heap_function(heap(), [this, request, mime_type]() {
+            handle_successful_fetch(request->url(), mime_type, move(m_received_data));
         });
         auto process_body_error = JS::create_heap_function(heap(), [this](JS::Value) {
             handle_failed_fetch();
         });
 
-        if (response->body())
-            response->body()->fully_read(realm, process_body, process_body_error, JS::NonnullGCPtr { realm.global_object() });
-        else
-            handle_failed_fetch();
+        response->body()->incrementally_read(process_body_chunk, process_end_of_body, process_body_error, JS::NonnullGCPtr { realm.global_object() });
     };
 
     m_state = State::Fetching;
@@ -111,7 +124,7 @@ void SharedImageRequest::fetch_image(JS::Realm& realm, JS::NonnullGCPtr<Fetch::I
     set_fetch_controller(fetch_controller);
 }
 
-void SharedImageRequest::add_callbacks(Function<void()> on_finish, Function<void()> on_fail)
+void SharedImageRequest::add_callbacks(Function<void()> on_finish, Function<void()> on_fail, Function<void()> on_progress)
 {
     if (m_state == State::Finished) {
         if (on_finish)
@@ -130,19 +143,77 @@ void SharedImageRequest::add_callbacks(Function<void()> on_finish, Function<void
         callbacks.on_finish = JS::create_heap_function(vm().heap(), move(on_finish));
     if (on_fail)
         callbacks.on_fail = JS::create_heap_function(vm().heap(), move(on_fail));
+    if (on_progress)
+        callbacks.on_progress = JS::create_heap_function(vm().heap(), move(on_progress));
 
     m_callbacks.append(move(callbacks));
 }
 
+static bool is_svg_image(URL::URL const& url, StringView mime_type)
+{
+    return mime_type == "image/svg+xml"sv || url.basename().ends_with(".svg"sv);
+}
+
+// Smaller prefixes than this rarely contain anything worth showing.
+static constexpr size_t minimum_size_for_partial_decode = 8 * KiB;
+
+void SharedImageRequest::handle_received_data(URL::URL const& url, StringView mime_type, ByteBuffer chunk)
+{
+    if (m_received_data.is_empty())
+        m_received_data = move(chunk);
+    else
+        m_received_data.append(chunk.bytes());
+
+    // SVG images can only be shown once they have been parsed completely.
+    if (m_is_decoding_partial_image || is_svg_image(url, mime_type))
+        return;
+
+    if (m_received_data.size() < max(minimum_size_for_partial_decode, m_received_data_size_at_last_partial_decode * 2))
+        return;
+
+    // Nobody would see the partial image.
+    if (!any_of(m_callbacks, [](auto const& callbacks) { return callbacks.on_progress != nullptr; }))
+        return;
+
+    m_is_decoding_partial_image = true;
+    m_received_data_size_at_last_partial_decode = m_received_data.size();
+
+    auto handle_successful_partial_decode = [strong_this = JS::Handle(*this)](Web::Platform::DecodedImage& result) -> ErrorOr<void> {
+        strong_this->m_is_decoding_partial_image = false;
+
+        // The complete image may have been decoded in the meantime.
+        if (strong_this->m_state != State::Fetching || strong_this->m_image_data)
+            return {};
+
+        Vector<AnimatedBitmapDecodedImageData::Frame> frames;
+        frames.append(AnimatedBitmapDecodedImageData::Frame {
+            .bitmap = Gfx::ImmutableBitmap::create(*result.frames.first().bitmap),
+            .duration = 0,
+        });
+        strong_this->m_partial_image_data = TRY(AnimatedBitmapDecodedImageData::create(strong_this->m_document->realm(), move(frames), 0, false));
+
+        for (auto& callback : strong_this->m_callbacks) {
+            if (callback.on_progress)
+                callback.on_progress->function()();
+        }
+        return {};
+    };
+
+    auto handle_failed_partial_decode = [strong_this = JS::Handle(*this)](Error&) {
+        strong_this->m_is_decoding_partial_image = false;
+    };
+
+    (void)Web::Platform::ImageCodecPlugin::the().decode_partial_image(m_received_data.bytes(), move(handle_successful_partial_decode), move(handle_failed_partial_decode));
+}
+
 void SharedImageRequest::handle_successful_fetch(URL::URL const& url_string, StringView mime_type, ByteBuffer data)
 {
     // AD-HOC: At this point, things gets very ad-hoc.
     // FIXME: Bring this closer to spec.
 
-    bool const is_svg_image = mime_type == "image/svg+xml"sv || url_string.basename().ends_with(".svg"sv);
-
     auto handle_failed_decode = [strong_this = JS::Handle(*this)](Error&) -> void {
         strong_this->m_state = State::Failed;
+        strong_this->m_partial_image_data = nullptr;
         for (auto& callback : strong_this->m_callbacks) {
             if (callback.on_fail)
                 callback.on_fail->function()();
@@ -151,6 +222,7 @@ void SharedImageRequest::handle_successful_fetch(URL::URL const& url_string, Str
 
     auto handle_successful_decode = [](SharedImageRequest& self) {
         self.m_state = State::Finished;
+        self.m_partial_image_data = nullptr;
         for (auto& callback : self.m_callbacks) {
             if (callback.on_finish)
                 callback.on_finish->function()();
@@ -158,7 +230,7 @@ void SharedImageRequest::handle_successful_fetch(URL::URL const& url_string, Str
         self.m_callbacks.clear();
     };
 
-    if (is_svg_image) {
+    if (is_svg_image(url_string, mime_type)) {
         auto result = SVG::SVGDecodedImageData::create(m_document->realm(), m_page, url_string, data);
         if (result.is_error()) {
             handle_failed_decode(result.error());
@@ -188,6 +260,8 @@ void SharedImageRequest::handle_successful_fetch(URL::URL const& url_string, Str
 void SharedImageRequest::handle_failed_fetch()
 {
     m_state = State::Failed;
+    m_received_data.clear();
+    m_partial_image_data = nullptr;
     for (auto& callback : m_callbacks) {
         if (callback.on_fail)
             callback.on_fail->function()();
@@ -30,12 +30,15 @@ public:
 
     [[nodiscard]] JS::GCPtr<DecodedImageData> image_data() const;
 
+    // The part of the image that could be decoded from the data received so far, while it is still being fetched.
+    [[nodiscard]] JS::GCPtr<DecodedImageData> partial_image_data() const { return m_partial_image_data; }
+
     [[nodiscard]] JS::GCPtr<Fetch::Infrastructure::FetchController> fetch_controller();
     void set_fetch_controller(JS::GCPtr<Fetch::Infrastructure::FetchController>);
 
     void fetch_image(JS::Realm&, JS::NonnullGCPtr<Fetch::Infrastructure::Request>);
 
-    void add_callbacks(Function<void()> on_finish, Function<void()> on_fail);
+    void add_callbacks(Function<void()> on_finish, Function<void()> on_fail, Function<void()> on_progress = {});
 
     bool is_fetching() const;
     bool needs_fetching() const;
@@ -46,6 +49,7 @@ private:
     virtual void finalize() override;
     virtual void visit_edges(JS::Cell::Visitor&) override;
 
+    void handle_received_data(URL::URL const&, StringView mime_type, ByteBuffer chunk);
     void handle_successful_fetch(URL::URL const&, StringView mime_type, ByteBuffer data);
     void handle_failed_fetch();
 
@@ -63,11 +67,19 @@ private:
     struct Callbacks {
         JS::GCPtr<JS::HeapFunction<void()>> on_finish;
         JS::GCPtr<JS::HeapFunction<void()>> on_fail;
+        JS::GCPtr<JS::HeapFunction<void()>> on_progress;
     };
     Vector<Callbacks> m_callbacks;
 
     URL::URL m_url;
     JS::GCPtr<DecodedImageData> m_image_data;
+
+    // The data received so far is decoded again each time it has doubled in size, so that the total amount of work stays
+    // proportional to the size of the image.
+    ByteBuffer m_received_data;
+    size_t m_received_data_size_at_last_partial_decode { 0 };
+    bool m_is_decoding_partial_image { false };
+    JS::GCPtr<DecodedImageData> m_partial_image_data;
     JS::GCPtr<Fetch::Infrastructure::FetchController> m_fetch_controller;
 
     JS::GCPtr<DOM::Document> m_document;
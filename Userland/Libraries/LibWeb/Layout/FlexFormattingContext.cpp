@@ -1094,6 +1094,15 @@ void FlexFormattingContext::determine_hypothetical_cross_size_of_item(FlexItem&
     }
 
     // For indefinite cross sizes, we perform a throwaway layout and then measure it.
+    // NOTE: The result only depends on the item's contents and its main size, so it's cached along with the intrinsic sizes.
+    //       Without this, nested flex containers repeat the same measuring layouts once per level of nesting.
+    auto& cache = *m_state.m_root.intrinsic_sizes.ensure(item.box.ptr(), [] { return adopt_own(*new LayoutState::IntrinsicSizes); });
+    auto& cross_size_cache = is_row_layout() ? cache.flex_item_content_height_for_width : cache.flex_item_content_width_for_height;
+    if (auto cached_cross_size = cross_size_cache.get(item.main_size.value()); cached_cross_size.has_value()) {
+        item.hypothetical_cross_size = css_clamp(cached_cross_size.value(), clamp_min, clamp_max);
+        return;
+    }
+
     LayoutState throwaway_state(&m_state);
 
     auto& box_state = throwaway_state.get_mutable(item.box);
@@ -1115,6 +1124,7 @@ void FlexFormattingContext::determine_hypothetical_cross_size_of_item(FlexItem&
 
     auto automatic_cross_size = is_row_layout() ? independent_formatting_context->automatic_content_height()
                                                 : independent_formatting_context->automatic_content_width();
+    cross_size_cache.set(item.main_size.value(), automatic_cross_size);
 
     item.hypothetical_cross_size = css_clamp(automatic_cross_size, clamp_min, clamp_max);
 }
@@ -186,6 +186,10 @@ struct LayoutState {
 
         HashMap<CSSPixels, Optional<CSSPixels>> min_content_height;
         HashMap<CSSPixels, Optional<CSSPixels>> max_content_height;
+
+        // Results of the measuring layout for a flex item with an indefinite cross size, keyed by its main size.
+        HashMap<CSSPixels, CSSPixels> flex_item_content_height_for_width;
+        HashMap<CSSPixels, CSSPixels> flex_item_content_width_for_height;
     };
 
     HashMap<JS::GCPtr<NodeWithStyle const>, NonnullOwnPtr<IntrinsicSizes>> mutable intrinsic_sizes;
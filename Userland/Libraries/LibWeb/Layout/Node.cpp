@@ -231,6 +231,20 @@ Viewport& Node::root()
     return *document().layout_node();
 }
 
+void Node::set_needs_layout()
+{
+    // NOTE: The intrinsic sizes of a box only depend on the box and its contents, so a change here
+    //       can only affect the cached intrinsic sizes of this node and its ancestors.
+    if (auto* viewport = document().layout_node()) {
+        auto& cached_intrinsic_sizes = viewport->cached_intrinsic_sizes();
+        for (auto* node = this; node; node = node->parent()) {
+            if (is<NodeWithStyle>(*node))
+                cached_intrinsic_sizes.remove(static_cast<NodeWithStyle const*>(node));
+        }
+    }
+    document().set_needs_layout({});
+}
+
 bool Node::is_floating() const
 {
     if (!has_style())
@@ -81,6 +81,9 @@ public:
     Viewport const& root() const;
     Viewport& root();
 
+    // Requests a layout because something about this node changed, keeping the cached results of unaffected boxes.
+    void set_needs_layout();
+
     bool is_root_element() const;
 
     String debug_description() const;
@@ -22,6 +22,13 @@ Viewport::Viewport(DOM::Document& document, NonnullRefPtr<CSS::StyleProperties>
 
 Viewport::~Viewport() = default;
 
+void Viewport::visit_edges(Cell::Visitor& visitor)
+{
+    Base::visit_edges(visitor);
+    for (auto& it : m_cached_intrinsic_sizes)
+        visitor.visit(it.key);
+}
+
 JS::GCPtr<Painting::Paintable> Viewport::create_paintable() const
 {
     return Painting::ViewportPaintable::create(*this);
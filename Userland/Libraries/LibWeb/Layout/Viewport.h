@@ -8,6 +8,7 @@
 
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/Layout/BlockContainer.h>
+#include <LibWeb/Layout/LayoutState.h>
 
 namespace Web::Layout {
 
@@ -21,8 +22,16 @@ public:
 
     const DOM::Document& dom_node() const { return static_cast<const DOM::Document&>(*Node::dom_node()); }
 
+    // Intrinsic sizes from previous layouts that are still valid. They are handed to the root LayoutState of the next
+    // layout, and taken back once it's done. See Node::set_needs_layout() for how they're invalidated.
+    using IntrinsicSizesCache = HashMap<JS::GCPtr<NodeWithStyle const>, NonnullOwnPtr<LayoutState::IntrinsicSizes>>;
+    IntrinsicSizesCache& cached_intrinsic_sizes() { return m_cached_intrinsic_sizes; }
+
 private:
     virtual JS::GCPtr<Painting::Paintable> create_paintable() const override;
+    virtual void visit_edges(Cell::Visitor&) override;
+
+    IntrinsicSizesCache m_cached_intrinsic_sizes;
 
     virtual bool is_viewport() const override { return true; }
 };
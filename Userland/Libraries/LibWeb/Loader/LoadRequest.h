@@ -8,8 +8,11 @@
 
 #include <AK/ByteBuffer.h>
 #include <AK/HashMap.h>
+#include <AK/Optional.h>
+#include <AK/String.h>
 #include <AK/Time.h>
 #include <LibCore/ElapsedTimer.h>
+#include <LibHTTP/RequestPriority.h>
 #include <LibURL/URL.h>
 #include <LibWeb/Forward.h>
 #include <LibWeb/Page/Page.h>
@@ -40,6 +43,21 @@ public:
     ByteBuffer const& body() const { return m_body; }
     void set_body(ByteBuffer body) { m_body = move(body); }
 
+    HTTP::RequestPriority priority() const { return m_priority; }
+    void set_priority(HTTP::RequestPriority priority) { m_priority = priority; }
+
+    // The parts of a Fetch request that decide how it's sent and how its response may be used, besides the URL and
+    // method. A speculative preload is only handed over to a load with the same ones.
+    struct FetchParameters {
+        StringView mode;
+        StringView credentials_mode;
+        String integrity_metadata;
+
+        bool operator==(FetchParameters const&) const = default;
+    };
+    Optional<FetchParameters> const& fetch_parameters() const { return m_fetch_parameters; }
+    void set_fetch_parameters(FetchParameters fetch_parameters) { m_fetch_parameters = move(fetch_parameters); }
+
     void start_timer() { m_load_timer.start(); }
     Duration load_time() const { return m_load_timer.elapsed_time(); }
 
@@ -79,7 +97,9 @@ private:
     ByteString m_method { "GET" };
     HashMap<ByteString, ByteString, CaseInsensitiveStringTraits> m_headers;
     ByteBuffer m_body;
-    Core::ElapsedTimer m_load_timer;
+    HTTP::RequestPriority m_priority { HTTP::RequestPriority::Normal };
+    Optional<FetchParameters> m_fetch_parameters;
+    Core::ElapsedTimer m_load_timer { Core::TimerType::Precise };
     JS::Handle<Page> m_page;
     bool m_main_resource { false };
 };
@@ -11,6 +11,7 @@
 #include <LibCore/ElapsedTimer.h>
 #include <LibCore/MimeData.h>
 #include <LibCore/Resource.h>
+#include <LibCore/TraceEvent.h>
 #include <LibWeb/Cookie/Cookie.h>
 #include <LibWeb/Cookie/ParsedCookie.h>
 #include <LibWeb/Fetch/Infrastructure/URL.h>
@@ -182,12 +183,22 @@ static void log_request_start(LoadRequest const& request)
     dbgln_if(SPAM_DEBUG, "ResourceLoader: Starting load of: \"{}\"", url_for_logging);
 }
 
+static void trace_load(LoadRequest const& request, StringView name, StringView url_for_logging)
+{
+    if (!Core::TraceEvent::is_enabled())
+        return;
+
+    auto end = MonotonicTime::now();
+    Core::TraceEvent::record_async("network"sv, name, request.id(), end - request.load_time(), end, url_for_logging);
+}
+
 static void log_success(LoadRequest const& request)
 {
     auto url_for_logging = sanitized_url_for_logging(request.url());
     auto load_time_ms = request.load_time().to_milliseconds();
 
     emit_signpost(ByteString::formatted("Finished load: {}", url_for_logging), request.id());
+    trace_load(request, "ResourceLoader::load"sv, url_for_logging);
     dbgln_if(SPAM_DEBUG, "ResourceLoader: Finished load of: \"{}\", Duration: {}ms", url_for_logging, load_time_ms);
 }
 
@@ -198,6 +209,7 @@ static void log_failure(LoadRequest const& request, ErrorType const& error)
     auto load_time_ms = request.load_time().to_milliseconds();
 
     emit_signpost(ByteString::formatted("Failed load: {}", url_for_logging), request.id());
+    trace_load(request, "ResourceLoader::load (failed)"sv, url_for_logging);
     dbgln("ResourceLoader: Failed load of: \"{}\", \033[31;1mError: {}\033[0m, Duration: {}ms", url_for_logging, error, load_time_ms);
 }
 
@@ -403,6 +415,23 @@ void ResourceLoader::load(LoadRequest& request, SuccessCallback success_callback
     }
 
     if (url.scheme() == "http" || url.scheme() == "https" || url.scheme() == "gemini") {
+        if (auto preload = take_speculative_preload(request)) {
+            dbgln_if(SPAM_DEBUG, "ResourceLoader: Taking over speculative preload for {}", url);
+            preload->on_settled = [this, &preload = *preload, request, success_callback = move(success_callback), error_callback = move(error_callback)]() mutable {
+                // NOTE: A failed preload is simply retried, so that the caller gets the error from a load of its own.
+                if (preload.state == SpeculativePreload::State::Loaded)
+                    success_callback(preload.data, preload.response_headers, preload.status_code);
+                else
+                    load(request, move(success_callback), move(error_callback));
+            };
+            if (preload->state != SpeculativePreload::State::Pending) {
+                Platform::EventLoopPlugin::the().deferred_invoke([preload] {
+                    preload->on_settled();
+                });
+            }
+            return;
+        }
+
         auto protocol_request = start_network_request(request);
         if (!protocol_request) {
             if (error_callback)
@@ -450,6 +479,61 @@ void ResourceLoader::load(LoadRequest& request, SuccessCallback success_callback
         error_callback(not_implemented_error, {}, {}, {});
 }
 
+void ResourceLoader::preload_speculatively(LoadRequest& request)
+{
+    auto const& url = request.url();
+    if (!url.scheme().is_one_of("http"sv, "https"sv) || m_speculative_preloads.contains(url))
+        return;
+
+    auto preload = adopt_ref(*new SpeculativePreload);
+    preload->fetch_parameters = request.fetch_parameters();
+    auto settle = [preload](SpeculativePreload::State state, ReadonlyBytes data, HTTP::HeaderMap const& response_headers, Optional<u32> status_code) {
+        preload->state = state;
+        if (state == SpeculativePreload::State::Loaded) {
+            // FIXME: Handle OOM failure.
+            preload->data = ByteBuffer::copy(data).release_value_but_fixme_should_propagate_errors();
+            preload->response_headers = response_headers;
+            preload->status_code = status_code;
+        }
+        if (preload->on_settled)
+            preload->on_settled();
+    };
+
+    load(
+        request,
+        [settle](auto data, auto& response_headers, auto status_code) {
+            settle(SpeculativePreload::State::Loaded, data, response_headers, status_code);
+        },
+        [settle](auto&, auto status_code, auto, auto& response_headers) {
+            settle(SpeculativePreload::State::Failed, {}, response_headers, status_code);
+        });
+
+    // NOTE: This is done after starting the load, so that load() doesn't take over its own preload.
+    m_speculative_preloads.set(url, move(preload));
+}
+
+void ResourceLoader::discard_speculative_preload(URL::URL const& url)
+{
+    m_speculative_preloads.remove(url);
+}
+
+RefPtr<ResourceLoader::SpeculativePreload> ResourceLoader::take_speculative_preload(LoadRequest const& request)
+{
+    if (m_speculative_preloads.is_empty() || request.method() != "GET"sv || !request.body().is_empty())
+        return nullptr;
+    auto preload = m_speculative_preloads.get(request.url());
+    if (!preload.has_value())
+        return nullptr;
+
+    // NOTE: A request with a different mode, credentials mode or integrity metadata would have been made (or its
+    //       response checked) differently, so it has to go to the network on its own. The preload stays around for
+    //       the request it was made for.
+    if (!request.fetch_parameters().has_value() || request.fetch_parameters() != (*preload)->fetch_parameters)
+        return nullptr;
+
+    return m_speculative_preloads.take(request.url()).release_value();
+}
+
 void ResourceLoader::load_unbuffered(LoadRequest& request, OnHeadersReceived on_headers_received, OnDataReceived on_data_received, OnComplete on_complete)
 {
     auto const& url = request.url();
@@ -504,13 +588,13 @@ RefPtr<ResourceLoaderConnectorRequest> ResourceLoader::start_network_request(Loa
 
     HTTP::HeaderMap headers;
     headers.set("User-Agent", m_user_agent.to_byte_string());
-    headers.set("Accept-Encoding", "gzip, deflate, br");
+    headers.set("Accept-Encoding", "gzip, deflate, br, zstd");
 
     for (auto const& it : request.headers()) {
         headers.set(it.key, it.value);
     }
 
-    auto protocol_request = m_connector->start_request(request.method(), request.url(), headers, request.body(), proxy);
+    auto protocol_request = m_connector->start_request(request.method(), request.url(), headers, request.body(), proxy, request.priority());
     if (!protocol_request) {
         log_failure(request, "Failed to initiate load"sv);
         return nullptr;
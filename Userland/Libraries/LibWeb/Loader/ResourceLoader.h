@@ -12,6 +12,7 @@
 #include <AK/HashMap.h>
 #include <LibCore/EventReceiver.h>
 #include <LibCore/Proxy.h>
+#include <LibHTTP/RequestPriority.h>
 #include <LibJS/SafeFunction.h>
 #include <LibProtocol/Request.h>
 #include <LibURL/URL.h>
@@ -57,7 +58,7 @@ public:
     virtual void prefetch_dns(URL::URL const&) = 0;
     virtual void preconnect(URL::URL const&) = 0;
 
-    virtual RefPtr<ResourceLoaderConnectorRequest> start_request(ByteString const& method, URL::URL const&, HTTP::HeaderMap const& request_headers = {}, ReadonlyBytes request_body = {}, Core::ProxyData const& = {}) = 0;
+    virtual RefPtr<ResourceLoaderConnectorRequest> start_request(ByteString const& method, URL::URL const&, HTTP::HeaderMap const& request_headers = {}, ReadonlyBytes request_body = {}, Core::ProxyData const& = {}, HTTP::RequestPriority = HTTP::RequestPriority::Normal) = 0;
     virtual RefPtr<Web::WebSockets::WebSocketClientSocket> websocket_connect(const URL::URL&, ByteString const& origin, Vector<ByteString> const& protocols) = 0;
 
 protected:
@@ -84,6 +85,12 @@ public:
 
     void load_unbuffered(LoadRequest&, OnHeadersReceived, OnDataReceived, OnComplete);
 
+    // Starts loading a resource that is expected to be requested soon (e.g. found by the HTML parser's preload scan
+    // while it is blocked on a script). A later load() of the same URL with the same fetch parameters takes over the
+    // speculative response instead of going to the network again.
+    void preload_speculatively(LoadRequest&);
+    void discard_speculative_preload(URL::URL const&);
+
     ResourceLoaderConnector& connector() { return *m_connector; }
 
     void prefetch_dns(URL::URL const&);
@@ -110,8 +117,25 @@ private:
     void handle_network_response_headers(LoadRequest const&, HTTP::HeaderMap const&);
     void finish_network_request(NonnullRefPtr<ResourceLoaderConnectorRequest> const&);
 
+    struct SpeculativePreload : public RefCounted<SpeculativePreload> {
+        enum class State {
+            Pending,
+            Loaded,
+            Failed,
+        };
+        State state { State::Pending };
+        Optional<LoadRequest::FetchParameters> fetch_parameters;
+        ByteBuffer data;
+        HTTP::HeaderMap response_headers;
+        Optional<u32> status_code;
+        Function<void()> on_settled;
+    };
+    RefPtr<SpeculativePreload> take_speculative_preload(LoadRequest const&);
+
     int m_pending_loads { 0 };
 
+    HashMap<URL::URL, NonnullRefPtr<SpeculativePreload>> m_speculative_preloads;
+
     HashTable<NonnullRefPtr<ResourceLoaderConnectorRequest>> m_active_requests;
     NonnullRefPtr<ResourceLoaderConnector> m_connector;
     String m_user_agent;
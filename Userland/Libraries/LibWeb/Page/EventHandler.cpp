@@ -18,6 +18,7 @@
 #include <LibWeb/HTML/HTMLMediaElement.h>
 #include <LibWeb/HTML/HTMLVideoElement.h>
 #include <LibWeb/Layout/Viewport.h>
+#include <LibWeb/Loader/ResourceLoader.h>
 #include <LibWeb/Page/EventHandler.h>
 #include <LibWeb/Page/Page.h>
 #include <LibWeb/Painting/PaintableBox.h>
@@ -556,9 +557,13 @@ bool EventHandler::handle_mousemove(CSSPixelPoint position, CSSPixelPoint screen
         } else {
             page.client().page_did_leave_tooltip_area();
         }
-        if (is_hovering_link)
-            page.client().page_did_hover_link(document.parse_url(hovered_link_element->href()));
-        else
+        if (is_hovering_link) {
+            auto url = document.parse_url(hovered_link_element->href());
+            // The user is likely about to follow the link, so get a connection going to where it points.
+            if (url.is_valid() && url.scheme().is_one_of("http"sv, "https"sv))
+                ResourceLoader::the().preconnect(url);
+            page.client().page_did_hover_link(url);
+        } else
             page.client().page_did_unhover_link();
     }
 
@@ -29,11 +29,19 @@ CommandResult CommandExecutorCPU::draw_glyph_run(DrawGlyphRun const& command)
 {
     auto& painter = this->painter();
     auto const& glyphs = command.glyph_run->glyphs();
+
+    // Most runs only use a single font, so the scaled font is only looked up again when the font changes.
+    Gfx::Font const* unscaled_font = nullptr;
+    RefPtr<Gfx::Font const> scaled_font;
     for (auto& glyph_or_emoji : glyphs) {
         auto transformed_glyph = glyph_or_emoji;
         transformed_glyph.visit([&](auto& glyph) {
+            if (glyph.font.ptr() != unscaled_font) {
+                unscaled_font = glyph.font.ptr();
+                scaled_font = glyph.font->with_size(glyph.font->point_size() * static_cast<float>(command.scale));
+            }
             glyph.position = glyph.position.scaled(command.scale).translated(command.translation);
-            glyph.font = glyph.font->with_size(glyph.font->point_size() * static_cast<float>(command.scale));
+            glyph.font = *scaled_font;
         });
         if (glyph_or_emoji.has<Gfx::DrawGlyph>()) {
             auto& glyph = transformed_glyph.get<Gfx::DrawGlyph>();
@@ -102,7 +110,17 @@ CommandResult CommandExecutorCPU::draw_scaled_bitmap(DrawScaledBitmap const& com
 CommandResult CommandExecutorCPU::draw_scaled_immutable_bitmap(DrawScaledImmutableBitmap const& command)
 {
     auto paint_op = [&](Gfx::Painter& painter) {
-        painter.draw_scaled_bitmap(command.dst_rect, command.bitmap->bitmap(), command.src_rect, 1, command.scaling_mode);
+        // Scaling down with one of the smooth scaling modes is expensive enough that it's worth keeping the result around.
+        auto const& bitmap = *command.bitmap;
+        bool is_smooth_scaling_mode = command.scaling_mode == Gfx::Painter::ScalingMode::BilinearBlend || command.scaling_mode == Gfx::Painter::ScalingMode::BoxSampling;
+        bool is_scaled_down = command.dst_rect.size() != command.src_rect.size() && command.dst_rect.width() <= command.src_rect.width() && command.dst_rect.height() <= command.src_rect.height();
+        if (is_smooth_scaling_mode && is_scaled_down && command.src_rect == bitmap.rect() && painter.scale() == 1 && bitmap.bitmap().scale() == 1) {
+            if (auto scaled_bitmap = bitmap.scaled_bitmap(command.dst_rect.size(), command.scaling_mode); !scaled_bitmap.is_error()) {
+                painter.blit(command.dst_rect.location(), *scaled_bitmap.value(), scaled_bitmap.value()->rect());
+                return;
+            }
+        }
+        painter.draw_scaled_bitmap(command.dst_rect, bitmap.bitmap(), command.src_rect, 1, command.scaling_mode);
     };
     if (command.clip_paths.is_empty()) {
         paint_op(painter());
@@ -36,11 +36,19 @@ CommandResult CommandExecutorGPU::draw_glyph_run(DrawGlyphRun const& command)
     Vector<Gfx::DrawGlyphOrEmoji> transformed_glyph_run;
     auto const& glyphs = command.glyph_run->glyphs();
     transformed_glyph_run.ensure_capacity(glyphs.size());
+
+    // Most runs only use a single font, so the scaled font is only looked up again when the font changes.
+    Gfx::Font const* unscaled_font = nullptr;
+    RefPtr<Gfx::Font const> scaled_font;
     for (auto& glyph : glyphs) {
         auto transformed_glyph = glyph;
         transformed_glyph.visit([&](auto& glyph) {
+            if (glyph.font.ptr() != unscaled_font) {
+                unscaled_font = glyph.font.ptr();
+                scaled_font = glyph.font->with_size(glyph.font->point_size() * static_cast<float>(command.scale));
+            }
             glyph.position = glyph.position.scaled(command.scale).translated(command.translation);
-            glyph.font = glyph.font->with_size(glyph.font->point_size() * static_cast<float>(command.scale));
+            glyph.font = *scaled_font;
         });
         transformed_glyph_run.append(transformed_glyph);
     }
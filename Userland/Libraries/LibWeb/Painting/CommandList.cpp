@@ -142,44 +142,42 @@ void CommandList::execute(CommandExecutor& executor)
             }
         }
 
-#define HANDLE_COMMAND(command_type, executor_method)                            \
-    if (command.has<command_type>()) {                                           \
-        result = current_executor->executor_method(command.get<command_type>()); \
-    }
-
-        // clang-format off
-        CommandResult result;
-        HANDLE_COMMAND(DrawGlyphRun, draw_glyph_run)
-        else HANDLE_COMMAND(DrawText, draw_text)
-        else HANDLE_COMMAND(FillRect, fill_rect)
-        else HANDLE_COMMAND(DrawScaledBitmap, draw_scaled_bitmap)
-        else HANDLE_COMMAND(DrawScaledImmutableBitmap, draw_scaled_immutable_bitmap)
-        else HANDLE_COMMAND(SetClipRect, set_clip_rect)
-        else HANDLE_COMMAND(ClearClipRect, clear_clip_rect)
-        else HANDLE_COMMAND(PushStackingContext, push_stacking_context)
-        else HANDLE_COMMAND(PopStackingContext, pop_stacking_context)
-        else HANDLE_COMMAND(PaintLinearGradient, paint_linear_gradient)
-        else HANDLE_COMMAND(PaintRadialGradient, paint_radial_gradient)
-        else HANDLE_COMMAND(PaintConicGradient, paint_conic_gradient)
-        else HANDLE_COMMAND(PaintOuterBoxShadow, paint_outer_box_shadow)
-        else HANDLE_COMMAND(PaintInnerBoxShadow, paint_inner_box_shadow)
-        else HANDLE_COMMAND(PaintTextShadow, paint_text_shadow)
-        else HANDLE_COMMAND(FillRectWithRoundedCorners, fill_rect_with_rounded_corners)
-        else HANDLE_COMMAND(FillPathUsingColor, fill_path_using_color)
-        else HANDLE_COMMAND(FillPathUsingPaintStyle, fill_path_using_paint_style)
-        else HANDLE_COMMAND(StrokePathUsingColor, stroke_path_using_color)
-        else HANDLE_COMMAND(StrokePathUsingPaintStyle, stroke_path_using_paint_style)
-        else HANDLE_COMMAND(DrawEllipse, draw_ellipse)
-        else HANDLE_COMMAND(FillEllipse, fill_ellipse)
-        else HANDLE_COMMAND(DrawLine, draw_line)
-        else HANDLE_COMMAND(DrawSignedDistanceField, draw_signed_distance_field)
-        else HANDLE_COMMAND(ApplyBackdropFilter, apply_backdrop_filter)
-        else HANDLE_COMMAND(DrawRect, draw_rect)
-        else HANDLE_COMMAND(DrawTriangleWave, draw_triangle_wave)
-        else HANDLE_COMMAND(SampleUnderCorners, sample_under_corners)
-        else HANDLE_COMMAND(BlitCornerClipping, blit_corner_clipping)
-        else VERIFY_NOT_REACHED();
-        // clang-format on
+        // NOTE: Visiting the variant dispatches on its index directly, instead of testing each command type in turn.
+#define HANDLE_COMMAND(command_type, executor_method) \
+    [&](command_type const& command) { return current_executor->executor_method(command); }
+
+        auto result = command.visit(
+            HANDLE_COMMAND(DrawGlyphRun, draw_glyph_run),
+            HANDLE_COMMAND(DrawText, draw_text),
+            HANDLE_COMMAND(FillRect, fill_rect),
+            HANDLE_COMMAND(DrawScaledBitmap, draw_scaled_bitmap),
+            HANDLE_COMMAND(DrawScaledImmutableBitmap, draw_scaled_immutable_bitmap),
+            HANDLE_COMMAND(SetClipRect, set_clip_rect),
+            HANDLE_COMMAND(ClearClipRect, clear_clip_rect),
+            HANDLE_COMMAND(PushStackingContext, push_stacking_context),
+            HANDLE_COMMAND(PopStackingContext, pop_stacking_context),
+            HANDLE_COMMAND(PaintLinearGradient, paint_linear_gradient),
+            HANDLE_COMMAND(PaintRadialGradient, paint_radial_gradient),
+            HANDLE_COMMAND(PaintConicGradient, paint_conic_gradient),
+            HANDLE_COMMAND(PaintOuterBoxShadow, paint_outer_box_shadow),
+            HANDLE_COMMAND(PaintInnerBoxShadow, paint_inner_box_shadow),
+            HANDLE_COMMAND(PaintTextShadow, paint_text_shadow),
+            HANDLE_COMMAND(FillRectWithRoundedCorners, fill_rect_with_rounded_corners),
+            HANDLE_COMMAND(FillPathUsingColor, fill_path_using_color),
+            HANDLE_COMMAND(FillPathUsingPaintStyle, fill_path_using_paint_style),
+            HANDLE_COMMAND(StrokePathUsingColor, stroke_path_using_color),
+            HANDLE_COMMAND(StrokePathUsingPaintStyle, stroke_path_using_paint_style),
+            HANDLE_COMMAND(DrawEllipse, draw_ellipse),
+            HANDLE_COMMAND(FillEllipse, fill_ellipse),
+            HANDLE_COMMAND(DrawLine, draw_line),
+            HANDLE_COMMAND(DrawSignedDistanceField, draw_signed_distance_field),
+            HANDLE_COMMAND(ApplyBackdropFilter, apply_backdrop_filter),
+            HANDLE_COMMAND(DrawRect, draw_rect),
+            HANDLE_COMMAND(DrawTriangleWave, draw_triangle_wave),
+            HANDLE_COMMAND(SampleUnderCorners, sample_under_corners),
+            HANDLE_COMMAND(BlitCornerClipping, blit_corner_clipping));
+
+#undef HANDLE_COMMAND
 
         if (result == CommandResult::ContinueWithNestedExecutor) {
             executor_stack.append(*current_executor);
@@ -33,6 +33,9 @@ public:
     virtual ~ImageCodecPlugin();
 
     virtual NonnullRefPtr<Core::Promise<DecodedImage>> decode_image(ReadonlyBytes, ESCAPING Function<ErrorOr<void>(DecodedImage&)> on_resolved, ESCAPING Function<void(Error&)> on_rejected) = 0;
+
+    // Decodes the part of the first frame that the beginning of an image, which is still being downloaded, covers.
+    virtual NonnullRefPtr<Core::Promise<DecodedImage>> decode_partial_image(ReadonlyBytes, ESCAPING Function<ErrorOr<void>(DecodedImage&)> on_resolved, ESCAPING Function<void(Error&)> on_rejected) = 0;
 };
 
 }
@@ -11,10 +11,15 @@
 
 namespace WebView {
 
-WebContentClient::WebContentClient(NonnullOwnPtr<Core::LocalSocket> socket, ViewImplementation& view)
+WebContentClient::WebContentClient(NonnullOwnPtr<Core::LocalSocket> socket)
     : IPC::ConnectionToServer<WebContentClientEndpoint, WebContentServerEndpoint>(*this, move(socket))
 {
-    m_views.set(0, &view);
+}
+
+WebContentClient::WebContentClient(NonnullOwnPtr<Core::LocalSocket> socket, ViewImplementation& view)
+    : WebContentClient(move(socket))
+{
+    adopt_view(view);
 }
 
 void WebContentClient::die()
@@ -23,6 +28,12 @@ void WebContentClient::die()
     on_web_content_process_crash();
 }
 
+void WebContentClient::adopt_view(ViewImplementation& view)
+{
+    VERIFY(!m_views.contains(0));
+    m_views.set(0, &view);
+}
+
 void WebContentClient::register_view(u64 page_id, ViewImplementation& view)
 {
     VERIFY(page_id > 0);
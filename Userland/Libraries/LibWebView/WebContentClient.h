@@ -26,8 +26,11 @@ class WebContentClient final
     IPC_CLIENT_CONNECTION(WebContentClient, "/tmp/session/%sid/portal/webcontent"sv);
 
 public:
+    explicit WebContentClient(NonnullOwnPtr<Core::LocalSocket>);
     WebContentClient(NonnullOwnPtr<Core::LocalSocket>, ViewImplementation&);
 
+    // Attaches a view to the initial page of a process that was launched ahead of time, without one.
+    void adopt_view(ViewImplementation&);
     void register_view(u64 page_id, ViewImplementation&);
     void unregister_view(u64 page_id);
 
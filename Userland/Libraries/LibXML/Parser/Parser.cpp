@@ -149,12 +149,34 @@ void Parser::enter_node(Node& node)
 
 void Parser::leave_node()
 {
+    auto* parent = m_entered_node->parent;
+
     if (m_listener) {
         auto& element = m_entered_node->content.get<Node::Element>();
         m_listener->element_end(element.name);
+
+        // The listener has seen all there is to see of this element, so drop it instead of building up a tree that
+        // nobody will look at. This keeps memory use proportional to the nesting depth rather than the document size.
+        if (parent) {
+            auto& siblings = parent->content.get<Node::Element>().children;
+            VERIFY(siblings.last().ptr() == m_entered_node);
+            siblings.remove(siblings.size() - 1);
+        }
     }
 
-    m_entered_node = m_entered_node->parent;
+    m_entered_node = parent;
+}
+
+Name Parser::intern_name(StringView name)
+{
+    // Documents tend to use the same handful of element and attribute names over and over, so share their storage.
+    auto it = m_interned_names.find(name.hash(), [&](auto const& interned_name) { return interned_name == name; });
+    if (it != m_interned_names.end())
+        return *it;
+
+    Name interned_name { name };
+    m_interned_names.set(interned_name);
+    return interned_name;
 }
 
 ErrorOr<Document, ParseError> Parser::parse()
@@ -546,12 +568,12 @@ ErrorOr<Name, ParseError> Parser::parse_name()
     auto accept = accept_rule();
 
     auto rest = m_lexer.consume_while(s_name_characters);
-    StringBuilder builder;
-    builder.append(start);
-    builder.append(rest);
+
+    // The start character and the rest of the name are adjacent in the source.
+    StringView name { start.characters_without_null_termination(), start.length() + rest.length() };
 
     rollback.disarm();
-    return builder.to_byte_string();
+    return intern_name(name);
 }
 
 // 2.8.28. doctypedecl, https://www.w3.org/TR/2006/REC-xml11-20060816/#NT-doctypedecl
@@ -11,6 +11,7 @@
 #include <AK/Function.h>
 #include <AK/GenericLexer.h>
 #include <AK/HashMap.h>
+#include <AK/HashTable.h>
 #include <AK/OwnPtr.h>
 #include <AK/SourceLocation.h>
 #include <AK/TemporaryChange.h>
@@ -77,6 +78,7 @@ private:
     void append_comment(StringView, LineTrackingLexer::Position);
     void enter_node(Node&);
     void leave_node();
+    Name intern_name(StringView);
 
     enum class ReferencePlacement {
         AttributeValue,
@@ -210,6 +212,7 @@ private:
     } m_current_rule {};
 
     Vector<ParseError> m_parse_errors;
+    HashTable<Name> m_interned_names;
 
     Optional<Doctype> m_doctype;
 };
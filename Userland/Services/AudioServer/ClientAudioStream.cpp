@@ -25,39 +25,51 @@ bool ClientAudioStream::is_connected() const
     return m_client && m_client->is_open();
 }
 
-ErrorOr<Audio::Sample, ClientAudioStream::ErrorState> ClientAudioStream::get_next_sample(u32 audiodevice_sample_rate)
+size_t ClientAudioStream::get_next_samples(Span<Audio::Sample> samples, u32 audiodevice_sample_rate)
 {
     // Note: Even though we only check client state here, we will probably close the client much earlier.
-    if (!is_connected())
-        return ErrorState::ClientDisconnected;
-
-    if (m_paused)
-        return ErrorState::ClientUnderrun;
+    if (!is_connected() || m_paused)
+        return 0;
+
+    size_t filled_samples = 0;
+    while (filled_samples < samples.size()) {
+        if (m_in_chunk_location >= m_current_audio_chunk.size()) {
+            if (fetch_next_chunk(audiodevice_sample_rate).is_error())
+                break;
+            continue;
+        }
 
-    if (m_in_chunk_location >= m_current_audio_chunk.size()) {
-        auto result = m_buffer->dequeue();
-        if (result.is_error()) {
-            if (result.error() == Audio::AudioQueue::QueueStatus::Empty) {
-                dbgln_if(AUDIO_DEBUG, "Audio client {} can't keep up!", m_client->client_id());
-            }
+        auto chunk_samples = m_current_audio_chunk.span().slice(m_in_chunk_location);
+        auto copied_samples = chunk_samples.trim(samples.size() - filled_samples).copy_to(samples.slice(filled_samples));
+        m_in_chunk_location += copied_samples;
+        filled_samples += copied_samples;
+    }
+    return filled_samples;
+}
 
-            return ErrorState::ClientUnderrun;
+ErrorOr<void, ClientAudioStream::ErrorState> ClientAudioStream::fetch_next_chunk(u32 audiodevice_sample_rate)
+{
+    auto result = m_buffer->dequeue();
+    if (result.is_error()) {
+        if (result.error() == Audio::AudioQueue::QueueStatus::Empty) {
+            dbgln_if(AUDIO_DEBUG, "Audio client {} can't keep up!", m_client->client_id());
         }
-        // FIXME: Our resampler and the way we resample here are bad.
-        //        Ideally, we should both do perfect band-corrected resampling,
-        //        as well as carry resampling state over between buffers.
-        auto maybe_resampled = Audio::ResampleHelper<Audio::Sample> { m_sample_rate == 0 ? audiodevice_sample_rate : m_sample_rate, audiodevice_sample_rate }
-                                   .try_resample(result.release_value());
-        if (maybe_resampled.is_error())
-            return ErrorState::ResamplingError;
-
-        // If the sample rate changes underneath us, we will still play the existing buffer unchanged until we're done.
-        // This is not a significant problem since the buffers are very small (~100 samples or less).
-        m_current_audio_chunk = maybe_resampled.release_value();
-        m_in_chunk_location = 0;
-    }
 
-    return m_current_audio_chunk[m_in_chunk_location++];
+        return ErrorState::ClientUnderrun;
+    }
+    // FIXME: Our resampler and the way we resample here are bad.
+    //        Ideally, we should both do perfect band-corrected resampling,
+    //        as well as carry resampling state over between buffers.
+    auto maybe_resampled = Audio::ResampleHelper<Audio::Sample> { m_sample_rate == 0 ? audiodevice_sample_rate : m_sample_rate, audiodevice_sample_rate }
+                               .try_resample(result.release_value());
+    if (maybe_resampled.is_error())
+        return ErrorState::ResamplingError;
+
+    // If the sample rate changes underneath us, we will still play the existing buffer unchanged until we're done.
+    // This is not a significant problem since the buffers are very small (~100 samples or less).
+    m_current_audio_chunk = maybe_resampled.release_value();
+    m_in_chunk_location = 0;
+    return {};
 }
 
 void ClientAudioStream::set_buffer(NonnullOwnPtr<Audio::AudioQueue> buffer)
@@ -29,7 +29,9 @@ public:
     explicit ClientAudioStream(ConnectionFromClient&);
     ~ClientAudioStream() = default;
 
-    ErrorOr<Audio::Sample, ErrorState> get_next_sample(u32 audiodevice_sample_rate);
+    // Fills the front of the span with the next samples of this stream, and returns how many samples were filled in.
+    // Fewer samples than requested are returned if the client can't provide more right now.
+    size_t get_next_samples(Span<Audio::Sample> samples, u32 audiodevice_sample_rate);
     void clear();
 
     bool is_connected() const;
@@ -48,9 +50,11 @@ public:
     void set_sample_rate(u32 sample_rate);
 
 private:
+    ErrorOr<void, ErrorState> fetch_next_chunk(u32 audiodevice_sample_rate);
+
     OwnPtr<Audio::AudioQueue> m_buffer;
     Vector<Audio::Sample> m_current_audio_chunk;
-    size_t m_in_chunk_location;
+    size_t m_in_chunk_location { 0 };
 
     bool m_paused { true };
     bool m_muted { false };
@@ -32,8 +32,12 @@ Mixer::Mixer(NonnullRefPtr<Core::ConfigFile> config, NonnullOwnPtr<Core::File> d
 {
     m_muted = m_config->read_bool_entry("Master", "Mute", false);
     m_main_volume = static_cast<double>(m_config->read_num_entry("Master", "Volume", 100)) / 100.0;
+    m_period_size = clamp(static_cast<size_t>(m_config->read_num_entry("Master", "PeriodSize", HARDWARE_BUFFER_SIZE)), MINIMUM_PERIOD_SIZE, HARDWARE_BUFFER_SIZE);
 
     m_sound_thread->start();
+    // Any delay in mixing is immediately audible, so the mixer should not have to wait for less urgent work.
+    if (auto result = m_sound_thread->set_priority(sched_get_priority_max(0)); result.is_error())
+        dbgln("Failed to raise the mixer thread priority: {}", result.error());
 }
 
 NonnullRefPtr<ClientAudioStream> Mixer::create_queue(ConnectionFromClient& client)
@@ -68,6 +72,8 @@ void Mixer::mix()
         active_mix_queues.remove_all_matching([&](auto& entry) { return !entry->is_connected(); });
 
         Array<Audio::Sample, HARDWARE_BUFFER_SIZE> mixed_buffer;
+        auto mixed_samples = mixed_buffer.span().trim(m_period_size);
+        auto const sample_rate = audiodevice_get_sample_rate();
 
         m_main_volume.advance_time();
 
@@ -79,28 +85,32 @@ void Mixer::mix()
             }
             queue->volume().advance_time();
 
-            // FIXME: Perform sample extraction and mixing in two separate loops so they can be more easily vectorized.
-            for (auto& mixed_sample : mixed_buffer) {
-                auto sample_or_error = queue->get_next_sample(audiodevice_get_sample_rate());
-                if (sample_or_error.is_error())
-                    break;
-                if (queue->is_muted())
-                    continue;
-                auto sample = sample_or_error.release_value();
-                sample.log_multiply(SAMPLE_HEADROOM);
-                sample.log_multiply(static_cast<float>(queue->volume()));
-                mixed_sample += sample;
+            // Samples are extracted and mixed in two separate loops, so that the mixing can be vectorized.
+            Array<Audio::Sample, HARDWARE_BUFFER_SIZE> queue_buffer;
+            auto queue_samples = queue_buffer.span().trim(queue->get_next_samples(queue_buffer.span().trim(m_period_size), sample_rate));
+            if (queue->is_muted())
+                continue;
+
+            // Volumes only change between periods, so their factors can be computed once instead of for every sample.
+            float const factor = Audio::Sample::linear_to_log(SAMPLE_HEADROOM) * Audio::Sample::linear_to_log(static_cast<float>(queue->volume()));
+            for (size_t i = 0; i < queue_samples.size(); ++i) {
+                mixed_samples[i].left += queue_samples[i].left * factor;
+                mixed_samples[i].right += queue_samples[i].right * factor;
             }
         }
 
+        auto const period_size_bytes = m_period_size * 2 * sizeof(i16);
+
         // Even though it's not realistic, the user expects no sound at 0%.
         if (m_muted || m_main_volume < 0.01) {
-            m_device->write_until_depleted(m_zero_filled_buffer).release_value_but_fixme_should_propagate_errors();
+            m_device->write_until_depleted(m_zero_filled_buffer.span().trim(period_size_bytes)).release_value_but_fixme_should_propagate_errors();
         } else {
             FixedMemoryStream stream { m_stream_buffer.span() };
 
-            for (auto& mixed_sample : mixed_buffer) {
-                mixed_sample.log_multiply(static_cast<float>(m_main_volume));
+            float const main_volume_factor = Audio::Sample::linear_to_log(static_cast<float>(m_main_volume));
+            for (auto& mixed_sample : mixed_samples) {
+                mixed_sample.left *= main_volume_factor;
+                mixed_sample.right *= main_volume_factor;
                 mixed_sample.clip();
 
                 LittleEndian<i16> out_sample;
@@ -112,7 +122,7 @@ void Mixer::mix()
             }
 
             auto buffered_bytes = MUST(stream.tell());
-            VERIFY(buffered_bytes == m_stream_buffer.size());
+            VERIFY(buffered_bytes == period_size_bytes);
             m_device->write_until_depleted({ m_stream_buffer.data(), buffered_bytes })
                 .release_value_but_fixme_should_propagate_errors();
         }
@@ -31,8 +31,10 @@ namespace AudioServer {
 // Headroom, i.e. fixed attenuation for all audio streams.
 // This is to prevent clipping when two streams with low headroom (e.g. normalized & compressed) are playing.
 constexpr double SAMPLE_HEADROOM = 0.95;
-// The size of the buffer in samples that the hardware receives through write() calls to the audio device.
+// The maximum size of the buffer in samples that the hardware receives through write() calls to the audio device.
+// Smaller periods can be configured to lower the latency, at the cost of waking up the mixer more often.
 constexpr size_t HARDWARE_BUFFER_SIZE = 512;
+constexpr size_t MINIMUM_PERIOD_SIZE = 64;
 // The hardware buffer size in bytes; there's two channels of 16-bit samples.
 constexpr size_t HARDWARE_BUFFER_SIZE_BYTES = HARDWARE_BUFFER_SIZE * 2 * sizeof(i16);
 
@@ -76,6 +78,7 @@ private:
 
     bool m_muted { false };
     FadingProperty<double> m_main_volume { 1 };
+    size_t m_period_size { HARDWARE_BUFFER_SIZE };
 
     NonnullRefPtr<Core::ConfigFile> m_config;
     RefPtr<Core::Timer> m_config_write_timer;
@@ -5,8 +5,10 @@
  */
 
 #include <AK/Debug.h>
+#include <AK/Math.h>
 #include <ImageDecoder/ConnectionFromClient.h>
 #include <ImageDecoder/ImageDecoderClientEndpoint.h>
+#include <LibCore/System.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/ImageFormats/ImageDecoder.h>
 #include <LibGfx/ImageFormats/TIFFMetadata.h>
@@ -15,62 +17,130 @@ namespace ImageDecoder {
 
 ConnectionFromClient::ConnectionFromClient(NonnullOwnPtr<Core::LocalSocket> socket)
     : IPC::ConnectionFromClient<ImageDecoderClientEndpoint, ImageDecoderServerEndpoint>(*this, move(socket), 1)
+    , m_event_loop(Core::EventLoop::current())
 {
+    // Keep one core free for the main thread, which has to talk to the client and share the decoded bitmaps.
+    auto worker_thread_count = max(Core::System::hardware_concurrency(), 2u) - 1;
+    for (unsigned i = 0; i < worker_thread_count; ++i) {
+        auto thread = Threading::Thread::construct([this] { return run_worker_thread(); }, "Image Decoder"sv);
+        thread->start();
+        m_worker_threads.append(move(thread));
+    }
+}
+
+ConnectionFromClient::~ConnectionFromClient()
+{
+    stop_worker_threads();
 }
 
 void ConnectionFromClient::die()
 {
-    for (auto& [_, job] : m_pending_jobs) {
-        job->cancel();
-    }
+    stop_worker_threads();
     m_pending_jobs.clear();
 
-    Threading::quit_background_thread();
     Core::EventLoop::current().quit(0);
 }
 
-static void decode_image_to_bitmaps_and_durations_with_decoder(Gfx::ImageDecoder const& decoder, Optional<Gfx::IntSize> ideal_size, Vector<Gfx::ShareableBitmap>& bitmaps, Vector<u32>& durations)
+void ConnectionFromClient::stop_worker_threads()
+{
+    {
+        Threading::MutexLocker locker { m_jobs_mutex };
+        m_worker_threads_should_exit = true;
+        m_queued_jobs.clear();
+        for (auto& [_, job] : m_pending_jobs)
+            job->is_canceled = true;
+        m_jobs_condition.broadcast();
+    }
+
+    for (auto& thread : m_worker_threads)
+        (void)thread->join();
+    m_worker_threads.clear();
+}
+
+// Frames that are larger than the size they are going to be displayed at are only scaled down, and keep their aspect ratio.
+static ErrorOr<NonnullRefPtr<Gfx::Bitmap>> downscale_to_ideal_size(NonnullRefPtr<Gfx::Bitmap> bitmap, Optional<Gfx::IntSize> ideal_size)
+{
+    if (!ideal_size.has_value() || ideal_size->is_empty())
+        return bitmap;
+
+    auto scale = max(static_cast<float>(ideal_size->width()) / bitmap->width(), static_cast<float>(ideal_size->height()) / bitmap->height());
+    if (scale >= 1)
+        return bitmap;
+
+    auto width = max(1, static_cast<int>(AK::ceil(bitmap->width() * scale)));
+    auto height = max(1, static_cast<int>(AK::ceil(bitmap->height() * scale)));
+    return bitmap->scaled_to_size({ width, height });
+}
+
+static ErrorOr<void> decode_image_to_bitmaps_and_durations_with_decoder(Gfx::ImageDecoder const& decoder, ConnectionFromClient::Job const& job, Vector<Gfx::ShareableBitmap>& bitmaps, Vector<u32>& durations)
 {
     for (size_t i = 0; i < decoder.frame_count(); ++i) {
-        auto frame_or_error = decoder.frame(i, ideal_size);
+        if (job.is_canceled)
+            return Error::from_errno(ECANCELED);
+
+        auto frame_or_error = decoder.frame(i, job.ideal_size);
         if (frame_or_error.is_error()) {
             bitmaps.append(Gfx::ShareableBitmap {});
             durations.append(0);
         } else {
             auto frame = frame_or_error.release_value();
-            bitmaps.append(frame.image->to_shareable_bitmap());
+            auto image = TRY(downscale_to_ideal_size(*frame.image, job.ideal_size));
+            bitmaps.append(image->to_shareable_bitmap());
             durations.append(frame.duration);
         }
     }
+    return {};
+}
+
+static Gfx::FloatPoint scale_from_metadata(Gfx::ImageDecoder const& decoder)
+{
+    Gfx::FloatPoint scale { 1, 1 };
+    if (auto maybe_metadata = decoder.metadata(); maybe_metadata.has_value() && is<Gfx::ExifMetadata>(*maybe_metadata)) {
+        auto const& exif = static_cast<Gfx::ExifMetadata const&>(maybe_metadata.value());
+        if (exif.x_resolution().has_value() && exif.y_resolution().has_value()) {
+            auto const x_resolution = exif.x_resolution()->as_double();
+            auto const y_resolution = exif.y_resolution()->as_double();
+            if (x_resolution < y_resolution)
+                scale.set_y(x_resolution / y_resolution);
+            else
+                scale.set_x(y_resolution / x_resolution);
+        }
+    }
+    return scale;
+}
+
+static ErrorOr<ConnectionFromClient::DecodeResult> decode_partial_image_to_details(Gfx::ImageDecoder const& decoder, ConnectionFromClient::Job const& job)
+{
+    auto frame = TRY(decoder.partial_first_frame());
+    auto image = TRY(downscale_to_ideal_size(*frame.image, job.ideal_size));
+
+    ConnectionFromClient::DecodeResult result;
+    result.scale = scale_from_metadata(decoder);
+    result.bitmaps.append(image->to_shareable_bitmap());
+    result.durations.append(0);
+    return result;
 }
 
-static ErrorOr<ConnectionFromClient::DecodeResult> decode_image_to_details(Core::AnonymousBuffer const& encoded_buffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> const& known_mime_type)
+static ErrorOr<ConnectionFromClient::DecodeResult> decode_image_to_details(ConnectionFromClient::Job const& job)
 {
-    auto decoder = TRY(Gfx::ImageDecoder::try_create_for_raw_bytes(ReadonlyBytes { encoded_buffer.data<u8>(), encoded_buffer.size() }, known_mime_type));
+    auto const& encoded_buffer = job.encoded_buffer;
+    auto decoder = TRY(Gfx::ImageDecoder::try_create_for_raw_bytes(ReadonlyBytes { encoded_buffer.data<u8>(), encoded_buffer.size() }, job.mime_type));
 
     if (!decoder)
         return Error::from_string_literal("Could not find suitable image decoder plugin for data");
 
+    if (job.is_partial_data)
+        return decode_partial_image_to_details(*decoder, job);
+
     if (!decoder->frame_count())
         return Error::from_string_literal("Could not decode image from encoded data");
 
     ConnectionFromClient::DecodeResult result;
     result.is_animated = decoder->is_animated();
     result.loop_count = decoder->loop_count();
+    result.scale = scale_from_metadata(*decoder);
 
-    if (auto maybe_metadata = decoder->metadata(); maybe_metadata.has_value() && is<Gfx::ExifMetadata>(*maybe_metadata)) {
-        auto const& exif = static_cast<Gfx::ExifMetadata const&>(maybe_metadata.value());
-        if (exif.x_resolution().has_value() && exif.y_resolution().has_value()) {
-            auto const x_resolution = exif.x_resolution()->as_double();
-            auto const y_resolution = exif.y_resolution()->as_double();
-            if (x_resolution < y_resolution)
-                result.scale.set_y(x_resolution / y_resolution);
-            else
-                result.scale.set_x(y_resolution / x_resolution);
-        }
-    }
-
-    decode_image_to_bitmaps_and_durations_with_decoder(*decoder, move(ideal_size), result.bitmaps, result.durations);
+    TRY(decode_image_to_bitmaps_and_durations_with_decoder(*decoder, job, result.bitmaps, result.durations));
 
     if (result.bitmaps.is_empty())
         return Error::from_string_literal("Could not decode image");
@@ -78,25 +148,60 @@ static ErrorOr<ConnectionFromClient::DecodeResult> decode_image_to_details(Core:
     return result;
 }
 
-NonnullRefPtr<ConnectionFromClient::Job> ConnectionFromClient::make_decode_image_job(i64 image_id, Core::AnonymousBuffer encoded_buffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type)
-{
-    return Job::construct(
-        [encoded_buffer = move(encoded_buffer), ideal_size = move(ideal_size), mime_type = move(mime_type)](auto&) -> ErrorOr<DecodeResult> {
-            return TRY(decode_image_to_details(encoded_buffer, ideal_size, mime_type));
-        },
-        [strong_this = NonnullRefPtr(*this), image_id](DecodeResult result) -> ErrorOr<void> {
-            strong_this->async_did_decode_image(image_id, result.is_animated, result.loop_count, result.bitmaps, result.durations, result.scale);
-            strong_this->m_pending_jobs.remove(image_id);
-            return {};
-        },
-        [strong_this = NonnullRefPtr(*this), image_id](Error error) -> void {
-            if (strong_this->is_open())
-                strong_this->async_did_fail_to_decode_image(image_id, MUST(String::formatted("Decoding failed: {}", error)));
-            strong_this->m_pending_jobs.remove(image_id);
+ConnectionFromClient::Job* ConnectionFromClient::take_next_queued_job()
+{
+    // Images that are visible to the user are decoded first, everything else in the order it was requested.
+    auto index = m_queued_jobs.find_first_index_if([](auto* job) { return job->is_visible; }).value_or(0);
+    return m_queued_jobs.take(index);
+}
+
+intptr_t ConnectionFromClient::run_worker_thread()
+{
+    for (;;) {
+        Job* job = nullptr;
+        {
+            Threading::MutexLocker locker { m_jobs_mutex };
+            while (m_queued_jobs.is_empty() && !m_worker_threads_should_exit)
+                m_jobs_condition.wait();
+            if (m_worker_threads_should_exit)
+                return 0;
+            job = take_next_queued_job();
+        }
+
+        auto result = decode_image_to_details(*job);
+        m_event_loop.deferred_invoke([this, image_id = job->image_id, result = move(result)]() mutable {
+            did_finish_job(image_id, move(result));
         });
+        m_event_loop.wake();
+    }
+}
+
+void ConnectionFromClient::did_finish_job(i64 image_id, ErrorOr<DecodeResult> result)
+{
+    auto job = m_pending_jobs.take(image_id);
+    if (!job.has_value() || job.value()->is_canceled || !is_open())
+        return;
+
+    if (result.is_error()) {
+        async_did_fail_to_decode_image(image_id, MUST(String::formatted("Decoding failed: {}", result.error())));
+        return;
+    }
+
+    auto decoded = result.release_value();
+    async_did_decode_image(image_id, decoded.is_animated, decoded.loop_count, decoded.bitmaps, decoded.durations, decoded.scale);
 }
 
 Messages::ImageDecoderServer::DecodeImageResponse ConnectionFromClient::decode_image(Core::AnonymousBuffer const& encoded_buffer, Optional<Gfx::IntSize> const& ideal_size, Optional<ByteString> const& mime_type)
+{
+    return queue_job(encoded_buffer, ideal_size, mime_type, false);
+}
+
+Messages::ImageDecoderServer::DecodePartialImageResponse ConnectionFromClient::decode_partial_image(Core::AnonymousBuffer const& encoded_buffer, Optional<Gfx::IntSize> const& ideal_size, Optional<ByteString> const& mime_type)
+{
+    return queue_job(encoded_buffer, ideal_size, mime_type, true);
+}
+
+i64 ConnectionFromClient::queue_job(Core::AnonymousBuffer const& encoded_buffer, Optional<Gfx::IntSize> const& ideal_size, Optional<ByteString> const& mime_type, bool is_partial_data)
 {
     auto image_id = m_next_image_id++;
 
@@ -106,16 +211,44 @@ Messages::ImageDecoderServer::DecodeImageResponse ConnectionFromClient::decode_i
         return image_id;
     }
 
-    m_pending_jobs.set(image_id, make_decode_image_job(image_id, encoded_buffer, ideal_size, mime_type));
+    auto job = make<Job>();
+    job->image_id = image_id;
+    job->encoded_buffer = encoded_buffer;
+    job->ideal_size = ideal_size;
+    job->mime_type = mime_type;
+    job->is_partial_data = is_partial_data;
+
+    Threading::MutexLocker locker { m_jobs_mutex };
+    m_queued_jobs.append(job.ptr());
+    m_pending_jobs.set(image_id, move(job));
+    m_jobs_condition.signal();
 
     return image_id;
 }
 
 void ConnectionFromClient::cancel_decoding(i64 image_id)
 {
-    if (auto job = m_pending_jobs.take(image_id); job.has_value()) {
-        job.value()->cancel();
-    }
+    auto it = m_pending_jobs.find(image_id);
+    if (it == m_pending_jobs.end())
+        return;
+
+    Threading::MutexLocker locker { m_jobs_mutex };
+    auto& job = *it->value;
+    // Jobs that haven't started yet can go away right now, the worker thread that is decoding a job will notice it being canceled between frames.
+    if (m_queued_jobs.remove_first_matching([&](auto* queued_job) { return queued_job == &job; }))
+        m_pending_jobs.remove(it);
+    else
+        job.is_canceled = true;
+}
+
+void ConnectionFromClient::set_image_visibility(i64 image_id, bool is_visible)
+{
+    auto it = m_pending_jobs.find(image_id);
+    if (it == m_pending_jobs.end())
+        return;
+
+    Threading::MutexLocker locker { m_jobs_mutex };
+    it->value->is_visible = is_visible;
 }
 
 }
@@ -6,12 +6,16 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
 #include <AK/HashMap.h>
 #include <ImageDecoder/Forward.h>
 #include <ImageDecoder/ImageDecoderClientEndpoint.h>
 #include <ImageDecoder/ImageDecoderServerEndpoint.h>
+#include <LibCore/AnonymousBuffer.h>
 #include <LibIPC/ConnectionFromClient.h>
-#include <LibThreading/BackgroundAction.h>
+#include <LibThreading/ConditionVariable.h>
+#include <LibThreading/Mutex.h>
+#include <LibThreading/Thread.h>
 
 namespace ImageDecoder {
 
@@ -20,7 +24,7 @@ class ConnectionFromClient final
     C_OBJECT(ConnectionFromClient);
 
 public:
-    ~ConnectionFromClient() override = default;
+    ~ConnectionFromClient() override;
 
     virtual void die() override;
 
@@ -32,18 +36,48 @@ public:
         Vector<u32> durations;
     };
 
-private:
-    using Job = Threading::BackgroundAction<DecodeResult>;
+    struct Job {
+        i64 image_id { 0 };
+        Core::AnonymousBuffer encoded_buffer;
+        Optional<Gfx::IntSize> ideal_size;
+        Optional<ByteString> mime_type;
+
+        // The data is only the beginning of the image, of which the part of the first frame it covers is decoded.
+        bool is_partial_data { false };
+
+        // Only accessed while holding m_jobs_mutex.
+        bool is_visible { true };
+
+        // Set when the client cancels a job that a worker thread is already decoding.
+        Atomic<bool> is_canceled { false };
+    };
 
+private:
     explicit ConnectionFromClient(NonnullOwnPtr<Core::LocalSocket>);
 
     virtual Messages::ImageDecoderServer::DecodeImageResponse decode_image(Core::AnonymousBuffer const&, Optional<Gfx::IntSize> const& ideal_size, Optional<ByteString> const& mime_type) override;
+    virtual Messages::ImageDecoderServer::DecodePartialImageResponse decode_partial_image(Core::AnonymousBuffer const&, Optional<Gfx::IntSize> const& ideal_size, Optional<ByteString> const& mime_type) override;
     virtual void cancel_decoding(i64 image_id) override;
+    virtual void set_image_visibility(i64 image_id, bool is_visible) override;
 
-    NonnullRefPtr<Job> make_decode_image_job(i64 image_id, Core::AnonymousBuffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type);
+    i64 queue_job(Core::AnonymousBuffer const&, Optional<Gfx::IntSize> const& ideal_size, Optional<ByteString> const& mime_type, bool is_partial_data);
+    intptr_t run_worker_thread();
+    Job* take_next_queued_job();
+    void did_finish_job(i64 image_id, ErrorOr<DecodeResult>);
+    void stop_worker_threads();
 
     i64 m_next_image_id { 0 };
-    HashMap<i64, NonnullRefPtr<Job>> m_pending_jobs;
+
+    // The jobs are owned by the main thread, and only destroyed there once no worker thread is decoding them anymore.
+    HashMap<i64, NonnullOwnPtr<Job>> m_pending_jobs;
+
+    Core::EventLoop& m_event_loop;
+    Vector<NonnullRefPtr<Threading::Thread>> m_worker_threads;
+
+    Threading::Mutex m_jobs_mutex;
+    Threading::ConditionVariable m_jobs_condition { m_jobs_mutex };
+    Vector<Job*> m_queued_jobs;
+    bool m_worker_threads_should_exit { false };
 };
 
 }
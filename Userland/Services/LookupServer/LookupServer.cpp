@@ -27,6 +27,12 @@ namespace LookupServer {
 static LookupServer* s_the;
 // NOTE: This is the TTL we return for the hostname or answers from /etc/hosts.
 static constexpr u32 s_static_ttl = 86400;
+// NOTE: We don't parse the SOA record that RFC 2308 derives the negative TTL from, so use a short fixed one.
+static constexpr u32 s_negative_answer_ttl = 60;
+static constexpr size_t s_max_cached_names = 256;
+// NOTE: Names that were looked up more than once are refreshed in the background once less than a tenth of their TTL is left.
+static constexpr u32 s_min_hits_for_refresh = 2;
+static constexpr u32 s_min_ttl_for_refresh = 10;
 
 LookupServer& LookupServer::the()
 {
@@ -188,27 +194,59 @@ ErrorOr<Vector<Answer>> LookupServer::lookup(Name const& name, RecordType record
     }
 
     // Third, try our cache.
-    if (auto cached_answers = m_lookup_cache.find(name); cached_answers != m_lookup_cache.end()) {
-        for (auto& answer : cached_answers->value) {
-            // TODO: Actually remove expired answers from the cache.
-            if (answer.type() == record_type && !answer.has_expired()) {
-                dbgln_if(LOOKUPSERVER_DEBUG, "Cache hit: {} -> {}", name.as_string(), answer.record_data());
-                add_answer(answer);
-            }
+    if (auto it = m_lookup_cache.find(name); it != m_lookup_cache.end()) {
+        auto& cached_name = it->value;
+        auto now = time(nullptr);
+        cached_name.answers.remove_all_matching([](Answer const& answer) { return answer.has_expired(); });
+        cached_name.negative_answers.remove_all_matching([&](NegativeAnswer const& negative_answer) { return negative_answer.expiry_time <= now; });
+        cached_name.last_used = now;
+        ++cached_name.hit_count;
+
+        bool should_refresh = false;
+        for (auto& answer : cached_name.answers) {
+            if (answer.type() != record_type)
+                continue;
+            dbgln_if(LOOKUPSERVER_DEBUG, "Cache hit: {} -> {}", name.as_string(), answer.record_data());
+            add_answer(answer);
+            auto time_left = answer.received_time() + answer.ttl() - now;
+            if (answer.ttl() >= s_min_ttl_for_refresh && time_left < static_cast<time_t>(answer.ttl() / 10))
+                should_refresh = true;
         }
-        if (!answers.is_empty())
+        if (!answers.is_empty()) {
+            if (should_refresh && cached_name.hit_count >= s_min_hits_for_refresh)
+                schedule_refresh(name, record_type);
             return answers;
+        }
+
+        for (auto& negative_answer : cached_name.negative_answers) {
+            if (negative_answer.type == record_type) {
+                dbgln_if(LOOKUPSERVER_DEBUG, "Negative cache hit: {}", name.as_string());
+                return Vector<Answer> {};
+            }
+        }
+
+        if (cached_name.answers.is_empty() && cached_name.negative_answers.is_empty() && cached_name.pending_refreshes.is_empty())
+            m_lookup_cache.remove(it);
     }
 
+    auto upstream_answers = TRY(lookup_upstream(name, record_type));
+    for (auto& answer : upstream_answers)
+        add_answer(answer);
+    return answers;
+}
+
+ErrorOr<Vector<Answer>> LookupServer::lookup_upstream(Name const& name, RecordType record_type)
+{
     // Fourth, look up .local names using mDNS instead of DNS nameservers.
     if (name.as_string().ends_with(".local"sv)) {
-        answers = TRY(m_mdns->lookup(name, record_type));
+        auto answers = TRY(m_mdns->lookup(name, record_type));
         for (auto& answer : answers)
             put_in_cache(answer);
         return answers;
     }
 
     // Fifth, ask the upstream nameservers.
+    Vector<Answer> answers;
     for (auto& nameserver : m_nameservers) {
         dbgln_if(LOOKUPSERVER_DEBUG, "Doing lookup using nameserver '{}'", nameserver);
         bool did_get_response = false;
@@ -223,10 +261,7 @@ ErrorOr<Vector<Answer>> LookupServer::lookup(Name const& name, RecordType record
                 break;
         } while (--retries);
         if (!upstream_answers.is_empty()) {
-            for (auto& answer : upstream_answers) {
-                add_answer(answer);
-                put_in_cache(answer);
-            }
+            answers = move(upstream_answers);
             break;
         } else {
             if (!did_get_response)
@@ -288,6 +323,11 @@ ErrorOr<Vector<Answer>> LookupServer::lookup(Name const& name, ByteString const&
         return Vector<Answer> {};
     }
 
+    if (response.code() == Packet::Code::NXDOMAIN) {
+        put_negative_answer_in_cache(name, record_type);
+        return Vector<Answer> {};
+    }
+
     if (response.question_count() != request.question_count()) {
         dbgln("LookupServer: Question count ({} vs {}) :(", response.question_count(), request.question_count());
         return Vector<Answer> {};
@@ -310,6 +350,7 @@ ErrorOr<Vector<Answer>> LookupServer::lookup(Name const& name, ByteString const&
 
     if (response.answer_count() < 1) {
         dbgln("LookupServer: No answers :(");
+        put_negative_answer_in_cache(name, record_type);
         return Vector<Answer> {};
     }
 
@@ -329,31 +370,95 @@ void LookupServer::put_in_cache(Answer const& answer)
     if (answer.has_expired())
         return;
 
+    auto it = m_lookup_cache.find(answer.name());
+    if (it == m_lookup_cache.end()) {
+        make_room_in_cache();
+        CachedName cached_name;
+        cached_name.answers.append(answer);
+        cached_name.last_used = time(nullptr);
+        m_lookup_cache.set(answer.name(), move(cached_name));
+        return;
+    }
+
+    auto& cached_name = it->value;
+    auto now = time(nullptr);
+    cached_name.answers.remove_all_matching([&](Answer const& other_answer) {
+        if (other_answer.type() != answer.type() || other_answer.class_code() != answer.class_code())
+            return false;
+
+        // A fresh copy of a record we already have replaces it, so refreshing a name doesn't grow its entry.
+        if (other_answer.record_data() == answer.record_data())
+            return true;
+
+        if (!answer.mdns_cache_flush() || other_answer.received_time() >= now - 1)
+            return false;
+
+        dbgln_if(LOOKUPSERVER_DEBUG, "Removing cache entry: {}", other_answer.name());
+        return true;
+    });
+    cached_name.negative_answers.remove_all_matching([&](NegativeAnswer const& negative_answer) { return negative_answer.type == answer.type(); });
+    cached_name.answers.append(answer);
+}
+
+void LookupServer::put_negative_answer_in_cache(Name const& name, RecordType record_type)
+{
+    auto now = time(nullptr);
+    if (!m_lookup_cache.contains(name))
+        make_room_in_cache();
+
+    auto& cached_name = m_lookup_cache.ensure(name, [&] {
+        CachedName cached_name;
+        cached_name.last_used = now;
+        return cached_name;
+    });
+
+    auto& negative_answers = cached_name.negative_answers;
+    negative_answers.remove_all_matching([&](NegativeAnswer const& negative_answer) { return negative_answer.type == record_type; });
+    negative_answers.append({ record_type, now + s_negative_answer_ttl });
+}
+
+void LookupServer::make_room_in_cache()
+{
     // Prevent the cache from growing too big.
-    // TODO: Evict least used entries.
-    if (m_lookup_cache.size() >= 256)
-        m_lookup_cache.remove(m_lookup_cache.begin());
+    if (m_lookup_cache.size() < s_max_cached_names)
+        return;
 
-    auto it = m_lookup_cache.find(answer.name());
-    if (it == m_lookup_cache.end())
-        m_lookup_cache.set(answer.name(), { answer });
-    else {
-        if (answer.mdns_cache_flush()) {
-            auto now = time(nullptr);
-
-            it->value.remove_all_matching([&](Answer const& other_answer) {
-                if (other_answer.type() != answer.type() || other_answer.class_code() != answer.class_code())
-                    return false;
-
-                if (other_answer.received_time() >= now - 1)
-                    return false;
-
-                dbgln_if(LOOKUPSERVER_DEBUG, "Removing cache entry: {}", other_answer.name());
-                return true;
-            });
-        }
-        it->value.append(answer);
+    // Drop names that have nothing left worth keeping first, and the least recently used name if that's not enough.
+    auto now = time(nullptr);
+    m_lookup_cache.remove_all_matching([&](Name const&, CachedName& cached_name) {
+        cached_name.answers.remove_all_matching([](Answer const& answer) { return answer.has_expired(); });
+        cached_name.negative_answers.remove_all_matching([&](NegativeAnswer const& negative_answer) { return negative_answer.expiry_time <= now; });
+        return cached_name.answers.is_empty() && cached_name.negative_answers.is_empty() && cached_name.pending_refreshes.is_empty();
+    });
+    if (m_lookup_cache.size() < s_max_cached_names)
+        return;
+
+    auto least_recently_used = m_lookup_cache.begin();
+    for (auto it = m_lookup_cache.begin(); it != m_lookup_cache.end(); ++it) {
+        if (it->value.last_used < least_recently_used->value.last_used)
+            least_recently_used = it;
     }
+    m_lookup_cache.remove(least_recently_used);
+}
+
+void LookupServer::schedule_refresh(Name const& name, RecordType record_type)
+{
+    auto it = m_lookup_cache.find(name);
+    if (it == m_lookup_cache.end() || it->value.pending_refreshes.contains_slow(record_type))
+        return;
+    it->value.pending_refreshes.append(record_type);
+
+    // NOTE: The refresh runs after the current request has been answered, so the client doesn't wait for it.
+    deferred_invoke([this, name, record_type] {
+        dbgln_if(LOOKUPSERVER_DEBUG, "Refreshing cached answers for '{}'", name.as_string());
+        if (auto result = lookup_upstream(name, record_type); result.is_error())
+            dbgln("LookupServer: Failed to refresh '{}': {}", name.as_string(), result.error());
+
+        if (auto it = m_lookup_cache.find(name); it != m_lookup_cache.end()) {
+            it->value.pending_refreshes.remove_all_matching([&](RecordType type) { return type == record_type; });
+            it->value.hit_count = 0;
+        }
+    });
 }
 
 }
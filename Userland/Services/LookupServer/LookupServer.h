@@ -32,16 +32,34 @@ private:
     ErrorOr<HashMap<Name, Vector<Answer>, Name::Traits>> try_load_etc_hosts();
     void load_etc_hosts();
     void put_in_cache(Answer const&);
+    void put_negative_answer_in_cache(Name const&, RecordType);
+    void make_room_in_cache();
+    void schedule_refresh(Name const&, RecordType);
 
+    ErrorOr<Vector<Answer>> lookup_upstream(Name const& name, RecordType record_type);
     ErrorOr<Vector<Answer>> lookup(Name const& hostname, ByteString const& nameserver, bool& did_get_response, RecordType record_type, ShouldRandomizeCase = ShouldRandomizeCase::Yes);
 
+    struct NegativeAnswer {
+        RecordType type;
+        time_t expiry_time { 0 };
+    };
+
+    struct CachedName {
+        Vector<Answer> answers;
+        // Record types the nameservers told us don't exist for this name (RFC 2308).
+        Vector<NegativeAnswer> negative_answers;
+        Vector<RecordType> pending_refreshes;
+        time_t last_used { 0 };
+        u32 hit_count { 0 };
+    };
+
     OwnPtr<IPC::MultiServer<ConnectionFromClient>> m_server;
     RefPtr<DNSServer> m_dns_server;
     RefPtr<MulticastDNS> m_mdns;
     Vector<ByteString> m_nameservers;
     RefPtr<Core::FileWatcher> m_file_watcher;
     HashMap<Name, Vector<Answer>, Name::Traits> m_etc_hosts;
-    HashMap<Name, Vector<Answer>, Name::Traits> m_lookup_cache;
+    HashMap<Name, CachedName, Name::Traits> m_lookup_cache;
 };
 
 }
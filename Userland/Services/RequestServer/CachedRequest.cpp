@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/EventLoop.h>
+#include <LibCore/File.h>
+#include <LibCore/Notifier.h>
+#include <RequestServer/CachedRequest.h>
+
+namespace RequestServer {
+
+CachedRequest::CachedRequest(ConnectionFromClient& client, URL::URL url, NonnullRefPtr<ResponseCache::CachedResponse const> response, NonnullOwnPtr<Core::File>&& output_stream, i32 request_id)
+    : Request(client, move(output_stream), request_id)
+    , m_url(move(url))
+    , m_response(move(response))
+{
+    // NOTE: The client only learns about this request (and the file descriptor to read the body from) once we've been
+    //       returned to ConnectionFromClient, so we have to wait before sending it anything.
+    Core::deferred_invoke([weak_this = make_weak_ptr()] {
+        if (weak_this)
+            weak_this->start();
+    });
+}
+
+CachedRequest::~CachedRequest()
+{
+    if (m_write_notifier) {
+        m_write_notifier->set_enabled(false);
+        m_write_notifier->on_activation = nullptr;
+    }
+}
+
+NonnullOwnPtr<CachedRequest> CachedRequest::create(ConnectionFromClient& client, URL::URL url, NonnullRefPtr<ResponseCache::CachedResponse const> response, NonnullOwnPtr<Core::File>&& output_stream, i32 request_id)
+{
+    return adopt_own(*new CachedRequest(client, move(url), move(response), move(output_stream), request_id));
+}
+
+void CachedRequest::start()
+{
+    set_status_code(m_response->status_code);
+    set_response_headers(m_response->response_headers);
+
+    m_write_notifier = Core::Notifier::construct(output_stream().fd(), Core::Notifier::Type::Write);
+    m_write_notifier->on_activation = [this] {
+        write_more_of_the_body();
+    };
+    write_more_of_the_body();
+}
+
+void CachedRequest::write_more_of_the_body()
+{
+    auto body = m_response->body.bytes();
+
+    while (m_written_size < body.size()) {
+        auto result = output_stream().write_some(body.slice(m_written_size));
+        if (result.is_error()) {
+            // The client hasn't read what we wrote so far, try again once there's room in the pipe.
+            if (result.error().is_errno() && result.error().code() == EAGAIN) {
+                did_progress(body.size(), m_written_size);
+                return;
+            }
+
+            dbgln("CachedRequest: Failed to write cached response for {}: {}", m_url, result.error());
+            m_write_notifier->set_enabled(false);
+            did_finish(false);
+            return;
+        }
+        m_written_size += result.value();
+    }
+
+    m_write_notifier->set_enabled(false);
+    did_progress(body.size(), body.size());
+
+    // NOTE: This destroys the request.
+    did_finish(true);
+}
+
+}
@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Weakable.h>
+#include <LibCore/Forward.h>
+#include <RequestServer/Request.h>
+#include <RequestServer/ResponseCache.h>
+
+namespace RequestServer {
+
+// A request that is answered from the ResponseCache instead of the network.
+class CachedRequest final : public Request
+    , public Weakable<CachedRequest> {
+public:
+    virtual ~CachedRequest() override;
+    static NonnullOwnPtr<CachedRequest> create(ConnectionFromClient&, URL::URL, NonnullRefPtr<ResponseCache::CachedResponse const>, NonnullOwnPtr<Core::File>&&, i32 request_id);
+
+    virtual URL::URL url() const override { return m_url; }
+
+private:
+    explicit CachedRequest(ConnectionFromClient&, URL::URL, NonnullRefPtr<ResponseCache::CachedResponse const>, NonnullOwnPtr<Core::File>&&, i32 request_id);
+
+    void start();
+    void write_more_of_the_body();
+
+    URL::URL m_url;
+    NonnullRefPtr<ResponseCache::CachedResponse const> m_response;
+    size_t m_written_size { 0 };
+    RefPtr<Core::Notifier> m_write_notifier;
+};
+
+}
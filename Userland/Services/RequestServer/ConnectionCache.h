@@ -16,6 +16,7 @@
 #include <LibCore/NetworkJob.h>
 #include <LibCore/SOCKSProxyClient.h>
 #include <LibCore/Timer.h>
+#include <LibHTTP/RequestPriority.h>
 #include <LibTLS/TLSv12.h>
 #include <LibThreading/RWLockProtected.h>
 #include <LibURL/URL.h>
@@ -63,6 +64,7 @@ struct JobData {
     Function<void(Core::BufferedSocketBase&)> start {};
     Function<void(Core::NetworkJob::Error)> fail {};
     Function<Vector<TLS::Certificate>()> provide_client_certificates {};
+    HTTP::RequestPriority priority { HTTP::RequestPriority::Normal };
 #if REQUESTSERVER_DEBUG
     struct {
         bool valid { true };
@@ -87,6 +89,7 @@ struct JobData {
         : start(move(other.start))
         , fail(move(other.fail))
         , provide_client_certificates(move(other.provide_client_certificates))
+        , priority(other.priority)
         , timing_info(move(other.timing_info))
     {
         other.timing_info.valid = false;
@@ -96,17 +99,19 @@ struct JobData {
         Function<void(Core::BufferedSocketBase&)> start,
         Function<void(Core::NetworkJob::Error)> fail,
         Function<Vector<TLS::Certificate>()> provide_client_certificates,
+        HTTP::RequestPriority priority,
         decltype(timing_info) timing_info)
         : start(move(start))
         , fail(move(fail))
         , provide_client_certificates(move(provide_client_certificates))
+        , priority(priority)
         , timing_info(move(timing_info))
     {
     }
 #endif
 
     template<typename T>
-    static JobData create(NonnullRefPtr<T> job)
+    static JobData create(NonnullRefPtr<T> job, HTTP::RequestPriority priority = HTTP::RequestPriority::Normal)
     {
         return JobData {
             /* .start = */ [job](auto& socket) { job->start(socket); },
@@ -120,6 +125,7 @@ struct JobData {
                     (void)job;
                 }
                 return Vector<TLS::Certificate> {}; },
+            /* .priority = */ priority,
 #if REQUESTSERVER_DEBUG
             /* .timing_info = */ {
                 .timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise),
@@ -146,6 +152,18 @@ struct Connection {
     Optional<JobData> job_data {};
     Proxy proxy {};
     size_t max_queue_length { 0 };
+
+    // Keeps the queue sorted by priority; requests of equal priority are still served in the order they were made.
+    void enqueue(JobData job)
+    {
+        request_queue.with_write_locked([&](auto& queue) {
+            auto index = queue.size();
+            while (index > 0 && queue[index - 1].priority < job.priority)
+                --index;
+            queue.insert(index, move(job));
+            max_queue_length = max(max_queue_length, queue.size());
+        });
+    }
 };
 
 struct ConnectionKey {
@@ -178,9 +196,12 @@ extern Threading::RWLockProtected<HashMap<ByteString, InferredServerProperties>>
 void request_did_finish(URL::URL const&, Core::Socket const*);
 void dump_jobs();
 
-constexpr static size_t MaxConcurrentConnectionsPerURL = 4;
+constexpr static size_t MaxConcurrentConnectionsPerURL = 6;
 constexpr static size_t ConnectionKeepAliveTimeMilliseconds = 10'000;
 constexpr static size_t ConnectionCacheQueueHighWatermark = 4;
+// Connections that low priority requests may not open, so that a page full of images can't keep its stylesheets and
+// scripts waiting for a free connection.
+constexpr static size_t ConnectionsReservedForUrgentRequests = 2;
 
 template<typename T>
 Coroutine<ErrorOr<void>> recreate_socket_if_needed(T& connection, URL::URL const& url)
@@ -224,7 +245,7 @@ Coroutine<ErrorOr<void>> recreate_socket_if_needed(T& connection, URL::URL const
     co_return {};
 }
 
-Coroutine<void> async_get_or_create_connection(auto& cache, URL::URL url, auto job, Core::ProxyData proxy_data = {})
+Coroutine<void> async_get_or_create_connection(auto& cache, URL::URL url, auto job, Core::ProxyData proxy_data = {}, HTTP::RequestPriority priority = HTTP::RequestPriority::Normal)
 {
     using CacheEntryType = RemoveCVReference<decltype(*declval<typename RemoveCVReference<decltype(cache)>::ProtectedType>().begin()->value)>;
 
@@ -235,7 +256,10 @@ Coroutine<void> async_get_or_create_connection(auto& cache, URL::URL url, auto j
         return map.ensure({ move(hostname), url.port_or_default(), proxy_data }, [] { return make<CacheEntryType>(); }).ptr();
     });
 
-    // Find the connection with an empty queue; if none exist, we'll find the least backed-up connection later.
+    // Find an idle connection first. HTTP/1.1 can't multiplex, so a request queued on a busy connection has to wait
+    // for everything in front of it to finish; while we're allowed to open another connection, that's the better deal.
+    // Only once we're at the limit, look for a connection with a short queue; if none exist, we'll find the least
+    // backed-up connection later.
     // Note that servers that are known to serve a single request per connection (e.g. HTTP/1.0) usually have
     // issues with concurrent connections, so we'll only allow one connection per URL in that case to avoid issues.
     // This is a bit too aggressive, but there's no way to know if the server can handle concurrent connections
@@ -243,16 +267,26 @@ Coroutine<void> async_get_or_create_connection(auto& cache, URL::URL url, auto j
     auto it = cache.with_read_locked([&](auto&) {
         return sockets_for_url.find_if([&](auto& connection) {
             return properties.requests_served_per_connection < 2
-                || connection->request_queue.with_read_locked([&](auto const& queue) { return queue.size(); }) < ConnectionCacheQueueHighWatermark;
+                || (!connection->is_being_started && !connection->has_started && connection->request_queue.with_read_locked([&](auto const& queue) { return queue.is_empty(); }));
         });
     });
+    auto max_connections = ConnectionCache::MaxConcurrentConnectionsPerURL;
+    if (priority == HTTP::RequestPriority::Low)
+        max_connections -= ConnectionCache::ConnectionsReservedForUrgentRequests;
+    if (it.is_end() && sockets_for_url.size() >= max_connections) {
+        it = cache.with_read_locked([&](auto&) {
+            return sockets_for_url.find_if([&](auto& connection) {
+                return connection->request_queue.with_read_locked([&](auto const& queue) { return queue.size(); }) < ConnectionCacheQueueHighWatermark;
+            });
+        });
+    }
     auto did_add_new_connection = false;
     auto failed_to_find_a_socket = it.is_end();
     size_t index;
     Proxy proxy { proxy_data };
 
     auto start_timer = Core::ElapsedTimer::start_new();
-    if (failed_to_find_a_socket && sockets_for_url.size() < ConnectionCache::MaxConcurrentConnectionsPerURL) {
+    if (failed_to_find_a_socket && sockets_for_url.size() < max_connections) {
         using ConnectionType = RemoveCVReference<decltype(*declval<CacheEntryType>().at(0))>;
         cache.with_write_locked([&](auto&) {
             sockets_for_url.append(make<ConnectionType>(
@@ -313,10 +347,7 @@ Coroutine<void> async_get_or_create_connection(auto& cache, URL::URL url, auto j
     auto& connection = *sockets_for_url[index];
     if (connection.is_being_started) {
         dbgln_if(REQUESTSERVER_DEBUG, "Enqueue request for URL {} in {} - {}", url, &connection, connection.socket);
-        connection.request_queue.with_write_locked([&](auto& queue) {
-            queue.append(JobData::create(job));
-            connection.max_queue_length = max(connection.max_queue_length, queue.size());
-        });
+        connection.enqueue(JobData::create(job, priority));
         co_return;
     }
 
@@ -324,8 +355,8 @@ Coroutine<void> async_get_or_create_connection(auto& cache, URL::URL url, auto j
 
     if (!connection.has_started) {
         connection.has_started = true;
-        Core::deferred_invoke([&connection, url, job = move(job), connection_time] {
-            Core::run_async_in_current_event_loop([&connection, url = move(url), job = move(job), connection_time] -> Coroutine<void> {
+        Core::deferred_invoke([&connection, url, job = move(job), connection_time, priority] {
+            Core::run_async_in_current_event_loop([&connection, url = move(url), job = move(job), connection_time, priority] -> Coroutine<void> {
                 auto timer = Core::ElapsedTimer::start_new();
                 // if !REQUESTSERVER_DEBUG, this is unused.
                 (void)connection_time;
@@ -344,7 +375,7 @@ Coroutine<void> async_get_or_create_connection(auto& cache, URL::URL url, auto j
                     connection.removal_timer->stop();
                     connection.timer.start();
                     connection.current_url = url;
-                    connection.job_data = JobData::create(job);
+                    connection.job_data = JobData::create(job, priority);
                     if constexpr (REQUESTSERVER_DEBUG)
                         connection.job_data->timing_info.starting_connection += Duration::from_milliseconds(timer.elapsed_milliseconds() + connection_time);
                     connection.socket->set_notifications_enabled(true);
@@ -354,15 +385,12 @@ Coroutine<void> async_get_or_create_connection(auto& cache, URL::URL url, auto j
         });
     } else {
         dbgln_if(REQUESTSERVER_DEBUG, "Enqueue request for URL {} in {} - {}", url, &connection, connection.socket);
-        connection.request_queue.with_write_locked([&](auto& queue) {
-            queue.append(JobData::create(job));
-            connection.max_queue_length = max(connection.max_queue_length, queue.size());
-        });
+        connection.enqueue(JobData::create(job, priority));
     }
 }
 
-void ensure_connection(auto& cache, URL::URL const& url, auto job, Core::ProxyData proxy_data = {})
+void ensure_connection(auto& cache, URL::URL const& url, auto job, Core::ProxyData proxy_data = {}, HTTP::RequestPriority priority = HTTP::RequestPriority::Normal)
 {
-    Core::EventLoop::current().adopt_coroutine(async_get_or_create_connection(cache, url, move(job), proxy_data));
+    Core::EventLoop::current().adopt_coroutine(async_get_or_create_connection(cache, url, move(job), proxy_data, priority));
 }
 }
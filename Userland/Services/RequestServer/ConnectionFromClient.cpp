@@ -143,7 +143,7 @@ void ConnectionFromClient::worker_do_work(Work work)
                 (void)post_message(Messages::RequestClient::RequestFinished(start_request.request_id, false, 0));
                 return;
             }
-            auto request = protocol->start_request(start_request.request_id, *this, start_request.method, start_request.url, start_request.request_headers, start_request.request_body, start_request.proxy_data);
+            auto request = protocol->start_request(start_request.request_id, *this, start_request.method, start_request.url, start_request.request_headers, start_request.request_body, start_request.proxy_data, start_request.priority);
             if (!request) {
                 dbgln("StartRequest: Protocol handler failed to start request: '{}'", start_request.url);
                 auto lock = Threading::MutexLocker(m_ipc_mutex);
@@ -234,7 +234,7 @@ Messages::RequestServer::IsSupportedProtocolResponse ConnectionFromClient::is_su
     return supported;
 }
 
-void ConnectionFromClient::start_request(i32 request_id, ByteString const& method, URL::URL const& url, HTTP::HeaderMap const& request_headers, ByteBuffer const& request_body, Core::ProxyData const& proxy_data)
+void ConnectionFromClient::start_request(i32 request_id, ByteString const& method, URL::URL const& url, HTTP::HeaderMap const& request_headers, ByteBuffer const& request_body, Core::ProxyData const& proxy_data, HTTP::RequestPriority priority)
 {
     if (!url.is_valid()) {
         dbgln("StartRequest: Invalid URL requested: '{}'", url);
@@ -250,6 +250,7 @@ void ConnectionFromClient::start_request(i32 request_id, ByteString const& metho
         .request_headers = request_headers,
         .request_body = request_body,
         .proxy_data = proxy_data,
+        .priority = priority,
     });
 }
 
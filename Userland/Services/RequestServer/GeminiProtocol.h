@@ -19,7 +19,7 @@ public:
 private:
     GeminiProtocol();
 
-    virtual OwnPtr<Request> start_request(i32, ConnectionFromClient&, ByteString const& method, const URL::URL&, HTTP::HeaderMap const&, ReadonlyBytes body, Core::ProxyData proxy_data = {}) override;
+    virtual OwnPtr<Request> start_request(i32, ConnectionFromClient&, ByteString const& method, const URL::URL&, HTTP::HeaderMap const&, ReadonlyBytes body, Core::ProxyData proxy_data = {}, HTTP::RequestPriority priority = HTTP::RequestPriority::Normal) override;
 };
 
 }
@@ -14,9 +14,11 @@
 #include <AK/OwnPtr.h>
 #include <AK/Types.h>
 #include <LibHTTP/HttpRequest.h>
+#include <RequestServer/CachedRequest.h>
 #include <RequestServer/ConnectionCache.h>
 #include <RequestServer/ConnectionFromClient.h>
 #include <RequestServer/Request.h>
+#include <RequestServer/ResponseCache.h>
 
 namespace RequestServer::Detail {
 
@@ -29,6 +31,13 @@ void init(TSelf* self, TJob job)
         self->set_response_headers(headers);
     };
 
+    if (ResponseCache::may_store_response_to(job->request())) {
+        self->start_recording_body();
+        job->on_response_body_written = [self](ReadonlyBytes bytes) {
+            self->record_body(bytes);
+        };
+    }
+
     job->on_finish = [self](bool success) {
         Core::deferred_invoke([url = self->job().url(), socket = self->job().socket()] {
             ConnectionCache::request_did_finish(url, socket);
@@ -39,6 +48,9 @@ void init(TSelf* self, TJob job)
             self->set_downloaded_size(response->downloaded_size());
         }
 
+        if (auto body = self->take_recorded_body(); body.has_value() && success && self->status_code().has_value())
+            ResponseCache::the().store(self->job().request(), *self->status_code(), self->response_headers(), body.release_value());
+
         // if we didn't know the total size, pretend that the request finished successfully
         // and set the total size to the downloaded size
         if (!self->total_size().has_value())
@@ -61,7 +73,7 @@ void init(TSelf* self, TJob job)
 }
 
 template<typename TBadgedProtocol, typename TPipeResult>
-OwnPtr<Request> start_request(TBadgedProtocol&& protocol, i32 request_id, ConnectionFromClient& client, ByteString const& method, URL::URL const& url, HTTP::HeaderMap const& headers, ReadonlyBytes body, TPipeResult&& pipe_result, Core::ProxyData proxy_data = {})
+OwnPtr<Request> start_request(TBadgedProtocol&& protocol, i32 request_id, ConnectionFromClient& client, ByteString const& method, URL::URL const& url, HTTP::HeaderMap const& headers, ReadonlyBytes body, TPipeResult&& pipe_result, Core::ProxyData proxy_data = {}, HTTP::RequestPriority priority = HTTP::RequestPriority::Normal)
 {
     using TJob = typename TBadgedProtocol::Type::JobType;
     using TRequest = typename TBadgedProtocol::Type::RequestType;
@@ -92,6 +104,13 @@ OwnPtr<Request> start_request(TBadgedProtocol&& protocol, i32 request_id, Connec
     request.set_url(url);
     request.set_headers(headers);
 
+    if (auto cached_response = ResponseCache::the().lookup(request.method(), url, headers)) {
+        auto output_stream = MUST(Core::File::adopt_fd(pipe_result.value().write_fd, Core::File::OpenMode::Write));
+        auto cached_request = CachedRequest::create(client, url, cached_response.release_nonnull(), move(output_stream), request_id);
+        cached_request->set_request_fd(pipe_result.value().read_fd);
+        return cached_request;
+    }
+
     auto allocated_body_result = ByteBuffer::copy(body);
     if (allocated_body_result.is_error())
         return {};
@@ -104,9 +123,9 @@ OwnPtr<Request> start_request(TBadgedProtocol&& protocol, i32 request_id, Connec
 
     Core::deferred_invoke([=] {
         if constexpr (IsSame<typename TBadgedProtocol::Type, HttpsProtocol>)
-            ConnectionCache::ensure_connection(ConnectionCache::g_tls_connection_cache, url, job, proxy_data);
+            ConnectionCache::ensure_connection(ConnectionCache::g_tls_connection_cache, url, job, proxy_data, priority);
         else
-            ConnectionCache::ensure_connection(ConnectionCache::g_tcp_connection_cache, url, job, proxy_data);
+            ConnectionCache::ensure_connection(ConnectionCache::g_tcp_connection_cache, url, job, proxy_data, priority);
     });
 
     return protocol_request;
@@ -9,6 +9,7 @@
 #include <AK/RefPtr.h>
 #include <LibCore/Proxy.h>
 #include <LibHTTP/HeaderMap.h>
+#include <LibHTTP/RequestPriority.h>
 #include <LibURL/URL.h>
 #include <RequestServer/Forward.h>
 
@@ -19,7 +20,7 @@ public:
     virtual ~Protocol() = default;
 
     ByteString const& name() const { return m_name; }
-    virtual OwnPtr<Request> start_request(i32, ConnectionFromClient&, ByteString const& method, URL::URL const&, HTTP::HeaderMap const& headers, ReadonlyBytes body, Core::ProxyData proxy_data = {}) = 0;
+    virtual OwnPtr<Request> start_request(i32, ConnectionFromClient&, ByteString const& method, URL::URL const&, HTTP::HeaderMap const& headers, ReadonlyBytes body, Core::ProxyData proxy_data = {}, HTTP::RequestPriority priority = HTTP::RequestPriority::Normal) = 0;
 
     static Protocol* find_by_name(ByteString const&);
 
@@ -6,6 +6,7 @@
 
 #include <RequestServer/ConnectionFromClient.h>
 #include <RequestServer/Request.h>
+#include <RequestServer/ResponseCache.h>
 
 namespace RequestServer {
 
@@ -27,6 +28,18 @@ void Request::set_response_headers(HTTP::HeaderMap response_headers)
     m_client.did_receive_headers({}, *this);
 }
 
+void Request::record_body(ReadonlyBytes bytes)
+{
+    if (!m_recorded_body.has_value())
+        return;
+
+    // NOTE: Responses this large aren't going to be cached anyway, so stop holding on to them.
+    if (m_recorded_body->size() + bytes.size() > ResponseCache::maximum_cached_response_size
+        || m_recorded_body->try_append(bytes).is_error()) {
+        m_recorded_body.clear();
+    }
+}
+
 void Request::set_certificate(ByteString, ByteString)
 {
 }
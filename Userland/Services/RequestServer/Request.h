@@ -6,10 +6,12 @@
 
 #pragma once
 
+#include <AK/ByteBuffer.h>
 #include <AK/HashMap.h>
 #include <AK/NonnullOwnPtr.h>
 #include <AK/Optional.h>
 #include <AK/RefCounted.h>
+#include <LibHTTP/HeaderMap.h>
 #include <LibURL/URL.h>
 #include <RequestServer/Forward.h>
 
@@ -41,6 +43,12 @@ public:
     void set_response_headers(HTTP::HeaderMap);
     void set_downloaded_size(size_t size) { m_downloaded_size = size; }
     Core::File const& output_stream() const { return *m_output_stream; }
+    Core::File& output_stream() { return *m_output_stream; }
+
+    // Keeps a copy of the response body handed to the client, so it can be stored in the ResponseCache afterwards.
+    void start_recording_body() { m_recorded_body = ByteBuffer {}; }
+    void record_body(ReadonlyBytes);
+    Optional<ByteBuffer> take_recorded_body() { return move(m_recorded_body); }
 
 protected:
     explicit Request(ConnectionFromClient&, NonnullOwnPtr<Core::File>&&, i32 request_id);
@@ -54,6 +62,7 @@ private:
     size_t m_downloaded_size { 0 };
     NonnullOwnPtr<Core::File> m_output_stream;
     HTTP::HeaderMap m_response_headers;
+    Optional<ByteBuffer> m_recorded_body;
 };
 
 }
@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <RequestServer/ResponseCache.h>
+
+namespace RequestServer {
+
+struct CacheControl {
+    bool no_store { false };
+    bool no_cache { false };
+    Optional<i64> max_age;
+};
+
+// https://httpwg.org/specs/rfc9111.html#field.cache-control
+static CacheControl parse_cache_control(Optional<ByteString> const& header_value)
+{
+    CacheControl cache_control;
+    if (!header_value.has_value())
+        return cache_control;
+
+    for (auto directive : header_value->split_view(',')) {
+        directive = directive.trim_whitespace();
+
+        auto name = directive;
+        Optional<StringView> argument;
+        if (auto equals = directive.find('='); equals.has_value()) {
+            name = directive.substring_view(0, *equals).trim_whitespace();
+            argument = directive.substring_view(*equals + 1).trim_whitespace().trim("\""sv);
+        }
+
+        if (name.equals_ignoring_ascii_case("no-store"sv))
+            cache_control.no_store = true;
+        else if (name.equals_ignoring_ascii_case("no-cache"sv))
+            cache_control.no_cache = true;
+        else if (name.equals_ignoring_ascii_case("max-age"sv) && argument.has_value())
+            cache_control.max_age = argument->to_number<i64>();
+    }
+    return cache_control;
+}
+
+// https://httpwg.org/specs/rfc9110.html#rfc.section.15.1
+static bool is_heuristically_cacheable_status(u32 status_code)
+{
+    switch (status_code) {
+    case 200:
+    case 203:
+    case 204:
+    case 300:
+    case 301:
+    case 308:
+    case 404:
+    case 405:
+    case 410:
+    case 414:
+    case 501:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static ByteString cache_key_for(URL::URL const& url)
+{
+    return url.serialize(URL::ExcludeFragment::Yes);
+}
+
+ResponseCache& ResponseCache::the()
+{
+    static ResponseCache cache;
+    return cache;
+}
+
+RefPtr<ResponseCache::CachedResponse const> ResponseCache::lookup(HTTP::HttpRequest::Method method, URL::URL const& url, HTTP::HeaderMap const& request_headers)
+{
+    if (method != HTTP::HttpRequest::Method::GET || request_headers.contains("Range"))
+        return nullptr;
+
+    // https://httpwg.org/specs/rfc9111.html#cache-request-directive
+    auto request_cache_control = parse_cache_control(request_headers.get("Cache-Control"));
+    if (request_cache_control.no_store || request_cache_control.no_cache || request_cache_control.max_age == 0)
+        return nullptr;
+    if (auto pragma = request_headers.get("Pragma"); pragma.has_value() && pragma->contains("no-cache"sv, CaseSensitivity::CaseInsensitive))
+        return nullptr;
+
+    Threading::MutexLocker locker(m_mutex);
+
+    auto it = m_entries.find(cache_key_for(url));
+    if (it == m_entries.end())
+        return nullptr;
+    auto& response = *it->value.response;
+
+    // https://httpwg.org/specs/rfc9111.html#caching.negotiated.responses
+    for (auto const& header : response.vary_request_headers) {
+        if (request_headers.get(header.name).value_or({}) != header.value)
+            return nullptr;
+    }
+
+    // https://httpwg.org/specs/rfc9111.html#expiration.model
+    auto current_age = response.initial_age + (MonotonicTime::now() - response.response_time);
+    if (current_age >= response.freshness_lifetime) {
+        dbgln_if(REQUESTSERVER_DEBUG, "ResponseCache: Dropping stale response for {}", url);
+        m_size_in_bytes -= response.body.size();
+        m_entries.remove(it);
+        return nullptr;
+    }
+
+    dbgln_if(REQUESTSERVER_DEBUG, "ResponseCache: Serving {} from the cache", url);
+    it->value.last_used = ++m_use_counter;
+    return it->value.response;
+}
+
+// https://httpwg.org/specs/rfc9111.html#response.cacheability
+bool ResponseCache::may_store_response_to(HTTP::HttpRequest const& request)
+{
+    if (request.method() != HTTP::HttpRequest::Method::GET || !request.body().is_empty())
+        return false;
+    if (request.headers().contains("Range"))
+        return false;
+    return !parse_cache_control(request.headers().get("Cache-Control")).no_store;
+}
+
+void ResponseCache::store(HTTP::HttpRequest const& request, u32 status_code, HTTP::HeaderMap const& response_headers, ByteBuffer body)
+{
+    if (!may_store_response_to(request) || !is_heuristically_cacheable_status(status_code))
+        return;
+    if (body.size() > maximum_cached_response_size)
+        return;
+
+    auto cache_control = parse_cache_control(response_headers.get("Cache-Control"));
+    if (cache_control.no_store || cache_control.no_cache)
+        return;
+
+    // NOTE: Replaying a Set-Cookie header to another request would set the cookie again, so we don't store those.
+    if (response_headers.contains("Set-Cookie"))
+        return;
+
+    // FIXME: Use Expires when there is no max-age, and compute a heuristic freshness lifetime when there is neither.
+    if (!cache_control.max_age.has_value() || *cache_control.max_age <= 0)
+        return;
+
+    auto response = adopt_ref(*new CachedResponse);
+    response->status_code = status_code;
+    response->response_headers = response_headers;
+    response->body = move(body);
+    response->freshness_lifetime = AK::Duration::from_seconds(*cache_control.max_age);
+    if (auto age = response_headers.get("Age"); age.has_value())
+        response->initial_age = AK::Duration::from_seconds(age->to_number<i64>().value_or(0));
+
+    if (auto vary = response_headers.get("Vary"); vary.has_value()) {
+        for (auto name : vary->split_view(',')) {
+            name = name.trim_whitespace();
+            if (name == "*"sv)
+                return;
+            response->vary_request_headers.append({ name, request.headers().get(name).value_or({}) });
+        }
+    }
+
+    dbgln_if(REQUESTSERVER_DEBUG, "ResponseCache: Storing {} bytes for {}, fresh for {}s", response->body.size(), request.url(), *cache_control.max_age);
+
+    Threading::MutexLocker locker(m_mutex);
+
+    auto key = cache_key_for(request.url());
+    if (auto it = m_entries.find(key); it != m_entries.end()) {
+        m_size_in_bytes -= it->value.response->body.size();
+        m_entries.remove(it);
+    }
+
+    evict_until_size_is_at_most(maximum_cache_size - response->body.size());
+    m_size_in_bytes += response->body.size();
+    m_entries.set(move(key), Entry { move(response), ++m_use_counter });
+}
+
+void ResponseCache::evict_until_size_is_at_most(size_t size)
+{
+    while (m_size_in_bytes > size && !m_entries.is_empty()) {
+        auto least_recently_used = m_entries.begin();
+        for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+            if (it->value.last_used < least_recently_used->value.last_used)
+                least_recently_used = it;
+        }
+        m_size_in_bytes -= least_recently_used->value.response->body.size();
+        m_entries.remove(least_recently_used);
+    }
+}
+
+}
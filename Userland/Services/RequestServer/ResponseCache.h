@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/ByteString.h>
+#include <AK/HashMap.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/RefCounted.h>
+#include <AK/Time.h>
+#include <LibHTTP/HeaderMap.h>
+#include <LibHTTP/HttpRequest.h>
+#include <LibThreading/Mutex.h>
+#include <LibURL/URL.h>
+
+namespace RequestServer {
+
+// An in-memory HTTP cache (https://httpwg.org/specs/rfc9111.html) shared by all clients of this RequestServer.
+// Only responses that carry an explicit freshness lifetime are stored, and they are only served while they are fresh.
+// FIXME: Revalidate stale responses with If-None-Match / If-Modified-Since instead of dropping them.
+// FIXME: Persist responses to disk, so they survive a restart.
+class ResponseCache {
+public:
+    struct CachedResponse : public RefCounted<CachedResponse> {
+        u32 status_code { 0 };
+        HTTP::HeaderMap response_headers;
+        ByteBuffer body;
+
+        // The values the request headers named by the response's Vary header had when the response was stored.
+        Vector<HTTP::Header> vary_request_headers;
+
+        MonotonicTime response_time { MonotonicTime::now() };
+        AK::Duration initial_age;
+        AK::Duration freshness_lifetime;
+    };
+
+    static constexpr size_t maximum_cache_size = 64 * MiB;
+    static constexpr size_t maximum_cached_response_size = 8 * MiB;
+
+    static ResponseCache& the();
+
+    RefPtr<CachedResponse const> lookup(HTTP::HttpRequest::Method, URL::URL const&, HTTP::HeaderMap const& request_headers);
+
+    static bool may_store_response_to(HTTP::HttpRequest const&);
+    void store(HTTP::HttpRequest const&, u32 status_code, HTTP::HeaderMap const& response_headers, ByteBuffer body);
+
+private:
+    ResponseCache() = default;
+
+    void evict_until_size_is_at_most(size_t);
+
+    struct Entry {
+        NonnullRefPtr<CachedResponse const> response;
+        u64 last_used { 0 };
+    };
+
+    Threading::Mutex m_mutex;
+    HashMap<ByteString, Entry> m_entries;
+    size_t m_size_in_bytes { 0 };
+    u64 m_use_counter { 0 };
+};
+
+}
@@ -6,6 +6,7 @@
 
 #include <AK/OwnPtr.h>
 #include <LibCore/EventLoop.h>
+#include <LibCore/EventLoopImplementationUnix.h>
 #include <LibCore/LocalServer.h>
 #include <LibCore/System.h>
 #include <LibIPC/SingleServer.h>
@@ -38,6 +39,8 @@ ErrorOr<int> serenity_main(Main::Arguments)
     [[maybe_unused]] auto& certs = DefaultRootCACertificates::the();
 
     Core::EventLoop event_loop;
+    // Our timers mostly expire idle keep-alive connections, which doesn't need to happen on the dot.
+    Core::EventLoopManagerUnix::set_timer_slack(Duration::from_milliseconds(50));
     // FIXME: Establish a connection to LookupServer and then drop "unix"?
     TRY(Core::System::unveil("/tmp/portal/lookup", "rw"));
     TRY(Core::System::unveil("/etc/cacert.pem", "rw"));
@@ -5,6 +5,7 @@
  */
 
 #include <AK/LexicalPath.h>
+#include <LibCore/EventLoop.h>
 #include <SQLServer/DatabaseConnection.h>
 #include <SQLServer/SQLStatement.h>
 
@@ -12,6 +13,7 @@ namespace SQLServer {
 
 static HashMap<SQL::ConnectionID, NonnullRefPtr<DatabaseConnection>> s_connections;
 static SQL::ConnectionID s_next_connection_id = 0;
+static HashMap<SQL::Database const*, Vector<Function<void(ErrorOr<void> const&)>>> s_pending_commits;
 
 static ErrorOr<NonnullRefPtr<SQL::Database>> find_or_create_database(StringView database_path, StringView database_name)
 {
@@ -68,8 +70,29 @@ SQL::ResultOr<SQL::StatementID> DatabaseConnection::prepare_statement(StringView
 {
     dbgln_if(SQLSERVER_DEBUG, "DatabaseConnection::prepare_statement(connection_id {}, database '{}', sql '{}'", connection_id(), m_database_name, sql);
 
+    if (auto statement_id = m_prepared_statements.get(sql); statement_id.has_value() && SQLStatement::statement_for(*statement_id))
+        return *statement_id;
+
     auto statement = TRY(SQLStatement::create(*this, sql));
+    TRY(m_prepared_statements.try_set(sql, statement->statement_id()));
     return statement->statement_id();
 }
 
+void DatabaseConnection::commit(Function<void(ErrorOr<void> const&)> on_complete)
+{
+    auto& pending_commits = s_pending_commits.ensure(m_database.ptr());
+    pending_commits.append(move(on_complete));
+    if (pending_commits.size() > 1)
+        return;
+
+    Core::deferred_invoke([database = m_database] {
+        auto pending_commits = s_pending_commits.take(database.ptr()).release_value();
+        dbgln_if(SQLSERVER_DEBUG, "DatabaseConnection: committing {} statement(s)", pending_commits.size());
+
+        auto result = database->commit();
+        for (auto& on_complete : pending_commits)
+            on_complete(result);
+    });
+}
+
 }
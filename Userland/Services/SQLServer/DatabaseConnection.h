@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Function.h>
 #include <AK/NonnullRefPtr.h>
 #include <AK/RefCounted.h>
 #include <LibSQL/Database.h>
@@ -27,6 +28,10 @@ public:
     void disconnect();
     SQL::ResultOr<SQL::StatementID> prepare_statement(StringView sql);
 
+    // Commits the database once the statements that are already queued for execution have run. All statements
+    // executed in the meantime, on any connection to the same database, are made durable by that same commit.
+    void commit(Function<void(ErrorOr<void> const&)> on_complete);
+
 private:
     DatabaseConnection(NonnullRefPtr<SQL::Database> database, ByteString database_name, int client_id);
 
@@ -34,6 +39,10 @@ private:
     ByteString m_database_name;
     SQL::ConnectionID m_connection_id { 0 };
     int m_client_id { 0 };
+
+    // Statements prepared on this connection, by their SQL text. Preparing the same SQL again reuses the statement,
+    // since executing it with different placeholder values does not require parsing it again.
+    HashMap<ByteString, SQL::StatementID> m_prepared_statements;
 };
 
 }
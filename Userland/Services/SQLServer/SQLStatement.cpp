@@ -70,42 +70,54 @@ Optional<SQL::ExecutionID> SQLStatement::execute(Vector<SQL::Value> placeholder_
     auto execution_id = m_next_execution_id++;
 
     Core::deferred_invoke([this, strong_this = NonnullRefPtr(*this), placeholder_values = move(placeholder_values), execution_id] {
-        auto execution_result = m_statement->execute(connection().database(), placeholder_values);
+        auto execution_result = m_statement->execute(connection().database(), placeholder_values, SQL::AST::ShouldCommit::No);
 
         if (execution_result.is_error()) {
             report_error(execution_result.release_error(), execution_id);
             return;
         }
 
-        auto client_connection = ConnectionFromClient::client_connection_for(connection().client_id());
-        if (!client_connection) {
-            warnln("Cannot return statement execution results. Client disconnected");
-            return;
-        }
-
-        auto result = execution_result.release_value();
-        auto result_size = result.size();
-
-        if (should_send_result_rows(result)) {
-            client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), true, 0, 0, 0);
-
-            m_ongoing_executions.set(execution_id, { move(result), result_size });
-            ready_for_next_result(execution_id);
-        } else {
-            if (result.command() == SQL::SQLCommand::Insert)
-                client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, result_size, 0, 0);
-            else if (result.command() == SQL::SQLCommand::Update)
-                client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, 0, result_size, 0);
-            else if (result.command() == SQL::SQLCommand::Delete)
-                client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, 0, 0, result_size);
-            else
-                client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, 0, 0, 0);
-        }
+        // Results are only reported once the modifications are durable, which happens with one commit for all
+        // statements that are executed in the same batch.
+        connection().commit([this, strong_this = NonnullRefPtr(*this), result = execution_result.release_value(), execution_id](ErrorOr<void> const& commit_result) mutable {
+            if (commit_result.is_error()) {
+                report_error({ result.command(), SQL::SQLErrorCode::InternalError, ByteString::formatted("{}", commit_result.error()) }, execution_id);
+                return;
+            }
+            report_success(move(result), execution_id);
+        });
     });
 
     return execution_id;
 }
 
+void SQLStatement::report_success(SQL::ResultSet result, SQL::ExecutionID execution_id)
+{
+    auto client_connection = ConnectionFromClient::client_connection_for(connection().client_id());
+    if (!client_connection) {
+        warnln("Cannot return statement execution results. Client disconnected");
+        return;
+    }
+
+    auto result_size = result.size();
+
+    if (should_send_result_rows(result)) {
+        client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), true, 0, 0, 0);
+
+        m_ongoing_executions.set(execution_id, { move(result), result_size });
+        ready_for_next_result(execution_id);
+    } else {
+        if (result.command() == SQL::SQLCommand::Insert)
+            client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, result_size, 0, 0);
+        else if (result.command() == SQL::SQLCommand::Update)
+            client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, 0, result_size, 0);
+        else if (result.command() == SQL::SQLCommand::Delete)
+            client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, 0, 0, result_size);
+        else
+            client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, 0, 0, 0);
+    }
+}
+
 void SQLStatement::ready_for_next_result(SQL::ExecutionID execution_id)
 {
     auto client_connection = ConnectionFromClient::client_connection_for(connection().client_id());
@@ -119,14 +131,22 @@ void SQLStatement::ready_for_next_result(SQL::ExecutionID execution_id)
         return;
     }
 
-    if (execution->result.is_empty()) {
+    if (execution->next_row == execution->result.size()) {
         client_connection->async_results_exhausted(statement_id(), execution_id, execution->result_size);
         m_ongoing_executions.remove(execution_id);
         return;
     }
 
-    auto result_row = execution->result.take_first();
-    client_connection->async_next_result(statement_id(), execution_id, result_row.row.take_data());
+    // Rows are sent in batches to avoid a round trip to the client for every single row.
+    static constexpr size_t max_rows_per_batch = 64;
+    auto row_count = min(execution->result.size() - execution->next_row, max_rows_per_batch);
+
+    Vector<Vector<SQL::Value>> rows;
+    rows.ensure_capacity(row_count);
+    for (size_t i = 0; i < row_count; ++i)
+        rows.unchecked_append(execution->result[execution->next_row++].row.take_data());
+
+    client_connection->async_next_results(statement_id(), execution_id, move(rows));
 }
 
 bool SQLStatement::should_send_result_rows(SQL::ResultSet const& result) const
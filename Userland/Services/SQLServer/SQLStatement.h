@@ -33,6 +33,7 @@ private:
 
     bool should_send_result_rows(SQL::ResultSet const& result) const;
     void report_error(SQL::Result, SQL::ExecutionID execution_id);
+    void report_success(SQL::ResultSet, SQL::ExecutionID execution_id);
 
     DatabaseConnection& m_connection;
     SQL::StatementID m_statement_id { 0 };
@@ -40,6 +41,7 @@ private:
     struct Execution {
         SQL::ResultSet result;
         size_t result_size { 0 };
+        size_t next_row { 0 };
     };
     HashMap<SQL::ExecutionID, Execution> m_ongoing_executions;
     SQL::ExecutionID m_next_execution_id { 0 };
@@ -5,6 +5,7 @@
  */
 
 #include "Service.h"
+#include <AK/AnyOf.h>
 #include <AK/Debug.h>
 #include <AK/HashMap.h>
 #include <AK/JsonArray.h>
@@ -115,11 +116,53 @@ ErrorOr<void> Service::activate()
 {
     VERIFY(m_pid < 0);
 
+    // did_come_up() activates us once everything we're waiting for is up.
+    if (m_pending_dependency_count > 0)
+        return {};
+
+    ErrorOr<void> result;
     if (m_lazy)
         setup_notifier();
     else
-        TRY(spawn());
-    return {};
+        result = spawn();
+
+    // Services with sockets are up as soon as clients can connect to them, since the connections queue up until the
+    // service accepts them. Other services are up once they're running, or once they're done if they only run once.
+    if (result.is_error() || !m_sockets.is_empty() || m_keep_alive || m_multi_instance)
+        did_come_up();
+    return result;
+}
+
+void Service::wait_for(Service& dependency)
+{
+    VERIFY(!dependency.depends_on(*this));
+    m_dependencies.append(&dependency);
+    if (dependency.m_has_come_up)
+        return;
+    dependency.m_dependents.append(this);
+    ++m_pending_dependency_count;
+}
+
+bool Service::depends_on(Service const& other) const
+{
+    return any_of(m_dependencies, [&](auto* dependency) { return dependency == &other || dependency->depends_on(other); });
+}
+
+void Service::did_come_up()
+{
+    if (m_has_come_up)
+        return;
+    m_has_come_up = true;
+
+    for (auto* dependent : m_dependents) {
+        VERIFY(dependent->m_pending_dependency_count > 0);
+        if (--dependent->m_pending_dependency_count > 0)
+            continue;
+        dbgln_if(SYSTEMSERVER_DEBUG, "Activating {} now that {} is up", dependent->name(), name());
+        if (auto result = dependent->activate(); result.is_error())
+            dbgln("{}: {}", dependent->name(), result.release_error());
+    }
+    m_dependents.clear();
 }
 
 ErrorOr<void> Service::change_privileges()
@@ -239,6 +282,8 @@ ErrorOr<void> Service::spawn(int socket_fd)
         s_service_map.set(pid, this);
     }
 
+    dbgln("Service {} spawned as PID {}, {} ms after boot", name(), pid, MonotonicTime::now().milliseconds());
+
     return {};
 }
 
@@ -257,8 +302,10 @@ ErrorOr<void> Service::did_exit(int status)
     s_service_map.remove(m_pid);
     m_pid = -1;
 
-    if (!m_keep_alive)
+    if (!m_keep_alive) {
+        did_come_up();
         return {};
+    }
 
     auto run_time = m_run_timer.elapsed_time();
     bool exited_successfully = WIFEXITED(status) && WEXITSTATUS(status) == 0;
@@ -321,6 +368,7 @@ Service::Service(Core::ConfigFile const& config, StringView name)
     m_system_modes = config.read_entry(name, "SystemModes", "graphical").split(',');
     m_multi_instance = config.read_bool_entry(name, "MultiInstance");
     m_accept_socket_connections = config.read_bool_entry(name, "AcceptSocketConnections");
+    m_after = config.read_entry(name, "After").split(',');
 
     ByteString socket_entry = config.read_entry(name, "Socket");
     ByteString socket_permissions_entry = config.read_entry(name, "SocketPermissions", "0600");
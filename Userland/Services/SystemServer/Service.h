@@ -27,6 +27,11 @@ public:
 
     ErrorOr<void> setup_sockets();
 
+    Vector<ByteString> const& after() const { return m_after; }
+    // Holds off activating this service until the given one has come up.
+    void wait_for(Service&);
+    bool depends_on(Service const&) const;
+
     static Service* find_by_pid(pid_t);
 
 private:
@@ -76,6 +81,8 @@ private:
     ByteString m_environment;
     // Socket descriptors for this service.
     Vector<SocketDescriptor> m_sockets;
+    // Names of the services that have to come up before this one is activated.
+    Vector<ByteString> m_after;
 
     // The resolved user account to run this service as.
     Optional<Core::Account> m_account;
@@ -91,6 +98,13 @@ private:
     // times where it has exited unsuccessfully and too quickly.
     int m_restart_attempts { 0 };
 
+    // The services we wait for, and the ones waiting for us.
+    Vector<Service*> m_dependencies;
+    Vector<Service*> m_dependents;
+    size_t m_pending_dependency_count { 0 };
+    bool m_has_come_up { false };
+
+    void did_come_up();
     ErrorOr<void> setup_socket(SocketDescriptor&);
     void setup_notifier();
     ErrorOr<void> handle_socket_connection();
@@ -216,7 +216,23 @@ static ErrorOr<void> activate_services(Core::ConfigFile const& config)
             g_services.append(move(service));
         }
     }
+    for (auto& service : g_services) {
+        for (auto const& name : service->after()) {
+            auto dependency = g_services.find_if([&](auto& other) { return other->name() == name; });
+            if (dependency.is_end()) {
+                dbgln("{}: Not waiting for {}, which isn't enabled", service->name(), name);
+                continue;
+            }
+            if ((*dependency)->depends_on(*service) || *dependency == service) {
+                dbgln("{}: Not waiting for {}, which would wait for {} in turn", service->name(), name, service->name());
+                continue;
+            }
+            service->wait_for(**dependency);
+        }
+    }
+
     // After we've set them all up, activate them!
+    // Services that wait for others are activated once those have come up.
     dbgln("Activating {} services...", g_services.size());
     for (auto& service : g_services) {
         dbgln_if(SYSTEMSERVER_DEBUG, "Activating {}", service->name());
@@ -247,14 +263,15 @@ static ErrorOr<void> activate_base_services_based_on_system_mode()
 {
     if (g_system_mode == graphical_system_mode) {
         bool found_gpu_device = false;
-        for (int attempt = 0; attempt < 10; attempt++) {
+        // NOTE: Poll often, so we don't hold up the rest of the boot for long once the device shows up.
+        for (int attempt = 0; attempt < 100; attempt++) {
             struct stat file_state;
             int rc = lstat("/dev/gpu/connector0", &file_state);
             if (rc == 0) {
                 found_gpu_device = true;
                 break;
             }
-            sleep(1);
+            usleep(100'000);
         }
         if (!found_gpu_device) {
             dbgln("WARNING: No device nodes at /dev/gpu/ directory after 10 seconds. This is probably a sign of disabled graphics functionality.");
@@ -11,6 +11,7 @@
 
 #include <AK/JsonObject.h>
 #include <AK/QuickSort.h>
+#include <LibCore/TraceEvent.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/Font/FontDatabase.h>
 #include <LibGfx/SystemTheme.h>
@@ -816,6 +817,16 @@ Messages::WebContentServer::DumpGcGraphResponse ConnectionFromClient::dump_gc_gr
     return MUST(String::from_byte_string(gc_graph_json.to_byte_string()));
 }
 
+void ConnectionFromClient::set_tracing_enabled(u64, bool enabled)
+{
+    Core::TraceEvent::set_enabled(enabled);
+}
+
+Messages::WebContentServer::TakeTraceEventsResponse ConnectionFromClient::take_trace_events(u64)
+{
+    return Core::TraceEvent::take_events_as_json();
+}
+
 Messages::WebContentServer::GetSelectedTextResponse ConnectionFromClient::get_selected_text(u64 page_id)
 {
     if (auto page = this->page(page_id); page.has_value())
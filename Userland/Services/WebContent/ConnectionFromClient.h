@@ -124,6 +124,9 @@ private:
 
     virtual Messages::WebContentServer::DumpGcGraphResponse dump_gc_graph(u64 page_id) override;
 
+    virtual void set_tracing_enabled(u64 page_id, bool enabled) override;
+    virtual Messages::WebContentServer::TakeTraceEventsResponse take_trace_events(u64 page_id) override;
+
     virtual Messages::WebContentServer::GetLocalStorageEntriesResponse get_local_storage_entries(u64 page_id) override;
     virtual Messages::WebContentServer::GetSessionStorageEntriesResponse get_session_storage_entries(u64 page_id) override;
 
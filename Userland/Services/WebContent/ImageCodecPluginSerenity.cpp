@@ -14,6 +14,16 @@ ImageCodecPluginSerenity::ImageCodecPluginSerenity() = default;
 ImageCodecPluginSerenity::~ImageCodecPluginSerenity() = default;
 
 NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> ImageCodecPluginSerenity::decode_image(ReadonlyBytes bytes, Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected)
+{
+    return start_decoding(bytes, move(on_resolved), move(on_rejected), IsPartialData::No);
+}
+
+NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> ImageCodecPluginSerenity::decode_partial_image(ReadonlyBytes bytes, Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected)
+{
+    return start_decoding(bytes, move(on_resolved), move(on_rejected), IsPartialData::Yes);
+}
+
+NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> ImageCodecPluginSerenity::start_decoding(ReadonlyBytes bytes, Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, IsPartialData is_partial_data)
 {
     if (!m_client) {
         m_client = ImageDecoderClient::Client::try_create().release_value_but_fixme_should_propagate_errors();
@@ -28,22 +38,25 @@ NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> ImageCodecPluginSereni
     if (on_rejected)
         promise->on_rejection = move(on_rejected);
 
-    auto image_decoder_promise = m_client->decode_image(
-        bytes,
-        [promise](ImageDecoderClient::DecodedImage& result) -> ErrorOr<void> {
-            // FIXME: Remove this codec plugin and just use the ImageDecoderClient directly to avoid these copies
-            Web::Platform::DecodedImage decoded_image;
-            decoded_image.is_animated = result.is_animated;
-            decoded_image.loop_count = result.loop_count;
-            for (auto const& frame : result.frames) {
-                decoded_image.frames.empend(move(frame.bitmap), frame.duration);
-            }
-            promise->resolve(move(decoded_image));
-            return {};
-        },
-        [promise](auto& error) {
-            promise->reject(Error::copy(error));
-        });
+    auto on_decoded = [promise](ImageDecoderClient::DecodedImage& result) -> ErrorOr<void> {
+        // FIXME: Remove this codec plugin and just use the ImageDecoderClient directly to avoid these copies
+        Web::Platform::DecodedImage decoded_image;
+        decoded_image.is_animated = result.is_animated;
+        decoded_image.loop_count = result.loop_count;
+        for (auto const& frame : result.frames) {
+            decoded_image.frames.empend(move(frame.bitmap), frame.duration);
+        }
+        promise->resolve(move(decoded_image));
+        return {};
+    };
+    auto on_failed = [promise](auto& error) {
+        promise->reject(Error::copy(error));
+    };
+
+    if (is_partial_data == IsPartialData::Yes)
+        m_client->decode_partial_image(bytes, move(on_decoded), move(on_failed));
+    else
+        m_client->decode_image(bytes, move(on_decoded), move(on_failed));
 
     return promise;
 }
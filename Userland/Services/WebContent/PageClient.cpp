@@ -6,6 +6,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibCore/TraceEvent.h>
 #include <LibGfx/ShareableBitmap.h>
 #include <LibGfx/SystemTheme.h>
 #include <LibJS/Console.h>
@@ -217,6 +218,8 @@ void PageClient::paint(Web::DevicePixelRect const& content_rect, Gfx::Bitmap& ta
     paint_config.has_focus = m_has_focus;
     page().top_level_traversable()->paint(recording_painter, paint_config);
 
+    Core::TraceEventScope trace_event("paint"sv, "PageClient::rasterize"sv);
+
     if (s_use_gpu_painter) {
 #ifdef HAS_ACCELERATED_GRAPHICS
         Web::Painting::CommandExecutorGPU painting_command_executor(*m_accelerated_graphics_context, target);
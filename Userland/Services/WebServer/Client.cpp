@@ -19,7 +19,6 @@
 #include <LibCore/MappedFile.h>
 #include <LibCore/MimeData.h>
 #include <LibCore/System.h>
-#include <LibFileSystem/FileSystem.h>
 #include <LibHTTP/HttpRequest.h>
 #include <LibHTTP/HttpResponse.h>
 #include <LibURL/URL.h>
@@ -30,14 +29,19 @@
 
 namespace WebServer {
 
+// NOTE: Connections that are kept alive for further requests are closed after sitting idle for this long.
+static constexpr int idle_connection_timeout_ms = 30'000;
+
 Client::Client(NonnullOwnPtr<Core::BufferedTCPSocket> socket, Core::EventReceiver* parent)
     : Core::EventReceiver(parent)
     , m_socket(move(socket))
 {
+    m_idle_timer = Core::Timer::create_single_shot(idle_connection_timeout_ms, [this] { die(); }, this);
 }
 
 void Client::die()
 {
+    m_idle_timer->stop();
     m_socket->close();
     deferred_invoke([this] { remove_from_parent(); });
 }
@@ -59,6 +63,47 @@ void Client::start()
     };
 }
 
+// Returns the length of the first request in raw_request, or nothing if it hasn't been received completely yet.
+static ErrorOr<Optional<size_t>, HTTP::HttpRequest::ParseError> length_of_complete_request(StringView raw_request)
+{
+    auto end_of_headers = raw_request.find("\r\n\r\n"sv);
+    if (!end_of_headers.has_value()) {
+        // NOTE: This is the same limit HttpRequest::from_raw_request() puts on a single part of the request.
+        if (raw_request.length() > 65536)
+            return HTTP::HttpRequest::ParseError::RequestTooLarge;
+        return OptionalNone {};
+    }
+
+    size_t header_length = end_of_headers.value() + 4;
+    size_t content_length = 0;
+    for (auto line : raw_request.substring_view(0, end_of_headers.value()).split_view("\r\n"sv)) {
+        auto colon = line.find(':');
+        if (!colon.has_value() || !line.substring_view(0, colon.value()).equals_ignoring_ascii_case("Content-Length"sv))
+            continue;
+        content_length = line.substring_view(colon.value() + 1).trim_whitespace().to_number<size_t>().value_or(0);
+    }
+
+    if (raw_request.length() - header_length < content_length)
+        return OptionalNone {};
+    return header_length + content_length;
+}
+
+static bool should_keep_alive(StringView raw_request, HTTP::HttpRequest const& request)
+{
+    // HTTP/1.1 connections are persistent unless the client says otherwise, older ones only if the client asks for it.
+    auto request_line = raw_request.substring_view(0, raw_request.find("\r\n"sv).value_or(raw_request.length()));
+    bool keep_alive = request_line.ends_with(" HTTP/1.1"sv);
+
+    if (auto connection = request.headers().get("Connection"); connection.has_value()) {
+        auto value = connection->view().trim_whitespace();
+        if (value.equals_ignoring_ascii_case("close"sv))
+            keep_alive = false;
+        else if (value.equals_ignoring_ascii_case("keep-alive"sv))
+            keep_alive = true;
+    }
+    return keep_alive;
+}
+
 ErrorOr<void, Client::WrappedError> Client::on_ready_to_read()
 {
     // FIXME: Mostly copied from LibWeb/WebDriver/Client.cpp. As noted there, this should be move the LibHTTP and made spec compliant.
@@ -75,28 +120,94 @@ ErrorOr<void, Client::WrappedError> Client::on_ready_to_read()
             break;
     }
 
-    if (m_remaining_request.is_empty())
-        return {};
+    bool client_is_done_sending = m_socket->is_eof();
 
-    auto request = TRY(m_remaining_request.to_byte_buffer());
-    dbgln_if(WEBSERVER_DEBUG, "Got raw request: '{}'", ByteString::copy(request));
-
-    auto maybe_parsed_request = HTTP::HttpRequest::from_raw_request(TRY(m_remaining_request.to_byte_buffer()));
-    if (maybe_parsed_request.is_error()) {
-        if (maybe_parsed_request.error() == HTTP::HttpRequest::ParseError::RequestIncomplete) {
+    // Answer every complete request we have, so that pipelined requests are answered in the order they were sent.
+    while (!m_remaining_request.is_empty() && m_socket->is_open()) {
+        auto raw_request = m_remaining_request.string_view();
+        auto request_length = TRY(length_of_complete_request(raw_request));
+        if (!request_length.has_value()) {
             // If request is not complete we need to wait for more data to arrive
-            return {};
+            break;
         }
-        return maybe_parsed_request.error();
+
+        auto request = raw_request.substring_view(0, request_length.value());
+        dbgln_if(WEBSERVER_DEBUG, "Got raw request: '{}'", request);
+
+        auto maybe_parsed_request = HTTP::HttpRequest::from_raw_request(request.bytes());
+        if (maybe_parsed_request.is_error())
+            return maybe_parsed_request.error();
+        m_keep_alive = should_keep_alive(request, maybe_parsed_request.value());
+
+        StringBuilder remaining_request;
+        TRY(remaining_request.try_append(raw_request.substring_view(request_length.value())));
+        m_remaining_request = move(remaining_request);
+
+        m_idle_timer->stop();
+        TRY(handle_request(maybe_parsed_request.value()));
     }
 
-    m_remaining_request.clear();
+    if (!m_socket->is_open())
+        return {};
 
-    TRY(handle_request(maybe_parsed_request.value()));
+    if (client_is_done_sending) {
+        die();
+        return {};
+    }
 
+    m_idle_timer->restart();
     return {};
 }
 
+// Parses a Range header asking for a single range of bytes (RFC 9110, 14.2).
+// Returns an empty Optional if the header should be ignored and the whole file sent, and an error if the range can't be satisfied.
+ErrorOr<Optional<Client::ContentRange>> Client::parse_range_header(StringView value, u64 complete_length)
+{
+    auto ranges = value.trim_whitespace();
+    if (!ranges.starts_with("bytes="sv, CaseSensitivity::CaseInsensitive))
+        return OptionalNone {};
+    ranges = ranges.substring_view(6).trim_whitespace();
+
+    // NOTE: Sending multiple ranges would need a multipart/byteranges response, so we send the whole file instead.
+    if (ranges.contains(','))
+        return OptionalNone {};
+
+    auto dash = ranges.find('-');
+    if (!dash.has_value())
+        return OptionalNone {};
+    auto first_part = ranges.substring_view(0, dash.value()).trim_whitespace();
+    auto last_part = ranges.substring_view(dash.value() + 1).trim_whitespace();
+
+    ContentRange range { .first = 0, .last = 0, .complete_length = complete_length };
+    if (first_part.is_empty()) {
+        // A suffix range, asking for the last N bytes.
+        auto suffix_length = last_part.to_number<u64>();
+        if (!suffix_length.has_value())
+            return OptionalNone {};
+        if (suffix_length.value() == 0 || complete_length == 0)
+            return Error::from_errno(EINVAL);
+        range.first = complete_length - min(suffix_length.value(), complete_length);
+        range.last = complete_length - 1;
+        return range;
+    }
+
+    auto first = first_part.to_number<u64>();
+    if (!first.has_value())
+        return OptionalNone {};
+    if (first.value() >= complete_length)
+        return Error::from_errno(EINVAL);
+    range.first = first.value();
+    range.last = complete_length - 1;
+
+    if (!last_part.is_empty()) {
+        auto last = last_part.to_number<u64>();
+        if (!last.has_value() || last.value() < first.value())
+            return OptionalNone {};
+        range.last = min(last.value(), complete_length - 1);
+    }
+    return range;
+}
+
 ErrorOr<bool> Client::handle_request(HTTP::HttpRequest const& request)
 {
     auto resource_decoded = URL::percent_decode(request.resource());
@@ -130,14 +241,17 @@ ErrorOr<bool> Client::handle_request(HTTP::HttpRequest const& request)
 
     auto real_path = TRY(String::formatted("{}{}", Configuration::the().document_root_path(), requested_path));
 
-    if (FileSystem::is_directory(real_path.bytes_as_string_view())) {
+    // NOTE: A single stat() tells us everything we need to know about the path, instead of asking for each property separately.
+    auto st_or_error = Core::System::stat(real_path.bytes_as_string_view());
+    if (!st_or_error.is_error() && S_ISDIR(st_or_error.value().st_mode)) {
         if (!resource_decoded.ends_with('/')) {
             TRY(send_redirect(TRY(String::formatted("{}/", requested_path)), request));
             return true;
         }
 
         auto index_html_path = TRY(String::formatted("{}/index.html", real_path));
-        if (!FileSystem::exists(index_html_path)) {
+        auto index_html_st_or_error = Core::System::stat(index_html_path);
+        if (index_html_st_or_error.is_error()) {
             auto is_searchable_or_error = Core::System::access(real_path.bytes_as_string_view(), X_OK);
             if (is_searchable_or_error.is_error()) {
                 TRY(send_error_response(403, request));
@@ -148,12 +262,14 @@ ErrorOr<bool> Client::handle_request(HTTP::HttpRequest const& request)
             return true;
         }
         real_path = index_html_path;
+        st_or_error = index_html_st_or_error.release_value();
     }
 
-    if (!FileSystem::exists(real_path.bytes_as_string_view())) {
+    if (st_or_error.is_error()) {
         TRY(send_error_response(404, request));
         return false;
     }
+    auto st = st_or_error.release_value();
 
     auto is_readable_or_error = Core::System::access(real_path.bytes_as_string_view(), R_OK);
     if (is_readable_or_error.is_error()) {
@@ -161,45 +277,111 @@ ErrorOr<bool> Client::handle_request(HTTP::HttpRequest const& request)
         return false;
     }
 
-    if (FileSystem::is_device(real_path.bytes_as_string_view())) {
+    if (S_ISBLK(st.st_mode) || S_ISCHR(st.st_mode)) {
         TRY(send_error_response(403, request));
         return false;
     }
 
+    auto const complete_length = static_cast<u64>(st.st_size);
+    Optional<ContentRange> range;
+    if (auto range_header = request.headers().get("Range"); range_header.has_value()) {
+        auto range_or_error = parse_range_header(range_header->view(), complete_length);
+        if (range_or_error.is_error()) {
+            TRY(send_error_response(416, request, { TRY(String::formatted("Content-Range: bytes */{}", complete_length)) }));
+            return false;
+        }
+        range = range_or_error.release_value();
+    }
+
     auto stream = TRY(Core::File::open(real_path.bytes_as_string_view(), Core::File::OpenMode::Read));
 
     auto const info = ContentInfo {
         .type = TRY(String::from_utf8(Core::guess_mime_type_based_on_filename(real_path.bytes_as_string_view()))),
-        .length = static_cast<u64>(TRY(FileSystem::size_from_stat(real_path.bytes_as_string_view())))
+        .length = range.has_value() ? range->last - range->first + 1 : complete_length
     };
-    TRY(send_response(*stream, request, move(info)));
+    TRY(send_file_response(*stream, request, move(info), range));
     return true;
 }
 
-ErrorOr<void> Client::send_response(Stream& response, HTTP::HttpRequest const& request, ContentInfo content_info)
+ErrorOr<void> Client::send_response_header(HTTP::HttpRequest const& request, ContentInfo const& content_info, Optional<ContentRange> const& range)
 {
     StringBuilder builder;
-    TRY(builder.try_append("HTTP/1.0 200 OK\r\n"sv));
+    if (range.has_value())
+        TRY(builder.try_append("HTTP/1.1 206 Partial Content\r\n"sv));
+    else
+        TRY(builder.try_append("HTTP/1.1 200 OK\r\n"sv));
     TRY(builder.try_append("Server: WebServer (SerenityOS)\r\n"sv));
     TRY(builder.try_append("X-Frame-Options: SAMEORIGIN\r\n"sv));
     TRY(builder.try_append("X-Content-Type-Options: nosniff\r\n"sv));
     TRY(builder.try_append("Pragma: no-cache\r\n"sv));
+    TRY(builder.try_appendff("Connection: {}\r\n", m_keep_alive ? "keep-alive"sv : "close"sv));
     if (content_info.type == "text/plain")
         TRY(builder.try_appendff("Content-Type: {}; charset=utf-8\r\n", content_info.type));
     else
         TRY(builder.try_appendff("Content-Type: {}\r\n", content_info.type));
     TRY(builder.try_appendff("Content-Length: {}\r\n", content_info.length));
+    if (range.has_value())
+        TRY(builder.try_appendff("Content-Range: bytes {}-{}/{}\r\n", range->first, range->last, range->complete_length));
     TRY(builder.try_append("\r\n"sv));
 
     auto builder_contents = TRY(builder.to_byte_buffer());
     TRY(m_socket->write_until_depleted(builder_contents));
-    log_response(200, request);
+    log_response(range.has_value() ? 206 : 200, request);
+    return {};
+}
+
+ErrorOr<void> Client::send_file_response(Core::File& file, HTTP::HttpRequest const& request, ContentInfo content_info, Optional<ContentRange> const& range)
+{
+    off_t offset = range.has_value() ? static_cast<off_t>(range->first) : 0;
+
+#if defined(AK_OS_SERENITY) || defined(AK_OS_LINUX)
+    auto socket_fd = m_socket->fd();
+    if (!socket_fd.has_value())
+        return Error::from_errno(ENOTCONN);
+
+    TRY(send_response_header(request, content_info, range));
+
+    // Let the kernel move the file into the socket, instead of copying it in and out of our address space.
+    u64 remaining = content_info.length;
+    bool sent_anything = false;
+    while (remaining > 0) {
+        auto nsent_or_error = Core::System::sendfile(socket_fd.value(), file.fd(), &offset, min(remaining, static_cast<u64>(NumericLimits<ssize_t>::max())));
+        if (nsent_or_error.is_error()) {
+            if (!sent_anything && nsent_or_error.error().code() == EINVAL) {
+                TRY(file.seek(offset, SeekMode::SetPosition));
+                return send_response_body(file, remaining);
+            }
+            return nsent_or_error.release_error();
+        }
+        if (nsent_or_error.value() == 0)
+            break;
+        sent_anything = true;
+        remaining -= nsent_or_error.value();
+    }
+
+    finish_response();
+    return {};
+#else
+    TRY(file.seek(offset, SeekMode::SetPosition));
+    TRY(send_response_header(request, content_info, range));
+    return send_response_body(file, content_info.length);
+#endif
+}
+
+ErrorOr<void> Client::send_response(Stream& response, HTTP::HttpRequest const& request, ContentInfo content_info)
+{
+    TRY(send_response_header(request, content_info));
+    return send_response_body(response, content_info.length);
+}
 
+ErrorOr<void> Client::send_response_body(Stream& response, u64 length)
+{
     char buffer[PAGE_SIZE];
-    do {
-        auto size = TRY(response.read_some({ buffer, sizeof(buffer) })).size();
+    while (length > 0) {
+        auto size = TRY(response.read_some({ buffer, min(sizeof(buffer), length) })).size();
         if (response.is_eof() && size == 0)
             break;
+        length -= size;
 
         ReadonlyBytes write_buffer { buffer, size };
         while (!write_buffer.is_empty()) {
@@ -211,32 +393,34 @@ ErrorOr<void> Client::send_response(Stream& response, HTTP::HttpRequest const& r
 
             write_buffer = write_buffer.slice(nwritten);
         }
-    } while (true);
-
-    auto keep_alive = false;
-    if (auto it = request.headers().headers().find_if([](auto& header) { return header.name.equals_ignoring_ascii_case("Connection"sv); }); !it.is_end()) {
-        if (it->value.trim_whitespace().equals_ignoring_ascii_case("keep-alive"sv))
-            keep_alive = true;
     }
-    if (!keep_alive)
-        m_socket->close();
 
+    finish_response();
     return {};
 }
 
+void Client::finish_response()
+{
+    if (!m_keep_alive)
+        die();
+}
+
 ErrorOr<void> Client::send_redirect(StringView redirect_path, HTTP::HttpRequest const& request)
 {
     StringBuilder builder;
-    TRY(builder.try_append("HTTP/1.0 301 Moved Permanently\r\n"sv));
+    TRY(builder.try_append("HTTP/1.1 301 Moved Permanently\r\n"sv));
     TRY(builder.try_append("Location: "sv));
     TRY(builder.try_append(redirect_path));
     TRY(builder.try_append("\r\n"sv));
+    TRY(builder.try_appendff("Connection: {}\r\n", m_keep_alive ? "keep-alive"sv : "close"sv));
+    TRY(builder.try_append("Content-Length: 0\r\n"sv));
     TRY(builder.try_append("\r\n"sv));
 
     auto builder_contents = TRY(builder.to_byte_buffer());
     TRY(m_socket->write_until_depleted(builder_contents));
 
     log_response(301, request);
+    finish_response();
     return {};
 }
 
@@ -353,7 +537,7 @@ ErrorOr<void> Client::send_error_response(unsigned code, HTTP::HttpRequest const
     TRY(content_builder.try_append("</h1></body></html>"sv));
 
     StringBuilder header_builder;
-    TRY(header_builder.try_appendff("HTTP/1.0 {} ", code));
+    TRY(header_builder.try_appendff("HTTP/1.1 {} ", code));
     TRY(header_builder.try_append(reason_phrase));
     TRY(header_builder.try_append("\r\n"sv));
 
@@ -361,6 +545,7 @@ ErrorOr<void> Client::send_error_response(unsigned code, HTTP::HttpRequest const
         TRY(header_builder.try_append(header));
         TRY(header_builder.try_append("\r\n"sv));
     }
+    TRY(header_builder.try_appendff("Connection: {}\r\n", m_keep_alive ? "keep-alive"sv : "close"sv));
     TRY(header_builder.try_append("Content-Type: text/html; charset=UTF-8\r\n"sv));
     TRY(header_builder.try_appendff("Content-Length: {}\r\n", content_builder.length()));
     TRY(header_builder.try_append("\r\n"sv));
@@ -368,6 +553,7 @@ ErrorOr<void> Client::send_error_response(unsigned code, HTTP::HttpRequest const
     TRY(m_socket->write_until_depleted(TRY(content_builder.to_byte_buffer())));
 
     log_response(code, request);
+    finish_response();
     return {};
 }
 
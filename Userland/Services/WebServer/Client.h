@@ -9,7 +9,9 @@
 
 #include <AK/String.h>
 #include <LibCore/EventReceiver.h>
+#include <LibCore/Forward.h>
 #include <LibCore/Socket.h>
+#include <LibCore/Timer.h>
 #include <LibHTTP/Forward.h>
 #include <LibHTTP/HttpRequest.h>
 
@@ -31,9 +33,22 @@ private:
         u64 length {};
     };
 
+    // The inclusive range of bytes a 206 (Partial Content) response sends out of a file of complete_length bytes.
+    struct ContentRange {
+        u64 first {};
+        u64 last {};
+        u64 complete_length {};
+    };
+
+    static ErrorOr<Optional<ContentRange>> parse_range_header(StringView, u64 complete_length);
+
     ErrorOr<void, WrappedError> on_ready_to_read();
     ErrorOr<bool> handle_request(HTTP::HttpRequest const&);
     ErrorOr<void> send_response(Stream&, HTTP::HttpRequest const&, ContentInfo);
+    ErrorOr<void> send_file_response(Core::File&, HTTP::HttpRequest const&, ContentInfo, Optional<ContentRange> const&);
+    ErrorOr<void> send_response_header(HTTP::HttpRequest const&, ContentInfo const&, Optional<ContentRange> const& = {});
+    ErrorOr<void> send_response_body(Stream&, u64 length);
+    void finish_response();
     ErrorOr<void> send_redirect(StringView redirect, HTTP::HttpRequest const&);
     ErrorOr<void> send_error_response(unsigned code, HTTP::HttpRequest const&, Vector<String> const& headers = {});
     void die();
@@ -43,6 +58,8 @@ private:
 
     NonnullOwnPtr<Core::BufferedTCPSocket> m_socket;
     StringBuilder m_remaining_request;
+    bool m_keep_alive { false };
+    RefPtr<Core::Timer> m_idle_timer;
 };
 
 }
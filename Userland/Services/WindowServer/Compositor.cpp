@@ -47,12 +47,12 @@ static WallpaperMode mode_to_enum(ByteString const& name)
 Compositor::Compositor()
 {
     m_display_link_notify_timer = add<Core::Timer>(
-        1000 / 60, [this] {
+        frame_interval_ms, [this] {
             notify_display_links();
         });
 
     m_compose_timer = Core::Timer::create_single_shot(
-        1000 / 60,
+        frame_interval_ms,
         [this] {
             compose();
         },
@@ -603,6 +603,15 @@ void Compositor::compose()
         flush(screen);
         return IterationDecision::Continue;
     });
+
+    // Let display link clients know right away that their last frame made it to the screen,
+    // so that they render the next one into the upcoming compose rather than some time after it.
+    // The timer only ticks them if nothing is composed for a whole frame, and we don't tick them
+    // again for composes that follow each other closely, e.g. while the cursor is moving.
+    if (m_display_link_count && MonotonicTime::now_coarse() - m_last_display_link_notification >= Duration::from_milliseconds(frame_interval_ms / 2)) {
+        notify_display_links();
+        m_display_link_notify_timer->restart();
+    }
 }
 
 void Compositor::flush(Screen& screen)
@@ -640,21 +649,33 @@ void Compositor::flush(Screen& screen)
         }
     }
 
+    auto scale_factor = screen.scale_factor();
+    u64 pixels_composed = 0;
+    auto& flush_rects = screen_data.m_coalesced_flush_rects;
+    flush_rects.clear_with_capacity();
+    for (auto* rects : { &screen_data.m_flush_rects, &screen_data.m_flush_transparent_rects, &screen_data.m_flush_special_rects }) {
+        for (auto& rect : rects->rects())
+            pixels_composed += static_cast<u64>(rect.size().area()) * scale_factor * scale_factor;
+        flush_rects.add(*rects);
+    }
+
+    // Every flushed rect costs a row loop setup and a flush request to the device on top of
+    // copying its pixels, so copying a few unchanged pixels to save rects is worth it. This
+    // is safe because outside of the rects we're flushing, both buffers hold the same pixels.
+    static constexpr int flush_rect_overhead_in_pixels = 64 * 64;
+    flush_rects.coalesce(flush_rect_overhead_in_pixels);
+
     if (device_can_flush_buffers && screen_data.m_screen_can_set_buffer) {
         if (!screen_data.m_has_flipped) {
             // If we have not flipped any buffers before, we should be flushing
             // the entire buffer to make sure that the device has all the bits we wrote
-            screen_data.m_flush_rects = { screen.rect() };
+            flush_rects = { screen.rect() };
         }
 
         // If we also support buffer flipping we need to make sure we transfer all
         // updated areas to the device before we flip. We already modified the framebuffer
         // memory, but the device needs to know what areas we actually did update.
-        for (auto& rect : screen_data.m_flush_rects.rects())
-            screen.queue_flush_display_rect(rect.translated(-screen_rect.location()));
-        for (auto& rect : screen_data.m_flush_transparent_rects.rects())
-            screen.queue_flush_display_rect(rect.translated(-screen_rect.location()));
-        for (auto& rect : screen_data.m_flush_special_rects.rects())
+        for (auto& rect : flush_rects.rects())
             screen.queue_flush_display_rect(rect.translated(-screen_rect.location()));
 
         screen.flush_display((!screen_data.m_screen_can_set_buffer || screen_data.m_buffers_are_flipped) ? 0 : 1);
@@ -665,6 +686,7 @@ void Compositor::flush(Screen& screen)
         screen_data.m_has_flipped = true;
     }
 
+    u64 pixels_flushed = 0;
     auto do_flush = [&](Gfx::IntRect rect) {
         VERIFY(screen_rect.contains(rect));
         rect.translate_by(-screen_rect.location());
@@ -672,7 +694,8 @@ void Compositor::flush(Screen& screen)
         // Almost everything in Compositor is in logical coordinates, with the painters having
         // a scale applied. But this routine accesses the backbuffer pixels directly, so it
         // must work in physical coordinates.
-        auto scaled_rect = rect * screen.scale_factor();
+        auto scaled_rect = rect * scale_factor;
+        pixels_flushed += static_cast<u64>(scaled_rect.size().area());
         Gfx::ARGB32* front_ptr = screen_data.m_front_bitmap->scanline(scaled_rect.y()) + scaled_rect.x();
         Gfx::ARGB32* back_ptr = screen_data.m_back_bitmap->scanline(scaled_rect.y()) + scaled_rect.x();
         size_t pitch = screen_data.m_back_bitmap->pitch();
@@ -709,12 +732,16 @@ void Compositor::flush(Screen& screen)
             screen.queue_flush_display_rect(rect);
         }
     };
-    for (auto& rect : screen_data.m_flush_rects.rects())
-        do_flush(rect);
-    for (auto& rect : screen_data.m_flush_transparent_rects.rects())
-        do_flush(rect);
-    for (auto& rect : screen_data.m_flush_special_rects.rects())
+    for (auto& rect : flush_rects.rects())
         do_flush(rect);
+
+    auto& statistics = screen_data.m_statistics;
+    ++statistics.frames;
+    statistics.pixels_composed += pixels_composed;
+    statistics.pixels_flushed += pixels_flushed;
+    statistics.last_frame_pixels_composed = pixels_composed;
+    statistics.last_frame_pixels_flushed = pixels_flushed;
+
     if (device_can_flush_buffers && !screen_data.m_screen_can_set_buffer) {
         // If we also support flipping buffers we don't really need to flush these areas right now.
         // Instead, we skip this step and just keep track of them until shortly before the next flip.
@@ -1055,6 +1082,7 @@ void Compositor::update_fonts()
 
 void Compositor::notify_display_links()
 {
+    m_last_display_link_notification = MonotonicTime::now_coarse();
     ConnectionFromClient::for_each_client([](auto& client) {
         client.notify_display_link({});
     });
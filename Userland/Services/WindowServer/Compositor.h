@@ -8,6 +8,7 @@
 
 #include <AK/OwnPtr.h>
 #include <AK/RefPtr.h>
+#include <AK/Time.h>
 #include <LibCore/EventReceiver.h>
 #include <LibGfx/Color.h>
 #include <LibGfx/DisjointRectSet.h>
@@ -32,6 +33,14 @@ enum class WallpaperMode {
     Unchecked
 };
 
+struct CompositorStatistics {
+    u64 frames { 0 };
+    u64 pixels_composed { 0 };
+    u64 pixels_flushed { 0 };
+    u64 last_frame_pixels_composed { 0 };
+    u64 last_frame_pixels_flushed { 0 };
+};
+
 struct CompositorScreenData {
     RefPtr<Gfx::Bitmap> m_front_bitmap;
     RefPtr<Gfx::Bitmap> m_back_bitmap;
@@ -54,6 +63,9 @@ struct CompositorScreenData {
     Gfx::DisjointIntRectSet m_flush_rects;
     Gfx::DisjointIntRectSet m_flush_transparent_rects;
     Gfx::DisjointIntRectSet m_flush_special_rects;
+    Gfx::DisjointIntRectSet m_coalesced_flush_rects;
+
+    CompositorStatistics m_statistics;
 
     Gfx::Painter& overlay_painter() { return *m_temp_painter; }
 
@@ -214,6 +226,8 @@ private:
     void finish_window_stack_switch();
     void update_wallpaper_bitmap();
 
+    static constexpr int frame_interval_ms = 1000 / 60;
+
     RefPtr<Core::Timer> m_compose_timer;
     RefPtr<Core::Timer> m_immediate_compose_timer;
     bool m_flash_flush { false };
@@ -241,6 +255,7 @@ private:
 
     RefPtr<Core::Timer> m_display_link_notify_timer;
     size_t m_display_link_count { 0 };
+    MonotonicTime m_last_display_link_notification { MonotonicTime::now_coarse() };
 
     WindowStack* m_current_window_stack { nullptr };
     WindowStack* m_transitioning_to_window_stack { nullptr };
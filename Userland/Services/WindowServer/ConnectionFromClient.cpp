@@ -1357,6 +1357,15 @@ void ConnectionFromClient::set_flash_flush(bool enabled)
     Compositor::the().set_flash_flush(enabled);
 }
 
+Messages::WindowServer::GetCompositorStatisticsResponse ConnectionFromClient::get_compositor_statistics(u32 screen_index)
+{
+    auto* screen = Screen::find_by_index(screen_index);
+    if (!screen)
+        return { false, 0, 0, 0, 0, 0 };
+    auto const& statistics = screen->compositor_screen_data().m_statistics;
+    return { true, statistics.frames, statistics.pixels_composed, statistics.pixels_flushed, statistics.last_frame_pixels_composed, statistics.last_frame_pixels_flushed };
+}
+
 void ConnectionFromClient::set_window_parent_from_client(i32 client_id, i32 parent_id, i32 child_id)
 {
     auto* child_window = window_from_id(child_id);
@@ -1786,7 +1786,7 @@ ErrorOr<void> Execute::for_each_entry(RefPtr<Shell> shell, Function<ErrorOr<Iter
         };
 
         notifier->on_activation = [&]() -> void {
-            constexpr static auto buffer_size = 16;
+            constexpr static auto buffer_size = 4 * KiB;
             u8 buffer[buffer_size];
             size_t remaining_size = buffer_size;
 
@@ -1799,7 +1799,11 @@ ErrorOr<void> Execute::for_each_entry(RefPtr<Shell> shell, Function<ErrorOr<Iter
                         notifier->set_type(Core::Notifier::Type::Read);
                 } };
 
-                if (check_and_call().release_value_but_fixme_should_propagate_errors() == Break) {
+                // A single read can bring in many entries, so hand all the complete ones out before reading more.
+                auto result = CheckResult::Continue;
+                while (result == CheckResult::Continue)
+                    result = check_and_call().release_value_but_fixme_should_propagate_errors();
+                if (result == Break) {
                     loop.quit(Break);
                     return;
                 }
@@ -817,6 +817,11 @@ ErrorOr<RefPtr<Job>> Shell::run_command(const AST::Command& command)
 
     argv.append(nullptr);
 
+    // Look the executable up before forking, so that finding it again next time doesn't have to search PATH.
+    Optional<ByteString> executable_path;
+    if (!command.should_immediately_execute_next && !has_builtin(command.argv.first()) && !has_function(command.argv.first()))
+        executable_path = resolve_executable(copy_argv[0]);
+
     auto sync_pipe = TRY(Core::System::pipe2(0));
     auto child = TRY(Core::System::fork());
 
@@ -873,7 +878,7 @@ ErrorOr<RefPtr<Job>> Shell::run_command(const AST::Command& command)
         // We no longer need the jobs here.
         jobs.clear();
 
-        execute_process(move(argv));
+        execute_process(move(argv), executable_path);
         VERIFY_NOT_REACHED();
     }
 
@@ -968,7 +973,32 @@ ErrorOr<void> Shell::execute_process(Span<StringView> argv)
     execute_process(move(args));
 }
 
-void Shell::execute_process(Vector<char const*>&& argv)
+Optional<ByteString> Shell::resolve_executable(StringView name)
+{
+    if (name.contains('/'))
+        return {};
+
+    ByteString path = getenv("PATH");
+    if (path != m_resolved_executables_path) {
+        m_resolved_executables.clear();
+        m_resolved_executables_path = move(path);
+    }
+
+    if (auto executable_path = m_resolved_executables.get(name); executable_path.has_value())
+        return executable_path.release_value();
+
+    auto executable_path_or_error = Core::System::resolve_executable_from_environment(name);
+    if (executable_path_or_error.is_error())
+        return {};
+    auto executable_path = executable_path_or_error.release_value().to_byte_string();
+
+    // Relative entries in PATH depend on the current working directory, so only remember absolute paths.
+    if (executable_path.starts_with('/'))
+        m_resolved_executables.set(name, executable_path);
+    return executable_path;
+}
+
+void Shell::execute_process(Vector<char const*>&& argv, Optional<ByteString> const& executable_path)
 {
     for (auto& promise : m_active_promises) {
         MUST(Core::System::pledge("stdio rpath exec"sv, promise.data.exec_promises));
@@ -976,6 +1006,11 @@ void Shell::execute_process(Vector<char const*>&& argv)
             MUST(Core::System::unveil(item.path, item.access));
     }
 
+    // NOTE: If this fails (e.g. because the executable has been moved since it was looked up),
+    //       execvp() below gets to search PATH again and report errors as usual.
+    if (executable_path.has_value())
+        (void)execv(executable_path->characters(), const_cast<char* const*>(argv.data()));
+
     int rc = execvp(argv[0], const_cast<char* const*>(argv.data()));
     if (rc < 0) {
         auto parts = StringView { argv[0], strlen(argv[0]) }.split_view('/');
@@ -1490,10 +1525,15 @@ void Shell::cache_path()
     for (auto const& builtin_name : builtin_names)
         cached_path.append({ RunnablePath::Kind::Builtin, escape_token(builtin_name) });
 
+    // NOTE: Earlier kinds shadow later ones, this keeps track of what's been added so far.
+    HashTable<ByteString> cached_names;
+    for (auto const& entry : cached_path)
+        cached_names.set(entry.path);
+
     // Add functions to the cache.
     for (auto& function : m_functions) {
         auto name = escape_token(function.key);
-        if (cached_path.contains_slow(name))
+        if (cached_names.set(name) != HashSetResult::InsertedNewEntry)
             continue;
         cached_path.append({ RunnablePath::Kind::Function, name });
     }
@@ -1501,7 +1541,7 @@ void Shell::cache_path()
     // Add aliases to the cache.
     for (auto const& alias : m_aliases) {
         auto name = escape_token(alias.key);
-        if (cached_path.contains_slow(name))
+        if (cached_names.set(name) != HashSetResult::InsertedNewEntry)
             continue;
         cached_path.append({ RunnablePath::Kind::Alias, name });
     }
@@ -1514,12 +1554,14 @@ void Shell::cache_path()
             Core::DirIterator programs(directory.characters(), Core::DirIterator::SkipDots);
             while (programs.has_next()) {
                 auto program = programs.next_path();
-                auto program_path = ByteString::formatted("{}/{}", directory, program);
                 auto escaped_name = escape_token(program);
-                if (cached_path.contains_slow(escaped_name))
+                if (cached_names.contains(escaped_name))
                     continue;
-                if (access(program_path.characters(), X_OK) == 0)
+                auto program_path = ByteString::formatted("{}/{}", directory, program);
+                if (access(program_path.characters(), X_OK) == 0) {
+                    cached_names.set(escaped_name);
                     cached_path.append({ RunnablePath::Kind::Executable, escaped_name });
+                }
             }
         }
     }
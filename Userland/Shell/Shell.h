@@ -448,7 +448,8 @@ private:
     void run_tail(RefPtr<Job>);
     void run_tail(const AST::Command&, const AST::NodeWithAction&, int head_exit_code);
 
-    [[noreturn]] void execute_process(Vector<char const*>&& argv);
+    [[noreturn]] void execute_process(Vector<char const*>&& argv, Optional<ByteString> const& executable_path = {});
+    Optional<ByteString> resolve_executable(StringView name);
     ErrorOr<void> execute_process(Span<StringView> argv);
 
     virtual void custom_event(Core::CustomEvent&) override;
@@ -500,6 +501,10 @@ private:
     Vector<NonnullRefPtr<AST::Redirection>> m_global_redirections;
 
     HashMap<ByteString, ByteString> m_aliases;
+
+    // Where commands were found in PATH, which is only valid for as long as PATH is m_resolved_executables_path.
+    HashMap<ByteString, ByteString> m_resolved_executables;
+    ByteString m_resolved_executables_path;
     bool m_is_interactive { true };
     bool m_is_subshell { false };
     bool m_should_reinstall_signal_handlers { true };
@@ -39,6 +39,24 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
     Array<u8, 32768> buffer;
     for (auto const& file : files) {
+#if defined(AK_OS_SERENITY) || defined(AK_OS_LINUX)
+        // Let the kernel move the data to stdout, and only fall back to copying it ourselves if it can't.
+        bool sent_anything = false;
+        while (true) {
+            auto nsent_or_error = Core::System::sendfile(STDOUT_FILENO, file->fd(), nullptr, buffer.size());
+            if (nsent_or_error.is_error()) {
+                if (sent_anything || nsent_or_error.error().code() != EINVAL)
+                    return nsent_or_error.release_error();
+                break;
+            }
+            if (nsent_or_error.value() == 0)
+                break;
+            sent_anything = true;
+        }
+        if (sent_anything)
+            continue;
+#endif
+
         while (!file->is_eof()) {
             auto const buffer_span = TRY(file->read_some(buffer));
             out("{:s}", buffer_span);
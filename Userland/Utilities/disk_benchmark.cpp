@@ -7,6 +7,10 @@
 
 #include <AK/ByteBuffer.h>
 #include <AK/ByteString.h>
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <AK/QuickSort.h>
+#include <AK/Random.h>
 #include <AK/ScopeGuard.h>
 #include <AK/Types.h>
 #include <AK/Vector.h>
@@ -14,19 +18,20 @@
 #include <LibCore/ElapsedTimer.h>
 #include <LibCore/System.h>
 #include <LibMain/Main.h>
+#include <LibThreading/Thread.h>
 #include <fcntl.h>
 #include <stdio.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
-struct Result {
+struct SequentialResult {
     u64 write_bps {};
     u64 read_bps {};
 };
 
-static Result average_result(Vector<Result> const& results)
+static SequentialResult average_result(Vector<SequentialResult> const& results)
 {
-    Result average;
+    SequentialResult average;
 
     for (auto& res : results) {
         average.write_bps += res.write_bps;
@@ -39,7 +44,34 @@ static Result average_result(Vector<Result> const& results)
     return average;
 }
 
-static ErrorOr<Result> benchmark(ByteString const& filename, int file_size, ByteBuffer& buffer, bool allow_cache);
+struct RandomResult {
+    u64 reads {};
+    u64 writes {};
+    u64 bytes {};
+    Duration elapsed;
+    // Sorted, in nanoseconds.
+    Vector<u64> latencies;
+};
+
+struct RandomOptions {
+    size_t file_size {};
+    size_t block_size {};
+    size_t jobs {};
+    int read_percentage {};
+    Duration duration;
+    bool allow_cache {};
+};
+
+static ErrorOr<SequentialResult> benchmark(ByteString const& filename, int file_size, ByteBuffer& buffer, bool allow_cache);
+static ErrorOr<RandomResult> benchmark_random(ByteString const& filename, RandomOptions const&);
+
+static double latency_percentile_in_microseconds(Vector<u64> const& sorted_latencies, double percentile)
+{
+    if (sorted_latencies.is_empty())
+        return 0;
+    auto index = min(static_cast<size_t>(sorted_latencies.size() * percentile / 100.0), sorted_latencies.size() - 1);
+    return sorted_latencies[index] / 1000.0;
+}
 
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
@@ -50,6 +82,10 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     Vector<size_t> file_sizes;
     Vector<size_t> block_sizes;
     bool allow_cache = false;
+    StringView mode = "sequential"sv;
+    int read_percentage = 50;
+    size_t jobs = 1;
+    bool print_json = false;
 
     Core::ArgsParser args_parser;
     args_parser.add_option(allow_cache, "Allow using disk cache", "cache", 'c');
@@ -57,8 +93,28 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.add_option(time_per_benchmark_sec, "Time elapsed per benchmark (seconds)", "time-per-benchmark", 't', "time-per-benchmark");
     args_parser.add_option(file_sizes, "A comma-separated list of file sizes", "file-size", 'f', "file-size");
     args_parser.add_option(block_sizes, "A comma-separated list of block sizes", "block-size", 'b', "block-size");
+    args_parser.add_option(mode, "Access pattern, either sequential or random", "mode", 'm', "mode");
+    args_parser.add_option(read_percentage, "Percentage of random accesses that are reads, the rest are writes", "read-percentage", 'r', "percentage");
+    args_parser.add_option(jobs, "Number of threads doing random accesses at the same time", "jobs", 'j', "jobs");
+    args_parser.add_option(print_json, "Print the results as JSON", "json", {});
     args_parser.parse(arguments);
 
+    bool random = false;
+    if (mode == "random"sv) {
+        random = true;
+    } else if (mode != "sequential"sv) {
+        warnln("Unknown mode '{}', expected sequential or random", mode);
+        return 1;
+    }
+    if (read_percentage < 0 || read_percentage > 100) {
+        warnln("Read percentage has to be between 0 and 100");
+        return 1;
+    }
+    if (jobs == 0) {
+        warnln("At least one job is needed");
+        return 1;
+    }
+
     Duration const time_per_benchmark = Duration::from_seconds(time_per_benchmark_sec);
 
     if (file_sizes.size() == 0) {
@@ -69,39 +125,102 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     }
 
     auto filename = ByteString::formatted("{}/disk_benchmark.tmp", directory);
+    JsonArray json_results;
 
     for (auto file_size : file_sizes) {
         for (auto block_size : block_sizes) {
             if (block_size > file_size)
                 continue;
 
+            if (random) {
+                if (!print_json)
+                    outln("Running: file_size={} block_size={} jobs={} read_percentage={}", file_size, block_size, jobs, read_percentage);
+                auto result = TRY(benchmark_random(filename, { file_size, block_size, jobs, read_percentage, time_per_benchmark, allow_cache }));
+
+                auto elapsed_seconds = max(result.elapsed.to_nanoseconds(), 1) / 1'000'000'000.0;
+                auto read_iops = static_cast<u64>(result.reads / elapsed_seconds);
+                auto write_iops = static_cast<u64>(result.writes / elapsed_seconds);
+                auto bps = static_cast<u64>(result.bytes / elapsed_seconds);
+                auto p50 = latency_percentile_in_microseconds(result.latencies, 50);
+                auto p99 = latency_percentile_in_microseconds(result.latencies, 99);
+                auto p999 = latency_percentile_in_microseconds(result.latencies, 99.9);
+                auto max_latency = result.latencies.is_empty() ? 0 : result.latencies.last() / 1000.0;
+
+                if (print_json) {
+                    JsonObject latency;
+                    latency.set("p50", p50);
+                    latency.set("p99", p99);
+                    latency.set("p99.9", p999);
+                    latency.set("max", max_latency);
+
+                    JsonObject json_result;
+                    json_result.set("mode", "random");
+                    json_result.set("file_size", file_size);
+                    json_result.set("block_size", block_size);
+                    json_result.set("jobs", jobs);
+                    json_result.set("read_percentage", read_percentage);
+                    json_result.set("time_ms", result.elapsed.to_milliseconds());
+                    json_result.set("reads", result.reads);
+                    json_result.set("writes", result.writes);
+                    json_result.set("read_iops", read_iops);
+                    json_result.set("write_iops", write_iops);
+                    json_result.set("bps", bps);
+                    json_result.set("latency_us", move(latency));
+                    TRY(json_results.append(move(json_result)));
+                } else {
+                    outln("Finished: time={}ms read_iops={} write_iops={} bps={} latency p50={:.1}us p99={:.1}us p99.9={:.1}us max={:.1}us",
+                        result.elapsed.to_milliseconds(), read_iops, write_iops, bps, p50, p99, p999, max_latency);
+                }
+
+                sleep(1);
+                continue;
+            }
+
             auto buffer_result = ByteBuffer::create_uninitialized(block_size);
             if (buffer_result.is_error()) {
                 warnln("Not enough memory to allocate space for block size = {}", block_size);
                 continue;
             }
-            Vector<Result> results;
+            Vector<SequentialResult> results;
 
-            outln("Running: file_size={} block_size={}", file_size, block_size);
+            if (!print_json)
+                outln("Running: file_size={} block_size={}", file_size, block_size);
             auto timer = Core::ElapsedTimer::start_new();
             while (timer.elapsed_time() < time_per_benchmark) {
-                out(".");
-                fflush(stdout);
+                if (!print_json) {
+                    out(".");
+                    fflush(stdout);
+                }
                 auto result = TRY(benchmark(filename, file_size, buffer_result.value(), allow_cache));
                 results.append(result);
                 usleep(100);
             }
             auto average = average_result(results);
-            outln("Finished: runs={} time={}ms write_bps={} read_bps={}", results.size(), timer.elapsed_milliseconds(), average.write_bps, average.read_bps);
+            if (print_json) {
+                JsonObject json_result;
+                json_result.set("mode", "sequential");
+                json_result.set("file_size", file_size);
+                json_result.set("block_size", block_size);
+                json_result.set("runs", results.size());
+                json_result.set("time_ms", timer.elapsed_milliseconds());
+                json_result.set("write_bps", average.write_bps);
+                json_result.set("read_bps", average.read_bps);
+                TRY(json_results.append(move(json_result)));
+            } else {
+                outln("Finished: runs={} time={}ms write_bps={} read_bps={}", results.size(), timer.elapsed_milliseconds(), average.write_bps, average.read_bps);
+            }
 
             sleep(1);
         }
     }
 
+    if (print_json)
+        outln("{}", json_results.serialized<StringBuilder>());
+
     return 0;
 }
 
-ErrorOr<Result> benchmark(ByteString const& filename, int file_size, ByteBuffer& buffer, bool allow_cache)
+ErrorOr<SequentialResult> benchmark(ByteString const& filename, int file_size, ByteBuffer& buffer, bool allow_cache)
 {
     int flags = O_CREAT | O_TRUNC | O_RDWR;
     if (!allow_cache)
@@ -119,7 +238,7 @@ ErrorOr<Result> benchmark(ByteString const& filename, int file_size, ByteBuffer&
             warnln("{}", void_or_error.release_error());
     });
 
-    Result result;
+    SequentialResult result;
 
     auto timer = Core::ElapsedTimer::start_new();
 
@@ -143,3 +262,108 @@ ErrorOr<Result> benchmark(ByteString const& filename, int file_size, ByteBuffer&
     result.read_bps = (u64)(timer.elapsed_milliseconds() ? (file_size / timer.elapsed_milliseconds()) : file_size) * 1000;
     return result;
 }
+
+// A xorshift generator is plenty to pick offsets with, and keeps getting randomness from the system out of the measurements.
+static u64 next_random(u64& state)
+{
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 0x2545F4914F6CDD1DULL;
+}
+
+ErrorOr<RandomResult> benchmark_random(ByteString const& filename, RandomOptions const& options)
+{
+    int flags = O_RDWR;
+    if (!options.allow_cache)
+        flags |= O_DIRECT;
+
+    auto buffer = TRY(ByteBuffer::create_zeroed(options.block_size));
+    auto block_count = options.file_size / options.block_size;
+
+    // Fill the file first, so that reads don't hit holes and writes don't grow the file.
+    int fd = TRY(Core::System::open(filename, flags | O_CREAT | O_TRUNC, 0644));
+    auto fd_cleanup = ScopeGuard([fd, filename] {
+        auto void_or_error = Core::System::close(fd);
+        if (void_or_error.is_error())
+            warnln("{}", void_or_error.release_error());
+
+        void_or_error = Core::System::unlink(filename);
+        if (void_or_error.is_error())
+            warnln("{}", void_or_error.release_error());
+    });
+    for (size_t i = 0; i < block_count; ++i) {
+        ReadonlyBytes remaining = buffer;
+        while (!remaining.is_empty())
+            remaining = remaining.slice(TRY(Core::System::write(fd, remaining)));
+    }
+    TRY(Core::System::fsync(fd));
+
+    struct Job {
+        RandomResult result;
+        Optional<Error> error;
+    };
+    Vector<Job> jobs;
+    jobs.resize(options.jobs);
+
+    auto deadline = MonotonicTime::now() + options.duration;
+    auto run_job = [&](Job& job) -> ErrorOr<void> {
+        // Every job gets its own file description, so their file offsets don't get in each other's way.
+        int job_fd = TRY(Core::System::open(filename, flags));
+        ScopeGuard close_job_fd = [job_fd] { (void)Core::System::close(job_fd); };
+        auto job_buffer = TRY(ByteBuffer::create_zeroed(options.block_size));
+        u64 random_state = get_random<u64>() | 1;
+
+        auto start = MonotonicTime::now();
+        while (true) {
+            auto before = MonotonicTime::now();
+            if (before >= deadline)
+                break;
+
+            auto offset = static_cast<off_t>((next_random(random_state) % block_count) * options.block_size);
+            bool is_read = static_cast<int>(next_random(random_state) % 100) < options.read_percentage;
+            ssize_t rc = is_read
+                ? pread(job_fd, job_buffer.data(), job_buffer.size(), offset)
+                : pwrite(job_fd, job_buffer.data(), job_buffer.size(), offset);
+            if (rc < 0)
+                return Error::from_syscall(is_read ? "pread"sv : "pwrite"sv, -errno);
+
+            auto after = MonotonicTime::now();
+            TRY(job.result.latencies.try_append((after - before).to_nanoseconds()));
+            if (is_read)
+                ++job.result.reads;
+            else
+                ++job.result.writes;
+            job.result.bytes += rc;
+        }
+        job.result.elapsed = MonotonicTime::now() - start;
+        return {};
+    };
+
+    Vector<NonnullRefPtr<Threading::Thread>> threads;
+    for (auto& job : jobs) {
+        auto thread = TRY(Threading::Thread::try_create([&job, &run_job]() -> intptr_t {
+            if (auto result = run_job(job); result.is_error())
+                job.error = result.release_error();
+            return 0;
+        },
+            "disk_benchmark"sv));
+        thread->start();
+        TRY(threads.try_append(move(thread)));
+    }
+    for (auto& thread : threads)
+        (void)thread->join();
+
+    RandomResult total;
+    for (auto& job : jobs) {
+        if (job.error.has_value())
+            return job.error.release_value();
+        total.reads += job.result.reads;
+        total.writes += job.result.writes;
+        total.bytes += job.result.bytes;
+        total.elapsed = max(total.elapsed, job.result.elapsed);
+        TRY(total.latencies.try_extend(move(job.result.latencies)));
+    }
+    quick_sort(total.latencies);
+    return total;
+}
@@ -10,10 +10,11 @@
 #include <AK/Vector.h>
 #include <LibCore/ArgsParser.h>
 #include <LibCore/DateTime.h>
-#include <LibCore/DirIterator.h>
 #include <LibCore/File.h>
 #include <LibCore/System.h>
 #include <LibMain/Main.h>
+#include <dirent.h>
+#include <fcntl.h>
 #include <limits.h>
 #include <string.h>
 
@@ -59,7 +60,7 @@ struct AK::Traits<VisitedFile> : public DefaultTraits<VisitedFile> {
 static HashTable<VisitedFile> s_visited_files;
 
 static ErrorOr<void> parse_args(Main::Arguments arguments, Vector<ByteString>& files, DuOption& du_option);
-static u64 print_space_usage(ByteString const& path, DuOption const& du_option, size_t current_depth, Optional<dev_t> root_device = {});
+static u64 print_space_usage(ByteString const& path, DuOption const& du_option, size_t current_depth, Optional<dev_t> root_device = {}, int directory_fd = AT_FDCWD, StringView name = {});
 
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
@@ -169,10 +170,12 @@ ErrorOr<void> parse_args(Main::Arguments arguments, Vector<ByteString>& files, D
     return {};
 }
 
-u64 print_space_usage(ByteString const& path, DuOption const& du_option, size_t current_depth, Optional<dev_t> root_device)
+// Files inside of directories are looked up relative to the directory's fd by their name, so the kernel
+// doesn't have to resolve the whole path again for every single one of them.
+u64 print_space_usage(ByteString const& path, DuOption const& du_option, size_t current_depth, Optional<dev_t> root_device, int directory_fd, StringView name)
 {
     u64 size = 0;
-    auto path_stat_or_error = Core::System::lstat(path);
+    auto path_stat_or_error = Core::System::fstatat(directory_fd, name.is_empty() ? path.view() : name, AT_SYMLINK_NOFOLLOW);
     if (path_stat_or_error.is_error()) {
         warnln("du: cannot stat '{}': {}", path, path_stat_or_error.release_error());
         return 0;
@@ -188,25 +191,41 @@ u64 print_space_usage(ByteString const& path, DuOption const& du_option, size_t
         return 0;
     }
 
-    VisitedFile visited_file { path_stat.st_dev, path_stat.st_ino };
-    if (s_visited_files.contains(visited_file)) {
-        return 0;
+    bool const is_directory = S_ISDIR(path_stat.st_mode);
+
+    // Other files can only be visited twice if they have multiple hard links, so there's no need to remember all of them.
+    if (is_directory || path_stat.st_nlink > 1) {
+        VisitedFile visited_file { path_stat.st_dev, path_stat.st_ino };
+        if (s_visited_files.contains(visited_file)) {
+            return 0;
+        }
+        s_visited_files.set(visited_file);
     }
-    s_visited_files.set(visited_file);
 
-    bool const is_directory = S_ISDIR(path_stat.st_mode);
     if (is_directory) {
-        auto di = Core::DirIterator(path, Core::DirIterator::SkipParentAndBaseDir);
-        if (di.has_error()) {
-            auto error = di.error();
-            warnln("du: cannot read directory '{}': {}", path, error);
+        auto child_directory_fd_or_error = Core::System::openat(directory_fd, name.is_empty() ? path.view() : name, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (child_directory_fd_or_error.is_error()) {
+            warnln("du: cannot read directory '{}': {}", path, child_directory_fd_or_error.release_error());
             return 0;
         }
 
-        while (di.has_next()) {
-            auto const child_path = di.next_full_path();
-            size += print_space_usage(child_path, du_option, current_depth + 1, root_device);
+        auto* dir = fdopendir(child_directory_fd_or_error.value());
+        if (!dir) {
+            warnln("du: cannot read directory '{}': {}", path, Error::from_errno(errno));
+            close(child_directory_fd_or_error.value());
+            return 0;
+        }
+
+        auto const child_path_prefix = path.ends_with('/') ? path : ByteString::formatted("{}/", path);
+        while (auto* entry = readdir(dir)) {
+            StringView const child_name { entry->d_name, strlen(entry->d_name) };
+            if (child_name == "."sv || child_name == ".."sv)
+                continue;
+
+            auto const child_path = ByteString::formatted("{}{}", child_path_prefix, child_name);
+            size += print_space_usage(child_path, du_option, current_depth + 1, root_device, dirfd(dir), child_name);
         }
+        closedir(dir);
     }
 
     auto const basename = LexicalPath::basename(path);
@@ -14,12 +14,17 @@
 #include <LibCore/ArgsParser.h>
 #include <LibCore/DirIterator.h>
 #include <LibCore/File.h>
+#include <LibCore/MappedFile.h>
 #include <LibCore/System.h>
 #include <LibFileSystem/FileSystem.h>
 #include <LibMain/Main.h>
 #include <LibRegex/Regex.h>
+#include <LibThreading/DefaultThreadPool.h>
+#include <LibThreading/ParallelFor.h>
 #include <LibURL/URL.h>
 #include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
 #include <unistd.h>
 
 enum class BinaryFileMode {
@@ -58,6 +63,214 @@ static ByteString escape_characters(StringView string, StringView characters)
     return builder.to_byte_string();
 }
 
+// Returns a string that every match of the pattern has to contain, so lines without it can be skipped
+// without running the regex on them. This only has to be correct, not find the longest such string.
+static Optional<ByteString> required_literal(StringView pattern, bool extended)
+{
+    auto special_characters = extended ? ere_special_characters : basic_special_characters;
+
+    ByteString longest_literal;
+    StringBuilder literal;
+    size_t group_depth = 0;
+    auto end_literal = [&] {
+        if (literal.length() > longest_literal.length())
+            longest_literal = literal.to_byte_string();
+        literal.clear();
+    };
+    // Quantifiers make the preceding character optional or repeat it, so it can't be part of the literal.
+    auto end_literal_before_quantifier = [&] {
+        if (!literal.is_empty())
+            literal.trim(1);
+        end_literal();
+    };
+
+    for (size_t i = 0; i < pattern.length(); ++i) {
+        auto ch = pattern[i];
+        if (ch == '\\') {
+            if (++i == pattern.length())
+                return {};
+            ch = pattern[i];
+            if (!extended && (ch == '(' || ch == ')')) {
+                end_literal();
+                group_depth += ch == '(' ? 1 : -1;
+                continue;
+            }
+            if (!extended && ch == '|')
+                return {};
+            if (!extended && ch == '{') {
+                end_literal_before_quantifier();
+                while (i + 1 < pattern.length() && !pattern.substring_view(i).starts_with("\\}"sv))
+                    ++i;
+                ++i;
+                continue;
+            }
+            if (!special_characters.contains(ch)) {
+                // Escapes like \w or \< are not literal characters.
+                end_literal_before_quantifier();
+                continue;
+            }
+        } else if (ch == '[') {
+            end_literal();
+            // A ']' right at the start of a bracket expression is part of it.
+            if (i + 1 < pattern.length() && pattern[i + 1] == '^')
+                ++i;
+            if (i + 1 < pattern.length() && pattern[i + 1] == ']')
+                ++i;
+            while (i + 1 < pattern.length() && pattern[i + 1] != ']')
+                ++i;
+            ++i;
+            continue;
+        } else if (ch == '*' || (extended && (ch == '+' || ch == '?' || ch == '{'))) {
+            end_literal_before_quantifier();
+            if (ch == '{') {
+                while (i + 1 < pattern.length() && pattern[i] != '}')
+                    ++i;
+            }
+            continue;
+        } else if (extended && (ch == '(' || ch == ')')) {
+            end_literal();
+            group_depth += ch == '(' ? 1 : -1;
+            continue;
+        } else if (extended && ch == '|') {
+            if (group_depth == 0)
+                return {};
+            continue;
+        } else if (ch == '.' || ch == '^' || ch == '$') {
+            end_literal();
+            continue;
+        }
+
+        // Characters inside of groups might be repeated or be part of an alternative.
+        if (group_depth == 0)
+            literal.append(ch);
+    }
+    end_literal();
+
+    if (longest_literal.is_empty())
+        return {};
+    return longest_literal;
+}
+
+// Finds the next occurrence of the literal with memchr(), which is much faster than looking at every character.
+static Optional<size_t> find_literal(ReadonlyBytes bytes, size_t start, StringView literal)
+{
+    while (start + literal.length() <= bytes.size()) {
+        auto const* candidate = static_cast<u8 const*>(memchr(bytes.data() + start, literal[0], bytes.size() - literal.length() - start + 1));
+        if (!candidate)
+            return {};
+        auto offset = static_cast<size_t>(candidate - bytes.data());
+        if (__builtin_memcmp(candidate + 1, literal.characters_without_null_termination() + 1, literal.length() - 1) == 0)
+            return offset;
+        start = offset + 1;
+    }
+    return {};
+}
+
+static size_t count_newlines(ReadonlyBytes bytes)
+{
+    size_t count = 0;
+    for (auto const* position = bytes.data(); (position = static_cast<u8 const*>(memchr(position, '\n', bytes.data() + bytes.size() - position))); ++position)
+        ++count;
+    return count;
+}
+
+struct CandidateLine {
+    size_t start { 0 };
+    size_t length { 0 };
+    size_t line_number { 0 };
+};
+
+struct ScanOptions {
+    Vector<ByteString> required_literals;
+    BinaryFileMode binary_mode { BinaryFileMode::Binary };
+    bool line_numbers { false };
+};
+
+// The part of grepping a file that doesn't touch the regular expressions, so it can run on multiple threads.
+// (LibRegex shares the state of its opcodes between all expressions, so matching has to stay on one thread.)
+struct ScannedFile {
+    ErrorOr<void> scan(StringView path, ScanOptions const& options)
+    {
+        if (path == "-"sv) {
+            needs_buffered_read = true;
+            return {};
+        }
+
+        auto fd = TRY(Core::System::open(path, O_RDONLY | O_CLOEXEC));
+        ArmedScopeGuard close_fd = [fd] { (void)Core::System::close(fd); };
+
+        auto stat = TRY(Core::System::fstat(fd));
+        if (!S_ISREG(stat.st_mode)) {
+            // Pipes, devices and the like can't be mapped, so they are read like standard input.
+            needs_buffered_read = true;
+            return {};
+        }
+        // NOTE: Files in ProcFS and SysFS claim to be empty, but are generated when read.
+        if (stat.st_size == 0) {
+            needs_buffered_read = true;
+            return {};
+        }
+
+        close_fd.disarm();
+        mapped_file = TRY(Core::MappedFile::map_from_fd_and_close(fd, path));
+        (void)mapped_file->advise(MADV_SEQUENTIAL);
+        auto contents = bytes();
+
+        // Like other greps, a file is considered binary if there's a null byte close to its start.
+        static constexpr size_t binary_detection_size = 32 * KiB;
+        is_binary = memchr(contents.data(), '\0', min(contents.size(), binary_detection_size)) != nullptr;
+        if (is_binary && options.binary_mode == BinaryFileMode::Skip)
+            return {};
+
+        if (options.required_literals.is_empty())
+            return {};
+
+        candidate_lines = Vector<CandidateLine> {};
+        Vector<Optional<size_t>> next_literal_offsets;
+        TRY(next_literal_offsets.try_resize(options.required_literals.size()));
+        for (size_t i = 0; i < options.required_literals.size(); ++i)
+            next_literal_offsets[i] = find_literal(contents, 0, options.required_literals[i]);
+
+        size_t offset = 0;
+        size_t line_number = 1;
+        while (true) {
+            Optional<size_t> candidate_offset;
+            for (size_t i = 0; i < options.required_literals.size(); ++i) {
+                if (next_literal_offsets[i].has_value() && *next_literal_offsets[i] < offset)
+                    next_literal_offsets[i] = find_literal(contents, offset, options.required_literals[i]);
+                if (next_literal_offsets[i].has_value() && (!candidate_offset.has_value() || *next_literal_offsets[i] < *candidate_offset))
+                    candidate_offset = next_literal_offsets[i];
+            }
+            if (!candidate_offset.has_value())
+                break;
+
+            auto line_start = *candidate_offset;
+            while (line_start > offset && contents[line_start - 1] != '\n')
+                --line_start;
+            auto const* newline = static_cast<u8 const*>(memchr(contents.data() + *candidate_offset, '\n', contents.size() - *candidate_offset));
+            auto line_end = newline ? static_cast<size_t>(newline - contents.data()) : contents.size();
+
+            if (options.line_numbers)
+                line_number += count_newlines(contents.slice(offset, line_start - offset));
+            TRY(candidate_lines->try_append({ line_start, line_end - line_start, line_number }));
+            if (options.line_numbers)
+                ++line_number;
+            offset = line_end + 1;
+        }
+
+        return {};
+    }
+
+    ReadonlyBytes bytes() const { return mapped_file ? mapped_file->bytes() : ReadonlyBytes {}; }
+
+    OwnPtr<Core::MappedFile> mapped_file;
+    bool needs_buffered_read { false };
+    bool is_binary { false };
+    // Only the lines that contain one of the required literals, if there are any.
+    Optional<Vector<CandidateLine>> candidate_lines;
+    Optional<Error> error;
+};
+
 static ByteString& hostname()
 {
     static ByteString s_hostname;
@@ -115,7 +328,7 @@ static void append_formatted_path(StringBuilder& builder, StringView path, Optio
 
 ErrorOr<int> serenity_main(Main::Arguments args)
 {
-    TRY(Core::System::pledge("stdio rpath"));
+    TRY(Core::System::pledge("stdio rpath thread"));
 
     ByteString program_name = AK::LexicalPath::basename(args.strings[0]);
 
@@ -295,26 +508,32 @@ ErrorOr<int> serenity_main(Main::Arguments args)
 
         auto exit_status = ExitStatus::NoLinesMatched;
 
-        auto handle_file = [&matches, binary_mode, count_lines, quiet_mode, disable_hyperlinks, colored_output,
-                               &matched_line_count, &exit_status](StringView filename, bool print_filename) -> ErrorOr<void> {
-            auto file = TRY(Core::File::open_file_or_standard_stream(filename, Core::File::OpenMode::Read));
-            auto buffered_file = TRY(Core::InputBufferedFile::create(move(file)));
-
-            for (size_t line_number = 1; TRY(buffered_file->can_read_line()); ++line_number) {
-                Array<u8, PAGE_SIZE> buffer;
-                auto line = TRY(buffered_file->read_line(buffer));
-
-                auto is_binary = line.contains('\0');
-
-                auto matched = matches(line, filename, line_number, print_filename, is_binary);
-                if (matched) {
-                    if (exit_status == ExitStatus::NoLinesMatched)
-                        exit_status = ExitStatus::SomethingMatched;
-                    if (is_binary && binary_mode == BinaryFileMode::Binary)
-                        break;
+        ScanOptions scan_options { .required_literals = {}, .binary_mode = binary_mode, .line_numbers = line_numbers };
+        // Lines without any of the literals can only be skipped if they wouldn't be selected either.
+        if (!case_insensitive && !invert_match) {
+            for (auto& re : regular_expressions) {
+                auto literal = required_literal(re.pattern_value, use_ere);
+                if (!literal.has_value()) {
+                    scan_options.required_literals.clear();
+                    break;
                 }
+                scan_options.required_literals.append(literal.release_value());
             }
+        }
 
+        // Returns whether the rest of the file can be skipped.
+        auto handle_line = [&matches, binary_mode, &exit_status](StringView line, StringView filename, size_t line_number, bool print_filename, bool is_binary_file) {
+            auto is_binary = is_binary_file || line.contains('\0');
+
+            auto matched = matches(line, filename, line_number, print_filename, is_binary);
+            if (!matched)
+                return false;
+            if (exit_status == ExitStatus::NoLinesMatched)
+                exit_status = ExitStatus::SomethingMatched;
+            return is_binary && binary_mode == BinaryFileMode::Binary;
+        };
+
+        auto print_line_count = [count_lines, quiet_mode, disable_hyperlinks, colored_output, &matched_line_count](StringView filename, bool print_filename) {
             if (count_lines && !quiet_mode) {
                 if (print_filename) {
                     StringBuilder filename_builder;
@@ -324,22 +543,99 @@ ErrorOr<int> serenity_main(Main::Arguments args)
                 outln("{}", matched_line_count);
                 matched_line_count = 0;
             }
+        };
+
+        auto handle_buffered_file = [&handle_line](StringView filename, bool print_filename) -> ErrorOr<void> {
+            auto file = TRY(Core::File::open_file_or_standard_stream(filename, Core::File::OpenMode::Read));
+            auto buffered_file = TRY(Core::InputBufferedFile::create(move(file)));
+
+            for (size_t line_number = 1; TRY(buffered_file->can_read_line()); ++line_number) {
+                Array<u8, PAGE_SIZE> buffer;
+                auto line = TRY(buffered_file->read_line(buffer));
+                if (handle_line(line, filename, line_number, print_filename, false))
+                    break;
+            }
 
             return {};
         };
 
-        auto add_directory = [&handle_file, &exit_status, user_has_specified_files, suppress_errors](ByteString base, Optional<ByteString> recursive, auto handle_directory) -> void {
+        auto handle_scanned_file = [&handle_line, binary_mode](ScannedFile const& file, StringView filename, bool print_filename) {
+            if (file.is_binary && binary_mode == BinaryFileMode::Skip)
+                return;
+
+            auto contents = file.bytes();
+            if (file.candidate_lines.has_value()) {
+                for (auto const& line : *file.candidate_lines) {
+                    if (handle_line(StringView { contents.slice(line.start, line.length) }, filename, line.line_number, print_filename, file.is_binary))
+                        break;
+                }
+                return;
+            }
+
+            size_t offset = 0;
+            for (size_t line_number = 1; offset < contents.size(); ++line_number) {
+                auto const* newline = static_cast<u8 const*>(memchr(contents.data() + offset, '\n', contents.size() - offset));
+                auto line_end = newline ? static_cast<size_t>(newline - contents.data()) : contents.size();
+                if (handle_line(StringView { contents.slice(offset, line_end - offset) }, filename, line_number, print_filename, file.is_binary))
+                    break;
+                offset = line_end + 1;
+            }
+        };
+
+        OwnPtr<Threading::DefaultThreadPool> thread_pool;
+
+        // Files are mapped and searched for the required literals on multiple threads, and then matched in order.
+        auto handle_files = [&](ReadonlySpan<ByteString> filenames, bool print_filename) {
+            Vector<ScannedFile> scanned_files;
+            scanned_files.resize(filenames.size());
+            auto scan_file = [&](size_t i) {
+                if (auto result = scanned_files[i].scan(filenames[i], scan_options); result.is_error())
+                    scanned_files[i].error = result.release_error();
+            };
+            if (filenames.size() == 1) {
+                scan_file(0);
+            } else {
+                if (!thread_pool)
+                    thread_pool = make<Threading::DefaultThreadPool>([](Function<void()> work) { work(); });
+                Threading::parallel_for(*thread_pool, filenames.size(), scan_file);
+            }
+
+            for (size_t i = 0; i < filenames.size(); ++i) {
+                auto& file = scanned_files[i];
+                ErrorOr<void> result {};
+                if (file.error.has_value())
+                    result = file.error.release_value();
+                else if (file.needs_buffered_read)
+                    result = handle_buffered_file(filenames[i], print_filename);
+                else
+                    handle_scanned_file(file, filenames[i], print_filename);
+
+                if (result.is_error()) {
+                    if (!suppress_errors) {
+                        warnln("Failed with file {}: {}", filenames[i], result.release_error());
+                        exit_status = ExitStatus::ErrorOccurred;
+                    }
+                    continue;
+                }
+                print_line_count(filenames[i], print_filename);
+            }
+        };
+
+        static constexpr size_t files_per_batch = 64;
+        Vector<ByteString> pending_files;
+
+        auto add_directory = [&handle_files, &pending_files, user_has_specified_files](ByteString base, Optional<ByteString> recursive, auto handle_directory) -> void {
             Core::DirIterator it(recursive.value_or(base), Core::DirIterator::Flags::SkipDots);
             while (it.has_next()) {
                 auto path = it.next_full_path();
                 if (!FileSystem::is_directory(path)) {
                     // Remove leading './' when `grep -r` was run without any specified paths.
-                    auto key = user_has_specified_files ? path.view() : path.substring_view(base.length() + 1);
-                    if (auto result = handle_file(key, true); result.is_error() && !suppress_errors) {
-                        warnln("Failed with file {}: {}", key, result.release_error());
-                        exit_status = ExitStatus::ErrorOccurred;
+                    auto key = user_has_specified_files ? path : path.substring(base.length() + 1);
+                    pending_files.append(move(key));
+                    if (pending_files.size() == files_per_batch) {
+                        handle_files(pending_files, true);
+                        pending_files.clear_with_capacity();
                     }
-
                 } else {
                     handle_directory(base, path, handle_directory);
                 }
@@ -353,18 +649,14 @@ ErrorOr<int> serenity_main(Main::Arguments args)
             for (auto& filename : files) {
                 add_directory(filename, {}, add_directory);
             }
+            handle_files(pending_files, true);
         } else {
             if (!user_has_specified_files)
                 files.append("-"sv);
 
             bool print_filename { files.size() > 1 };
-            for (auto& filename : files) {
-                auto result = handle_file(filename, print_filename);
-                if (result.is_error() && !suppress_errors) {
-                    warnln("Failed with file {}: {}", filename, result.release_error());
-                    exit_status = ExitStatus::ErrorOccurred;
-                }
-            }
+            for (size_t start = 0; start < files.size(); start += files_per_batch)
+                handle_files(files.span().slice(start, min(files_per_batch, files.size() - start)), print_filename);
         }
 
         return exit_status;
@@ -20,11 +20,13 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     bool keep_input_files { false };
     bool write_to_stdout { false };
     bool decompress { false };
+    size_t thread_count { 1 };
 
     Core::ArgsParser args_parser;
     args_parser.add_option(keep_input_files, "Keep (don't delete) input files", "keep", 'k');
     args_parser.add_option(write_to_stdout, "Write to stdout, keep original files unchanged", "stdout", 'c');
     args_parser.add_option(decompress, "Decompress", "decompress", 'd');
+    args_parser.add_option(thread_count, "Number of threads to compress with, or 0 for one per CPU core", "threads", 'T', "count");
     args_parser.add_positional_argument(filenames, "Files", "FILES", Core::ArgsParser::Required::No);
     args_parser.parse(arguments);
 
@@ -46,6 +48,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     if (write_to_stdout)
         keep_input_files = true;
 
+    if (thread_count == 0)
+        thread_count = Core::System::hardware_concurrency();
+
     for (auto const& input_filename : filenames) {
         OwnPtr<Stream> output_stream;
 
@@ -74,13 +79,18 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         if (decompress) {
             input_stream = TRY(try_make<Compress::GzipDecompressor>(move(input_stream)));
         } else {
-            output_stream = TRY(try_make<Compress::GzipCompressor>(output_stream.release_nonnull()));
+            output_stream = TRY(try_make<Compress::GzipCompressor>(output_stream.release_nonnull(), thread_count));
         }
 
-        auto buffer = TRY(ByteBuffer::create_uninitialized(1 * MiB));
+        // Every thread gets its own part of each buffer to compress, so give them enough to work with.
+        auto buffer_size = decompress ? 1 * MiB : thread_count * 1 * MiB;
+        auto buffer = TRY(ByteBuffer::create_uninitialized(buffer_size));
 
         while (!input_stream->is_eof()) {
+            // Fill the whole buffer if we can, as the compressor writes a separate member for every write.
             auto span = TRY(input_stream->read_some(buffer));
+            while (span.size() < buffer.size() && !input_stream->is_eof())
+                span = buffer.span().trim(span.size() + TRY(input_stream->read_some(buffer.bytes().slice(span.size()))).size());
             TRY(output_stream->write_until_depleted(span));
         }
 
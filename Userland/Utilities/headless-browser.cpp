@@ -11,11 +11,14 @@
 #include <AK/ByteBuffer.h>
 #include <AK/ByteString.h>
 #include <AK/Function.h>
+#include <AK/HashMap.h>
+#include <AK/JsonArray.h>
 #include <AK/JsonObject.h>
 #include <AK/JsonParser.h>
 #include <AK/LexicalPath.h>
 #include <AK/NonnullOwnPtr.h>
 #include <AK/Platform.h>
+#include <AK/QuickSort.h>
 #include <AK/String.h>
 #include <AK/Vector.h>
 #include <Ladybird/Types.h>
@@ -28,6 +31,7 @@
 #include <LibCore/Promise.h>
 #include <LibCore/ResourceImplementationFile.h>
 #include <LibCore/Timer.h>
+#include <LibCore/TraceEvent.h>
 #include <LibDiff/Format.h>
 #include <LibDiff/Generator.h>
 #include <LibFileSystem/FileSystem.h>
@@ -163,6 +167,17 @@ public:
         client().async_set_content_filters(0, {});
     }
 
+    void set_tracing_enabled(bool enabled)
+    {
+        client().async_set_tracing_enabled(0, enabled);
+    }
+
+    ErrorOr<JsonArray> take_trace_events()
+    {
+        auto events = TRY(JsonValue::from_string(client().take_trace_events(0)));
+        return move(events.as_array());
+    }
+
 private:
     HeadlessWebContentView(NonnullRefPtr<WebView::Database> database, NonnullOwnPtr<WebView::CookieJar> cookie_jar, RefPtr<Protocol::RequestClient> request_client = nullptr)
         : m_database(move(database))
@@ -217,7 +232,25 @@ private:
     RefPtr<Protocol::RequestClient> m_request_client;
 };
 
-static ErrorOr<NonnullRefPtr<Core::Timer>> load_page_for_screenshot_and_exit(Core::EventLoop& event_loop, HeadlessWebContentView& view, URL::URL url, int screenshot_timeout)
+static ErrorOr<void> write_trace_file(StringView path, JsonArray trace_events)
+{
+    // Our own events go into the same trace, so that each page load can be lined up with the work it caused.
+    auto own_events = TRY(JsonValue::from_string(Core::TraceEvent::take_events_as_json()));
+    for (auto const& event : own_events.as_array().values())
+        TRY(trace_events.append(event));
+
+    JsonObject trace;
+    trace.set("traceEvents"sv, move(trace_events));
+    trace.set("displayTimeUnit"sv, "ms"sv);
+
+    auto file = TRY(Core::File::open(path, Core::File::OpenMode::Write));
+    auto serialized_trace = trace.to_byte_string();
+    TRY(file->write_until_depleted(serialized_trace.bytes()));
+    outln("Trace written to {}", path);
+    return {};
+}
+
+static ErrorOr<NonnullRefPtr<Core::Timer>> load_page_for_screenshot_and_exit(Core::EventLoop& event_loop, HeadlessWebContentView& view, URL::URL url, int screenshot_timeout, StringView trace_path)
 {
     // FIXME: Allow passing the output path as an argument.
     static constexpr auto output_file_path = "output.png"sv;
@@ -240,9 +273,18 @@ static ErrorOr<NonnullRefPtr<Core::Timer>> load_page_for_screenshot_and_exit(Cor
                 warnln("No screenshot available");
             }
 
+            if (!trace_path.is_empty()) {
+                auto trace_events = MUST(view.take_trace_events());
+                if (auto result = write_trace_file(trace_path, move(trace_events)); result.is_error())
+                    warnln("Unable to write trace to {}: {}", trace_path, result.error());
+            }
+
             event_loop.quit(0);
         });
 
+    if (!trace_path.is_empty())
+        view.set_tracing_enabled(true);
+
     view.load(url);
     timer->start();
     return timer;
@@ -658,6 +700,201 @@ static ErrorOr<int> run_tests(HeadlessWebContentView& view, StringView test_root
     return 1;
 }
 
+struct PageLoadSample {
+    i64 load_time_us { 0 };
+    HashMap<ByteString, i64> self_time_us_per_category;
+};
+
+// Attributes the time of each span to its category, minus the time of the spans nested inside of it. Otherwise,
+// e.g. all scripts that run during parsing would also be counted as parsing.
+static void accumulate_self_time_per_category(JsonArray const& trace_events, HashMap<ByteString, i64>& self_time_us_per_category)
+{
+    struct Span {
+        ByteString category;
+        u64 thread_id { 0 };
+        i64 start_us { 0 };
+        i64 end_us { 0 };
+    };
+
+    Vector<Span> spans;
+    trace_events.for_each([&](JsonValue const& value) {
+        auto const& event = value.as_object();
+        if (event.get_byte_string("ph"sv) != "X"sv)
+            return;
+        auto start_us = event.get_i64("ts"sv).value_or(0);
+        spans.append({
+            .category = event.get_byte_string("cat"sv).value_or({}),
+            .thread_id = event.get_u64("tid"sv).value_or(0),
+            .start_us = start_us,
+            .end_us = start_us + event.get_i64("dur"sv).value_or(0),
+        });
+    });
+
+    quick_sort(spans, [](Span const& a, Span const& b) {
+        if (a.thread_id != b.thread_id)
+            return a.thread_id < b.thread_id;
+        if (a.start_us != b.start_us)
+            return a.start_us < b.start_us;
+        return a.end_us > b.end_us;
+    });
+
+    Vector<Span const*> open_spans;
+    for (auto const& span : spans) {
+        while (!open_spans.is_empty() && (open_spans.last()->thread_id != span.thread_id || open_spans.last()->end_us <= span.start_us))
+            open_spans.take_last();
+
+        auto duration_us = span.end_us - span.start_us;
+        if (!open_spans.is_empty())
+            self_time_us_per_category.ensure(open_spans.last()->category) -= duration_us;
+        self_time_us_per_category.ensure(span.category) += duration_us;
+        open_spans.append(&span);
+    }
+}
+
+static i64 percentile(Vector<i64> const& sorted_values, size_t percent)
+{
+    VERIFY(!sorted_values.is_empty());
+    auto rank = (sorted_values.size() * percent + 99) / 100;
+    return sorted_values[max<size_t>(rank, 1) - 1];
+}
+
+static void print_percentiles(StringView name, Vector<i64> values)
+{
+    quick_sort(values);
+
+    auto format = [](i64 microseconds) {
+        return ByteString::formatted("{:.1}ms", static_cast<double>(microseconds) / 1000);
+    };
+
+    outln("    {:10} {:>10} {:>10} {:>10} {:>10} {:>10}", name,
+        format(percentile(values, 50)), format(percentile(values, 90)), format(percentile(values, 99)),
+        format(values.first()), format(values.last()));
+}
+
+static ErrorOr<int> run_page_load_benchmark(HeadlessWebContentView& view, StringView url_list_path, int run_count, StringView trace_path)
+{
+    if (run_count < 1) {
+        warnln("Invalid number of page load benchmark runs: {}", run_count);
+        return 1;
+    }
+
+    Vector<URL::URL> urls;
+    auto url_list = TRY(Core::File::open(url_list_path, Core::File::OpenMode::Read));
+    auto url_list_contents = TRY(url_list->read_until_eof());
+    for (auto line : StringView { url_list_contents.bytes() }.lines()) {
+        line = line.trim_whitespace();
+        if (line.is_empty() || line.starts_with('#'))
+            continue;
+
+        auto url = WebView::sanitize_url(line);
+        if (!url.has_value()) {
+            warnln("Invalid URL: \"{}\"", line);
+            return Error::from_string_literal("Invalid URL");
+        }
+        urls.append(url.release_value());
+    }
+
+    if (urls.is_empty()) {
+        warnln("No URLs to load in {}", url_list_path);
+        return 1;
+    }
+
+    // The trace events are what tell us where the time went, so we always record them.
+    view.set_tracing_enabled(true);
+    Core::TraceEvent::set_enabled(!trace_path.is_empty());
+    (void)TRY(view.take_trace_events());
+
+    Vector<Vector<PageLoadSample>> samples_per_url;
+    samples_per_url.resize(urls.size());
+    JsonArray trace_events;
+    size_t timeout_count = 0;
+
+    for (int run = 0; run < run_count; ++run) {
+        for (size_t i = 0; i < urls.size(); ++i) {
+            auto const& url = urls[i];
+            outln("{}/{}: {}", run + 1, run_count, url);
+
+            Core::EventLoop loop;
+            bool did_timeout = false;
+
+            auto timeout_timer = Core::Timer::create_single_shot(DEFAULT_TIMEOUT_MS, [&] {
+                did_timeout = true;
+                loop.quit(0);
+            });
+
+            view.on_load_finish = [&](auto const& loaded_url) {
+                // NOTE: The initial about:blank document finishes loading as well.
+                if (loaded_url.equals(URL::URL("about:blank")) && !url.equals(loaded_url))
+                    return;
+                loop.quit(0);
+            };
+
+            auto start = MonotonicTime::now();
+            view.load(url);
+            timeout_timer->start();
+            loop.exec();
+            auto end = MonotonicTime::now();
+
+            view.on_load_finish = {};
+            auto events = TRY(view.take_trace_events());
+
+            if (did_timeout) {
+                warnln("Timed out loading {}", url);
+                ++timeout_count;
+                continue;
+            }
+
+            PageLoadSample sample;
+            sample.load_time_us = (end - start).to_microseconds();
+            accumulate_self_time_per_category(events, sample.self_time_us_per_category);
+            samples_per_url[i].append(move(sample));
+
+            if (!trace_path.is_empty()) {
+                Core::TraceEvent::record("headless-browser"sv, "Page load"sv, start, end, url.to_byte_string());
+                for (auto const& event : events.values())
+                    TRY(trace_events.append(event));
+            }
+        }
+    }
+
+    view.set_tracing_enabled(false);
+
+    outln("==================================================");
+    for (size_t i = 0; i < urls.size(); ++i) {
+        auto const& samples = samples_per_url[i];
+        outln("{} ({} loads)", urls[i], samples.size());
+        if (samples.is_empty())
+            continue;
+
+        outln("    {:10} {:>10} {:>10} {:>10} {:>10} {:>10}", ""sv, "p50"sv, "p90"sv, "p99"sv, "min"sv, "max"sv);
+
+        Vector<i64> load_times;
+        Vector<ByteString> categories;
+        for (auto const& sample : samples) {
+            load_times.append(sample.load_time_us);
+            for (auto const& category : sample.self_time_us_per_category.keys()) {
+                if (!categories.contains_slow(category))
+                    categories.append(category);
+            }
+        }
+        print_percentiles("load"sv, move(load_times));
+
+        quick_sort(categories);
+        for (auto const& category : categories) {
+            Vector<i64> self_times;
+            for (auto const& sample : samples)
+                self_times.append(sample.self_time_us_per_category.get(category).value_or(0));
+            print_percentiles(category, move(self_times));
+        }
+    }
+    outln("==================================================");
+
+    if (!trace_path.is_empty())
+        TRY(write_trace_file(trace_path, move(trace_events)));
+
+    return timeout_count == 0 ? 0 : 1;
+}
+
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
     Core::EventLoop event_loop;
@@ -673,6 +910,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     bool is_layout_test_mode = false;
     StringView test_root_path;
     ByteString test_glob;
+    StringView trace_path;
+    StringView page_load_benchmark_path;
+    int page_load_benchmark_runs = 5;
     Vector<ByteString> certificates;
 
 #if !defined(AK_OS_SERENITY)
@@ -693,6 +933,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.add_option(web_driver_ipc_path, "Path to the WebDriver IPC socket", "webdriver-ipc-path", 0, "path");
     args_parser.add_option(is_layout_test_mode, "Enable layout test mode", "layout-test-mode");
     args_parser.add_option(certificates, "Path to a certificate file", "certificate", 'C', "certificate");
+    args_parser.add_option(trace_path, "Write a trace of the page load in Chrome's trace event format", "trace", 0, "path");
+    args_parser.add_option(page_load_benchmark_path, "Load each URL listed in a file, and report how long the loads took", "page-load-benchmark", 0, "url-list-path");
+    args_parser.add_option(page_load_benchmark_runs, "How often to load each URL in the page load benchmark (default: 5)", "page-load-benchmark-runs", 0, "n");
     args_parser.add_positional_argument(raw_url, "URL to open", "url", Core::ArgsParser::Required::No);
     args_parser.parse(arguments);
 
@@ -722,6 +965,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         return run_tests(*view, test_root_path, test_glob, dump_failed_ref_tests, dump_gc_graph);
     }
 
+    if (!page_load_benchmark_path.is_empty())
+        return run_page_load_benchmark(*view, page_load_benchmark_path, page_load_benchmark_runs, trace_path);
+
     auto url = WebView::sanitize_url(raw_url);
     if (!url.has_value()) {
         warnln("Invalid URL: \"{}\"", raw_url);
@@ -739,7 +985,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     }
 
     if (web_driver_ipc_path.is_empty()) {
-        auto timer = TRY(load_page_for_screenshot_and_exit(event_loop, *view, url.value(), screenshot_timeout));
+        auto timer = TRY(load_page_for_screenshot_and_exit(event_loop, *view, url.value(), screenshot_timeout, trace_path));
         return event_loop.exec();
     }
 
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashMap.h>
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <AK/QuickSort.h>
+#include <LibCore/ArgsParser.h>
+#include <LibCore/File.h>
+#include <LibCore/System.h>
+#include <LibMain/Main.h>
+#include <unistd.h>
+
+static constexpr StringView lock_statistics_path = "/sys/kernel/lock_statistics"sv;
+
+struct MutexSite {
+    ByteString name;
+    ByteString location;
+    u64 acquisitions { 0 };
+    u64 contended_acquisitions { 0 };
+    u64 total_wait_time_ns { 0 };
+    u64 max_wait_time_ns { 0 };
+    u64 exclusive_holds { 0 };
+    u64 total_hold_time_ns { 0 };
+};
+
+struct SpinlockRank {
+    ByteString rank;
+    u64 acquisitions { 0 };
+    u64 contended_acquisitions { 0 };
+    u64 spins { 0 };
+};
+
+struct Snapshot {
+    HashMap<ByteString, MutexSite> mutexes;
+    Vector<SpinlockRank> spinlocks;
+};
+
+static ErrorOr<Snapshot> read_snapshot()
+{
+    auto file = TRY(Core::File::open(lock_statistics_path, Core::File::OpenMode::Read));
+    auto file_contents = TRY(file->read_until_eof());
+    auto json = TRY(JsonValue::from_string(file_contents));
+    auto const& object = json.as_object();
+
+    Snapshot snapshot;
+    object.get_array("mutexes"sv)->for_each([&](JsonValue const& value) {
+        auto const& site_object = value.as_object();
+        MutexSite site;
+        site.name = site_object.get_byte_string("name"sv).value_or({});
+        site.location = ByteString::formatted("{}:{} ({})", site_object.get_byte_string("file"sv).value_or({}), site_object.get_u32("line"sv).value_or(0), site_object.get_byte_string("function"sv).value_or({}));
+        site.acquisitions = site_object.get_u64("acquisitions"sv).value_or(0);
+        site.contended_acquisitions = site_object.get_u64("contended_acquisitions"sv).value_or(0);
+        site.total_wait_time_ns = site_object.get_u64("total_wait_time_ns"sv).value_or(0);
+        site.max_wait_time_ns = site_object.get_u64("max_wait_time_ns"sv).value_or(0);
+        site.exclusive_holds = site_object.get_u64("exclusive_holds"sv).value_or(0);
+        site.total_hold_time_ns = site_object.get_u64("total_hold_time_ns"sv).value_or(0);
+        auto key = ByteString::formatted("{}@{}", site.name, site.location);
+        snapshot.mutexes.set(move(key), move(site));
+    });
+    object.get_array("spinlocks"sv)->for_each([&](JsonValue const& value) {
+        auto const& rank_object = value.as_object();
+        snapshot.spinlocks.append({
+            .rank = rank_object.get_byte_string("rank"sv).value_or({}),
+            .acquisitions = rank_object.get_u64("acquisitions"sv).value_or(0),
+            .contended_acquisitions = rank_object.get_u64("contended_acquisitions"sv).value_or(0),
+            .spins = rank_object.get_u64("spins"sv).value_or(0),
+        });
+    });
+    return snapshot;
+}
+
+// Turns the totals of `current` into the deltas since `previous`. The maximum wait can't be
+// diffed, so it stays the maximum since boot.
+static void subtract_snapshot(Snapshot& current, Snapshot const& previous)
+{
+    for (auto& [key, site] : current.mutexes) {
+        auto previous_site = previous.mutexes.get(key);
+        if (!previous_site.has_value())
+            continue;
+        site.acquisitions -= previous_site->acquisitions;
+        site.contended_acquisitions -= previous_site->contended_acquisitions;
+        site.total_wait_time_ns -= previous_site->total_wait_time_ns;
+        site.exclusive_holds -= previous_site->exclusive_holds;
+        site.total_hold_time_ns -= previous_site->total_hold_time_ns;
+    }
+    for (size_t i = 0; i < min(current.spinlocks.size(), previous.spinlocks.size()); ++i) {
+        current.spinlocks[i].acquisitions -= previous.spinlocks[i].acquisitions;
+        current.spinlocks[i].contended_acquisitions -= previous.spinlocks[i].contended_acquisitions;
+        current.spinlocks[i].spins -= previous.spinlocks[i].spins;
+    }
+}
+
+static ByteString format_time_ns(u64 time_ns)
+{
+    if (time_ns >= 1'000'000'000)
+        return ByteString::formatted("{}.{:03}s", time_ns / 1'000'000'000, (time_ns / 1'000'000) % 1000);
+    if (time_ns >= 1'000'000)
+        return ByteString::formatted("{}.{:03}ms", time_ns / 1'000'000, (time_ns / 1'000) % 1000);
+    if (time_ns >= 1'000)
+        return ByteString::formatted("{}.{:03}us", time_ns / 1'000, time_ns % 1000);
+    return ByteString::formatted("{}ns", time_ns);
+}
+
+ErrorOr<int> serenity_main(Main::Arguments arguments)
+{
+    TRY(Core::System::pledge("stdio rpath"));
+    TRY(Core::System::unveil(lock_statistics_path, "r"sv));
+    TRY(Core::System::unveil(nullptr, nullptr));
+
+    StringView sort_by = "wait"sv;
+    size_t max_rows = 20;
+    unsigned interval = 0;
+    bool show_all = false;
+
+    Core::ArgsParser args_parser;
+    args_parser.set_general_help("Show which kernel locks are contended. Requires a kernel built with LOCK_STATISTICS.");
+    args_parser.add_option(sort_by, "Sort by wait, max-wait, contended, acquisitions or hold (default: wait)", "sort", 's', "key");
+    args_parser.add_option(max_rows, "Number of lock sites to show (default: 20)", "count", 'n', "count");
+    args_parser.add_option(interval, "Only count what happens during the next N seconds", "interval", 'i', "seconds");
+    args_parser.add_option(show_all, "Also show lock sites that were never contended", "all", 'a');
+    args_parser.parse(arguments);
+
+    Function<u64(MutexSite const&)> sort_key;
+    if (sort_by == "wait"sv)
+        sort_key = [](auto& site) { return site.total_wait_time_ns; };
+    else if (sort_by == "max-wait"sv)
+        sort_key = [](auto& site) { return site.max_wait_time_ns; };
+    else if (sort_by == "contended"sv)
+        sort_key = [](auto& site) { return site.contended_acquisitions; };
+    else if (sort_by == "acquisitions"sv)
+        sort_key = [](auto& site) { return site.acquisitions; };
+    else if (sort_by == "hold"sv)
+        sort_key = [](auto& site) { return site.total_hold_time_ns; };
+    else {
+        warnln("Unknown sort key '{}'", sort_by);
+        return 1;
+    }
+
+    auto snapshot_or_error = read_snapshot();
+    if (snapshot_or_error.is_error() && snapshot_or_error.error().is_errno() && snapshot_or_error.error().code() == ENOENT) {
+        warnln("{} doesn't exist, the kernel was built without LOCK_STATISTICS", lock_statistics_path);
+        return 1;
+    }
+    auto snapshot = TRY(move(snapshot_or_error));
+
+    if (interval > 0) {
+        sleep(interval);
+        auto previous_snapshot = move(snapshot);
+        snapshot = TRY(read_snapshot());
+        subtract_snapshot(snapshot, previous_snapshot);
+    }
+
+    TRY(Core::System::pledge("stdio"));
+
+    Vector<MutexSite const*> sites;
+    for (auto const& it : snapshot.mutexes) {
+        if (show_all || it.value.contended_acquisitions > 0)
+            sites.append(&it.value);
+    }
+    quick_sort(sites, [&](auto* a, auto* b) { return sort_key(*a) > sort_key(*b); });
+
+    outln("{:>12} {:>10} {:>12} {:>12} {:>12}  {:<20} {}", "Acquired", "Contended", "Total wait", "Max wait", "Avg hold", "Lock", "Site");
+    for (size_t i = 0; i < min(sites.size(), max_rows); ++i) {
+        auto const& site = *sites[i];
+        auto average_hold_time_ns = site.exclusive_holds ? site.total_hold_time_ns / site.exclusive_holds : 0;
+        outln("{:>12} {:>10} {:>12} {:>12} {:>12}  {:<20} {}", site.acquisitions, site.contended_acquisitions, format_time_ns(site.total_wait_time_ns), format_time_ns(site.max_wait_time_ns), format_time_ns(average_hold_time_ns), site.name, site.location);
+    }
+
+    outln();
+    outln("{:<14} {:>14} {:>12} {:>14}", "Spinlock rank", "Acquired", "Contended", "Spins");
+    for (auto const& rank : snapshot.spinlocks)
+        outln("{:<14} {:>14} {:>12} {:>14}", rank.rank, rank.acquisitions, rank.contended_acquisitions, rank.spins);
+
+    return 0;
+}
@@ -201,13 +201,19 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
             }
 
             while (di.has_next()) {
-                ByteString directory = di.next_full_path();
-                if (FileSystem::is_directory(directory) && !FileSystem::is_link(directory)) {
-                    ++subdirs;
-                    FileMetadata new_file;
-                    new_file.name = move(directory);
-                    files.insert(i + subdirs, move(new_file));
-                }
+                auto entry = di.next().release_value();
+                // Most file systems report the type of each entry, so only the others need to be stat'ed.
+                if (entry.type != Core::DirectoryEntry::Type::Directory && entry.type != Core::DirectoryEntry::Type::Unknown)
+                    continue;
+
+                auto directory = path.ends_with('/') ? ByteString::formatted("{}{}", path, entry.name) : ByteString::formatted("{}/{}", path, entry.name);
+                if (entry.type == Core::DirectoryEntry::Type::Unknown && (!FileSystem::is_directory(directory) || FileSystem::is_link(directory)))
+                    continue;
+
+                ++subdirs;
+                FileMetadata new_file;
+                new_file.name = move(directory);
+                files.insert(i + subdirs, move(new_file));
             }
         }
 
@@ -45,6 +45,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     u64 physical_uncommitted = json.get_u64("physical_uncommitted"sv).value_or(0);
     u32 kmalloc_call_count = json.get_u32("kmalloc_call_count"sv).value_or(0);
     u32 kfree_call_count = json.get_u32("kfree_call_count"sv).value_or(0);
+    u64 reclaim_pages_purged = json.get_u64("reclaim_pages_purged"sv).value_or(0);
+    u64 reclaim_clean_pages_released = json.get_u64("reclaim_clean_pages_released"sv).value_or(0);
+    u64 physical_allocation_failures = json.get_u64("physical_allocation_failures"sv).value_or(0);
 
     u64 kmalloc_bytes_total = kmalloc_allocated + kmalloc_available;
     u64 physical_pages_total = physical_allocated + physical_available;
@@ -66,5 +69,8 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     outln("Kmalloc call count: {}", kmalloc_call_count);
     outln("Kfree call count: {}", kfree_call_count);
     outln("Kmalloc/Kfree delta: {}", TRY(String::formatted("{:+}", kmalloc_call_count - kfree_call_count)));
+    outln("Volatile pages purged: {}", reclaim_pages_purged);
+    outln("Clean file pages released: {}", reclaim_clean_pages_released);
+    outln("Physical page allocation failures: {}", physical_allocation_failures);
     return 0;
 }
@@ -5,28 +5,51 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/BinaryHeap.h>
 #include <AK/ByteString.h>
 #include <AK/CharacterTypes.h>
-#include <AK/HashMap.h>
-#include <AK/QuickSort.h>
+#include <AK/MergeSort.h>
+#include <AK/NonnullOwnPtr.h>
 #include <AK/Vector.h>
 #include <LibCore/ArgsParser.h>
 #include <LibCore/File.h>
 #include <LibCore/System.h>
+#include <LibFileSystem/TempFile.h>
 #include <LibMain/Main.h>
+#include <LibThreading/DefaultThreadPool.h>
+#include <LibThreading/ParallelFor.h>
+
+struct KeyPosition {
+    size_t field { 0 };
+    size_t character { 0 };
+};
+
+struct Options {
+    Optional<KeyPosition> key_start;
+    Optional<KeyPosition> key_end;
+    bool unique { false };
+    bool numeric { false };
+    bool reverse { false };
+    bool zero_terminated { false };
+    StringView separator {};
+    size_t buffer_size { 64 * MiB };
+    Optional<size_t> parallel;
+    Vector<ByteString> files;
+};
 
 struct Line {
+    ByteString line;
+    // The key is extracted once when the line is read, so comparisons never have to split the line again.
     StringView key;
     long int numeric_key;
-    ByteString line;
     bool numeric;
+    bool reverse;
 
     bool operator<(Line const& other) const
     {
-        if (numeric)
-            return numeric_key < other.numeric_key;
-
-        return key < other.key;
+        if (reverse)
+            return other.compare_keys(*this);
+        return compare_keys(other);
     }
 
     bool operator==(Line const& other) const
@@ -38,30 +61,342 @@ struct Line {
     }
 
 private:
+    bool compare_keys(Line const& other) const
+    {
+        if (numeric)
+            return numeric_key < other.numeric_key;
+
+        return key < other.key;
+    }
+};
+
+// Returns the (1-based) field of the line, or an empty view at the end of the line if there aren't enough fields.
+static StringView find_field(Options const& options, StringView line, size_t field)
+{
+    size_t start = 0;
+    if (!options.separator.is_empty()) {
+        for (size_t i = 1; i < field; ++i) {
+            auto next_separator = line.find(options.separator, start);
+            if (!next_separator.has_value())
+                return line.substring_view(line.length());
+            start = *next_separator + options.separator.length();
+        }
+        auto end = line.find(options.separator, start).value_or(line.length());
+        return line.substring_view(start, end - start);
+    }
+
+    size_t end = 0;
+    for (size_t i = 0; i < field; ++i) {
+        start = end;
+        while (start < line.length() && is_ascii_space(line[start]))
+            ++start;
+        end = start;
+        while (end < line.length() && !is_ascii_space(line[end]))
+            ++end;
+    }
+    return line.substring_view(start, end - start);
+}
+
+static StringView find_key(Options const& options, StringView line)
+{
+    if (!options.key_start.has_value())
+        return line;
+
+    auto start_field = find_field(options, line, options.key_start->field);
+    size_t start = start_field.characters_without_null_termination() - line.characters_without_null_termination();
+    if (options.key_start->character != 0)
+        start += min(options.key_start->character - 1, start_field.length());
+
+    size_t end = line.length();
+    if (options.key_end.has_value()) {
+        auto end_field = find_field(options, line, options.key_end->field);
+        end = end_field.characters_without_null_termination() - line.characters_without_null_termination();
+        if (options.key_end->character == 0)
+            end += end_field.length();
+        else
+            end += min(options.key_end->character, end_field.length());
+    }
+
+    if (end <= start)
+        return ""sv;
+    return line.substring_view(start, end - start);
+}
+
+static Line make_line(Options const& options, ByteString line)
+{
+    auto key = find_key(options, line);
+    return { line, key, key.trim_whitespace().to_number<int>().value_or(0), options.numeric, options.reverse };
+}
+
+static ErrorOr<void> parse_key_definition(StringView definition, Options& options)
+{
+    auto parse_position = [&](StringView position, bool is_end) -> ErrorOr<KeyPosition> {
+        // Trailing ordering options apply to the whole key.
+        while (!position.is_empty() && is_ascii_alpha(position[position.length() - 1])) {
+            switch (position[position.length() - 1]) {
+            case 'n':
+                options.numeric = true;
+                break;
+            case 'r':
+                options.reverse = true;
+                break;
+            case 'b':
+                // Leading blanks are always skipped when fields are separated by whitespace.
+                break;
+            default:
+                return Error::from_string_literal("Unsupported key option");
+            }
+            position = position.substring_view(0, position.length() - 1);
+        }
+
+        KeyPosition key_position;
+        auto parts = position.split_view('.', SplitBehavior::KeepEmpty);
+        if (parts.is_empty() || parts.size() > 2)
+            return Error::from_string_literal("Invalid key position");
+
+        auto field = parts[0].to_number<size_t>();
+        if (!field.has_value() || *field == 0)
+            return Error::from_string_literal("Invalid key field");
+        key_position.field = *field;
+
+        if (parts.size() == 2) {
+            auto character = parts[1].to_number<size_t>();
+            if (!character.has_value() || (!is_end && *character == 0))
+                return Error::from_string_literal("Invalid key character position");
+            key_position.character = *character;
+        }
+        return key_position;
+    };
+
+    auto positions = definition.split_view(',', SplitBehavior::KeepEmpty);
+    if (positions.is_empty() || positions.size() > 2)
+        return Error::from_string_literal("Invalid key definition");
+
+    options.key_start = TRY(parse_position(positions[0], false));
+    if (positions.size() == 2)
+        options.key_end = TRY(parse_position(positions[1], true));
+    return {};
+}
+
+static ErrorOr<size_t> parse_buffer_size(StringView size)
+{
+    // Like GNU sort, the size is in KiB unless it has a suffix.
+    size_t multiplier = KiB;
+    if (!size.is_empty() && is_ascii_alpha(size[size.length() - 1])) {
+        switch (to_ascii_uppercase(size[size.length() - 1])) {
+        case 'B':
+            multiplier = 1;
+            break;
+        case 'K':
+            multiplier = KiB;
+            break;
+        case 'M':
+            multiplier = MiB;
+            break;
+        case 'G':
+            multiplier = GiB;
+            break;
+        case 'T':
+            multiplier = TiB;
+            break;
+        default:
+            return Error::from_string_literal("Invalid buffer size suffix");
+        }
+        size = size.substring_view(0, size.length() - 1);
+    }
+
+    auto value = size.to_number<size_t>();
+    if (!value.has_value() || *value == 0)
+        return Error::from_string_literal("Invalid buffer size");
+    return *value * multiplier;
+}
+
+class MergeSource {
+public:
+    virtual ~MergeSource() = default;
+    virtual ErrorOr<Optional<Line>> next() = 0;
 };
 
-template<>
-struct AK::Traits<Line> : public DefaultTraits<Line> {
-    static unsigned hash(Line const& l)
+class MemoryMergeSource final : public MergeSource {
+public:
+    explicit MemoryMergeSource(Span<Line> lines)
+        : m_lines(lines)
     {
-        if (l.numeric)
-            return l.numeric_key;
+    }
 
-        return l.key.hash();
+    virtual ErrorOr<Optional<Line>> next() override
+    {
+        if (m_index >= m_lines.size())
+            return OptionalNone {};
+        return move(m_lines[m_index++]);
     }
+
+private:
+    Span<Line> m_lines;
+    size_t m_index { 0 };
 };
 
-struct Options {
-    size_t key_field { 0 };
-    bool unique { false };
-    bool numeric { false };
-    bool reverse { false };
-    bool zero_terminated { false };
-    StringView separator {};
-    Vector<ByteString> files;
+class FileMergeSource final : public MergeSource {
+public:
+    static ErrorOr<NonnullOwnPtr<FileMergeSource>> create(Options const& options, StringView path, StringView line_delimiter)
+    {
+        auto file = TRY(Core::InputBufferedFile::create(TRY(Core::File::open(path, Core::File::OpenMode::Read))));
+        auto buffer = TRY(ByteBuffer::create_uninitialized(4096));
+        return adopt_nonnull_own_or_enomem(new (nothrow) FileMergeSource(options, move(file), move(buffer), line_delimiter));
+    }
+
+    virtual ErrorOr<Optional<Line>> next() override
+    {
+        if (m_file->is_eof())
+            return OptionalNone {};
+        ByteString line { TRY(m_file->read_until_with_resize(m_buffer, m_line_delimiter)) };
+        if (line.is_empty() && m_file->is_eof())
+            return OptionalNone {};
+        return make_line(m_options, move(line));
+    }
+
+private:
+    FileMergeSource(Options const& options, NonnullOwnPtr<Core::InputBufferedFile> file, ByteBuffer buffer, StringView line_delimiter)
+        : m_options(options)
+        , m_file(move(file))
+        , m_buffer(move(buffer))
+        , m_line_delimiter(line_delimiter)
+    {
+    }
+
+    Options const& m_options;
+    NonnullOwnPtr<Core::InputBufferedFile> m_file;
+    ByteBuffer m_buffer;
+    StringView m_line_delimiter;
 };
 
-static ErrorOr<void> load_file(Options const& options, StringView filename, StringView line_delimiter, Vector<Line>& lines, HashTable<Line>& seen)
+struct MergeKey {
+    Line const* line;
+    size_t source;
+
+    // Sources hold consecutive parts of the input, so equal lines are taken from the earlier source first,
+    // which keeps the sort stable and makes --unique keep the first of the equal lines.
+    bool operator<(MergeKey const& other) const
+    {
+        if (*line < *other.line)
+            return true;
+        if (*other.line < *line)
+            return false;
+        return source < other.source;
+    }
+};
+
+// Does a k-way merge of sorted sources into the output, dropping duplicates if requested.
+static ErrorOr<void> merge(Options const& options, Vector<NonnullOwnPtr<MergeSource>>& sources, Stream& output, StringView line_delimiter)
+{
+    Vector<Optional<Line>> current_lines;
+    TRY(current_lines.try_resize(sources.size()));
+
+    BinaryHeap<MergeKey, size_t, 16> heap;
+    for (size_t i = 0; i < sources.size(); ++i) {
+        current_lines[i] = TRY(sources[i]->next());
+        if (current_lines[i].has_value())
+            heap.insert({ &current_lines[i].value(), i }, i);
+    }
+
+    Optional<Line> previous_line;
+    while (!heap.is_empty()) {
+        auto source = heap.pop_min();
+        auto line = current_lines[source].release_value();
+
+        current_lines[source] = TRY(sources[source]->next());
+        if (current_lines[source].has_value())
+            heap.insert({ &current_lines[source].value(), source }, source);
+
+        if (options.unique) {
+            if (previous_line.has_value() && *previous_line == line)
+                continue;
+        }
+
+        TRY(output.write_until_depleted(line.line));
+        TRY(output.write_until_depleted(line_delimiter));
+
+        if (options.unique)
+            previous_line = move(line);
+    }
+
+    return {};
+}
+
+class Sorter {
+public:
+    Sorter(Options const& options, StringView line_delimiter)
+        : m_options(options)
+        , m_line_delimiter(line_delimiter)
+        , m_thread_pool([](Function<void()> work) { work(); }, options.parallel)
+    {
+    }
+
+    ErrorOr<void> add_line(ByteString line)
+    {
+        m_lines_size += line.length() + sizeof(Line);
+        TRY(m_lines.try_append(make_line(m_options, move(line))));
+        if (m_lines_size >= m_options.buffer_size)
+            TRY(spill_lines());
+        return {};
+    }
+
+    ErrorOr<void> finish(Stream& output)
+    {
+        // The runs hold the lines that were read first, so they have to come before the ones still in memory.
+        Vector<NonnullOwnPtr<MergeSource>> sources;
+        for (auto& run : m_runs)
+            TRY(sources.try_append(TRY(FileMergeSource::create(m_options, run->path(), m_line_delimiter))));
+        TRY(sources.try_extend(TRY(sort_lines())));
+
+        return merge(m_options, sources, output, m_line_delimiter);
+    }
+
+private:
+    // Sorts parts of the buffered lines in parallel, and returns them as sources for merging.
+    ErrorOr<Vector<NonnullOwnPtr<MergeSource>>> sort_lines()
+    {
+        static constexpr size_t minimum_lines_per_thread = 16 * KiB;
+        auto thread_count = clamp(m_lines.size() / minimum_lines_per_thread, 1, max<size_t>(m_thread_pool.concurrency(), 1));
+        auto lines_per_thread = ceil_div(m_lines.size(), thread_count);
+
+        Vector<Span<Line>> parts;
+        for (size_t start = 0; start < m_lines.size(); start += lines_per_thread)
+            TRY(parts.try_append(m_lines.span().slice(start, min(lines_per_thread, m_lines.size() - start))));
+
+        Threading::parallel_for(m_thread_pool, parts.size(), [&](size_t i) { merge_sort(parts[i]); });
+
+        Vector<NonnullOwnPtr<MergeSource>> sources;
+        for (auto part : parts)
+            TRY(sources.try_append(TRY(adopt_nonnull_own_or_enomem(new (nothrow) MemoryMergeSource(part)))));
+        return sources;
+    }
+
+    // Writes the buffered lines to a temporary file as one sorted run.
+    ErrorOr<void> spill_lines()
+    {
+        auto run = TRY(FileSystem::TempFile::create_temp_file());
+        auto file = TRY(Core::OutputBufferedFile::create(TRY(Core::File::open(run->path(), Core::File::OpenMode::Write))));
+
+        auto sources = TRY(sort_lines());
+        TRY(merge(m_options, sources, *file, m_line_delimiter));
+        TRY(file->flush_buffer());
+
+        TRY(m_runs.try_append(move(run)));
+        m_lines.clear_with_capacity();
+        m_lines_size = 0;
+        return {};
+    }
+
+    Options const& m_options;
+    StringView m_line_delimiter;
+    Vector<Line> m_lines;
+    size_t m_lines_size { 0 };
+    Vector<NonnullOwnPtr<FileSystem::TempFile>> m_runs;
+    Threading::DefaultThreadPool m_thread_pool;
+};
+
+static ErrorOr<void> load_file(StringView filename, StringView line_delimiter, Sorter& sorter)
 {
     auto file = TRY(Core::InputBufferedFile::create(
         TRY(Core::File::open_file_or_standard_stream(filename, Core::File::OpenMode::Read))));
@@ -73,25 +408,7 @@ static ErrorOr<void> load_file(Options const& options, StringView filename, Stri
         if (line.is_empty() && file->is_eof())
             break;
 
-        StringView key = line;
-        if (options.key_field != 0) {
-            auto split = (!options.separator.is_empty())
-                ? key.split_view(options.separator)
-                : key.split_view_if(is_ascii_space);
-            if (options.key_field - 1 >= split.size()) {
-                key = ""sv;
-            } else {
-                key = split[options.key_field - 1];
-            }
-        }
-
-        Line l = { key, key.to_number<int>().value_or(0), line, options.numeric };
-
-        if (!options.unique || !seen.contains(l)) {
-            lines.append(l);
-            if (options.unique)
-                seen.set(l);
-        }
+        TRY(sorter.add_line(move(line)));
     }
 
     return {};
@@ -99,43 +416,45 @@ static ErrorOr<void> load_file(Options const& options, StringView filename, Stri
 
 ErrorOr<int> serenity_main([[maybe_unused]] Main::Arguments arguments)
 {
-    TRY(Core::System::pledge("stdio rpath"));
+    TRY(Core::System::pledge("stdio rpath wpath cpath thread"));
 
     Options options;
+    StringView key_definition;
+    StringView buffer_size;
 
     Core::ArgsParser args_parser;
-    args_parser.add_option(options.key_field, "The field to sort by", "key-field", 'k', "keydef");
+    args_parser.add_option(key_definition, "The key to sort by, as F[.C][OPTS][,F[.C][OPTS]]", "key", 'k', "keydef");
     args_parser.add_option(options.unique, "Don't emit duplicate lines", "unique", 'u');
     args_parser.add_option(options.numeric, "treat the key field as a number", "numeric", 'n');
     args_parser.add_option(options.separator, "The separator to split fields by", "sep", 't', "char");
     args_parser.add_option(options.reverse, "Sort in reverse order", "reverse", 'r');
     args_parser.add_option(options.zero_terminated, "Use '\\0' as the line delimiter instead of a newline", "zero-terminated", 'z');
+    args_parser.add_option(buffer_size, "Size of the in-memory buffer, lines beyond it are sorted in temporary files (default unit is KiB)", "buffer-size", 'S', "size");
+    args_parser.add_option(options.parallel, "Number of threads to sort with (default is the number of processors)", "parallel", 0, "n");
     args_parser.add_positional_argument(options.files, "Files to sort", "file", Core::ArgsParser::Required::No);
     args_parser.parse(arguments);
 
+    if (!key_definition.is_empty())
+        TRY(parse_key_definition(key_definition, options));
+    if (!buffer_size.is_empty())
+        options.buffer_size = TRY(parse_buffer_size(buffer_size));
+    if (options.parallel == 0u)
+        options.parallel = 1;
+
     auto line_delimiter = options.zero_terminated ? "\0"sv : "\n"sv;
-    Vector<Line> lines;
-    HashTable<Line> seen;
+    Sorter sorter(options, line_delimiter);
 
     if (options.files.size() == 0) {
-        TRY(load_file(options, "-"sv, line_delimiter, lines, seen));
+        TRY(load_file("-"sv, line_delimiter, sorter));
     } else {
         for (auto& file : options.files) {
-            TRY(load_file(options, file, line_delimiter, lines, seen));
+            TRY(load_file(file, line_delimiter, sorter));
         }
     }
 
-    quick_sort(lines);
-
-    auto print_lines = [line_delimiter](auto const& lines) {
-        for (auto& line : lines)
-            out("{}{}", line.line, line_delimiter);
-    };
-
-    if (options.reverse)
-        print_lines(lines.in_reverse());
-    else
-        print_lines(lines);
+    auto output = TRY(Core::OutputBufferedFile::create(TRY(Core::File::standard_output())));
+    TRY(sorter.finish(*output));
+    TRY(output->flush_buffer());
 
     return 0;
 }
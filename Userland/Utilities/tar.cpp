@@ -8,24 +8,172 @@
 #include <AK/ByteString.h>
 #include <AK/HashMap.h>
 #include <AK/LexicalPath.h>
+#include <AK/Queue.h>
 #include <AK/Span.h>
 #include <AK/Vector.h>
 #include <LibArchive/TarStream.h>
 #include <LibCompress/Gzip.h>
 #include <LibCompress/Lzma.h>
 #include <LibCompress/Xz.h>
+#include <LibCompress/Zstd.h>
 #include <LibCore/ArgsParser.h>
 #include <LibCore/DirIterator.h>
 #include <LibCore/Directory.h>
 #include <LibCore/System.h>
 #include <LibFileSystem/FileSystem.h>
 #include <LibMain/Main.h>
+#include <LibThreading/ConditionVariable.h>
+#include <LibThreading/Mutex.h>
+#include <LibThreading/Thread.h>
 #include <fcntl.h>
 #include <stdio.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
 constexpr size_t buffer_size = 4096;
+constexpr size_t write_chunk_size = 256 * KiB;
+constexpr size_t max_queued_write_bytes = 16 * MiB;
+// Archives full of small files would otherwise queue up a job and an fd per file faster than they can be written out.
+constexpr size_t max_queued_write_jobs = 1024;
+constexpr size_t max_open_files = 64;
+
+// Writes extracted file contents on a thread of its own, so reading and decompressing the archive can carry on meanwhile.
+// Jobs run in the order they were queued, so a file that shows up in the archive twice still ends up with the latter contents.
+class FileWriter {
+public:
+    FileWriter()
+    {
+        m_thread = Threading::Thread::construct([this]() -> intptr_t {
+            run();
+            return 0;
+        },
+            "tar writer"sv);
+        m_thread->start();
+    }
+
+    ~FileWriter()
+    {
+        (void)finish();
+    }
+
+    // Waits until there are few enough files that haven't been closed yet, then opens another one.
+    ErrorOr<int> open(StringView path, int options, mode_t mode)
+    {
+        {
+            Threading::MutexLocker locker(m_mutex);
+            while (m_open_files >= max_open_files && !m_error.has_value())
+                m_condition.wait();
+            if (m_error.has_value())
+                return Error::copy(m_error.value());
+            ++m_open_files;
+        }
+
+        auto fd_or_error = Core::System::open(path, options, mode);
+        if (fd_or_error.is_error()) {
+            Threading::MutexLocker locker(m_mutex);
+            --m_open_files;
+            m_condition.broadcast();
+        }
+        return fd_or_error;
+    }
+
+    ErrorOr<void> write(int fd, ByteBuffer data)
+    {
+        return enqueue({ fd, move(data), false });
+    }
+
+    // Takes ownership of an fd returned by open(), it is closed once everything queued for it has been written.
+    ErrorOr<void> close(int fd)
+    {
+        return enqueue({ fd, {}, true });
+    }
+
+    ErrorOr<void> finish()
+    {
+        {
+            Threading::MutexLocker locker(m_mutex);
+            if (m_finished)
+                return {};
+            m_finished = true;
+            m_condition.broadcast();
+        }
+        (void)m_thread->join();
+        if (m_error.has_value())
+            return Error::copy(m_error.value());
+        return {};
+    }
+
+private:
+    struct Job {
+        int fd { -1 };
+        ByteBuffer data;
+        bool close { false };
+    };
+
+    ErrorOr<void> enqueue(Job job)
+    {
+        Threading::MutexLocker locker(m_mutex);
+        while ((m_queued_bytes >= max_queued_write_bytes || m_jobs.size() >= max_queued_write_jobs) && !m_error.has_value())
+            m_condition.wait();
+        // NOTE: fds are still closed after an error, to not leak them.
+        if (m_error.has_value() && !job.close)
+            return Error::copy(m_error.value());
+        m_queued_bytes += job.data.size();
+        m_jobs.enqueue(move(job));
+        m_condition.broadcast();
+        return {};
+    }
+
+    void run()
+    {
+        while (true) {
+            Job job;
+            bool failed = false;
+            {
+                Threading::MutexLocker locker(m_mutex);
+                while (m_jobs.is_empty() && !m_finished)
+                    m_condition.wait();
+                if (m_jobs.is_empty())
+                    return;
+                job = m_jobs.dequeue();
+                failed = m_error.has_value();
+            }
+
+            // Once something went wrong the extraction is going to fail anyway, so don't bother writing the rest.
+            ErrorOr<void> result {};
+            if (job.close)
+                result = Core::System::close(job.fd);
+            else if (!failed)
+                result = write_until_depleted(job.fd, job.data);
+
+            Threading::MutexLocker locker(m_mutex);
+            m_queued_bytes -= job.data.size();
+            if (job.close)
+                --m_open_files;
+            if (result.is_error() && !m_error.has_value())
+                m_error = result.release_error();
+            m_condition.broadcast();
+        }
+    }
+
+    static ErrorOr<void> write_until_depleted(int fd, ReadonlyBytes data)
+    {
+        while (!data.is_empty()) {
+            auto nwritten = TRY(Core::System::write(fd, data));
+            data = data.slice(nwritten);
+        }
+        return {};
+    }
+
+    RefPtr<Threading::Thread> m_thread;
+    Threading::Mutex m_mutex;
+    Threading::ConditionVariable m_condition { m_mutex };
+    Queue<Job> m_jobs;
+    size_t m_queued_bytes { 0 };
+    size_t m_open_files { 0 };
+    bool m_finished { false };
+    Optional<Error> m_error;
+};
 
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
@@ -36,6 +184,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     bool gzip = false;
     bool lzma = false;
     bool xz = false;
+    bool zstd = false;
     bool no_auto_compress = false;
     StringView archive_file;
     bool dereference = false;
@@ -50,6 +199,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.add_option(gzip, "Compress or decompress file using gzip", "gzip", 'z');
     args_parser.add_option(lzma, "Compress or decompress file using lzma", "lzma");
     args_parser.add_option(xz, "Compress or decompress file using xz", "xz", 'J');
+    args_parser.add_option(zstd, "Compress or decompress file using zstd", "zstd");
     args_parser.add_option(no_auto_compress, "Do not use the archive suffix to select the compression algorithm", "no-auto-compress");
     args_parser.add_option(directory, "Directory to extract to/create from", "directory", 'C', "DIRECTORY");
     args_parser.add_option(archive_file, "Archive file", "file", 'f', "FILE");
@@ -69,6 +219,8 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
             lzma = true;
         if (archive_file.ends_with(".xz"sv))
             xz = true;
+        if (archive_file.ends_with(".zst"sv) || archive_file.ends_with(".tzst"sv))
+            zstd = true;
     }
 
     if (list || extract) {
@@ -86,7 +238,11 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         if (xz)
             input_stream = TRY(Compress::XzDecompressor::create(move(input_stream)));
 
+        if (zstd)
+            input_stream = TRY(Compress::ZstdDecompressor::create(move(input_stream)));
+
         auto tar_stream = TRY(Archive::TarInputStream::construct(move(input_stream)));
+        FileWriter writer;
 
         HashMap<ByteString, ByteString> global_overrides;
         HashMap<ByteString, ByteString> local_overrides;
@@ -176,15 +332,23 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
                 case Archive::TarFileType::AlternateNormalFile: {
                     MUST(Core::Directory::create(parent_path, Core::Directory::CreateDirectories::Yes));
 
-                    int fd = TRY(Core::System::open(absolute_path, O_CREAT | O_WRONLY, header_mode));
+                    int fd = TRY(writer.open(absolute_path, O_CREAT | O_WRONLY, header_mode));
 
-                    Array<u8, buffer_size> buffer;
+                    auto remaining_size = TRY(header.size());
                     while (!file_stream.is_eof()) {
-                        auto slice = TRY(file_stream.read_some(buffer));
-                        TRY(Core::System::write(fd, slice));
+                        auto buffer = TRY(ByteBuffer::create_uninitialized(clamp<size_t>(remaining_size, 1, write_chunk_size)));
+                        size_t buffered = 0;
+                        while (buffered < buffer.size() && !file_stream.is_eof())
+                            buffered += TRY(file_stream.read_some(buffer.bytes().slice(buffered))).size();
+                        buffer.trim(buffered, false);
+                        remaining_size -= min(remaining_size, buffered);
+                        if (auto result = writer.write(fd, move(buffer)); result.is_error()) {
+                            (void)writer.close(fd);
+                            return result.release_error();
+                        }
                     }
 
-                    TRY(Core::System::close(fd));
+                    TRY(writer.close(fd));
                     break;
                 }
                 case Archive::TarFileType::SymLink: {
@@ -214,6 +378,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
             TRY(tar_stream->advance());
         }
 
+        TRY(writer.finish());
         return 0;
     }
 
@@ -240,6 +405,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         if (xz)
             TODO();
 
+        if (zstd)
+            output_stream = TRY(Compress::ZstdCompressor::create(move(output_stream)));
+
         Archive::TarOutputStream tar_stream(move(output_stream));
 
         auto add_file = [&](ByteString path) -> ErrorOr<void> {
@@ -6,6 +6,7 @@
 
 #include <AK/Assertions.h>
 #include <AK/DOSPackedTime.h>
+#include <AK/HashTable.h>
 #include <AK/NumberFormat.h>
 #include <AK/StringUtils.h>
 #include <LibArchive/Zip.h>
@@ -18,6 +19,7 @@
 #include <LibCore/System.h>
 #include <LibCrypto/Checksum/CRC32.h>
 #include <LibFileSystem/FileSystem.h>
+#include <LibThreading/ParallelFor.h>
 #include <sys/stat.h>
 
 static ErrorOr<void> adjust_modification_time(Archive::ZipMember const& zip_member)
@@ -32,52 +34,46 @@ static ErrorOr<void> adjust_modification_time(Archive::ZipMember const& zip_memb
     return Core::System::utime(zip_member.name, buf);
 }
 
-static bool unpack_zip_member(Archive::ZipMember zip_member, bool quiet)
+// Members are extracted in batches of this many, so that output stays in archive order and a failure stops the extraction soon after.
+static constexpr size_t extraction_batch_size = 64;
+
+struct ExtractionResult {
+    // Whether the member got far enough to be listed as extracted.
+    bool started { false };
+    Optional<ByteString> error;
+};
+
+static ExtractionResult create_zip_directory(Archive::ZipMember const& zip_member)
+{
+    if (auto maybe_error = Core::System::mkdir(zip_member.name, 0755); maybe_error.is_error())
+        return { false, ByteString::formatted("Failed to create directory '{}': {}", zip_member.name, maybe_error.error()) };
+    return { true, {} };
+}
+
+// NOTE: This runs on several threads at once, the parent directory has to exist already.
+static ExtractionResult unpack_zip_file(Archive::ZipMember const& zip_member)
 {
-    if (zip_member.is_directory) {
-        if (auto maybe_error = Core::System::mkdir(zip_member.name, 0755); maybe_error.is_error()) {
-            warnln("Failed to create directory '{}': {}", zip_member.name, maybe_error.error());
-            return false;
-        }
-        if (!quiet)
-            outln(" extracting: {}", zip_member.name);
-        return true;
-    }
-    MUST(Core::Directory::create(LexicalPath(zip_member.name.to_byte_string()).parent(), Core::Directory::CreateDirectories::Yes));
     auto new_file_or_error = Core::File::open(zip_member.name.to_byte_string(), Core::File::OpenMode::Write);
-    if (new_file_or_error.is_error()) {
-        warnln("Can't write file {}: {}", zip_member.name, new_file_or_error.release_error());
-        return false;
-    }
+    if (new_file_or_error.is_error())
+        return { false, ByteString::formatted("Can't write file {}: {}", zip_member.name, new_file_or_error.release_error()) };
     auto new_file = new_file_or_error.release_value();
 
-    if (!quiet)
-        outln(" extracting: {}", zip_member.name);
-
     Crypto::Checksum::CRC32 checksum;
     switch (zip_member.compression_method) {
     case Archive::ZipCompressionMethod::Store: {
-        if (auto maybe_error = new_file->write_until_depleted(zip_member.compressed_data); maybe_error.is_error()) {
-            warnln("Can't write file contents in {}: {}", zip_member.name, maybe_error.release_error());
-            return false;
-        }
+        if (auto maybe_error = new_file->write_until_depleted(zip_member.compressed_data); maybe_error.is_error())
+            return { true, ByteString::formatted("Can't write file contents in {}: {}", zip_member.name, maybe_error.release_error()) };
         checksum.update({ zip_member.compressed_data.data(), zip_member.compressed_data.size() });
         break;
     }
     case Archive::ZipCompressionMethod::Deflate: {
         auto decompressed_data = Compress::DeflateDecompressor::decompress_all(zip_member.compressed_data);
-        if (decompressed_data.is_error()) {
-            warnln("Failed decompressing file {}: {}", zip_member.name, decompressed_data.error());
-            return false;
-        }
-        if (decompressed_data.value().size() != zip_member.uncompressed_size) {
-            warnln("Failed decompressing file {}", zip_member.name);
-            return false;
-        }
-        if (auto maybe_error = new_file->write_until_depleted(decompressed_data.value()); maybe_error.is_error()) {
-            warnln("Can't write file contents in {}: {}", zip_member.name, maybe_error.release_error());
-            return false;
-        }
+        if (decompressed_data.is_error())
+            return { true, ByteString::formatted("Failed decompressing file {}: {}", zip_member.name, decompressed_data.error()) };
+        if (decompressed_data.value().size() != zip_member.uncompressed_size)
+            return { true, ByteString::formatted("Failed decompressing file {}", zip_member.name) };
+        if (auto maybe_error = new_file->write_until_depleted(decompressed_data.value()); maybe_error.is_error())
+            return { true, ByteString::formatted("Can't write file contents in {}: {}", zip_member.name, maybe_error.release_error()) };
         checksum.update(decompressed_data.value());
         break;
     }
@@ -85,19 +81,66 @@ static bool unpack_zip_member(Archive::ZipMember zip_member, bool quiet)
         VERIFY_NOT_REACHED();
     }
 
-    if (adjust_modification_time(zip_member).is_error()) {
-        warnln("Failed setting modification_time for file {}", zip_member.name);
-        return false;
-    }
+    if (adjust_modification_time(zip_member).is_error())
+        return { true, ByteString::formatted("Failed setting modification_time for file {}", zip_member.name) };
 
     new_file->close();
 
     if (checksum.digest() != zip_member.crc32) {
-        warnln("Failed decompressing file {}: CRC32 mismatch", zip_member.name);
         MUST(FileSystem::remove(zip_member.name, FileSystem::RecursionMode::Disallowed));
-        return false;
+        return { true, ByteString::formatted("Failed decompressing file {}: CRC32 mismatch", zip_member.name) };
     }
 
+    return { true, {} };
+}
+
+// Directories are created in archive order first, then the files are decompressed and written out in parallel.
+// Files that share a name are written out one after the other, in archive order.
+static bool unpack_zip_members(Span<Archive::ZipMember const> zip_members, bool quiet)
+{
+    Vector<ExtractionResult> results;
+    results.resize(zip_members.size());
+    Vector<size_t> file_indices;
+    HashTable<StringView> file_names;
+
+    auto unpack_pending_files = [&] {
+        Threading::parallel_for(file_indices.size(), [&](size_t i) {
+            results[file_indices[i]] = unpack_zip_file(zip_members[file_indices[i]]);
+        });
+        file_indices.clear_with_capacity();
+        file_names.clear_with_capacity();
+    };
+
+    for (size_t i = 0; i < zip_members.size(); ++i) {
+        auto const& zip_member = zip_members[i];
+        if (zip_member.is_directory) {
+            results[i] = create_zip_directory(zip_member);
+            if (results[i].error.has_value()) {
+                zip_members = zip_members.trim(i + 1);
+                break;
+            }
+            continue;
+        }
+        MUST(Core::Directory::create(LexicalPath(zip_member.name.to_byte_string()).parent(), Core::Directory::CreateDirectories::Yes));
+
+        // NOTE: Archives can contain the same name more than once, and the later member has to end up on disk. So the
+        //       files before it are written out first, rather than having two threads write to the same file.
+        if (file_names.contains(zip_member.name.bytes_as_string_view()))
+            unpack_pending_files();
+        file_names.set(zip_member.name.bytes_as_string_view());
+        file_indices.append(i);
+    }
+
+    unpack_pending_files();
+
+    for (size_t i = 0; i < zip_members.size(); ++i) {
+        if (results[i].started && !quiet)
+            outln(" extracting: {}", zip_members[i].name);
+        if (results[i].error.has_value()) {
+            warnln("{}", results[i].error.value());
+            return false;
+        }
+    }
     return true;
 }
 
@@ -160,9 +203,10 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         return 0;
     }
 
+    Vector<Archive::ZipMember> zip_members;
     Vector<Archive::ZipMember> zip_directories;
 
-    auto success = TRY(zip_file->for_each_member([&](auto zip_member) {
+    TRY(zip_file->for_each_member([&](auto zip_member) {
         bool keep_file = false;
 
         if (!file_filters.is_empty()) {
@@ -179,8 +223,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         }
 
         if (keep_file) {
-            if (!unpack_zip_member(zip_member, quiet))
-                return IterationDecision::Break;
+            zip_members.append(zip_member);
             if (zip_member.is_directory)
                 zip_directories.append(zip_member);
         }
@@ -188,8 +231,10 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         return IterationDecision::Continue;
     }));
 
-    if (!success) {
-        return 1;
+    for (size_t i = 0; i < zip_members.size(); i += extraction_batch_size) {
+        auto batch = zip_members.span().slice(i, min(extraction_batch_size, zip_members.size() - i));
+        if (!unpack_zip_members(batch, quiet))
+            return 1;
     }
 
     for (auto& directory : zip_directories) {
@@ -199,5 +244,5 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         }
     }
 
-    return success ? 0 : 1;
+    return 0;
 }
@@ -13,11 +13,24 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     auto app = TRY(GUI::Application::create(arguments));
 
     int flash_flush = -1;
+    bool show_statistics = false;
     Core::ArgsParser args_parser;
     args_parser.add_option(flash_flush, "Flash flush (repaint) rectangles", "flash-flush", 'f', "0/1");
+    args_parser.add_option(show_statistics, "Show how many pixels were composed and flushed on each screen", "statistics", 's');
     args_parser.parse(arguments);
 
     if (flash_flush != -1)
         GUI::ConnectionToWindowServer::the().async_set_flash_flush(flash_flush);
+
+    if (show_statistics) {
+        for (u32 screen_index = 0;; ++screen_index) {
+            auto statistics = GUI::ConnectionToWindowServer::the().get_compositor_statistics(screen_index);
+            if (!statistics.success())
+                break;
+            outln("Screen #{}: {} frames, {} pixels composed, {} pixels flushed (last frame: {} composed, {} flushed)",
+                screen_index, statistics.frames(), statistics.pixels_composed(), statistics.pixels_flushed(),
+                statistics.last_frame_pixels_composed(), statistics.last_frame_pixels_flushed());
+        }
+    }
     return 0;
 }
@@ -12,18 +12,23 @@
 
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
-    TRY(Core::System::pledge("rpath stdio"));
+    TRY(Core::System::pledge("rpath stdio thread"));
 
     StringView filename;
+    size_t thread_count { 1 };
 
     Core::ArgsParser args_parser;
     args_parser.set_general_help("Decompress and print an XZ archive");
+    args_parser.add_option(thread_count, "Number of threads to decompress with, or 0 for one per CPU core", "threads", 'T', "count");
     args_parser.add_positional_argument(filename, "File to decompress", "file");
     args_parser.parse(arguments);
 
+    if (thread_count == 0)
+        thread_count = Core::System::hardware_concurrency();
+
     auto file = TRY(Core::File::open_file_or_standard_stream(filename, Core::File::OpenMode::Read));
     auto buffered_file = TRY(Core::InputBufferedFile::create(move(file)));
-    auto stream = TRY(Compress::XzDecompressor::create(move(buffered_file)));
+    auto stream = TRY(Compress::XzDecompressor::create(move(buffered_file), thread_count));
 
     // Arbitrarily chosen buffer size.
     Array<u8, 4096> buffer;
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteString.h>
+#include <AK/LexicalPath.h>
+#include <LibCompress/Zstd.h>
+#include <LibCore/ArgsParser.h>
+#include <LibCore/File.h>
+#include <LibCore/System.h>
+#include <LibMain/Main.h>
+
+ErrorOr<int> serenity_main(Main::Arguments arguments)
+{
+    Vector<StringView> filenames;
+    bool keep_input_files { false };
+    bool remove_input_files { false };
+    bool write_to_stdout { false };
+    bool decompress { false };
+
+    Core::ArgsParser args_parser;
+    args_parser.add_option(keep_input_files, "Keep (don't delete) input files, which is the default", "keep", 'k');
+    args_parser.add_option(remove_input_files, "Delete input files after processing them", "rm");
+    args_parser.add_option(write_to_stdout, "Write to stdout, keep original files unchanged", "stdout", 'c');
+    args_parser.add_option(decompress, "Decompress", "decompress", 'd');
+    args_parser.add_positional_argument(filenames, "Files", "FILES", Core::ArgsParser::Required::No);
+    args_parser.parse(arguments);
+
+    auto program_name = LexicalPath::basename(arguments.strings[0]);
+
+    // NOTE: If the user run this program via the /bin/zstdcat or /bin/unzstd symlink,
+    // then emulate zstd decompression.
+    if (program_name == "zstdcat"sv || program_name == "unzstd"sv)
+        decompress = true;
+
+    if (program_name == "zstdcat"sv)
+        write_to_stdout = true;
+
+    if (filenames.is_empty()) {
+        filenames.append("-"sv);
+        write_to_stdout = true;
+    }
+
+    // Unlike gzip, zstd keeps its input files unless it is asked not to.
+    if (write_to_stdout || keep_input_files)
+        remove_input_files = false;
+
+    for (auto const& input_filename : filenames) {
+        OwnPtr<Stream> output_stream;
+
+        if (write_to_stdout) {
+            output_stream = TRY(Core::File::standard_output());
+        } else if (decompress) {
+            if (!input_filename.ends_with(".zst"sv)) {
+                warnln("unknown suffix for: {}, skipping", input_filename);
+                continue;
+            }
+
+            auto output_filename = input_filename.substring_view(0, input_filename.length() - ".zst"sv.length());
+            output_stream = TRY(Core::File::open(output_filename, Core::File::OpenMode::Write));
+        } else {
+            auto output_filename = ByteString::formatted("{}.zst", input_filename);
+            output_stream = TRY(Core::File::open(output_filename, Core::File::OpenMode::Write));
+        }
+
+        VERIFY(output_stream);
+
+        NonnullOwnPtr<Core::File> input_file = TRY(Core::File::open_file_or_standard_stream(input_filename, Core::File::OpenMode::Read));
+
+        // Buffer reads, which yields a significant performance improvement.
+        NonnullOwnPtr<Stream> input_stream = TRY(Core::InputBufferedFile::create(move(input_file), 1 * MiB));
+
+        if (decompress) {
+            input_stream = TRY(Compress::ZstdDecompressor::create(move(input_stream)));
+        } else {
+            // Storing the size of regular files in the frame header lets small files be decompressed with a smaller window.
+            Optional<u64> content_size;
+            if (input_filename != "-"sv) {
+                auto stat = TRY(Core::System::stat(input_filename));
+                if (S_ISREG(stat.st_mode))
+                    content_size = stat.st_size;
+            }
+            output_stream = TRY(Compress::ZstdCompressor::create(output_stream.release_nonnull(), content_size));
+        }
+
+        auto buffer = TRY(ByteBuffer::create_uninitialized(1 * MiB));
+        while (!input_stream->is_eof()) {
+            auto span = TRY(input_stream->read_some(buffer));
+            TRY(output_stream->write_until_depleted(span));
+        }
+
+        if (!decompress)
+            TRY(static_cast<Compress::ZstdCompressor&>(*output_stream).finish());
+
+        if (remove_input_files)
+            TRY(Core::System::unlink(input_filename));
+    }
+
+    return 0;
+}